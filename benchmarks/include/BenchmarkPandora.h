@@ -0,0 +1,75 @@
+/**
+ *  @file   PandoraSDK/benchmarks/include/BenchmarkPandora.h
+ *
+ *  @brief  Header file for the benchmark pandora class.
+ *
+ *  $Log: $
+ */
+#ifndef PANDORA_BENCHMARK_PANDORA_H
+#define PANDORA_BENCHMARK_PANDORA_H 1
+
+#include "CallbackPandora.h"
+#include "SyntheticEventGenerator.h"
+
+#include <benchmark/benchmark.h>
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+namespace pandora_benchmarks
+{
+
+/**
+ *  @brief  BenchmarkPandora class, a callback pandora instance with helpers for creating synthetic events and reporting failures to the
+ *          benchmark state
+ */
+class BenchmarkPandora : public CallbackPandora
+{
+public:
+    /**
+     *  @brief  Constructor
+     *
+     *  @param  layerPitch the pseudo layer pitch along z, units mm
+     */
+    BenchmarkPandora(const float layerPitch = 5.f);
+
+    /**
+     *  @brief  Create the lar tpcs and the objects for a synthetic event, using the synthetic event parameters for the specified number
+     *          of calo hits. Call at most once per instance.
+     *
+     *  @param  nCaloHits the number of calo hits
+     */
+    pandora::StatusCode CreateSyntheticEvent(const unsigned int nCaloHits);
+
+    /**
+     *  @brief  Run a benchmark, processing the event with a callback that holds the benchmark loop, then resetting the event. Any
+     *          failure is reported as a benchmark error.
+     *
+     *  @param  state the benchmark state
+     *  @param  callback the callback
+     */
+    void Run(benchmark::State &state, const Callback &callback);
+
+    /**
+     *  @brief  Get the synthetic event parameters for a benchmark, using the default generator parameters, but with the specified number
+     *          of calo hits and with one primary mc particle and one track per thousand calo hits
+     *
+     *  @param  nCaloHits the number of calo hits
+     *
+     *  @return the synthetic event parameters
+     */
+    static SyntheticEventGenerator::Parameters GetSyntheticEventParameters(const unsigned int nCaloHits);
+
+    /**
+     *  @brief  Check the status code of a benchmark step, reporting any failure as a benchmark error
+     *
+     *  @param  state the benchmark state
+     *  @param  statusCode the status code
+     *
+     *  @return whether the step succeeded
+     */
+    static bool Check(benchmark::State &state, const pandora::StatusCode statusCode);
+};
+
+} // namespace pandora_benchmarks
+
+#endif // #ifndef PANDORA_BENCHMARK_PANDORA_H
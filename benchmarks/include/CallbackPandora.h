@@ -0,0 +1,117 @@
+/**
+ *  @file   PandoraSDK/benchmarks/include/CallbackPandora.h
+ *
+ *  @brief  Header file for the callback pandora class.
+ *
+ *  $Log: $
+ */
+#ifndef PANDORA_CALLBACK_PANDORA_H
+#define PANDORA_CALLBACK_PANDORA_H 1
+
+#include "Pandora/Algorithm.h"
+
+#include <functional>
+
+namespace pandora {class Pandora;}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+namespace pandora_benchmarks
+{
+
+/**
+ *  @brief  CallbackPandora class, owning a pandora instance that runs a single callback algorithm, so that tools and benchmarks may run
+ *          code needing an algorithm context, such as list access and cluster creation, against the objects created for an event. Calo
+ *          hits are assigned pseudo layers of fixed pitch along z.
+ */
+class CallbackPandora
+{
+public:
+    typedef std::function<pandora::StatusCode(const pandora::Algorithm &)> Callback;
+
+    /**
+     *  @brief  Constructor
+     *
+     *  @param  layerPitch the pseudo layer pitch along z, units mm
+     */
+    CallbackPandora(const float layerPitch = 5.f);
+
+    /**
+     *  @brief  Destructor
+     */
+    ~CallbackPandora();
+
+    /**
+     *  @brief  Get the pandora instance
+     *
+     *  @return the pandora instance
+     */
+    const pandora::Pandora &GetPandora() const;
+
+    /**
+     *  @brief  Process the event, running a callback as the body of the single algorithm. The objects created for the event, and
+     *          during the callback, remain until the event is reset.
+     *
+     *  @param  callback the callback
+     */
+    pandora::StatusCode ProcessEvent(const Callback &callback);
+
+    /**
+     *  @brief  Reset the event, deleting all objects
+     */
+    pandora::StatusCode Reset();
+
+private:
+    /**
+     *  @brief  CallbackAlgorithm class
+     */
+    class CallbackAlgorithm : public pandora::Algorithm
+    {
+    public:
+        /**
+         *  @brief  Factory class for instantiating algorithm
+         */
+        class Factory : public pandora::AlgorithmFactory
+        {
+        public:
+            /**
+             *  @brief  Constructor
+             *
+             *  @param  callback the callback, owned by the callback pandora instance
+             */
+            Factory(const Callback &callback);
+
+            pandora::Algorithm *CreateAlgorithm() const;
+
+        private:
+            const Callback     &m_callback;         ///< The callback, owned by the callback pandora instance
+        };
+
+        /**
+         *  @brief  Constructor
+         *
+         *  @param  callback the callback, owned by the callback pandora instance
+         */
+        CallbackAlgorithm(const Callback &callback);
+
+    private:
+        pandora::StatusCode Run();
+        pandora::StatusCode ReadSettings(const pandora::TiXmlHandle xmlHandle);
+
+        const Callback         &m_callback;         ///< The callback, owned by the callback pandora instance
+    };
+
+    pandora::Pandora           *m_pPandora;         ///< The pandora instance
+    Callback                    m_callback;         ///< The callback for the current event
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const pandora::Pandora &CallbackPandora::GetPandora() const
+{
+    return *m_pPandora;
+}
+
+} // namespace pandora_benchmarks
+
+#endif // #ifndef PANDORA_CALLBACK_PANDORA_H
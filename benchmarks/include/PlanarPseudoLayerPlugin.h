@@ -0,0 +1,40 @@
+/**
+ *  @file   PandoraSDK/benchmarks/include/PlanarPseudoLayerPlugin.h
+ *
+ *  @brief  Header file for the planar pseudo layer plugin class.
+ *
+ *  $Log: $
+ */
+#ifndef PANDORA_PLANAR_PSEUDO_LAYER_PLUGIN_H
+#define PANDORA_PLANAR_PSEUDO_LAYER_PLUGIN_H 1
+
+#include "Plugins/PseudoLayerPlugin.h"
+
+namespace pandora_benchmarks
+{
+
+/**
+ *  @brief  PlanarPseudoLayerPlugin class, assigning pseudo layers of fixed pitch along z
+ */
+class PlanarPseudoLayerPlugin : public pandora::PseudoLayerPlugin
+{
+public:
+    /**
+     *  @brief  Constructor
+     *
+     *  @param  layerPitch the pseudo layer pitch along z, units mm
+     */
+    PlanarPseudoLayerPlugin(const float layerPitch);
+
+    unsigned int GetPseudoLayer(const pandora::CartesianVector &positionVector) const;
+    unsigned int GetPseudoLayerAtIp() const;
+
+private:
+    pandora::StatusCode ReadSettings(const pandora::TiXmlHandle xmlHandle);
+
+    const float             m_layerPitch;       ///< The pseudo layer pitch along z, units mm
+};
+
+} // namespace pandora_benchmarks
+
+#endif // #ifndef PANDORA_PLANAR_PSEUDO_LAYER_PLUGIN_H
@@ -0,0 +1,56 @@
+/**
+ *  @file   PandoraSDK/benchmarks/include/SyntheticClusteringAlgorithm.h
+ *
+ *  @brief  Header file for the synthetic clustering algorithm class.
+ *
+ *  $Log: $
+ */
+#ifndef PANDORA_SYNTHETIC_CLUSTERING_ALGORITHM_H
+#define PANDORA_SYNTHETIC_CLUSTERING_ALGORITHM_H 1
+
+#include "Pandora/Algorithm.h"
+
+namespace pandora_benchmarks
+{
+
+/**
+ *  @brief  SyntheticClusteringAlgorithm class, a stand-in for a real clustering algorithm in replay workloads. Available calo hits are
+ *          grouped by hit type, by drift position window and by pseudo layer window; the first calo hit in each group creates a
+ *          cluster and each later calo hit is added to it. The clusters are saved as a named list, which becomes the current list.
+ */
+class SyntheticClusteringAlgorithm : public pandora::Algorithm
+{
+public:
+    /**
+     *  @brief  Factory class for instantiating algorithm
+     */
+    class Factory : public pandora::AlgorithmFactory
+    {
+    public:
+        pandora::Algorithm *CreateAlgorithm() const;
+    };
+
+    /**
+     *  @brief  Default constructor
+     */
+    SyntheticClusteringAlgorithm();
+
+private:
+    pandora::StatusCode Run();
+    pandora::StatusCode ReadSettings(const pandora::TiXmlHandle xmlHandle);
+
+    std::string         m_clusterListName;          ///< The name under which to save the clusters
+    unsigned int        m_layerWindow;              ///< The number of pseudo layers spanned by each group of calo hits
+    float               m_driftWindow;              ///< The range of drift (x) positions spanned by each group of calo hits, units mm
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline pandora::Algorithm *SyntheticClusteringAlgorithm::Factory::CreateAlgorithm() const
+{
+    return new SyntheticClusteringAlgorithm();
+}
+
+} // namespace pandora_benchmarks
+
+#endif // #ifndef PANDORA_SYNTHETIC_CLUSTERING_ALGORITHM_H
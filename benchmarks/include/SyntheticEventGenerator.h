@@ -0,0 +1,101 @@
+/**
+ *  @file   PandoraSDK/benchmarks/include/SyntheticEventGenerator.h
+ *
+ *  @brief  Header file for the synthetic event generator class.
+ *
+ *  $Log: $
+ */
+#ifndef PANDORA_SYNTHETIC_EVENT_GENERATOR_H
+#define PANDORA_SYNTHETIC_EVENT_GENERATOR_H 1
+
+#include "Pandora/StatusCodes.h"
+
+namespace pandora {class Algorithm; class FileWriter; class Pandora;}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+namespace pandora_benchmarks
+{
+
+/**
+ *  @brief  SyntheticEventGenerator class, creating large lar tpc events directly via the pandora api, for stress and scaling tests.
+ *          Each primary mc particle produces either a straight track of calo hits or an electromagnetic-like shower, whose calo hits
+ *          are shared with the daughter mc particles of the shower. Calo hits are created in the u, v and w views in turn, and each
+ *          is related to the mc particle that produced it. Tracks are related to the track-like primary mc particles. The same seed
+ *          and event number always give the same event.
+ */
+class SyntheticEventGenerator
+{
+public:
+    /**
+     *  @brief  Parameters class
+     */
+    class Parameters
+    {
+    public:
+        /**
+         *  @brief  Default constructor
+         */
+        Parameters();
+
+        unsigned int    m_nCaloHits;            ///< The number of calo hits, shared equally between the primary mc particles
+        unsigned int    m_nTracks;              ///< The number of tracks
+        unsigned int    m_nMCParticles;         ///< The number of primary mc particles
+        unsigned int    m_nShowerDaughters;     ///< The number of daughter mc particles for each shower
+        unsigned int    m_nLArTPCs;             ///< The number of lar tpcs, placed side by side in x
+        float           m_showerFraction;       ///< The probability that a primary mc particle produces a shower, rather than a track
+        float           m_hitSpacing;           ///< The spacing of the calo hits along a track, units mm
+        unsigned int    m_seed;                 ///< The random number seed
+    };
+
+    /**
+     *  @brief  Constructor
+     *
+     *  @param  parameters the generator parameters
+     */
+    SyntheticEventGenerator(const Parameters &parameters);
+
+    /**
+     *  @brief  Get the generator parameters
+     *
+     *  @return the generator parameters
+     */
+    const Parameters &GetParameters() const;
+
+    /**
+     *  @brief  Create the lar tpcs, which must be done once for each pandora instance, before creating any events
+     *
+     *  @param  pandora the pandora instance
+     */
+    pandora::StatusCode CreateGeometry(const pandora::Pandora &pandora) const;
+
+    /**
+     *  @brief  Create the calo hits, tracks, mc particles and relationships for a synthetic event
+     *
+     *  @param  pandora the pandora instance
+     *  @param  eventNumber the event number, combined with the seed to give a different event for each event number
+     */
+    pandora::StatusCode CreateEvent(const pandora::Pandora &pandora, const unsigned int eventNumber = 0) const;
+
+    /**
+     *  @brief  Write the current calo hits, tracks and mc particles, with their relationships, to a file
+     *
+     *  @param  algorithm the algorithm, providing access to the current lists
+     *  @param  fileWriter the file writer
+     */
+    static pandora::StatusCode WriteEvent(const pandora::Algorithm &algorithm, pandora::FileWriter &fileWriter);
+
+private:
+    const Parameters    m_parameters;           ///< The generator parameters
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const SyntheticEventGenerator::Parameters &SyntheticEventGenerator::GetParameters() const
+{
+    return m_parameters;
+}
+
+} // namespace pandora_benchmarks
+
+#endif // #ifndef PANDORA_SYNTHETIC_EVENT_GENERATOR_H
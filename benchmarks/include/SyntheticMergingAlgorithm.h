@@ -0,0 +1,55 @@
+/**
+ *  @file   PandoraSDK/benchmarks/include/SyntheticMergingAlgorithm.h
+ *
+ *  @brief  Header file for the synthetic merging algorithm class.
+ *
+ *  $Log: $
+ */
+#ifndef PANDORA_SYNTHETIC_MERGING_ALGORITHM_H
+#define PANDORA_SYNTHETIC_MERGING_ALGORITHM_H 1
+
+#include "Pandora/Algorithm.h"
+
+namespace pandora_benchmarks
+{
+
+/**
+ *  @brief  SyntheticMergingAlgorithm class, a stand-in for a real cluster merging algorithm in replay workloads. Clusters in the current
+ *          list are considered in order of inner pseudo layer. A cluster absorbs any later cluster of the same hit type that starts
+ *          within a few pseudo layers of its outer layer, with an inner layer centroid close to its outer layer centroid.
+ */
+class SyntheticMergingAlgorithm : public pandora::Algorithm
+{
+public:
+    /**
+     *  @brief  Factory class for instantiating algorithm
+     */
+    class Factory : public pandora::AlgorithmFactory
+    {
+    public:
+        pandora::Algorithm *CreateAlgorithm() const;
+    };
+
+    /**
+     *  @brief  Default constructor
+     */
+    SyntheticMergingAlgorithm();
+
+private:
+    pandora::StatusCode Run();
+    pandora::StatusCode ReadSettings(const pandora::TiXmlHandle xmlHandle);
+
+    unsigned int        m_maxLayerGap;              ///< The maximum gap between the outer and inner pseudo layers of merged clusters
+    float               m_maxMergeDistance;         ///< The maximum distance between the outer and inner layer centroids, units mm
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline pandora::Algorithm *SyntheticMergingAlgorithm::Factory::CreateAlgorithm() const
+{
+    return new SyntheticMergingAlgorithm();
+}
+
+} // namespace pandora_benchmarks
+
+#endif // #ifndef PANDORA_SYNTHETIC_MERGING_ALGORITHM_H
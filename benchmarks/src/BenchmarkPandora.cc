@@ -0,0 +1,65 @@
+/**
+ *  @file   PandoraSDK/benchmarks/src/BenchmarkPandora.cc
+ *
+ *  @brief  Implementation of the benchmark pandora class.
+ *
+ *  $Log: $
+ */
+
+#include "Api/PandoraApi.h"
+
+#include "BenchmarkPandora.h"
+
+#include <algorithm>
+
+using namespace pandora;
+
+namespace pandora_benchmarks
+{
+
+BenchmarkPandora::BenchmarkPandora(const float layerPitch) :
+    CallbackPandora(layerPitch)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode BenchmarkPandora::CreateSyntheticEvent(const unsigned int nCaloHits)
+{
+    const SyntheticEventGenerator syntheticEventGenerator(BenchmarkPandora::GetSyntheticEventParameters(nCaloHits));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, syntheticEventGenerator.CreateGeometry(this->GetPandora()));
+    return syntheticEventGenerator.CreateEvent(this->GetPandora());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void BenchmarkPandora::Run(benchmark::State &state, const Callback &callback)
+{
+    if (BenchmarkPandora::Check(state, this->ProcessEvent(callback)))
+        (void) BenchmarkPandora::Check(state, this->Reset());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+SyntheticEventGenerator::Parameters BenchmarkPandora::GetSyntheticEventParameters(const unsigned int nCaloHits)
+{
+    SyntheticEventGenerator::Parameters parameters;
+    parameters.m_nCaloHits = nCaloHits;
+    parameters.m_nTracks = std::max(1u, nCaloHits / 1000);
+    parameters.m_nMCParticles = std::max(1u, nCaloHits / 1000);
+
+    return parameters;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool BenchmarkPandora::Check(benchmark::State &state, const StatusCode statusCode)
+{
+    if (STATUS_CODE_SUCCESS == statusCode)
+        return true;
+
+    state.SkipWithError(StatusCodeToString(statusCode).c_str());
+    return false;
+}
+
+} // namespace pandora_benchmarks
@@ -0,0 +1,123 @@
+/**
+ *  @file   PandoraSDK/benchmarks/src/CallbackPandora.cc
+ *
+ *  @brief  Implementation of the callback pandora class.
+ *
+ *  $Log: $
+ */
+
+#include "Api/PandoraApi.h"
+
+#include "Xml/tinyxml.h"
+
+#include "CallbackPandora.h"
+#include "PlanarPseudoLayerPlugin.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <unistd.h>
+
+using namespace pandora;
+
+namespace pandora_benchmarks
+{
+
+CallbackPandora::CallbackPandora(const float layerPitch) :
+    m_pPandora(new Pandora("PandoraSDKBenchmarks"))
+{
+    try
+    {
+        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraApi::RegisterAlgorithmFactory(*m_pPandora, "Callback",
+            new CallbackAlgorithm::Factory(m_callback)));
+        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraApi::SetPseudoLayerPlugin(*m_pPandora, new PlanarPseudoLayerPlugin(layerPitch)));
+
+        const std::string settingsFileName((std::filesystem::temp_directory_path() / ("PandoraSDKBenchmarks_" +
+            std::to_string(::getpid()) + "_" + std::to_string(reinterpret_cast<std::uintptr_t>(this)) + ".xml")).string());
+
+        {
+            std::ofstream settingsFile(settingsFileName);
+            settingsFile << "<pandora>\n    <algorithm type = \"Callback\"/>\n</pandora>\n";
+        }
+
+        const StatusCode statusCode(PandoraApi::ReadSettings(*m_pPandora, settingsFileName));
+        std::remove(settingsFileName.c_str());
+
+        if (STATUS_CODE_SUCCESS != statusCode)
+            throw StatusCodeException(statusCode);
+    }
+    catch (StatusCodeException &)
+    {
+        delete m_pPandora;
+        throw;
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+CallbackPandora::~CallbackPandora()
+{
+    delete m_pPandora;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode CallbackPandora::ProcessEvent(const Callback &callback)
+{
+    m_callback = callback;
+    const StatusCode statusCode(PandoraApi::ProcessEvent(*m_pPandora));
+    m_callback = nullptr;
+
+    return statusCode;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode CallbackPandora::Reset()
+{
+    return PandoraApi::Reset(*m_pPandora);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+CallbackPandora::CallbackAlgorithm::Factory::Factory(const Callback &callback) :
+    m_callback(callback)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+Algorithm *CallbackPandora::CallbackAlgorithm::Factory::CreateAlgorithm() const
+{
+    return new CallbackAlgorithm(m_callback);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+CallbackPandora::CallbackAlgorithm::CallbackAlgorithm(const Callback &callback) :
+    m_callback(callback)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode CallbackPandora::CallbackAlgorithm::Run()
+{
+    if (!m_callback)
+        return STATUS_CODE_NOT_INITIALIZED;
+
+    return m_callback(*this);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode CallbackPandora::CallbackAlgorithm::ReadSettings(const TiXmlHandle)
+{
+    return STATUS_CODE_SUCCESS;
+}
+
+} // namespace pandora_benchmarks
@@ -0,0 +1,415 @@
+/**
+ *  @file   PandoraSDK/benchmarks/src/ClusterBenchmarks.cc
+ *
+ *  @brief  Micro-benchmarks for cluster creation and removal, the cluster fit accumulators and the cluster fit helper.
+ *
+ *  $Log: $
+ */
+
+#include "Api/PandoraContentApi.h"
+
+#include "Helpers/ClusterFitHelper.h"
+
+#include "Objects/CaloHit.h"
+#include "Objects/Cluster.h"
+
+#include "BenchmarkPandora.h"
+
+using namespace pandora;
+using namespace pandora_benchmarks;
+
+namespace
+{
+
+/**
+ *  @brief  Get the first calo hits in the current calo hit list
+ *
+ *  @param  algorithm the algorithm
+ *  @param  nCaloHits the number of calo hits
+ *  @param  caloHitList to receive the calo hits
+ */
+StatusCode GetCaloHits(const Algorithm &algorithm, const unsigned int nCaloHits, CaloHitList &caloHitList)
+{
+    const CaloHitList *pCaloHitList(nullptr);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::GetCurrentList(algorithm, pCaloHitList));
+
+    for (const CaloHit *const pCaloHit : *pCaloHitList)
+    {
+        if (caloHitList.size() == nCaloHits)
+            break;
+
+        caloHitList.push_back(pCaloHit);
+    }
+
+    return ((caloHitList.size() == nCaloHits) ? STATUS_CODE_SUCCESS : STATUS_CODE_OUT_OF_RANGE);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Create a cluster in a new temporary cluster list
+ *
+ *  @param  algorithm the algorithm
+ *  @param  caloHitList the calo hits to include
+ *  @param  pCluster to receive the address of the cluster
+ */
+StatusCode CreateCluster(const Algorithm &algorithm, const CaloHitList &caloHitList, const Cluster *&pCluster)
+{
+    const ClusterList *pClusterList(nullptr);
+    std::string clusterListName;
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::CreateTemporaryListAndSetCurrent(algorithm, pClusterList, clusterListName));
+
+    PandoraContentApi::Cluster::Parameters parameters;
+    parameters.m_caloHitList = caloHitList;
+    return PandoraContentApi::Cluster::Create(algorithm, parameters, pCluster);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Create a cluster for each calo hit in a new temporary cluster list
+ *
+ *  @param  algorithm the algorithm
+ *  @param  caloHitList the calo hits
+ *  @param  clusterVector to receive the addresses of the clusters, in creation order
+ */
+StatusCode CreateSingleHitClusters(const Algorithm &algorithm, const CaloHitList &caloHitList, ClusterVector &clusterVector)
+{
+    const ClusterList *pClusterList(nullptr);
+    std::string clusterListName;
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::CreateTemporaryListAndSetCurrent(algorithm, pClusterList, clusterListName));
+
+    clusterVector.reserve(caloHitList.size());
+
+    for (const CaloHit *const pCaloHit : caloHitList)
+    {
+        PandoraContentApi::Cluster::Parameters parameters;
+        parameters.m_caloHitList.push_back(pCaloHit);
+
+        const Cluster *pCluster(nullptr);
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::Cluster::Create(algorithm, parameters, pCluster));
+        clusterVector.push_back(pCluster);
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Delete the clusters remaining in the current cluster list, releasing their calo hits
+ *
+ *  @param  algorithm the algorithm
+ */
+StatusCode DeleteRemainingClusters(const Algorithm &algorithm)
+{
+    const ClusterList *pClusterList(nullptr);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::GetCurrentList(algorithm, pClusterList));
+
+    const ClusterList remainingClusters(*pClusterList);
+    return PandoraContentApi::Delete(algorithm, &remainingClusters);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Create, then delete, a cluster holding a specified number of calo hits, filling its per pseudo layer fit accumulators
+ */
+void BM_Cluster_CreateAndDelete(benchmark::State &state)
+{
+    const unsigned int nCaloHits(static_cast<unsigned int>(state.range(0)));
+    BenchmarkPandora benchmarkPandora;
+
+    if (!BenchmarkPandora::Check(state, benchmarkPandora.CreateSyntheticEvent(nCaloHits)))
+        return;
+
+    benchmarkPandora.Run(state, [&state, nCaloHits](const Algorithm &algorithm) -> StatusCode
+    {
+        CaloHitList caloHitList;
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, GetCaloHits(algorithm, nCaloHits, caloHitList));
+
+        const ClusterList *pClusterList(nullptr);
+        std::string clusterListName;
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::CreateTemporaryListAndSetCurrent(algorithm, pClusterList, clusterListName));
+
+        PandoraContentApi::Cluster::Parameters parameters;
+        parameters.m_caloHitList = caloHitList;
+
+        for (auto _ : state)
+        {
+            const Cluster *pCluster(nullptr);
+            PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::Cluster::Create(algorithm, parameters, pCluster));
+            PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::Delete(algorithm, pCluster));
+        }
+
+        state.SetItemsProcessed(state.iterations() * nCaloHits);
+        return STATUS_CODE_SUCCESS;
+    });
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Grow a cluster one calo hit at a time, updating its fit accumulators, then delete it
+ */
+void BM_Cluster_AddToCluster(benchmark::State &state)
+{
+    const unsigned int nCaloHits(static_cast<unsigned int>(state.range(0)));
+    BenchmarkPandora benchmarkPandora;
+
+    if (!BenchmarkPandora::Check(state, benchmarkPandora.CreateSyntheticEvent(nCaloHits)))
+        return;
+
+    benchmarkPandora.Run(state, [&state, nCaloHits](const Algorithm &algorithm) -> StatusCode
+    {
+        CaloHitList caloHitList;
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, GetCaloHits(algorithm, nCaloHits, caloHitList));
+
+        const ClusterList *pClusterList(nullptr);
+        std::string clusterListName;
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::CreateTemporaryListAndSetCurrent(algorithm, pClusterList, clusterListName));
+
+        PandoraContentApi::Cluster::Parameters parameters;
+        parameters.m_caloHitList.push_back(*caloHitList.begin());
+
+        for (auto _ : state)
+        {
+            const Cluster *pCluster(nullptr);
+            PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::Cluster::Create(algorithm, parameters, pCluster));
+
+            for (CaloHitList::const_iterator iter = std::next(caloHitList.begin()); iter != caloHitList.end(); ++iter)
+                PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::AddToCluster(algorithm, pCluster, *iter));
+
+            PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::Delete(algorithm, pCluster));
+        }
+
+        state.SetItemsProcessed(state.iterations() * nCaloHits);
+        return STATUS_CODE_SUCCESS;
+    });
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Accumulate the fit moment sums for a set of calo hits
+ */
+void BM_ClusterFitAccumulator_Add(benchmark::State &state)
+{
+    const unsigned int nCaloHits(static_cast<unsigned int>(state.range(0)));
+    BenchmarkPandora benchmarkPandora;
+
+    if (!BenchmarkPandora::Check(state, benchmarkPandora.CreateSyntheticEvent(nCaloHits)))
+        return;
+
+    benchmarkPandora.Run(state, [&state, nCaloHits](const Algorithm &algorithm) -> StatusCode
+    {
+        CaloHitList caloHitList;
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, GetCaloHits(algorithm, nCaloHits, caloHitList));
+
+        for (auto _ : state)
+        {
+            ClusterFitAccumulator clusterFitAccumulator;
+
+            for (const CaloHit *const pCaloHit : caloHitList)
+                clusterFitAccumulator.Add(pCaloHit);
+
+            benchmark::DoNotOptimize(clusterFitAccumulator.GetFitWeightSum());
+        }
+
+        state.SetItemsProcessed(state.iterations() * nCaloHits);
+        return STATUS_CODE_SUCCESS;
+    });
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Fit all of the calo hits in a cluster
+ */
+void BM_ClusterFitHelper_FitFullCluster(benchmark::State &state)
+{
+    const unsigned int nCaloHits(static_cast<unsigned int>(state.range(0)));
+    BenchmarkPandora benchmarkPandora;
+
+    if (!BenchmarkPandora::Check(state, benchmarkPandora.CreateSyntheticEvent(nCaloHits)))
+        return;
+
+    benchmarkPandora.Run(state, [&state, nCaloHits](const Algorithm &algorithm) -> StatusCode
+    {
+        CaloHitList caloHitList;
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, GetCaloHits(algorithm, nCaloHits, caloHitList));
+
+        const Cluster *pCluster(nullptr);
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, CreateCluster(algorithm, caloHitList, pCluster));
+
+        for (auto _ : state)
+        {
+            ClusterFitResult clusterFitResult;
+            PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, ClusterFitHelper::FitFullCluster(pCluster, clusterFitResult));
+            benchmark::DoNotOptimize(clusterFitResult.GetChi2());
+        }
+
+        state.SetItemsProcessed(state.iterations() * nCaloHits);
+        return STATUS_CODE_SUCCESS;
+    });
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Fit the calo hits in the first occupied pseudo layers of a cluster
+ */
+void BM_ClusterFitHelper_FitStart(benchmark::State &state)
+{
+    const unsigned int nCaloHits(static_cast<unsigned int>(state.range(0)));
+    BenchmarkPandora benchmarkPandora;
+
+    if (!BenchmarkPandora::Check(state, benchmarkPandora.CreateSyntheticEvent(nCaloHits)))
+        return;
+
+    benchmarkPandora.Run(state, [&state, nCaloHits](const Algorithm &algorithm) -> StatusCode
+    {
+        CaloHitList caloHitList;
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, GetCaloHits(algorithm, nCaloHits, caloHitList));
+
+        const Cluster *pCluster(nullptr);
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, CreateCluster(algorithm, caloHitList, pCluster));
+
+        for (auto _ : state)
+        {
+            ClusterFitResult clusterFitResult;
+            PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, ClusterFitHelper::FitStart(pCluster, 20, clusterFitResult));
+            benchmark::DoNotOptimize(clusterFitResult.GetChi2());
+        }
+
+        return STATUS_CODE_SUCCESS;
+    });
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Fit a list of cluster fit points
+ */
+void BM_ClusterFitHelper_FitPoints(benchmark::State &state)
+{
+    const unsigned int nCaloHits(static_cast<unsigned int>(state.range(0)));
+    BenchmarkPandora benchmarkPandora;
+
+    if (!BenchmarkPandora::Check(state, benchmarkPandora.CreateSyntheticEvent(nCaloHits)))
+        return;
+
+    benchmarkPandora.Run(state, [&state, nCaloHits](const Algorithm &algorithm) -> StatusCode
+    {
+        CaloHitList caloHitList;
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, GetCaloHits(algorithm, nCaloHits, caloHitList));
+
+        ClusterFitPointList clusterFitPointList;
+
+        for (const CaloHit *const pCaloHit : caloHitList)
+            clusterFitPointList.push_back(ClusterFitPoint(pCaloHit));
+
+        for (auto _ : state)
+        {
+            ClusterFitResult clusterFitResult;
+            PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, ClusterFitHelper::FitPoints(clusterFitPointList, clusterFitResult));
+            benchmark::DoNotOptimize(clusterFitResult.GetChi2());
+        }
+
+        state.SetItemsProcessed(state.iterations() * nCaloHits);
+        return STATUS_CODE_SUCCESS;
+    });
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Delete every other cluster from a large cluster list, one cluster at a time, creating the clusters outside the timed region
+ */
+void BM_ClusterList_DeleteClusters(benchmark::State &state)
+{
+    const unsigned int nClusters(static_cast<unsigned int>(state.range(0)));
+    BenchmarkPandora benchmarkPandora;
+
+    if (!BenchmarkPandora::Check(state, benchmarkPandora.CreateSyntheticEvent(nClusters)))
+        return;
+
+    benchmarkPandora.Run(state, [&state, nClusters](const Algorithm &algorithm) -> StatusCode
+    {
+        CaloHitList caloHitList;
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, GetCaloHits(algorithm, nClusters, caloHitList));
+
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            ClusterVector clusterVector;
+            PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, CreateSingleHitClusters(algorithm, caloHitList, clusterVector));
+            state.ResumeTiming();
+
+            for (unsigned int iCluster = 0; iCluster < nClusters; iCluster += 2)
+                PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::Delete(algorithm, clusterVector.at(iCluster)));
+
+            state.PauseTiming();
+            PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, DeleteRemainingClusters(algorithm));
+            state.ResumeTiming();
+        }
+
+        state.SetItemsProcessed(state.iterations() * ((nClusters + 1) / 2));
+        return STATUS_CODE_SUCCESS;
+    });
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Delete every other cluster from a large cluster list, as a single list of clusters, creating the clusters outside the timed
+ *          region
+ */
+void BM_ClusterList_DeleteClusterList(benchmark::State &state)
+{
+    const unsigned int nClusters(static_cast<unsigned int>(state.range(0)));
+    BenchmarkPandora benchmarkPandora;
+
+    if (!BenchmarkPandora::Check(state, benchmarkPandora.CreateSyntheticEvent(nClusters)))
+        return;
+
+    benchmarkPandora.Run(state, [&state, nClusters](const Algorithm &algorithm) -> StatusCode
+    {
+        CaloHitList caloHitList;
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, GetCaloHits(algorithm, nClusters, caloHitList));
+
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            ClusterVector clusterVector;
+            PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, CreateSingleHitClusters(algorithm, caloHitList, clusterVector));
+
+            ClusterList clustersToDelete;
+
+            for (unsigned int iCluster = 0; iCluster < nClusters; iCluster += 2)
+                clustersToDelete.push_back(clusterVector.at(iCluster));
+
+            state.ResumeTiming();
+
+            PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::Delete(algorithm, &clustersToDelete));
+
+            state.PauseTiming();
+            PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, DeleteRemainingClusters(algorithm));
+            state.ResumeTiming();
+        }
+
+        state.SetItemsProcessed(state.iterations() * ((nClusters + 1) / 2));
+        return STATUS_CODE_SUCCESS;
+    });
+}
+
+} // namespace
+
+BENCHMARK(BM_Cluster_CreateAndDelete)->RangeMultiplier(10)->Range(1000, 100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Cluster_AddToCluster)->RangeMultiplier(10)->Range(1000, 100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ClusterFitAccumulator_Add)->RangeMultiplier(10)->Range(10000, 1000000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ClusterFitHelper_FitFullCluster)->RangeMultiplier(10)->Range(1000, 100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ClusterFitHelper_FitStart)->RangeMultiplier(10)->Range(1000, 100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ClusterFitHelper_FitPoints)->RangeMultiplier(10)->Range(10000, 1000000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ClusterList_DeleteClusters)->RangeMultiplier(10)->Range(10000, 1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ClusterList_DeleteClusterList)->RangeMultiplier(10)->Range(10000, 1000000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,77 @@
+/**
+ *  @file   PandoraSDK/benchmarks/src/EventBenchmarks.cc
+ *
+ *  @brief  Micro-benchmarks for the creation and reset of synthetic events, measuring how the managers scale with event size.
+ *
+ *  $Log: $
+ */
+
+#include "BenchmarkPandora.h"
+#include "SyntheticEventGenerator.h"
+
+using namespace pandora;
+using namespace pandora_benchmarks;
+
+namespace
+{
+
+/**
+ *  @brief  Create the calo hits, tracks, mc particles and relationships for a synthetic event, then reset the event outside the timed
+ *          region. The time includes generation of the object parameters.
+ */
+void BM_Event_Create(benchmark::State &state)
+{
+    const unsigned int nCaloHits(static_cast<unsigned int>(state.range(0)));
+    const SyntheticEventGenerator syntheticEventGenerator(BenchmarkPandora::GetSyntheticEventParameters(nCaloHits));
+    BenchmarkPandora benchmarkPandora;
+
+    if (!BenchmarkPandora::Check(state, syntheticEventGenerator.CreateGeometry(benchmarkPandora.GetPandora())))
+        return;
+
+    for (auto _ : state)
+    {
+        if (!BenchmarkPandora::Check(state, syntheticEventGenerator.CreateEvent(benchmarkPandora.GetPandora())))
+            break;
+
+        state.PauseTiming();
+        const StatusCode statusCode(benchmarkPandora.Reset());
+        state.ResumeTiming();
+
+        if (!BenchmarkPandora::Check(state, statusCode))
+            break;
+    }
+
+    state.SetItemsProcessed(state.iterations() * nCaloHits);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Reset a synthetic event, deleting all of its objects, having created the event outside the timed region
+ */
+void BM_Event_Reset(benchmark::State &state)
+{
+    const unsigned int nCaloHits(static_cast<unsigned int>(state.range(0)));
+    const SyntheticEventGenerator syntheticEventGenerator(BenchmarkPandora::GetSyntheticEventParameters(nCaloHits));
+    BenchmarkPandora benchmarkPandora;
+
+    if (!BenchmarkPandora::Check(state, syntheticEventGenerator.CreateGeometry(benchmarkPandora.GetPandora())))
+        return;
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        const StatusCode statusCode(syntheticEventGenerator.CreateEvent(benchmarkPandora.GetPandora()));
+        state.ResumeTiming();
+
+        if (!BenchmarkPandora::Check(state, statusCode) || !BenchmarkPandora::Check(state, benchmarkPandora.Reset()))
+            break;
+    }
+
+    state.SetItemsProcessed(state.iterations() * nCaloHits);
+}
+
+} // namespace
+
+BENCHMARK(BM_Event_Create)->RangeMultiplier(10)->Range(10000, 1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Event_Reset)->RangeMultiplier(10)->Range(10000, 1000000)->Unit(benchmark::kMillisecond);
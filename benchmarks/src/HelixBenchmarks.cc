@@ -0,0 +1,144 @@
+/**
+ *  @file   PandoraSDK/benchmarks/src/HelixBenchmarks.cc
+ *
+ *  @brief  Micro-benchmarks for helix construction and propagation.
+ *
+ *  $Log: $
+ */
+
+#include "Objects/Helix.h"
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+using namespace pandora;
+
+namespace
+{
+
+const float BFIELD(3.5f);                       ///< The magnetic field, units Tesla
+const CartesianVector REFERENCE_POINT(0.f, 0.f, 0.f); ///< The reference point for the propagation benchmarks
+
+/**
+ *  @brief  Get a helix describing a low momentum track, curling within the range of the propagation benchmarks
+ *
+ *  @return the helix
+ */
+Helix GetHelix()
+{
+    return Helix(CartesianVector(1.f, 2.f, 3.f), CartesianVector(1.2f, 0.7f, 0.9f), 1.f, BFIELD);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Construct a helix from a position and momentum
+ */
+void BM_Helix_Construct(benchmark::State &state)
+{
+    const CartesianVector position(1.f, 2.f, 3.f), momentum(1.2f, 0.7f, 0.9f);
+
+    for (auto _ : state)
+    {
+        const Helix helix(position, momentum, 1.f, BFIELD);
+        benchmark::DoNotOptimize(helix.GetOmega());
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Find the intersection of a helix with a cylinder
+ */
+void BM_Helix_GetPointOnCircle(benchmark::State &state)
+{
+    const Helix helix(GetHelix());
+
+    for (auto _ : state)
+    {
+        CartesianVector intersectionPoint(0.f, 0.f, 0.f);
+        benchmark::DoNotOptimize(helix.GetPointOnCircle(100.f, REFERENCE_POINT, intersectionPoint));
+        benchmark::DoNotOptimize(intersectionPoint);
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Find the intersection of a helix with a plane of constant z
+ */
+void BM_Helix_GetPointInZ(benchmark::State &state)
+{
+    const Helix helix(GetHelix());
+
+    for (auto _ : state)
+    {
+        CartesianVector intersectionPoint(0.f, 0.f, 0.f);
+        benchmark::DoNotOptimize(helix.GetPointInZ(100.f, REFERENCE_POINT, intersectionPoint));
+        benchmark::DoNotOptimize(intersectionPoint);
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Find the distance of closest approach of a helix to a single point
+ */
+void BM_Helix_GetDistanceToPoint(benchmark::State &state)
+{
+    const Helix helix(GetHelix());
+    const CartesianVector point(50.f, -20.f, 30.f);
+
+    for (auto _ : state)
+    {
+        CartesianVector distance(0.f, 0.f, 0.f);
+        benchmark::DoNotOptimize(helix.GetDistanceToPoint(point, distance));
+        benchmark::DoNotOptimize(distance);
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Find the distances of closest approach of a helix to a batch of points
+ */
+void BM_Helix_GetDistanceToPoints(benchmark::State &state)
+{
+    const unsigned int nPoints(static_cast<unsigned int>(state.range(0)));
+    const Helix helix(GetHelix());
+
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<float> distribution(-500.f, 500.f);
+    FloatVector x(nPoints), y(nPoints), z(nPoints);
+
+    for (unsigned int iPoint = 0; iPoint < nPoints; ++iPoint)
+    {
+        x[iPoint] = distribution(generator);
+        y[iPoint] = distribution(generator);
+        z[iPoint] = distribution(generator);
+    }
+
+    FloatVector distanceXY, distanceZ, distance3D, genericTime;
+
+    for (auto _ : state)
+    {
+        if (STATUS_CODE_SUCCESS != helix.GetDistanceToPoints(x, y, z, distanceXY, distanceZ, distance3D, genericTime))
+        {
+            state.SkipWithError("GetDistanceToPoints failed");
+            break;
+        }
+
+        benchmark::DoNotOptimize(distance3D.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * nPoints);
+}
+
+} // namespace
+
+BENCHMARK(BM_Helix_Construct);
+BENCHMARK(BM_Helix_GetPointOnCircle);
+BENCHMARK(BM_Helix_GetPointInZ);
+BENCHMARK(BM_Helix_GetDistanceToPoint);
+BENCHMARK(BM_Helix_GetDistanceToPoints)->RangeMultiplier(10)->Range(10000, 1000000)->Unit(benchmark::kMicrosecond);
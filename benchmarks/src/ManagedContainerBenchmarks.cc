@@ -0,0 +1,197 @@
+/**
+ *  @file   PandoraSDK/benchmarks/src/ManagedContainerBenchmarks.cc
+ *
+ *  @brief  Micro-benchmarks comparing the managed container choices, std::list, MyList and ContiguousList, for calo hit pointers.
+ *
+ *  $Log: $
+ */
+
+#include "Api/PandoraContentApi.h"
+
+#include "Objects/CaloHit.h"
+
+#include "BenchmarkPandora.h"
+
+#include <list>
+
+using namespace pandora;
+using namespace pandora_benchmarks;
+
+namespace
+{
+
+/**
+ *  @brief  Copy the current calo hit list to a calo hit vector, in list order
+ *
+ *  @param  algorithm the algorithm
+ *  @param  caloHitVector to receive the calo hits
+ */
+StatusCode GetCaloHits(const Algorithm &algorithm, CaloHitVector &caloHitVector)
+{
+    const CaloHitList *pCaloHitList(nullptr);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::GetCurrentList(algorithm, pCaloHitList));
+
+    caloHitVector.insert(caloHitVector.end(), pCaloHitList->begin(), pCaloHitList->end());
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Label a benchmark with whether its container checks for duplicate entries, which for MyList follows the build options
+ *
+ *  @param  state the benchmark state
+ */
+template <typename TContainer>
+void SetContainerLabel(benchmark::State &state)
+{
+    (void) state;
+}
+
+template <>
+void SetContainerLabel<MyList<const CaloHit *> >(benchmark::State &state)
+{
+    state.SetLabel(PANDORA_MYLIST_DUPLICATE_CHECK ? "duplicate check" : "no duplicate check");
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Fill a container with the calo hits of the event, one push_back at a time
+ */
+template <typename TContainer>
+void BM_ManagedContainer_PushBack(benchmark::State &state)
+{
+    BenchmarkPandora benchmarkPandora;
+
+    if (!BenchmarkPandora::Check(state, benchmarkPandora.CreateSyntheticEvent(static_cast<unsigned int>(state.range(0)))))
+        return;
+
+    SetContainerLabel<TContainer>(state);
+
+    benchmarkPandora.Run(state, [&state](const Algorithm &algorithm) -> StatusCode
+    {
+        CaloHitVector caloHitVector;
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, GetCaloHits(algorithm, caloHitVector));
+
+        for (auto _ : state)
+        {
+            TContainer container;
+
+            for (const CaloHit *const pCaloHit : caloHitVector)
+                container.push_back(pCaloHit);
+
+            benchmark::DoNotOptimize(container.size());
+        }
+
+        state.SetItemsProcessed(state.iterations() * caloHitVector.size());
+        return STATUS_CODE_SUCCESS;
+    });
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Visit every calo hit in a filled container, reading a property of each calo hit
+ */
+template <typename TContainer>
+void BM_ManagedContainer_Iterate(benchmark::State &state)
+{
+    BenchmarkPandora benchmarkPandora;
+
+    if (!BenchmarkPandora::Check(state, benchmarkPandora.CreateSyntheticEvent(static_cast<unsigned int>(state.range(0)))))
+        return;
+
+    SetContainerLabel<TContainer>(state);
+
+    benchmarkPandora.Run(state, [&state](const Algorithm &algorithm) -> StatusCode
+    {
+        CaloHitVector caloHitVector;
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, GetCaloHits(algorithm, caloHitVector));
+
+        TContainer container;
+
+        for (const CaloHit *const pCaloHit : caloHitVector)
+            container.push_back(pCaloHit);
+
+        for (auto _ : state)
+        {
+            float energySum(0.f);
+
+            for (const CaloHit *const pCaloHit : container)
+                energySum += pCaloHit->GetMipEquivalentEnergy();
+
+            benchmark::DoNotOptimize(energySum);
+        }
+
+        state.SetItemsProcessed(state.iterations() * caloHitVector.size());
+        return STATUS_CODE_SUCCESS;
+    });
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Erase every tenth calo hit from a filled container in a single forward pass, refilling the container outside the timed region
+ */
+template <typename TContainer>
+void BM_ManagedContainer_Erase(benchmark::State &state)
+{
+    BenchmarkPandora benchmarkPandora;
+
+    if (!BenchmarkPandora::Check(state, benchmarkPandora.CreateSyntheticEvent(static_cast<unsigned int>(state.range(0)))))
+        return;
+
+    SetContainerLabel<TContainer>(state);
+
+    benchmarkPandora.Run(state, [&state](const Algorithm &algorithm) -> StatusCode
+    {
+        CaloHitVector caloHitVector;
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, GetCaloHits(algorithm, caloHitVector));
+
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            TContainer container;
+
+            for (const CaloHit *const pCaloHit : caloHitVector)
+                container.push_back(pCaloHit);
+
+            state.ResumeTiming();
+
+            unsigned int index(0);
+
+            for (typename TContainer::const_iterator iter = container.begin(); iter != container.end(); )
+            {
+                if (0 == index++ % 10)
+                {
+                    iter = container.erase(iter);
+                }
+                else
+                {
+                    ++iter;
+                }
+            }
+
+            benchmark::DoNotOptimize(container.size());
+        }
+
+        state.SetItemsProcessed(state.iterations() * ((caloHitVector.size() + 9) / 10));
+        return STATUS_CODE_SUCCESS;
+    });
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_ManagedContainer_PushBack, std::list<const CaloHit *>)->RangeMultiplier(10)->Range(10000, 1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ManagedContainer_PushBack, MyList<const CaloHit *>)->RangeMultiplier(10)->Range(10000, 1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ManagedContainer_PushBack, ContiguousList<const CaloHit *>)->RangeMultiplier(10)->Range(10000, 1000000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_ManagedContainer_Iterate, std::list<const CaloHit *>)->RangeMultiplier(10)->Range(10000, 1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ManagedContainer_Iterate, MyList<const CaloHit *>)->RangeMultiplier(10)->Range(10000, 1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ManagedContainer_Iterate, ContiguousList<const CaloHit *>)->RangeMultiplier(10)->Range(10000, 1000000)->Unit(benchmark::kMillisecond);
+
+// ATTN Erasing from the middle of a ContiguousList is linear in its size, so the largest events are omitted
+BENCHMARK_TEMPLATE(BM_ManagedContainer_Erase, std::list<const CaloHit *>)->RangeMultiplier(10)->Range(1000, 100000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ManagedContainer_Erase, MyList<const CaloHit *>)->RangeMultiplier(10)->Range(1000, 100000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ManagedContainer_Erase, ContiguousList<const CaloHit *>)->RangeMultiplier(10)->Range(1000, 100000)->Unit(benchmark::kMillisecond);
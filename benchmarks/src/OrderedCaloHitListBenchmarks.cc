@@ -0,0 +1,133 @@
+/**
+ *  @file   PandoraSDK/benchmarks/src/OrderedCaloHitListBenchmarks.cc
+ *
+ *  @brief  Micro-benchmarks for the ordered calo hit list.
+ *
+ *  $Log: $
+ */
+
+#include "Api/PandoraContentApi.h"
+
+#include "Objects/CaloHit.h"
+#include "Objects/OrderedCaloHitList.h"
+
+#include "BenchmarkPandora.h"
+
+using namespace pandora;
+using namespace pandora_benchmarks;
+
+namespace
+{
+
+/**
+ *  @brief  Fill an ordered calo hit list from the current calo hit list
+ */
+void BM_OrderedCaloHitList_Add(benchmark::State &state)
+{
+    BenchmarkPandora benchmarkPandora;
+
+    if (!BenchmarkPandora::Check(state, benchmarkPandora.CreateSyntheticEvent(static_cast<unsigned int>(state.range(0)))))
+        return;
+
+    benchmarkPandora.Run(state, [&state](const Algorithm &algorithm) -> StatusCode
+    {
+        const CaloHitList *pCaloHitList(nullptr);
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::GetCurrentList(algorithm, pCaloHitList));
+
+        for (auto _ : state)
+        {
+            OrderedCaloHitList orderedCaloHitList;
+            PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, orderedCaloHitList.Add(*pCaloHitList));
+            benchmark::DoNotOptimize(orderedCaloHitList.size());
+        }
+
+        state.SetItemsProcessed(state.iterations() * pCaloHitList->size());
+        return STATUS_CODE_SUCCESS;
+    });
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Remove every other calo hit from a filled ordered calo hit list, refilling the list outside the timed region
+ */
+void BM_OrderedCaloHitList_Remove(benchmark::State &state)
+{
+    BenchmarkPandora benchmarkPandora;
+
+    if (!BenchmarkPandora::Check(state, benchmarkPandora.CreateSyntheticEvent(static_cast<unsigned int>(state.range(0)))))
+        return;
+
+    benchmarkPandora.Run(state, [&state](const Algorithm &algorithm) -> StatusCode
+    {
+        const CaloHitList *pCaloHitList(nullptr);
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::GetCurrentList(algorithm, pCaloHitList));
+
+        CaloHitList caloHitsToRemove;
+        unsigned int iCaloHit(0);
+
+        for (const CaloHit *const pCaloHit : *pCaloHitList)
+        {
+            if (0 == iCaloHit++ % 2)
+                caloHitsToRemove.push_back(pCaloHit);
+        }
+
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            OrderedCaloHitList orderedCaloHitList;
+            PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, orderedCaloHitList.Add(*pCaloHitList));
+            state.ResumeTiming();
+
+            PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, orderedCaloHitList.Remove(caloHitsToRemove));
+            benchmark::DoNotOptimize(orderedCaloHitList.size());
+        }
+
+        state.SetItemsProcessed(state.iterations() * caloHitsToRemove.size());
+        return STATUS_CODE_SUCCESS;
+    });
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Visit every calo hit in a filled ordered calo hit list, in pseudo layer order
+ */
+void BM_OrderedCaloHitList_Iterate(benchmark::State &state)
+{
+    BenchmarkPandora benchmarkPandora;
+
+    if (!BenchmarkPandora::Check(state, benchmarkPandora.CreateSyntheticEvent(static_cast<unsigned int>(state.range(0)))))
+        return;
+
+    benchmarkPandora.Run(state, [&state](const Algorithm &algorithm) -> StatusCode
+    {
+        const CaloHitList *pCaloHitList(nullptr);
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::GetCurrentList(algorithm, pCaloHitList));
+
+        OrderedCaloHitList orderedCaloHitList;
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, orderedCaloHitList.Add(*pCaloHitList));
+
+        for (auto _ : state)
+        {
+            float energySum(0.f);
+
+            for (const OrderedCaloHitList::value_type &layerEntry : orderedCaloHitList)
+            {
+                for (const CaloHit *const pCaloHit : *layerEntry.second)
+                    energySum += pCaloHit->GetMipEquivalentEnergy();
+            }
+
+            benchmark::DoNotOptimize(energySum);
+        }
+
+        state.SetItemsProcessed(state.iterations() * pCaloHitList->size());
+        return STATUS_CODE_SUCCESS;
+    });
+}
+
+} // namespace
+
+BENCHMARK(BM_OrderedCaloHitList_Add)->RangeMultiplier(10)->Range(10000, 1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_OrderedCaloHitList_Remove)->RangeMultiplier(10)->Range(10000, 1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_OrderedCaloHitList_Iterate)->RangeMultiplier(10)->Range(10000, 1000000)->Unit(benchmark::kMillisecond);
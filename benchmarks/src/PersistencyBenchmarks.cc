@@ -0,0 +1,176 @@
+/**
+ *  @file   PandoraSDK/benchmarks/src/PersistencyBenchmarks.cc
+ *
+ *  @brief  Micro-benchmarks for the binary and xml file readers.
+ *
+ *  $Log: $
+ */
+
+#include "Persistency/BinaryFileReader.h"
+#include "Persistency/BinaryFileWriter.h"
+#include "Persistency/EventRecord.h"
+#include "Persistency/XmlFileReader.h"
+#include "Persistency/XmlFileWriter.h"
+
+#include "BenchmarkPandora.h"
+#include "SyntheticEventGenerator.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+using namespace pandora;
+using namespace pandora_benchmarks;
+
+namespace
+{
+
+/**
+ *  @brief  Write a synthetic event, with its tracks, mc particles and relationships, to a binary file buffer
+ *
+ *  @param  nCaloHits the number of calo hits
+ *  @param  shouldPackCaloHits whether to write the calo hits as a packed calo hit block
+ *  @param  buffer to receive the binary file contents
+ */
+StatusCode WriteBinaryEvent(const unsigned int nCaloHits, const bool shouldPackCaloHits, std::vector<char> &buffer)
+{
+    BenchmarkPandora benchmarkPandora;
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, benchmarkPandora.CreateSyntheticEvent(nCaloHits));
+
+    return benchmarkPandora.ProcessEvent([&benchmarkPandora, shouldPackCaloHits, &buffer](const Algorithm &algorithm) -> StatusCode
+    {
+        BinaryFileWriter binaryFileWriter(benchmarkPandora.GetPandora(), buffer, false, false, shouldPackCaloHits);
+        return SyntheticEventGenerator::WriteEvent(algorithm, binaryFileWriter);
+    });
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Write a synthetic event, with its tracks, mc particles and relationships, to an xml file
+ *
+ *  @param  nCaloHits the number of calo hits
+ *  @param  fileName the file name
+ */
+StatusCode WriteXmlEvent(const unsigned int nCaloHits, const std::string &fileName)
+{
+    BenchmarkPandora benchmarkPandora;
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, benchmarkPandora.CreateSyntheticEvent(nCaloHits));
+
+    return benchmarkPandora.ProcessEvent([&benchmarkPandora, &fileName](const Algorithm &algorithm) -> StatusCode
+    {
+        XmlFileWriter xmlFileWriter(benchmarkPandora.GetPandora(), fileName, OVERWRITE);
+        return SyntheticEventGenerator::WriteEvent(algorithm, xmlFileWriter);
+    });
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Read a binary event into an event record, without creating any objects
+ */
+void BM_BinaryFileReader_ReadEventRecord(benchmark::State &state)
+{
+    const unsigned int nCaloHits(static_cast<unsigned int>(state.range(0)));
+    std::vector<char> buffer;
+
+    if (!BenchmarkPandora::Check(state, WriteBinaryEvent(nCaloHits, 0 != state.range(1), buffer)))
+        return;
+
+    BenchmarkPandora benchmarkPandora;
+    BinaryFileReader binaryFileReader(benchmarkPandora.GetPandora(), buffer.data(), buffer.size());
+    EventRecord eventRecord;
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        const StatusCode statusCode(static_cast<FileReader &>(binaryFileReader).GoToEvent(0));
+        state.ResumeTiming();
+
+        if (!BenchmarkPandora::Check(state, statusCode) || !BenchmarkPandora::Check(state, binaryFileReader.ReadEvent(eventRecord)))
+            break;
+    }
+
+    state.SetItemsProcessed(state.iterations() * nCaloHits);
+    state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Read a binary event, recreating its objects and relationships, then reset the event outside the timed region
+ */
+void BM_BinaryFileReader_ReadEvent(benchmark::State &state)
+{
+    const unsigned int nCaloHits(static_cast<unsigned int>(state.range(0)));
+    std::vector<char> buffer;
+
+    if (!BenchmarkPandora::Check(state, WriteBinaryEvent(nCaloHits, 0 != state.range(1), buffer)))
+        return;
+
+    BenchmarkPandora benchmarkPandora;
+    BinaryFileReader binaryFileReader(benchmarkPandora.GetPandora(), buffer.data(), buffer.size());
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        const StatusCode statusCode(static_cast<FileReader &>(binaryFileReader).GoToEvent(0));
+        state.ResumeTiming();
+
+        if (!BenchmarkPandora::Check(state, statusCode) || !BenchmarkPandora::Check(state, binaryFileReader.ReadEvent()))
+            break;
+
+        state.PauseTiming();
+        const StatusCode resetStatusCode(benchmarkPandora.Reset());
+        state.ResumeTiming();
+
+        if (!BenchmarkPandora::Check(state, resetStatusCode))
+            break;
+    }
+
+    state.SetItemsProcessed(state.iterations() * nCaloHits);
+    state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Read an xml event into an event record, without creating any objects
+ */
+void BM_XmlFileReader_ReadEventRecord(benchmark::State &state)
+{
+    const unsigned int nCaloHits(static_cast<unsigned int>(state.range(0)));
+    const std::string fileName((std::filesystem::temp_directory_path() / ("PandoraSDKBenchmarks_" + std::to_string(::getpid()) + "_" +
+        std::to_string(reinterpret_cast<std::uintptr_t>(&state)) + ".xml")).string());
+
+    if (BenchmarkPandora::Check(state, WriteXmlEvent(nCaloHits, fileName)))
+    {
+        BenchmarkPandora benchmarkPandora;
+        XmlFileReader xmlFileReader(benchmarkPandora.GetPandora(), fileName);
+        EventRecord eventRecord;
+
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            const StatusCode statusCode(static_cast<FileReader &>(xmlFileReader).GoToEvent(0));
+            state.ResumeTiming();
+
+            if (!BenchmarkPandora::Check(state, statusCode) || !BenchmarkPandora::Check(state, xmlFileReader.ReadEvent(eventRecord)))
+                break;
+        }
+
+        state.SetItemsProcessed(state.iterations() * nCaloHits);
+    }
+
+    std::remove(fileName.c_str());
+}
+
+} // namespace
+
+BENCHMARK(BM_BinaryFileReader_ReadEventRecord)->RangeMultiplier(10)->Ranges({{10000, 1000000}, {0, 1}})->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_BinaryFileReader_ReadEvent)->RangeMultiplier(10)->Ranges({{10000, 1000000}, {0, 1}})->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_XmlFileReader_ReadEventRecord)->RangeMultiplier(10)->Range(10000, 100000)->Unit(benchmark::kMillisecond);
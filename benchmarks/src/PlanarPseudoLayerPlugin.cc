@@ -0,0 +1,51 @@
+/**
+ *  @file   PandoraSDK/benchmarks/src/PlanarPseudoLayerPlugin.cc
+ *
+ *  @brief  Implementation of the planar pseudo layer plugin class.
+ *
+ *  $Log: $
+ */
+
+#include "Objects/CartesianVector.h"
+
+#include "Xml/tinyxml.h"
+
+#include "PlanarPseudoLayerPlugin.h"
+
+#include <cmath>
+
+using namespace pandora;
+
+namespace pandora_benchmarks
+{
+
+PlanarPseudoLayerPlugin::PlanarPseudoLayerPlugin(const float layerPitch) :
+    m_layerPitch(layerPitch)
+{
+    if (!(m_layerPitch > 0.f))
+        throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+unsigned int PlanarPseudoLayerPlugin::GetPseudoLayer(const CartesianVector &positionVector) const
+{
+    const float z(positionVector.GetZ());
+    return ((z > 0.f) ? static_cast<unsigned int>(std::floor(z / m_layerPitch)) : 0);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+unsigned int PlanarPseudoLayerPlugin::GetPseudoLayerAtIp() const
+{
+    return 0;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PlanarPseudoLayerPlugin::ReadSettings(const TiXmlHandle)
+{
+    return STATUS_CODE_SUCCESS;
+}
+
+} // namespace pandora_benchmarks
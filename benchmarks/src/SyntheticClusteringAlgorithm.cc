@@ -0,0 +1,102 @@
+/**
+ *  @file   PandoraSDK/benchmarks/src/SyntheticClusteringAlgorithm.cc
+ *
+ *  @brief  Implementation of the synthetic clustering algorithm class.
+ *
+ *  $Log: $
+ */
+
+#include "Api/PandoraContentApi.h"
+
+#include "Helpers/XmlHelper.h"
+
+#include "Objects/CaloHit.h"
+#include "Objects/Cluster.h"
+
+#include "SyntheticClusteringAlgorithm.h"
+
+#include <cmath>
+#include <limits>
+#include <map>
+#include <tuple>
+
+using namespace pandora;
+
+namespace pandora_benchmarks
+{
+
+SyntheticClusteringAlgorithm::SyntheticClusteringAlgorithm() :
+    m_clusterListName("SyntheticClusters"),
+    m_layerWindow(10),
+    m_driftWindow(20.f)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode SyntheticClusteringAlgorithm::Run()
+{
+    const CaloHitList *pCaloHitList(nullptr);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::GetCurrentList(*this, pCaloHitList));
+
+    const ClusterList *pClusterList(nullptr);
+    std::string temporaryListName;
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::CreateTemporaryListAndSetCurrent(*this, pClusterList, temporaryListName));
+
+    typedef std::tuple<int, int, unsigned int> ClusterKey;
+    std::map<ClusterKey, const Cluster *> keyToClusterMap;
+
+    for (const CaloHit *const pCaloHit : *pCaloHitList)
+    {
+        if (!PandoraContentApi::IsAvailable(*this, pCaloHit))
+            continue;
+
+        const ClusterKey key(static_cast<int>(pCaloHit->GetHitType()), static_cast<int>(std::floor(pCaloHit->GetPositionVector().GetX() / m_driftWindow)),
+            pCaloHit->GetPseudoLayer() / m_layerWindow);
+
+        auto iter(keyToClusterMap.find(key));
+
+        if (keyToClusterMap.end() == iter)
+        {
+            PandoraContentApi::Cluster::Parameters parameters;
+            parameters.m_caloHitList.push_back(pCaloHit);
+
+            const Cluster *pCluster(nullptr);
+            PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::Cluster::Create(*this, parameters, pCluster));
+            keyToClusterMap.emplace(key, pCluster);
+        }
+        else
+        {
+            PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::AddToCluster(*this, iter->second, pCaloHit));
+        }
+    }
+
+    if (!pClusterList->empty())
+    {
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::SaveList<Cluster>(*this, m_clusterListName));
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::ReplaceCurrentList<Cluster>(*this, m_clusterListName));
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode SyntheticClusteringAlgorithm::ReadSettings(const TiXmlHandle xmlHandle)
+{
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(xmlHandle,
+        "ClusterListName", m_clusterListName));
+
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(xmlHandle,
+        "LayerWindow", m_layerWindow));
+
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(xmlHandle,
+        "DriftWindow", m_driftWindow));
+
+    if ((0 == m_layerWindow) || (m_driftWindow < std::numeric_limits<float>::epsilon()))
+        return STATUS_CODE_INVALID_PARAMETER;
+
+    return STATUS_CODE_SUCCESS;
+}
+
+} // namespace pandora_benchmarks
@@ -0,0 +1,341 @@
+/**
+ *  @file   PandoraSDK/benchmarks/src/SyntheticEventGenerator.cc
+ *
+ *  @brief  Implementation of the synthetic event generator class.
+ *
+ *  $Log: $
+ */
+
+#include "Api/PandoraApi.h"
+#include "Api/PandoraContentApi.h"
+
+#include "Pandora/PdgTable.h"
+
+#include "Persistency/FileWriter.h"
+
+#include "SyntheticEventGenerator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace pandora;
+
+namespace
+{
+
+const float PI(std::acos(-1.f));                ///< The value of pi
+const float LAR_TPC_WIDTH_X(2000.f);            ///< The width of each lar tpc in x, the drift direction, units mm
+const float LAR_TPC_WIDTH_Y(2000.f);            ///< The width of each lar tpc in y, units mm
+const float LAR_TPC_WIDTH_Z(5000.f);            ///< The width of each lar tpc in z, units mm
+const float WIRE_PITCH(3.f);                    ///< The wire pitch in each view, units mm
+const float WIRE_ANGLE_U(PI / 3.f);             ///< The u wire angle to the vertical, units radians
+const float WIRE_ANGLE_V(-PI / 3.f);            ///< The v wire angle to the vertical, units radians
+const float SHOWER_LENGTH(500.f);               ///< The typical longitudinal extent of a shower, units mm
+const float MIP_TO_GEV(0.002f);                 ///< The conversion from mip equivalent energy to calorimetric energy, units GeV
+
+/**
+ *  @brief  Get the address in the user framework of the object with a specified index, counting over calo hits, then tracks, then mc
+ *          particles, so that the addresses of all objects in an event are distinct and non-null
+ *
+ *  @param  index the object index
+ *
+ *  @return the address
+ */
+const void *GetAddress(const unsigned int index)
+{
+    return reinterpret_cast<const void*>(static_cast<std::uintptr_t>(index + 1));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Get the two dimensional position, in the drift coordinate x and the wire coordinate of a specified view, of a 3D position
+ *
+ *  @param  position the 3D position
+ *  @param  hitType the view
+ *
+ *  @return the two dimensional position, with wire coordinate held as z
+ */
+CartesianVector GetViewPosition(const CartesianVector &position, const HitType hitType)
+{
+    const float wireAngle((TPC_VIEW_U == hitType) ? WIRE_ANGLE_U : (TPC_VIEW_V == hitType) ? WIRE_ANGLE_V : 0.f);
+    return CartesianVector(position.GetX(), 0.f, position.GetZ() * std::cos(wireAngle) - position.GetY() * std::sin(wireAngle));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Get the parameters for a mc particle
+ *
+ *  @param  particleId the pdg code
+ *  @param  vertex the production vertex, units mm
+ *  @param  direction the unit direction
+ *  @param  energy the energy, units GeV
+ *  @param  length the distance from the vertex to the endpoint, units mm
+ *
+ *  @return the mc particle parameters
+ */
+PandoraApi::MCParticle::Parameters GetMCParticleParameters(const int particleId, const CartesianVector &vertex,
+    const CartesianVector &direction, const float energy, const float length)
+{
+    const float mass(PdgTable::GetParticleMass(particleId));
+    const float momentum((energy > mass) ? std::sqrt(energy * energy - mass * mass) : 0.f);
+
+    PandoraApi::MCParticle::Parameters parameters;
+    parameters.m_energy = energy;
+    parameters.m_momentum = direction * momentum;
+    parameters.m_vertex = vertex;
+    parameters.m_endpoint = vertex + direction * length;
+    parameters.m_particleId = particleId;
+    parameters.m_mcParticleType = MC_3D;
+    parameters.m_pParentAddress = nullptr;
+
+    return parameters;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+namespace pandora_benchmarks
+{
+
+SyntheticEventGenerator::SyntheticEventGenerator(const Parameters &parameters) :
+    m_parameters(parameters)
+{
+    if ((0 == m_parameters.m_nLArTPCs) || ((0 == m_parameters.m_nMCParticles) && ((0 != m_parameters.m_nCaloHits) ||
+        (0 != m_parameters.m_nTracks))) || (m_parameters.m_showerFraction < 0.f) || (m_parameters.m_showerFraction > 1.f) ||
+        !(m_parameters.m_hitSpacing > 0.f))
+    {
+        throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode SyntheticEventGenerator::CreateGeometry(const Pandora &pandora) const
+{
+    PandoraApi::Geometry::LArTPC::ParametersVector parametersVector(m_parameters.m_nLArTPCs);
+
+    for (unsigned int iLArTPC = 0; iLArTPC < m_parameters.m_nLArTPCs; ++iLArTPC)
+    {
+        PandoraApi::Geometry::LArTPC::Parameters &parameters(parametersVector[iLArTPC]);
+        parameters.m_larTPCVolumeId = iLArTPC;
+        parameters.m_centerX = (static_cast<float>(iLArTPC) + 0.5f) * LAR_TPC_WIDTH_X;
+        parameters.m_centerY = 0.f;
+        parameters.m_centerZ = 0.5f * LAR_TPC_WIDTH_Z;
+        parameters.m_widthX = LAR_TPC_WIDTH_X;
+        parameters.m_widthY = LAR_TPC_WIDTH_Y;
+        parameters.m_widthZ = LAR_TPC_WIDTH_Z;
+        parameters.m_wirePitchU = WIRE_PITCH;
+        parameters.m_wirePitchV = WIRE_PITCH;
+        parameters.m_wirePitchW = WIRE_PITCH;
+        parameters.m_wireAngleU = WIRE_ANGLE_U;
+        parameters.m_wireAngleV = WIRE_ANGLE_V;
+        parameters.m_wireAngleW = 0.f;
+        parameters.m_sigmaUVW = 1.f;
+        parameters.m_isDriftInPositiveX = (1 == iLArTPC % 2);
+    }
+
+    return PandoraApi::Geometry::LArTPC::Create(pandora, parametersVector);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode SyntheticEventGenerator::CreateEvent(const Pandora &pandora, const unsigned int eventNumber) const
+{
+    const unsigned int nCaloHits(m_parameters.m_nCaloHits), nTracks(m_parameters.m_nTracks), nPrimaries(m_parameters.m_nMCParticles);
+    const unsigned int mcParticleOffset(nCaloHits + nTracks);
+    const HitType views[3] = {TPC_VIEW_U, TPC_VIEW_V, TPC_VIEW_W};
+
+    std::seed_seq seedSequence{m_parameters.m_seed, eventNumber};
+    std::mt19937 generator(seedSequence);
+    std::uniform_real_distribution<float> uniformDistribution(0.f, 1.f);
+    std::normal_distribution<float> normalDistribution(0.f, 1.f);
+    std::bernoulli_distribution showerDistribution(m_parameters.m_showerFraction);
+    std::gamma_distribution<float> depthDistribution(2.f, 0.25f * SHOWER_LENGTH);
+    std::gamma_distribution<float> mipDistribution(4.f, 0.25f);
+    std::uniform_real_distribution<float> energyDistribution(0.1f, 5.f);
+
+    PandoraApi::CaloHit::ParametersVector caloHitParametersVector(nCaloHits);
+    PandoraApi::Track::ParametersVector trackParametersVector(nTracks);
+    PandoraApi::MCParticle::ParametersVector mcParticleParametersVector;
+    MCParticleRelationshipVector caloHitRelationshipVector, trackRelationshipVector;
+    std::vector<std::pair<unsigned int, unsigned int>> mcParentDaughterVector;
+    UIntVector primaryIndices, trackLikeIndices;
+
+    mcParticleParametersVector.reserve(nPrimaries);
+    caloHitRelationshipVector.reserve(nCaloHits);
+    trackRelationshipVector.reserve(nTracks);
+
+    unsigned int iCaloHit(0);
+
+    for (unsigned int iPrimary = 0; iPrimary < nPrimaries; ++iPrimary)
+    {
+        const float larTPCMinX(static_cast<float>(iPrimary % m_parameters.m_nLArTPCs) * LAR_TPC_WIDTH_X);
+        const CartesianVector vertex(larTPCMinX + LAR_TPC_WIDTH_X * (0.1f + 0.8f * uniformDistribution(generator)),
+            LAR_TPC_WIDTH_Y * (0.8f * uniformDistribution(generator) - 0.4f), LAR_TPC_WIDTH_Z * (0.1f + 0.8f * uniformDistribution(generator)));
+
+        const float cosTheta(2.f * uniformDistribution(generator) - 1.f), phi(2.f * PI * uniformDistribution(generator));
+        const float sinTheta(std::sqrt(1.f - cosTheta * cosTheta));
+        const CartesianVector direction(sinTheta * std::cos(phi), sinTheta * std::sin(phi), cosTheta);
+
+        const unsigned int nPrimaryCaloHits(nCaloHits / nPrimaries + ((iPrimary < nCaloHits % nPrimaries) ? 1 : 0));
+        const bool isShower(showerDistribution(generator));
+        const float trackLength(static_cast<float>(nPrimaryCaloHits) * m_parameters.m_hitSpacing);
+        const unsigned int primaryIndex(mcParticleParametersVector.size());
+
+        mcParticleParametersVector.push_back(GetMCParticleParameters(isShower ? E_MINUS : MU_MINUS, vertex, direction,
+            energyDistribution(generator), isShower ? SHOWER_LENGTH : trackLength));
+        primaryIndices.push_back(primaryIndex);
+
+        // Shower daughters carry on from random depths, sharing the shower calo hits with their parent
+        if (isShower)
+        {
+            for (unsigned int iDaughter = 0; iDaughter < m_parameters.m_nShowerDaughters; ++iDaughter)
+            {
+                const CartesianVector daughterDirection((direction + CartesianVector(normalDistribution(generator),
+                    normalDistribution(generator), normalDistribution(generator)) * 0.2f).GetUnitVector());
+
+                mcParentDaughterVector.emplace_back(primaryIndex, mcParticleParametersVector.size());
+                mcParticleParametersVector.push_back(GetMCParticleParameters(PHOTON, vertex + direction * depthDistribution(generator),
+                    daughterDirection, 0.5f * energyDistribution(generator), SHOWER_LENGTH));
+            }
+        }
+        else
+        {
+            trackLikeIndices.push_back(primaryIndex);
+        }
+
+        const CartesianVector axis((std::fabs(direction.GetZ()) < 0.9f) ? CartesianVector(0.f, 0.f, 1.f) : CartesianVector(1.f, 0.f, 0.f));
+        const CartesianVector transverse1(direction.GetCrossProduct(axis).GetUnitVector()), transverse2(direction.GetCrossProduct(transverse1));
+        const unsigned int nShowerMCParticles(mcParticleParametersVector.size() - primaryIndex);
+
+        for (unsigned int iPrimaryCaloHit = 0; iPrimaryCaloHit < nPrimaryCaloHits; ++iPrimaryCaloHit, ++iCaloHit)
+        {
+            CartesianVector position(vertex + direction * (static_cast<float>(iPrimaryCaloHit) * m_parameters.m_hitSpacing));
+            unsigned int mcParticleIndex(primaryIndex);
+
+            if (isShower)
+            {
+                const float depth(depthDistribution(generator)), spread(5.f + 0.05f * depth);
+                position = vertex + direction * depth + transverse1 * (spread * normalDistribution(generator)) +
+                    transverse2 * (spread * normalDistribution(generator));
+                mcParticleIndex += std::min(static_cast<unsigned int>(uniformDistribution(generator) * nShowerMCParticles), nShowerMCParticles - 1);
+            }
+
+            const HitType hitType(views[iCaloHit % 3]);
+            const float mipEquivalentEnergy(mipDistribution(generator));
+
+            PandoraApi::CaloHit::Parameters &parameters(caloHitParametersVector[iCaloHit]);
+            parameters.m_positionVector = GetViewPosition(position, hitType);
+            parameters.m_expectedDirection = CartesianVector(0.f, 0.f, 1.f);
+            parameters.m_cellNormalVector = CartesianVector(0.f, 0.f, 1.f);
+            parameters.m_cellGeometry = RECTANGULAR;
+            parameters.m_cellSize0 = 0.5f;
+            parameters.m_cellSize1 = WIRE_PITCH;
+            parameters.m_cellThickness = WIRE_PITCH;
+            parameters.m_nCellRadiationLengths = 1.f;
+            parameters.m_nCellInteractionLengths = 1.f;
+            parameters.m_time = 0.f;
+            parameters.m_inputEnergy = mipEquivalentEnergy * MIP_TO_GEV;
+            parameters.m_mipEquivalentEnergy = mipEquivalentEnergy;
+            parameters.m_electromagneticEnergy = mipEquivalentEnergy * MIP_TO_GEV;
+            parameters.m_hadronicEnergy = mipEquivalentEnergy * MIP_TO_GEV;
+            parameters.m_isDigital = false;
+            parameters.m_hitType = hitType;
+            parameters.m_hitRegion = SINGLE_REGION;
+            parameters.m_layer = 0;
+            parameters.m_isInOuterSamplingLayer = false;
+            parameters.m_pParentAddress = GetAddress(iCaloHit);
+
+            caloHitRelationshipVector.emplace_back(GetAddress(iCaloHit), GetAddress(mcParticleOffset + mcParticleIndex), 1.f);
+        }
+    }
+
+    // Tracks follow the track-like primaries, or any primary if every primary produced a shower
+    const UIntVector &trackedIndices(trackLikeIndices.empty() ? primaryIndices : trackLikeIndices);
+
+    for (unsigned int iTrack = 0; iTrack < nTracks; ++iTrack)
+    {
+        const unsigned int mcParticleIndex(trackedIndices[iTrack % trackedIndices.size()]);
+        const PandoraApi::MCParticle::Parameters &mcParticleParameters(mcParticleParametersVector[mcParticleIndex]);
+        const int particleId(mcParticleParameters.m_particleId.Get());
+        const CartesianVector &momentum(mcParticleParameters.m_momentum.Get());
+
+        PandoraApi::Track::Parameters &parameters(trackParametersVector[iTrack]);
+        parameters.m_d0 = 0.f;
+        parameters.m_z0 = mcParticleParameters.m_vertex.Get().GetZ();
+        parameters.m_particleId = particleId;
+        parameters.m_charge = PdgTable::GetParticleCharge(particleId);
+        parameters.m_mass = PdgTable::GetParticleMass(particleId);
+        parameters.m_momentumAtDca = momentum;
+        parameters.m_trackStateAtStart = TrackState(mcParticleParameters.m_vertex.Get(), momentum);
+        parameters.m_trackStateAtEnd = TrackState(mcParticleParameters.m_endpoint.Get(), momentum);
+        parameters.m_trackStateAtCalorimeter = TrackState(mcParticleParameters.m_endpoint.Get(), momentum);
+        parameters.m_timeAtCalorimeter = 0.f;
+        parameters.m_reachesCalorimeter = false;
+        parameters.m_isProjectedToEndCap = false;
+        parameters.m_canFormPfo = true;
+        parameters.m_canFormClusterlessPfo = false;
+        parameters.m_pParentAddress = GetAddress(nCaloHits + iTrack);
+
+        trackRelationshipVector.emplace_back(GetAddress(nCaloHits + iTrack), GetAddress(mcParticleOffset + mcParticleIndex), 1.f);
+    }
+
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraApi::SetEventSizeHints(pandora, nCaloHits, nTracks,
+        mcParticleParametersVector.size(), nCaloHits + nTracks));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraApi::CaloHit::Create(pandora, caloHitParametersVector));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraApi::Track::Create(pandora, trackParametersVector));
+
+    for (unsigned int iMCParticle = 0; iMCParticle < mcParticleParametersVector.size(); ++iMCParticle)
+        mcParticleParametersVector[iMCParticle].m_pParentAddress = GetAddress(mcParticleOffset + iMCParticle);
+
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraApi::MCParticle::Create(pandora, mcParticleParametersVector));
+
+    for (const auto &parentDaughter : mcParentDaughterVector)
+    {
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraApi::SetMCParentDaughterRelationship(pandora,
+            GetAddress(mcParticleOffset + parentDaughter.first), GetAddress(mcParticleOffset + parentDaughter.second)));
+    }
+
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraApi::SetCaloHitToMCParticleRelationships(pandora, caloHitRelationshipVector));
+    return PandoraApi::SetTrackToMCParticleRelationships(pandora, trackRelationshipVector);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode SyntheticEventGenerator::WriteEvent(const Algorithm &algorithm, FileWriter &fileWriter)
+{
+    const CaloHitList *pCaloHitList(nullptr);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::GetCurrentList(algorithm, pCaloHitList));
+
+    const TrackList *pTrackList(nullptr);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::GetCurrentList(algorithm, pTrackList));
+
+    const MCParticleList *pMCParticleList(nullptr);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::GetCurrentList(algorithm, pMCParticleList));
+
+    return fileWriter.WriteEvent(*pCaloHitList, *pTrackList, *pMCParticleList);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+SyntheticEventGenerator::Parameters::Parameters() :
+    m_nCaloHits(100000),
+    m_nTracks(50),
+    m_nMCParticles(100),
+    m_nShowerDaughters(4),
+    m_nLArTPCs(4),
+    m_showerFraction(0.5f),
+    m_hitSpacing(3.f),
+    m_seed(1)
+{
+}
+
+} // namespace pandora_benchmarks
@@ -0,0 +1,117 @@
+/**
+ *  @file   PandoraSDK/benchmarks/src/SyntheticMergingAlgorithm.cc
+ *
+ *  @brief  Implementation of the synthetic merging algorithm class.
+ *
+ *  $Log: $
+ */
+
+#include "Api/PandoraContentApi.h"
+
+#include "Helpers/XmlHelper.h"
+
+#include "Objects/CaloHit.h"
+#include "Objects/Cluster.h"
+
+#include "SyntheticMergingAlgorithm.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+using namespace pandora;
+
+namespace
+{
+
+/**
+ *  @brief  Get the hit type of a cluster, taken from its first calo hit as the synthetic clusters each hold a single hit type
+ *
+ *  @param  pCluster address of the cluster
+ *
+ *  @return the hit type
+ */
+HitType GetHitType(const Cluster *const pCluster)
+{
+    return (*pCluster->GetOrderedCaloHitList().begin()->second->begin())->GetHitType();
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+namespace pandora_benchmarks
+{
+
+SyntheticMergingAlgorithm::SyntheticMergingAlgorithm() :
+    m_maxLayerGap(2),
+    m_maxMergeDistance(50.f)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode SyntheticMergingAlgorithm::Run()
+{
+    const ClusterList *pClusterList(nullptr);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::GetCurrentList(*this, pClusterList));
+
+    ClusterVector clusterVector(pClusterList->begin(), pClusterList->end());
+    std::stable_sort(clusterVector.begin(), clusterVector.end(), [](const Cluster *const pLhs, const Cluster *const pRhs)
+    {
+        return (pLhs->GetInnerPseudoLayer() < pRhs->GetInnerPseudoLayer());
+    });
+
+    const float maxMergeDistanceSquared(m_maxMergeDistance * m_maxMergeDistance);
+    std::unordered_set<const Cluster *> deletedClusters;
+
+    for (ClusterVector::const_iterator iterI = clusterVector.begin(), iterEnd = clusterVector.end(); iterI != iterEnd; ++iterI)
+    {
+        const Cluster *const pClusterI(*iterI);
+
+        if (deletedClusters.count(pClusterI))
+            continue;
+
+        for (ClusterVector::const_iterator iterJ = iterI + 1; iterJ != iterEnd; ++iterJ)
+        {
+            const Cluster *const pClusterJ(*iterJ);
+
+            if (deletedClusters.count(pClusterJ))
+                continue;
+
+            // ATTN Merging can extend cluster i, so its outer layer is re-read for each candidate
+            const unsigned int outerLayerI(pClusterI->GetOuterPseudoLayer());
+
+            if (pClusterJ->GetInnerPseudoLayer() > outerLayerI + m_maxLayerGap)
+                break;
+
+            if (GetHitType(pClusterI) != GetHitType(pClusterJ))
+                continue;
+
+            const CartesianVector separation(pClusterJ->GetCentroid(pClusterJ->GetInnerPseudoLayer()) - pClusterI->GetCentroid(outerLayerI));
+
+            if (separation.GetMagnitudeSquared() > maxMergeDistanceSquared)
+                continue;
+
+            PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::MergeAndDeleteClusters(*this, pClusterI, pClusterJ));
+            deletedClusters.insert(pClusterJ);
+        }
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode SyntheticMergingAlgorithm::ReadSettings(const TiXmlHandle xmlHandle)
+{
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(xmlHandle,
+        "MaxLayerGap", m_maxLayerGap));
+
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(xmlHandle,
+        "MaxMergeDistance", m_maxMergeDistance));
+
+    return STATUS_CODE_SUCCESS;
+}
+
+} // namespace pandora_benchmarks
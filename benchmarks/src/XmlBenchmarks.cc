@@ -0,0 +1,192 @@
+/**
+ *  @file   PandoraSDK/benchmarks/src/XmlBenchmarks.cc
+ *
+ *  @brief  Micro-benchmarks for parsing pandora settings files through tinyxml and the xml helper.
+ *
+ *  $Log: $
+ */
+
+#include "Helpers/XmlHelper.h"
+
+#include "Pandora/StatusCodes.h"
+
+#include <benchmark/benchmark.h>
+
+#include <sstream>
+
+using namespace pandora;
+
+namespace
+{
+
+const unsigned int N_SCALAR_PARAMETERS = 4;         ///< The number of each type of scalar parameter in each algorithm block
+const unsigned int N_VECTOR_ENTRIES = 20;           ///< The number of entries in each vector parameter in each algorithm block
+const unsigned int N_CALIBRATION_ENTRIES = 1000;    ///< The number of entries in the calibration vector of every tenth algorithm block
+
+/**
+ *  @brief  Get a representative settings file, with an algorithm block holding integer, float and bool parameters and integer and
+ *          float vector parameters for each algorithm, plus a long calibration vector for every tenth algorithm
+ *
+ *  @param  nAlgorithms the number of algorithm blocks
+ *  @param  nValues to receive the number of values in the settings file
+ *
+ *  @return the settings file contents
+ */
+std::string GetSettingsXml(const unsigned int nAlgorithms, unsigned int &nValues)
+{
+    std::ostringstream xml;
+    xml << "<pandora>\n";
+    nValues = 0;
+
+    for (unsigned int iAlgorithm = 0; iAlgorithm < nAlgorithms; ++iAlgorithm)
+    {
+        xml << "    <algorithm type = \"BenchmarkAlgorithm\" description = \"Algorithm" << iAlgorithm << "\">\n";
+
+        for (unsigned int iParameter = 0; iParameter < N_SCALAR_PARAMETERS; ++iParameter)
+        {
+            xml << "        <IntParameter" << iParameter << ">" << (iAlgorithm * 7 + iParameter) << "</IntParameter" << iParameter << ">\n";
+            xml << "        <FloatParameter" << iParameter << ">" << (0.125f * iAlgorithm + 3.75f * iParameter) << "</FloatParameter" << iParameter << ">\n";
+        }
+
+        xml << "        <BoolParameter>" << ((0 == iAlgorithm % 2) ? "true" : "false") << "</BoolParameter>\n";
+        xml << "        <IntVector>";
+
+        for (unsigned int iEntry = 0; iEntry < N_VECTOR_ENTRIES; ++iEntry)
+            xml << ((0 == iEntry) ? "" : " ") << (iAlgorithm + 13 * iEntry);
+
+        xml << "</IntVector>\n";
+        xml << "        <FloatVector>";
+
+        for (unsigned int iEntry = 0; iEntry < N_VECTOR_ENTRIES; ++iEntry)
+            xml << ((0 == iEntry) ? "" : " ") << (1.5e-3f * iAlgorithm - 0.875f * iEntry);
+
+        xml << "</FloatVector>\n";
+        nValues += 2 * N_SCALAR_PARAMETERS + 1 + 2 * N_VECTOR_ENTRIES;
+
+        if (0 == iAlgorithm % 10)
+        {
+            xml << "        <CalibrationVector>";
+
+            for (unsigned int iEntry = 0; iEntry < N_CALIBRATION_ENTRIES; ++iEntry)
+                xml << ((0 == iEntry) ? "" : " ") << (1.f + 1.e-4f * iEntry);
+
+            xml << "</CalibrationVector>\n";
+            nValues += N_CALIBRATION_ENTRIES;
+        }
+
+        xml << "    </algorithm>\n";
+    }
+
+    xml << "</pandora>\n";
+    return xml.str();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Read every parameter of every algorithm block in a parsed settings file, through the xml helper
+ *
+ *  @param  xmlDocument the parsed settings file
+ *  @param  nValues to receive the number of values read
+ */
+StatusCode ReadSettings(const TiXmlDocument &xmlDocument, unsigned int &nValues)
+{
+    nValues = 0;
+    const TiXmlElement *const pPandoraElement(xmlDocument.FirstChildElement("pandora"));
+
+    if (!pPandoraElement)
+        return STATUS_CODE_NOT_FOUND;
+
+    for (const TiXmlElement *pXmlElement = pPandoraElement->FirstChildElement("algorithm"); nullptr != pXmlElement;
+        pXmlElement = pXmlElement->NextSiblingElement("algorithm"))
+    {
+        const TiXmlHandle xmlHandle(const_cast<TiXmlElement *>(pXmlElement));
+
+        for (unsigned int iParameter = 0; iParameter < N_SCALAR_PARAMETERS; ++iParameter)
+        {
+            const std::string suffix(TypeToString(iParameter));
+            int intParameter(0);
+            float floatParameter(0.f);
+            PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, XmlHelper::ReadValue(xmlHandle, "IntParameter" + suffix, intParameter));
+            PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, XmlHelper::ReadValue(xmlHandle, "FloatParameter" + suffix, floatParameter));
+            benchmark::DoNotOptimize(intParameter);
+            benchmark::DoNotOptimize(floatParameter);
+        }
+
+        bool boolParameter(false);
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, XmlHelper::ReadValue(xmlHandle, "BoolParameter", boolParameter));
+        benchmark::DoNotOptimize(boolParameter);
+
+        IntVector intVector;
+        FloatVector floatVector, calibrationVector;
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, XmlHelper::ReadVectorOfValues(xmlHandle, "IntVector", intVector));
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, XmlHelper::ReadVectorOfValues(xmlHandle, "FloatVector", floatVector));
+        PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadVectorOfValues(xmlHandle,
+            "CalibrationVector", calibrationVector));
+
+        nValues += 2 * N_SCALAR_PARAMETERS + 1 + intVector.size() + floatVector.size() + calibrationVector.size();
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Parse a representative settings file with tinyxml, then read all of its values through the xml helper
+ */
+void BM_XmlHelper_ParseAndReadSettings(benchmark::State &state)
+{
+    unsigned int nExpectedValues(0);
+    const std::string settingsXml(GetSettingsXml(static_cast<unsigned int>(state.range(0)), nExpectedValues));
+
+    for (auto _ : state)
+    {
+        TiXmlDocument xmlDocument;
+        xmlDocument.Parse(settingsXml.c_str());
+
+        unsigned int nValues(0);
+
+        if (xmlDocument.Error() || (STATUS_CODE_SUCCESS != ReadSettings(xmlDocument, nValues)) || (nExpectedValues != nValues))
+        {
+            state.SkipWithError("Failed to read settings");
+            return;
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * nExpectedValues);
+    state.SetBytesProcessed(state.iterations() * settingsXml.size());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Read all of the values in a parsed representative settings file through the xml helper, isolating the string to value
+ *          conversions from the tinyxml parse
+ */
+void BM_XmlHelper_ReadSettings(benchmark::State &state)
+{
+    unsigned int nExpectedValues(0);
+    const std::string settingsXml(GetSettingsXml(static_cast<unsigned int>(state.range(0)), nExpectedValues));
+
+    TiXmlDocument xmlDocument;
+    xmlDocument.Parse(settingsXml.c_str());
+
+    for (auto _ : state)
+    {
+        unsigned int nValues(0);
+
+        if (xmlDocument.Error() || (STATUS_CODE_SUCCESS != ReadSettings(xmlDocument, nValues)) || (nExpectedValues != nValues))
+        {
+            state.SkipWithError("Failed to read settings");
+            return;
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * nExpectedValues);
+}
+
+} // namespace
+
+BENCHMARK(BM_XmlHelper_ParseAndReadSettings)->RangeMultiplier(10)->Range(10, 1000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_XmlHelper_ReadSettings)->RangeMultiplier(10)->Range(10, 1000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,132 @@
+/**
+ *  @file   PandoraSDK/benchmarks/tools/PandoraSDKGenerateEvents.cc
+ *
+ *  @brief  Generate synthetic lar tpc events, optionally writing them to a binary file, for stress and scaling tests.
+ *
+ *  $Log: $
+ */
+
+#include "Persistency/BinaryFileWriter.h"
+
+#include "CallbackPandora.h"
+#include "SyntheticEventGenerator.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include <unistd.h>
+
+using namespace pandora;
+using namespace pandora_benchmarks;
+
+/**
+ *  @brief  Print the usage of the tool
+ *
+ *  @param  pToolName the tool name
+ */
+void PrintUsage(const char *const pToolName)
+{
+    const SyntheticEventGenerator::Parameters parameters;
+
+    std::cout << "Usage: " << pToolName << " [options]" << std::endl
+              << "    -n nCaloHits          number of calo hits per event (default " << parameters.m_nCaloHits << ")" << std::endl
+              << "    -t nTracks            number of tracks per event (default " << parameters.m_nTracks << ")" << std::endl
+              << "    -m nMCParticles       number of primary mc particles per event (default " << parameters.m_nMCParticles << ")" << std::endl
+              << "    -d nShowerDaughters   number of daughter mc particles per shower (default " << parameters.m_nShowerDaughters << ")" << std::endl
+              << "    -l nLArTPCs           number of lar tpcs (default " << parameters.m_nLArTPCs << ")" << std::endl
+              << "    -f showerFraction     probability that a primary mc particle produces a shower (default " << parameters.m_showerFraction << ")" << std::endl
+              << "    -s hitSpacing         spacing of the calo hits along a track, units mm (default " << parameters.m_hitSpacing << ")" << std::endl
+              << "    -r seed               random number seed (default " << parameters.m_seed << ")" << std::endl
+              << "    -e nEvents            number of events (default 1)" << std::endl
+              << "    -o fileName           write the geometry and events to a binary file" << std::endl
+              << "    -p                    write the calo hits of each event as a packed calo hit block" << std::endl
+              << "    -h                    print this help" << std::endl;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    SyntheticEventGenerator::Parameters parameters;
+    unsigned int nEvents(1);
+    std::string fileName;
+    bool shouldPackCaloHits(false);
+
+    int option(0);
+
+    while ((option = ::getopt(argc, argv, "n:t:m:d:l:f:s:r:e:o:ph")) != -1)
+    {
+        switch (option)
+        {
+        case 'n': parameters.m_nCaloHits = std::strtoul(optarg, nullptr, 10); break;
+        case 't': parameters.m_nTracks = std::strtoul(optarg, nullptr, 10); break;
+        case 'm': parameters.m_nMCParticles = std::strtoul(optarg, nullptr, 10); break;
+        case 'd': parameters.m_nShowerDaughters = std::strtoul(optarg, nullptr, 10); break;
+        case 'l': parameters.m_nLArTPCs = std::strtoul(optarg, nullptr, 10); break;
+        case 'f': parameters.m_showerFraction = std::strtof(optarg, nullptr); break;
+        case 's': parameters.m_hitSpacing = std::strtof(optarg, nullptr); break;
+        case 'r': parameters.m_seed = std::strtoul(optarg, nullptr, 10); break;
+        case 'e': nEvents = std::strtoul(optarg, nullptr, 10); break;
+        case 'o': fileName = optarg; break;
+        case 'p': shouldPackCaloHits = true; break;
+        case 'h':
+            PrintUsage(argv[0]);
+            return 0;
+        default:
+            PrintUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    try
+    {
+        const SyntheticEventGenerator syntheticEventGenerator(parameters);
+        CallbackPandora callbackPandora;
+        const Pandora &pandora(callbackPandora.GetPandora());
+
+        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, syntheticEventGenerator.CreateGeometry(pandora));
+
+        std::unique_ptr<BinaryFileWriter> pBinaryFileWriter;
+
+        if (!fileName.empty())
+        {
+            pBinaryFileWriter.reset(new BinaryFileWriter(pandora, fileName, OVERWRITE, true, false, 0, shouldPackCaloHits));
+            PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, pBinaryFileWriter->WriteGeometry());
+        }
+
+        for (unsigned int iEvent = 0; iEvent < nEvents; ++iEvent)
+        {
+            const auto startTime(std::chrono::steady_clock::now());
+            PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, syntheticEventGenerator.CreateEvent(pandora, iEvent));
+            const auto createTime(std::chrono::steady_clock::now());
+
+            if (pBinaryFileWriter)
+            {
+                PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, callbackPandora.ProcessEvent([&pBinaryFileWriter](const Algorithm &algorithm)
+                {
+                    return SyntheticEventGenerator::WriteEvent(algorithm, *pBinaryFileWriter);
+                }));
+            }
+
+            const auto writeTime(std::chrono::steady_clock::now());
+            PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, callbackPandora.Reset());
+
+            std::cout << "Event " << iEvent << ": created in " << std::chrono::duration<double, std::milli>(createTime - startTime).count() << " ms";
+
+            if (pBinaryFileWriter)
+                std::cout << ", written in " << std::chrono::duration<double, std::milli>(writeTime - createTime).count() << " ms";
+
+            std::cout << std::endl;
+        }
+    }
+    catch (StatusCodeException &statusCodeException)
+    {
+        std::cout << argv[0] << ": " << statusCodeException.ToString() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
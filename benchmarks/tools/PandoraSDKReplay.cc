@@ -0,0 +1,236 @@
+/**
+ *  @file   PandoraSDK/benchmarks/tools/PandoraSDKReplay.cc
+ *
+ *  @brief  Replay events from binary files through the event reading algorithm and a configurable algorithm chain, reporting the event
+ *          throughput, per event latency percentiles and peak resident set size.
+ *
+ *  $Log: $
+ */
+
+#include "Api/PandoraApi.h"
+
+#include "Persistency/PandoraIO.h"
+
+#include "Templates/TemplateAlgorithm.h"
+
+#include "PlanarPseudoLayerPlugin.h"
+#include "SyntheticClusteringAlgorithm.h"
+#include "SyntheticMergingAlgorithm.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+using namespace pandora;
+using namespace pandora_benchmarks;
+
+/**
+ *  @brief  Print the usage of the tool
+ *
+ *  @param  pToolName the tool name
+ */
+void PrintUsage(const char *const pToolName)
+{
+    std::cout << "Usage: " << pToolName << " [options] eventFile [eventFile ...]" << std::endl
+              << "    -g geometryFile       read the geometry from a separate file (default: the first event file)" << std::endl
+              << "    -x settingsFile       run the algorithm chain in a settings file, which must configure its own event reading" << std::endl
+              << "                          (default: EventReading, Template, SyntheticClustering, SyntheticMerging)" << std::endl
+              << "    -t nThreads           number of pandora worker threads (default 1)" << std::endl
+              << "    -l layerPitch         pseudo layer pitch along z, units mm (default 5)" << std::endl
+              << "    -h                    print this help" << std::endl
+              << "Event files can be produced with PandoraSDKGenerateEvents -o fileName" << std::endl;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Write the default settings file, reading the events then running the template and synthetic algorithms
+ *
+ *  @param  settingsFileName the settings file name
+ *  @param  geometryFileName the geometry file name
+ *  @param  eventFileNames the event file names
+ *  @param  nThreads the number of pandora worker threads
+ */
+void WriteDefaultSettings(const std::string &settingsFileName, const std::string &geometryFileName, const StringVector &eventFileNames,
+    const unsigned int nThreads)
+{
+    std::ofstream settingsFile(settingsFileName);
+    settingsFile << "<pandora>\n"
+                 << "    <NThreads>" << nThreads << "</NThreads>\n"
+                 << "    <algorithm type = \"EventReading\">\n"
+                 << "        <GeometryFileName>" << geometryFileName << "</GeometryFileName>\n"
+                 << "        <EventFileNameList>";
+
+    for (const std::string &eventFileName : eventFileNames)
+        settingsFile << ((&eventFileName == &eventFileNames.front()) ? "" : " ") << eventFileName;
+
+    settingsFile << "</EventFileNameList>\n"
+                 << "    </algorithm>\n"
+                 << "    <algorithm type = \"Template\"/>\n"
+                 << "    <algorithm type = \"SyntheticClustering\"/>\n"
+                 << "    <algorithm type = \"SyntheticMerging\"/>\n"
+                 << "</pandora>\n";
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Get the latency at a given fraction of a sorted latency distribution, using the nearest rank
+ *
+ *  @param  sortedLatencies the sorted per event latencies
+ *  @param  fraction the fraction, in the range [0, 1]
+ *
+ *  @return the latency
+ */
+double GetQuantile(const std::vector<double> &sortedLatencies, const double fraction)
+{
+    const std::size_t rank(static_cast<std::size_t>(fraction * static_cast<double>(sortedLatencies.size() - 1) + 0.5));
+    return sortedLatencies.at(rank);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Get the peak resident set size of the process
+ *
+ *  @return the peak resident set size, units MB
+ */
+double GetPeakResidentSetSize()
+{
+    struct rusage resourceUsage;
+
+    if (0 != ::getrusage(RUSAGE_SELF, &resourceUsage))
+        return 0.;
+
+#ifdef __APPLE__
+    return static_cast<double>(resourceUsage.ru_maxrss) / (1024. * 1024.);
+#else
+    return static_cast<double>(resourceUsage.ru_maxrss) / 1024.;
+#endif
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    std::string geometryFileName, settingsFileName;
+    unsigned int nThreads(1);
+    float layerPitch(5.f);
+
+    int option(0);
+
+    while ((option = ::getopt(argc, argv, "g:x:t:l:h")) != -1)
+    {
+        switch (option)
+        {
+        case 'g': geometryFileName = optarg; break;
+        case 'x': settingsFileName = optarg; break;
+        case 't': nThreads = std::strtoul(optarg, nullptr, 10); break;
+        case 'l': layerPitch = std::strtof(optarg, nullptr); break;
+        case 'h':
+            PrintUsage(argv[0]);
+            return 0;
+        default:
+            PrintUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    const StringVector eventFileNames(argv + optind, argv + argc);
+
+    if (settingsFileName.empty() && eventFileNames.empty())
+    {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    if (geometryFileName.empty() && !eventFileNames.empty())
+        geometryFileName = eventFileNames.front();
+
+    std::vector<double> latencies;
+    double totalTime(0.);
+
+    try
+    {
+        const std::unique_ptr<Pandora> pPandora(new Pandora("PandoraSDKReplay"));
+        const Pandora &pandora(*pPandora);
+
+        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraApi::RegisterAlgorithmFactory(pandora, "Template", new TemplateAlgorithm::Factory));
+        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraApi::RegisterAlgorithmFactory(pandora, "SyntheticClustering",
+            new SyntheticClusteringAlgorithm::Factory));
+        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraApi::RegisterAlgorithmFactory(pandora, "SyntheticMerging",
+            new SyntheticMergingAlgorithm::Factory));
+        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraApi::SetPseudoLayerPlugin(pandora, new PlanarPseudoLayerPlugin(layerPitch)));
+
+        if (settingsFileName.empty())
+        {
+            const std::string defaultSettingsFileName((std::filesystem::temp_directory_path() / ("PandoraSDKReplay_" +
+                std::to_string(::getpid()) + ".xml")).string());
+
+            WriteDefaultSettings(defaultSettingsFileName, geometryFileName, eventFileNames, nThreads);
+            const StatusCode statusCode(PandoraApi::ReadSettings(pandora, defaultSettingsFileName));
+            std::remove(defaultSettingsFileName.c_str());
+
+            if (STATUS_CODE_SUCCESS != statusCode)
+                throw StatusCodeException(statusCode);
+        }
+        else
+        {
+            PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraApi::ReadSettings(pandora, settingsFileName));
+        }
+
+        const auto replayStartTime(std::chrono::steady_clock::now());
+
+        try
+        {
+            while (true)
+            {
+                const auto startTime(std::chrono::steady_clock::now());
+                PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraApi::ProcessEvent(pandora));
+                PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraApi::Reset(pandora));
+                latencies.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count());
+            }
+        }
+        catch (const StopProcessingException &)
+        {
+            // ATTN The event reading algorithm raises this once all event files are processed; the partial final event is not timed
+            PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraApi::Reset(pandora));
+        }
+
+        totalTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - replayStartTime).count();
+    }
+    catch (StatusCodeException &statusCodeException)
+    {
+        std::cout << argv[0] << ": " << statusCodeException.ToString() << std::endl;
+        return 1;
+    }
+
+    if (latencies.empty())
+    {
+        std::cout << argv[0] << ": no events processed" << std::endl;
+        return 1;
+    }
+
+    std::vector<double> sortedLatencies(latencies);
+    std::sort(sortedLatencies.begin(), sortedLatencies.end());
+    const double meanLatency(std::accumulate(latencies.begin(), latencies.end(), 0.) / static_cast<double>(latencies.size()));
+
+    std::cout << "Events processed: " << latencies.size() << " in " << totalTime << " s, " << (static_cast<double>(latencies.size()) / totalTime)
+              << " events/s" << std::endl
+              << "Event latency (ms): mean " << meanLatency << ", p50 " << GetQuantile(sortedLatencies, 0.5) << ", p90 "
+              << GetQuantile(sortedLatencies, 0.9) << ", p99 " << GetQuantile(sortedLatencies, 0.99) << ", max " << sortedLatencies.back() << std::endl
+              << "Peak resident set size: " << GetPeakResidentSetSize() << " MB" << std::endl;
+
+    return 0;
+}
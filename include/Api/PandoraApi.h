@@ -8,6 +8,11 @@
 #ifndef PANDORA_API_H
 #define PANDORA_API_H 1
 
+#include "Managers/MemoryUsage.h"
+#include "Managers/ProfileAggregator.h"
+
+#include "Objects/PfoExportTable.h"
+
 #include "Pandora/ObjectCreation.h"
 #include "Pandora/Pandora.h"
 #include "Pandora/PandoraObjectFactories.h"
@@ -42,7 +47,8 @@ public:
     };
 
     /**
-     *  @brief  Process an event
+     *  @brief  Process an event. If the MaxObjectsPerEvent budget is exceeded, the event is abandoned and STATUS_CODE_BUDGET_EXCEEDED
+     *          returned, after which PandoraApi::Reset releases the objects created so far, ready for the next event.
      * 
      *  @param  pandora the pandora instance to process event
      */
@@ -53,8 +59,11 @@ public:
      * 
      *  @param  pandora the pandora instance to run the algorithms initialize
      *  @param  xmlFileName the name of the xml file containing the settings
+     *  @param  settingsCacheFileName the name of a settings cache file, holding a binary image of the settings which is used whilst the
+     *          xml file is unchanged and otherwise rewritten, or empty to always parse the xml file
      */
-    static pandora::StatusCode ReadSettings(const pandora::Pandora &pandora, const std::string &xmlFileName);
+    static pandora::StatusCode ReadSettings(const pandora::Pandora &pandora, const std::string &xmlFileName,
+        const std::string &settingsCacheFileName = "");
 
     /**
      *  @brief  Register an algorithm factory with pandora
@@ -128,6 +137,51 @@ public:
     static pandora::StatusCode SetTrackToMCParticleRelationship(const pandora::Pandora &pandora, const void *const pTrackParentAddress,
         const void *const pMCParticleParentAddress, const float mcParticleWeight = 1);
 
+    /**
+     *  @brief  Set a batch of calo hit to mc particle relationships, equivalent to setting each relationship in turn
+     * 
+     *  @param  pandora the pandora instance to register the relationships with
+     *  @param  relationshipVector the relationships, each relating the address of a calo hit in the user framework to the address of
+     *          a mc particle in the user framework
+     */
+    static pandora::StatusCode SetCaloHitToMCParticleRelationships(const pandora::Pandora &pandora,
+        const pandora::MCParticleRelationshipVector &relationshipVector);
+
+    /**
+     *  @brief  Set a batch of track to mc particle relationships, equivalent to setting each relationship in turn
+     * 
+     *  @param  pandora the pandora instance to register the relationships with
+     *  @param  relationshipVector the relationships, each relating the address of a track in the user framework to the address of
+     *          a mc particle in the user framework
+     */
+    static pandora::StatusCode SetTrackToMCParticleRelationships(const pandora::Pandora &pandora,
+        const pandora::MCParticleRelationshipVector &relationshipVector);
+
+    /**
+     *  @brief  Provide the expected sizes of the upcoming event, so that internal containers can be reserved up front rather than
+     *          growing by repeated reallocation and rehashing. Call after any reset and before creating the objects for the event.
+     * 
+     *  @param  pandora the pandora instance to receive the hints
+     *  @param  nCaloHits the expected number of calo hits
+     *  @param  nTracks the expected number of tracks
+     *  @param  nMCParticles the expected number of mc particles
+     *  @param  nRelationships the expected number of calo hit and track to mc particle relationships
+     */
+    static pandora::StatusCode SetEventSizeHints(const pandora::Pandora &pandora, const unsigned int nCaloHits, const unsigned int nTracks,
+        const unsigned int nMCParticles, const unsigned int nRelationships);
+
+    /**
+     *  @brief  Add existing calo hits, owned by another pandora instance (e.g. a parent instance), to the input calo hits of this
+     *          instance by reference, rather than recreating them. The owning instance keeps ownership, so the calo hits must outlive
+     *          their use here, and the owning instance must not use them whilst this instance is processing. Shared calo hits keep
+     *          their pseudo layers and mc particle relationships and cannot be fragmented, merged or have their metadata altered here.
+     *          Their availability and index are restored when this instance is reset.
+     * 
+     *  @param  pandora the pandora instance with which to share the calo hits
+     *  @param  caloHitList the calo hits to share
+     */
+    static pandora::StatusCode ShareCaloHits(const pandora::Pandora &pandora, const pandora::CaloHitList &caloHitList);
+
     /**
      *  @brief  Get the current pfo list
      * 
@@ -145,6 +199,44 @@ public:
      */
     static pandora::StatusCode GetPfoList(const pandora::Pandora &pandora, const std::string &pfoListName, const pandora::PfoList *&pPfoList);
 
+    /**
+     *  @brief  Get a named cluster list
+     * 
+     *  @param  pandora the pandora instance to get the objects from
+     *  @param  clusterListName the name of the cluster list
+     *  @param  pClusterList to receive the address of the cluster list
+     */
+    static pandora::StatusCode GetClusterList(const pandora::Pandora &pandora, const std::string &clusterListName,
+        const pandora::ClusterList *&pClusterList);
+
+    /**
+     *  @brief  Get the current pfos separated by event id, for use when a batch of small events, each input object tagged with its
+     *          event id, has been processed together
+     * 
+     *  @param  pandora the pandora instance to get the objects from
+     *  @param  eventIdToPfoListMap to receive the current pfos, keyed by event id
+     */
+    static pandora::StatusCode GetCurrentPfoListsByEventId(const pandora::Pandora &pandora, pandora::EventIdToPfoListMap &eventIdToPfoListMap);
+
+    /**
+     *  @brief  Export the current pfos, their hierarchy, calo hits, tracks and vertices to a flattened, columnar table, in a single pass.
+     *          A table held by the caller across events reuses its storage.
+     * 
+     *  @param  pandora the pandora instance to get the objects from
+     *  @param  pfoExportTable to receive the exported pfos
+     */
+    static pandora::StatusCode ExportCurrentPfos(const pandora::Pandora &pandora, pandora::PfoExportTable &pfoExportTable);
+
+    /**
+     *  @brief  Export the pfos in a named list, their hierarchy, calo hits, tracks and vertices to a flattened, columnar table, in a
+     *          single pass. A table held by the caller across events reuses its storage.
+     * 
+     *  @param  pandora the pandora instance to get the objects from
+     *  @param  pfoListName the name of the pfo list
+     *  @param  pfoExportTable to receive the exported pfos
+     */
+    static pandora::StatusCode ExportPfos(const pandora::Pandora &pandora, const std::string &pfoListName, pandora::PfoExportTable &pfoExportTable);
+
     /**
      *  @brief  Set the external parameters associated with an algorithm instance of a specific type. It is enforced that there
      *          be only a single instance of an externally-configured algorithm, per algorithm type, per Pandora instance
@@ -209,6 +301,17 @@ public:
     static pandora::StatusCode RegisterEnergyCorrectionPlugin(const pandora::Pandora &pandora, const std::string &name,
         const pandora::EnergyCorrectionType energyCorrectionType, pandora::EnergyCorrectionPlugin *const pEnergyCorrectionPlugin);
 
+    /**
+     *  @brief  Register a calo hit energy correction plugin, whose corrections to the input calo hits are made once per event
+     * 
+     *  @param  pandora the pandora instance with which to register the calo hit energy correction plugin
+     *  @param  name the name/label associated with the calo hit energy correction plugin
+     *  @param  energyCorrectionType the energy correction type
+     *  @param  pCaloHitEnergyCorrectionPlugin address of the calo hit energy correction plugin (will pass ownership to pandora)
+     */
+    static pandora::StatusCode RegisterEnergyCorrectionPlugin(const pandora::Pandora &pandora, const std::string &name,
+        const pandora::EnergyCorrectionType energyCorrectionType, pandora::CaloHitEnergyCorrectionPlugin *const pCaloHitEnergyCorrectionPlugin);
+
     /**
      *  @brief  Register a particle id plugin
      * 
@@ -225,6 +328,84 @@ public:
      *  @param  pandora the pandora instance to reset
      */
     static pandora::StatusCode Reset(const pandora::Pandora &pandora);
+
+    /**
+     *  @brief  Reset pandora to process the next window of a continuous readout stream. Calo hits with time before the start of the
+     *          next window are retired, whilst those in the overlap region are carried over, together with their metadata, rather than
+     *          being recreated. Carried over calo hits are made available once more and lose their mc particle relationships, which
+     *          may be registered again for the next window. All other objects are reset as for PandoraApi::Reset. The user framework
+     *          objects addressed by carried over calo hits must persist until those calo hits are retired.
+     * 
+     *  @param  pandora the pandora instance to reset
+     *  @param  windowStartTime the start time of the next window, units ns
+     */
+    static pandora::StatusCode ResetWindow(const pandora::Pandora &pandora, const float windowStartTime);
+
+    /**
+     *  @brief  Print a summary table of the algorithm profiles accumulated so far (requires ShouldProfileAlgorithms setting)
+     * 
+     *  @param  pandora the pandora instance
+     */
+    static pandora::StatusCode PrintAlgorithmProfile(const pandora::Pandora &pandora);
+
+    /**
+     *  @brief  Write all algorithm invocations recorded so far to a file, in the chrome trace event (json) format, readable by
+     *          chrome://tracing or perfetto (requires ShouldRecordAlgorithmTrace setting)
+     * 
+     *  @param  pandora the pandora instance
+     *  @param  fileName the name of the output file
+     */
+    static pandora::StatusCode WriteAlgorithmTrace(const pandora::Pandora &pandora, const std::string &fileName);
+
+    /**
+     *  @brief  Print a summary of the event processing times recorded so far (requires ShouldRecordEventLatency setting)
+     * 
+     *  @param  pandora the pandora instance
+     */
+    static pandora::StatusCode PrintEventLatency(const pandora::Pandora &pandora);
+
+    /**
+     *  @brief  Get an event processing time quantile, from the event processing times recorded so far (requires ShouldRecordEventLatency
+     *          setting)
+     * 
+     *  @param  pandora the pandora instance
+     *  @param  fraction the fraction of events processed within the returned time, e.g. 0.99 for the 99th percentile
+     *  @param  latency to receive the event processing time quantile, units s
+     */
+    static pandora::StatusCode GetEventLatencyQuantile(const pandora::Pandora &pandora, const double fraction, double &latency);
+
+    /**
+     *  @brief  Print the current memory usage of each object manager and its high-water mark for the current event (requires
+     *          ShouldRecordMemoryUsage setting)
+     * 
+     *  @param  pandora the pandora instance
+     */
+    static pandora::StatusCode PrintMemoryUsage(const pandora::Pandora &pandora);
+
+    /**
+     *  @brief  Get the current memory usage of each object manager and its high-water mark for the current event, keyed by object type
+     *          (requires ShouldRecordMemoryUsage setting). The high-water marks are cleared by PandoraApi::Reset.
+     * 
+     *  @param  pandora the pandora instance
+     *  @param  currentUsageMap to receive the current memory usage of each object manager
+     *  @param  peakUsageMap to receive the memory usage high-water mark of each object manager
+     */
+    static pandora::StatusCode GetMemoryUsage(const pandora::Pandora &pandora, pandora::MemoryUsageMap &currentUsageMap,
+        pandora::MemoryUsageMap &peakUsageMap);
+
+    /**
+     *  @brief  Print the profile merged across all pandora instances in the process that enable the ShouldAggregateProfiles setting,
+     *          including instances already destroyed, e.g. at shutdown
+     */
+    static pandora::StatusCode PrintAggregatedProfile();
+
+    /**
+     *  @brief  Get the profile merged across all pandora instances in the process that enable the ShouldAggregateProfiles setting,
+     *          including instances already destroyed
+     * 
+     *  @param  summary to receive the merged profile
+     */
+    static pandora::StatusCode GetAggregatedProfile(pandora::ProfileAggregator::Summary &summary);
 };
 
 #endif // #ifndef PANDORA_API_H
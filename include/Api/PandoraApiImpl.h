@@ -32,6 +32,15 @@ private:
     template <typename PARAMETERS, typename OBJECT>
     StatusCode Create(const PARAMETERS &parameters, const ObjectFactory<PARAMETERS, OBJECT> &factory) const;
 
+    /**
+     *  @brief  Create a batch of objects for pandora
+     *
+     *  @param  parametersVector the parameters for each object
+     *  @param  factory the factory that performs the object allocation
+     */
+    template <typename PARAMETERS, typename OBJECT>
+    StatusCode Create(const std::vector<PARAMETERS> &parametersVector, const ObjectFactory<PARAMETERS, OBJECT> &factory) const;
+
     /**
      *  @brief  Process event
      */
@@ -41,8 +50,10 @@ private:
      *  @brief  Read pandora settings
      * 
      *  @param  xmlFileName the name of the xml file containing the settings
+     *  @param  settingsCacheFileName the name of a settings cache file, holding a binary image of the settings which is used whilst the
+     *          xml file is unchanged and otherwise rewritten, or empty to always parse the xml file
      */
-    StatusCode ReadSettings(const std::string &xmlFileName) const;
+    StatusCode ReadSettings(const std::string &xmlFileName, const std::string &settingsCacheFileName = "") const;
 
     /**
      *  @brief  Register an algorithm factory with pandora
@@ -104,6 +115,38 @@ private:
     StatusCode SetTrackToMCParticleRelationship(const void *const pTrackParentAddress, const void *const pMCParticleParentAddress,
         const float mcParticleWeight) const;
 
+    /**
+     *  @brief  Set a batch of calo hit to mc particle relationships
+     * 
+     *  @param  relationshipVector the calo hit to mc particle relationships
+     */
+    StatusCode SetCaloHitToMCParticleRelationships(const MCParticleRelationshipVector &relationshipVector) const;
+
+    /**
+     *  @brief  Set a batch of track to mc particle relationships
+     * 
+     *  @param  relationshipVector the track to mc particle relationships
+     */
+    StatusCode SetTrackToMCParticleRelationships(const MCParticleRelationshipVector &relationshipVector) const;
+
+    /**
+     *  @brief  Provide the expected sizes of the upcoming event, reserving the relevant manager containers
+     * 
+     *  @param  nCaloHits the expected number of calo hits
+     *  @param  nTracks the expected number of tracks
+     *  @param  nMCParticles the expected number of mc particles
+     *  @param  nRelationships the expected number of calo hit and track to mc particle relationships
+     */
+    StatusCode SetEventSizeHints(const unsigned int nCaloHits, const unsigned int nTracks, const unsigned int nMCParticles,
+        const unsigned int nRelationships) const;
+
+    /**
+     *  @brief  Add existing calo hits, owned by another pandora instance, to the input calo hits of this instance by reference
+     * 
+     *  @param  caloHitList the calo hits to share
+     */
+    StatusCode ShareCaloHits(const CaloHitList &caloHitList) const;
+
     /**
      *  @brief  Get the current pfo list
      * 
@@ -120,6 +163,36 @@ private:
      */
     StatusCode GetPfoList(const std::string &pfoListName, const PfoList *&pPfoList) const;
 
+    /**
+     *  @brief  Get a named cluster list
+     * 
+     *  @param  clusterListName the name of the cluster list
+     *  @param  pClusterList to receive the address of the cluster list
+     */
+    StatusCode GetClusterList(const std::string &clusterListName, const ClusterList *&pClusterList) const;
+
+    /**
+     *  @brief  Get the current pfos separated by event id
+     * 
+     *  @param  eventIdToPfoListMap to receive the current pfos, keyed by event id
+     */
+    StatusCode GetCurrentPfoListsByEventId(EventIdToPfoListMap &eventIdToPfoListMap) const;
+
+    /**
+     *  @brief  Export the current pfos to a flattened, columnar table
+     * 
+     *  @param  pfoExportTable to receive the exported pfos
+     */
+    StatusCode ExportCurrentPfos(PfoExportTable &pfoExportTable) const;
+
+    /**
+     *  @brief  Export the pfos in a named list to a flattened, columnar table
+     * 
+     *  @param  pfoListName the name of the pfo list
+     *  @param  pfoExportTable to receive the exported pfos
+     */
+    StatusCode ExportPfos(const std::string &pfoListName, PfoExportTable &pfoExportTable) const;
+
     /**
      *  @brief  Set the granularity level to be associated with a specified hit type
      * 
@@ -166,6 +239,16 @@ private:
     StatusCode RegisterEnergyCorrectionPlugin(const std::string &name, const EnergyCorrectionType energyCorrectionType,
         EnergyCorrectionPlugin *const pEnergyCorrectionPlugin) const;
 
+    /**
+     *  @brief  Register a calo hit energy correction plugin
+     * 
+     *  @param  name the name/label associated with the calo hit energy correction plugin
+     *  @param  energyCorrectionType the energy correction type
+     *  @param  pCaloHitEnergyCorrectionPlugin address of the calo hit energy correction plugin (will pass ownership to pandora)
+     */
+    StatusCode RegisterEnergyCorrectionPlugin(const std::string &name, const EnergyCorrectionType energyCorrectionType,
+        CaloHitEnergyCorrectionPlugin *const pCaloHitEnergyCorrectionPlugin) const;
+
     /**
      *  @brief  Register a particle id plugin
      * 
@@ -179,6 +262,51 @@ private:
      */
     StatusCode ResetEvent() const;
 
+    /**
+     *  @brief  Reset pandora to process the next window of a continuous readout stream, carrying over calo hits in the overlap region
+     * 
+     *  @param  windowStartTime the start time of the next window, units ns
+     */
+    StatusCode ResetWindow(const float windowStartTime) const;
+
+    /**
+     *  @brief  Print a summary table of the algorithm profiles accumulated so far
+     */
+    StatusCode PrintAlgorithmProfile() const;
+
+    /**
+     *  @brief  Write all algorithm invocations recorded so far to a file, in the chrome trace event (json) format
+     * 
+     *  @param  fileName the name of the output file
+     */
+    StatusCode WriteAlgorithmTrace(const std::string &fileName) const;
+
+    /**
+     *  @brief  Print a summary of the event processing times recorded so far
+     */
+    StatusCode PrintEventLatency() const;
+
+    /**
+     *  @brief  Get an event processing time quantile, from the event processing times recorded so far
+     * 
+     *  @param  fraction the fraction of events processed within the returned time, e.g. 0.99 for the 99th percentile
+     *  @param  latency to receive the event processing time quantile, units s
+     */
+    StatusCode GetEventLatencyQuantile(const double fraction, double &latency) const;
+
+    /**
+     *  @brief  Print the current memory usage of each object manager and its high-water mark for the current event
+     */
+    StatusCode PrintMemoryUsage() const;
+
+    /**
+     *  @brief  Get the current memory usage of each object manager and its high-water mark for the current event, keyed by object type
+     * 
+     *  @param  currentUsageMap to receive the current memory usage of each object manager
+     *  @param  peakUsageMap to receive the memory usage high-water mark of each object manager
+     */
+    StatusCode GetMemoryUsage(MemoryUsageMap &currentUsageMap, MemoryUsageMap &peakUsageMap) const;
+
     /**
      *  @brief  Constructor
      * 
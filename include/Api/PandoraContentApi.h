@@ -8,9 +8,13 @@
 #ifndef PANDORA_CONTENT_API_H
 #define PANDORA_CONTENT_API_H 1
 
+#include "Objects/SideTable.h"
+
 #include "Pandora/ObjectCreation.h"
 #include "Pandora/Pandora.h"
 #include "Pandora/PandoraObjectFactories.h"
+#include "Pandora/ScratchArena.h"
+#include "Pandora/ThreadPool.h"
 
 namespace pandora { class TiXmlElement; }
 
@@ -61,6 +65,38 @@ public:
     static const pandora::PluginManager *GetPlugins(const pandora::Algorithm &algorithm);
 
 
+    /* Parallel processing functions */
+
+    /**
+     *  @brief  Run a task for each of a number of items, using the thread pool owned by pandora and sized by the NThreads setting. The
+     *          task must not call any other PandoraContentApi functions. If any item fails, the status returned is that of the first
+     *          failing item in index order.
+     * 
+     *  @param  algorithm the algorithm calling this function
+     *  @param  nItems the number of items, e.g. the size of a vector of clusters or calo hits
+     *  @param  task the task to run for each item
+     *  @param  grainSize the number of consecutive items processed as a single unit of work
+     */
+    static pandora::StatusCode ParallelFor(const pandora::Algorithm &algorithm, const unsigned int nItems, const pandora::ParallelForTask &task,
+        const unsigned int grainSize = 1);
+
+    /**
+     *  @brief  Map each of a number of items to a value and combine the values into a result, using the thread pool owned by pandora.
+     *          The task must not call any other PandoraContentApi functions. Map must assign, not accumulate into, the default-constructed
+     *          value it receives. Values are combined in a fixed order, determined by the grain size alone, and the initial result is
+     *          combined only once, so the result is reproducible for any number of threads.
+     * 
+     *  @param  algorithm the algorithm calling this function
+     *  @param  nItems the number of items, e.g. the size of a vector of clusters or calo hits
+     *  @param  task the task mapping and combining the items
+     *  @param  result the initial result, to receive the combined result
+     *  @param  grainSize the number of consecutive items processed as a single unit of work
+     */
+    template <typename T>
+    static pandora::StatusCode ParallelReduce(const pandora::Algorithm &algorithm, const unsigned int nItems,
+        const pandora::ParallelReduceTask<T> &task, T &result, const unsigned int grainSize = 1);
+
+
     /* High-level steering functions */
 
     /**
@@ -81,6 +117,18 @@ public:
     static pandora::StatusCode CreateAlgorithmTool(const pandora::Algorithm &algorithm, pandora::TiXmlElement *const pXmlElement,
         pandora::AlgorithmTool *&pAlgorithmTool);
 
+    /**
+     *  @brief  Create a clone of a cloneable algorithm tool, via the algorithm tool factory and settings used for the original tool.
+     *          A parent algorithm can give each of its worker threads a separate clone, then merge the results on its own thread.
+     *          This function must be called by the parent algorithm, not from a worker thread. Clones are owned by pandora.
+     * 
+     *  @param  algorithm the parent algorithm, which will later run the algorithm tool clone
+     *  @param  pAlgorithmTool address of the algorithm tool to clone, for which IsCloneable must return true
+     *  @param  pAlgorithmToolClone to receive the address of the algorithm tool clone
+     */
+    static pandora::StatusCode CloneAlgorithmTool(const pandora::Algorithm &algorithm, const pandora::AlgorithmTool *const pAlgorithmTool,
+        pandora::AlgorithmTool *&pAlgorithmToolClone);
+
     /**
      *  @brief  Create an algorithm instance, via one of the algorithm factories registered with pandora.
      *          This function is expected to be called whilst reading the settings for a parent algorithm.
@@ -100,6 +148,15 @@ public:
      */
     static pandora::StatusCode RunDaughterAlgorithm(const pandora::Algorithm &algorithm, const std::string &daughterAlgorithmName);
 
+    /**
+     *  @brief  Run a sequence of algorithms registered with pandora, from within a parent algorithm. All names are checked before any
+     *          algorithm is run, then the algorithms are run in the order specified.
+     * 
+     *  @param  algorithm the parent algorithm, now attempting to run daughter algorithms
+     *  @param  daughterAlgorithmNames the names of the daughter algorithm instances to run
+     */
+    static pandora::StatusCode RunDaughterAlgorithms(const pandora::Algorithm &algorithm, const pandora::StringVector &daughterAlgorithmNames);
+
     /**
      *  @brief  Run a clustering algorithm (an algorithm that will create new cluster objects)
      * 
@@ -111,11 +168,23 @@ public:
     static pandora::StatusCode RunClusteringAlgorithm(const pandora::Algorithm &algorithm, const std::string &clusteringAlgorithmName,
         const pandora::ClusterList *&pNewClusterList, std::string &newClusterListName);
 
+    /**
+     *  @brief  Run a set of candidate clustering algorithms against the same input calo hits, e.g. to offer several reclustering
+     *          options to EndReclustering. Each candidate runs against its own calo hit metadata and temporary cluster list, so the
+     *          candidates are independent of one another. All algorithms must be registered before any are run.
+     * 
+     *  @param  algorithm the parent algorithm, now attempting to run the daughter clustering algorithms
+     *  @param  clusteringAlgorithmNames the names of the clustering algorithms to run
+     *  @param  newClusterListNames to receive the names of the new cluster lists populated, one per clustering algorithm
+     */
+    static pandora::StatusCode RunClusteringAlgorithms(const pandora::Algorithm &algorithm, const pandora::StringVector &clusteringAlgorithmNames,
+        pandora::StringVector &newClusterListNames);
+
 
     /* List-manipulation functions */
 
     /**
-     *  @brief  Get the current list
+     *  @brief  Get the current list. The list address is cached until the current list changes, so repeated calls are inexpensive.
      * 
      *  @param  algorithm the algorithm calling this function
      *  @param  pT to receive the address of the current list
@@ -142,6 +211,27 @@ public:
     template <typename T>
     static pandora::StatusCode GetCurrentListName(const pandora::Algorithm &algorithm, std::string &listName);
 
+    /**
+     *  @brief  Get the upper bound of the dense per-event object indices, for sizing vector side tables indexed by GetIndex()
+     * 
+     *  @param  algorithm the algorithm calling this function
+     *  @param  indexUpperBound to receive the index upper bound
+     */
+    template <typename T>
+    static pandora::StatusCode GetIndexUpperBound(const pandora::Algorithm &algorithm, unsigned int &indexUpperBound);
+
+    /**
+     *  @brief  Get a named side table, holding algorithm data attached to objects of type T, creating an empty table on first request.
+     *          Tables are owned by the algorithm and cleared, retaining their storage, when pandora is reset. Each request sizes the
+     *          table for all objects created so far in the event.
+     * 
+     *  @param  algorithm the algorithm calling this function
+     *  @param  name the side table name, unique within the algorithm
+     *  @param  pSideTable to receive the address of the side table
+     */
+    template <typename T, typename V>
+    static pandora::StatusCode GetSideTable(const pandora::Algorithm &algorithm, const std::string &name, pandora::SideTable<T, V> *&pSideTable);
+
     /**
      *  @brief  Replace the current list with a pre-saved list; use this new list as a permanent replacement
      *          for the current list (will persist outside the current algorithm)
@@ -262,6 +352,18 @@ public:
     template <typename T>
     static pandora::StatusCode CreateTemporaryListAndSetCurrent(const pandora::Algorithm &algorithm, const T *&pT, std::string &temporaryListName);
 
+    /**
+     *  @brief  Create a temporary calo hit list from a span of calo hits, e.g. a time window from the input calo hit time index, and set
+     *          it to be the current list. The list is filled directly from the span, without an intermediate copy.
+     * 
+     *  @param  algorithm the algorithm calling this function
+     *  @param  caloHitSpan the span of calo hits
+     *  @param  pCaloHitList to receive the address of the temporary list
+     *  @param  temporaryListName to receive the temporary list name
+     */
+    static pandora::StatusCode CreateTemporaryListAndSetCurrent(const pandora::Algorithm &algorithm, const pandora::CaloHitSpan &caloHitSpan,
+        const pandora::CaloHitList *&pCaloHitList, std::string &temporaryListName);
+
 
     /* Object-related functions */
 
@@ -302,7 +404,8 @@ public:
     /* CaloHit-related functions */
 
     /**
-     *  @brief  Add a calo hit, or a list of calo hits, to a cluster
+     *  @brief  Add a calo hit, or a list of calo hits, to a cluster. A list is added in a single batched update of the cluster
+     *          properties, and no hits are added unless all of them are available and can be added.
      *
      *  @param  algorithm the algorithm calling this function
      *  @param  pCluster address of the cluster to modify
@@ -371,6 +474,98 @@ public:
         const pandora::CaloHit *const pFragmentCaloHit2, const pandora::CaloHit *&pMergedCaloHit,
         const pandora::ObjectFactory<object_creation::CaloHitFragment::Parameters, object_creation::CaloHitFragment::Object> &factory = pandora::PandoraObjectFactory<object_creation::CaloHitFragment::Parameters, object_creation::CaloHitFragment::Object>());
 
+    /**
+     *  @brief  Get a read-only structure-of-arrays snapshot of the input calo hit list (position, energy, pseudo layer and hit type
+     *          arrays, plus the calo hit addresses), suitable for vectorised loops. The snapshot is rebuilt only when the input list
+     *          changes, and the address remains valid until the next change to the input list.
+     *
+     *  @param  algorithm the algorithm calling this function
+     *  @param  pCaloHitSnapshot to receive the address of the snapshot
+     */
+    static pandora::StatusCode GetInputCaloHitSnapshot(const pandora::Algorithm &algorithm, const pandora::CaloHitSnapshot *&pCaloHitSnapshot);
+
+    /**
+     *  @brief  Get a read-only index over the input calo hit list, sorted by calo hit time, supporting time window queries that return
+     *          spans of calo hits. The index is built on first request and rebuilt only when the input list changes, and the address,
+     *          and any spans obtained from it, remain valid until the next change to the input list.
+     *
+     *  @param  algorithm the algorithm calling this function
+     *  @param  pCaloHitTimeIndex to receive the address of the time index
+     */
+    static pandora::StatusCode GetInputCaloHitTimeIndex(const pandora::Algorithm &algorithm, const pandora::CaloHitTimeIndex *&pCaloHitTimeIndex);
+
+    /**
+     *  @brief  Get the partition of the input calo hit list for a single hit type, e.g. the hits in a single tpc view, in input list
+     *          order. Partitions are built once per event when ShouldPartitionInputCaloHits is specified in the pandora settings, and
+     *          are also available as saved lists named after the input list and hit type, e.g. Input_TPC_VIEW_U. Returns
+     *          STATUS_CODE_NOT_INITIALIZED if partitioning is disabled or the event contains no hits of the given type.
+     *
+     *  @param  algorithm the algorithm calling this function
+     *  @param  hitType the hit type
+     *  @param  pCaloHitList to receive the address of the calo hit list
+     */
+    static pandora::StatusCode GetInputCaloHitList(const pandora::Algorithm &algorithm, const pandora::HitType hitType,
+        const pandora::CaloHitList *&pCaloHitList);
+
+    /**
+     *  @brief  Get a read-only spatial index over the positions of all calo hits in a named list, supporting nearest, k-nearest and
+     *          radius queries. The index is shared between algorithms and rebuilt only when the contents of the list change, and the
+     *          address remains valid until the next change to the list.
+     *
+     *  @param  algorithm the algorithm calling this function
+     *  @param  listName the name of the calo hit list
+     *  @param  pCaloHitSpatialIndex to receive the address of the spatial index
+     */
+    static pandora::StatusCode GetCaloHitSpatialIndex(const pandora::Algorithm &algorithm, const std::string &listName,
+        const pandora::CaloHitSpatialIndex *&pCaloHitSpatialIndex);
+
+    /**
+     *  @brief  Get a read-only spatial index over the positions of the calo hits of a single hit type in a named list, e.g. the hits
+     *          in a single tpc view, for which the index is two-dimensional. The index is shared between algorithms and rebuilt only
+     *          when the contents of the list change, and the address remains valid until the next change to the list.
+     *
+     *  @param  algorithm the algorithm calling this function
+     *  @param  listName the name of the calo hit list
+     *  @param  hitType the hit type
+     *  @param  pCaloHitSpatialIndex to receive the address of the spatial index
+     */
+    static pandora::StatusCode GetCaloHitSpatialIndex(const pandora::Algorithm &algorithm, const std::string &listName,
+        const pandora::HitType hitType, const pandora::CaloHitSpatialIndex *&pCaloHitSpatialIndex);
+
+    /**
+     *  @brief  Get the read-only neighbour graph over the input calo hits, built once per event when a non-zero neighbour graph maximum
+     *          distance is specified in the pandora settings. The graph is unavailable after any calo hit fragmentation or merging.
+     *
+     *  @param  algorithm the algorithm calling this function
+     *  @param  pCaloHitNeighbourGraph to receive the address of the neighbour graph
+     */
+    static pandora::StatusCode GetCaloHitNeighbourGraph(const pandora::Algorithm &algorithm, const pandora::CaloHitNeighbourGraph *&pCaloHitNeighbourGraph);
+
+    /**
+     *  @brief  Get the read-only hit occupancy grid over the input calo hits of a lar tpc view, built once per event when a non-zero lar
+     *          tpc hit grid drift bin width is specified in the pandora settings. The grids are unavailable after any calo hit
+     *          fragmentation or merging, and there is no grid for a view without calo hits.
+     *
+     *  @param  algorithm the algorithm calling this function
+     *  @param  larTPC the lar tpc
+     *  @param  hitType the hit type of the view, TPC_VIEW_U, TPC_VIEW_V or TPC_VIEW_W
+     *  @param  pLArTPCHitGrid to receive the address of the hit grid
+     */
+    static pandora::StatusCode GetLArTPCHitGrid(const pandora::Algorithm &algorithm, const pandora::LArTPC &larTPC, const pandora::HitType hitType,
+        const pandora::LArTPCHitGrid *&pLArTPCHitGrid);
+
+    /**
+     *  @brief  Get the cluster containing a calo hit, in constant time, using the calo hit to cluster index maintained by the cluster
+     *          manager when requested in the pandora settings. During reclustering, the index refers to the cluster to which the calo
+     *          hit was most recently added, until the selected cluster list is chosen.
+     *
+     *  @param  algorithm the algorithm calling this function
+     *  @param  pCaloHit address of the calo hit
+     *  @param  pCluster to receive the address of the cluster containing the calo hit
+     */
+    static pandora::StatusCode GetCaloHitCluster(const pandora::Algorithm &algorithm, const pandora::CaloHit *const pCaloHit,
+        const pandora::Cluster *&pCluster);
+
 
     /* Track-related functions */
 
@@ -408,6 +603,55 @@ public:
      */
     static pandora::StatusCode RemoveAllTrackClusterAssociations(const pandora::Algorithm &algorithm);
 
+    /**
+     *  @brief  Get a snapshot of all associations between tracks and clusters, in input track list order. The snapshot is a flat
+     *          copy, one entry per associated track, so it is cheap to take before a reclustering attempt.
+     * 
+     *  @param  algorithm the algorithm calling this function
+     *  @param  associations to receive the track and cluster of each association
+     */
+    static pandora::StatusCode GetTrackClusterAssociations(const pandora::Algorithm &algorithm, pandora::TrackClusterAssociationVector &associations);
+
+    /**
+     *  @brief  Replace all associations between tracks and clusters with those in a snapshot, updating both the track and cluster
+     *          sides. The clusters in the snapshot must not have been deleted since it was taken.
+     * 
+     *  @param  algorithm the algorithm calling this function
+     *  @param  associations the track and cluster of each association
+     */
+    static pandora::StatusCode RestoreTrackClusterAssociations(const pandora::Algorithm &algorithm,
+        const pandora::TrackClusterAssociationVector &associations);
+
+    /**
+     *  @brief  Get a spatial index over the calorimeter projections of the input tracks, for nearest-track and within-radius
+     *          queries. The index is rebuilt only when the input list changes, and the address remains valid until the next change
+     *          to the input list.
+     *
+     *  @param  algorithm the algorithm calling this function
+     *  @param  pTrackSpatialIndex to receive the address of the spatial index
+     */
+    static pandora::StatusCode GetInputTrackSpatialIndex(const pandora::Algorithm &algorithm, const pandora::TrackSpatialIndex *&pTrackSpatialIndex);
+
+    /**
+     *  @brief  Get the parent, daughter and sibling relationships of the input tracks, flattened into contiguous per-track index
+     *          ranges for traversal without visiting the per-track lists. The graph is filled when the track associations are applied,
+     *          and the address remains valid until the next change to the input list.
+     *
+     *  @param  algorithm the algorithm calling this function
+     *  @param  pTrackRelationGraph to receive the address of the track relation graph
+     */
+    static pandora::StatusCode GetTrackRelationGraph(const pandora::Algorithm &algorithm, const pandora::TrackRelationGraph *&pTrackRelationGraph);
+
+    /**
+     *  @brief  Get the selection flag words of the input tracks, recording properties such as whether each track can form a pfo,
+     *          reaches the calorimeter or has an associated cluster, for selecting tracks by bitmask scan. The flags are updated as
+     *          track availability and cluster associations change, and the address remains valid until the end of the event.
+     *
+     *  @param  algorithm the algorithm calling this function
+     *  @param  pTrackSelectionMasks to receive the address of the track selection masks
+     */
+    static pandora::StatusCode GetTrackSelectionMasks(const pandora::Algorithm &algorithm, const pandora::TrackSelectionMasks *&pTrackSelectionMasks);
+
 
     /* MCParticle-related functions */
 
@@ -443,6 +687,27 @@ public:
     static pandora::StatusCode MergeAndDeleteClusters(const pandora::Algorithm &algorithm, const pandora::Cluster *const pClusterToEnlarge,
         const pandora::Cluster *const pClusterToDelete, const std::string &enlargeListName, const std::string &deleteListName);
 
+    /**
+     *  @brief  Get a spatial index over the inner pseudo layer centroids of the clusters in the current list, for nearest-cluster and
+     *          within-radius queries. Clusters without calo hits are omitted. The index is rebuilt by each call, and the address
+     *          remains valid only until clusters are next modified, created or deleted.
+     *
+     *  @param  algorithm the algorithm calling this function
+     *  @param  pClusterSpatialIndex to receive the address of the spatial index
+     */
+    static pandora::StatusCode GetCurrentClusterSpatialIndex(const pandora::Algorithm &algorithm, const pandora::ClusterSpatialIndex *&pClusterSpatialIndex);
+
+    /**
+     *  @brief  Get a cluster pair finder over the bounding boxes of the clusters in the current list, generating candidate cluster
+     *          pairs by sort-and-sweep rather than by testing all pairs. Clusters without calo hits are omitted. The finder is rebuilt
+     *          by each call, then kept up to date as clusters are merged, have calo hits added or removed, or are deleted. Clusters
+     *          created after the call are not included, and the finder is emptied whenever an algorithm finishes.
+     *
+     *  @param  algorithm the algorithm calling this function
+     *  @param  pClusterPairFinder to receive the address of the cluster pair finder
+     */
+    static pandora::StatusCode GetCurrentClusterPairFinder(const pandora::Algorithm &algorithm, const pandora::ClusterPairFinder *&pClusterPairFinder);
+
 
     /* Pfo-related functions */
 
@@ -487,6 +752,54 @@ public:
     static pandora::StatusCode RemovePfoParentDaughterRelationship(const pandora::Algorithm &algorithm, const pandora::ParticleFlowObject *const pParentPfo,
         const pandora::ParticleFlowObject *const pDaughterPfo);
 
+    /**
+     *  @brief  Get the flattened hierarchy of all particle flow objects, for range-scan queries of the pfos, clusters, tracks and calo
+     *          hits downstream of a pfo. The hierarchy is rebuilt only when pfos have been created or deleted, or parent-daughter
+     *          relationships altered, and the address remains valid only until pfos or their relationships are next modified.
+     *
+     *  @param  algorithm the algorithm calling this function
+     *  @param  pPfoHierarchy to receive the address of the pfo hierarchy
+     */
+    static pandora::StatusCode GetPfoHierarchy(const pandora::Algorithm &algorithm, const pandora::PfoHierarchy *&pPfoHierarchy);
+
+
+    /* Vertex-related functions */
+
+    /**
+     *  @brief  Get a spatial index over the positions of the vertices in a named list, for nearest-vertex and within-radius queries,
+     *          e.g. to find candidates near an existing vertex. The index is rebuilt by each call, and the address remains valid only
+     *          until vertices are next created or deleted, or another vertex list is indexed.
+     *
+     *  @param  algorithm the algorithm calling this function
+     *  @param  listName the name of the vertex list
+     *  @param  pVertexSpatialIndex to receive the address of the spatial index
+     */
+    static pandora::StatusCode GetVertexSpatialIndex(const pandora::Algorithm &algorithm, const std::string &listName,
+        const pandora::VertexSpatialIndex *&pVertexSpatialIndex);
+
+    /**
+     *  @brief  Merge nearby candidate vertices in a named list, deleting each available vertex that lies within the merge distance of
+     *          an earlier available vertex in the list. The earliest vertex of each group is retained, unaltered.
+     *
+     *  @param  algorithm the algorithm calling this function
+     *  @param  listName the name of the vertex list
+     *  @param  mergeDistance the merge distance, units mm
+     */
+    static pandora::StatusCode MergeNearbyVertices(const pandora::Algorithm &algorithm, const std::string &listName, const float mergeDistance);
+
+    /**
+     *  @brief  Summarise the calo hits in a named list around each of a vector of candidate vertices, using the shared calo hit
+     *          spatial index and the pandora thread pool, in place of a loop over all vertex and calo hit pairs
+     *
+     *  @param  algorithm the algorithm calling this function
+     *  @param  vertexVector the candidate vertices
+     *  @param  caloHitListName the name of the calo hit list
+     *  @param  summaryRadius the radius within which calo hits are counted and summed, units mm
+     *  @param  summaryVector to receive the summaries, one per vertex in the input order
+     */
+    static pandora::StatusCode GetVertexCaloHitSummaries(const pandora::Algorithm &algorithm, const pandora::VertexVector &vertexVector,
+        const std::string &caloHitListName, const float summaryRadius, pandora::VertexCaloHitSummaryVector &summaryVector);
+
 
     /* Reclustering functions */
 
@@ -531,6 +844,89 @@ public:
      *  @param  selectedClusterListName the name of the list containing the chosen recluster candidates (or the original candidates)
      */
     static pandora::StatusCode EndReclustering(const pandora::Algorithm &algorithm, const std::string &selectedClusterListName);
+
+
+    /* Checkpoint functions */
+
+    /**
+     *  @brief  Open a checkpoint, allowing speculative changes to be reverted. All subsequent changes to clusters, pfos, vertices and
+     *          track-cluster associations are recorded, until the checkpoint is rolled back or released; objects deleted meanwhile are
+     *          kept alive, detached from their lists, until the checkpoint is released. Only one checkpoint may be open at a time.
+     *          While it is open, list reorganisation (save, rename, replace, drop), daughter algorithms, reclustering, fragmentation,
+     *          calo hit fragment operations, bulk track-cluster association removal and cluster, pfo and vertex metadata changes are
+     *          not allowed. A checkpoint still open when its algorithm finishes is released.
+     * 
+     *  @param  algorithm the algorithm calling this function
+     */
+    static pandora::StatusCode CreateCheckpoint(const pandora::Algorithm &algorithm);
+
+    /**
+     *  @brief  Revert all changes recorded since the checkpoint was opened, most recent first, restoring the current cluster, pfo
+     *          and vertex lists, then close the checkpoint. The cost is proportional to the number of changes recorded. Objects
+     *          created since the checkpoint was opened are deleted. Cluster properties are restored by inverse updates, so sums of
+     *          floating point quantities may differ by rounding, and the order of objects within pfo and association lists may differ.
+     * 
+     *  @param  algorithm the algorithm calling this function, which must be that which opened the checkpoint
+     */
+    static pandora::StatusCode RollbackToCheckpoint(const pandora::Algorithm &algorithm);
+
+    /**
+     *  @brief  Keep all changes recorded since the checkpoint was opened, destroying any objects deleted meanwhile, then close the
+     *          checkpoint
+     * 
+     *  @param  algorithm the algorithm calling this function, which must be that which opened the checkpoint
+     */
+    static pandora::StatusCode ReleaseCheckpoint(const pandora::Algorithm &algorithm);
+
+private:
+    /**
+     *  @brief  Get the thread pool owned by pandora
+     * 
+     *  @param  algorithm the algorithm calling this function
+     * 
+     *  @return the address of the thread pool
+     */
+    static pandora::ThreadPool *GetThreadPool(const pandora::Algorithm &algorithm);
+
+    /**
+     *  @brief  Get the scratch arena owned by an algorithm
+     * 
+     *  @param  algorithm the algorithm calling this function
+     * 
+     *  @return the scratch arena
+     */
+    static pandora::ScratchArena &GetScratchArena(const pandora::Algorithm &algorithm);
 };
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline pandora::StatusCode PandoraContentApi::ParallelReduce(const pandora::Algorithm &algorithm, const unsigned int nItems,
+    const pandora::ParallelReduceTask<T> &task, T &result, const unsigned int grainSize)
+{
+    return PandoraContentApi::GetThreadPool(algorithm)->ParallelReduce(nItems, task, result, grainSize);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T, typename V>
+inline pandora::StatusCode PandoraContentApi::GetSideTable(const pandora::Algorithm &algorithm, const std::string &name,
+    pandora::SideTable<T, V> *&pSideTable)
+{
+    unsigned int indexUpperBound(0);
+    PANDORA_RETURN_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, PandoraContentApi::GetIndexUpperBound<T>(algorithm, indexUpperBound));
+
+    try
+    {
+        pSideTable = &PandoraContentApi::GetScratchArena(algorithm).GetBuffer<pandora::SideTable<T, V> >("SideTable:" + name);
+    }
+    catch (pandora::StatusCodeException &statusCodeException)
+    {
+        return statusCodeException.GetStatusCode();
+    }
+
+    pSideTable->Reserve(indexUpperBound);
+    return pandora::STATUS_CODE_SUCCESS;
+}
+
 #endif // #ifndef PANDORA_CONTENT_API_H
@@ -10,6 +10,8 @@
 
 #include "Api/PandoraContentApi.h"
 
+#include "Managers/ManagerCheckpoint.h"
+
 #include "Pandora/ObjectCreation.h"
 #include "Pandora/StatusCodes.h"
 
@@ -44,6 +46,32 @@ private:
     template<typename T>
     typename ReturnType<T>::Type *GetManager() const;
 
+    /**
+     *  @brief  VertexCaloHitSummaryTask class, summarising the calo hits around a single candidate vertex
+     */
+    class VertexCaloHitSummaryTask : public ParallelForTask
+    {
+    public:
+        /**
+         *  @brief  Constructor
+         *
+         *  @param  vertexVector the candidate vertices
+         *  @param  caloHitSpatialIndex the spatial index over the calo hits
+         *  @param  summaryRadius the radius within which calo hits are counted and summed, units mm
+         *  @param  summaryVector the summaries, presized to the number of vertices
+         */
+        VertexCaloHitSummaryTask(const VertexVector &vertexVector, const CaloHitSpatialIndex &caloHitSpatialIndex, const float summaryRadius,
+            VertexCaloHitSummaryVector &summaryVector);
+
+        StatusCode Run(const unsigned int index) const;
+
+    private:
+        const VertexVector             &m_vertexVector;         ///< The candidate vertices
+        const CaloHitSpatialIndex      &m_caloHitSpatialIndex;  ///< The spatial index over the calo hits
+        const float                     m_summaryRadius;        ///< The radius within which calo hits are counted and summed, units mm
+        VertexCaloHitSummaryVector     &m_summaryVector;        ///< The summaries, with one element per vertex
+    };
+
 
     /* Object-metadata manipulation */
 
@@ -94,6 +122,22 @@ private:
      */
     const PluginManager *GetPlugins() const;
 
+    /**
+     *  @brief  Get the thread pool for parallel loops within algorithms
+     * 
+     *  @return the address of the thread pool
+     */
+    ThreadPool *GetThreadPool() const;
+
+    /**
+     *  @brief  Get the scratch arena owned by an algorithm
+     * 
+     *  @param  algorithm the algorithm
+     * 
+     *  @return the scratch arena
+     */
+    ScratchArena &GetScratchArena(const Algorithm &algorithm) const;
+
 
     /* High-level steering functions */
 
@@ -111,6 +155,15 @@ private:
      */
     StatusCode CreateAlgorithmTool(TiXmlElement *const pXmlElement, AlgorithmTool *&pAlgorithmTool) const;
 
+    /**
+     *  @brief  Create a clone of a cloneable algorithm tool, for use on a separate worker thread.
+     *          This function is expected to be called by the parent algorithm, not from a worker thread.
+     * 
+     *  @param  pAlgorithmTool address of the algorithm tool to clone
+     *  @param  pAlgorithmToolClone to receive the address of the algorithm tool clone
+     */
+    StatusCode CloneAlgorithmTool(const AlgorithmTool *const pAlgorithmTool, AlgorithmTool *&pAlgorithmToolClone) const;
+
     /**
      *  @brief  Create an algorithm instance, via one of the algorithm factories registered with pandora.
      *          This function is expected to be called whilst reading the settings for a parent algorithm.
@@ -127,6 +180,13 @@ private:
      */
     StatusCode RunAlgorithm(const std::string &algorithmName) const;
 
+    /**
+     *  @brief  Run a sequence of algorithms registered with pandora, checking that all are registered before running any
+     * 
+     *  @param  algorithmNames the algorithm names
+     */
+    StatusCode RunAlgorithms(const StringVector &algorithmNames) const;
+
     /**
      *  @brief  Run a clustering algorithm (an algorithm that will create new cluster objects)
      * 
@@ -138,6 +198,16 @@ private:
      StatusCode RunClusteringAlgorithm(const Algorithm &algorithm, const std::string &clusteringAlgorithmName,
         const ClusterList *&pNewClusterList, std::string &newClusterListName) const;
 
+    /**
+     *  @brief  Run a set of candidate clustering algorithms, each against its own calo hit metadata and temporary cluster list,
+     *          checking that all are registered before running any
+     * 
+     *  @param  algorithm the algorithm calling this function
+     *  @param  clusteringAlgorithmNames the names of the clustering algorithms to run
+     *  @param  newClusterListNames to receive the names of the new cluster lists populated
+     */
+    StatusCode RunClusteringAlgorithms(const Algorithm &algorithm, const StringVector &clusteringAlgorithmNames, StringVector &newClusterListNames) const;
+
 
     /* List-manipulation functions */
 
@@ -150,6 +220,14 @@ private:
     template <typename T>
     StatusCode GetCurrentList(const T *&pT, std::string &listName) const;
 
+    /**
+     *  @brief  Get the current list, without copying its name
+     * 
+     *  @param  pT to receive the address of the current list
+     */
+    template <typename T>
+    StatusCode GetCurrentList(const T *&pT) const;
+
     /**
      *  @brief  Get the current list name
      * 
@@ -158,6 +236,14 @@ private:
     template <typename T>
     StatusCode GetCurrentListName(std::string &listName) const;
 
+    /**
+     *  @brief  Get the upper bound of the dense per-event object indices
+     * 
+     *  @param  indexUpperBound to receive the index upper bound
+     */
+    template <typename T>
+    StatusCode GetIndexUpperBound(unsigned int &indexUpperBound) const;
+
     /**
      *  @brief  Replace the current list with a pre-saved list; use this new list as a permanent replacement
      *          for the current list (will persist outside the current algorithm)
@@ -269,6 +355,17 @@ private:
     template <typename T>
     StatusCode CreateTemporaryListAndSetCurrent(const Algorithm &algorithm, const T *&pT, std::string &temporaryListName) const;
 
+    /**
+     *  @brief  Create a temporary calo hit list from a span of calo hits and set it to be the current list
+     * 
+     *  @param  algorithm the algorithm calling this function
+     *  @param  caloHitSpan the span of calo hits
+     *  @param  pCaloHitList to receive the address of the temporary list
+     *  @param  temporaryListName to receive the temporary list name
+     */
+    StatusCode CreateTemporaryListAndSetCurrent(const Algorithm &algorithm, const CaloHitSpan &caloHitSpan, const CaloHitList *&pCaloHitList,
+        std::string &temporaryListName) const;
+
 
     /* Object-related functions */
 
@@ -365,6 +462,69 @@ private:
     StatusCode MergeFragments(const CaloHit *const pFragmentCaloHit1, const CaloHit *const pFragmentCaloHit2,
         const CaloHit *&pMergedCaloHit, const ObjectFactory<object_creation::CaloHitFragment::Parameters, object_creation::CaloHitFragment::Object> &factory) const;
 
+    /**
+     *  @brief  Get a read-only structure-of-arrays snapshot of the input calo hit list
+     *
+     *  @param  pCaloHitSnapshot to receive the address of the snapshot
+     */
+    StatusCode GetInputCaloHitSnapshot(const CaloHitSnapshot *&pCaloHitSnapshot) const;
+
+    /**
+     *  @brief  Get a read-only index over the input calo hit list, sorted by calo hit time
+     *
+     *  @param  pCaloHitTimeIndex to receive the address of the time index
+     */
+    StatusCode GetInputCaloHitTimeIndex(const CaloHitTimeIndex *&pCaloHitTimeIndex) const;
+
+    /**
+     *  @brief  Get the partition of the input calo hit list for a single hit type
+     *
+     *  @param  hitType the hit type
+     *  @param  pCaloHitList to receive the address of the calo hit list
+     */
+    StatusCode GetInputCaloHitList(const HitType hitType, const CaloHitList *&pCaloHitList) const;
+
+    /**
+     *  @brief  Get a read-only spatial index over the positions of all calo hits in a named list
+     *
+     *  @param  listName the name of the calo hit list
+     *  @param  pCaloHitSpatialIndex to receive the address of the spatial index
+     */
+    StatusCode GetCaloHitSpatialIndex(const std::string &listName, const CaloHitSpatialIndex *&pCaloHitSpatialIndex) const;
+
+    /**
+     *  @brief  Get a read-only spatial index over the positions of the calo hits of a single hit type in a named list
+     *
+     *  @param  listName the name of the calo hit list
+     *  @param  hitType the hit type
+     *  @param  pCaloHitSpatialIndex to receive the address of the spatial index
+     */
+    StatusCode GetCaloHitSpatialIndex(const std::string &listName, const HitType hitType, const CaloHitSpatialIndex *&pCaloHitSpatialIndex) const;
+
+    /**
+     *  @brief  Get the read-only neighbour graph over the input calo hits
+     *
+     *  @param  pCaloHitNeighbourGraph to receive the address of the neighbour graph
+     */
+    StatusCode GetCaloHitNeighbourGraph(const CaloHitNeighbourGraph *&pCaloHitNeighbourGraph) const;
+
+    /**
+     *  @brief  Get the read-only hit occupancy grid over the input calo hits of a lar tpc view
+     *
+     *  @param  larTPC the lar tpc
+     *  @param  hitType the hit type of the view
+     *  @param  pLArTPCHitGrid to receive the address of the hit grid
+     */
+    StatusCode GetLArTPCHitGrid(const LArTPC &larTPC, const HitType hitType, const LArTPCHitGrid *&pLArTPCHitGrid) const;
+
+    /**
+     *  @brief  Get the cluster containing a calo hit, using the calo hit to cluster index
+     *
+     *  @param  pCaloHit address of the calo hit
+     *  @param  pCluster to receive the address of the cluster containing the calo hit
+     */
+    StatusCode GetCaloHitCluster(const CaloHit *const pCaloHit, const Cluster *&pCluster) const;
+
 
     /* Track-related functions */
 
@@ -394,6 +554,41 @@ private:
      */
     StatusCode RemoveAllTrackClusterAssociations() const;
 
+    /**
+     *  @brief  Get a snapshot of all associations between tracks and clusters
+     *
+     *  @param  associations to receive the track and cluster of each association
+     */
+    StatusCode GetTrackClusterAssociations(TrackClusterAssociationVector &associations) const;
+
+    /**
+     *  @brief  Replace all associations between tracks and clusters with those in a snapshot
+     *
+     *  @param  associations the track and cluster of each association
+     */
+    StatusCode RestoreTrackClusterAssociations(const TrackClusterAssociationVector &associations) const;
+
+    /**
+     *  @brief  Get a spatial index over the calorimeter projections of the input tracks, rebuilt only when the input list changes
+     *
+     *  @param  pTrackSpatialIndex to receive the address of the spatial index
+     */
+    StatusCode GetInputTrackSpatialIndex(const TrackSpatialIndex *&pTrackSpatialIndex) const;
+
+    /**
+     *  @brief  Get the flattened parent, daughter and sibling relationships of the input tracks
+     *
+     *  @param  pTrackRelationGraph to receive the address of the track relation graph
+     */
+    StatusCode GetTrackRelationGraph(const TrackRelationGraph *&pTrackRelationGraph) const;
+
+    /**
+     *  @brief  Get the selection flag words of the input tracks
+     *
+     *  @param  pTrackSelectionMasks to receive the address of the track selection masks
+     */
+    StatusCode GetTrackSelectionMasks(const TrackSelectionMasks *&pTrackSelectionMasks) const;
+
 
     /* MCParticle-related functions */
 
@@ -429,6 +624,20 @@ private:
     StatusCode MergeAndDeleteClusters(const Cluster *const pClusterToEnlarge, const Cluster *const pClusterToDelete, const std::string &enlargeListName,
         const std::string &deleteListName) const;
 
+    /**
+     *  @brief  Get a spatial index over the inner pseudo layer centroids of the clusters in the current list, rebuilt by each call
+     *
+     *  @param  pClusterSpatialIndex to receive the address of the spatial index
+     */
+    StatusCode GetCurrentClusterSpatialIndex(const ClusterSpatialIndex *&pClusterSpatialIndex) const;
+
+    /**
+     *  @brief  Get a cluster pair finder over the bounding boxes of the clusters in the current list, rebuilt by each call
+     *
+     *  @param  pClusterPairFinder to receive the address of the cluster pair finder
+     */
+    StatusCode GetCurrentClusterPairFinder(const ClusterPairFinder *&pClusterPairFinder) const;
+
 
     /* Pfo-related functions */
 
@@ -467,6 +676,44 @@ private:
      */
     StatusCode RemovePfoParentDaughterRelationship(const ParticleFlowObject *const pParentPfo, const ParticleFlowObject *const pDaughterPfo) const;
 
+    /**
+     *  @brief  Get the flattened hierarchy of all particle flow objects, rebuilt only if pfos or their relationships have changed
+     *
+     *  @param  pPfoHierarchy to receive the address of the pfo hierarchy
+     */
+    StatusCode GetPfoHierarchy(const PfoHierarchy *&pPfoHierarchy) const;
+
+
+    /* Vertex-related functions */
+
+    /**
+     *  @brief  Get a spatial index over the positions of the vertices in a named list, rebuilt by each call
+     *
+     *  @param  listName the name of the vertex list
+     *  @param  pVertexSpatialIndex to receive the address of the spatial index
+     */
+    StatusCode GetVertexSpatialIndex(const std::string &listName, const VertexSpatialIndex *&pVertexSpatialIndex) const;
+
+    /**
+     *  @brief  Merge nearby candidate vertices in a named list, deleting each available vertex within the merge distance of an earlier
+     *          available vertex in the list
+     *
+     *  @param  listName the name of the vertex list
+     *  @param  mergeDistance the merge distance, units mm
+     */
+    StatusCode MergeNearbyVertices(const std::string &listName, const float mergeDistance) const;
+
+    /**
+     *  @brief  Summarise the calo hits in a named list around each of a vector of candidate vertices
+     *
+     *  @param  vertexVector the candidate vertices
+     *  @param  caloHitListName the name of the calo hit list
+     *  @param  summaryRadius the radius within which calo hits are counted and summed, units mm
+     *  @param  summaryVector to receive the summaries, one per vertex in the input order
+     */
+    StatusCode GetVertexCaloHitSummaries(const VertexVector &vertexVector, const std::string &caloHitListName, const float summaryRadius,
+        VertexCaloHitSummaryVector &summaryVector) const;
+
 
     /* Reclustering functions */
 
@@ -512,6 +759,32 @@ private:
      */
     StatusCode EndReclustering(const Algorithm &algorithm, const std::string &selectedClusterListName) const;
 
+
+    /* Checkpoint functions */
+
+    /**
+     *  @brief  Open a checkpoint, from which all subsequent changes to clusters, pfos, vertices and track-cluster associations are
+     *          recorded, so that they may be rolled back. Only one checkpoint may be open at a time.
+     * 
+     *  @param  algorithm the algorithm calling this function
+     */
+    StatusCode CreateCheckpoint(const Algorithm &algorithm) const;
+
+    /**
+     *  @brief  Revert all changes recorded since the checkpoint was opened, most recent first, then close the checkpoint
+     * 
+     *  @param  algorithm the algorithm calling this function, which must be that which opened the checkpoint
+     */
+    StatusCode RollbackToCheckpoint(const Algorithm &algorithm) const;
+
+    /**
+     *  @brief  Keep all changes recorded since the checkpoint was opened, destroying any objects deleted meanwhile, then close the
+     *          checkpoint
+     * 
+     *  @param  algorithm the algorithm calling this function, which must be that which opened the checkpoint
+     */
+    StatusCode ReleaseCheckpoint(const Algorithm &algorithm) const;
+
 private:
     /**
      *  @brief  Constructor
@@ -520,6 +793,11 @@ private:
      */
     PandoraContentApiImpl(Pandora *const pPandora);
 
+    /**
+     *  @brief  Destructor
+     */
+    ~PandoraContentApiImpl();
+
     /**
      *  @brief  Whether a proposed addition to a cluster is allowed
      *
@@ -560,10 +838,66 @@ private:
      */
     StatusCode PostRunAlgorithm(Algorithm *const pAlgorithm) const;
 
-    Pandora    *m_pPandora;    ///< The pandora object to provide an interface to
+    /**
+     *  @brief  Whether the per-event object budget of any object manager has been exceeded, during the current event
+     * 
+     *  @return boolean
+     */
+    bool IsObjectBudgetExceeded() const;
+
+    /**
+     *  @brief  Record a change in the open checkpoint, if any
+     * 
+     *  @param  change the change
+     */
+    void RecordChange(const ManagerCheckpoint::Change &change) const;
+
+    /**
+     *  @brief  Delete a list of objects while a checkpoint is open, detaching the objects from their list and recording the deletions
+     * 
+     *  @param  pT address of the list of objects to delete
+     *  @param  listName the name of the list containing the objects
+     */
+    template <typename T>
+    StatusCode DeleteWithCheckpoint(const T *const pT, const std::string &listName) const;
+
+    /**
+     *  @brief  Revert a change recorded in the checkpoint
+     * 
+     *  @param  change the change
+     */
+    StatusCode RevertChange(const ManagerCheckpoint::Change &change) const;
+
+    /**
+     *  @brief  Revert the addition of an object to, or removal of an object from, a particle flow object
+     * 
+     *  @param  pPfo address of the particle flow object
+     *  @param  pT address of the cluster, track or vertex
+     *  @param  isAddition whether the object was added, rather than removed
+     */
+    template <typename T>
+    StatusCode RevertPfoContentChange(const ParticleFlowObject *const pPfo, const T *const pT, const bool isAddition) const;
+
+    /**
+     *  @brief  Restore the track and calo hit state of a detached cluster ahead of its reattachment
+     * 
+     *  @param  pCluster address of the detached cluster
+     *  @param  restoreCaloHitAvailability whether to mark the calo hits of the cluster as unavailable again
+     */
+    StatusCode RestoreDetachedCluster(const Cluster *const pCluster, const bool restoreCaloHitAvailability) const;
+
+    /**
+     *  @brief  Destroy the objects detached by the checkpoint and close the checkpoint, keeping all recorded changes
+     */
+    StatusCode ReleaseCheckpoint() const;
+
+    Pandora                *m_pPandora;         ///< The pandora object to provide an interface to
+    ManagerCheckpoint      *m_pCheckpoint;      ///< The checkpoint, recording changes for rollback while open
+    mutable unsigned int    m_algorithmDepth;   ///< The number of algorithms currently running, including parent algorithms
 
     friend class Pandora;
     friend class PandoraImpl;
+    friend class BinaryFileReader;
     friend class ::PandoraContentApi;
     template<typename PARAMETERS, typename METADATA, typename OBJECT> friend class ::object_creation::ObjectCreationHelper;
 };
@@ -232,27 +232,29 @@ private:
     ConcentricGap(const object_creation::Geometry::ConcentricGap::Parameters &parameters);
 
     /**
-     *  @brief  Populate list of polygon vertices, assuming regular polygon in XY plane at constant z coordinate
+     *  @brief  Populate the outward unit normals to the edges of a regular polygon in the XY plane, one per edge
      * 
-     *  @brief  rCoordinate polygon r coordinate
-     *  @brief  zCoordinate polygon z coordinate
-     *  @brief  phiCoordinate polygon phi coordinate
-     *  @brief  symmetryOrder polygon symmetry order
-     *  @param  vertexPointList to receive the vertex point list, with vertexPointList[symmetryOrder] = vertexPointList[0]
+     *  @param  phiCoordinate polygon phi coordinate
+     *  @param  symmetryOrder polygon symmetry order
+     *  @param  normalXVector to receive the edge normal x components
+     *  @param  normalYVector to receive the edge normal y components
      */
-    void GetPolygonVertices(const float rCoordinate, const float zCoordinate, const float phiCoordinate,
-        const unsigned int symmetryOrder, VertexPointList &vertexPointList) const;
+    void GetEdgeNormals(const float phiCoordinate, const unsigned int symmetryOrder, FloatVector &normalXVector, FloatVector &normalYVector) const;
 
     /**
-     *  @brief  Winding number test for a point in a 2D polygon in the XY plane (z coordinates are ignored)
+     *  @brief  Whether a point lies inside a regular polygon in the XY plane, i.e. whether its projection onto every edge normal is
+     *          below the polygon r coordinate (the distance from the origin to each edge). Polygons with fewer than three edges
+     *          enclose no area.
      * 
-     *  @param  point the test point
-     *  @param  vertexPointList vertex points of a polygon, with vertexPointList[symmetryOrder] = vertexPointList[0]
-     *  @param  symmetryOrder order of symmetry of polygon
+     *  @param  x the point x coordinate
+     *  @param  y the point y coordinate
+     *  @param  rCoordinate polygon r coordinate
+     *  @param  normalXVector the edge normal x components
+     *  @param  normalYVector the edge normal y components
      * 
      *  @return whether point is inside polygon
      */
-    bool IsIn2DPolygon(const CartesianVector &point, const VertexPointList &vertexPointList, const unsigned int symmetryOrder) const;
+    bool IsIn2DPolygon(const float x, const float y, const float rCoordinate, const FloatVector &normalXVector, const FloatVector &normalYVector) const;
 
     const float             m_minZCoordinate;       ///< Min cylindrical polar z coordinate, origin interaction point, units mm
     const float             m_maxZCoordinate;       ///< Max cylindrical polar z coordinate, origin interaction point, units mm
@@ -263,8 +265,11 @@ private:
     const float             m_outerPhiCoordinate;   ///< Outer cylindrical polar phi coordinate (angle wrt cartesian x axis)
     const unsigned int      m_outerSymmetryOrder;   ///< Order of symmetry of the outermost edge of gap
 
-    VertexPointList         m_innerVertexPointList; ///< The vertex points of the inner polygon
-    VertexPointList         m_outerVertexPointList; ///< The vertex points of the outer polygon
+    float                   m_outerRMax;            ///< The circumradius of the outer polygon, beyond which no point is in the gap, units mm
+    FloatVector             m_innerNormalXVector;   ///< The x components of the inner polygon edge normals
+    FloatVector             m_innerNormalYVector;   ///< The y components of the inner polygon edge normals
+    FloatVector             m_outerNormalXVector;   ///< The x components of the outer polygon edge normals
+    FloatVector             m_outerNormalYVector;   ///< The y components of the outer polygon edge normals
 
     friend class PandoraObjectFactory<object_creation::Geometry::ConcentricGap::Parameters, object_creation::Geometry::ConcentricGap::Object>;
 };
@@ -0,0 +1,232 @@
+/**
+ *  @file   PandoraSDK/include/Geometry/DetectorGapIndex.h
+ *
+ *  @brief  Header file for the detector gap index class.
+ *
+ *  $Log: $
+ */
+#ifndef PANDORA_DETECTOR_GAP_INDEX_H
+#define PANDORA_DETECTOR_GAP_INDEX_H 1
+
+#include "Objects/CartesianVector.h"
+
+#include "Pandora/PandoraEnumeratedTypes.h"
+#include "Pandora/PandoraInternal.h"
+
+namespace pandora
+{
+
+/**
+ *  @brief  DetectorGapIndex class, an acceleration structure answering whether a position lies in any registered detector gap.
+ *          Line gaps are held as sorted, coalesced intervals per view, whilst box and concentric gaps are held in a uniform 3D grid of
+ *          bounding boxes, with final decisions always made by the gaps' own IsInGap implementations.
+ */
+class DetectorGapIndex
+{
+public:
+    /**
+     *  @brief  Default constructor
+     */
+    DetectorGapIndex();
+
+    /**
+     *  @brief  Whether a specified position lies within any of the gaps applicable to the specified hit type: line gaps for tpc hit
+     *          types and box or concentric gaps for all hit types other than the 2D tpc views
+     *
+     *  @param  positionVector the position vector
+     *  @param  hitType the hit type, providing context to aid interpretation of provided position vector
+     *  @param  gapTolerance tolerance allowed when declaring a point to be "in" a gap region, units mm
+     *
+     *  @return boolean
+     */
+    bool IsInGap(const CartesianVector &positionVector, const HitType hitType, const float gapTolerance) const;
+
+private:
+    /**
+     *  @brief  IntervalList class, a run-length encoded list of line gap intervals along a single coordinate. Adjacent or overlapping
+     *          intervals are coalesced as they are added, so the list holds sorted, disjoint intervals, typically far fewer than the
+     *          line gaps for detectors with long runs of bad channels.
+     */
+    class IntervalList
+    {
+    public:
+        /**
+         *  @brief  Add an interval to the list, coalescing it with any adjacent or overlapping intervals. Intervals added in ascending
+         *          order, as for gaps listed by channel, are appended or merged with the last interval, without moving the others.
+         *
+         *  @param  start the interval start coordinate
+         *  @param  end the interval end coordinate
+         */
+        void Add(const float start, const float end);
+
+        /**
+         *  @brief  Whether a coordinate lies within any interval, using the same comparisons as LineGap::IsInGap. Coalescing means that a
+         *          coordinate on the boundary shared by adjacent gaps lies within the gap, as does, for a negative gap tolerance, a
+         *          coordinate within the tolerance of the boundary between two coalesced gaps.
+         *
+         *  @param  coordinate the coordinate
+         *  @param  gapTolerance the gap tolerance
+         *
+         *  @return boolean
+         */
+        bool Contains(const float coordinate, const float gapTolerance) const;
+
+        /**
+         *  @brief  Clear the list
+         */
+        void Clear();
+
+    private:
+        FloatVector             m_startVector;          ///< The start coordinates of the disjoint intervals, in ascending order
+        FloatVector             m_endVector;            ///< The end coordinates of the disjoint intervals, in ascending order
+    };
+
+    /**
+     *  @brief  BoundedGap class, describing a box or concentric gap and its axis-aligned bounding box
+     */
+    class BoundedGap
+    {
+    public:
+        const DetectorGap      *m_pDetectorGap;         ///< The address of the detector gap
+        float                   m_min[3];               ///< The bounding box minimum x, y and z coordinates, for zero gap tolerance
+        float                   m_max[3];               ///< The bounding box maximum x, y and z coordinates, for zero gap tolerance
+        float                   m_toleranceScale[3];    ///< The bounding box growth in x, y and z per unit of gap tolerance
+    };
+
+    typedef std::vector<BoundedGap> BoundedGapVector;
+
+    /**
+     *  @brief  Add a line gap to the index
+     *
+     *  @param  pLineGap address of the line gap
+     */
+    void Add(const LineGap *const pLineGap);
+
+    /**
+     *  @brief  Add a box gap to the index
+     *
+     *  @param  pBoxGap address of the box gap
+     */
+    void Add(const BoxGap *const pBoxGap);
+
+    /**
+     *  @brief  Add a concentric gap to the index
+     *
+     *  @param  pConcentricGap address of the concentric gap
+     */
+    void Add(const ConcentricGap *const pConcentricGap);
+
+    /**
+     *  @brief  Add a batch of line gaps to the index, adding the intervals in ascending order, so that each is appended or merged with
+     *          the last interval. Either all line gaps are added or, for an unrecognised line gap type, none are.
+     *
+     *  @param  lineGapVector the line gaps
+     */
+    void Add(const std::vector<const LineGap*> &lineGapVector);
+
+    /**
+     *  @brief  Add a batch of box gaps to the index, rebuilding the uniform grid once
+     *
+     *  @param  boxGapVector the box gaps
+     */
+    void Add(const std::vector<const BoxGap*> &boxGapVector);
+
+    /**
+     *  @brief  Add a batch of concentric gaps to the index, rebuilding the uniform grid once
+     *
+     *  @param  concentricGapVector the concentric gaps
+     */
+    void Add(const std::vector<const ConcentricGap*> &concentricGapVector);
+
+    /**
+     *  @brief  Add a box gap to the list of bounded or unbounded gaps, without rebuilding the uniform grid
+     *
+     *  @param  pBoxGap address of the box gap
+     */
+    void AddBoundedGap(const BoxGap *const pBoxGap);
+
+    /**
+     *  @brief  Add a concentric gap to the list of bounded or unbounded gaps, without rebuilding the uniform grid
+     *
+     *  @param  pConcentricGap address of the concentric gap
+     */
+    void AddBoundedGap(const ConcentricGap *const pConcentricGap);
+
+    /**
+     *  @brief  Clear the index
+     */
+    void Clear();
+
+    /**
+     *  @brief  Whether a specified position lies within any box or concentric gap
+     *
+     *  @param  positionVector the position vector
+     *  @param  hitType the hit type
+     *  @param  gapTolerance the gap tolerance
+     *
+     *  @return boolean
+     */
+    bool IsInBoundedGap(const CartesianVector &positionVector, const HitType hitType, const float gapTolerance) const;
+
+    /**
+     *  @brief  Whether a specified position lies within a bounded gap
+     *
+     *  @param  boundedGap the bounded gap
+     *  @param  position the position x, y and z coordinates
+     *  @param  positionVector the position vector
+     *  @param  hitType the hit type
+     *  @param  gapTolerance the gap tolerance
+     *
+     *  @return boolean
+     */
+    static bool IsInGap(const BoundedGap &boundedGap, const float *const position, const CartesianVector &positionVector, const HitType hitType,
+        const float gapTolerance);
+
+    /**
+     *  @brief  Pad a bounded gap bounding box, so that it safely contains all positions accepted by the gap
+     *
+     *  @param  boundedGap the bounded gap
+     */
+    static void AddMargin(BoundedGap &boundedGap);
+
+    /**
+     *  @brief  Rebuild the uniform grid using the current list of bounded gaps
+     */
+    void BuildGrid();
+
+    /**
+     *  @brief  Get the range of grid cells overlapping a coordinate range along a single axis
+     *
+     *  @param  axis the axis
+     *  @param  low the low edge of the coordinate range
+     *  @param  high the high edge of the coordinate range
+     *  @param  firstCell to receive the first overlapping cell
+     *  @param  lastCell to receive the last overlapping cell
+     *
+     *  @return whether the coordinate range overlaps the grid
+     */
+    bool GetCellRange(const unsigned int axis, const float low, const float high, unsigned int &firstCell, unsigned int &lastCell) const;
+
+    IntervalList                m_wireGapIntervalsU;    ///< The u view wire gap z intervals
+    IntervalList                m_wireGapIntervalsV;    ///< The v view wire gap z intervals
+    IntervalList                m_wireGapIntervalsW;    ///< The w view wire gap z intervals
+    IntervalList                m_driftGapIntervals;    ///< The drift gap x intervals
+
+    BoundedGapVector            m_boundedGapVector;     ///< The box and concentric gaps with finite bounding boxes, in creation order
+    BoundedGapVector            m_unboundedGapVector;   ///< The box and concentric gaps without finite bounding boxes, tested for every position
+    BoundedGapVector            m_largeGapVector;       ///< The bounded gaps overlapping too many grid cells, tested for every position
+    BoundedGapVector            m_griddedGapVector;     ///< The bounded gaps held in the grid
+    float                       m_gridMin[3];           ///< The grid minimum x, y and z coordinates
+    float                       m_gridMax[3];           ///< The grid maximum x, y and z coordinates
+    float                       m_inverseCellSize[3];   ///< The inverse of the grid cell size in x, y and z
+    unsigned int                m_nCells[3];            ///< The number of grid cells in x, y and z
+    float                       m_maxToleranceScale;    ///< The largest bounding box growth per unit of gap tolerance, for all gridded gaps
+    UIntVector                  m_cellOffsets;          ///< The offset of the first gap index for each grid cell, plus a final end offset
+    UIntVector                  m_cellGapIndices;       ///< The indices of the gridded gaps overlapping each cell
+
+    friend class GeometryManager;
+};
+
+} // namespace pandora
+
+#endif // #ifndef PANDORA_DETECTOR_GAP_INDEX_H
@@ -0,0 +1,110 @@
+/**
+ *  @file   PandoraSDK/include/Geometry/LArTPCIndex.h
+ *
+ *  @brief  Header file for the lar tpc index class.
+ *
+ *  $Log: $
+ */
+#ifndef PANDORA_LAR_TPC_INDEX_H
+#define PANDORA_LAR_TPC_INDEX_H 1
+
+#include "Objects/CartesianVector.h"
+
+#include "Pandora/PandoraInternal.h"
+#include "Pandora/StatusCodes.h"
+
+namespace pandora
+{
+
+/**
+ *  @brief  LArTPCIndex class, answering which lar tpc volume contains a position. The distinct volume boundaries along each axis
+ *          divide space into a non-uniform grid, so that a lookup is a binary search per axis followed by a check of the few
+ *          volumes touching the selected cell.
+ */
+class LArTPCIndex
+{
+public:
+    /**
+     *  @brief  Default constructor
+     */
+    LArTPCIndex();
+
+    /**
+     *  @brief  Get the lar tpc whose volume (center -/+ half width, boundaries inclusive) contains a specified position. If several
+     *          volumes contain the position, the lar tpc with the lowest volume id is returned.
+     *
+     *  @param  positionVector the position vector
+     *  @param  pLArTPC to receive the address of the lar tpc
+     */
+    StatusCode GetLArTPC(const CartesianVector &positionVector, const LArTPC *&pLArTPC) const;
+
+private:
+    /**
+     *  @brief  Volume class, describing a lar tpc and its extent
+     */
+    class Volume
+    {
+    public:
+        const LArTPC           *m_pLArTPC;              ///< The address of the lar tpc
+        float                   m_min[3];               ///< The volume minimum x, y and z coordinates
+        float                   m_max[3];               ///< The volume maximum x, y and z coordinates
+    };
+
+    typedef std::vector<Volume> VolumeVector;
+
+    /**
+     *  @brief  Refill the index using the contents of a lar tpc map
+     *
+     *  @param  larTPCMap the lar tpc map
+     */
+    void Fill(const LArTPCMap &larTPCMap);
+
+    /**
+     *  @brief  Clear the index
+     */
+    void Clear();
+
+    /**
+     *  @brief  Get the grid cell containing a coordinate along a single axis
+     *
+     *  @param  axis the axis
+     *  @param  coordinate the coordinate
+     *  @param  cell to receive the cell
+     *
+     *  @return whether the coordinate lies within the grid
+     */
+    bool GetCell(const unsigned int axis, const float coordinate, unsigned int &cell) const;
+
+    /**
+     *  @brief  Whether a volume contains a position
+     *
+     *  @param  volume the volume
+     *  @param  position the position x, y and z coordinates
+     *
+     *  @return boolean
+     */
+    static bool Contains(const Volume &volume, const float *const position);
+
+    static const unsigned int MAX_GRID_CELLS = 1 << 18; ///< The largest grid size, beyond which lookups scan over all volumes
+
+    VolumeVector                m_volumeVector;         ///< The volumes, in order of lar tpc volume id
+    FloatVector                 m_edgeVector[3];        ///< The distinct volume boundaries along x, y and z, in ascending order
+    unsigned int                m_nCells[3];            ///< The number of grid cells in x, y and z
+    bool                        m_isGridded;            ///< Whether lookups use the grid, rather than scanning over all volumes
+    UIntVector                  m_cellOffsets;          ///< The offset of the first volume index for each grid cell, plus a final end offset
+    UIntVector                  m_cellVolumeIndices;    ///< The indices of the volumes touching each cell, in order of lar tpc volume id
+
+    friend class GeometryManager;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool LArTPCIndex::Contains(const Volume &volume, const float *const position)
+{
+    return ((position[0] >= volume.m_min[0]) && (position[0] <= volume.m_max[0]) && (position[1] >= volume.m_min[1]) &&
+        (position[1] <= volume.m_max[1]) && (position[2] >= volume.m_min[2]) && (position[2] <= volume.m_max[2]));
+}
+
+} // namespace pandora
+
+#endif // #ifndef PANDORA_LAR_TPC_INDEX_H
@@ -160,6 +160,46 @@ public:
      */
     const SubDetectorLayerVector &GetSubDetectorLayerVector() const;
 
+    /**
+     *  @brief  Get the layer boundary table: the closest distances of the layers from the interaction point, in ascending order, i.e.
+     *          radii for barrel-like sub detectors and |z| coordinates for endcaps. Built once, when the sub detector is created.
+     * 
+     *  @return the layer boundaries, units mm
+     */
+    const FloatVector &GetLayerBoundaries() const;
+
+    /**
+     *  @brief  Get the layer coordinate of a position, comparable with the layer boundaries: |z| for endcaps and, for all other sub
+     *          detectors, the distance from the z axis to the plane of the nearest face of the inner polygon (or the cylindrical
+     *          radius for an inner symmetry order below three)
+     * 
+     *  @param  positionVector the position vector
+     * 
+     *  @return the layer coordinate, units mm
+     */
+    float GetLayerCoordinate(const CartesianVector &positionVector) const;
+
+    /**
+     *  @brief  Find the layer containing a specified layer coordinate, the outermost layer whose closest distance from the interaction
+     *          point does not exceed the coordinate, using a binary search of the layer boundary table
+     * 
+     *  @param  layerCoordinate the layer coordinate, units mm
+     *  @param  layer to receive the index of the layer in the sub detector layer vector
+     * 
+     *  @return STATUS_CODE_SUCCESS, or STATUS_CODE_NOT_FOUND if the coordinate lies inside the innermost layer
+     */
+    StatusCode FindLayer(const float layerCoordinate, unsigned int &layer) const;
+
+    /**
+     *  @brief  Find the layer containing a specified position, using its layer coordinate and a binary search of the layer boundary table
+     * 
+     *  @param  positionVector the position vector
+     *  @param  layer to receive the index of the layer in the sub detector layer vector
+     * 
+     *  @return STATUS_CODE_SUCCESS, or STATUS_CODE_NOT_FOUND if the position lies inside the innermost layer
+     */
+    StatusCode FindLayer(const CartesianVector &positionVector, unsigned int &layer) const;
+
 protected:
     /**
      *  @brief  Constructor
@@ -186,6 +226,11 @@ protected:
     bool                    m_isMirroredInZ;            ///< Whether a second sub detector exists, equivalent to a reflection in z=0 plane
     unsigned int            m_nLayers;                  ///< The number of layers in the sub detector section
     SubDetectorLayerVector  m_subDetectorLayerVector;   ///< The vector of layer parameters for the sub detector section
+    bool                    m_isEndCap;                 ///< Whether the sub detector is an endcap, with layers at fixed |z|
+    FloatVector             m_layerBoundaries;          ///< The closest distances of the layers from the interaction point, ascending
+    UIntVector              m_layerBoundaryIndices;     ///< The index in the sub detector layer vector of each layer boundary
+    FloatVector             m_faceCosines;              ///< The x components of the inner polygon face normals
+    FloatVector             m_faceSines;                ///< The y components of the inner polygon face normals
 
     friend class GeometryManager;
     friend class PandoraObjectFactory<object_creation::Geometry::SubDetector::Parameters, object_creation::Geometry::SubDetector::Object>;
@@ -313,6 +358,20 @@ inline const SubDetector::SubDetectorLayerVector &SubDetector::GetSubDetectorLay
     return m_subDetectorLayerVector;
 }
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const FloatVector &SubDetector::GetLayerBoundaries() const
+{
+    return m_layerBoundaries;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline StatusCode SubDetector::FindLayer(const CartesianVector &positionVector, unsigned int &layer) const
+{
+    return this->FindLayer(this->GetLayerCoordinate(positionVector), layer);
+}
+
 } // namespace pandora
 
 #endif // #ifndef PANDORA_SUB_DETECTOR_H
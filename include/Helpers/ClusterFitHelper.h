@@ -95,6 +95,142 @@ typedef std::vector<ClusterFitPoint> ClusterFitPointList;
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+/**
+ *  @brief  ClusterFitAccumulator class, holding the moment sums required for a linear fit to a set of cluster fit points. Points can be
+ *          added and removed in constant time, and accumulators for disjoint sets of points (e.g. pseudo layers) can be combined.
+ *          Positions are accumulated in double precision, relative to the first point added, so that the central moments do not
+ *          suffer from cancellation for points far from the origin.
+ */
+class ClusterFitAccumulator
+{
+public:
+    /**
+     *  @brief  Default constructor
+     */
+    ClusterFitAccumulator();
+
+    /**
+     *  @brief  Add a cluster fit point to the accumulator
+     * 
+     *  @param  clusterFitPoint the cluster fit point
+     */
+    void Add(const ClusterFitPoint &clusterFitPoint);
+
+    /**
+     *  @brief  Add a cluster fit point to the accumulator, with the specified weight in the linear fit. Points with a negative weight
+     *          are recorded as invalid, and cause subsequent fits to fail with STATUS_CODE_INVALID_PARAMETER.
+     * 
+     *  @param  clusterFitPoint the cluster fit point
+     *  @param  fitWeight the weight of the point in the linear fit
+     */
+    void Add(const ClusterFitPoint &clusterFitPoint, const float fitWeight);
+
+    /**
+     *  @brief  Remove a cluster fit point from the accumulator
+     * 
+     *  @param  clusterFitPoint the cluster fit point
+     */
+    void Remove(const ClusterFitPoint &clusterFitPoint);
+
+    /**
+     *  @brief  Add a calo hit to the accumulator. Hits with an invalid cell size are recorded, and cause subsequent fits to fail with
+     *          STATUS_CODE_INVALID_PARAMETER.
+     * 
+     *  @param  pCaloHit the address of the calo hit
+     */
+    void Add(const CaloHit *const pCaloHit);
+
+    /**
+     *  @brief  Remove a calo hit from the accumulator
+     * 
+     *  @param  pCaloHit the address of the calo hit
+     */
+    void Remove(const CaloHit *const pCaloHit);
+
+    /**
+     *  @brief  Add the contents of a second accumulator to this accumulator
+     * 
+     *  @param  rhs the second accumulator
+     */
+    ClusterFitAccumulator &operator+=(const ClusterFitAccumulator &rhs);
+
+    /**
+     *  @brief  Reset the accumulator, emptying its contents
+     */
+    void Reset();
+
+    /**
+     *  @brief  Get the number of points in the accumulator
+     * 
+     *  @return the number of points
+     */
+    unsigned int GetNPoints() const;
+
+    /**
+     *  @brief  Get the sum of the weights of the points in the linear fit, equal to the number of points unless weights are specified
+     * 
+     *  @return the sum of the fit weights
+     */
+    double GetFitWeightSum() const;
+
+    /**
+     *  @brief  Get the sum of the cell normal vectors of the points in the accumulator
+     * 
+     *  @return the sum of the cell normal vectors
+     */
+    CartesianVector GetCellNormalVectorSum() const;
+
+    /**
+     *  @brief  Get the sum of the cell sizes of the points in the accumulator
+     * 
+     *  @return the sum of the cell sizes
+     */
+    float GetCellSizeSum() const;
+
+    /**
+     *  @brief  Get the sum of the energies of the points in the accumulator
+     * 
+     *  @return the sum of the energies
+     */
+    float GetEnergySum() const;
+
+private:
+    /**
+     *  @brief  Add (or, for a negative scale, remove) the contributions of a point to the accumulator
+     * 
+     *  @param  position the position vector of the point
+     *  @param  cellNormalVector the normal vector to the cell in which the point was recorded
+     *  @param  cellSize the size of the cell in which the point was recorded
+     *  @param  energy the energy deposited in the cell in which the point was recorded
+     *  @param  pseudoLayer the pseudolayer in which the point was recorded
+     *  @param  scale +1 to add the point, -1 to remove the point
+     *  @param  fitWeight the weight of the point in the linear fit
+     */
+    void Accumulate(const CartesianVector &position, const CartesianVector &cellNormalVector, const float cellSize, const float energy,
+        const unsigned int pseudoLayer, const double scale, const double fitWeight);
+
+    int                     m_nPoints;                      ///< The number of points
+    int                     m_nInvalidPoints;               ///< The number of points with an invalid cell size or fit weight
+    bool                    m_hasReferencePosition;         ///< Whether the reference position has been set
+    double                  m_referencePosition[3];         ///< The reference position, relative to which all positions are accumulated
+    double                  m_fitWeightSum;                 ///< The sum of the fit weights
+    double                  m_positionSum[3];               ///< The fit-weighted sum of the x, y and z relative positions
+    double                  m_positionProductSum[3][3];     ///< The fit-weighted sums of the products of the relative positions
+    double                  m_weightSum;                    ///< The fit-weighted sum of the inverse squared position errors
+    double                  m_weightedPositionSum[3];       ///< The error- and fit-weighted sum of the relative positions
+    double                  m_weightedPositionProductSum[3][3]; ///< The error- and fit-weighted sums of the products of the relative positions
+    double                  m_layerSum;                     ///< The fit-weighted sum of the pseudo layers
+    double                  m_layerSquaredSum;              ///< The fit-weighted sum of the squared pseudo layers
+    double                  m_layerPositionSum[3];          ///< The fit-weighted sum of the products of pseudo layer and relative position
+    double                  m_cellNormalVectorSum[3];       ///< The sum of the cell normal vectors
+    double                  m_cellSizeSum;                  ///< The sum of the cell sizes
+    double                  m_energySum;                    ///< The sum of the energies
+
+    friend class ClusterFitHelper;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 /**
  *  @brief  ClusterFitResult class
  */
@@ -214,6 +350,24 @@ typedef std::vector<ClusterFitResult> ClusterFitResultList;
 class ClusterFitHelper
 {
 public:
+    /**
+     *  @brief  FitPointWeighting enum, the weighting of cluster fit points in the linear fit
+     */
+    enum FitPointWeighting
+    {
+        UNIT_WEIGHTS,
+        ENERGY_WEIGHTS
+    };
+
+    /**
+     *  @brief  FitPointOrdering enum, the order in which cluster fit points are accumulated for the linear fit
+     */
+    enum FitPointOrdering
+    {
+        INPUT_ORDER,
+        DETERMINISTIC_ORDER
+    };
+
     /**
      *  @brief  Fit points in first n occupied pseudolayers of a cluster
      * 
@@ -263,24 +417,117 @@ public:
         ClusterFitResult &clusterFitResult);
 
     /**
-     *  @brief  Perform linear regression of x vs d and y vs d and z vs d (assuming same error on all hits)
+     *  @brief  Fit points in first n occupied pseudolayers of each of a vector of clusters
+     * 
+     *  @param  clusterVector the vector of clusters to fit
+     *  @param  maxOccupiedLayers the maximum number of occupied pseudo layers to consider
+     *  @param  clusterFitResultList to receive the cluster fit results, one per cluster in the input order (failed fits are flagged as
+     *          unsuccessful)
+     */
+    static StatusCode FitStart(const ClusterVector &clusterVector, const unsigned int maxOccupiedLayers, ClusterFitResultList &clusterFitResultList);
+
+    /**
+     *  @brief  Fit points in last n occupied pseudolayers of each of a vector of clusters
+     * 
+     *  @param  clusterVector the vector of clusters to fit
+     *  @param  maxOccupiedLayers the maximum number of occupied pseudo layers to consider
+     *  @param  clusterFitResultList to receive the cluster fit results, one per cluster in the input order (failed fits are flagged as
+     *          unsuccessful)
+     */
+    static StatusCode FitEnd(const ClusterVector &clusterVector, const unsigned int maxOccupiedLayers, ClusterFitResultList &clusterFitResultList);
+
+    /**
+     *  @brief  Fit all points in each of a vector of clusters
+     * 
+     *  @param  clusterVector the vector of clusters to fit
+     *  @param  clusterFitResultList to receive the cluster fit results, one per cluster in the input order (failed fits are flagged as
+     *          unsuccessful)
+     */
+    static StatusCode FitFullCluster(const ClusterVector &clusterVector, ClusterFitResultList &clusterFitResultList);
+
+    /**
+     *  @brief  Perform linear regression of x vs d and y vs d and z vs d (assuming same error on all hits), in a single pass over the
+     *          points in input order. Reordering the points may change the last bits of the double precision sums.
+     * 
+     *  @param  clusterFitPointList list of cluster fit points
+     *  @param  clusterFitResult to receive the cluster fit result
+     */
+    static StatusCode FitPoints(const ClusterFitPointList &clusterFitPointList, ClusterFitResult &clusterFitResult);
+
+    /**
+     *  @brief  Perform linear regression of x vs d and y vs d and z vs d (assuming same error on all hits), with the points optionally
+     *          weighted by energy. The deterministic ordering sorts a copy of the points before accumulation, giving bit-identical
+     *          results for any input order, at the cost of the sort.
      * 
      *  @param  clusterFitPointList list of cluster fit points
+     *  @param  fitPointWeighting the weighting of the points
+     *  @param  fitPointOrdering the order in which to accumulate the points
      *  @param  clusterFitResult to receive the cluster fit result
      */
-    static StatusCode FitPoints(ClusterFitPointList &clusterFitPointList, ClusterFitResult &clusterFitResult);
+    static StatusCode FitPoints(const ClusterFitPointList &clusterFitPointList, const FitPointWeighting fitPointWeighting,
+        const FitPointOrdering fitPointOrdering, ClusterFitResult &clusterFitResult);
+
+    /**
+     *  @brief  Perform linear regression of x vs d and y vs d and z vs d (assuming same error on all hits), using accumulated moment sums
+     * 
+     *  @param  clusterFitAccumulator the cluster fit accumulator
+     *  @param  clusterFitResult to receive the cluster fit result
+     */
+    static StatusCode FitPoints(const ClusterFitAccumulator &clusterFitAccumulator, ClusterFitResult &clusterFitResult);
 
 private:
     /**
-     *  @brief  Perform linear fit to cluster fit points
+     *  @brief  Perform linear fit to accumulated cluster fit points
      * 
      *  @param  centralPosition central position of the cluster fit points
      *  @param  centralDirection central direction of normal to cluster fit calorimeter cells
-     *  @param  clusterFitPointList list of cluster fit points
+     *  @param  clusterFitAccumulator the cluster fit accumulator
      *  @param  clusterFitResult to receive the cluster fit result
      */
     static StatusCode PerformLinearFit(const CartesianVector &centralPosition, const CartesianVector &centralDirection,
-        ClusterFitPointList &clusterFitPointList, ClusterFitResult &clusterFitResult);
+        const ClusterFitAccumulator &clusterFitAccumulator, ClusterFitResult &clusterFitResult);
+
+    /**
+     *  @brief  Get the rotation matrix taking a vector into the (p, q, r) fit frame, in which the r axis is the specified direction
+     * 
+     *  @param  centralDirection the central direction, defining the r axis
+     *  @param  rotation to receive the rows of the rotation matrix
+     */
+    static void GetRotationMatrix(const CartesianVector &centralDirection, double rotation[3][3]);
+
+    /**
+     *  @brief  Get the first and second moments of a set of positions about a specified centre, given the accumulated sums
+     * 
+     *  @param  sum the (weighted) sum of the positions, relative to the accumulator reference position
+     *  @param  productSum the (weighted) sums of the products of the positions, relative to the accumulator reference position
+     *  @param  weightSum the sum of the weights
+     *  @param  centre the centre, relative to the accumulator reference position
+     *  @param  firstMoment to receive the first moment about the centre
+     *  @param  secondMoment to receive the second moment about the centre
+     */
+    static void GetCentralMoments(const double sum[3], const double productSum[3][3], const double weightSum, const double centre[3],
+        double firstMoment[3], double secondMoment[3][3]);
+
+    /**
+     *  @brief  Get the scalar product of two three-vectors
+     * 
+     *  @param  lhs the first three-vector
+     *  @param  rhs the second three-vector
+     * 
+     *  @return the scalar product
+     */
+    static double GetProduct(const double lhs[3], const double rhs[3]);
+
+    /**
+     *  @brief  Get the product lhs^T . matrix . rhs of two three-vectors and a three by three matrix
+     * 
+     *  @param  lhs the first three-vector
+     *  @param  matrix the matrix
+     *  @param  rhs the second three-vector
+     * 
+     *  @return the product
+     */
+    static double GetProduct(const double lhs[3], const double matrix[3][3], const double rhs[3]);
 };
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -322,6 +569,43 @@ inline unsigned int ClusterFitPoint::GetPseudoLayer() const
 //------------------------------------------------------------------------------------------------------------------------------------------
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+inline unsigned int ClusterFitAccumulator::GetNPoints() const
+{
+    return static_cast<unsigned int>(m_nPoints);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline double ClusterFitAccumulator::GetFitWeightSum() const
+{
+    return m_fitWeightSum;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline CartesianVector ClusterFitAccumulator::GetCellNormalVectorSum() const
+{
+    return CartesianVector(static_cast<float>(m_cellNormalVectorSum[0]), static_cast<float>(m_cellNormalVectorSum[1]),
+        static_cast<float>(m_cellNormalVectorSum[2]));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline float ClusterFitAccumulator::GetCellSizeSum() const
+{
+    return static_cast<float>(m_cellSizeSum);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline float ClusterFitAccumulator::GetEnergySum() const
+{
+    return static_cast<float>(m_energySum);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 inline ClusterFitResult::ClusterFitResult() :
     m_isFitSuccessful(false),
     m_direction(0.f, 0.f, 0.f),
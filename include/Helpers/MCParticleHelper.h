@@ -29,6 +29,37 @@ public:
      */
     template <typename T>
     static const MCParticle *GetMainMCParticle(const T *const pT);
+
+    /**
+     *  @brief  Find the main mc particle for each calo hit or track in a list, using the values cached when the mc particles are set
+     * 
+     *  @param  pTList address of the calo hit list or track list to examine
+     *  @param  mainMCParticleVector to receive the address of the main mc particle for each object, in list order, with nullptr for
+     *          objects without a contributing mc particle
+     */
+    template <typename T>
+    static void GetMainMCParticles(const T *const pTList, MCParticleVector &mainMCParticleVector);
+
+    /**
+     *  @brief  Find the mc particle with the largest weight in a mc particle weight map, with ties resolved using the mc particle sort
+     *          order. Only mc particles with positive weight are considered.
+     * 
+     *  @param  mcParticleWeightMap the mc particle weight map
+     * 
+     *  @return address of the main mc particle, nullptr if there is no mc particle with positive weight
+     */
+    static const MCParticle *FindMainMCParticle(const MCParticleWeightMap &mcParticleWeightMap);
+
+private:
+    /**
+     *  @brief  Find the mc particle making the largest contribution to a specified collection of calo hits
+     * 
+     *  @param  caloHits the calo hit container or range to examine
+     * 
+     *  @return address of the main mc particle
+     */
+    template <typename T>
+    static const MCParticle *GetMainMCParticleFromCaloHits(const T &caloHits);
 };
 
 } // namespace pandora
@@ -0,0 +1,137 @@
+/**
+ *  @file   PandoraSDK/include/Helpers/SettingsCacheHelper.h
+ * 
+ *  @brief  Header file for the settings cache helper class.
+ * 
+ *  $Log: $
+ */
+#ifndef PANDORA_SETTINGS_CACHE_HELPER_H
+#define PANDORA_SETTINGS_CACHE_HELPER_H 1
+
+#include "Pandora/StatusCodes.h"
+
+#include "Xml/tinyxml.h"
+
+#include <cstdint>
+#include <string>
+
+namespace pandora
+{
+
+/**
+ *  @brief  SettingsCacheHelper class, loading pandora settings via a compact binary image of the resolved xml element tree. The image
+ *          records a hash of the xml file contents and is only used whilst the xml file is unchanged, otherwise the xml file is parsed
+ *          and the image rewritten. Comments and declarations are not retained. Images use native byte order and are intended as a
+ *          local cache, not for exchange between machines.
+ */
+class SettingsCacheHelper
+{
+public:
+    /**
+     *  @brief  Load the settings from an xml file into an xml document, using and maintaining a settings cache file
+     * 
+     *  @param  xmlFileName the name of the xml file containing the settings
+     *  @param  cacheFileName the name of the settings cache file
+     *  @param  xmlDocument to receive the settings
+     * 
+     *  @return STATUS_CODE_SUCCESS, or STATUS_CODE_FAILURE if the xml file is unreadable or invalid
+     */
+    static StatusCode LoadSettings(const std::string &xmlFileName, const std::string &cacheFileName, TiXmlDocument &xmlDocument);
+
+private:
+    /**
+     *  @brief  Node type, as recorded in the settings cache
+     */
+    enum NodeType
+    {
+        ELEMENT_NODE,
+        TEXT_NODE,
+        CDATA_NODE
+    };
+
+    /**
+     *  @brief  Read the full contents of a file
+     * 
+     *  @param  fileName the file name
+     *  @param  contents to receive the contents
+     * 
+     *  @return whether the file could be read
+     */
+    static bool ReadFile(const std::string &fileName, std::string &contents);
+
+    /**
+     *  @brief  Get a 64-bit hash of a block of memory
+     * 
+     *  @param  pContents address of the block
+     *  @param  size the size of the block
+     * 
+     *  @return the hash
+     */
+    static uint64_t GetHash(const char *const pContents, const size_t size);
+
+    /**
+     *  @brief  Rebuild an xml document from a settings cache image
+     * 
+     *  @param  cacheImage the settings cache image
+     *  @param  xmlHash the hash of the current xml file contents
+     *  @param  xmlDocument to receive the rebuilt element tree
+     * 
+     *  @return whether the image was valid and up to date
+     */
+    static bool ReadCacheImage(const std::string &cacheImage, const uint64_t xmlHash, TiXmlDocument &xmlDocument);
+
+    /**
+     *  @brief  Write a settings cache image for an xml document, via a temporary file renamed into place
+     * 
+     *  @param  xmlDocument the xml document
+     *  @param  xmlHash the hash of the xml file contents
+     *  @param  cacheFileName the name of the settings cache file
+     * 
+     *  @return whether the image was written
+     */
+    static bool WriteCacheImage(const TiXmlDocument &xmlDocument, const uint64_t xmlHash, const std::string &cacheFileName);
+
+    /**
+     *  @brief  Append the daughter elements and text of an xml node to a settings cache image
+     * 
+     *  @param  pXmlNode address of the xml node
+     *  @param  cacheImage the settings cache image
+     */
+    static void WriteChildren(const TiXmlNode *const pXmlNode, std::string &cacheImage);
+
+    /**
+     *  @brief  Read daughter elements and text from a settings cache image, linking them to an xml node
+     * 
+     *  @param  cacheImage the settings cache image
+     *  @param  position the current position in the image, advanced past the daughters
+     *  @param  pXmlNode address of the xml node
+     * 
+     *  @return whether the daughters were read successfully
+     */
+    static bool ReadChildren(const std::string &cacheImage, size_t &position, TiXmlNode *const pXmlNode);
+
+    /**
+     *  @brief  Append a value to a settings cache image
+     * 
+     *  @param  t the value
+     *  @param  cacheImage the settings cache image
+     */
+    template <typename T>
+    static void WriteValue(const T &t, std::string &cacheImage);
+
+    /**
+     *  @brief  Read a value from a settings cache image
+     * 
+     *  @param  cacheImage the settings cache image
+     *  @param  position the current position in the image, advanced past the value
+     *  @param  t to receive the value
+     * 
+     *  @return whether the value was read successfully
+     */
+    template <typename T>
+    static bool ReadValue(const std::string &cacheImage, size_t &position, T &t);
+};
+
+} // namespace pandora
+
+#endif // #ifndef PANDORA_SETTINGS_CACHE_HELPER_H
@@ -0,0 +1,77 @@
+/**
+ *  @file   PandoraSDK/include/Helpers/SortingHelper.h
+ *
+ *  @brief  Header file for the sorting helper class.
+ *
+ *  $Log: $
+ */
+#ifndef PANDORA_SORTING_HELPER_H
+#define PANDORA_SORTING_HELPER_H 1
+
+#include "Pandora/PandoraInternal.h"
+
+#include <cstdint>
+
+namespace pandora
+{
+
+/**
+ *  @brief  SortingHelper class, providing the packed sort keys precomputed for calo hits, tracks and mc particles, and a stable radix
+ *          sort of object vectors by these keys. The key order follows the leading position comparisons of the object operator<,
+ *          z then x, but compares the exact float values; objects with equal keys retain their input order.
+ */
+class SortingHelper
+{
+public:
+    /**
+     *  @brief  Get the packed sort key for a position: the order-preserving bit patterns of the z and x coordinates, in the upper and
+     *          lower 32 bits respectively
+     *
+     *  @param  position the position
+     *
+     *  @return the sort key
+     */
+    static uint64_t GetPositionSortKey(const CartesianVector &position);
+
+    /**
+     *  @brief  Stable sort of a vector of objects by their precomputed sort keys, using a least significant digit radix sort
+     *
+     *  @param  objectVector the vector of calo hits, tracks or mc particles to sort
+     */
+    template <typename T>
+    static void SortByKey(std::vector<const T*> &objectVector);
+
+private:
+    /**
+     *  @brief  Get the order-preserving bit pattern of a float, such that unsigned integer comparison matches float comparison
+     *
+     *  @param  value the float value
+     *
+     *  @return the bit pattern
+     */
+    static uint32_t GetOrderedBits(const float value);
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Enable ordering of pointers based on the precomputed sort keys of target objects
+ */
+template <typename T>
+class SortKeyLessThan
+{
+public:
+    bool operator()(const T *lhs, const T *rhs) const;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline bool SortKeyLessThan<T>::operator()(const T *lhs, const T *rhs) const
+{
+    return (lhs->GetSortKey() < rhs->GetSortKey());
+}
+
+} // namespace pandora
+
+#endif // #ifndef PANDORA_SORTING_HELPER_H
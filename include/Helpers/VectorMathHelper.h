@@ -0,0 +1,123 @@
+/**
+ *  @file   PandoraSDK/include/Helpers/VectorMathHelper.h
+ *
+ *  @brief  Header file for the vector math helper class.
+ *
+ *  $Log: $
+ */
+#ifndef PANDORA_VECTOR_MATH_HELPER_H
+#define PANDORA_VECTOR_MATH_HELPER_H 1
+
+#include "Pandora/PandoraInternal.h"
+
+namespace pandora
+{
+
+class CaloHitSnapshot;
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  VectorMathHelper class, providing batched vector operations on arrays of x, y and z coordinates, such as those held by a
+ *          calo hit snapshot. Each operation is a simple loop over contiguous arrays, suited to compiler auto-vectorization, and gives
+ *          the same results as the equivalent CartesianVector member functions. Output vectors are resized to match the input.
+ *          Approximate scalar functions are provided separately, for use only where their stated accuracy is sufficient.
+ */
+class VectorMathHelper
+{
+public:
+    /**
+     *  @brief  Get the dot products of an array of vectors with a specified vector
+     *
+     *  @param  x the x components of the array of vectors
+     *  @param  y the y components of the array of vectors
+     *  @param  z the z components of the array of vectors
+     *  @param  vector the specified vector
+     *  @param  dotProducts to receive the dot products
+     */
+    static void GetDotProducts(const FloatVector &x, const FloatVector &y, const FloatVector &z, const CartesianVector &vector,
+        FloatVector &dotProducts);
+
+    /**
+     *  @brief  Get the distances squared between an array of positions and a specified position
+     *
+     *  @param  x the x coordinates of the array of positions
+     *  @param  y the y coordinates of the array of positions
+     *  @param  z the z coordinates of the array of positions
+     *  @param  position the specified position
+     *  @param  distancesSquared to receive the distances squared
+     */
+    static void GetDistancesSquared(const FloatVector &x, const FloatVector &y, const FloatVector &z, const CartesianVector &position,
+        FloatVector &distancesSquared);
+
+    /**
+     *  @brief  Get the distances squared between the calo hit positions in a snapshot and a specified position
+     *
+     *  @param  caloHitSnapshot the calo hit snapshot
+     *  @param  position the specified position
+     *  @param  distancesSquared to receive the distances squared, indexed as the snapshot calo hit vector
+     */
+    static void GetDistancesSquared(const CaloHitSnapshot &caloHitSnapshot, const CartesianVector &position, FloatVector &distancesSquared);
+
+    /**
+     *  @brief  Get the cross products of an array of vectors with a specified vector
+     *
+     *  @param  x the x components of the array of vectors
+     *  @param  y the y components of the array of vectors
+     *  @param  z the z components of the array of vectors
+     *  @param  vector the specified vector
+     *  @param  crossX to receive the x components of the cross products
+     *  @param  crossY to receive the y components of the cross products
+     *  @param  crossZ to receive the z components of the cross products
+     */
+    static void GetCrossProducts(const FloatVector &x, const FloatVector &y, const FloatVector &z, const CartesianVector &vector,
+        FloatVector &crossX, FloatVector &crossY, FloatVector &crossZ);
+
+    /**
+     *  @brief  Get the cosines of the opening angles between an array of vectors and a specified vector
+     *
+     *  @param  x the x components of the array of vectors
+     *  @param  y the y components of the array of vectors
+     *  @param  z the z components of the array of vectors
+     *  @param  vector the specified vector
+     *  @param  cosOpeningAngles to receive the cosines of the opening angles
+     */
+    static void GetCosOpeningAngles(const FloatVector &x, const FloatVector &y, const FloatVector &z, const CartesianVector &vector,
+        FloatVector &cosOpeningAngles);
+
+    /**
+     *  @brief  Get the cosines of the opening angles between a specified direction and the displacements of the calo hit positions in a
+     *          snapshot from a specified origin
+     *
+     *  @param  caloHitSnapshot the calo hit snapshot
+     *  @param  origin the origin
+     *  @param  direction the specified direction
+     *  @param  cosOpeningAngles to receive the cosines of the opening angles, indexed as the snapshot calo hit vector
+     */
+    static void GetCosOpeningAngles(const CaloHitSnapshot &caloHitSnapshot, const CartesianVector &origin, const CartesianVector &direction,
+        FloatVector &cosOpeningAngles);
+
+    /**
+     *  @brief  Get an approximate inverse square root, via a bit-level initial estimate and two Newton-Raphson iterations. The relative
+     *          error is below 5e-6 for positive normal inputs. Results for zero, negative or non-finite inputs are undefined.
+     *
+     *  @param  value the value
+     *
+     *  @return the approximate inverse square root
+     */
+    static float GetApproximateInverseSqrt(const float value);
+
+    /**
+     *  @brief  Get an approximate arc cosine, via a polynomial approximation (Abramowitz and Stegun 4.4.45). The absolute error is below
+     *          7e-5 radians. Inputs are clamped to the range [-1, 1].
+     *
+     *  @param  value the value
+     *
+     *  @return the approximate arc cosine, radians
+     */
+    static float GetApproximateAcos(const float value);
+};
+
+} // namespace pandora
+
+#endif // #ifndef PANDORA_VECTOR_MATH_HELPER_H
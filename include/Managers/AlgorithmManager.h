@@ -89,6 +89,14 @@ private:
      */
     StatusCode CreateAlgorithmTool(TiXmlElement *const pXmlElement, AlgorithmTool *&pAlgorithmTool);
 
+    /**
+     *  @brief  Create a clone of a cloneable algorithm tool, via the algorithm tool factory and xml settings used for the original tool
+     * 
+     *  @param  pAlgorithmTool address of the algorithm tool to clone
+     *  @param  pAlgorithmToolClone to receive the address of the algorithm tool clone
+     */
+    StatusCode CloneAlgorithmTool(const AlgorithmTool *const pAlgorithmTool, AlgorithmTool *&pAlgorithmToolClone);
+
     /**
      *  @brief  Find the name of a specific algorithm instance, so that it can be re-used
      * 
@@ -113,9 +121,11 @@ private:
     StringVector                    m_pandoraAlgorithms;                ///< The ordered list of names of top-level algorithms, to be run by pandora
 
     typedef std::map<const std::string, AlgorithmToolFactory *const> AlgorithmToolFactoryMap;
+    typedef std::unordered_map<const AlgorithmTool *, TiXmlElement *> AlgorithmToolXmlMap;
 
     AlgorithmToolVector             m_algorithmToolVector;              ///< The algorithm tool vector
     AlgorithmToolFactoryMap         m_algorithmToolFactoryMap;          ///< The algorithm tool factory map
+    AlgorithmToolXmlMap             m_algorithmToolXmlMap;              ///< Copies of the xml settings for cloneable algorithm tools
 
     const Pandora *const            m_pPandora;                         ///< The pandora instance that will run the algorithms
 
@@ -10,6 +10,8 @@
 
 #include "Managers/Manager.h"
 
+#include <unordered_map>
+
 namespace pandora
 {
 
@@ -32,6 +34,20 @@ public:
      */
     virtual ~AlgorithmObjectManager();
 
+    /**
+     *  @brief  Get the total number of objects created by the manager, over the lifetime of the manager
+     * 
+     *  @return the number of objects created
+     */
+    unsigned int GetNObjectsCreated() const;
+
+    /**
+     *  @brief  Get the total number of objects deleted by the manager, over the lifetime of the manager
+     * 
+     *  @return the number of objects deleted
+     */
+    unsigned int GetNObjectsDeleted() const;
+
 protected:
     typedef typename Manager<T>::ObjectList ObjectList;
 
@@ -103,7 +119,8 @@ protected:
     virtual StatusCode DeleteObject(const T *const pT, const std::string &listName);
 
     /**
-     *  @brief  Delete a list of objects from a specified list
+     *  @brief  Delete a list of objects from a specified list, in a single pass. No objects are deleted unless all are distinct and
+     *          present in the specified list.
      * 
      *  @param  objectList the list of objects to delete
      *  @param  listName the name of the list containing the objects
@@ -164,14 +181,157 @@ protected:
      */
     virtual StatusCode ResetAlgorithmInfo(const Algorithm *const pAlgorithm, bool isAlgorithmFinished);
 
+    /**
+     *  @brief  Whether the manager is unchanged, other than in its current list, since its initial lists were created
+     * 
+     *  @return boolean
+     */
+    virtual bool IsInInitialState() const;
+
     /**
      *  @brief  Erase all manager content
      */
     virtual StatusCode EraseAllContent();
 
-    bool        m_canMakeNewObjects;            ///< Whether the manager is allowed to make new objects when requested by algorithms
+    /**
+     *  @brief  Get the number of objects currently owned by the manager, i.e. those alive in managed lists or detached
+     * 
+     *  @return the number of objects
+     */
+    virtual unsigned int GetNOwnedObjects() const;
+
+    /**
+     *  @brief  Add an object to the end of a managed list, recording the position of the object within the list
+     * 
+     *  @param  pObjectList address of the managed list
+     *  @param  pT address of the object
+     */
+    StatusCode AddObjectToList(ObjectList *const pObjectList, const T *const pT);
+
+    /**
+     *  @brief  Remove an object from a managed list, using the recorded position of the object within the list
+     * 
+     *  @param  pObjectList address of the managed list
+     *  @param  pT address of the object
+     */
+    StatusCode RemoveObjectFromList(ObjectList *const pObjectList, const T *const pT);
+
+    /**
+     *  @brief  Whether an object is contained in a managed list
+     * 
+     *  @param  pObjectList address of the managed list
+     *  @param  pT address of the object
+     * 
+     *  @return boolean
+     */
+    bool IsObjectInList(const ObjectList *const pObjectList, const T *const pT) const;
+
+    /**
+     *  @brief  Forget the recorded positions of all objects in a managed list, ahead of clearing the list or deleting its objects
+     * 
+     *  @param  objectList the managed list
+     */
+    void RemoveObjectPositions(const ObjectList &objectList);
+
+    typedef std::vector<const T*> ObjectVector;
+
+    /**
+     *  @brief  Detach an object from a specified list, without deleting it, so that it may later be reattached or destroyed
+     * 
+     *  @param  pT address of the object to detach
+     *  @param  listName the name of the list containing the object
+     *  @param  pNextT to receive the address of the object following the detached object in the list, nullptr if it was last
+     */
+    StatusCode DetachObject(const T *const pT, const std::string &listName, const T *&pNextT);
+
+    /**
+     *  @brief  Detach a list of objects from a specified list, without deleting them. No objects are detached unless all are distinct
+     *          and present in the specified list.
+     * 
+     *  @param  objectList the list of objects to detach
+     *  @param  listName the name of the list containing the objects
+     *  @param  nextObjectVector to receive, for each object in turn, the address of the object then following it in the list
+     */
+    StatusCode DetachObjects(const ObjectList &objectList, const std::string &listName, ObjectVector &nextObjectVector);
+
+    /**
+     *  @brief  Reattach a detached object to a specified list, restoring its position within the list
+     * 
+     *  @param  pT address of the detached object
+     *  @param  listName the name of the list from which the object was detached
+     *  @param  pNextT address of the object that followed the detached object in the list, nullptr if it was last
+     */
+    StatusCode ReattachObject(const T *const pT, const std::string &listName, const T *const pNextT);
+
+    /**
+     *  @brief  Destroy a detached object
+     * 
+     *  @param  pT address of the detached object
+     */
+    void DestroyDetachedObject(const T *const pT);
+
+    /**
+     *  @brief  Get the current list state, so that it may later be restored
+     * 
+     *  @param  currentListName to receive the current list name
+     *  @param  canMakeNewObjects to receive whether the manager is allowed to make new objects
+     */
+    void GetCurrentListState(std::string &currentListName, bool &canMakeNewObjects) const;
+
+    /**
+     *  @brief  Restore a current list state
+     * 
+     *  @param  currentListName the current list name
+     *  @param  canMakeNewObjects whether the manager is allowed to make new objects
+     */
+    StatusCode RestoreCurrentListState(const std::string &currentListName, const bool canMakeNewObjects);
+
+    /**
+     *  @brief  ObjectPosition class, recording the managed list containing an algorithm object (each object resides in a single
+     *          managed list) and, where the list iterators are stable, the position of the object within the list
+     */
+    class ObjectPosition
+    {
+    public:
+        ObjectList                     *m_pObjectList;          ///< The address of the managed list containing the object
+#if PANDORA_MANAGED_CONTAINER_STABLE_ITERATORS
+        typename ObjectList::iterator   m_iterator;             ///< The position of the object within the managed list
+#endif
+    };
+
+    typedef std::unordered_map<const T*, ObjectPosition> ObjectPositionMap;
+
+    bool                m_canMakeNewObjects;            ///< Whether the manager is allowed to make new objects when requested by algorithms
+    ObjectPositionMap   m_objectPositionMap;            ///< The object position map, allowing constant-time removal from managed lists
+    unsigned int        m_nObjectsDeleted;              ///< The total number of objects deleted by the manager
+    unsigned int        m_nObjectsDetached;             ///< The number of objects detached from their lists, neither reattached nor destroyed
 };
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template<typename T>
+inline unsigned int AlgorithmObjectManager<T>::GetNObjectsCreated() const
+{
+    // ATTN Every live object has a recorded position, unless detached, so the objects ever created are those alive, detached or deleted
+    return m_objectPositionMap.size() + m_nObjectsDetached + m_nObjectsDeleted;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template<typename T>
+inline unsigned int AlgorithmObjectManager<T>::GetNObjectsDeleted() const
+{
+    return m_nObjectsDeleted;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template<typename T>
+inline unsigned int AlgorithmObjectManager<T>::GetNOwnedObjects() const
+{
+    return m_objectPositionMap.size() + m_nObjectsDetached;
+}
+
 } // namespace pandora
 
 #endif // #ifndef PANDORA_ALGORITHM_OBJECT_MANAGER
@@ -11,8 +11,18 @@
 #include "Managers/InputObjectManager.h"
 #include "Managers/Metadata.h"
 
+#include "Objects/CaloHitNeighbourGraph.h"
+#include "Objects/CaloHitSnapshot.h"
+#include "Objects/CaloHitTimeIndex.h"
+#include "Objects/LArTPCHitGrid.h"
+#include "Objects/SpatialIndex.h"
+
 #include "Pandora/ObjectCreation.h"
 #include "Pandora/PandoraInternal.h"
+#include "Pandora/ThreadPool.h"
+
+#include <map>
+#include <unordered_map>
 
 namespace pandora
 {
@@ -36,6 +46,44 @@ public:
     ~CaloHitManager();
 
 private:
+    /**
+     *  @brief  MCPfoTargetMatchingTask class, matching a single calo hit to its mc pfo targets. Each item writes only to its
+     *          own calo hit.
+     */
+    class MCPfoTargetMatchingTask : public ParallelForTask
+    {
+    public:
+        /**
+         *  @brief  Constructor
+         *
+         *  @param  caloHitManager the calo hit manager
+         *  @param  caloHitVector the input calo hits, in input list order
+         *  @param  caloHitToPfoTargetsMap the calo hit uid to mc pfo target map
+         */
+        MCPfoTargetMatchingTask(const CaloHitManager &caloHitManager, const CaloHitVector &caloHitVector,
+            const UidToMCParticleWeightTable &caloHitToPfoTargetsMap);
+
+        StatusCode Run(const unsigned int index) const;
+
+    private:
+        const CaloHitManager                &m_caloHitManager;          ///< The calo hit manager
+        const CaloHitVector                 &m_caloHitVector;           ///< The input calo hits, in input list order
+        const UidToMCParticleWeightTable    &m_caloHitToPfoTargetsMap;  ///< The calo hit uid to mc pfo target map
+    };
+
+    /**
+     *  @brief  SharedCaloHitState class, the state of a calo hit owned by another pandora instance, recorded when the calo hit is
+     *          shared with this instance and restored when it is released
+     */
+    class SharedCaloHitState
+    {
+    public:
+        bool                                m_isAvailable;              ///< The availability of the calo hit
+        unsigned int                        m_index;                    ///< The dense calo hit index, within its owning instance
+    };
+
+    typedef std::unordered_map<const CaloHit*, SharedCaloHitState> SharedCaloHitMap;
+
     /**
      *  @brief  Create calo hit
      * 
@@ -46,6 +94,45 @@ private:
     StatusCode Create(const object_creation::CaloHit::Parameters &parameters, const CaloHit *&pCaloHit,
         const ObjectFactory<object_creation::CaloHit::Parameters, object_creation::CaloHit::Object> &factory);
 
+    /**
+     *  @brief  Create a batch of calo hits, either creating all calo hits or none
+     * 
+     *  @param  parametersVector the parameters for each of the calo hits
+     *  @param  factory the factory that performs the object allocation
+     */
+    StatusCode Create(const std::vector<object_creation::CaloHit::Parameters> &parametersVector,
+        const ObjectFactory<object_creation::CaloHit::Parameters, object_creation::CaloHit::Object> &factory);
+
+    /**
+     *  @brief  Check that all required calo hit parameters are initialized, so that the calo hit constructor may read them unchecked
+     * 
+     *  @param  parameters the calo hit parameters
+     */
+    static StatusCode ValidateParameters(const object_creation::CaloHit::Parameters &parameters);
+
+    /**
+     *  @brief  Add calo hits owned by another pandora instance to the input list, by reference. The calo hits keep their parameters,
+     *          pseudo layers and mc particle relationships, are never deleted, fragmented, merged or altered by this instance, and
+     *          have their availability and index restored when this instance is reset.
+     * 
+     *  @param  caloHitList the calo hits to share
+     */
+    StatusCode ShareCaloHits(const CaloHitList &caloHitList);
+
+    /**
+     *  @brief  Whether a calo hit is owned by another pandora instance and shared with this instance
+     * 
+     *  @param  pCaloHit address of the calo hit
+     * 
+     *  @return boolean
+     */
+    bool IsShared(const CaloHit *const pCaloHit) const;
+
+    /**
+     *  @brief  Release all shared calo hits, restoring their state and removing them from the input list
+     */
+    StatusCode ReleaseSharedCaloHits();
+
     /**
      *  @brief  Alter the metadata information stored in a calo hit
      * 
@@ -73,6 +160,142 @@ private:
     template <typename T>
     StatusCode SetAvailability(const T *const pT, bool isAvailable);
 
+    /**
+     *  @brief  Get the structure-of-arrays snapshot of the input calo hit list, rebuilding it only if the input list has changed
+     * 
+     *  @param  pCaloHitSnapshot to receive the address of the snapshot
+     */
+    StatusCode GetInputSnapshot(const CaloHitSnapshot *&pCaloHitSnapshot);
+
+    /**
+     *  @brief  Get the time-sorted index over the input calo hit list, rebuilding it only if the input list has changed
+     * 
+     *  @param  pCaloHitTimeIndex to receive the address of the time index
+     */
+    StatusCode GetInputTimeIndex(const CaloHitTimeIndex *&pCaloHitTimeIndex);
+
+    /**
+     *  @brief  Get the spatial index over the positions of all calo hits in a named list, building it only if the list has changed
+     *          since the last request. The address remains valid until the next change to the list.
+     *
+     *  @param  listName the name of the calo hit list
+     *  @param  pCaloHitSpatialIndex to receive the address of the spatial index
+     */
+    StatusCode GetListSpatialIndex(const std::string &listName, const CaloHitSpatialIndex *&pCaloHitSpatialIndex);
+
+    /**
+     *  @brief  Get the spatial index over the positions of the calo hits of a single hit type (e.g. a single tpc view) in a named list,
+     *          building it only if the list has changed since the last request. The address remains valid until the next change to
+     *          the list.
+     *
+     *  @param  listName the name of the calo hit list
+     *  @param  hitType the hit type
+     *  @param  pCaloHitSpatialIndex to receive the address of the spatial index
+     */
+    StatusCode GetListSpatialIndex(const std::string &listName, const HitType hitType, const CaloHitSpatialIndex *&pCaloHitSpatialIndex);
+
+    /**
+     *  @brief  Build the neighbour graph over the calo hits in the input list
+     *
+     *  @param  maxDistance the maximum distance between neighbouring calo hits, units mm
+     *  @param  layerWindow the number of preceding pseudo layers in which neighbours are sought
+     */
+    StatusCode CreateNeighbourGraph(const float maxDistance, const unsigned int layerWindow);
+
+    /**
+     *  @brief  Get the neighbour graph over the calo hits in the input list, if built for the current event and not since invalidated
+     *          by calo hit fragmentation or merging
+     *
+     *  @param  pCaloHitNeighbourGraph to receive the address of the neighbour graph
+     */
+    StatusCode GetNeighbourGraph(const CaloHitNeighbourGraph *&pCaloHitNeighbourGraph) const;
+
+    /**
+     *  @brief  Build a hit occupancy grid for each lar tpc view, over the calo hits in the input list with hit type TPC_VIEW_U, TPC_VIEW_V
+     *          or TPC_VIEW_W. Calo hits are assigned to the lar tpc whose volume contains their position, and are omitted if there is none.
+     *
+     *  @param  driftBinWidth the drift bin width, units mm
+     */
+    StatusCode CreateLArTPCHitGrids(const float driftBinWidth);
+
+    /**
+     *  @brief  Get the hit occupancy grid for a lar tpc view, if built for the current event and not since invalidated by calo hit
+     *          fragmentation or merging
+     *
+     *  @param  larTPC the lar tpc
+     *  @param  hitType the hit type of the view
+     *  @param  pLArTPCHitGrid to receive the address of the hit grid
+     */
+    StatusCode GetLArTPCHitGrid(const LArTPC &larTPC, const HitType hitType, const LArTPCHitGrid *&pLArTPCHitGrid) const;
+
+    /**
+     *  @brief  Partition the input calo hit list by hit type, saving the hits of each hit type present, in input list order, as a
+     *          named list. Any existing partitions are refilled, so that repeated event preparation does not duplicate entries.
+     */
+    StatusCode CreateInputHitTypeLists();
+
+    /**
+     *  @brief  Get the name of the partition of the input calo hit list for a given hit type, e.g. Input_TPC_VIEW_U
+     *
+     *  @param  hitType the hit type
+     *
+     *  @return the list name
+     */
+    std::string GetInputListName(const HitType hitType) const;
+
+    /**
+     *  @brief  Get the partition of the input calo hit list for a given hit type
+     *
+     *  @param  hitType the hit type
+     *  @param  pCaloHitList to receive the address of the calo hit list
+     */
+    StatusCode GetInputList(const HitType hitType, const CaloHitList *&pCaloHitList) const;
+
+    /**
+     *  @brief  Create the input calo hit list, which will be sorted
+     */
+    StatusCode CreateInputList();
+
+    /**
+     *  @brief  Add objects to a saved calo hit list
+     * 
+     *  @param  listName the name of the list
+     *  @param  caloHitList the calo hit list
+     */
+    StatusCode AddObjectsToList(const std::string &listName, const CaloHitList &caloHitList);
+
+    /**
+     *  @brief  Remove objects from a saved calo hit list
+     * 
+     *  @param  listName the name of the list
+     *  @param  caloHitList the calo hit list
+     */
+    StatusCode RemoveObjectsFromList(const std::string &listName, const CaloHitList &caloHitList);
+
+    /**
+     *  @brief  Save a list of calo hits, or add them to an existing list of the same name
+     *
+     *  @param  listName the calo hit list name
+     *  @param  caloHitList the calo hit list
+     */
+    StatusCode SaveList(const std::string &listName, const CaloHitList &caloHitList);
+
+    /**
+     *  @brief  Change the name of a calo hit list
+     *
+     *  @param  oldListName the old calo hit list name
+     *  @param  newListName the new calo hit list name
+     */
+    StatusCode RenameList(const std::string &oldListName, const std::string &newListName);
+
+    /**
+     *  @brief  Remove temporary lists and reset the current list to that in place when algorithm was initialized
+     *
+     *  @param  pAlgorithm address of the algorithm altering the lists
+     *  @param  isAlgorithmFinished whether the algorithm has completely finished and the algorithm info should be entirely removed
+     */
+    StatusCode ResetAlgorithmInfo(const Algorithm *const pAlgorithm, bool isAlgorithmFinished);
+
     using InputObjectManager<CaloHit>::CreateTemporaryListAndSetCurrent;
 
     /**
@@ -84,17 +307,51 @@ private:
      */
     StatusCode CreateTemporaryListAndSetCurrent(const Algorithm *const pAlgorithm, const ClusterList &clusterList, std::string &temporaryListName);
 
+    /**
+     *  @brief  Change the current calo hit list to a span of calo hits, e.g. a time window of the input hits
+     * 
+     *  @param  pAlgorithm address of the algorithm changing the current calo hit list
+     *  @param  caloHitSpan the span of calo hits
+     *  @param  temporaryListName to receive the name of the temporary list
+     */
+    StatusCode CreateTemporaryListAndSetCurrent(const Algorithm *const pAlgorithm, const CaloHitSpan &caloHitSpan, std::string &temporaryListName);
+
+    /**
+     *  @brief  Whether the calo hit manager is unchanged, other than in its current list, since its initial lists were created
+     * 
+     *  @return boolean
+     */
+    bool IsInInitialState() const;
+
     /**
      *  @brief  Erase all calo hit manager content
      */
     StatusCode EraseAllContent();
 
+    /**
+     *  @brief  Reset the calo hit manager for the next window of a continuous readout stream, deleting the input calo hits with time
+     *          before the start of the window and carrying the remainder over into a fresh input list. Carried over calo hits are made
+     *          available, lose their mc particle relationships and are assigned new dense indices. All other content is erased and any
+     *          shared calo hits are released.
+     * 
+     *  @param  windowStartTime the start time of the next window, units ns
+     */
+    StatusCode ResetForNextWindow(const float windowStartTime);
+
+    /**
+     *  @brief  Reserve capacity for the expected number of calo hits in the upcoming event, avoiding repeated reallocation
+     * 
+     *  @param  nCaloHits the expected number of calo hits
+     */
+    StatusCode ReserveCapacity(const unsigned int nCaloHits);
+
     /**
      *  @brief  Match calo hits to their correct mc particles for particle flow
      * 
      *  @param  caloHitToPfoTargetsMap the calo hit uid to mc pfo target map
+     *  @param  threadPool the thread pool across which to partition the input calo hits
      */
-    StatusCode MatchCaloHitsToMCPfoTargets(const UidToMCParticleWeightMap &caloHitToPfoTargetsMap);
+    StatusCode MatchCaloHitsToMCPfoTargets(const UidToMCParticleWeightTable &caloHitToPfoTargetsMap, ThreadPool &threadPool);
 
     /**
      *  @brief  Remove all mc particle associations that have been registered with calo hits
@@ -170,6 +427,13 @@ private:
      */
     StatusCode EndReclustering(const Algorithm *const pAlgorithm, const std::string &selectedReclusterListName);
 
+    /**
+     *  @brief  Assign the next dense per-event index to a newly created calo hit
+     * 
+     *  @param  pCaloHit address of the calo hit
+     */
+    void AssignIndex(const CaloHit *const pCaloHit);
+
     /**
      *  @brief  Update all calo hit lists to account for changes by daughter recluster processes
      * 
@@ -184,6 +448,14 @@ private:
      */
     StatusCode Update(const CaloHitReplacement &caloHitReplacement);
 
+    /**
+     *  @brief  Apply a newly created calo hit replacement, either recording it in the current reclustering metadata, which takes
+     *          ownership, or updating all calo hit lists directly and then releasing the replacement record
+     * 
+     *  @param  pCaloHitReplacement address of the calo hit replacement
+     */
+    StatusCode ApplyCaloHitReplacement(CaloHitReplacement *const pCaloHitReplacement);
+
     /**
      *  @brief  Update a calo hit list to account for a specific calo hit replacement
      * 
@@ -192,9 +464,40 @@ private:
      */
     StatusCode Update(CaloHitList *const pCaloHitList, const CaloHitReplacement &caloHitReplacement);
 
+    /**
+     *  @brief  Discard the spatial indices over a named calo hit list, following a change to its contents
+     *
+     *  @param  listName the calo hit list name
+     */
+    void InvalidateSpatialIndices(const std::string &listName);
+
+    /**
+     *  @brief  Discard the spatial indices over all calo hit lists
+     */
+    void InvalidateSpatialIndices();
+
+    typedef std::map<std::string, CaloHitSpatialIndex> NameToSpatialIndexMap;
+    typedef std::pair<std::string, HitType> ListNameAndHitType;
+    typedef std::map<ListNameAndHitType, CaloHitSpatialIndex> HitTypeSpatialIndexMap;
+    typedef std::map<HitType, CaloHitList*> HitTypeToListMap;
+    typedef std::pair<unsigned int, HitType> VolumeIdAndHitType;
+    typedef std::map<VolumeIdAndHitType, LArTPCHitGrid> LArTPCHitGridMap;
+
     unsigned int                    m_nReclusteringProcesses;           ///< The number of reclustering algorithms currently in operation
     ReclusterMetadata              *m_pCurrentReclusterMetadata;        ///< Address of the current recluster metadata
     ReclusterMetadataList           m_reclusterMetadataList;            ///< The recluster metadata list
+    CaloHitVector                   m_indexedCaloHitVector;             ///< The calo hits created during the event, by calo hit index
+    CaloHitSnapshot                 m_inputSnapshot;                    ///< The structure-of-arrays snapshot of the input calo hit list
+    bool                            m_isInputSnapshotValid;             ///< Whether the input snapshot reflects the current input list
+    CaloHitTimeIndex                m_inputTimeIndex;                   ///< The time-sorted index over the input calo hit list
+    bool                            m_isInputTimeIndexValid;            ///< Whether the input time index reflects the current input list
+    NameToSpatialIndexMap           m_spatialIndexMap;                  ///< The valid spatial indices over all calo hits, by list name
+    HitTypeSpatialIndexMap          m_hitTypeSpatialIndexMap;           ///< The valid spatial indices over single hit types, by list name
+    CaloHitNeighbourGraph           m_neighbourGraph;                   ///< The neighbour graph over the input calo hits
+    bool                            m_isNeighbourGraphValid;            ///< Whether the neighbour graph has been built and remains valid
+    LArTPCHitGridMap                m_larTPCHitGridMap;                 ///< The hit grids over the input calo hits, by lar tpc volume id and view
+    bool                            m_areLArTPCHitGridsValid;           ///< Whether the lar tpc hit grids have been built and remain valid
+    SharedCaloHitMap                m_sharedCaloHitMap;                 ///< The calo hits shared by other instances, with their original state
 
     friend class PandoraApiImpl;
     friend class PandoraContentApiImpl;
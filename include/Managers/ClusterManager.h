@@ -10,6 +10,9 @@
 
 #include "Managers/AlgorithmObjectManager.h"
 
+#include "Objects/ClusterPairFinder.h"
+#include "Objects/SpatialIndex.h"
+
 #include "Pandora/ObjectCreation.h"
 #include "Pandora/PandoraInternal.h"
 
@@ -80,6 +83,14 @@ private:
      */
     StatusCode AddToCluster(const Cluster *const pCluster, const CaloHit *const pCaloHit);
 
+    /**
+     *  @brief  Add a list of calo hits to a cluster, in a single batched update of the cluster properties
+     *
+     *  @param  pCluster address of the cluster to modify
+     *  @param  caloHitList the list of hits to add
+     */
+    StatusCode AddToCluster(const Cluster *const pCluster, const CaloHitList &caloHitList);
+
     /**
      *  @brief  Remove a calo hit from a cluster
      *
@@ -116,6 +127,40 @@ private:
     StatusCode MergeAndDeleteClusters(const Cluster *const pClusterToEnlarge, const Cluster *const pClusterToDelete,
         const std::string &enlargeListName, const std::string &deleteListName);
 
+    /**
+     *  @brief  Merge two clusters from two specified lists, enlarging one cluster and detaching the second from its list, without
+     *          deleting it, so that the merge may later be reverted
+     * 
+     *  @param  pClusterToEnlarge address of the cluster to enlarge
+     *  @param  pClusterToDelete address of the cluster to detach
+     *  @param  enlargeListName name of the list containing the cluster to enlarge
+     *  @param  deleteListName name of the list containing the cluster to detach
+     *  @param  pNextCluster to receive the address of the cluster following the detached cluster in its list, nullptr if it was last
+     */
+    StatusCode MergeAndDetachClusters(const Cluster *const pClusterToEnlarge, const Cluster *const pClusterToDelete,
+        const std::string &enlargeListName, const std::string &deleteListName, const Cluster *&pNextCluster);
+
+    /**
+     *  @brief  Check that two clusters may be merged, i.e. that they are distinct and are present in their specified lists
+     * 
+     *  @param  pClusterToEnlarge address of the cluster to enlarge
+     *  @param  pClusterToDelete address of the cluster to delete
+     *  @param  enlargeListName name of the list containing the cluster to enlarge
+     *  @param  deleteListName name of the list containing the cluster to delete
+     */
+    StatusCode CheckMergeClusters(const Cluster *const pClusterToEnlarge, const Cluster *const pClusterToDelete,
+        const std::string &enlargeListName, const std::string &deleteListName) const;
+
+    /**
+     *  @brief  Remove lists of calo hits and isolated calo hits from a cluster, e.g. to revert a merge, without the restriction that
+     *          the cluster must retain at least one calo hit
+     * 
+     *  @param  pCluster address of the cluster to modify
+     *  @param  caloHitList the calo hits to remove
+     *  @param  isolatedCaloHitList the isolated calo hits to remove
+     */
+    StatusCode RemoveCaloHits(const Cluster *const pCluster, const CaloHitList &caloHitList, const CaloHitList &isolatedCaloHitList);
+
     /**
      *  @brief  Add an association between a cluster and a track
      * 
@@ -138,19 +183,161 @@ private:
     StatusCode RemoveAllTrackAssociations() const;
 
     /**
-     *  @brief  Remove cluster to track associations from all clusters in the current list
+     *  @brief  Rebuild and get the spatial index over the inner pseudo layer centroids of the clusters in the current list
+     * 
+     *  @param  pClusterSpatialIndex to receive the address of the spatial index
+     */
+    StatusCode GetCurrentListSpatialIndex(const ClusterSpatialIndex *&pClusterSpatialIndex);
+
+    /**
+     *  @brief  Rebuild and get the cluster pair finder over the bounding boxes of the clusters in the current list
+     * 
+     *  @param  pClusterPairFinder to receive the address of the cluster pair finder
+     */
+    StatusCode GetCurrentListPairFinder(const ClusterPairFinder *&pClusterPairFinder);
+
+    /**
+     *  @brief  Get the cluster containing a calo hit, using the calo hit to cluster index. During reclustering, the index refers
+     *          to the cluster to which the calo hit was most recently added, until the selected cluster list is chosen.
+     * 
+     *  @param  pCaloHit address of the calo hit
+     *  @param  pCluster to receive the address of the cluster containing the calo hit
+     */
+    StatusCode GetCaloHitCluster(const CaloHit *const pCaloHit, const Cluster *&pCluster) const;
+
+    /**
+     *  @brief  Point the calo hit to cluster index at the clusters in a specified list, e.g. once a list has been selected at the
+     *          end of reclustering, before the unselected clusters are deleted
+     * 
+     *  @param  listName the name of the cluster list
+     */
+    StatusCode UpdateCaloHitClusterIndex(const std::string &listName);
+
+    /**
+     *  @brief  Delete a cluster from a specified list
+     * 
+     *  @param  pCluster address of the cluster to delete
+     *  @param  listName the name of the list containing the cluster
+     */
+    StatusCode DeleteObject(const Cluster *const pCluster, const std::string &listName);
+
+    /**
+     *  @brief  Delete a list of clusters from a specified list
+     * 
+     *  @param  clusterList the list of clusters to delete
+     *  @param  listName the name of the list containing the clusters
+     */
+    StatusCode DeleteObjects(const ClusterList &clusterList, const std::string &listName);
+
+    /**
+     *  @brief  Delete the contents of a temporary cluster list
+     * 
+     *  @param  pAlgorithm address of the algorithm calling this function
+     *  @param  temporaryListName the name of the temporary list
+     */
+    StatusCode DeleteTemporaryObjects(const Algorithm *const pAlgorithm, const std::string &temporaryListName);
+
+    /**
+     *  @brief  Remove temporary lists, deleting their clusters, and reset the current list to that in place when algorithm was initialized
+     * 
+     *  @param  pAlgorithm address of the algorithm altering the lists
+     *  @param  isAlgorithmFinished whether the algorithm has completely finished and the algorithm info should be entirely removed
+     */
+    StatusCode ResetAlgorithmInfo(const Algorithm *const pAlgorithm, bool isAlgorithmFinished);
+
+    /**
+     *  @brief  Detach a cluster from a specified list, without deleting it, so that it may later be reattached or destroyed
+     * 
+     *  @param  pCluster address of the cluster to detach
+     *  @param  listName the name of the list containing the cluster
+     *  @param  pNextCluster to receive the address of the cluster following the detached cluster in the list, nullptr if it was last
+     */
+    StatusCode DetachObject(const Cluster *const pCluster, const std::string &listName, const Cluster *&pNextCluster);
+
+    /**
+     *  @brief  Detach a list of clusters from a specified list, without deleting them
+     * 
+     *  @param  clusterList the list of clusters to detach
+     *  @param  listName the name of the list containing the clusters
+     *  @param  nextClusterVector to receive, for each cluster in turn, the address of the cluster then following it in the list
+     */
+    StatusCode DetachObjects(const ClusterList &clusterList, const std::string &listName, ObjectVector &nextClusterVector);
+
+    /**
+     *  @brief  Reattach a detached cluster to a specified list, restoring its position within the list
+     * 
+     *  @param  pCluster address of the detached cluster
+     *  @param  listName the name of the list from which the cluster was detached
+     *  @param  pNextCluster address of the cluster that followed the detached cluster in the list, nullptr if it was last
+     */
+    StatusCode ReattachObject(const Cluster *const pCluster, const std::string &listName, const Cluster *const pNextCluster);
+
+    /**
+     *  @brief  Whether the cluster manager is unchanged, other than in its current list, since its initial lists were created
+     * 
+     *  @return boolean
+     */
+    bool IsInInitialState() const;
+
+    /**
+     *  @brief  Erase all cluster manager content
+     */
+    StatusCode EraseAllContent();
+
+    /**
+     *  @brief  Whether the calo hit to cluster index is to be maintained
+     * 
+     *  @return boolean
+     */
+    bool ShouldMaintainCaloHitClusterIndex() const;
+
+    /**
+     *  @brief  Point the calo hit to cluster index entry for a calo hit at a specified cluster
+     * 
+     *  @param  pCaloHit address of the calo hit
+     *  @param  pCluster address of the cluster
+     */
+    void IndexCaloHit(const CaloHit *const pCaloHit, const Cluster *const pCluster);
+
+    /**
+     *  @brief  Point the calo hit to cluster index entries for all calo hits and isolated calo hits in a source cluster at a
+     *          specified cluster
+     * 
+     *  @param  pSourceCluster address of the cluster providing the calo hits
+     *  @param  pCluster address of the cluster
+     */
+    void IndexCaloHits(const Cluster *const pSourceCluster, const Cluster *const pCluster);
+
+    /**
+     *  @brief  Clear the calo hit to cluster index entry for a calo hit, if it refers to a specified cluster
      * 
-     *  @param  danglingTracks to receive the list of "dangling" associations
+     *  @param  pCaloHit address of the calo hit
+     *  @param  pCluster address of the cluster
      */
-    StatusCode RemoveCurrentTrackAssociations(TrackList &danglingTracks) const;
+    void UnindexCaloHit(const CaloHit *const pCaloHit, const Cluster *const pCluster);
 
     /**
-     *  @brief  Remove a specified list of cluster to track associations
+     *  @brief  Get the calo hits and isolated calo hits in a cluster whose calo hit to cluster index entries refer to the cluster
      * 
-     *  @param  trackToClusterList the specified track to cluster list
+     *  @param  pCluster address of the cluster
+     *  @param  caloHitList to receive the list of calo hits
      */
-    StatusCode RemoveTrackAssociations(const TrackToClusterMap &trackToClusterList) const;
+    void GetIndexedCaloHits(const Cluster *const pCluster, CaloHitList &caloHitList) const;
+
+    /**
+     *  @brief  Clear the calo hit to cluster index entries for a list of calo hits
+     * 
+     *  @param  caloHitList the list of calo hits
+     */
+    void ClearCaloHitClusterIndex(const CaloHitList &caloHitList);
+
+    typedef std::vector<const Cluster*> CaloHitClusterVector;
+
+    ClusterSpatialIndex             m_currentListSpatialIndex;          ///< The spatial index over the clusters in the current list
+    ClusterPairFinder               m_currentListPairFinder;            ///< The cluster pair finder over the clusters in the current list
+    CaloHitClusterVector            m_caloHitClusterVector;             ///< The cluster containing each calo hit, indexed by calo hit index
 
+    friend class PandoraApiImpl;
     friend class PandoraContentApiImpl;
     friend class PandoraImpl;
 };
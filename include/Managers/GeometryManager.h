@@ -8,6 +8,9 @@
 #ifndef PANDORA_GEOMETRY_MANAGER_H
 #define PANDORA_GEOMETRY_MANAGER_H 1
 
+#include "Geometry/DetectorGapIndex.h"
+#include "Geometry/LArTPCIndex.h"
+
 #include "Pandora/ObjectCreation.h"
 #include "Pandora/PandoraEnumeratedTypes.h"
 
@@ -65,6 +68,15 @@ public:
      */
     const LArTPC &GetLArTPC() const;
 
+    /**
+     *  @brief  Get the lar tpc whose volume (center -/+ half width, boundaries inclusive) contains a specified position, using an index
+     *          built as lar tpcs are created. If several volumes contain the position, the lar tpc with the lowest volume id is returned.
+     * 
+     *  @param  positionVector the position vector
+     *  @param  pLArTPC to receive the address of the lar tpc
+     */
+    StatusCode GetLArTPC(const CartesianVector &positionVector, const LArTPC *&pLArTPC) const;
+
     /**
      *  @brief  Get the map from name to lar tpc parameters
      * 
@@ -79,6 +91,19 @@ public:
      */
     const DetectorGapList &GetDetectorGapList() const;
 
+    /**
+     *  @brief  Whether a specified position lies within any of the gaps in the active detector volume that are applicable to the
+     *          specified hit type: line gaps for tpc hit types and box or concentric gaps for all hit types other than the 2D tpc views.
+     *          Uses an index built as gaps are created, rather than querying each gap in the detector gap list.
+     * 
+     *  @param  positionVector the position vector
+     *  @param  hitType the hit type, providing context to aid interpretation of provided position vector
+     *  @param  gapTolerance tolerance allowed when declaring a point to be "in" a gap region, units mm
+     * 
+     *  @return boolean
+     */
+    bool IsInGap(const CartesianVector &positionVector, const HitType hitType, const float gapTolerance = 0.f) const;
+
     /**
      *  @brief  Get the granularity level specified for a given calorimeter hit type
      * 
@@ -116,6 +141,33 @@ private:
     template <typename PARAMETERS, typename OBJECT>
     StatusCode CreateGap(const PARAMETERS &parameters, const ObjectFactory<PARAMETERS, OBJECT> &factory);
 
+    /**
+     *  @brief  Create a batch of sub detectors, either creating all sub detectors or none, and refilling the lookup arrays once
+     * 
+     *  @param  parametersVector the parameters for each of the sub detectors
+     *  @param  factory the factory that performs the object allocation
+     */
+    StatusCode CreateSubDetectors(const std::vector<object_creation::Geometry::SubDetector::Parameters> &parametersVector,
+        const ObjectFactory<object_creation::Geometry::SubDetector::Parameters, object_creation::Geometry::SubDetector::Object> &factory);
+
+    /**
+     *  @brief  Create a batch of lar tpcs, either creating all lar tpcs or none, and refilling the lar tpc index once
+     * 
+     *  @param  parametersVector the parameters for each of the lar tpcs
+     *  @param  factory the factory that performs the object allocation
+     */
+    StatusCode CreateLArTPCs(const std::vector<object_creation::Geometry::LArTPC::Parameters> &parametersVector,
+        const ObjectFactory<object_creation::Geometry::LArTPC::Parameters, object_creation::Geometry::LArTPC::Object> &factory);
+
+    /**
+     *  @brief  Create a batch of gaps of a single type, either creating all gaps or none, and adding them to the gap index together
+     * 
+     *  @param  parametersVector the parameters for each of the gaps
+     *  @param  factory the factory that performs the object allocation
+     */
+    template <typename PARAMETERS, typename OBJECT>
+    StatusCode CreateGaps(const std::vector<PARAMETERS> &parametersVector, const ObjectFactory<PARAMETERS, OBJECT> &factory);
+
     /**
      *  @brief  Erase all geometry manager content
      */
@@ -138,13 +190,27 @@ private:
      */
     StatusCode SetHitTypeGranularity(const HitType hitType, const Granularity granularity);
 
+    /**
+     *  @brief  Refill the enum-indexed sub detector and granularity arrays, using the current contents of the corresponding maps
+     */
+    void FillLookupArrays();
+
     typedef std::multimap<SubDetectorType, const SubDetector*> SubDetectorTypeMap;
 
+    static const unsigned int N_SUB_DETECTOR_TYPES = SUB_DETECTOR_OTHER + 1;    ///< The number of enumerated sub detector types
+    static const unsigned int N_HIT_TYPES = HIT_CUSTOM + 1;                     ///< The number of enumerated hit types
+
     SubDetectorMap              m_subDetectorMap;           ///< Map from sub detector name to sub detector
     SubDetectorTypeMap          m_subDetectorTypeMap;       ///< Map from sub detector type to sub detector
     LArTPCMap                   m_larTPCMap;                ///< Map from lar tpc volume id to lar tpc
+    LArTPCIndex                 m_larTPCIndex;              ///< Index of the lar tpc volumes, for position queries
     DetectorGapList             m_detectorGapList;          ///< List of gaps in the active detector volume
+    DetectorGapIndex            m_detectorGapIndex;         ///< Index of the gaps in the active detector volume, for position queries
     HitTypeToGranularityMap     m_hitTypeToGranularityMap;  ///< The hit type to granularity map
+    const SubDetector          *m_subDetectorTypeArray[N_SUB_DETECTOR_TYPES];        ///< The sub detector for each enumerated type, if registered
+    unsigned int                m_nSubDetectorsOfType[N_SUB_DETECTOR_TYPES];         ///< The number of sub detectors for each enumerated type
+    Granularity                 m_hitTypeGranularityArray[N_HIT_TYPES];              ///< The granularity for each enumerated hit type, if registered
+    bool                        m_isHitTypeGranularitySet[N_HIT_TYPES];              ///< Whether a granularity is registered for each enumerated hit type
 
     const Pandora *const        m_pPandora;                 ///< The associated pandora object
 
@@ -160,6 +226,13 @@ inline const SubDetectorMap &GeometryManager::GetSubDetectorMap() const
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+inline StatusCode GeometryManager::GetLArTPC(const CartesianVector &positionVector, const LArTPC *&pLArTPC) const
+{
+    return m_larTPCIndex.GetLArTPC(positionVector, pLArTPC);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 inline const LArTPCMap &GeometryManager::GetLArTPCMap() const
 {
     return m_larTPCMap;
@@ -172,6 +245,13 @@ inline const DetectorGapList &GeometryManager::GetDetectorGapList() const
     return m_detectorGapList;
 }
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool GeometryManager::IsInGap(const CartesianVector &positionVector, const HitType hitType, const float gapTolerance) const
+{
+    return m_detectorGapIndex.IsInGap(positionVector, hitType, gapTolerance);
+}
+
 } // namespace pandora
 
 #endif // #ifndef PANDORA_GEOMETRY_MANAGER_H
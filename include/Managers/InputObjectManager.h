@@ -84,6 +84,13 @@ protected:
      */
     virtual StatusCode RenameList(const std::string &oldListName, const std::string &newListName);
 
+    /**
+     *  @brief  Whether the manager is unchanged, other than in its current list, since its initial null and input lists were created
+     * 
+     *  @return boolean
+     */
+    virtual bool IsInInitialState() const;
+
     /**
      *  @brief  Erase all manager content
      */
@@ -94,7 +101,31 @@ protected:
      */
     virtual StatusCode CreateInitialLists();
 
+    /**
+     *  @brief  Get the number of objects currently owned by the manager, i.e. the number of objects in the input list
+     * 
+     *  @return the number of objects
+     */
+    virtual unsigned int GetNOwnedObjects() const;
+
+    /**
+     *  @brief  Reserve capacity in the input list for an expected number of objects, where the managed container type supports this
+     * 
+     *  @param  nObjects the expected number of objects
+     */
+    StatusCode ReserveInputList(const unsigned int nObjects);
+
+    /**
+     *  @brief  Whether the parameters of input objects created in the current event should be validated. Validation is always
+     *          performed in debug builds or without trusted input objects, and otherwise only for the first event and for events
+     *          sampled at the trusted input validation interval.
+     * 
+     *  @return boolean
+     */
+    bool ShouldValidateInputParameters() const;
+
     const std::string               m_inputListName;                    ///< The name of the input list
+    unsigned int                    m_nErasedEvents;                    ///< The number of events erased since the manager was created
 };
 
 } // namespace pandora
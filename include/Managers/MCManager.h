@@ -13,6 +13,8 @@
 #include "Pandora/ObjectCreation.h"
 #include "Pandora/PandoraInternal.h"
 
+#include <limits>
+
 namespace pandora
 {
 
@@ -45,11 +47,37 @@ private:
     StatusCode Create(const object_creation::MCParticle::Parameters &parameters, const MCParticle *&pMCParticle,
         const ObjectFactory<object_creation::MCParticle::Parameters, object_creation::MCParticle::Object> &factory);
 
+    /**
+     *  @brief  Create a batch of mc particles, either creating all mc particles or none
+     * 
+     *  @param  parametersVector the parameters for each of the mc particles
+     *  @param  factory the factory that performs the object allocation
+     */
+    StatusCode Create(const std::vector<object_creation::MCParticle::Parameters> &parametersVector,
+        const ObjectFactory<object_creation::MCParticle::Parameters, object_creation::MCParticle::Object> &factory);
+
+    /**
+     *  @brief  Whether the mc manager is unchanged, other than in its current list, since its initial lists were created
+     * 
+     *  @return boolean
+     */
+    bool IsInInitialState() const;
+
     /**
      *  @brief  Erase all mc manager content
      */
     StatusCode EraseAllContent();
 
+    /**
+     *  @brief  Reserve capacity for the expected numbers of mc particles and mc particle relationships in the upcoming event,
+     *          avoiding repeated rehashing
+     * 
+     *  @param  nMCParticles the expected number of mc particles
+     *  @param  nCaloHitRelations the expected number of calo hits with mc particle relationships
+     *  @param  nTrackRelations the expected number of tracks with mc particle relationships
+     */
+    StatusCode ReserveCapacity(const unsigned int nMCParticles, const unsigned int nCaloHitRelations, const unsigned int nTrackRelations);
+
     /**
      *  @brief  Set mc particle relationship
      * 
@@ -76,6 +104,20 @@ private:
      */
     StatusCode SetTrackToMCParticleRelationship(const Uid trackUid, const Uid mcParticleUid, const float mcParticleWeight);
 
+    /**
+     *  @brief  Set a batch of calo hit to mc particle relationships
+     * 
+     *  @param  relationshipVector the calo hit to mc particle relationships
+     */
+    StatusCode SetCaloHitToMCParticleRelationships(const MCParticleRelationshipVector &relationshipVector);
+
+    /**
+     *  @brief  Set a batch of track to mc particle relationships
+     * 
+     *  @param  relationshipVector the track to mc particle relationships
+     */
+    StatusCode SetTrackToMCParticleRelationships(const MCParticleRelationshipVector &relationshipVector);
+
     /**
      *  @brief  Identify pfo targets
      */
@@ -87,56 +129,186 @@ private:
     StatusCode SelectPfoTargets();
 
     /**
-     *  @brief  Apply mc pfo selection rules 
-     *
-     *  @param  mcRootParticle address of the mc root particle
-     *  @param  mcPfoSet set of all MCPFOs selected so far
+     *  @brief  Build the flattened mc particle tree from the input list, which must already be sorted
      */
-    StatusCode ApplyPfoSelectionRules(const MCParticle *const mcRootParticle, MCParticleSet &mcPfoSet) const;
+    StatusCode BuildTruthTree();
 
     /**
-     *  @brief  Set pfo target for a mc tree
+     *  @brief  Set the pfo target for all particles connected to a selected pfo target. The pfo target propagates to its own daughters
+     *          only, but to both the daughters and parents of all other particles, skipping particles with a pfo target already set.
      * 
-     *  @param  pMCParticle address of a particle in the mc tree
-     *  @param  pPfoTarget address of the pfo target
-     *  @param  onlyDaughters if "true" go through daughters only, if false go through parents as well
+     *  @param  pfoTargetIndex the truth tree index of the pfo target
+     *  @param  indexStack scratch stack of truth tree indices
      */
-    StatusCode SetPfoTargetInTree(const MCParticle *const pMCParticle, const MCParticle *const pPfoTarget, bool onlyDaughters = false) const;
+    StatusCode SetPfoTargetInTree(const unsigned int pfoTargetIndex, UIntVector &indexStack) const;
 
    /**
      *  @brief  Create a map relating calo hit uid to mc pfo target
      * 
      *  @param  caloHitToPfoTargetMap to receive the calo hit uid to mc pfo target map
      */
-    StatusCode CreateCaloHitToPfoTargetsMap(UidToMCParticleWeightMap &caloHitToPfoTargetsMap) const;
+    StatusCode CreateCaloHitToPfoTargetsMap(UidToMCParticleWeightTable &caloHitToPfoTargetsMap) const;
 
    /**
      *  @brief  Create a map relating track uid to mc pfo target
      * 
      *  @param  trackToPfoTargetMap to receive the track uid to mc pfo target map
      */
-    StatusCode CreateTrackToPfoTargetsMap(UidToMCParticleWeightMap &trackToPfoTargetsMap) const;
+    StatusCode CreateTrackToPfoTargetsMap(UidToMCParticleWeightTable &trackToPfoTargetsMap) const;
 
     /**
      *  @brief  Apply mc particle associations (parent-daughter) that have been registered with the mc manager
      */
-    StatusCode AddMCParticleRelationships() const;
+    StatusCode AddMCParticleRelationships();
 
     /**
      *  @brief  Remove all mc particle associations that have been registered with the mc manager
      */
     StatusCode RemoveAllMCParticleRelationships();
 
+    typedef std::pair<const MCParticle *, const MCParticle *> ParentDaughterLink;
+    typedef std::vector<ParentDaughterLink> ParentDaughterLinkVector;
+
     /**
-     *  @brief  Remove all parent/daughter particle links from a mc particle and from its (previously) linked particles
+     *  @brief  Get the current parent-daughter links, ordered by parent in input list order, then by position in the daughter list
      * 
-     *  @param  pMCParticle address of the mc particle
+     *  @param  inputList the input mc particle list
+     *  @param  parentDaughterLinks to receive the parent-daughter links
      */
-    StatusCode RemoveMCParticleRelationships(const MCParticle *const pMCParticle) const;
+    void GetParentDaughterLinks(const MCParticleList &inputList, ParentDaughterLinkVector &parentDaughterLinks) const;
 
-    typedef std::unordered_map<Uid, float> UidToWeightMap;
+    /**
+     *  @brief  Replace all parent-daughter relationships, flattening them into the compressed sparse row parent and daughter arrays
+     *          and pointing the relationship ranges of each input mc particle into these arrays. The daughters of each mc particle
+     *          follow the order of the links, as do the parents.
+     * 
+     *  @param  inputList the input mc particle list
+     *  @param  parentDaughterLinks the parent-daughter links
+     */
+    void SetParentDaughterLinks(const MCParticleList &inputList, const ParentDaughterLinkVector &parentDaughterLinks);
+
+    /**
+     *  @brief  Order parent-daughter links by parent address, for grouping by parent
+     * 
+     *  @param  lhs the first link
+     *  @param  rhs the second link
+     * 
+     *  @return boolean
+     */
+    static bool IsParentLessThan(const ParentDaughterLink &lhs, const ParentDaughterLink &rhs);
+
+    /**
+     *  @brief  Order parent-daughter links by daughter address, for grouping by daughter
+     * 
+     *  @param  lhs the first link
+     *  @param  rhs the second link
+     * 
+     *  @return boolean
+     */
+    static bool IsDaughterLessThan(const ParentDaughterLink &lhs, const ParentDaughterLink &rhs);
+
+    typedef SmallMap<Uid, float, 4> UidToWeightMap;
     typedef std::unordered_map<Uid, UidToWeightMap> ObjectRelationMap;
     typedef std::unordered_multimap<Uid, Uid> MCParticleRelationMap;
+    typedef std::unordered_map<Uid, unsigned int> UidToIndexMap;
+    typedef std::vector<UidToWeightMap> UidToWeightMapVector;
+    typedef std::vector<std::pair<unsigned int, unsigned int> > DenseRelationVector;
+
+    /**
+     *  @brief  ObjectRelations class, the object (calo hit or track) to mc particle relations. Relations are keyed by hashed uid or,
+     *          in dense uid mode, held in a vector indexed by the dense object uid.
+     */
+    class ObjectRelations
+    {
+    public:
+        /**
+         *  @brief  Clear the relations, retaining allocated vector storage
+         */
+        void Clear();
+
+        /**
+         *  @brief  Whether there are no relations
+         * 
+         *  @return boolean
+         */
+        bool IsEmpty() const;
+
+        ObjectRelationMap           m_objectRelationMap;            ///< The object relation map, for hashed uids
+        UidToWeightMapVector        m_uidToWeightMapVector;         ///< The mc particle weights for each object, indexed by dense uid
+    };
+
+    /**
+     *  @brief  TruthTree class, a flattened representation of the mc particle tree. Particles are identified by their index in the
+     *          (sorted) input list and the parent and daughter links of particle i are stored, as indices, between offsets i and i+1.
+     */
+    class TruthTree
+    {
+    public:
+        /**
+         *  @brief  Constructor
+         */
+        TruthTree();
+
+        /**
+         *  @brief  Clear the tree, retaining allocated storage
+         */
+        void Clear();
+
+        /**
+         *  @brief  Find the index of a mc particle in the tree
+         * 
+         *  @param  uid the mc particle unique identifier
+         *  @param  index to receive the truth tree index
+         * 
+         *  @return whether the mc particle is present in the tree
+         */
+        bool FindIndex(const Uid uid, unsigned int &index) const;
+
+        bool                        m_isDense;                      ///< Whether the tree was built with dense mc particle uids
+        MCParticleVector            m_mcParticleVector;             ///< The mc particles, in input list order
+        UidToIndexMap               m_uidToIndexMap;                ///< The map from mc particle uid to index, for hashed uids
+        UIntVector                  m_denseUidToIndex;              ///< The index of each mc particle, indexed by dense uid
+        UIntVector                  m_daughterOffsets;              ///< The offsets into the daughter index vector, one per particle plus one
+        UIntVector                  m_daughterIndices;              ///< The daughter indices, grouped by particle
+        UIntVector                  m_parentOffsets;                ///< The offsets into the parent index vector, one per particle plus one
+        UIntVector                  m_parentIndices;                ///< The parent indices, grouped by particle
+    };
+
+    /**
+     *  @brief  Whether the user framework uids are dense indices, cast to addresses
+     * 
+     *  @return boolean
+     */
+    bool UseDenseUids() const;
+
+    /**
+     *  @brief  Get the dense index held by a uid, checking that it lies within the supported range
+     * 
+     *  @param  uid the unique identifier
+     *  @param  index to receive the dense index
+     */
+    static StatusCode GetDenseIndex(const Uid uid, unsigned int &index);
+
+    /**
+     *  @brief  Register a newly created mc particle by its uid
+     * 
+     *  @param  pMCParticle address of the mc particle
+     */
+    StatusCode RegisterMCParticle(const MCParticle *const pMCParticle);
+
+    /**
+     *  @brief  Remove the uid registration of a mc particle
+     * 
+     *  @param  pMCParticle address of the mc particle
+     */
+    void DeregisterMCParticle(const MCParticle *const pMCParticle);
+
+    /**
+     *  @brief  Get the number of mc particles registered by uid
+     * 
+     *  @return the number of registered mc particles
+     */
+    unsigned int GetNRegisteredMCParticles() const;
 
     /**
      *  @brief  Set an object (e.g. calo hit or track) to mc particle relationship
@@ -144,25 +316,66 @@ private:
      *  @param  uid the unique identifier of the object
      *  @param  mcParticleUid the mc particle unique identifier
      *  @param  mcParticleWeight weighting to assign to the mc particle
-     *  @param  objectRelationMap the uid relation map to populate
+     *  @param  objectRelations the object relations to populate
      */
     StatusCode SetUidToMCParticleRelationship(const Uid objectUid, const Uid mcParticleUid, const float mcParticleWeight,
-        ObjectRelationMap &objectRelationMap) const;
+        ObjectRelations &objectRelations) const;
+
+    /**
+     *  @brief  Set a batch of object (e.g. calo hit or track) to mc particle relationships
+     * 
+     *  @param  relationshipVector the object to mc particle relationships
+     *  @param  objectRelations the object relations to populate
+     */
+    StatusCode SetUidToMCParticleRelationships(const MCParticleRelationshipVector &relationshipVector, ObjectRelations &objectRelations) const;
+
+    /**
+     *  @brief  Add an object to mc particle relationship to the object relations
+     * 
+     *  @param  objectUid the unique identifier of the object
+     *  @param  mcParticleUid the mc particle unique identifier
+     *  @param  mcParticleWeight weighting to assign to the mc particle
+     *  @param  useSingleMCParticleAssociation whether to retain only the single highest weight mc particle for each object
+     *  @param  useDenseUids whether the object uid is a dense index, cast to an address
+     *  @param  objectRelations the object relations to populate
+     */
+    static StatusCode AddUidToMCParticleRelationship(const Uid objectUid, const Uid mcParticleUid, const float mcParticleWeight,
+        const bool useSingleMCParticleAssociation, const bool useDenseUids, ObjectRelations &objectRelations);
 
    /**
      *  @brief  Create a map relating an object (calo hit or track) uid to mc pfo targets
      * 
      *  @param  uidToMCParticleWeightMap to receive the calo hit uid to mc pfo target map
-     *  @param  objectRelationMap the object relation map containing the information
+     *  @param  objectRelations the object relations containing the information
      */
-    StatusCode CreateUidToPfoTargetsMap(UidToMCParticleWeightMap &uidToMCParticleWeightMap, const ObjectRelationMap &objectRelationMap) const;
+    StatusCode CreateUidToPfoTargetsMap(UidToMCParticleWeightTable &uidToMCParticleWeightMap, const ObjectRelations &objectRelations) const;
+
+    /**
+     *  @brief  Add the mc pfo targets of a single object (calo hit or track) to a uid to mc pfo target map
+     * 
+     *  @param  objectUid the unique identifier of the object
+     *  @param  uidToWeightMap the mc particle uids and weights related to the object
+     *  @param  collapseToPfoTarget whether to relate the object to the pfo targets, rather than to the mc particles themselves
+     *  @param  mcParticleIndices scratch vector of truth tree indices
+     *  @param  uidToMCParticleWeightMap the uid to mc pfo target map to populate
+     */
+    void AddPfoTargets(const Uid objectUid, const UidToWeightMap &uidToWeightMap, const bool collapseToPfoTarget, UIntVector &mcParticleIndices,
+        UidToMCParticleWeightTable &uidToMCParticleWeightMap) const;
+
+    static const unsigned int       m_maxDenseUid;                      ///< The upper limit on dense uids, guarding against uids that are addresses
 
     const std::string               m_selectedListName;                 ///< The name of the selected list
 
     UidToMCParticleMap              m_uidToMCParticleMap;               ///< The uid to mc particle map
     MCParticleRelationMap           m_parentDaughterRelationMap;        ///< The mc particle parent-daughter relation map
-    ObjectRelationMap               m_caloHitToMCParticleMap;           ///< The calo hit to mc particle relation map
-    ObjectRelationMap               m_trackToMCParticleMap;             ///< The track to mc particle relation map
+    MCParticleVector                m_denseUidToMCParticle;             ///< The mc particles, indexed by dense uid, in dense uid mode
+    unsigned int                    m_nDenseMCParticles;                ///< The number of mc particles registered by dense uid
+    DenseRelationVector             m_denseParentDaughterRelations;     ///< The dense parent and daughter uids, in dense uid mode
+    ObjectRelations                 m_caloHitToMCParticleMap;           ///< The calo hit to mc particle relations
+    ObjectRelations                 m_trackToMCParticleMap;             ///< The track to mc particle relations
+    TruthTree                       m_truthTree;                        ///< The flattened mc particle tree, built when identifying pfo targets
+    MCParticleVector                m_daughterArray;                    ///< The daughters of all mc particles, grouped by parent
+    MCParticleVector                m_parentArray;                      ///< The parents of all mc particles, grouped by daughter
 
     friend class PandoraApiImpl;
     friend class PandoraContentApiImpl;
@@ -185,14 +398,88 @@ inline StatusCode MCManager::SetTrackToMCParticleRelationship(const Uid trackUid
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-inline StatusCode MCManager::CreateCaloHitToPfoTargetsMap(UidToMCParticleWeightMap &caloHitToPfoTargetsMap) const
+inline StatusCode MCManager::SetCaloHitToMCParticleRelationships(const MCParticleRelationshipVector &relationshipVector)
+{
+    return this->SetUidToMCParticleRelationships(relationshipVector, m_caloHitToMCParticleMap);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline StatusCode MCManager::SetTrackToMCParticleRelationships(const MCParticleRelationshipVector &relationshipVector)
+{
+    return this->SetUidToMCParticleRelationships(relationshipVector, m_trackToMCParticleMap);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline void MCManager::ObjectRelations::Clear()
+{
+    m_objectRelationMap.clear();
+    m_uidToWeightMapVector.clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool MCManager::ObjectRelations::IsEmpty() const
+{
+    return (m_objectRelationMap.empty() && m_uidToWeightMapVector.empty());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline MCManager::TruthTree::TruthTree() :
+    m_isDense(false)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline void MCManager::TruthTree::Clear()
+{
+    m_isDense = false;
+    m_mcParticleVector.clear();
+    m_uidToIndexMap.clear();
+    m_denseUidToIndex.clear();
+    m_daughterOffsets.clear();
+    m_daughterIndices.clear();
+    m_parentOffsets.clear();
+    m_parentIndices.clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool MCManager::TruthTree::FindIndex(const Uid uid, unsigned int &index) const
+{
+    if (m_isDense)
+    {
+        const std::size_t denseIndex(UidToMCParticleWeightTable::GetDenseIndex(uid));
+
+        if (denseIndex >= m_denseUidToIndex.size())
+            return false;
+
+        index = m_denseUidToIndex[denseIndex];
+        return (std::numeric_limits<unsigned int>::max() != index);
+    }
+
+    UidToIndexMap::const_iterator iter = m_uidToIndexMap.find(uid);
+
+    if (m_uidToIndexMap.end() == iter)
+        return false;
+
+    index = iter->second;
+    return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline StatusCode MCManager::CreateCaloHitToPfoTargetsMap(UidToMCParticleWeightTable &caloHitToPfoTargetsMap) const
 {
     return this->CreateUidToPfoTargetsMap(caloHitToPfoTargetsMap, m_caloHitToMCParticleMap);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-inline StatusCode MCManager::CreateTrackToPfoTargetsMap(UidToMCParticleWeightMap &trackToPfoTargetsMap) const
+inline StatusCode MCManager::CreateTrackToPfoTargetsMap(UidToMCParticleWeightTable &trackToPfoTargetsMap) const
 {
     return this->CreateUidToPfoTargetsMap(trackToPfoTargetsMap, m_trackToMCParticleMap);
 }
@@ -8,6 +8,8 @@
 #ifndef PANDORA_MANAGER_H
 #define PANDORA_MANAGER_H 1
 
+#include "Managers/MemoryUsage.h"
+
 #include "Pandora/PandoraInternal.h"
 #include "Pandora/StatusCodes.h"
 
@@ -57,6 +59,13 @@ protected:
      */
     virtual StatusCode GetCurrentList(const ObjectList *&pObjectList, std::string &listName) const;
 
+    /**
+     *  @brief  Get the current list, without copying its name. The list address is cached until the current list changes.
+     * 
+     *  @param  pObjectList to receive the current list
+     */
+    StatusCode GetCurrentList(const ObjectList *&pObjectList) const;
+
     /**
      *  @brief  Get the current list name
      * 
@@ -135,10 +144,28 @@ protected:
     virtual StatusCode ResetAlgorithmInfo(const Algorithm *const pAlgorithm, bool isAlgorithmFinished);
 
     /**
-     *  @brief  Reset the manager
+     *  @brief  Reset the manager, erasing its content only if it has been modified since it was last reset
      */
     virtual StatusCode ResetForNextEvent();
 
+    /**
+     *  @brief  Whether the manager is unchanged, other than in its current list, since its initial lists were created, such that
+     *          no content need be erased before the next event
+     * 
+     *  @return boolean
+     */
+    virtual bool IsInInitialState() const;
+
+    /**
+     *  @brief  Whether the manager holds no algorithm info and no lists, other than the empty null list and an optional empty
+     *          initial list
+     * 
+     *  @param  initialListName the name of the additional initial list, which may be the null list name
+     * 
+     *  @return boolean
+     */
+    bool HasOnlyInitialLists(const std::string &initialListName) const;
+
     /**
      *  @brief  Erase all manager content
      */
@@ -158,6 +185,83 @@ protected:
      */
     virtual T *Modifiable(const T *const pT) const;
 
+    /**
+     *  @brief  Get the number of objects currently owned by the manager
+     * 
+     *  @return the number of objects
+     */
+    virtual unsigned int GetNOwnedObjects() const = 0;
+
+    /**
+     *  @brief  Get the current memory usage of the manager and its high-water mark for the current event
+     * 
+     *  @param  currentUsage to receive the current memory usage
+     *  @param  peakUsage to receive the high-water mark, including the current memory usage
+     */
+    void GetMemoryUsage(MemoryUsage &currentUsage, MemoryUsage &peakUsage) const;
+
+    /**
+     *  @brief  Update the high-water mark for the current event with the current memory usage
+     * 
+     *  @param  pAlgorithm address of the algorithm that has just run
+     */
+    void UpdatePeakMemoryUsage(const Algorithm *const pAlgorithm);
+
+    /**
+     *  @brief  Fill the current memory usage of the manager
+     * 
+     *  @param  memoryUsage to receive the current memory usage
+     */
+    void FillMemoryUsage(MemoryUsage &memoryUsage) const;
+
+    /**
+     *  @brief  Merge a memory usage into a high-water mark, taking the larger of each count
+     * 
+     *  @param  memoryUsage the memory usage
+     *  @param  peakUsage the high-water mark to update
+     */
+    static void MergePeakMemoryUsage(const MemoryUsage &memoryUsage, MemoryUsage &peakUsage);
+
+    /**
+     *  @brief  Whether the creation of a number of new objects keeps the manager within the per-event object budget, recording
+     *          any excess so that the event can be abandoned
+     * 
+     *  @param  nNewObjects the number of new objects
+     * 
+     *  @return boolean
+     */
+    bool IsWithinObjectBudget(const unsigned int nNewObjects);
+
+    /**
+     *  @brief  Whether the per-event object budget has been exceeded, during the current event
+     * 
+     *  @return boolean
+     */
+    bool IsObjectBudgetExceeded() const;
+
+    /**
+     *  @brief  Get the upper bound of the dense per-event object indices, one more than the largest index assigned during the event
+     * 
+     *  @return the index upper bound
+     */
+    unsigned int GetIndexUpperBound() const;
+
+    /**
+     *  @brief  Assign a dense per-event index to a new object, reusing the most recently released index if there is one, and record
+     *          the current generation of the index in the object
+     * 
+     *  @param  pT the address of the object
+     */
+    void AssignIndex(const T *const pT);
+
+    /**
+     *  @brief  Release the index of an object that is about to be deleted, for reuse by objects created later in the event, advancing
+     *          the generation of the index
+     * 
+     *  @param  pT the address of the object
+     */
+    void ReleaseIndex(const T *const pT);
+
     /**
      *  @brief  AlgorithmInfo class
      */
@@ -165,21 +269,70 @@ protected:
     {
     public:
         std::string                 m_parentListName;                   ///< The current list when algorithm was initialized
-        StringSet                   m_temporaryListNames;               ///< The temporary list names
+        std::string                 m_temporaryListPrefix;              ///< The temporary list name prefix, the instance name and separator
+        std::vector<ObjectList *>   m_temporaryLists;                   ///< The current temporary lists, indexed by handle less first handle
+        unsigned int                m_firstTemporaryListHandle;         ///< The handle of the first of the current temporary lists
         unsigned int                m_numberOfListsCreated;             ///< The number of lists created by the algorithm
+        bool                        m_isActive;                         ///< Whether the algorithm is running, rather than its record retained
     };
 
+    /**
+     *  @brief  Get the info for a running algorithm. Records are retained, inactive, after each run of an algorithm, for reuse by its
+     *          next run, so an algorithm is tracked only while its record is active.
+     * 
+     *  @param  pAlgorithm address of the algorithm
+     * 
+     *  @return address of the algorithm info, nullptr if the algorithm is not running
+     */
+    AlgorithmInfo *GetActiveAlgorithmInfo(const Algorithm *const pAlgorithm);
+
+    /**
+     *  @brief  Get the info for a running algorithm
+     * 
+     *  @param  pAlgorithm address of the algorithm
+     * 
+     *  @return address of the algorithm info, nullptr if the algorithm is not running
+     */
+    const AlgorithmInfo *GetActiveAlgorithmInfo(const Algorithm *const pAlgorithm) const;
+
+    /**
+     *  @brief  Get the name of a temporary list, built on demand from the algorithm temporary list prefix and list handle
+     * 
+     *  @param  algorithmInfo the algorithm info
+     *  @param  temporaryListHandle the temporary list handle
+     * 
+     *  @return the temporary list name
+     */
+    static std::string GetTemporaryListName(const AlgorithmInfo &algorithmInfo, const unsigned int temporaryListHandle);
+
+    /**
+     *  @brief  Whether a named list is one of the current temporary lists created by an algorithm, found by parsing the list handle
+     *          from the name, rather than by searching a set of names
+     * 
+     *  @param  algorithmInfo the algorithm info
+     *  @param  listName the list name
+     * 
+     *  @return boolean
+     */
+    static bool IsTemporaryList(const AlgorithmInfo &algorithmInfo, const std::string &listName);
+
     const std::string               m_nullListName;                     ///< The name of the default empty (NULL) list
     const Pandora *const            m_pPandora;                         ///< The associated pandora object
 
-    typedef std::map<std::string, ObjectList *> NameToListMap;
+    typedef std::unordered_map<std::string, ObjectList *> NameToListMap;
     typedef std::unordered_map<const Algorithm *, AlgorithmInfo> AlgorithmInfoMap;
 
     NameToListMap                   m_nameToListMap;                    ///< The name to list map
     AlgorithmInfoMap                m_algorithmInfoMap;                 ///< The algorithm info map
 
     std::string                     m_currentListName;                  ///< The name of the current list
+    mutable const ObjectList       *m_pCurrentList;                     ///< Cached address of the current list, nullptr if not yet looked up
     StringSet                       m_savedLists;                       ///< The set of saved lists
+    MemoryUsage                     m_peakMemoryUsage;                  ///< The memory usage high-water mark for the current event
+    bool                            m_isObjectBudgetExceeded;           ///< Whether the per-event object budget has been exceeded
+    unsigned int                    m_indexUpperBound;                  ///< The upper bound of the object indices assigned during the event
+    UIntVector                      m_releasedIndices;                  ///< The indices released during the event, awaiting reuse
+    UIntVector                      m_indexGenerations;                 ///< The generation of each index, advanced on release and event reset
 };
 
 } // namespace pandora
@@ -0,0 +1,258 @@
+/**
+ *  @file   PandoraSDK/include/Managers/ManagerCheckpoint.h
+ *
+ *  @brief  Header file for the manager checkpoint class.
+ *
+ *  $Log: $
+ */
+#ifndef PANDORA_MANAGER_CHECKPOINT_H
+#define PANDORA_MANAGER_CHECKPOINT_H 1
+
+#include "Pandora/PandoraInternal.h"
+
+namespace pandora
+{
+
+/**
+ *  @brief  ManagerCheckpoint class, an undo log of the changes made to clusters, particle flow objects, vertices and track-cluster
+ *          associations since a checkpoint was opened by an algorithm. Each change is recorded as it is made, so that a rollback
+ *          reverts the changes, most recent first, at a cost proportional to the number of changes rather than to the event size.
+ *          Objects deleted while the checkpoint is open are only detached from their lists, and are destroyed on release.
+ */
+class ManagerCheckpoint
+{
+public:
+    /**
+     *  @brief  Default constructor
+     */
+    ManagerCheckpoint();
+
+    /**
+     *  @brief  Whether the checkpoint is open
+     *
+     *  @return boolean
+     */
+    bool IsOpen() const;
+
+    /**
+     *  @brief  Get the address of the algorithm that opened the checkpoint
+     *
+     *  @return the address of the algorithm, nullptr if the checkpoint is not open
+     */
+    const Algorithm *GetAlgorithm() const;
+
+    /**
+     *  @brief  Get the number of changes recorded since the checkpoint was opened
+     *
+     *  @return the number of changes
+     */
+    unsigned int GetNChanges() const;
+
+private:
+    /**
+     *  @brief  ChangeType enum
+     */
+    enum ChangeType
+    {
+        CLUSTER_CREATION,
+        PFO_CREATION,
+        VERTEX_CREATION,
+        CLUSTER_DELETION,
+        PFO_DELETION,
+        VERTEX_DELETION,
+        CLUSTER_MERGE,
+        CALO_HIT_ADDITION,
+        CALO_HIT_REMOVAL,
+        ISOLATED_CALO_HIT_ADDITION,
+        ISOLATED_CALO_HIT_REMOVAL,
+        TRACK_CLUSTER_ASSOCIATION,
+        TRACK_CLUSTER_DISASSOCIATION,
+        PFO_CONTENT_ADDITION,
+        PFO_CONTENT_REMOVAL,
+        PFO_PARENT_DAUGHTER_ASSOCIATION,
+        PFO_PARENT_DAUGHTER_DISASSOCIATION
+    };
+
+    /**
+     *  @brief  Change class, a single entry in the undo log. Only the members relevant to the change type are populated.
+     */
+    class Change
+    {
+    public:
+        /**
+         *  @brief  Constructor
+         *
+         *  @param  changeType the change type
+         */
+        Change(const ChangeType changeType);
+
+        /**
+         *  @brief  Set the cluster added to, or removed from, a particle flow object
+         *
+         *  @param  pCluster address of the cluster
+         */
+        void SetPfoContent(const Cluster *const pCluster);
+
+        /**
+         *  @brief  Set the track added to, or removed from, a particle flow object
+         *
+         *  @param  pTrack address of the track
+         */
+        void SetPfoContent(const Track *const pTrack);
+
+        /**
+         *  @brief  Set the vertex added to, or removed from, a particle flow object
+         *
+         *  @param  pVertex address of the vertex
+         */
+        void SetPfoContent(const Vertex *const pVertex);
+
+        ChangeType                  m_changeType;           ///< The change type
+        const Cluster              *m_pCluster;             ///< The cluster created, deleted or modified
+        const Cluster              *m_pSecondCluster;       ///< The cluster enlarged by a merge
+        const Cluster              *m_pNextCluster;         ///< The cluster following a deleted cluster in its list, nullptr if last
+        const ParticleFlowObject   *m_pPfo;                 ///< The pfo created, deleted or modified, or the parent pfo
+        const ParticleFlowObject   *m_pSecondPfo;           ///< The daughter pfo
+        const ParticleFlowObject   *m_pNextPfo;             ///< The pfo following a deleted pfo in its list, nullptr if last
+        const Vertex               *m_pVertex;              ///< The vertex created or deleted, or added to or removed from a pfo
+        const Vertex               *m_pNextVertex;          ///< The vertex following a deleted vertex in its list, nullptr if last
+        const CaloHit              *m_pCaloHit;             ///< The calo hit added to or removed from a cluster
+        const Track                *m_pTrack;               ///< The track associated or disassociated, or added to or removed from a pfo
+        CaloHitList                 m_isolatedCaloHitList;  ///< The isolated calo hits dropped on removal of the last ordered calo hit
+        std::string                 m_listName;             ///< The name of the list in which an object was created or deleted
+        PfoList                     m_parentPfoList;        ///< The parents of a deleted pfo
+        PfoList                     m_daughterPfoList;      ///< The daughters of a deleted pfo
+    };
+
+    typedef std::vector<Change> ChangeVector;
+
+    /**
+     *  @brief  ListState class, the current list state of an algorithm object manager when the checkpoint was opened
+     */
+    class ListState
+    {
+    public:
+        /**
+         *  @brief  Default constructor
+         */
+        ListState();
+
+        std::string                 m_currentListName;      ///< The current list name
+        bool                        m_canMakeNewObjects;    ///< Whether the manager was allowed to make new objects
+    };
+
+    /**
+     *  @brief  Open the checkpoint
+     *
+     *  @param  pAlgorithm address of the algorithm opening the checkpoint
+     */
+    void Open(const Algorithm *const pAlgorithm);
+
+    /**
+     *  @brief  Close the checkpoint, forgetting all recorded changes
+     */
+    void Close();
+
+    const Algorithm                *m_pAlgorithm;           ///< The algorithm that opened the checkpoint, nullptr if not open
+    ChangeVector                    m_changeVector;         ///< The changes recorded since the checkpoint was opened, in order
+    ListState                       m_clusterListState;     ///< The cluster manager list state when the checkpoint was opened
+    ListState                       m_pfoListState;         ///< The pfo manager list state when the checkpoint was opened
+    ListState                       m_vertexListState;      ///< The vertex manager list state when the checkpoint was opened
+
+    friend class PandoraContentApiImpl;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline ManagerCheckpoint::ManagerCheckpoint() :
+    m_pAlgorithm(nullptr)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool ManagerCheckpoint::IsOpen() const
+{
+    return (nullptr != m_pAlgorithm);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const Algorithm *ManagerCheckpoint::GetAlgorithm() const
+{
+    return m_pAlgorithm;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int ManagerCheckpoint::GetNChanges() const
+{
+    return m_changeVector.size();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline void ManagerCheckpoint::Open(const Algorithm *const pAlgorithm)
+{
+    m_pAlgorithm = pAlgorithm;
+    m_changeVector.clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline void ManagerCheckpoint::Close()
+{
+    m_pAlgorithm = nullptr;
+    m_changeVector.clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline ManagerCheckpoint::Change::Change(const ChangeType changeType) :
+    m_changeType(changeType),
+    m_pCluster(nullptr),
+    m_pSecondCluster(nullptr),
+    m_pNextCluster(nullptr),
+    m_pPfo(nullptr),
+    m_pSecondPfo(nullptr),
+    m_pNextPfo(nullptr),
+    m_pVertex(nullptr),
+    m_pNextVertex(nullptr),
+    m_pCaloHit(nullptr),
+    m_pTrack(nullptr)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline void ManagerCheckpoint::Change::SetPfoContent(const Cluster *const pCluster)
+{
+    m_pCluster = pCluster;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline void ManagerCheckpoint::Change::SetPfoContent(const Track *const pTrack)
+{
+    m_pTrack = pTrack;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline void ManagerCheckpoint::Change::SetPfoContent(const Vertex *const pVertex)
+{
+    m_pVertex = pVertex;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline ManagerCheckpoint::ListState::ListState() :
+    m_canMakeNewObjects(false)
+{
+}
+
+} // namespace pandora
+
+#endif // #ifndef PANDORA_MANAGER_CHECKPOINT_H
@@ -0,0 +1,52 @@
+/**
+ *  @file   PandoraSDK/include/Managers/MemoryUsage.h
+ *
+ *  @brief  Header file for the memory usage class.
+ *
+ *  $Log: $
+ */
+#ifndef PANDORA_MEMORY_USAGE_H
+#define PANDORA_MEMORY_USAGE_H 1
+
+#include <cstddef>
+#include <map>
+#include <string>
+
+namespace pandora
+{
+
+/**
+ *  @brief  MemoryUsage class, the numbers of objects, lists and list entries held by a manager, with an estimate of the memory they
+ *          occupy. The estimate counts the objects themselves, the named lists and their entries, but not any memory owned by the
+ *          objects (e.g. the calo hits lists inside clusters), so should be regarded as a lower bound.
+ */
+class MemoryUsage
+{
+public:
+    /**
+     *  @brief  Default constructor
+     */
+    MemoryUsage();
+
+    unsigned int    m_nObjects;                     ///< The number of objects owned by the manager
+    unsigned int    m_nLists;                       ///< The number of named lists, including temporary lists
+    unsigned int    m_nListEntries;                 ///< The total number of entries across all named lists
+    std::size_t     m_estimatedBytes;               ///< The estimated memory occupied by the objects, lists and list entries, units bytes
+    std::string     m_algorithmName;                ///< For a high-water mark, the instance name of the algorithm that had just run
+};
+
+typedef std::map<std::string, MemoryUsage> MemoryUsageMap;
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline MemoryUsage::MemoryUsage() :
+    m_nObjects(0),
+    m_nLists(0),
+    m_nListEntries(0),
+    m_estimatedBytes(0)
+{
+}
+
+} // namespace pandora
+
+#endif // #ifndef PANDORA_MEMORY_USAGE_H
@@ -13,6 +13,9 @@
 #include "Pandora/PandoraInternal.h"
 #include "Pandora/StatusCodes.h"
 
+#include <cstddef>
+#include <cstdint>
+
 namespace pandora
 {
 
@@ -22,18 +25,131 @@ namespace pandora
 class CaloHitReplacement
 {
 public:
+#ifdef PANDORA_POOLED_OBJECT_ALLOCATION
+    /**
+     *  @brief  Class-specific allocation, using the calo hit replacement object pool
+     * 
+     *  @param  size the number of bytes requested
+     */
+    static void *operator new(std::size_t size);
+
+    /**
+     *  @brief  Class-specific deallocation, using the calo hit replacement object pool
+     * 
+     *  @param  pAddress the address of the memory to release
+     *  @param  size the number of bytes originally requested
+     */
+    static void operator delete(void *pAddress, std::size_t size);
+#endif
+
     CaloHitList             m_oldCaloHits;              ///< The list of old calo hits, to be replaced
     CaloHitList             m_newCaloHits;              ///< The list new calo hits, to act as replacements
 };
 
 typedef std::vector<CaloHitReplacement *> CaloHitReplacementList;
-typedef std::unordered_map<const CaloHit *, bool> CaloHitUsageMap;
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 /**
- *  @brief  CaloHitMetadata class
+ *  @brief  CaloHitBitset class, a growable bitset addressed by the dense per-event calo hit index
+ */
+class CaloHitBitset
+{
+public:
+    /**
+     *  @brief  Whether the bit for a given calo hit index is set
+     * 
+     *  @param  index the calo hit index
+     * 
+     *  @return boolean
+     */
+    bool Test(const unsigned int index) const;
+
+    /**
+     *  @brief  Set the bit for a given calo hit index, growing the bitset as required
+     * 
+     *  @param  index the calo hit index
+     */
+    void Set(const unsigned int index);
+
+    /**
+     *  @brief  Reset the bit for a given calo hit index
+     * 
+     *  @param  index the calo hit index
+     */
+    void Reset(const unsigned int index);
+
+    /**
+     *  @brief  Bitwise and with another bitset, i.e. this = this & rhs
+     * 
+     *  @param  rhs the other bitset
+     */
+    void And(const CaloHitBitset &rhs);
+
+    /**
+     *  @brief  Bitwise and with the complement of another bitset, i.e. this = this & ~rhs
+     * 
+     *  @param  rhs the other bitset
+     */
+    void AndNot(const CaloHitBitset &rhs);
+
+    /**
+     *  @brief  Bitwise or with another bitset, i.e. this = this | rhs
+     * 
+     *  @param  rhs the other bitset
+     */
+    void Or(const CaloHitBitset &rhs);
+
+    /**
+     *  @brief  Whether every bit set in this bitset is also set in another bitset
+     * 
+     *  @param  rhs the other bitset
+     * 
+     *  @return boolean
+     */
+    bool IsSubsetOf(const CaloHitBitset &rhs) const;
+
+    /**
+     *  @brief  Merge in the bits from another bitset, replacing only those bits set in a mask, i.e. this = (this & ~mask) | (values & mask)
+     * 
+     *  @param  mask the mask, identifying the bits to replace
+     *  @param  values the bitset providing the replacement bits
+     */
+    void Merge(const CaloHitBitset &mask, const CaloHitBitset &values);
+
+    /**
+     *  @brief  Get the indices of all set bits, in increasing order
+     * 
+     *  @param  indices to receive the indices of all set bits
+     */
+    void GetSetIndices(UIntVector &indices) const;
+
+    /**
+     *  @brief  Clear all bits, retaining allocated storage
+     */
+    void Clear();
+
+private:
+    typedef std::uint64_t Word;
+    typedef std::vector<Word> WordVector;
+
+    static const unsigned int BITS_PER_WORD = 64;
+
+    WordVector                  m_words;                            ///< The bitset words
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  CaloHitMetadata class, describing a single reclustering option as a set of differences from the state at the start of
+ *          reclustering: the calo hits added or removed by calo hit replacements, and the calo hits whose availability has been
+ *          recorded by this option. Options may inherit availability from the parent level, i.e. the current option of an enclosing
+ *          reclustering process or, outermost, the calo hits themselves, in which case reads of calo hits without recorded availability
+ *          fall through to that level, which is not modified until reclustering ends. Creating and querying an option therefore costs
+ *          time proportional only to the hits it touches, and folding an inheriting option back into its parent level costs time
+ *          proportional only to its recorded availability.
  */
 class CaloHitMetadata
 {
@@ -43,9 +159,12 @@ public:
      * 
      *  @param  pCaloHitList address of the associated calo hit list
      *  @param  caloHitListName name of the associated calo hit list
-     *  @param  initialHitAvailability the initial availability of the calo hits
+     *  @param  pBaseMembershipBitset address of the bitset identifying the calo hits at the start of reclustering, shared by all options
+     *  @param  pParentCaloHitMetadata address of the parent level metadata, null if the parent level is the calo hits themselves
+     *  @param  inheritAvailability whether to inherit calo hit availability from the parent level, rather than start with all available
      */
-    CaloHitMetadata(CaloHitList *const pCaloHitList, const std::string &caloHitListName, const bool initialHitAvailability);
+    CaloHitMetadata(CaloHitList *const pCaloHitList, const std::string &caloHitListName, const CaloHitBitset *const pBaseMembershipBitset,
+        const CaloHitMetadata *const pParentCaloHitMetadata, const bool inheritAvailability);
 
     /**
      *  @brief  Destructor
@@ -72,11 +191,12 @@ public:
     StatusCode SetAvailability(const T *const pT, bool isAvailable);
 
     /**
-     *  @brief  Update metadata to account for changes by daughter recluster processes
+     *  @brief  Update metadata to account for changes by daughter recluster processes, taking ownership of their calo hit replacement
+     *          records rather than copying them
      * 
      *  @param  caloHitMetadata description of the changes made by daughter reclustering processes
      */
-    StatusCode Update(const CaloHitMetadata &caloHitMetadata);
+    StatusCode Update(CaloHitMetadata &caloHitMetadata);
 
     /**
      *  @brief  Update metadata to account for a specific calo hit replacement
@@ -85,17 +205,34 @@ public:
      */
     StatusCode Update(const CaloHitReplacement &caloHitReplacement);
 
+    /**
+     *  @brief  Update metadata to account for a specific calo hit replacement, taking ownership of the replacement record rather than
+     *          copying it. The record is deleted if the update fails.
+     * 
+     *  @param  pCaloHitReplacement address of the calo hit replacement
+     */
+    StatusCode Update(CaloHitReplacement *const pCaloHitReplacement);
+
     /**
      *  @brief  Clear all metadata content
      */
     void Clear();
 
     /**
-     *  @brief  Get the calo hit usage map
+     *  @brief  Get the bitset identifying the calo hits associated with this metadata, by calo hit index
+     * 
+     *  @param  membershipBitset to receive the calo hit membership bitset
+     */
+    void GetMembershipBitset(CaloHitBitset &membershipBitset) const;
+
+    /**
+     *  @brief  Get the availability to be folded into the parent level: that recorded by this option if it inherits availability,
+     *          otherwise that of all the associated calo hits
      * 
-     *  @return the calo hit usage map
+     *  @param  availableIndices to receive the indices of the calo hits to be made available
+     *  @param  unavailableIndices to receive the indices of the calo hits to be made unavailable
      */
-    const CaloHitUsageMap &GetCaloHitUsageMap() const;
+    void GetAvailabilityUpdates(UIntVector &availableIndices, UIntVector &unavailableIndices) const;
 
     /**
      *  @brief  Get the calo hit replacement list
@@ -105,10 +242,58 @@ public:
     const CaloHitReplacementList &GetCaloHitReplacementList() const;
 
 private:
+    /**
+     *  @brief  Get the dense per-event index of a calo hit, throwing if no index has been assigned
+     * 
+     *  @param  pCaloHit address of the calo hit
+     * 
+     *  @return the calo hit index
+     */
+    static unsigned int GetIndex(const CaloHit *const pCaloHit);
+
+    /**
+     *  @brief  Whether a calo hit is associated with this metadata
+     * 
+     *  @param  index the calo hit index
+     * 
+     *  @return boolean
+     */
+    bool IsMember(const unsigned int index) const;
+
+    /**
+     *  @brief  Record the availability of an associated calo hit
+     * 
+     *  @param  index the calo hit index
+     *  @param  isAvailable the availability
+     */
+    void RecordAvailability(const unsigned int index, const bool isAvailable);
+
+    /**
+     *  @brief  Erase the recorded availability of a calo hit
+     * 
+     *  @param  index the calo hit index
+     */
+    void EraseAvailability(const unsigned int index);
+
+    /**
+     *  @brief  Apply a calo hit replacement to the associated calo hit list and bitsets, without recording the replacement
+     * 
+     *  @param  caloHitReplacement the calo hit replacement
+     */
+    StatusCode ApplyReplacement(const CaloHitReplacement &caloHitReplacement);
+
     CaloHitList                *m_pCaloHitList;                     ///< Address of the associated calo hit list
     std::string                 m_caloHitListName;                  ///< The name of the associated calo hit list
-    CaloHitUsageMap             m_caloHitUsageMap;                  ///< The calo hit usage map
+    const CaloHitBitset        *m_pBaseMembershipBitset;            ///< Address of the calo hits at the start of reclustering, by calo hit index
+    CaloHitBitset               m_addedBitset;                      ///< The calo hits added by replacements, by calo hit index
+    CaloHitBitset               m_removedBitset;                    ///< The base calo hits removed by replacements, by calo hit index
+    const CaloHitMetadata      *m_pParentCaloHitMetadata;           ///< Address of the parent level metadata, null if the calo hits themselves
+    CaloHitBitset               m_recordedBitset;                   ///< The calo hits whose availability is recorded by this option
+    CaloHitBitset               m_availabilityBitset;               ///< The recorded availability, by calo hit index
+    bool                        m_inheritAvailability;              ///< Whether unrecorded availability is inherited from the parent level
     CaloHitReplacementList      m_caloHitReplacementList;           ///< The calo hit replacement list
+
+    friend class ReclusterMetadata;
 };
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -124,11 +309,12 @@ public:
      *  @brief  Constructor
      * 
      *  @param  pCaloHitList address of the initial calo hit list, copies of which will be used during reclustering
+     *  @param  pParentCaloHitMetadata address of the current metadata of the enclosing reclustering process, null if none
      */
-    ReclusterMetadata(CaloHitList *const pCaloHitList);
+    ReclusterMetadata(CaloHitList *const pCaloHitList, const CaloHitMetadata *const pParentCaloHitMetadata);
 
     /**
-     *  @brief  Destructor
+     *  @brief  Destructor, releasing the metadata for all reclustering options together
      */
     ~ReclusterMetadata();
 
@@ -138,18 +324,18 @@ public:
      *  @param  pCaloHitList address of the calo hit list associated with the reclustering option
      *  @param  caloHitListName name of the calo hit list associated with the reclustering option
      *  @param  reclusterListName the name of the reclustering option
-     *  @param  initialHitAvailability the initial availability of the calo hits
+     *  @param  inheritAvailability whether to inherit calo hit availability from the parent level, rather than start with all available
      */
     StatusCode CreateCaloHitMetadata(CaloHitList *const pCaloHitList, const std::string &caloHitListName, const std::string &reclusterListName,
-        const bool initialHitAvailability);
+        const bool inheritAvailability);
 
     /**
-     *  @brief  Extract specific calo hit metadata, removing entry from map and receiving a pointer to the metadata
+     *  @brief  Get specific calo hit metadata, which remains owned by the recluster metadata
      * 
      *  @param  reclusterListName the key/name matching the desired metadata
      *  @param  pCaloHitMetaData to receive the pointer to the metadata
      */
-    StatusCode ExtractCaloHitMetadata(const std::string &reclusterListName, CaloHitMetadata *&pCaloHitMetaData);
+    StatusCode GetCaloHitMetadata(const std::string &reclusterListName, CaloHitMetadata *&pCaloHitMetaData) const;
 
     /**
      *  @brief  Get the initial calo hit list
@@ -169,7 +355,9 @@ private:
     typedef std::map<std::string, CaloHitMetadata *> NameToMetadataMap;
 
     CaloHitMetadata            *m_pCurrentCaloHitMetadata;          ///< Address of the current calo hit metadata
+    const CaloHitMetadata      *m_pParentCaloHitMetadata;           ///< Address of the metadata of the enclosing reclustering process, if any
     CaloHitList                 m_caloHitList;                      ///< Copy of the reclustering input calo hit list
+    CaloHitBitset               m_membershipBitset;                 ///< The reclustering input calo hits, by calo hit index
     NameToMetadataMap           m_nameToMetadataMap;                ///< The recluster list name to metadata map
 };
 
@@ -178,9 +366,75 @@ typedef std::vector<ReclusterMetadata *> ReclusterMetadataList;
 //------------------------------------------------------------------------------------------------------------------------------------------
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-inline const CaloHitUsageMap &CaloHitMetadata::GetCaloHitUsageMap() const
+inline bool CaloHitBitset::Test(const unsigned int index) const
+{
+    const unsigned int wordIndex(index / BITS_PER_WORD);
+
+    if (wordIndex >= m_words.size())
+        return false;
+
+    return (0 != (m_words[wordIndex] & (Word(1) << (index % BITS_PER_WORD))));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline void CaloHitBitset::Set(const unsigned int index)
+{
+    const unsigned int wordIndex(index / BITS_PER_WORD);
+
+    if (wordIndex >= m_words.size())
+        m_words.resize(wordIndex + 1, 0);
+
+    m_words[wordIndex] |= (Word(1) << (index % BITS_PER_WORD));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline void CaloHitBitset::Reset(const unsigned int index)
+{
+    const unsigned int wordIndex(index / BITS_PER_WORD);
+
+    if (wordIndex < m_words.size())
+        m_words[wordIndex] &= ~(Word(1) << (index % BITS_PER_WORD));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline void CaloHitBitset::Clear()
+{
+    m_words.clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool CaloHitMetadata::IsMember(const unsigned int index) const
+{
+    return ((m_pBaseMembershipBitset->Test(index) && !m_removedBitset.Test(index)) || m_addedBitset.Test(index));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline void CaloHitMetadata::RecordAvailability(const unsigned int index, const bool isAvailable)
+{
+    m_recordedBitset.Set(index);
+
+    if (isAvailable)
+    {
+        m_availabilityBitset.Set(index);
+    }
+    else
+    {
+        m_availabilityBitset.Reset(index);
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline void CaloHitMetadata::EraseAvailability(const unsigned int index)
 {
-    return m_caloHitUsageMap;
+    m_recordedBitset.Reset(index);
+    m_availabilityBitset.Reset(index);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -10,6 +10,8 @@
 
 #include "Managers/AlgorithmObjectManager.h"
 
+#include "Objects/PfoHierarchy.h"
+
 #include "Pandora/ObjectCreation.h"
 #include "Pandora/PandoraInternal.h"
 
@@ -87,6 +89,26 @@ private:
      */
     StatusCode RemoveParentDaughterAssociation(const ParticleFlowObject *const pParentPfo, const ParticleFlowObject *const pDaughterPfo) const;
 
+    /**
+     *  @brief  Remove all parent-daughter relationships involving a list of particle flow objects, e.g. ahead of their deletion,
+     *          visiting each related particle flow object only once
+     *
+     *  @param  pfoList the list of particle flow objects
+     */
+    StatusCode RemoveAllParentDaughterAssociations(const PfoList &pfoList) const;
+
+    /**
+     *  @brief  Get the hierarchy of all particle flow objects, rebuilt only if particle flow objects have been created or deleted, or
+     *          parent-daughter relationships altered, since it was last built
+     *
+     *  @param  pPfoHierarchy to receive the address of the pfo hierarchy
+     */
+    StatusCode GetPfoHierarchy(const PfoHierarchy *&pPfoHierarchy);
+
+    PfoHierarchy            m_pfoHierarchy;             ///< The hierarchy of all particle flow objects
+    mutable bool            m_isPfoHierarchyValid;      ///< Whether the pfo hierarchy reflects the current pfos and relationships
+    unsigned int            m_pfoHierarchyNDeleted;     ///< The number of pfos deleted by the manager when the pfo hierarchy was built
+
     friend class PandoraApiImpl;
     friend class PandoraContentApiImpl;
     friend class PandoraImpl;
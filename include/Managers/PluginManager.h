@@ -8,6 +8,7 @@
 #ifndef PANDORA_PLUGIN_MANAGER_H
 #define PANDORA_PLUGIN_MANAGER_H 1
 
+#include "Pandora/ScratchArena.h"
 #include "Pandora/StatusCodes.h"
 
 namespace pandora
@@ -114,6 +115,15 @@ public:
      */
     const ParticleId *GetParticleId() const;
 
+    /**
+     *  @brief  Get the scratch arena for use with the shower profile plugin, holding reusable grids and peak calo hit lists. The arena
+     *          belongs to this pandora instance, so is never shared between threads running separate instances, and its contents are
+     *          cleared, with storage retained, when pandora is reset.
+     * 
+     *  @return the shower profile scratch arena
+     */
+    ScratchArena &GetShowerProfileScratchArena() const;
+
 private:
     /**
      *  @brief  Set the bfield plugin
@@ -159,6 +169,7 @@ private:
     LArTransformationPlugin        *m_pLArTransformationPlugin;         ///< Address of the lar transformation plugin
     PseudoLayerPlugin              *m_pPseudoLayerPlugin;               ///< Address of the pseudolayer plugin
     ShowerProfilePlugin            *m_pShowerProfilePlugin;             ///< The shower profile plugin
+    mutable ScratchArena            m_showerProfileScratchArena;        ///< The scratch arena for use with the shower profile plugin
 
     EnergyCorrections              *m_pEnergyCorrections;               ///< The energy corrections
     ParticleId                     *m_pParticleId;                      ///< The particle id
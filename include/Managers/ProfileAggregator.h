@@ -0,0 +1,180 @@
+/**
+ *  @file   PandoraSDK/include/Managers/ProfileAggregator.h
+ *
+ *  @brief  Header file for the profile aggregator class.
+ *
+ *  $Log: $
+ */
+#ifndef PANDORA_PROFILE_AGGREGATOR_H
+#define PANDORA_PROFILE_AGGREGATOR_H 1
+
+#include "Managers/MemoryUsage.h"
+#include "Managers/ProfileManager.h"
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace pandora
+{
+
+class Pandora;
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  ProfileAggregator class, merging the profiles of all pandora instances in the process that enable profile aggregation in
+ *          their settings. Each instance contributes at the end of each event, on its own thread: its algorithm profiles and event
+ *          processing time histogram (if recorded), the hot path counters for the event (if compiled in) and the memory usage
+ *          high-water marks for the event (if recorded). Contributions of destroyed instances are retained.
+ */
+class ProfileAggregator
+{
+public:
+    /**
+     *  @brief  AlgorithmSummary class, the profile of an algorithm instance name, summed over the pandora instances running it
+     */
+    class AlgorithmSummary
+    {
+    public:
+        /**
+         *  @brief  Default constructor
+         */
+        AlgorithmSummary();
+
+        std::string                         m_type;                 ///< The algorithm type
+        unsigned int                        m_nInstances;           ///< The number of pandora instances contributing
+        unsigned long long                  m_nCalls;               ///< The number of times the algorithm has been run
+        unsigned long long                  m_nEvents;              ///< The number of events in which the algorithm has been run
+        double                              m_wallTime;             ///< The total wall time, units s
+        double                              m_selfWallTime;         ///< The total wall time, excluding daughter algorithms, units s
+        double                              m_cpuTime;              ///< The total cpu time, units s
+        ProfileManager::ObjectCounts        m_objectCounts;         ///< The total numbers of algorithm objects created and deleted
+        unsigned long long                  m_nAllocations;         ///< The number of heap allocations, if tracked
+        unsigned long long                  m_nAllocatedBytes;      ///< The number of bytes allocated, if tracked
+    };
+
+    typedef std::map<std::string, AlgorithmSummary> AlgorithmSummaryMap;
+    typedef std::vector<unsigned long long> HotPathCountVector;
+    typedef std::vector<unsigned int> LatencyBinVector;
+
+    /**
+     *  @brief  Summary class, the merged profile of one or more pandora instances
+     */
+    class Summary
+    {
+    public:
+        /**
+         *  @brief  Default constructor
+         */
+        Summary();
+
+        unsigned int                        m_nInstances;           ///< The number of pandora instances contributing
+        unsigned long long                  m_nEvents;              ///< The number of events contributed
+        double                              m_elapsedTime;          ///< For a process summary, the wall time since the first contribution, units s
+        AlgorithmSummaryMap                 m_algorithmSummaryMap;  ///< The algorithm summaries, by algorithm instance name
+        HotPathCountVector                  m_hotPathCounts;        ///< The hot path counter totals, indexed by hot path counter
+        MemoryUsageMap                      m_peakMemoryUsageMap;   ///< The largest per-event memory usage high-water mark of each manager
+        LatencyBinVector                    m_latencyBinVector;     ///< The histogram of event processing times, as for the profile manager
+        unsigned long long                  m_nEventLatencies;      ///< The number of recorded event processing times
+        double                              m_latencySum;           ///< The sum of recorded event processing times, units s
+        double                              m_maxLatency;           ///< The maximum recorded event processing time, units s
+    };
+
+    /**
+     *  @brief  Get the merged profile of all contributing pandora instances, past and present
+     *
+     *  @param  summary to receive the merged profile
+     */
+    static void GetSummary(Summary &summary);
+
+    /**
+     *  @brief  Get an event processing time quantile from a merged profile, as for the profile manager
+     *
+     *  @param  summary the merged profile
+     *  @param  fraction the fraction of events processed within the returned time, e.g. 0.99 for the 99th percentile
+     *  @param  latency to receive the event processing time quantile, units s
+     */
+    static StatusCode GetEventLatencyQuantile(const Summary &summary, const double fraction, double &latency);
+
+    /**
+     *  @brief  Print the merged profile of all contributing pandora instances: the algorithm profiles, the event processing times
+     *          and throughput, the hot path counters and the memory usage high-water marks, as available
+     */
+    static void PrintSummary();
+
+private:
+    /**
+     *  @brief  Record the contribution of a pandora instance at the end of an event, printing the merged profile if the number of
+     *          events contributed by all instances reaches a multiple of the report period specified in its settings
+     *
+     *  @param  pPandora address of the pandora instance
+     *  @param  profileManager the profile manager of the pandora instance
+     *  @param  peakUsageMap the memory usage high-water marks for the event, empty if not recorded
+     */
+    static void Update(const Pandora *const pPandora, const ProfileManager &profileManager, const MemoryUsageMap &peakUsageMap);
+
+    /**
+     *  @brief  Retain the contribution of a pandora instance that is being destroyed
+     *
+     *  @param  pPandora address of the pandora instance
+     *  @param  profileManager the profile manager of the pandora instance
+     */
+    static void Remove(const Pandora *const pPandora, const ProfileManager &profileManager);
+
+    /**
+     *  @brief  Refresh the algorithm profiles and event processing time histogram of an instance summary, which are cumulative
+     *
+     *  @param  profileManager the profile manager
+     *  @param  summary the instance summary
+     */
+    static void FillCumulativeProfile(const ProfileManager &profileManager, Summary &summary);
+
+    /**
+     *  @brief  Merge one summary into another
+     *
+     *  @param  summary the summary to merge
+     *  @param  mergedSummary the summary into which to merge
+     */
+    static void Merge(const Summary &summary, Summary &mergedSummary);
+
+    /**
+     *  @brief  Merge memory usage high-water marks, retaining the larger estimated size for each manager
+     *
+     *  @param  peakUsageMap the high-water marks to merge
+     *  @param  mergedPeakUsageMap the high-water marks into which to merge
+     */
+    static void MergePeakMemoryUsage(const MemoryUsageMap &peakUsageMap, MemoryUsageMap &mergedPeakUsageMap);
+
+    /**
+     *  @brief  Get the merged profile, the caller holding the mutex
+     *
+     *  @param  summary to receive the merged profile
+     */
+    static void GetSummaryLocked(Summary &summary);
+
+    /**
+     *  @brief  Print a merged profile
+     *
+     *  @param  summary the merged profile
+     */
+    static void Print(const Summary &summary);
+
+    typedef std::map<const Pandora *, Summary> InstanceSummaryMap;
+    typedef std::chrono::steady_clock Clock;
+
+    static InstanceSummaryMap               m_instanceSummaryMap;   ///< The summaries of the live contributing pandora instances
+    static Summary                          m_retiredSummary;       ///< The merged summary of destroyed contributing pandora instances
+    static unsigned long long               m_nEvents;              ///< The number of events contributed by all instances
+    static Clock::time_point                m_startTime;            ///< The wall time of the first contribution
+    static std::mutex                       m_mutex;                ///< The mutex guarding the summaries
+
+    friend class Pandora;
+    friend class PandoraImpl;
+};
+
+} // namespace pandora
+
+#endif // #ifndef PANDORA_PROFILE_AGGREGATOR_H
@@ -0,0 +1,278 @@
+/**
+ *  @file   PandoraSDK/include/Managers/ProfileManager.h
+ *
+ *  @brief  Header file for the profile manager class.
+ *
+ *  $Log: $
+ */
+#ifndef PANDORA_PROFILE_MANAGER_H
+#define PANDORA_PROFILE_MANAGER_H 1
+
+#include "Pandora/StatusCodes.h"
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace pandora
+{
+
+class Algorithm;
+class AllocationCounters;
+class ClusterManager;
+class Pandora;
+class ParticleFlowObjectManager;
+class VertexManager;
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  ProfileManager class, recording the wall time, cpu time, object counts and, if allocation tracking is compiled in, heap
+ *          allocations for each algorithm instance, and a histogram of the wall time taken to process each event
+ */
+class ProfileManager
+{
+public:
+    /**
+     *  @brief  ObjectCounts class, the numbers of algorithm objects created and deleted
+     */
+    class ObjectCounts
+    {
+    public:
+        /**
+         *  @brief  Default constructor
+         */
+        ObjectCounts();
+
+        unsigned int    m_nClustersCreated;             ///< The number of clusters created
+        unsigned int    m_nClustersDeleted;             ///< The number of clusters deleted
+        unsigned int    m_nPfosCreated;                 ///< The number of pfos created
+        unsigned int    m_nPfosDeleted;                 ///< The number of pfos deleted
+        unsigned int    m_nVerticesCreated;             ///< The number of vertices created
+        unsigned int    m_nVerticesDeleted;             ///< The number of vertices deleted
+    };
+
+    /**
+     *  @brief  AlgorithmProfile class, the profile accumulated for a single algorithm instance. Times are inclusive of any
+     *          daughter algorithms run by the algorithm, except for the self wall time.
+     */
+    class AlgorithmProfile
+    {
+    public:
+        /**
+         *  @brief  Default constructor
+         */
+        AlgorithmProfile();
+
+        std::string     m_type;                         ///< The algorithm type
+        unsigned int    m_nCalls;                       ///< The number of times the algorithm has been run
+        unsigned int    m_nEvents;                      ///< The number of events in which the algorithm has been run
+        double          m_wallTime;                     ///< The total wall time, units s
+        double          m_selfWallTime;                 ///< The total wall time, excluding time spent in daughter algorithms, units s
+        double          m_cpuTime;                      ///< The total cpu time of the processing thread, units s
+        ObjectCounts    m_objectCounts;                 ///< The total numbers of algorithm objects created and deleted
+        AllocationCounters *m_pAllocationCounters;      ///< The heap allocations, excluding daughter algorithms, if tracked, else null
+
+    private:
+        unsigned int    m_lastEventNumber;              ///< The number of the last event in which the algorithm was run
+
+        friend class ProfileManager;
+    };
+
+    typedef std::map<std::string, AlgorithmProfile> AlgorithmProfileMap;
+
+    /**
+     *  @brief  Constructor
+     *
+     *  @param  pPandora address of the associated pandora object
+     *  @param  pClusterManager address of the cluster manager
+     *  @param  pPfoManager address of the pfo manager
+     *  @param  pVertexManager address of the vertex manager
+     */
+    ProfileManager(const Pandora *const pPandora, const ClusterManager *const pClusterManager, const ParticleFlowObjectManager *const pPfoManager,
+        const VertexManager *const pVertexManager);
+
+    /**
+     *  @brief  Destructor
+     */
+    ~ProfileManager();
+
+    /**
+     *  @brief  Get the algorithm profile map, from algorithm instance name to accumulated profile
+     *
+     *  @return the algorithm profile map
+     */
+    const AlgorithmProfileMap &GetAlgorithmProfileMap() const;
+
+    /**
+     *  @brief  Print a summary table of the accumulated algorithm profiles
+     */
+    void PrintSummary() const;
+
+    /**
+     *  @brief  Write all recorded algorithm invocations to a file, in the chrome trace event (json) format. If profiling zones are
+     *          compiled in, the zones recorded by all threads since creation of the manager are written too, labelled by thread.
+     *
+     *  @param  fileName the name of the output file
+     */
+    StatusCode WriteTrace(const std::string &fileName) const;
+
+    /**
+     *  @brief  Get the number of events for which the processing time has been recorded
+     *
+     *  @return the number of events
+     */
+    unsigned int GetNEventLatencies() const;
+
+    /**
+     *  @brief  Get an event processing time quantile, from the histogram of recorded times. The value returned is the upper edge of
+     *          the histogram bin containing the quantile, with bin widths of approximately twelve percent of the bin lower edge.
+     *
+     *  @param  fraction the fraction of events processed within the returned time, e.g. 0.99 for the 99th percentile
+     *  @param  latency to receive the event processing time quantile, units s
+     */
+    StatusCode GetEventLatencyQuantile(const double fraction, double &latency) const;
+
+    /**
+     *  @brief  Print a summary of the recorded event processing times: the number of events, the mean and maximum times, the
+     *          50th, 99th and 99.9th percentiles, the event throughput and the peak resident set size of the process
+     */
+    void PrintEventLatencySummary() const;
+
+private:
+    /**
+     *  @brief  Record the start of an algorithm invocation
+     *
+     *  @param  pAlgorithm address of the algorithm
+     */
+    StatusCode BeginAlgorithm(const Algorithm *const pAlgorithm);
+
+    /**
+     *  @brief  Record the end of the most recently started algorithm invocation
+     */
+    StatusCode EndAlgorithm();
+
+    /**
+     *  @brief  Reset the manager for the next event, abandoning any unfinished algorithm invocations
+     */
+    StatusCode ResetForNextEvent();
+
+    /**
+     *  @brief  Record the wall time taken to process an event
+     *
+     *  @param  latency the event processing time, units s
+     */
+    void RecordEventLatency(const double latency);
+
+    /**
+     *  @brief  Get the current numbers of algorithm objects created and deleted by the managers
+     *
+     *  @param  objectCounts to receive the object counts
+     */
+    void GetObjectCounts(ObjectCounts &objectCounts) const;
+
+    /**
+     *  @brief  Get the cpu time consumed by the calling thread
+     *
+     *  @return the cpu time, units s
+     */
+    static double GetThreadCpuTime();
+
+    /**
+     *  @brief  Get the peak resident set size of the process
+     *
+     *  @return the peak resident set size, units MB, zero if unavailable
+     */
+    static double GetPeakResidentSetSize();
+
+    /**
+     *  @brief  Get an event processing time quantile from a histogram of event processing times
+     *
+     *  @param  latencyBinVector the histogram of event processing times
+     *  @param  nEventLatencies the number of recorded event processing times
+     *  @param  maxLatency the maximum recorded event processing time, units s
+     *  @param  fraction the fraction of events processed within the returned time
+     *  @param  latency to receive the event processing time quantile, units s
+     */
+    static StatusCode GetLatencyQuantile(const std::vector<unsigned int> &latencyBinVector, const unsigned long long nEventLatencies,
+        const double maxLatency, const double fraction, double &latency);
+
+    typedef std::chrono::steady_clock Clock;
+
+    /**
+     *  @brief  Invocation class, describing an algorithm invocation that has started but not yet finished
+     */
+    class Invocation
+    {
+    public:
+        AlgorithmProfileMap::iterator   m_profileIter;          ///< The profile of the algorithm
+        Clock::time_point               m_startTime;            ///< The wall time at the start of the invocation
+        double                          m_startCpuTime;         ///< The cpu time at the start of the invocation, units s
+        double                          m_daughterWallTime;     ///< The wall time spent in daughter algorithms, units s
+        ObjectCounts                    m_startObjectCounts;    ///< The object counts at the start of the invocation
+        AllocationCounters             *m_pParentCounters;      ///< The allocation counters current before the invocation
+    };
+
+    /**
+     *  @brief  TraceEntry class, describing a finished algorithm invocation
+     */
+    class TraceEntry
+    {
+    public:
+        const std::string              *m_pInstanceName;        ///< The algorithm instance name
+        const std::string              *m_pType;                ///< The algorithm type
+        unsigned int                    m_eventNumber;          ///< The event number
+        unsigned int                    m_threadIndex;          ///< The index of the thread running the algorithm, as for profiling zones
+        double                          m_startTime;            ///< The start time, relative to creation of the manager, units s
+        double                          m_duration;             ///< The duration, units s
+    };
+
+    typedef std::vector<Invocation> InvocationStack;
+    typedef std::vector<TraceEntry> TraceEntryList;
+    typedef std::vector<unsigned int> LatencyBinVector;
+
+    static const double                 m_minLatency;           ///< The lower edge of the first event processing time bin, units s
+    static const unsigned int           m_nLatencyBinsPerDecade;///< The number of event processing time bins per decade
+    static const unsigned int           m_nLatencyBins;         ///< The number of event processing time bins
+
+    AlgorithmProfileMap                 m_algorithmProfileMap;  ///< The algorithm profile map
+    InvocationStack                     m_invocationStack;      ///< The algorithm invocations currently in progress
+    TraceEntryList                      m_traceEntryList;       ///< The finished algorithm invocations, if recording a trace
+    Clock::time_point                   m_referenceTime;        ///< The wall time at creation of the manager
+    unsigned int                        m_eventNumber;          ///< The current event number, incremented on each reset
+
+    LatencyBinVector                    m_latencyBinVector;     ///< The histogram of event processing times, logarithmic binning
+    unsigned int                        m_nEventLatencies;      ///< The number of recorded event processing times
+    double                              m_latencySum;           ///< The sum of recorded event processing times, units s
+    double                              m_maxLatency;           ///< The maximum recorded event processing time, units s
+
+    const Pandora *const                m_pPandora;             ///< The associated pandora object
+    const ClusterManager *const         m_pClusterManager;      ///< The cluster manager
+    const ParticleFlowObjectManager *const m_pPfoManager;       ///< The pfo manager
+    const VertexManager *const          m_pVertexManager;       ///< The vertex manager
+
+    friend class Pandora;
+    friend class PandoraApiImpl;
+    friend class PandoraContentApiImpl;
+    friend class PandoraImpl;
+    friend class ProfileAggregator;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const ProfileManager::AlgorithmProfileMap &ProfileManager::GetAlgorithmProfileMap() const
+{
+    return m_algorithmProfileMap;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int ProfileManager::GetNEventLatencies() const
+{
+    return m_nEventLatencies;
+}
+
+} // namespace pandora
+
+#endif // #ifndef PANDORA_PROFILE_MANAGER_H
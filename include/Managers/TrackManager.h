@@ -10,8 +10,13 @@
 
 #include "Managers/InputObjectManager.h"
 
+#include "Objects/SpatialIndex.h"
+#include "Objects/TrackRelationGraph.h"
+#include "Objects/TrackSelectionMasks.h"
+
 #include "Pandora/ObjectCreation.h"
 #include "Pandora/PandoraInternal.h"
+#include "Pandora/ThreadPool.h"
 
 namespace pandora
 {
@@ -35,6 +40,75 @@ public:
     ~TrackManager();
 
 private:
+    /**
+     *  @brief  MCPfoTargetMatchingTask class, matching a single track to its mc pfo targets. Each item writes only to its own track.
+     */
+    class MCPfoTargetMatchingTask : public ParallelForTask
+    {
+    public:
+        /**
+         *  @brief  Constructor
+         *
+         *  @param  trackManager the track manager
+         *  @param  trackVector the input tracks, in input list order
+         *  @param  trackToPfoTargetsMap the track uid to mc pfo target map
+         */
+        MCPfoTargetMatchingTask(const TrackManager &trackManager, const TrackVector &trackVector,
+            const UidToMCParticleWeightTable &trackToPfoTargetsMap);
+
+        StatusCode Run(const unsigned int index) const;
+
+    private:
+        const TrackManager                  &m_trackManager;            ///< The track manager
+        const TrackVector                   &m_trackVector;             ///< The input tracks, in input list order
+        const UidToMCParticleWeightTable    &m_trackToPfoTargetsMap;    ///< The track uid to mc pfo target map
+    };
+
+    /**
+     *  @brief  CalorimeterLayer class, describing a single barrel or endcap calorimeter layer
+     */
+    class CalorimeterLayer
+    {
+    public:
+        SubDetectorType                     m_subDetectorType;          ///< The sub detector type
+        unsigned int                        m_layer;                    ///< The index of the layer within the sub detector
+        bool                                m_isBarrel;                 ///< Whether the layer is a barrel layer, rather than an endcap layer
+        float                               m_distanceToIp;             ///< The layer radius, for barrels, or z coordinate, for endcaps, units mm
+        float                               m_maxExtent;                ///< The sub detector outer z, for barrels, or outer radius, for endcaps, units mm
+        bool                                m_isMirroredInZ;            ///< Whether an endcap layer is mirrored in the negative z half
+    };
+
+    typedef std::vector<CalorimeterLayer> CalorimeterLayerVector;
+
+    /**
+     *  @brief  LayerIntersectionTask class, calculating the calorimeter layer intersections for a single track. Each item writes
+     *          only to its own track.
+     */
+    class LayerIntersectionTask : public ParallelForTask
+    {
+    public:
+        /**
+         *  @brief  Constructor
+         *
+         *  @param  trackManager the track manager
+         *  @param  trackVector the input tracks, in input list order
+         *  @param  calorimeterLayers the calorimeter layers
+         *  @param  bField the bfield at the origin, units Tesla
+         *  @param  pseudoLayerPlugin the pseudo layer plugin
+         */
+        LayerIntersectionTask(const TrackManager &trackManager, const TrackVector &trackVector, const CalorimeterLayerVector &calorimeterLayers,
+            const float bField, const PseudoLayerPlugin &pseudoLayerPlugin);
+
+        StatusCode Run(const unsigned int index) const;
+
+    private:
+        const TrackManager                  &m_trackManager;            ///< The track manager
+        const TrackVector                   &m_trackVector;             ///< The input tracks, in input list order
+        const CalorimeterLayerVector        &m_calorimeterLayers;       ///< The calorimeter layers
+        const float                          m_bField;                  ///< The bfield at the origin, units Tesla
+        const PseudoLayerPlugin             &m_pseudoLayerPlugin;       ///< The pseudo layer plugin
+    };
+
     /**
      *  @brief  Create track
      * 
@@ -45,6 +119,23 @@ private:
     StatusCode Create(const object_creation::Track::Parameters &parameters, const Track *&pTrack,
         const ObjectFactory<object_creation::Track::Parameters, object_creation::Track::Object> &factory);
 
+    /**
+     *  @brief  Create a batch of tracks, either creating all tracks or none
+     * 
+     *  @param  parametersVector the parameters for each of the tracks
+     *  @param  factory the factory that performs the object allocation
+     */
+    StatusCode Create(const std::vector<object_creation::Track::Parameters> &parametersVector,
+        const ObjectFactory<object_creation::Track::Parameters, object_creation::Track::Object> &factory);
+
+    /**
+     *  @brief  Check that all required track parameters are initialized, so that the track constructor may read them unchecked, and
+     *          that the track energy and charge are consistent
+     * 
+     *  @param  parameters the track parameters
+     */
+    static StatusCode ValidateParameters(const object_creation::Track::Parameters &parameters);
+
     /**
      *  @brief  Is a track, or a list of tracks, available to add to a particle flow object
      * 
@@ -62,19 +153,87 @@ private:
      *  @param  isAvailable the availability
      */
     template <typename T>
-    void SetAvailability(const T *const pT, bool isAvailable) const;
+    void SetAvailability(const T *const pT, bool isAvailable);
+
+    /**
+     *  @brief  Whether the track manager is unchanged, other than in its current list, since its initial lists were created
+     * 
+     *  @return boolean
+     */
+    bool IsInInitialState() const;
 
     /**
      *  @brief  Erase all track manager content
      */
     StatusCode EraseAllContent();
 
+    /**
+     *  @brief  Reserve capacity for the expected number of tracks in the upcoming event, avoiding repeated rehashing
+     *
+     *  @param  nTracks the expected number of tracks
+     */
+    StatusCode ReserveCapacity(const unsigned int nTracks);
+
+    /**
+     *  @brief  Get the spatial index over the calorimeter projections of the input tracks, rebuilding it only if the input list has changed
+     * 
+     *  @param  pTrackSpatialIndex to receive the address of the spatial index
+     */
+    StatusCode GetInputSpatialIndex(const TrackSpatialIndex *&pTrackSpatialIndex);
+
+    /**
+     *  @brief  Get the flattened parent, daughter and sibling relationships of the input tracks, rebuilding them only if the input list
+     *          has changed since the track associations were applied
+     * 
+     *  @param  pTrackRelationGraph to receive the address of the track relation graph
+     */
+    StatusCode GetTrackRelationGraph(const TrackRelationGraph *&pTrackRelationGraph);
+
+    /**
+     *  @brief  Get the selection flag words of the input tracks, which are kept up to date as tracks are created and as their
+     *          availability and cluster associations change
+     * 
+     *  @param  pTrackSelectionMasks to receive the address of the track selection masks
+     */
+    StatusCode GetTrackSelectionMasks(const TrackSelectionMasks *&pTrackSelectionMasks) const;
+
+    /**
+     *  @brief  Create the input track list, which will be sorted
+     */
+    StatusCode CreateInputList();
+
+    /**
+     *  @brief  Add objects to a saved track list
+     * 
+     *  @param  listName the name of the list
+     *  @param  trackList the track list
+     */
+    StatusCode AddObjectsToList(const std::string &listName, const TrackList &trackList);
+
+    /**
+     *  @brief  Remove objects from a saved track list
+     * 
+     *  @param  listName the name of the list
+     *  @param  trackList the track list
+     */
+    StatusCode RemoveObjectsFromList(const std::string &listName, const TrackList &trackList);
+
     /**
      *  @brief  Match tracks to their correct mc particles for particle flow
      *
      *  @param  trackToPfoTargetsMap the track uid to mc pfo target map
+     *  @param  threadPool the thread pool across which to partition the input tracks
+     */
+    StatusCode MatchTracksToMCPfoTargets(const UidToMCParticleWeightTable &trackToPfoTargetsMap, ThreadPool &threadPool);
+
+    /**
+     *  @brief  Calculate the intersections of the helix at the calorimeter of each input track with every barrel and endcap calorimeter
+     *          layer, caching them in the tracks by pseudo layer. Nothing is calculated without calorimeter sub detectors, a bfield plugin
+     *          and a pseudo layer plugin.
+     *
+     *  @param  threadPool the thread pool across which to partition the input tracks
      */
-    StatusCode MatchTracksToMCPfoTargets(const UidToMCParticleWeightMap &trackToPfoTargetsMap);
+    StatusCode CalculateLayerIntersections(ThreadPool &threadPool);
 
     /**
      *  @brief  Remove all mc particle associations that have been registered with tracks
@@ -98,9 +257,10 @@ private:
     StatusCode SetTrackSiblingRelationship(const Uid firstSiblingUid, const Uid secondSiblingUid);
 
     /**
-     *  @brief  Apply track associations (parent-daughter and sibling) that have been registered with the track manager
+     *  @brief  Apply track associations (parent-daughter and sibling) that have been registered with the track manager, then
+     *          fill the track relation graph
      */
-    StatusCode AssociateTracks() const;
+    StatusCode AssociateTracks();
 
     /**
      *  @brief  Add parent-daughter associations to tracks
@@ -118,7 +278,7 @@ private:
      *  @param  pTrack the address of the relevant track
      *  @param  pCluster the address of the associated cluster
      */
-    StatusCode SetAssociatedCluster(const Track *const pTrack, const Cluster *const pCluster) const;
+    StatusCode SetAssociatedCluster(const Track *const pTrack, const Cluster *const pCluster);
 
     /**
      *  @brief  Remove the association of a track with a cluster
@@ -126,26 +286,26 @@ private:
      *  @param  pTrack the address of the relevant track
      *  @param  pCluster the address of the cluster with which the track is no longer associated
      */
-    StatusCode RemoveAssociatedCluster(const Track *const pTrack, const Cluster *const pCluster) const;
+    StatusCode RemoveAssociatedCluster(const Track *const pTrack, const Cluster *const pCluster);
 
     /**
      *  @brief  Remove all track to cluster associations
      */
-    StatusCode RemoveAllClusterAssociations() const;
+    StatusCode RemoveAllClusterAssociations();
 
     /**
-     *  @brief  Remove track to cluster associations from all tracks in the current list
-     * 
-     *  @param  danglingClusters to receive the list of "dangling" associations
+     *  @brief  Get all track to cluster associations, in input track list order
+     *
+     *  @param  associations to receive the track and cluster of each association
      */
-    StatusCode RemoveCurrentClusterAssociations(TrackToClusterMap &danglingClusters) const;
+    StatusCode GetClusterAssociations(TrackClusterAssociationVector &associations) const;
 
     /**
      *  @brief  Remove track to cluster associations from a specified list of tracks
      * 
      *  @param  trackList the specified track list
      */
-    StatusCode RemoveClusterAssociations(const TrackList &trackList) const;
+    StatusCode RemoveClusterAssociations(const TrackList &trackList);
 
     /**
      *  @brief  Initialize reclustering operations, preparing lists and metadata accordingly
@@ -163,6 +323,11 @@ private:
     UidToTrackMap                   m_uidToTrackMap;                    ///< The uid to track map
     TrackRelationMap                m_parentDaughterRelationMap;        ///< The track parent-daughter relation map
     TrackRelationMap                m_siblingRelationMap;               ///< The track sibling relation map
+    TrackSpatialIndex               m_inputSpatialIndex;                ///< The spatial index over the input track calorimeter projections
+    bool                            m_isInputSpatialIndexValid;         ///< Whether the input spatial index reflects the current input list
+    TrackRelationGraph              m_trackRelationGraph;               ///< The flattened relationships between the input tracks
+    bool                            m_isTrackRelationGraphValid;        ///< Whether the track relation graph reflects the current input list
+    TrackSelectionMasks             m_trackSelectionMasks;              ///< The selection flag words of the input tracks
 
     friend class PandoraApiImpl;
     friend class PandoraContentApiImpl;
@@ -10,6 +10,8 @@
 
 #include "Managers/AlgorithmObjectManager.h"
 
+#include "Objects/SpatialIndex.h"
+
 #include "Pandora/ObjectCreation.h"
 #include "Pandora/PandoraInternal.h"
 
@@ -72,6 +74,31 @@ private:
     template <typename T>
     void SetAvailability(const T *const pT, bool isAvailable) const;
 
+    /**
+     *  @brief  Rebuild and get the spatial index over the positions of the vertices in a specified list
+     * 
+     *  @param  listName the name of the vertex list
+     *  @param  pVertexSpatialIndex to receive the address of the spatial index
+     */
+    StatusCode GetListSpatialIndex(const std::string &listName, const VertexSpatialIndex *&pVertexSpatialIndex);
+
+    /**
+     *  @brief  Get the available vertices in a specified list that lie within a merge distance of an earlier available vertex in the
+     *          list, which is retained. Vertices are considered in list order, so each retained vertex absorbs the later candidates
+     *          around it, and an absorbed vertex absorbs no others.
+     * 
+     *  @param  listName the name of the vertex list
+     *  @param  mergeDistance the merge distance, units mm
+     *  @param  duplicateVertexList to receive the vertices lying within the merge distance of a retained vertex
+     */
+    StatusCode GetDuplicateVertices(const std::string &listName, const float mergeDistance, VertexList &duplicateVertexList);
+
+    bool IsInInitialState() const;
+    StatusCode EraseAllContent();
+
+    VertexSpatialIndex              m_listSpatialIndex;             ///< The spatial index over the vertices in the most recently indexed list
+
+    friend class PandoraApiImpl;
     friend class PandoraContentApiImpl;
     friend class PandoraImpl;
 };
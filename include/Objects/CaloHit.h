@@ -11,10 +11,13 @@
 #include "Pandora/ObjectCreation.h"
 #include "Pandora/StatusCodes.h"
 
+#include <cstdint>
+
 namespace pandora
 {
 
 template<typename T> class InputObjectManager;
+template<typename T> class Manager;
 template<typename T, typename S> class PandoraObjectFactory;
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -207,11 +210,41 @@ public:
      */
     const MCParticleWeightMap &GetMCParticleWeightMap() const;
 
+    /**
+     *  @brief  Get the mc particle making the largest contribution to the calo hit, cached when the mc particles are set
+     * 
+     *  @return address of the main mc particle, nullptr if there is no contributing mc particle
+     */
+    const MCParticle *GetMainMCParticle() const;
+
     /**
      *  @brief  Get the address of the parent calo hit in the user framework
      */
     const void *GetParentAddress() const;
 
+    /**
+     *  @brief  Get the id of the event, within a batch of events, to which the calo hit belongs
+     * 
+     *  @return the event id
+     */
+    unsigned int GetEventId() const;
+
+    /**
+     *  @brief  Get the dense per-event calo hit index, assigned by the calo hit manager at creation, for use in vector side tables.
+     *          Unlike those of clusters, vertices and pfos, calo hit indices are never reused within an event.
+     *
+     *  @return the calo hit index
+     */
+    unsigned int GetIndex() const;
+
+    /**
+     *  @brief  Get the generation of the calo hit index, advanced whenever the index is released or the event is reset, so that the
+     *          calo hit may be distinguished from any earlier holder of the same index
+     *
+     *  @return the index generation
+     */
+    unsigned int GetIndexGeneration() const;
+
     /**
      *  @brief  Get the list of cartesian coordinates for the cell corners
      * 
@@ -219,6 +252,13 @@ public:
      */
     void GetCellCorners(CartesianPointVector &cartesianPointVector) const;
 
+    /**
+     *  @brief  Get the packed sort key, precomputed from the cell position, for fast and deterministic sorting via the sorting helper
+     * 
+     *  @return the sort key
+     */
+    uint64_t GetSortKey() const;
+
     /**
      *  @brief  operator< sorting by position, then energy
      * 
@@ -228,7 +268,73 @@ public:
      */
     bool operator< (const CaloHit &rhs) const;
 
+#ifdef PANDORA_POOLED_OBJECT_ALLOCATION
+    /**
+     *  @brief  Class-specific allocation, using the calo hit object pool
+     * 
+     *  @param  size the number of bytes requested
+     */
+    static void *operator new(std::size_t size);
+
+    /**
+     *  @brief  Class-specific deallocation, using the calo hit object pool
+     * 
+     *  @param  pAddress the address of the memory to release
+     *  @param  size the number of bytes originally requested
+     */
+    static void operator delete(void *pAddress, std::size_t size);
+#endif
+
 protected:
+#ifdef PANDORA_COMPACT_CALO_HITS
+    /**
+     *  @brief  CellProperties class, holding the calorimeter-specific cell properties. In compact mode, each distinct set of cell
+     *          properties is stored once per process and shared by all calo hits with identical values, e.g. all the hits in a
+     *          lar tpc readout view, so the properties cost a single pointer per calo hit.
+     */
+    class CellProperties
+    {
+    public:
+        /**
+         *  @brief  Constructor
+         * 
+         *  @param  parameters the calo hit parameters
+         */
+        CellProperties(const object_creation::CaloHit::Parameters &parameters);
+
+        /**
+         *  @brief  Equality operator, requiring identical values
+         * 
+         *  @param  rhs the cell properties to compare
+         */
+        bool operator== (const CellProperties &rhs) const;
+
+        /**
+         *  @brief  Hash the cell properties
+         * 
+         *  @return the hash value
+         */
+        std::size_t GetHash() const;
+
+        CartesianVector     m_expectedDirection;        ///< Unit vector in direction of expected hit propagation
+        CartesianVector     m_cellNormalVector;         ///< Unit normal to the sampling layer, pointing outwards from the origin
+        CellGeometry        m_cellGeometry;             ///< The cell geometry type, pointing or rectangular
+        float               m_nCellRadiationLengths;    ///< Absorber material in front of cell, units radiation lengths
+        float               m_nCellInteractionLengths;  ///< Absorber material in front of cell, units interaction lengths
+        bool                m_isInOuterSamplingLayer;   ///< Whether cell is in one of the outermost detector sampling layers
+    };
+
+    /**
+     *  @brief  Get the shared copy of the cell properties described by the calo hit parameters, creating it if required. Shared
+     *          copies live until the end of the process, so remain valid for calo hits shared between pandora instances.
+     * 
+     *  @param  parameters the calo hit parameters
+     * 
+     *  @return address of the shared cell properties
+     */
+    static const CellProperties *GetSharedCellProperties(const object_creation::CaloHit::Parameters &parameters);
+#endif
+
     /**
      *  @brief  Constructor
      * 
@@ -274,6 +380,20 @@ protected:
      */
     void RemoveMCParticles();
 
+    /**
+     *  @brief  Create a new, empty mc particle weight map, drawing its storage from the shared pool if pooling is enabled
+     * 
+     *  @return the address of the new mc particle weight map
+     */
+    static MCParticleWeightMap *CreateMCParticleWeightMap();
+
+    /**
+     *  @brief  Delete an mc particle weight map, returning its storage to the shared pool if pooling is enabled
+     * 
+     *  @param  pMCParticleWeightMap the address of the mc particle weight map
+     */
+    static void DeleteMCParticleWeightMap(MCParticleWeightMap *const pMCParticleWeightMap);
+
     /**
      *  @brief  Calculate the typical length scale of the cell, units mm
      * 
@@ -311,14 +431,20 @@ protected:
 
     CartesianVector         m_positionVector;           ///< Position vector of center of calorimeter cell, units mm
     float                   m_x0;                       ///< For LArTPC usage, the x-coordinate shift associated with a drift time t0 shift, units mm
+#ifdef PANDORA_COMPACT_CALO_HITS
+    const CellProperties   *const m_pCellProperties;    ///< The shared calorimeter-specific cell properties
+#else
     const CartesianVector   m_expectedDirection;        ///< Unit vector in direction of expected hit propagation
     const CartesianVector   m_cellNormalVector;         ///< Unit normal to the sampling layer, pointing outwards from the origin
     const CellGeometry      m_cellGeometry;             ///< The cell geometry type, pointing or rectangular
+#endif
     const float             m_cellSize0;                ///< Cell size 0 [pointing: pseudo rapidity, eta, rectangular: up in ENDCAP, along beam in BARREL, units mm]
     const float             m_cellSize1;                ///< Cell size 1 [pointing: azimuthal angle, phi, rectangular: perpendicular to size 0 and thickness, units mm]
     const float             m_cellThickness;            ///< Thickness of cell, units mm
+#ifndef PANDORA_COMPACT_CALO_HITS
     const float             m_nCellRadiationLengths;    ///< Absorber material in front of cell, units radiation lengths
     const float             m_nCellInteractionLengths;  ///< Absorber material in front of cell, units interaction lengths
+#endif
     const float             m_time;                     ///< Time of (earliest) energy deposition in this cell, units ns
     const float             m_inputEnergy;              ///< Corrected energy of calorimeter cell in user framework, units GeV
     const float             m_mipEquivalentEnergy;      ///< The calibrated mip equivalent energy, units mip
@@ -329,18 +455,29 @@ protected:
     const HitRegion         m_hitRegion;                ///< Region of the detector in which the calo hit is located
     const unsigned int      m_layer;                    ///< The subdetector readout layer number
     InputUInt               m_pseudoLayer;              ///< The pseudo layer to which the calo hit has been assigned
+#ifndef PANDORA_COMPACT_CALO_HITS
     const bool              m_isInOuterSamplingLayer;   ///< Whether cell is in one of the outermost detector sampling layers
+#endif
     float                   m_cellLengthScale;          ///< Typical length scale [pointing: measured at cell mid-point, rectangular: std::sqrt(cellSize0 * cellSize1), units mm ]
     bool                    m_isPossibleMip;            ///< Whether the calo hit is a possible mip hit
     bool                    m_isIsolated;               ///< Whether the calo hit is isolated
     bool                    m_isAvailable;              ///< Whether the calo hit is available to be added to a cluster
+    unsigned int            m_index;                    ///< The dense per-event calo hit index, assigned by the calo hit manager
+    unsigned int            m_indexGeneration;          ///< The generation of the calo hit index, as assigned
     float                   m_weight;                   ///< The calo hit weight, which may not be unity if the hit has been fragmented
-    MCParticleWeightMap     m_mcParticleWeightMap;      ///< The mc particle weight map
+    MCParticleWeightMap    *m_pMCParticleWeightMap;     ///< The mc particle weight map, allocated only if there are mc particles
+    const MCParticle       *m_pMainMCParticle;          ///< The mc particle making the largest contribution, if any
     const void             *m_pParentAddress;           ///< The address of the parent calo hit in the user framework
+    const unsigned int      m_eventId;                  ///< The id of the event, within a batch of events, to which the calo hit belongs
+    const uint64_t          m_sortKey;                  ///< The packed sort key, precomputed from the cell position
 
     friend class CaloHitMetadata;
+    friend class CaloHitNeighbourGraph;
     friend class CaloHitManager;
+    friend class ClusterManager;
+    friend class EnergyCorrections;
     friend class InputObjectManager<CaloHit>;
+    friend class Manager<CaloHit>;
     friend class PandoraObjectFactory<object_creation::CaloHit::Parameters, object_creation::CaloHit::Object>;
     friend class PandoraObjectFactory<object_creation::CaloHitFragment::Parameters, object_creation::CaloHitFragment::Object>;
 };
@@ -363,21 +500,33 @@ inline float CaloHit::GetX0() const
 
 inline const CartesianVector &CaloHit::GetExpectedDirection() const
 {
+#ifdef PANDORA_COMPACT_CALO_HITS
+    return m_pCellProperties->m_expectedDirection;
+#else
     return m_expectedDirection;
+#endif
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 inline const CartesianVector &CaloHit::GetCellNormalVector() const
 {
+#ifdef PANDORA_COMPACT_CALO_HITS
+    return m_pCellProperties->m_cellNormalVector;
+#else
     return m_cellNormalVector;
+#endif
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 inline CellGeometry CaloHit::GetCellGeometry() const
 {
+#ifdef PANDORA_COMPACT_CALO_HITS
+    return m_pCellProperties->m_cellGeometry;
+#else
     return m_cellGeometry;
+#endif
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -405,14 +554,22 @@ inline float CaloHit::GetCellThickness() const
 
 inline float CaloHit::GetNCellRadiationLengths() const
 {
+#ifdef PANDORA_COMPACT_CALO_HITS
+    return m_pCellProperties->m_nCellRadiationLengths;
+#else
     return m_nCellRadiationLengths;
+#endif
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 inline float CaloHit::GetNCellInteractionLengths() const
 {
+#ifdef PANDORA_COMPACT_CALO_HITS
+    return m_pCellProperties->m_nCellInteractionLengths;
+#else
     return m_nCellInteractionLengths;
+#endif
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -468,7 +625,11 @@ inline unsigned int CaloHit::GetPseudoLayer() const
 
 inline bool CaloHit::IsInOuterSamplingLayer() const
 {
+#ifdef PANDORA_COMPACT_CALO_HITS
+    return m_pCellProperties->m_isInOuterSamplingLayer;
+#else
     return m_isInOuterSamplingLayer;
+#endif
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -524,7 +685,16 @@ inline bool CaloHit::IsIsolated() const
 
 inline const MCParticleWeightMap &CaloHit::GetMCParticleWeightMap() const
 {
-    return m_mcParticleWeightMap;
+    static const MCParticleWeightMap emptyMCParticleWeightMap;
+
+    return (m_pMCParticleWeightMap ? *m_pMCParticleWeightMap : emptyMCParticleWeightMap);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const MCParticle *CaloHit::GetMainMCParticle() const
+{
+    return m_pMainMCParticle;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -536,6 +706,34 @@ inline const void *CaloHit::GetParentAddress() const
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+inline unsigned int CaloHit::GetEventId() const
+{
+    return m_eventId;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int CaloHit::GetIndex() const
+{
+    return m_index;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int CaloHit::GetIndexGeneration() const
+{
+    return m_indexGeneration;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline uint64_t CaloHit::GetSortKey() const
+{
+    return m_sortKey;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 inline bool CaloHit::IsAvailable() const
 {
     return m_isAvailable;
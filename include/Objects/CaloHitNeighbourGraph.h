@@ -0,0 +1,162 @@
+/**
+ *  @file   PandoraSDK/include/Objects/CaloHitNeighbourGraph.h
+ *
+ *  @brief  Header file for the calo hit neighbour graph class.
+ *
+ *  $Log: $
+ */
+#ifndef PANDORA_CALO_HIT_NEIGHBOUR_GRAPH_H
+#define PANDORA_CALO_HIT_NEIGHBOUR_GRAPH_H 1
+
+#include "Pandora/PandoraInternal.h"
+#include "Pandora/StatusCodes.h"
+
+namespace pandora
+{
+
+/**
+ *  @brief  CaloHitNeighbourGraph class, a read-only precomputed neighbour relationship between calo hits. For each calo hit in the
+ *          list used to build the graph, the neighbours are the other calo hits in the list within a maximum distance, in the same
+ *          pseudo layer or in one of a fixed number of preceding pseudo layers. Neighbours are held in list order.
+ */
+class CaloHitNeighbourGraph
+{
+public:
+    /**
+     *  @brief  Default constructor
+     */
+    CaloHitNeighbourGraph();
+
+    /**
+     *  @brief  Get the number of calo hits in the graph
+     *
+     *  @return the number of calo hits
+     */
+    unsigned int size() const;
+
+    /**
+     *  @brief  Whether the graph is empty
+     *
+     *  @return boolean
+     */
+    bool empty() const;
+
+    /**
+     *  @brief  Get the maximum distance between neighbouring calo hits, units mm
+     *
+     *  @return the maximum distance
+     */
+    float GetMaxDistance() const;
+
+    /**
+     *  @brief  Get the number of preceding pseudo layers in which neighbours are sought
+     *
+     *  @return the number of preceding pseudo layers
+     */
+    unsigned int GetLayerWindow() const;
+
+    /**
+     *  @brief  Get the neighbours of a calo hit, within the maximum distance and in pseudo layers L - layerWindow to L, where L is the
+     *          pseudo layer of the calo hit
+     *
+     *  @param  pCaloHit address of the calo hit
+     *  @param  caloHitVector to receive the neighbours, appended in list order
+     *
+     *  @return STATUS_CODE_SUCCESS, or STATUS_CODE_NOT_FOUND if the calo hit is not in the graph
+     */
+    StatusCode GetNeighbours(const CaloHit *const pCaloHit, CaloHitVector &caloHitVector) const;
+
+private:
+    /**
+     *  @brief  GridEntry class, describing the grid cell of a calo hit
+     */
+    class GridEntry
+    {
+    public:
+        /**
+         *  @brief  Less than operator, ordering entries by pseudo layer, then cell coordinates, then list index
+         *
+         *  @param  rhs the entry for comparison
+         *
+         *  @return boolean
+         */
+        bool operator<(const GridEntry &rhs) const;
+
+        unsigned int            m_pseudoLayer;          ///< The calo hit pseudo layer
+        int                     m_cell[3];              ///< The grid cell x, y and z coordinates
+        unsigned int            m_listIndex;            ///< The position of the calo hit in the source list
+    };
+
+    typedef std::vector<GridEntry> GridEntryVector;
+
+    /**
+     *  @brief  Refill the graph using the contents of a calo hit list, via a grid of cells with size equal to the maximum distance
+     *
+     *  @param  caloHitList the calo hit list
+     *  @param  maxDistance the maximum distance between neighbouring calo hits, units mm
+     *  @param  layerWindow the number of preceding pseudo layers in which neighbours are sought
+     */
+    StatusCode Fill(const CaloHitList &caloHitList, const float maxDistance, const unsigned int layerWindow);
+
+    /**
+     *  @brief  Clear the graph
+     */
+    void Clear();
+
+    CaloHitVector               m_neighbourVector;      ///< The neighbours of all calo hits, contiguous for each calo hit
+    UIntVector                  m_beginIndices;         ///< For each calo hit index, the position of the first neighbour
+    UIntVector                  m_endIndices;           ///< For each calo hit index, the position one beyond the last neighbour
+    unsigned int                m_nCaloHits;            ///< The number of calo hits in the graph
+    float                       m_maxDistance;          ///< The maximum distance between neighbouring calo hits, units mm
+    unsigned int                m_layerWindow;          ///< The number of preceding pseudo layers in which neighbours are sought
+
+    friend class CaloHitManager;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int CaloHitNeighbourGraph::size() const
+{
+    return m_nCaloHits;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool CaloHitNeighbourGraph::empty() const
+{
+    return (0 == m_nCaloHits);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline float CaloHitNeighbourGraph::GetMaxDistance() const
+{
+    return m_maxDistance;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int CaloHitNeighbourGraph::GetLayerWindow() const
+{
+    return m_layerWindow;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool CaloHitNeighbourGraph::GridEntry::operator<(const GridEntry &rhs) const
+{
+    if (m_pseudoLayer != rhs.m_pseudoLayer)
+        return (m_pseudoLayer < rhs.m_pseudoLayer);
+
+    for (unsigned int axis = 0; axis < 3; ++axis)
+    {
+        if (m_cell[axis] != rhs.m_cell[axis])
+            return (m_cell[axis] < rhs.m_cell[axis]);
+    }
+
+    return (m_listIndex < rhs.m_listIndex);
+}
+
+} // namespace pandora
+
+#endif // #ifndef PANDORA_CALO_HIT_NEIGHBOUR_GRAPH_H
@@ -0,0 +1,214 @@
+/**
+ *  @file   PandoraSDK/include/Objects/CaloHitSnapshot.h
+ *
+ *  @brief  Header file for the calo hit snapshot class.
+ *
+ *  $Log: $
+ */
+#ifndef PANDORA_CALO_HIT_SNAPSHOT_H
+#define PANDORA_CALO_HIT_SNAPSHOT_H 1
+
+#include "Pandora/PandoraEnumeratedTypes.h"
+#include "Pandora/PandoraInternal.h"
+#include "Pandora/StatusCodes.h"
+
+namespace pandora
+{
+
+/**
+ *  @brief  CaloHitSnapshot class, a read-only structure-of-arrays copy of the most frequently used calo hit properties. Entry i in
+ *          each array describes the calo hit at position i in the calo hit vector.
+ */
+class CaloHitSnapshot
+{
+public:
+    typedef std::vector<HitType> HitTypeVector;
+
+    /**
+     *  @brief  Default constructor
+     */
+    CaloHitSnapshot();
+
+    /**
+     *  @brief  Get the number of calo hits in the snapshot
+     *
+     *  @return the number of calo hits
+     */
+    unsigned int size() const;
+
+    /**
+     *  @brief  Whether the snapshot is empty
+     *
+     *  @return boolean
+     */
+    bool empty() const;
+
+    /**
+     *  @brief  Get the calo hit vector, providing the index back to the calo hit addresses
+     *
+     *  @return the calo hit vector
+     */
+    const CaloHitVector &GetCaloHitVector() const;
+
+    /**
+     *  @brief  Get the calo hit position x coordinates, units mm
+     *
+     *  @return the x coordinates
+     */
+    const FloatVector &GetX() const;
+
+    /**
+     *  @brief  Get the calo hit position y coordinates, units mm
+     *
+     *  @return the y coordinates
+     */
+    const FloatVector &GetY() const;
+
+    /**
+     *  @brief  Get the calo hit position z coordinates, units mm
+     *
+     *  @return the z coordinates
+     */
+    const FloatVector &GetZ() const;
+
+    /**
+     *  @brief  Get the calo hit input energies, units GeV
+     *
+     *  @return the input energies
+     */
+    const FloatVector &GetInputEnergy() const;
+
+    /**
+     *  @brief  Get the calo hit electromagnetic energies, units GeV
+     *
+     *  @return the electromagnetic energies
+     */
+    const FloatVector &GetElectromagneticEnergy() const;
+
+    /**
+     *  @brief  Get the calo hit hadronic energies, units GeV
+     *
+     *  @return the hadronic energies
+     */
+    const FloatVector &GetHadronicEnergy() const;
+
+    /**
+     *  @brief  Get the calo hit pseudo layers
+     *
+     *  @return the pseudo layers
+     */
+    const UIntVector &GetPseudoLayer() const;
+
+    /**
+     *  @brief  Get the calo hit types
+     *
+     *  @return the hit types
+     */
+    const HitTypeVector &GetHitType() const;
+
+private:
+    /**
+     *  @brief  Refill the snapshot using the contents of a calo hit list
+     *
+     *  @param  caloHitList the calo hit list
+     */
+    void Fill(const CaloHitList &caloHitList);
+
+    /**
+     *  @brief  Clear the snapshot
+     */
+    void Clear();
+
+    CaloHitVector       m_caloHitVector;            ///< The calo hit addresses
+    FloatVector         m_x;                        ///< The calo hit position x coordinates
+    FloatVector         m_y;                        ///< The calo hit position y coordinates
+    FloatVector         m_z;                        ///< The calo hit position z coordinates
+    FloatVector         m_inputEnergy;              ///< The calo hit input energies
+    FloatVector         m_electromagneticEnergy;    ///< The calo hit electromagnetic energies
+    FloatVector         m_hadronicEnergy;           ///< The calo hit hadronic energies
+    UIntVector          m_pseudoLayer;              ///< The calo hit pseudo layers
+    HitTypeVector       m_hitType;                  ///< The calo hit types
+
+    friend class CaloHitManager;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int CaloHitSnapshot::size() const
+{
+    return m_caloHitVector.size();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool CaloHitSnapshot::empty() const
+{
+    return m_caloHitVector.empty();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const CaloHitVector &CaloHitSnapshot::GetCaloHitVector() const
+{
+    return m_caloHitVector;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const FloatVector &CaloHitSnapshot::GetX() const
+{
+    return m_x;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const FloatVector &CaloHitSnapshot::GetY() const
+{
+    return m_y;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const FloatVector &CaloHitSnapshot::GetZ() const
+{
+    return m_z;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const FloatVector &CaloHitSnapshot::GetInputEnergy() const
+{
+    return m_inputEnergy;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const FloatVector &CaloHitSnapshot::GetElectromagneticEnergy() const
+{
+    return m_electromagneticEnergy;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const FloatVector &CaloHitSnapshot::GetHadronicEnergy() const
+{
+    return m_hadronicEnergy;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const UIntVector &CaloHitSnapshot::GetPseudoLayer() const
+{
+    return m_pseudoLayer;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const CaloHitSnapshot::HitTypeVector &CaloHitSnapshot::GetHitType() const
+{
+    return m_hitType;
+}
+
+} // namespace pandora
+
+#endif // #ifndef PANDORA_CALO_HIT_SNAPSHOT_H
@@ -0,0 +1,221 @@
+/**
+ *  @file   PandoraSDK/include/Objects/CaloHitTimeIndex.h
+ *
+ *  @brief  Header file for the calo hit time index and calo hit span classes.
+ *
+ *  $Log: $
+ */
+#ifndef PANDORA_CALO_HIT_TIME_INDEX_H
+#define PANDORA_CALO_HIT_TIME_INDEX_H 1
+
+#include "Pandora/PandoraInternal.h"
+#include "Pandora/StatusCodes.h"
+
+namespace pandora
+{
+
+/**
+ *  @brief  CaloHitSpan class, a read-only view of a contiguous range of calo hits within a calo hit time index. The span remains
+ *          valid only as long as the index from which it was obtained.
+ */
+class CaloHitSpan
+{
+public:
+    typedef CaloHitVector::const_iterator const_iterator;
+
+    /**
+     *  @brief  Default constructor, creating an empty span
+     */
+    CaloHitSpan();
+
+    /**
+     *  @brief  Constructor
+     *
+     *  @param  beginIter iterator to the first calo hit in the span
+     *  @param  endIter iterator one beyond the last calo hit in the span
+     */
+    CaloHitSpan(const const_iterator beginIter, const const_iterator endIter);
+
+    /**
+     *  @brief  Get an iterator to the first calo hit in the span
+     *
+     *  @return the iterator
+     */
+    const_iterator begin() const;
+
+    /**
+     *  @brief  Get an iterator one beyond the last calo hit in the span
+     *
+     *  @return the iterator
+     */
+    const_iterator end() const;
+
+    /**
+     *  @brief  Get the number of calo hits in the span
+     *
+     *  @return the number of calo hits
+     */
+    unsigned int size() const;
+
+    /**
+     *  @brief  Whether the span is empty
+     *
+     *  @return boolean
+     */
+    bool empty() const;
+
+private:
+    const_iterator      m_begin;                    ///< Iterator to the first calo hit in the span
+    const_iterator      m_end;                      ///< Iterator one beyond the last calo hit in the span
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  CaloHitTimeIndex class, a read-only copy of the addresses of a list of calo hits, sorted by time. Calo hits with equal times
+ *          retain their relative order in the original list. Entry i in the time vector describes calo hit i in the calo hit vector.
+ */
+class CaloHitTimeIndex
+{
+public:
+    /**
+     *  @brief  Default constructor
+     */
+    CaloHitTimeIndex();
+
+    /**
+     *  @brief  Get the number of calo hits in the index
+     *
+     *  @return the number of calo hits
+     */
+    unsigned int size() const;
+
+    /**
+     *  @brief  Whether the index is empty
+     *
+     *  @return boolean
+     */
+    bool empty() const;
+
+    /**
+     *  @brief  Get the calo hit vector, sorted by time
+     *
+     *  @return the calo hit vector
+     */
+    const CaloHitVector &GetCaloHitVector() const;
+
+    /**
+     *  @brief  Get the calo hit times, sorted in ascending order, units ns
+     *
+     *  @return the calo hit times
+     */
+    const FloatVector &GetTime() const;
+
+    /**
+     *  @brief  Get the span of calo hits with times in the half-open window [minTime, maxTime), using a binary search
+     *
+     *  @param  minTime the minimum calo hit time, units ns
+     *  @param  maxTime the maximum calo hit time, exclusive, units ns
+     *
+     *  @return the span of calo hits, sorted by time
+     */
+    CaloHitSpan GetSpan(const float minTime, const float maxTime) const;
+
+private:
+    typedef std::pair<float, unsigned int> TimeAndPosition;
+    typedef std::vector<TimeAndPosition> TimeAndPositionVector;
+
+    /**
+     *  @brief  Refill the index using the contents of a calo hit list
+     *
+     *  @param  caloHitList the calo hit list
+     */
+    void Fill(const CaloHitList &caloHitList);
+
+    /**
+     *  @brief  Clear the index
+     */
+    void Clear();
+
+    CaloHitVector       m_caloHitVector;            ///< The calo hit addresses, sorted by time
+    FloatVector         m_time;                     ///< The calo hit times, sorted in ascending order
+
+    friend class CaloHitManager;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline CaloHitSpan::CaloHitSpan() :
+    m_begin(),
+    m_end()
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline CaloHitSpan::CaloHitSpan(const const_iterator beginIter, const const_iterator endIter) :
+    m_begin(beginIter),
+    m_end(endIter)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline CaloHitSpan::const_iterator CaloHitSpan::begin() const
+{
+    return m_begin;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline CaloHitSpan::const_iterator CaloHitSpan::end() const
+{
+    return m_end;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int CaloHitSpan::size() const
+{
+    return static_cast<unsigned int>(m_end - m_begin);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool CaloHitSpan::empty() const
+{
+    return (m_begin == m_end);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int CaloHitTimeIndex::size() const
+{
+    return m_caloHitVector.size();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool CaloHitTimeIndex::empty() const
+{
+    return m_caloHitVector.empty();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const CaloHitVector &CaloHitTimeIndex::GetCaloHitVector() const
+{
+    return m_caloHitVector;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const FloatVector &CaloHitTimeIndex::GetTime() const
+{
+    return m_time;
+}
+
+} // namespace pandora
+
+#endif // #ifndef PANDORA_CALO_HIT_TIME_INDEX_H
@@ -11,6 +11,7 @@
 #include "Helpers/ClusterFitHelper.h"
 
 #include "Objects/OrderedCaloHitList.h"
+#include "Objects/ParticleIdCache.h"
 
 #include "Pandora/ObjectCreation.h"
 #include "Pandora/StatusCodes.h"
@@ -20,6 +21,7 @@ namespace pandora
 
 class Pandora;
 template<typename T> class AlgorithmObjectManager;
+template<typename T> class Manager;
 template<typename T, typename S> class PandoraObjectFactory;
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -128,6 +130,15 @@ public:
      */
     const Track *GetTrackSeed() const;
 
+    /**
+     *  @brief  Get the address of the track with which the cluster is seeded, without throwing if the cluster is not track seeded
+     * 
+     *  @param  pTrackSeed to receive the address of the track seed
+     * 
+     *  @return STATUS_CODE_SUCCESS, or STATUS_CODE_NOT_INITIALIZED if the cluster is not track seeded
+     */
+    StatusCode GetTrackSeed(const Track *&pTrackSeed) const;
+
     /**
      *  @brief  Get the innermost pseudo layer in the cluster
      * 
@@ -151,6 +162,16 @@ public:
      */
     const CartesianVector GetCentroid(const unsigned int pseudoLayer) const;
 
+    /**
+     *  @brief  Get unweighted centroid for cluster at a particular pseudo layer, without throwing if there are no hits in the layer
+     * 
+     *  @param  pseudoLayer the pseudo layer of interest
+     *  @param  centroid to receive the unweighted centroid
+     * 
+     *  @return STATUS_CODE_SUCCESS, or STATUS_CODE_FAILURE if the cluster has no hits in the pseudo layer
+     */
+    StatusCode GetCentroid(const unsigned int pseudoLayer, CartesianVector &centroid) const;
+
     /**
      *  @brief  Get the initial direction of the cluster
      * 
@@ -193,6 +214,37 @@ public:
      */
     bool IsAvailable() const;
 
+    /**
+     *  @brief  Get the modification epoch, a counter incremented by any change to the cluster calo hits, metadata or track associations
+     * 
+     *  @return the modification epoch
+     */
+    unsigned int GetModificationEpoch() const;
+
+    /**
+     *  @brief  Get the id of the event, within a batch of events, to which the cluster belongs. All calo hits and associated tracks
+     *          must share this event id.
+     * 
+     *  @return the event id
+     */
+    unsigned int GetEventId() const;
+
+    /**
+     *  @brief  Get the dense per-event cluster index, assigned by the cluster manager at creation, for use in vector side tables.
+     *          The indices of deleted clusters are reused by clusters created later in the event.
+     *
+     *  @return the cluster index
+     */
+    unsigned int GetIndex() const;
+
+    /**
+     *  @brief  Get the generation of the cluster index, advanced whenever the index is released or the event is reset, so that the
+     *          cluster may be distinguished from any earlier holder of the same index
+     *
+     *  @return the index generation
+     */
+    unsigned int GetIndexGeneration() const;
+
     /**
      *  @brief  Get the corrected electromagnetic estimate of the cluster energy, units GeV
      * 
@@ -266,6 +318,23 @@ public:
      */
     void GetClusterSpanX(float &xmin, float &xmax) const;
 
+    /**
+     *  @brief  Get the axis-aligned bounding box of the calo hits in this cluster (isolated hits are not included)
+     *
+     *  @param  minimum to receive the minimum x, y and z positions
+     *  @param  maximum to receive the maximum x, y and z positions
+     */
+    void GetClusterBoundingBox(CartesianVector &minimum, CartesianVector &maximum) const;
+
+    /**
+     *  @brief  Get the linear fit moment sums for the calo hits in a specified pseudo layer
+     *
+     *  @param  pseudoLayer the pseudo layer
+     *
+     *  @return the cluster fit accumulator for the pseudo layer
+     */
+    const ClusterFitAccumulator &GetFitAccumulator(const unsigned int pseudoLayer) const;
+
     /**
      *  @brief  Get upper and lower Z positions of the calo hits in a cluster in range xmin to xmax
      *
@@ -276,6 +345,37 @@ public:
      */
     void GetClusterSpanZ(const float xmin, const float xmax, float &zmin, float &zmax) const;
 
+    /**
+     *  @brief  Calculate upper and lower Z positions of the calo hits in a cluster in range xmin to xmax, without throwing if there
+     *          are no calo hits in the range
+     *
+     *  @param  xmin for range in x
+     *  @param  xmax for range in x
+     *  @param  zmin the lower z for this range of x
+     *  @param  zmax the upper z for this range in x
+     *
+     *  @return STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND if there are no calo hits in the range, or STATUS_CODE_INVALID_PARAMETER
+     *          if xmin exceeds xmax
+     */
+    StatusCode CalculateClusterSpanZ(const float xmin, const float xmax, float &zmin, float &zmax) const;
+
+#ifdef PANDORA_POOLED_OBJECT_ALLOCATION
+    /**
+     *  @brief  Class-specific allocation, using the cluster object pool
+     * 
+     *  @param  size the number of bytes requested
+     */
+    static void *operator new(std::size_t size);
+
+    /**
+     *  @brief  Class-specific deallocation, using the cluster object pool
+     * 
+     *  @param  pAddress the address of the memory to release
+     *  @param  size the number of bytes originally requested
+     */
+    static void operator delete(void *pAddress, std::size_t size);
+#endif
+
 protected:
     /**
      *  @brief  Constructor
@@ -303,6 +403,14 @@ protected:
      */
     StatusCode AddCaloHit(const CaloHit *const pCaloHit);
 
+    /**
+     *  @brief  Add a list of calo hits to the cluster, invalidating the outdated cluster properties only once for the whole list.
+     *          Results are identical to those of adding each calo hit in turn, in list order.
+     * 
+     *  @param  caloHitList the list of calo hits
+     */
+    StatusCode AddCaloHits(const CaloHitList &caloHitList);
+
     /**
      *  @brief  Remove a calo hit from the cluster
      * 
@@ -338,9 +446,10 @@ protected:
      *  @brief  Update typical hit type for specified layer
      * 
      *  @param  pseudoLayer the pseudo layer
+     *  @param  cachedProperty the cached property flag to set once the typical layer hit type has been identified
      *  @param  layerHitType to receive the typical layer hit type
      */
-    void UpdateLayerHitTypeCache(const unsigned int pseudoLayer, InputHitType &layerHitType) const;
+    void UpdateLayerHitTypeCache(const unsigned int pseudoLayer, const unsigned int cachedProperty, HitType &layerHitType) const;
 
     /**
      *  @brief  Update cluster corrected energy values
@@ -349,6 +458,22 @@ protected:
      */
     void UpdateEnergyCorrectionsCache(const Pandora &pandora) const;
 
+    /**
+     *  @brief  Whether the cluster corrected energy values are up to date, having been calculated since the cluster contents last changed
+     * 
+     *  @return boolean
+     */
+    bool IsEnergyCorrectionsCacheUpToDate() const;
+
+    /**
+     *  @brief  Set the cluster corrected energy values
+     * 
+     *  @param  pandora the associated pandora instance
+     *  @param  correctedElectromagneticEnergy the corrected electromagnetic energy
+     *  @param  correctedHadronicEnergy the corrected hadronic energy
+     */
+    void SetEnergyCorrectionsCache(const Pandora &pandora, const float correctedElectromagneticEnergy, const float correctedHadronicEnergy) const;
+
     /**
      *  @brief  Update photon if flag
      * 
@@ -370,11 +495,23 @@ protected:
      */
     void UpdateShowerProfileCache(const Pandora &pandora) const;
 
+    /**
+     *  @brief  Update the axis-aligned bounding box of the calo hits in the cluster, using the per pseudo layer hit position extents
+     */
+    void UpdateBoundingBoxCache() const;
+
     /**
      *  @brief  Reset all cluster properties
      */
     StatusCode ResetProperties();
 
+    /**
+     *  @brief  Update the cluster properties to account for a calo hit just added to the ordered calo hit list
+     * 
+     *  @param  pCaloHit the address of the calo hit
+     */
+    void AddCaloHitProperties(const CaloHit *const pCaloHit);
+
     /**
      *  @brief  Reset those cluster properties that must be recalculated upon addition/removal of a calo hit
      */
@@ -387,6 +524,21 @@ protected:
      */
     StatusCode AddHitsFromSecondCluster(const Cluster *const pCluster);
 
+    /**
+     *  @brief  Add the calo hits from a second cluster to this, transferring rather than copying the calo hit storage of the second
+     *          cluster where possible. The second cluster is left without calo hits, so must be deleted immediately afterwards.
+     * 
+     *  @param  pCluster the address of the second cluster
+     */
+    StatusCode TransferHitsFromSecondCluster(Cluster *const pCluster);
+
+    /**
+     *  @brief  Update the cluster properties to account for the calo hits of a second cluster, just added to the calo hit lists
+     * 
+     *  @param  pCluster the address of the second cluster
+     */
+    void AddPropertiesFromSecondCluster(const Cluster *const pCluster);
+
     /**
      *  @brief  Add an association between the cluster and a track
      * 
@@ -419,13 +571,78 @@ protected:
     class SimplePoint
     {
     public:
+        /**
+         *  @brief  Extend the hit position extent to include a specified position
+         * 
+         *  @param  x the x position
+         *  @param  y the y position
+         *  @param  z the z position
+         */
+        void ExtendExtent(const float x, const float y, const float z) const;
+
+        /**
+         *  @brief  Whether a specified position lies strictly inside the hit position extent, i.e. would not define its boundary
+         * 
+         *  @param  x the x position
+         *  @param  y the y position
+         *  @param  z the z position
+         * 
+         *  @return boolean
+         */
+        bool IsInsideExtent(const float x, const float y, const float z) const;
+
+        /**
+         *  @brief  Recalculate the hit position extent from the calo hits in the pseudo layer
+         * 
+         *  @param  caloHitList the calo hits in the pseudo layer
+         */
+        void UpdateExtent(const CaloHitList &caloHitList) const;
+
         double                  m_xyzPositionSums[3];           ///< The sum of the x, y and z hit positions in the pseudo layer
         unsigned int            m_nHits;                        ///< The number of hits in the pseudo layer
+        mutable float           m_xyzMin[3];                    ///< The minimum x, y and z hit positions in the pseudo layer
+        mutable float           m_xyzMax[3];                    ///< The maximum x, y and z hit positions in the pseudo layer
+        mutable bool            m_isExtentUpToDate;             ///< Whether the hit position extent of the pseudo layer is up to date
+        ClusterFitAccumulator   m_fitAccumulator;               ///< The linear fit moment sums for the hits in the pseudo layer
     };
 
-    typedef std::map<unsigned int, SimplePoint> PointByPseudoLayerMap;///< The point by pseudo layer typedef
+    /**
+     *  @brief  Get the simple point for a specified pseudo layer, extending the dense array of simple points as required
+     * 
+     *  @param  pseudoLayer the pseudo layer
+     * 
+     *  @return the simple point, with no hits if the pseudo layer was not previously populated
+     */
+    SimplePoint &GetModifiablePoint(const unsigned int pseudoLayer);
+
+    /**
+     *  @brief  Get the simple point for a specified pseudo layer
+     * 
+     *  @param  pseudoLayer the pseudo layer
+     * 
+     *  @return address of the simple point, nullptr if the pseudo layer contains no hits
+     */
+    const SimplePoint *GetPoint(const unsigned int pseudoLayer) const;
+
+    typedef std::vector<SimplePoint> SimplePointVector;         ///< The simple point vector typedef
     typedef std::map<HitType, float> HitTypeToEnergyMap;        ///< The hit type to energy map typedef
 
+    /**
+     *  @brief  The lazily calculated cluster properties, each represented by a bit in the cached property mask
+     */
+    enum CachedProperty : unsigned int
+    {
+        CACHED_INITIAL_DIRECTION = 1u << 0,
+        CACHED_FIT_TO_ALL_HITS = 1u << 1,
+        CACHED_BOUNDING_BOX = 1u << 2,
+        CACHED_ENERGY_CORRECTIONS = 1u << 3,
+        CACHED_PHOTON_ID = 1u << 4,
+        CACHED_SHOWER_START_LAYER = 1u << 5,
+        CACHED_SHOWER_PROFILE = 1u << 6,
+        CACHED_INNER_LAYER_HIT_TYPE = 1u << 7,
+        CACHED_OUTER_LAYER_HIT_TYPE = 1u << 8
+    };
+
     OrderedCaloHitList          m_orderedCaloHitList;           ///< The ordered calo hit list
     CaloHitList                 m_isolatedCaloHitList;          ///< The list of isolated hits, which contribute only towards cluster energy
     unsigned int                m_nCaloHits;                    ///< The number of calo hits
@@ -437,30 +654,38 @@ protected:
     double                      m_isolatedHadronicEnergy;       ///< Sum of hadronic energy measures of isolated calo hits, units GeV
     int                         m_particleId;                   ///< The particle id flag
     const Track                *m_pTrackSeed;                   ///< Address of the track with which the cluster is seeded
-    PointByPseudoLayerMap       m_sumXYZByPseudoLayer;          ///< Construct to allow rapid calculation of centroid in each pseudolayer
+    SimplePointVector           m_sumXYZByPseudoLayer;          ///< Dense per pseudo layer sums, indexed from m_firstPointPseudoLayer
+    unsigned int                m_firstPointPseudoLayer;        ///< The pseudo layer corresponding to the first entry in m_sumXYZByPseudoLayer
     InputUInt                   m_innerPseudoLayer;             ///< The innermost pseudo layer in the cluster
     InputUInt                   m_outerPseudoLayer;             ///< The outermost pseudo layer in the cluster
 
+    mutable unsigned int        m_cachedProperties;             ///< The mask of cached property flags, set for each cached value that is up to date
     mutable CartesianVector     m_initialDirection;             ///< The initial direction of the cluster
-    mutable bool                m_isDirectionUpToDate;          ///< Whether the initial direction of the cluster is up to date
+    mutable CartesianVector     m_boundingBoxMin;               ///< Cached minimum x, y and z positions of the calo hits in the cluster
+    mutable CartesianVector     m_boundingBoxMax;               ///< Cached maximum x, y and z positions of the calo hits in the cluster
+    mutable float               m_correctedElectromagneticEnergy;///< The corrected electromagnetic estimate of the cluster energy, units GeV
+    mutable float               m_correctedHadronicEnergy;      ///< The corrected hadronic estimate of the cluster energy, units GeV
+    mutable float               m_trackComparisonEnergy;        ///< The appropriate corrected energy to use in comparisons with track momentum, units GeV
+    mutable float               m_showerProfileStart;           ///< The cluster shower profile start, units radiation lengths
+    mutable float               m_showerProfileDiscrepancy;     ///< The cluster shower profile discrepancy
+    mutable unsigned int        m_showerStartLayer;             ///< The pseudo layer at which shower commences
+    mutable HitType             m_innerLayerHitType;            ///< The typical inner layer hit type
+    mutable HitType             m_outerLayerHitType;            ///< The typical outer layer hit type
+    mutable bool                m_passPhotonId;                 ///< Whether the cluster passes the photon id
     mutable ClusterFitResult    m_fitToAllHitsResult;           ///< The result of a linear fit to all calo hits in the cluster
-    mutable bool                m_isFitUpToDate;                ///< Whether the fit to all calo hits is up to date
-    mutable InputFloat          m_correctedElectromagneticEnergy;///< The corrected electromagnetic estimate of the cluster energy, units GeV
-    mutable InputFloat          m_correctedHadronicEnergy;      ///< The corrected hadronic estimate of the cluster energy, units GeV
-    mutable InputFloat          m_trackComparisonEnergy;        ///< The appropriate corrected energy to use in comparisons with track momentum, units GeV
-    mutable InputBool           m_passPhotonId;                 ///< Whether the cluster passes the photon id
-    mutable InputUInt           m_showerStartLayer;             ///< The pseudo layer at which shower commences
-    mutable InputFloat          m_showerProfileStart;           ///< The cluster shower profile start, units radiation lengths
-    mutable InputFloat          m_showerProfileDiscrepancy;     ///< The cluster shower profile discrepancy
-    mutable InputHitType        m_innerLayerHitType;            ///< The typical inner layer hit type
-    mutable InputHitType        m_outerLayerHitType;            ///< The typical outer layer hit type
-    mutable InputFloat          m_xMin;                         ///< Cached cluster minimum in x
-    mutable InputFloat          m_xMax;                         ///< Cached cluster maximum in x
 
     TrackList                   m_associatedTrackList;          ///< The list of tracks associated with the cluster
     bool                        m_isAvailable;                  ///< Whether the cluster is available to be added to a particle flow object
+    unsigned int                m_modificationEpoch;            ///< The modification epoch, incremented by any change to the cluster
+    unsigned int                m_eventId;                      ///< The id of the event, within a batch of events, to which the cluster belongs
+    unsigned int                m_index;                        ///< The dense per-event cluster index, assigned by the cluster manager
+    unsigned int                m_indexGeneration;              ///< The generation of the cluster index, as assigned
+    mutable ParticleIdCache     m_particleIdCache;              ///< The particle id plugin results, labelled by modification epoch
 
     friend class ClusterManager;
+    friend class EnergyCorrections;
+    friend class ParticleId;
+    friend class Manager<Cluster>;
     friend class AlgorithmObjectManager<Cluster>;
     friend class PandoraObjectFactory<object_creation::Cluster::Parameters, object_creation::Cluster::Object>;
 };
@@ -586,11 +811,50 @@ inline bool Cluster::IsAvailable() const
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+inline unsigned int Cluster::GetModificationEpoch() const
+{
+    return m_modificationEpoch;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int Cluster::GetIndex() const
+{
+    return m_index;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int Cluster::GetIndexGeneration() const
+{
+    return m_indexGeneration;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int Cluster::GetEventId() const
+{
+    return m_eventId;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 inline void Cluster::SetAvailability(bool isAvailable)
 {
     m_isAvailable = isAvailable;
 }
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const Cluster::SimplePoint *Cluster::GetPoint(const unsigned int pseudoLayer) const
+{
+    if ((pseudoLayer < m_firstPointPseudoLayer) || (pseudoLayer - m_firstPointPseudoLayer >= m_sumXYZByPseudoLayer.size()))
+        return nullptr;
+
+    const SimplePoint &simplePoint(m_sumXYZByPseudoLayer[pseudoLayer - m_firstPointPseudoLayer]);
+    return ((simplePoint.m_nHits > 0) ? &simplePoint : nullptr);
+}
+
 } // namespace pandora
 
 #endif // #ifndef PANDORA_CLUSTER_H
@@ -0,0 +1,195 @@
+/**
+ *  @file   PandoraSDK/include/Objects/ClusterPairFinder.h
+ *
+ *  @brief  Header file for the cluster pair finder class.
+ *
+ *  $Log: $
+ */
+#ifndef PANDORA_CLUSTER_PAIR_FINDER_H
+#define PANDORA_CLUSTER_PAIR_FINDER_H 1
+
+#include "Pandora/PandoraInternal.h"
+#include "Pandora/StatusCodes.h"
+
+namespace pandora
+{
+
+/**
+ *  @brief  ClusterPairFinder class, a sort-and-sweep index over the bounding boxes of the clusters in a list, generating the candidate
+ *          pairs whose bounding boxes, each extended by a gap, overlap. Boxes are sorted by their minimum along the axis of greatest
+ *          spread, so a sweep need only compare each box with those starting before it ends. Results are identical to those of a
+ *          brute-force loop over the list, in list order. The index is updated in place as clusters are merged, modified or deleted.
+ */
+class ClusterPairFinder
+{
+public:
+    typedef std::pair<const Cluster *, const Cluster *> ClusterPair;
+    typedef std::vector<ClusterPair> ClusterPairVector;
+
+    /**
+     *  @brief  Default constructor
+     */
+    ClusterPairFinder();
+
+    /**
+     *  @brief  Get the number of clusters in the index
+     *
+     *  @return the number of clusters
+     */
+    unsigned int size() const;
+
+    /**
+     *  @brief  Whether the index is empty
+     *
+     *  @return boolean
+     */
+    bool empty() const;
+
+    /**
+     *  @brief  Find all pairs of clusters whose bounding boxes are separated by no more than a specified gap along every axis, ordered
+     *          as by a loop over the list and, for each cluster, a nested loop over the clusters after it in the list
+     *
+     *  @param  maximumGap the maximum gap between bounding boxes, units mm
+     *  @param  clusterPairVector to receive the candidate pairs, the earlier cluster in the list first
+     */
+    StatusCode FindCandidatePairs(const float maximumGap, ClusterPairVector &clusterPairVector) const;
+
+    /**
+     *  @brief  Find all clusters whose bounding boxes are separated from that of a specified cluster by no more than a specified gap
+     *          along every axis, in list order. The specified cluster need not be in the index, but is never among the results.
+     *
+     *  @param  pCluster address of the specified cluster
+     *  @param  maximumGap the maximum gap between bounding boxes, units mm
+     *  @param  clusterVector to receive the addresses of the candidate clusters
+     */
+    StatusCode FindCandidates(const Cluster *const pCluster, const float maximumGap, ClusterVector &clusterVector) const;
+
+private:
+    /**
+     *  @brief  Entry class, describing a cluster and its bounding box
+     */
+    class Entry
+    {
+    public:
+        float                   m_min[3];               ///< The bounding box minimum x, y and z coordinates
+        float                   m_max[3];               ///< The bounding box maximum x, y and z coordinates
+        unsigned int            m_listIndex;            ///< The position of the cluster in the source list
+        const Cluster          *m_pCluster;             ///< The address of the cluster
+    };
+
+    typedef std::vector<Entry> EntryVector;
+
+    /**
+     *  @brief  SweepLessThan class, ordering entries by bounding box minimum along the sweep axis, then by list index
+     */
+    class SweepLessThan
+    {
+    public:
+        /**
+         *  @brief  Constructor
+         *
+         *  @param  axis the coordinate index of the sweep axis
+         */
+        SweepLessThan(const unsigned int axis);
+
+        /**
+         *  @brief  Compare two entries
+         *
+         *  @param  lhs the first entry
+         *  @param  rhs the second entry
+         *
+         *  @return boolean
+         */
+        bool operator()(const Entry &lhs, const Entry &rhs) const;
+
+    private:
+        unsigned int            m_axis;                 ///< The coordinate index of the sweep axis
+    };
+
+    /**
+     *  @brief  Refill the index using the contents of a cluster list; clusters without calo hits are omitted
+     *
+     *  @param  clusterList the cluster list
+     */
+    void Fill(const ClusterList &clusterList);
+
+    /**
+     *  @brief  Clear the index
+     */
+    void Clear();
+
+    /**
+     *  @brief  Refresh the bounding box of a cluster after its calo hits have changed, moving it to its new place in the sweep order.
+     *          Clusters not in the index are ignored, and clusters left without calo hits are removed.
+     *
+     *  @param  pCluster address of the cluster
+     */
+    void Update(const Cluster *const pCluster);
+
+    /**
+     *  @brief  Remove a cluster from the index, e.g. before it is deleted or detached. Clusters not in the index are ignored.
+     *
+     *  @param  pCluster address of the cluster
+     */
+    void Remove(const Cluster *const pCluster);
+
+    /**
+     *  @brief  Find the entry describing a cluster
+     *
+     *  @param  pCluster address of the cluster
+     *
+     *  @return iterator to the entry, or the past-the-end iterator if the cluster is not in the index
+     */
+    EntryVector::iterator FindEntry(const Cluster *const pCluster);
+
+    /**
+     *  @brief  Insert an entry at its place in the sweep order
+     *
+     *  @param  entry the entry
+     */
+    void Insert(const Entry &entry);
+
+    /**
+     *  @brief  Fill the bounding box of an entry from a cluster
+     *
+     *  @param  pCluster address of the cluster
+     *  @param  entry to receive the bounding box
+     *
+     *  @return whether the cluster has calo hits, and so a bounding box
+     */
+    static bool GetBoundingBox(const Cluster *const pCluster, Entry &entry);
+
+    /**
+     *  @brief  Whether the bounding boxes of two entries are separated by no more than a specified gap along every axis
+     *
+     *  @param  lhs the first entry
+     *  @param  rhs the second entry
+     *  @param  maximumGap the maximum gap
+     *
+     *  @return boolean
+     */
+    static bool Overlaps(const Entry &lhs, const Entry &rhs, const float maximumGap);
+
+    EntryVector                 m_entryVector;          ///< The entries, sorted by bounding box minimum along the sweep axis
+    unsigned int                m_sweepAxis;            ///< The coordinate index of the sweep axis
+
+    friend class ClusterManager;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int ClusterPairFinder::size() const
+{
+    return m_entryVector.size();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool ClusterPairFinder::empty() const
+{
+    return m_entryVector.empty();
+}
+
+} // namespace pandora
+
+#endif // #ifndef PANDORA_CLUSTER_PAIR_FINDER_H
@@ -0,0 +1,367 @@
+/**
+ *  @file   PandoraSDK/include/Objects/ClusterSnapshot.h
+ *
+ *  @brief  Header file for the cluster snapshot class.
+ *
+ *  $Log: $
+ */
+#ifndef PANDORA_CLUSTER_SNAPSHOT_H
+#define PANDORA_CLUSTER_SNAPSHOT_H 1
+
+#include "Helpers/ClusterFitHelper.h"
+
+#include "Pandora/PandoraEnumeratedTypes.h"
+#include "Pandora/PandoraInternal.h"
+#include "Pandora/StatusCodes.h"
+
+#include <unordered_map>
+
+namespace pandora
+{
+
+class Pandora;
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  ClusterProperties class, an immutable copy of the lazily-calculated properties of a single cluster
+ */
+class ClusterProperties
+{
+public:
+    /**
+     *  @brief  Constructor, calculating (if required) and copying the properties of a cluster
+     *
+     *  @param  pandora the associated pandora instance
+     *  @param  pCluster address of the cluster
+     */
+    ClusterProperties(const Pandora &pandora, const Cluster *const pCluster);
+
+    /**
+     *  @brief  Get the address of the cluster
+     *
+     *  @return the address of the cluster
+     */
+    const Cluster *GetCluster() const;
+
+    /**
+     *  @brief  Get the initial direction of the cluster
+     *
+     *  @return the initial direction of the cluster
+     */
+    const CartesianVector &GetInitialDirection() const;
+
+    /**
+     *  @brief  Get the result of a linear fit to all calo hits in the cluster
+     *
+     *  @return the cluster fit result
+     */
+    const ClusterFitResult &GetFitToAllHitsResult() const;
+
+    /**
+     *  @brief  Get the corrected electromagnetic estimate of the cluster energy, units GeV
+     *
+     *  @return the corrected electromagnetic energy
+     */
+    float GetCorrectedElectromagneticEnergy() const;
+
+    /**
+     *  @brief  Get the corrected hadronic estimate of the cluster energy, units GeV
+     *
+     *  @return the corrected hadronic energy
+     */
+    float GetCorrectedHadronicEnergy() const;
+
+    /**
+     *  @brief  Get the best energy estimate to use when comparing cluster energy to associated track momentum, units GeV
+     *
+     *  @return the track comparison energy
+     */
+    float GetTrackComparisonEnergy() const;
+
+    /**
+     *  @brief  Whether the cluster passes the photon id
+     *
+     *  @return boolean
+     */
+    bool PassPhotonId() const;
+
+    /**
+     *  @brief  Get the pseudo layer at which shower commences
+     *
+     *  @return the shower start layer
+     */
+    unsigned int GetShowerStartLayer() const;
+
+    /**
+     *  @brief  Get the cluster shower profile start, units radiation lengths
+     *
+     *  @return the shower profile start
+     */
+    float GetShowerProfileStart() const;
+
+    /**
+     *  @brief  Get the cluster shower profile discrepancy
+     *
+     *  @return the shower profile discrepancy
+     */
+    float GetShowerProfileDiscrepancy() const;
+
+    /**
+     *  @brief  Get the typical inner layer hit type
+     *
+     *  @return the inner layer hit type
+     */
+    HitType GetInnerLayerHitType() const;
+
+    /**
+     *  @brief  Get the typical outer layer hit type
+     *
+     *  @return the outer layer hit type
+     */
+    HitType GetOuterLayerHitType() const;
+
+    /**
+     *  @brief  Get the minimum x, y and z positions of the calo hits in the cluster
+     *
+     *  @return the minimum positions
+     */
+    const CartesianVector &GetBoundingBoxMin() const;
+
+    /**
+     *  @brief  Get the maximum x, y and z positions of the calo hits in the cluster
+     *
+     *  @return the maximum positions
+     */
+    const CartesianVector &GetBoundingBoxMax() const;
+
+private:
+    /**
+     *  @brief  Check that a property was available when the snapshot was made
+     *
+     *  @param  isAvailable whether the property is available
+     */
+    static void CheckAvailable(const bool isAvailable);
+
+    const Cluster          *m_pCluster;                         ///< The address of the cluster
+    CartesianVector         m_initialDirection;                 ///< The initial direction of the cluster
+    ClusterFitResult        m_fitToAllHitsResult;               ///< The result of a linear fit to all calo hits in the cluster
+    float                   m_correctedElectromagneticEnergy;   ///< The corrected electromagnetic estimate of the cluster energy, units GeV
+    float                   m_correctedHadronicEnergy;          ///< The corrected hadronic estimate of the cluster energy, units GeV
+    float                   m_trackComparisonEnergy;            ///< The appropriate corrected energy to use in comparisons with track momentum
+    bool                    m_passPhotonId;                     ///< Whether the cluster passes the photon id
+    unsigned int            m_showerStartLayer;                 ///< The pseudo layer at which shower commences
+    float                   m_showerProfileStart;               ///< The cluster shower profile start, units radiation lengths
+    float                   m_showerProfileDiscrepancy;         ///< The cluster shower profile discrepancy
+    HitType                 m_innerLayerHitType;                ///< The typical inner layer hit type
+    HitType                 m_outerLayerHitType;                ///< The typical outer layer hit type
+    CartesianVector         m_boundingBoxMin;                   ///< The minimum x, y and z positions of the calo hits in the cluster
+    CartesianVector         m_boundingBoxMax;                   ///< The maximum x, y and z positions of the calo hits in the cluster
+
+    bool                    m_isInitialDirectionAvailable;      ///< Whether the initial direction is available
+    bool                    m_areEnergyCorrectionsAvailable;    ///< Whether the corrected energies are available
+    bool                    m_isPhotonIdAvailable;              ///< Whether the photon id is available
+    bool                    m_isShowerStartLayerAvailable;      ///< Whether the shower start layer is available
+    bool                    m_isShowerProfileAvailable;         ///< Whether the shower profile properties are available
+    bool                    m_areLayerHitTypesAvailable;        ///< Whether the inner and outer layer hit types are available
+};
+
+typedef std::vector<ClusterProperties> ClusterPropertiesVector;
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  ClusterSnapshot class, a frozen copy of the lazily-calculated properties of every cluster in a list. Cluster accessors may
+ *          write to their internal caches, whereas the snapshot is immutable once made, so it can be read safely by many threads at once.
+ *          The snapshot does not track later changes to the clusters.
+ */
+class ClusterSnapshot
+{
+public:
+    /**
+     *  @brief  Constructor, calculating (if required) and copying the properties of every cluster in a list
+     *
+     *  @param  pandora the associated pandora instance
+     *  @param  clusterList the cluster list
+     */
+    ClusterSnapshot(const Pandora &pandora, const ClusterList &clusterList);
+
+    /**
+     *  @brief  Get the number of clusters in the snapshot
+     *
+     *  @return the number of clusters
+     */
+    unsigned int size() const;
+
+    /**
+     *  @brief  Whether the snapshot is empty
+     *
+     *  @return boolean
+     */
+    bool empty() const;
+
+    /**
+     *  @brief  Get the cluster properties, in the order of the input cluster list
+     *
+     *  @return the cluster properties vector
+     */
+    const ClusterPropertiesVector &GetClusterPropertiesVector() const;
+
+    /**
+     *  @brief  Get the properties of a specified cluster
+     *
+     *  @param  pCluster address of the cluster
+     *
+     *  @return the cluster properties
+     */
+    const ClusterProperties &GetClusterProperties(const Cluster *const pCluster) const;
+
+private:
+    typedef std::unordered_map<const Cluster *, unsigned int> ClusterToIndexMap;
+
+    ClusterPropertiesVector m_clusterPropertiesVector;          ///< The cluster properties
+    ClusterToIndexMap       m_clusterToIndexMap;                ///< The map from cluster address to index in the properties vector
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const Cluster *ClusterProperties::GetCluster() const
+{
+    return m_pCluster;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const CartesianVector &ClusterProperties::GetInitialDirection() const
+{
+    ClusterProperties::CheckAvailable(m_isInitialDirectionAvailable);
+    return m_initialDirection;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const ClusterFitResult &ClusterProperties::GetFitToAllHitsResult() const
+{
+    return m_fitToAllHitsResult;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline float ClusterProperties::GetCorrectedElectromagneticEnergy() const
+{
+    ClusterProperties::CheckAvailable(m_areEnergyCorrectionsAvailable);
+    return m_correctedElectromagneticEnergy;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline float ClusterProperties::GetCorrectedHadronicEnergy() const
+{
+    ClusterProperties::CheckAvailable(m_areEnergyCorrectionsAvailable);
+    return m_correctedHadronicEnergy;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline float ClusterProperties::GetTrackComparisonEnergy() const
+{
+    ClusterProperties::CheckAvailable(m_areEnergyCorrectionsAvailable);
+    return m_trackComparisonEnergy;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool ClusterProperties::PassPhotonId() const
+{
+    ClusterProperties::CheckAvailable(m_isPhotonIdAvailable);
+    return m_passPhotonId;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int ClusterProperties::GetShowerStartLayer() const
+{
+    ClusterProperties::CheckAvailable(m_isShowerStartLayerAvailable);
+    return m_showerStartLayer;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline float ClusterProperties::GetShowerProfileStart() const
+{
+    ClusterProperties::CheckAvailable(m_isShowerProfileAvailable);
+    return m_showerProfileStart;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline float ClusterProperties::GetShowerProfileDiscrepancy() const
+{
+    ClusterProperties::CheckAvailable(m_isShowerProfileAvailable);
+    return m_showerProfileDiscrepancy;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline HitType ClusterProperties::GetInnerLayerHitType() const
+{
+    ClusterProperties::CheckAvailable(m_areLayerHitTypesAvailable);
+    return m_innerLayerHitType;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline HitType ClusterProperties::GetOuterLayerHitType() const
+{
+    ClusterProperties::CheckAvailable(m_areLayerHitTypesAvailable);
+    return m_outerLayerHitType;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const CartesianVector &ClusterProperties::GetBoundingBoxMin() const
+{
+    return m_boundingBoxMin;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const CartesianVector &ClusterProperties::GetBoundingBoxMax() const
+{
+    return m_boundingBoxMax;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline void ClusterProperties::CheckAvailable(const bool isAvailable)
+{
+    if (!isAvailable)
+        throw StatusCodeException(STATUS_CODE_NOT_INITIALIZED);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int ClusterSnapshot::size() const
+{
+    return m_clusterPropertiesVector.size();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool ClusterSnapshot::empty() const
+{
+    return m_clusterPropertiesVector.empty();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const ClusterPropertiesVector &ClusterSnapshot::GetClusterPropertiesVector() const
+{
+    return m_clusterPropertiesVector;
+}
+
+} // namespace pandora
+
+#endif // #ifndef PANDORA_CLUSTER_SNAPSHOT_H
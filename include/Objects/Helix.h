@@ -10,6 +10,7 @@
 
 #include "Objects/CartesianVector.h"
 
+#include "Pandora/PandoraInternal.h"
 #include "Pandora/StatusCodes.h"
 
 namespace pandora
@@ -135,6 +136,21 @@ public:
      */
     StatusCode GetDistanceToPoint(const CartesianVector &point, CartesianVector &distance, float &genericTime) const;
 
+    /**
+     *  @brief  Get distances of the closest approach of helix to a set of points in space, provided in structure-of-arrays layout (e.g.
+     *          from a calo hit snapshot). Entry i in each output vector matches the result of GetDistanceToPoint for point i.
+     * 
+     *  @param  x the point x coordinates
+     *  @param  y the point y coordinates
+     *  @param  z the point z coordinates
+     *  @param  distanceXY to receive the distances from helix to each point in the R-Phi plane
+     *  @param  distanceZ to receive the distances from helix to each point along the Z axis
+     *  @param  distance3D to receive the 3D distance magnitudes
+     *  @param  genericTime to receive the generic times (helix length, from reference point to intersection, divided by particle momentum)
+     */
+    StatusCode GetDistanceToPoints(const FloatVector &x, const FloatVector &y, const FloatVector &z, FloatVector &distanceXY,
+        FloatVector &distanceZ, FloatVector &distance3D, FloatVector &genericTime) const;
+
     /**
      *  @brief  Get distance between two helices
      * 
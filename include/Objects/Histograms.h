@@ -8,7 +8,11 @@
 #ifndef PANDORA_HISTOGRAMS_H
 #define PANDORA_HISTOGRAMS_H 1
 
+#include "Pandora/PandoraInternal.h"
+
+#include <iosfwd>
 #include <map>
+#include <vector>
 
 namespace pandora
 {
@@ -41,6 +45,13 @@ public:
      */
     Histogram(const TiXmlHandle *const pXmlHandle, const std::string &xmlElementName);
 
+    /**
+     *  @brief  Constructor
+     * 
+     *  @param  binaryStream the stream from which to read the binary image of the histogram, as written by WriteToBinary
+     */
+    Histogram(std::istream &binaryStream);
+
     /**
      *  @brief  Copy constructor
      * 
@@ -217,6 +228,14 @@ public:
      */
     void Fill(const float valueX, const float weight = 1.f);
 
+    /**
+     *  @brief  Add a batch of entries to the histogram
+     * 
+     *  @param  valuesX the values for the entries
+     *  @param  weights the weights associated with the entries, one per value
+     */
+    void Fill(const FloatVector &valuesX, const FloatVector &weights);
+
     /**
      *  @brief  Scale contents of all histogram bins by a specified factor
      * 
@@ -224,6 +243,15 @@ public:
      */
     void Scale(const float scaleFactor);
 
+    /**
+     *  @brief  Set whether to cache prefix sums of the bin contents, answering range sums, means and standard deviations in constant
+     *          time. The cache is rebuilt by the first such query after the contents change, and is only used with dense bin storage.
+     *          Cached results are accumulated in double precision, so may differ in the last bits from those of a bin by bin scan.
+     * 
+     *  @param  shouldCachePrefixSums whether to cache prefix sums
+     */
+    void SetShouldCachePrefixSums(const bool shouldCachePrefixSums);
+
     /**
      *  @brief  Write the histogram to an xml document
      * 
@@ -232,15 +260,83 @@ public:
      */
     void WriteToXml(TiXmlDocument *const pTiXmlDocument, const std::string &xmlElementName) const;
 
+    /**
+     *  @brief  Write a compact binary image of the histogram to a stream, holding the bin contents as raw floats in native byte order
+     * 
+     *  @param  binaryStream the stream to which to write the binary image
+     */
+    void WriteToBinary(std::ostream &binaryStream) const;
+
+    static const unsigned int MAX_DENSE_BINS = 1 << 18; ///< The largest number of bins, including overflow and underflow, stored densely
+
 private:
+    /**
+     *  @brief  Whether a specified bin is held in the dense bin contents
+     * 
+     *  @param  binX the specified bin number
+     * 
+     *  @return boolean
+     */
+    bool IsDenseBin(const int binX) const;
+
+    /**
+     *  @brief  Whether range queries should use the cached prefix sums, which are rebuilt if necessary
+     * 
+     *  @return boolean
+     */
+    bool UsePrefixSums() const;
+
+    /**
+     *  @brief  Get the sums of the bin contents, weighted by powers of the bin center, over a specified range of bins, using the
+     *          cached prefix sums
+     * 
+     *  @param  xLowBin bin at start of specified x range, at least the underflow bin number
+     *  @param  xHighBin bin at end of specified x range, at most the overflow bin number
+     *  @param  sum to receive the sum of bin contents
+     *  @param  sumX to receive the sum of bin contents multiplied by bin center
+     *  @param  sumXX to receive the sum of bin contents multiplied by bin center squared
+     */
+    void GetRangeSums(const int xLowBin, const int xHighBin, double &sum, double &sumX, double &sumXX) const;
+
+    /**
+     *  @brief  Write values to a binary stream
+     * 
+     *  @param  pValues address of the first value
+     *  @param  nValues the number of values
+     *  @param  binaryStream the binary stream
+     */
+    template <typename T>
+    static void WriteBinaryValues(const T *const pValues, const unsigned int nValues, std::ostream &binaryStream);
+
+    /**
+     *  @brief  Read values from a binary stream
+     * 
+     *  @param  binaryStream the binary stream
+     *  @param  pValues address at which to receive the first value
+     *  @param  nValues the number of values
+     */
+    template <typename T>
+    static void ReadBinaryValues(std::istream &binaryStream, T *const pValues, const unsigned int nValues);
+
     typedef std::map<int, float> HistogramMap;
+    typedef std::vector<float> BinContentVector;
+    typedef std::vector<double> PrefixSumVector;
 
-    HistogramMap        m_histogramMap;         ///< The histogram map
+    BinContentVector    m_binContents;          ///< The dense bin contents, from underflow to overflow, if there are few enough bins
+    HistogramMap        m_histogramMap;         ///< The histogram map, holding any bins not held in the dense bin contents
+
+    bool                    m_shouldCachePrefixSums;    ///< Whether to cache prefix sums of the dense bin contents
+    mutable bool            m_arePrefixSumsValid;       ///< Whether the cached prefix sums reflect the current bin contents
+    mutable PrefixSumVector m_prefixSums;               ///< The prefix sums of bin contents
+    mutable PrefixSumVector m_prefixSumsX;              ///< The prefix sums of bin contents multiplied by bin center
+    mutable PrefixSumVector m_prefixSumsXX;             ///< The prefix sums of bin contents multiplied by bin center squared
 
     int                 m_nBinsX;               ///< The number of x bins
     float               m_xLow;                 ///< The min binned x value
     float               m_xHigh;                ///< The max binned x value
     float               m_xBinWidth;            ///< The x bin width
+
+    friend class HistogramFillShards;
 };
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -273,6 +369,13 @@ public:
      */
     TwoDHistogram(const TiXmlHandle *const pXmlHandle, const std::string &xmlElementName);
 
+    /**
+     *  @brief  Constructor
+     * 
+     *  @param  binaryStream the stream from which to read the binary image of the histogram, as written by WriteToBinary
+     */
+    TwoDHistogram(std::istream &binaryStream);
+
     /**
      *  @brief  Copy constructor
      * 
@@ -572,6 +675,15 @@ public:
      */
     void Fill(const float valueX, const float valueY, const float weight = 1.f);
 
+    /**
+     *  @brief  Add a batch of entries to the histogram
+     * 
+     *  @param  valuesX the x values for the entries
+     *  @param  valuesY the y values for the entries, one per x value
+     *  @param  weights the weights associated with the entries, one per x value
+     */
+    void Fill(const FloatVector &valuesX, const FloatVector &valuesY, const FloatVector &weights);
+
     /**
      *  @brief  Scale contents of all histogram bins by a specified factor
      * 
@@ -579,6 +691,15 @@ public:
      */
     void Scale(const float scaleFactor);
 
+    /**
+     *  @brief  Set whether to cache summed-area tables of the bin contents, answering range sums, means and standard deviations in
+     *          constant time. The tables are rebuilt by the first such query after the contents change, and are only used with dense bin
+     *          storage. Cached results are accumulated in double precision, so may differ in the last bits from those of a bin by bin scan.
+     * 
+     *  @param  shouldCachePrefixSums whether to cache summed-area tables
+     */
+    void SetShouldCachePrefixSums(const bool shouldCachePrefixSums);
+
     /**
      *  @brief  Write the histogram to an xml document
      * 
@@ -587,12 +708,113 @@ public:
      */
     void WriteToXml(TiXmlDocument *const pTiXmlDocument, const std::string &xmlElementName) const;
 
+    /**
+     *  @brief  Write a compact binary image of the histogram to a stream, holding the bin contents as raw floats in native byte order
+     * 
+     *  @param  binaryStream the stream to which to write the binary image
+     */
+    void WriteToBinary(std::ostream &binaryStream) const;
+
+    static const unsigned int MAX_DENSE_BINS = 1 << 18; ///< The largest number of bins, including overflow and underflow, stored densely
+
 private:
+    /**
+     *  @brief  Whether a specified bin is held in the dense bin contents
+     * 
+     *  @param  binX the specified x bin number
+     *  @param  binY the specified y bin number
+     * 
+     *  @return boolean
+     */
+    bool IsDenseBin(const int binX, const int binY) const;
+
+    /**
+     *  @brief  Get the index of a specified bin in the dense bin contents
+     * 
+     *  @param  binX the specified x bin number
+     *  @param  binY the specified y bin number
+     * 
+     *  @return the index
+     */
+    unsigned int GetDenseIndex(const int binX, const int binY) const;
+
+    /**
+     *  @brief  Allocate the dense bin contents, if the total number of bins, including overflow and underflow, is small enough
+     */
+    void InitializeBinContents();
+
+    /**
+     *  @brief  Whether range queries should use the cached summed-area tables, which are rebuilt if necessary
+     * 
+     *  @return boolean
+     */
+    bool UsePrefixSums() const;
+
+    /**
+     *  @brief  Get the sums of the bin contents, weighted by powers of the bin centers, over a specified range of bins, using the
+     *          cached summed-area tables
+     * 
+     *  @param  xLowBin bin at start of specified x range, at least the underflow x bin number
+     *  @param  xHighBin bin at end of specified x range, at most the overflow x bin number
+     *  @param  yLowBin bin at start of specified y range, at least the underflow y bin number
+     *  @param  yHighBin bin at end of specified y range, at most the overflow y bin number
+     *  @param  sum to receive the sum of bin contents
+     *  @param  sumX to receive the sum of bin contents multiplied by x bin center
+     *  @param  sumXX to receive the sum of bin contents multiplied by x bin center squared
+     *  @param  sumY to receive the sum of bin contents multiplied by y bin center
+     *  @param  sumYY to receive the sum of bin contents multiplied by y bin center squared
+     */
+    void GetRangeSums(const int xLowBin, const int xHighBin, const int yLowBin, const int yHighBin, double &sum, double &sumX,
+        double &sumXX, double &sumY, double &sumYY) const;
+
+    /**
+     *  @brief  Get the sum of the entries of a summed-area table over a specified range of bins
+     * 
+     *  @param  table the summed-area table
+     *  @param  xLowBin bin at start of specified x range
+     *  @param  xHighBin bin at end of specified x range
+     *  @param  yLowBin bin at start of specified y range
+     *  @param  yHighBin bin at end of specified y range
+     * 
+     *  @return the sum
+     */
+    double GetTableSum(const std::vector<double> &table, const int xLowBin, const int xHighBin, const int yLowBin, const int yHighBin) const;
+
+    /**
+     *  @brief  Write values to a binary stream
+     * 
+     *  @param  pValues address of the first value
+     *  @param  nValues the number of values
+     *  @param  binaryStream the binary stream
+     */
+    template <typename T>
+    static void WriteBinaryValues(const T *const pValues, const unsigned int nValues, std::ostream &binaryStream);
+
+    /**
+     *  @brief  Read values from a binary stream
+     * 
+     *  @param  binaryStream the binary stream
+     *  @param  pValues address at which to receive the first value
+     *  @param  nValues the number of values
+     */
+    template <typename T>
+    static void ReadBinaryValues(std::istream &binaryStream, T *const pValues, const unsigned int nValues);
+
     typedef std::map<int, float> HistogramMap;
     typedef std::map<int, HistogramMap> TwoDHistogramMap;
+    typedef std::vector<float> BinContentVector;
+    typedef std::vector<double> PrefixSumVector;
+
+    BinContentVector    m_binContents;          ///< The dense bin contents, ordered by y then x bin, if there are few enough bins
+    TwoDHistogramMap    m_xyHistogramMap;       ///< The x->y->value 2d histogram map, holding any bins not held in the dense bin contents
 
-    TwoDHistogramMap    m_xyHistogramMap;       ///< The x->y->value 2d histogram map
-    TwoDHistogramMap    m_yxHistogramMap;       ///< The y->x->value 2d histogram map
+    bool                    m_shouldCachePrefixSums;    ///< Whether to cache summed-area tables of the dense bin contents
+    mutable bool            m_arePrefixSumsValid;       ///< Whether the cached summed-area tables reflect the current bin contents
+    mutable PrefixSumVector m_prefixSums;               ///< The summed-area table of bin contents
+    mutable PrefixSumVector m_prefixSumsX;              ///< The summed-area table of bin contents multiplied by x bin center
+    mutable PrefixSumVector m_prefixSumsXX;             ///< The summed-area table of bin contents multiplied by x bin center squared
+    mutable PrefixSumVector m_prefixSumsY;              ///< The summed-area table of bin contents multiplied by y bin center
+    mutable PrefixSumVector m_prefixSumsYY;             ///< The summed-area table of bin contents multiplied by y bin center squared
 
     int                 m_nBinsX;               ///< The number of x bins
     float               m_xLow;                 ///< The min binned x value
@@ -603,6 +825,117 @@ private:
     float               m_yLow;                 ///< The min binned y value
     float               m_yHigh;                ///< The max binned y value
     float               m_yBinWidth;            ///< The y bin width
+
+    friend class TwoDHistogramFillShards;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  HistogramFillShards class, allowing a histogram with dense bin storage to be filled concurrently, without locks, by the
+ *          threads of a parallel loop. Each thread fills its own shard of dense bin contents, selected by its thread index within the
+ *          loop, and the shards are added to the histogram by Merge or on destruction. The histogram should not otherwise be accessed
+ *          whilst being filled, and its contents do not include the shards until they are merged.
+ */
+class HistogramFillShards
+{
+public:
+    /**
+     *  @brief  Constructor
+     *
+     *  @param  histogram the histogram to fill, which must use dense bin storage
+     *  @param  nShards the number of shards, at least the number of threads filling the histogram, e.g. the NThreads setting
+     */
+    HistogramFillShards(Histogram &histogram, const unsigned int nShards);
+
+    /**
+     *  @brief  Destructor, merging any outstanding shards into the histogram
+     */
+    ~HistogramFillShards();
+
+    /**
+     *  @brief  Deleted copy constructor
+     */
+    HistogramFillShards(const HistogramFillShards &) = delete;
+
+    /**
+     *  @brief  Deleted assignment operator
+     */
+    HistogramFillShards &operator=(const HistogramFillShards &) = delete;
+
+    /**
+     *  @brief  Add an entry to the shard of the calling thread, identified by ThreadPool::GetCurrentThreadIndex
+     *
+     *  @param  valueX the x value
+     *  @param  weight the weight
+     */
+    void Fill(const float valueX, const float weight = 1.f);
+
+    /**
+     *  @brief  Add the contents of all shards to the histogram and clear the shards, once the concurrent filling is complete
+     */
+    void Merge();
+
+private:
+    typedef std::vector<FloatVector> ShardVector;
+
+    Histogram              &m_histogram;            ///< The histogram to fill
+    ShardVector             m_shardVector;          ///< The shards, by thread index, each empty until first filled
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  TwoDHistogramFillShards class, allowing a two dimensional histogram with dense bin storage to be filled concurrently, as
+ *          for HistogramFillShards
+ */
+class TwoDHistogramFillShards
+{
+public:
+    /**
+     *  @brief  Constructor
+     *
+     *  @param  twoDHistogram the two dimensional histogram to fill, which must use dense bin storage
+     *  @param  nShards the number of shards, at least the number of threads filling the histogram, e.g. the NThreads setting
+     */
+    TwoDHistogramFillShards(TwoDHistogram &twoDHistogram, const unsigned int nShards);
+
+    /**
+     *  @brief  Destructor, merging any outstanding shards into the histogram
+     */
+    ~TwoDHistogramFillShards();
+
+    /**
+     *  @brief  Deleted copy constructor
+     */
+    TwoDHistogramFillShards(const TwoDHistogramFillShards &) = delete;
+
+    /**
+     *  @brief  Deleted assignment operator
+     */
+    TwoDHistogramFillShards &operator=(const TwoDHistogramFillShards &) = delete;
+
+    /**
+     *  @brief  Add an entry to the shard of the calling thread, identified by ThreadPool::GetCurrentThreadIndex
+     *
+     *  @param  valueX the x value
+     *  @param  valueY the y value
+     *  @param  weight the weight
+     */
+    void Fill(const float valueX, const float valueY, const float weight = 1.f);
+
+    /**
+     *  @brief  Add the contents of all shards to the histogram and clear the shards, once the concurrent filling is complete
+     */
+    void Merge();
+
+private:
+    typedef std::vector<FloatVector> ShardVector;
+
+    TwoDHistogram          &m_twoDHistogram;        ///< The two dimensional histogram to fill
+    ShardVector             m_shardVector;          ///< The shards, by thread index, each empty until first filled
 };
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -690,6 +1023,13 @@ inline float Histogram::GetStandardDeviationX() const
     return this->GetStandardDeviationX(this->GetMinBinNumber(), this->GetMaxBinNumber());
 }
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool Histogram::IsDenseBin(const int binX) const
+{
+    return (!m_binContents.empty() && (binX >= this->GetUnderflowBinNumber()) && (binX <= this->GetOverflowBinNumber()));
+}
+
 //------------------------------------------------------------------------------------------------------------------------------------------
 //------------------------------------------------------------------------------------------------------------------------------------------
 
@@ -843,6 +1183,21 @@ inline float TwoDHistogram::GetStandardDeviationY() const
     return this->GetStandardDeviationY(this->GetMinBinNumberX(), this->GetMaxBinNumberX(), this->GetMinBinNumberY(), this->GetMaxBinNumberY());
 }
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool TwoDHistogram::IsDenseBin(const int binX, const int binY) const
+{
+    return (!m_binContents.empty() && (binX >= this->GetUnderflowBinNumberX()) && (binX <= this->GetOverflowBinNumberX()) &&
+        (binY >= this->GetUnderflowBinNumberY()) && (binY <= this->GetOverflowBinNumberY()));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int TwoDHistogram::GetDenseIndex(const int binX, const int binY) const
+{
+    return (static_cast<unsigned int>(binY + 1) * static_cast<unsigned int>(m_nBinsX + 2) + static_cast<unsigned int>(binX + 1));
+}
+
 } // namespace pandora
 
 #endif // #ifndef PANDORA_HISTOGRAMS_H
@@ -0,0 +1,275 @@
+/**
+ *  @file   PandoraSDK/include/Objects/LArTPCHitGrid.h
+ *
+ *  @brief  Header file for the lar tpc hit grid class.
+ *
+ *  $Log: $
+ */
+#ifndef PANDORA_LAR_TPC_HIT_GRID_H
+#define PANDORA_LAR_TPC_HIT_GRID_H 1
+
+#include "Pandora/PandoraInternal.h"
+#include "Pandora/StatusCodes.h"
+
+namespace pandora
+{
+
+/**
+ *  @brief  LArTPCHitGrid class, a read-only dense occupancy grid over the calo hits of a single lar tpc view. The drift (x) axis is
+ *          divided into bins of fixed width spanning the lar tpc, and the wire (z) axis into bins of one wire pitch, starting at a whole
+ *          number of pitches and spanning the calo hits. Cell (driftBin, wireBin) has cell index driftBin * nWireBins + wireBin, and its
+ *          calo hits, in list order, are those from position offset[cellIndex] to offset[cellIndex + 1] in the calo hit vector. The
+ *          offsets therefore describe the occupancy of every cell, in a layout that may be handed on without re-binning the calo hits.
+ */
+class LArTPCHitGrid
+{
+public:
+    /**
+     *  @brief  Default constructor
+     */
+    LArTPCHitGrid();
+
+    /**
+     *  @brief  Get the address of the lar tpc
+     *
+     *  @return the address of the lar tpc
+     */
+    const LArTPC *GetLArTPC() const;
+
+    /**
+     *  @brief  Get the hit type of the view
+     *
+     *  @return the hit type
+     */
+    HitType GetHitType() const;
+
+    /**
+     *  @brief  Get the number of calo hits in the grid
+     *
+     *  @return the number of calo hits
+     */
+    unsigned int size() const;
+
+    /**
+     *  @brief  Whether the grid is empty
+     *
+     *  @return boolean
+     */
+    bool empty() const;
+
+    /**
+     *  @brief  Get the number of drift bins
+     *
+     *  @return the number of drift bins
+     */
+    unsigned int GetNDriftBins() const;
+
+    /**
+     *  @brief  Get the number of wire bins
+     *
+     *  @return the number of wire bins
+     */
+    unsigned int GetNWireBins() const;
+
+    /**
+     *  @brief  Get the lower edge of the first drift bin, units mm
+     *
+     *  @return the drift coordinate minimum
+     */
+    float GetDriftMin() const;
+
+    /**
+     *  @brief  Get the lower edge of the first wire bin, units mm
+     *
+     *  @return the wire coordinate minimum
+     */
+    float GetWireMin() const;
+
+    /**
+     *  @brief  Get the drift bin width, units mm
+     *
+     *  @return the drift bin width
+     */
+    float GetDriftBinWidth() const;
+
+    /**
+     *  @brief  Get the wire bin width, i.e. the wire pitch, units mm
+     *
+     *  @return the wire bin width
+     */
+    float GetWireBinWidth() const;
+
+    /**
+     *  @brief  Get the cell containing a position
+     *
+     *  @param  positionVector the position vector
+     *  @param  driftBin to receive the drift bin
+     *  @param  wireBin to receive the wire bin
+     *
+     *  @return whether the position lies within the grid
+     */
+    bool GetCell(const CartesianVector &positionVector, unsigned int &driftBin, unsigned int &wireBin) const;
+
+    /**
+     *  @brief  Get the calo hits in a cell
+     *
+     *  @param  driftBin the drift bin
+     *  @param  wireBin the wire bin
+     *  @param  caloHitVector to receive the calo hits, appended in list order
+     */
+    StatusCode GetCellCaloHits(const unsigned int driftBin, const unsigned int wireBin, CaloHitVector &caloHitVector) const;
+
+    /**
+     *  @brief  Get the calo hits in the cells within a specified number of bins of the cell containing a position, clipped to the grid
+     *
+     *  @param  positionVector the position vector
+     *  @param  nDriftBins the number of drift bins either side of the cell
+     *  @param  nWireBins the number of wire bins either side of the cell
+     *  @param  caloHitVector to receive the calo hits, appended cell by cell, in drift bin then wire bin order
+     */
+    StatusCode GetNeighbourhoodCaloHits(const CartesianVector &positionVector, const unsigned int nDriftBins, const unsigned int nWireBins,
+        CaloHitVector &caloHitVector) const;
+
+    /**
+     *  @brief  Get the offsets of the calo hits in each cell within the calo hit vector, with one entry per cell plus a final entry
+     *
+     *  @return the cell offsets
+     */
+    const UIntVector &GetCellOffsets() const;
+
+    /**
+     *  @brief  Get the calo hit vector, ordered by cell index; dense per-event calo hit indices are available via CaloHit::GetIndex
+     *
+     *  @return the calo hit vector
+     */
+    const CaloHitVector &GetCaloHitVector() const;
+
+private:
+    /**
+     *  @brief  Refill the grid using a vector of calo hits from a single lar tpc view
+     *
+     *  @param  pLArTPC address of the lar tpc
+     *  @param  hitType the hit type of the view, TPC_VIEW_U, TPC_VIEW_V or TPC_VIEW_W
+     *  @param  driftBinWidth the drift bin width, units mm
+     *  @param  caloHitVector the calo hits, in list order
+     */
+    StatusCode Fill(const LArTPC *const pLArTPC, const HitType hitType, const float driftBinWidth, const CaloHitVector &caloHitVector);
+
+    /**
+     *  @brief  Clear the grid
+     */
+    void Clear();
+
+    /**
+     *  @brief  Get the bin containing a coordinate, clamped to the grid
+     *
+     *  @param  coordinate the coordinate
+     *  @param  minimum the lower edge of the first bin
+     *  @param  binWidth the bin width
+     *  @param  nBins the number of bins
+     *
+     *  @return the bin
+     */
+    static unsigned int GetClampedBin(const float coordinate, const float minimum, const float binWidth, const unsigned int nBins);
+
+    const LArTPC               *m_pLArTPC;              ///< The address of the lar tpc
+    HitType                     m_hitType;              ///< The hit type of the view
+    unsigned int                m_nDriftBins;           ///< The number of drift bins
+    unsigned int                m_nWireBins;            ///< The number of wire bins
+    float                       m_driftMin;             ///< The lower edge of the first drift bin, units mm
+    float                       m_wireMin;              ///< The lower edge of the first wire bin, units mm
+    float                       m_driftBinWidth;        ///< The drift bin width, units mm
+    float                       m_wireBinWidth;         ///< The wire bin width, units mm
+    UIntVector                  m_cellOffsets;          ///< The offsets of the calo hits in each cell, one entry per cell plus a final entry
+    CaloHitVector               m_caloHitVector;        ///< The calo hits, ordered by cell index
+
+    friend class CaloHitManager;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const LArTPC *LArTPCHitGrid::GetLArTPC() const
+{
+    return m_pLArTPC;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline HitType LArTPCHitGrid::GetHitType() const
+{
+    return m_hitType;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int LArTPCHitGrid::size() const
+{
+    return m_caloHitVector.size();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool LArTPCHitGrid::empty() const
+{
+    return m_caloHitVector.empty();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int LArTPCHitGrid::GetNDriftBins() const
+{
+    return m_nDriftBins;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int LArTPCHitGrid::GetNWireBins() const
+{
+    return m_nWireBins;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline float LArTPCHitGrid::GetDriftMin() const
+{
+    return m_driftMin;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline float LArTPCHitGrid::GetWireMin() const
+{
+    return m_wireMin;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline float LArTPCHitGrid::GetDriftBinWidth() const
+{
+    return m_driftBinWidth;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline float LArTPCHitGrid::GetWireBinWidth() const
+{
+    return m_wireBinWidth;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const UIntVector &LArTPCHitGrid::GetCellOffsets() const
+{
+    return m_cellOffsets;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const CaloHitVector &LArTPCHitGrid::GetCaloHitVector() const
+{
+    return m_caloHitVector;
+}
+
+} // namespace pandora
+
+#endif // #ifndef PANDORA_LAR_TPC_HIT_GRID_H
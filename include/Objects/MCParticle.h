@@ -11,10 +11,13 @@
 #include "Pandora/ObjectCreation.h"
 #include "Pandora/StatusCodes.h"
 
+#include <cstdint>
+
 namespace pandora
 {
 
 template<typename T> class InputObjectManager;
+template<typename T> class Manager;
 template<typename T, typename S> class PandoraObjectFactory;
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -95,6 +98,28 @@ public:
      */
     MCParticleType GetMCParticleType() const;
 
+    /**
+     *  @brief  Get the id of the event, within a batch of events, to which the mc particle belongs
+     * 
+     *  @return the event id
+     */
+    unsigned int GetEventId() const;
+
+    /**
+     *  @brief  Get the dense per-event mc particle index, assigned by the mc manager at creation, for use in vector side tables.
+     *
+     *  @return the mc particle index
+     */
+    unsigned int GetIndex() const;
+
+    /**
+     *  @brief  Get the generation of the mc particle index, advanced whenever the index is released or the event is reset, so that the
+     *          mc particle may be distinguished from any earlier holder of the same index
+     *
+     *  @return the index generation
+     */
+    unsigned int GetIndexGeneration() const;
+
     /**
      *  @brief  Whether the pfo target been set
      *
@@ -117,18 +142,25 @@ public:
     Uid GetUid() const;
 
     /**
-     *  @brief  Get list of parents of mc particle
+     *  @brief  Get list of parents of mc particle, a view of the flattened relationships owned by the mc manager
      * 
      *  @return the mc parent particle list
      */
-    const MCParticleList &GetParentList() const;
+    MCParticleRange GetParentList() const;
 
     /**
-     *  @brief  Get list of daughters of mc particle
+     *  @brief  Get list of daughters of mc particle, a view of the flattened relationships owned by the mc manager
      * 
      *  @return the mc daughter particle list
      */
-    const MCParticleList &GetDaughterList() const;
+    MCParticleRange GetDaughterList() const;
+
+    /**
+     *  @brief  Get the packed sort key, precomputed from the vertex position, for fast and deterministic sorting via the sorting helper
+     * 
+     *  @return the sort key
+     */
+    uint64_t GetSortKey() const;
 
     /**
      *  @brief  operator< sorting by vertex position, then energy
@@ -153,32 +185,12 @@ protected:
     virtual ~MCParticle();
 
     /**
-     *  @brief  Add daughter particle
-     * 
-     *  @param  mcParticle the daughter particle
-     */
-    StatusCode AddDaughter(const MCParticle *const pMCParticle);
-
-    /**
-     *  @brief  Add parent particle
-     * 
-     *  @param  mcParticle the parent particle
-     */
-    StatusCode AddParent(const MCParticle *const pMCParticle);
-
-    /**
-     *  @brief  Remove daughter particle
+     *  @brief  Set the parent and daughter particles, as ranges of the flattened relationships owned by the mc manager
      * 
-     *  @param  mcParticle the daughter particle
+     *  @param  parentRange the parent particles
+     *  @param  daughterRange the daughter particles
      */
-    StatusCode RemoveDaughter(const MCParticle *const pMCParticle);
-
-    /**
-     *  @brief  Remove parent particle
-     * 
-     *  @param  mcParticle the parent particle
-     */
-    StatusCode RemoveParent(const MCParticle *const pMCParticle);
+    void SetRelationships(const MCParticleRange &parentRange, const MCParticleRange &daughterRange);
 
     /**
      *  @brief  Set pfo target particle
@@ -201,11 +213,16 @@ protected:
     const float             m_outerRadius;              ///< Outer radius of the particle's path, units mm
     const int               m_particleId;               ///< The PDG code of the mc particle
     const MCParticleType    m_mcParticleType;           ///< The type of the mc particle, e.g. vertex, 2D-projection, etc.
+    const unsigned int      m_eventId;                  ///< The id of the event, within a batch of events, to which the mc particle belongs
+    unsigned int            m_index;                    ///< The dense per-event mc particle index, assigned by the mc manager
+    unsigned int            m_indexGeneration;          ///< The generation of the mc particle index, as assigned
     const MCParticle       *m_pPfoTarget;               ///< The address of the pfo target
-    MCParticleList          m_daughterList;             ///< The list of mc daughter particles
-    MCParticleList          m_parentList;               ///< The list of mc parent particles
+    const uint64_t          m_sortKey;                  ///< The packed sort key, precomputed from the vertex position
+    MCParticleRange         m_daughterRange;            ///< The mc daughter particles
+    MCParticleRange         m_parentRange;              ///< The mc parent particles
 
     friend class MCManager;
+    friend class Manager<MCParticle>;
     friend class InputObjectManager<MCParticle>;
     friend class PandoraObjectFactory<object_creation::MCParticle::Parameters, object_creation::MCParticle::Object>;
 };
@@ -214,7 +231,7 @@ protected:
 
 inline bool MCParticle::IsRootParticle() const
 {
-    return m_parentList.empty();
+    return m_parentRange.empty();
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -240,6 +257,13 @@ inline Uid MCParticle::GetUid() const
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+inline uint64_t MCParticle::GetSortKey() const
+{
+    return m_sortKey;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 inline float MCParticle::GetEnergy() const
 {
     return m_energy;
@@ -296,16 +320,37 @@ inline MCParticleType MCParticle::GetMCParticleType() const
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-inline const MCParticleList &MCParticle::GetParentList() const
+inline unsigned int MCParticle::GetIndex() const
+{
+    return m_index;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int MCParticle::GetIndexGeneration() const
+{
+    return m_indexGeneration;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int MCParticle::GetEventId() const
+{
+    return m_eventId;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline MCParticleRange MCParticle::GetParentList() const
 {
-    return m_parentList;
+    return m_parentRange;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-inline const MCParticleList &MCParticle::GetDaughterList() const
+inline MCParticleRange MCParticle::GetDaughterList() const
 {
-    return m_daughterList;
+    return m_daughterRange;
 }
 
 } // namespace pandora
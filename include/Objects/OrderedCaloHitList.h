@@ -13,6 +13,7 @@
 #include "Pandora/PandoraInternal.h"
 #include "Pandora/StatusCodes.h"
 
+#include <iterator>
 #include <map>
 
 namespace pandora
@@ -29,6 +30,144 @@ public:
     typedef TheList::const_iterator const_iterator;
     typedef TheList::const_reverse_iterator const_reverse_iterator;
 
+    /**
+     *  @brief  CaloHitIterator class, a forward iterator over every calo hit in the ordered calo hit list, in pseudo layer order
+     */
+    class CaloHitIterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef const CaloHit *value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const value_type *pointer;
+        typedef const value_type &reference;
+
+        /**
+         *  @brief  Constructor
+         *
+         *  @param  layerIter the pseudo layer at which to start
+         *  @param  layerIterEnd the past-the-end pseudo layer
+         */
+        CaloHitIterator(const const_iterator layerIter, const const_iterator layerIterEnd);
+
+        /**
+         *  @brief  Get the address of the current calo hit
+         *
+         *  @return the address of the current calo hit
+         */
+        reference operator*() const;
+
+        /**
+         *  @brief  Advance to the next calo hit
+         *
+         *  @return the advanced iterator
+         */
+        CaloHitIterator &operator++();
+
+        /**
+         *  @brief  Advance to the next calo hit
+         *
+         *  @return the iterator before advancing
+         */
+        CaloHitIterator operator++(int);
+
+        /**
+         *  @brief  Equality operator
+         *
+         *  @param  rhs the iterator to compare
+         */
+        bool operator==(const CaloHitIterator &rhs) const;
+
+        /**
+         *  @brief  Inequality operator
+         *
+         *  @param  rhs the iterator to compare
+         */
+        bool operator!=(const CaloHitIterator &rhs) const;
+
+    private:
+        /**
+         *  @brief  Move forward past any pseudo layers without calo hits, to the first calo hit in the next populated pseudo layer
+         */
+        void SkipEmptyLayers();
+
+        const_iterator                  m_layerIter;            ///< The current pseudo layer
+        const_iterator                  m_layerIterEnd;         ///< The past-the-end pseudo layer
+        CaloHitList::const_iterator     m_hitIter;              ///< The current calo hit within the current pseudo layer
+    };
+
+    /**
+     *  @brief  CaloHitRange class, a range over every calo hit in the ordered calo hit list, for use in range-based for loops
+     */
+    class CaloHitRange
+    {
+    public:
+        /**
+         *  @brief  Constructor
+         *
+         *  @param  theList the underlying ordered calo hit list map
+         */
+        CaloHitRange(const TheList &theList);
+
+        /**
+         *  @brief  Returns an iterator referring to the first calo hit in the range
+         */
+        CaloHitIterator begin() const;
+
+        /**
+         *  @brief  Returns an iterator referring to the past-the-end calo hit in the range
+         */
+        CaloHitIterator end() const;
+
+    private:
+        const TheList                  &m_theList;              ///< The underlying ordered calo hit list map
+    };
+
+    /**
+     *  @brief  LayerRange class, a view of a contiguous run of occupied pseudo layers in the ordered calo hit list, holding only a pair
+     *          of iterators. A view remains valid until pseudo layers are added to or removed from the list.
+     */
+    class LayerRange
+    {
+    public:
+        /**
+         *  @brief  Constructor
+         *
+         *  @param  beginIter the first pseudo layer in the range
+         *  @param  endIter the past-the-end pseudo layer
+         */
+        LayerRange(const const_iterator beginIter, const const_iterator endIter);
+
+        /**
+         *  @brief  Returns a const iterator referring to the first pseudo layer in the range
+         */
+        const_iterator begin() const;
+
+        /**
+         *  @brief  Returns a const iterator referring to the past-the-end pseudo layer in the range
+         */
+        const_iterator end() const;
+
+        /**
+         *  @brief  Returns a const reverse iterator referring to the last pseudo layer in the range
+         */
+        const_reverse_iterator rbegin() const;
+
+        /**
+         *  @brief  Returns a const reverse iterator referring to the before-the-first pseudo layer in the range
+         */
+        const_reverse_iterator rend() const;
+
+        /**
+         *  @brief  Returns whether the range contains no pseudo layers
+         */
+        bool empty() const;
+
+    private:
+        const_iterator                  m_beginIter;            ///< The first pseudo layer in the range
+        const_iterator                  m_endIter;              ///< The past-the-end pseudo layer
+    };
+
     /**
      *  @brief  Default constructor
      */
@@ -53,6 +192,14 @@ public:
      */
     StatusCode Add(const OrderedCaloHitList &rhs);
 
+    /**
+     *  @brief  Transfer the hits from a second ordered calo hit list to this list, leaving the second list empty. The calo hit lists
+     *          for pseudo layers absent from this list are transferred directly, rather than copied.
+     * 
+     *  @param  rhs the source ordered calo hit list
+     */
+    StatusCode Transfer(OrderedCaloHitList &rhs);
+
     /**
      *  @brief  Remove the hits in a second ordered calo hit list from this list
      * 
@@ -61,7 +208,8 @@ public:
     StatusCode Remove(const OrderedCaloHitList &rhs);
 
     /**
-     *  @brief  Add a list of calo hits to the ordered calo hit list
+     *  @brief  Add a list of calo hits to the ordered calo hit list. Larger lists are grouped by pseudo layer and merged layer by layer,
+     *          in which case the ordered calo hit list is left unmodified if any calo hit is already present.
      * 
      *  @param  caloHitList the calo hit list
      */
@@ -117,6 +265,55 @@ public:
      */
     void FillCaloHitList(CaloHitList &caloHitList) const;
 
+    /**
+     *  @brief  Fill a provided calo hit vector with all the calo hits in the ordered calo hit list, reserving the required capacity
+     * 
+     *  @param  caloHitVector to receive the calo hits
+     */
+    void FillCaloHitVector(CaloHitVector &caloHitVector) const;
+
+    /**
+     *  @brief  Get a range over every calo hit in the ordered calo hit list, in pseudo layer order, without building an intermediate list
+     * 
+     *  @return the calo hit range
+     */
+    CaloHitRange GetCaloHitRange() const;
+
+    /**
+     *  @brief  Get a view of the occupied pseudo layers in the inclusive range [firstLayer, lastLayer]
+     * 
+     *  @param  firstLayer the first pseudo layer
+     *  @param  lastLayer the last pseudo layer
+     * 
+     *  @return the layer range, empty if no pseudo layers in the range are occupied
+     */
+    LayerRange GetLayerRange(const unsigned int firstLayer, const unsigned int lastLayer) const;
+
+    /**
+     *  @brief  Get a view of the first n occupied pseudo layers, or of all occupied pseudo layers if there are fewer than n
+     * 
+     *  @param  nLayers the number of occupied pseudo layers
+     * 
+     *  @return the layer range
+     */
+    LayerRange GetFirstNOccupiedLayers(const unsigned int nLayers) const;
+
+    /**
+     *  @brief  Get a view of the last n occupied pseudo layers, or of all occupied pseudo layers if there are fewer than n
+     * 
+     *  @param  nLayers the number of occupied pseudo layers
+     * 
+     *  @return the layer range
+     */
+    LayerRange GetLastNOccupiedLayers(const unsigned int nLayers) const;
+
+    /**
+     *  @brief  Get the total number of calo hits in the ordered calo hit list
+     * 
+     *  @return the number of calo hits
+     */
+    unsigned int GetNCaloHits() const;
+
     /**
      *  @brief  Returns a const iterator referring to the first element in the ordered calo hit list
      */
@@ -182,6 +379,40 @@ private:
      */
     StatusCode Remove(const CaloHit *const pCaloHit, const unsigned int pseudoLayer);
 
+    /**
+     *  @brief  Add a list of calo hits to the ordered calo hit list, grouped by pseudo layer, without checking for duplicate calo hits
+     * 
+     *  @param  caloHitList the calo hit list
+     */
+    void FillWithoutChecks(const CaloHitList &caloHitList);
+
+    /**
+     *  @brief  Whether two calo hit lists share any calo hits. Small lists are compared directly, whilst larger lists are compared via
+     *          a hashed set of the hits in the smaller list, so that merging two pseudo layers is linear in their combined size.
+     * 
+     *  @param  caloHitList the first calo hit list
+     *  @param  otherCaloHitList the second calo hit list
+     * 
+     *  @return boolean
+     */
+    static bool HasCommonCaloHits(const CaloHitList &caloHitList, const CaloHitList &otherCaloHitList);
+
+    /**
+     *  @brief  Create a new, empty calo hit list for a pseudo layer, drawing its storage from the shared pool if pooling is enabled
+     * 
+     *  @return the address of the new calo hit list
+     */
+    static CaloHitList *CreateCaloHitList();
+
+    /**
+     *  @brief  Delete a pseudo layer calo hit list, returning its storage to the shared pool if pooling is enabled
+     * 
+     *  @param  pCaloHitList the address of the calo hit list
+     */
+    static void DeleteCaloHitList(CaloHitList *const pCaloHitList);
+
+    static const unsigned int MAX_LINEAR_SEARCH_PRODUCT = 64;   ///< The largest product of layer sizes for which layers are searched directly
+
     TheList     m_theList;      ///< The ordered calo hit list
 };
 
@@ -249,11 +480,186 @@ inline StatusCode OrderedCaloHitList::Remove(const CaloHit *const pCaloHit)
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+inline OrderedCaloHitList::CaloHitRange OrderedCaloHitList::GetCaloHitRange() const
+{
+    return CaloHitRange(m_theList);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline OrderedCaloHitList::LayerRange OrderedCaloHitList::GetLayerRange(const unsigned int firstLayer, const unsigned int lastLayer) const
+{
+    if (firstLayer > lastLayer)
+        return LayerRange(m_theList.end(), m_theList.end());
+
+    return LayerRange(m_theList.lower_bound(firstLayer), m_theList.upper_bound(lastLayer));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline OrderedCaloHitList::LayerRange OrderedCaloHitList::GetFirstNOccupiedLayers(const unsigned int nLayers) const
+{
+    if (nLayers >= m_theList.size())
+        return LayerRange(m_theList.begin(), m_theList.end());
+
+    return LayerRange(m_theList.begin(), std::next(m_theList.begin(), nLayers));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline OrderedCaloHitList::LayerRange OrderedCaloHitList::GetLastNOccupiedLayers(const unsigned int nLayers) const
+{
+    if (nLayers >= m_theList.size())
+        return LayerRange(m_theList.begin(), m_theList.end());
+
+    return LayerRange(std::prev(m_theList.end(), nLayers), m_theList.end());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 inline void OrderedCaloHitList::clear()
 {
     m_theList.clear();
 }
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline OrderedCaloHitList::CaloHitIterator::CaloHitIterator(const const_iterator layerIter, const const_iterator layerIterEnd) :
+    m_layerIter(layerIter),
+    m_layerIterEnd(layerIterEnd),
+    m_hitIter()
+{
+    if (m_layerIterEnd != m_layerIter)
+    {
+        m_hitIter = m_layerIter->second->begin();
+        this->SkipEmptyLayers();
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline OrderedCaloHitList::CaloHitIterator::reference OrderedCaloHitList::CaloHitIterator::operator*() const
+{
+    return *m_hitIter;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline OrderedCaloHitList::CaloHitIterator &OrderedCaloHitList::CaloHitIterator::operator++()
+{
+    ++m_hitIter;
+    this->SkipEmptyLayers();
+    return *this;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline OrderedCaloHitList::CaloHitIterator OrderedCaloHitList::CaloHitIterator::operator++(int)
+{
+    const CaloHitIterator previous(*this);
+    ++(*this);
+    return previous;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool OrderedCaloHitList::CaloHitIterator::operator==(const CaloHitIterator &rhs) const
+{
+    // ATTN Calo hit iterators are only compared within a pseudo layer, as all past-the-end iterators are equivalent
+    return ((m_layerIter == rhs.m_layerIter) && ((m_layerIterEnd == m_layerIter) || (m_hitIter == rhs.m_hitIter)));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool OrderedCaloHitList::CaloHitIterator::operator!=(const CaloHitIterator &rhs) const
+{
+    return !(*this == rhs);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline void OrderedCaloHitList::CaloHitIterator::SkipEmptyLayers()
+{
+    while (m_layerIter->second->end() == m_hitIter)
+    {
+        if (m_layerIterEnd == ++m_layerIter)
+        {
+            m_hitIter = CaloHitList::const_iterator();
+            return;
+        }
+
+        m_hitIter = m_layerIter->second->begin();
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline OrderedCaloHitList::CaloHitRange::CaloHitRange(const TheList &theList) :
+    m_theList(theList)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline OrderedCaloHitList::CaloHitIterator OrderedCaloHitList::CaloHitRange::begin() const
+{
+    return CaloHitIterator(m_theList.begin(), m_theList.end());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline OrderedCaloHitList::CaloHitIterator OrderedCaloHitList::CaloHitRange::end() const
+{
+    return CaloHitIterator(m_theList.end(), m_theList.end());
+}
+
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline OrderedCaloHitList::LayerRange::LayerRange(const const_iterator beginIter, const const_iterator endIter) :
+    m_beginIter(beginIter),
+    m_endIter(endIter)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline OrderedCaloHitList::const_iterator OrderedCaloHitList::LayerRange::begin() const
+{
+    return m_beginIter;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline OrderedCaloHitList::const_iterator OrderedCaloHitList::LayerRange::end() const
+{
+    return m_endIter;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline OrderedCaloHitList::const_reverse_iterator OrderedCaloHitList::LayerRange::rbegin() const
+{
+    return const_reverse_iterator(m_endIter);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline OrderedCaloHitList::const_reverse_iterator OrderedCaloHitList::LayerRange::rend() const
+{
+    return const_reverse_iterator(m_beginIter);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool OrderedCaloHitList::LayerRange::empty() const
+{
+    return (m_beginIter == m_endIter);
+}
+
 } // namespace pandora
 
 #endif // #ifndef PANDORA_ORDERED_CALO_HIT_LIST_H
@@ -8,6 +8,8 @@
 #ifndef PANDORA_PARTICLE_FLOW_OBJECT_H
 #define PANDORA_PARTICLE_FLOW_OBJECT_H 1
 
+#include "Objects/ParticleIdCache.h"
+
 #include "Pandora/ObjectCreation.h"
 #include "Pandora/StatusCodes.h"
 
@@ -15,6 +17,7 @@ namespace pandora
 {
 
 template<typename T> class AlgorithmObjectManager;
+template<typename T> class Manager;
 template<typename T, typename S> class PandoraObjectFactory;
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -109,6 +112,43 @@ public:
      */
     unsigned int GetNClusters() const;
 
+    /**
+     *  @brief  Get the number of calo hits in the clusters of the particle flow object, excluding isolated calo hits
+     * 
+     *  @return The number of calo hits
+     */
+    unsigned int GetNCaloHits() const;
+
+    /**
+     *  @brief  Get the number of calo hits of a specified type in the clusters of the particle flow object, excluding isolated calo hits
+     * 
+     *  @param  hitType the hit type
+     * 
+     *  @return The number of calo hits of the specified type
+     */
+    unsigned int GetNCaloHits(const HitType hitType) const;
+
+    /**
+     *  @brief  Get the number of isolated calo hits in the clusters of the particle flow object
+     * 
+     *  @return The number of isolated calo hits
+     */
+    unsigned int GetNIsolatedCaloHits() const;
+
+    /**
+     *  @brief  Get the sum of the electromagnetic energy measures of the clusters of the particle flow object, units GeV
+     * 
+     *  @return The summed electromagnetic energy measure
+     */
+    float GetElectromagneticEnergy() const;
+
+    /**
+     *  @brief  Get the sum of the hadronic energy measures of the clusters of the particle flow object, units GeV
+     * 
+     *  @return The summed hadronic energy measure
+     */
+    float GetHadronicEnergy() const;
+
     /**
      *  @brief  Get the parent pfo list
      * 
@@ -144,6 +184,56 @@ public:
      */
     const PropertiesMap &GetPropertiesMap() const;
 
+    /**
+     *  @brief  Get the modification epoch, a counter incremented by any change to the particle flow object metadata, constituents or
+     *          parent/daughter relationships. The sum of this epoch and those of the constituent clusters increases with any change to
+     *          the particle flow object or its clusters.
+     * 
+     *  @return the modification epoch
+     */
+    unsigned int GetModificationEpoch() const;
+
+    /**
+     *  @brief  Get the id of the event, within a batch of events, to which the particle flow object belongs. All constituent clusters
+     *          and tracks must share this event id.
+     * 
+     *  @return the event id
+     */
+    unsigned int GetEventId() const;
+
+    /**
+     *  @brief  Get the dense per-event pfo index, assigned by the pfo manager at creation, for use in vector side tables.
+     *          The indices of deleted pfos are reused by pfos created later in the event.
+     *
+     *  @return the pfo index
+     */
+    unsigned int GetIndex() const;
+
+    /**
+     *  @brief  Get the generation of the pfo index, advanced whenever the index is released or the event is reset, so that the
+     *          pfo may be distinguished from any earlier holder of the same index
+     *
+     *  @return the index generation
+     */
+    unsigned int GetIndexGeneration() const;
+
+#ifdef PANDORA_POOLED_OBJECT_ALLOCATION
+    /**
+     *  @brief  Class-specific allocation, using the particle flow object object pool
+     * 
+     *  @param  size the number of bytes requested
+     */
+    static void *operator new(std::size_t size);
+
+    /**
+     *  @brief  Class-specific deallocation, using the particle flow object object pool
+     * 
+     *  @param  pAddress the address of the memory to release
+     *  @param  size the number of bytes originally requested
+     */
+    static void operator delete(void *pAddress, std::size_t size);
+#endif
+
 protected:
     /**
      *  @brief  Constructor
@@ -208,6 +298,18 @@ protected:
      */
     StatusCode RemoveDaughter(const ParticleFlowObject *const pPfo);
 
+    /**
+     *  @brief  Remove any parent and daughter pfos in a specified set, in a single pass over the parent and daughter pfo lists
+     * 
+     *  @param  pfoSet the set of pfos to remove
+     */
+    void RemoveParentsAndDaughters(const PfoSet &pfoSet);
+
+    /**
+     *  @brief  Remove all parent and daughter pfos
+     */
+    void ClearParentsAndDaughters();
+
     /**
      *  @brief  Update the properties map
      * 
@@ -215,6 +317,37 @@ protected:
      */
     StatusCode UpdatePropertiesMap(const object_creation::ParticleFlowObject::Metadata &metadata);
 
+    /**
+     *  @brief  ClusterAggregates class, quantities summed over the clusters of the particle flow object, labelled with the modification
+     *          epoch of the particle flow object and its clusters at which they were calculated
+     */
+    class ClusterAggregates
+    {
+    public:
+        /**
+         *  @brief  Default constructor
+         */
+        ClusterAggregates();
+
+        static const unsigned int m_nHitTypes = HIT_CUSTOM + 1;  ///< The number of hit types
+
+        unsigned int    m_nCaloHits;                    ///< The number of calo hits, excluding isolated calo hits
+        unsigned int    m_nCaloHitsByType[m_nHitTypes]; ///< The number of calo hits of each hit type, excluding isolated calo hits
+        unsigned int    m_nIsolatedCaloHits;            ///< The number of isolated calo hits
+        float           m_electromagneticEnergy;        ///< The summed electromagnetic energy measure, units GeV
+        float           m_hadronicEnergy;               ///< The summed hadronic energy measure, units GeV
+        unsigned int    m_modificationEpoch;            ///< The summed modification epoch at which the aggregates were calculated
+        bool            m_isInitialized;                ///< Whether the aggregates have been calculated
+    };
+
+    /**
+     *  @brief  Get the cluster aggregates, recalculating them if the particle flow object or any of its clusters has changed since
+     *          they were last calculated
+     * 
+     *  @return The cluster aggregates
+     */
+    const ClusterAggregates &GetClusterAggregates() const;
+
     int                     m_particleId;               ///< The particle flow object id (PDG code)
     int                     m_charge;                   ///< The particle flow object charge
     float                   m_mass;                     ///< The particle flow object mass
@@ -226,8 +359,16 @@ protected:
     PfoList                 m_parentPfoList;            ///< The list of parent pfos
     PfoList                 m_daughterPfoList;          ///< The list of daughter pfos
     PropertiesMap           m_propertiesMap;            ///< The map from registered property name to floating point property value
+    unsigned int            m_modificationEpoch;        ///< The modification epoch, incremented by any change to the particle flow object
+    unsigned int            m_eventId;                  ///< The id of the event, within a batch of events, to which the pfo belongs
+    unsigned int            m_index;                    ///< The dense per-event pfo index, assigned by the pfo manager
+    unsigned int            m_indexGeneration;          ///< The generation of the pfo index, as assigned
+    mutable ParticleIdCache m_particleIdCache;          ///< The particle id plugin results, labelled by modification epoch
+    mutable ClusterAggregates m_clusterAggregates;      ///< The quantities summed over the clusters, labelled by modification epoch
 
     friend class ParticleFlowObjectManager;
+    friend class ParticleId;
+    friend class Manager<ParticleFlowObject>;
     friend class AlgorithmObjectManager<ParticleFlowObject>;
     friend class PandoraObjectFactory<object_creation::ParticleFlowObject::Parameters, object_creation::ParticleFlowObject::Object>;
 };
@@ -306,6 +447,41 @@ inline unsigned int ParticleFlowObject::GetNClusters() const
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+inline unsigned int ParticleFlowObject::GetNCaloHits() const
+{
+    return this->GetClusterAggregates().m_nCaloHits;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int ParticleFlowObject::GetNCaloHits(const HitType hitType) const
+{
+    return (hitType < ClusterAggregates::m_nHitTypes) ? this->GetClusterAggregates().m_nCaloHitsByType[hitType] : 0;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int ParticleFlowObject::GetNIsolatedCaloHits() const
+{
+    return this->GetClusterAggregates().m_nIsolatedCaloHits;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline float ParticleFlowObject::GetElectromagneticEnergy() const
+{
+    return this->GetClusterAggregates().m_electromagneticEnergy;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline float ParticleFlowObject::GetHadronicEnergy() const
+{
+    return this->GetClusterAggregates().m_hadronicEnergy;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 inline const PfoList &ParticleFlowObject::GetParentPfoList() const
 {
     return m_parentPfoList;
@@ -339,6 +515,34 @@ inline const PropertiesMap &ParticleFlowObject::GetPropertiesMap() const
     return m_propertiesMap;
 }
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int ParticleFlowObject::GetModificationEpoch() const
+{
+    return m_modificationEpoch;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int ParticleFlowObject::GetIndex() const
+{
+    return m_index;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int ParticleFlowObject::GetIndexGeneration() const
+{
+    return m_indexGeneration;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int ParticleFlowObject::GetEventId() const
+{
+    return m_eventId;
+}
+
 } // namespace pandora
 
 #endif // #ifndef PANDORA_PARTICLE_FLOW_OBJECT_H
@@ -0,0 +1,98 @@
+/**
+ *  @file   PandoraSDK/include/Objects/ParticleIdCache.h
+ * 
+ *  @brief  Header file for the particle id cache class.
+ * 
+ *  $Log: $
+ */
+#ifndef PANDORA_PARTICLE_ID_CACHE_H
+#define PANDORA_PARTICLE_ID_CACHE_H 1
+
+namespace pandora
+{
+
+/**
+ *  @brief  ParticleIdCache class, holding the particle id plugin results for a cluster or pfo, each labelled with the modification epoch
+ *          of the object at which it was calculated
+ */
+class ParticleIdCache
+{
+public:
+    /**
+     *  @brief  ParticleIdType enum, labelling the particle id hypotheses
+     */
+    enum ParticleIdType
+    {
+        EM_SHOWER_ID,
+        PHOTON_ID,
+        ELECTRON_ID,
+        MUON_ID,
+        N_PARTICLE_ID_TYPES
+    };
+
+    /**
+     *  @brief  Default constructor
+     */
+    ParticleIdCache();
+
+    /**
+     *  @brief  Get a cached particle id result, if it was calculated at the current modification epoch of the object
+     * 
+     *  @param  particleIdType the particle id type
+     *  @param  modificationEpoch the current modification epoch of the object
+     *  @param  isMatch to receive the cached result
+     * 
+     *  @return whether a valid cached result is available
+     */
+    bool Get(const ParticleIdType particleIdType, const unsigned int modificationEpoch, bool &isMatch) const;
+
+    /**
+     *  @brief  Set a cached particle id result
+     * 
+     *  @param  particleIdType the particle id type
+     *  @param  modificationEpoch the modification epoch of the object at which the result was calculated
+     *  @param  isMatch the result
+     */
+    void Set(const ParticleIdType particleIdType, const unsigned int modificationEpoch, const bool isMatch);
+
+private:
+    unsigned int    m_modificationEpochs[N_PARTICLE_ID_TYPES];  ///< The modification epoch at which each result was calculated
+    bool            m_isInitialized[N_PARTICLE_ID_TYPES];       ///< Whether each result has been calculated
+    bool            m_isMatch[N_PARTICLE_ID_TYPES];             ///< The cached results
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline ParticleIdCache::ParticleIdCache()
+{
+    for (unsigned int index = 0; index < N_PARTICLE_ID_TYPES; ++index)
+    {
+        m_modificationEpochs[index] = 0;
+        m_isInitialized[index] = false;
+        m_isMatch[index] = false;
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool ParticleIdCache::Get(const ParticleIdType particleIdType, const unsigned int modificationEpoch, bool &isMatch) const
+{
+    if (!m_isInitialized[particleIdType] || (modificationEpoch != m_modificationEpochs[particleIdType]))
+        return false;
+
+    isMatch = m_isMatch[particleIdType];
+    return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline void ParticleIdCache::Set(const ParticleIdType particleIdType, const unsigned int modificationEpoch, const bool isMatch)
+{
+    m_modificationEpochs[particleIdType] = modificationEpoch;
+    m_isInitialized[particleIdType] = true;
+    m_isMatch[particleIdType] = isMatch;
+}
+
+} // namespace pandora
+
+#endif // #ifndef PANDORA_PARTICLE_ID_CACHE_H
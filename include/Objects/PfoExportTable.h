@@ -0,0 +1,209 @@
+/**
+ *  @file   PandoraSDK/include/Objects/PfoExportTable.h
+ *
+ *  @brief  Header file for the pfo export table class.
+ *
+ *  $Log: $
+ */
+#ifndef PANDORA_PFO_EXPORT_TABLE_H
+#define PANDORA_PFO_EXPORT_TABLE_H 1
+
+#include "Objects/CartesianVector.h"
+#include "Objects/PfoHierarchy.h"
+
+#include "Pandora/PandoraInternal.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace pandora
+{
+
+/**
+ *  @brief  PfoExportTable class, a flattened, columnar copy of the reconstruction output, for translation by host frameworks without
+ *          walking the pfo, cluster and ordered calo hit list objects. Pfos are held in the depth-first order of a pfo hierarchy, so the
+ *          downstream pfos of any pfo follow it in the table. Each pfo row addresses ranges of the flat daughter index, calo hit, track
+ *          and vertex arrays. Calo hits and tracks are identified by the addresses of their parents in the host framework. Filling the
+ *          table reuses the storage of the previous fill, so a table held across events allocates only as event sizes grow.
+ */
+class PfoExportTable
+{
+public:
+    /**
+     *  @brief  PfoRow class, the kinematics, hierarchy indices and array ranges for a single pfo
+     */
+    class PfoRow
+    {
+    public:
+        int                     m_particleId;           ///< The pfo particle id
+        int                     m_charge;               ///< The pfo charge
+        float                   m_mass;                 ///< The pfo mass, units GeV
+        float                   m_energy;               ///< The pfo energy, units GeV
+        float                   m_momentumX;            ///< The pfo momentum x component, units GeV
+        float                   m_momentumY;            ///< The pfo momentum y component, units GeV
+        float                   m_momentumZ;            ///< The pfo momentum z component, units GeV
+        unsigned int            m_eventId;              ///< The pfo event id
+        int                     m_parentIndex;          ///< The row index of the first parent pfo in the table, or -1 if none
+        unsigned int            m_daughterBegin;        ///< The start of the pfo range in the daughter index array
+        unsigned int            m_daughterEnd;          ///< The end of the pfo range in the daughter index array
+        unsigned int            m_caloHitBegin;         ///< The start of the pfo range in the calo hit arrays
+        unsigned int            m_caloHitEnd;           ///< The end of the pfo range in the calo hit arrays
+        unsigned int            m_trackBegin;           ///< The start of the pfo range in the track array
+        unsigned int            m_trackEnd;             ///< The end of the pfo range in the track array
+        unsigned int            m_vertexBegin;          ///< The start of the pfo range in the vertex array
+        unsigned int            m_vertexEnd;            ///< The end of the pfo range in the vertex array
+    };
+
+    typedef std::vector<PfoRow> PfoRowVector;
+    typedef std::vector<const void *> AddressVector;
+    typedef std::vector<CartesianVector> CartesianPointVector;
+
+    /**
+     *  @brief  Rebuild the table from a list of pfos. Daughters absent from the list are included via their parents.
+     *
+     *  @param  pfoList the list of pfos
+     */
+    void Fill(const PfoList &pfoList);
+
+    /**
+     *  @brief  Get the number of pfos in the table
+     *
+     *  @return the number of pfos
+     */
+    unsigned int size() const;
+
+    /**
+     *  @brief  Whether the table is empty
+     *
+     *  @return boolean
+     */
+    bool empty() const;
+
+    /**
+     *  @brief  Get the pfos, in table order
+     *
+     *  @return the pfo vector
+     */
+    const PfoVector &GetPfoVector() const;
+
+    /**
+     *  @brief  Get the pfo rows, in table order
+     *
+     *  @return the pfo row vector
+     */
+    const PfoRowVector &GetPfoRows() const;
+
+    /**
+     *  @brief  Get the daughter index array, holding the row indices of the daughters of each pfo
+     *
+     *  @return the daughter index array
+     */
+    const UIntVector &GetDaughterIndices() const;
+
+    /**
+     *  @brief  Get the calo hit parent address array, holding the calo hits, including isolated calo hits, in the clusters of each pfo
+     *
+     *  @return the calo hit parent address array
+     */
+    const AddressVector &GetCaloHitParentAddresses() const;
+
+    /**
+     *  @brief  Get the calo hit pfo index array, holding the row index of the pfo for each entry in the calo hit parent address array
+     *
+     *  @return the calo hit pfo index array
+     */
+    const UIntVector &GetCaloHitPfoIndices() const;
+
+    /**
+     *  @brief  Get the track parent address array, holding the tracks of each pfo
+     *
+     *  @return the track parent address array
+     */
+    const AddressVector &GetTrackParentAddresses() const;
+
+    /**
+     *  @brief  Get the vertex position array, holding the vertex positions of each pfo, units mm
+     *
+     *  @return the vertex position array
+     */
+    const CartesianPointVector &GetVertexPositions() const;
+
+private:
+    typedef std::unordered_map<const ParticleFlowObject *, unsigned int> PfoToIndexMap;
+
+    PfoHierarchy                m_pfoHierarchy;             ///< The pfo hierarchy, defining the table order
+    PfoToIndexMap               m_pfoToIndexMap;            ///< The row index of each pfo
+    PfoRowVector                m_pfoRows;                  ///< The pfo rows
+    UIntVector                  m_daughterIndices;          ///< The daughter index array
+    AddressVector               m_caloHitParentAddresses;   ///< The calo hit parent address array
+    UIntVector                  m_caloHitPfoIndices;        ///< The calo hit pfo index array
+    AddressVector               m_trackParentAddresses;     ///< The track parent address array
+    CartesianPointVector        m_vertexPositions;          ///< The vertex position array
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int PfoExportTable::size() const
+{
+    return m_pfoRows.size();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool PfoExportTable::empty() const
+{
+    return m_pfoRows.empty();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const PfoVector &PfoExportTable::GetPfoVector() const
+{
+    return m_pfoHierarchy.GetPfoVector();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const PfoExportTable::PfoRowVector &PfoExportTable::GetPfoRows() const
+{
+    return m_pfoRows;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const UIntVector &PfoExportTable::GetDaughterIndices() const
+{
+    return m_daughterIndices;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const PfoExportTable::AddressVector &PfoExportTable::GetCaloHitParentAddresses() const
+{
+    return m_caloHitParentAddresses;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const UIntVector &PfoExportTable::GetCaloHitPfoIndices() const
+{
+    return m_caloHitPfoIndices;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const PfoExportTable::AddressVector &PfoExportTable::GetTrackParentAddresses() const
+{
+    return m_trackParentAddresses;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const PfoExportTable::CartesianPointVector &PfoExportTable::GetVertexPositions() const
+{
+    return m_vertexPositions;
+}
+
+} // namespace pandora
+
+#endif // #ifndef PANDORA_PFO_EXPORT_TABLE_H
@@ -0,0 +1,162 @@
+/**
+ *  @file   PandoraSDK/include/Objects/PfoHierarchy.h
+ *
+ *  @brief  Header file for the pfo hierarchy class.
+ *
+ *  $Log: $
+ */
+#ifndef PANDORA_PFO_HIERARCHY_H
+#define PANDORA_PFO_HIERARCHY_H 1
+
+#include "Pandora/PandoraInternal.h"
+#include "Pandora/StatusCodes.h"
+
+#include <unordered_map>
+
+namespace pandora
+{
+
+/**
+ *  @brief  PfoHierarchy class, a read-only flattened view of the parent-daughter relationships between particle flow objects. Pfos
+ *          are held in depth-first order, starting from each pfo without parents, so that when each pfo has at most one parent the
+ *          downstream pfos of any pfo form a contiguous range and subtree queries are range scans. Pfos with several parents, or in
+ *          parent-daughter cycles, are supported via an explicit walk of the hierarchy. The contents of the pfos (clusters, tracks,
+ *          calo hits) are not cached, and are read from the pfos by each query.
+ */
+class PfoHierarchy
+{
+public:
+    /**
+     *  @brief  Default constructor
+     */
+    PfoHierarchy();
+
+    /**
+     *  @brief  Rebuild the hierarchy from a list of pfos. Daughters absent from the list are included via their parents.
+     *
+     *  @param  pfoList the list of pfos, the order of which determines the order of the pfos without parents
+     */
+    void Fill(const PfoList &pfoList);
+
+    /**
+     *  @brief  Get the number of pfos in the hierarchy
+     *
+     *  @return the number of pfos
+     */
+    unsigned int size() const;
+
+    /**
+     *  @brief  Whether the hierarchy is empty
+     *
+     *  @return boolean
+     */
+    bool empty() const;
+
+    /**
+     *  @brief  Whether each pfo has at most one parent and there are no cycles, such that all subtree queries are range scans
+     *
+     *  @return boolean
+     */
+    bool IsForest() const;
+
+    /**
+     *  @brief  Get all pfos in the hierarchy, in depth-first order
+     *
+     *  @return the pfo vector
+     */
+    const PfoVector &GetPfoVector() const;
+
+    /**
+     *  @brief  Get a pfo and all its downstream pfos (daughters, granddaughters, etc.), in depth-first order
+     *
+     *  @param  pPfo address of the pfo
+     *  @param  pfoVector to receive the pfo and its downstream pfos
+     *
+     *  @return STATUS_CODE_SUCCESS, or STATUS_CODE_NOT_FOUND if the pfo is not in the hierarchy
+     */
+    StatusCode GetDownstreamPfos(const ParticleFlowObject *const pPfo, PfoVector &pfoVector) const;
+
+    /**
+     *  @brief  Get the clusters of a pfo and all its downstream pfos
+     *
+     *  @param  pPfo address of the pfo
+     *  @param  clusterList to receive the clusters, appended in depth-first pfo order
+     *
+     *  @return STATUS_CODE_SUCCESS, or STATUS_CODE_NOT_FOUND if the pfo is not in the hierarchy
+     */
+    StatusCode GetDownstreamClusters(const ParticleFlowObject *const pPfo, ClusterList &clusterList) const;
+
+    /**
+     *  @brief  Get the tracks of a pfo and all its downstream pfos
+     *
+     *  @param  pPfo address of the pfo
+     *  @param  trackList to receive the tracks, appended in depth-first pfo order
+     *
+     *  @return STATUS_CODE_SUCCESS, or STATUS_CODE_NOT_FOUND if the pfo is not in the hierarchy
+     */
+    StatusCode GetDownstreamTracks(const ParticleFlowObject *const pPfo, TrackList &trackList) const;
+
+    /**
+     *  @brief  Get the calo hits, including isolated calo hits, in the clusters of a pfo and all its downstream pfos
+     *
+     *  @param  pPfo address of the pfo
+     *  @param  caloHitList to receive the calo hits, appended in depth-first pfo order
+     *
+     *  @return STATUS_CODE_SUCCESS, or STATUS_CODE_NOT_FOUND if the pfo is not in the hierarchy
+     */
+    StatusCode GetDownstreamCaloHits(const ParticleFlowObject *const pPfo, CaloHitList &caloHitList) const;
+
+private:
+    typedef std::unordered_map<const ParticleFlowObject *, unsigned int> PfoToIndexMap;
+
+    /**
+     *  @brief  Add a pfo and its downstream pfos, not yet in the hierarchy, in depth-first order
+     *
+     *  @param  pPfo address of the pfo
+     */
+    void AddSubtree(const ParticleFlowObject *const pPfo);
+
+    PfoVector                   m_pfoVector;            ///< The pfos, in depth-first order
+    UIntVector                  m_subtreeEnds;          ///< For each pfo, the index one beyond its last downstream pfo
+    PfoToIndexMap               m_pfoToIndexMap;        ///< The index of each pfo in the depth-first order
+    bool                        m_isForest;             ///< Whether each pfo has at most one parent and there are no cycles
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline PfoHierarchy::PfoHierarchy() :
+    m_isForest(true)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int PfoHierarchy::size() const
+{
+    return m_pfoVector.size();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool PfoHierarchy::empty() const
+{
+    return m_pfoVector.empty();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool PfoHierarchy::IsForest() const
+{
+    return m_isForest;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const PfoVector &PfoHierarchy::GetPfoVector() const
+{
+    return m_pfoVector;
+}
+
+} // namespace pandora
+
+#endif // #ifndef PANDORA_PFO_HIERARCHY_H
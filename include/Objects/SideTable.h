@@ -0,0 +1,242 @@
+/**
+ *  @file   PandoraSDK/include/Objects/SideTable.h
+ *
+ *  @brief  Header file for the side table class.
+ *
+ *  $Log: $
+ */
+#ifndef PANDORA_SIDE_TABLE_H
+#define PANDORA_SIDE_TABLE_H 1
+
+#include "Pandora/StatusCodes.h"
+
+#include <limits>
+#include <vector>
+
+namespace pandora
+{
+
+/**
+ *  @brief  SideTable class, holding algorithm data attached to pandora objects in a contiguous vector indexed by the dense per-event
+ *          object index, in place of a hash map keyed by object address. Each entry records the address and index generation of its
+ *          object, so an entry left over from a deleted object is never returned for a later object reusing its index, even at the
+ *          same address. Entries for deleted objects should nevertheless be erased, to keep the entry count accurate. Clearing the
+ *          table retains its storage.
+ */
+template <typename T, typename V>
+class SideTable
+{
+public:
+    /**
+     *  @brief  Default constructor
+     */
+    SideTable();
+
+    /**
+     *  @brief  Whether the table holds an entry for a specified object
+     *
+     *  @param  pT address of the object
+     *
+     *  @return boolean
+     */
+    bool Contains(const T *const pT) const;
+
+    /**
+     *  @brief  Get the entry for a specified object, inserting a default-constructed entry if there is none
+     *
+     *  @param  pT address of the object, which must have a valid index
+     *
+     *  @return the entry
+     */
+    V &operator[](const T *const pT);
+
+    /**
+     *  @brief  Get the entry for a specified object, throwing STATUS_CODE_NOT_FOUND if there is none
+     *
+     *  @param  pT address of the object
+     *
+     *  @return the entry
+     */
+    const V &at(const T *const pT) const;
+
+    /**
+     *  @brief  Erase the entry for a specified object, if any
+     *
+     *  @param  pT address of the object
+     */
+    void Erase(const T *const pT);
+
+    /**
+     *  @brief  Ensure storage for all objects with indices below a specified bound, e.g. that provided by GetIndexUpperBound
+     *
+     *  @param  indexUpperBound the index upper bound
+     */
+    void Reserve(const unsigned int indexUpperBound);
+
+    /**
+     *  @brief  Get the number of entries in the table
+     *
+     *  @return the number of entries
+     */
+    unsigned int size() const;
+
+    /**
+     *  @brief  Whether the table is empty
+     *
+     *  @return boolean
+     */
+    bool empty() const;
+
+    /**
+     *  @brief  Erase all entries, retaining the storage
+     */
+    void clear();
+
+private:
+    /**
+     *  @brief  Slot class, the table storage for a single object index
+     */
+    class Slot
+    {
+    public:
+        /**
+         *  @brief  Default constructor
+         */
+        Slot();
+
+        const T                *m_pT;                   ///< The address of the object owning the entry, null if none
+        unsigned int            m_generation;           ///< The index generation of the object owning the entry
+        V                       m_value;                ///< The entry
+    };
+
+    typedef std::vector<Slot> SlotVector;
+
+    SlotVector                  m_slotVector;           ///< The slots, by object index
+    unsigned int                m_size;                 ///< The number of entries
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T, typename V>
+inline SideTable<T, V>::SideTable() :
+    m_size(0)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T, typename V>
+inline bool SideTable<T, V>::Contains(const T *const pT) const
+{
+    const unsigned int index(pT->GetIndex());
+
+    if (index >= m_slotVector.size())
+        return false;
+
+    const Slot &slot(m_slotVector[index]);
+    return ((pT == slot.m_pT) && (pT->GetIndexGeneration() == slot.m_generation));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T, typename V>
+inline V &SideTable<T, V>::operator[](const T *const pT)
+{
+    const unsigned int index(pT->GetIndex());
+
+    if (std::numeric_limits<unsigned int>::max() == index)
+        throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
+
+    if (index >= m_slotVector.size())
+        m_slotVector.resize(index + 1);
+
+    Slot &slot(m_slotVector[index]);
+
+    // ATTN A slot owned by another object, or by an earlier holder of the index at the same address, is left over from an object
+    // deleted without its entry being erased
+    if ((pT != slot.m_pT) || (pT->GetIndexGeneration() != slot.m_generation))
+    {
+        if (!slot.m_pT)
+            ++m_size;
+
+        slot.m_pT = pT;
+        slot.m_generation = pT->GetIndexGeneration();
+        slot.m_value = V();
+    }
+
+    return slot.m_value;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T, typename V>
+inline const V &SideTable<T, V>::at(const T *const pT) const
+{
+    if (!this->Contains(pT))
+        throw StatusCodeException(STATUS_CODE_NOT_FOUND);
+
+    return m_slotVector[pT->GetIndex()].m_value;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T, typename V>
+inline void SideTable<T, V>::Erase(const T *const pT)
+{
+    if (!this->Contains(pT))
+        return;
+
+    m_slotVector[pT->GetIndex()].m_pT = nullptr;
+    --m_size;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T, typename V>
+inline void SideTable<T, V>::Reserve(const unsigned int indexUpperBound)
+{
+    if (indexUpperBound > m_slotVector.size())
+        m_slotVector.resize(indexUpperBound);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T, typename V>
+inline unsigned int SideTable<T, V>::size() const
+{
+    return m_size;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T, typename V>
+inline bool SideTable<T, V>::empty() const
+{
+    return (0 == m_size);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T, typename V>
+inline void SideTable<T, V>::clear()
+{
+    for (Slot &slot : m_slotVector)
+        slot.m_pT = nullptr;
+
+    m_size = 0;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T, typename V>
+inline SideTable<T, V>::Slot::Slot() :
+    m_pT(nullptr),
+    m_generation(0),
+    m_value()
+{
+}
+
+} // namespace pandora
+
+#endif // #ifndef PANDORA_SIDE_TABLE_H
@@ -0,0 +1,305 @@
+/**
+ *  @file   PandoraSDK/include/Objects/SpatialIndex.h
+ *
+ *  @brief  Header file for the spatial index class.
+ *
+ *  $Log: $
+ */
+#ifndef PANDORA_SPATIAL_INDEX_H
+#define PANDORA_SPATIAL_INDEX_H 1
+
+#include "Objects/CartesianVector.h"
+
+#include "Pandora/PandoraInternal.h"
+#include "Pandora/StatusCodes.h"
+
+namespace pandora
+{
+
+/**
+ *  @brief  SpatialIndex class, a read-only kd-tree over a representative position for each object in a list: the calorimeter
+ *          projection for tracks, the inner pseudo layer centroid for clusters and the position vector for calo hits and vertices. Query results
+ *          are identical to those of a brute-force loop over the list, in list order. Only coordinates that vary across the list are
+ *          used to split the tree, so that an index over hits in a single two-dimensional view is a two-dimensional tree.
+ */
+template <typename T>
+class SpatialIndex
+{
+public:
+    typedef MANAGED_CONTAINER<const T *> ObjectList;
+    typedef std::vector<const T *> ObjectVector;
+
+    /**
+     *  @brief  Default constructor
+     */
+    SpatialIndex();
+
+    /**
+     *  @brief  Get the number of objects in the index
+     *
+     *  @return the number of objects
+     */
+    unsigned int size() const;
+
+    /**
+     *  @brief  Whether the index is empty
+     *
+     *  @return boolean
+     */
+    bool empty() const;
+
+    /**
+     *  @brief  Find the object whose position is nearest to a specified point; for equidistant objects, the first in list order
+     *
+     *  @param  point the specified point
+     *  @param  pNearestObject to receive the address of the nearest object
+     *  @param  distance to receive the distance between the point and the nearest object position
+     */
+    StatusCode FindNearest(const CartesianVector &point, const T *&pNearestObject, float &distance) const;
+
+    /**
+     *  @brief  Find all objects whose positions lie within a specified radius of a point (inclusive), in list order
+     *
+     *  @param  point the specified point
+     *  @param  radius the radius
+     *  @param  objectVector to receive the addresses of the objects within the radius
+     */
+    StatusCode FindWithinRadius(const CartesianVector &point, const float radius, ObjectVector &objectVector) const;
+
+    /**
+     *  @brief  Find the k objects whose positions are nearest to a specified point, ordered by distance and then by list order; fewer
+     *          than k objects are returned if the index holds fewer than k objects
+     *
+     *  @param  point the specified point
+     *  @param  k the number of objects to find
+     *  @param  objectVector to receive the addresses of the nearest objects
+     */
+    StatusCode FindKNearest(const CartesianVector &point, const unsigned int k, ObjectVector &objectVector) const;
+
+private:
+    /**
+     *  @brief  Entry class, describing an object and its representative position
+     */
+    class Entry
+    {
+    public:
+        float                   m_position[3];          ///< The representative position x, y and z coordinates
+        unsigned int            m_listIndex;            ///< The position of the object in the source list
+        const T                *m_pObject;              ///< The address of the object
+    };
+
+    typedef std::vector<Entry> EntryVector;
+    typedef std::pair<float, const Entry *> Neighbour;
+    typedef std::vector<Neighbour> NeighbourVector;
+
+    static const unsigned int LIST_ORDER = 3;           ///< The axis value used to order entries by list index alone
+
+    /**
+     *  @brief  AxisLessThan class, ordering entries by a single coordinate, then by list index
+     */
+    class AxisLessThan
+    {
+    public:
+        /**
+         *  @brief  Constructor
+         *
+         *  @param  axis the coordinate index, or LIST_ORDER to order entries by list index alone
+         */
+        AxisLessThan(const unsigned int axis);
+
+        /**
+         *  @brief  Compare two entries
+         *
+         *  @param  lhs the first entry
+         *  @param  rhs the second entry
+         *
+         *  @return boolean
+         */
+        bool operator()(const Entry &lhs, const Entry &rhs) const;
+
+    private:
+        unsigned int            m_axis;                 ///< The coordinate index
+    };
+
+    /**
+     *  @brief  NeighbourLessThan class, ordering neighbours by squared distance, then by list index
+     */
+    class NeighbourLessThan
+    {
+    public:
+        /**
+         *  @brief  Compare two neighbours
+         *
+         *  @param  lhs the first neighbour
+         *  @param  rhs the second neighbour
+         *
+         *  @return boolean
+         */
+        bool operator()(const Neighbour &lhs, const Neighbour &rhs) const;
+    };
+
+    /**
+     *  @brief  Refill the index using the contents of an object list; objects without a representative position are omitted
+     *
+     *  @param  objectList the object list
+     */
+    void Fill(const ObjectList &objectList);
+
+    /**
+     *  @brief  Clear the index
+     */
+    void Clear();
+
+    /**
+     *  @brief  Get the representative position of an object
+     *
+     *  @param  pObject address of the object
+     *  @param  position to receive the position
+     *
+     *  @return whether the object has a representative position
+     */
+    static bool GetPosition(const T *const pObject, CartesianVector &position);
+
+    /**
+     *  @brief  Arrange a range of entries as a balanced kd-tree, with the median entry of each range at its centre
+     *
+     *  @param  begin the index of the first entry in the range
+     *  @param  end the index one past the last entry in the range
+     *  @param  depth the tree depth, selecting the splitting coordinate
+     */
+    void Build(const unsigned int begin, const unsigned int end, const unsigned int depth);
+
+    /**
+     *  @brief  Search a range of the kd-tree for the entry nearest to a point
+     *
+     *  @param  point the point x, y and z coordinates
+     *  @param  begin the index of the first entry in the range
+     *  @param  end the index one past the last entry in the range
+     *  @param  depth the tree depth, selecting the splitting coordinate
+     *  @param  pBestEntry to receive the address of the nearest entry found so far
+     *  @param  bestDistanceSquared to receive the squared distance to the nearest entry found so far
+     */
+    void FindNearest(const float *const point, const unsigned int begin, const unsigned int end, const unsigned int depth,
+        const Entry *&pBestEntry, float &bestDistanceSquared) const;
+
+    /**
+     *  @brief  Search a range of the kd-tree for the entries within a radius of a point
+     *
+     *  @param  point the point x, y and z coordinates
+     *  @param  radiusSquared the squared radius
+     *  @param  begin the index of the first entry in the range
+     *  @param  end the index one past the last entry in the range
+     *  @param  depth the tree depth, selecting the splitting coordinate
+     *  @param  entryVector to receive the entries within the radius
+     */
+    void FindWithinRadius(const float *const point, const float radiusSquared, const unsigned int begin, const unsigned int end,
+        const unsigned int depth, EntryVector &entryVector) const;
+
+    /**
+     *  @brief  Search a range of the kd-tree for the k entries nearest to a point
+     *
+     *  @param  point the point x, y and z coordinates
+     *  @param  k the number of entries to find
+     *  @param  begin the index of the first entry in the range
+     *  @param  end the index one past the last entry in the range
+     *  @param  depth the tree depth, selecting the splitting coordinate
+     *  @param  neighbourHeap the nearest entries found so far, arranged as a heap with the furthest entry at the front
+     */
+    void FindKNearest(const float *const point, const unsigned int k, const unsigned int begin, const unsigned int end,
+        const unsigned int depth, NeighbourVector &neighbourHeap) const;
+
+    /**
+     *  @brief  Get the splitting coordinate for a tree depth
+     *
+     *  @param  depth the tree depth
+     *
+     *  @return the coordinate index
+     */
+    unsigned int GetSplitAxis(const unsigned int depth) const;
+
+    /**
+     *  @brief  Get the squared distance between an entry position and a point
+     *
+     *  @param  entry the entry
+     *  @param  point the point x, y and z coordinates
+     *
+     *  @return the squared distance
+     */
+    static float GetDistanceSquared(const Entry &entry, const float *const point);
+
+    EntryVector                 m_entryVector;          ///< The entries, arranged as an implicit kd-tree
+    unsigned int                m_splitAxes[3];         ///< The coordinates used to split the tree, in depth order
+    unsigned int                m_nSplitAxes;           ///< The number of coordinates used to split the tree
+
+    friend class CaloHitManager;
+    friend class ClusterManager;
+    friend class TrackManager;
+    friend class VertexManager;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline unsigned int SpatialIndex<T>::size() const
+{
+    return m_entryVector.size();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline bool SpatialIndex<T>::empty() const
+{
+    return m_entryVector.empty();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline SpatialIndex<T>::AxisLessThan::AxisLessThan(const unsigned int axis) :
+    m_axis(axis)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline bool SpatialIndex<T>::AxisLessThan::operator()(const Entry &lhs, const Entry &rhs) const
+{
+    if ((LIST_ORDER != m_axis) && (lhs.m_position[m_axis] != rhs.m_position[m_axis]))
+        return (lhs.m_position[m_axis] < rhs.m_position[m_axis]);
+
+    return (lhs.m_listIndex < rhs.m_listIndex);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline bool SpatialIndex<T>::NeighbourLessThan::operator()(const Neighbour &lhs, const Neighbour &rhs) const
+{
+    if (lhs.first != rhs.first)
+        return (lhs.first < rhs.first);
+
+    return (lhs.second->m_listIndex < rhs.second->m_listIndex);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline unsigned int SpatialIndex<T>::GetSplitAxis(const unsigned int depth) const
+{
+    return m_splitAxes[depth % m_nSplitAxes];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline float SpatialIndex<T>::GetDistanceSquared(const Entry &entry, const float *const point)
+{
+    const float dx(entry.m_position[0] - point[0]), dy(entry.m_position[1] - point[1]), dz(entry.m_position[2] - point[2]);
+    return (dx * dx + dy * dy + dz * dz);
+}
+
+} // namespace pandora
+
+#endif // #ifndef PANDORA_SPATIAL_INDEX_H
@@ -11,10 +11,13 @@
 #include "Pandora/ObjectCreation.h"
 #include "Pandora/StatusCodes.h"
 
+#include <cstdint>
+
 namespace pandora
 {
 
 template<typename T> class InputObjectManager;
+template<typename T> class Manager;
 template<typename T, typename S> class PandoraObjectFactory;
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -25,6 +28,33 @@ template<typename T, typename S> class PandoraObjectFactory;
 class Track 
 {
 public:
+    /**
+     *  @brief  LayerIntersection class, describing the intersection of the helix at the calorimeter with a single sub detector layer
+     */
+    class LayerIntersection
+    {
+    public:
+        /**
+         *  @brief  Constructor
+         *
+         *  @param  pseudoLayer the pseudo layer of the intersection point
+         *  @param  position the intersection point, units mm
+         *  @param  genericTime the helix generic time from the track state at the calorimeter to the intersection point
+         *  @param  subDetectorType the type of the intersected sub detector
+         *  @param  layer the index of the intersected layer within the sub detector
+         */
+        LayerIntersection(const unsigned int pseudoLayer, const CartesianVector &position, const float genericTime,
+            const SubDetectorType subDetectorType, const unsigned int layer);
+
+        unsigned int            m_pseudoLayer;              ///< The pseudo layer of the intersection point
+        CartesianVector         m_position;                 ///< The intersection point, units mm
+        float                   m_genericTime;              ///< The helix generic time from the track state at the calorimeter
+        SubDetectorType         m_subDetectorType;          ///< The type of the intersected sub detector
+        unsigned int            m_layer;                    ///< The index of the intersected layer within the sub detector
+    };
+
+    typedef std::vector<LayerIntersection> LayerIntersectionVector;
+
     /**
      *  @brief  Get the 2D impact parameter wrt (0,0)
      * 
@@ -95,6 +125,36 @@ public:
      */
     const TrackState &GetTrackStateAtCalorimeter() const;
 
+    /**
+     *  @brief  Get the helix fit to the track state at the start of the track, built on first use and cached until requested
+     *          with a different bfield value
+     * 
+     *  @param  bField the bfield, units Tesla, e.g. from the bfield plugin
+     * 
+     *  @return the helix at the start of the track
+     */
+    const Helix &GetHelixAtStart(const float bField) const;
+
+    /**
+     *  @brief  Get the helix fit to the track state at the end of the track, built on first use and cached until requested
+     *          with a different bfield value
+     * 
+     *  @param  bField the bfield, units Tesla, e.g. from the bfield plugin
+     * 
+     *  @return the helix at the end of the track
+     */
+    const Helix &GetHelixAtEnd(const float bField) const;
+
+    /**
+     *  @brief  Get the helix fit to the track state at the calorimeter, built on first use and cached until requested with a
+     *          different bfield value
+     * 
+     *  @param  bField the bfield, units Tesla, e.g. from the bfield plugin
+     * 
+     *  @return the helix at the calorimeter
+     */
+    const Helix &GetHelixAtCalorimeter(const float bField) const;
+
     /**
      *  @brief  Get the (sometimes projected) time at the calorimeter
      * 
@@ -151,6 +211,13 @@ public:
      */
     const MCParticleWeightMap &GetMCParticleWeightMap() const;
 
+    /**
+     *  @brief  Get the mc particle making the largest contribution to the track, cached when the mc particles are set
+     * 
+     *  @return address of the main mc particle, nullptr if there is no contributing mc particle
+     */
+    const MCParticle *GetMainMCParticle() const;
+
     /**
      *  @brief  Get the address of the parent track in the user framework
      *
@@ -158,6 +225,28 @@ public:
      */
     const void *GetParentAddress() const;
 
+    /**
+     *  @brief  Get the id of the event, within a batch of events, to which the track belongs
+     *
+     *  @return the event id
+     */
+    unsigned int GetEventId() const;
+
+    /**
+     *  @brief  Get the dense per-event track index, assigned by the track manager at creation, for use in vector side tables.
+     *
+     *  @return the track index
+     */
+    unsigned int GetIndex() const;
+
+    /**
+     *  @brief  Get the generation of the track index, advanced whenever the index is released or the event is reset, so that the
+     *          track may be distinguished from any earlier holder of the same index
+     *
+     *  @return the index generation
+     */
+    unsigned int GetIndexGeneration() const;
+
     /**
      *  @brief  Get the parent track list
      * 
@@ -186,6 +275,13 @@ public:
      */
     bool IsAvailable() const;
 
+    /**
+     *  @brief  Get the packed sort key, precomputed from the track position at the calorimeter, for fast and deterministic sorting via the sorting helper
+     * 
+     *  @return the sort key
+     */
+    uint64_t GetSortKey() const;
+
     /**
      *  @brief  operator< sorting by position at calorimeter, then energy at the 2D distance of closest approach
      * 
@@ -195,6 +291,42 @@ public:
      */
     bool operator< (const Track &rhs) const;
 
+    /**
+     *  @brief  Get the intersections of the helix at the calorimeter with the barrel and endcap calorimeter layers, in order of pseudo
+     *          layer and then generic time. Calculated when the event is prepared, if requested in the pandora settings, and otherwise
+     *          empty.
+     * 
+     *  @return the layer intersections
+     */
+    const LayerIntersectionVector &GetLayerIntersections() const;
+
+    /**
+     *  @brief  Get the first intersection, along the helix at the calorimeter, with a layer in a specified pseudo layer
+     * 
+     *  @param  pseudoLayer the pseudo layer
+     *  @param  pLayerIntersection to receive the address of the layer intersection
+     * 
+     *  @return STATUS_CODE_SUCCESS, or STATUS_CODE_NOT_FOUND if no layer intersection has been calculated for the pseudo layer
+     */
+    StatusCode GetLayerIntersection(const unsigned int pseudoLayer, const LayerIntersection *&pLayerIntersection) const;
+
+#ifdef PANDORA_POOLED_OBJECT_ALLOCATION
+    /**
+     *  @brief  Class-specific allocation, using the track object pool
+     * 
+     *  @param  size the number of bytes requested
+     */
+    static void *operator new(std::size_t size);
+
+    /**
+     *  @brief  Class-specific deallocation, using the track object pool
+     * 
+     *  @param  pAddress the address of the memory to release
+     *  @param  size the number of bytes originally requested
+     */
+    static void operator delete(void *pAddress, std::size_t size);
+#endif
+
 protected:
     /**
      *  @brief  Constructor
@@ -234,6 +366,13 @@ protected:
      */
     StatusCode RemoveAssociatedCluster(const Cluster *const pCluster);
 
+    /**
+     *  @brief  Set the intersections of the helix at the calorimeter with the calorimeter layers
+     * 
+     *  @param  layerIntersections the layer intersections, in order of pseudo layer and then generic time
+     */
+    void SetLayerIntersections(const LayerIntersectionVector &layerIntersections);
+
     /**
      *  @brief  Add a parent track to the parent track list
      * 
@@ -262,6 +401,23 @@ protected:
      */
     void SetAvailability(bool isAvailable);
 
+    /**
+     *  @brief  Get a cached helix fit to a track state, building it if absent and discarding all cached helices if the bfield
+     *          differs from that used to build them
+     * 
+     *  @param  trackState the track state
+     *  @param  bField the bfield, units Tesla
+     *  @param  pHelix the cached helix address for the track state
+     * 
+     *  @return the helix
+     */
+    const Helix &GetHelix(const TrackState &trackState, const float bField, const Helix *&pHelix) const;
+
+    /**
+     *  @brief  Delete all cached helices
+     */
+    void ClearHelixCache() const;
+
     const float             m_d0;                       ///< The 2D impact parameter wrt (0,0), units mm
     const float             m_z0;                       ///< The z coordinate at the 2D distance of closest approach, units mm
     const int               m_particleId;               ///< The PDG code of the tracked particle
@@ -278,14 +434,25 @@ protected:
     const bool              m_canFormPfo;               ///< Whether track should form a pfo, if it has an associated cluster
     const bool              m_canFormClusterlessPfo;    ///< Whether track should form a pfo, even if it has no associated cluster
     const Cluster          *m_pAssociatedCluster;       ///< The address of an associated cluster
-    MCParticleWeightMap     m_mcParticleWeightMap;      ///< The mc particle weight map
+    MCParticleWeightMap    *m_pMCParticleWeightMap;     ///< The mc particle weight map, allocated only if there are mc particles
+    const MCParticle       *m_pMainMCParticle;          ///< The mc particle making the largest contribution, if any
     const void             *m_pParentAddress;           ///< The address of the parent track in the user framework
+    const unsigned int      m_eventId;                  ///< The id of the event, within a batch of events, to which the track belongs
+    unsigned int            m_index;                    ///< The dense per-event track index, assigned by the track manager
+    unsigned int            m_indexGeneration;          ///< The generation of the track index, as assigned
     TrackList               m_parentTrackList;          ///< The list of parent track addresses
     TrackList               m_siblingTrackList;         ///< The list of sibling track addresses
     TrackList               m_daughterTrackList;        ///< The list of daughter track addresses
     bool                    m_isAvailable;              ///< Whether the track is available to be added to a particle flow object
+    mutable const Helix    *m_pHelixAtStart;            ///< The cached helix at the start of the track, built on first use
+    mutable const Helix    *m_pHelixAtEnd;              ///< The cached helix at the end of the track, built on first use
+    mutable const Helix    *m_pHelixAtCalorimeter;      ///< The cached helix at the calorimeter, built on first use
+    mutable float           m_helixBField;              ///< The bfield used to build the cached helices, units Tesla
+    const uint64_t          m_sortKey;                  ///< The packed sort key, precomputed from the track position at the calorimeter
+    LayerIntersectionVector m_layerIntersections;       ///< The intersections of the helix at the calorimeter with the calorimeter layers
 
     friend class TrackManager;
+    friend class Manager<Track>;
     friend class InputObjectManager<Track>;
     friend class PandoraObjectFactory<object_creation::Track::Parameters, object_creation::Track::Object>;
 };
@@ -362,6 +529,27 @@ inline const TrackState &Track::GetTrackStateAtCalorimeter() const
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+inline const Helix &Track::GetHelixAtStart(const float bField) const
+{
+    return this->GetHelix(m_trackStateAtStart, bField, m_pHelixAtStart);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const Helix &Track::GetHelixAtEnd(const float bField) const
+{
+    return this->GetHelix(m_trackStateAtEnd, bField, m_pHelixAtEnd);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const Helix &Track::GetHelixAtCalorimeter(const float bField) const
+{
+    return this->GetHelix(m_trackStateAtCalorimeter, bField, m_pHelixAtCalorimeter);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 inline float Track::GetTimeAtCalorimeter() const
 {
     return m_timeAtCalorimeter;
@@ -406,7 +594,16 @@ inline bool Track::HasAssociatedCluster() const
 
 inline const MCParticleWeightMap &Track::GetMCParticleWeightMap() const
 {
-    return m_mcParticleWeightMap;
+    static const MCParticleWeightMap emptyMCParticleWeightMap;
+
+    return (m_pMCParticleWeightMap ? *m_pMCParticleWeightMap : emptyMCParticleWeightMap);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const MCParticle *Track::GetMainMCParticle() const
+{
+    return m_pMainMCParticle;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -418,6 +615,61 @@ inline const void *Track::GetParentAddress() const
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+inline unsigned int Track::GetIndex() const
+{
+    return m_index;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int Track::GetIndexGeneration() const
+{
+    return m_indexGeneration;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int Track::GetEventId() const
+{
+    return m_eventId;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline uint64_t Track::GetSortKey() const
+{
+    return m_sortKey;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const Track::LayerIntersectionVector &Track::GetLayerIntersections() const
+{
+    return m_layerIntersections;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline void Track::SetLayerIntersections(const LayerIntersectionVector &layerIntersections)
+{
+    m_layerIntersections = layerIntersections;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline Track::LayerIntersection::LayerIntersection(const unsigned int pseudoLayer, const CartesianVector &position, const float genericTime,
+        const SubDetectorType subDetectorType, const unsigned int layer) :
+    m_pseudoLayer(pseudoLayer),
+    m_position(position),
+    m_genericTime(genericTime),
+    m_subDetectorType(subDetectorType),
+    m_layer(layer)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 inline const TrackList &Track::GetParentList() const
 {
     return m_parentTrackList;
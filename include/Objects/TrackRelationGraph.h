@@ -0,0 +1,222 @@
+/**
+ *  @file   PandoraSDK/include/Objects/TrackRelationGraph.h
+ *
+ *  @brief  Header file for the track relation graph class.
+ *
+ *  $Log: $
+ */
+#ifndef PANDORA_TRACK_RELATION_GRAPH_H
+#define PANDORA_TRACK_RELATION_GRAPH_H 1
+
+#include "Pandora/PandoraInternal.h"
+#include "Pandora/StatusCodes.h"
+
+#include <unordered_map>
+
+namespace pandora
+{
+
+/**
+ *  @brief  TrackRelationGraph class, a read-only compressed sparse row copy of the track parent, daughter and sibling relationships.
+ *          Tracks are identified by their index in the input track list, and the related track indices for each track are stored
+ *          contiguously, in the same order as the corresponding track list held by the track.
+ */
+class TrackRelationGraph
+{
+public:
+    /**
+     *  @brief  Default constructor
+     */
+    TrackRelationGraph();
+
+    /**
+     *  @brief  Get the number of tracks in the graph
+     *
+     *  @return the number of tracks
+     */
+    unsigned int size() const;
+
+    /**
+     *  @brief  Whether the graph is empty
+     *
+     *  @return boolean
+     */
+    bool empty() const;
+
+    /**
+     *  @brief  Get the track vector, providing the index back to the track addresses
+     *
+     *  @return the track vector
+     */
+    const TrackVector &GetTrackVector() const;
+
+    /**
+     *  @brief  Get the index of a track in the graph
+     *
+     *  @param  pTrack address of the track
+     *  @param  index to receive the track index
+     */
+    StatusCode GetIndex(const Track *const pTrack, unsigned int &index) const;
+
+    /**
+     *  @brief  Get the number of parents of a track
+     *
+     *  @param  index the track index
+     *
+     *  @return the number of parents
+     */
+    unsigned int GetNParents(const unsigned int index) const;
+
+    /**
+     *  @brief  Get the address of the first parent index of a track, followed by the remaining GetNParents(index) - 1 parent indices
+     *
+     *  @param  index the track index
+     *
+     *  @return the address of the first parent index
+     */
+    const unsigned int *GetParents(const unsigned int index) const;
+
+    /**
+     *  @brief  Get the number of daughters of a track
+     *
+     *  @param  index the track index
+     *
+     *  @return the number of daughters
+     */
+    unsigned int GetNDaughters(const unsigned int index) const;
+
+    /**
+     *  @brief  Get the address of the first daughter index of a track, followed by the remaining GetNDaughters(index) - 1 daughter indices
+     *
+     *  @param  index the track index
+     *
+     *  @return the address of the first daughter index
+     */
+    const unsigned int *GetDaughters(const unsigned int index) const;
+
+    /**
+     *  @brief  Get the number of siblings of a track
+     *
+     *  @param  index the track index
+     *
+     *  @return the number of siblings
+     */
+    unsigned int GetNSiblings(const unsigned int index) const;
+
+    /**
+     *  @brief  Get the address of the first sibling index of a track, followed by the remaining GetNSiblings(index) - 1 sibling indices
+     *
+     *  @param  index the track index
+     *
+     *  @return the address of the first sibling index
+     */
+    const unsigned int *GetSiblings(const unsigned int index) const;
+
+private:
+    /**
+     *  @brief  Adjacency class, describing a single relation type in compressed sparse row form
+     */
+    class Adjacency
+    {
+    public:
+        UIntVector              m_offsets;              ///< The offset of the first related index for each track, plus a final end offset
+        UIntVector              m_indices;              ///< The related track indices, for all tracks
+    };
+
+    typedef std::unordered_map<const Track *, unsigned int> TrackToIndexMap;
+
+    /**
+     *  @brief  Refill the graph using the contents of a track list and the relationships held by the tracks
+     *
+     *  @param  trackList the track list
+     */
+    StatusCode Fill(const TrackList &trackList);
+
+    /**
+     *  @brief  Clear the graph
+     */
+    void Clear();
+
+    /**
+     *  @brief  Append the related track indices for a track to an adjacency
+     *
+     *  @param  relatedTrackList the list of related tracks
+     *  @param  adjacency the adjacency
+     */
+    StatusCode AddRelations(const TrackList &relatedTrackList, Adjacency &adjacency) const;
+
+    TrackVector                 m_trackVector;          ///< The track addresses
+    TrackToIndexMap             m_trackToIndexMap;      ///< The track address to index map
+    Adjacency                   m_parents;              ///< The parent relationships
+    Adjacency                   m_daughters;            ///< The daughter relationships
+    Adjacency                   m_siblings;             ///< The sibling relationships
+
+    friend class TrackManager;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int TrackRelationGraph::size() const
+{
+    return m_trackVector.size();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool TrackRelationGraph::empty() const
+{
+    return m_trackVector.empty();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const TrackVector &TrackRelationGraph::GetTrackVector() const
+{
+    return m_trackVector;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int TrackRelationGraph::GetNParents(const unsigned int index) const
+{
+    return (m_parents.m_offsets[index + 1] - m_parents.m_offsets[index]);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const unsigned int *TrackRelationGraph::GetParents(const unsigned int index) const
+{
+    return (m_parents.m_indices.data() + m_parents.m_offsets[index]);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int TrackRelationGraph::GetNDaughters(const unsigned int index) const
+{
+    return (m_daughters.m_offsets[index + 1] - m_daughters.m_offsets[index]);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const unsigned int *TrackRelationGraph::GetDaughters(const unsigned int index) const
+{
+    return (m_daughters.m_indices.data() + m_daughters.m_offsets[index]);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int TrackRelationGraph::GetNSiblings(const unsigned int index) const
+{
+    return (m_siblings.m_offsets[index + 1] - m_siblings.m_offsets[index]);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const unsigned int *TrackRelationGraph::GetSiblings(const unsigned int index) const
+{
+    return (m_siblings.m_indices.data() + m_siblings.m_offsets[index]);
+}
+
+} // namespace pandora
+
+#endif // #ifndef PANDORA_TRACK_RELATION_GRAPH_H
@@ -0,0 +1,176 @@
+/**
+ *  @file   PandoraSDK/include/Objects/TrackSelectionMasks.h
+ *
+ *  @brief  Header file for the track selection masks class.
+ *
+ *  $Log: $
+ */
+#ifndef PANDORA_TRACK_SELECTION_MASKS_H
+#define PANDORA_TRACK_SELECTION_MASKS_H 1
+
+#include "Pandora/PandoraInternal.h"
+#include "Pandora/StatusCodes.h"
+
+namespace pandora
+{
+
+/**
+ *  @brief  TrackSelectionMasks class, holding a packed word of selection flags for each input track, indexed by the dense per-event
+ *          track index. The flags are maintained by the track manager as tracks are created and as their availability and cluster
+ *          associations change, so that tracks may be selected by scanning the flag words, without dereferencing each track. The
+ *          tracks with each single flag set are additionally cached, in track index order, and refreshed on first use after a change.
+ */
+class TrackSelectionMasks
+{
+public:
+    /**
+     *  @brief  Flag enum, the track properties recorded in the flag words
+     */
+    enum Flag
+    {
+        CAN_FORM_PFO                = 1 << 0,   ///< Track::CanFormPfo
+        CAN_FORM_CLUSTERLESS_PFO    = 1 << 1,   ///< Track::CanFormClusterlessPfo
+        REACHES_CALORIMETER         = 1 << 2,   ///< Track::ReachesCalorimeter
+        IS_PROJECTED_TO_END_CAP     = 1 << 3,   ///< Track::IsProjectedToEndCap
+        IS_POSITIVELY_CHARGED       = 1 << 4,   ///< Track::GetCharge is positive
+        HAS_ASSOCIATED_CLUSTER      = 1 << 5,   ///< Track::HasAssociatedCluster
+        IS_AVAILABLE                = 1 << 6    ///< Track::IsAvailable
+    };
+
+    typedef unsigned char FlagWord;
+
+    /**
+     *  @brief  Default constructor
+     */
+    TrackSelectionMasks();
+
+    /**
+     *  @brief  Get the number of tracks
+     *
+     *  @return the number of tracks
+     */
+    unsigned int size() const;
+
+    /**
+     *  @brief  Whether there are no tracks
+     *
+     *  @return boolean
+     */
+    bool empty() const;
+
+    /**
+     *  @brief  Get the track vector, by track index, providing the index back to the track addresses
+     *
+     *  @return the track vector
+     */
+    const TrackVector &GetTrackVector() const;
+
+    /**
+     *  @brief  Get the flag words, by track index
+     *
+     *  @return the flag words
+     */
+    const std::vector<FlagWord> &GetFlagWords() const;
+
+    /**
+     *  @brief  Get the flag word of a track
+     *
+     *  @param  pTrack address of the track
+     *  @param  flagWord to receive the flag word
+     */
+    StatusCode GetFlagWord(const Track *const pTrack, FlagWord &flagWord) const;
+
+    /**
+     *  @brief  Get the tracks with all of the required flags set and none of the vetoed flags set, by scanning the flag words
+     *
+     *  @param  requiredFlags the required flags, a combination of Flag values
+     *  @param  vetoedFlags the vetoed flags, a combination of Flag values
+     *  @param  trackVector to receive the selected tracks, appended in track index order
+     */
+    void GetTracks(const FlagWord requiredFlags, const FlagWord vetoedFlags, TrackVector &trackVector) const;
+
+    /**
+     *  @brief  Get the cached vector of tracks with a single flag set, in track index order. The reference remains valid until the
+     *          end of the event, but its contents may change as the flag words are updated.
+     *
+     *  @param  flag the flag
+     *
+     *  @return the selected tracks
+     */
+    const TrackVector &GetTracks(const Flag flag) const;
+
+private:
+    /**
+     *  @brief  Add a track, recording its flags
+     *
+     *  @param  pTrack address of the track, which must have a valid index
+     */
+    void Add(const Track *const pTrack);
+
+    /**
+     *  @brief  Set or unset a flag for a track
+     *
+     *  @param  pTrack address of the track
+     *  @param  flag the flag
+     *  @param  isSet whether the flag should be set
+     */
+    void SetFlag(const Track *const pTrack, const Flag flag, const bool isSet);
+
+    /**
+     *  @brief  Clear all tracks, retaining the storage
+     */
+    void Clear();
+
+    /**
+     *  @brief  Get the position of a single flag within the flag word
+     *
+     *  @param  flag the flag
+     *
+     *  @return the flag position
+     */
+    static unsigned int GetFlagPosition(const Flag flag);
+
+    static const unsigned int N_FLAGS = 7;
+
+    typedef std::vector<FlagWord> FlagWordVector;
+    typedef std::vector<TrackVector> TrackVectorVector;
+
+    TrackVector                 m_trackVector;          ///< The tracks, by track index, null for unused indices
+    FlagWordVector              m_flagWordVector;       ///< The flag words, by track index
+    mutable TrackVectorVector   m_cachedTracks;         ///< The cached tracks with each single flag set, by flag position
+    mutable FlagWord            m_validCacheFlags;      ///< The flags for which the cached tracks are up to date
+
+    friend class TrackManager;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int TrackSelectionMasks::size() const
+{
+    return m_trackVector.size();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool TrackSelectionMasks::empty() const
+{
+    return m_trackVector.empty();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const TrackVector &TrackSelectionMasks::GetTrackVector() const
+{
+    return m_trackVector;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const std::vector<TrackSelectionMasks::FlagWord> &TrackSelectionMasks::GetFlagWords() const
+{
+    return m_flagWordVector;
+}
+
+} // namespace pandora
+
+#endif // #ifndef PANDORA_TRACK_SELECTION_MASKS_H
@@ -11,10 +11,13 @@
 #include "Pandora/ObjectCreation.h"
 #include "Pandora/StatusCodes.h"
 
+#include <limits>
+
 namespace pandora
 {
 
 template<typename T> class AlgorithmObjectManager;
+template<typename T> class Manager;
 template<typename T, typename S> class PandoraObjectFactory;
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -53,6 +56,22 @@ public:
      */
     VertexType GetVertexType() const;
 
+    /**
+     *  @brief  Get the dense per-event vertex index, assigned by the vertex manager at creation, for use in vector side tables.
+     *          The indices of deleted vertices are reused by vertices created later in the event.
+     *
+     *  @return the vertex index
+     */
+    unsigned int GetIndex() const;
+
+    /**
+     *  @brief  Get the generation of the vertex index, advanced whenever the index is released or the event is reset, so that the
+     *          vertex may be distinguished from any earlier holder of the same index
+     *
+     *  @return the index generation
+     */
+    unsigned int GetIndexGeneration() const;
+
     /**
      *  @brief  Whether the vertex is available to be added to a particle flow object
      * 
@@ -92,14 +111,36 @@ protected:
     VertexLabel             m_vertexLabel;              ///< The vertex label (interaction, start, end, etc.)
     VertexType              m_vertexType;               ///< The vertex type (3d, view u, v, w, etc.)
     bool                    m_isAvailable;              ///< Whether the track is available to be added to a particle flow object
+    unsigned int            m_index;                    ///< The dense per-event vertex index, assigned by the vertex manager
+    unsigned int            m_indexGeneration;          ///< The generation of the vertex index, as assigned
 
     friend class VertexManager;
+    friend class Manager<Vertex>;
     friend class AlgorithmObjectManager<Vertex>;
     friend class PandoraObjectFactory<object_creation::Vertex::Parameters, object_creation::Vertex::Object>;
 };
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+/**
+ *  @brief  VertexCaloHitSummary class, summarising the calo hits around a candidate vertex position, for vertex scoring
+ */
+class VertexCaloHitSummary
+{
+public:
+    /**
+     *  @brief  Default constructor
+     */
+    VertexCaloHitSummary();
+
+    unsigned int            m_nCaloHits;                ///< The number of calo hits within the summary radius
+    float                   m_inputEnergySum;           ///< The sum of the input energies of the calo hits within the summary radius
+    float                   m_distanceSum;              ///< The sum of the distances to the calo hits within the summary radius, units mm
+    float                   m_nearestDistance;          ///< The distance to the nearest calo hit, at any range, units mm
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 inline const CartesianVector &Vertex::GetPosition() const
 {
     return m_position;
@@ -128,6 +169,20 @@ inline VertexType Vertex::GetVertexType() const
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+inline unsigned int Vertex::GetIndex() const
+{
+    return m_index;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int Vertex::GetIndexGeneration() const
+{
+    return m_indexGeneration;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 inline bool Vertex::IsAvailable() const
 {
     return m_isAvailable;
@@ -140,6 +195,17 @@ inline void Vertex::SetAvailability(bool isAvailable)
     m_isAvailable = isAvailable;
 }
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline VertexCaloHitSummary::VertexCaloHitSummary() :
+    m_nCaloHits(0),
+    m_inputEnergySum(0.f),
+    m_distanceSum(0.f),
+    m_nearestDistance(std::numeric_limits<float>::max())
+{
+}
+
 } // namespace pandora
 
 #endif // #ifndef PANDORA_VERTEX_H
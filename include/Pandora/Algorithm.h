@@ -19,16 +19,83 @@ namespace pandora
  */
 class Algorithm : public Process
 {
+public:
+    /**
+     *  @brief  The object types with which an algorithm works, as flags that may be combined
+     */
+    enum ObjectType : unsigned int
+    {
+        CALO_HIT_OBJECTS = 1u << 0,
+        CLUSTER_OBJECTS = 1u << 1,
+        MC_PARTICLE_OBJECTS = 1u << 2,
+        PFO_OBJECTS = 1u << 3,
+        TRACK_OBJECTS = 1u << 4,
+        VERTEX_OBJECTS = 1u << 5,
+        ALL_OBJECTS = (1u << 6) - 1
+    };
+
+    /**
+     *  @brief  Default constructor
+     */
+    Algorithm();
+
+    /**
+     *  @brief  Whether the algorithm works with a specified object type
+     * 
+     *  @param  objectType the object type
+     * 
+     *  @return boolean
+     */
+    bool UsesObjectType(const ObjectType objectType) const;
+
 protected:
     /**
      *  @brief  Run the algorithm
      */
     virtual StatusCode Run() = 0;
 
+    /**
+     *  @brief  Declare the object types with which the algorithm works, so that only the relevant managers track each run of the
+     *          algorithm. The algorithm must not use the temporary lists or algorithm input lists of any other object type, nor
+     *          change the current lists of any other object type. Reclustering requires calo hits, clusters, pfos and tracks. By
+     *          default, an algorithm works with all object types.
+     * 
+     *  @param  usedObjectTypes the used object types, a combination of object type flags
+     */
+    StatusCode SetUsedObjectTypes(const unsigned int usedObjectTypes);
+
+private:
+    unsigned int            m_usedObjectTypes;      ///< The object types with which the algorithm works, a combination of flags
+
     friend class AlgorithmManager;
     friend class PandoraContentApiImpl;
 };
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline Algorithm::Algorithm() :
+    m_usedObjectTypes(ALL_OBJECTS)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool Algorithm::UsesObjectType(const ObjectType objectType) const
+{
+    return (0 != (m_usedObjectTypes & objectType));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline StatusCode Algorithm::SetUsedObjectTypes(const unsigned int usedObjectTypes)
+{
+    if ((0 == usedObjectTypes) || (0 != (usedObjectTypes & ~static_cast<unsigned int>(ALL_OBJECTS))))
+        return STATUS_CODE_INVALID_PARAMETER;
+
+    m_usedObjectTypes = usedObjectTypes;
+    return STATUS_CODE_SUCCESS;
+}
+
 //------------------------------------------------------------------------------------------------------------------------------------------
 //------------------------------------------------------------------------------------------------------------------------------------------
 
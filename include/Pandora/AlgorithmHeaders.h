@@ -22,14 +22,21 @@
 #include "Managers/PluginManager.h"
 
 #include "Objects/CaloHit.h"
+#include "Objects/CaloHitSnapshot.h"
+#include "Objects/CaloHitTimeIndex.h"
 #include "Objects/CartesianVector.h"
 #include "Objects/Cluster.h"
+#include "Objects/ClusterPairFinder.h"
+#include "Objects/ClusterSnapshot.h"
 #include "Objects/Helix.h"
 #include "Objects/Histograms.h"
+#include "Objects/LArTPCHitGrid.h"
 #include "Objects/MCParticle.h"
 #include "Objects/OrderedCaloHitList.h"
 #include "Objects/ParticleFlowObject.h"
+#include "Objects/SideTable.h"
 #include "Objects/Track.h"
+#include "Objects/TrackSelectionMasks.h"
 #include "Objects/TrackState.h"
 #include "Objects/Vertex.h"
 
@@ -20,6 +20,17 @@ namespace pandora
  */
 class AlgorithmTool : public Process
 {
+public:
+    /**
+     *  @brief  Whether the algorithm tool may be cloned, so that a parent algorithm can run the clones on separate worker threads.
+     *          Each clone is an independent instance, with its own settings, members and scratch arena. A cloneable tool must only
+     *          modify its own members and read the objects supplied by its parent algorithm: it must not call pandora content api
+     *          functions, or modify pandora objects, when run on a worker thread.
+     * 
+     *  @return boolean
+     */
+    virtual bool IsCloneable() const;
+
 protected:
     friend class AlgorithmManager;
 };
@@ -48,6 +59,13 @@ public:
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+inline bool AlgorithmTool::IsCloneable() const
+{
+    return false;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 inline AlgorithmToolFactory::~AlgorithmToolFactory()
 {
 }
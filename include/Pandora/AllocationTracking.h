@@ -0,0 +1,106 @@
+/**
+ *  @file   PandoraSDK/include/Pandora/AllocationTracking.h
+ *
+ *  @brief  Header file for the allocation tracking class.
+ *
+ *  $Log: $
+ */
+#ifndef PANDORA_ALLOCATION_TRACKING_H
+#define PANDORA_ALLOCATION_TRACKING_H 1
+
+#include <atomic>
+#include <cstddef>
+
+namespace pandora
+{
+
+/**
+ *  @brief  AllocationCounters class, the heap allocations attributed to a single tag, e.g. an algorithm instance
+ */
+class AllocationCounters
+{
+public:
+    /**
+     *  @brief  Default constructor
+     */
+    AllocationCounters();
+
+    std::atomic<unsigned long long>     m_nAllocations;     ///< The number of allocations
+    std::atomic<unsigned long long>     m_nBytes;           ///< The total number of bytes allocated
+    std::atomic<unsigned long long>     m_liveBytes;        ///< The number of bytes allocated and not yet freed, wherever freed
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  AllocationTracking class, attributing heap allocations to the counters set as current for the calling thread. The global
+ *          operator new and delete are replaced, only if PANDORA_ALLOCATION_TRACKING is defined, to record each allocation against
+ *          the current counters and each deallocation against the counters of the matching allocation, so that live bytes remain
+ *          correct when memory is freed by another algorithm or thread. Allocations made without current counters are not recorded.
+ */
+class AllocationTracking
+{
+public:
+    /**
+     *  @brief  Whether allocation tracking is compiled in, i.e. whether PANDORA_ALLOCATION_TRACKING is defined
+     *
+     *  @return boolean
+     */
+    static bool IsEnabled();
+
+    /**
+     *  @brief  Create a new set of counters. Counters are never freed, as memory attributed to them may outlive their users.
+     *
+     *  @return address of the new counters
+     */
+    static AllocationCounters *NewCounters();
+
+    /**
+     *  @brief  Get the counters to which allocations by the calling thread are attributed
+     *
+     *  @return address of the current counters, null if none
+     */
+    static AllocationCounters *GetCurrentCounters();
+
+    /**
+     *  @brief  Set the counters to which allocations by the calling thread are attributed
+     *
+     *  @param  pAllocationCounters address of the counters, null to stop recording allocations
+     */
+    static void SetCurrentCounters(AllocationCounters *const pAllocationCounters);
+
+    /**
+     *  @brief  Allocate memory, recording the allocation against the current counters
+     *
+     *  @param  size the number of bytes requested
+     *
+     *  @return address of the allocated memory, null on failure
+     */
+    static void *Allocate(const std::size_t size);
+
+    /**
+     *  @brief  Free memory obtained from Allocate, recording the deallocation against the counters of the allocation
+     *
+     *  @param  pAddress address of the memory, may be null
+     */
+    static void Deallocate(void *const pAddress);
+
+private:
+    /**
+     *  @brief  AllocationHeader class, stored immediately before each allocation
+     */
+    class AllocationHeader
+    {
+    public:
+        AllocationCounters     *m_pAllocationCounters;      ///< The counters of the allocation, null if not recorded
+        std::size_t             m_size;                     ///< The number of bytes requested
+    };
+
+    static const std::size_t                m_headerSize;           ///< The space reserved for the header, preserving alignment
+    static thread_local AllocationCounters *m_pCurrentCounters;     ///< The current counters for the calling thread
+};
+
+} // namespace pandora
+
+#endif // #ifndef PANDORA_ALLOCATION_TRACKING_H
@@ -0,0 +1,165 @@
+/**
+ *  @file   PandoraSDK/include/Pandora/EventPipeline.h
+ *
+ *  @brief  Header file for the event pipeline class and the event task interface.
+ *
+ *  $Log: $
+ */
+#ifndef PANDORA_EVENT_PIPELINE_H
+#define PANDORA_EVENT_PIPELINE_H 1
+
+#include "Pandora/PandoraInternal.h"
+#include "Pandora/StatusCodes.h"
+
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace pandora
+{
+
+/**
+ *  @brief  EventTask class, supplying the inputs for a single event and consuming its reconstruction output. Both methods are called
+ *          on the thread of the worker pandora instance processing the event, so the task must hold (or be able to read safely) all
+ *          the input data it needs.
+ */
+class EventTask
+{
+public:
+    /**
+     *  @brief  Destructor
+     */
+    virtual ~EventTask();
+
+    /**
+     *  @brief  Create the input objects for the event in the worker pandora instance, e.g. via PandoraApi::CaloHit::Create
+     *
+     *  @param  pandora the worker pandora instance
+     */
+    virtual StatusCode CreateInputs(const Pandora &pandora) = 0;
+
+    /**
+     *  @brief  Consume the reconstruction output for the event. The pfos are owned by the worker pandora instance and are released
+     *          when this method returns, so any required information must be copied.
+     *
+     *  @param  pandora the worker pandora instance
+     *  @param  pfoList the current pfo list
+     */
+    virtual StatusCode ProcessOutput(const Pandora &pandora, const PfoList &pfoList) = 0;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  EventPipeline class, processing submitted events asynchronously on a set of worker pandora instances, each with its own
+ *          thread. Events are queued in submission order and taken by the first free worker, so outputs may complete out of order.
+ *          Submission only holds a lock to append to the queue, so a host i/o thread can feed events without waiting for reconstruction.
+ */
+class EventPipeline
+{
+public:
+    typedef std::vector<const Pandora*> PandoraVector;
+
+    /**
+     *  @brief  Constructor, starting a thread for each worker pandora instance
+     *
+     *  @param  workerPandoraVector the worker pandora instances, fully configured by the client and not owned by the pipeline. Each
+     *          worker thread is pinned to the core set in the settings of its pandora instance.
+     */
+    EventPipeline(const PandoraVector &workerPandoraVector);
+
+    /**
+     *  @brief  Destructor, processing any queued events then stopping the worker threads
+     */
+    ~EventPipeline();
+
+    /**
+     *  @brief  Deleted copy constructor
+     */
+    EventPipeline(const EventPipeline &) = delete;
+
+    /**
+     *  @brief  Deleted assignment operator
+     */
+    EventPipeline &operator=(const EventPipeline &) = delete;
+
+    /**
+     *  @brief  Submit an event for processing. The worker pandora instance is reset after the output has been consumed, whether or
+     *          not the event succeeded.
+     *
+     *  @param  pEventTask address of the event task, ownership of which is taken by the pipeline
+     *
+     *  @return the future status code of the event, the first failure of input creation, event processing and output consumption
+     */
+    std::future<StatusCode> SubmitEvent(EventTask *const pEventTask);
+
+    /**
+     *  @brief  Get the number of worker pandora instances
+     *
+     *  @return the number of worker pandora instances
+     */
+    unsigned int GetNWorkers() const;
+
+private:
+    /**
+     *  @brief  QueuedEvent class, an event task awaiting processing, with the promise of its status code
+     */
+    class QueuedEvent
+    {
+    public:
+        /**
+         *  @brief  Constructor
+         *
+         *  @param  pEventTask address of the event task
+         */
+        QueuedEvent(EventTask *const pEventTask);
+
+        EventTask                  *m_pEventTask;       ///< The address of the event task, owned by the pipeline
+        std::promise<StatusCode>    m_promise;          ///< The promise of the event status code
+    };
+
+    typedef std::deque<QueuedEvent> QueuedEventDeque;
+    typedef std::vector<std::thread> ThreadVector;
+
+    /**
+     *  @brief  Process a single event in a worker pandora instance, converting any exception into a status code
+     *
+     *  @param  pandora the worker pandora instance
+     *  @param  eventTask the event task
+     */
+    static StatusCode ProcessEvent(const Pandora &pandora, EventTask &eventTask);
+
+    /**
+     *  @brief  Process queued events in a worker pandora instance until the pipeline is stopped and the queue is empty
+     *
+     *  @param  pPandora address of the worker pandora instance
+     */
+    void RunWorker(const Pandora *const pPandora);
+
+    QueuedEventDeque            m_queuedEvents;         ///< The events awaiting processing, in submission order
+    ThreadVector                m_threadVector;         ///< The worker threads, one per worker pandora instance
+    bool                        m_shouldStop;           ///< Whether the worker threads have been asked to stop
+    std::mutex                  m_mutex;                ///< The mutex protecting the queue and flags
+    std::condition_variable     m_condition;            ///< The condition variable signalling changes to the queue and flags
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int EventPipeline::GetNWorkers() const
+{
+    return m_threadVector.size();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline EventPipeline::QueuedEvent::QueuedEvent(EventTask *const pEventTask) :
+    m_pEventTask(pEventTask)
+{
+}
+
+} // namespace pandora
+
+#endif // #ifndef PANDORA_EVENT_PIPELINE_H
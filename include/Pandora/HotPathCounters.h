@@ -0,0 +1,171 @@
+/**
+ *  @file   PandoraSDK/include/Pandora/HotPathCounters.h
+ *
+ *  @brief  Header file defining counters for expensive manager operations and relevant preprocessor macros
+ *
+ *  $Log: $
+ */
+#ifndef PANDORA_HOT_PATH_COUNTERS_H
+#define PANDORA_HOT_PATH_COUNTERS_H 1
+
+#include <iostream>
+#include <string>
+
+/**
+ *  @brief  Increment a hot path counter for the calling thread, compiled out unless PANDORA_HOT_PATH_COUNTERS is defined
+ */
+#ifdef PANDORA_HOT_PATH_COUNTERS
+    #define PANDORA_INCREMENT_HOT_PATH_COUNTER(Counter) pandora::HotPathCounters::Increment(pandora::Counter)
+#else
+    #define PANDORA_INCREMENT_HOT_PATH_COUNTER(Counter)
+#endif
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+namespace pandora
+{
+
+#define HOT_PATH_COUNTER_TABLE(d)                                                                       \
+    d(HOT_PATH_GET_LIST,                    "GetList"                               )                   \
+    d(HOT_PATH_SAVE_OBJECTS,                "SaveObjects"                           )                   \
+    d(HOT_PATH_CREATE_TEMPORARY_LIST,       "CreateTemporaryList"                   )                   \
+    d(HOT_PATH_MERGE_AND_DELETE_CLUSTERS,   "MergeAndDeleteClusters"                )                   \
+    d(HOT_PATH_RECLUSTER_IS_AVAILABLE,      "ReclusterIsAvailable"                  )                   \
+    d(HOT_PATH_FRAGMENT_CALO_HIT,           "FragmentCaloHit"                       )                   \
+    d(HOT_PATH_MERGE_CALO_HIT_FRAGMENTS,    "MergeCaloHitFragments"                 )
+
+/**
+ *  @brief  The hot path counter enum entry macro
+ */
+#define GET_HOT_PATH_COUNTER_ENUM_ENTRY(a, b)                                                           \
+    a,
+
+/**
+ *  @brief  The hot path counter name switch statement macro
+ */
+#define GET_HOT_PATH_COUNTER_NAME_SWITCH(a, b)                                                          \
+    case a : return b;
+
+/**
+ *  @brief  The HotPathCounter enum
+ */
+enum HotPathCounter
+{
+    HOT_PATH_COUNTER_TABLE(GET_HOT_PATH_COUNTER_ENUM_ENTRY)
+    NUMBER_OF_HOT_PATH_COUNTERS
+};
+
+/**
+ *  @brief  Get hot path counter as a string
+ *
+ *  @return The hot path counter string
+ */
+std::string HotPathCounterToString(const HotPathCounter hotPathCounter);
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  HotPathCounters class, holding a separate set of counters for each thread. As each pandora instance is driven by a
+ *          single thread, the counters for a thread describe the operations performed by the instance running on that thread.
+ */
+class HotPathCounters
+{
+public:
+    /**
+     *  @brief  Increment a counter for the calling thread
+     *
+     *  @param  hotPathCounter the counter
+     */
+    static void Increment(const HotPathCounter hotPathCounter);
+
+    /**
+     *  @brief  Get the value of a counter for the calling thread
+     *
+     *  @param  hotPathCounter the counter
+     *
+     *  @return the counter value
+     */
+    static unsigned long long GetCount(const HotPathCounter hotPathCounter);
+
+    /**
+     *  @brief  Print the values of all counters for the calling thread
+     *
+     *  @param  label a label to accompany the printout, e.g. the name of the pandora instance
+     */
+    static void Print(const std::string &label);
+
+    /**
+     *  @brief  Reset all counters for the calling thread
+     */
+    static void Reset();
+
+private:
+    /**
+     *  @brief  Get the counters for the calling thread
+     *
+     *  @return the counters for the calling thread
+     */
+    static unsigned long long *GetThreadCounters();
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline void HotPathCounters::Increment(const HotPathCounter hotPathCounter)
+{
+    ++HotPathCounters::GetThreadCounters()[hotPathCounter];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned long long HotPathCounters::GetCount(const HotPathCounter hotPathCounter)
+{
+    return HotPathCounters::GetThreadCounters()[hotPathCounter];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline void HotPathCounters::Print(const std::string &label)
+{
+    std::cout << "Hot path counters, " << label << std::endl;
+
+    for (unsigned int i = 0; i < NUMBER_OF_HOT_PATH_COUNTERS; ++i)
+    {
+        const HotPathCounter hotPathCounter(static_cast<HotPathCounter>(i));
+        std::cout << "    " << HotPathCounterToString(hotPathCounter) << ": " << HotPathCounters::GetCount(hotPathCounter) << std::endl;
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline void HotPathCounters::Reset()
+{
+    unsigned long long *const pThreadCounters(HotPathCounters::GetThreadCounters());
+
+    for (unsigned int i = 0; i < NUMBER_OF_HOT_PATH_COUNTERS; ++i)
+        pThreadCounters[i] = 0;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned long long *HotPathCounters::GetThreadCounters()
+{
+    thread_local unsigned long long threadCounters[NUMBER_OF_HOT_PATH_COUNTERS] = {};
+    return threadCounters;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline std::string HotPathCounterToString(const HotPathCounter hotPathCounter)
+{
+    switch (hotPathCounter)
+    {
+        HOT_PATH_COUNTER_TABLE(GET_HOT_PATH_COUNTER_NAME_SWITCH)
+        default : return "UNKNOWN";
+    }
+}
+
+} // namespace pandora
+
+#endif // #ifndef PANDORA_HOT_PATH_COUNTERS_H
@@ -0,0 +1,218 @@
+/**
+ *  @file   PandoraSDK/include/Pandora/LArTPCSubEventAlgorithm.h
+ *
+ *  @brief  Header file for the lar tpc sub event algorithm class.
+ *
+ *  $Log: $
+ */
+#ifndef LAR_TPC_SUB_EVENT_ALGORITHM_H
+#define LAR_TPC_SUB_EVENT_ALGORITHM_H 1
+
+#include "Objects/CartesianVector.h"
+
+#include "Pandora/ExternallyConfiguredAlgorithm.h"
+#include "Pandora/ThreadPool.h"
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  LArTPCSubEventAlgorithm class. Partitions the current calo hit list by lar tpc volume and processes each partition as a
+ *          sub event in a worker pandora instance, with the workers running in parallel on the pandora thread pool. Each worker is
+ *          configured by the client, sharing the geometry of this instance, with the algorithm sub chain to run for each lar tpc.
+ *          The clusters, vertices and pfos produced by the workers are then recreated in this instance, from the original calo hits,
+ *          and saved in named lists ready for cross-tpc stitching.
+ */
+class LArTPCSubEventAlgorithm : public pandora::ExternallyConfiguredAlgorithm
+{
+public:
+    /**
+     *  @brief  Factory class for instantiating algorithm
+     */
+    class Factory : public pandora::AlgorithmFactory
+    {
+    public:
+        pandora::Algorithm *CreateAlgorithm() const;
+    };
+
+    typedef std::vector<const pandora::Pandora*> PandoraVector;
+
+    /**
+     *  @brief  External lar tpc sub event parameters class
+     */
+    class ExternalLArTPCSubEventParameters : public pandora::ExternalParameters
+    {
+    public:
+        PandoraVector           m_workerPandoraVector;          ///< The worker pandora instances, each sharing the geometry of this instance
+    };
+
+    /**
+     *  @brief  Default constructor
+     */
+    LArTPCSubEventAlgorithm();
+
+private:
+    /**
+     *  @brief  ClusterRecord class, describing a cluster produced by a worker in terms of the original calo hits
+     */
+    class ClusterRecord
+    {
+    public:
+        pandora::CaloHitList    m_caloHitList;                  ///< The original calo hits in the cluster
+        pandora::CaloHitList    m_isolatedCaloHitList;          ///< The original isolated calo hits in the cluster
+        int                     m_particleId;                   ///< The cluster particle id
+    };
+
+    /**
+     *  @brief  VertexRecord class, describing a vertex produced by a worker
+     */
+    class VertexRecord
+    {
+    public:
+        /**
+         *  @brief  Constructor
+         *
+         *  @param  pVertex address of the worker vertex
+         */
+        VertexRecord(const pandora::Vertex *const pVertex);
+
+        pandora::CartesianVector m_position;                    ///< The vertex position, including any x0 shift, units mm
+        float                   m_x0;                           ///< The vertex x0 shift, units mm
+        pandora::VertexLabel    m_vertexLabel;                  ///< The vertex label
+        pandora::VertexType     m_vertexType;                   ///< The vertex type
+    };
+
+    /**
+     *  @brief  PfoRecord class, describing a pfo produced by a worker, with its clusters, vertices and daughters given as indices
+     *          into the records of the same sub event
+     */
+    class PfoRecord
+    {
+    public:
+        /**
+         *  @brief  Constructor
+         *
+         *  @param  pPfo address of the worker pfo
+         */
+        PfoRecord(const pandora::ParticleFlowObject *const pPfo);
+
+        int                     m_particleId;                   ///< The pfo particle id
+        int                     m_charge;                       ///< The pfo charge
+        float                   m_mass;                         ///< The pfo mass, units GeV
+        float                   m_energy;                       ///< The pfo energy, units GeV
+        pandora::CartesianVector m_momentum;                    ///< The pfo momentum, units GeV
+        pandora::PropertiesMap  m_propertiesMap;                ///< The pfo properties
+        pandora::UIntVector     m_clusterIndices;               ///< The indices of the pfo cluster records
+        pandora::UIntVector     m_vertexIndices;                ///< The indices of the pfo vertex records
+        pandora::UIntVector     m_daughterIndices;              ///< The indices of the daughter pfo records
+    };
+
+    typedef std::vector<ClusterRecord> ClusterRecordVector;
+    typedef std::vector<VertexRecord> VertexRecordVector;
+    typedef std::vector<PfoRecord> PfoRecordVector;
+
+    /**
+     *  @brief  SubEvent class, describing the input calo hits and reconstruction output for a single lar tpc
+     */
+    class SubEvent
+    {
+    public:
+        /**
+         *  @brief  Constructor
+         *
+         *  @param  pLArTPC address of the lar tpc
+         */
+        SubEvent(const pandora::LArTPC *const pLArTPC);
+
+        const pandora::LArTPC  *m_pLArTPC;                      ///< The address of the lar tpc
+        pandora::CaloHitList    m_caloHitList;                  ///< The original calo hits within the lar tpc volume
+        ClusterRecordVector     m_clusterRecords;               ///< The cluster records
+        VertexRecordVector      m_vertexRecords;                ///< The vertex records
+        PfoRecordVector         m_pfoRecords;                   ///< The pfo records
+    };
+
+    typedef std::vector<SubEvent> SubEventVector;
+
+    /**
+     *  @brief  SubEventTask class, processing all the sub events assigned to a single worker, in turn. Each item writes only to the
+     *          records of its own sub events and uses only its own worker pandora instance.
+     */
+    class SubEventTask : public pandora::ParallelForTask
+    {
+    public:
+        /**
+         *  @brief  Constructor
+         *
+         *  @param  algorithm the lar tpc sub event algorithm
+         *  @param  subEventVector the sub events
+         */
+        SubEventTask(const LArTPCSubEventAlgorithm &algorithm, SubEventVector &subEventVector);
+
+        pandora::StatusCode Run(const unsigned int index) const;
+
+    private:
+        const LArTPCSubEventAlgorithm  &m_algorithm;            ///< The lar tpc sub event algorithm
+        SubEventVector                 &m_subEventVector;       ///< The sub events
+    };
+
+    pandora::StatusCode Run();
+
+    /**
+     *  @brief  Partition the current calo hits by lar tpc volume. Calo hits outside all lar tpc volumes are not processed.
+     *
+     *  @param  subEventVector to receive the sub events, in order of lar tpc volume id
+     */
+    pandora::StatusCode PartitionCaloHits(SubEventVector &subEventVector) const;
+
+    /**
+     *  @brief  Process a sub event in a worker pandora instance, recording the reconstruction output. The worker is always reset.
+     *
+     *  @param  workerPandora the worker pandora instance
+     *  @param  subEvent the sub event
+     */
+    pandora::StatusCode ProcessSubEvent(const pandora::Pandora &workerPandora, SubEvent &subEvent) const;
+
+    /**
+     *  @brief  Create the worker calo hits for a sub event, each addressing the original calo hit as its parent
+     *
+     *  @param  workerPandora the worker pandora instance
+     *  @param  subEvent the sub event
+     */
+    pandora::StatusCode CreateWorkerCaloHits(const pandora::Pandora &workerPandora, const SubEvent &subEvent) const;
+
+    /**
+     *  @brief  Record the clusters, vertices and pfos produced by a worker pandora instance
+     *
+     *  @param  workerPandora the worker pandora instance
+     *  @param  subEvent the sub event, to receive the records
+     */
+    pandora::StatusCode RecordWorkerOutput(const pandora::Pandora &workerPandora, SubEvent &subEvent) const;
+
+    /**
+     *  @brief  Recreate the recorded clusters, vertices and pfos for a sub event in this pandora instance
+     *
+     *  @param  subEvent the sub event
+     *  @param  clusterListName the temporary cluster list name, set on first use
+     *  @param  vertexListName the temporary vertex list name, set on first use
+     *  @param  pfoListName the temporary pfo list name, set on first use
+     */
+    pandora::StatusCode CreateOutput(const SubEvent &subEvent, std::string &clusterListName, std::string &vertexListName,
+        std::string &pfoListName) const;
+
+    pandora::StatusCode ReadSettings(const pandora::TiXmlHandle xmlHandle);
+
+    PandoraVector               m_workerPandoraVector;          ///< The worker pandora instances, not owned
+    std::string                 m_workerClusterListName;        ///< The name of the worker cluster list to return, in addition to pfo clusters
+    std::string                 m_workerPfoListName;            ///< The name of the worker pfo list to return, or empty for the current list
+    std::string                 m_outputClusterListName;        ///< The name under which to save the returned clusters
+    std::string                 m_outputVertexListName;         ///< The name under which to save the returned vertices
+    std::string                 m_outputPfoListName;            ///< The name under which to save the returned pfos
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline pandora::Algorithm *LArTPCSubEventAlgorithm::Factory::CreateAlgorithm() const
+{
+    return new LArTPCSubEventAlgorithm();
+}
+
+#endif // #ifndef LAR_TPC_SUB_EVENT_ALGORITHM_H
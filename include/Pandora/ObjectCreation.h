@@ -38,6 +38,7 @@ public:
     typedef PARAMETERS Parameters;
     typedef METADATA Metadata;
     typedef OBJECT Object;
+    typedef std::vector<PARAMETERS> ParametersVector;
 
     /**
      *  @brief  Create a new object from a user factory
@@ -49,6 +50,18 @@ public:
     static pandora::StatusCode Create(const pandora::Pandora &pandora, const Parameters &parameters,
         const pandora::ObjectFactory<Parameters, Object> &factory = pandora::PandoraObjectFactory<Parameters, Object>());
 
+    /**
+     *  @brief  Create a batch of new objects from a user factory. For calo hits, tracks, mc particles and geometry objects, the objects
+     *          are registered together and either all objects are created or none are, with any geometry lookup structures built once
+     *          for the batch. Other objects are created one at a time, in order.
+     *
+     *  @param  pandora the pandora instance to create the new objects
+     *  @param  parametersVector the parameters for each object
+     *  @param  factory the factory that performs the object allocation
+     */
+    static pandora::StatusCode Create(const pandora::Pandora &pandora, const ParametersVector &parametersVector,
+        const pandora::ObjectFactory<Parameters, Object> &factory = pandora::PandoraObjectFactory<Parameters, Object>());
+
     /**
      *  @brief  Create a new object from a user factory, receiving the address of the object created
      *
@@ -137,6 +150,7 @@ public:
     pandora::InputUInt                  m_layer;                    ///< The subdetector readout layer number
     pandora::InputBool                  m_isInOuterSamplingLayer;   ///< Whether cell is in one of the outermost detector sampling layers
     pandora::InputAddress               m_pParentAddress;           ///< Address of the parent calo hit in the user framework
+    pandora::InputUInt                  m_eventId;                  ///< Optional id of the event within a batch of events, default 0
 };
 
 typedef ObjectCreationHelper<CaloHitParameters, CaloHitMetadata, pandora::CaloHit> CaloHit;
@@ -156,6 +170,7 @@ public:
     pandora::InputInt                   m_particleId;               ///< The MC particle's ID (PDG code)
     pandora::InputMCParticleType        m_mcParticleType;           ///< The type of mc particle, e.g. vertex, 2D-projection, etc.
     pandora::InputAddress               m_pParentAddress;           ///< Address of the parent MC particle in the user framework
+    pandora::InputUInt                  m_eventId;                  ///< Optional id of the event within a batch of events, default 0
 };
 
 typedef ObjectCreationHelper<MCParticleParameters, ObjectMetadata, pandora::MCParticle> MCParticle;
@@ -183,6 +198,7 @@ public:
     pandora::InputBool                  m_canFormPfo;               ///< Whether track should form a pfo, if it has an associated cluster
     pandora::InputBool                  m_canFormClusterlessPfo;    ///< Whether track should form a pfo, even if it has no associated cluster
     pandora::InputAddress               m_pParentAddress;           ///< Address of the parent track in the user framework
+    pandora::InputUInt                  m_eventId;                  ///< Optional id of the event within a batch of events, default 0
 };
 
 typedef ObjectCreationHelper<TrackParameters, ObjectMetadata, pandora::Track> Track;
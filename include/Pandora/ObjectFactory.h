@@ -16,6 +16,8 @@ namespace pandora
 class FileReader;
 class FileWriter;
 
+template <typename PARAMETERS, typename OBJECT> class PandoraObjectFactory;
+
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 /**
@@ -61,7 +63,21 @@ public:
      */
     virtual StatusCode Write(const Object *const pObject, FileWriter &fileWriter) const = 0;
 
+    /**
+     *  @brief  Whether this is the default pandora object factory, which reads, writes and creates only the base object parameters
+     *
+     *  @return boolean
+     */
+    bool IsDefaultFactory() const;
+
 protected:
+    /**
+     *  @brief  Constructor, for use by the default pandora object factory
+     * 
+     *  @param  isDefaultFactory whether this is the default pandora object factory
+     */
+    ObjectFactory(const bool isDefaultFactory);
+
     /**
      *  @brief  Create an object with the given parameters
      *
@@ -70,6 +86,17 @@ protected:
      */
     virtual StatusCode Create(const Parameters &parameters, const Object *&pObject) const = 0;
 
+    /**
+     *  @brief  Create an object with the given parameters, bypassing the virtual dispatch if this is the default pandora object
+     *          factory. Defined in PandoraObjectFactories.h.
+     *
+     *  @param  parameters the parameters to pass in constructor
+     *  @param  pObject to receive the address of the object created
+     */
+    StatusCode CreateObject(const Parameters &parameters, const Object *&pObject) const;
+
+    const bool  m_isDefaultFactory;     ///< Whether this is the default pandora object factory, whose creation path can be inlined
+
     friend class CaloHitManager;
     friend class TrackManager;
     friend class MCManager;
@@ -82,7 +109,16 @@ protected:
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 template <typename PARAMETERS, typename OBJECT>
-inline ObjectFactory<PARAMETERS, OBJECT>::ObjectFactory()
+inline ObjectFactory<PARAMETERS, OBJECT>::ObjectFactory() :
+    m_isDefaultFactory(false)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename PARAMETERS, typename OBJECT>
+inline ObjectFactory<PARAMETERS, OBJECT>::ObjectFactory(const bool isDefaultFactory) :
+    m_isDefaultFactory(isDefaultFactory)
 {
 }
 
@@ -93,6 +129,14 @@ inline ObjectFactory<PARAMETERS, OBJECT>::~ObjectFactory()
 {
 }
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename PARAMETERS, typename OBJECT>
+inline bool ObjectFactory<PARAMETERS, OBJECT>::IsDefaultFactory() const
+{
+    return m_isDefaultFactory;
+}
+
 } // namespace pandora
 
 #endif // #ifndef PANDORA_OBJECT_FACTORY_H
@@ -0,0 +1,158 @@
+/**
+ *  @file   PandoraSDK/include/Pandora/ObjectPool.h
+ *
+ *  @brief  Header file for the object pool class.
+ *
+ *  $Log: $
+ */
+#ifndef PANDORA_OBJECT_POOL_H
+#define PANDORA_OBJECT_POOL_H 1
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace pandora
+{
+
+/**
+ *  @brief  ObjectPool class, a per-type slab allocator with a free list, used to back class-specific operator new and operator delete.
+ *          Memory released by deleted objects is recycled for the next objects created (e.g. in the next event), rather than being
+ *          returned to the heap. Requests for any other size (e.g. derived types created by custom object factories) use the heap.
+ */
+template <typename T>
+class ObjectPool
+{
+public:
+    /**
+     *  @brief  Allocate memory for a single object
+     *
+     *  @param  size the number of bytes requested
+     *
+     *  @return the address of the allocated memory
+     */
+    static void *Allocate(const std::size_t size);
+
+    /**
+     *  @brief  Release memory for a single object
+     *
+     *  @param  pAddress the address of the memory to release
+     *  @param  size the number of bytes originally requested
+     */
+    static void Deallocate(void *const pAddress, const std::size_t size);
+
+private:
+    /**
+     *  @brief  Slot union, holding either an object or a link in the free list
+     */
+    union Slot
+    {
+        Slot                       *m_pNextFreeSlot;        ///< The address of the next free slot
+        alignas(T) unsigned char    m_storage[sizeof(T)];   ///< The object storage
+    };
+
+    typedef std::vector<Slot*> SlabList;
+
+    /**
+     *  @brief  Default constructor
+     */
+    ObjectPool();
+
+    /**
+     *  @brief  Get the object pool instance for this type, which is deliberately never destroyed, so that objects may safely be released
+     *          during static destruction
+     *
+     *  @return the object pool instance
+     */
+    static ObjectPool &GetInstance();
+
+    /**
+     *  @brief  Allocate a new slab and add its slots to the free list
+     */
+    void AddSlab();
+
+    static const std::size_t    m_nSlotsPerSlab = 1024; ///< The number of slots per slab
+
+    std::mutex                  m_mutex;                ///< The mutex protecting the free list
+    Slot                       *m_pFreeSlot;            ///< The address of the first free slot
+    SlabList                    m_slabList;             ///< The list of slabs
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline void *ObjectPool<T>::Allocate(const std::size_t size)
+{
+    if (sizeof(T) != size)
+        return ::operator new(size);
+
+    ObjectPool &objectPool(ObjectPool::GetInstance());
+    std::lock_guard<std::mutex> lock(objectPool.m_mutex);
+
+    if (nullptr == objectPool.m_pFreeSlot)
+        objectPool.AddSlab();
+
+    Slot *const pSlot(objectPool.m_pFreeSlot);
+    objectPool.m_pFreeSlot = pSlot->m_pNextFreeSlot;
+
+    return pSlot;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline void ObjectPool<T>::Deallocate(void *const pAddress, const std::size_t size)
+{
+    if (nullptr == pAddress)
+        return;
+
+    if (sizeof(T) != size)
+    {
+        ::operator delete(pAddress);
+        return;
+    }
+
+    ObjectPool &objectPool(ObjectPool::GetInstance());
+    std::lock_guard<std::mutex> lock(objectPool.m_mutex);
+
+    Slot *const pSlot(static_cast<Slot*>(pAddress));
+    pSlot->m_pNextFreeSlot = objectPool.m_pFreeSlot;
+    objectPool.m_pFreeSlot = pSlot;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline ObjectPool<T>::ObjectPool() :
+    m_pFreeSlot(nullptr)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline ObjectPool<T> &ObjectPool<T>::GetInstance()
+{
+    static ObjectPool *const pObjectPool(new ObjectPool);
+    return *pObjectPool;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline void ObjectPool<T>::AddSlab()
+{
+    Slot *const pSlab(static_cast<Slot*>(::operator new(m_nSlotsPerSlab * sizeof(Slot))));
+    m_slabList.push_back(pSlab);
+
+    for (std::size_t iSlot = m_nSlotsPerSlab; iSlot > 0; --iSlot)
+    {
+        pSlab[iSlot - 1].m_pNextFreeSlot = m_pFreeSlot;
+        m_pFreeSlot = &pSlab[iSlot - 1];
+    }
+}
+
+} // namespace pandora
+
+#endif // #ifndef PANDORA_OBJECT_POOL_H
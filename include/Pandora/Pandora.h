@@ -28,6 +28,8 @@ class PandoraSettings;
 class ParticleFlowObjectManager;
 class ParticleIdPlugin;
 class PluginManager;
+class ProfileManager;
+class ThreadPool;
 class TrackManager;
 class VertexManager;
 
@@ -46,6 +48,17 @@ public:
      */
     Pandora(const std::string &name = "");
 
+    /**
+     *  @brief  Constructor, for an instance with its own event state that shares the (read-only) geometry of an existing instance.
+     *          Geometry must be fully registered with the existing instance before this constructor is called and the existing
+     *          instance must outlive this instance. Attempts to register geometry with this instance will return not allowed.
+     *          Each instance still owns its algorithms and plugins, so one instance may process events on each thread.
+     *
+     *  @param  geometryPandora the existing pandora instance, which owns the geometry
+     *  @param  name descriptive name or label for the pandora instance
+     */
+    Pandora(const Pandora &geometryPandora, const std::string &name);
+
     /**
      *  @brief  Destructor
      */
@@ -94,6 +107,14 @@ public:
     const std::string &GetName() const;
 
 private:
+    /**
+     *  @brief  Constructor
+     *
+     *  @param  pSharedGeometryManager address of a geometry manager to share, or nullptr to create and own a new geometry manager
+     *  @param  name descriptive name or label for the pandora instance
+     */
+    Pandora(const GeometryManager *const pSharedGeometryManager, const std::string &name);
+
     /**
      *  @brief  Prepare event, calculating properties of input objects for later use in algorithms
      */
@@ -109,20 +130,33 @@ private:
      */
     StatusCode ResetEvent();
 
+    /**
+     *  @brief  Reset window, retiring calo hits older than the next window and carrying over the remainder, then resetting all other
+     *          event content
+     * 
+     *  @param  windowStartTime the start time of the next window, units ns
+     */
+    StatusCode ResetWindow(const float windowStartTime);
+
     /**
      *  @brief  Read pandora settings
      * 
      *  @param  xmlFileName the name of the xml file containing the settings
+     *  @param  settingsCacheFileName the name of a settings cache file, holding a binary image of the settings which is used whilst the
+     *          xml file is unchanged and otherwise rewritten, or empty to always parse the xml file
      */
-    StatusCode ReadSettings(const std::string &xmlFileName);
+    StatusCode ReadSettings(const std::string &xmlFileName, const std::string &settingsCacheFileName);
 
     AlgorithmManager            *m_pAlgorithmManager;           ///< The algorithm manager
     CaloHitManager              *m_pCaloHitManager;             ///< The hit manager
     ClusterManager              *m_pClusterManager;             ///< The cluster manager
-    GeometryManager             *m_pGeometryManager;            ///< The geometry manager
+    GeometryManager             *m_pGeometryManager;            ///< The geometry manager, owned by this instance (nullptr if shared)
+    const GeometryManager       *m_pGeometry;                   ///< The geometry manager used by this instance, either owned or shared
     MCManager                   *m_pMCManager;                  ///< The MC manager
     ParticleFlowObjectManager   *m_pPfoManager;                 ///< The particle flow object manager
     PluginManager               *m_pPluginManager;              ///< The pandora plugin manager
+    ProfileManager              *m_pProfileManager;             ///< The algorithm profile manager
+    ThreadPool                  *m_pThreadPool;                 ///< The thread pool for parallel loops within algorithms
     TrackManager                *m_pTrackManager;               ///< The track manager
     VertexManager               *m_pVertexManager;              ///< The vertex manager
 
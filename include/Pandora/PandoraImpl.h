@@ -8,6 +8,8 @@
 #ifndef PANDORA_IMPL_H
 #define PANDORA_IMPL_H 1
 
+#include "Pandora/ThreadPool.h"
+
 namespace pandora
 {
 
@@ -18,11 +20,49 @@ class PandoraImpl
 {
 private:
     /**
-     *  @brief  Prepare mc particles: select mc pfo targets, match tracks and calo hits to the correct mc
-     *          particles for particle flow
+     *  @brief  PreparationTask class, running one of the independent input object preparation stages
+     */
+    class PreparationTask : public ParallelForTask
+    {
+    public:
+        /**
+         *  @brief  Constructor
+         *
+         *  @param  pandoraImpl the pandora impl object providing the preparation stages
+         */
+        PreparationTask(const PandoraImpl &pandoraImpl);
+
+        StatusCode Run(const unsigned int index) const;
+
+    private:
+        const PandoraImpl  &m_pandoraImpl;                  ///< The pandora impl object providing the preparation stages
+    };
+
+    /**
+     *  @brief  Prepare the input mc particles, tracks and calo hits. The stages for each object type touch only their own manager,
+     *          so run concurrently on the pandora thread pool, before the mc pfo targets are matched to the tracks and calo hits.
+     *          Content plugins are not required to be thread-safe, so the calo hit energy corrections are made afterwards, on the
+     *          calling thread.
+     */
+    StatusCode PrepareInputObjects() const;
+
+    /**
+     *  @brief  Prepare mc particles: add mc particle relationships and identify mc pfo targets
      */
     StatusCode PrepareMCParticles() const;
 
+    /**
+     *  @brief  Match tracks and calo hits to the correct mc particles for particle flow and select mc pfo targets, once the
+     *          mc particles, tracks and calo hits have all been prepared
+     */
+    StatusCode MatchMCPfoTargets() const;
+
+    /**
+     *  @brief  Calculate the intersections of the input tracks with the calorimeter layers, if requested in the pandora settings, once
+     *          the tracks have been prepared
+     */
+    StatusCode CalculateTrackLayerIntersections() const;
+
     /**
      *  @brief  Prepare tracks: add track associations (parent-daughter and sibling)
      */
@@ -48,6 +88,13 @@ private:
      */
     StatusCode RunAlgorithm(const std::string &algorithmName) const;
 
+    /**
+     *  @brief  Whether the per-event object budget of any object manager has been exceeded, during the current event
+     * 
+     *  @return boolean
+     */
+    bool IsObjectBudgetExceeded() const;
+
     /**
      *  @brief  Initialize pandora settings
      * 
@@ -70,10 +117,33 @@ private:
     StatusCode InitializePlugins(const TiXmlHandle *const pXmlHandle) const;
 
     /**
-     *  @brief  Ï event, calling manager reset functions and any registered reset functions
+     *  @brief  Reset event, calling manager reset functions and any registered reset functions
      */
     StatusCode ResetEvent() const;
 
+    /**
+     *  @brief  Reset window, retiring calo hits older than the next window, carrying over the remainder, and otherwise calling the
+     *          manager reset functions as for the end of an event
+     * 
+     *  @param  windowStartTime the start time of the next window, units ns
+     */
+    StatusCode ResetWindow(const float windowStartTime) const;
+
+    /**
+     *  @brief  Print the end of event summaries requested in the pandora settings
+     */
+    StatusCode PrintEventSummaries() const;
+
+    /**
+     *  @brief  Call the reset functions of all managers other than the calo hit manager
+     */
+    StatusCode ResetNonCaloHitManagers() const;
+
+    /**
+     *  @brief  Append the input calo hits, tracks and mc particles for the current event, with their relationships, to the slow event file
+     */
+    StatusCode WriteSlowEvent() const;
+
     /**
      *  @brief  Constructor
      * 
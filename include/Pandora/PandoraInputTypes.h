@@ -68,7 +68,15 @@ public:
     const T &Get() const;
 
     /**
-     *  @brief  Reset the pandora type
+     *  @brief  Get the value held by the pandora type, without checking that it has been initialized. For use only once the value is
+     *          known to be initialized; in debug builds the check is retained, as in Get.
+     *
+     *  @return the value
+     */
+    const T &GetUnchecked() const;
+
+    /**
+     *  @brief  Reset the pandora type, retaining any allocated storage for reuse
      */   
     void Reset();
 
@@ -174,13 +182,19 @@ inline PandoraInputType<T>::PandoraInputType(const PandoraInputType<T> &rhs) :
 template <typename T>
 inline void PandoraInputType<T>::Set(const T &t)
 {
-    if (m_isInitialized)
-        delete m_pValue;
-
     if (!this->IsValid(t))
         throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
 
-    m_pValue = new T(t);
+    // ATTN Storage is retained across resets, so a reused pandora type need not reallocate
+    if (nullptr != m_pValue)
+    {
+        *m_pValue = t;
+    }
+    else
+    {
+        m_pValue = new T(t);
+    }
+
     m_isInitialized = true;
 }
 
@@ -198,13 +212,21 @@ inline const T &PandoraInputType<T>::Get() const
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 template <typename T>
-inline void PandoraInputType<T>::Reset()
+inline const T &PandoraInputType<T>::GetUnchecked() const
 {
-    if (nullptr != m_pValue)
-        delete m_pValue;
+#ifndef NDEBUG
+    return this->Get();
+#else
+    return *m_pValue;
+#endif
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
 
+template <typename T>
+inline void PandoraInputType<T>::Reset()
+{
     m_isInitialized = false;
-    m_pValue = nullptr;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
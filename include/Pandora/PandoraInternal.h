@@ -9,15 +9,21 @@
 #define PANDORA_INTERNAL_H 1
 
 #include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <initializer_list>
 #include <iostream>
 #include <iomanip>
 #include <list>
 #include <map>
 #include <set>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace pandora
@@ -28,29 +34,54 @@ class AlgorithmTool;
 class BFieldPlugin;
 class BoxGap;
 class CaloHit;
+class CaloHitEnergyCorrectionPlugin;
+class CaloHitNeighbourGraph;
+class CaloHitSnapshot;
+class CaloHitSpan;
+class CaloHitTimeIndex;
 class CartesianVector;
 class Cluster;
+class ClusterPairFinder;
+class ClusterProperties;
+class ClusterSnapshot;
 class ConcentricGap;
 class DetectorGap;
 class EnergyCorrectionPlugin;
 class ExternalParameters;
 class Helix;
 class Histogram;
+class HistogramFillShards;
 class LArTPC;
+class LArTPCHitGrid;
 class LArTransformationPlugin;
 class LineGap;
 class MCParticle;
+class ManagerCheckpoint;
 class OrderedCaloHitList;
 class ParticleFlowObject;
 class ParticleIdPlugin;
+class PfoHierarchy;
+class PfoExportTable;
 class PandoraSettings;
 class PseudoLayerPlugin;
+class ScratchArena;
 class ShowerProfilePlugin;
 class SubDetector;
 class Track;
+class TrackRelationGraph;
+class TrackSelectionMasks;
 class TrackState;
 class TwoDHistogram;
+class TwoDHistogramFillShards;
 class Vertex;
+class VertexCaloHitSummary;
+
+template <typename T, typename V> class SideTable;
+template <typename T> class SpatialIndex;
+typedef SpatialIndex<CaloHit> CaloHitSpatialIndex;
+typedef SpatialIndex<Track> TrackSpatialIndex;
+typedef SpatialIndex<Cluster> ClusterSpatialIndex;
+typedef SpatialIndex<Vertex> VertexSpatialIndex;
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
@@ -93,12 +124,166 @@ inline bool StringToType(const std::string &s, T &t)
     return !(iss >> t).fail();
 }
 
+/**
+ *  @brief  Get the start of the number in a string, skipping leading whitespace and a leading '+' sign, as for stream extraction
+ *
+ *  @param  s the string
+ *
+ *  @return the address of the first character of the number
+ */
+inline const char *GetNumberStart(const std::string &s)
+{
+    const char *pChar(s.data());
+    const char *const pEnd(s.data() + s.size());
+
+    while ((pChar != pEnd) && ((' ' == *pChar) || (('\t' <= *pChar) && ('\r' >= *pChar))))
+        ++pChar;
+
+    if ((pChar != pEnd) && ('+' == *pChar) && (pChar + 1 != pEnd) && ('-' != *(pChar + 1)))
+        ++pChar;
+
+    return pChar;
+}
+
+/**
+ *  @brief  Convert a string to an integer without constructing a stream, accepting and rejecting the same strings as stream extraction
+ *
+ *  @param  s the string
+ *  @param  t to receive the integer
+ *
+ *  @return whether the conversion was successful
+ */
+template <class T>
+inline bool StringToInteger(const std::string &s, T &t)
+{
+    const char *pBegin(GetNumberStart(s));
+    const char *const pEnd(s.data() + s.size());
+
+    // ATTN Stream extraction accepts a minus sign for unsigned types, negating the value within the unsigned type
+    const bool isNegated(std::is_unsigned<T>::value && (pBegin != pEnd) && ('-' == *pBegin));
+
+    if (isNegated)
+        ++pBegin;
+
+    T value(0);
+
+    if (std::errc() != std::from_chars(pBegin, pEnd, value).ec)
+        return false;
+
+    t = isNegated ? static_cast<T>(0 - value) : value;
+    return true;
+}
+
+/**
+ *  @brief  Convert a string to a floating point number without constructing a stream, accepting and rejecting the same strings as
+ *          stream extraction. Infinities, nans and incomplete exponents are rejected, whilst out of range values are handed to stream
+ *          extraction, which accepts underflows.
+ *
+ *  @param  s the string
+ *  @param  t to receive the floating point number
+ *
+ *  @return whether the conversion was successful
+ */
+template <class T>
+inline bool StringToFloatingPoint(const std::string &s, T &t)
+{
+    const char *const pBegin(GetNumberStart(s));
+    const char *const pEnd(s.data() + s.size());
+    const char *const pDigits(((pBegin != pEnd) && ('-' == *pBegin)) ? pBegin + 1 : pBegin);
+
+    if ((pDigits == pEnd) || (('.' != *pDigits) && (('0' > *pDigits) || ('9' < *pDigits))))
+        return false;
+
+    T value(0);
+    const std::from_chars_result result(std::from_chars(pBegin, pEnd, value));
+
+    if (std::errc::result_out_of_range == result.ec)
+    {
+        std::istringstream iss(s);
+        return !(iss >> t).fail();
+    }
+
+    if ((std::errc() != result.ec) || ((result.ptr != pEnd) && (('e' == *result.ptr) || ('E' == *result.ptr))))
+        return false;
+
+    t = value;
+    return true;
+}
+
+template <>
+inline bool StringToType(const std::string &s, short &t)
+{
+    return StringToInteger(s, t);
+}
+
+template <>
+inline bool StringToType(const std::string &s, unsigned short &t)
+{
+    return StringToInteger(s, t);
+}
+
+template <>
+inline bool StringToType(const std::string &s, int &t)
+{
+    return StringToInteger(s, t);
+}
+
+template <>
+inline bool StringToType(const std::string &s, unsigned int &t)
+{
+    return StringToInteger(s, t);
+}
+
+template <>
+inline bool StringToType(const std::string &s, long &t)
+{
+    return StringToInteger(s, t);
+}
+
+template <>
+inline bool StringToType(const std::string &s, unsigned long &t)
+{
+    return StringToInteger(s, t);
+}
+
+template <>
+inline bool StringToType(const std::string &s, long long &t)
+{
+    return StringToInteger(s, t);
+}
+
+template <>
+inline bool StringToType(const std::string &s, unsigned long long &t)
+{
+    return StringToInteger(s, t);
+}
+
+template <>
+inline bool StringToType(const std::string &s, float &t)
+{
+    return StringToFloatingPoint(s, t);
+}
+
+template <>
+inline bool StringToType(const std::string &s, double &t)
+{
+    return StringToFloatingPoint(s, t);
+}
+
 template <>
 inline bool StringToType(const std::string &s, const void *&t)
 {
-    uintptr_t address;
-    std::istringstream iss(s);
-    iss >> std::hex >> address;
+    const char *pBegin(GetNumberStart(s));
+    const char *const pEnd(s.data() + s.size());
+
+    if ((pEnd - pBegin > 2) && ('0' == pBegin[0]) && (('x' == pBegin[1]) || ('X' == pBegin[1])))
+        pBegin += 2;
+
+    uintptr_t address(0);
+
+    if (std::errc() != std::from_chars(pBegin, pEnd, address, 16).ec)
+        return false;
+
     t = reinterpret_cast<const void*>(address);
     return true;
 }
@@ -170,14 +355,30 @@ inline bool PointerLessThan<T>::operator()(const T *lhs, const T *rhs) const
 //------------------------------------------------------------------------------------------------------------------------------------------
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+// ATTN The duplicate check follows the PANDORA_DUPLICATE_CHECKED_MANAGED_CONTAINER build option alone, exported in the package configuration,
+// never NDEBUG, so that clients built in any mode agree with the library on the behaviour of MyList
+#ifdef PANDORA_MYLIST_DUPLICATE_CHECK
+    #error "PANDORA_MYLIST_DUPLICATE_CHECK is set by the PANDORA_DUPLICATE_CHECKED_MANAGED_CONTAINER build option and must not be defined"
+#endif
+
+#ifdef PANDORA_DUPLICATE_CHECKED_MANAGED_CONTAINER
+    #define PANDORA_MYLIST_DUPLICATE_CHECK 1
+#else
+    #define PANDORA_MYLIST_DUPLICATE_CHECK 0
+#endif
+
 /**
- *  @brief  Wrapper around std::list
+ *  @brief  Wrapper around std::list, checking for insertion of duplicate entries. Membership is tracked in a companion hash set, so
+ *          that each check is O(1). The check is enabled in builds with PANDORA_DUPLICATE_CHECKED_MANAGED_CONTAINER, in which MyList
+ *          backs the managed object lists, and otherwise the set is left empty. The set is a member in either case, so the class
+ *          layout does not depend on the check.
  */
 template <typename T>
 class MyList
 {
 public:
     typedef typename std::list<T> TheList;
+    typedef typename std::unordered_set<T> TheSet;
     typedef typename TheList::const_iterator const_iterator;
     typedef typename TheList::const_iterator iterator;
     typedef typename TheList::value_type value_type;
@@ -247,6 +448,14 @@ public:
      */
     iterator erase(const_iterator position);
 
+    /**
+     *  @brief  insert
+     * 
+     *  @param  position
+     *  @param  val
+     */
+    iterator insert(const_iterator position, const value_type &val);
+
     /**
      *  @brief  insert
      * 
@@ -286,6 +495,7 @@ public:
 
 private:
     TheList     m_theList;      ///< The list
+    TheSet      m_theSet;       ///< The set of list members, for duplicate checking, empty if the check is disabled
 };
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -299,7 +509,8 @@ inline MyList<T>::MyList()
 
 template <typename T>
 inline MyList<T>::MyList(const MyList &rhs) :
-    m_theList(rhs.m_theList)
+    m_theList(rhs.m_theList),
+    m_theSet(rhs.m_theSet)
 {
 }
 
@@ -309,6 +520,9 @@ template <typename T>
 inline MyList<T>::MyList(size_t n, const value_type &val) :
     m_theList(n, val)
 {
+#if PANDORA_MYLIST_DUPLICATE_CHECK
+    m_theSet.insert(m_theList.begin(), m_theList.end());
+#endif
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -318,6 +532,9 @@ template <class InputIterator>
 inline MyList<T>::MyList(InputIterator first, InputIterator last) :
     m_theList(first, last)
 {
+#if PANDORA_MYLIST_DUPLICATE_CHECK
+    m_theSet.insert(m_theList.begin(), m_theList.end());
+#endif
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -333,6 +550,7 @@ template <typename T>
 inline void MyList<T>::operator= (const MyList &rhs)
 {
     m_theList = rhs.m_theList;
+    m_theSet = rhs.m_theSet;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -356,11 +574,13 @@ inline typename MyList<T>::const_iterator MyList<T>::end() const
 template <typename T>
 inline void MyList<T>::push_back(const value_type &val)
 {
-    if (m_theList.end() != std::find(m_theList.begin(), m_theList.end(), val))
+#if PANDORA_MYLIST_DUPLICATE_CHECK
+    if (!m_theSet.insert(val).second)
     {
         std::cout << "push_back duplicate, in file:     " << __FILE__ << " line#: " << __LINE__ << std::endl;
         throw;
     }
+#endif
 
     m_theList.push_back(val);
 }
@@ -370,24 +590,48 @@ inline void MyList<T>::push_back(const value_type &val)
 template <typename T>
 inline typename MyList<T>::iterator MyList<T>::erase(const_iterator position)
 {
+#if PANDORA_MYLIST_DUPLICATE_CHECK
+    m_theSet.erase(*position);
+#endif
+
     return m_theList.erase(position);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+template <typename T>
+inline typename MyList<T>::iterator MyList<T>::insert(const_iterator position, const value_type &val)
+{
+#if PANDORA_MYLIST_DUPLICATE_CHECK
+    if (!m_theSet.insert(val).second)
+    {
+        std::cout << "insert duplicate, in file:     " << __FILE__ << " line#: " << __LINE__ << std::endl;
+        throw;
+    }
+#endif
+
+    return m_theList.insert(position, val);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 template <typename T>
 template <class InputIterator>
 inline void MyList<T>::insert(const_iterator position, InputIterator first, InputIterator last)
 {
+#if PANDORA_MYLIST_DUPLICATE_CHECK
     for (InputIterator iter = first; iter != last; ++iter)
     {
-        if (m_theList.end() != std::find(m_theList.begin(), m_theList.end(), *iter))
+        if (m_theSet.count(*iter))
         {
             std::cout << "insert duplicate, in file:     " << __FILE__ << " line#: " << __LINE__ << std::endl;
             throw;
         }
     }
 
+    m_theSet.insert(first, last);
+#endif
+
     m_theList.insert(position, first, last);
 }
 
@@ -422,64 +666,1397 @@ template <typename T>
 inline void MyList<T>::clear()
 {
     m_theList.clear();
+#if PANDORA_MYLIST_DUPLICATE_CHECK
+    m_theSet.clear();
+#endif
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-#define MANAGED_CONTAINER std::list
+/**
+ *  @brief  Contiguous storage, wrapping std::vector, offering the subset of the std::list interface relied upon by the managed lists
+ */
+template <typename T>
+class ContiguousList
+{
+public:
+    typedef typename std::vector<T> TheVector;
+    typedef typename TheVector::value_type value_type;
+    typedef typename TheVector::size_type size_type;
+    typedef typename TheVector::reference reference;
+    typedef typename TheVector::const_reference const_reference;
+    typedef typename TheVector::iterator iterator;
+    typedef typename TheVector::const_iterator const_iterator;
+    typedef typename TheVector::reverse_iterator reverse_iterator;
+    typedef typename TheVector::const_reverse_iterator const_reverse_iterator;
 
-typedef MANAGED_CONTAINER<const CaloHit *> CaloHitList;
-typedef MANAGED_CONTAINER<const Cluster *> ClusterList;
-typedef MANAGED_CONTAINER<const DetectorGap *> DetectorGapList;
-typedef MANAGED_CONTAINER<const LArTPC *> LArTPCList;
-typedef MANAGED_CONTAINER<const MCParticle *> MCParticleList;
-typedef MANAGED_CONTAINER<const ParticleFlowObject *> ParticleFlowObjectList;
-typedef MANAGED_CONTAINER<const ParticleFlowObject *> PfoList;
-typedef MANAGED_CONTAINER<const SubDetector *> SubDetectorList;
-typedef MANAGED_CONTAINER<const Track *> TrackList;
-typedef MANAGED_CONTAINER<const Vertex *> VertexList;
+    /**
+     *  @brief  Default constructor
+     */
+    ContiguousList();
 
-typedef std::vector<const CaloHit *> CaloHitVector;
-typedef std::vector<const Cluster *> ClusterVector;
-typedef std::vector<const DetectorGap *> DetectorGapVector;
-typedef std::vector<const LArTPC *> LArTPCVector;
-typedef std::vector<const MCParticle *> MCParticleVector;
-typedef std::vector<const ParticleFlowObject *> ParticleFlowObjectVector;
-typedef std::vector<const ParticleFlowObject *> PfoVector;
-typedef std::vector<const SubDetector *> SubDetectorVector;
-typedef std::vector<const Track *> TrackVector;
-typedef std::vector<const Vertex *> VertexVector;
+    /**
+     *  @brief  Constructor
+     * 
+     *  @param  n
+     *  @param  val
+     */
+    explicit ContiguousList(size_type n, const value_type &val = value_type());
 
-typedef std::unordered_set<const CaloHit *> CaloHitSet;
-typedef std::unordered_set<const Cluster *> ClusterSet;
-typedef std::unordered_set<const DetectorGap *> DetectorGapSet;
-typedef std::unordered_set<const LArTPC *> LArTPCSet;
-typedef std::unordered_set<const MCParticle *> MCParticleSet;
-typedef std::unordered_set<const ParticleFlowObject *> ParticleFlowObjectSet;
-typedef std::unordered_set<const ParticleFlowObject *> PfoSet;
-typedef std::unordered_set<const SubDetector *> SubDetectorSet;
-typedef std::unordered_set<const Track *> TrackSet;
-typedef std::unordered_set<const Vertex *> VertexSet;
+    /**
+     *  @brief  Constructor
+     * 
+     *  @param  first
+     *  @param  last
+     */
+    template <class InputIterator>
+    ContiguousList(InputIterator first, InputIterator last);
 
-typedef std::vector<int> IntVector;
-typedef std::vector<float> FloatVector;
-typedef std::vector<std::string> StringVector;
-typedef std::vector<CartesianVector> CartesianPointVector;
-typedef std::vector<TrackState> TrackStateVector;
-typedef std::vector<AlgorithmTool *> AlgorithmToolVector;
+    /**
+     *  @brief  Constructor
+     * 
+     *  @param  init
+     */
+    ContiguousList(std::initializer_list<value_type> init);
 
-typedef const void * Uid;
-typedef std::unordered_map<Uid, const MCParticle *> UidToMCParticleMap;
-typedef std::unordered_map<const MCParticle *, float> MCParticleWeightMap;
-typedef std::unordered_map<Uid, MCParticleWeightMap> UidToMCParticleWeightMap;
-typedef std::unordered_map<const Cluster *, const Track * > ClusterToTrackMap;
-typedef std::unordered_map<const Track *, const Cluster * > TrackToClusterMap;
+    /**
+     *  @brief  begin, end, rbegin, rend
+     */
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+    const_iterator cbegin() const;
+    const_iterator cend() const;
+    reverse_iterator rbegin();
+    reverse_iterator rend();
+    const_reverse_iterator rbegin() const;
+    const_reverse_iterator rend() const;
 
-typedef std::set<std::string> StringSet;
-typedef std::map<std::string, float> PropertiesMap;
-typedef std::map<std::string, const SubDetector *> SubDetectorMap;
-typedef std::map<unsigned int, const LArTPC *> LArTPCMap;
+    /**
+     *  @brief  front, back
+     */
+    reference front();
+    reference back();
+    const_reference front() const;
+    const_reference back() const;
+
+    /**
+     *  @brief  push_back
+     * 
+     *  @param  val
+     */
+    void push_back(const value_type &val);
+
+    /**
+     *  @brief  push_front, linear in the number of elements
+     * 
+     *  @param  val
+     */
+    void push_front(const value_type &val);
+
+    /**
+     *  @brief  pop_back
+     */
+    void pop_back();
+
+    /**
+     *  @brief  pop_front, linear in the number of elements
+     */
+    void pop_front();
+
+    /**
+     *  @brief  insert
+     * 
+     *  @param  position
+     *  @param  val
+     */
+    iterator insert(const_iterator position, const value_type &val);
+
+    /**
+     *  @brief  insert
+     * 
+     *  @param  position
+     *  @param  first
+     *  @param  last
+     */
+    template <class InputIterator>
+    iterator insert(const_iterator position, InputIterator first, InputIterator last);
+
+    /**
+     *  @brief  erase
+     * 
+     *  @param  position
+     */
+    iterator erase(const_iterator position);
+
+    /**
+     *  @brief  erase
+     * 
+     *  @param  first
+     *  @param  last
+     */
+    iterator erase(const_iterator first, const_iterator last);
+
+    /**
+     *  @brief  remove all elements equal to the specified value
+     * 
+     *  @param  val
+     */
+    void remove(const value_type &val);
+
+    /**
+     *  @brief  sort, stable, to match std::list::sort
+     */
+    void sort();
+
+    /**
+     *  @brief  sort, stable, to match std::list::sort
+     * 
+     *  @param  comp
+     */
+    template <class Compare>
+    void sort(Compare comp);
+
+    /**
+     *  @brief  reserve capacity (no equivalent in std::list)
+     * 
+     *  @param  n
+     */
+    void reserve(size_type n);
+
+    /**
+     *  @brief  size
+     * 
+     *  @return size
+     */
+    size_type size() const;
+
+    /**
+     *  @brief  empty
+     * 
+     *  @return boolean
+     */
+    bool empty() const;
+
+    /**
+     *  @brief  clear
+     */
+    void clear();
+
+    /**
+     *  @brief  swap
+     * 
+     *  @param  rhs
+     */
+    void swap(ContiguousList &rhs);
+
+    /**
+     *  @brief  operator==
+     * 
+     *  @param  rhs
+     */
+    bool operator== (const ContiguousList &rhs) const;
+
+    /**
+     *  @brief  operator!=
+     * 
+     *  @param  rhs
+     */
+    bool operator!= (const ContiguousList &rhs) const;
+
+private:
+    TheVector   m_theVector;    ///< The vector
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline ContiguousList<T>::ContiguousList()
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline ContiguousList<T>::ContiguousList(size_type n, const value_type &val) :
+    m_theVector(n, val)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+template <class InputIterator>
+inline ContiguousList<T>::ContiguousList(InputIterator first, InputIterator last) :
+    m_theVector(first, last)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline ContiguousList<T>::ContiguousList(std::initializer_list<value_type> init) :
+    m_theVector(init)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline typename ContiguousList<T>::iterator ContiguousList<T>::begin()
+{
+    return m_theVector.begin();
+}
+
+template <typename T>
+inline typename ContiguousList<T>::iterator ContiguousList<T>::end()
+{
+    return m_theVector.end();
+}
+
+template <typename T>
+inline typename ContiguousList<T>::const_iterator ContiguousList<T>::begin() const
+{
+    return m_theVector.begin();
+}
+
+template <typename T>
+inline typename ContiguousList<T>::const_iterator ContiguousList<T>::end() const
+{
+    return m_theVector.end();
+}
+
+template <typename T>
+inline typename ContiguousList<T>::const_iterator ContiguousList<T>::cbegin() const
+{
+    return m_theVector.cbegin();
+}
+
+template <typename T>
+inline typename ContiguousList<T>::const_iterator ContiguousList<T>::cend() const
+{
+    return m_theVector.cend();
+}
+
+template <typename T>
+inline typename ContiguousList<T>::reverse_iterator ContiguousList<T>::rbegin()
+{
+    return m_theVector.rbegin();
+}
+
+template <typename T>
+inline typename ContiguousList<T>::reverse_iterator ContiguousList<T>::rend()
+{
+    return m_theVector.rend();
+}
+
+template <typename T>
+inline typename ContiguousList<T>::const_reverse_iterator ContiguousList<T>::rbegin() const
+{
+    return m_theVector.rbegin();
+}
+
+template <typename T>
+inline typename ContiguousList<T>::const_reverse_iterator ContiguousList<T>::rend() const
+{
+    return m_theVector.rend();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline typename ContiguousList<T>::reference ContiguousList<T>::front()
+{
+    return m_theVector.front();
+}
+
+template <typename T>
+inline typename ContiguousList<T>::reference ContiguousList<T>::back()
+{
+    return m_theVector.back();
+}
+
+template <typename T>
+inline typename ContiguousList<T>::const_reference ContiguousList<T>::front() const
+{
+    return m_theVector.front();
+}
+
+template <typename T>
+inline typename ContiguousList<T>::const_reference ContiguousList<T>::back() const
+{
+    return m_theVector.back();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline void ContiguousList<T>::push_back(const value_type &val)
+{
+    m_theVector.push_back(val);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline void ContiguousList<T>::push_front(const value_type &val)
+{
+    m_theVector.insert(m_theVector.begin(), val);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline void ContiguousList<T>::pop_back()
+{
+    m_theVector.pop_back();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline void ContiguousList<T>::pop_front()
+{
+    m_theVector.erase(m_theVector.begin());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline typename ContiguousList<T>::iterator ContiguousList<T>::insert(const_iterator position, const value_type &val)
+{
+    return m_theVector.insert(position, val);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+template <class InputIterator>
+inline typename ContiguousList<T>::iterator ContiguousList<T>::insert(const_iterator position, InputIterator first, InputIterator last)
+{
+    return m_theVector.insert(position, first, last);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline typename ContiguousList<T>::iterator ContiguousList<T>::erase(const_iterator position)
+{
+    return m_theVector.erase(position);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline typename ContiguousList<T>::iterator ContiguousList<T>::erase(const_iterator first, const_iterator last)
+{
+    return m_theVector.erase(first, last);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline void ContiguousList<T>::remove(const value_type &val)
+{
+    m_theVector.erase(std::remove(m_theVector.begin(), m_theVector.end(), val), m_theVector.end());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline void ContiguousList<T>::sort()
+{
+    std::stable_sort(m_theVector.begin(), m_theVector.end());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+template <class Compare>
+inline void ContiguousList<T>::sort(Compare comp)
+{
+    std::stable_sort(m_theVector.begin(), m_theVector.end(), comp);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline void ContiguousList<T>::reserve(size_type n)
+{
+    m_theVector.reserve(n);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline typename ContiguousList<T>::size_type ContiguousList<T>::size() const
+{
+    return m_theVector.size();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline bool ContiguousList<T>::empty() const
+{
+    return m_theVector.empty();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline void ContiguousList<T>::clear()
+{
+    m_theVector.clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline void ContiguousList<T>::swap(ContiguousList &rhs)
+{
+    m_theVector.swap(rhs.m_theVector);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline bool ContiguousList<T>::operator== (const ContiguousList &rhs) const
+{
+    return (m_theVector == rhs.m_theVector);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline bool ContiguousList<T>::operator!= (const ContiguousList &rhs) const
+{
+    return (m_theVector != rhs.m_theVector);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Small map, holding up to N (key, value) pairs inline and spilling to the heap beyond that, offering the subset of the
+ *          std::unordered_map interface relied upon by the mc particle weight maps. Lookup is a linear search and entries are held
+ *          in insertion order. Unlike std::unordered_map, insertion and erasure invalidate references to existing entries.
+ */
+template <typename KEY, typename VALUE, unsigned int N>
+class SmallMap
+{
+public:
+    typedef KEY key_type;
+    typedef VALUE mapped_type;
+    typedef std::pair<KEY, VALUE> value_type;
+    typedef std::size_t size_type;
+    typedef value_type *iterator;
+    typedef const value_type *const_iterator;
+
+    static_assert(N > 0, "SmallMap requires a non-zero inline capacity");
+    static_assert(std::is_trivially_copyable<KEY>::value && std::is_trivially_copyable<VALUE>::value, "SmallMap requires trivially copyable types");
+
+    /**
+     *  @brief  Default constructor
+     */
+    SmallMap();
+
+    /**
+     *  @brief  Copy constructor
+     * 
+     *  @param  rhs
+     */
+    SmallMap(const SmallMap &rhs);
+
+    /**
+     *  @brief  Move constructor
+     * 
+     *  @param  rhs
+     */
+    SmallMap(SmallMap &&rhs);
+
+    /**
+     *  @brief  Destructor
+     */
+    ~SmallMap();
+
+    /**
+     *  @brief  Copy assignment operator
+     * 
+     *  @param  rhs
+     */
+    SmallMap &operator= (const SmallMap &rhs);
+
+    /**
+     *  @brief  Move assignment operator
+     * 
+     *  @param  rhs
+     */
+    SmallMap &operator= (SmallMap &&rhs);
+
+    /**
+     *  @brief  begin, end
+     */
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+    const_iterator cbegin() const;
+    const_iterator cend() const;
+
+    /**
+     *  @brief  find
+     * 
+     *  @param  key
+     */
+    iterator find(const key_type &key);
+    const_iterator find(const key_type &key) const;
+
+    /**
+     *  @brief  count
+     * 
+     *  @param  key
+     */
+    size_type count(const key_type &key) const;
+
+    /**
+     *  @brief  at, throwing std::out_of_range if the key is not present
+     * 
+     *  @param  key
+     */
+    mapped_type &at(const key_type &key);
+    const mapped_type &at(const key_type &key) const;
+
+    /**
+     *  @brief  operator[], inserting a value-initialized entry if the key is not present
+     * 
+     *  @param  key
+     */
+    mapped_type &operator[] (const key_type &key);
+
+    /**
+     *  @brief  insert
+     * 
+     *  @param  val
+     */
+    std::pair<iterator, bool> insert(const value_type &val);
+
+    /**
+     *  @brief  erase, preserving the order of the remaining entries
+     * 
+     *  @param  position
+     */
+    iterator erase(const_iterator position);
+
+    /**
+     *  @brief  erase, preserving the order of the remaining entries
+     * 
+     *  @param  key
+     */
+    size_type erase(const key_type &key);
+
+    /**
+     *  @brief  reserve capacity
+     * 
+     *  @param  n
+     */
+    void reserve(size_type n);
+
+    /**
+     *  @brief  size
+     * 
+     *  @return size
+     */
+    size_type size() const;
+
+    /**
+     *  @brief  empty
+     * 
+     *  @return boolean
+     */
+    bool empty() const;
+
+    /**
+     *  @brief  clear, retaining any heap storage
+     */
+    void clear();
+
+    /**
+     *  @brief  swap
+     * 
+     *  @param  rhs
+     */
+    void swap(SmallMap &rhs);
+
+    /**
+     *  @brief  operator==, independent of entry order
+     * 
+     *  @param  rhs
+     */
+    bool operator== (const SmallMap &rhs) const;
+
+    /**
+     *  @brief  operator!=, independent of entry order
+     * 
+     *  @param  rhs
+     */
+    bool operator!= (const SmallMap &rhs) const;
+
+private:
+    /**
+     *  @brief  Take ownership of the entries of another small map, which is left empty. This map must be empty and inline.
+     * 
+     *  @param  rhs
+     */
+    void MoveFrom(SmallMap &rhs);
+
+    value_type      m_inlineEntries[N];     ///< The inline entries, used until the capacity exceeds N
+    value_type     *m_pHeapEntries;         ///< The heap entries, nullptr while the entries are held inline
+    unsigned int    m_size;                 ///< The number of entries
+    unsigned int    m_capacity;             ///< The current capacity
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename KEY, typename VALUE, unsigned int N>
+inline SmallMap<KEY, VALUE, N>::SmallMap() :
+    m_pHeapEntries(nullptr),
+    m_size(0),
+    m_capacity(N)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename KEY, typename VALUE, unsigned int N>
+inline SmallMap<KEY, VALUE, N>::SmallMap(const SmallMap &rhs) :
+    m_pHeapEntries(nullptr),
+    m_size(0),
+    m_capacity(N)
+{
+    *this = rhs;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename KEY, typename VALUE, unsigned int N>
+inline SmallMap<KEY, VALUE, N>::SmallMap(SmallMap &&rhs) :
+    m_pHeapEntries(nullptr),
+    m_size(0),
+    m_capacity(N)
+{
+    this->MoveFrom(rhs);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename KEY, typename VALUE, unsigned int N>
+inline SmallMap<KEY, VALUE, N>::~SmallMap()
+{
+    delete [] m_pHeapEntries;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename KEY, typename VALUE, unsigned int N>
+inline SmallMap<KEY, VALUE, N> &SmallMap<KEY, VALUE, N>::operator= (const SmallMap &rhs)
+{
+    if (this != &rhs)
+    {
+        m_size = 0;
+        this->reserve(rhs.m_size);
+        std::copy(rhs.begin(), rhs.end(), this->begin());
+        m_size = rhs.m_size;
+    }
+
+    return *this;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename KEY, typename VALUE, unsigned int N>
+inline SmallMap<KEY, VALUE, N> &SmallMap<KEY, VALUE, N>::operator= (SmallMap &&rhs)
+{
+    if (this != &rhs)
+    {
+        delete [] m_pHeapEntries;
+        m_pHeapEntries = nullptr;
+        m_size = 0;
+        m_capacity = N;
+        this->MoveFrom(rhs);
+    }
+
+    return *this;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename KEY, typename VALUE, unsigned int N>
+inline typename SmallMap<KEY, VALUE, N>::iterator SmallMap<KEY, VALUE, N>::begin()
+{
+    return (m_pHeapEntries ? m_pHeapEntries : m_inlineEntries);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename KEY, typename VALUE, unsigned int N>
+inline typename SmallMap<KEY, VALUE, N>::iterator SmallMap<KEY, VALUE, N>::end()
+{
+    return (this->begin() + m_size);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename KEY, typename VALUE, unsigned int N>
+inline typename SmallMap<KEY, VALUE, N>::const_iterator SmallMap<KEY, VALUE, N>::begin() const
+{
+    return (m_pHeapEntries ? m_pHeapEntries : m_inlineEntries);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename KEY, typename VALUE, unsigned int N>
+inline typename SmallMap<KEY, VALUE, N>::const_iterator SmallMap<KEY, VALUE, N>::end() const
+{
+    return (this->begin() + m_size);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename KEY, typename VALUE, unsigned int N>
+inline typename SmallMap<KEY, VALUE, N>::const_iterator SmallMap<KEY, VALUE, N>::cbegin() const
+{
+    return this->begin();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename KEY, typename VALUE, unsigned int N>
+inline typename SmallMap<KEY, VALUE, N>::const_iterator SmallMap<KEY, VALUE, N>::cend() const
+{
+    return this->end();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename KEY, typename VALUE, unsigned int N>
+inline typename SmallMap<KEY, VALUE, N>::iterator SmallMap<KEY, VALUE, N>::find(const key_type &key)
+{
+    iterator iter(this->begin());
+    const iterator iterEnd(this->end());
+
+    while ((iterEnd != iter) && (key != iter->first))
+        ++iter;
+
+    return iter;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename KEY, typename VALUE, unsigned int N>
+inline typename SmallMap<KEY, VALUE, N>::const_iterator SmallMap<KEY, VALUE, N>::find(const key_type &key) const
+{
+    const_iterator iter(this->begin());
+    const const_iterator iterEnd(this->end());
+
+    while ((iterEnd != iter) && (key != iter->first))
+        ++iter;
+
+    return iter;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename KEY, typename VALUE, unsigned int N>
+inline typename SmallMap<KEY, VALUE, N>::size_type SmallMap<KEY, VALUE, N>::count(const key_type &key) const
+{
+    return ((this->end() != this->find(key)) ? 1 : 0);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename KEY, typename VALUE, unsigned int N>
+inline typename SmallMap<KEY, VALUE, N>::mapped_type &SmallMap<KEY, VALUE, N>::at(const key_type &key)
+{
+    const iterator iter(this->find(key));
+
+    if (this->end() == iter)
+        throw std::out_of_range("SmallMap::at");
+
+    return iter->second;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename KEY, typename VALUE, unsigned int N>
+inline const typename SmallMap<KEY, VALUE, N>::mapped_type &SmallMap<KEY, VALUE, N>::at(const key_type &key) const
+{
+    const const_iterator iter(this->find(key));
+
+    if (this->end() == iter)
+        throw std::out_of_range("SmallMap::at");
+
+    return iter->second;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename KEY, typename VALUE, unsigned int N>
+inline typename SmallMap<KEY, VALUE, N>::mapped_type &SmallMap<KEY, VALUE, N>::operator[] (const key_type &key)
+{
+    return this->insert(value_type(key, mapped_type())).first->second;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename KEY, typename VALUE, unsigned int N>
+inline std::pair<typename SmallMap<KEY, VALUE, N>::iterator, bool> SmallMap<KEY, VALUE, N>::insert(const value_type &val)
+{
+    const iterator iter(this->find(val.first));
+
+    if (this->end() != iter)
+        return std::make_pair(iter, false);
+
+    // ATTN Copy before any reallocation, in case val refers to an existing entry
+    const value_type newEntry(val);
+
+    if (m_size == m_capacity)
+        this->reserve(2 * m_capacity);
+
+    iterator newIter(this->end());
+    *newIter = newEntry;
+    ++m_size;
+
+    return std::make_pair(newIter, true);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename KEY, typename VALUE, unsigned int N>
+inline typename SmallMap<KEY, VALUE, N>::iterator SmallMap<KEY, VALUE, N>::erase(const_iterator position)
+{
+    const iterator iter(this->begin() + (position - this->cbegin()));
+    std::copy(iter + 1, this->end(), iter);
+    --m_size;
+
+    return iter;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename KEY, typename VALUE, unsigned int N>
+inline typename SmallMap<KEY, VALUE, N>::size_type SmallMap<KEY, VALUE, N>::erase(const key_type &key)
+{
+    const iterator iter(this->find(key));
+
+    if (this->end() == iter)
+        return 0;
+
+    this->erase(iter);
+    return 1;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename KEY, typename VALUE, unsigned int N>
+inline void SmallMap<KEY, VALUE, N>::reserve(size_type n)
+{
+    if (n <= m_capacity)
+        return;
+
+    value_type *const pNewEntries(new value_type[n]);
+    std::copy(this->begin(), this->end(), pNewEntries);
+
+    delete [] m_pHeapEntries;
+    m_pHeapEntries = pNewEntries;
+    m_capacity = static_cast<unsigned int>(n);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename KEY, typename VALUE, unsigned int N>
+inline typename SmallMap<KEY, VALUE, N>::size_type SmallMap<KEY, VALUE, N>::size() const
+{
+    return m_size;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename KEY, typename VALUE, unsigned int N>
+inline bool SmallMap<KEY, VALUE, N>::empty() const
+{
+    return (0 == m_size);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename KEY, typename VALUE, unsigned int N>
+inline void SmallMap<KEY, VALUE, N>::clear()
+{
+    m_size = 0;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename KEY, typename VALUE, unsigned int N>
+inline void SmallMap<KEY, VALUE, N>::swap(SmallMap &rhs)
+{
+    SmallMap temp(std::move(rhs));
+    rhs = std::move(*this);
+    *this = std::move(temp);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename KEY, typename VALUE, unsigned int N>
+inline bool SmallMap<KEY, VALUE, N>::operator== (const SmallMap &rhs) const
+{
+    if (m_size != rhs.m_size)
+        return false;
+
+    for (const value_type &entry : *this)
+    {
+        const const_iterator rhsIter(rhs.find(entry.first));
+
+        if ((rhs.end() == rhsIter) || !(entry.second == rhsIter->second))
+            return false;
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename KEY, typename VALUE, unsigned int N>
+inline bool SmallMap<KEY, VALUE, N>::operator!= (const SmallMap &rhs) const
+{
+    return !(*this == rhs);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename KEY, typename VALUE, unsigned int N>
+inline void SmallMap<KEY, VALUE, N>::MoveFrom(SmallMap &rhs)
+{
+    if (rhs.m_pHeapEntries)
+    {
+        m_pHeapEntries = rhs.m_pHeapEntries;
+        m_capacity = rhs.m_capacity;
+        rhs.m_pHeapEntries = nullptr;
+        rhs.m_capacity = N;
+    }
+    else
+    {
+        std::copy(rhs.begin(), rhs.end(), m_inlineEntries);
+    }
+
+    m_size = rhs.m_size;
+    rhs.m_size = 0;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+#if defined(PANDORA_CONTIGUOUS_MANAGED_CONTAINER)
+    // Contiguous storage: faster iteration, fewer allocations, but insertion/erasure invalidates iterators to later elements
+    #define MANAGED_CONTAINER ContiguousList
+    #define PANDORA_MANAGED_CONTAINER_STABLE_ITERATORS 0
+#elif defined(PANDORA_DUPLICATE_CHECKED_MANAGED_CONTAINER)
+    // Debugging aid: report insertion of duplicate entries into managed lists
+    #define MANAGED_CONTAINER MyList
+    #define PANDORA_MANAGED_CONTAINER_STABLE_ITERATORS 1
+#else
+    #define MANAGED_CONTAINER std::list
+    #define PANDORA_MANAGED_CONTAINER_STABLE_ITERATORS 1
+#endif
+
+typedef MANAGED_CONTAINER<const CaloHit *> CaloHitList;
+typedef MANAGED_CONTAINER<const Cluster *> ClusterList;
+typedef MANAGED_CONTAINER<const DetectorGap *> DetectorGapList;
+typedef MANAGED_CONTAINER<const LArTPC *> LArTPCList;
+typedef MANAGED_CONTAINER<const MCParticle *> MCParticleList;
+typedef MANAGED_CONTAINER<const ParticleFlowObject *> ParticleFlowObjectList;
+typedef MANAGED_CONTAINER<const ParticleFlowObject *> PfoList;
+typedef MANAGED_CONTAINER<const SubDetector *> SubDetectorList;
+typedef MANAGED_CONTAINER<const Track *> TrackList;
+typedef MANAGED_CONTAINER<const Vertex *> VertexList;
+
+typedef std::vector<const CaloHit *> CaloHitVector;
+typedef std::vector<const Cluster *> ClusterVector;
+typedef std::vector<const DetectorGap *> DetectorGapVector;
+typedef std::vector<const LArTPC *> LArTPCVector;
+typedef std::vector<const MCParticle *> MCParticleVector;
+typedef std::vector<const ParticleFlowObject *> ParticleFlowObjectVector;
+typedef std::vector<const ParticleFlowObject *> PfoVector;
+typedef std::vector<const SubDetector *> SubDetectorVector;
+typedef std::vector<const Track *> TrackVector;
+typedef std::vector<const Vertex *> VertexVector;
+typedef std::vector<VertexCaloHitSummary> VertexCaloHitSummaryVector;
+
+typedef std::unordered_set<const CaloHit *> CaloHitSet;
+typedef std::unordered_set<const Cluster *> ClusterSet;
+typedef std::unordered_set<const DetectorGap *> DetectorGapSet;
+typedef std::unordered_set<const LArTPC *> LArTPCSet;
+typedef std::unordered_set<const MCParticle *> MCParticleSet;
+typedef std::unordered_set<const ParticleFlowObject *> ParticleFlowObjectSet;
+typedef std::unordered_set<const ParticleFlowObject *> PfoSet;
+typedef std::unordered_set<const SubDetector *> SubDetectorSet;
+typedef std::unordered_set<const Track *> TrackSet;
+typedef std::unordered_set<const Vertex *> VertexSet;
+
+typedef std::vector<int> IntVector;
+typedef std::vector<float> FloatVector;
+typedef std::vector<unsigned int> UIntVector;
+typedef std::vector<std::string> StringVector;
+typedef std::vector<CartesianVector> CartesianPointVector;
+typedef std::vector<TrackState> TrackStateVector;
+typedef std::vector<AlgorithmTool *> AlgorithmToolVector;
+
+typedef const void * Uid;
+typedef std::unordered_map<Uid, const MCParticle *> UidToMCParticleMap;
+typedef SmallMap<const MCParticle *, float, 4> MCParticleWeightMap;
+typedef std::unordered_map<Uid, MCParticleWeightMap> UidToMCParticleWeightMap;
+typedef std::unordered_map<const Cluster *, const Track * > ClusterToTrackMap;
+typedef std::unordered_map<const Track *, const Cluster * > TrackToClusterMap;
+typedef std::vector<std::pair<const Track *, const Cluster *> > TrackClusterAssociationVector;
+
+typedef std::set<std::string> StringSet;
+typedef std::map<std::string, float> PropertiesMap;
+typedef std::map<std::string, const SubDetector *> SubDetectorMap;
+typedef std::map<unsigned int, const LArTPC *> LArTPCMap;
+typedef std::map<unsigned int, PfoList> EventIdToPfoListMap;
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  ObjectRange class, a lightweight, read-only view of a contiguous range of object addresses owned elsewhere, offering the
+ *          subset of the managed container interface used for traversal. The range converts to a managed container on request, which
+ *          copies its contents.
+ */
+template <typename T>
+class ObjectRange
+{
+public:
+    typedef const T *value_type;
+    typedef std::size_t size_type;
+    typedef const value_type *const_iterator;
+    typedef const_iterator iterator;
+
+    /**
+     *  @brief  Default constructor, an empty range
+     */
+    ObjectRange();
+
+    /**
+     *  @brief  Constructor
+     * 
+     *  @param  first the start of the range
+     *  @param  last the end of the range
+     */
+    ObjectRange(const_iterator first, const_iterator last);
+
+    /**
+     *  @brief  begin, end
+     */
+    const_iterator begin() const;
+    const_iterator end() const;
+    const_iterator cbegin() const;
+    const_iterator cend() const;
+
+    /**
+     *  @brief  size
+     */
+    size_type size() const;
+
+    /**
+     *  @brief  empty
+     */
+    bool empty() const;
+
+    /**
+     *  @brief  front, back
+     */
+    value_type front() const;
+    value_type back() const;
+
+    /**
+     *  @brief  operator[]
+     * 
+     *  @param  n
+     */
+    value_type operator[](size_type n) const;
+
+    /**
+     *  @brief  Copy the range into a managed container
+     */
+    operator MANAGED_CONTAINER<const T *>() const;
+
+private:
+    const_iterator  m_first;    ///< The start of the range
+    const_iterator  m_last;     ///< The end of the range
+};
+
+typedef ObjectRange<MCParticle> MCParticleRange;
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  MCParticleRelationship class, a weighted link from an object (calo hit or track) to a mc particle
+ */
+class MCParticleRelationship
+{
+public:
+    /**
+     *  @brief  Constructor
+     * 
+     *  @param  objectUid the object unique identifier, the address of the calo hit or track in the user framework
+     *  @param  mcParticleUid the mc particle unique identifier, the address of the mc particle in the user framework
+     *  @param  mcParticleWeight weighting to assign to the mc particle
+     */
+    MCParticleRelationship(const Uid objectUid, const Uid mcParticleUid, const float mcParticleWeight = 1.f);
+
+    Uid                 m_objectUid;                ///< The object unique identifier
+    Uid                 m_mcParticleUid;            ///< The mc particle unique identifier
+    float               m_mcParticleWeight;         ///< The weighting to assign to the mc particle
+};
+
+typedef std::vector<MCParticleRelationship> MCParticleRelationshipVector;
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  UidToMCParticleWeightTable class, relating object (calo hit or track) uids to mc particle weight maps. Uids are hashed by
+ *          default but, where the user framework identifies objects by dense indices cast to addresses, the indices may instead be
+ *          used to address a vector directly.
+ */
+class UidToMCParticleWeightTable
+{
+public:
+    /**
+     *  @brief  Constructor
+     * 
+     *  @param  isDense whether the uids are dense indices, cast to addresses
+     */
+    UidToMCParticleWeightTable(const bool isDense);
+
+    /**
+     *  @brief  Get the dense index held by a uid, for a user framework that identifies objects by dense indices cast to addresses
+     * 
+     *  @param  uid the unique identifier
+     * 
+     *  @return the dense index
+     */
+    static std::size_t GetDenseIndex(const Uid uid);
+
+    /**
+     *  @brief  Whether the uids are dense indices, cast to addresses
+     * 
+     *  @return boolean
+     */
+    bool IsDense() const;
+
+    /**
+     *  @brief  Whether the table is empty
+     * 
+     *  @return boolean
+     */
+    bool empty() const;
+
+    /**
+     *  @brief  Get the mc particle weight map for a uid, inserting an empty map if the uid is not present
+     * 
+     *  @param  uid the unique identifier
+     * 
+     *  @return the mc particle weight map
+     */
+    MCParticleWeightMap &operator[](const Uid uid);
+
+    /**
+     *  @brief  Find the mc particle weight map for a uid
+     * 
+     *  @param  uid the unique identifier
+     * 
+     *  @return address of the mc particle weight map, or nullptr if the uid is not present
+     */
+    const MCParticleWeightMap *Find(const Uid uid) const;
+
+private:
+    typedef std::vector<MCParticleWeightMap> MCParticleWeightMapVector;
+
+    bool                        m_isDense;                      ///< Whether the uids are dense indices, cast to addresses
+    UidToMCParticleWeightMap    m_uidToMCParticleWeightMap;     ///< The uid to mc particle weight map, for hashed uids
+    MCParticleWeightMapVector   m_mcParticleWeightMapVector;    ///< The mc particle weight maps, indexed by dense uid
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline MCParticleRelationship::MCParticleRelationship(const Uid objectUid, const Uid mcParticleUid, const float mcParticleWeight) :
+    m_objectUid(objectUid),
+    m_mcParticleUid(mcParticleUid),
+    m_mcParticleWeight(mcParticleWeight)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline ObjectRange<T>::ObjectRange() :
+    m_first(nullptr),
+    m_last(nullptr)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline ObjectRange<T>::ObjectRange(const_iterator first, const_iterator last) :
+    m_first(first),
+    m_last(last)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline typename ObjectRange<T>::const_iterator ObjectRange<T>::begin() const
+{
+    return m_first;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline typename ObjectRange<T>::const_iterator ObjectRange<T>::end() const
+{
+    return m_last;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline typename ObjectRange<T>::const_iterator ObjectRange<T>::cbegin() const
+{
+    return m_first;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline typename ObjectRange<T>::const_iterator ObjectRange<T>::cend() const
+{
+    return m_last;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline typename ObjectRange<T>::size_type ObjectRange<T>::size() const
+{
+    return static_cast<size_type>(m_last - m_first);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline bool ObjectRange<T>::empty() const
+{
+    return (m_first == m_last);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline typename ObjectRange<T>::value_type ObjectRange<T>::front() const
+{
+    return *m_first;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline typename ObjectRange<T>::value_type ObjectRange<T>::back() const
+{
+    return *(m_last - 1);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline typename ObjectRange<T>::value_type ObjectRange<T>::operator[](size_type n) const
+{
+    return m_first[n];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline ObjectRange<T>::operator MANAGED_CONTAINER<const T *>() const
+{
+    return MANAGED_CONTAINER<const T *>(m_first, m_last);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline UidToMCParticleWeightTable::UidToMCParticleWeightTable(const bool isDense) :
+    m_isDense(isDense)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline std::size_t UidToMCParticleWeightTable::GetDenseIndex(const Uid uid)
+{
+    return static_cast<std::size_t>(reinterpret_cast<std::uintptr_t>(uid));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool UidToMCParticleWeightTable::IsDense() const
+{
+    return m_isDense;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool UidToMCParticleWeightTable::empty() const
+{
+    return (m_isDense ? m_mcParticleWeightMapVector.empty() : m_uidToMCParticleWeightMap.empty());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline MCParticleWeightMap &UidToMCParticleWeightTable::operator[](const Uid uid)
+{
+    if (!m_isDense)
+        return m_uidToMCParticleWeightMap[uid];
+
+    const std::size_t index(UidToMCParticleWeightTable::GetDenseIndex(uid));
+
+    if (index >= m_mcParticleWeightMapVector.size())
+        m_mcParticleWeightMapVector.resize(index + 1);
+
+    return m_mcParticleWeightMapVector[index];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const MCParticleWeightMap *UidToMCParticleWeightTable::Find(const Uid uid) const
+{
+    if (!m_isDense)
+    {
+        UidToMCParticleWeightMap::const_iterator iter = m_uidToMCParticleWeightMap.find(uid);
+        return ((m_uidToMCParticleWeightMap.end() != iter) ? &(iter->second) : nullptr);
+    }
+
+    // ATTN Dense indices without relationships address empty maps, which are treated as absent
+    const std::size_t index(UidToMCParticleWeightTable::GetDenseIndex(uid));
+    return (((index < m_mcParticleWeightMapVector.size()) && !m_mcParticleWeightMapVector[index].empty()) ? &m_mcParticleWeightMapVector[index] : nullptr);
+}
 
 } // namespace pandora
 
@@ -11,27 +11,89 @@
 #include "Pandora/ObjectFactory.h"
 #include "Pandora/StatusCodes.h"
 
+#include <iostream>
+
 namespace pandora
 {
 
 /**
- *  @brief  PandoraObjectFactory class
+ *  @brief  PandoraObjectFactory class, the default object factory. The managers recognise this factory and create its objects via
+ *          an inlined, non-virtual path, so it is final: custom object creation should derive from ObjectFactory instead.
  */
 template <typename PARAMETERS, typename OBJECT>
-class PandoraObjectFactory : public ObjectFactory<PARAMETERS, OBJECT>
+class PandoraObjectFactory final : public ObjectFactory<PARAMETERS, OBJECT>
 {
 public:
     typedef PARAMETERS Parameters;
     typedef OBJECT Object;
 
+    /**
+     *  @brief  Default constructor
+     */
+    PandoraObjectFactory();
+
     Parameters *NewParameters() const;
     StatusCode Read(Parameters &parameters, FileReader &fileReader) const;
     StatusCode Write(const Object *const pObject, FileWriter &fileWriter) const;
 
 private:
     StatusCode Create(const Parameters &parameters, const Object *&pObject) const;
+
+    /**
+     *  @brief  Create an object with the given parameters, without virtual dispatch
+     *
+     *  @param  parameters the parameters to pass in constructor
+     *  @param  pObject to receive the address of the object created
+     */
+    static StatusCode CreateDefault(const Parameters &parameters, const Object *&pObject);
+
+    friend class ObjectFactory<PARAMETERS, OBJECT>;
 };
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename PARAMETERS, typename OBJECT>
+inline PandoraObjectFactory<PARAMETERS, OBJECT>::PandoraObjectFactory() :
+    ObjectFactory<PARAMETERS, OBJECT>(true)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename PARAMETERS, typename OBJECT>
+inline StatusCode PandoraObjectFactory<PARAMETERS, OBJECT>::CreateDefault(const Parameters &parameters, const Object *&pObject)
+{
+    pObject = nullptr;
+
+    try
+    {
+        pObject = new OBJECT(parameters);
+    }
+    catch (StatusCodeException &statusCodeException)
+    {
+        delete pObject;
+        pObject = nullptr;
+
+        std::cout << "StatusCodeException caught while instantiating pandora object :" << statusCodeException.ToString() << std::endl;
+        return statusCodeException.GetStatusCode();
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename PARAMETERS, typename OBJECT>
+inline StatusCode ObjectFactory<PARAMETERS, OBJECT>::CreateObject(const Parameters &parameters, const Object *&pObject) const
+{
+    // ATTN The default factory is final, so the flag identifies its Create implementation exactly
+    if (m_isDefaultFactory)
+        return PandoraObjectFactory<PARAMETERS, OBJECT>::CreateDefault(parameters, pObject);
+
+    return this->Create(parameters, pObject);
+}
+
 } // namespace pandora
 
 #endif // #ifndef PANDORA_OBJECT_FACTORY_H
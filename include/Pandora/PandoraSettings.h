@@ -10,6 +10,9 @@
 
 #include "Pandora/StatusCodes.h"
 
+#include <string>
+#include <vector>
+
 namespace pandora
 {
 
@@ -50,6 +53,153 @@ public:
      */
     bool ShouldDisplayAlgorithmInfo() const;
 
+    /**
+     *  @brief  Whether to record wall time, cpu time and object counts for each algorithm instance during processing
+     * 
+     *  @return boolean
+     */
+    bool ShouldProfileAlgorithms() const;
+
+    /**
+     *  @brief  Whether to additionally record every algorithm invocation, for output as a trace (requires algorithm profiling)
+     * 
+     *  @return boolean
+     */
+    bool ShouldRecordAlgorithmTrace() const;
+
+    /**
+     *  @brief  Whether to display the hot path counters at the end of each event (requires PANDORA_HOT_PATH_COUNTERS build flag)
+     * 
+     *  @return boolean
+     */
+    bool ShouldDisplayHotPathCounters() const;
+
+    /**
+     *  @brief  Whether to record the wall time taken to process each event, in a histogram of event processing times
+     * 
+     *  @return boolean
+     */
+    bool ShouldRecordEventLatency() const;
+
+    /**
+     *  @brief  Whether to record, after each algorithm, the per-event high-water marks of the memory used by each object manager
+     * 
+     *  @return boolean
+     */
+    bool ShouldRecordMemoryUsage() const;
+
+    /**
+     *  @brief  Whether to display the memory usage high-water marks at the end of each event (requires memory usage recording)
+     * 
+     *  @return boolean
+     */
+    bool ShouldDisplayMemoryUsage() const;
+
+    /**
+     *  @brief  Whether to contribute the profiles recorded by this instance to the process-wide profile aggregator at the end of each
+     *          event, for merged reporting across all pandora instances in the process
+     * 
+     *  @return boolean
+     */
+    bool ShouldAggregateProfiles() const;
+
+    /**
+     *  @brief  Get the number of events, contributed by all instances, after which the aggregated profile is printed (zero to disable
+     *          periodic reports; the aggregated profile may instead be printed on request, e.g. at shutdown)
+     * 
+     *  @return the aggregated profile report period
+     */
+    unsigned int GetAggregatedProfileReportPeriod() const;
+
+    /**
+     *  @brief  Get the maximum number of objects of any single type (calo hits, tracks, mc particles, clusters, pfos or vertices) that
+     *          may be created in an event (zero to disable). Once exceeded, the event is abandoned with STATUS_CODE_BUDGET_EXCEEDED.
+     * 
+     *  @return the maximum number of objects per event
+     */
+    unsigned int GetMaxObjectsPerEvent() const;
+
+    /**
+     *  @brief  Get the number of threads used for parallel loops within algorithms, including the calling thread (one to run serially)
+     * 
+     *  @return the number of threads
+     */
+    unsigned int GetNThreads() const;
+
+    /**
+     *  @brief  Get the cores to which the threads of the thread pool are pinned (empty to disable). Memory first touched by pinned
+     *          threads, such as per-event objects and scratch containers, is then placed on the local numa node by the kernel.
+     * 
+     *  @return the core set
+     */
+    const std::vector<unsigned int> &GetCoreSet() const;
+
+    /**
+     *  @brief  Get the event processing time above which the input objects for an event are written to the slow event file (zero to
+     *          disable), units s
+     * 
+     *  @return the slow event threshold
+     */
+    float GetSlowEventThreshold() const;
+
+    /**
+     *  @brief  Get the name of the binary file to which the input objects for slow events are appended
+     * 
+     *  @return the slow event file name
+     */
+    const std::string &GetSlowEventFileName() const;
+
+    /**
+     *  @brief  Get the maximum distance between calo hits in the precomputed calo hit neighbour graph (zero to disable), units mm
+     * 
+     *  @return the neighbour graph maximum distance
+     */
+    float GetNeighbourGraphMaxDistance() const;
+
+    /**
+     *  @brief  Get the number of preceding pseudo layers in which neighbours are sought for the calo hit neighbour graph
+     * 
+     *  @return the neighbour graph layer window
+     */
+    unsigned int GetNeighbourGraphLayerWindow() const;
+
+    /**
+     *  @brief  Get the drift bin width for the precomputed per-view lar tpc hit grids (zero to disable), units mm
+     * 
+     *  @return the lar tpc hit grid drift bin width
+     */
+    float GetLArTPCHitGridDriftBinWidth() const;
+
+    /**
+     *  @brief  Whether to partition the input calo hit list by hit type, saving each partition as a named list when preparing the event
+     * 
+     *  @return boolean
+     */
+    bool ShouldPartitionInputCaloHits() const;
+
+    /**
+     *  @brief  Whether to calculate and cache the intersections of each input track with the calorimeter layers when preparing the event
+     * 
+     *  @return boolean
+     */
+    bool ShouldCalculateTrackLayerIntersections() const;
+
+    /**
+     *  @brief  Whether to trust the input calo hit and track parameters, skipping their validation in release builds other than for
+     *          the first event and for events sampled at the trusted input validation interval
+     * 
+     *  @return boolean
+     */
+    bool ShouldTrustInputObjects() const;
+
+    /**
+     *  @brief  Get the interval, in events, at which input object parameters are still validated when trusting input objects, zero
+     *          to validate only the first event
+     * 
+     *  @return the trusted input validation interval
+     */
+    unsigned int GetTrustedInputValidationInterval() const;
+
     /**
      *  @brief  Whether to allow only single hit types in individual clusters
      * 
@@ -57,6 +207,13 @@ public:
      */
     bool SingleHitTypeClusteringMode() const;
 
+    /**
+     *  @brief  Whether the cluster manager should maintain an index from each calo hit to the cluster containing it
+     * 
+     *  @return boolean
+     */
+    bool ShouldMaintainCaloHitClusterIndex() const;
+
     /**
      *  @brief  Whether to collapse mc particle decay chains down to just the pfo target
      * 
@@ -71,6 +228,22 @@ public:
      */
     bool UseSingleMCParticleAssociation() const;
 
+    /**
+     *  @brief  Whether to run in data mode, in which no mc particles or mc particle relationships may be registered and all mc
+     *          particle preparation is skipped
+     * 
+     *  @return boolean
+     */
+    bool IsDataMode() const;
+
+    /**
+     *  @brief  Whether the user framework identifies mc particles, calo hits and tracks by dense indices, cast to addresses, so that
+     *          the mc manager may hold its relationships in vectors indexed by uid, rather than in hash maps
+     * 
+     *  @return boolean
+     */
+    bool ShouldUseDenseUids() const;
+
     /**
      *  @brief  Get the electromagnetic energy resolution as a fraction, X, such that sigmaE = ( X * E / sqrt(E) )
      * 
@@ -130,9 +303,23 @@ private:
 
     bool     m_isMonitoringEnabled;                         ///< Whether monitoring is enabled
     bool     m_shouldDisplayAlgorithmInfo;                  ///< Whether to display algorithm information during processing
+    bool     m_shouldProfileAlgorithms;                     ///< Whether to record timing and object counts for each algorithm instance
+    bool     m_shouldRecordAlgorithmTrace;                  ///< Whether to additionally record every algorithm invocation, for trace output
+    bool     m_shouldDisplayHotPathCounters;                ///< Whether to display the hot path counters at the end of each event
+    bool     m_shouldRecordEventLatency;                    ///< Whether to record the wall time taken to process each event
+    bool     m_shouldRecordMemoryUsage;                     ///< Whether to record the per-event memory usage high-water marks
+    bool     m_shouldDisplayMemoryUsage;                    ///< Whether to display the memory usage high-water marks at the end of each event
+    bool     m_shouldAggregateProfiles;                     ///< Whether to contribute profiles to the process-wide profile aggregator
+    unsigned int m_aggregatedProfileReportPeriod;           ///< The number of events between aggregated profile reports, zero to disable
+    unsigned int m_maxObjectsPerEvent;                      ///< The maximum number of objects of any single type per event, zero to disable
+    unsigned int m_nThreads;                                ///< The number of threads used for parallel loops within algorithms
+    std::vector<unsigned int> m_coreSet;                    ///< The cores to which the thread pool threads are pinned, empty to disable
     bool     m_singleHitTypeClusteringMode;                 ///< Whether to allow only single hit types in individual clusters
+    bool     m_shouldMaintainCaloHitClusterIndex;           ///< Whether to maintain an index from each calo hit to its containing cluster
     bool     m_shouldCollapseMCParticlesToPfoTarget;        ///< Whether to collapse mc particle decay chains down to just the pfo target
     bool     m_useSingleMCParticleAssociation;              ///< Whether to allow only single mc particle association to objects (largest weight)
+    bool     m_isDataMode;                                  ///< Whether to run in data mode, skipping all mc particle preparation
+    bool     m_shouldUseDenseUids;                          ///< Whether user framework uids are dense indices, cast to addresses
 
     float    m_electromagneticEnergyResolution;             ///< Electromagnetic energy resolution, X, such that sigmaE = ( X * E / sqrt(E) )
     float    m_hadronicEnergyResolution;                    ///< Hadronic energy resolution, X, such that sigmaE = ( X * E / sqrt(E) )
@@ -142,6 +329,18 @@ private:
 
     float    m_gapTolerance;                                ///< Tolerance allowed when declaring a point to be "in" a gap region, units mm
 
+    float    m_slowEventThreshold;                          ///< Event processing time above which to write the event to file, units s
+    std::string m_slowEventFileName;                        ///< Name of the binary file to which slow events are appended
+
+    float    m_neighbourGraphMaxDistance;                   ///< Maximum distance between calo hits in the neighbour graph, zero to disable, units mm
+    unsigned int m_neighbourGraphLayerWindow;               ///< Number of preceding pseudo layers in which graph neighbours are sought
+    float    m_larTPCHitGridDriftBinWidth;                  ///< Drift bin width for the lar tpc hit grids, zero to disable, units mm
+
+    bool     m_shouldPartitionInputCaloHits;                ///< Whether to save a named partition of the input calo hit list for each hit type
+    bool     m_shouldCalculateTrackLayerIntersections;      ///< Whether to cache the track intersections with the calorimeter layers
+    bool     m_shouldTrustInputObjects;                     ///< Whether to skip validation of input calo hit and track parameters
+    unsigned int m_trustedInputValidationInterval;          ///< The interval, in events, at which trusted input parameters are validated
+
     const Pandora *const m_pPandora;                        ///< The associated pandora object
 
     friend class PandoraApiImpl;
@@ -164,6 +363,146 @@ inline bool PandoraSettings::ShouldDisplayAlgorithmInfo() const
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+inline bool PandoraSettings::ShouldProfileAlgorithms() const
+{
+    return m_shouldProfileAlgorithms;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool PandoraSettings::ShouldRecordAlgorithmTrace() const
+{
+    return m_shouldRecordAlgorithmTrace;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool PandoraSettings::ShouldDisplayHotPathCounters() const
+{
+    return m_shouldDisplayHotPathCounters;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool PandoraSettings::ShouldRecordEventLatency() const
+{
+    return m_shouldRecordEventLatency;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool PandoraSettings::ShouldRecordMemoryUsage() const
+{
+    return m_shouldRecordMemoryUsage;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool PandoraSettings::ShouldDisplayMemoryUsage() const
+{
+    return m_shouldDisplayMemoryUsage;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool PandoraSettings::ShouldAggregateProfiles() const
+{
+    return m_shouldAggregateProfiles;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int PandoraSettings::GetAggregatedProfileReportPeriod() const
+{
+    return m_aggregatedProfileReportPeriod;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int PandoraSettings::GetMaxObjectsPerEvent() const
+{
+    return m_maxObjectsPerEvent;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int PandoraSettings::GetNThreads() const
+{
+    return m_nThreads;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const std::vector<unsigned int> &PandoraSettings::GetCoreSet() const
+{
+    return m_coreSet;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline float PandoraSettings::GetSlowEventThreshold() const
+{
+    return m_slowEventThreshold;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const std::string &PandoraSettings::GetSlowEventFileName() const
+{
+    return m_slowEventFileName;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline float PandoraSettings::GetNeighbourGraphMaxDistance() const
+{
+    return m_neighbourGraphMaxDistance;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int PandoraSettings::GetNeighbourGraphLayerWindow() const
+{
+    return m_neighbourGraphLayerWindow;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline float PandoraSettings::GetLArTPCHitGridDriftBinWidth() const
+{
+    return m_larTPCHitGridDriftBinWidth;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool PandoraSettings::ShouldPartitionInputCaloHits() const
+{
+    return m_shouldPartitionInputCaloHits;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool PandoraSettings::ShouldCalculateTrackLayerIntersections() const
+{
+    return m_shouldCalculateTrackLayerIntersections;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool PandoraSettings::ShouldTrustInputObjects() const
+{
+    return m_shouldTrustInputObjects;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int PandoraSettings::GetTrustedInputValidationInterval() const
+{
+    return m_trustedInputValidationInterval;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 inline bool PandoraSettings::SingleHitTypeClusteringMode() const
 {
     return m_singleHitTypeClusteringMode;
@@ -171,6 +510,13 @@ inline bool PandoraSettings::SingleHitTypeClusteringMode() const
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+inline bool PandoraSettings::ShouldMaintainCaloHitClusterIndex() const
+{
+    return m_shouldMaintainCaloHitClusterIndex;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 inline bool PandoraSettings::ShouldCollapseMCParticlesToPfoTarget() const
 {
     return m_shouldCollapseMCParticlesToPfoTarget;
@@ -185,6 +531,20 @@ inline bool PandoraSettings::UseSingleMCParticleAssociation() const
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+inline bool PandoraSettings::IsDataMode() const
+{
+    return m_isDataMode;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool PandoraSettings::ShouldUseDenseUids() const
+{
+    return m_shouldUseDenseUids;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 inline float PandoraSettings::GetElectromagneticEnergyResolution() const
 {
     return m_electromagneticEnergyResolution;
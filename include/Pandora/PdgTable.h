@@ -10,7 +10,9 @@
 
 #include "Pandora/StatusCodes.h"
 
+#include <array>
 #include <string>
+#include <string_view>
 
 namespace pandora
 {
@@ -59,40 +61,16 @@ namespace pandora
     a = b,
 
 /**
- *  @brief  The particle type switch statement macro
+ *  @brief  The particle record entry macro
  */
-#define GET_PARTICLE_TYPE_SWITCH(a, b, c, d, e)                                         \
-    case b : return a;
+#define GET_PARTICLE_RECORD_ENTRY(a, b, c, d, e)                                        \
+    ParticleRecord{a, b, c, d, e, #a},
 
 /**
- *  @brief  The name switch statement macro
+ *  @brief  The particle count macro
  */
-#define GET_PARTICLE_NAME_SWITCH(a, b, c, d, e)                                         \
-    case a : return std::string(#a);
-
-/**
- *  @brief  The pdg code switch statement macro
- */
-#define GET_PARTICLE_PDG_CODE_SWITCH(a, b, c, d, e)                                     \
-    case a : return b;
-
-/**
- *  @brief  The mass switch statement macro
- */
-#define GET_PARTICLE_MASS_SWITCH(a, b, c, d, e)                                         \
-    case a : return c;
-
-/**
- *  @brief  The width switch statement macro
- */
-#define GET_PARTICLE_WIDTH_SWITCH(a, b, c, d, e)                                        \
-    case a : return d;
-
-/**
- *  @brief  The charge switch statement macro
- */
-#define GET_PARTICLE_CHARGE_SWITCH(a, b, c, d, e)                                       \
-    case a : return e;
+#define GET_PARTICLE_COUNT_ENTRY(a, b, c, d, e)                                         \
+    + 1
 
 /**
  *  @brief  The particle type enum
@@ -107,11 +85,48 @@ enum ParticleType
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 /**
- *  @brief  PdgTable class
+ *  @brief  ParticleRecord class, holding all properties of a particle type in the particle data table
+ */
+class ParticleRecord
+{
+public:
+    ParticleType        m_particleType;         ///< The particle type
+    int                 m_pdgCode;              ///< The pdg code
+    float               m_mass;                 ///< The mass, GeV
+    float               m_width;                ///< The width, GeV
+    int                 m_charge;               ///< The charge
+    std::string_view    m_name;                 ///< The name, referring to static storage
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  PdgTable class. Particle records are held in a single table, sorted by pdg code and built at compile time, with direct
+ *          indexing for the commonly encountered lepton, photon and meson pdg codes and a binary search otherwise.
  */
 class PdgTable
 {
 public:
+    /**
+     *  @brief  Get the record of all properties of a particle type
+     * 
+     *  @param  pdgCode the pdg code (or particle type)
+     * 
+     *  @return the particle record
+     */
+    static const ParticleRecord &GetParticleRecord(const int pdgCode);
+
+    /**
+     *  @brief  Get the record of all properties of a particle type, without throwing for unknown pdg codes
+     * 
+     *  @param  pdgCode the pdg code (or particle type)
+     *  @param  pParticleRecord to receive the address of the particle record
+     * 
+     *  @return STATUS_CODE_SUCCESS, or STATUS_CODE_INVALID_PARAMETER if the pdg code is unknown
+     */
+    static StatusCode GetParticleRecord(const int pdgCode, const ParticleRecord *&pParticleRecord);
+
     /**
      *  @brief  Get the particle type for a given pdg code
      * 
@@ -165,72 +180,241 @@ public:
      *  @return the charge
      */
     static int GetParticleCharge(const int pdgCode);
+
+    /**
+     *  @brief  Whether a pdg code (or particle type) is present in the table, i.e. whether the other functions will succeed
+     * 
+     *  @param  pdgCode the pdg code (or particle type)
+     * 
+     *  @return boolean
+     */
+    static bool IsKnownPdgCode(const int pdgCode);
+
+    /**
+     *  @brief  Get the particle type of a particle type, without throwing for unknown pdg codes
+     * 
+     *  @param  pdgCode the pdg code
+     *  @param  particleType to receive the particle type
+     * 
+     *  @return STATUS_CODE_SUCCESS, or STATUS_CODE_INVALID_PARAMETER if the pdg code is unknown
+     */
+    static StatusCode GetParticleType(const int pdgCode, ParticleType &particleType);
+
+    /**
+     *  @brief  Get the name of a particle type, without throwing for unknown pdg codes
+     * 
+     *  @param  pdgCode the pdg code (or particle type)
+     *  @param  particleName to receive the name
+     * 
+     *  @return STATUS_CODE_SUCCESS, or STATUS_CODE_INVALID_PARAMETER if the pdg code is unknown
+     */
+    static StatusCode GetParticleName(const int pdgCode, std::string &particleName);
+
+    /**
+     *  @brief  Get the pdg code of a particle type, without throwing for unknown pdg codes
+     * 
+     *  @param  pdgCode the pdg code (or particle type)
+     *  @param  particlePdgCode to receive the pdg code
+     * 
+     *  @return STATUS_CODE_SUCCESS, or STATUS_CODE_INVALID_PARAMETER if the pdg code is unknown
+     */
+    static StatusCode GetParticlePdgCode(const int pdgCode, int &particlePdgCode);
+
+    /**
+     *  @brief  Get the mass of a particle type, without throwing for unknown pdg codes
+     * 
+     *  @param  pdgCode the pdg code (or particle type)
+     *  @param  particleMass to receive the mass
+     * 
+     *  @return STATUS_CODE_SUCCESS, or STATUS_CODE_INVALID_PARAMETER if the pdg code is unknown
+     */
+    static StatusCode GetParticleMass(const int pdgCode, float &particleMass);
+
+    /**
+     *  @brief  Get the width of a particle type, without throwing for unknown pdg codes
+     * 
+     *  @param  pdgCode the pdg code (or particle type)
+     *  @param  particleWidth to receive the width
+     * 
+     *  @return STATUS_CODE_SUCCESS, or STATUS_CODE_INVALID_PARAMETER if the pdg code is unknown
+     */
+    static StatusCode GetParticleWidth(const int pdgCode, float &particleWidth);
+
+    /**
+     *  @brief  Get the charge of a particle type, without throwing for unknown pdg codes
+     * 
+     *  @param  pdgCode the pdg code (or particle type)
+     *  @param  particleCharge to receive the charge
+     * 
+     *  @return STATUS_CODE_SUCCESS, or STATUS_CODE_INVALID_PARAMETER if the pdg code is unknown
+     */
+    static StatusCode GetParticleCharge(const int pdgCode, int &particleCharge);
+
+private:
+    static const unsigned int N_PARTICLE_RECORDS = 0 PARTICLE_DATA_TABLE(GET_PARTICLE_COUNT_ENTRY);
+    static const int MAX_DIRECT_PDG_CODE = 400;
+
+    typedef std::array<ParticleRecord, N_PARTICLE_RECORDS> ParticleRecordArray;
+    typedef std::array<signed char, 2 * MAX_DIRECT_PDG_CODE + 1> DirectIndexArray;
+
+    /**
+     *  @brief  Get the particle records, sorted by pdg code
+     * 
+     *  @return the sorted particle records
+     */
+    static constexpr ParticleRecordArray GetSortedParticleRecords();
+
+    /**
+     *  @brief  Get the index of the particle record for each pdg code in the direct indexing range, or -1 for unknown pdg codes
+     * 
+     *  @param  particleRecordArray the sorted particle records
+     * 
+     *  @return the direct indices
+     */
+    static constexpr DirectIndexArray GetDirectIndices(const ParticleRecordArray &particleRecordArray);
+
+    static const ParticleRecordArray    m_particleRecordArray;      ///< The particle records, sorted by pdg code
+    static const DirectIndexArray       m_directIndexArray;         ///< The particle record indices for small absolute pdg codes
 };
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+inline const ParticleRecord &PdgTable::GetParticleRecord(const int pdgCode)
+{
+    const ParticleRecord *pParticleRecord(nullptr);
+
+    if (STATUS_CODE_SUCCESS != PdgTable::GetParticleRecord(pdgCode, pParticleRecord))
+        throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
+
+    return *pParticleRecord;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 inline ParticleType PdgTable::GetParticleType(const int pdgCode)
 {
-    switch (pdgCode)
-    {
-        PARTICLE_DATA_TABLE(GET_PARTICLE_TYPE_SWITCH)
-        default : throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
-    }
+    return PdgTable::GetParticleRecord(pdgCode).m_particleType;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 inline std::string PdgTable::GetParticleName(const int pdgCode)
 {
-    switch (pdgCode)
-    {
-        PARTICLE_DATA_TABLE(GET_PARTICLE_NAME_SWITCH)
-        default : throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
-    }
+    return std::string(PdgTable::GetParticleRecord(pdgCode).m_name);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 inline int PdgTable::GetParticlePdgCode(const int pdgCode)
 {
-    switch (pdgCode)
-    {
-        PARTICLE_DATA_TABLE(GET_PARTICLE_PDG_CODE_SWITCH)
-        default : throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
-    }
+    return PdgTable::GetParticleRecord(pdgCode).m_pdgCode;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 inline float PdgTable::GetParticleMass(const int pdgCode)
 {
-    switch (pdgCode)
-    {
-        PARTICLE_DATA_TABLE(GET_PARTICLE_MASS_SWITCH)
-        default : throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
-    }
+    return PdgTable::GetParticleRecord(pdgCode).m_mass;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 inline float PdgTable::GetParticleWidth(const int pdgCode)
 {
-    switch (pdgCode)
-    {
-        PARTICLE_DATA_TABLE(GET_PARTICLE_WIDTH_SWITCH)
-        default : throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
-    }
+    return PdgTable::GetParticleRecord(pdgCode).m_width;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 inline int PdgTable::GetParticleCharge(const int pdgCode)
 {
-    switch (pdgCode)
-    {
-        PARTICLE_DATA_TABLE(GET_PARTICLE_CHARGE_SWITCH)
-        default : throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
-    }
+    return PdgTable::GetParticleRecord(pdgCode).m_charge;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool PdgTable::IsKnownPdgCode(const int pdgCode)
+{
+    const ParticleRecord *pParticleRecord(nullptr);
+    return (STATUS_CODE_SUCCESS == PdgTable::GetParticleRecord(pdgCode, pParticleRecord));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline StatusCode PdgTable::GetParticleType(const int pdgCode, ParticleType &particleType)
+{
+    const ParticleRecord *pParticleRecord(nullptr);
+
+    if (STATUS_CODE_SUCCESS != PdgTable::GetParticleRecord(pdgCode, pParticleRecord))
+        return STATUS_CODE_INVALID_PARAMETER;
+
+    particleType = pParticleRecord->m_particleType;
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline StatusCode PdgTable::GetParticleName(const int pdgCode, std::string &particleName)
+{
+    const ParticleRecord *pParticleRecord(nullptr);
+
+    if (STATUS_CODE_SUCCESS != PdgTable::GetParticleRecord(pdgCode, pParticleRecord))
+        return STATUS_CODE_INVALID_PARAMETER;
+
+    particleName = std::string(pParticleRecord->m_name);
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline StatusCode PdgTable::GetParticlePdgCode(const int pdgCode, int &particlePdgCode)
+{
+    const ParticleRecord *pParticleRecord(nullptr);
+
+    if (STATUS_CODE_SUCCESS != PdgTable::GetParticleRecord(pdgCode, pParticleRecord))
+        return STATUS_CODE_INVALID_PARAMETER;
+
+    particlePdgCode = pParticleRecord->m_pdgCode;
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline StatusCode PdgTable::GetParticleMass(const int pdgCode, float &particleMass)
+{
+    const ParticleRecord *pParticleRecord(nullptr);
+
+    if (STATUS_CODE_SUCCESS != PdgTable::GetParticleRecord(pdgCode, pParticleRecord))
+        return STATUS_CODE_INVALID_PARAMETER;
+
+    particleMass = pParticleRecord->m_mass;
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline StatusCode PdgTable::GetParticleWidth(const int pdgCode, float &particleWidth)
+{
+    const ParticleRecord *pParticleRecord(nullptr);
+
+    if (STATUS_CODE_SUCCESS != PdgTable::GetParticleRecord(pdgCode, pParticleRecord))
+        return STATUS_CODE_INVALID_PARAMETER;
+
+    particleWidth = pParticleRecord->m_width;
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline StatusCode PdgTable::GetParticleCharge(const int pdgCode, int &particleCharge)
+{
+    const ParticleRecord *pParticleRecord(nullptr);
+
+    if (STATUS_CODE_SUCCESS != PdgTable::GetParticleRecord(pdgCode, pParticleRecord))
+        return STATUS_CODE_INVALID_PARAMETER;
+
+    particleCharge = pParticleRecord->m_charge;
+    return STATUS_CODE_SUCCESS;
 }
 
 } // namespace pandora
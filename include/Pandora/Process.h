@@ -8,6 +8,7 @@
 #ifndef PANDORA_PROCESS_H
 #define PANDORA_PROCESS_H 1
 
+#include "Pandora/ScratchArena.h"
 #include "Pandora/StatusCodes.h"
 
 #include <string>
@@ -70,6 +71,13 @@ protected:
      */
     virtual StatusCode Reset();
 
+    /**
+     *  @brief  Get the scratch arena for the process, providing reusable containers that are cleared when pandora is reset
+     * 
+     *  @return the scratch arena
+     */
+    ScratchArena &GetScratchArena();
+
     /**
      *  @brief  Destructor
      */
@@ -87,6 +95,7 @@ protected:
     const Pandora          *m_pPandora;             ///< The pandora object that will run the process
     std::string             m_type;                 ///< The process type
     std::string             m_instanceName;         ///< The process instance name
+    ScratchArena            m_scratchArena;         ///< The scratch arena, cleared when pandora is reset
 };
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -137,6 +146,13 @@ inline StatusCode Process::Reset()
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+inline ScratchArena &Process::GetScratchArena()
+{
+    return m_scratchArena;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 inline Process::~Process()
 {
 }
@@ -0,0 +1,213 @@
+/**
+ *  @file   PandoraSDK/include/Pandora/ProfileZones.h
+ *
+ *  @brief  Header file defining scoped profiling zones and relevant preprocessor macros
+ *
+ *  $Log: $
+ */
+#ifndef PANDORA_PROFILE_ZONES_H
+#define PANDORA_PROFILE_ZONES_H 1
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+/**
+ *  @brief  Record the time spent in the enclosing scope as a named zone, for the calling thread, compiled out unless
+ *          PANDORA_PROFILE_ZONES is defined. The name must be a string literal, or otherwise outlive the trace output.
+ */
+#ifdef PANDORA_PROFILE_ZONES
+    #define PANDORA_PROFILE_ZONE_CONCATENATE_DETAIL(a, b) a##b
+    #define PANDORA_PROFILE_ZONE_CONCATENATE(a, b) PANDORA_PROFILE_ZONE_CONCATENATE_DETAIL(a, b)
+    #define PANDORA_PROFILE_SCOPE(Name) const pandora::ProfileZone PANDORA_PROFILE_ZONE_CONCATENATE(pandoraProfileZone, __LINE__)(Name)
+#else
+    #define PANDORA_PROFILE_SCOPE(Name)
+#endif
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+namespace pandora
+{
+
+/**
+ *  @brief  ProfileZones class, holding a ring buffer of finished zones for each thread. Recording a zone touches only the buffer of
+ *          the calling thread, so needs no locking; the buffers are read when the trace is written, which should happen between
+ *          events, while no zones are being recorded. Once a buffer is full, the oldest zones are overwritten.
+ */
+class ProfileZones
+{
+public:
+    /**
+     *  @brief  ZoneRecord class, describing a finished zone
+     */
+    class ZoneRecord
+    {
+    public:
+        const char             *m_pName;                ///< The zone name
+        unsigned long long      m_startTime;            ///< The start time, units ns
+        unsigned long long      m_endTime;              ///< The end time, units ns
+    };
+
+    typedef std::vector<std::pair<unsigned int, ZoneRecord> > ThreadZoneRecordVector;
+
+    /**
+     *  @brief  Get the current time, on the steady clock used for all profiling
+     *
+     *  @return the current time, units ns
+     */
+    static unsigned long long GetTimestamp();
+
+    /**
+     *  @brief  Get the index of the calling thread, assigned on first use, which labels the thread in trace output
+     *
+     *  @return the thread index
+     */
+    static unsigned int GetThreadIndex();
+
+    /**
+     *  @brief  Record a finished zone for the calling thread
+     *
+     *  @param  pName the zone name
+     *  @param  startTime the start time, units ns
+     *  @param  endTime the end time, units ns
+     */
+    static void Record(const char *const pName, const unsigned long long startTime, const unsigned long long endTime);
+
+    /**
+     *  @brief  Notify any external profiler of the start of a zone on the calling thread
+     *
+     *  @param  pName the zone name
+     */
+    static void BeginExternalZone(const char *const pName);
+
+    /**
+     *  @brief  Notify any external profiler of the end of the most recently started zone on the calling thread
+     */
+    static void EndExternalZone();
+
+    /**
+     *  @brief  Get the zones recorded by all threads, each labelled by its thread index
+     *
+     *  @param  threadZoneRecordVector to receive the thread indices and zone records
+     */
+    static void GetZoneRecords(ThreadZoneRecordVector &threadZoneRecordVector);
+
+    static const unsigned int   m_bufferSize;           ///< The number of zones held in the ring buffer for each thread
+
+private:
+    /**
+     *  @brief  ThreadBuffer class, the ring buffer of finished zones for a single thread
+     */
+    class ThreadBuffer
+    {
+    public:
+        /**
+         *  @brief  Constructor
+         *
+         *  @param  threadIndex the thread index
+         */
+        ThreadBuffer(const unsigned int threadIndex);
+
+        const unsigned int          m_threadIndex;      ///< The thread index
+        std::vector<ZoneRecord>     m_zoneRecords;      ///< The zone records, allocated when the first zone is recorded
+        std::atomic<unsigned long long> m_nRecorded;    ///< The number of zones recorded, including any overwritten
+    };
+
+    typedef std::shared_ptr<ThreadBuffer> ThreadBufferPtr;
+    typedef std::vector<ThreadBufferPtr> ThreadBufferVector;
+
+    /**
+     *  @brief  Get the ring buffer for the calling thread, registering it on first use. Buffers are shared with the registry, so
+     *          zones recorded by threads that have since exited remain available for trace output.
+     *
+     *  @return the ring buffer for the calling thread
+     */
+    static ThreadBuffer &GetThreadBuffer();
+
+    static ThreadBufferVector   m_threadBufferRegistry;         ///< The ring buffers for all threads, in order of thread index
+    static std::mutex           m_threadBufferRegistryMutex;    ///< The mutex guarding the registry of ring buffers
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  ProfileZone class, recording the time between its construction and destruction as a zone for the calling thread
+ */
+class ProfileZone
+{
+public:
+    /**
+     *  @brief  Constructor
+     *
+     *  @param  pName the zone name, which must outlive the trace output
+     */
+    ProfileZone(const char *const pName);
+
+    /**
+     *  @brief  Destructor
+     */
+    ~ProfileZone();
+
+    /**
+     *  @brief  Deleted copy constructor
+     */
+    ProfileZone(const ProfileZone &) = delete;
+
+    /**
+     *  @brief  Deleted assignment operator
+     */
+    ProfileZone &operator=(const ProfileZone &) = delete;
+
+private:
+    const char *const           m_pName;                ///< The zone name
+    const unsigned long long    m_startTime;            ///< The start time, units ns
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned long long ProfileZones::GetTimestamp()
+{
+    return static_cast<unsigned long long>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline ProfileZones::ThreadBuffer::ThreadBuffer(const unsigned int threadIndex) :
+    m_threadIndex(threadIndex),
+    m_nRecorded(0)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline ProfileZone::ProfileZone(const char *const pName) :
+    m_pName(pName),
+    m_startTime(ProfileZones::GetTimestamp())
+{
+#ifdef PANDORA_PROFILE_ZONES_ITT
+    ProfileZones::BeginExternalZone(m_pName);
+#endif
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline ProfileZone::~ProfileZone()
+{
+    const unsigned long long endTime(ProfileZones::GetTimestamp());
+
+#ifdef PANDORA_PROFILE_ZONES_ITT
+    ProfileZones::EndExternalZone();
+#endif
+
+    ProfileZones::Record(m_pName, m_startTime, endTime);
+}
+
+} // namespace pandora
+
+#endif // #ifndef PANDORA_PROFILE_ZONES_H
@@ -0,0 +1,133 @@
+/**
+ *  @file   PandoraSDK/include/Pandora/ScratchArena.h
+ *
+ *  @brief  Header file for the scratch arena class.
+ *
+ *  $Log: $
+ */
+#ifndef PANDORA_SCRATCH_ARENA_H
+#define PANDORA_SCRATCH_ARENA_H 1
+
+#include "Pandora/StatusCodes.h"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace pandora
+{
+
+/**
+ *  @brief  ScratchArena class, holding named scratch containers owned by a single process. The containers persist for the lifetime
+ *          of the process and are cleared, rather than freed, when pandora is reset. Containers such as vectors and hash maps
+ *          therefore retain their allocated storage between events.
+ */
+class ScratchArena
+{
+public:
+    /**
+     *  @brief  Default constructor
+     */
+    ScratchArena();
+
+    /**
+     *  @brief  Get a named scratch container, creating an empty container on first request. The container type must provide a
+     *          clear() member function. Returned references remain valid for the lifetime of the arena.
+     *
+     *  @param  name the container name, unique within the arena
+     *
+     *  @return the scratch container
+     */
+    template <typename T>
+    T &GetBuffer(const std::string &name);
+
+    /**
+     *  @brief  Clear the contents of all scratch containers, retaining the containers themselves
+     */
+    void Clear();
+
+private:
+    /**
+     *  @brief  BufferBase class, providing type erasure for the scratch containers
+     */
+    class BufferBase
+    {
+    public:
+        /**
+         *  @brief  Destructor
+         */
+        virtual ~BufferBase();
+
+        /**
+         *  @brief  Clear the contents of the container
+         */
+        virtual void Clear() = 0;
+    };
+
+    /**
+     *  @brief  Buffer class, holding a scratch container of a specific type
+     */
+    template <typename T>
+    class Buffer : public BufferBase
+    {
+    public:
+        void Clear();
+
+        T               m_container;                ///< The scratch container
+    };
+
+    typedef std::unordered_map<std::string, std::unique_ptr<BufferBase> > BufferMap;
+
+    BufferMap           m_bufferMap;                ///< The map from container name to scratch container
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline ScratchArena::ScratchArena()
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline T &ScratchArena::GetBuffer(const std::string &name)
+{
+    std::unique_ptr<BufferBase> &pBufferBase(m_bufferMap[name]);
+
+    if (!pBufferBase)
+        pBufferBase.reset(new Buffer<T>);
+
+    Buffer<T> *const pBuffer(dynamic_cast<Buffer<T>*>(pBufferBase.get()));
+
+    // ATTN The same name requested with a different container type
+    if (!pBuffer)
+        throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
+
+    return pBuffer->m_container;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline void ScratchArena::Clear()
+{
+    for (BufferMap::value_type &mapEntry : m_bufferMap)
+        mapEntry.second->Clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline ScratchArena::BufferBase::~BufferBase()
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline void ScratchArena::Buffer<T>::Clear()
+{
+    m_container.clear();
+}
+
+} // namespace pandora
+
+#endif // #ifndef PANDORA_SCRATCH_ARENA_H
@@ -79,7 +79,8 @@ namespace pandora
     d(STATUS_CODE_OUT_OF_RANGE,             "STATUS_CODE_OUT_OF_RANGE"              )                   \
     d(STATUS_CODE_NOT_ALLOWED,              "STATUS_CODE_NOT_ALLOWED"               )                   \
     d(STATUS_CODE_INVALID_PARAMETER,        "STATUS_CODE_INVALID_PARAMETER"         )                   \
-    d(STATUS_CODE_UNCHANGED,                "STATUS_CODE_UNCHANGED"                 )
+    d(STATUS_CODE_UNCHANGED,                "STATUS_CODE_UNCHANGED"                 )                   \
+    d(STATUS_CODE_BUDGET_EXCEEDED,          "STATUS_CODE_BUDGET_EXCEEDED"           )
 
 /**
  *  @brief  The status code enum entry macro
@@ -145,15 +146,21 @@ public:
     std::string ToString() const;
 
     /**
-     *  @brief  Get back trace at point of exception construction (gcc only)
+     *  @brief  Get back trace at point of exception construction (gcc only). The stack addresses are recorded on construction, but
+     *          only converted to symbol names when the back trace is first requested.
      * 
      *  @return The back trace
      */
     const std::string &GetBackTrace() const;
 
 private:
-    const StatusCode    m_statusCode;   ///< The status code
-    std::string         m_backTrace;    ///< The back trace
+    const StatusCode    m_statusCode;                       ///< The status code
+    mutable std::string m_backTrace;                        ///< The back trace, filled on first request
+#if defined(__GNUC__) && defined(BACKTRACE)
+    static const int    m_maxStackDepth = 100;              ///< The maximum number of stack addresses to record
+    void               *m_stackAddresses[m_maxStackDepth];  ///< The stack addresses at the point of exception construction
+    int                 m_stackDepth;                       ///< The number of recorded stack addresses
+#endif
 };
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -162,21 +169,8 @@ inline StatusCodeException::StatusCodeException(const StatusCode statusCode) :
     m_statusCode(statusCode)
 {
 #if defined(__GNUC__) && defined(BACKTRACE)
-    const size_t maxDepth = 100;
-    void *stackAddresses[maxDepth];
-
-    size_t stackDepth = backtrace(stackAddresses, maxDepth);
-    char **stackStrings = backtrace_symbols(stackAddresses, stackDepth);
-
-    m_backTrace = "\nBackTrace\n    ";
-
-    for (size_t i = 0; i < stackDepth; ++i)
-    {
-        m_backTrace += stackStrings[i];
-        m_backTrace += "\n    ";
-    }
-
-    free(stackStrings); // malloc()ed by backtrace_symbols
+    // ATTN Symbolization is expensive and rarely needed, so is deferred until GetBackTrace
+    m_stackDepth = backtrace(m_stackAddresses, m_maxStackDepth);
 #endif
 }
 
@@ -204,6 +198,25 @@ inline std::string StatusCodeException::ToString() const
 
 inline const std::string &StatusCodeException::GetBackTrace() const
 {
+#if defined(__GNUC__) && defined(BACKTRACE)
+    if (m_backTrace.empty() && (m_stackDepth > 0))
+    {
+        char **stackStrings = backtrace_symbols(m_stackAddresses, m_stackDepth);
+
+        if (stackStrings)
+        {
+            m_backTrace = "\nBackTrace\n    ";
+
+            for (int i = 0; i < m_stackDepth; ++i)
+            {
+                m_backTrace += stackStrings[i];
+                m_backTrace += "\n    ";
+            }
+
+            free(stackStrings); // malloc()ed by backtrace_symbols
+        }
+    }
+#endif
     return m_backTrace;
 }
 
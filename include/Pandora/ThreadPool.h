@@ -0,0 +1,404 @@
+/**
+ *  @file   PandoraSDK/include/Pandora/ThreadPool.h
+ *
+ *  @brief  Header file for the thread pool class and the parallel task interfaces.
+ *
+ *  $Log: $
+ */
+#ifndef PANDORA_THREAD_POOL_H
+#define PANDORA_THREAD_POOL_H 1
+
+#include "Pandora/StatusCodes.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace pandora
+{
+
+class AllocationCounters;
+
+/**
+ *  @brief  ParallelForTask class, processing one item of a parallel loop. Run may be called concurrently for different items, so it
+ *          must only read shared state, writing its output to storage owned by the item (e.g. an element of a presized vector).
+ */
+class ParallelForTask
+{
+public:
+    /**
+     *  @brief  Destructor
+     */
+    virtual ~ParallelForTask();
+
+    /**
+     *  @brief  Process a single item
+     *
+     *  @param  index the index of the item
+     */
+    virtual StatusCode Run(const unsigned int index) const = 0;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  ParallelReduceTask class, mapping each item of a parallel loop to a value and combining those values. Map may be called
+ *          concurrently for different items, so it must only read shared state. Combine must be safe to call concurrently. T must be
+ *          default constructible. Map receives a default-constructed value and must assign every field of it, rather than accumulate
+ *          into it, as values are combined only through Combine.
+ */
+template <typename T>
+class ParallelReduceTask
+{
+public:
+    /**
+     *  @brief  Destructor
+     */
+    virtual ~ParallelReduceTask();
+
+    /**
+     *  @brief  Map a single item to a value
+     *
+     *  @param  index the index of the item
+     *  @param  value a default-constructed value, to be assigned the value for the item
+     */
+    virtual StatusCode Map(const unsigned int index, T &value) const = 0;
+
+    /**
+     *  @brief  Combine two values, the first accumulated from items preceding those of the second
+     *
+     *  @param  lhs the first value
+     *  @param  rhs the second value
+     *
+     *  @return the combined value
+     */
+    virtual T Combine(const T &lhs, const T &rhs) const = 0;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  ThreadPool class, a work-stealing pool of worker threads for parallel loops within an algorithm. Items are grouped into
+ *          chunks of a fixed grain size, distributed in contiguous blocks between the worker threads and the calling thread, which
+ *          takes part in the work. A thread that exhausts its own chunks steals from the far end of another thread's queue.
+ *          Only one loop runs on the pool at a time: a loop requested from within a running loop, or on a pool without worker threads,
+ *          runs serially on the calling thread.
+ */
+class ThreadPool
+{
+public:
+    /**
+     *  @brief  Constructor, starting the worker threads
+     *
+     *  @param  nThreads the number of threads to use for each parallel loop, including the calling thread
+     */
+    ThreadPool(const unsigned int nThreads);
+
+    /**
+     *  @brief  Constructor, starting the worker threads pinned to a set of cores
+     *
+     *  @param  nThreads the number of threads to use for each parallel loop, including the calling thread
+     *  @param  coreSet the cores to which the worker threads are pinned (empty to disable)
+     */
+    ThreadPool(const unsigned int nThreads, const std::vector<unsigned int> &coreSet);
+
+    /**
+     *  @brief  Destructor, stopping the worker threads
+     */
+    ~ThreadPool();
+
+    /**
+     *  @brief  Get the number of threads used for each parallel loop, including the calling thread
+     *
+     *  @return the number of threads
+     */
+    unsigned int GetNThreads() const;
+
+    /**
+     *  @brief  Get the cores to which the worker threads are pinned
+     *
+     *  @return the core set, empty if the worker threads are not pinned
+     */
+    const std::vector<unsigned int> &GetCoreSet() const;
+
+    /**
+     *  @brief  Pin the calling thread to a set of cores, e.g. the thread driving a worker pandora instance. Supported on linux only.
+     *
+     *  @param  coreSet the cores to which the thread is pinned (empty to leave the thread unpinned)
+     */
+    static StatusCode PinCurrentThread(const std::vector<unsigned int> &coreSet);
+
+    /**
+     *  @brief  Get the index of the calling thread within the parallel loop it is running: zero for the thread starting the loop and
+     *          the index of its work queue for a worker thread, so below the number of threads of the pool. Zero outside any loop.
+     *
+     *  @return the thread index
+     */
+    static unsigned int GetCurrentThreadIndex();
+
+    /**
+     *  @brief  Run a task for each of a number of items, returning once all items have been processed. If any item fails, the
+     *          status returned is that of the first failing item in index order, independent of scheduling.
+     *
+     *  @param  nItems the number of items
+     *  @param  task the task to run for each item
+     *  @param  grainSize the number of consecutive items in each chunk of work
+     */
+    StatusCode ParallelFor(const unsigned int nItems, const ParallelForTask &task, const unsigned int grainSize);
+
+    /**
+     *  @brief  Map each of a number of items to a value and combine the values into a result. The values within each chunk are
+     *          combined in index order, starting from the value of the first item, then the initial result is combined with each chunk
+     *          value in turn, in chunk order. The initial result therefore enters the combination exactly once and each item value is
+     *          counted once. The result does not depend on the number of threads or the scheduling, nor, for an associative Combine,
+     *          on the grain size, beyond floating point rounding.
+     *
+     *  @param  nItems the number of items
+     *  @param  task the task mapping and combining the items
+     *  @param  result the initial result, to receive the combined result
+     *  @param  grainSize the number of consecutive items in each chunk of work
+     */
+    template <typename T>
+    StatusCode ParallelReduce(const unsigned int nItems, const ParallelReduceTask<T> &task, T &result, const unsigned int grainSize);
+
+private:
+    /**
+     *  @brief  ChunkTask class, processing a chunk of consecutive items
+     */
+    class ChunkTask
+    {
+    public:
+        /**
+         *  @brief  Destructor
+         */
+        virtual ~ChunkTask();
+
+        /**
+         *  @brief  Process a chunk of consecutive items
+         *
+         *  @param  chunkIndex the index of the chunk
+         *  @param  firstIndex the index of the first item in the chunk
+         *  @param  endIndex the index one beyond the last item in the chunk
+         */
+        virtual StatusCode Run(const unsigned int chunkIndex, const unsigned int firstIndex, const unsigned int endIndex) const = 0;
+    };
+
+    /**
+     *  @brief  ForChunkTask class, running a parallel for task for each item in a chunk
+     */
+    class ForChunkTask : public ChunkTask
+    {
+    public:
+        /**
+         *  @brief  Constructor
+         *
+         *  @param  task the parallel for task
+         */
+        ForChunkTask(const ParallelForTask &task);
+
+        StatusCode Run(const unsigned int chunkIndex, const unsigned int firstIndex, const unsigned int endIndex) const;
+
+    private:
+        const ParallelForTask  &m_task;                 ///< The parallel for task
+    };
+
+    /**
+     *  @brief  ReduceChunkTask class, mapping the items in a chunk and combining their values into a value for the chunk
+     */
+    template <typename T>
+    class ReduceChunkTask : public ChunkTask
+    {
+    public:
+        /**
+         *  @brief  Constructor
+         *
+         *  @param  task the parallel reduce task
+         *  @param  chunkValues the chunk values, presized to the number of chunks, to receive the value for each chunk
+         */
+        ReduceChunkTask(const ParallelReduceTask<T> &task, std::deque<T> &chunkValues);
+
+        StatusCode Run(const unsigned int chunkIndex, const unsigned int firstIndex, const unsigned int endIndex) const;
+
+    private:
+        const ParallelReduceTask<T>    &m_task;         ///< The parallel reduce task
+        std::deque<T>                  &m_chunkValues;  ///< The chunk values, with one element per chunk
+    };
+
+    /**
+     *  @brief  WorkQueue class, holding the indices of the chunks awaiting processing by a single thread
+     */
+    class WorkQueue
+    {
+    public:
+        std::mutex                  m_mutex;            ///< The mutex protecting the chunk indices
+        std::deque<unsigned int>    m_chunkIndices;     ///< The indices of the chunks awaiting processing
+    };
+
+    typedef std::vector<std::thread> ThreadVector;
+
+    /**
+     *  @brief  Get the number of chunks for a number of items and a grain size
+     *
+     *  @param  nItems the number of items
+     *  @param  grainSize the number of consecutive items in each chunk
+     *
+     *  @return the number of chunks
+     */
+    static unsigned int GetNChunks(const unsigned int nItems, const unsigned int grainSize);
+
+    /**
+     *  @brief  Process all chunks of a parallel loop, using the worker threads if possible
+     *
+     *  @param  nItems the number of items
+     *  @param  grainSize the number of consecutive items in each chunk
+     *  @param  chunkTask the task processing each chunk
+     */
+    StatusCode RunChunks(const unsigned int nItems, const unsigned int grainSize, const ChunkTask &chunkTask);
+
+    /**
+     *  @brief  Process a single chunk, converting any exception into a status code
+     *
+     *  @param  chunkTask the task processing each chunk
+     *  @param  chunkIndex the index of the chunk
+     *  @param  nItems the number of items
+     *  @param  grainSize the number of consecutive items in each chunk
+     */
+    static StatusCode RunChunk(const ChunkTask &chunkTask, const unsigned int chunkIndex, const unsigned int nItems, const unsigned int grainSize);
+
+    /**
+     *  @brief  Process chunks from a thread's own work queue, then steal chunks from the other work queues, until none remain
+     *
+     *  @param  queueIndex the index of the thread's own work queue
+     */
+    void ProcessChunks(const unsigned int queueIndex);
+
+    /**
+     *  @brief  Take the index of the next chunk to process, from the front of a thread's own work queue or the back of another
+     *
+     *  @param  queueIndex the index of the thread's own work queue
+     *  @param  chunkIndex to receive the index of the chunk
+     *
+     *  @return whether a chunk was found
+     */
+    bool PopChunk(const unsigned int queueIndex, unsigned int &chunkIndex);
+
+    /**
+     *  @brief  Process the chunks of each parallel loop until the pool is stopped
+     *
+     *  @param  queueIndex the index of the worker thread's own work queue
+     */
+    void RunWorker(const unsigned int queueIndex);
+
+    const unsigned int          m_nThreads;             ///< The number of threads used for each parallel loop, including the calling thread
+    const std::vector<unsigned int> m_coreSet;          ///< The cores to which the worker threads are pinned, empty if not pinned
+    WorkQueue                  *m_pWorkQueues;          ///< The work queues, one per thread, with the calling thread using the first
+    ThreadVector                m_threadVector;         ///< The worker threads
+
+    const ChunkTask            *m_pChunkTask;           ///< The task processing each chunk of the running loop
+    unsigned int                m_nItems;               ///< The number of items in the running loop
+    unsigned int                m_grainSize;            ///< The number of consecutive items in each chunk of the running loop
+    std::atomic<unsigned int>   m_firstFailedChunk;     ///< The index of the first failed chunk of the running loop, later chunks are skipped
+    StatusCode                  m_statusCode;           ///< The status code of the first failed chunk of the running loop
+    AllocationCounters         *m_pAllocationCounters;  ///< The allocation counters of the calling thread, adopted by the worker threads
+
+    bool                        m_isRunning;            ///< Whether a parallel loop is running
+    unsigned int                m_generation;           ///< The number of parallel loops started on the worker threads
+    unsigned int                m_nBusyWorkers;         ///< The number of worker threads processing chunks of the running loop
+    bool                        m_shouldStop;           ///< Whether the worker threads have been asked to stop
+    std::mutex                  m_mutex;                ///< The mutex protecting the running loop and flags
+    std::condition_variable     m_condition;            ///< The condition variable signalling changes to the running loop and flags
+
+    static thread_local unsigned int m_currentThreadIndex;  ///< The index of the calling thread within its running loop
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline ParallelReduceTask<T>::~ParallelReduceTask()
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int ThreadPool::GetNThreads() const
+{
+    return m_nThreads;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const std::vector<unsigned int> &ThreadPool::GetCoreSet() const
+{
+    return m_coreSet;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int ThreadPool::GetCurrentThreadIndex()
+{
+    return m_currentThreadIndex;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline StatusCode ThreadPool::ParallelReduce(const unsigned int nItems, const ParallelReduceTask<T> &task, T &result, const unsigned int grainSize)
+{
+    if (0 == grainSize)
+        return STATUS_CODE_INVALID_PARAMETER;
+
+    std::deque<T> chunkValues(ThreadPool::GetNChunks(nItems, grainSize));
+    const ReduceChunkTask<T> chunkTask(task, chunkValues);
+    const StatusCode statusCode(this->RunChunks(nItems, grainSize, chunkTask));
+
+    if (STATUS_CODE_SUCCESS != statusCode)
+        return statusCode;
+
+    for (const T &chunkValue : chunkValues)
+        result = task.Combine(result, chunkValue);
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline ThreadPool::ReduceChunkTask<T>::ReduceChunkTask(const ParallelReduceTask<T> &task, std::deque<T> &chunkValues) :
+    m_task(task),
+    m_chunkValues(chunkValues)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline StatusCode ThreadPool::ReduceChunkTask<T>::Run(const unsigned int chunkIndex, const unsigned int firstIndex, const unsigned int endIndex) const
+{
+    // ATTN Failures are returned without printing, as several threads may fail at once
+    T chunkValue = T();
+    const StatusCode firstStatusCode(m_task.Map(firstIndex, chunkValue));
+
+    if (STATUS_CODE_SUCCESS != firstStatusCode)
+        return firstStatusCode;
+
+    for (unsigned int index = firstIndex + 1; index < endIndex; ++index)
+    {
+        T value = T();
+        const StatusCode statusCode(m_task.Map(index, value));
+
+        if (STATUS_CODE_SUCCESS != statusCode)
+            return statusCode;
+
+        chunkValue = m_task.Combine(chunkValue, value);
+    }
+
+    m_chunkValues[chunkIndex] = chunkValue;
+    return STATUS_CODE_SUCCESS;
+}
+
+} // namespace pandora
+
+#endif // #ifndef PANDORA_THREAD_POOL_H
@@ -9,13 +9,17 @@
 #define PANDORA_BINARY_FILE_READER_H 1
 
 #include "Pandora/Pandora.h"
+#include "Pandora/ThreadPool.h"
 
 #include "Objects/CartesianVector.h"
+#include "Objects/Histograms.h"
 #include "Objects/TrackState.h"
 
 #include "Persistency/FileReader.h"
 
+#include <cstring>
 #include <fstream>
+#include <sstream>
 
 namespace pandora
 {
@@ -31,8 +35,20 @@ public:
      * 
      *  @param  pandora the pandora instance to be used alongside the file reader
      *  @param  fileName the name of the file containing the pandora objects
+     *  @param  useMemoryMap whether to map the whole file into memory and decode variables directly from the mapped bytes, rather than
+     *          reading each variable from a file stream
      */
-    BinaryFileReader(const pandora::Pandora &pandora, const std::string &fileName);
+    BinaryFileReader(const pandora::Pandora &pandora, const std::string &fileName, const bool useMemoryMap = false);
+
+    /**
+     *  @brief  Constructor, reading from a caller-owned buffer holding the contents of a binary file, rather than from a named file.
+     *          Variables are decoded directly from the buffer, without copying, so the buffer must outlive the reader and be unchanged.
+     * 
+     *  @param  pandora the pandora instance to be used alongside the file reader
+     *  @param  pBuffer the address of the buffer
+     *  @param  bufferSize the size of the buffer
+     */
+    BinaryFileReader(const pandora::Pandora &pandora, const void *const pBuffer, const std::size_t bufferSize);
 
     /**
      *  @brief  Destructor
@@ -40,12 +56,71 @@ public:
     ~BinaryFileReader();
 
     /**
-     *  @brief  Read a variable from the file
+     *  @brief  Read a variable from the file. Histograms are read into a newly allocated histogram, owned by the caller.
      */
     template<typename T>
     StatusCode ReadVariable(T &t);
 
+    /**
+     *  @brief  Read the reconstruction container, if any, immediately following the event container just read, recreating the stored
+     *          clusters, vertices and pfos and saving them in the named lists recorded in the file. Calo hits and tracks are identified
+     *          via their parent addresses, so must be present, with their original parent addresses, in the current lists.
+     * 
+     *  @param  algorithm the algorithm in which the objects are to be created
+     * 
+     *  @return STATUS_CODE_NOT_FOUND if the next container is not a reconstruction container
+     */
+    StatusCode ReadReconstruction(const Algorithm &algorithm);
+
 private:
+    typedef std::vector<std::ifstream::pos_type> PositionVector;
+    typedef std::vector<char> ByteVector;
+    typedef std::unordered_map<const void*, const CaloHit*> CaloHitAddressMap;
+    typedef std::unordered_map<const void*, const Track*> TrackAddressMap;
+    typedef std::unordered_map<const void*, const Cluster*> ClusterAddressMap;
+    typedef std::unordered_map<const void*, const Vertex*> VertexAddressMap;
+    typedef std::unordered_map<const void*, const ParticleFlowObject*> PfoAddressMap;
+    typedef std::vector<std::pair<const ParticleFlowObject*, const void*> > PfoDaughterAddressVector;
+    typedef std::vector<object_creation::CaloHit::Parameters*> CaloHitParametersVector;
+
+    /**
+     *  @brief  CaloHitDecodingTask class, decoding a single packed calo hit record. Each item writes only to its own calo hit parameters.
+     */
+    class CaloHitDecodingTask : public ParallelForTask
+    {
+    public:
+        /**
+         *  @brief  Constructor
+         *
+         *  @param  pRecordBytes the address of the first packed calo hit record
+         *  @param  parametersVector the calo hit parameters, one per record
+         */
+        CaloHitDecodingTask(const char *const pRecordBytes, const CaloHitParametersVector &parametersVector);
+
+        StatusCode Run(const unsigned int index) const;
+
+    private:
+        const char *const               m_pRecordBytes;         ///< The address of the first packed calo hit record
+        const CaloHitParametersVector  &m_parametersVector;     ///< The calo hit parameters, one per record
+    };
+
+    /**
+     *  @brief  ReconstructionState class, holding the objects recreated whilst reading a reconstruction container
+     */
+    class ReconstructionState
+    {
+    public:
+        CaloHitAddressMap           m_caloHitAddressMap;        ///< The current calo hits, keyed on parent address
+        TrackAddressMap             m_trackAddressMap;          ///< The current tracks, keyed on parent address
+        ClusterAddressMap           m_clusterAddressMap;        ///< The recreated clusters, keyed on stored address
+        VertexAddressMap            m_vertexAddressMap;         ///< The recreated vertices, keyed on stored address
+        PfoAddressMap               m_pfoAddressMap;            ///< The recreated pfos, keyed on stored address
+        PfoDaughterAddressVector    m_pfoDaughterAddresses;     ///< The recreated pfos and the stored addresses of their daughters
+        std::string                 m_clusterListName;          ///< The temporary cluster list name, empty until a cluster is read
+        std::string                 m_vertexListName;           ///< The temporary vertex list name, empty until a vertex is read
+        std::string                 m_pfoListName;              ///< The temporary pfo list name, empty until a pfo is read
+    };
+
     StatusCode ReadHeader();
     StatusCode GoToNextContainer();
     ContainerId GetNextContainerId();
@@ -96,6 +171,41 @@ private:
      */
     StatusCode ReadCaloHit(bool checkComponentId = true);
 
+    /**
+     *  @brief  Read a calo hit block from the current position in the file, recreating the stored objects
+     * 
+     *  @param  checkComponentId whether to check the component id before deserializing
+     */
+    StatusCode ReadCaloHitBlock(bool checkComponentId = true);
+
+    /**
+     *  @brief  Read the factory-extension data for the calo hits in a calo hit block, decode their packed records concurrently on the
+     *          pandora thread pool, then recreate the calo hits in file order
+     * 
+     *  @param  nCaloHits the number of calo hits in the block
+     *  @param  pRecordBytes the address of the first packed calo hit record
+     *  @param  threadPool the thread pool
+     */
+    StatusCode ReadCaloHitRecordsInParallel(const unsigned int nCaloHits, const char *const pRecordBytes, ThreadPool &threadPool);
+
+    /**
+     *  @brief  Read the factory-extension data for the calo hits in a calo hit block, decode their packed records, concurrently on the
+     *          pandora thread pool if worthwhile, then create the calo hits as a single batch. For use only if CanCreateCaloHitBatch.
+     * 
+     *  @param  nCaloHits the number of calo hits in the block
+     *  @param  pRecordBytes the address of the first packed calo hit record
+     *  @param  threadPool the thread pool
+     */
+    StatusCode ReadCaloHitRecordsAsBatch(const unsigned int nCaloHits, const char *const pRecordBytes, ThreadPool &threadPool);
+
+    /**
+     *  @brief  Fill calo hit parameters from a packed calo hit record
+     * 
+     *  @param  pRecordBytes the address of the packed calo hit record, which need not be aligned
+     *  @param  parameters to receive the calo hit parameters
+     */
+    static void FillCaloHitParameters(const char *const pRecordBytes, object_creation::CaloHit::Parameters &parameters);
+
     /**
      *  @brief  Read a track from the current position in the file, recreating the stored object
      * 
@@ -117,16 +227,168 @@ private:
      */
     StatusCode ReadRelationship(bool checkComponentId = true);
 
+    /**
+     *  @brief  Read the contents of the current reconstruction container, recreating the stored objects
+     * 
+     *  @param  algorithm the algorithm in which the objects are to be created
+     */
+    StatusCode ReadReconstructionComponents(const Algorithm &algorithm);
+
+    /**
+     *  @brief  Read a cluster from the current position in the reconstruction container, recreating the stored object
+     * 
+     *  @param  algorithm the algorithm in which the cluster is to be created
+     *  @param  state the reconstruction state
+     */
+    StatusCode ReadCluster(const Algorithm &algorithm, ReconstructionState &state);
+
+    /**
+     *  @brief  Read a vertex from the current position in the reconstruction container, recreating the stored object
+     * 
+     *  @param  algorithm the algorithm in which the vertex is to be created
+     *  @param  state the reconstruction state
+     */
+    StatusCode ReadVertex(const Algorithm &algorithm, ReconstructionState &state);
+
+    /**
+     *  @brief  Read a pfo from the current position in the reconstruction container, recreating the stored object
+     * 
+     *  @param  algorithm the algorithm in which the pfo is to be created
+     *  @param  state the reconstruction state
+     */
+    StatusCode ReadPfo(const Algorithm &algorithm, ReconstructionState &state);
+
+    /**
+     *  @brief  Read a list of stored addresses, preceded by the number of entries, and resolve each using an address map
+     * 
+     *  @param  addressMap the address map
+     *  @param  t to receive the resolved objects
+     */
+    template <typename MAP, typename T>
+    StatusCode ReadAddresses(const MAP &addressMap, T &t);
+
+    /**
+     *  @brief  Read the container header, without decompressing the container contents
+     * 
+     *  @param  isCompressed to receive whether the container contents are compressed
+     */
+    StatusCode ReadContainerHeader(bool &isCompressed);
+
+    /**
+     *  @brief  Decompress the contents of the current container into the container buffer, from which all subsequent variables are read
+     *          until the read position is next changed, leaving the file read position at the container end
+     */
+    StatusCode DecompressContainer();
+
+    /**
+     *  @brief  Read the file index, if present, then return to the start of the file
+     */
+    void InitializeIndex();
+
+    /**
+     *  @brief  Read the event and geometry container positions from the index at the end of the file
+     */
+    StatusCode ReadIndex();
+
+    /**
+     *  @brief  Get the current read position in the file
+     * 
+     *  @return the current read position
+     */
+    std::ifstream::pos_type GetPosition();
+
+    /**
+     *  @brief  Set the read position in the file
+     * 
+     *  @param  position the read position, relative to the start of the file
+     */
+    StatusCode SetPosition(const std::ifstream::pos_type position);
+
+    /**
+     *  @brief  Copy bytes from the current position in the memory-mapped file, advancing the read position
+     * 
+     *  @param  pDestination the destination address
+     *  @param  nBytes the number of bytes to copy
+     */
+    StatusCode ReadMappedBytes(void *const pDestination, const std::size_t nBytes);
+
+    /**
+     *  @brief  Copy bytes from the current position in the container buffer, advancing the buffer read position
+     * 
+     *  @param  pDestination the destination address
+     *  @param  nBytes the number of bytes to copy
+     */
+    StatusCode ReadBufferedBytes(void *const pDestination, const std::size_t nBytes);
+
+    /**
+     *  @brief  Get a view of bytes from the current read position, advancing the read position. The view addresses the memory-mapped
+     *          file or container buffer directly where possible, or otherwise the block buffer, and is valid until the next read.
+     * 
+     *  @param  nBytes the number of bytes
+     *  @param  pBytes to receive the address of the bytes
+     */
+    StatusCode ReadBytesView(const std::size_t nBytes, const char *&pBytes);
+
     std::ifstream::pos_type         m_containerPosition;    ///< Position of start of the current event/geometry container object in file
     std::ifstream::pos_type         m_containerSize;        ///< Size of the current event/geometry container object in the file
-    std::ifstream                   m_fileStream;           ///< The stream class to read from the file
+    std::ifstream                   m_fileStream;           ///< The stream class to read from the file, if not memory-mapped
+
+    bool                            m_isMemoryMapped;       ///< Whether the file is memory-mapped, rather than read via the file stream
+    bool                            m_isCallerBuffer;       ///< Whether the mapped contents are a caller-owned buffer, rather than a mapped file
+    const char                     *m_pMappedFile;          ///< The address of the memory-mapped file contents
+    std::size_t                     m_mappedFileSize;       ///< The size of the memory-mapped file
+    std::size_t                     m_readLimit;            ///< The end of the readable region, the current container end where known
+    std::size_t                     m_mappedPosition;       ///< The current read position in the memory-mapped file
+
+    PositionVector                  m_eventPositions;       ///< The event container header positions, from the file index if present
+    PositionVector                  m_geometryPositions;    ///< The geometry container header positions, from the file index if present
+
+    bool                            m_isReadingContainerBuffer; ///< Whether variables are read from the container buffer, rather than the file
+    ByteVector                      m_containerBuffer;      ///< The decompressed contents of the current container
+    ByteVector                      m_compressionBuffer;    ///< The compressed contents of the current container, if read via the file stream
+    std::size_t                     m_bufferPosition;       ///< The current read position in the container buffer
+    ByteVector                      m_blockBuffer;          ///< The contents of the current calo hit block, if read via the file stream
+
+    static const unsigned int       m_caloHitDecodingGrainSize; ///< The number of calo hit records decoded in each chunk of work, and the minimum for parallel decoding
 };
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+inline StatusCode BinaryFileReader::ReadMappedBytes(void *const pDestination, const std::size_t nBytes)
+{
+    if (nBytes > m_readLimit - m_mappedPosition)
+        return STATUS_CODE_FAILURE;
+
+    std::memcpy(pDestination, m_pMappedFile + m_mappedPosition, nBytes);
+    m_mappedPosition += nBytes;
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline StatusCode BinaryFileReader::ReadBufferedBytes(void *const pDestination, const std::size_t nBytes)
+{
+    if (nBytes > m_containerBuffer.size() - m_bufferPosition)
+        return STATUS_CODE_FAILURE;
+
+    std::memcpy(pDestination, m_containerBuffer.data() + m_bufferPosition, nBytes);
+    m_bufferPosition += nBytes;
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 template<typename T>
 inline StatusCode BinaryFileReader::ReadVariable(T &t)
 {
+    if (m_isReadingContainerBuffer)
+        return this->ReadBufferedBytes(&t, sizeof(T));
+
+    if (m_isMemoryMapped)
+        return this->ReadMappedBytes(&t, sizeof(T));
+
     char *const pMemBlock = new char[sizeof(T)];
     m_fileStream.read(pMemBlock, sizeof(T));
 
@@ -148,6 +410,28 @@ inline StatusCode BinaryFileReader::ReadVariable(std::string &t)
     if (STATUS_CODE_SUCCESS != statusCode)
         return statusCode;
 
+    if (m_isReadingContainerBuffer)
+    {
+        if (stringSize > m_containerBuffer.size() - m_bufferPosition)
+            return STATUS_CODE_FAILURE;
+
+        t.assign(m_containerBuffer.data() + m_bufferPosition, stringSize);
+        m_bufferPosition += stringSize;
+
+        return STATUS_CODE_SUCCESS;
+    }
+
+    if (m_isMemoryMapped)
+    {
+        if (stringSize > m_readLimit - m_mappedPosition)
+            return STATUS_CODE_FAILURE;
+
+        t.assign(m_pMappedFile + m_mappedPosition, stringSize);
+        m_mappedPosition += stringSize;
+
+        return STATUS_CODE_SUCCESS;
+    }
+
     char *const pMemBlock = new char[stringSize];
     m_fileStream.read(pMemBlock, stringSize);
 
@@ -183,6 +467,44 @@ inline StatusCode BinaryFileReader::ReadVariable(TrackState &t)
     return STATUS_CODE_SUCCESS;
 }
 
+template<>
+inline StatusCode BinaryFileReader::ReadVariable(Histogram *&t)
+{
+    std::string binaryImage;
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(binaryImage));
+
+    try
+    {
+        std::istringstream binaryStream(binaryImage);
+        t = new Histogram(binaryStream);
+    }
+    catch (const StatusCodeException &statusCodeException)
+    {
+        return statusCodeException.GetStatusCode();
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
+template<>
+inline StatusCode BinaryFileReader::ReadVariable(TwoDHistogram *&t)
+{
+    std::string binaryImage;
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(binaryImage));
+
+    try
+    {
+        std::istringstream binaryStream(binaryImage);
+        t = new TwoDHistogram(binaryStream);
+    }
+    catch (const StatusCodeException &statusCodeException)
+    {
+        return statusCodeException.GetStatusCode();
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
 } // namespace pandora
 
 #endif // #ifndef PANDORA_BINARY_FILE_READER_H
@@ -11,15 +11,21 @@
 #include "Pandora/Pandora.h"
 
 #include "Objects/CartesianVector.h"
+#include "Objects/Histograms.h"
 #include "Objects/TrackState.h"
 
 #include "Persistency/FileWriter.h"
 
 #include <fstream>
+#include <sstream>
 
 namespace pandora
 {
 
+class ContainerWriteQueue;
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 /**
  *  @brief  BinaryFileWriter class
  */
@@ -32,33 +38,156 @@ public:
      *  @param  algorithm the pandora instance to be used alongside the file writer
      *  @param  fileName the name of the output file
      *  @param  fileMode the mode for file writing
+     *  @param  shouldWriteIndex whether to end the file with an index of the event and geometry container positions, written when the
+     *          file writer is destroyed, and covering any containers already present in an appended file
+     *  @param  shouldCompress whether to compress the contents of each event and geometry container, requiring a build with
+     *          PANDORA_COMPRESSED_PERSISTENCY
+     *  @param  nQueuedContainers the maximum number of serialized containers to hold in memory whilst a background thread writes them
+     *          to the file, in order, or zero to write each container before returning
+     *  @param  shouldPackCaloHits whether to write the calo hits of each event as a single calo hit block component, holding packed
+     *          fixed-size records, rather than as individual calo hit components
+     */
+    BinaryFileWriter(const pandora::Pandora &pandora, const std::string &fileName, const FileMode fileMode = APPEND,
+        const bool shouldWriteIndex = false, const bool shouldCompress = false, const unsigned int nQueuedContainers = 0,
+        const bool shouldPackCaloHits = false);
+
+    /**
+     *  @brief  Constructor, appending each completed container to a caller-owned buffer, rather than writing to a named file. The buffer
+     *          then holds the contents of a binary file, readable via the buffer constructor of the binary file reader, and must outlive
+     *          the file writer, which appends any index or incomplete container when destroyed.
+     * 
+     *  @param  algorithm the pandora instance to be used alongside the file writer
+     *  @param  outputBuffer the buffer to receive the containers, which must be empty if an index is to be written
+     *  @param  shouldWriteIndex whether to end the buffer with an index of the event and geometry container positions
+     *  @param  shouldCompress whether to compress the contents of each event and geometry container, requiring a build with
+     *          PANDORA_COMPRESSED_PERSISTENCY
+     *  @param  shouldPackCaloHits whether to write the calo hits of each event as a single calo hit block component
      */
-    BinaryFileWriter(const pandora::Pandora &pandora, const std::string &fileName, const FileMode fileMode = APPEND);
+    BinaryFileWriter(const pandora::Pandora &pandora, std::vector<char> &outputBuffer, const bool shouldWriteIndex = false,
+        const bool shouldCompress = false, const bool shouldPackCaloHits = false);
 
     /**
-     *  @brief  Destructor
+     *  @brief  Destructor, completing any queued writes before closing the file
      */
     ~BinaryFileWriter();
 
     /**
-     *  @brief  Write a variable to the file
+     *  @brief  Write reconstruction outputs to the file, in a reconstruction container following the event container to which they
+     *          belong. Calo hits and tracks are identified by their parent addresses, as in the event container, whilst the clusters,
+     *          vertices and daughters of each pfo must be present in the lists written. Reconstruction containers are not compressed
+     *          and are not listed in any file index.
+     * 
+     *  @param  clusterListName the name under which the clusters are to be saved when read
+     *  @param  clusterList the list of clusters to write to the file
+     *  @param  vertexListName the name under which the vertices are to be saved when read
+     *  @param  vertexList the list of vertices to write to the file
+     *  @param  pfoListName the name under which the pfos are to be saved when read
+     *  @param  pfoList the list of pfos to write to the file
+     */
+    StatusCode WriteReconstruction(const std::string &clusterListName, const ClusterList &clusterList, const std::string &vertexListName,
+        const VertexList &vertexList, const std::string &pfoListName, const PfoList &pfoList);
+
+    /**
+     *  @brief  Write a variable to the file, via the container buffer. Histograms are written as their binary image.
      */
     template<typename T>
     StatusCode WriteVariable(const T &t);
 
 private:
+    typedef std::pair<ContainerId, std::ofstream::pos_type> IndexEntry;
+    typedef std::vector<IndexEntry> IndexEntryVector;
+    typedef std::vector<char> ByteVector;
+
     StatusCode WriteHeader(const ContainerId containerId);
     StatusCode WriteFooter();
     StatusCode WriteSubDetector(const SubDetector *const pSubDetector);
     StatusCode WriteLArTPC(const LArTPC *const pLArTPC);
     StatusCode WriteDetectorGap(const DetectorGap *const pDetectorGap);
     StatusCode WriteCaloHit(const CaloHit *const pCaloHit);
+    StatusCode WriteCaloHitList(const CaloHitList &caloHitList);
     StatusCode WriteTrack(const Track *const pTrack);
     StatusCode WriteMCParticle(const MCParticle *const pMCParticle);
     StatusCode WriteRelationship(const RelationshipId relationshipId, const void *address1, const void *address2, const float weight);
 
-    std::ofstream::pos_type     m_containerPosition;    ///< Position of start of the current event/geometry container object in file
+    /**
+     *  @brief  Write a cluster to the current position in the reconstruction container
+     * 
+     *  @param  pCluster address of the cluster
+     */
+    StatusCode WriteCluster(const Cluster *const pCluster);
+
+    /**
+     *  @brief  Write a vertex to the current position in the reconstruction container
+     * 
+     *  @param  pVertex address of the vertex
+     */
+    StatusCode WriteVertex(const Vertex *const pVertex);
+
+    /**
+     *  @brief  Write a pfo to the current position in the reconstruction container
+     * 
+     *  @param  pPfo address of the pfo
+     */
+    StatusCode WritePfo(const ParticleFlowObject *const pPfo);
+
+    /**
+     *  @brief  Write the parent addresses of a list of calo hits or tracks, preceded by the number of entries
+     * 
+     *  @param  t the list
+     */
+    template <typename T>
+    StatusCode WriteParentAddresses(const T &t);
+
+    /**
+     *  @brief  Write the addresses of a list of clusters, vertices or pfos, preceded by the number of entries
+     * 
+     *  @param  t the list
+     */
+    template <typename T>
+    StatusCode WriteAddresses(const T &t);
+
+    /**
+     *  @brief  Add the event and geometry containers already present in a file to the index
+     * 
+     *  @param  fileName the name of the file
+     *  @param  writePosition to receive the position from which to continue writing, overwriting any existing index at the file end
+     */
+    StatusCode IndexExistingContainers(const std::string &fileName, std::ofstream::pos_type &writePosition);
+
+    /**
+     *  @brief  Write the index container to the current position in the file
+     */
+    StatusCode WriteIndex();
+
+    /**
+     *  @brief  Replace the contents of the container held in the container buffer with their compressed form
+     */
+    StatusCode CompressContainerBuffer();
+
+    /**
+     *  @brief  Fill the size field of the container held in the container buffer, then write the buffer contents to the file, or hand
+     *          them to the container write queue, if any
+     */
+    StatusCode WriteContainerBuffer();
+
+    /**
+     *  @brief  Get the position in the file at which the next variable will be written, once the container buffer is written
+     * 
+     *  @return the position
+     */
+    std::ofstream::pos_type GetWritePosition();
+
+    ByteVector                  m_containerBuffer;      ///< The serialized contents of the current container, written to file in one call
+    ByteVector                  m_compressionBuffer;    ///< The compressed form of the current container, swapped into the container buffer
+    std::size_t                 m_containerSizeOffset;  ///< Offset of the size field of the current container in the container buffer
     std::ofstream               m_fileStream;           ///< The stream class to write to the file
+    ByteVector                 *m_pOutputBuffer;        ///< Address of the caller-owned buffer receiving the containers, if not writing to file
+    std::ofstream::pos_type     m_filePosition;         ///< The position in the file following the last container written or queued
+    ContainerWriteQueue        *m_pContainerWriteQueue; ///< Address of the queue writing containers in a background thread, if any
+    bool                        m_shouldWriteIndex;     ///< Whether to end the file with an index of the container positions
+    bool                        m_shouldCompress;       ///< Whether to compress the contents of each event and geometry container
+    bool                        m_shouldPackCaloHits;   ///< Whether to write the calo hits of each event as a calo hit block component
+    IndexEntryVector            m_indexEntryVector;     ///< The id and header position of each event and geometry container in the file
 };
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -66,10 +195,8 @@ private:
 template<typename T>
 inline StatusCode BinaryFileWriter::WriteVariable(const T &t)
 {
-    m_fileStream.write(reinterpret_cast<const char*>(&t), sizeof(T));
-
-    if (!m_fileStream.good())
-        return STATUS_CODE_FAILURE;
+    const char *const pMemBlock(reinterpret_cast<const char*>(&t));
+    m_containerBuffer.insert(m_containerBuffer.end(), pMemBlock, pMemBlock + sizeof(T));
 
     return STATUS_CODE_SUCCESS;
 }
@@ -79,10 +206,7 @@ inline StatusCode BinaryFileWriter::WriteVariable(const std::string &t)
 {
     const unsigned int stringSize(t.size());
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteVariable(stringSize));
-    m_fileStream.write(reinterpret_cast<const char*>(t.c_str()), stringSize);
-
-    if (!m_fileStream.good())
-        return STATUS_CODE_FAILURE;
+    m_containerBuffer.insert(m_containerBuffer.end(), t.c_str(), t.c_str() + stringSize);
 
     return STATUS_CODE_SUCCESS;
 }
@@ -104,6 +228,22 @@ inline StatusCode BinaryFileWriter::WriteVariable(const TrackState &t)
     return STATUS_CODE_SUCCESS;
 }
 
+template<>
+inline StatusCode BinaryFileWriter::WriteVariable(const Histogram &t)
+{
+    std::ostringstream binaryStream;
+    t.WriteToBinary(binaryStream);
+    return this->WriteVariable(binaryStream.str());
+}
+
+template<>
+inline StatusCode BinaryFileWriter::WriteVariable(const TwoDHistogram &t)
+{
+    std::ostringstream binaryStream;
+    t.WriteToBinary(binaryStream);
+    return this->WriteVariable(binaryStream.str());
+}
+
 } // namespace pandora
 
 #endif // #ifndef PANDORA_BINARY_FILE_WRITER_H
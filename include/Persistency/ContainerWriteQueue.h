@@ -0,0 +1,85 @@
+/**
+ *  @file   PandoraSDK/include/Persistency/ContainerWriteQueue.h
+ * 
+ *  @brief  Header file for the container write queue class.
+ * 
+ *  $Log: $
+ */
+#ifndef PANDORA_CONTAINER_WRITE_QUEUE_H
+#define PANDORA_CONTAINER_WRITE_QUEUE_H 1
+
+#include "Pandora/StatusCodes.h"
+
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace pandora
+{
+
+/**
+ *  @brief  ContainerWriteQueue class, writing serialized containers to a file stream in a background thread, so that disk writes overlap
+ *          with the processing of later events. Containers are written in the order in which they are queued. Whilst a queue exists,
+ *          the file stream must only be written via the queue.
+ */
+class ContainerWriteQueue
+{
+public:
+    typedef std::vector<char> ByteVector;
+
+    /**
+     *  @brief  Constructor, starting the background thread
+     *
+     *  @param  fileStream the file stream, which must outlive the queue
+     *  @param  nQueuedContainers the maximum number of containers to hold in memory, awaiting their write
+     */
+    ContainerWriteQueue(std::ofstream &fileStream, const unsigned int nQueuedContainers);
+
+    /**
+     *  @brief  Destructor, writing any containers still queued, then stopping the background thread
+     */
+    ~ContainerWriteQueue();
+
+    /**
+     *  @brief  Queue a container for writing, waiting for space in the queue if necessary. The container contents are taken from the
+     *          provided buffer, which is left empty, but may receive the storage of a container already written.
+     *
+     *  @param  containerBuffer the buffer holding the serialized container
+     *
+     *  @return STATUS_CODE_FAILURE if the write of any previously queued container has failed
+     */
+    StatusCode Push(ByteVector &containerBuffer);
+
+    /**
+     *  @brief  Wait until all queued containers have been written
+     *
+     *  @return STATUS_CODE_FAILURE if the write of any queued container has failed
+     */
+    StatusCode Flush();
+
+private:
+    typedef std::deque<ByteVector> ContainerQueue;
+
+    /**
+     *  @brief  Write containers from the queue until the queue is stopped
+     */
+    void WriteContainers();
+
+    std::ofstream              &m_fileStream;           ///< The file stream
+    const unsigned int          m_nQueuedContainers;    ///< The maximum number of containers to hold in memory, awaiting their write
+    ContainerQueue              m_containerQueue;       ///< The containers queued, but not yet written, in file order
+    ByteVector                  m_spareBuffer;          ///< The storage of the last container written, recycled for a later container
+    bool                        m_isWriting;            ///< Whether the background thread is writing a container taken from the queue
+    bool                        m_hasWriteFailed;       ///< Whether the write of any container has failed
+    bool                        m_shouldStop;           ///< Whether the background thread has been asked to stop
+    std::mutex                  m_mutex;                ///< The mutex protecting the queue and flags
+    std::condition_variable     m_condition;            ///< The condition variable signalling changes to the queue and flags
+    std::thread                 m_thread;               ///< The background thread
+};
+
+} // namespace pandora
+
+#endif // #ifndef PANDORA_CONTAINER_WRITE_QUEUE_H
@@ -0,0 +1,163 @@
+/**
+ *  @file   PandoraSDK/include/Persistency/EventFileDispatcher.h
+ * 
+ *  @brief  Header file for the event file dispatcher class.
+ * 
+ *  $Log: $
+ */
+#ifndef PANDORA_EVENT_FILE_DISPATCHER_H
+#define PANDORA_EVENT_FILE_DISPATCHER_H 1
+
+#include "Pandora/PandoraInternal.h"
+#include "Pandora/StatusCodes.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+
+namespace pandora
+{
+
+class Pandora;
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  EventFileDispatcher class, shared between the event reading algorithms of several pandora instances (e.g. one per thread),
+ *          handing out (file, event) work units from a list of event files. The numbers of events in the files need not be known in
+ *          advance: readers report when a work unit lies beyond the end of its file, after which no further events are dispatched
+ *          from that file.
+ * 
+ *          In unordered mode, each pandora instance is given a file of its own where possible, so that files are sharded across the
+ *          instances, with idle instances sharing the remaining files towards the end of processing. In ordered mode, events are
+ *          dispatched strictly in file and event order, and clients must bracket the output of each processed event with calls to
+ *          BeginEventOutput and EndEventOutput, which admit instances to the output stage in dispatch order.
+ */
+class EventFileDispatcher
+{
+public:
+    /**
+     *  @brief  WorkUnit class, describing an event to be read
+     */
+    class WorkUnit
+    {
+    public:
+        std::string             m_fileName;             ///< The name of the event file
+        unsigned int            m_eventNumber;          ///< The event number within the file
+        unsigned int            m_workUnitId;           ///< The work unit id, counting all work units in dispatch order
+    };
+
+    /**
+     *  @brief  Constructor
+     * 
+     *  @param  fileNameVector the names of the event files, in order
+     *  @param  isOrdered whether event output is to be ordered
+     */
+    EventFileDispatcher(const StringVector &fileNameVector, const bool isOrdered);
+
+    /**
+     *  @brief  Get the next work unit for a pandora instance, which also completes any previous work unit for the instance
+     * 
+     *  @param  pandora the pandora instance
+     *  @param  workUnit to receive the work unit
+     * 
+     *  @return STATUS_CODE_SUCCESS, or STATUS_CODE_NOT_FOUND if all event files are exhausted
+     */
+    StatusCode GetNextWorkUnit(const Pandora &pandora, WorkUnit &workUnit);
+
+    /**
+     *  @brief  Report that the current work unit for a pandora instance could not be read, as it lies beyond the end of its file (or
+     *          the file is unreadable). The work unit is completed without output and the file is marked as exhausted.
+     * 
+     *  @param  pandora the pandora instance
+     */
+    StatusCode ReportEndOfFile(const Pandora &pandora);
+
+    /**
+     *  @brief  Begin the output of the current work unit for a pandora instance. In ordered mode, waits until the output of all
+     *          earlier work units has ended.
+     * 
+     *  @param  pandora the pandora instance
+     */
+    StatusCode BeginEventOutput(const Pandora &pandora);
+
+    /**
+     *  @brief  End the output of the current work unit for a pandora instance, completing the work unit
+     * 
+     *  @param  pandora the pandora instance
+     */
+    StatusCode EndEventOutput(const Pandora &pandora);
+
+    /**
+     *  @brief  Whether event output is ordered
+     * 
+     *  @return boolean
+     */
+    bool IsOrdered() const;
+
+private:
+    /**
+     *  @brief  FileState class, describing the dispatch of events from a single file
+     */
+    class FileState
+    {
+    public:
+        std::string             m_fileName;             ///< The name of the event file
+        unsigned int            m_nextEventNumber;      ///< The number of the next event to dispatch
+        unsigned int            m_nReaders;             ///< The number of pandora instances currently reading the file
+        bool                    m_isExhausted;          ///< Whether the end of the file has been reached
+    };
+
+    /**
+     *  @brief  ReaderState class, describing the current work unit for a single pandora instance
+     */
+    class ReaderState
+    {
+    public:
+        unsigned int            m_fileIndex;            ///< The index of the file being read
+        unsigned int            m_workUnitId;           ///< The id of the current work unit
+        bool                    m_hasWorkUnit;          ///< Whether there is a current work unit, not yet completed
+    };
+
+    typedef std::vector<FileState> FileStateVector;
+    typedef std::unordered_map<const Pandora*, ReaderState> ReaderStateMap;
+    typedef std::set<unsigned int> WorkUnitIdSet;
+
+    /**
+     *  @brief  Get the index of the file from which to dispatch the next event for a pandora instance
+     * 
+     *  @param  readerState the reader state for the pandora instance
+     *  @param  fileIndex to receive the file index
+     * 
+     *  @return whether a file with events remaining was found
+     */
+    bool GetNextFileIndex(const ReaderState &readerState, unsigned int &fileIndex) const;
+
+    /**
+     *  @brief  Complete the current work unit for a pandora instance, if any. The caller must hold the mutex.
+     * 
+     *  @param  readerState the reader state for the pandora instance
+     */
+    void CompleteWorkUnit(ReaderState &readerState);
+
+    const bool                  m_isOrdered;            ///< Whether event output is ordered
+    FileStateVector             m_fileStateVector;      ///< The file states, in order
+    ReaderStateMap              m_readerStateMap;       ///< The reader states, for each pandora instance
+    unsigned int                m_nextWorkUnitId;       ///< The id of the next work unit to dispatch
+    unsigned int                m_nextOutputId;         ///< The id of the next work unit to be admitted to the output stage
+    WorkUnitIdSet               m_completedIdSet;       ///< The ids of completed work units beyond the next output id
+    std::mutex                  m_mutex;                ///< The mutex protecting the dispatcher state
+    std::condition_variable     m_condition;            ///< The condition variable signalling completion of work units
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool EventFileDispatcher::IsOrdered() const
+{
+    return m_isOrdered;
+}
+
+} // namespace pandora
+
+#endif // #ifndef PANDORA_EVENT_FILE_DISPATCHER_H
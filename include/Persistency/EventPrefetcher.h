@@ -0,0 +1,84 @@
+/**
+ *  @file   PandoraSDK/include/Persistency/EventPrefetcher.h
+ * 
+ *  @brief  Header file for the event prefetcher class.
+ * 
+ *  $Log: $
+ */
+#ifndef PANDORA_EVENT_PREFETCHER_H
+#define PANDORA_EVENT_PREFETCHER_H 1
+
+#include "Pandora/StatusCodes.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace pandora
+{
+
+class EventRecord;
+class FileReader;
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  EventPrefetcher class, reading and decoding upcoming events from a file reader in a background thread, so that file access
+ *          overlaps with the processing of the current event. Whilst a prefetcher exists, the file reader must only be used via the
+ *          prefetcher, and its object factories must support concurrent calls to NewParameters and Create.
+ */
+class EventPrefetcher
+{
+public:
+    /**
+     *  @brief  Constructor, starting the background thread, which reads from the current position in the file
+     *
+     *  @param  fileReader the file reader, which must outlive the prefetcher
+     *  @param  nPrefetchEvents the maximum number of events to hold in memory ahead of the current event
+     */
+    EventPrefetcher(FileReader &fileReader, const unsigned int nPrefetchEvents);
+
+    /**
+     *  @brief  Destructor, stopping the background thread and deleting any events not yet replayed
+     */
+    ~EventPrefetcher();
+
+    /**
+     *  @brief  Create the objects for the next event, waiting for it to be read if necessary. Behaves as FileReader::ReadEvent, with
+     *          any status code exception raised when reading the event rethrown after its objects have been created.
+     */
+    StatusCode ReplayNextEvent();
+
+private:
+    /**
+     *  @brief  PrefetchedEvent class, describing an event read by the background thread and the outcome of the read
+     */
+    class PrefetchedEvent
+    {
+    public:
+        EventRecord            *m_pEventRecord;         ///< Address of the event record
+        StatusCode              m_statusCode;           ///< The status code returned, or raised via exception, when reading the event
+        bool                    m_isException;          ///< Whether reading the event raised a status code exception
+    };
+
+    typedef std::deque<PrefetchedEvent> PrefetchedEventQueue;
+
+    /**
+     *  @brief  Read events into the queue until the end of the file, or until the prefetcher is stopped
+     */
+    void ReadEvents();
+
+    FileReader                 &m_fileReader;           ///< The file reader
+    const unsigned int          m_nPrefetchEvents;      ///< The maximum number of events to hold in memory ahead of the current event
+    PrefetchedEventQueue        m_prefetchedEventQueue; ///< The events read, but not yet replayed, in file order
+    bool                        m_isReadingFinished;    ///< Whether the background thread has stopped reading events
+    bool                        m_shouldStop;           ///< Whether the background thread has been asked to stop
+    std::mutex                  m_mutex;                ///< The mutex protecting the queue and flags
+    std::condition_variable     m_condition;            ///< The condition variable signalling changes to the queue and flags
+    std::thread                 m_thread;               ///< The background thread
+};
+
+} // namespace pandora
+
+#endif // #ifndef PANDORA_EVENT_PREFETCHER_H
@@ -14,7 +14,7 @@
 
 #include "Persistency/PandoraIO.h"
 
-namespace pandora {class FileReader;}
+namespace pandora {class EventFileDispatcher; class EventPrefetcher; class FileReader; class GeometryRecord;}
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
@@ -49,9 +49,18 @@ public:
     class ExternalEventReadingParameters : public pandora::ExternalParameters
     {
     public:
+        /**
+         *  @brief  Default constructor
+         */
+        ExternalEventReadingParameters();
+
         std::string             m_geometryFileName;             ///< Name of the file containing geometry information
         std::string             m_eventFileNameList;            ///< Colon-separated list of file names to be processed
         pandora::InputUInt      m_skipToEvent;                  ///< Index of first event to consider in input file
+        pandora::EventFileDispatcher *m_pEventFileDispatcher;   ///< Address of an event file dispatcher shared between pandora instances
+        const pandora::GeometryRecord *m_pGeometryRecord;       ///< Address of a geometry record shared between pandora instances, used in place of a geometry file
+        const void             *m_pEventBuffer;                 ///< Address of a caller-owned buffer of binary event containers, read in place of event files
+        std::size_t             m_eventBufferSize;              ///< The size of the caller-owned buffer of binary event containers
     };
 
 protected:
@@ -63,6 +72,11 @@ protected:
      */
     void MoveToNextEventFile();
 
+    /**
+     *  @brief  Read the next event handed out by the event file dispatcher, skipping any work units beyond the ends of their files
+     */
+    void ReadDispatchedEvent();
+
     /**
      *  @brief  Replace the current event file reader with a new reader for the specified file
      *
@@ -70,6 +84,16 @@ protected:
      */
     pandora::StatusCode ReplaceEventFileReader(const std::string &fileName);
 
+    /**
+     *  @brief  Read the next event from the current event file reader, via the event prefetcher if prefetching is enabled
+     */
+    pandora::StatusCode ReadNextEvent();
+
+    /**
+     *  @brief  Read the clusters, vertices and pfos stored alongside the event just read, if enabled and present in a binary event file
+     */
+    pandora::StatusCode ReadReconstruction();
+
     /**
      *  @brief  Analyze a provided file name to extract the file type/extension
      *
@@ -86,8 +110,18 @@ protected:
     pandora::StringVector       m_eventFileNameVector;          ///< Vector of file names to be processed
 
     unsigned int                m_skipToEvent;                  ///< Index of first event to consider in first input file
+    bool                        m_useMemoryMappedFiles;         ///< Whether to read binary files via memory maps, rather than file streams
+    bool                        m_useStreamingXmlFiles;         ///< Whether to parse xml files one container at a time, rather than loading them
+    unsigned int                m_nPrefetchEvents;              ///< The number of events to read ahead in a background thread, or zero
+    bool                        m_shouldReadReconstruction;     ///< Whether to recreate the clusters, vertices and pfos stored after each event
 
     pandora::FileReader        *m_pEventFileReader;             ///< Address of the event file reader
+    pandora::EventPrefetcher   *m_pEventPrefetcher;             ///< Address of the event prefetcher, reading from the event file reader
+    pandora::EventFileDispatcher *m_pEventFileDispatcher;       ///< Address of the shared event file dispatcher, if any, not owned
+    const pandora::GeometryRecord *m_pGeometryRecord;           ///< Address of the shared geometry record, if any, not owned
+    const void                 *m_pEventBuffer;                 ///< Address of the caller-owned buffer of binary event containers, if any, not owned
+    std::size_t                 m_eventBufferSize;              ///< The size of the caller-owned buffer of binary event containers
+    unsigned int                m_nextEventNumber;              ///< The number of the next event in the current dispatched event file
 };
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -97,4 +131,14 @@ inline pandora::Algorithm *EventReadingAlgorithm::Factory::CreateAlgorithm() con
     return new EventReadingAlgorithm();
 }
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline EventReadingAlgorithm::ExternalEventReadingParameters::ExternalEventReadingParameters() :
+    m_pEventFileDispatcher(nullptr),
+    m_pGeometryRecord(nullptr),
+    m_pEventBuffer(nullptr),
+    m_eventBufferSize(0)
+{
+}
+
 #endif // #ifndef EVENT_READING_ALGORITHM_H
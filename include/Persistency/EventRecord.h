@@ -0,0 +1,85 @@
+/**
+ *  @file   PandoraSDK/include/Persistency/EventRecord.h
+ * 
+ *  @brief  Header file for the event record class.
+ * 
+ *  $Log: $
+ */
+#ifndef PANDORA_EVENT_RECORD_H
+#define PANDORA_EVENT_RECORD_H 1
+
+#include "Pandora/ObjectCreation.h"
+
+#include "Persistency/PandoraIO.h"
+
+#include <vector>
+
+namespace pandora
+{
+
+/**
+ *  @brief  EventRecord class, holding the parameters of the objects and relationships of a single event read from a file, so that the
+ *          objects can be created later, via the file reader that read them
+ */
+class EventRecord
+{
+public:
+    /**
+     *  @brief  Default constructor
+     */
+    EventRecord();
+
+    /**
+     *  @brief  Destructor
+     */
+    ~EventRecord();
+
+    /**
+     *  @brief  Clear the record, deleting all held parameters
+     */
+    void Clear();
+
+    /**
+     *  @brief  Whether the record is empty
+     * 
+     *  @return boolean
+     */
+    bool IsEmpty() const;
+
+private:
+    /**
+     *  @brief  Relationship class, describing a relationship between two objects with specified addresses
+     */
+    class Relationship
+    {
+    public:
+        RelationshipId          m_relationshipId;       ///< The relationship id
+        const void             *m_address1;             ///< The first address
+        const void             *m_address2;             ///< The second address
+        float                   m_weight;               ///< The relationship weight
+    };
+
+    typedef std::vector<object_creation::CaloHit::Parameters*> CaloHitParametersVector;
+    typedef std::vector<object_creation::Track::Parameters*> TrackParametersVector;
+    typedef std::vector<object_creation::MCParticle::Parameters*> MCParticleParametersVector;
+    typedef std::vector<Relationship> RelationshipVector;
+
+    CaloHitParametersVector     m_caloHitParametersVector;      ///< The calo hit parameters, in the order read from file
+    TrackParametersVector       m_trackParametersVector;        ///< The track parameters, in the order read from file
+    MCParticleParametersVector  m_mcParticleParametersVector;   ///< The mc particle parameters, in the order read from file
+    RelationshipVector          m_relationshipVector;           ///< The relationships, in the order read from file
+
+    friend class FileReader;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool EventRecord::IsEmpty() const
+{
+    return (m_caloHitParametersVector.empty() && m_trackParametersVector.empty() && m_mcParticleParametersVector.empty() &&
+        m_relationshipVector.empty());
+}
+
+} // namespace pandora
+
+#endif // #ifndef PANDORA_EVENT_RECORD_H
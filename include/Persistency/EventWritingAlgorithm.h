@@ -60,6 +60,16 @@ protected:
 
     bool                    m_shouldOverwriteEventFile;     ///< Whether to overwrite existing event file with specified name, or append
     bool                    m_shouldOverwriteGeometryFile;  ///< Whether to overwrite existing geometry file with specified name, or append
+    bool                    m_shouldWriteFileIndex;         ///< Whether to end binary files with an index of the event and geometry positions
+    bool                    m_shouldCompressBinaryFiles;    ///< Whether to compress the event and geometry containers in binary files
+    bool                    m_shouldPackCaloHits;           ///< Whether to write binary event calo hits as blocks of packed records
+    bool                    m_shouldStreamXmlFiles;         ///< Whether to write xml files one container at a time, rather than as documents
+    unsigned int            m_nQueuedEventContainers;       ///< The number of binary event containers to queue for a background write, or zero
+
+    bool                    m_shouldWriteReconstruction;    ///< Whether to follow each binary event with its named clusters, vertices and pfos
+    std::string             m_reconstructionClusterListName;///< The name of the cluster list to write after each event
+    std::string             m_reconstructionVertexListName; ///< The name of the vertex list to write after each event
+    std::string             m_reconstructionPfoListName;    ///< The name of the pfo list to write after each event
 
     pandora::FileWriter    *m_pEventFileWriter;             ///< Address of the event file writer
 };
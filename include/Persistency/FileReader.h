@@ -18,6 +18,8 @@
 namespace pandora
 {
 
+class EventRecord;
+class GeometryRecord;
 class Pandora;
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -42,15 +44,61 @@ public:
     virtual ~FileReader();
 
     /**
-     *  @brief  Read the current geometry information from the file
+     *  @brief  Read the current geometry information from the file, creating each object as it is read, using the file reader object
+     *          factories. For large geometries created with the default factories, reading into a geometry record and creating the
+     *          geometry from the record is faster, as the objects are then created in batches.
      */
     StatusCode ReadGeometry();
 
+    /**
+     *  @brief  Read the current geometry information from the file, storing the geometry parameters in a geometry record, rather than
+     *          creating the geometry. The record may then be used to create the geometry in any number of pandora instances.
+     * 
+     *  @param  geometryRecord to receive the geometry contents
+     */
+    StatusCode ReadGeometry(GeometryRecord &geometryRecord);
+
     /**
      *  @brief  Read an entire pandora event from the file, recreating the stored objects
      */
     StatusCode ReadEvent();
 
+    /**
+     *  @brief  Read an entire pandora event from the file, storing the object parameters and relationships in an event record, rather
+     *          than creating the objects. The pandora instance is not used, so the event may be read concurrently with processing.
+     * 
+     *  @param  eventRecord to receive the event contents
+     */
+    StatusCode ReadEvent(EventRecord &eventRecord);
+
+    /**
+     *  @brief  Create the objects and relationships stored in an event record, which must have been filled by this file reader, using
+     *          its object factories. Objects of each type are created in file order, calo hits first, then tracks, mc particles and
+     *          finally relationships, matching the layout of files written by the pandora file writers.
+     * 
+     *  @param  eventRecord the event record
+     */
+    StatusCode CreateEvent(const EventRecord &eventRecord) const;
+
+    /**
+     *  @brief  Set whether a type of event component is to be recreated when reading events. Calo hit, track, mc particle and
+     *          relationship components may be deselected. Deselected components are still parsed, as necessary to find the next
+     *          component, but are neither created nor added to an event record. All components are recreated by default.
+     * 
+     *  @param  componentId the event component id
+     *  @param  shouldRecreate whether components of this type should be recreated
+     */
+    StatusCode SetComponentSelection(const ComponentId componentId, const bool shouldRecreate);
+
+    /**
+     *  @brief  Set whether a type of relationship is to be recreated when reading events. Relationships involving an object type whose
+     *          components are deselected are never recreated. All relationships are recreated by default.
+     * 
+     *  @param  relationshipId the relationship id
+     *  @param  shouldRecreate whether relationships of this type should be recreated
+     */
+    StatusCode SetRelationshipSelection(const RelationshipId relationshipId, const bool shouldRecreate);
+
     /**
      *  @brief  Skip to next geometry container in the file
      */
@@ -61,6 +109,13 @@ public:
      */
     StatusCode GoToNextEvent();
 
+    /**
+     *  @brief  Skip a specified number of events, counting from the current position in the file, just beyond the last event read
+     * 
+     *  @param  nEvents the number of events to skip
+     */
+    StatusCode SkipEvents(const unsigned int nEvents);
+
     /**
      *  @brief  Skip to a specified geometry number in the file
      * 
@@ -102,8 +157,194 @@ protected:
      *  @brief  Read the next pandora event component from the current position in the file, recreating the stored component
      */
     virtual StatusCode ReadNextEventComponent() = 0;
+
+    /**
+     *  @brief  Whether event components of a specified type are to be recreated
+     * 
+     *  @param  componentId the event component id
+     * 
+     *  @return boolean
+     */
+    bool ShouldRecreate(const ComponentId componentId) const;
+
+    /**
+     *  @brief  Whether relationships of a specified type are to be recreated, requiring selection of the relationship type, of
+     *          relationship components and of the components for each object type the relationship links
+     * 
+     *  @param  relationshipId the relationship id
+     * 
+     *  @return boolean
+     */
+    bool ShouldRecreate(const RelationshipId relationshipId) const;
+
+    /**
+     *  @brief  Get calo hit parameters to be filled from the file. Unless filling an event record, to which ownership of the parameters
+     *          passes, a single reset instance, supplied by the current calo hit factory, is reused for each calo hit read.
+     * 
+     *  @return address of the calo hit parameters, to be released via DeleteParameters
+     */
+    object_creation::CaloHit::Parameters *GetCaloHitParameters();
+
+    /**
+     *  @brief  Get track parameters to be filled from the file. Unless filling an event record, to which ownership of the parameters
+     *          passes, a single reset instance, supplied by the current track factory, is reused for each track read.
+     * 
+     *  @return address of the track parameters, to be released via DeleteParameters
+     */
+    object_creation::Track::Parameters *GetTrackParameters();
+
+    /**
+     *  @brief  Get mc particle parameters to be filled from the file. Unless filling an event record, to which ownership of the parameters
+     *          passes, a single reset instance, supplied by the current mc particle factory, is reused for each mc particle read.
+     * 
+     *  @return address of the mc particle parameters, to be released via DeleteParameters
+     */
+    object_creation::MCParticle::Parameters *GetMCParticleParameters();
+
+    /**
+     *  @brief  Release calo hit parameters obtained via GetCaloHitParameters, deleting them unless they are the reusable instance
+     * 
+     *  @param  pParameters address of the calo hit parameters
+     */
+    void DeleteParameters(object_creation::CaloHit::Parameters *const pParameters) const;
+
+    /**
+     *  @brief  Release track parameters obtained via GetTrackParameters, deleting them unless they are the reusable instance
+     * 
+     *  @param  pParameters address of the track parameters
+     */
+    void DeleteParameters(object_creation::Track::Parameters *const pParameters) const;
+
+    /**
+     *  @brief  Release mc particle parameters obtained via GetMCParticleParameters, deleting them unless they are the reusable instance
+     * 
+     *  @param  pParameters address of the mc particle parameters
+     */
+    void DeleteParameters(object_creation::MCParticle::Parameters *const pParameters) const;
+
+    /**
+     *  @brief  Create a sub detector, or add its parameters to the geometry record being filled
+     * 
+     *  @param  pParameters address of the sub detector parameters, set to nullptr if ownership passes to the geometry record
+     */
+    StatusCode CreateSubDetector(object_creation::Geometry::SubDetector::Parameters *&pParameters);
+
+    /**
+     *  @brief  Create a lar tpc, or add its parameters to the geometry record being filled
+     * 
+     *  @param  pParameters address of the lar tpc parameters, set to nullptr if ownership passes to the geometry record
+     */
+    StatusCode CreateLArTPC(object_creation::Geometry::LArTPC::Parameters *&pParameters);
+
+    /**
+     *  @brief  Create a line gap, or add its parameters to the geometry record being filled
+     * 
+     *  @param  pParameters address of the line gap parameters, set to nullptr if ownership passes to the geometry record
+     */
+    StatusCode CreateLineGap(object_creation::Geometry::LineGap::Parameters *&pParameters);
+
+    /**
+     *  @brief  Create a box gap, or add its parameters to the geometry record being filled
+     * 
+     *  @param  pParameters address of the box gap parameters, set to nullptr if ownership passes to the geometry record
+     */
+    StatusCode CreateBoxGap(object_creation::Geometry::BoxGap::Parameters *&pParameters);
+
+    /**
+     *  @brief  Create a concentric gap, or add its parameters to the geometry record being filled
+     * 
+     *  @param  pParameters address of the concentric gap parameters, set to nullptr if ownership passes to the geometry record
+     */
+    StatusCode CreateConcentricGap(object_creation::Geometry::ConcentricGap::Parameters *&pParameters);
+
+    /**
+     *  @brief  Create a calo hit, or add its parameters to the event record being filled
+     * 
+     *  @param  pParameters address of the calo hit parameters, set to nullptr if ownership passes to the event record
+     */
+    StatusCode CreateCaloHit(object_creation::CaloHit::Parameters *&pParameters);
+
+    /**
+     *  @brief  Reserve space for a known number of calo hits, in the event record being filled or the pandora instance
+     * 
+     *  @param  nCaloHits the number of calo hits
+     */
+    StatusCode ReserveCaloHits(const unsigned int nCaloHits);
+
+    /**
+     *  @brief  Whether calo hits may be created as a batch, i.e. they are being created directly in the pandora instance, rather than
+     *          added to an event record, using the default calo hit factory, so that the by-value batch slices no factory parameters
+     * 
+     *  @return boolean
+     */
+    bool CanCreateCaloHitBatch() const;
+
+    /**
+     *  @brief  Create a batch of calo hits, all-or-none, in the pandora instance. For use only if CanCreateCaloHitBatch.
+     * 
+     *  @param  parametersVector the calo hit parameters
+     */
+    StatusCode CreateCaloHitBatch(const object_creation::CaloHit::ParametersVector &parametersVector) const;
+
+    /**
+     *  @brief  Create a track, or add its parameters to the event record being filled
+     * 
+     *  @param  pParameters address of the track parameters, set to nullptr if ownership passes to the event record
+     */
+    StatusCode CreateTrack(object_creation::Track::Parameters *&pParameters);
+
+    /**
+     *  @brief  Create a mc particle, or add its parameters to the event record being filled
+     * 
+     *  @param  pParameters address of the mc particle parameters, set to nullptr if ownership passes to the event record
+     */
+    StatusCode CreateMCParticle(object_creation::MCParticle::Parameters *&pParameters);
+
+    /**
+     *  @brief  Set a relationship between two objects with specified addresses, or add it to the event record being filled
+     * 
+     *  @param  relationshipId the relationship id
+     *  @param  address1 the first address
+     *  @param  address2 the second address
+     *  @param  weight the relationship weight
+     */
+    StatusCode CreateRelationship(const RelationshipId relationshipId, const void *address1, const void *address2, const float weight);
+
+private:
+    /**
+     *  @brief  Get parameters to be filled from the file, either new parameters for the event record or the reset reusable instance
+     * 
+     *  @param  factory the factory supplying the parameters
+     *  @param  pReusableParameters to receive the address of the reusable parameters, if not yet created
+     * 
+     *  @return address of the parameters
+     */
+    template <typename PARAMETERS, typename OBJECT>
+    PARAMETERS *GetParameters(const ObjectFactory<PARAMETERS, OBJECT> &factory, PARAMETERS *&pReusableParameters) const;
+
+    /**
+     *  @brief  Set a relationship between two objects with specified addresses in the pandora instance
+     * 
+     *  @param  relationshipId the relationship id
+     *  @param  address1 the first address
+     *  @param  address2 the second address
+     *  @param  weight the relationship weight
+     */
+    StatusCode SetRelationship(const RelationshipId relationshipId, const void *address1, const void *address2, const float weight) const;
+
+    EventRecord                *m_pEventRecord;         ///< Address of the event record being filled, if objects are not to be created directly
+    GeometryRecord             *m_pGeometryRecord;      ///< Address of the geometry record being filled, if geometry is not to be created directly
+    unsigned int                m_skippedComponents;    ///< Bit mask, indexed by component id, of the event components not to be recreated
+    unsigned int                m_skippedRelationships; ///< Bit mask, indexed by relationship id, of the relationships not to be recreated
 };
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool FileReader::ShouldRecreate(const ComponentId componentId) const
+{
+    return !(m_skippedComponents & (1u << componentId));
+}
+
 } // namespace pandora
 
 #endif // #ifndef PANDORA_FILE_READER_H
@@ -0,0 +1,98 @@
+/**
+ *  @file   PandoraSDK/include/Persistency/GeometryRecord.h
+ * 
+ *  @brief  Header file for the geometry record class.
+ * 
+ *  $Log: $
+ */
+#ifndef PANDORA_GEOMETRY_RECORD_H
+#define PANDORA_GEOMETRY_RECORD_H 1
+
+#include "Pandora/ObjectCreation.h"
+
+#include <vector>
+
+namespace pandora
+{
+
+class Pandora;
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  GeometryRecord class, holding the parameters of the sub detectors, lar tpcs and detector gaps of a single geometry read from
+ *          a file, so that the geometry can be read once and then created in any number of pandora instances. Once filled, the record
+ *          is not modified by geometry creation, so may be shared between instances, including instances in concurrent threads.
+ */
+class GeometryRecord
+{
+public:
+    /**
+     *  @brief  Default constructor
+     */
+    GeometryRecord();
+
+    /**
+     *  @brief  Destructor
+     */
+    ~GeometryRecord();
+
+    /**
+     *  @brief  Clear the record, deleting all held parameters
+     */
+    void Clear();
+
+    /**
+     *  @brief  Whether the record is empty
+     * 
+     *  @return boolean
+     */
+    bool IsEmpty() const;
+
+    /**
+     *  @brief  Create the geometry held in the record in a pandora instance, in the order read from file. The default pandora object
+     *          factories are used, so any additional parameters read by custom geometry factories are ignored. Each object type is
+     *          created as a single all-or-none batch, sub detectors first, then lar tpcs, line gaps, box gaps and concentric gaps, so
+     *          that the geometry lookup structures are built once per type, rather than once per object.
+     * 
+     *  @param  pandora the pandora instance in which to create the geometry
+     */
+    StatusCode CreateGeometry(const Pandora &pandora) const;
+
+private:
+    /**
+     *  @brief  Create a batch of geometry objects of a single type in a pandora instance, using the default pandora object factory
+     * 
+     *  @param  pandora the pandora instance in which to create the objects
+     *  @param  parametersPointerVector the addresses of the object parameters, in the order read from file
+     */
+    template <typename OBJECT_CREATION>
+    static StatusCode CreateBatch(const Pandora &pandora,
+        const std::vector<typename OBJECT_CREATION::Parameters*> &parametersPointerVector);
+
+    typedef std::vector<object_creation::Geometry::SubDetector::Parameters*> SubDetectorParametersVector;
+    typedef std::vector<object_creation::Geometry::LArTPC::Parameters*> LArTPCParametersVector;
+    typedef std::vector<object_creation::Geometry::LineGap::Parameters*> LineGapParametersVector;
+    typedef std::vector<object_creation::Geometry::BoxGap::Parameters*> BoxGapParametersVector;
+    typedef std::vector<object_creation::Geometry::ConcentricGap::Parameters*> ConcentricGapParametersVector;
+
+    SubDetectorParametersVector     m_subDetectorParametersVector;      ///< The sub detector parameters, in the order read from file
+    LArTPCParametersVector          m_larTPCParametersVector;           ///< The lar tpc parameters, in the order read from file
+    LineGapParametersVector         m_lineGapParametersVector;          ///< The line gap parameters, in the order read from file
+    BoxGapParametersVector          m_boxGapParametersVector;           ///< The box gap parameters, in the order read from file
+    ConcentricGapParametersVector   m_concentricGapParametersVector;    ///< The concentric gap parameters, in the order read from file
+
+    friend class FileReader;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool GeometryRecord::IsEmpty() const
+{
+    return (m_subDetectorParametersVector.empty() && m_larTPCParametersVector.empty() && m_lineGapParametersVector.empty() &&
+        m_boxGapParametersVector.empty() && m_concentricGapParametersVector.empty());
+}
+
+} // namespace pandora
+
+#endif // #ifndef PANDORA_GEOMETRY_RECORD_H
@@ -8,6 +8,7 @@
 #ifndef PANDORA_IO_H
 #define PANDORA_IO_H 1
 
+#include <cstdint>
 #include <string>
 
 namespace pandora
@@ -18,19 +19,27 @@ const std::string PANDORA_FILE_HASH("pandora"); ///< Look for hash each event to
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 /**
- *  @brief  The container identification enum
+ *  @brief  The container identification enum. A binary file may end with an index container, listing the id and header position of
+ *          each event and geometry container, followed by the index header position and file hash, allowing the index to be found.
+ *          Compressed event and geometry containers hold the uncompressed size of the container contents, then the compressed contents.
+ *          A reconstruction container, in a binary file, holds clusters, vertices and pfos built from the preceding event container.
  */
 enum ContainerId
 {
     EVENT_CONTAINER,
     GEOMETRY_CONTAINER,
+    INDEX_CONTAINER,
+    COMPRESSED_EVENT_CONTAINER,
+    COMPRESSED_GEOMETRY_CONTAINER,
+    RECONSTRUCTION_CONTAINER,
     UNKNOWN_CONTAINER
 };
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 /**
- *  @brief  The component identification enum
+ *  @brief  The component identification enum. A calo hit block component holds all calo hits of an event, as the number of calo hits
+ *          and the record size, then one packed calo hit record per calo hit, then the factory-extension data for each calo hit in turn.
  */
 enum ComponentId
 {
@@ -45,6 +54,11 @@ enum ComponentId
     CONCENTRIC_GAP_COMPONENT,
     GEOMETRY_END_COMPONENT,
     LAR_TPC_COMPONENT,
+    CLUSTER_COMPONENT,
+    VERTEX_COMPONENT,
+    PFO_COMPONENT,
+    RECONSTRUCTION_END_COMPONENT,
+    CALO_HIT_BLOCK_COMPONENT,
     UNKNOWN_COMPONENT
 };
 
@@ -87,6 +101,40 @@ enum FileMode
     UNKNOWN_MODE
 };
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  PackedCaloHitRecord class, the fixed-size record for a single calo hit in a calo hit block component. Members are ordered by
+ *          size, with explicit padding, so the record has no implicit padding and can be copied to and from the file as a whole.
+ */
+class PackedCaloHitRecord
+{
+public:
+    std::uint64_t           m_parentAddress;            ///< The address of the parent calo hit in the user framework
+    float                   m_positionVector[3];        ///< The position vector components, units mm
+    float                   m_expectedDirection[3];     ///< The expected direction components
+    float                   m_cellNormalVector[3];      ///< The cell normal vector components
+    float                   m_cellSize0;                ///< The first cell size, units mm
+    float                   m_cellSize1;                ///< The second cell size, units mm
+    float                   m_cellThickness;            ///< The cell thickness, units mm
+    float                   m_nCellRadiationLengths;    ///< The absorber material in front of cell, units radiation lengths
+    float                   m_nCellInteractionLengths;  ///< The absorber material in front of cell, units interaction lengths
+    float                   m_time;                     ///< The time of (earliest) energy deposition in this cell, units ns
+    float                   m_inputEnergy;              ///< The corrected energy of the calo hit, units GeV
+    float                   m_mipEquivalentEnergy;      ///< The calibrated mip equivalent energy, units mip
+    float                   m_electromagneticEnergy;    ///< The calibrated electromagnetic energy measure, units GeV
+    float                   m_hadronicEnergy;           ///< The calibrated hadronic energy measure, units GeV
+    std::uint32_t           m_cellGeometry;             ///< The cell geometry
+    std::uint32_t           m_hitType;                  ///< The calorimeter hit type
+    std::uint32_t           m_hitRegion;                ///< The region of the detector in which the calo hit is located
+    std::uint32_t           m_layer;                    ///< The subdetector readout layer number
+    std::uint8_t            m_isDigital;                ///< Whether the calo hit should be treated as digital
+    std::uint8_t            m_isInOuterSamplingLayer;   ///< Whether the calo hit is in the outermost sampling layer
+    std::uint8_t            m_padding[6];               ///< Explicit padding, written as zero
+};
+
+static_assert(sizeof(PackedCaloHitRecord) == 112, "PackedCaloHitRecord must have no implicit padding");
+
 //------------------------------------------------------------------------------------------------------------------------------------------
 //------------------------------------------------------------------------------------------------------------------------------------------
 
@@ -83,6 +83,10 @@ protected:
     ObjectFactory<object_creation::Geometry::LineGap::Parameters, object_creation::Geometry::LineGap::Object>              *m_pLineGapFactory;       ///< Address of the line gap factory
     ObjectFactory<object_creation::Geometry::BoxGap::Parameters, object_creation::Geometry::BoxGap::Object>                *m_pBoxGapFactory;        ///< Address of the box gap factory
     ObjectFactory<object_creation::Geometry::ConcentricGap::Parameters, object_creation::Geometry::ConcentricGap::Object>  *m_pConcentricGapFactory; ///< Address of the concentric gap factory
+
+    object_creation::CaloHit::Parameters       *m_pCaloHitParameters;       ///< Reusable calo hit parameters, from the calo hit factory, for file reading
+    object_creation::Track::Parameters         *m_pTrackParameters;         ///< Reusable track parameters, from the track factory, for file reading
+    object_creation::MCParticle::Parameters    *m_pMCParticleParameters;    ///< Reusable mc particle parameters, from the mc particle factory, for file reading
 };
 
 //------------------------------------------------------------------------------------------------------------------------------------------
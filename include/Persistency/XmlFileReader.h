@@ -17,6 +17,8 @@
 
 #include "Persistency/FileReader.h"
 
+#include <fstream>
+
 namespace pandora
 {
 
@@ -31,8 +33,10 @@ public:
      * 
      *  @param  pandora the pandora instance to be used alongside the file reader
      *  @param  fileName the name of the file containing the pandora objects
+     *  @param  useStreaming whether to parse one container at a time from a file stream, holding only the current container in
+     *          memory, rather than loading the entire document
      */
-    XmlFileReader(const pandora::Pandora &pandora, const std::string &fileName);
+    XmlFileReader(const pandora::Pandora &pandora, const std::string &fileName, const bool useStreaming = false);
 
     /**
      *  @brief  Destructor
@@ -101,10 +105,23 @@ private:
      */
     StatusCode ReadRelationship();
 
+    /**
+     *  @brief  Read the next top-level container element from the file stream, replacing the xml document with a document holding
+     *          only that container
+     * 
+     *  @param  isAtFileStart whether to read the first container in the file, rather than the container after the current position
+     * 
+     *  @return the address of the container element, or nullptr if the end of the file has been reached
+     */
+    TiXmlElement *ReadContainerXmlElement(const bool isAtFileStart);
+
     TiXmlDocument                  *m_pXmlDocument;         ///< The xml document
     TiXmlNode                      *m_pContainerXmlNode;    ///< The document xml node
     TiXmlElement                   *m_pCurrentXmlElement;   ///< The current xml element
     bool                            m_isAtFileStart;        ///< Whether reader is at file start
+    bool                            m_isStreaming;          ///< Whether containers are parsed one at a time from the file stream
+    std::ifstream                   m_fileStream;           ///< The stream class to read from the file, if streaming
+    std::string                     m_containerText;        ///< The text of the current container, if streaming
 };
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -17,6 +17,8 @@
 
 #include "Xml/tinyxml.h"
 
+#include <fstream>
+
 namespace pandora
 {
 
@@ -32,8 +34,11 @@ public:
      *  @param  algorithm the pandora instance to be used alongside the file writer
      *  @param  fileName the name of the output file
      *  @param  fileMode the mode for file writing
+     *  @param  useStreaming whether to write each container to a file stream as soon as it is complete, holding only the current
+     *          container in memory, rather than saving the entire document on destruction
      */
-    XmlFileWriter(const pandora::Pandora &pandora, const std::string &fileName, const FileMode fileMode = APPEND);
+    XmlFileWriter(const pandora::Pandora &pandora, const std::string &fileName, const FileMode fileMode = APPEND,
+        const bool useStreaming = false);
 
     /**
      *  @brief  Destructor
@@ -59,9 +64,16 @@ private:
     StatusCode WriteMCParticle(const MCParticle *const pMCParticle);
     StatusCode WriteRelationship(const RelationshipId relationshipId, const void *address1, const void *address2, const float weight);
 
+    /**
+     *  @brief  Write the current container to the file stream, then delete it
+     */
+    StatusCode WriteContainer();
+
     TiXmlDocument      *m_pXmlDocument;         ///< The xml document
     TiXmlElement       *m_pContainerXmlElement; ///< The container xml element
     TiXmlElement       *m_pCurrentXmlElement;   ///< The current xml element
+    bool                m_isStreaming;          ///< Whether containers are written to the file stream as soon as they are complete
+    std::ofstream       m_fileStream;           ///< The stream class to write to the file, if streaming
 };
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -30,6 +30,7 @@ public:
     virtual float GetBField(const CartesianVector &positionVector) const = 0;
 
 protected:
+    friend class CachedBFieldPlugin;
     friend class PluginManager;
 };
 
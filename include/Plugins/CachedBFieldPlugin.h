@@ -0,0 +1,69 @@
+/**
+ *  @file   PandoraSDK/include/Plugins/CachedBFieldPlugin.h
+ * 
+ *  @brief  Header file for the cached bfield plugin class.
+ * 
+ *  $Log: $
+ */
+#ifndef PANDORA_CACHED_BFIELD_PLUGIN_H
+#define PANDORA_CACHED_BFIELD_PLUGIN_H 1
+
+#include "Plugins/BFieldPlugin.h"
+
+namespace pandora
+{
+
+/**
+ *  @brief  CachedBFieldPlugin class, wrapping an inner bfield plugin. The inner plugin is sampled once, at initialization, onto a
+ *          regular 3D grid of points and bfield queries within the grid are then answered by trilinear interpolation. Queries outside
+ *          the grid, or all queries if no grid is configured, are forwarded to the inner plugin.
+ * 
+ *          Configuration is read from the BFieldPlugin xml element: GridMin and GridMax (x y z, units mm) give the grid extent,
+ *          NGridPointsX, NGridPointsY and NGridPointsZ give the number of sample points along each axis, and the settings for the inner
+ *          plugin are read from an InnerBFieldPlugin child element. An axis with a single sample point is treated as field-invariant.
+ */
+class CachedBFieldPlugin : public BFieldPlugin
+{
+public:
+    /**
+     *  @brief  Constructor
+     * 
+     *  @param  pInnerBFieldPlugin address of the inner bfield plugin, ownership of which is taken by the cached bfield plugin
+     */
+    CachedBFieldPlugin(BFieldPlugin *const pInnerBFieldPlugin);
+
+    /**
+     *  @brief  Destructor
+     */
+    ~CachedBFieldPlugin();
+
+    float GetBField(const CartesianVector &positionVector) const;
+
+private:
+    StatusCode ReadSettings(const TiXmlHandle xmlHandle);
+    StatusCode Initialize();
+    StatusCode Reset();
+
+    /**
+     *  @brief  Register the inner bfield plugin with the pandora instance running the cached bfield plugin, if not already registered
+     */
+    StatusCode RegisterInnerPlugin();
+
+    /**
+     *  @brief  Sample the inner bfield plugin at each grid point
+     */
+    StatusCode FillGrid();
+
+    static const unsigned int MAX_GRID_POINTS = 1 << 24;    ///< The largest number of grid points
+
+    BFieldPlugin               *m_pInnerBFieldPlugin;       ///< The address of the inner bfield plugin
+    float                       m_gridMin[3];               ///< The grid minimum x, y and z coordinates
+    float                       m_gridMax[3];               ///< The grid maximum x, y and z coordinates
+    unsigned int                m_nGridPoints[3];           ///< The number of grid points in x, y and z, or zero if no grid is configured
+    float                       m_inverseGridSpacing[3];    ///< The inverse of the grid point spacing in x, y and z
+    FloatVector                 m_bFieldVector;             ///< The sampled bfield values, indexed by (ix * nY + iy) * nZ + iz
+};
+
+} // namespace pandora
+
+#endif // #ifndef PANDORA_CACHED_BFIELD_PLUGIN_H
@@ -33,6 +33,37 @@ public:
      */
     virtual StatusCode MakeEnergyCorrections(const Cluster *const pCluster, float &correctedEnergy) const = 0;
 
+    /**
+     *  @brief  Make energy corrections to a batch of clusters. The default implementation corrects each cluster in turn, but plugins
+     *          may override this to share work across the batch.
+     * 
+     *  @param  clusterVector the clusters
+     *  @param  correctedEnergies the energies to correct, one per cluster, each to be replaced by the corresponding corrected energy
+     */
+    virtual StatusCode MakeBatchEnergyCorrections(const ClusterVector &clusterVector, FloatVector &correctedEnergies) const;
+
+protected:
+    friend class EnergyCorrections;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  CaloHitEnergyCorrectionPlugin class, making energy corrections to individual calo hits, e.g. for saturation or leakage by layer.
+ *          The corrections to the input calo hits are made once per event, before any algorithms are run, and the corrected calo hit
+ *          energies, summed over each cluster, replace the raw cluster energies as the starting point for the cluster energy corrections.
+ */
+class CaloHitEnergyCorrectionPlugin : public Process
+{
+public:
+    /**
+     *  @brief  Make energy corrections to a calo hit
+     * 
+     *  @param  pCaloHit address of the calo hit
+     *  @param  correctedEnergy to receive the corrected energy
+     */
+    virtual StatusCode MakeEnergyCorrections(const CaloHit *const pCaloHit, float &correctedEnergy) const = 0;
+
 protected:
     friend class EnergyCorrections;
 };
@@ -54,7 +85,75 @@ public:
      */
     StatusCode MakeEnergyCorrections(const Cluster *const pCluster, float &correctedElectromagneticEnergy, float &correctedHadronicEnergy) const;
 
+    /**
+     *  @brief  Make an ordered list of energy corrections to a batch of clusters, running each plugin once over the full batch
+     * 
+     *  @param  clusterVector the clusters
+     *  @param  correctedElectromagneticEnergies to receive the corrected electromagnetic energies, one per cluster
+     *  @param  correctedHadronicEnergies to receive the corrected hadronic energies, one per cluster
+     */
+    StatusCode MakeEnergyCorrections(const ClusterVector &clusterVector, FloatVector &correctedElectromagneticEnergies,
+        FloatVector &correctedHadronicEnergies) const;
+
+    /**
+     *  @brief  Update the cached corrected energies of those clusters in a list whose cached values are out of date, i.e. have not been
+     *          calculated since the cluster contents last changed, using a single batched pass through the energy correction plugins
+     * 
+     *  @param  clusterList the cluster list
+     */
+    StatusCode UpdateEnergyCorrections(const ClusterList &clusterList) const;
+
+    /**
+     *  @brief  Get the energies of a calo hit after the ordered list of calo hit energy corrections. The values for the input calo hits
+     *          are those made once per event, whilst the corrections to any other calo hits are made on demand.
+     * 
+     *  @param  pCaloHit address of the calo hit
+     *  @param  correctedElectromagneticEnergy to receive the corrected electromagnetic energy
+     *  @param  correctedHadronicEnergy to receive the corrected hadronic energy
+     */
+    StatusCode GetCorrectedCaloHitEnergies(const CaloHit *const pCaloHit, float &correctedElectromagneticEnergy, float &correctedHadronicEnergy) const;
+
 private:
+    typedef std::vector<EnergyCorrectionPlugin *> EnergyCorrectionPluginVector;
+    typedef std::vector<CaloHitEnergyCorrectionPlugin *> CaloHitEnergyCorrectionPluginVector;
+
+    /**
+     *  @brief  Run an ordered list of energy correction plugins over a batch of clusters
+     * 
+     *  @param  energyCorrectionPluginVector the energy correction plugins
+     *  @param  clusterVector the clusters
+     *  @param  correctedEnergies the energies to correct, one per cluster, each to be replaced by the corresponding corrected energy
+     */
+    static StatusCode MakeEnergyCorrections(const EnergyCorrectionPluginVector &energyCorrectionPluginVector, const ClusterVector &clusterVector,
+        FloatVector &correctedEnergies);
+
+    /**
+     *  @brief  Run an ordered list of calo hit energy correction plugins over a calo hit
+     * 
+     *  @param  caloHitEnergyCorrectionPluginVector the calo hit energy correction plugins
+     *  @param  pCaloHit address of the calo hit
+     *  @param  correctedEnergy the energy to correct, to be replaced by the corrected energy
+     */
+    static StatusCode MakeEnergyCorrections(const CaloHitEnergyCorrectionPluginVector &caloHitEnergyCorrectionPluginVector,
+        const CaloHit *const pCaloHit, float &correctedEnergy);
+
+    /**
+     *  @brief  Get the energies of a cluster from which the cluster energy corrections start: the sums of the corrected calo hit energies,
+     *          for each energy correction type with calo hit energy correction plugins, else the raw cluster energies
+     * 
+     *  @param  pCluster address of the cluster
+     *  @param  electromagneticEnergy to receive the electromagnetic energy
+     *  @param  hadronicEnergy to receive the hadronic energy
+     */
+    StatusCode GetUncorrectedEnergies(const Cluster *const pCluster, float &electromagneticEnergy, float &hadronicEnergy) const;
+
+    /**
+     *  @brief  Make the calo hit energy corrections to the calo hits of the event, storing the corrected energies by calo hit index
+     * 
+     *  @param  indexedCaloHitVector the calo hits of the event, by calo hit index
+     */
+    StatusCode MakeCaloHitEnergyCorrections(const CaloHitVector &indexedCaloHitVector);
+
     /**
      *  @brief  Default constructor
      * 
@@ -77,6 +176,16 @@ private:
     StatusCode RegisterPlugin(const std::string &pluginName, const EnergyCorrectionType energyCorrectionType,
         EnergyCorrectionPlugin *const pEnergyCorrectionPlugin);
 
+    /**
+     *  @brief  Register a calo hit energy correction plugin
+     * 
+     *  @param  pluginName the name/label associated with the calo hit energy correction plugin
+     *  @param  energyCorrectionType the energy correction type
+     *  @param  pCaloHitEnergyCorrectionPlugin pointer to a calo hit energy correction plugin
+     */
+    StatusCode RegisterPlugin(const std::string &pluginName, const EnergyCorrectionType energyCorrectionType,
+        CaloHitEnergyCorrectionPlugin *const pCaloHitEnergyCorrectionPlugin);
+
     /**
      *  @brief  Initialize plugins
      * 
@@ -84,20 +193,29 @@ private:
      */
     StatusCode InitializePlugins(const TiXmlHandle *const pXmlHandle);
 
-    typedef std::vector<EnergyCorrectionPlugin *> EnergyCorrectionPluginVector;
+    /**
+     *  @brief  Read the settings of, and initialize, each plugin in a plugin map
+     * 
+     *  @param  pXmlHandle address of the relevant xml handle
+     *  @param  pluginMap the plugin map
+     */
+    template <typename PLUGIN>
+    static StatusCode InitializePluginMap(const TiXmlHandle *const pXmlHandle, const std::map<std::string, PLUGIN *> &pluginMap);
 
     /**
      *  @brief  Read requested plugin names/labels from a specified xml tag and attempt to assign the plugin pointers as requested
      * 
      *  @param  pXmlHandle address of the relevant xml handle
      *  @param  xmlTagName the xml tag name for a given energy correction type
-     *  @param  energyCorrectionType the energy correction type
-     *  @param  energyCorrectionPluginVector to receive the addresses of the energy correction plugins
+     *  @param  pluginMap the plugin map for the energy correction type
+     *  @param  pluginVector to receive the addresses of the energy correction plugins
      */
-    StatusCode InitializePlugin(const TiXmlHandle *const pXmlHandle, const std::string &xmlTagName,
-        const EnergyCorrectionType energyCorrectionType, EnergyCorrectionPluginVector &energyCorrectionPluginVector);
+    template <typename PLUGIN>
+    static StatusCode InitializePlugin(const TiXmlHandle *const pXmlHandle, const std::string &xmlTagName,
+        const std::map<std::string, PLUGIN *> &pluginMap, std::vector<PLUGIN *> &pluginVector);
 
     typedef std::map<std::string, EnergyCorrectionPlugin *> EnergyCorrectionPluginMap;
+    typedef std::map<std::string, CaloHitEnergyCorrectionPlugin *> CaloHitEnergyCorrectionPluginMap;
 
     /**
      *  @brief  Get the energy correction plugin map corresponding to the specified energy correction type
@@ -108,6 +226,15 @@ private:
      */
     EnergyCorrectionPluginMap &GetEnergyCorrectionPluginMap(const EnergyCorrectionType energyCorrectionType);
 
+    /**
+     *  @brief  Get the calo hit energy correction plugin map corresponding to the specified energy correction type
+     * 
+     *  @param  energyCorrectionType the energy correction type
+     * 
+     *  @return reference to the relevant calo hit energy correction plugin map
+     */
+    CaloHitEnergyCorrectionPluginMap &GetCaloHitEnergyCorrectionPluginMap(const EnergyCorrectionType energyCorrectionType);
+
     /**
      *  @brief  Call the reset callback in all managed plugins
      */
@@ -119,7 +246,17 @@ private:
     EnergyCorrectionPluginVector    m_hadEnergyCorrectionPlugins;       ///< The final hadronic energy correction plugin vector
     EnergyCorrectionPluginVector    m_emEnergyCorrectionPlugins;        ///< The final electromagnetic energy correction plugin vector
 
+    CaloHitEnergyCorrectionPluginMap    m_hadCaloHitEnergyCorrectionPluginMap;  ///< The hadronic calo hit energy correction plugin map
+    CaloHitEnergyCorrectionPluginMap    m_emCaloHitEnergyCorrectionPluginMap;   ///< The electromagnetic calo hit energy correction plugin map
+    CaloHitEnergyCorrectionPluginVector m_hadCaloHitEnergyCorrectionPlugins;    ///< The final hadronic calo hit energy correction plugin vector
+    CaloHitEnergyCorrectionPluginVector m_emCaloHitEnergyCorrectionPlugins;     ///< The final electromagnetic calo hit energy correction plugin vector
+
+    CaloHitVector                   m_correctedCaloHitVector;           ///< The calo hits with corrected energies, by calo hit index
+    FloatVector                     m_correctedCaloHitEmEnergies;       ///< The corrected calo hit electromagnetic energies, by calo hit index
+    FloatVector                     m_correctedCaloHitHadEnergies;      ///< The corrected calo hit hadronic energies, by calo hit index
+
     friend class PandoraApiImpl;
+    friend class PandoraImpl;
     friend class PluginManager;
 };
 
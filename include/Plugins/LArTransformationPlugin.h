@@ -153,6 +153,168 @@ public:
     virtual void GetMinChiSquaredYZ(const double u, const double v, const double w, const double sigmaU, const double sigmaV, const double sigmaW,
         const double uFit, const double vFit, const double wFit, const double sigmaFit, double &y, double &z, double &chiSquared) const = 0;
 
+    /**
+     *  @brief  Transform an array of (U,V) positions to W positions. The default implementation calls UVtoW for each position.
+     *
+     *  @param  nPositions the number of positions
+     *  @param  pU address of the array of U positions
+     *  @param  pV address of the array of V positions
+     *  @param  pW address of the array to receive the W positions
+     */
+    virtual void UVtoWArray(const unsigned int nPositions, const double *const pU, const double *const pV, double *const pW) const;
+
+    /**
+     *  @brief  Transform an array of (V,W) positions to U positions. The default implementation calls VWtoU for each position.
+     *
+     *  @param  nPositions the number of positions
+     *  @param  pV address of the array of V positions
+     *  @param  pW address of the array of W positions
+     *  @param  pU address of the array to receive the U positions
+     */
+    virtual void VWtoUArray(const unsigned int nPositions, const double *const pV, const double *const pW, double *const pU) const;
+
+    /**
+     *  @brief  Transform an array of (W,U) positions to V positions. The default implementation calls WUtoV for each position.
+     *
+     *  @param  nPositions the number of positions
+     *  @param  pW address of the array of W positions
+     *  @param  pU address of the array of U positions
+     *  @param  pV address of the array to receive the V positions
+     */
+    virtual void WUtoVArray(const unsigned int nPositions, const double *const pW, const double *const pU, double *const pV) const;
+
+    /**
+     *  @brief  Transform an array of (U,V) positions to Y positions. The default implementation calls UVtoY for each position.
+     *
+     *  @param  nPositions the number of positions
+     *  @param  pU address of the array of U positions
+     *  @param  pV address of the array of V positions
+     *  @param  pY address of the array to receive the Y positions
+     */
+    virtual void UVtoYArray(const unsigned int nPositions, const double *const pU, const double *const pV, double *const pY) const;
+
+    /**
+     *  @brief  Transform an array of (U,V) positions to Z positions. The default implementation calls UVtoZ for each position.
+     *
+     *  @param  nPositions the number of positions
+     *  @param  pU address of the array of U positions
+     *  @param  pV address of the array of V positions
+     *  @param  pZ address of the array to receive the Z positions
+     */
+    virtual void UVtoZArray(const unsigned int nPositions, const double *const pU, const double *const pV, double *const pZ) const;
+
+    /**
+     *  @brief  Transform an array of (U,W) positions to Y positions. The default implementation calls UWtoY for each position.
+     *
+     *  @param  nPositions the number of positions
+     *  @param  pU address of the array of U positions
+     *  @param  pW address of the array of W positions
+     *  @param  pY address of the array to receive the Y positions
+     */
+    virtual void UWtoYArray(const unsigned int nPositions, const double *const pU, const double *const pW, double *const pY) const;
+
+    /**
+     *  @brief  Transform an array of (U,W) positions to Z positions. The default implementation calls UWtoZ for each position.
+     *
+     *  @param  nPositions the number of positions
+     *  @param  pU address of the array of U positions
+     *  @param  pW address of the array of W positions
+     *  @param  pZ address of the array to receive the Z positions
+     */
+    virtual void UWtoZArray(const unsigned int nPositions, const double *const pU, const double *const pW, double *const pZ) const;
+
+    /**
+     *  @brief  Transform an array of (V,W) positions to Y positions. The default implementation calls VWtoY for each position.
+     *
+     *  @param  nPositions the number of positions
+     *  @param  pV address of the array of V positions
+     *  @param  pW address of the array of W positions
+     *  @param  pY address of the array to receive the Y positions
+     */
+    virtual void VWtoYArray(const unsigned int nPositions, const double *const pV, const double *const pW, double *const pY) const;
+
+    /**
+     *  @brief  Transform an array of (V,W) positions to Z positions. The default implementation calls VWtoZ for each position.
+     *
+     *  @param  nPositions the number of positions
+     *  @param  pV address of the array of V positions
+     *  @param  pW address of the array of W positions
+     *  @param  pZ address of the array to receive the Z positions
+     */
+    virtual void VWtoZArray(const unsigned int nPositions, const double *const pV, const double *const pW, double *const pZ) const;
+
+    /**
+     *  @brief  Transform an array of (Y,Z) positions to U positions. The default implementation calls YZtoU for each position.
+     *
+     *  @param  nPositions the number of positions
+     *  @param  pY address of the array of Y positions
+     *  @param  pZ address of the array of Z positions
+     *  @param  pU address of the array to receive the U positions
+     */
+    virtual void YZtoUArray(const unsigned int nPositions, const double *const pY, const double *const pZ, double *const pU) const;
+
+    /**
+     *  @brief  Transform an array of (Y,Z) positions to V positions. The default implementation calls YZtoV for each position.
+     *
+     *  @param  nPositions the number of positions
+     *  @param  pY address of the array of Y positions
+     *  @param  pZ address of the array of Z positions
+     *  @param  pV address of the array to receive the V positions
+     */
+    virtual void YZtoVArray(const unsigned int nPositions, const double *const pY, const double *const pZ, double *const pV) const;
+
+    /**
+     *  @brief  Transform an array of (Y,Z) positions to W positions. The default implementation calls YZtoW for each position.
+     *
+     *  @param  nPositions the number of positions
+     *  @param  pY address of the array of Y positions
+     *  @param  pZ address of the array of Z positions
+     *  @param  pW address of the array to receive the W positions
+     */
+    virtual void YZtoWArray(const unsigned int nPositions, const double *const pY, const double *const pZ, double *const pW) const;
+
+    /**
+     *  @brief  Get, for arrays of u, v and w coordinates, the y, z positions that yield the minimum chi squared values. The default
+     *          implementation calls GetMinChiSquaredYZ for each set of coordinates.
+     *
+     *  @param  nPositions the number of positions
+     *  @param  pU address of the array of u coordinates
+     *  @param  pV address of the array of v coordinates
+     *  @param  pW address of the array of w coordinates
+     *  @param  pSigmaU address of the array of uncertainties in the u coordinates
+     *  @param  pSigmaV address of the array of uncertainties in the v coordinates
+     *  @param  pSigmaW address of the array of uncertainties in the w coordinates
+     *  @param  pY address of the array to receive the y coordinates
+     *  @param  pZ address of the array to receive the z coordinates
+     *  @param  pChiSquared address of the array to receive the chi squared values
+     */
+    virtual void GetMinChiSquaredYZArray(const unsigned int nPositions, const double *const pU, const double *const pV, const double *const pW,
+        const double *const pSigmaU, const double *const pSigmaV, const double *const pSigmaW, double *const pY, double *const pZ,
+        double *const pChiSquared) const;
+
+    /**
+     *  @brief  Get, for arrays of u, v and w coordinates and of coordinates from fits to overall trajectories in 3D, the y, z positions that
+     *          yield the minimum chi squared values. The default implementation calls GetMinChiSquaredYZ for each set of coordinates.
+     *
+     *  @param  nPositions the number of positions
+     *  @param  pU address of the array of u coordinates
+     *  @param  pV address of the array of v coordinates
+     *  @param  pW address of the array of w coordinates
+     *  @param  pSigmaU address of the array of uncertainties in the u coordinates
+     *  @param  pSigmaV address of the array of uncertainties in the v coordinates
+     *  @param  pSigmaW address of the array of uncertainties in the w coordinates
+     *  @param  pUFit address of the array of u coordinates from fits to overall trajectories
+     *  @param  pVFit address of the array of v coordinates from fits to overall trajectories
+     *  @param  pWFit address of the array of w coordinates from fits to overall trajectories
+     *  @param  pSigmaFit address of the array of uncertainties in coordinates extracted from fits to overall trajectories
+     *  @param  pY address of the array to receive the y coordinates
+     *  @param  pZ address of the array to receive the z coordinates
+     *  @param  pChiSquared address of the array to receive the chi squared values
+     */
+    virtual void GetMinChiSquaredYZArray(const unsigned int nPositions, const double *const pU, const double *const pV, const double *const pW,
+        const double *const pSigmaU, const double *const pSigmaV, const double *const pSigmaW, const double *const pUFit, const double *const pVFit,
+        const double *const pWFit, const double *const pSigmaFit, double *const pY, double *const pZ, double *const pChiSquared) const;
+
 protected:
     friend class PluginManager;
 };
@@ -8,6 +8,8 @@
 #ifndef PANDORA_PARTICLE_ID_PLUGIN_H
 #define PANDORA_PARTICLE_ID_PLUGIN_H 1
 
+#include "Objects/ParticleIdCache.h"
+
 #include "Pandora/PandoraInternal.h"
 #include "Pandora/Process.h"
 
@@ -132,6 +134,38 @@ private:
      */
     StatusCode ResetForNextEvent();
 
+    /**
+     *  @brief  Whether a cluster or pfo matches the hypothesis of a particle id plugin, reusing the result cached on the cluster or pfo
+     *          if the object has not been modified since the result was calculated
+     * 
+     *  @param  pParticleIdPlugin address of the particle id plugin
+     *  @param  particleIdType the particle id type
+     *  @param  pT address of the cluster or pfo
+     * 
+     *  @return boolean
+     */
+    template <typename T>
+    static bool IsMatch(const ParticleIdPlugin *const pParticleIdPlugin, const ParticleIdCache::ParticleIdType particleIdType, const T *const pT);
+
+    /**
+     *  @brief  Get the modification epoch of a cluster
+     * 
+     *  @param  pCluster address of the cluster
+     * 
+     *  @return the modification epoch
+     */
+    static unsigned int GetModificationEpoch(const Cluster *const pCluster);
+
+    /**
+     *  @brief  Get the modification epoch of a pfo, summed with those of its constituent clusters, so that it also changes when the
+     *          pfo clusters are modified
+     * 
+     *  @param  pPfo address of the pfo
+     * 
+     *  @return the modification epoch
+     */
+    static unsigned int GetModificationEpoch(const ParticleFlowObject *const pPfo);
+
     const Pandora *const        m_pPandora;                   ///< Address of the associated pandora instance
     ParticleIdPlugin           *m_pEmShowerPlugin;            ///< The electromagnetic shower id plugin pointer
     ParticleIdPlugin           *m_pPhotonPlugin;              ///< The photon id plugin pointer
@@ -124,6 +124,37 @@ public:
     virtual void CalculateTrackBasedTransverseProfile(const Cluster *const pCluster, const unsigned int maxPseudoLayer, const Track *const pClosestTrack, 
         const TrackVector &trackVector, ShowerPeakList &showerPeakListPhoton, ShowerPeakList &showerPeakListNonPhoton) const = 0;
 
+    /**
+     *  @brief  Calculate transverse shower profile for a cluster and get the list of peaks identified in the profile, using a caller-owned
+     *          scratch arena to hold any intermediate grids and peak calo hit lists. The default implementation ignores the scratch arena,
+     *          but plugins may override this to avoid repeated allocation when profiling many clusters.
+     * 
+     *  @param  pCluster the address of the cluster
+     *  @param  maxPseudoLayer the maximum pseudo layer to consider
+     *  @param  showerPeakList to receive the shower peak list
+     *  @param  inclusiveMode whether to operate inclusive shower peak finding
+     *  @param  scratchArena the scratch arena, e.g. that provided by PluginManager::GetShowerProfileScratchArena
+     */
+    virtual void CalculateTransverseProfileUsingArena(const Cluster *const pCluster, const unsigned int maxPseudoLayer,
+        ShowerPeakList &showerPeakList, const bool inclusiveMode, ScratchArena &scratchArena) const;
+
+    /**
+     *  @brief  Calculate transverse shower profile for a cluster and get the list of peaks identified in the profile, for clusters close to
+     *          tracks, using a caller-owned scratch arena to hold any intermediate grids and peak calo hit lists. The default implementation
+     *          ignores the scratch arena.
+     * 
+     *  @param  pCluster the address of the cluster
+     *  @param  maxPseudoLayer the maximum pseudo layer to consider
+     *  @param  pClosestTrack the address of the closest track
+     *  @param  trackVector the vector of nearby tracks
+     *  @param  showerPeakListPhoton to receive the shower peak list that are photon candidates
+     *  @param  showerPeakListNonPhoton to receive the shower peak list that are not photon candidates
+     *  @param  scratchArena the scratch arena, e.g. that provided by PluginManager::GetShowerProfileScratchArena
+     */
+    virtual void CalculateTrackBasedTransverseProfileUsingArena(const Cluster *const pCluster, const unsigned int maxPseudoLayer,
+        const Track *const pClosestTrack, const TrackVector &trackVector, ShowerPeakList &showerPeakListPhoton, ShowerPeakList &showerPeakListNonPhoton,
+        ScratchArena &scratchArena) const;
+
 protected:
     friend class PluginManager;
 };
@@ -176,6 +176,52 @@ enum TiXmlEncoding
 
 const TiXmlEncoding TIXML_DEFAULT_ENCODING = TIXML_ENCODING_UNKNOWN;
 
+/**	A bump allocator, owned by a TiXmlDocument, from which the nodes and attributes created
+	whilst parsing the document are allocated. The memory is released all at once, when the
+	document is cleared or destroyed: deleting an individual node runs its destructor, but
+	returns no memory. Nodes created outside a parse continue to use the heap. Released blocks
+	are kept in a small per-thread cache, for reuse by the next document parsed.
+*/
+class TiXmlArena
+{
+public:
+	TiXmlArena() : blocks( 0 ), position( 0 ), end( 0 ) {}
+	~TiXmlArena()	{ Release(); }
+
+	/// Allocate memory, aligned for any node or attribute.
+	void* Allocate( size_t size );
+
+	/// Release all memory allocated from the arena.
+	void Release();
+
+	/// [internal use] The arena receiving the nodes and attributes created by the current thread, if any.
+	static TiXmlArena*& Current();
+
+private:
+	TiXmlArena( const TiXmlArena& );			// not implemented.
+	void operator=( const TiXmlArena& );		// not allowed.
+
+	enum
+	{
+		BLOCK_SIZE = 64 * 1024,
+		MAX_CACHED_BLOCKS = 32
+	};
+
+	struct Block
+	{
+		Block*		next;
+		bool		isDedicated;
+	};
+
+	struct BlockCache;
+	static BlockCache& GetBlockCache();
+
+	Block*	blocks;
+	char*	position;
+	char*	end;
+};
+
+
 /** TiXmlBase is a base class for every class in TinyXml.
 	It does little except to establish that TinyXml classes
 	can be printed and provide some utility functions.
@@ -208,6 +254,12 @@ public:
 	TiXmlBase()	:	userData(0)		{}
 	virtual ~TiXmlBase()			{}
 
+	/**	Nodes and attributes are allocated from the arena of the document being parsed, if any,
+		otherwise from the heap. Either way, they are deleted as normal.
+	*/
+	static void* operator new( size_t size );
+	static void operator delete( void* p );
+
 	/**	All TinyXml classes can print themselves to a filestream
 		or the string class (TiXmlString in non-STL mode, std::string
 		in STL mode.) Either or both cfile and str can be null.
@@ -1413,7 +1465,10 @@ public:
 	TiXmlDocument( const TiXmlDocument& copy );
 	TiXmlDocument& operator=( const TiXmlDocument& copy );
 
-	virtual ~TiXmlDocument() {}
+	virtual ~TiXmlDocument()	{ Clear(); }
+
+	/// Delete all the children of the document and release the memory of the document arena.
+	void Clear();
 
 	/** Load a file using the current document value.
 		Returns true if successful. Will delete any existing
@@ -1559,6 +1614,7 @@ private:
 	int tabsize;
 	TiXmlCursor errorLocation;
 	bool useMicrosoftBOM;		// the UTF-8 BOM were found when read. Note this, and try to write.
+	TiXmlArena arena;			// the arena for nodes and attributes created whilst parsing.
 };
 
 
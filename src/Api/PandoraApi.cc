@@ -18,9 +18,10 @@ pandora::StatusCode PandoraApi::ProcessEvent(const pandora::Pandora &pandora)
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-pandora::StatusCode PandoraApi::ReadSettings(const pandora::Pandora &pandora, const std::string &xmlFileName)
+pandora::StatusCode PandoraApi::ReadSettings(const pandora::Pandora &pandora, const std::string &xmlFileName,
+    const std::string &settingsCacheFileName)
 {
-    return pandora.GetPandoraApiImpl()->ReadSettings(xmlFileName);
+    return pandora.GetPandoraApiImpl()->ReadSettings(xmlFileName, settingsCacheFileName);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -81,6 +82,37 @@ pandora::StatusCode PandoraApi::SetTrackToMCParticleRelationship(const pandora::
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+pandora::StatusCode PandoraApi::SetCaloHitToMCParticleRelationships(const pandora::Pandora &pandora,
+    const pandora::MCParticleRelationshipVector &relationshipVector)
+{
+    return pandora.GetPandoraApiImpl()->SetCaloHitToMCParticleRelationships(relationshipVector);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+pandora::StatusCode PandoraApi::SetTrackToMCParticleRelationships(const pandora::Pandora &pandora,
+    const pandora::MCParticleRelationshipVector &relationshipVector)
+{
+    return pandora.GetPandoraApiImpl()->SetTrackToMCParticleRelationships(relationshipVector);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+pandora::StatusCode PandoraApi::SetEventSizeHints(const pandora::Pandora &pandora, const unsigned int nCaloHits, const unsigned int nTracks,
+    const unsigned int nMCParticles, const unsigned int nRelationships)
+{
+    return pandora.GetPandoraApiImpl()->SetEventSizeHints(nCaloHits, nTracks, nMCParticles, nRelationships);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+pandora::StatusCode PandoraApi::ShareCaloHits(const pandora::Pandora &pandora, const pandora::CaloHitList &caloHitList)
+{
+    return pandora.GetPandoraApiImpl()->ShareCaloHits(caloHitList);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 pandora::StatusCode PandoraApi::GetCurrentPfoList(const pandora::Pandora &pandora, const pandora::PfoList *&pfoList)
 {
     std::string pfoListName;
@@ -96,6 +128,35 @@ pandora::StatusCode PandoraApi::GetPfoList(const pandora::Pandora &pandora, cons
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+pandora::StatusCode PandoraApi::GetClusterList(const pandora::Pandora &pandora, const std::string &clusterListName,
+    const pandora::ClusterList *&pClusterList)
+{
+    return pandora.GetPandoraApiImpl()->GetClusterList(clusterListName, pClusterList);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+pandora::StatusCode PandoraApi::GetCurrentPfoListsByEventId(const pandora::Pandora &pandora, pandora::EventIdToPfoListMap &eventIdToPfoListMap)
+{
+    return pandora.GetPandoraApiImpl()->GetCurrentPfoListsByEventId(eventIdToPfoListMap);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+pandora::StatusCode PandoraApi::ExportCurrentPfos(const pandora::Pandora &pandora, pandora::PfoExportTable &pfoExportTable)
+{
+    return pandora.GetPandoraApiImpl()->ExportCurrentPfos(pfoExportTable);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+pandora::StatusCode PandoraApi::ExportPfos(const pandora::Pandora &pandora, const std::string &pfoListName, pandora::PfoExportTable &pfoExportTable)
+{
+    return pandora.GetPandoraApiImpl()->ExportPfos(pfoListName, pfoExportTable);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 pandora::StatusCode PandoraApi::SetExternalParameters(const pandora::Pandora &pandora, const std::string &algorithmType,
     pandora::ExternalParameters *const pExternalParameters)
 {
@@ -148,6 +209,14 @@ pandora::StatusCode PandoraApi::RegisterEnergyCorrectionPlugin(const pandora::Pa
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+pandora::StatusCode PandoraApi::RegisterEnergyCorrectionPlugin(const pandora::Pandora &pandora, const std::string &name,
+    const pandora::EnergyCorrectionType energyCorrectionType, pandora::CaloHitEnergyCorrectionPlugin *const pCaloHitEnergyCorrectionPlugin)
+{
+    return pandora.GetPandoraApiImpl()->RegisterEnergyCorrectionPlugin(name, energyCorrectionType, pCaloHitEnergyCorrectionPlugin);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 pandora::StatusCode PandoraApi::RegisterParticleIdPlugin(const pandora::Pandora &pandora, const std::string &name,
     pandora::ParticleIdPlugin *const pParticleIdPlugin)
 {
@@ -160,3 +229,69 @@ pandora::StatusCode PandoraApi::Reset(const pandora::Pandora &pandora)
 {
     return pandora.GetPandoraApiImpl()->ResetEvent();
 }
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+pandora::StatusCode PandoraApi::ResetWindow(const pandora::Pandora &pandora, const float windowStartTime)
+{
+    return pandora.GetPandoraApiImpl()->ResetWindow(windowStartTime);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+pandora::StatusCode PandoraApi::PrintAlgorithmProfile(const pandora::Pandora &pandora)
+{
+    return pandora.GetPandoraApiImpl()->PrintAlgorithmProfile();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+pandora::StatusCode PandoraApi::WriteAlgorithmTrace(const pandora::Pandora &pandora, const std::string &fileName)
+{
+    return pandora.GetPandoraApiImpl()->WriteAlgorithmTrace(fileName);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+pandora::StatusCode PandoraApi::PrintEventLatency(const pandora::Pandora &pandora)
+{
+    return pandora.GetPandoraApiImpl()->PrintEventLatency();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+pandora::StatusCode PandoraApi::GetEventLatencyQuantile(const pandora::Pandora &pandora, const double fraction, double &latency)
+{
+    return pandora.GetPandoraApiImpl()->GetEventLatencyQuantile(fraction, latency);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+pandora::StatusCode PandoraApi::PrintMemoryUsage(const pandora::Pandora &pandora)
+{
+    return pandora.GetPandoraApiImpl()->PrintMemoryUsage();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+pandora::StatusCode PandoraApi::GetMemoryUsage(const pandora::Pandora &pandora, pandora::MemoryUsageMap &currentUsageMap,
+    pandora::MemoryUsageMap &peakUsageMap)
+{
+    return pandora.GetPandoraApiImpl()->GetMemoryUsage(currentUsageMap, peakUsageMap);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+pandora::StatusCode PandoraApi::PrintAggregatedProfile()
+{
+    pandora::ProfileAggregator::PrintSummary();
+    return pandora::STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+pandora::StatusCode PandoraApi::GetAggregatedProfile(pandora::ProfileAggregator::Summary &summary)
+{
+    pandora::ProfileAggregator::GetSummary(summary);
+    return pandora::STATUS_CODE_SUCCESS;
+}
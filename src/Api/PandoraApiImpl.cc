@@ -16,9 +16,13 @@
 #include "Managers/MCManager.h"
 #include "Managers/ParticleFlowObjectManager.h"
 #include "Managers/PluginManager.h"
+#include "Managers/ProfileManager.h"
 #include "Managers/TrackManager.h"
 #include "Managers/VertexManager.h"
 
+#include "Objects/ParticleFlowObject.h"
+#include "Objects/PfoExportTable.h"
+
 #include "Pandora/ExternallyConfiguredAlgorithm.h"
 #include "Pandora/ObjectCreation.h"
 #include "Pandora/Pandora.h"
@@ -27,6 +31,9 @@
 #include "Plugins/EnergyCorrectionsPlugin.h"
 #include "Plugins/ParticleIdPlugin.h"
 
+#include <algorithm>
+#include <iomanip>
+
 namespace pandora
 {
 
@@ -34,6 +41,9 @@ template <>
 StatusCode PandoraApiImpl::Create(const object_creation::MCParticle::Parameters &parameters,
     const ObjectFactory<object_creation::MCParticle::Parameters, object_creation::MCParticle::Object> &factory) const
 {
+    if (m_pPandora->GetSettings()->IsDataMode())
+        return STATUS_CODE_NOT_ALLOWED;
+
     const MCParticle *pMCParticle(nullptr);
     return m_pPandora->m_pMCManager->Create(parameters, pMCParticle, factory);
 }
@@ -58,6 +68,9 @@ template <>
 StatusCode PandoraApiImpl::Create(const object_creation::Geometry::SubDetector::Parameters &parameters,
     const ObjectFactory<object_creation::Geometry::SubDetector::Parameters, object_creation::Geometry::SubDetector::Object> &factory) const
 {
+    if (!m_pPandora->m_pGeometryManager)
+        return STATUS_CODE_NOT_ALLOWED;
+
     return m_pPandora->m_pGeometryManager->CreateSubDetector(parameters, factory);
 }
 
@@ -65,6 +78,9 @@ template <>
 StatusCode PandoraApiImpl::Create(const object_creation::Geometry::LArTPC::Parameters &parameters,
     const ObjectFactory<object_creation::Geometry::LArTPC::Parameters, object_creation::Geometry::LArTPC::Object> &factory) const
 {
+    if (!m_pPandora->m_pGeometryManager)
+        return STATUS_CODE_NOT_ALLOWED;
+
     return m_pPandora->m_pGeometryManager->CreateLArTPC(parameters, factory);
 }
 
@@ -72,6 +88,9 @@ template <>
 StatusCode PandoraApiImpl::Create(const object_creation::Geometry::LineGap::Parameters &parameters,
     const ObjectFactory<object_creation::Geometry::LineGap::Parameters, object_creation::Geometry::LineGap::Object> &factory) const
 {
+    if (!m_pPandora->m_pGeometryManager)
+        return STATUS_CODE_NOT_ALLOWED;
+
     return m_pPandora->m_pGeometryManager->CreateGap(parameters, factory);
 }
 
@@ -79,6 +98,9 @@ template <>
 StatusCode PandoraApiImpl::Create(const object_creation::Geometry::BoxGap::Parameters &parameters,
     const ObjectFactory<object_creation::Geometry::BoxGap::Parameters, object_creation::Geometry::BoxGap::Object> &factory) const
 {
+    if (!m_pPandora->m_pGeometryManager)
+        return STATUS_CODE_NOT_ALLOWED;
+
     return m_pPandora->m_pGeometryManager->CreateGap(parameters, factory);
 }
 
@@ -86,6 +108,9 @@ template <>
 StatusCode PandoraApiImpl::Create(const object_creation::Geometry::ConcentricGap::Parameters &parameters,
     const ObjectFactory<object_creation::Geometry::ConcentricGap::Parameters, object_creation::Geometry::ConcentricGap::Object> &factory) const
 {
+    if (!m_pPandora->m_pGeometryManager)
+        return STATUS_CODE_NOT_ALLOWED;
+
     return m_pPandora->m_pGeometryManager->CreateGap(parameters, factory);
 }
 
@@ -97,6 +122,91 @@ StatusCode PandoraApiImpl::Create(const PARAMETERS &/*parameters*/, const Object
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+template <>
+StatusCode PandoraApiImpl::Create(const std::vector<object_creation::MCParticle::Parameters> &parametersVector,
+    const ObjectFactory<object_creation::MCParticle::Parameters, object_creation::MCParticle::Object> &factory) const
+{
+    if (m_pPandora->GetSettings()->IsDataMode())
+        return STATUS_CODE_NOT_ALLOWED;
+
+    return m_pPandora->m_pMCManager->Create(parametersVector, factory);
+}
+
+template <>
+StatusCode PandoraApiImpl::Create(const std::vector<object_creation::Track::Parameters> &parametersVector,
+    const ObjectFactory<object_creation::Track::Parameters, object_creation::Track::Object> &factory) const
+{
+    return m_pPandora->m_pTrackManager->Create(parametersVector, factory);
+}
+
+template <>
+StatusCode PandoraApiImpl::Create(const std::vector<object_creation::CaloHit::Parameters> &parametersVector,
+    const ObjectFactory<object_creation::CaloHit::Parameters, object_creation::CaloHit::Object> &factory) const
+{
+    return m_pPandora->m_pCaloHitManager->Create(parametersVector, factory);
+}
+
+template <>
+StatusCode PandoraApiImpl::Create(const std::vector<object_creation::Geometry::SubDetector::Parameters> &parametersVector,
+    const ObjectFactory<object_creation::Geometry::SubDetector::Parameters, object_creation::Geometry::SubDetector::Object> &factory) const
+{
+    if (!m_pPandora->m_pGeometryManager)
+        return STATUS_CODE_FAILURE;
+
+    return m_pPandora->m_pGeometryManager->CreateSubDetectors(parametersVector, factory);
+}
+
+template <>
+StatusCode PandoraApiImpl::Create(const std::vector<object_creation::Geometry::LArTPC::Parameters> &parametersVector,
+    const ObjectFactory<object_creation::Geometry::LArTPC::Parameters, object_creation::Geometry::LArTPC::Object> &factory) const
+{
+    if (!m_pPandora->m_pGeometryManager)
+        return STATUS_CODE_FAILURE;
+
+    return m_pPandora->m_pGeometryManager->CreateLArTPCs(parametersVector, factory);
+}
+
+template <>
+StatusCode PandoraApiImpl::Create(const std::vector<object_creation::Geometry::LineGap::Parameters> &parametersVector,
+    const ObjectFactory<object_creation::Geometry::LineGap::Parameters, object_creation::Geometry::LineGap::Object> &factory) const
+{
+    if (!m_pPandora->m_pGeometryManager)
+        return STATUS_CODE_FAILURE;
+
+    return m_pPandora->m_pGeometryManager->CreateGaps(parametersVector, factory);
+}
+
+template <>
+StatusCode PandoraApiImpl::Create(const std::vector<object_creation::Geometry::BoxGap::Parameters> &parametersVector,
+    const ObjectFactory<object_creation::Geometry::BoxGap::Parameters, object_creation::Geometry::BoxGap::Object> &factory) const
+{
+    if (!m_pPandora->m_pGeometryManager)
+        return STATUS_CODE_FAILURE;
+
+    return m_pPandora->m_pGeometryManager->CreateGaps(parametersVector, factory);
+}
+
+template <>
+StatusCode PandoraApiImpl::Create(const std::vector<object_creation::Geometry::ConcentricGap::Parameters> &parametersVector,
+    const ObjectFactory<object_creation::Geometry::ConcentricGap::Parameters, object_creation::Geometry::ConcentricGap::Object> &factory) const
+{
+    if (!m_pPandora->m_pGeometryManager)
+        return STATUS_CODE_FAILURE;
+
+    return m_pPandora->m_pGeometryManager->CreateGaps(parametersVector, factory);
+}
+
+template <typename PARAMETERS, typename OBJECT>
+StatusCode PandoraApiImpl::Create(const std::vector<PARAMETERS> &parametersVector, const ObjectFactory<PARAMETERS, OBJECT> &factory) const
+{
+    for (const PARAMETERS &parameters : parametersVector)
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->Create(parameters, factory));
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 StatusCode PandoraApiImpl::ProcessEvent() const
 {
     return m_pPandora->ProcessEvent();
@@ -104,9 +214,9 @@ StatusCode PandoraApiImpl::ProcessEvent() const
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-StatusCode PandoraApiImpl::ReadSettings(const std::string &xmlFileName) const
+StatusCode PandoraApiImpl::ReadSettings(const std::string &xmlFileName, const std::string &settingsCacheFileName) const
 {
-    return m_pPandora->ReadSettings(xmlFileName);
+    return m_pPandora->ReadSettings(xmlFileName, settingsCacheFileName);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -127,6 +237,9 @@ StatusCode PandoraApiImpl::RegisterAlgorithmToolFactory(const std::string &algor
 
 StatusCode PandoraApiImpl::SetMCParentDaughterRelationship(const void *const pParentAddress, const void *const pDaughterAddress) const
 {
+    if (m_pPandora->GetSettings()->IsDataMode())
+        return STATUS_CODE_NOT_ALLOWED;
+
     return m_pPandora->m_pMCManager->SetMCParentDaughterRelationship(pParentAddress, pDaughterAddress);
 }
 
@@ -149,6 +262,9 @@ StatusCode PandoraApiImpl::SetTrackSiblingRelationship(const void *const pFirstS
 StatusCode PandoraApiImpl::SetCaloHitToMCParticleRelationship(const void *const pCaloHitParentAddress, const void *const pMCParticleParentAddress,
     const float mcParticleWeight) const
 {
+    if (m_pPandora->GetSettings()->IsDataMode())
+        return STATUS_CODE_NOT_ALLOWED;
+
     return m_pPandora->m_pMCManager->SetCaloHitToMCParticleRelationship(pCaloHitParentAddress, pMCParticleParentAddress, mcParticleWeight);
 }
 
@@ -157,11 +273,56 @@ StatusCode PandoraApiImpl::SetCaloHitToMCParticleRelationship(const void *const
 StatusCode PandoraApiImpl::SetTrackToMCParticleRelationship(const void *const pTrackParentAddress, const void *const pMCParticleParentAddress,
     const float mcParticleWeight) const
 {
+    if (m_pPandora->GetSettings()->IsDataMode())
+        return STATUS_CODE_NOT_ALLOWED;
+
     return m_pPandora->m_pMCManager->SetTrackToMCParticleRelationship(pTrackParentAddress, pMCParticleParentAddress, mcParticleWeight);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+StatusCode PandoraApiImpl::SetCaloHitToMCParticleRelationships(const MCParticleRelationshipVector &relationshipVector) const
+{
+    if (m_pPandora->GetSettings()->IsDataMode())
+        return STATUS_CODE_NOT_ALLOWED;
+
+    return m_pPandora->m_pMCManager->SetCaloHitToMCParticleRelationships(relationshipVector);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PandoraApiImpl::SetTrackToMCParticleRelationships(const MCParticleRelationshipVector &relationshipVector) const
+{
+    if (m_pPandora->GetSettings()->IsDataMode())
+        return STATUS_CODE_NOT_ALLOWED;
+
+    return m_pPandora->m_pMCManager->SetTrackToMCParticleRelationships(relationshipVector);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PandoraApiImpl::SetEventSizeHints(const unsigned int nCaloHits, const unsigned int nTracks, const unsigned int nMCParticles,
+    const unsigned int nRelationships) const
+{
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pPandora->m_pCaloHitManager->ReserveCapacity(nCaloHits));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pPandora->m_pTrackManager->ReserveCapacity(nTracks));
+
+    if (m_pPandora->GetSettings()->IsDataMode())
+        return STATUS_CODE_SUCCESS;
+
+    // ATTN Relation maps are keyed by calo hit or track, so hold at most one entry per object
+    return m_pPandora->m_pMCManager->ReserveCapacity(nMCParticles, std::min(nRelationships, nCaloHits), std::min(nRelationships, nTracks));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PandoraApiImpl::ShareCaloHits(const CaloHitList &caloHitList) const
+{
+    return m_pPandora->m_pCaloHitManager->ShareCaloHits(caloHitList);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 StatusCode PandoraApiImpl::GetCurrentPfoList(const PfoList *&pPfoList, std::string &pfoListName) const
 {
     return m_pPandora->m_pPfoManager->GetCurrentList(pPfoList, pfoListName);
@@ -176,8 +337,58 @@ StatusCode PandoraApiImpl::GetPfoList(const std::string &pfoListName, const PfoL
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+StatusCode PandoraApiImpl::GetClusterList(const std::string &clusterListName, const ClusterList *&pClusterList) const
+{
+    return m_pPandora->m_pClusterManager->GetList(clusterListName, pClusterList);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PandoraApiImpl::GetCurrentPfoListsByEventId(EventIdToPfoListMap &eventIdToPfoListMap) const
+{
+    if (!eventIdToPfoListMap.empty())
+        return STATUS_CODE_INVALID_PARAMETER;
+
+    std::string pfoListName;
+    const PfoList *pPfoList(nullptr);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pPandora->m_pPfoManager->GetCurrentList(pPfoList, pfoListName));
+
+    for (const ParticleFlowObject *const pPfo : *pPfoList)
+        eventIdToPfoListMap[pPfo->GetEventId()].push_back(pPfo);
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PandoraApiImpl::ExportCurrentPfos(PfoExportTable &pfoExportTable) const
+{
+    std::string pfoListName;
+    const PfoList *pPfoList(nullptr);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pPandora->m_pPfoManager->GetCurrentList(pPfoList, pfoListName));
+
+    pfoExportTable.Fill(*pPfoList);
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PandoraApiImpl::ExportPfos(const std::string &pfoListName, PfoExportTable &pfoExportTable) const
+{
+    const PfoList *pPfoList(nullptr);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pPandora->m_pPfoManager->GetList(pfoListName, pPfoList));
+
+    pfoExportTable.Fill(*pPfoList);
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 StatusCode PandoraApiImpl::SetHitTypeGranularity(const HitType hitType, const Granularity granularity) const
 {
+    if (!m_pPandora->m_pGeometryManager)
+        return STATUS_CODE_NOT_ALLOWED;
+
     return m_pPandora->m_pGeometryManager->SetHitTypeGranularity(hitType, granularity);
 }
 
@@ -219,6 +430,14 @@ StatusCode PandoraApiImpl::RegisterEnergyCorrectionPlugin(const std::string &nam
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+StatusCode PandoraApiImpl::RegisterEnergyCorrectionPlugin(const std::string &name, const EnergyCorrectionType energyCorrectionType,
+    CaloHitEnergyCorrectionPlugin *const pCaloHitEnergyCorrectionPlugin) const
+{
+    return m_pPandora->m_pPluginManager->m_pEnergyCorrections->RegisterPlugin(name, energyCorrectionType, pCaloHitEnergyCorrectionPlugin);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 StatusCode PandoraApiImpl::RegisterParticleIdPlugin(const std::string &name, ParticleIdPlugin *const pParticleIdPlugin) const
 {
     return m_pPandora->m_pPluginManager->m_pParticleId->RegisterPlugin(name, pParticleIdPlugin);
@@ -233,6 +452,105 @@ StatusCode PandoraApiImpl::ResetEvent() const
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+StatusCode PandoraApiImpl::ResetWindow(const float windowStartTime) const
+{
+    return m_pPandora->ResetWindow(windowStartTime);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PandoraApiImpl::PrintAlgorithmProfile() const
+{
+    if (!m_pPandora->GetSettings()->ShouldProfileAlgorithms())
+        return STATUS_CODE_NOT_ALLOWED;
+
+    m_pPandora->m_pProfileManager->PrintSummary();
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PandoraApiImpl::WriteAlgorithmTrace(const std::string &fileName) const
+{
+    if (!m_pPandora->GetSettings()->ShouldRecordAlgorithmTrace())
+        return STATUS_CODE_NOT_ALLOWED;
+
+    return m_pPandora->m_pProfileManager->WriteTrace(fileName);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PandoraApiImpl::PrintEventLatency() const
+{
+    if (!m_pPandora->GetSettings()->ShouldRecordEventLatency())
+        return STATUS_CODE_NOT_ALLOWED;
+
+    m_pPandora->m_pProfileManager->PrintEventLatencySummary();
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PandoraApiImpl::GetEventLatencyQuantile(const double fraction, double &latency) const
+{
+    if (!m_pPandora->GetSettings()->ShouldRecordEventLatency())
+        return STATUS_CODE_NOT_ALLOWED;
+
+    return m_pPandora->m_pProfileManager->GetEventLatencyQuantile(fraction, latency);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PandoraApiImpl::PrintMemoryUsage() const
+{
+    MemoryUsageMap currentUsageMap, peakUsageMap;
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetMemoryUsage(currentUsageMap, peakUsageMap));
+
+    std::cout << "Memory usage, current / peak for this event (estimated MB)" << std::endl;
+
+    for (const MemoryUsageMap::value_type &mapEntry : currentUsageMap)
+    {
+        const MemoryUsage &currentUsage(mapEntry.second);
+        const MemoryUsage &peakUsage(peakUsageMap.at(mapEntry.first));
+
+        std::cout << "    " << mapEntry.first << ": objects " << currentUsage.m_nObjects << " / " << peakUsage.m_nObjects
+                  << ", lists " << currentUsage.m_nLists << " / " << peakUsage.m_nLists
+                  << ", list entries " << currentUsage.m_nListEntries << " / " << peakUsage.m_nListEntries
+                  << std::fixed << std::setprecision(3)
+                  << ", size " << static_cast<double>(currentUsage.m_estimatedBytes) / (1024. * 1024.) << " / "
+                  << static_cast<double>(peakUsage.m_estimatedBytes) / (1024. * 1024.) << std::defaultfloat;
+
+        if (!peakUsage.m_algorithmName.empty())
+            std::cout << ", peak after " << peakUsage.m_algorithmName;
+
+        std::cout << std::endl;
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PandoraApiImpl::GetMemoryUsage(MemoryUsageMap &currentUsageMap, MemoryUsageMap &peakUsageMap) const
+{
+    if (!m_pPandora->GetSettings()->ShouldRecordMemoryUsage())
+        return STATUS_CODE_NOT_ALLOWED;
+
+    currentUsageMap.clear();
+    peakUsageMap.clear();
+
+    m_pPandora->m_pCaloHitManager->GetMemoryUsage(currentUsageMap["CaloHit"], peakUsageMap["CaloHit"]);
+    m_pPandora->m_pClusterManager->GetMemoryUsage(currentUsageMap["Cluster"], peakUsageMap["Cluster"]);
+    m_pPandora->m_pMCManager->GetMemoryUsage(currentUsageMap["MCParticle"], peakUsageMap["MCParticle"]);
+    m_pPandora->m_pPfoManager->GetMemoryUsage(currentUsageMap["ParticleFlowObject"], peakUsageMap["ParticleFlowObject"]);
+    m_pPandora->m_pTrackManager->GetMemoryUsage(currentUsageMap["Track"], peakUsageMap["Track"]);
+    m_pPandora->m_pVertexManager->GetMemoryUsage(currentUsageMap["Vertex"], peakUsageMap["Vertex"]);
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 PandoraApiImpl::PandoraApiImpl(Pandora *const pPandora) :
     m_pPandora(pPandora)
 {
@@ -245,4 +563,8 @@ template StatusCode PandoraApiImpl::Create(const object_creation::Cluster::Param
 template StatusCode PandoraApiImpl::Create(const object_creation::ParticleFlowObject::Parameters &, const ObjectFactory<object_creation::ParticleFlowObject::Parameters, object_creation::ParticleFlowObject::Object> &) const;
 template StatusCode PandoraApiImpl::Create(const object_creation::Vertex::Parameters &, const ObjectFactory<object_creation::Vertex::Parameters, object_creation::Vertex::Object> &) const;
 
+template StatusCode PandoraApiImpl::Create(const std::vector<object_creation::Cluster::Parameters> &, const ObjectFactory<object_creation::Cluster::Parameters, object_creation::Cluster::Object> &) const;
+template StatusCode PandoraApiImpl::Create(const std::vector<object_creation::ParticleFlowObject::Parameters> &, const ObjectFactory<object_creation::ParticleFlowObject::Parameters, object_creation::ParticleFlowObject::Object> &) const;
+template StatusCode PandoraApiImpl::Create(const std::vector<object_creation::Vertex::Parameters> &, const ObjectFactory<object_creation::Vertex::Parameters, object_creation::Vertex::Object> &) const;
+
 } // namespace pandora
@@ -33,6 +33,28 @@ const pandora::PluginManager *PandoraContentApi::GetPlugins(const pandora::Algor
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+pandora::StatusCode PandoraContentApi::ParallelFor(const pandora::Algorithm &algorithm, const unsigned int nItems,
+    const pandora::ParallelForTask &task, const unsigned int grainSize)
+{
+    return PandoraContentApi::GetThreadPool(algorithm)->ParallelFor(nItems, task, grainSize);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+pandora::ThreadPool *PandoraContentApi::GetThreadPool(const pandora::Algorithm &algorithm)
+{
+    return algorithm.GetPandora().GetPandoraContentApiImpl()->GetThreadPool();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+pandora::ScratchArena &PandoraContentApi::GetScratchArena(const pandora::Algorithm &algorithm)
+{
+    return algorithm.GetPandora().GetPandoraContentApiImpl()->GetScratchArena(algorithm);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 pandora::StatusCode PandoraContentApi::RepeatEventPreparation(const pandora::Algorithm &algorithm)
 {
     return algorithm.GetPandora().GetPandoraContentApiImpl()->RepeatEventPreparation();
@@ -48,6 +70,14 @@ pandora::StatusCode PandoraContentApi::CreateAlgorithmTool(const pandora::Algori
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+pandora::StatusCode PandoraContentApi::CloneAlgorithmTool(const pandora::Algorithm &algorithm, const pandora::AlgorithmTool *const pAlgorithmTool,
+    pandora::AlgorithmTool *&pAlgorithmToolClone)
+{
+    return algorithm.GetPandora().GetPandoraContentApiImpl()->CloneAlgorithmTool(pAlgorithmTool, pAlgorithmToolClone);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 pandora::StatusCode PandoraContentApi::CreateDaughterAlgorithm(const pandora::Algorithm &algorithm, pandora::TiXmlElement *const pXmlElement,
     std::string &daughterAlgorithmName)
 {
@@ -63,6 +93,13 @@ pandora::StatusCode PandoraContentApi::RunDaughterAlgorithm(const pandora::Algor
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+pandora::StatusCode PandoraContentApi::RunDaughterAlgorithms(const pandora::Algorithm &algorithm, const pandora::StringVector &daughterAlgorithmNames)
+{
+    return algorithm.GetPandora().GetPandoraContentApiImpl()->RunAlgorithms(daughterAlgorithmNames);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 pandora::StatusCode PandoraContentApi::RunClusteringAlgorithm(const pandora::Algorithm &algorithm, const std::string &clusteringAlgorithmName,
     const pandora::ClusterList *&pNewClusterList, std::string &newClusterListName)
 {
@@ -71,11 +108,18 @@ pandora::StatusCode PandoraContentApi::RunClusteringAlgorithm(const pandora::Alg
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+pandora::StatusCode PandoraContentApi::RunClusteringAlgorithms(const pandora::Algorithm &algorithm, const pandora::StringVector &clusteringAlgorithmNames,
+    pandora::StringVector &newClusterListNames)
+{
+    return algorithm.GetPandora().GetPandoraContentApiImpl()->RunClusteringAlgorithms(algorithm, clusteringAlgorithmNames, newClusterListNames);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 template <typename T>
 pandora::StatusCode PandoraContentApi::GetCurrentList(const pandora::Algorithm &algorithm, const T *&pT)
 {
-    std::string listName;
-    return algorithm.GetPandora().GetPandoraContentApiImpl()->GetCurrentList(pT, listName);
+    return algorithm.GetPandora().GetPandoraContentApiImpl()->GetCurrentList(pT);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -96,6 +140,14 @@ pandora::StatusCode PandoraContentApi::GetCurrentListName(const pandora::Algorit
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+template <typename T>
+pandora::StatusCode PandoraContentApi::GetIndexUpperBound(const pandora::Algorithm &algorithm, unsigned int &indexUpperBound)
+{
+    return algorithm.GetPandora().GetPandoraContentApiImpl()->GetIndexUpperBound<T>(indexUpperBound);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 template <typename T>
 pandora::StatusCode PandoraContentApi::ReplaceCurrentList(const pandora::Algorithm &algorithm, const std::string &newListName)
 {
@@ -187,6 +239,14 @@ pandora::StatusCode PandoraContentApi::CreateTemporaryListAndSetCurrent(const pa
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+pandora::StatusCode PandoraContentApi::CreateTemporaryListAndSetCurrent(const pandora::Algorithm &algorithm, const pandora::CaloHitSpan &caloHitSpan,
+    const pandora::CaloHitList *&pCaloHitList, std::string &temporaryListName)
+{
+    return algorithm.GetPandora().GetPandoraContentApiImpl()->CreateTemporaryListAndSetCurrent(algorithm, caloHitSpan, pCaloHitList, temporaryListName);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 template <typename T>
 bool PandoraContentApi::IsAvailable(const pandora::Algorithm &algorithm, const T *const pT)
 {
@@ -261,6 +321,67 @@ pandora::StatusCode PandoraContentApi::MergeFragments(const pandora::Algorithm &
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+pandora::StatusCode PandoraContentApi::GetInputCaloHitSnapshot(const pandora::Algorithm &algorithm, const pandora::CaloHitSnapshot *&pCaloHitSnapshot)
+{
+    return algorithm.GetPandora().GetPandoraContentApiImpl()->GetInputCaloHitSnapshot(pCaloHitSnapshot);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+pandora::StatusCode PandoraContentApi::GetInputCaloHitTimeIndex(const pandora::Algorithm &algorithm, const pandora::CaloHitTimeIndex *&pCaloHitTimeIndex)
+{
+    return algorithm.GetPandora().GetPandoraContentApiImpl()->GetInputCaloHitTimeIndex(pCaloHitTimeIndex);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+pandora::StatusCode PandoraContentApi::GetInputCaloHitList(const pandora::Algorithm &algorithm, const pandora::HitType hitType,
+    const pandora::CaloHitList *&pCaloHitList)
+{
+    return algorithm.GetPandora().GetPandoraContentApiImpl()->GetInputCaloHitList(hitType, pCaloHitList);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+pandora::StatusCode PandoraContentApi::GetCaloHitSpatialIndex(const pandora::Algorithm &algorithm, const std::string &listName,
+    const pandora::CaloHitSpatialIndex *&pCaloHitSpatialIndex)
+{
+    return algorithm.GetPandora().GetPandoraContentApiImpl()->GetCaloHitSpatialIndex(listName, pCaloHitSpatialIndex);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+pandora::StatusCode PandoraContentApi::GetCaloHitSpatialIndex(const pandora::Algorithm &algorithm, const std::string &listName,
+    const pandora::HitType hitType, const pandora::CaloHitSpatialIndex *&pCaloHitSpatialIndex)
+{
+    return algorithm.GetPandora().GetPandoraContentApiImpl()->GetCaloHitSpatialIndex(listName, hitType, pCaloHitSpatialIndex);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+pandora::StatusCode PandoraContentApi::GetCaloHitNeighbourGraph(const pandora::Algorithm &algorithm, const pandora::CaloHitNeighbourGraph *&pCaloHitNeighbourGraph)
+{
+    return algorithm.GetPandora().GetPandoraContentApiImpl()->GetCaloHitNeighbourGraph(pCaloHitNeighbourGraph);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+pandora::StatusCode PandoraContentApi::GetLArTPCHitGrid(const pandora::Algorithm &algorithm, const pandora::LArTPC &larTPC, const pandora::HitType hitType,
+    const pandora::LArTPCHitGrid *&pLArTPCHitGrid)
+{
+    return algorithm.GetPandora().GetPandoraContentApiImpl()->GetLArTPCHitGrid(larTPC, hitType, pLArTPCHitGrid);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+pandora::StatusCode PandoraContentApi::GetCaloHitCluster(const pandora::Algorithm &algorithm, const pandora::CaloHit *const pCaloHit,
+    const pandora::Cluster *&pCluster)
+{
+    return algorithm.GetPandora().GetPandoraContentApiImpl()->GetCaloHitCluster(pCaloHit, pCluster);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 pandora::StatusCode PandoraContentApi::AddTrackClusterAssociation(const pandora::Algorithm &algorithm, const pandora::Track *const pTrack,
     const pandora::Cluster *const pCluster)
 {
@@ -291,6 +412,42 @@ pandora::StatusCode PandoraContentApi::RemoveAllTrackClusterAssociations(const p
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+pandora::StatusCode PandoraContentApi::GetTrackClusterAssociations(const pandora::Algorithm &algorithm, pandora::TrackClusterAssociationVector &associations)
+{
+    return algorithm.GetPandora().GetPandoraContentApiImpl()->GetTrackClusterAssociations(associations);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+pandora::StatusCode PandoraContentApi::RestoreTrackClusterAssociations(const pandora::Algorithm &algorithm,
+    const pandora::TrackClusterAssociationVector &associations)
+{
+    return algorithm.GetPandora().GetPandoraContentApiImpl()->RestoreTrackClusterAssociations(associations);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+pandora::StatusCode PandoraContentApi::GetInputTrackSpatialIndex(const pandora::Algorithm &algorithm, const pandora::TrackSpatialIndex *&pTrackSpatialIndex)
+{
+    return algorithm.GetPandora().GetPandoraContentApiImpl()->GetInputTrackSpatialIndex(pTrackSpatialIndex);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+pandora::StatusCode PandoraContentApi::GetTrackRelationGraph(const pandora::Algorithm &algorithm, const pandora::TrackRelationGraph *&pTrackRelationGraph)
+{
+    return algorithm.GetPandora().GetPandoraContentApiImpl()->GetTrackRelationGraph(pTrackRelationGraph);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+pandora::StatusCode PandoraContentApi::GetTrackSelectionMasks(const pandora::Algorithm &algorithm, const pandora::TrackSelectionMasks *&pTrackSelectionMasks)
+{
+    return algorithm.GetPandora().GetPandoraContentApiImpl()->GetTrackSelectionMasks(pTrackSelectionMasks);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 pandora::StatusCode PandoraContentApi::RemoveAllMCParticleRelationships(const pandora::Algorithm &algorithm)
 {
     return algorithm.GetPandora().GetPandoraContentApiImpl()->RemoveAllMCParticleRelationships();
@@ -314,6 +471,20 @@ pandora::StatusCode PandoraContentApi::MergeAndDeleteClusters(const pandora::Alg
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+pandora::StatusCode PandoraContentApi::GetCurrentClusterSpatialIndex(const pandora::Algorithm &algorithm, const pandora::ClusterSpatialIndex *&pClusterSpatialIndex)
+{
+    return algorithm.GetPandora().GetPandoraContentApiImpl()->GetCurrentClusterSpatialIndex(pClusterSpatialIndex);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+pandora::StatusCode PandoraContentApi::GetCurrentClusterPairFinder(const pandora::Algorithm &algorithm, const pandora::ClusterPairFinder *&pClusterPairFinder)
+{
+    return algorithm.GetPandora().GetPandoraContentApiImpl()->GetCurrentClusterPairFinder(pClusterPairFinder);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 template <typename T>
 pandora::StatusCode PandoraContentApi::AddToPfo(const pandora::Algorithm &algorithm, const pandora::ParticleFlowObject *const pPfo, const T *const pT)
 {
@@ -346,6 +517,37 @@ pandora::StatusCode PandoraContentApi::RemovePfoParentDaughterRelationship(const
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+pandora::StatusCode PandoraContentApi::GetPfoHierarchy(const pandora::Algorithm &algorithm, const pandora::PfoHierarchy *&pPfoHierarchy)
+{
+    return algorithm.GetPandora().GetPandoraContentApiImpl()->GetPfoHierarchy(pPfoHierarchy);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+pandora::StatusCode PandoraContentApi::GetVertexSpatialIndex(const pandora::Algorithm &algorithm, const std::string &listName,
+    const pandora::VertexSpatialIndex *&pVertexSpatialIndex)
+{
+    return algorithm.GetPandora().GetPandoraContentApiImpl()->GetVertexSpatialIndex(listName, pVertexSpatialIndex);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+pandora::StatusCode PandoraContentApi::MergeNearbyVertices(const pandora::Algorithm &algorithm, const std::string &listName, const float mergeDistance)
+{
+    return algorithm.GetPandora().GetPandoraContentApiImpl()->MergeNearbyVertices(listName, mergeDistance);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+pandora::StatusCode PandoraContentApi::GetVertexCaloHitSummaries(const pandora::Algorithm &algorithm, const pandora::VertexVector &vertexVector,
+    const std::string &caloHitListName, const float summaryRadius, pandora::VertexCaloHitSummaryVector &summaryVector)
+{
+    return algorithm.GetPandora().GetPandoraContentApiImpl()->GetVertexCaloHitSummaries(vertexVector, caloHitListName, summaryRadius,
+        summaryVector);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 pandora::StatusCode PandoraContentApi::InitializeFragmentation(const pandora::Algorithm &algorithm, const pandora::ClusterList &inputClusterList,
     std::string &originalClustersListName, std::string &fragmentClustersListName)
 {
@@ -376,6 +578,27 @@ pandora::StatusCode PandoraContentApi::EndReclustering(const pandora::Algorithm
     return algorithm.GetPandora().GetPandoraContentApiImpl()->EndReclustering(algorithm, selectedClusterListName);
 }
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+pandora::StatusCode PandoraContentApi::CreateCheckpoint(const pandora::Algorithm &algorithm)
+{
+    return algorithm.GetPandora().GetPandoraContentApiImpl()->CreateCheckpoint(algorithm);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+pandora::StatusCode PandoraContentApi::RollbackToCheckpoint(const pandora::Algorithm &algorithm)
+{
+    return algorithm.GetPandora().GetPandoraContentApiImpl()->RollbackToCheckpoint(algorithm);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+pandora::StatusCode PandoraContentApi::ReleaseCheckpoint(const pandora::Algorithm &algorithm)
+{
+    return algorithm.GetPandora().GetPandoraContentApiImpl()->ReleaseCheckpoint(algorithm);
+}
+
 //------------------------------------------------------------------------------------------------------------------------------------------
 //------------------------------------------------------------------------------------------------------------------------------------------
 
@@ -400,6 +623,13 @@ template pandora::StatusCode PandoraContentApi::GetCurrentListName<pandora::Clus
 template pandora::StatusCode PandoraContentApi::GetCurrentListName<pandora::ParticleFlowObject>(const pandora::Algorithm &, std::string &);
 template pandora::StatusCode PandoraContentApi::GetCurrentListName<pandora::Vertex>(const pandora::Algorithm &, std::string &);
 
+template pandora::StatusCode PandoraContentApi::GetIndexUpperBound<pandora::CaloHit>(const pandora::Algorithm &, unsigned int &);
+template pandora::StatusCode PandoraContentApi::GetIndexUpperBound<pandora::Track>(const pandora::Algorithm &, unsigned int &);
+template pandora::StatusCode PandoraContentApi::GetIndexUpperBound<pandora::MCParticle>(const pandora::Algorithm &, unsigned int &);
+template pandora::StatusCode PandoraContentApi::GetIndexUpperBound<pandora::Cluster>(const pandora::Algorithm &, unsigned int &);
+template pandora::StatusCode PandoraContentApi::GetIndexUpperBound<pandora::ParticleFlowObject>(const pandora::Algorithm &, unsigned int &);
+template pandora::StatusCode PandoraContentApi::GetIndexUpperBound<pandora::Vertex>(const pandora::Algorithm &, unsigned int &);
+
 template pandora::StatusCode PandoraContentApi::ReplaceCurrentList<pandora::CaloHit>(const pandora::Algorithm &, const std::string &);
 template pandora::StatusCode PandoraContentApi::ReplaceCurrentList<pandora::Track>(const pandora::Algorithm &, const std::string &);
 template pandora::StatusCode PandoraContentApi::ReplaceCurrentList<pandora::MCParticle>(const pandora::Algorithm &, const std::string &);
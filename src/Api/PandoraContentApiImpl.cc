@@ -15,6 +15,7 @@
 #include "Managers/MCManager.h"
 #include "Managers/ParticleFlowObjectManager.h"
 #include "Managers/PluginManager.h"
+#include "Managers/ProfileManager.h"
 #include "Managers/TrackManager.h"
 #include "Managers/VertexManager.h"
 
@@ -32,6 +33,8 @@
 
 #include "Persistency/PandoraIO.h"
 
+#include <algorithm>
+
 namespace pandora
 {
 
@@ -76,18 +79,27 @@ StatusCode PandoraContentApiImpl::AlterMetadata(const CaloHit *const pObject, co
 template <>
 StatusCode PandoraContentApiImpl::AlterMetadata(const Cluster *const pObject, const object_creation::Cluster::Metadata &metadata) const
 {
+    if (m_pCheckpoint->IsOpen())
+        return STATUS_CODE_NOT_ALLOWED;
+
     return this->GetManager<Cluster>()->AlterMetadata(pObject, metadata);
 }
 
 template <>
 StatusCode PandoraContentApiImpl::AlterMetadata(const ParticleFlowObject *const pObject, const object_creation::ParticleFlowObject::Metadata &metadata) const
 {
+    if (m_pCheckpoint->IsOpen())
+        return STATUS_CODE_NOT_ALLOWED;
+
     return this->GetManager<ParticleFlowObject>()->AlterMetadata(pObject, metadata);
 }
 
 template <>
 StatusCode PandoraContentApiImpl::AlterMetadata(const Vertex *const pObject, const object_creation::Vertex::Metadata &metadata) const
 {
+    if (m_pCheckpoint->IsOpen())
+        return STATUS_CODE_NOT_ALLOWED;
+
     return this->GetManager<Vertex>()->AlterMetadata(pObject, metadata);
 }
 
@@ -124,7 +136,17 @@ template <>
 StatusCode PandoraContentApiImpl::Create(const object_creation::Vertex::Parameters &parameters, const Vertex *&pObject,
     const pandora::ObjectFactory<object_creation::Vertex::Parameters, object_creation::Vertex::Object> &factory) const
 {
-    return this->GetManager<Vertex>()->Create(parameters, pObject, factory);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Vertex>()->Create(parameters, pObject, factory));
+
+    if (m_pCheckpoint->IsOpen())
+    {
+        ManagerCheckpoint::Change change(ManagerCheckpoint::VERTEX_CREATION);
+        change.m_pVertex = pObject;
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Vertex>()->GetCurrentListName(change.m_listName));
+        this->RecordChange(change);
+    }
+
+    return STATUS_CODE_SUCCESS;
 }
 
 template <>
@@ -141,6 +163,14 @@ StatusCode PandoraContentApiImpl::Create(const object_creation::Cluster::Paramet
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<CaloHit>()->SetAvailability(&parameters.m_caloHitList, false));
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<CaloHit>()->SetAvailability(&parameters.m_isolatedCaloHitList, false));
 
+    if (m_pCheckpoint->IsOpen())
+    {
+        ManagerCheckpoint::Change change(ManagerCheckpoint::CLUSTER_CREATION);
+        change.m_pCluster = pCluster;
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->GetCurrentListName(change.m_listName));
+        this->RecordChange(change);
+    }
+
     return STATUS_CODE_SUCCESS;
 }
 
@@ -160,6 +190,14 @@ StatusCode PandoraContentApiImpl::Create(const object_creation::ParticleFlowObje
     this->GetManager<Track>()->SetAvailability(&pfoParameters.m_trackList, false);
     this->GetManager<Vertex>()->SetAvailability(&pfoParameters.m_vertexList, false);
 
+    if (m_pCheckpoint->IsOpen())
+    {
+        ManagerCheckpoint::Change change(ManagerCheckpoint::PFO_CREATION);
+        change.m_pPfo = pPfo;
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<ParticleFlowObject>()->GetCurrentListName(change.m_listName));
+        this->RecordChange(change);
+    }
+
     return STATUS_CODE_SUCCESS;
 }
 
@@ -192,6 +230,21 @@ const PluginManager *PandoraContentApiImpl::GetPlugins() const
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+ThreadPool *PandoraContentApiImpl::GetThreadPool() const
+{
+    return m_pPandora->m_pThreadPool;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+ScratchArena &PandoraContentApiImpl::GetScratchArena(const Algorithm &algorithm) const
+{
+    // ATTN Algorithms reach the api only through const references, but own their scratch arenas
+    return const_cast<Algorithm &>(algorithm).GetScratchArena();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 StatusCode PandoraContentApiImpl::RepeatEventPreparation() const
 {
     return m_pPandora->PrepareEvent();
@@ -206,6 +259,13 @@ StatusCode PandoraContentApiImpl::CreateAlgorithmTool(TiXmlElement *const pXmlEl
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+StatusCode PandoraContentApiImpl::CloneAlgorithmTool(const AlgorithmTool *const pAlgorithmTool, AlgorithmTool *&pAlgorithmToolClone) const
+{
+    return m_pPandora->m_pAlgorithmManager->CloneAlgorithmTool(pAlgorithmTool, pAlgorithmToolClone);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 StatusCode PandoraContentApiImpl::CreateDaughterAlgorithm(TiXmlElement *const pXmlElement, std::string &daughterAlgorithmName) const
 {
     return m_pPandora->m_pAlgorithmManager->CreateAlgorithm(pXmlElement, daughterAlgorithmName);
@@ -220,6 +280,18 @@ StatusCode PandoraContentApiImpl::RunAlgorithm(const std::string &algorithmName)
     if (m_pPandora->m_pAlgorithmManager->m_algorithmMap.end() == iter)
         return STATUS_CODE_NOT_FOUND;
 
+    // ATTN Daughter algorithms delete their temporary objects on completion, which the checkpoint could not then revert
+    if (m_pCheckpoint->IsOpen())
+        return STATUS_CODE_NOT_ALLOWED;
+
+    if (this->IsObjectBudgetExceeded())
+        return STATUS_CODE_BUDGET_EXCEEDED;
+
+    const bool shouldProfileAlgorithm(m_pPandora->GetSettings()->ShouldProfileAlgorithms());
+
+    if (shouldProfileAlgorithm)
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pPandora->m_pProfileManager->BeginAlgorithm(iter->second));
+
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->PreRunAlgorithm(iter->second));
 
     try
@@ -228,7 +300,7 @@ StatusCode PandoraContentApiImpl::RunAlgorithm(const std::string &algorithmName)
 
         if (shouldDisplayAlgorithmInfo)
         {
-            for (unsigned int i = 1, iMax = this->GetManager<CaloHit>()->m_algorithmInfoMap.size(); i < iMax; ++i) std::cout << "----";
+            for (unsigned int i = 1; i < m_algorithmDepth; ++i) std::cout << "----";
             std::cout << "> Running Algorithm: " << iter->second->GetInstanceName() << ", " << iter->second->GetType() << std::endl;
         }
 
@@ -243,6 +315,15 @@ StatusCode PandoraContentApiImpl::RunAlgorithm(const std::string &algorithmName)
     {
         std::cout << "Algorithm " << iter->first << ", " << iter->second->GetType() << " raised stop processing exception: "
                   << exception.GetDescription() << std::endl;
+
+        if (m_pCheckpoint->IsOpen())
+            PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReleaseCheckpoint());
+
+        --m_algorithmDepth;
+
+        if (shouldProfileAlgorithm)
+            PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pPandora->m_pProfileManager->EndAlgorithm());
+
         throw exception;
     }
     catch (...)
@@ -252,6 +333,34 @@ StatusCode PandoraContentApiImpl::RunAlgorithm(const std::string &algorithmName)
 
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->PostRunAlgorithm(iter->second));
 
+    if (shouldProfileAlgorithm)
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pPandora->m_pProfileManager->EndAlgorithm());
+
+    // ATTN Abandon the event, unwinding through any parent algorithms, each of which tidies its temporary objects and lists
+    if (this->IsObjectBudgetExceeded())
+    {
+        std::cout << "Algorithm " << iter->first << ", " << iter->second->GetType() << " exceeded the per-event object budget" << std::endl;
+        return STATUS_CODE_BUDGET_EXCEEDED;
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PandoraContentApiImpl::RunAlgorithms(const StringVector &algorithmNames) const
+{
+    const AlgorithmManager::AlgorithmMap &algorithmMap(m_pPandora->m_pAlgorithmManager->m_algorithmMap);
+
+    for (const std::string &algorithmName : algorithmNames)
+    {
+        if (algorithmMap.end() == algorithmMap.find(algorithmName))
+            return STATUS_CODE_NOT_FOUND;
+    }
+
+    for (const std::string &algorithmName : algorithmNames)
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->RunAlgorithm(algorithmName));
+
     return STATUS_CODE_SUCCESS;
 }
 
@@ -260,6 +369,9 @@ StatusCode PandoraContentApiImpl::RunAlgorithm(const std::string &algorithmName)
 StatusCode PandoraContentApiImpl::RunClusteringAlgorithm(const Algorithm &algorithm, const std::string &clusteringAlgorithmName,
     const ClusterList *&pNewClusterList, std::string &newClusterListName) const
 {
+    if (m_pCheckpoint->IsOpen())
+        return STATUS_CODE_NOT_ALLOWED;
+
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->CreateTemporaryListAndSetCurrent(&algorithm, newClusterListName));
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<CaloHit>()->PrepareForClustering(&algorithm, newClusterListName));
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->RunAlgorithm(clusteringAlgorithmName));
@@ -270,6 +382,34 @@ StatusCode PandoraContentApiImpl::RunClusteringAlgorithm(const Algorithm &algori
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+StatusCode PandoraContentApiImpl::RunClusteringAlgorithms(const Algorithm &algorithm, const StringVector &clusteringAlgorithmNames,
+    StringVector &newClusterListNames) const
+{
+    const AlgorithmManager::AlgorithmMap &algorithmMap(m_pPandora->m_pAlgorithmManager->m_algorithmMap);
+
+    for (const std::string &clusteringAlgorithmName : clusteringAlgorithmNames)
+    {
+        if (algorithmMap.end() == algorithmMap.find(clusteringAlgorithmName))
+            return STATUS_CODE_NOT_FOUND;
+    }
+
+    newClusterListNames.clear();
+    newClusterListNames.reserve(clusteringAlgorithmNames.size());
+
+    // ATTN Candidates share no state beyond the input calo hits, but the managers are not thread-safe, so candidates run in turn
+    for (const std::string &clusteringAlgorithmName : clusteringAlgorithmNames)
+    {
+        const ClusterList *pNewClusterList(nullptr);
+        std::string newClusterListName;
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->RunClusteringAlgorithm(algorithm, clusteringAlgorithmName, pNewClusterList, newClusterListName));
+        newClusterListNames.push_back(newClusterListName);
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 template <typename T>
 StatusCode PandoraContentApiImpl::GetCurrentList(const T *&pT, std::string &listName) const
 {
@@ -278,6 +418,14 @@ StatusCode PandoraContentApiImpl::GetCurrentList(const T *&pT, std::string &list
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+template <typename T>
+StatusCode PandoraContentApiImpl::GetCurrentList(const T *&pT) const
+{
+    return this->GetManager<T>()->GetCurrentList(pT);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 template <typename T>
 StatusCode PandoraContentApiImpl::GetCurrentListName(std::string &listName) const
 {
@@ -286,9 +434,21 @@ StatusCode PandoraContentApiImpl::GetCurrentListName(std::string &listName) cons
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+template <typename T>
+StatusCode PandoraContentApiImpl::GetIndexUpperBound(unsigned int &indexUpperBound) const
+{
+    indexUpperBound = this->GetManager<T>()->GetIndexUpperBound();
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 template <typename T>
 StatusCode PandoraContentApiImpl::ReplaceCurrentList(const Algorithm &algorithm, const std::string &newListName) const
 {
+    if (m_pCheckpoint->IsOpen())
+        return STATUS_CODE_NOT_ALLOWED;
+
     return this->GetManager<T>()->ReplaceCurrentAndAlgorithmInputLists(&algorithm, newListName);
 }
 
@@ -297,6 +457,9 @@ StatusCode PandoraContentApiImpl::ReplaceCurrentList(const Algorithm &algorithm,
 template <typename T>
 StatusCode PandoraContentApiImpl::DropCurrentList(const Algorithm &algorithm) const
 {
+    if (m_pCheckpoint->IsOpen())
+        return STATUS_CODE_NOT_ALLOWED;
+
     return this->GetManager<T>()->DropCurrentList(&algorithm);
 }
 
@@ -313,6 +476,9 @@ StatusCode PandoraContentApiImpl::GetList(const std::string &listName, const T *
 template <typename T>
 StatusCode PandoraContentApiImpl::RenameList(const std::string &oldListName, const std::string &newListName) const
 {
+    if (m_pCheckpoint->IsOpen())
+        return STATUS_CODE_NOT_ALLOWED;
+
     return this->GetManager<T>()->RenameList(oldListName, newListName);
 }
 
@@ -321,6 +487,9 @@ StatusCode PandoraContentApiImpl::RenameList(const std::string &oldListName, con
 template <typename T>
 StatusCode PandoraContentApiImpl::SaveList(const T &t, const std::string &newListName) const
 {
+    if (m_pCheckpoint->IsOpen())
+        return STATUS_CODE_NOT_ALLOWED;
+
     return this->GetManager<T>()->SaveList(newListName, t);
 }
 
@@ -329,6 +498,9 @@ StatusCode PandoraContentApiImpl::SaveList(const T &t, const std::string &newLis
 template <typename T>
 StatusCode PandoraContentApiImpl::SaveList(const std::string &newListName) const
 {
+    if (m_pCheckpoint->IsOpen())
+        return STATUS_CODE_NOT_ALLOWED;
+
     std::string currentListName;
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<T>()->GetCurrentListName(currentListName));
     return this->GetManager<T>()->SaveObjects(newListName, currentListName);
@@ -339,6 +511,9 @@ StatusCode PandoraContentApiImpl::SaveList(const std::string &newListName) const
 template <typename T>
 StatusCode PandoraContentApiImpl::SaveList(const std::string &oldListName, const std::string &newListName) const
 {
+    if (m_pCheckpoint->IsOpen())
+        return STATUS_CODE_NOT_ALLOWED;
+
     return this->GetManager<T>()->SaveObjects(newListName, oldListName);
 }
 
@@ -347,6 +522,9 @@ StatusCode PandoraContentApiImpl::SaveList(const std::string &oldListName, const
 template <typename T>
 StatusCode PandoraContentApiImpl::SaveList(const std::string &newListName, const T &t) const
 {
+    if (m_pCheckpoint->IsOpen())
+        return STATUS_CODE_NOT_ALLOWED;
+
     std::string currentListName;
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<T>()->GetCurrentListName(currentListName));
     return this->GetManager<T>()->SaveObjects(newListName, currentListName, t);
@@ -357,6 +535,9 @@ StatusCode PandoraContentApiImpl::SaveList(const std::string &newListName, const
 template <typename T>
 StatusCode PandoraContentApiImpl::SaveList(const std::string &oldListName, const std::string &newListName, const T &t) const
 {
+    if (m_pCheckpoint->IsOpen())
+        return STATUS_CODE_NOT_ALLOWED;
+
     return this->GetManager<T>()->SaveObjects(newListName, oldListName, t);
 }
 
@@ -379,6 +560,16 @@ StatusCode PandoraContentApiImpl::CreateTemporaryListAndSetCurrent(const Algorit
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+StatusCode PandoraContentApiImpl::CreateTemporaryListAndSetCurrent(const Algorithm &algorithm, const CaloHitSpan &caloHitSpan,
+    const CaloHitList *&pCaloHitList, std::string &temporaryListName) const
+{
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<CaloHit>()->CreateTemporaryListAndSetCurrent(&algorithm, caloHitSpan,
+        temporaryListName));
+    return this->GetManager<CaloHit>()->GetCurrentList(pCaloHitList, temporaryListName);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 template <typename T>
 bool PandoraContentApiImpl::IsAvailable(const T *const pT) const
 {
@@ -390,16 +581,31 @@ bool PandoraContentApiImpl::IsAvailable(const T *const pT) const
 template <>
 StatusCode PandoraContentApiImpl::AddToCluster(const Cluster *const pCluster, const CaloHitList *const pCaloHitList) const
 {
-    for (const CaloHit *const pCaloHit : *pCaloHitList)
+    // ATTN Hits are marked as unavailable as they are checked, so a hit appearing twice in the list is refused, leaving no changes
+    for (CaloHitList::const_iterator iter = pCaloHitList->begin(), iterEnd = pCaloHitList->end(); iter != iterEnd; ++iter)
     {
-        if (!this->IsAddToClusterAllowed(pCluster, pCaloHit))
+        if (!this->IsAddToClusterAllowed(pCluster, *iter))
+        {
+            for (CaloHitList::const_iterator restoreIter = pCaloHitList->begin(); restoreIter != iter; ++restoreIter)
+                PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<CaloHit>()->SetAvailability(*restoreIter, true));
+
             return STATUS_CODE_NOT_ALLOWED;
+        }
+
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<CaloHit>()->SetAvailability(*iter, false));
     }
 
-    for (const CaloHit *const pCaloHit : *pCaloHitList)
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->AddToCluster(pCluster, *pCaloHitList));
+
+    if (m_pCheckpoint->IsOpen())
     {
-        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->AddToCluster(pCluster, pCaloHit));
-        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<CaloHit>()->SetAvailability(pCaloHit, false));
+        for (const CaloHit *const pCaloHit : *pCaloHitList)
+        {
+            ManagerCheckpoint::Change change(ManagerCheckpoint::CALO_HIT_ADDITION);
+            change.m_pCluster = pCluster;
+            change.m_pCaloHit = pCaloHit;
+            this->RecordChange(change);
+        }
     }
 
     return STATUS_CODE_SUCCESS;
@@ -419,9 +625,22 @@ StatusCode PandoraContentApiImpl::RemoveFromCluster(const Cluster *const pCluste
     if ((pCluster->GetNCaloHits() <= 1) && (pCluster->GetNIsolatedCaloHits() == 0))
         return STATUS_CODE_NOT_ALLOWED;
 
+    // ATTN Removing the last ordered calo hit resets the cluster, dropping its isolated calo hits, which a rollback must add again
+    const CaloHitList isolatedCaloHitList((m_pCheckpoint->IsOpen() && (pCluster->GetNCaloHits() <= 1)) ? pCluster->GetIsolatedCaloHitList() :
+        CaloHitList());
+
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->RemoveFromCluster(pCluster, pCaloHit));
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<CaloHit>()->SetAvailability(pCaloHit, true));
 
+    if (m_pCheckpoint->IsOpen())
+    {
+        ManagerCheckpoint::Change change(ManagerCheckpoint::CALO_HIT_REMOVAL);
+        change.m_pCluster = pCluster;
+        change.m_pCaloHit = pCaloHit;
+        change.m_isolatedCaloHitList = isolatedCaloHitList;
+        this->RecordChange(change);
+    }
+
     return STATUS_CODE_SUCCESS;
 }
 
@@ -440,6 +659,14 @@ StatusCode PandoraContentApiImpl::AddIsolatedToCluster(const Cluster *const pClu
     {
         PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->AddIsolatedToCluster(pCluster, pCaloHit));
         PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<CaloHit>()->SetAvailability(pCaloHit, false));
+
+        if (m_pCheckpoint->IsOpen())
+        {
+            ManagerCheckpoint::Change change(ManagerCheckpoint::ISOLATED_CALO_HIT_ADDITION);
+            change.m_pCluster = pCluster;
+            change.m_pCaloHit = pCaloHit;
+            this->RecordChange(change);
+        }
     }
 
     return STATUS_CODE_SUCCESS;
@@ -462,6 +689,14 @@ StatusCode PandoraContentApiImpl::RemoveIsolatedFromCluster(const Cluster *const
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->RemoveIsolatedFromCluster(pCluster, pCaloHit));
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<CaloHit>()->SetAvailability(pCaloHit, true));
 
+    if (m_pCheckpoint->IsOpen())
+    {
+        ManagerCheckpoint::Change change(ManagerCheckpoint::ISOLATED_CALO_HIT_REMOVAL);
+        change.m_pCluster = pCluster;
+        change.m_pCaloHit = pCaloHit;
+        this->RecordChange(change);
+    }
+
     return STATUS_CODE_SUCCESS;
 }
 
@@ -470,6 +705,9 @@ StatusCode PandoraContentApiImpl::RemoveIsolatedFromCluster(const Cluster *const
 StatusCode PandoraContentApiImpl::Fragment(const CaloHit *const pOriginalCaloHit, const float fraction1, const CaloHit *&pDaughterCaloHit1,
     const CaloHit *&pDaughterCaloHit2, const ObjectFactory<object_creation::CaloHitFragment::Parameters, object_creation::CaloHitFragment::Object> &factory) const
 {
+    if (m_pCheckpoint->IsOpen())
+        return STATUS_CODE_NOT_ALLOWED;
+
     return this->GetManager<CaloHit>()->FragmentCaloHit(pOriginalCaloHit, fraction1, pDaughterCaloHit1, pDaughterCaloHit2, factory);
 }
 
@@ -478,16 +716,87 @@ StatusCode PandoraContentApiImpl::Fragment(const CaloHit *const pOriginalCaloHit
 StatusCode PandoraContentApiImpl::MergeFragments(const CaloHit *const pFragmentCaloHit1, const CaloHit *const pFragmentCaloHit2,
     const CaloHit *&pMergedCaloHit, const ObjectFactory<object_creation::CaloHitFragment::Parameters, object_creation::CaloHitFragment::Object> &factory) const
 {
+    if (m_pCheckpoint->IsOpen())
+        return STATUS_CODE_NOT_ALLOWED;
+
     return this->GetManager<CaloHit>()->MergeCaloHitFragments(pFragmentCaloHit1, pFragmentCaloHit2, pMergedCaloHit, factory);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+StatusCode PandoraContentApiImpl::GetInputCaloHitSnapshot(const CaloHitSnapshot *&pCaloHitSnapshot) const
+{
+    return this->GetManager<CaloHit>()->GetInputSnapshot(pCaloHitSnapshot);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PandoraContentApiImpl::GetInputCaloHitTimeIndex(const CaloHitTimeIndex *&pCaloHitTimeIndex) const
+{
+    return this->GetManager<CaloHit>()->GetInputTimeIndex(pCaloHitTimeIndex);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PandoraContentApiImpl::GetInputCaloHitList(const HitType hitType, const CaloHitList *&pCaloHitList) const
+{
+    return this->GetManager<CaloHit>()->GetInputList(hitType, pCaloHitList);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PandoraContentApiImpl::GetCaloHitSpatialIndex(const std::string &listName, const CaloHitSpatialIndex *&pCaloHitSpatialIndex) const
+{
+    return this->GetManager<CaloHit>()->GetListSpatialIndex(listName, pCaloHitSpatialIndex);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PandoraContentApiImpl::GetCaloHitSpatialIndex(const std::string &listName, const HitType hitType,
+    const CaloHitSpatialIndex *&pCaloHitSpatialIndex) const
+{
+    return this->GetManager<CaloHit>()->GetListSpatialIndex(listName, hitType, pCaloHitSpatialIndex);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PandoraContentApiImpl::GetCaloHitNeighbourGraph(const CaloHitNeighbourGraph *&pCaloHitNeighbourGraph) const
+{
+    return this->GetManager<CaloHit>()->GetNeighbourGraph(pCaloHitNeighbourGraph);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PandoraContentApiImpl::GetLArTPCHitGrid(const LArTPC &larTPC, const HitType hitType, const LArTPCHitGrid *&pLArTPCHitGrid) const
+{
+    return this->GetManager<CaloHit>()->GetLArTPCHitGrid(larTPC, hitType, pLArTPCHitGrid);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PandoraContentApiImpl::GetCaloHitCluster(const CaloHit *const pCaloHit, const Cluster *&pCluster) const
+{
+    return this->GetManager<Cluster>()->GetCaloHitCluster(pCaloHit, pCluster);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 StatusCode PandoraContentApiImpl::AddTrackClusterAssociation(const Track *const pTrack, const Cluster *const pCluster) const
 {
+    if (pTrack->GetEventId() != pCluster->GetEventId())
+        return STATUS_CODE_NOT_ALLOWED;
+
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Track>()->SetAssociatedCluster(pTrack, pCluster));
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->AddTrackAssociation(pCluster, pTrack));
 
+    if (m_pCheckpoint->IsOpen())
+    {
+        ManagerCheckpoint::Change change(ManagerCheckpoint::TRACK_CLUSTER_ASSOCIATION);
+        change.m_pTrack = pTrack;
+        change.m_pCluster = pCluster;
+        this->RecordChange(change);
+    }
+
     return STATUS_CODE_SUCCESS;
 }
 
@@ -498,6 +807,14 @@ StatusCode PandoraContentApiImpl::RemoveTrackClusterAssociation(const Track *con
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Track>()->RemoveAssociatedCluster(pTrack, pCluster));
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->RemoveTrackAssociation(pCluster, pTrack));
 
+    if (m_pCheckpoint->IsOpen())
+    {
+        ManagerCheckpoint::Change change(ManagerCheckpoint::TRACK_CLUSTER_DISASSOCIATION);
+        change.m_pTrack = pTrack;
+        change.m_pCluster = pCluster;
+        this->RecordChange(change);
+    }
+
     return STATUS_CODE_SUCCESS;
 }
 
@@ -505,17 +822,37 @@ StatusCode PandoraContentApiImpl::RemoveTrackClusterAssociation(const Track *con
 
 StatusCode PandoraContentApiImpl::RemoveCurrentTrackClusterAssociations() const
 {
-    TrackList danglingTracks;
-    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->RemoveCurrentTrackAssociations(danglingTracks));
+    if (m_pCheckpoint->IsOpen())
+        return STATUS_CODE_NOT_ALLOWED;
+
+    const ClusterList *pClusterList(nullptr);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->GetCurrentList(pClusterList));
+
+    for (const Cluster *const pCluster : *pClusterList)
+    {
+        const TrackList trackList(pCluster->GetAssociatedTrackList());
+
+        for (const Track *const pTrack : trackList)
+        {
+            PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->RemoveTrackAssociation(pCluster, pTrack));
+
+            if (pTrack->HasAssociatedCluster())
+                PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Track>()->RemoveAssociatedCluster(pTrack, pTrack->GetAssociatedCluster()));
+        }
+    }
 
-    if (!danglingTracks.empty())
-        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Track>()->RemoveClusterAssociations(danglingTracks));
+    const TrackList *pTrackList(nullptr);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Track>()->GetCurrentList(pTrackList));
 
-    TrackToClusterMap danglingClusters;
-    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Track>()->RemoveCurrentClusterAssociations(danglingClusters));
+    for (const Track *const pTrack : *pTrackList)
+    {
+        if (!pTrack->HasAssociatedCluster())
+            continue;
 
-    if (!danglingClusters.empty())
-        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->RemoveTrackAssociations(danglingClusters));
+        const Cluster *const pCluster(pTrack->GetAssociatedCluster());
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Track>()->RemoveAssociatedCluster(pTrack, pCluster));
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->RemoveTrackAssociation(pCluster, pTrack));
+    }
 
     return STATUS_CODE_SUCCESS;
 }
@@ -524,6 +861,9 @@ StatusCode PandoraContentApiImpl::RemoveCurrentTrackClusterAssociations() const
 
 StatusCode PandoraContentApiImpl::RemoveAllTrackClusterAssociations() const
 {
+    if (m_pCheckpoint->IsOpen())
+        return STATUS_CODE_NOT_ALLOWED;
+
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Track>()->RemoveAllClusterAssociations());
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->RemoveAllTrackAssociations());
 
@@ -532,6 +872,66 @@ StatusCode PandoraContentApiImpl::RemoveAllTrackClusterAssociations() const
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+StatusCode PandoraContentApiImpl::GetTrackClusterAssociations(TrackClusterAssociationVector &associations) const
+{
+    return this->GetManager<Track>()->GetClusterAssociations(associations);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PandoraContentApiImpl::RestoreTrackClusterAssociations(const TrackClusterAssociationVector &associations) const
+{
+    if (m_pCheckpoint->IsOpen())
+        return STATUS_CODE_NOT_ALLOWED;
+
+    for (const TrackClusterAssociationVector::value_type &association : associations)
+    {
+        if (association.first->GetEventId() != association.second->GetEventId())
+            return STATUS_CODE_NOT_ALLOWED;
+    }
+
+    // ATTN Every association has exactly one track, so the track side enumerates the existing associations without a cluster list walk
+    TrackClusterAssociationVector currentAssociations;
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Track>()->GetClusterAssociations(currentAssociations));
+
+    for (const TrackClusterAssociationVector::value_type &association : currentAssociations)
+    {
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Track>()->RemoveAssociatedCluster(association.first, association.second));
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->RemoveTrackAssociation(association.second, association.first));
+    }
+
+    for (const TrackClusterAssociationVector::value_type &association : associations)
+    {
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Track>()->SetAssociatedCluster(association.first, association.second));
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->AddTrackAssociation(association.second, association.first));
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PandoraContentApiImpl::GetInputTrackSpatialIndex(const TrackSpatialIndex *&pTrackSpatialIndex) const
+{
+    return this->GetManager<Track>()->GetInputSpatialIndex(pTrackSpatialIndex);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PandoraContentApiImpl::GetTrackRelationGraph(const TrackRelationGraph *&pTrackRelationGraph) const
+{
+    return this->GetManager<Track>()->GetTrackRelationGraph(pTrackRelationGraph);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PandoraContentApiImpl::GetTrackSelectionMasks(const TrackSelectionMasks *&pTrackSelectionMasks) const
+{
+    return this->GetManager<Track>()->GetTrackSelectionMasks(pTrackSelectionMasks);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 StatusCode PandoraContentApiImpl::RemoveAllMCParticleRelationships() const
 {
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<MCParticle>()->RemoveAllMCParticleRelationships());
@@ -555,10 +955,27 @@ StatusCode PandoraContentApiImpl::MergeAndDeleteClusters(const Cluster *const pC
 StatusCode PandoraContentApiImpl::MergeAndDeleteClusters(const Cluster *const pClusterToEnlarge, const Cluster *const pClusterToDelete,
     const std::string &enlargeListName, const std::string &deleteListName) const
 {
-    if ((pClusterToEnlarge == pClusterToDelete) || !this->GetManager<Cluster>()->IsAvailable(pClusterToDelete))
+    if ((pClusterToEnlarge == pClusterToDelete) || (pClusterToEnlarge->GetEventId() != pClusterToDelete->GetEventId()) ||
+        !this->GetManager<Cluster>()->IsAvailable(pClusterToDelete))
+    {
         return STATUS_CODE_NOT_ALLOWED;
+    }
 
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Track>()->RemoveClusterAssociations(pClusterToDelete->GetAssociatedTrackList()));
+
+    if (m_pCheckpoint->IsOpen())
+    {
+        ManagerCheckpoint::Change change(ManagerCheckpoint::CLUSTER_MERGE);
+        change.m_pCluster = pClusterToDelete;
+        change.m_pSecondCluster = pClusterToEnlarge;
+        change.m_listName = deleteListName;
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->MergeAndDetachClusters(pClusterToEnlarge, pClusterToDelete,
+            enlargeListName, deleteListName, change.m_pNextCluster));
+        this->RecordChange(change);
+
+        return STATUS_CODE_SUCCESS;
+    }
+
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->MergeAndDeleteClusters(pClusterToEnlarge, pClusterToDelete,
         enlargeListName, deleteListName));
 
@@ -567,6 +984,20 @@ StatusCode PandoraContentApiImpl::MergeAndDeleteClusters(const Cluster *const pC
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+StatusCode PandoraContentApiImpl::GetCurrentClusterSpatialIndex(const ClusterSpatialIndex *&pClusterSpatialIndex) const
+{
+    return this->GetManager<Cluster>()->GetCurrentListSpatialIndex(pClusterSpatialIndex);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PandoraContentApiImpl::GetCurrentClusterPairFinder(const ClusterPairFinder *&pClusterPairFinder) const
+{
+    return this->GetManager<Cluster>()->GetCurrentListPairFinder(pClusterPairFinder);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 template <typename T>
 StatusCode PandoraContentApiImpl::AddToPfo(const ParticleFlowObject *const pPfo, const T *const pT) const
 {
@@ -576,6 +1007,14 @@ StatusCode PandoraContentApiImpl::AddToPfo(const ParticleFlowObject *const pPfo,
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<ParticleFlowObject>()->AddToPfo(pPfo, pT));
     this->GetManager<T>()->SetAvailability(pT, false);
 
+    if (m_pCheckpoint->IsOpen())
+    {
+        ManagerCheckpoint::Change change(ManagerCheckpoint::PFO_CONTENT_ADDITION);
+        change.m_pPfo = pPfo;
+        change.SetPfoContent(pT);
+        this->RecordChange(change);
+    }
+
     return STATUS_CODE_SUCCESS;
 }
 
@@ -587,6 +1026,14 @@ StatusCode PandoraContentApiImpl::RemoveFromPfo(const ParticleFlowObject *const
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<ParticleFlowObject>()->RemoveFromPfo(pPfo, pT));
     this->GetManager<T>()->SetAvailability(pT, true);
 
+    if (m_pCheckpoint->IsOpen())
+    {
+        ManagerCheckpoint::Change change(ManagerCheckpoint::PFO_CONTENT_REMOVAL);
+        change.m_pPfo = pPfo;
+        change.SetPfoContent(pT);
+        this->RecordChange(change);
+    }
+
     return STATUS_CODE_SUCCESS;
 }
 
@@ -594,28 +1041,64 @@ StatusCode PandoraContentApiImpl::RemoveFromPfo(const ParticleFlowObject *const
 
 StatusCode PandoraContentApiImpl::SetPfoParentDaughterRelationship(const ParticleFlowObject *const pParentPfo, const ParticleFlowObject *const pDaughterPfo) const
 {
-    return this->GetManager<ParticleFlowObject>()->SetParentDaughterAssociation(pParentPfo, pDaughterPfo);
-}
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<ParticleFlowObject>()->SetParentDaughterAssociation(pParentPfo, pDaughterPfo));
+
+    if (m_pCheckpoint->IsOpen())
+    {
+        ManagerCheckpoint::Change change(ManagerCheckpoint::PFO_PARENT_DAUGHTER_ASSOCIATION);
+        change.m_pPfo = pParentPfo;
+        change.m_pSecondPfo = pDaughterPfo;
+        this->RecordChange(change);
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 StatusCode PandoraContentApiImpl::RemovePfoParentDaughterRelationship(const ParticleFlowObject *const pParentPfo, const ParticleFlowObject *const pDaughterPfo) const
 {
-    return this->GetManager<ParticleFlowObject>()->RemoveParentDaughterAssociation(pParentPfo, pDaughterPfo);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<ParticleFlowObject>()->RemoveParentDaughterAssociation(pParentPfo, pDaughterPfo));
+
+    if (m_pCheckpoint->IsOpen())
+    {
+        ManagerCheckpoint::Change change(ManagerCheckpoint::PFO_PARENT_DAUGHTER_DISASSOCIATION);
+        change.m_pPfo = pParentPfo;
+        change.m_pSecondPfo = pDaughterPfo;
+        this->RecordChange(change);
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PandoraContentApiImpl::GetPfoHierarchy(const PfoHierarchy *&pPfoHierarchy) const
+{
+    return this->GetManager<ParticleFlowObject>()->GetPfoHierarchy(pPfoHierarchy);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 PandoraContentApiImpl::PandoraContentApiImpl(Pandora *const pPandora) :
-    m_pPandora(pPandora)
+    m_pPandora(pPandora),
+    m_pCheckpoint(new ManagerCheckpoint),
+    m_algorithmDepth(0)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+PandoraContentApiImpl::~PandoraContentApiImpl()
 {
+    delete m_pCheckpoint;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 bool PandoraContentApiImpl::IsAddToClusterAllowed(const Cluster *const pCluster, const CaloHit *const pCaloHit) const
 {
-    if (!this->GetManager<CaloHit>()->IsAvailable(pCaloHit))
+    if (!this->GetManager<CaloHit>()->IsAvailable(pCaloHit) || (pCaloHit->GetEventId() != pCluster->GetEventId()))
         return false;
 
     if (!m_pPandora->GetSettings()->SingleHitTypeClusteringMode())
@@ -680,18 +1163,9 @@ StatusCode PandoraContentApiImpl::PrepareForDeletion(const PfoList *const pPfoLi
         this->GetManager<Cluster>()->SetAvailability(&pPfo->GetClusterList(), true);
         this->GetManager<Track>()->SetAvailability(&pPfo->GetTrackList(), true);
         this->GetManager<Vertex>()->SetAvailability(&pPfo->GetVertexList(), true);
-
-        const PfoList parentList(pPfo->GetParentPfoList());
-        const PfoList daughterList(pPfo->GetDaughterPfoList());
-
-        for (const ParticleFlowObject *const pParentPfo : parentList)
-            this->RemovePfoParentDaughterRelationship(pParentPfo, pPfo);
-
-        for (const ParticleFlowObject *const pDaughterPfo : daughterList)
-            this->RemovePfoParentDaughterRelationship(pPfo, pDaughterPfo);
     }
 
-    return STATUS_CODE_SUCCESS;
+    return this->GetManager<ParticleFlowObject>()->RemoveAllParentDaughterAssociations(*pPfoList);
 }
 
 template <>
@@ -721,6 +1195,82 @@ StatusCode PandoraContentApiImpl::PrepareForReclusteringDeletion(const ClusterLi
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+template <>
+StatusCode PandoraContentApiImpl::DeleteWithCheckpoint(const ClusterList *const pClusterList, const std::string &listName) const
+{
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->PrepareForDeletion(pClusterList));
+
+    ClusterManager::ObjectVector nextClusterVector;
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->DetachObjects(*pClusterList, listName, nextClusterVector));
+
+    ClusterManager::ObjectVector::const_iterator nextIter(nextClusterVector.begin());
+
+    for (const Cluster *const pCluster : *pClusterList)
+    {
+        ManagerCheckpoint::Change change(ManagerCheckpoint::CLUSTER_DELETION);
+        change.m_pCluster = pCluster;
+        change.m_pNextCluster = *(nextIter++);
+        change.m_listName = listName;
+        this->RecordChange(change);
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
+template <>
+StatusCode PandoraContentApiImpl::DeleteWithCheckpoint(const PfoList *const pPfoList, const std::string &listName) const
+{
+    // ATTN Parent-daughter relationships are removed in preparation for deletion, so must be recorded beforehand
+    ManagerCheckpoint::ChangeVector changeVector;
+
+    for (const ParticleFlowObject *const pPfo : *pPfoList)
+    {
+        ManagerCheckpoint::Change change(ManagerCheckpoint::PFO_DELETION);
+        change.m_pPfo = pPfo;
+        change.m_listName = listName;
+        change.m_parentPfoList = pPfo->GetParentPfoList();
+        change.m_daughterPfoList = pPfo->GetDaughterPfoList();
+        changeVector.push_back(change);
+    }
+
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->PrepareForDeletion(pPfoList));
+
+    ParticleFlowObjectManager::ObjectVector nextPfoVector;
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<ParticleFlowObject>()->DetachObjects(*pPfoList, listName, nextPfoVector));
+
+    for (unsigned int iChange = 0, nChanges = changeVector.size(); iChange < nChanges; ++iChange)
+    {
+        changeVector[iChange].m_pNextPfo = nextPfoVector[iChange];
+        this->RecordChange(changeVector[iChange]);
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
+template <>
+StatusCode PandoraContentApiImpl::DeleteWithCheckpoint(const VertexList *const pVertexList, const std::string &listName) const
+{
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->PrepareForDeletion(pVertexList));
+
+    VertexManager::ObjectVector nextVertexVector;
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Vertex>()->DetachObjects(*pVertexList, listName, nextVertexVector));
+
+    VertexManager::ObjectVector::const_iterator nextIter(nextVertexVector.begin());
+
+    for (const Vertex *const pVertex : *pVertexList)
+    {
+        ManagerCheckpoint::Change change(ManagerCheckpoint::VERTEX_DELETION);
+        change.m_pVertex = pVertex;
+        change.m_pNextVertex = *(nextIter++);
+        change.m_listName = listName;
+        this->RecordChange(change);
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 template <typename T>
 StatusCode PandoraContentApiImpl::Delete(const T *const pT) const
 {
@@ -734,6 +1284,12 @@ StatusCode PandoraContentApiImpl::Delete(const T *const pT) const
 template <typename T>
 StatusCode PandoraContentApiImpl::Delete(const T *const pT, const std::string &listName) const
 {
+    if (m_pCheckpoint->IsOpen())
+    {
+        const MANAGED_CONTAINER<const T *> objectList(1, pT);
+        return this->DeleteWithCheckpoint(&objectList, listName);
+    }
+
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->PrepareForDeletion(pT));
     return this->GetManager<T>()->DeleteObject(pT, listName);
 }
@@ -741,6 +1297,9 @@ StatusCode PandoraContentApiImpl::Delete(const T *const pT, const std::string &l
 template <>
 StatusCode PandoraContentApiImpl::Delete(const ClusterList *const pT, const std::string &listName) const
 {
+    if (m_pCheckpoint->IsOpen())
+        return this->DeleteWithCheckpoint(pT, listName);
+
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->PrepareForDeletion(pT));
     return this->GetManager<ClusterList>()->DeleteObjects(*pT, listName);
 }
@@ -748,6 +1307,9 @@ StatusCode PandoraContentApiImpl::Delete(const ClusterList *const pT, const std:
 template <>
 StatusCode PandoraContentApiImpl::Delete(const PfoList *const pT, const std::string &listName) const
 {
+    if (m_pCheckpoint->IsOpen())
+        return this->DeleteWithCheckpoint(pT, listName);
+
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->PrepareForDeletion(pT));
     return this->GetManager<PfoList>()->DeleteObjects(*pT, listName);
 }
@@ -755,15 +1317,58 @@ StatusCode PandoraContentApiImpl::Delete(const PfoList *const pT, const std::str
 template <>
 StatusCode PandoraContentApiImpl::Delete(const VertexList *const pT, const std::string &listName) const
 {
+    if (m_pCheckpoint->IsOpen())
+        return this->DeleteWithCheckpoint(pT, listName);
+
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->PrepareForDeletion(pT));
     return this->GetManager<VertexList>()->DeleteObjects(*pT, listName);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+StatusCode PandoraContentApiImpl::GetVertexSpatialIndex(const std::string &listName, const VertexSpatialIndex *&pVertexSpatialIndex) const
+{
+    return this->GetManager<Vertex>()->GetListSpatialIndex(listName, pVertexSpatialIndex);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PandoraContentApiImpl::MergeNearbyVertices(const std::string &listName, const float mergeDistance) const
+{
+    VertexList duplicateVertexList;
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Vertex>()->GetDuplicateVertices(listName, mergeDistance, duplicateVertexList));
+
+    if (duplicateVertexList.empty())
+        return STATUS_CODE_SUCCESS;
+
+    return this->Delete(&duplicateVertexList, listName);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PandoraContentApiImpl::GetVertexCaloHitSummaries(const VertexVector &vertexVector, const std::string &caloHitListName,
+    const float summaryRadius, VertexCaloHitSummaryVector &summaryVector) const
+{
+    if (summaryRadius < 0.f)
+        return STATUS_CODE_INVALID_PARAMETER;
+
+    const CaloHitSpatialIndex *pCaloHitSpatialIndex(nullptr);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<CaloHit>()->GetListSpatialIndex(caloHitListName, pCaloHitSpatialIndex));
+
+    summaryVector.assign(vertexVector.size(), VertexCaloHitSummary());
+    const VertexCaloHitSummaryTask vertexCaloHitSummaryTask(vertexVector, *pCaloHitSpatialIndex, summaryRadius, summaryVector);
+
+    return this->GetThreadPool()->ParallelFor(vertexVector.size(), vertexCaloHitSummaryTask, 16);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 StatusCode PandoraContentApiImpl::InitializeFragmentation(const Algorithm &algorithm, const ClusterList &inputClusterList,
     std::string &originalClustersListName, std::string &fragmentClustersListName) const
 {
+    if (m_pCheckpoint->IsOpen())
+        return STATUS_CODE_NOT_ALLOWED;
+
     std::string inputClusterListName;
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->GetAlgorithmInputListName(&algorithm, inputClusterListName));
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->MoveObjectsToTemporaryListAndSetCurrent(&algorithm, inputClusterListName, originalClustersListName, inputClusterList));
@@ -780,9 +1385,13 @@ StatusCode PandoraContentApiImpl::InitializeFragmentation(const Algorithm &algor
 StatusCode PandoraContentApiImpl::EndFragmentation(const Algorithm &algorithm, const std::string &clusterListToSaveName,
     const std::string &clusterListToDeleteName) const
 {
+    if (m_pCheckpoint->IsOpen())
+        return STATUS_CODE_NOT_ALLOWED;
+
     std::string inputClusterListName;
     const ClusterList *pClustersToBeDeleted(nullptr);
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->GetAlgorithmInputListName(&algorithm, inputClusterListName));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->UpdateCaloHitClusterIndex(clusterListToSaveName));
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->SaveObjects(inputClusterListName, clusterListToSaveName));
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->GetList(clusterListToDeleteName, pClustersToBeDeleted));
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->PrepareForReclusteringDeletion(pClustersToBeDeleted));
@@ -800,6 +1409,9 @@ StatusCode PandoraContentApiImpl::EndFragmentation(const Algorithm &algorithm, c
 StatusCode PandoraContentApiImpl::InitializeReclustering(const Algorithm &algorithm, const TrackList &inputTrackList,
     const ClusterList &inputClusterList, std::string &originalClustersListName) const
 {
+    if (m_pCheckpoint->IsOpen())
+        return STATUS_CODE_NOT_ALLOWED;
+
     std::string inputClusterListName;
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->GetAlgorithmInputListName(&algorithm, inputClusterListName));
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->MoveObjectsToTemporaryListAndSetCurrent(&algorithm, inputClusterListName, originalClustersListName, inputClusterList));
@@ -814,9 +1426,13 @@ StatusCode PandoraContentApiImpl::InitializeReclustering(const Algorithm &algori
 
 StatusCode PandoraContentApiImpl::EndReclustering(const Algorithm &algorithm, const std::string &selectedClusterListName) const
 {
+    if (m_pCheckpoint->IsOpen())
+        return STATUS_CODE_NOT_ALLOWED;
+
     std::string inputClusterListName;
     ClusterList clustersToBeDeleted;
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->GetAlgorithmInputListName(&algorithm, inputClusterListName));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->UpdateCaloHitClusterIndex(selectedClusterListName));
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->SaveObjects(inputClusterListName, selectedClusterListName));
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->GetResetDeletionObjects(&algorithm, clustersToBeDeleted));
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->PrepareForReclusteringDeletion(&clustersToBeDeleted));
@@ -832,15 +1448,92 @@ StatusCode PandoraContentApiImpl::EndReclustering(const Algorithm &algorithm, co
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+StatusCode PandoraContentApiImpl::CreateCheckpoint(const Algorithm &algorithm) const
+{
+    if (m_pCheckpoint->IsOpen())
+        return STATUS_CODE_ALREADY_INITIALIZED;
+
+    ManagerCheckpoint::ListState &clusterListState(m_pCheckpoint->m_clusterListState);
+    ManagerCheckpoint::ListState &pfoListState(m_pCheckpoint->m_pfoListState);
+    ManagerCheckpoint::ListState &vertexListState(m_pCheckpoint->m_vertexListState);
+    this->GetManager<Cluster>()->GetCurrentListState(clusterListState.m_currentListName, clusterListState.m_canMakeNewObjects);
+    this->GetManager<ParticleFlowObject>()->GetCurrentListState(pfoListState.m_currentListName, pfoListState.m_canMakeNewObjects);
+    this->GetManager<Vertex>()->GetCurrentListState(vertexListState.m_currentListName, vertexListState.m_canMakeNewObjects);
+
+    m_pCheckpoint->Open(&algorithm);
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PandoraContentApiImpl::RollbackToCheckpoint(const Algorithm &algorithm) const
+{
+    if (!m_pCheckpoint->IsOpen())
+        return STATUS_CODE_NOT_INITIALIZED;
+
+    if (&algorithm != m_pCheckpoint->GetAlgorithm())
+        return STATUS_CODE_NOT_ALLOWED;
+
+    // ATTN Forget each change once reverted, so that a failed rollback leaves only the changes still in effect
+    ManagerCheckpoint::ChangeVector &changeVector(m_pCheckpoint->m_changeVector);
+
+    while (!changeVector.empty())
+    {
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->RevertChange(changeVector.back()));
+        changeVector.pop_back();
+    }
+
+    const ManagerCheckpoint::ListState &clusterListState(m_pCheckpoint->m_clusterListState);
+    const ManagerCheckpoint::ListState &pfoListState(m_pCheckpoint->m_pfoListState);
+    const ManagerCheckpoint::ListState &vertexListState(m_pCheckpoint->m_vertexListState);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->RestoreCurrentListState(clusterListState.m_currentListName,
+        clusterListState.m_canMakeNewObjects));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<ParticleFlowObject>()->RestoreCurrentListState(pfoListState.m_currentListName,
+        pfoListState.m_canMakeNewObjects));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Vertex>()->RestoreCurrentListState(vertexListState.m_currentListName,
+        vertexListState.m_canMakeNewObjects));
+
+    m_pCheckpoint->Close();
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PandoraContentApiImpl::ReleaseCheckpoint(const Algorithm &algorithm) const
+{
+    if (!m_pCheckpoint->IsOpen())
+        return STATUS_CODE_NOT_INITIALIZED;
+
+    if (&algorithm != m_pCheckpoint->GetAlgorithm())
+        return STATUS_CODE_NOT_ALLOWED;
+
+    return this->ReleaseCheckpoint();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 StatusCode PandoraContentApiImpl::PreRunAlgorithm(Algorithm *const pAlgorithm) const
 {
-    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<CaloHit>()->RegisterAlgorithm(pAlgorithm));
-    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->RegisterAlgorithm(pAlgorithm));
-    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<MCParticle>()->RegisterAlgorithm(pAlgorithm));
-    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<ParticleFlowObject>()->RegisterAlgorithm(pAlgorithm));
-    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Track>()->RegisterAlgorithm(pAlgorithm));
-    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Vertex>()->RegisterAlgorithm(pAlgorithm));
+    // ATTN Only the managers for the object types declared by the algorithm track its run
+    if (pAlgorithm->UsesObjectType(Algorithm::CALO_HIT_OBJECTS))
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<CaloHit>()->RegisterAlgorithm(pAlgorithm));
+
+    if (pAlgorithm->UsesObjectType(Algorithm::CLUSTER_OBJECTS))
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->RegisterAlgorithm(pAlgorithm));
+
+    if (pAlgorithm->UsesObjectType(Algorithm::MC_PARTICLE_OBJECTS))
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<MCParticle>()->RegisterAlgorithm(pAlgorithm));
+
+    if (pAlgorithm->UsesObjectType(Algorithm::PFO_OBJECTS))
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<ParticleFlowObject>()->RegisterAlgorithm(pAlgorithm));
+
+    if (pAlgorithm->UsesObjectType(Algorithm::TRACK_OBJECTS))
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Track>()->RegisterAlgorithm(pAlgorithm));
+
+    if (pAlgorithm->UsesObjectType(Algorithm::VERTEX_OBJECTS))
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Vertex>()->RegisterAlgorithm(pAlgorithm));
 
+    ++m_algorithmDepth;
     return STATUS_CODE_SUCCESS;
 }
 
@@ -848,24 +1541,302 @@ StatusCode PandoraContentApiImpl::PreRunAlgorithm(Algorithm *const pAlgorithm) c
 
 StatusCode PandoraContentApiImpl::PostRunAlgorithm(Algorithm *const pAlgorithm) const
 {
-    PfoList pfosToBeDeleted;
-    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<ParticleFlowObject>()->GetResetDeletionObjects(pAlgorithm, pfosToBeDeleted));
-    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->PrepareForDeletion(&pfosToBeDeleted));
+    --m_algorithmDepth;
 
-    ClusterList clustersToBeDeleted;
-    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->GetResetDeletionObjects(pAlgorithm, clustersToBeDeleted));
-    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->PrepareForDeletion(&clustersToBeDeleted));
+    if (m_pCheckpoint->IsOpen())
+    {
+        std::cout << "Algorithm " << pAlgorithm->GetInstanceName() << ", " << pAlgorithm->GetType()
+                  << " did not roll back or release its checkpoint, changes will be kept" << std::endl;
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReleaseCheckpoint());
+    }
+
+    if (m_pPandora->GetSettings()->ShouldRecordMemoryUsage())
+    {
+        // ATTN Sampled before the temporary lists and objects of the algorithm are removed, so these contribute to the high-water marks
+        this->GetManager<CaloHit>()->UpdatePeakMemoryUsage(pAlgorithm);
+        this->GetManager<Cluster>()->UpdatePeakMemoryUsage(pAlgorithm);
+        this->GetManager<MCParticle>()->UpdatePeakMemoryUsage(pAlgorithm);
+        this->GetManager<ParticleFlowObject>()->UpdatePeakMemoryUsage(pAlgorithm);
+        this->GetManager<Track>()->UpdatePeakMemoryUsage(pAlgorithm);
+        this->GetManager<Vertex>()->UpdatePeakMemoryUsage(pAlgorithm);
+    }
+
+    if (pAlgorithm->UsesObjectType(Algorithm::PFO_OBJECTS))
+    {
+        PfoList pfosToBeDeleted;
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<ParticleFlowObject>()->GetResetDeletionObjects(pAlgorithm, pfosToBeDeleted));
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->PrepareForDeletion(&pfosToBeDeleted));
+    }
+
+    if (pAlgorithm->UsesObjectType(Algorithm::CLUSTER_OBJECTS))
+    {
+        ClusterList clustersToBeDeleted;
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->GetResetDeletionObjects(pAlgorithm, clustersToBeDeleted));
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->PrepareForDeletion(&clustersToBeDeleted));
+    }
+
+    if (pAlgorithm->UsesObjectType(Algorithm::VERTEX_OBJECTS))
+    {
+        VertexList verticesToBeDeleted;
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Vertex>()->GetResetDeletionObjects(pAlgorithm, verticesToBeDeleted));
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->PrepareForDeletion(&verticesToBeDeleted));
+    }
+
+    if (pAlgorithm->UsesObjectType(Algorithm::CALO_HIT_OBJECTS))
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<CaloHit>()->ResetAlgorithmInfo(pAlgorithm, true));
+
+    if (pAlgorithm->UsesObjectType(Algorithm::CLUSTER_OBJECTS))
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->ResetAlgorithmInfo(pAlgorithm, true));
+
+    if (pAlgorithm->UsesObjectType(Algorithm::MC_PARTICLE_OBJECTS))
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<MCParticle>()->ResetAlgorithmInfo(pAlgorithm, true));
+
+    if (pAlgorithm->UsesObjectType(Algorithm::PFO_OBJECTS))
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<ParticleFlowObject>()->ResetAlgorithmInfo(pAlgorithm, true));
+
+    if (pAlgorithm->UsesObjectType(Algorithm::TRACK_OBJECTS))
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Track>()->ResetAlgorithmInfo(pAlgorithm, true));
+
+    if (pAlgorithm->UsesObjectType(Algorithm::VERTEX_OBJECTS))
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Vertex>()->ResetAlgorithmInfo(pAlgorithm, true));
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool PandoraContentApiImpl::IsObjectBudgetExceeded() const
+{
+    return (this->GetManager<CaloHit>()->IsObjectBudgetExceeded() || this->GetManager<Cluster>()->IsObjectBudgetExceeded() ||
+        this->GetManager<MCParticle>()->IsObjectBudgetExceeded() || this->GetManager<ParticleFlowObject>()->IsObjectBudgetExceeded() ||
+        this->GetManager<Track>()->IsObjectBudgetExceeded() || this->GetManager<Vertex>()->IsObjectBudgetExceeded());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void PandoraContentApiImpl::RecordChange(const ManagerCheckpoint::Change &change) const
+{
+    m_pCheckpoint->m_changeVector.push_back(change);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PandoraContentApiImpl::RevertChange(const ManagerCheckpoint::Change &change) const
+{
+    switch (change.m_changeType)
+    {
+    case ManagerCheckpoint::CLUSTER_CREATION:
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->PrepareForDeletion(change.m_pCluster));
+        return this->GetManager<Cluster>()->DeleteObject(change.m_pCluster, change.m_listName);
+
+    case ManagerCheckpoint::PFO_CREATION:
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->PrepareForDeletion(change.m_pPfo));
+        return this->GetManager<ParticleFlowObject>()->DeleteObject(change.m_pPfo, change.m_listName);
+
+    case ManagerCheckpoint::VERTEX_CREATION:
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->PrepareForDeletion(change.m_pVertex));
+        return this->GetManager<Vertex>()->DeleteObject(change.m_pVertex, change.m_listName);
+
+    case ManagerCheckpoint::CLUSTER_DELETION:
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->ReattachObject(change.m_pCluster, change.m_listName,
+            change.m_pNextCluster));
+        return this->RestoreDetachedCluster(change.m_pCluster, true);
+
+    case ManagerCheckpoint::PFO_DELETION:
+    {
+        const ParticleFlowObject *const pPfo(change.m_pPfo);
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<ParticleFlowObject>()->ReattachObject(pPfo, change.m_listName,
+            change.m_pNextPfo));
+        this->GetManager<ParticleFlowObject>()->m_isPfoHierarchyValid = false;
+        this->GetManager<Cluster>()->SetAvailability(&pPfo->GetClusterList(), false);
+        this->GetManager<Track>()->SetAvailability(&pPfo->GetTrackList(), false);
+        this->GetManager<Vertex>()->SetAvailability(&pPfo->GetVertexList(), false);
+
+        // ATTN Relationships between pfos deleted together are restored with the first of the pair to be reattached
+        for (const ParticleFlowObject *const pParentPfo : change.m_parentPfoList)
+        {
+            if (pPfo->GetParentPfoList().end() == std::find(pPfo->GetParentPfoList().begin(), pPfo->GetParentPfoList().end(), pParentPfo))
+                PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<ParticleFlowObject>()->SetParentDaughterAssociation(pParentPfo, pPfo));
+        }
+
+        for (const ParticleFlowObject *const pDaughterPfo : change.m_daughterPfoList)
+        {
+            if (pPfo->GetDaughterPfoList().end() == std::find(pPfo->GetDaughterPfoList().begin(), pPfo->GetDaughterPfoList().end(), pDaughterPfo))
+                PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<ParticleFlowObject>()->SetParentDaughterAssociation(pPfo, pDaughterPfo));
+        }
+
+        return STATUS_CODE_SUCCESS;
+    }
+
+    case ManagerCheckpoint::VERTEX_DELETION:
+        return this->GetManager<Vertex>()->ReattachObject(change.m_pVertex, change.m_listName, change.m_pNextVertex);
+
+    case ManagerCheckpoint::CLUSTER_MERGE:
+    {
+        CaloHitList caloHitList;
+        change.m_pCluster->GetOrderedCaloHitList().FillCaloHitList(caloHitList);
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->RemoveCaloHits(change.m_pSecondCluster, caloHitList,
+            change.m_pCluster->GetIsolatedCaloHitList()));
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->ReattachObject(change.m_pCluster, change.m_listName,
+            change.m_pNextCluster));
+        return this->RestoreDetachedCluster(change.m_pCluster, false);
+    }
+
+    case ManagerCheckpoint::CALO_HIT_ADDITION:
+    {
+        const CaloHitList caloHitList(1, change.m_pCaloHit);
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->RemoveCaloHits(change.m_pCluster, caloHitList, CaloHitList()));
+        return this->GetManager<CaloHit>()->SetAvailability(change.m_pCaloHit, true);
+    }
+
+    case ManagerCheckpoint::CALO_HIT_REMOVAL:
+    {
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->AddToCluster(change.m_pCluster, change.m_pCaloHit));
+
+        for (const CaloHit *const pCaloHit : change.m_isolatedCaloHitList)
+            PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->AddIsolatedToCluster(change.m_pCluster, pCaloHit));
+
+        return this->GetManager<CaloHit>()->SetAvailability(change.m_pCaloHit, false);
+    }
+
+    case ManagerCheckpoint::ISOLATED_CALO_HIT_ADDITION:
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->RemoveIsolatedFromCluster(change.m_pCluster, change.m_pCaloHit));
+        return this->GetManager<CaloHit>()->SetAvailability(change.m_pCaloHit, true);
+
+    case ManagerCheckpoint::ISOLATED_CALO_HIT_REMOVAL:
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->AddIsolatedToCluster(change.m_pCluster, change.m_pCaloHit));
+        return this->GetManager<CaloHit>()->SetAvailability(change.m_pCaloHit, false);
+
+    case ManagerCheckpoint::TRACK_CLUSTER_ASSOCIATION:
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Track>()->RemoveAssociatedCluster(change.m_pTrack, change.m_pCluster));
+        return this->GetManager<Cluster>()->RemoveTrackAssociation(change.m_pCluster, change.m_pTrack);
 
-    VertexList verticesToBeDeleted;
-    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Vertex>()->GetResetDeletionObjects(pAlgorithm, verticesToBeDeleted));
-    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->PrepareForDeletion(&verticesToBeDeleted));
+    case ManagerCheckpoint::TRACK_CLUSTER_DISASSOCIATION:
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Track>()->SetAssociatedCluster(change.m_pTrack, change.m_pCluster));
+        return this->GetManager<Cluster>()->AddTrackAssociation(change.m_pCluster, change.m_pTrack);
 
-    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<CaloHit>()->ResetAlgorithmInfo(pAlgorithm, true));
-    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Cluster>()->ResetAlgorithmInfo(pAlgorithm, true));
-    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<MCParticle>()->ResetAlgorithmInfo(pAlgorithm, true));
-    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<ParticleFlowObject>()->ResetAlgorithmInfo(pAlgorithm, true));
-    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Track>()->ResetAlgorithmInfo(pAlgorithm, true));
-    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Vertex>()->ResetAlgorithmInfo(pAlgorithm, true));
+    case ManagerCheckpoint::PFO_CONTENT_ADDITION:
+    case ManagerCheckpoint::PFO_CONTENT_REMOVAL:
+    {
+        const bool isAddition(ManagerCheckpoint::PFO_CONTENT_ADDITION == change.m_changeType);
+
+        if (change.m_pCluster)
+            return this->RevertPfoContentChange(change.m_pPfo, change.m_pCluster, isAddition);
+
+        if (change.m_pTrack)
+            return this->RevertPfoContentChange(change.m_pPfo, change.m_pTrack, isAddition);
+
+        return this->RevertPfoContentChange(change.m_pPfo, change.m_pVertex, isAddition);
+    }
+
+    case ManagerCheckpoint::PFO_PARENT_DAUGHTER_ASSOCIATION:
+        return this->GetManager<ParticleFlowObject>()->RemoveParentDaughterAssociation(change.m_pPfo, change.m_pSecondPfo);
+
+    case ManagerCheckpoint::PFO_PARENT_DAUGHTER_DISASSOCIATION:
+        return this->GetManager<ParticleFlowObject>()->SetParentDaughterAssociation(change.m_pPfo, change.m_pSecondPfo);
+    }
+
+    return STATUS_CODE_FAILURE;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+StatusCode PandoraContentApiImpl::RevertPfoContentChange(const ParticleFlowObject *const pPfo, const T *const pT, const bool isAddition) const
+{
+    if (isAddition)
+    {
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<ParticleFlowObject>()->RemoveFromPfo(pPfo, pT));
+        this->GetManager<T>()->SetAvailability(pT, true);
+    }
+    else
+    {
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<ParticleFlowObject>()->AddToPfo(pPfo, pT));
+        this->GetManager<T>()->SetAvailability(pT, false);
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PandoraContentApiImpl::RestoreDetachedCluster(const Cluster *const pCluster, const bool restoreCaloHitAvailability) const
+{
+    if (restoreCaloHitAvailability)
+    {
+        CaloHitList caloHitList;
+        pCluster->GetOrderedCaloHitList().FillCaloHitList(caloHitList);
+        caloHitList.insert(caloHitList.end(), pCluster->GetIsolatedCaloHitList().begin(), pCluster->GetIsolatedCaloHitList().end());
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<CaloHit>()->SetAvailability(&caloHitList, false));
+    }
+
+    for (const Track *const pTrack : pCluster->GetAssociatedTrackList())
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetManager<Track>()->SetAssociatedCluster(pTrack, pCluster));
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PandoraContentApiImpl::ReleaseCheckpoint() const
+{
+    for (const ManagerCheckpoint::Change &change : m_pCheckpoint->m_changeVector)
+    {
+        if ((ManagerCheckpoint::CLUSTER_DELETION == change.m_changeType) || (ManagerCheckpoint::CLUSTER_MERGE == change.m_changeType))
+        {
+            this->GetManager<Cluster>()->DestroyDetachedObject(change.m_pCluster);
+        }
+        else if (ManagerCheckpoint::PFO_DELETION == change.m_changeType)
+        {
+            this->GetManager<ParticleFlowObject>()->DestroyDetachedObject(change.m_pPfo);
+        }
+        else if (ManagerCheckpoint::VERTEX_DELETION == change.m_changeType)
+        {
+            this->GetManager<Vertex>()->DestroyDetachedObject(change.m_pVertex);
+        }
+    }
+
+    m_pCheckpoint->Close();
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+PandoraContentApiImpl::VertexCaloHitSummaryTask::VertexCaloHitSummaryTask(const VertexVector &vertexVector,
+        const CaloHitSpatialIndex &caloHitSpatialIndex, const float summaryRadius, VertexCaloHitSummaryVector &summaryVector) :
+    m_vertexVector(vertexVector),
+    m_caloHitSpatialIndex(caloHitSpatialIndex),
+    m_summaryRadius(summaryRadius),
+    m_summaryVector(summaryVector)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PandoraContentApiImpl::VertexCaloHitSummaryTask::Run(const unsigned int index) const
+{
+    const Vertex *const pVertex(m_vertexVector.at(index));
+    const CartesianVector &vertexPosition(pVertex->GetPosition());
+    VertexCaloHitSummary &summary(m_summaryVector.at(index));
+
+    CaloHitSpatialIndex::ObjectVector nearbyCaloHits;
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_caloHitSpatialIndex.FindWithinRadius(vertexPosition, m_summaryRadius, nearbyCaloHits));
+
+    for (const CaloHit *const pCaloHit : nearbyCaloHits)
+    {
+        ++summary.m_nCaloHits;
+        summary.m_inputEnergySum += pCaloHit->GetInputEnergy();
+        summary.m_distanceSum += (pCaloHit->GetPositionVector() - vertexPosition).GetMagnitude();
+    }
+
+    // ATTN An empty calo hit list leaves the nearest distance at its default, maximum value
+    const CaloHit *pNearestCaloHit(nullptr);
+    float nearestDistance(std::numeric_limits<float>::max());
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, m_caloHitSpatialIndex.FindNearest(vertexPosition, pNearestCaloHit, nearestDistance));
+
+    if (pNearestCaloHit)
+        summary.m_nearestDistance = nearestDistance;
 
     return STATUS_CODE_SUCCESS;
 }
@@ -893,6 +1864,12 @@ template StatusCode PandoraContentApiImpl::GetCurrentList<MCParticleList>(const
 template StatusCode PandoraContentApiImpl::GetCurrentList<ClusterList>(const ClusterList *&, std::string &) const;
 template StatusCode PandoraContentApiImpl::GetCurrentList<PfoList>(const PfoList *&, std::string &) const;
 template StatusCode PandoraContentApiImpl::GetCurrentList<VertexList>(const VertexList *&, std::string &) const;
+template StatusCode PandoraContentApiImpl::GetCurrentList<CaloHitList>(const CaloHitList *&) const;
+template StatusCode PandoraContentApiImpl::GetCurrentList<TrackList>(const TrackList *&) const;
+template StatusCode PandoraContentApiImpl::GetCurrentList<MCParticleList>(const MCParticleList *&) const;
+template StatusCode PandoraContentApiImpl::GetCurrentList<ClusterList>(const ClusterList *&) const;
+template StatusCode PandoraContentApiImpl::GetCurrentList<PfoList>(const PfoList *&) const;
+template StatusCode PandoraContentApiImpl::GetCurrentList<VertexList>(const VertexList *&) const;
 
 template StatusCode PandoraContentApiImpl::GetCurrentListName<CaloHit>(std::string &) const;
 template StatusCode PandoraContentApiImpl::GetCurrentListName<Track>(std::string &) const;
@@ -901,6 +1878,13 @@ template StatusCode PandoraContentApiImpl::GetCurrentListName<Cluster>(std::stri
 template StatusCode PandoraContentApiImpl::GetCurrentListName<ParticleFlowObject>(std::string &) const;
 template StatusCode PandoraContentApiImpl::GetCurrentListName<Vertex>(std::string &) const;
 
+template StatusCode PandoraContentApiImpl::GetIndexUpperBound<CaloHit>(unsigned int &) const;
+template StatusCode PandoraContentApiImpl::GetIndexUpperBound<Track>(unsigned int &) const;
+template StatusCode PandoraContentApiImpl::GetIndexUpperBound<MCParticle>(unsigned int &) const;
+template StatusCode PandoraContentApiImpl::GetIndexUpperBound<Cluster>(unsigned int &) const;
+template StatusCode PandoraContentApiImpl::GetIndexUpperBound<ParticleFlowObject>(unsigned int &) const;
+template StatusCode PandoraContentApiImpl::GetIndexUpperBound<Vertex>(unsigned int &) const;
+
 template StatusCode PandoraContentApiImpl::ReplaceCurrentList<CaloHit>(const Algorithm &, const std::string &) const;
 template StatusCode PandoraContentApiImpl::ReplaceCurrentList<Track>(const Algorithm &, const std::string &) const;
 template StatusCode PandoraContentApiImpl::ReplaceCurrentList<MCParticle>(const Algorithm &, const std::string &) const;
@@ -101,14 +101,17 @@ ConcentricGap::ConcentricGap(const object_creation::Geometry::ConcentricGap::Par
     m_innerSymmetryOrder(parameters.m_innerSymmetryOrder.Get()),
     m_outerRCoordinate(parameters.m_outerRCoordinate.Get()),
     m_outerPhiCoordinate(parameters.m_outerPhiCoordinate.Get()),
-    m_outerSymmetryOrder(parameters.m_outerSymmetryOrder.Get())
+    m_outerSymmetryOrder(parameters.m_outerSymmetryOrder.Get()),
+    m_outerRMax(0.f)
 {
     if ((0 == m_innerSymmetryOrder) || (0 == m_outerSymmetryOrder))
         throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
 
-    const float centralZCoordinate(0.5f * (m_maxZCoordinate + m_minZCoordinate));
-    this->GetPolygonVertices(m_innerRCoordinate, centralZCoordinate, m_innerPhiCoordinate, m_innerSymmetryOrder, m_innerVertexPointList);
-    this->GetPolygonVertices(m_outerRCoordinate, centralZCoordinate, m_outerPhiCoordinate, m_outerSymmetryOrder, m_outerVertexPointList);
+    static const float pi(std::acos(-1.f));
+    m_outerRMax = m_outerRCoordinate / std::cos(pi / static_cast<float>(m_outerSymmetryOrder));
+
+    this->GetEdgeNormals(m_innerPhiCoordinate, m_innerSymmetryOrder, m_innerNormalXVector, m_innerNormalYVector);
+    this->GetEdgeNormals(m_outerPhiCoordinate, m_outerSymmetryOrder, m_outerNormalXVector, m_outerNormalYVector);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -130,15 +133,13 @@ bool ConcentricGap::IsInGap(const CartesianVector &positionVector, const HitType
     if (r < m_innerRCoordinate)
         return false;
 
-    static const float pi(std::acos(-1.f));
-
-    if (r > m_outerRCoordinate / std::cos(pi / static_cast<float>(m_outerSymmetryOrder)))
+    if (r > m_outerRMax)
         return false;
 
-    if (!this->IsIn2DPolygon(positionVector, m_outerVertexPointList, m_outerSymmetryOrder))
+    if (!this->IsIn2DPolygon(x, y, m_outerRCoordinate, m_outerNormalXVector, m_outerNormalYVector))
         return false;
 
-    if (this->IsIn2DPolygon(positionVector, m_innerVertexPointList, m_innerSymmetryOrder))
+    if (this->IsIn2DPolygon(x, y, m_innerRCoordinate, m_innerNormalXVector, m_innerNormalYVector))
         return false;
 
     return true;
@@ -146,63 +147,41 @@ bool ConcentricGap::IsInGap(const CartesianVector &positionVector, const HitType
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-void ConcentricGap::GetPolygonVertices(const float rCoordinate, const float zCoordinate, const float phiCoordinate,
-    const unsigned int symmetryOrder, VertexPointList &vertexPointList) const
+void ConcentricGap::GetEdgeNormals(const float phiCoordinate, const unsigned int symmetryOrder, FloatVector &normalXVector,
+    FloatVector &normalYVector) const
 {
     if (0 == symmetryOrder)
         throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
 
+    // Vertices lie at angles phiCoordinate + (2i + 1) pi / symmetryOrder, measured from the y axis, so edge midpoints lie at
+    // phiCoordinate + 2i pi / symmetryOrder
     static const float pi(std::acos(-1.f));
-    const float firstVertexAngle(pi / static_cast<float>(symmetryOrder));
-    const float rMax(rCoordinate / std::cos(firstVertexAngle));
 
-    for (unsigned int i = 0; i < symmetryOrder + 1; ++i)
+    for (unsigned int i = 0; i < symmetryOrder; ++i)
     {
-        const float phi = phiCoordinate + firstVertexAngle + (2.f * pi * static_cast<float>(i) / static_cast<float>(symmetryOrder));
-        const float sinPhi(std::sin(phi));
-        const float cosPhi(std::cos(phi));
-        vertexPointList.push_back(CartesianVector(sinPhi * rMax, cosPhi * rMax, zCoordinate));
+        const float phi(phiCoordinate + (2.f * pi * static_cast<float>(i) / static_cast<float>(symmetryOrder)));
+        normalXVector.push_back(std::sin(phi));
+        normalYVector.push_back(std::cos(phi));
     }
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-bool ConcentricGap::IsIn2DPolygon(const CartesianVector &point, const VertexPointList &vertexPointList, const unsigned int symmetryOrder) const
+bool ConcentricGap::IsIn2DPolygon(const float x, const float y, const float rCoordinate, const FloatVector &normalXVector,
+    const FloatVector &normalYVector) const
 {
-    if (vertexPointList.size() != (symmetryOrder + 1))
-        throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
+    const unsigned int nEdges(normalXVector.size());
 
-    int windingNumber(0);
+    if (nEdges < 3)
+        return false;
 
-    for (unsigned int i = 0; i < symmetryOrder; ++i)
+    for (unsigned int i = 0; i < nEdges; ++i)
     {
-        if (vertexPointList[i].GetY() <= point.GetY())
-        {
-            if (vertexPointList[i + 1].GetY() > point.GetY())
-            {
-                // If point is left of edge, identify an upward crossing
-                if (((vertexPointList[i + 1].GetX() - vertexPointList[i].GetX()) * (point.GetY() - vertexPointList[i].GetY()) -
-                     (point.GetX() - vertexPointList[i].GetX()) * (vertexPointList[i + 1].GetY() - vertexPointList[i].GetY()) ) > 0.f)
-                {
-                    ++windingNumber;
-                }
-            }
-        }
-        else
-        {
-            if (vertexPointList[i + 1].GetY() <= point.GetY())
-            {
-                // If point is right of edge, identify a downward crossing
-                if (((vertexPointList[i + 1].GetX() - vertexPointList[i].GetX()) * (point.GetY() - vertexPointList[i].GetY()) -
-                     (point.GetX() - vertexPointList[i].GetX()) * (vertexPointList[i + 1].GetY() - vertexPointList[i].GetY()) ) < 0.f)
-                {
-                    --windingNumber;
-                }
-            }
-        }
+        if (x * normalXVector[i] + y * normalYVector[i] >= rCoordinate)
+            return false;
     }
 
-    return (0 != windingNumber);
+    return true;
 }
 
 } // namespace pandora
@@ -0,0 +1,490 @@
+/**
+ *  @file   PandoraSDK/src/Geometry/DetectorGapIndex.cc
+ *
+ *  @brief  Implementation of the detector gap index class.
+ *
+ *  $Log: $
+ */
+
+#include "Geometry/DetectorGap.h"
+#include "Geometry/DetectorGapIndex.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace pandora
+{
+
+DetectorGapIndex::DetectorGapIndex() :
+    m_maxToleranceScale(0.f)
+{
+    this->Clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool DetectorGapIndex::IsInGap(const CartesianVector &positionVector, const HitType hitType, const float gapTolerance) const
+{
+    if (TPC_VIEW_U == hitType)
+        return (m_wireGapIntervalsU.Contains(positionVector.GetZ(), gapTolerance) || m_driftGapIntervals.Contains(positionVector.GetX(), gapTolerance));
+
+    if (TPC_VIEW_V == hitType)
+        return (m_wireGapIntervalsV.Contains(positionVector.GetZ(), gapTolerance) || m_driftGapIntervals.Contains(positionVector.GetX(), gapTolerance));
+
+    if (TPC_VIEW_W == hitType)
+        return (m_wireGapIntervalsW.Contains(positionVector.GetZ(), gapTolerance) || m_driftGapIntervals.Contains(positionVector.GetX(), gapTolerance));
+
+    if ((TPC_3D == hitType) && m_driftGapIntervals.Contains(positionVector.GetX(), gapTolerance))
+        return true;
+
+    return this->IsInBoundedGap(positionVector, hitType, gapTolerance);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void DetectorGapIndex::IntervalList::Add(const float start, const float end)
+{
+    const unsigned int index(std::upper_bound(m_startVector.begin(), m_startVector.end(), start) - m_startVector.begin());
+
+    // Find the range of existing intervals, [firstIndex, lastIndex), that touch or overlap the new interval
+    const unsigned int firstIndex(((index > 0) && (m_endVector[index - 1] >= start)) ? index - 1 : index);
+    unsigned int lastIndex(index);
+
+    while ((lastIndex < m_startVector.size()) && (m_startVector[lastIndex] <= end))
+        ++lastIndex;
+
+    if (firstIndex == lastIndex)
+    {
+        m_startVector.insert(m_startVector.begin() + index, start);
+        m_endVector.insert(m_endVector.begin() + index, end);
+        return;
+    }
+
+    m_startVector[firstIndex] = std::min(start, m_startVector[firstIndex]);
+    m_endVector[firstIndex] = std::max(end, m_endVector[lastIndex - 1]);
+    m_startVector.erase(m_startVector.begin() + firstIndex + 1, m_startVector.begin() + lastIndex);
+    m_endVector.erase(m_endVector.begin() + firstIndex + 1, m_endVector.begin() + lastIndex);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool DetectorGapIndex::IntervalList::Contains(const float coordinate, const float gapTolerance) const
+{
+    // ATTN Shifting by the tolerance preserves the start ordering, so the intervals starting below the coordinate form a prefix, and
+    // the intervals are disjoint, so the last in the prefix has the largest end coordinate
+    unsigned int low(0), high(m_startVector.size());
+
+    while (low < high)
+    {
+        const unsigned int middle(low + (high - low) / 2);
+
+        if (coordinate > m_startVector[middle] - gapTolerance)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    return ((low > 0) && (coordinate < m_endVector[low - 1] + gapTolerance));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void DetectorGapIndex::IntervalList::Clear()
+{
+    m_startVector.clear();
+    m_endVector.clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void DetectorGapIndex::Add(const LineGap *const pLineGap)
+{
+    switch (pLineGap->GetLineGapType())
+    {
+    case TPC_WIRE_GAP_VIEW_U:
+        m_wireGapIntervalsU.Add(pLineGap->GetLineStartZ(), pLineGap->GetLineEndZ());
+        break;
+    case TPC_WIRE_GAP_VIEW_V:
+        m_wireGapIntervalsV.Add(pLineGap->GetLineStartZ(), pLineGap->GetLineEndZ());
+        break;
+    case TPC_WIRE_GAP_VIEW_W:
+        m_wireGapIntervalsW.Add(pLineGap->GetLineStartZ(), pLineGap->GetLineEndZ());
+        break;
+    case TPC_DRIFT_GAP:
+        m_driftGapIntervals.Add(pLineGap->GetLineStartX(), pLineGap->GetLineEndX());
+        break;
+    default:
+        throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void DetectorGapIndex::Add(const BoxGap *const pBoxGap)
+{
+    this->AddBoundedGap(pBoxGap);
+    this->BuildGrid();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void DetectorGapIndex::Add(const ConcentricGap *const pConcentricGap)
+{
+    this->AddBoundedGap(pConcentricGap);
+    this->BuildGrid();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void DetectorGapIndex::Add(const std::vector<const LineGap*> &lineGapVector)
+{
+    for (const LineGap *const pLineGap : lineGapVector)
+    {
+        const LineGapType lineGapType(pLineGap->GetLineGapType());
+
+        if ((TPC_WIRE_GAP_VIEW_U != lineGapType) && (TPC_WIRE_GAP_VIEW_V != lineGapType) && (TPC_WIRE_GAP_VIEW_W != lineGapType) &&
+            (TPC_DRIFT_GAP != lineGapType))
+        {
+            throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
+        }
+    }
+
+    // ATTN Coalescing is independent of the order in which intervals are added, but ascending order avoids moving existing intervals
+    std::vector<const LineGap*> sortedLineGapVector(lineGapVector);
+    std::stable_sort(sortedLineGapVector.begin(), sortedLineGapVector.end(), [](const LineGap *const pLhs, const LineGap *const pRhs)
+    {
+        const float lhsStart((TPC_DRIFT_GAP == pLhs->GetLineGapType()) ? pLhs->GetLineStartX() : pLhs->GetLineStartZ());
+        const float rhsStart((TPC_DRIFT_GAP == pRhs->GetLineGapType()) ? pRhs->GetLineStartX() : pRhs->GetLineStartZ());
+        return (lhsStart < rhsStart);
+    });
+
+    for (const LineGap *const pLineGap : sortedLineGapVector)
+        this->Add(pLineGap);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void DetectorGapIndex::Add(const std::vector<const BoxGap*> &boxGapVector)
+{
+    for (const BoxGap *const pBoxGap : boxGapVector)
+        this->AddBoundedGap(pBoxGap);
+
+    this->BuildGrid();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void DetectorGapIndex::Add(const std::vector<const ConcentricGap*> &concentricGapVector)
+{
+    for (const ConcentricGap *const pConcentricGap : concentricGapVector)
+        this->AddBoundedGap(pConcentricGap);
+
+    this->BuildGrid();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void DetectorGapIndex::AddBoundedGap(const BoxGap *const pBoxGap)
+{
+    BoundedGap boundedGap;
+    boundedGap.m_pDetectorGap = pBoxGap;
+
+    try
+    {
+        // The gap accepts positions whose projections onto the unit side vectors lie within the side lengths, a parallelepiped whose
+        // corners are found by inverting the matrix of unit side vectors
+        const CartesianVector unit1(pBoxGap->GetSide1().GetUnitVector());
+        const CartesianVector unit2(pBoxGap->GetSide2().GetUnitVector());
+        const CartesianVector unit3(pBoxGap->GetSide3().GetUnitVector());
+        const float determinant(unit1.GetDotProduct(unit2.GetCrossProduct(unit3)));
+
+        if (std::fabs(determinant) < 1.e-3f)
+            throw StatusCodeException(STATUS_CODE_OUT_OF_RANGE);
+
+        const CartesianVector columns[3] = {unit2.GetCrossProduct(unit3) * (1.f / determinant), unit3.GetCrossProduct(unit1) * (1.f / determinant),
+            unit1.GetCrossProduct(unit2) * (1.f / determinant)};
+        const float lengths[3] = {pBoxGap->GetSide1().GetMagnitude(), pBoxGap->GetSide2().GetMagnitude(), pBoxGap->GetSide3().GetMagnitude()};
+        const float vertex[3] = {pBoxGap->GetVertex().GetX(), pBoxGap->GetVertex().GetY(), pBoxGap->GetVertex().GetZ()};
+
+        for (unsigned int axis = 0; axis < 3; ++axis)
+        {
+            boundedGap.m_min[axis] = vertex[axis];
+            boundedGap.m_max[axis] = vertex[axis];
+            boundedGap.m_toleranceScale[axis] = 0.f;
+
+            for (unsigned int side = 0; side < 3; ++side)
+            {
+                const float component((0 == axis) ? columns[side].GetX() : (1 == axis) ? columns[side].GetY() : columns[side].GetZ());
+                boundedGap.m_min[axis] += std::min(0.f, component * lengths[side]);
+                boundedGap.m_max[axis] += std::max(0.f, component * lengths[side]);
+                boundedGap.m_toleranceScale[axis] += std::fabs(component);
+            }
+        }
+    }
+    catch (StatusCodeException &)
+    {
+        // ATTN Degenerate boxes are left to the gap itself, which will accept or reject positions exactly as without the index
+        m_unboundedGapVector.push_back(boundedGap);
+        return;
+    }
+
+    DetectorGapIndex::AddMargin(boundedGap);
+    m_boundedGapVector.push_back(boundedGap);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void DetectorGapIndex::AddBoundedGap(const ConcentricGap *const pConcentricGap)
+{
+    BoundedGap boundedGap;
+    boundedGap.m_pDetectorGap = pConcentricGap;
+
+    // The gap rejects positions beyond the circumradius of the outer polygon, which is only finite for three or more sides
+    static const float pi(std::acos(-1.f));
+    const unsigned int outerSymmetryOrder(pConcentricGap->GetOuterSymmetryOrder());
+    const float rMax((outerSymmetryOrder < 3) ? 0.f : pConcentricGap->GetOuterRCoordinate() / std::cos(pi / static_cast<float>(outerSymmetryOrder)));
+
+    if (!(rMax > 0.f) || !(pConcentricGap->GetMaxZCoordinate() >= pConcentricGap->GetMinZCoordinate()))
+    {
+        m_unboundedGapVector.push_back(boundedGap);
+        return;
+    }
+
+    boundedGap.m_min[0] = -rMax; boundedGap.m_max[0] = rMax;
+    boundedGap.m_min[1] = -rMax; boundedGap.m_max[1] = rMax;
+    boundedGap.m_min[2] = pConcentricGap->GetMinZCoordinate(); boundedGap.m_max[2] = pConcentricGap->GetMaxZCoordinate();
+
+    for (unsigned int axis = 0; axis < 3; ++axis)
+        boundedGap.m_toleranceScale[axis] = 1.f;
+
+    DetectorGapIndex::AddMargin(boundedGap);
+    m_boundedGapVector.push_back(boundedGap);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void DetectorGapIndex::Clear()
+{
+    m_wireGapIntervalsU.Clear();
+    m_wireGapIntervalsV.Clear();
+    m_wireGapIntervalsW.Clear();
+    m_driftGapIntervals.Clear();
+
+    m_boundedGapVector.clear();
+    m_unboundedGapVector.clear();
+    this->BuildGrid();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool DetectorGapIndex::IsInBoundedGap(const CartesianVector &positionVector, const HitType hitType, const float gapTolerance) const
+{
+    for (const BoundedGap &boundedGap : m_unboundedGapVector)
+    {
+        if (boundedGap.m_pDetectorGap->IsInGap(positionVector, hitType, gapTolerance))
+            return true;
+    }
+
+    const float position[3] = {positionVector.GetX(), positionVector.GetY(), positionVector.GetZ()};
+
+    for (const BoundedGap &boundedGap : m_largeGapVector)
+    {
+        if (DetectorGapIndex::IsInGap(boundedGap, position, positionVector, hitType, gapTolerance))
+            return true;
+    }
+
+    if (m_griddedGapVector.empty())
+        return false;
+
+    const float expansion(std::max(0.f, gapTolerance) * m_maxToleranceScale);
+    unsigned int firstCell[3] = {0, 0, 0}, lastCell[3] = {0, 0, 0};
+
+    for (unsigned int axis = 0; axis < 3; ++axis)
+    {
+        if (!this->GetCellRange(axis, position[axis] - expansion, position[axis] + expansion, firstCell[axis], lastCell[axis]))
+            return false;
+    }
+
+    for (unsigned int iX = firstCell[0]; iX <= lastCell[0]; ++iX)
+    {
+        for (unsigned int iY = firstCell[1]; iY <= lastCell[1]; ++iY)
+        {
+            for (unsigned int iZ = firstCell[2]; iZ <= lastCell[2]; ++iZ)
+            {
+                const unsigned int cell((iX * m_nCells[1] + iY) * m_nCells[2] + iZ);
+
+                for (unsigned int i = m_cellOffsets[cell]; i < m_cellOffsets[cell + 1]; ++i)
+                {
+                    if (DetectorGapIndex::IsInGap(m_griddedGapVector[m_cellGapIndices[i]], position, positionVector, hitType, gapTolerance))
+                        return true;
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool DetectorGapIndex::IsInGap(const BoundedGap &boundedGap, const float *const position, const CartesianVector &positionVector, const HitType hitType,
+    const float gapTolerance)
+{
+    const float tolerance(std::max(0.f, gapTolerance));
+
+    for (unsigned int axis = 0; axis < 3; ++axis)
+    {
+        const float expansion(tolerance * boundedGap.m_toleranceScale[axis]);
+
+        if ((position[axis] < boundedGap.m_min[axis] - expansion) || (position[axis] > boundedGap.m_max[axis] + expansion))
+            return false;
+    }
+
+    return boundedGap.m_pDetectorGap->IsInGap(positionVector, hitType, gapTolerance);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void DetectorGapIndex::AddMargin(BoundedGap &boundedGap)
+{
+    // ATTN Generous compared with the rounding in the gap calculations, as a bounding box that is too small would change results
+    for (unsigned int axis = 0; axis < 3; ++axis)
+    {
+        const float margin(1.e-3f + 1.e-4f * (std::fabs(boundedGap.m_min[axis]) + std::fabs(boundedGap.m_max[axis])));
+        boundedGap.m_min[axis] -= margin;
+        boundedGap.m_max[axis] += margin;
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void DetectorGapIndex::BuildGrid()
+{
+    m_largeGapVector.clear();
+    m_griddedGapVector.clear();
+    m_cellOffsets.clear();
+    m_cellGapIndices.clear();
+    m_maxToleranceScale = 0.f;
+
+    for (unsigned int axis = 0; axis < 3; ++axis)
+    {
+        m_gridMin[axis] = 0.f;
+        m_gridMax[axis] = 0.f;
+        m_inverseCellSize[axis] = 0.f;
+        m_nCells[axis] = 0;
+    }
+
+    if (m_boundedGapVector.empty())
+        return;
+
+    static const unsigned int maxCellsPerAxis(16);
+    const unsigned int nCellsPerAxis(std::min(maxCellsPerAxis, static_cast<unsigned int>(std::ceil(std::cbrt(2.f * m_boundedGapVector.size())))));
+
+    for (unsigned int axis = 0; axis < 3; ++axis)
+    {
+        m_gridMin[axis] = m_boundedGapVector.front().m_min[axis];
+        m_gridMax[axis] = m_boundedGapVector.front().m_max[axis];
+
+        for (const BoundedGap &boundedGap : m_boundedGapVector)
+        {
+            m_gridMin[axis] = std::min(m_gridMin[axis], boundedGap.m_min[axis]);
+            m_gridMax[axis] = std::max(m_gridMax[axis], boundedGap.m_max[axis]);
+        }
+
+        const float extent(m_gridMax[axis] - m_gridMin[axis]);
+        m_nCells[axis] = (extent > 0.f) ? std::max(1U, nCellsPerAxis) : 1;
+        m_inverseCellSize[axis] = (extent > 0.f) ? static_cast<float>(m_nCells[axis]) / extent : 0.f;
+    }
+
+    const unsigned int nCells(m_nCells[0] * m_nCells[1] * m_nCells[2]);
+    m_cellOffsets.assign(nCells + 1, 0);
+
+    // First pass counts the gaps per cell, second pass fills the cell contents at the accumulated offsets
+    for (unsigned int pass = 0; pass < 2; ++pass)
+    {
+        UIntVector cellFillVector;
+
+        if (1 == pass)
+        {
+            for (unsigned int cell = 0; cell < nCells; ++cell)
+                m_cellOffsets[cell + 1] += m_cellOffsets[cell];
+
+            m_cellGapIndices.resize(m_cellOffsets[nCells]);
+            cellFillVector.assign(m_cellOffsets.begin(), m_cellOffsets.end() - 1);
+        }
+
+        for (const BoundedGap &boundedGap : m_boundedGapVector)
+        {
+            unsigned int firstCell[3] = {0, 0, 0}, lastCell[3] = {0, 0, 0};
+
+            for (unsigned int axis = 0; axis < 3; ++axis)
+            {
+                if (!this->GetCellRange(axis, boundedGap.m_min[axis], boundedGap.m_max[axis], firstCell[axis], lastCell[axis]))
+                    throw StatusCodeException(STATUS_CODE_FAILURE);
+            }
+
+            const unsigned int nOverlappingCells((lastCell[0] - firstCell[0] + 1) * (lastCell[1] - firstCell[1] + 1) * (lastCell[2] - firstCell[2] + 1));
+
+            if ((nCells > 1) && (2 * nOverlappingCells > nCells))
+            {
+                if (0 == pass)
+                    m_largeGapVector.push_back(boundedGap);
+
+                continue;
+            }
+
+            const unsigned int gapIndex(m_griddedGapVector.size());
+
+            if (1 == pass)
+                m_griddedGapVector.push_back(boundedGap);
+
+            for (unsigned int iX = firstCell[0]; iX <= lastCell[0]; ++iX)
+            {
+                for (unsigned int iY = firstCell[1]; iY <= lastCell[1]; ++iY)
+                {
+                    for (unsigned int iZ = firstCell[2]; iZ <= lastCell[2]; ++iZ)
+                    {
+                        const unsigned int cell((iX * m_nCells[1] + iY) * m_nCells[2] + iZ);
+
+                        if (0 == pass)
+                        {
+                            ++m_cellOffsets[cell + 1];
+                        }
+                        else
+                        {
+                            m_cellGapIndices[cellFillVector[cell]++] = gapIndex;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    for (const BoundedGap &boundedGap : m_griddedGapVector)
+    {
+        for (unsigned int axis = 0; axis < 3; ++axis)
+            m_maxToleranceScale = std::max(m_maxToleranceScale, boundedGap.m_toleranceScale[axis]);
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool DetectorGapIndex::GetCellRange(const unsigned int axis, const float low, const float high, unsigned int &firstCell, unsigned int &lastCell) const
+{
+    if ((high < m_gridMin[axis]) || (low > m_gridMax[axis]))
+        return false;
+
+    const float lastIndex(static_cast<float>(m_nCells[axis] - 1));
+    firstCell = static_cast<unsigned int>(std::min(lastIndex, std::max(0.f, std::floor((low - m_gridMin[axis]) * m_inverseCellSize[axis]))));
+    lastCell = static_cast<unsigned int>(std::min(lastIndex, std::max(0.f, std::floor((high - m_gridMin[axis]) * m_inverseCellSize[axis]))));
+
+    return true;
+}
+
+} // namespace pandora
@@ -0,0 +1,198 @@
+/**
+ *  @file   PandoraSDK/src/Geometry/LArTPCIndex.cc
+ *
+ *  @brief  Implementation of the lar tpc index class.
+ *
+ *  $Log: $
+ */
+
+#include "Geometry/LArTPC.h"
+#include "Geometry/LArTPCIndex.h"
+
+#include <algorithm>
+
+namespace pandora
+{
+
+LArTPCIndex::LArTPCIndex() :
+    m_isGridded(false)
+{
+    this->Clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode LArTPCIndex::GetLArTPC(const CartesianVector &positionVector, const LArTPC *&pLArTPC) const
+{
+    pLArTPC = nullptr;
+    const float position[3] = {positionVector.GetX(), positionVector.GetY(), positionVector.GetZ()};
+
+    if (!m_isGridded)
+    {
+        for (const Volume &volume : m_volumeVector)
+        {
+            if (LArTPCIndex::Contains(volume, position))
+            {
+                pLArTPC = volume.m_pLArTPC;
+                return STATUS_CODE_SUCCESS;
+            }
+        }
+
+        return STATUS_CODE_NOT_FOUND;
+    }
+
+    unsigned int cell[3] = {0, 0, 0};
+
+    for (unsigned int axis = 0; axis < 3; ++axis)
+    {
+        if (!this->GetCell(axis, position[axis], cell[axis]))
+            return STATUS_CODE_NOT_FOUND;
+    }
+
+    const unsigned int cellIndex((cell[0] * m_nCells[1] + cell[1]) * m_nCells[2] + cell[2]);
+
+    for (unsigned int i = m_cellOffsets[cellIndex]; i < m_cellOffsets[cellIndex + 1]; ++i)
+    {
+        const Volume &volume(m_volumeVector[m_cellVolumeIndices[i]]);
+
+        if (LArTPCIndex::Contains(volume, position))
+        {
+            pLArTPC = volume.m_pLArTPC;
+            return STATUS_CODE_SUCCESS;
+        }
+    }
+
+    return STATUS_CODE_NOT_FOUND;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void LArTPCIndex::Fill(const LArTPCMap &larTPCMap)
+{
+    this->Clear();
+
+    for (const LArTPCMap::value_type &mapEntry : larTPCMap)
+    {
+        const LArTPC *const pLArTPC(mapEntry.second);
+        const float center[3] = {pLArTPC->GetCenterX(), pLArTPC->GetCenterY(), pLArTPC->GetCenterZ()};
+        const float width[3] = {pLArTPC->GetWidthX(), pLArTPC->GetWidthY(), pLArTPC->GetWidthZ()};
+
+        Volume volume;
+        volume.m_pLArTPC = pLArTPC;
+
+        for (unsigned int axis = 0; axis < 3; ++axis)
+        {
+            volume.m_min[axis] = center[axis] - 0.5f * width[axis];
+            volume.m_max[axis] = center[axis] + 0.5f * width[axis];
+            m_edgeVector[axis].push_back(volume.m_min[axis]);
+            m_edgeVector[axis].push_back(volume.m_max[axis]);
+        }
+
+        m_volumeVector.push_back(volume);
+    }
+
+    if (m_volumeVector.empty())
+        return;
+
+    unsigned int nCells(1);
+
+    for (unsigned int axis = 0; axis < 3; ++axis)
+    {
+        FloatVector &edgeVector(m_edgeVector[axis]);
+        std::sort(edgeVector.begin(), edgeVector.end());
+        edgeVector.erase(std::unique(edgeVector.begin(), edgeVector.end()), edgeVector.end());
+        m_nCells[axis] = std::max(1U, static_cast<unsigned int>(edgeVector.size()) - 1);
+
+        if (nCells > MAX_GRID_CELLS / m_nCells[axis])
+            return;
+
+        nCells *= m_nCells[axis];
+    }
+
+    // First pass counts the volumes per cell, second pass fills the cell contents at the accumulated offsets. Volumes are recorded in
+    // every cell whose closed extent they touch, so shared boundaries resolve to the lowest volume id, as in a scan over all volumes.
+    m_cellOffsets.assign(nCells + 1, 0);
+    UIntVector cellFillVector;
+
+    for (unsigned int pass = 0; pass < 2; ++pass)
+    {
+        if (1 == pass)
+        {
+            for (unsigned int cell = 0; cell < nCells; ++cell)
+                m_cellOffsets[cell + 1] += m_cellOffsets[cell];
+
+            m_cellVolumeIndices.resize(m_cellOffsets[nCells]);
+            cellFillVector.assign(m_cellOffsets.begin(), m_cellOffsets.end() - 1);
+        }
+
+        for (unsigned int volumeIndex = 0; volumeIndex < m_volumeVector.size(); ++volumeIndex)
+        {
+            const Volume &volume(m_volumeVector[volumeIndex]);
+            unsigned int firstCell[3] = {0, 0, 0}, lastCell[3] = {0, 0, 0};
+
+            for (unsigned int axis = 0; axis < 3; ++axis)
+            {
+                const FloatVector &edgeVector(m_edgeVector[axis]);
+                const unsigned int minEdge(std::lower_bound(edgeVector.begin(), edgeVector.end(), volume.m_min[axis]) - edgeVector.begin());
+                const unsigned int maxEdge(std::lower_bound(edgeVector.begin(), edgeVector.end(), volume.m_max[axis]) - edgeVector.begin());
+                firstCell[axis] = (minEdge > 0) ? minEdge - 1 : 0;
+                lastCell[axis] = std::min(maxEdge, m_nCells[axis] - 1);
+            }
+
+            for (unsigned int iX = firstCell[0]; iX <= lastCell[0]; ++iX)
+            {
+                for (unsigned int iY = firstCell[1]; iY <= lastCell[1]; ++iY)
+                {
+                    for (unsigned int iZ = firstCell[2]; iZ <= lastCell[2]; ++iZ)
+                    {
+                        const unsigned int cell((iX * m_nCells[1] + iY) * m_nCells[2] + iZ);
+
+                        if (0 == pass)
+                        {
+                            ++m_cellOffsets[cell + 1];
+                        }
+                        else
+                        {
+                            m_cellVolumeIndices[cellFillVector[cell]++] = volumeIndex;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    m_isGridded = true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void LArTPCIndex::Clear()
+{
+    m_volumeVector.clear();
+    m_cellOffsets.clear();
+    m_cellVolumeIndices.clear();
+    m_isGridded = false;
+
+    for (unsigned int axis = 0; axis < 3; ++axis)
+    {
+        m_edgeVector[axis].clear();
+        m_nCells[axis] = 0;
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool LArTPCIndex::GetCell(const unsigned int axis, const float coordinate, unsigned int &cell) const
+{
+    const FloatVector &edgeVector(m_edgeVector[axis]);
+
+    if (!(coordinate >= edgeVector.front()) || !(coordinate <= edgeVector.back()))
+        return false;
+
+    const unsigned int upperEdge(std::upper_bound(edgeVector.begin(), edgeVector.end(), coordinate) - edgeVector.begin());
+    cell = std::min(upperEdge - 1, m_nCells[axis] - 1);
+
+    return true;
+}
+
+} // namespace pandora
@@ -8,6 +8,9 @@
 
 #include "Geometry/SubDetector.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace pandora
 {
 
@@ -23,7 +26,8 @@ SubDetector::SubDetector(const object_creation::Geometry::SubDetector::Parameter
     m_outerPhiCoordinate(inputParameters.m_outerPhiCoordinate.Get()),
     m_outerSymmetryOrder(inputParameters.m_outerSymmetryOrder.Get()),
     m_isMirroredInZ(inputParameters.m_isMirroredInZ.Get()),
-    m_nLayers(inputParameters.m_nLayers.Get())
+    m_nLayers(inputParameters.m_nLayers.Get()),
+    m_isEndCap((ECAL_ENDCAP == m_subDetectorType) || (HCAL_ENDCAP == m_subDetectorType) || (MUON_ENDCAP == m_subDetectorType))
 {
     if ((m_innerRCoordinate < 0.f) || (m_outerRCoordinate < 0.f) || (m_isMirroredInZ && ((m_innerZCoordinate < 0.f) || (m_outerZCoordinate < 0.f))))
     {
@@ -42,6 +46,61 @@ SubDetector::SubDetector(const object_creation::Geometry::SubDetector::Parameter
         SubDetectorLayer subDetectorLayer(layerParameters.m_closestDistanceToIp.Get(), layerParameters.m_nRadiationLengths.Get(), layerParameters.m_nInteractionLengths.Get());
         m_subDetectorLayerVector.push_back(subDetectorLayer);
     }
+
+    // Layers are usually listed from the inside out, but the boundary table is sorted regardless, remembering the original indices
+    for (unsigned int iLayer = 0; iLayer < m_nLayers; ++iLayer)
+        m_layerBoundaryIndices.push_back(iLayer);
+
+    std::stable_sort(m_layerBoundaryIndices.begin(), m_layerBoundaryIndices.end(), [this](const unsigned int lhs, const unsigned int rhs)
+        { return (m_subDetectorLayerVector[lhs].GetClosestDistanceToIp() < m_subDetectorLayerVector[rhs].GetClosestDistanceToIp()); });
+
+    for (const unsigned int iLayer : m_layerBoundaryIndices)
+        m_layerBoundaries.push_back(m_subDetectorLayerVector[iLayer].GetClosestDistanceToIp());
+
+    if (m_innerSymmetryOrder >= 3)
+    {
+        static const float twoPi(2.f * std::acos(-1.f));
+
+        for (unsigned int iFace = 0; iFace < m_innerSymmetryOrder; ++iFace)
+        {
+            const float phi(m_innerPhiCoordinate + twoPi * static_cast<float>(iFace) / static_cast<float>(m_innerSymmetryOrder));
+            m_faceCosines.push_back(std::cos(phi));
+            m_faceSines.push_back(std::sin(phi));
+        }
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+float SubDetector::GetLayerCoordinate(const CartesianVector &positionVector) const
+{
+    if (m_isEndCap)
+        return std::fabs(positionVector.GetZ());
+
+    const float x(positionVector.GetX()), y(positionVector.GetY());
+
+    if (m_faceCosines.empty())
+        return std::sqrt(x * x + y * y);
+
+    float maxProjection(x * m_faceCosines.front() + y * m_faceSines.front());
+
+    for (unsigned int iFace = 1; iFace < m_faceCosines.size(); ++iFace)
+        maxProjection = std::max(maxProjection, x * m_faceCosines[iFace] + y * m_faceSines[iFace]);
+
+    return maxProjection;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode SubDetector::FindLayer(const float layerCoordinate, unsigned int &layer) const
+{
+    const FloatVector::const_iterator iter(std::upper_bound(m_layerBoundaries.begin(), m_layerBoundaries.end(), layerCoordinate));
+
+    if (m_layerBoundaries.begin() == iter)
+        return STATUS_CODE_NOT_FOUND;
+
+    layer = m_layerBoundaryIndices[iter - m_layerBoundaries.begin() - 1];
+    return STATUS_CODE_SUCCESS;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -31,21 +31,13 @@ StatusCode ClusterFitHelper::FitStart(const Cluster *const pCluster, const unsig
     if (listSize < 2)
         return STATUS_CODE_OUT_OF_RANGE;
 
-    unsigned int occupiedLayerCount(0);
-
-    ClusterFitPointList clusterFitPointList;
-    for (const OrderedCaloHitList::value_type &layerIter : orderedCaloHitList)
+    ClusterFitAccumulator clusterFitAccumulator;
+    for (const OrderedCaloHitList::value_type &layerIter : orderedCaloHitList.GetFirstNOccupiedLayers(maxOccupiedLayers))
     {
-        if (++occupiedLayerCount > maxOccupiedLayers)
-            break;
-
-        for (const CaloHit *const pCaloHit : *layerIter.second)
-        {
-            clusterFitPointList.push_back(ClusterFitPoint(pCaloHit));
-        }
+        clusterFitAccumulator += pCluster->GetFitAccumulator(layerIter.first);
     }
 
-    return FitPoints(clusterFitPointList, clusterFitResult);
+    return FitPoints(clusterFitAccumulator, clusterFitResult);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -64,21 +56,15 @@ StatusCode ClusterFitHelper::FitEnd(const Cluster *const pCluster, const unsigne
     if (listSize < 2)
         return STATUS_CODE_OUT_OF_RANGE;
 
-    unsigned int occupiedLayerCount(0);
+    const OrderedCaloHitList::LayerRange layerRange(orderedCaloHitList.GetLastNOccupiedLayers(maxOccupiedLayers));
 
-    ClusterFitPointList clusterFitPointList;
-    for (OrderedCaloHitList::const_reverse_iterator iter = orderedCaloHitList.rbegin(), iterEnd = orderedCaloHitList.rend(); iter != iterEnd; ++iter)
+    ClusterFitAccumulator clusterFitAccumulator;
+    for (OrderedCaloHitList::const_reverse_iterator iter = layerRange.rbegin(), iterEnd = layerRange.rend(); iter != iterEnd; ++iter)
     {
-        if (++occupiedLayerCount > maxOccupiedLayers)
-            break;
-
-        for (const CaloHit *const pCaloHit : *iter->second)
-        {
-            clusterFitPointList.push_back(ClusterFitPoint(pCaloHit));
-        }
+        clusterFitAccumulator += pCluster->GetFitAccumulator(iter->first);
     }
 
-    return FitPoints(clusterFitPointList, clusterFitResult);
+    return FitPoints(clusterFitAccumulator, clusterFitResult);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -94,16 +80,13 @@ StatusCode ClusterFitHelper::FitFullCluster(const Cluster *const pCluster, Clust
     if (listSize < 2)
         return STATUS_CODE_OUT_OF_RANGE;
 
-    ClusterFitPointList clusterFitPointList;
+    ClusterFitAccumulator clusterFitAccumulator;
     for (const OrderedCaloHitList::value_type &layerIter : orderedCaloHitList)
     {
-        for (const CaloHit *const pCaloHit : *layerIter.second)
-        {
-            clusterFitPointList.push_back(ClusterFitPoint(pCaloHit));
-        }
+        clusterFitAccumulator += pCluster->GetFitAccumulator(layerIter.first);
     }
 
-    return FitPoints(clusterFitPointList, clusterFitResult);
+    return FitPoints(clusterFitAccumulator, clusterFitResult);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -123,24 +106,13 @@ StatusCode ClusterFitHelper::FitLayers(const Cluster *const pCluster, const unsi
     if (listSize < 2)
         return STATUS_CODE_OUT_OF_RANGE;
 
-    ClusterFitPointList clusterFitPointList;
-    for (const OrderedCaloHitList::value_type &layerIter : orderedCaloHitList)
+    ClusterFitAccumulator clusterFitAccumulator;
+    for (const OrderedCaloHitList::value_type &layerIter : orderedCaloHitList.GetLayerRange(startLayer, endLayer))
     {
-        const unsigned int pseudoLayer(layerIter.first);
-
-        if (startLayer > pseudoLayer)
-            continue;
-
-        if (endLayer < pseudoLayer)
-            break;
-
-        for (const CaloHit *const pCaloHit : *layerIter.second)
-        {
-            clusterFitPointList.push_back(ClusterFitPoint(pCaloHit));
-        }
+        clusterFitAccumulator += pCluster->GetFitAccumulator(layerIter.first);
     }
 
-    return FitPoints(clusterFitPointList, clusterFitResult);
+    return FitPoints(clusterFitAccumulator, clusterFitResult);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -162,37 +134,24 @@ StatusCode ClusterFitHelper::FitLayerCentroids(const Cluster *const pCluster, co
         if (listSize < 2)
             return STATUS_CODE_OUT_OF_RANGE;
 
-        ClusterFitPointList clusterFitPointList;
-        for (const OrderedCaloHitList::value_type &layerIter : orderedCaloHitList)
+        ClusterFitAccumulator clusterFitAccumulator;
+        for (const OrderedCaloHitList::value_type &layerIter : orderedCaloHitList.GetLayerRange(startLayer, endLayer))
         {
             const unsigned int pseudoLayer(layerIter.first);
-
-            if (startLayer > pseudoLayer)
-                continue;
-
-            if (endLayer < pseudoLayer)
-                break;
-
-            const unsigned int nCaloHits(layerIter.second->size());
+            const ClusterFitAccumulator &layerAccumulator(pCluster->GetFitAccumulator(pseudoLayer));
+            const unsigned int nCaloHits(layerAccumulator.GetNPoints());
 
             if (0 == nCaloHits)
                 throw StatusCodeException(STATUS_CODE_FAILURE);
 
-            float cellLengthScaleSum(0.f), cellEnergySum(0.f);
-            CartesianVector cellNormalVectorSum(0.f, 0.f, 0.f);
-
-            for (const CaloHit *const pCaloHit : *layerIter.second)
-            {
-                cellLengthScaleSum += pCaloHit->GetCellLengthScale();
-                cellNormalVectorSum += pCaloHit->GetCellNormalVector();
-                cellEnergySum += pCaloHit->GetInputEnergy();
-            }
+            if (layerAccumulator.m_nInvalidPoints > 0)
+                throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
 
-            clusterFitPointList.push_back(ClusterFitPoint(pCluster->GetCentroid(pseudoLayer), cellNormalVectorSum.GetUnitVector(),
-                cellLengthScaleSum / static_cast<float>(nCaloHits), cellEnergySum / static_cast<float>(nCaloHits), pseudoLayer));
+            clusterFitAccumulator.Add(ClusterFitPoint(pCluster->GetCentroid(pseudoLayer), layerAccumulator.GetCellNormalVectorSum().GetUnitVector(),
+                layerAccumulator.GetCellSizeSum() / static_cast<float>(nCaloHits), layerAccumulator.GetEnergySum() / static_cast<float>(nCaloHits), pseudoLayer));
         }
 
-        return FitPoints(clusterFitPointList, clusterFitResult);
+        return FitPoints(clusterFitAccumulator, clusterFitResult);
     }
     catch (StatusCodeException &statusCodeException)
     {
@@ -203,28 +162,99 @@ StatusCode ClusterFitHelper::FitLayerCentroids(const Cluster *const pCluster, co
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-StatusCode ClusterFitHelper::FitPoints(ClusterFitPointList &clusterFitPointList, ClusterFitResult &clusterFitResult)
+StatusCode ClusterFitHelper::FitStart(const ClusterVector &clusterVector, const unsigned int maxOccupiedLayers, ClusterFitResultList &clusterFitResultList)
+{
+    if (maxOccupiedLayers < 2)
+        return STATUS_CODE_INVALID_PARAMETER;
+
+    clusterFitResultList.assign(clusterVector.size(), ClusterFitResult());
+
+    for (unsigned int iCluster = 0, nClusters = clusterVector.size(); iCluster < nClusters; ++iCluster)
+        (void) ClusterFitHelper::FitStart(clusterVector.at(iCluster), maxOccupiedLayers, clusterFitResultList.at(iCluster));
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode ClusterFitHelper::FitEnd(const ClusterVector &clusterVector, const unsigned int maxOccupiedLayers, ClusterFitResultList &clusterFitResultList)
+{
+    if (maxOccupiedLayers < 2)
+        return STATUS_CODE_INVALID_PARAMETER;
+
+    clusterFitResultList.assign(clusterVector.size(), ClusterFitResult());
+
+    for (unsigned int iCluster = 0, nClusters = clusterVector.size(); iCluster < nClusters; ++iCluster)
+        (void) ClusterFitHelper::FitEnd(clusterVector.at(iCluster), maxOccupiedLayers, clusterFitResultList.at(iCluster));
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode ClusterFitHelper::FitFullCluster(const ClusterVector &clusterVector, ClusterFitResultList &clusterFitResultList)
 {
-    std::sort(clusterFitPointList.begin(), clusterFitPointList.end());
+    clusterFitResultList.assign(clusterVector.size(), ClusterFitResult());
+
+    for (unsigned int iCluster = 0, nClusters = clusterVector.size(); iCluster < nClusters; ++iCluster)
+        (void) ClusterFitHelper::FitFullCluster(clusterVector.at(iCluster), clusterFitResultList.at(iCluster));
+
+    return STATUS_CODE_SUCCESS;
+}
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode ClusterFitHelper::FitPoints(const ClusterFitPointList &clusterFitPointList, ClusterFitResult &clusterFitResult)
+{
+    return FitPoints(clusterFitPointList, UNIT_WEIGHTS, INPUT_ORDER, clusterFitResult);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode ClusterFitHelper::FitPoints(const ClusterFitPointList &clusterFitPointList, const FitPointWeighting fitPointWeighting,
+    const FitPointOrdering fitPointOrdering, ClusterFitResult &clusterFitResult)
+{
+    ClusterFitPointList sortedClusterFitPointList;
+
+    if (DETERMINISTIC_ORDER == fitPointOrdering)
+    {
+        sortedClusterFitPointList = clusterFitPointList;
+        std::sort(sortedClusterFitPointList.begin(), sortedClusterFitPointList.end());
+    }
+
+    const ClusterFitPointList &orderedClusterFitPointList((DETERMINISTIC_ORDER == fitPointOrdering) ? sortedClusterFitPointList : clusterFitPointList);
+
+    ClusterFitAccumulator clusterFitAccumulator;
+
+    for (const ClusterFitPoint &clusterFitPoint : orderedClusterFitPointList)
+        clusterFitAccumulator.Add(clusterFitPoint, (ENERGY_WEIGHTS == fitPointWeighting) ? clusterFitPoint.GetEnergy() : 1.f);
+
+    return FitPoints(clusterFitAccumulator, clusterFitResult);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode ClusterFitHelper::FitPoints(const ClusterFitAccumulator &clusterFitAccumulator, ClusterFitResult &clusterFitResult)
+{
     try
     {
-        const unsigned int nFitPoints(clusterFitPointList.size());
+        if (clusterFitAccumulator.m_nInvalidPoints > 0)
+            throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
+
+        const unsigned int nFitPoints(clusterFitAccumulator.GetNPoints());
 
-        if (nFitPoints < 2)
+        if ((nFitPoints < 2) || (clusterFitAccumulator.m_fitWeightSum < std::numeric_limits<float>::epsilon()))
             return STATUS_CODE_INVALID_PARAMETER;
 
         clusterFitResult.Reset();
-        CartesianVector positionSum(0.f, 0.f, 0.f);
-        CartesianVector normalVectorSum(0.f, 0.f, 0.f);
-
-        for (const ClusterFitPoint &clusterFitPoint : clusterFitPointList)
-        {
-            positionSum += clusterFitPoint.GetPosition();
-            normalVectorSum += clusterFitPoint.GetCellNormalVector();
-        }
-
-        return PerformLinearFit(positionSum * (1.f / static_cast<float>(nFitPoints)), normalVectorSum.GetUnitVector(), clusterFitPointList, clusterFitResult);
+        const double *const reference(clusterFitAccumulator.m_referencePosition);
+        const double fitWeightSum(clusterFitAccumulator.m_fitWeightSum);
+        const CartesianVector centralPosition(static_cast<float>(reference[0] + clusterFitAccumulator.m_positionSum[0] / fitWeightSum),
+            static_cast<float>(reference[1] + clusterFitAccumulator.m_positionSum[1] / fitWeightSum),
+            static_cast<float>(reference[2] + clusterFitAccumulator.m_positionSum[2] / fitWeightSum));
+
+        return PerformLinearFit(centralPosition, clusterFitAccumulator.GetCellNormalVectorSum().GetUnitVector(), clusterFitAccumulator,
+            clusterFitResult);
     }
     catch (StatusCodeException &statusCodeException)
     {
@@ -237,40 +267,34 @@ StatusCode ClusterFitHelper::FitPoints(ClusterFitPointList &clusterFitPointList,
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 StatusCode ClusterFitHelper::PerformLinearFit(const CartesianVector &centralPosition, const CartesianVector &centralDirection,
-    ClusterFitPointList &clusterFitPointList, ClusterFitResult &clusterFitResult)
+    const ClusterFitAccumulator &clusterFitAccumulator, ClusterFitResult &clusterFitResult)
 {
-    std::sort(clusterFitPointList.begin(), clusterFitPointList.end());
-
-    // Extract the data
-    double sumP(0.), sumQ(0.), sumR(0.), sumWeights(0.);
-    double sumPR(0.), sumQR(0.), sumRR(0.);
-
-    const CartesianVector chosenAxis(0.f, 0.f, 1.f);
-    const double cosTheta(centralDirection.GetCosOpeningAngle(chosenAxis));
-    const double sinTheta(std::sin(std::acos(cosTheta)));
-
-    const CartesianVector rotationAxis((std::fabs(cosTheta) > 0.99) ? CartesianVector(1.f, 0.f, 0.f) :
-        centralDirection.GetCrossProduct(chosenAxis).GetUnitVector());
-
-    for (const ClusterFitPoint &clusterFitPoint : clusterFitPointList)
-    {
-        const CartesianVector position(clusterFitPoint.GetPosition() - centralPosition);
-        const double weight(1.);
-
-        const double p( (cosTheta + rotationAxis.GetX() * rotationAxis.GetX() * (1. - cosTheta)) * position.GetX() +
-            (rotationAxis.GetX() * rotationAxis.GetY() * (1. - cosTheta) - rotationAxis.GetZ() * sinTheta) * position.GetY() +
-            (rotationAxis.GetX() * rotationAxis.GetZ() * (1. - cosTheta) + rotationAxis.GetY() * sinTheta) * position.GetZ() );
-        const double q( (rotationAxis.GetY() * rotationAxis.GetX() * (1. - cosTheta) + rotationAxis.GetZ() * sinTheta) * position.GetX() +
-            (cosTheta + rotationAxis.GetY() * rotationAxis.GetY() * (1. - cosTheta)) * position.GetY() +
-            (rotationAxis.GetY() * rotationAxis.GetZ() * (1. - cosTheta) - rotationAxis.GetX() * sinTheta) * position.GetZ() );
-        const double r( (rotationAxis.GetZ() * rotationAxis.GetX() * (1. - cosTheta) - rotationAxis.GetY() * sinTheta) * position.GetX() +
-            (rotationAxis.GetZ() * rotationAxis.GetY() * (1. - cosTheta) + rotationAxis.GetX() * sinTheta) * position.GetY() +
-            (cosTheta + rotationAxis.GetZ() * rotationAxis.GetZ() * (1. - cosTheta)) * position.GetZ() );
-
-        sumP += p * weight; sumQ += q * weight; sumR += r * weight;
-        sumPR += p * r * weight; sumQR += q * r * weight; sumRR += r * r * weight;
-        sumWeights += weight;
-    }
+    // Rows of the rotation matrix, taking positions relative to the central position into the (p, q, r) fit frame; the columns take
+    // fit frame vectors back again
+    double rotation[3][3];
+    ClusterFitHelper::GetRotationMatrix(centralDirection, rotation);
+    const double *const rotationP(rotation[0]), *const rotationQ(rotation[1]), *const rotationR(rotation[2]);
+
+    // Extract the data, as moments of the positions relative to the central position. Accumulated positions are relative to the
+    // accumulator reference position, so the central position is expressed in the same frame.
+    const double fitWeightSum(clusterFitAccumulator.m_fitWeightSum);
+    const double *const reference(clusterFitAccumulator.m_referencePosition);
+    const double centre[3] = {centralPosition.GetX() - reference[0], centralPosition.GetY() - reference[1], centralPosition.GetZ() - reference[2]};
+
+    double firstMoment[3], secondMoment[3][3];
+    double weightedFirstMoment[3], weightedSecondMoment[3][3];
+    ClusterFitHelper::GetCentralMoments(clusterFitAccumulator.m_positionSum, clusterFitAccumulator.m_positionProductSum, fitWeightSum, centre,
+        firstMoment, secondMoment);
+    ClusterFitHelper::GetCentralMoments(clusterFitAccumulator.m_weightedPositionSum, clusterFitAccumulator.m_weightedPositionProductSum,
+        clusterFitAccumulator.m_weightSum, centre, weightedFirstMoment, weightedSecondMoment);
+
+    const double sumP(ClusterFitHelper::GetProduct(rotationP, firstMoment));
+    const double sumQ(ClusterFitHelper::GetProduct(rotationQ, firstMoment));
+    const double sumR(ClusterFitHelper::GetProduct(rotationR, firstMoment));
+    const double sumPR(ClusterFitHelper::GetProduct(rotationP, secondMoment, rotationR));
+    const double sumQR(ClusterFitHelper::GetProduct(rotationQ, secondMoment, rotationR));
+    const double sumRR(ClusterFitHelper::GetProduct(rotationR, secondMoment, rotationR));
+    const double sumWeights(fitWeightSum);
 
     // Perform the fit
     const double denominatorR(sumR * sumR - sumWeights * sumRR);
@@ -288,23 +312,14 @@ StatusCode ClusterFitHelper::PerformLinearFit(const CartesianVector &centralPosi
     const double dirP(aP / magnitude), dirQ(aQ / magnitude), dirR(1. / magnitude);
 
     CartesianVector direction(
-        static_cast<float>((cosTheta + rotationAxis.GetX() * rotationAxis.GetX() * (1. - cosTheta)) * dirP +
-            (rotationAxis.GetX() * rotationAxis.GetY() * (1. - cosTheta) + rotationAxis.GetZ() * sinTheta) * dirQ +
-            (rotationAxis.GetX() * rotationAxis.GetZ() * (1. - cosTheta) - rotationAxis.GetY() * sinTheta) * dirR),
-        static_cast<float>((rotationAxis.GetY() * rotationAxis.GetX() * (1. - cosTheta) - rotationAxis.GetZ() * sinTheta) * dirP +
-            (cosTheta + rotationAxis.GetY() * rotationAxis.GetY() * (1. - cosTheta)) * dirQ +
-            (rotationAxis.GetY() * rotationAxis.GetZ() * (1. - cosTheta) + rotationAxis.GetX() * sinTheta) * dirR),
-        static_cast<float>((rotationAxis.GetZ() * rotationAxis.GetX() * (1. - cosTheta) + rotationAxis.GetY() * sinTheta) * dirP +
-            (rotationAxis.GetZ() * rotationAxis.GetY() * (1. - cosTheta) - rotationAxis.GetX() * sinTheta) * dirQ +
-            (cosTheta + rotationAxis.GetZ() * rotationAxis.GetZ() * (1. - cosTheta)) * dirR) );
+        static_cast<float>(rotationP[0] * dirP + rotationQ[0] * dirQ + rotationR[0] * dirR),
+        static_cast<float>(rotationP[1] * dirP + rotationQ[1] * dirQ + rotationR[1] * dirR),
+        static_cast<float>(rotationP[2] * dirP + rotationQ[2] * dirQ + rotationR[2] * dirR));
 
     CartesianVector intercept(centralPosition + CartesianVector(
-        static_cast<float>((cosTheta + rotationAxis.GetX() * rotationAxis.GetX() * (1. - cosTheta)) * bP +
-            (rotationAxis.GetX() * rotationAxis.GetY() * (1. - cosTheta) + rotationAxis.GetZ() * sinTheta) * bQ),
-        static_cast<float>((rotationAxis.GetY() * rotationAxis.GetX() * (1. - cosTheta) - rotationAxis.GetZ() * sinTheta) * bP +
-            (cosTheta + rotationAxis.GetY() * rotationAxis.GetY() * (1. - cosTheta)) * bQ),
-        static_cast<float>((rotationAxis.GetZ() * rotationAxis.GetX() * (1. - cosTheta) + rotationAxis.GetY() * sinTheta) * bP +
-            (rotationAxis.GetZ() * rotationAxis.GetY() * (1. - cosTheta) - rotationAxis.GetX() * sinTheta) * bQ) ));
+        static_cast<float>(rotationP[0] * bP + rotationQ[0] * bQ),
+        static_cast<float>(rotationP[1] * bP + rotationQ[1] * bQ),
+        static_cast<float>(rotationP[2] * bP + rotationQ[2] * bQ)));
 
     // Extract radial direction cosine
     float dirCosR(direction.GetDotProduct(intercept) / intercept.GetMagnitude());
@@ -315,58 +330,113 @@ StatusCode ClusterFitHelper::PerformLinearFit(const CartesianVector &centralPosi
         direction = direction * -1.f;
     }
 
-    // Now calculate something like a chi2
-    double chi2_P(0.), chi2_Q(0.), rms(0.);
-    double sumA(0.), sumL(0.), sumAL(0.), sumLL(0.);
+    // Now calculate something like a chi2, using sum over points of weight * (u.(x - c) - b)^2 = u.W2.u - 2b u.W1 + b^2 W0
+    const double residualP[3] = {rotationP[0] - aP * rotationR[0], rotationP[1] - aP * rotationR[1], rotationP[2] - aP * rotationR[2]};
+    const double residualQ[3] = {rotationQ[0] - aQ * rotationR[0], rotationQ[1] - aQ * rotationR[1], rotationQ[2] - aQ * rotationR[2]};
 
-    for (const ClusterFitPoint &clusterFitPoint : clusterFitPointList)
-    {
-        const CartesianVector position(clusterFitPoint.GetPosition() - centralPosition);
-
-        const double p( (cosTheta + rotationAxis.GetX() * rotationAxis.GetX() * (1. - cosTheta)) * position.GetX() +
-            (rotationAxis.GetX() * rotationAxis.GetY() * (1. - cosTheta) - rotationAxis.GetZ() * sinTheta) * position.GetY() +
-            (rotationAxis.GetX() * rotationAxis.GetZ() * (1. - cosTheta) + rotationAxis.GetY() * sinTheta) * position.GetZ() );
-        const double q( (rotationAxis.GetY() * rotationAxis.GetX() * (1. - cosTheta) + rotationAxis.GetZ() * sinTheta) * position.GetX() +
-            (cosTheta + rotationAxis.GetY() * rotationAxis.GetY() * (1. - cosTheta)) * position.GetY() +
-            (rotationAxis.GetY() * rotationAxis.GetZ() * (1. - cosTheta) - rotationAxis.GetX() * sinTheta) * position.GetZ() );
-        const double r( (rotationAxis.GetZ() * rotationAxis.GetX() * (1. - cosTheta) - rotationAxis.GetY() * sinTheta) * position.GetX() +
-            (rotationAxis.GetZ() * rotationAxis.GetY() * (1. - cosTheta) + rotationAxis.GetX() * sinTheta) * position.GetY() +
-            (cosTheta + rotationAxis.GetZ() * rotationAxis.GetZ() * (1. - cosTheta)) * position.GetZ() );
-
-        const double error(clusterFitPoint.GetCellSize() / 3.46);
-        const double chiP((p - aP * r - bP) / error);
-        const double chiQ((q - aQ * r - bQ) / error);
-
-        chi2_P += chiP * chiP;
-        chi2_Q += chiQ * chiQ;
-
-        const CartesianVector difference(clusterFitPoint.GetPosition() - intercept);
-        rms += (direction.GetCrossProduct(difference)).GetMagnitudeSquared();
-
-        const float a(direction.GetDotProduct(difference));
-        const float l(static_cast<float>(clusterFitPoint.GetPseudoLayer()));
-        sumA += a; sumL += l; sumAL += a * l; sumLL += l * l;
-    }
+    const double chi2_P(ClusterFitHelper::GetProduct(residualP, weightedSecondMoment, residualP) -
+        2. * bP * ClusterFitHelper::GetProduct(residualP, weightedFirstMoment) + bP * bP * clusterFitAccumulator.m_weightSum);
+    const double chi2_Q(ClusterFitHelper::GetProduct(residualQ, weightedSecondMoment, residualQ) -
+        2. * bQ * ClusterFitHelper::GetProduct(residualQ, weightedFirstMoment) + bQ * bQ * clusterFitAccumulator.m_weightSum);
+
+    // Moments of the positions relative to the intercept, for the rms (|d x v|^2 = |d|^2 |v|^2 - (d.v)^2) and layer-ordering checks
+    const double interceptPosition[3] = {intercept.GetX() - reference[0], intercept.GetY() - reference[1], intercept.GetZ() - reference[2]};
+    const double directionVector[3] = {direction.GetX(), direction.GetY(), direction.GetZ()};
 
-    const double nPoints(static_cast<double>(clusterFitPointList.size()));
-    const double denominatorL(sumL * sumL - nPoints * sumLL);
+    double interceptFirstMoment[3], interceptSecondMoment[3][3];
+    ClusterFitHelper::GetCentralMoments(clusterFitAccumulator.m_positionSum, clusterFitAccumulator.m_positionProductSum, fitWeightSum,
+        interceptPosition, interceptFirstMoment, interceptSecondMoment);
+
+    const double rms(std::max(0., direction.GetMagnitudeSquared() * (interceptSecondMoment[0][0] + interceptSecondMoment[1][1] +
+        interceptSecondMoment[2][2]) - ClusterFitHelper::GetProduct(directionVector, interceptSecondMoment, directionVector)));
+
+    const double layerFirstMoment[3] = {clusterFitAccumulator.m_layerPositionSum[0] - interceptPosition[0] * clusterFitAccumulator.m_layerSum,
+        clusterFitAccumulator.m_layerPositionSum[1] - interceptPosition[1] * clusterFitAccumulator.m_layerSum,
+        clusterFitAccumulator.m_layerPositionSum[2] - interceptPosition[2] * clusterFitAccumulator.m_layerSum};
+
+    const double sumA(ClusterFitHelper::GetProduct(directionVector, interceptFirstMoment));
+    const double sumL(clusterFitAccumulator.m_layerSum);
+    const double sumAL(ClusterFitHelper::GetProduct(directionVector, layerFirstMoment));
+    const double sumLL(clusterFitAccumulator.m_layerSquaredSum);
+
+    const double denominatorL(sumL * sumL - fitWeightSum * sumLL);
 
     if (std::fabs(denominatorL) > std::numeric_limits<double>::epsilon())
     {
-        if (0. > ((sumL * sumA - nPoints * sumAL) / denominatorL))
+        if (0. > ((sumL * sumA - fitWeightSum * sumAL) / denominatorL))
             direction = direction * -1.f;
     }
 
     clusterFitResult.SetDirection(direction);
     clusterFitResult.SetIntercept(intercept);
-    clusterFitResult.SetChi2(static_cast<float>((chi2_P + chi2_Q) / nPoints));
-    clusterFitResult.SetRms(static_cast<float>(std::sqrt(rms / nPoints)));
+    clusterFitResult.SetChi2(static_cast<float>((chi2_P + chi2_Q) / fitWeightSum));
+    clusterFitResult.SetRms(static_cast<float>(std::sqrt(rms / fitWeightSum)));
     clusterFitResult.SetRadialDirectionCosine(dirCosR);
     clusterFitResult.SetSuccessFlag(true);
 
     return STATUS_CODE_SUCCESS;
 }
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void ClusterFitHelper::GetRotationMatrix(const CartesianVector &centralDirection, double rotation[3][3])
+{
+    const CartesianVector chosenAxis(0.f, 0.f, 1.f);
+    const double cosTheta(centralDirection.GetCosOpeningAngle(chosenAxis));
+    const double sinTheta(std::sin(std::acos(cosTheta)));
+
+    const CartesianVector rotationAxis((std::fabs(cosTheta) > 0.99) ? CartesianVector(1.f, 0.f, 0.f) :
+        centralDirection.GetCrossProduct(chosenAxis).GetUnitVector());
+
+    const double axis[3] = {rotationAxis.GetX(), rotationAxis.GetY(), rotationAxis.GetZ()};
+
+    rotation[0][0] = cosTheta + axis[0] * axis[0] * (1. - cosTheta);
+    rotation[0][1] = axis[0] * axis[1] * (1. - cosTheta) - axis[2] * sinTheta;
+    rotation[0][2] = axis[0] * axis[2] * (1. - cosTheta) + axis[1] * sinTheta;
+    rotation[1][0] = axis[1] * axis[0] * (1. - cosTheta) + axis[2] * sinTheta;
+    rotation[1][1] = cosTheta + axis[1] * axis[1] * (1. - cosTheta);
+    rotation[1][2] = axis[1] * axis[2] * (1. - cosTheta) - axis[0] * sinTheta;
+    rotation[2][0] = axis[2] * axis[0] * (1. - cosTheta) - axis[1] * sinTheta;
+    rotation[2][1] = axis[2] * axis[1] * (1. - cosTheta) + axis[0] * sinTheta;
+    rotation[2][2] = cosTheta + axis[2] * axis[2] * (1. - cosTheta);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void ClusterFitHelper::GetCentralMoments(const double sum[3], const double productSum[3][3], const double weightSum, const double centre[3],
+    double firstMoment[3], double secondMoment[3][3])
+{
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        firstMoment[i] = sum[i] - weightSum * centre[i];
+
+        for (unsigned int j = 0; j < 3; ++j)
+            secondMoment[i][j] = productSum[i][j] - sum[i] * centre[j] - centre[i] * sum[j] + weightSum * centre[i] * centre[j];
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+double ClusterFitHelper::GetProduct(const double lhs[3], const double rhs[3])
+{
+    return (lhs[0] * rhs[0] + lhs[1] * rhs[1] + lhs[2] * rhs[2]);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+double ClusterFitHelper::GetProduct(const double lhs[3], const double matrix[3][3], const double rhs[3])
+{
+    double product(0.);
+
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        for (unsigned int j = 0; j < 3; ++j)
+            product += lhs[i] * matrix[i][j] * rhs[j];
+    }
+
+    return product;
+}
+
 //------------------------------------------------------------------------------------------------------------------------------------------
 //------------------------------------------------------------------------------------------------------------------------------------------
 
@@ -413,4 +483,195 @@ bool ClusterFitPoint::operator<(const ClusterFitPoint &rhs) const
     return (this->GetEnergy() > rhs.GetEnergy());
 }
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+ClusterFitAccumulator::ClusterFitAccumulator()
+{
+    this->Reset();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void ClusterFitAccumulator::Add(const ClusterFitPoint &clusterFitPoint)
+{
+    this->Accumulate(clusterFitPoint.GetPosition(), clusterFitPoint.GetCellNormalVector(), clusterFitPoint.GetCellSize(), clusterFitPoint.GetEnergy(),
+        clusterFitPoint.GetPseudoLayer(), 1., 1.);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void ClusterFitAccumulator::Add(const ClusterFitPoint &clusterFitPoint, const float fitWeight)
+{
+    if (fitWeight < 0.f)
+    {
+        ++m_nInvalidPoints;
+        return;
+    }
+
+    this->Accumulate(clusterFitPoint.GetPosition(), clusterFitPoint.GetCellNormalVector(), clusterFitPoint.GetCellSize(), clusterFitPoint.GetEnergy(),
+        clusterFitPoint.GetPseudoLayer(), 1., fitWeight);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void ClusterFitAccumulator::Remove(const ClusterFitPoint &clusterFitPoint)
+{
+    this->Accumulate(clusterFitPoint.GetPosition(), clusterFitPoint.GetCellNormalVector(), clusterFitPoint.GetCellSize(), clusterFitPoint.GetEnergy(),
+        clusterFitPoint.GetPseudoLayer(), -1., 1.);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void ClusterFitAccumulator::Add(const CaloHit *const pCaloHit)
+{
+    if (pCaloHit->GetCellLengthScale() < std::numeric_limits<float>::epsilon())
+    {
+        ++m_nInvalidPoints;
+        return;
+    }
+
+    this->Accumulate(pCaloHit->GetPositionVector(), pCaloHit->GetCellNormalVector(), pCaloHit->GetCellLengthScale(), pCaloHit->GetInputEnergy(),
+        pCaloHit->GetPseudoLayer(), 1., 1.);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void ClusterFitAccumulator::Remove(const CaloHit *const pCaloHit)
+{
+    if (pCaloHit->GetCellLengthScale() < std::numeric_limits<float>::epsilon())
+    {
+        --m_nInvalidPoints;
+        return;
+    }
+
+    this->Accumulate(pCaloHit->GetPositionVector(), pCaloHit->GetCellNormalVector(), pCaloHit->GetCellLengthScale(), pCaloHit->GetInputEnergy(),
+        pCaloHit->GetPseudoLayer(), -1., 1.);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+ClusterFitAccumulator &ClusterFitAccumulator::operator+=(const ClusterFitAccumulator &rhs)
+{
+    if (!m_hasReferencePosition && rhs.m_hasReferencePosition)
+    {
+        m_hasReferencePosition = true;
+
+        for (unsigned int i = 0; i < 3; ++i)
+            m_referencePosition[i] = rhs.m_referencePosition[i];
+    }
+
+    // Move the rhs sums from the rhs reference position to this reference position, using x - a = (x - b) + (b - a)
+    double shift[3] = {0., 0., 0.};
+
+    if (rhs.m_hasReferencePosition)
+    {
+        for (unsigned int i = 0; i < 3; ++i)
+            shift[i] = rhs.m_referencePosition[i] - m_referencePosition[i];
+    }
+
+    m_nPoints += rhs.m_nPoints;
+    m_nInvalidPoints += rhs.m_nInvalidPoints;
+    m_fitWeightSum += rhs.m_fitWeightSum;
+    m_weightSum += rhs.m_weightSum;
+    m_layerSum += rhs.m_layerSum;
+    m_layerSquaredSum += rhs.m_layerSquaredSum;
+    m_cellSizeSum += rhs.m_cellSizeSum;
+    m_energySum += rhs.m_energySum;
+
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        m_positionSum[i] += rhs.m_positionSum[i] + rhs.m_fitWeightSum * shift[i];
+        m_weightedPositionSum[i] += rhs.m_weightedPositionSum[i] + rhs.m_weightSum * shift[i];
+        m_layerPositionSum[i] += rhs.m_layerPositionSum[i] + rhs.m_layerSum * shift[i];
+        m_cellNormalVectorSum[i] += rhs.m_cellNormalVectorSum[i];
+
+        for (unsigned int j = 0; j < 3; ++j)
+        {
+            m_positionProductSum[i][j] += rhs.m_positionProductSum[i][j] + rhs.m_positionSum[i] * shift[j] + shift[i] * rhs.m_positionSum[j] +
+                rhs.m_fitWeightSum * shift[i] * shift[j];
+            m_weightedPositionProductSum[i][j] += rhs.m_weightedPositionProductSum[i][j] + rhs.m_weightedPositionSum[i] * shift[j] +
+                shift[i] * rhs.m_weightedPositionSum[j] + rhs.m_weightSum * shift[i] * shift[j];
+        }
+    }
+
+    return *this;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void ClusterFitAccumulator::Reset()
+{
+    m_nPoints = 0;
+    m_nInvalidPoints = 0;
+    m_hasReferencePosition = false;
+    m_fitWeightSum = 0.;
+    m_weightSum = 0.;
+    m_layerSum = 0.;
+    m_layerSquaredSum = 0.;
+    m_cellSizeSum = 0.;
+    m_energySum = 0.;
+
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        m_referencePosition[i] = 0.;
+        m_positionSum[i] = 0.;
+        m_weightedPositionSum[i] = 0.;
+        m_layerPositionSum[i] = 0.;
+        m_cellNormalVectorSum[i] = 0.;
+
+        for (unsigned int j = 0; j < 3; ++j)
+        {
+            m_positionProductSum[i][j] = 0.;
+            m_weightedPositionProductSum[i][j] = 0.;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void ClusterFitAccumulator::Accumulate(const CartesianVector &position, const CartesianVector &cellNormalVector, const float cellSize,
+    const float energy, const unsigned int pseudoLayer, const double scale, const double fitWeight)
+{
+    if (!m_hasReferencePosition)
+    {
+        m_hasReferencePosition = true;
+        m_referencePosition[0] = position.GetX();
+        m_referencePosition[1] = position.GetY();
+        m_referencePosition[2] = position.GetZ();
+    }
+
+    const double xyz[3] = {position.GetX() - m_referencePosition[0], position.GetY() - m_referencePosition[1],
+        position.GetZ() - m_referencePosition[2]};
+    const double error(cellSize / 3.46);
+    const double layer(static_cast<double>(pseudoLayer));
+    const double signedFitWeight(scale * fitWeight);
+    const double weight(signedFitWeight / (error * error));
+
+    m_nPoints += ((scale > 0.) ? 1 : -1);
+    m_fitWeightSum += signedFitWeight;
+    m_weightSum += weight;
+    m_layerSum += signedFitWeight * layer;
+    m_layerSquaredSum += signedFitWeight * layer * layer;
+    m_cellSizeSum += scale * cellSize;
+    m_energySum += scale * energy;
+
+    m_cellNormalVectorSum[0] += scale * cellNormalVector.GetX();
+    m_cellNormalVectorSum[1] += scale * cellNormalVector.GetY();
+    m_cellNormalVectorSum[2] += scale * cellNormalVector.GetZ();
+
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        m_positionSum[i] += signedFitWeight * xyz[i];
+        m_weightedPositionSum[i] += weight * xyz[i];
+        m_layerPositionSum[i] += signedFitWeight * layer * xyz[i];
+
+        for (unsigned int j = 0; j < 3; ++j)
+        {
+            m_positionProductSum[i][j] += signedFitWeight * xyz[i] * xyz[j];
+            m_weightedPositionProductSum[i][j] += weight * xyz[i] * xyz[j];
+        }
+    }
+}
+
 } // namespace pandora
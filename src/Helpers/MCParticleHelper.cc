@@ -23,24 +23,7 @@ namespace pandora
 template <typename T>
 const MCParticle *MCParticleHelper::GetMainMCParticle(const T *const pT)
 {
-    float bestWeight(0.f);
-    const MCParticle *pBestMCParticle(nullptr);
-    const MCParticleWeightMap &hitMCParticleWeightMap(pT->GetMCParticleWeightMap());
-
-    MCParticleVector mcParticleVector;
-    for (const MCParticleWeightMap::value_type &mapEntry : hitMCParticleWeightMap) mcParticleVector.push_back(mapEntry.first);
-    std::sort(mcParticleVector.begin(), mcParticleVector.end(), PointerLessThan<MCParticle>());
-
-    for (const MCParticle *const pMCParticle : mcParticleVector)
-    {
-        const float weight(hitMCParticleWeightMap.at(pMCParticle));
-
-        if (weight > bestWeight)
-        {
-            bestWeight = weight;
-            pBestMCParticle = pMCParticle;
-        }
-    }
+    const MCParticle *const pBestMCParticle(pT->GetMainMCParticle());
 
     if (!pBestMCParticle)
         throw StatusCodeException(STATUS_CODE_NOT_INITIALIZED);
@@ -50,10 +33,47 @@ const MCParticle *MCParticleHelper::GetMainMCParticle(const T *const pT)
 
 template <>
 const MCParticle *MCParticleHelper::GetMainMCParticle(const CaloHitList *const pCaloHitList)
+{
+    return MCParticleHelper::GetMainMCParticleFromCaloHits(*pCaloHitList);
+}
+
+template <>
+const MCParticle *MCParticleHelper::GetMainMCParticle(const Cluster *const pCluster)
+{
+    return MCParticleHelper::GetMainMCParticleFromCaloHits(pCluster->GetOrderedCaloHitList().GetCaloHitRange());
+}
+
+template <>
+const MCParticle *MCParticleHelper::GetMainMCParticle(const ClusterList *const pClusterList)
+{
+    CaloHitVector caloHitVector;
+
+    for (const Cluster *const pCluster : *pClusterList)
+        pCluster->GetOrderedCaloHitList().FillCaloHitVector(caloHitVector);
+
+    return MCParticleHelper::GetMainMCParticleFromCaloHits(caloHitVector);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+void MCParticleHelper::GetMainMCParticles(const T *const pTList, MCParticleVector &mainMCParticleVector)
+{
+    mainMCParticleVector.clear();
+    mainMCParticleVector.reserve(pTList->size());
+
+    for (const auto *const pT : *pTList)
+        mainMCParticleVector.push_back(pT->GetMainMCParticle());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+const MCParticle *MCParticleHelper::GetMainMCParticleFromCaloHits(const T &caloHits)
 {
     MCParticleWeightMap mcParticleWeightMap;
 
-    for (const CaloHit *const pCaloHit : *pCaloHitList)
+    for (const CaloHit *const pCaloHit : caloHits)
     {
         const MCParticleWeightMap &hitMCParticleWeightMap(pCaloHit->GetMCParticleWeightMap());
 
@@ -92,24 +112,24 @@ const MCParticle *MCParticleHelper::GetMainMCParticle(const CaloHitList *const p
     return pBestMCParticle;
 }
 
-template <>
-const MCParticle *MCParticleHelper::GetMainMCParticle(const Cluster *const pCluster)
-{
-    CaloHitList caloHitList;
-    pCluster->GetOrderedCaloHitList().FillCaloHitList(caloHitList);
-
-    return MCParticleHelper::GetMainMCParticle(&caloHitList);
-}
+//------------------------------------------------------------------------------------------------------------------------------------------
 
-template <>
-const MCParticle *MCParticleHelper::GetMainMCParticle(const ClusterList *const pClusterList)
+const MCParticle *MCParticleHelper::FindMainMCParticle(const MCParticleWeightMap &mcParticleWeightMap)
 {
-    CaloHitList caloHitList;
+    float bestWeight(0.f);
+    const MCParticle *pBestMCParticle(nullptr);
 
-    for (const Cluster *const pCluster : *pClusterList)
-        pCluster->GetOrderedCaloHitList().FillCaloHitList(caloHitList);
+    // ATTN Equivalent to taking the first of the highest weight mc particles, after sorting using PointerLessThan
+    for (const MCParticleWeightMap::value_type &mapEntry : mcParticleWeightMap)
+    {
+        if ((mapEntry.second > bestWeight) || (pBestMCParticle && (mapEntry.second == bestWeight) && (*mapEntry.first < *pBestMCParticle)))
+        {
+            bestWeight = mapEntry.second;
+            pBestMCParticle = mapEntry.first;
+        }
+    }
 
-    return MCParticleHelper::GetMainMCParticle(&caloHitList);
+    return pBestMCParticle;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -118,4 +138,7 @@ const MCParticle *MCParticleHelper::GetMainMCParticle(const ClusterList *const p
 template const MCParticle *MCParticleHelper::GetMainMCParticle(const CaloHit *const);
 template const MCParticle *MCParticleHelper::GetMainMCParticle(const Track *const);
 
+template void MCParticleHelper::GetMainMCParticles(const CaloHitList *const, MCParticleVector &);
+template void MCParticleHelper::GetMainMCParticles(const TrackList *const, MCParticleVector &);
+
 } // namespace pandora
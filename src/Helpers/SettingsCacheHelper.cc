@@ -0,0 +1,302 @@
+/**
+ *  @file   PandoraSDK/src/Helpers/SettingsCacheHelper.cc
+ * 
+ *  @brief  Implementation of the settings cache helper class.
+ * 
+ *  $Log: $
+ */
+
+#include "Helpers/SettingsCacheHelper.h"
+
+#include "Pandora/PandoraInternal.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace pandora
+{
+
+const std::string SETTINGS_CACHE_HASH("pandora_settings_cache"); ///< Identifies settings cache files
+const unsigned int SETTINGS_CACHE_VERSION(1);                    ///< The settings cache file format version
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+void SettingsCacheHelper::WriteValue(const T &t, std::string &cacheImage)
+{
+    cacheImage.append(reinterpret_cast<const char*>(&t), sizeof(T));
+}
+
+template <>
+void SettingsCacheHelper::WriteValue(const std::string &t, std::string &cacheImage)
+{
+    const unsigned int size(t.size());
+    SettingsCacheHelper::WriteValue(size, cacheImage);
+    cacheImage.append(t);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+bool SettingsCacheHelper::ReadValue(const std::string &cacheImage, size_t &position, T &t)
+{
+    if (sizeof(T) > cacheImage.size() - position)
+        return false;
+
+    std::memcpy(&t, cacheImage.data() + position, sizeof(T));
+    position += sizeof(T);
+    return true;
+}
+
+template <>
+bool SettingsCacheHelper::ReadValue(const std::string &cacheImage, size_t &position, std::string &t)
+{
+    unsigned int size(0);
+
+    if (!SettingsCacheHelper::ReadValue(cacheImage, position, size) || (size > cacheImage.size() - position))
+        return false;
+
+    t.assign(cacheImage, position, size);
+    position += size;
+    return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode SettingsCacheHelper::LoadSettings(const std::string &xmlFileName, const std::string &cacheFileName, TiXmlDocument &xmlDocument)
+{
+    std::string xmlContents;
+
+    if (!SettingsCacheHelper::ReadFile(xmlFileName, xmlContents))
+        return STATUS_CODE_FAILURE;
+
+    const uint64_t xmlHash(SettingsCacheHelper::GetHash(xmlContents.data(), xmlContents.size()));
+    std::string cacheImage;
+
+    if (SettingsCacheHelper::ReadFile(cacheFileName, cacheImage) && SettingsCacheHelper::ReadCacheImage(cacheImage, xmlHash, xmlDocument))
+        return STATUS_CODE_SUCCESS;
+
+    xmlDocument.Clear();
+
+    if (!xmlDocument.LoadFile(xmlFileName))
+        return STATUS_CODE_FAILURE;
+
+    if (!SettingsCacheHelper::WriteCacheImage(xmlDocument, xmlHash, cacheFileName))
+        std::cout << "SettingsCacheHelper::LoadSettings - Unable to write settings cache file " << cacheFileName << std::endl;
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool SettingsCacheHelper::ReadFile(const std::string &fileName, std::string &contents)
+{
+    std::ifstream fileStream(fileName.c_str(), std::ios::in | std::ios::binary);
+
+    if (!fileStream.is_open())
+        return false;
+
+    fileStream.seekg(0, std::ios::end);
+    const std::streamoff fileSize(fileStream.tellg());
+    fileStream.seekg(0, std::ios::beg);
+
+    if (!fileStream.good() || (fileSize < 0))
+        return false;
+
+    contents.resize(static_cast<size_t>(fileSize));
+
+    return (contents.empty() || fileStream.read(&contents[0], fileSize).good());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+uint64_t SettingsCacheHelper::GetHash(const char *const pContents, const size_t size)
+{
+    // ATTN FNV-1a style mixing, applied to whole 64-bit words where possible, bytes thereafter
+    uint64_t hash(14695981039346656037ULL ^ size);
+    size_t position(0);
+
+    for (; position + sizeof(uint64_t) <= size; position += sizeof(uint64_t))
+    {
+        uint64_t word(0);
+        std::memcpy(&word, pContents + position, sizeof(uint64_t));
+        hash = (hash ^ word) * 1099511628211ULL;
+    }
+
+    for (; position < size; ++position)
+        hash = (hash ^ static_cast<unsigned char>(pContents[position])) * 1099511628211ULL;
+
+    return hash ^ (hash >> 32);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool SettingsCacheHelper::ReadCacheImage(const std::string &cacheImage, const uint64_t xmlHash, TiXmlDocument &xmlDocument)
+{
+    size_t position(0);
+    std::string cacheHash;
+    unsigned int version(0);
+    uint64_t imageXmlHash(0), payloadHash(0);
+
+    if (!SettingsCacheHelper::ReadValue(cacheImage, position, cacheHash) || (SETTINGS_CACHE_HASH != cacheHash) ||
+        !SettingsCacheHelper::ReadValue(cacheImage, position, version) || (SETTINGS_CACHE_VERSION != version) ||
+        !SettingsCacheHelper::ReadValue(cacheImage, position, imageXmlHash) || (xmlHash != imageXmlHash) ||
+        !SettingsCacheHelper::ReadValue(cacheImage, position, payloadHash) ||
+        (payloadHash != SettingsCacheHelper::GetHash(cacheImage.data() + position, cacheImage.size() - position)))
+    {
+        return false;
+    }
+
+    xmlDocument.Clear();
+
+    if (!SettingsCacheHelper::ReadChildren(cacheImage, position, &xmlDocument) || (cacheImage.size() != position) ||
+        !xmlDocument.FirstChildElement())
+    {
+        xmlDocument.Clear();
+        return false;
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool SettingsCacheHelper::WriteCacheImage(const TiXmlDocument &xmlDocument, const uint64_t xmlHash, const std::string &cacheFileName)
+{
+    std::string payload;
+    SettingsCacheHelper::WriteChildren(&xmlDocument, payload);
+
+    std::string cacheImage;
+    SettingsCacheHelper::WriteValue(SETTINGS_CACHE_HASH, cacheImage);
+    SettingsCacheHelper::WriteValue(SETTINGS_CACHE_VERSION, cacheImage);
+    SettingsCacheHelper::WriteValue(xmlHash, cacheImage);
+    SettingsCacheHelper::WriteValue(SettingsCacheHelper::GetHash(payload.data(), payload.size()), cacheImage);
+    cacheImage.append(payload);
+
+    // ATTN Write to a temporary file, unique within the process, so concurrent readers never see a partially written cache file
+    const std::string temporaryFileName(cacheFileName + "." + TypeToString(static_cast<const void*>(&xmlDocument)) + ".tmp");
+
+    {
+        std::ofstream fileStream(temporaryFileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+
+        if (!fileStream.is_open() || !fileStream.write(cacheImage.data(), cacheImage.size()).flush())
+        {
+            std::remove(temporaryFileName.c_str());
+            return false;
+        }
+    }
+
+    if (0 != std::rename(temporaryFileName.c_str(), cacheFileName.c_str()))
+    {
+        std::remove(temporaryFileName.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void SettingsCacheHelper::WriteChildren(const TiXmlNode *const pXmlNode, std::string &cacheImage)
+{
+    unsigned int nChildren(0);
+
+    for (const TiXmlNode *pChild = pXmlNode->FirstChild(); nullptr != pChild; pChild = pChild->NextSibling())
+    {
+        if (pChild->ToElement() || pChild->ToText())
+            ++nChildren;
+    }
+
+    SettingsCacheHelper::WriteValue(nChildren, cacheImage);
+
+    for (const TiXmlNode *pChild = pXmlNode->FirstChild(); nullptr != pChild; pChild = pChild->NextSibling())
+    {
+        const TiXmlText *const pXmlText(pChild->ToText());
+
+        if (pXmlText)
+        {
+            SettingsCacheHelper::WriteValue(static_cast<unsigned char>(pXmlText->CDATA() ? CDATA_NODE : TEXT_NODE), cacheImage);
+            SettingsCacheHelper::WriteValue(pXmlText->ValueStr(), cacheImage);
+            continue;
+        }
+
+        const TiXmlElement *const pXmlElement(pChild->ToElement());
+
+        if (!pXmlElement)
+            continue;
+
+        unsigned int nAttributes(0);
+
+        for (const TiXmlAttribute *pAttribute = pXmlElement->FirstAttribute(); nullptr != pAttribute; pAttribute = pAttribute->Next())
+            ++nAttributes;
+
+        SettingsCacheHelper::WriteValue(static_cast<unsigned char>(ELEMENT_NODE), cacheImage);
+        SettingsCacheHelper::WriteValue(pXmlElement->ValueStr(), cacheImage);
+        SettingsCacheHelper::WriteValue(nAttributes, cacheImage);
+
+        for (const TiXmlAttribute *pAttribute = pXmlElement->FirstAttribute(); nullptr != pAttribute; pAttribute = pAttribute->Next())
+        {
+            SettingsCacheHelper::WriteValue(pAttribute->NameTStr(), cacheImage);
+            SettingsCacheHelper::WriteValue(pAttribute->ValueStr(), cacheImage);
+        }
+
+        SettingsCacheHelper::WriteChildren(pXmlElement, cacheImage);
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool SettingsCacheHelper::ReadChildren(const std::string &cacheImage, size_t &position, TiXmlNode *const pXmlNode)
+{
+    unsigned int nChildren(0);
+
+    if (!SettingsCacheHelper::ReadValue(cacheImage, position, nChildren))
+        return false;
+
+    for (unsigned int iChild = 0; iChild < nChildren; ++iChild)
+    {
+        unsigned char nodeType(0);
+        std::string value;
+
+        if (!SettingsCacheHelper::ReadValue(cacheImage, position, nodeType) || !SettingsCacheHelper::ReadValue(cacheImage, position, value))
+            return false;
+
+        if ((TEXT_NODE == nodeType) || (CDATA_NODE == nodeType))
+        {
+            TiXmlText *const pXmlText(new TiXmlText(value));
+            pXmlText->SetCDATA(CDATA_NODE == nodeType);
+            pXmlNode->LinkEndChild(pXmlText);
+            continue;
+        }
+
+        if (ELEMENT_NODE != nodeType)
+            return false;
+
+        TiXmlElement *const pXmlElement(new TiXmlElement(value));
+        pXmlNode->LinkEndChild(pXmlElement);
+
+        unsigned int nAttributes(0);
+
+        if (!SettingsCacheHelper::ReadValue(cacheImage, position, nAttributes))
+            return false;
+
+        for (unsigned int iAttribute = 0; iAttribute < nAttributes; ++iAttribute)
+        {
+            std::string name, attributeValue;
+
+            if (!SettingsCacheHelper::ReadValue(cacheImage, position, name) || !SettingsCacheHelper::ReadValue(cacheImage, position, attributeValue))
+                return false;
+
+            pXmlElement->SetAttribute(name, attributeValue);
+        }
+
+        if (!SettingsCacheHelper::ReadChildren(cacheImage, position, pXmlElement))
+            return false;
+    }
+
+    return true;
+}
+
+} // namespace pandora
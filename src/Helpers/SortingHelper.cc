@@ -0,0 +1,112 @@
+/**
+ *  @file   PandoraSDK/src/Helpers/SortingHelper.cc
+ *
+ *  @brief  Implementation of the sorting helper class.
+ *
+ *  $Log: $
+ */
+
+#include "Helpers/SortingHelper.h"
+
+#include "Objects/CaloHit.h"
+#include "Objects/CartesianVector.h"
+#include "Objects/MCParticle.h"
+#include "Objects/Track.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace pandora
+{
+
+uint64_t SortingHelper::GetPositionSortKey(const CartesianVector &position)
+{
+    return ((static_cast<uint64_t>(SortingHelper::GetOrderedBits(position.GetZ())) << 32) |
+        static_cast<uint64_t>(SortingHelper::GetOrderedBits(position.GetX())));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+void SortingHelper::SortByKey(std::vector<const T*> &objectVector)
+{
+    // ATTN Below this size, the fixed cost of the radix passes exceeds that of a comparison sort on the cached keys
+    static const unsigned int minRadixSortSize(64);
+
+    if (objectVector.size() < minRadixSortSize)
+    {
+        std::stable_sort(objectVector.begin(), objectVector.end(), SortKeyLessThan<T>());
+        return;
+    }
+
+    static const unsigned int nBitsPerDigit(8);
+    static const unsigned int nBuckets(1 << nBitsPerDigit);
+    static const unsigned int nDigits(64 / nBitsPerDigit);
+
+    std::vector<uint64_t> keyVector, sortedKeyVector(objectVector.size());
+    std::vector<const T*> sortedObjectVector(objectVector.size());
+    keyVector.reserve(objectVector.size());
+
+    uint64_t keyOr(0), keyAnd(~static_cast<uint64_t>(0));
+
+    for (const T *const pT : objectVector)
+    {
+        const uint64_t key(pT->GetSortKey());
+        keyVector.push_back(key);
+        keyOr |= key;
+        keyAnd &= key;
+    }
+
+    for (unsigned int iDigit = 0; iDigit < nDigits; ++iDigit)
+    {
+        const unsigned int shift(iDigit * nBitsPerDigit);
+
+        // ATTN A digit shared by all keys cannot change the order, so its pass is skipped
+        if (0 == (((keyOr ^ keyAnd) >> shift) & (nBuckets - 1)))
+            continue;
+
+        unsigned int bucketOffsets[nBuckets] = {0};
+
+        for (const uint64_t key : keyVector)
+            ++bucketOffsets[(key >> shift) & (nBuckets - 1)];
+
+        unsigned int offset(0);
+
+        for (unsigned int &bucketOffset : bucketOffsets)
+        {
+            const unsigned int nEntries(bucketOffset);
+            bucketOffset = offset;
+            offset += nEntries;
+        }
+
+        for (unsigned int iEntry = 0, nEntries = keyVector.size(); iEntry < nEntries; ++iEntry)
+        {
+            const unsigned int position(bucketOffsets[(keyVector[iEntry] >> shift) & (nBuckets - 1)]++);
+            sortedKeyVector[position] = keyVector[iEntry];
+            sortedObjectVector[position] = objectVector[iEntry];
+        }
+
+        keyVector.swap(sortedKeyVector);
+        objectVector.swap(sortedObjectVector);
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+uint32_t SortingHelper::GetOrderedBits(const float value)
+{
+    uint32_t bits(0);
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    // ATTN Negative values have their order reversed by inverting all bits, and positive values are moved above them
+    return ((bits & 0x80000000u) ? ~bits : (bits | 0x80000000u));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template void SortingHelper::SortByKey(CaloHitVector &);
+template void SortingHelper::SortByKey(TrackVector &);
+template void SortingHelper::SortByKey(MCParticleVector &);
+
+} // namespace pandora
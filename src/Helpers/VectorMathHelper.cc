@@ -0,0 +1,180 @@
+/**
+ *  @file   PandoraSDK/src/Helpers/VectorMathHelper.cc
+ *
+ *  @brief  Implementation of the vector math helper class.
+ *
+ *  $Log: $
+ */
+
+#include "Helpers/VectorMathHelper.h"
+
+#include "Objects/CaloHitSnapshot.h"
+#include "Objects/CartesianVector.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace pandora
+{
+
+void VectorMathHelper::GetDotProducts(const FloatVector &x, const FloatVector &y, const FloatVector &z, const CartesianVector &vector,
+    FloatVector &dotProducts)
+{
+    const unsigned int nEntries(x.size());
+
+    if ((y.size() != nEntries) || (z.size() != nEntries))
+        throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
+
+    dotProducts.resize(nEntries);
+
+    const float *const pX(x.data()), *const pY(y.data()), *const pZ(z.data());
+    const float vectorX(vector.GetX()), vectorY(vector.GetY()), vectorZ(vector.GetZ());
+    float *const pDotProducts(dotProducts.data());
+
+    for (unsigned int i = 0; i < nEntries; ++i)
+        pDotProducts[i] = pX[i] * vectorX + pY[i] * vectorY + pZ[i] * vectorZ;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void VectorMathHelper::GetDistancesSquared(const FloatVector &x, const FloatVector &y, const FloatVector &z, const CartesianVector &position,
+    FloatVector &distancesSquared)
+{
+    const unsigned int nEntries(x.size());
+
+    if ((y.size() != nEntries) || (z.size() != nEntries))
+        throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
+
+    distancesSquared.resize(nEntries);
+
+    const float *const pX(x.data()), *const pY(y.data()), *const pZ(z.data());
+    const float positionX(position.GetX()), positionY(position.GetY()), positionZ(position.GetZ());
+    float *const pDistancesSquared(distancesSquared.data());
+
+    for (unsigned int i = 0; i < nEntries; ++i)
+    {
+        const float dX(pX[i] - positionX), dY(pY[i] - positionY), dZ(pZ[i] - positionZ);
+        pDistancesSquared[i] = dX * dX + dY * dY + dZ * dZ;
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void VectorMathHelper::GetDistancesSquared(const CaloHitSnapshot &caloHitSnapshot, const CartesianVector &position, FloatVector &distancesSquared)
+{
+    VectorMathHelper::GetDistancesSquared(caloHitSnapshot.GetX(), caloHitSnapshot.GetY(), caloHitSnapshot.GetZ(), position, distancesSquared);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void VectorMathHelper::GetCrossProducts(const FloatVector &x, const FloatVector &y, const FloatVector &z, const CartesianVector &vector,
+    FloatVector &crossX, FloatVector &crossY, FloatVector &crossZ)
+{
+    const unsigned int nEntries(x.size());
+
+    if ((y.size() != nEntries) || (z.size() != nEntries))
+        throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
+
+    crossX.resize(nEntries);
+    crossY.resize(nEntries);
+    crossZ.resize(nEntries);
+
+    const float *const pX(x.data()), *const pY(y.data()), *const pZ(z.data());
+    const float vectorX(vector.GetX()), vectorY(vector.GetY()), vectorZ(vector.GetZ());
+    float *const pCrossX(crossX.data()), *const pCrossY(crossY.data()), *const pCrossZ(crossZ.data());
+
+    for (unsigned int i = 0; i < nEntries; ++i)
+    {
+        pCrossX[i] = pY[i] * vectorZ - vectorY * pZ[i];
+        pCrossY[i] = pZ[i] * vectorX - vectorZ * pX[i];
+        pCrossZ[i] = pX[i] * vectorY - vectorX * pY[i];
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void VectorMathHelper::GetCosOpeningAngles(const FloatVector &x, const FloatVector &y, const FloatVector &z, const CartesianVector &vector,
+    FloatVector &cosOpeningAngles)
+{
+    const unsigned int nEntries(x.size());
+
+    if ((y.size() != nEntries) || (z.size() != nEntries))
+        throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
+
+    cosOpeningAngles.resize(nEntries);
+
+    const float *const pX(x.data()), *const pY(y.data()), *const pZ(z.data());
+    const float vectorX(vector.GetX()), vectorY(vector.GetY()), vectorZ(vector.GetZ());
+    const float vectorMagnitudeSquared(vector.GetMagnitudeSquared());
+    float *const pCosOpeningAngles(cosOpeningAngles.data());
+    unsigned int nInvalidEntries(0);
+
+    // ATTN Same operation order as CartesianVector::GetCosOpeningAngle, so that results are identical
+    for (unsigned int i = 0; i < nEntries; ++i)
+    {
+        const float magnitudesSquared((pX[i] * pX[i] + pY[i] * pY[i] + pZ[i] * pZ[i]) * vectorMagnitudeSquared);
+        nInvalidEntries += (magnitudesSquared < std::numeric_limits<float>::epsilon()) ? 1 : 0;
+
+        const float cosTheta((pX[i] * vectorX + pY[i] * vectorY + pZ[i] * vectorZ) / std::sqrt(magnitudesSquared));
+        pCosOpeningAngles[i] = (cosTheta > 1.f) ? 1.f : (cosTheta < -1.f) ? -1.f : cosTheta;
+    }
+
+    if (nInvalidEntries > 0)
+        throw StatusCodeException(STATUS_CODE_NOT_INITIALIZED);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void VectorMathHelper::GetCosOpeningAngles(const CaloHitSnapshot &caloHitSnapshot, const CartesianVector &origin, const CartesianVector &direction,
+    FloatVector &cosOpeningAngles)
+{
+    const unsigned int nEntries(caloHitSnapshot.size());
+    FloatVector displacementX(nEntries), displacementY(nEntries), displacementZ(nEntries);
+
+    const float *const pX(caloHitSnapshot.GetX().data()), *const pY(caloHitSnapshot.GetY().data()), *const pZ(caloHitSnapshot.GetZ().data());
+    const float originX(origin.GetX()), originY(origin.GetY()), originZ(origin.GetZ());
+
+    for (unsigned int i = 0; i < nEntries; ++i)
+    {
+        displacementX[i] = pX[i] - originX;
+        displacementY[i] = pY[i] - originY;
+        displacementZ[i] = pZ[i] - originZ;
+    }
+
+    VectorMathHelper::GetCosOpeningAngles(displacementX, displacementY, displacementZ, direction, cosOpeningAngles);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+float VectorMathHelper::GetApproximateInverseSqrt(const float value)
+{
+    uint32_t bits(0);
+    std::memcpy(&bits, &value, sizeof(float));
+    bits = 0x5f375a86u - (bits >> 1);
+
+    float estimate(0.f);
+    std::memcpy(&estimate, &bits, sizeof(float));
+
+    const float halfValue(0.5f * value);
+    estimate = estimate * (1.5f - halfValue * estimate * estimate);
+    estimate = estimate * (1.5f - halfValue * estimate * estimate);
+
+    return estimate;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+float VectorMathHelper::GetApproximateAcos(const float value)
+{
+    static const float pi(std::acos(-1.f));
+    const float clampedValue((value > 1.f) ? 1.f : (value < -1.f) ? -1.f : value);
+    const float absValue(std::fabs(clampedValue));
+
+    const float result(std::sqrt(1.f - absValue) * (1.5707288f + absValue * (-0.2121144f + absValue * (0.0742610f + absValue * -0.0187293f))));
+
+    return (clampedValue < 0.f) ? (pi - result) : result;
+}
+
+} // namespace pandora
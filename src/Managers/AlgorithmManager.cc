@@ -46,10 +46,14 @@ AlgorithmManager::~AlgorithmManager()
     for (AlgorithmToolFactoryMap::value_type &mapEntry : m_algorithmToolFactoryMap)
         delete mapEntry.second;
 
+    for (AlgorithmToolXmlMap::value_type &mapEntry : m_algorithmToolXmlMap)
+        delete mapEntry.second;
+
     m_algorithmMap.clear();
     m_algorithmFactoryMap.clear();
     m_algorithmToolVector.clear();
     m_algorithmToolFactoryMap.clear();
+    m_algorithmToolXmlMap.clear();
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -177,6 +181,10 @@ StatusCode AlgorithmManager::CreateAlgorithmTool(TiXmlElement *const pXmlElement
         PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, pLocalAlgorithmTool->ReadSettings(TiXmlHandle(pXmlElement)));
         PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, pLocalAlgorithmTool->Initialize());
 
+        // ATTN The xml document is not retained after initialization, so keep a copy of the settings for any later clones
+        if (pLocalAlgorithmTool->IsCloneable())
+            m_algorithmToolXmlMap[pLocalAlgorithmTool] = pXmlElement->Clone()->ToElement();
+
         m_algorithmToolVector.push_back(pLocalAlgorithmTool);
         pAlgorithmTool = pLocalAlgorithmTool;
     }
@@ -191,6 +199,24 @@ StatusCode AlgorithmManager::CreateAlgorithmTool(TiXmlElement *const pXmlElement
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+StatusCode AlgorithmManager::CloneAlgorithmTool(const AlgorithmTool *const pAlgorithmTool, AlgorithmTool *&pAlgorithmToolClone)
+{
+    if (!pAlgorithmTool)
+        return STATUS_CODE_INVALID_PARAMETER;
+
+    if (!pAlgorithmTool->IsCloneable())
+        return STATUS_CODE_NOT_ALLOWED;
+
+    AlgorithmToolXmlMap::const_iterator iter = m_algorithmToolXmlMap.find(pAlgorithmTool);
+
+    if (m_algorithmToolXmlMap.end() == iter)
+        return STATUS_CODE_NOT_FOUND;
+
+    return this->CreateAlgorithmTool(iter->second, pAlgorithmToolClone);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 StatusCode AlgorithmManager::FindSpecificAlgorithmInstance(TiXmlElement *const pXmlElement, std::string &algorithmName, std::string &xmlInstanceLabel) const
 {
     try
@@ -225,10 +251,16 @@ StatusCode AlgorithmManager::FindSpecificAlgorithmInstance(TiXmlElement *const p
 StatusCode AlgorithmManager::ResetForNextEvent()
 {
     for (AlgorithmMap::value_type &mapEntry : m_algorithmMap)
+    {
+        mapEntry.second->GetScratchArena().Clear();
         PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, mapEntry.second->Reset());
+    }
 
     for (AlgorithmTool *const pAlgorithmTool : m_algorithmToolVector)
+    {
+        pAlgorithmTool->GetScratchArena().Clear();
         PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, pAlgorithmTool->Reset());
+    }
 
     return STATUS_CODE_SUCCESS;
 }
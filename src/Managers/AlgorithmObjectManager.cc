@@ -12,7 +12,11 @@
 #include "Objects/ParticleFlowObject.h"
 #include "Objects/Vertex.h"
 
+#include "Pandora/HotPathCounters.h"
+
 #include <algorithm>
+#include <iterator>
+#include <unordered_set>
 
 namespace pandora
 {
@@ -20,7 +24,9 @@ namespace pandora
 template<typename T>
 AlgorithmObjectManager<T>::AlgorithmObjectManager(const Pandora *const pPandora) :
     Manager<T>(pPandora),
-    m_canMakeNewObjects(false)
+    m_canMakeNewObjects(false),
+    m_nObjectsDeleted(0),
+    m_nObjectsDetached(0)
 {
 }
 
@@ -60,6 +66,8 @@ StatusCode AlgorithmObjectManager<T>::MoveObjectsToTemporaryListAndSetCurrent(co
 template<typename T>
 StatusCode AlgorithmObjectManager<T>::SaveObjects(const std::string &targetListName, const std::string &sourceListName)
 {
+    PANDORA_INCREMENT_HOT_PATH_COUNTER(HOT_PATH_SAVE_OBJECTS);
+
     typename Manager<T>::NameToListMap::iterator targetObjectListIter = Manager<T>::m_nameToListMap.find(targetListName);
 
     if (Manager<T>::m_nameToListMap.end() == targetObjectListIter)
@@ -76,6 +84,8 @@ StatusCode AlgorithmObjectManager<T>::SaveObjects(const std::string &targetListN
 template<typename T>
 StatusCode AlgorithmObjectManager<T>::SaveObjects(const std::string &targetListName, const std::string &sourceListName, const ObjectList &objectsToSave)
 {
+    PANDORA_INCREMENT_HOT_PATH_COUNTER(HOT_PATH_SAVE_OBJECTS);
+
     if (objectsToSave.empty())
         return STATUS_CODE_NOT_INITIALIZED;
 
@@ -112,15 +122,16 @@ StatusCode AlgorithmObjectManager<T>::MoveObjectsBetweenLists(const std::string
     if (Manager<T>::m_nameToListMap.end() == targetListIter)
         return STATUS_CODE_FAILURE;
 
+    // ATTN Each algorithm object resides in a single managed list, so objects in the source list cannot already be in a distinct target list
     if (!pObjectSubset)
     {
-        for (const T *const pT : *sourceListIter->second)
-        {
-            if (targetListIter->second->end() != std::find(targetListIter->second->begin(), targetListIter->second->end(), pT))
-                return STATUS_CODE_ALREADY_PRESENT;
+        if (targetListIter->second == sourceListIter->second)
+            return STATUS_CODE_ALREADY_PRESENT;
 
-            targetListIter->second->push_back(pT);
-        }
+        this->RemoveObjectPositions(*sourceListIter->second);
+
+        for (const T *const pT : *sourceListIter->second)
+            PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->AddObjectToList(targetListIter->second, pT));
 
         sourceListIter->second->clear();
     }
@@ -131,16 +142,14 @@ StatusCode AlgorithmObjectManager<T>::MoveObjectsBetweenLists(const std::string
 
         for (const T *const pT : *pObjectSubset)
         {
-            typename ObjectList::iterator objectIter = std::find(sourceListIter->second->begin(), sourceListIter->second->end(), pT);
-
-            if (sourceListIter->second->end() == objectIter)
+            if (!this->IsObjectInList(sourceListIter->second, pT))
                 return STATUS_CODE_NOT_FOUND;
 
-            if (targetListIter->second->end() != std::find(targetListIter->second->begin(), targetListIter->second->end(), pT))
+            if (targetListIter->second == sourceListIter->second)
                 return STATUS_CODE_ALREADY_PRESENT;
 
-            targetListIter->second->push_back(pT);
-            objectIter = sourceListIter->second->erase(objectIter);
+            PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->RemoveObjectFromList(sourceListIter->second, pT));
+            PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->AddObjectToList(targetListIter->second, pT));
         }
     }
 
@@ -158,6 +167,7 @@ StatusCode AlgorithmObjectManager<T>::TemporarilyReplaceCurrentList(const std::s
 
     m_canMakeNewObjects = false;
     Manager<T>::m_currentListName = listName;
+    Manager<T>::m_pCurrentList = nullptr;
     return STATUS_CODE_SUCCESS;
 }
 
@@ -171,13 +181,10 @@ StatusCode AlgorithmObjectManager<T>::DeleteObject(const T *const pT, const std:
     if (Manager<T>::m_nameToListMap.end() == listIter)
         return STATUS_CODE_NOT_FOUND;
 
-    typename ObjectList::iterator deletionIter = std::find(listIter->second->begin(), listIter->second->end(), pT);
-
-    if (listIter->second->end() == deletionIter)
-        return STATUS_CODE_NOT_FOUND;
-
-    deletionIter = listIter->second->erase(deletionIter);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->RemoveObjectFromList(listIter->second, pT));
+    this->ReleaseIndex(pT);
     delete pT;
+    ++m_nObjectsDeleted;
 
     return STATUS_CODE_SUCCESS;
 }
@@ -195,17 +202,46 @@ StatusCode AlgorithmObjectManager<T>::DeleteObjects(const ObjectList &objectList
     if (listIter->second == &objectList)
         return STATUS_CODE_INVALID_PARAMETER;
 
+    // ATTN Check all objects before any are removed, so that either the whole list is deleted or nothing is changed
+    std::unordered_set<const T*> objectSet;
+
     for (const T *const pT : objectList)
     {
-        typename ObjectList::iterator deletionIter = std::find(listIter->second->begin(), listIter->second->end(), pT);
-
-        if (listIter->second->end() == deletionIter)
+        if (!this->IsObjectInList(listIter->second, pT) || !objectSet.insert(pT).second)
             return STATUS_CODE_NOT_FOUND;
+    }
+
+    if (objectSet.size() == listIter->second->size())
+    {
+        listIter->second->clear();
+    }
+    else
+    {
+#if PANDORA_MANAGED_CONTAINER_STABLE_ITERATORS
+        for (const T *const pT : objectList)
+            (void) listIter->second->erase(m_objectPositionMap.at(pT).m_iterator);
+#else
+        ObjectList remainingList;
+
+        for (const T *const pT : *listIter->second)
+        {
+            if (!objectSet.count(pT))
+                remainingList.push_back(pT);
+        }
+
+        *listIter->second = remainingList;
+#endif
+    }
+
+    this->RemoveObjectPositions(objectList);
 
-        deletionIter = listIter->second->erase(deletionIter);
+    for (const T *const pT : objectList)
+    {
+        this->ReleaseIndex(pT);
         delete pT;
     }
 
+    m_nObjectsDeleted += objectList.size();
     return STATUS_CODE_SUCCESS;
 }
 
@@ -217,12 +253,12 @@ StatusCode AlgorithmObjectManager<T>::DeleteTemporaryObjects(const Algorithm *co
     if (Manager<T>::m_savedLists.end() != Manager<T>::m_savedLists.find(temporaryListName))
         return STATUS_CODE_NOT_ALLOWED;
 
-    typename Manager<T>::AlgorithmInfoMap::const_iterator algorithmIter = Manager<T>::m_algorithmInfoMap.find(pAlgorithm);
+    const typename Manager<T>::AlgorithmInfo *const pAlgorithmInfo(Manager<T>::GetActiveAlgorithmInfo(pAlgorithm));
 
-    if (Manager<T>::m_algorithmInfoMap.end() == algorithmIter)
+    if (!pAlgorithmInfo)
         return STATUS_CODE_NOT_FOUND;
 
-    if (algorithmIter->second.m_temporaryListNames.end() == algorithmIter->second.m_temporaryListNames.find(temporaryListName))
+    if (!Manager<T>::IsTemporaryList(*pAlgorithmInfo, temporaryListName))
         return STATUS_CODE_NOT_ALLOWED;
 
     typename Manager<T>::NameToListMap::iterator listIter = Manager<T>::m_nameToListMap.find(temporaryListName);
@@ -230,9 +266,15 @@ StatusCode AlgorithmObjectManager<T>::DeleteTemporaryObjects(const Algorithm *co
     if (Manager<T>::m_nameToListMap.end() == listIter)
         return STATUS_CODE_FAILURE;
 
+    this->RemoveObjectPositions(*listIter->second);
+
     for (const T *const pT : *listIter->second)
+    {
+        this->ReleaseIndex(pT);
         delete pT;
+    }
 
+    m_nObjectsDeleted += listIter->second->size();
     listIter->second->clear();
     return STATUS_CODE_SUCCESS;
 }
@@ -242,20 +284,13 @@ StatusCode AlgorithmObjectManager<T>::DeleteTemporaryObjects(const Algorithm *co
 template<typename T>
 StatusCode AlgorithmObjectManager<T>::GetResetDeletionObjects(const Algorithm *const pAlgorithm, ObjectList &objectList) const
 {
-    typename Manager<T>::AlgorithmInfoMap::const_iterator algorithmIter = Manager<T>::m_algorithmInfoMap.find(pAlgorithm);
+    const typename Manager<T>::AlgorithmInfo *const pAlgorithmInfo(Manager<T>::GetActiveAlgorithmInfo(pAlgorithm));
 
-    if (Manager<T>::m_algorithmInfoMap.end() == algorithmIter)
+    if (!pAlgorithmInfo)
         return STATUS_CODE_NOT_FOUND;
 
-    for (const std::string &temporaryListName : algorithmIter->second.m_temporaryListNames)
-    {
-        typename Manager<T>::NameToListMap::const_iterator listIter = Manager<T>::m_nameToListMap.find(temporaryListName);
-
-        if (Manager<T>::m_nameToListMap.end() == listIter)
-            return STATUS_CODE_FAILURE;
-
-        objectList.insert(objectList.end(), listIter->second->begin(), listIter->second->end());
-    }
+    for (const ObjectList *const pTemporaryList : pAlgorithmInfo->m_temporaryLists)
+        objectList.insert(objectList.end(), pTemporaryList->begin(), pTemporaryList->end());
 
     return STATUS_CODE_SUCCESS;
 }
@@ -305,16 +340,29 @@ StatusCode AlgorithmObjectManager<T>::ResetAlgorithmInfo(const Algorithm *const
 {
     ObjectList objectList;
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetResetDeletionObjects(pAlgorithm, objectList));
+    this->RemoveObjectPositions(objectList);
 
     for (const T *const pT : objectList)
+    {
+        this->ReleaseIndex(pT);
         delete pT;
+    }
 
+    m_nObjectsDeleted += objectList.size();
     m_canMakeNewObjects = false;
     return Manager<T>::ResetAlgorithmInfo(pAlgorithm, isAlgorithmFinished);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+template<typename T>
+bool AlgorithmObjectManager<T>::IsInInitialState() const
+{
+    return (!m_canMakeNewObjects && m_objectPositionMap.empty() && (0 == m_nObjectsDetached) && Manager<T>::IsInInitialState());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 template<typename T>
 StatusCode AlgorithmObjectManager<T>::EraseAllContent()
 {
@@ -322,12 +370,201 @@ StatusCode AlgorithmObjectManager<T>::EraseAllContent()
     {
         for (const T *const pT : *mapEntry.second)
             delete pT;
+
+        m_nObjectsDeleted += mapEntry.second->size();
     }
 
     m_canMakeNewObjects = false;
+    m_objectPositionMap.clear();
     return Manager<T>::EraseAllContent();
 }
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template<typename T>
+StatusCode AlgorithmObjectManager<T>::AddObjectToList(ObjectList *const pObjectList, const T *const pT)
+{
+    ObjectPosition objectPosition;
+    objectPosition.m_pObjectList = pObjectList;
+
+    std::pair<typename ObjectPositionMap::iterator, bool> insertion(m_objectPositionMap.insert(typename ObjectPositionMap::value_type(pT, objectPosition)));
+
+    if (!insertion.second)
+        return STATUS_CODE_ALREADY_PRESENT;
+
+    pObjectList->push_back(pT);
+#if PANDORA_MANAGED_CONTAINER_STABLE_ITERATORS
+    insertion.first->second.m_iterator = std::prev(pObjectList->end());
+#endif
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template<typename T>
+StatusCode AlgorithmObjectManager<T>::RemoveObjectFromList(ObjectList *const pObjectList, const T *const pT)
+{
+    typename ObjectPositionMap::iterator positionIter(m_objectPositionMap.find(pT));
+
+    if ((m_objectPositionMap.end() == positionIter) || (pObjectList != positionIter->second.m_pObjectList))
+        return STATUS_CODE_NOT_FOUND;
+
+#if PANDORA_MANAGED_CONTAINER_STABLE_ITERATORS
+    (void) pObjectList->erase(positionIter->second.m_iterator);
+#else
+    (void) pObjectList->erase(std::find(pObjectList->begin(), pObjectList->end(), pT));
+#endif
+    (void) m_objectPositionMap.erase(positionIter);
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template<typename T>
+bool AlgorithmObjectManager<T>::IsObjectInList(const ObjectList *const pObjectList, const T *const pT) const
+{
+    typename ObjectPositionMap::const_iterator positionIter(m_objectPositionMap.find(pT));
+
+    return ((m_objectPositionMap.end() != positionIter) && (pObjectList == positionIter->second.m_pObjectList));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template<typename T>
+void AlgorithmObjectManager<T>::RemoveObjectPositions(const ObjectList &objectList)
+{
+    for (const T *const pT : objectList)
+        (void) m_objectPositionMap.erase(pT);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template<typename T>
+StatusCode AlgorithmObjectManager<T>::DetachObject(const T *const pT, const std::string &listName, const T *&pNextT)
+{
+    const ObjectList objectList(1, pT);
+    ObjectVector nextObjectVector;
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->DetachObjects(objectList, listName, nextObjectVector));
+
+    pNextT = nextObjectVector.front();
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template<typename T>
+StatusCode AlgorithmObjectManager<T>::DetachObjects(const ObjectList &objectList, const std::string &listName, ObjectVector &nextObjectVector)
+{
+    typename Manager<T>::NameToListMap::iterator listIter = Manager<T>::m_nameToListMap.find(listName);
+
+    if (Manager<T>::m_nameToListMap.end() == listIter)
+        return STATUS_CODE_NOT_FOUND;
+
+    if (listIter->second == &objectList)
+        return STATUS_CODE_INVALID_PARAMETER;
+
+    std::unordered_set<const T*> objectSet;
+
+    for (const T *const pT : objectList)
+    {
+        if (!this->IsObjectInList(listIter->second, pT) || !objectSet.insert(pT).second)
+            return STATUS_CODE_NOT_FOUND;
+    }
+
+    ObjectList *const pObjectList(listIter->second);
+
+    for (const T *const pT : objectList)
+    {
+#if PANDORA_MANAGED_CONTAINER_STABLE_ITERATORS
+        const typename ObjectList::iterator nextIter(std::next(m_objectPositionMap.at(pT).m_iterator));
+#else
+        const typename ObjectList::iterator nextIter(std::next(std::find(pObjectList->begin(), pObjectList->end(), pT)));
+#endif
+        nextObjectVector.push_back((pObjectList->end() == nextIter) ? nullptr : *nextIter);
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->RemoveObjectFromList(pObjectList, pT));
+        ++m_nObjectsDetached;
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template<typename T>
+StatusCode AlgorithmObjectManager<T>::ReattachObject(const T *const pT, const std::string &listName, const T *const pNextT)
+{
+    typename Manager<T>::NameToListMap::iterator listIter = Manager<T>::m_nameToListMap.find(listName);
+
+    if (Manager<T>::m_nameToListMap.end() == listIter)
+        return STATUS_CODE_NOT_FOUND;
+
+    if ((0 == m_nObjectsDetached) || (m_objectPositionMap.end() != m_objectPositionMap.find(pT)))
+        return STATUS_CODE_NOT_ALLOWED;
+
+    ObjectList *const pObjectList(listIter->second);
+    typename ObjectList::iterator insertIter(pObjectList->end());
+
+    if (pNextT)
+    {
+        if (!this->IsObjectInList(pObjectList, pNextT))
+            return STATUS_CODE_NOT_FOUND;
+
+#if PANDORA_MANAGED_CONTAINER_STABLE_ITERATORS
+        insertIter = m_objectPositionMap.at(pNextT).m_iterator;
+#else
+        insertIter = std::find(pObjectList->begin(), pObjectList->end(), pNextT);
+#endif
+    }
+
+    ObjectPosition objectPosition;
+    objectPosition.m_pObjectList = pObjectList;
+#if PANDORA_MANAGED_CONTAINER_STABLE_ITERATORS
+    objectPosition.m_iterator = pObjectList->insert(insertIter, pT);
+#else
+    (void) pObjectList->insert(insertIter, pT);
+#endif
+    (void) m_objectPositionMap.insert(typename ObjectPositionMap::value_type(pT, objectPosition));
+    --m_nObjectsDetached;
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template<typename T>
+void AlgorithmObjectManager<T>::DestroyDetachedObject(const T *const pT)
+{
+    this->ReleaseIndex(pT);
+    delete pT;
+    --m_nObjectsDetached;
+    ++m_nObjectsDeleted;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template<typename T>
+void AlgorithmObjectManager<T>::GetCurrentListState(std::string &currentListName, bool &canMakeNewObjects) const
+{
+    currentListName = Manager<T>::m_currentListName;
+    canMakeNewObjects = m_canMakeNewObjects;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template<typename T>
+StatusCode AlgorithmObjectManager<T>::RestoreCurrentListState(const std::string &currentListName, const bool canMakeNewObjects)
+{
+    if (Manager<T>::m_nameToListMap.end() == Manager<T>::m_nameToListMap.find(currentListName))
+        return STATUS_CODE_NOT_FOUND;
+
+    m_canMakeNewObjects = canMakeNewObjects;
+    Manager<T>::m_currentListName = currentListName;
+    Manager<T>::m_pCurrentList = nullptr;
+    return STATUS_CODE_SUCCESS;
+}
+
 //------------------------------------------------------------------------------------------------------------------------------------------
 //------------------------------------------------------------------------------------------------------------------------------------------
 
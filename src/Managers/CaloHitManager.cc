@@ -6,20 +6,26 @@
  *  $Log: $
  */
 
+#include "Geometry/LArTPC.h"
+
 #include "Managers/CaloHitManager.h"
+#include "Managers/GeometryManager.h"
 #include "Managers/PluginManager.h"
 
 #include "Objects/Cluster.h"
 #include "Objects/CaloHit.h"
 
+#include "Pandora/HotPathCounters.h"
 #include "Pandora/ObjectFactory.h"
 #include "Pandora/Pandora.h"
 #include "Pandora/PandoraInternal.h"
+#include "Pandora/PandoraObjectFactories.h"
 
 #include "Plugins/PseudoLayerPlugin.h"
 
 #include <algorithm>
 #include <cmath>
+#include <unordered_set>
 
 namespace pandora
 {
@@ -27,7 +33,11 @@ namespace pandora
 CaloHitManager::CaloHitManager(const Pandora *const pPandora) :
     InputObjectManager<CaloHit>(pPandora),
     m_nReclusteringProcesses(0),
-    m_pCurrentReclusterMetadata(nullptr)
+    m_pCurrentReclusterMetadata(nullptr),
+    m_isInputSnapshotValid(false),
+    m_isInputTimeIndexValid(false),
+    m_isNeighbourGraphValid(false),
+    m_areLArTPCHitGridsValid(false)
 {
     PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->CreateInitialLists());
 }
@@ -48,7 +58,13 @@ StatusCode CaloHitManager::Create(const object_creation::CaloHit::Parameters &pa
 
     try
     {
-        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, factory.Create(parameters, pCaloHit));
+        if (!this->IsWithinObjectBudget(1))
+            throw StatusCodeException(STATUS_CODE_BUDGET_EXCEEDED);
+
+        if (this->ShouldValidateInputParameters())
+            PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, CaloHitManager::ValidateParameters(parameters));
+
+        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, factory.CreateObject(parameters, pCaloHit));
 
         NameToListMap::iterator inputIter = m_nameToListMap.find(m_inputListName);
 
@@ -61,7 +77,11 @@ StatusCode CaloHitManager::Create(const object_creation::CaloHit::Parameters &pa
 
         PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->Modifiable(pCaloHit)->SetPseudoLayer(pseudoLayer));
 
+        this->AssignIndex(pCaloHit);
         inputIter->second->push_back(pCaloHit);
+        m_isInputSnapshotValid = false;
+        m_isInputTimeIndexValid = false;
+        this->InvalidateSpatialIndices(m_inputListName);
         return STATUS_CODE_SUCCESS;
     }
     catch (StatusCodeException &statusCodeException)
@@ -75,8 +95,193 @@ StatusCode CaloHitManager::Create(const object_creation::CaloHit::Parameters &pa
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+StatusCode CaloHitManager::Create(const std::vector<object_creation::CaloHit::Parameters> &parametersVector,
+    const ObjectFactory<object_creation::CaloHit::Parameters, object_creation::CaloHit::Object> &factory)
+{
+    NameToListMap::iterator inputIter = m_nameToListMap.find(m_inputListName);
+
+    if (m_nameToListMap.end() == inputIter)
+        return STATUS_CODE_FAILURE;
+
+    CaloHitVector caloHitVector;
+    caloHitVector.reserve(parametersVector.size());
+
+    try
+    {
+        if (!this->IsWithinObjectBudget(parametersVector.size()))
+            throw StatusCodeException(STATUS_CODE_BUDGET_EXCEEDED);
+
+        const bool shouldValidateParameters(this->ShouldValidateInputParameters());
+
+        for (const object_creation::CaloHit::Parameters &parameters : parametersVector)
+        {
+            if (shouldValidateParameters)
+                PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, CaloHitManager::ValidateParameters(parameters));
+
+            const CaloHit *pCaloHit(nullptr);
+            const StatusCode statusCode(factory.CreateObject(parameters, pCaloHit));
+
+            if (pCaloHit)
+                caloHitVector.push_back(pCaloHit);
+
+            if (STATUS_CODE_SUCCESS != statusCode)
+                throw StatusCodeException(statusCode);
+
+            if (!pCaloHit)
+                throw StatusCodeException(STATUS_CODE_FAILURE);
+        }
+
+        // ATTN No longer require presence of pseudo layer plugin, accepting use of a single dummy value for all hits
+        const PseudoLayerPlugin *const pPseudoLayerPlugin(m_pPandora->GetPlugins()->HasPseudoLayerPlugin() ?
+            m_pPandora->GetPlugins()->GetPseudoLayerPlugin() : nullptr);
+
+        UIntVector pseudoLayers;
+
+        if (pPseudoLayerPlugin)
+        {
+            CartesianPointVector positionVectors;
+            positionVectors.reserve(caloHitVector.size());
+
+            for (const CaloHit *const pCaloHit : caloHitVector)
+                positionVectors.push_back(pCaloHit->GetPositionVector());
+
+            PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, pPseudoLayerPlugin->GetPseudoLayers(positionVectors, pseudoLayers));
+
+            if (pseudoLayers.size() != caloHitVector.size())
+                throw StatusCodeException(STATUS_CODE_FAILURE);
+        }
+
+        for (unsigned int i = 0; i < caloHitVector.size(); ++i)
+            PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->Modifiable(caloHitVector[i])->SetPseudoLayer(pPseudoLayerPlugin ? pseudoLayers[i] : 0));
+    }
+    catch (StatusCodeException &statusCodeException)
+    {
+        std::cout << "Failed to create calo hits: " << statusCodeException.ToString() << std::endl;
+
+        for (const CaloHit *const pCaloHit : caloHitVector)
+            delete pCaloHit;
+
+        return statusCodeException.GetStatusCode();
+    }
+
+    m_indexedCaloHitVector.reserve(m_indexedCaloHitVector.size() + caloHitVector.size());
+
+    for (const CaloHit *const pCaloHit : caloHitVector)
+        this->AssignIndex(pCaloHit);
+
+    inputIter->second->insert(inputIter->second->end(), caloHitVector.begin(), caloHitVector.end());
+    m_isInputSnapshotValid = false;
+    m_isInputTimeIndexValid = false;
+    this->InvalidateSpatialIndices(m_inputListName);
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode CaloHitManager::ValidateParameters(const object_creation::CaloHit::Parameters &parameters)
+{
+    if (!parameters.m_positionVector.IsInitialized() || !parameters.m_expectedDirection.IsInitialized() ||
+        !parameters.m_cellNormalVector.IsInitialized() || !parameters.m_cellGeometry.IsInitialized() ||
+        !parameters.m_cellSize0.IsInitialized() || !parameters.m_cellSize1.IsInitialized() || !parameters.m_cellThickness.IsInitialized() ||
+        !parameters.m_nCellRadiationLengths.IsInitialized() || !parameters.m_nCellInteractionLengths.IsInitialized() ||
+        !parameters.m_time.IsInitialized() || !parameters.m_inputEnergy.IsInitialized() || !parameters.m_mipEquivalentEnergy.IsInitialized() ||
+        !parameters.m_electromagneticEnergy.IsInitialized() || !parameters.m_hadronicEnergy.IsInitialized() ||
+        !parameters.m_isDigital.IsInitialized() || !parameters.m_hitType.IsInitialized() || !parameters.m_hitRegion.IsInitialized() ||
+        !parameters.m_layer.IsInitialized() || !parameters.m_isInOuterSamplingLayer.IsInitialized() ||
+        !parameters.m_pParentAddress.IsInitialized())
+    {
+        return STATUS_CODE_NOT_INITIALIZED;
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode CaloHitManager::ShareCaloHits(const CaloHitList &caloHitList)
+{
+    NameToListMap::iterator inputIter = m_nameToListMap.find(m_inputListName);
+
+    if (m_nameToListMap.end() == inputIter)
+        return STATUS_CODE_FAILURE;
+
+    for (const CaloHit *const pCaloHit : caloHitList)
+    {
+        // ATTN Calo hits already in the input list, whether owned or shared, hold an index addressing themselves in this manager
+        if ((pCaloHit->m_index < m_indexedCaloHitVector.size()) && (pCaloHit == m_indexedCaloHitVector[pCaloHit->m_index]))
+            return STATUS_CODE_ALREADY_PRESENT;
+    }
+
+    for (const CaloHit *const pCaloHit : caloHitList)
+    {
+        SharedCaloHitState sharedCaloHitState;
+        sharedCaloHitState.m_isAvailable = pCaloHit->IsAvailable();
+        sharedCaloHitState.m_index = pCaloHit->m_index;
+
+        if (!m_sharedCaloHitMap.insert(SharedCaloHitMap::value_type(pCaloHit, sharedCaloHitState)).second)
+            return STATUS_CODE_ALREADY_PRESENT;
+
+        this->AssignIndex(pCaloHit);
+        inputIter->second->push_back(pCaloHit);
+    }
+
+    m_isInputSnapshotValid = false;
+    m_isInputTimeIndexValid = false;
+    this->InvalidateSpatialIndices(m_inputListName);
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool CaloHitManager::IsShared(const CaloHit *const pCaloHit) const
+{
+    return (!m_sharedCaloHitMap.empty() && (m_sharedCaloHitMap.count(pCaloHit) > 0));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode CaloHitManager::ReleaseSharedCaloHits()
+{
+    if (m_sharedCaloHitMap.empty())
+        return STATUS_CODE_SUCCESS;
+
+    for (const SharedCaloHitMap::value_type &mapEntry : m_sharedCaloHitMap)
+    {
+        CaloHit *const pCaloHit(this->Modifiable(mapEntry.first));
+        pCaloHit->SetAvailability(mapEntry.second.m_isAvailable);
+        pCaloHit->m_index = mapEntry.second.m_index;
+    }
+
+    NameToListMap::iterator inputIter = m_nameToListMap.find(m_inputListName);
+
+    if (m_nameToListMap.end() != inputIter)
+    {
+        CaloHitList *const pInputList(inputIter->second);
+
+        for (CaloHitList::iterator iter = pInputList->begin(); iter != pInputList->end(); )
+        {
+            if (m_sharedCaloHitMap.count(*iter))
+            {
+                iter = pInputList->erase(iter);
+            }
+            else
+            {
+                ++iter;
+            }
+        }
+    }
+
+    m_sharedCaloHitMap.clear();
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 StatusCode CaloHitManager::AlterMetadata(const CaloHit *const pCaloHit, const object_creation::CaloHit::Metadata &metadata) const
 {
+    if (this->IsShared(pCaloHit))
+        return STATUS_CODE_NOT_ALLOWED;
+
     return this->Modifiable(pCaloHit)->AlterMetadata(metadata);
 }
 
@@ -88,6 +293,7 @@ bool CaloHitManager::IsAvailable(const CaloHit *const pCaloHit) const
     if (0 == m_nReclusteringProcesses)
         return pCaloHit->IsAvailable();
 
+    PANDORA_INCREMENT_HOT_PATH_COUNTER(HOT_PATH_RECLUSTER_IS_AVAILABLE);
     return m_pCurrentReclusterMetadata->GetCurrentCaloHitMetadata()->IsAvailable(pCaloHit);
 }
 
@@ -104,6 +310,7 @@ bool CaloHitManager::IsAvailable(const CaloHitList *const pCaloHitList) const
         return isAvailable;
     }
 
+    PANDORA_INCREMENT_HOT_PATH_COUNTER(HOT_PATH_RECLUSTER_IS_AVAILABLE);
     return m_pCurrentReclusterMetadata->GetCurrentCaloHitMetadata()->IsAvailable(pCaloHitList);
 }
 
@@ -137,57 +344,474 @@ StatusCode CaloHitManager::SetAvailability(const CaloHitList *const pCaloHitList
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+StatusCode CaloHitManager::GetInputSnapshot(const CaloHitSnapshot *&pCaloHitSnapshot)
+{
+    if (!m_isInputSnapshotValid)
+    {
+        NameToListMap::const_iterator inputIter = m_nameToListMap.find(m_inputListName);
+
+        if (m_nameToListMap.end() == inputIter)
+            return STATUS_CODE_FAILURE;
+
+        m_inputSnapshot.Fill(*inputIter->second);
+        m_isInputSnapshotValid = true;
+    }
+
+    pCaloHitSnapshot = &m_inputSnapshot;
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode CaloHitManager::GetInputTimeIndex(const CaloHitTimeIndex *&pCaloHitTimeIndex)
+{
+    if (!m_isInputTimeIndexValid)
+    {
+        NameToListMap::const_iterator inputIter = m_nameToListMap.find(m_inputListName);
+
+        if (m_nameToListMap.end() == inputIter)
+            return STATUS_CODE_FAILURE;
+
+        m_inputTimeIndex.Fill(*inputIter->second);
+        m_isInputTimeIndexValid = true;
+    }
+
+    pCaloHitTimeIndex = &m_inputTimeIndex;
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode CaloHitManager::GetListSpatialIndex(const std::string &listName, const CaloHitSpatialIndex *&pCaloHitSpatialIndex)
+{
+    NameToSpatialIndexMap::const_iterator indexIter = m_spatialIndexMap.find(listName);
+
+    if (m_spatialIndexMap.end() == indexIter)
+    {
+        NameToListMap::const_iterator listIter = m_nameToListMap.find(listName);
+
+        if (m_nameToListMap.end() == listIter)
+            return STATUS_CODE_NOT_INITIALIZED;
+
+        CaloHitSpatialIndex &caloHitSpatialIndex(m_spatialIndexMap[listName]);
+        caloHitSpatialIndex.Fill(*listIter->second);
+        indexIter = m_spatialIndexMap.find(listName);
+    }
+
+    pCaloHitSpatialIndex = &indexIter->second;
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode CaloHitManager::GetListSpatialIndex(const std::string &listName, const HitType hitType, const CaloHitSpatialIndex *&pCaloHitSpatialIndex)
+{
+    const ListNameAndHitType key(listName, hitType);
+    HitTypeSpatialIndexMap::const_iterator indexIter = m_hitTypeSpatialIndexMap.find(key);
+
+    if (m_hitTypeSpatialIndexMap.end() == indexIter)
+    {
+        NameToListMap::const_iterator listIter = m_nameToListMap.find(listName);
+
+        if (m_nameToListMap.end() == listIter)
+            return STATUS_CODE_NOT_INITIALIZED;
+
+        CaloHitList caloHitList;
+
+        for (const CaloHit *const pCaloHit : *listIter->second)
+        {
+            if (hitType == pCaloHit->GetHitType())
+                caloHitList.push_back(pCaloHit);
+        }
+
+        CaloHitSpatialIndex &caloHitSpatialIndex(m_hitTypeSpatialIndexMap[key]);
+        caloHitSpatialIndex.Fill(caloHitList);
+        indexIter = m_hitTypeSpatialIndexMap.find(key);
+    }
+
+    pCaloHitSpatialIndex = &indexIter->second;
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode CaloHitManager::CreateNeighbourGraph(const float maxDistance, const unsigned int layerWindow)
+{
+    m_isNeighbourGraphValid = false;
+    NameToListMap::const_iterator inputIter = m_nameToListMap.find(m_inputListName);
+
+    if (m_nameToListMap.end() == inputIter)
+        return STATUS_CODE_FAILURE;
+
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_neighbourGraph.Fill(*inputIter->second, maxDistance, layerWindow));
+    m_isNeighbourGraphValid = true;
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode CaloHitManager::GetNeighbourGraph(const CaloHitNeighbourGraph *&pCaloHitNeighbourGraph) const
+{
+    if (!m_isNeighbourGraphValid)
+        return STATUS_CODE_NOT_INITIALIZED;
+
+    pCaloHitNeighbourGraph = &m_neighbourGraph;
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode CaloHitManager::CreateLArTPCHitGrids(const float driftBinWidth)
+{
+    m_areLArTPCHitGridsValid = false;
+    m_larTPCHitGridMap.clear();
+    NameToListMap::const_iterator inputIter = m_nameToListMap.find(m_inputListName);
+
+    if (m_nameToListMap.end() == inputIter)
+        return STATUS_CODE_FAILURE;
+
+    const GeometryManager *const pGeometryManager(m_pPandora->GetGeometry());
+    std::map<VolumeIdAndHitType, CaloHitVector> caloHitVectorMap;
+    std::map<unsigned int, const LArTPC *> volumeIdToLArTPCMap;
+
+    for (const CaloHit *const pCaloHit : *inputIter->second)
+    {
+        const HitType hitType(pCaloHit->GetHitType());
+
+        if ((TPC_VIEW_U != hitType) && (TPC_VIEW_V != hitType) && (TPC_VIEW_W != hitType))
+            continue;
+
+        const LArTPC *pLArTPC(nullptr);
+
+        if (STATUS_CODE_SUCCESS != pGeometryManager->GetLArTPC(pCaloHit->GetPositionVector(), pLArTPC))
+            continue;
+
+        volumeIdToLArTPCMap[pLArTPC->GetLArTPCVolumeId()] = pLArTPC;
+        caloHitVectorMap[VolumeIdAndHitType(pLArTPC->GetLArTPCVolumeId(), hitType)].push_back(pCaloHit);
+    }
+
+    for (const auto &mapEntry : caloHitVectorMap)
+    {
+        const LArTPC *const pLArTPC(volumeIdToLArTPCMap.at(mapEntry.first.first));
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_larTPCHitGridMap[mapEntry.first].Fill(pLArTPC, mapEntry.first.second, driftBinWidth,
+            mapEntry.second));
+    }
+
+    m_areLArTPCHitGridsValid = true;
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode CaloHitManager::GetLArTPCHitGrid(const LArTPC &larTPC, const HitType hitType, const LArTPCHitGrid *&pLArTPCHitGrid) const
+{
+    if (!m_areLArTPCHitGridsValid)
+        return STATUS_CODE_NOT_INITIALIZED;
+
+    LArTPCHitGridMap::const_iterator iter = m_larTPCHitGridMap.find(VolumeIdAndHitType(larTPC.GetLArTPCVolumeId(), hitType));
+
+    if (m_larTPCHitGridMap.end() == iter)
+        return STATUS_CODE_NOT_FOUND;
+
+    pLArTPCHitGrid = &iter->second;
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode CaloHitManager::CreateInputHitTypeLists()
+{
+    NameToListMap::const_iterator inputIter = m_nameToListMap.find(m_inputListName);
+
+    if (m_nameToListMap.end() == inputIter)
+        return STATUS_CODE_FAILURE;
+
+    HitTypeToListMap hitTypeToListMap;
+
+    for (const CaloHit *const pCaloHit : *inputIter->second)
+    {
+        HitTypeToListMap::const_iterator hitTypeIter(hitTypeToListMap.find(pCaloHit->GetHitType()));
+
+        if (hitTypeToListMap.end() == hitTypeIter)
+        {
+            // ATTN Partitions are ordinary saved lists, so calo hit fragmentation and merging update them along with the input list
+            const std::string listName(this->GetInputListName(pCaloHit->GetHitType()));
+            NameToListMap::iterator listIter(m_nameToListMap.find(listName));
+
+            if (m_nameToListMap.end() == listIter)
+            {
+                listIter = m_nameToListMap.insert(NameToListMap::value_type(listName, new CaloHitList)).first;
+                (void) m_savedLists.insert(listName);
+            }
+
+            listIter->second->clear();
+            this->InvalidateSpatialIndices(listName);
+            hitTypeIter = hitTypeToListMap.insert(HitTypeToListMap::value_type(pCaloHit->GetHitType(), listIter->second)).first;
+        }
+
+        hitTypeIter->second->push_back(pCaloHit);
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+std::string CaloHitManager::GetInputListName(const HitType hitType) const
+{
+    switch (hitType)
+    {
+    case TRACKER:
+        return m_inputListName + "_TRACKER";
+    case ECAL:
+        return m_inputListName + "_ECAL";
+    case HCAL:
+        return m_inputListName + "_HCAL";
+    case MUON:
+        return m_inputListName + "_MUON";
+    case TPC_VIEW_U:
+        return m_inputListName + "_TPC_VIEW_U";
+    case TPC_VIEW_V:
+        return m_inputListName + "_TPC_VIEW_V";
+    case TPC_VIEW_W:
+        return m_inputListName + "_TPC_VIEW_W";
+    case TPC_3D:
+        return m_inputListName + "_TPC_3D";
+    case HIT_CUSTOM:
+        return m_inputListName + "_HIT_CUSTOM";
+    default:
+        return m_inputListName + "_HIT_TYPE_" + TypeToString(static_cast<int>(hitType));
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode CaloHitManager::GetInputList(const HitType hitType, const CaloHitList *&pCaloHitList) const
+{
+    return this->GetList(this->GetInputListName(hitType), pCaloHitList);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode CaloHitManager::CreateInputList()
+{
+    m_isInputSnapshotValid = false;
+    m_isInputTimeIndexValid = false;
+    this->InvalidateSpatialIndices(m_inputListName);
+    return InputObjectManager<CaloHit>::CreateInputList();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode CaloHitManager::AddObjectsToList(const std::string &listName, const CaloHitList &caloHitList)
+{
+    if (m_inputListName == listName)
+    {
+        m_isInputSnapshotValid = false;
+        m_isInputTimeIndexValid = false;
+    }
+
+    this->InvalidateSpatialIndices(listName);
+    return InputObjectManager<CaloHit>::AddObjectsToList(listName, caloHitList);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode CaloHitManager::RemoveObjectsFromList(const std::string &listName, const CaloHitList &caloHitList)
+{
+    if (m_inputListName == listName)
+    {
+        m_isInputSnapshotValid = false;
+        m_isInputTimeIndexValid = false;
+    }
+
+    this->InvalidateSpatialIndices(listName);
+    return InputObjectManager<CaloHit>::RemoveObjectsFromList(listName, caloHitList);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode CaloHitManager::SaveList(const std::string &listName, const CaloHitList &caloHitList)
+{
+    this->InvalidateSpatialIndices(listName);
+    return InputObjectManager<CaloHit>::SaveList(listName, caloHitList);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode CaloHitManager::RenameList(const std::string &oldListName, const std::string &newListName)
+{
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, InputObjectManager<CaloHit>::RenameList(oldListName, newListName));
+
+    this->InvalidateSpatialIndices(oldListName);
+    this->InvalidateSpatialIndices(newListName);
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode CaloHitManager::ResetAlgorithmInfo(const Algorithm *const pAlgorithm, bool isAlgorithmFinished)
+{
+    const StatusCode statusCode(InputObjectManager<CaloHit>::ResetAlgorithmInfo(pAlgorithm, isAlgorithmFinished));
+
+    // ATTN Temporary list names may be reused by later algorithm calls, so indices over deleted lists are discarded
+    for (NameToSpatialIndexMap::iterator iter = m_spatialIndexMap.begin(); iter != m_spatialIndexMap.end(); )
+    {
+        if (m_nameToListMap.count(iter->first))
+        {
+            ++iter;
+        }
+        else
+        {
+            iter = m_spatialIndexMap.erase(iter);
+        }
+    }
+
+    for (HitTypeSpatialIndexMap::iterator iter = m_hitTypeSpatialIndexMap.begin(); iter != m_hitTypeSpatialIndexMap.end(); )
+    {
+        if (m_nameToListMap.count(iter->first.first))
+        {
+            ++iter;
+        }
+        else
+        {
+            iter = m_hitTypeSpatialIndexMap.erase(iter);
+        }
+    }
+
+    return statusCode;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 StatusCode CaloHitManager::CreateTemporaryListAndSetCurrent(const Algorithm *const pAlgorithm, const ClusterList &clusterList,
     std::string &temporaryListName)
 {
     if (clusterList.empty())
         return STATUS_CODE_NOT_INITIALIZED;
 
-    CaloHitList caloHitList;
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, Manager<CaloHit>::CreateTemporaryListAndSetCurrent(pAlgorithm, temporaryListName));
+    CaloHitList *const pCaloHitList(m_nameToListMap.at(temporaryListName));
 
+    // ATTN Fill the new temporary list in place, rather than via an intermediate copy
     for (const Cluster *const pCluster : clusterList)
     {
-        pCluster->GetOrderedCaloHitList().FillCaloHitList(caloHitList);
-        caloHitList.insert(caloHitList.end(), pCluster->GetIsolatedCaloHitList().begin(), pCluster->GetIsolatedCaloHitList().end());
+        pCluster->GetOrderedCaloHitList().FillCaloHitList(*pCaloHitList);
+        pCaloHitList->insert(pCaloHitList->end(), pCluster->GetIsolatedCaloHitList().begin(), pCluster->GetIsolatedCaloHitList().end());
     }
 
-    return InputObjectManager<CaloHit>::CreateTemporaryListAndSetCurrent(pAlgorithm, caloHitList, temporaryListName);
+    if (std::unordered_set<const CaloHit*>(pCaloHitList->begin(), pCaloHitList->end()).size() != pCaloHitList->size())
+        return STATUS_CODE_ALREADY_PRESENT;
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode CaloHitManager::CreateTemporaryListAndSetCurrent(const Algorithm *const pAlgorithm, const CaloHitSpan &caloHitSpan,
+    std::string &temporaryListName)
+{
+    if (caloHitSpan.empty())
+        return STATUS_CODE_NOT_INITIALIZED;
+
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, Manager<CaloHit>::CreateTemporaryListAndSetCurrent(pAlgorithm, temporaryListName));
+    CaloHitList *const pCaloHitList(m_nameToListMap.at(temporaryListName));
+
+    // ATTN Fill the new temporary list in place, rather than via an intermediate copy. Spans from an index never repeat a calo hit.
+    pCaloHitList->insert(pCaloHitList->end(), caloHitSpan.begin(), caloHitSpan.end());
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool CaloHitManager::IsInInitialState() const
+{
+    if ((0 != m_nReclusteringProcesses) || !m_reclusterMetadataList.empty() || !m_indexedCaloHitVector.empty())
+        return false;
+
+    if (m_isInputSnapshotValid || m_isInputTimeIndexValid || m_isNeighbourGraphValid || m_areLArTPCHitGridsValid)
+        return false;
+
+    if (!m_spatialIndexMap.empty() || !m_hitTypeSpatialIndexMap.empty() || !m_sharedCaloHitMap.empty())
+        return false;
+
+    return InputObjectManager<CaloHit>::IsInInitialState();
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 StatusCode CaloHitManager::EraseAllContent()
 {
+    // ATTN Shared calo hits are released before the input list is erased, as they remain owned by another pandora instance
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReleaseSharedCaloHits());
+
     for (const ReclusterMetadata *const pMetaData : m_reclusterMetadataList)
         delete pMetaData;
 
     m_nReclusteringProcesses = 0;
     m_pCurrentReclusterMetadata = nullptr;
     m_reclusterMetadataList.clear();
+    m_indexedCaloHitVector.clear();
+
+    m_inputSnapshot.Clear();
+    m_inputTimeIndex.Clear();
+    m_isInputSnapshotValid = false;
+    m_isInputTimeIndexValid = false;
+    this->InvalidateSpatialIndices();
+
+    m_neighbourGraph.Clear();
+    m_isNeighbourGraphValid = false;
+
+    m_larTPCHitGridMap.clear();
+    m_areLArTPCHitGridsValid = false;
 
     return InputObjectManager<CaloHit>::EraseAllContent();
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-StatusCode CaloHitManager::MatchCaloHitsToMCPfoTargets(const UidToMCParticleWeightMap &caloHitToPfoTargetsMap)
+StatusCode CaloHitManager::ResetForNextWindow(const float windowStartTime)
 {
-    if (caloHitToPfoTargetsMap.empty())
-        return STATUS_CODE_SUCCESS;
-
     NameToListMap::const_iterator inputIter = m_nameToListMap.find(m_inputListName);
 
     if (m_nameToListMap.end() == inputIter)
         return STATUS_CODE_FAILURE;
 
+    CaloHitList carriedCaloHitList;
+
     for (const CaloHit *const pCaloHit : *inputIter->second)
     {
-        UidToMCParticleWeightMap::const_iterator pfoTargetIter = caloHitToPfoTargetsMap.find(pCaloHit->GetParentAddress());
-
-        if (caloHitToPfoTargetsMap.end() == pfoTargetIter)
+        if (this->IsShared(pCaloHit))
             continue;
 
-        this->Modifiable(pCaloHit)->SetMCParticleWeightMap(pfoTargetIter->second);
+        if (pCaloHit->GetTime() < windowStartTime)
+        {
+            delete pCaloHit;
+        }
+        else
+        {
+            carriedCaloHitList.push_back(pCaloHit);
+        }
+    }
+
+    // ATTN Empty the input list first, so that the standard reset erases all lists and metadata, but deletes only the retired calo hits
+    inputIter->second->clear();
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ResetForNextEvent());
+
+    inputIter = m_nameToListMap.find(m_inputListName);
+
+    if (m_nameToListMap.end() == inputIter)
+        return STATUS_CODE_FAILURE;
+
+    for (const CaloHit *const pCaloHit : carriedCaloHitList)
+    {
+        CaloHit *const pModifiableCaloHit(this->Modifiable(pCaloHit));
+        pModifiableCaloHit->SetAvailability(true);
+        pModifiableCaloHit->RemoveMCParticles();
+        this->AssignIndex(pCaloHit);
+        inputIter->second->push_back(pCaloHit);
     }
 
     return STATUS_CODE_SUCCESS;
@@ -195,6 +819,35 @@ StatusCode CaloHitManager::MatchCaloHitsToMCPfoTargets(const UidToMCParticleWeig
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+StatusCode CaloHitManager::ReserveCapacity(const unsigned int nCaloHits)
+{
+    m_indexedCaloHitVector.reserve(nCaloHits);
+
+    return this->ReserveInputList(nCaloHits);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode CaloHitManager::MatchCaloHitsToMCPfoTargets(const UidToMCParticleWeightTable &caloHitToPfoTargetsMap, ThreadPool &threadPool)
+{
+    if (caloHitToPfoTargetsMap.empty())
+        return STATUS_CODE_SUCCESS;
+
+    NameToListMap::const_iterator inputIter = m_nameToListMap.find(m_inputListName);
+
+    if (m_nameToListMap.end() == inputIter)
+        return STATUS_CODE_FAILURE;
+
+    // ATTN Each lookup writes only to its own calo hit, so the input calo hits are partitioned across the thread pool in chunks of 1024
+    const CaloHitVector caloHitVector(inputIter->second->begin(), inputIter->second->end());
+    const MCPfoTargetMatchingTask matchingTask(*this, caloHitVector, caloHitToPfoTargetsMap);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, threadPool.ParallelFor(caloHitVector.size(), matchingTask, 1024));
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 StatusCode CaloHitManager::RemoveAllMCParticleRelationships()
 {
     NameToListMap::const_iterator inputIter = m_nameToListMap.find(m_inputListName);
@@ -203,7 +856,10 @@ StatusCode CaloHitManager::RemoveAllMCParticleRelationships()
         return STATUS_CODE_FAILURE;
 
     for (const CaloHit *const pCaloHit : *inputIter->second)
-        this->Modifiable(pCaloHit)->RemoveMCParticles();
+    {
+        if (!this->IsShared(pCaloHit))
+            this->Modifiable(pCaloHit)->RemoveMCParticles();
+    }
 
     return STATUS_CODE_SUCCESS;
 }
@@ -213,6 +869,7 @@ StatusCode CaloHitManager::RemoveAllMCParticleRelationships()
 StatusCode CaloHitManager::FragmentCaloHit(const CaloHit *const pOriginalCaloHit, const float fraction1, const CaloHit *&pDaughterCaloHit1,
     const CaloHit *&pDaughterCaloHit2, const ObjectFactory<object_creation::CaloHitFragment::Parameters, object_creation::CaloHitFragment::Object> &factory)
 {
+    PANDORA_INCREMENT_HOT_PATH_COUNTER(HOT_PATH_FRAGMENT_CALO_HIT);
     pDaughterCaloHit1 = nullptr; pDaughterCaloHit2 = nullptr;
 
     if (!this->CanFragmentCaloHit(pOriginalCaloHit, fraction1))
@@ -221,30 +878,24 @@ StatusCode CaloHitManager::FragmentCaloHit(const CaloHit *const pOriginalCaloHit
     object_creation::CaloHitFragment::Parameters parameters1;
     parameters1.m_pOriginalCaloHit = pOriginalCaloHit;
     parameters1.m_weight = fraction1;
-    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, factory.Create(parameters1, pDaughterCaloHit1));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, factory.CreateObject(parameters1, pDaughterCaloHit1));
 
     object_creation::CaloHitFragment::Parameters parameters2;
     parameters2.m_pOriginalCaloHit = pOriginalCaloHit;
     parameters2.m_weight = 1.f - fraction1;
-    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, factory.Create(parameters2, pDaughterCaloHit2));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, factory.CreateObject(parameters2, pDaughterCaloHit2));
 
     if (!pDaughterCaloHit1 || !pDaughterCaloHit2)
         return STATUS_CODE_FAILURE;
 
-    CaloHitReplacement caloHitReplacement;
-    caloHitReplacement.m_oldCaloHits.push_back(pOriginalCaloHit);
-    caloHitReplacement.m_newCaloHits.push_back(pDaughterCaloHit1); caloHitReplacement.m_newCaloHits.push_back(pDaughterCaloHit2);
+    this->AssignIndex(pDaughterCaloHit1);
+    this->AssignIndex(pDaughterCaloHit2);
 
-    if (m_nReclusteringProcesses > 0)
-    {
-        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pCurrentReclusterMetadata->GetCurrentCaloHitMetadata()->Update(caloHitReplacement));
-    }
-    else
-    {
-        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->Update(caloHitReplacement));
-    }
+    CaloHitReplacement *const pCaloHitReplacement(new CaloHitReplacement);
+    pCaloHitReplacement->m_oldCaloHits.push_back(pOriginalCaloHit);
+    pCaloHitReplacement->m_newCaloHits.push_back(pDaughterCaloHit1); pCaloHitReplacement->m_newCaloHits.push_back(pDaughterCaloHit2);
 
-    return STATUS_CODE_SUCCESS;
+    return this->ApplyCaloHitReplacement(pCaloHitReplacement);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -252,6 +903,7 @@ StatusCode CaloHitManager::FragmentCaloHit(const CaloHit *const pOriginalCaloHit
 StatusCode CaloHitManager::MergeCaloHitFragments(const CaloHit *const pFragmentCaloHit1, const CaloHit *const pFragmentCaloHit2,
     const CaloHit *&pMergedCaloHit, const ObjectFactory<object_creation::CaloHitFragment::Parameters, object_creation::CaloHitFragment::Object> &factory)
 {
+    PANDORA_INCREMENT_HOT_PATH_COUNTER(HOT_PATH_MERGE_CALO_HIT_FRAGMENTS);
     pMergedCaloHit = nullptr;
 
     if (!this->CanMergeCaloHitFragments(pFragmentCaloHit1, pFragmentCaloHit2) || (pFragmentCaloHit1->GetCellGeometry() != pFragmentCaloHit2->GetCellGeometry()))
@@ -262,25 +914,18 @@ StatusCode CaloHitManager::MergeCaloHitFragments(const CaloHit *const pFragmentC
     object_creation::CaloHitFragment::Parameters parameters;
     parameters.m_pOriginalCaloHit = pFragmentCaloHit1;
     parameters.m_weight = newWeight;
-    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, factory.Create(parameters, pMergedCaloHit));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, factory.CreateObject(parameters, pMergedCaloHit));
 
     if (!pMergedCaloHit)
         return STATUS_CODE_FAILURE;
 
-    CaloHitReplacement caloHitReplacement;
-    caloHitReplacement.m_newCaloHits.push_back(pMergedCaloHit);
-    caloHitReplacement.m_oldCaloHits.push_back(pFragmentCaloHit1); caloHitReplacement.m_oldCaloHits.push_back(pFragmentCaloHit2);
+    this->AssignIndex(pMergedCaloHit);
 
-    if (m_nReclusteringProcesses > 0)
-    {
-        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pCurrentReclusterMetadata->GetCurrentCaloHitMetadata()->Update(caloHitReplacement));
-    }
-    else
-    {
-        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->Update(caloHitReplacement));
-    }
+    CaloHitReplacement *const pCaloHitReplacement(new CaloHitReplacement);
+    pCaloHitReplacement->m_newCaloHits.push_back(pMergedCaloHit);
+    pCaloHitReplacement->m_oldCaloHits.push_back(pFragmentCaloHit1); pCaloHitReplacement->m_oldCaloHits.push_back(pFragmentCaloHit2);
 
-    return STATUS_CODE_SUCCESS;
+    return this->ApplyCaloHitReplacement(pCaloHitReplacement);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -290,7 +935,7 @@ bool CaloHitManager::CanFragmentCaloHit(const CaloHit *const pOriginalCaloHit, c
     if ((fraction1 < std::numeric_limits<float>::epsilon()) || (fraction1 > 1.f))
         return false;
 
-    if (!this->IsAvailable(pOriginalCaloHit))
+    if (!this->IsAvailable(pOriginalCaloHit) || this->IsShared(pOriginalCaloHit))
         return false;
 
     NameToListMap::const_iterator iter = m_nameToListMap.find(m_currentListName);
@@ -317,6 +962,9 @@ bool CaloHitManager::CanMergeCaloHitFragments(const CaloHit *const pFragmentCalo
     if (!this->IsAvailable(pFragmentCaloHit1) || !this->IsAvailable(pFragmentCaloHit2))
         return false;
 
+    if (this->IsShared(pFragmentCaloHit1) || this->IsShared(pFragmentCaloHit2))
+        return false;
+
     NameToListMap::const_iterator iter = m_nameToListMap.find(m_currentListName);
 
     if (m_nameToListMap.end() == iter)
@@ -340,11 +988,14 @@ StatusCode CaloHitManager::InitializeReclustering(const Algorithm *const pAlgori
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->CreateTemporaryListAndSetCurrent(pAlgorithm, clusterList, caloHitListName));
     CaloHitList *const pCaloHitList = m_nameToListMap[caloHitListName];
 
-    m_pCurrentReclusterMetadata = new ReclusterMetadata(pCaloHitList);
+    // ATTN The original option inherits availability from the enclosing level, in which its calo hits are held in clusters
+    const CaloHitMetadata *const pParentCaloHitMetadata(m_pCurrentReclusterMetadata ?
+        m_pCurrentReclusterMetadata->GetCurrentCaloHitMetadata() : nullptr);
+    m_pCurrentReclusterMetadata = new ReclusterMetadata(pCaloHitList, pParentCaloHitMetadata);
     m_reclusterMetadataList.push_back(m_pCurrentReclusterMetadata);
 
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pCurrentReclusterMetadata->CreateCaloHitMetadata(pCaloHitList, caloHitListName,
-        originalReclusterListName, false));
+        originalReclusterListName, true));
 
     ++m_nReclusteringProcesses;
 
@@ -366,7 +1017,7 @@ StatusCode CaloHitManager::PrepareForClustering(const Algorithm *const pAlgorith
     CaloHitList *const pCaloHitList = m_nameToListMap[caloHitListName];
 
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pCurrentReclusterMetadata->CreateCaloHitMetadata(pCaloHitList, caloHitListName,
-        newReclusterListName, true));
+        newReclusterListName, false));
 
     return STATUS_CODE_SUCCESS;
 }
@@ -379,11 +1030,11 @@ StatusCode CaloHitManager::EndReclustering(const Algorithm *const /*const pAlgor
         return STATUS_CODE_SUCCESS;
 
     CaloHitMetadata *pSelectedCaloHitMetaData(nullptr);
-    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pCurrentReclusterMetadata->ExtractCaloHitMetadata(selectedReclusterListName,
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pCurrentReclusterMetadata->GetCaloHitMetadata(selectedReclusterListName,
         pSelectedCaloHitMetaData));
 
+    ReclusterMetadata *const pReclusterMetadata(m_pCurrentReclusterMetadata);
     m_reclusterMetadataList.pop_back();
-    delete m_pCurrentReclusterMetadata;
 
     if (--m_nReclusteringProcesses > 0)
     {
@@ -397,14 +1048,24 @@ StatusCode CaloHitManager::EndReclustering(const Algorithm *const /*const pAlgor
         PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->Update(*pSelectedCaloHitMetaData));
     }
 
+    // ATTN The selected metadata refers to the shared recluster membership, so is cleared only now, then released with the other options
     pSelectedCaloHitMetaData->Clear();
-    delete pSelectedCaloHitMetaData;
+    delete pReclusterMetadata;
 
     return STATUS_CODE_SUCCESS;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+void CaloHitManager::AssignIndex(const CaloHit *const pCaloHit)
+{
+    // ATTN Indices are never released within an event, so the vector may also hold the addresses of calo hits deleted since creation
+    InputObjectManager<CaloHit>::AssignIndex(pCaloHit);
+    m_indexedCaloHitVector.push_back(pCaloHit);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 StatusCode CaloHitManager::Update(const CaloHitMetadata &caloHitMetadata)
 {
     const CaloHitReplacementList &caloHitReplacementList(caloHitMetadata.GetCaloHitReplacementList());
@@ -414,15 +1075,23 @@ StatusCode CaloHitManager::Update(const CaloHitMetadata &caloHitMetadata)
         PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->Update(*pCaloHitReplacement));
     }
 
-    const CaloHitUsageMap &caloHitUsageMap(caloHitMetadata.GetCaloHitUsageMap());
+    UIntVector availableIndices, unavailableIndices;
+    caloHitMetadata.GetAvailabilityUpdates(availableIndices, unavailableIndices);
 
-    CaloHitVector caloHitVector;
-    for (const CaloHitUsageMap::value_type &mapEntry : caloHitUsageMap) caloHitVector.push_back(mapEntry.first);
-    std::sort(caloHitVector.begin(), caloHitVector.end(), PointerLessThan<CaloHit>());
+    for (const unsigned int index : availableIndices)
+    {
+        if (index >= m_indexedCaloHitVector.size())
+            return STATUS_CODE_FAILURE;
 
-    for (const CaloHit *const pCaloHit : caloHitVector)
+        this->Modifiable(m_indexedCaloHitVector[index])->SetAvailability(true);
+    }
+
+    for (const unsigned int index : unavailableIndices)
     {
-        this->Modifiable(pCaloHit)->SetAvailability(caloHitUsageMap.at(pCaloHit));
+        if (index >= m_indexedCaloHitVector.size())
+            return STATUS_CODE_FAILURE;
+
+        this->Modifiable(m_indexedCaloHitVector[index])->SetAvailability(false);
     }
 
     return STATUS_CODE_SUCCESS;
@@ -440,11 +1109,31 @@ StatusCode CaloHitManager::Update(const CaloHitReplacement &caloHitReplacement)
     for (const CaloHit *const pCaloHit : caloHitReplacement.m_oldCaloHits)
         delete pCaloHit;
 
+    // ATTN Replaced calo hits may appear in any list, so all indices are discarded, as are the neighbour graph and hit grids over the input hits
+    m_isInputSnapshotValid = false;
+    m_isInputTimeIndexValid = false;
+    m_isNeighbourGraphValid = false;
+    m_larTPCHitGridMap.clear();
+    m_areLArTPCHitGridsValid = false;
+    this->InvalidateSpatialIndices();
     return STATUS_CODE_SUCCESS;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+StatusCode CaloHitManager::ApplyCaloHitReplacement(CaloHitReplacement *const pCaloHitReplacement)
+{
+    if (m_nReclusteringProcesses > 0)
+        return m_pCurrentReclusterMetadata->GetCurrentCaloHitMetadata()->Update(pCaloHitReplacement);
+
+    const StatusCode statusCode(this->Update(*pCaloHitReplacement));
+    delete pCaloHitReplacement;
+
+    return statusCode;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 StatusCode CaloHitManager::Update(CaloHitList *const pCaloHitList, const CaloHitReplacement &caloHitReplacement)
 {
     if (caloHitReplacement.m_newCaloHits.empty() || caloHitReplacement.m_oldCaloHits.empty())
@@ -486,4 +1175,53 @@ StatusCode CaloHitManager::Update(CaloHitList *const pCaloHitList, const CaloHit
     return STATUS_CODE_SUCCESS;
 }
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void CaloHitManager::InvalidateSpatialIndices(const std::string &listName)
+{
+    m_spatialIndexMap.erase(listName);
+
+    HitTypeSpatialIndexMap::iterator iter(m_hitTypeSpatialIndexMap.lower_bound(ListNameAndHitType(listName, TRACKER)));
+
+    while ((m_hitTypeSpatialIndexMap.end() != iter) && (listName == iter->first.first))
+        iter = m_hitTypeSpatialIndexMap.erase(iter);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void CaloHitManager::InvalidateSpatialIndices()
+{
+    m_spatialIndexMap.clear();
+    m_hitTypeSpatialIndexMap.clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+CaloHitManager::MCPfoTargetMatchingTask::MCPfoTargetMatchingTask(const CaloHitManager &caloHitManager, const CaloHitVector &caloHitVector,
+        const UidToMCParticleWeightTable &caloHitToPfoTargetsMap) :
+    m_caloHitManager(caloHitManager),
+    m_caloHitVector(caloHitVector),
+    m_caloHitToPfoTargetsMap(caloHitToPfoTargetsMap)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode CaloHitManager::MCPfoTargetMatchingTask::Run(const unsigned int index) const
+{
+    const CaloHit *const pCaloHit(m_caloHitVector[index]);
+
+    // ATTN Shared calo hits keep the mc particle relationships assigned by their owning instance
+    if (m_caloHitManager.IsShared(pCaloHit))
+        return STATUS_CODE_SUCCESS;
+
+    const MCParticleWeightMap *const pMCParticleWeightMap(m_caloHitToPfoTargetsMap.Find(pCaloHit->GetParentAddress()));
+
+    if (pMCParticleWeightMap)
+        m_caloHitManager.Modifiable(pCaloHit)->SetMCParticleWeightMap(*pMCParticleWeightMap);
+
+    return STATUS_CODE_SUCCESS;
+}
+
 } // namespace pandora
@@ -8,9 +8,14 @@
 
 #include "Managers/ClusterManager.h"
 
+#include "Objects/CaloHit.h"
 #include "Objects/Cluster.h"
 
+#include "Pandora/HotPathCounters.h"
 #include "Pandora/ObjectFactory.h"
+#include "Pandora/Pandora.h"
+#include "Pandora/PandoraObjectFactories.h"
+#include "Pandora/PandoraSettings.h"
 
 #include <algorithm>
 
@@ -42,17 +47,22 @@ StatusCode ClusterManager::Create(const object_creation::Cluster::Parameters &pa
         if (!m_canMakeNewObjects)
             throw StatusCodeException(STATUS_CODE_NOT_ALLOWED);
 
+        if (!this->IsWithinObjectBudget(1))
+            throw StatusCodeException(STATUS_CODE_BUDGET_EXCEEDED);
+
         NameToListMap::iterator iter = m_nameToListMap.find(m_currentListName);
 
         if (m_nameToListMap.end() == iter)
              throw StatusCodeException(STATUS_CODE_NOT_INITIALIZED);
 
-        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, factory.Create(parameters, pCluster));
+        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, factory.CreateObject(parameters, pCluster));
 
         if (!pCluster)
              throw StatusCodeException(STATUS_CODE_FAILURE);
 
-        iter->second->push_back(pCluster);
+        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->AddObjectToList(iter->second, pCluster));
+        this->AssignIndex(pCluster);
+        this->IndexCaloHits(pCluster, pCluster);
         return STATUS_CODE_SUCCESS;
     }
     catch (StatusCodeException &statusCodeException)
@@ -109,54 +119,142 @@ void ClusterManager::SetAvailability(const ClusterList *const pClusterList, bool
 
 StatusCode ClusterManager::AddToCluster(const Cluster *const pCluster, const CaloHit *const pCaloHit)
 {
-    return this->Modifiable(pCluster)->AddCaloHit(pCaloHit);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->Modifiable(pCluster)->AddCaloHit(pCaloHit));
+    this->IndexCaloHit(pCaloHit, pCluster);
+    m_currentListPairFinder.Update(pCluster);
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode ClusterManager::AddToCluster(const Cluster *const pCluster, const CaloHitList &caloHitList)
+{
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->Modifiable(pCluster)->AddCaloHits(caloHitList));
+
+    for (const CaloHit *const pCaloHit : caloHitList)
+        this->IndexCaloHit(pCaloHit, pCluster);
+
+    m_currentListPairFinder.Update(pCluster);
+
+    return STATUS_CODE_SUCCESS;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 StatusCode ClusterManager::RemoveFromCluster(const Cluster *const pCluster, const CaloHit *const pCaloHit)
 {
-    return this->Modifiable(pCluster)->RemoveCaloHit(pCaloHit);
+    // ATTN Removing the last calo hit resets all cluster properties, dropping the isolated calo hits
+    const CaloHitList droppedIsolatedCaloHitList((pCluster->GetNCaloHits() > 1) ? CaloHitList() : pCluster->GetIsolatedCaloHitList());
+
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->Modifiable(pCluster)->RemoveCaloHit(pCaloHit));
+    this->UnindexCaloHit(pCaloHit, pCluster);
+
+    for (const CaloHit *const pIsolatedCaloHit : droppedIsolatedCaloHitList)
+        this->UnindexCaloHit(pIsolatedCaloHit, pCluster);
+
+    m_currentListPairFinder.Update(pCluster);
+
+    return STATUS_CODE_SUCCESS;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 StatusCode ClusterManager::AddIsolatedToCluster(const Cluster *const pCluster, const CaloHit *const pCaloHit)
 {
-    return this->Modifiable(pCluster)->AddIsolatedCaloHit(pCaloHit);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->Modifiable(pCluster)->AddIsolatedCaloHit(pCaloHit));
+    this->IndexCaloHit(pCaloHit, pCluster);
+
+    return STATUS_CODE_SUCCESS;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 StatusCode ClusterManager::RemoveIsolatedFromCluster(const Cluster *const pCluster, const CaloHit *const pCaloHit)
 {
-    return this->Modifiable(pCluster)->RemoveIsolatedCaloHit(pCaloHit);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->Modifiable(pCluster)->RemoveIsolatedCaloHit(pCaloHit));
+    this->UnindexCaloHit(pCaloHit, pCluster);
+
+    return STATUS_CODE_SUCCESS;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 StatusCode ClusterManager::MergeAndDeleteClusters(const Cluster *const pClusterToEnlarge, const Cluster *const pClusterToDelete, const std::string &enlargeListName,
     const std::string &deleteListName)
+{
+    PANDORA_INCREMENT_HOT_PATH_COUNTER(HOT_PATH_MERGE_AND_DELETE_CLUSTERS);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->CheckMergeClusters(pClusterToEnlarge, pClusterToDelete, enlargeListName, deleteListName));
+    this->IndexCaloHits(pClusterToDelete, pClusterToEnlarge);
+
+    // ATTN The cluster to delete is destroyed immediately, so its calo hit storage can be transferred rather than copied
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->Modifiable(pClusterToEnlarge)->TransferHitsFromSecondCluster(this->Modifiable(pClusterToDelete)));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->DeleteObject(pClusterToDelete, deleteListName));
+    m_currentListPairFinder.Update(pClusterToEnlarge);
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode ClusterManager::MergeAndDetachClusters(const Cluster *const pClusterToEnlarge, const Cluster *const pClusterToDelete,
+    const std::string &enlargeListName, const std::string &deleteListName, const Cluster *&pNextCluster)
+{
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->CheckMergeClusters(pClusterToEnlarge, pClusterToDelete, enlargeListName, deleteListName));
+    this->IndexCaloHits(pClusterToDelete, pClusterToEnlarge);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->Modifiable(pClusterToEnlarge)->AddHitsFromSecondCluster(pClusterToDelete));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->DetachObject(pClusterToDelete, deleteListName, pNextCluster));
+    m_currentListPairFinder.Update(pClusterToEnlarge);
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode ClusterManager::CheckMergeClusters(const Cluster *const pClusterToEnlarge, const Cluster *const pClusterToDelete,
+    const std::string &enlargeListName, const std::string &deleteListName) const
 {
     if (pClusterToEnlarge == pClusterToDelete)
         return STATUS_CODE_INVALID_PARAMETER;
 
-    NameToListMap::iterator enlargeListIter = m_nameToListMap.find(enlargeListName);
-    NameToListMap::iterator deleteListIter = m_nameToListMap.find(deleteListName);
+    NameToListMap::const_iterator enlargeListIter = m_nameToListMap.find(enlargeListName);
+    NameToListMap::const_iterator deleteListIter = m_nameToListMap.find(deleteListName);
 
     if ((m_nameToListMap.end() == enlargeListIter) || (m_nameToListMap.end() == deleteListIter))
         return STATUS_CODE_NOT_INITIALIZED;
 
-    ClusterList::iterator clusterToEnlargeIter = std::find(enlargeListIter->second->begin(), enlargeListIter->second->end(), pClusterToEnlarge);
-    ClusterList::iterator clusterToDeleteIter = std::find(deleteListIter->second->begin(), deleteListIter->second->end(), pClusterToDelete);
-
-    if ((enlargeListIter->second->end() == clusterToEnlargeIter) || (deleteListIter->second->end() == clusterToDeleteIter))
+    if (!this->IsObjectInList(enlargeListIter->second, pClusterToEnlarge) || !this->IsObjectInList(deleteListIter->second, pClusterToDelete))
         return STATUS_CODE_NOT_FOUND;
 
-    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->Modifiable(pClusterToEnlarge)->AddHitsFromSecondCluster(pClusterToDelete));
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode ClusterManager::RemoveCaloHits(const Cluster *const pCluster, const CaloHitList &caloHitList, const CaloHitList &isolatedCaloHitList)
+{
+    Cluster *const pModifiableCluster(this->Modifiable(pCluster));
+
+    for (const CaloHit *const pCaloHit : isolatedCaloHitList)
+    {
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, pModifiableCluster->RemoveIsolatedCaloHit(pCaloHit));
+        this->UnindexCaloHit(pCaloHit, pCluster);
+    }
+
+    // ATTN Removing the last calo hit resets all cluster properties, so the remaining isolated calo hits must be added again
+    const CaloHitList remainingIsolatedCaloHitList((caloHitList.size() < pCluster->GetNCaloHits()) ? CaloHitList() :
+        pCluster->GetIsolatedCaloHitList());
+
+    for (const CaloHit *const pCaloHit : caloHitList)
+    {
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, pModifiableCluster->RemoveCaloHit(pCaloHit));
+        this->UnindexCaloHit(pCaloHit, pCluster);
+    }
+
+    for (const CaloHit *const pCaloHit : remainingIsolatedCaloHitList)
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, pModifiableCluster->AddIsolatedCaloHit(pCaloHit));
 
-    clusterToDeleteIter = deleteListIter->second->erase(clusterToDeleteIter);
-    delete pClusterToDelete;
+    m_currentListPairFinder.Update(pCluster);
 
     return STATUS_CODE_SUCCESS;
 }
@@ -195,34 +293,269 @@ StatusCode ClusterManager::RemoveAllTrackAssociations() const
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-StatusCode ClusterManager::RemoveCurrentTrackAssociations(TrackList &danglingTracks) const
+StatusCode ClusterManager::GetCurrentListSpatialIndex(const ClusterSpatialIndex *&pClusterSpatialIndex)
+{
+    const ClusterList *pClusterList(nullptr);
+    std::string currentListName;
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetCurrentList(pClusterList, currentListName));
+
+    m_currentListSpatialIndex.Fill(*pClusterList);
+    pClusterSpatialIndex = &m_currentListSpatialIndex;
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode ClusterManager::GetCurrentListPairFinder(const ClusterPairFinder *&pClusterPairFinder)
 {
-    NameToListMap::const_iterator iter = m_nameToListMap.find(m_currentListName);
+    const ClusterList *pClusterList(nullptr);
+    std::string currentListName;
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetCurrentList(pClusterList, currentListName));
+
+    m_currentListPairFinder.Fill(*pClusterList);
+    pClusterPairFinder = &m_currentListPairFinder;
+
+    return STATUS_CODE_SUCCESS;
+}
 
-    if (m_nameToListMap.end() == iter)
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode ClusterManager::GetCaloHitCluster(const CaloHit *const pCaloHit, const Cluster *&pCluster) const
+{
+    if (!this->ShouldMaintainCaloHitClusterIndex())
         return STATUS_CODE_NOT_INITIALIZED;
 
-    for (const Cluster *const pCluster : *iter->second)
+    const unsigned int index(pCaloHit->m_index);
+    pCluster = (index < m_caloHitClusterVector.size()) ? m_caloHitClusterVector[index] : nullptr;
+
+    return (pCluster ? STATUS_CODE_SUCCESS : STATUS_CODE_NOT_FOUND);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode ClusterManager::UpdateCaloHitClusterIndex(const std::string &listName)
+{
+    if (!this->ShouldMaintainCaloHitClusterIndex())
+        return STATUS_CODE_SUCCESS;
+
+    const ClusterList *pClusterList(nullptr);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetList(listName, pClusterList));
+
+    for (const Cluster *const pCluster : *pClusterList)
+        this->IndexCaloHits(pCluster, pCluster);
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode ClusterManager::DeleteObject(const Cluster *const pCluster, const std::string &listName)
+{
+    CaloHitList caloHitList;
+    this->GetIndexedCaloHits(pCluster, caloHitList);
+    m_currentListPairFinder.Remove(pCluster);
+
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, AlgorithmObjectManager<Cluster>::DeleteObject(pCluster, listName));
+    this->ClearCaloHitClusterIndex(caloHitList);
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode ClusterManager::DeleteObjects(const ClusterList &clusterList, const std::string &listName)
+{
+    CaloHitList caloHitList;
+
+    for (const Cluster *const pCluster : clusterList)
     {
-        const TrackList trackList(pCluster->GetAssociatedTrackList());
+        this->GetIndexedCaloHits(pCluster, caloHitList);
+        m_currentListPairFinder.Remove(pCluster);
+    }
+
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, AlgorithmObjectManager<Cluster>::DeleteObjects(clusterList, listName));
+    this->ClearCaloHitClusterIndex(caloHitList);
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode ClusterManager::DeleteTemporaryObjects(const Algorithm *const pAlgorithm, const std::string &temporaryListName)
+{
+    CaloHitList caloHitList;
+    NameToListMap::const_iterator listIter = m_nameToListMap.find(temporaryListName);
+
+    if (m_nameToListMap.end() != listIter)
+    {
+        for (const Cluster *const pCluster : *listIter->second)
+            this->GetIndexedCaloHits(pCluster, caloHitList);
+    }
 
-        danglingTracks.insert(danglingTracks.end(), trackList.begin(), trackList.end());
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, AlgorithmObjectManager<Cluster>::DeleteTemporaryObjects(pAlgorithm, temporaryListName));
+    this->ClearCaloHitClusterIndex(caloHitList);
+    m_currentListPairFinder.Clear();
 
-        for (const Track *const pTrack : trackList)
-            PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->RemoveTrackAssociation(pCluster, pTrack));
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode ClusterManager::ResetAlgorithmInfo(const Algorithm *const pAlgorithm, bool isAlgorithmFinished)
+{
+    CaloHitList caloHitList;
+
+    if (this->ShouldMaintainCaloHitClusterIndex())
+    {
+        ClusterList clusterList;
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetResetDeletionObjects(pAlgorithm, clusterList));
+
+        for (const Cluster *const pCluster : clusterList)
+            this->GetIndexedCaloHits(pCluster, caloHitList);
     }
 
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, AlgorithmObjectManager<Cluster>::ResetAlgorithmInfo(pAlgorithm, isAlgorithmFinished));
+    this->ClearCaloHitClusterIndex(caloHitList);
+    m_currentListPairFinder.Clear();
+
     return STATUS_CODE_SUCCESS;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-StatusCode ClusterManager::RemoveTrackAssociations(const TrackToClusterMap &trackToClusterList) const
+StatusCode ClusterManager::DetachObject(const Cluster *const pCluster, const std::string &listName, const Cluster *&pNextCluster)
 {
-    for (TrackToClusterMap::const_iterator iter = trackToClusterList.begin(), iterEnd = trackToClusterList.end(); iter != iterEnd; ++iter)
-        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->RemoveTrackAssociation(iter->second, iter->first));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, AlgorithmObjectManager<Cluster>::DetachObject(pCluster, listName, pNextCluster));
+
+    CaloHitList caloHitList;
+    this->GetIndexedCaloHits(pCluster, caloHitList);
+    this->ClearCaloHitClusterIndex(caloHitList);
+    m_currentListPairFinder.Remove(pCluster);
 
     return STATUS_CODE_SUCCESS;
 }
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode ClusterManager::DetachObjects(const ClusterList &clusterList, const std::string &listName, ObjectVector &nextClusterVector)
+{
+    for (const Cluster *const pCluster : clusterList)
+        m_currentListPairFinder.Remove(pCluster);
+
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, AlgorithmObjectManager<Cluster>::DetachObjects(clusterList, listName, nextClusterVector));
+
+    CaloHitList caloHitList;
+
+    for (const Cluster *const pCluster : clusterList)
+        this->GetIndexedCaloHits(pCluster, caloHitList);
+
+    this->ClearCaloHitClusterIndex(caloHitList);
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode ClusterManager::ReattachObject(const Cluster *const pCluster, const std::string &listName, const Cluster *const pNextCluster)
+{
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, AlgorithmObjectManager<Cluster>::ReattachObject(pCluster, listName, pNextCluster));
+    this->IndexCaloHits(pCluster, pCluster);
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool ClusterManager::IsInInitialState() const
+{
+    return ((0 == m_currentListSpatialIndex.size()) && m_currentListPairFinder.empty() && m_caloHitClusterVector.empty() &&
+        AlgorithmObjectManager<Cluster>::IsInInitialState());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode ClusterManager::EraseAllContent()
+{
+    m_currentListSpatialIndex.Clear();
+    m_currentListPairFinder.Clear();
+    m_caloHitClusterVector.clear();
+
+    return AlgorithmObjectManager<Cluster>::EraseAllContent();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool ClusterManager::ShouldMaintainCaloHitClusterIndex() const
+{
+    return m_pPandora->GetSettings()->ShouldMaintainCaloHitClusterIndex();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void ClusterManager::IndexCaloHit(const CaloHit *const pCaloHit, const Cluster *const pCluster)
+{
+    if (!this->ShouldMaintainCaloHitClusterIndex())
+        return;
+
+    const unsigned int index(pCaloHit->m_index);
+
+    if (index >= m_caloHitClusterVector.size())
+        m_caloHitClusterVector.resize(index + 1, nullptr);
+
+    m_caloHitClusterVector[index] = pCluster;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void ClusterManager::IndexCaloHits(const Cluster *const pSourceCluster, const Cluster *const pCluster)
+{
+    if (!this->ShouldMaintainCaloHitClusterIndex())
+        return;
+
+    for (const CaloHit *const pCaloHit : pSourceCluster->GetOrderedCaloHitList().GetCaloHitRange())
+        this->IndexCaloHit(pCaloHit, pCluster);
+
+    for (const CaloHit *const pCaloHit : pSourceCluster->GetIsolatedCaloHitList())
+        this->IndexCaloHit(pCaloHit, pCluster);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void ClusterManager::UnindexCaloHit(const CaloHit *const pCaloHit, const Cluster *const pCluster)
+{
+    const unsigned int index(pCaloHit->m_index);
+
+    if ((index < m_caloHitClusterVector.size()) && (pCluster == m_caloHitClusterVector[index]))
+        m_caloHitClusterVector[index] = nullptr;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void ClusterManager::GetIndexedCaloHits(const Cluster *const pCluster, CaloHitList &caloHitList) const
+{
+    if (m_caloHitClusterVector.empty())
+        return;
+
+    for (const CaloHit *const pCaloHit : pCluster->GetOrderedCaloHitList().GetCaloHitRange())
+    {
+        if ((pCaloHit->m_index < m_caloHitClusterVector.size()) && (pCluster == m_caloHitClusterVector[pCaloHit->m_index]))
+            caloHitList.push_back(pCaloHit);
+    }
+
+    for (const CaloHit *const pCaloHit : pCluster->GetIsolatedCaloHitList())
+    {
+        if ((pCaloHit->m_index < m_caloHitClusterVector.size()) && (pCluster == m_caloHitClusterVector[pCaloHit->m_index]))
+            caloHitList.push_back(pCaloHit);
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void ClusterManager::ClearCaloHitClusterIndex(const CaloHitList &caloHitList)
+{
+    for (const CaloHit *const pCaloHit : caloHitList)
+        m_caloHitClusterVector[pCaloHit->m_index] = nullptr;
+}
+
 } // namespace pandora
@@ -13,6 +13,7 @@
 #include "Managers/GeometryManager.h"
 
 #include "Pandora/ObjectFactory.h"
+#include "Pandora/PandoraObjectFactories.h"
 
 #include <algorithm>
 
@@ -23,6 +24,7 @@ GeometryManager::GeometryManager(const Pandora *const pPandora) :
     m_hitTypeToGranularityMap(this->GetDefaultHitTypeToGranularityMap()),
     m_pPandora(pPandora)
 {
+    this->FillLookupArrays();
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -48,6 +50,19 @@ const SubDetector &GeometryManager::GetSubDetector(const std::string &subDetecto
 
 const SubDetector &GeometryManager::GetSubDetector(const SubDetectorType subDetectorType) const
 {
+    if (static_cast<unsigned int>(subDetectorType) < N_SUB_DETECTOR_TYPES)
+    {
+        const unsigned int nSubDetectors(m_nSubDetectorsOfType[subDetectorType]);
+
+        if (0 == nSubDetectors)
+            throw StatusCodeException(STATUS_CODE_NOT_FOUND);
+
+        if (1 != nSubDetectors)
+            throw StatusCodeException(STATUS_CODE_OUT_OF_RANGE);
+
+        return *(m_subDetectorTypeArray[subDetectorType]);
+    }
+
     SubDetectorTypeMap::const_iterator iter = m_subDetectorTypeMap.find(subDetectorType);
 
     if (m_subDetectorTypeMap.end() == iter)
@@ -73,6 +88,9 @@ const LArTPC &GeometryManager::GetLArTPC() const
 
 Granularity GeometryManager::GetHitTypeGranularity(const HitType hitType) const
 {
+    if ((static_cast<unsigned int>(hitType) < N_HIT_TYPES) && m_isHitTypeGranularitySet[hitType])
+        return m_hitTypeGranularityArray[hitType];
+
     HitTypeToGranularityMap::const_iterator iter = m_hitTypeToGranularityMap.find(hitType);
 
     if (m_hitTypeToGranularityMap.end() != iter)
@@ -91,12 +109,13 @@ StatusCode GeometryManager::CreateSubDetector(const object_creation::Geometry::S
 
     try
     {
-        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, factory.Create(parameters, pSubDetector));
+        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, factory.CreateObject(parameters, pSubDetector));
 
         if (!m_subDetectorMap.insert(SubDetectorMap::value_type(pSubDetector->GetSubDetectorName(), pSubDetector)).second)
             throw StatusCodeException(STATUS_CODE_FAILURE);
 
         m_subDetectorTypeMap.insert(SubDetectorTypeMap::value_type(pSubDetector->GetSubDetectorType(), pSubDetector));
+        this->FillLookupArrays();
     }
     catch (StatusCodeException &statusCodeException)
     {
@@ -118,10 +137,12 @@ StatusCode GeometryManager::CreateLArTPC(const object_creation::Geometry::LArTPC
 
     try
     {
-        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, factory.Create(parameters, pLArTPC));
+        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, factory.CreateObject(parameters, pLArTPC));
 
         if (!m_larTPCMap.insert(LArTPCMap::value_type(pLArTPC->GetLArTPCVolumeId(), pLArTPC)).second)
             throw StatusCodeException(STATUS_CODE_FAILURE);
+
+        m_larTPCIndex.Fill(m_larTPCMap);
     }
     catch (StatusCodeException &statusCodeException)
     {
@@ -143,11 +164,12 @@ StatusCode GeometryManager::CreateGap(const PARAMETERS &parameters, const Object
 
     try
     {
-        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, factory.Create(parameters, pDetectorGap));
+        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, factory.CreateObject(parameters, pDetectorGap));
 
         if (!pDetectorGap)
             return STATUS_CODE_FAILURE;
 
+        m_detectorGapIndex.Add(pDetectorGap);
         m_detectorGapList.push_back(pDetectorGap);
         return STATUS_CODE_SUCCESS;
     }
@@ -162,6 +184,155 @@ StatusCode GeometryManager::CreateGap(const PARAMETERS &parameters, const Object
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+StatusCode GeometryManager::CreateSubDetectors(const std::vector<object_creation::Geometry::SubDetector::Parameters> &parametersVector,
+    const ObjectFactory<object_creation::Geometry::SubDetector::Parameters, object_creation::Geometry::SubDetector::Object> &factory)
+{
+    std::vector<const SubDetector*> subDetectorVector;
+    subDetectorVector.reserve(parametersVector.size());
+    unsigned int nRegistered(0);
+
+    try
+    {
+        for (const object_creation::Geometry::SubDetector::Parameters &parameters : parametersVector)
+        {
+            const SubDetector *pSubDetector(nullptr);
+            const StatusCode statusCode(factory.CreateObject(parameters, pSubDetector));
+
+            if (pSubDetector)
+                subDetectorVector.push_back(pSubDetector);
+
+            if (STATUS_CODE_SUCCESS != statusCode)
+                throw StatusCodeException(statusCode);
+
+            if (!pSubDetector)
+                throw StatusCodeException(STATUS_CODE_FAILURE);
+        }
+
+        for (const SubDetector *const pSubDetector : subDetectorVector)
+        {
+            if (!m_subDetectorMap.insert(SubDetectorMap::value_type(pSubDetector->GetSubDetectorName(), pSubDetector)).second)
+                throw StatusCodeException(STATUS_CODE_FAILURE);
+
+            ++nRegistered;
+        }
+    }
+    catch (StatusCodeException &statusCodeException)
+    {
+        std::cout << "Failed to create sub detectors: " << statusCodeException.ToString() << std::endl;
+
+        for (unsigned int i = 0; i < nRegistered; ++i)
+            m_subDetectorMap.erase(subDetectorVector[i]->GetSubDetectorName());
+
+        for (const SubDetector *const pSubDetector : subDetectorVector)
+            delete pSubDetector;
+
+        return statusCodeException.GetStatusCode();
+    }
+
+    for (const SubDetector *const pSubDetector : subDetectorVector)
+        m_subDetectorTypeMap.insert(SubDetectorTypeMap::value_type(pSubDetector->GetSubDetectorType(), pSubDetector));
+
+    this->FillLookupArrays();
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode GeometryManager::CreateLArTPCs(const std::vector<object_creation::Geometry::LArTPC::Parameters> &parametersVector,
+    const ObjectFactory<object_creation::Geometry::LArTPC::Parameters, object_creation::Geometry::LArTPC::Object> &factory)
+{
+    std::vector<const LArTPC*> larTPCVector;
+    larTPCVector.reserve(parametersVector.size());
+    unsigned int nRegistered(0);
+
+    try
+    {
+        for (const object_creation::Geometry::LArTPC::Parameters &parameters : parametersVector)
+        {
+            const LArTPC *pLArTPC(nullptr);
+            const StatusCode statusCode(factory.CreateObject(parameters, pLArTPC));
+
+            if (pLArTPC)
+                larTPCVector.push_back(pLArTPC);
+
+            if (STATUS_CODE_SUCCESS != statusCode)
+                throw StatusCodeException(statusCode);
+
+            if (!pLArTPC)
+                throw StatusCodeException(STATUS_CODE_FAILURE);
+        }
+
+        for (const LArTPC *const pLArTPC : larTPCVector)
+        {
+            if (!m_larTPCMap.insert(LArTPCMap::value_type(pLArTPC->GetLArTPCVolumeId(), pLArTPC)).second)
+                throw StatusCodeException(STATUS_CODE_FAILURE);
+
+            ++nRegistered;
+        }
+
+        m_larTPCIndex.Fill(m_larTPCMap);
+    }
+    catch (StatusCodeException &statusCodeException)
+    {
+        std::cout << "Failed to create lar tpcs: " << statusCodeException.ToString() << std::endl;
+
+        for (unsigned int i = 0; i < nRegistered; ++i)
+            m_larTPCMap.erase(larTPCVector[i]->GetLArTPCVolumeId());
+
+        for (const LArTPC *const pLArTPC : larTPCVector)
+            delete pLArTPC;
+
+        m_larTPCIndex.Fill(m_larTPCMap);
+        return statusCodeException.GetStatusCode();
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename PARAMETERS, typename OBJECT>
+StatusCode GeometryManager::CreateGaps(const std::vector<PARAMETERS> &parametersVector, const ObjectFactory<PARAMETERS, OBJECT> &factory)
+{
+    std::vector<const OBJECT*> detectorGapVector;
+    detectorGapVector.reserve(parametersVector.size());
+
+    try
+    {
+        for (const PARAMETERS &parameters : parametersVector)
+        {
+            const OBJECT *pDetectorGap(nullptr);
+            const StatusCode statusCode(factory.CreateObject(parameters, pDetectorGap));
+
+            if (pDetectorGap)
+                detectorGapVector.push_back(pDetectorGap);
+
+            if (STATUS_CODE_SUCCESS != statusCode)
+                throw StatusCodeException(statusCode);
+
+            if (!pDetectorGap)
+                throw StatusCodeException(STATUS_CODE_FAILURE);
+        }
+
+        // ATTN The index adds either all gaps in the batch or, if it throws, none of them
+        m_detectorGapIndex.Add(detectorGapVector);
+    }
+    catch (StatusCodeException &statusCodeException)
+    {
+        std::cout << "Failed to create gaps: " << statusCodeException.ToString() << std::endl;
+
+        for (const OBJECT *const pDetectorGap : detectorGapVector)
+            delete pDetectorGap;
+
+        return statusCodeException.GetStatusCode();
+    }
+
+    m_detectorGapList.insert(m_detectorGapList.end(), detectorGapVector.begin(), detectorGapVector.end());
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 StatusCode GeometryManager::EraseAllContent()
 {
     for (const SubDetectorMap::value_type &mapEntry : m_subDetectorMap)
@@ -175,9 +346,12 @@ StatusCode GeometryManager::EraseAllContent()
 
     m_subDetectorMap.clear();
     m_larTPCMap.clear();
+    m_larTPCIndex.Clear();
     m_subDetectorTypeMap.clear();
     m_detectorGapList.clear();
+    m_detectorGapIndex.Clear();
     m_hitTypeToGranularityMap.clear();
+    this->FillLookupArrays();
 
     return STATUS_CODE_SUCCESS;
 }
@@ -218,9 +392,49 @@ StatusCode GeometryManager::SetHitTypeGranularity(const HitType hitType, const G
         m_hitTypeToGranularityMap[hitType] = granularity;
     }
 
+    this->FillLookupArrays();
     return STATUS_CODE_SUCCESS;
 }
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void GeometryManager::FillLookupArrays()
+{
+    for (unsigned int i = 0; i < N_SUB_DETECTOR_TYPES; ++i)
+    {
+        m_subDetectorTypeArray[i] = nullptr;
+        m_nSubDetectorsOfType[i] = 0;
+    }
+
+    for (const SubDetectorTypeMap::value_type &mapEntry : m_subDetectorTypeMap)
+    {
+        const unsigned int index(static_cast<unsigned int>(mapEntry.first));
+
+        if (index >= N_SUB_DETECTOR_TYPES)
+            continue;
+
+        if (0 == m_nSubDetectorsOfType[index]++)
+            m_subDetectorTypeArray[index] = mapEntry.second;
+    }
+
+    for (unsigned int i = 0; i < N_HIT_TYPES; ++i)
+    {
+        m_hitTypeGranularityArray[i] = VERY_FINE;
+        m_isHitTypeGranularitySet[i] = false;
+    }
+
+    for (const HitTypeToGranularityMap::value_type &mapEntry : m_hitTypeToGranularityMap)
+    {
+        const unsigned int index(static_cast<unsigned int>(mapEntry.first));
+
+        if (index >= N_HIT_TYPES)
+            continue;
+
+        m_hitTypeGranularityArray[index] = mapEntry.second;
+        m_isHitTypeGranularitySet[index] = true;
+    }
+}
+
 //------------------------------------------------------------------------------------------------------------------------------------------
 //------------------------------------------------------------------------------------------------------------------------------------------
 
@@ -228,4 +442,8 @@ template StatusCode GeometryManager::CreateGap(const object_creation::Geometry::
 template StatusCode GeometryManager::CreateGap(const object_creation::Geometry::BoxGap::Parameters &, const ObjectFactory<object_creation::Geometry::BoxGap::Parameters, object_creation::Geometry::BoxGap::Object> &);
 template StatusCode GeometryManager::CreateGap(const object_creation::Geometry::ConcentricGap::Parameters &, const ObjectFactory<object_creation::Geometry::ConcentricGap::Parameters, object_creation::Geometry::ConcentricGap::Object> &);
 
+template StatusCode GeometryManager::CreateGaps(const std::vector<object_creation::Geometry::LineGap::Parameters> &, const ObjectFactory<object_creation::Geometry::LineGap::Parameters, object_creation::Geometry::LineGap::Object> &);
+template StatusCode GeometryManager::CreateGaps(const std::vector<object_creation::Geometry::BoxGap::Parameters> &, const ObjectFactory<object_creation::Geometry::BoxGap::Parameters, object_creation::Geometry::BoxGap::Object> &);
+template StatusCode GeometryManager::CreateGaps(const std::vector<object_creation::Geometry::ConcentricGap::Parameters> &, const ObjectFactory<object_creation::Geometry::ConcentricGap::Parameters, object_creation::Geometry::ConcentricGap::Object> &);
+
 } // namespace pandora
@@ -12,7 +12,10 @@
 #include "Objects/MCParticle.h"
 #include "Objects/Track.h"
 
+#include "Pandora/HotPathCounters.h"
+#include "Pandora/Pandora.h"
 #include "Pandora/PandoraInternal.h"
+#include "Pandora/PandoraSettings.h"
 
 #include <algorithm>
 #include <unordered_set>
@@ -23,7 +26,8 @@ namespace pandora
 template<typename T>
 InputObjectManager<T>::InputObjectManager(const Pandora *const pPandora) :
     Manager<T>(pPandora),
-    m_inputListName("Input")
+    m_inputListName("Input"),
+    m_nErasedEvents(0)
 {
 }
 
@@ -48,6 +52,7 @@ StatusCode InputObjectManager<T>::CreateInputList()
     existingListIter->second->sort(PointerLessThan<T>());
 
     Manager<T>::m_currentListName = m_inputListName;
+    Manager<T>::m_pCurrentList = nullptr;
     return STATUS_CODE_SUCCESS;
 }
 
@@ -68,10 +73,12 @@ StatusCode InputObjectManager<T>::CreateTemporaryListAndSetCurrent(const Algorit
 template<typename T>
 StatusCode InputObjectManager<T>::SaveList(const std::string &listName, const ObjectList &objectList)
 {
+    PANDORA_INCREMENT_HOT_PATH_COUNTER(HOT_PATH_SAVE_OBJECTS);
+
     if (Manager<T>::m_nameToListMap.end() != Manager<T>::m_nameToListMap.find(listName))
         return this->AddObjectsToList(listName, objectList);
 
-    ObjectList *const pObjectList(new ObjectList);
+    ObjectList *const pObjectList(new ObjectList(objectList));
 
     if (!Manager<T>::m_nameToListMap.insert(typename Manager<T>::NameToListMap::value_type(listName, pObjectList)).second)
     {
@@ -79,7 +86,6 @@ StatusCode InputObjectManager<T>::SaveList(const std::string &listName, const Ob
         return STATUS_CODE_ALREADY_PRESENT;
     }
 
-    *(Manager<T>::m_nameToListMap[listName]) = objectList;
     Manager<T>::m_savedLists.insert(listName);
 
     return STATUS_CODE_SUCCESS;
@@ -105,6 +111,7 @@ StatusCode InputObjectManager<T>::AddObjectsToList(const std::string &listName,
 
     // ATTN For look-up efficiency
     std::unordered_set<const T*> savedSet(pSavedList->begin(), pSavedList->end());
+    savedSet.reserve(pSavedList->size() + objectList.size());
 
     for (const T *const pT : objectList)
     {
@@ -133,12 +140,19 @@ StatusCode InputObjectManager<T>::RemoveObjectsFromList(const std::string &listN
     if (pSavedList == &objectList)
         return STATUS_CODE_INVALID_PARAMETER;
 
-    for (const T *const pT : objectList)
-    {
-        typename ObjectList::iterator savedObjectIter = std::find(pSavedList->begin(), pSavedList->end(), pT);
+    // ATTN For look-up efficiency, single pass over the saved list
+    const std::unordered_set<const T*> removalSet(objectList.begin(), objectList.end());
 
-        if (pSavedList->end() != savedObjectIter)
+    for (typename ObjectList::iterator savedObjectIter = pSavedList->begin(); savedObjectIter != pSavedList->end(); )
+    {
+        if (removalSet.count(*savedObjectIter))
+        {
             savedObjectIter = pSavedList->erase(savedObjectIter);
+        }
+        else
+        {
+            ++savedObjectIter;
+        }
     }
 
     return STATUS_CODE_SUCCESS;
@@ -157,6 +171,14 @@ StatusCode InputObjectManager<T>::RenameList(const std::string &oldListName, con
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+template<typename T>
+bool InputObjectManager<T>::IsInInitialState() const
+{
+    return ((0 == Manager<T>::GetIndexUpperBound()) && Manager<T>::HasOnlyInitialLists(m_inputListName));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 template<typename T>
 StatusCode InputObjectManager<T>::EraseAllContent()
 {
@@ -172,6 +194,7 @@ StatusCode InputObjectManager<T>::EraseAllContent()
             delete pT;
     }
 
+    ++m_nErasedEvents;
     return Manager<T>::EraseAllContent();
 }
 
@@ -187,6 +210,53 @@ StatusCode InputObjectManager<T>::CreateInitialLists()
     return STATUS_CODE_SUCCESS;
 }
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template<typename T>
+unsigned int InputObjectManager<T>::GetNOwnedObjects() const
+{
+    typename Manager<T>::NameToListMap::const_iterator inputIter = Manager<T>::m_nameToListMap.find(m_inputListName);
+
+    return ((Manager<T>::m_nameToListMap.end() == inputIter) ? 0 : inputIter->second->size());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template<typename T>
+StatusCode InputObjectManager<T>::ReserveInputList(const unsigned int nObjects)
+{
+    typename Manager<T>::NameToListMap::iterator inputIter = Manager<T>::m_nameToListMap.find(m_inputListName);
+
+    if (Manager<T>::m_nameToListMap.end() == inputIter)
+        return STATUS_CODE_FAILURE;
+
+#if defined(PANDORA_CONTIGUOUS_MANAGED_CONTAINER)
+    inputIter->second->reserve(nObjects);
+#else
+    (void) nObjects;
+#endif
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template<typename T>
+bool InputObjectManager<T>::ShouldValidateInputParameters() const
+{
+#ifndef NDEBUG
+    return true;
+#else
+    const PandoraSettings *const pSettings(Manager<T>::m_pPandora->GetSettings());
+
+    if (!pSettings->ShouldTrustInputObjects() || (0 == m_nErasedEvents))
+        return true;
+
+    const unsigned int validationInterval(pSettings->GetTrustedInputValidationInterval());
+    return ((validationInterval > 0) && (0 == m_nErasedEvents % validationInterval));
+#endif
+}
+
 //------------------------------------------------------------------------------------------------------------------------------------------
 //------------------------------------------------------------------------------------------------------------------------------------------
 
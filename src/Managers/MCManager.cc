@@ -13,17 +13,24 @@
 #include "Pandora/ObjectFactory.h"
 #include "Pandora/Pandora.h"
 #include "Pandora/PandoraInternal.h"
+#include "Pandora/PandoraObjectFactories.h"
 #include "Pandora/PandoraSettings.h"
 #include "Pandora/PdgTable.h"
 
 #include <algorithm>
+#include <numeric>
 
 namespace pandora
 {
 
+const unsigned int MCManager::m_maxDenseUid(1 << 26);
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 MCManager::MCManager(const Pandora *const pPandora) :
     InputObjectManager<MCParticle>(pPandora),
-    m_selectedListName("Selected")
+    m_selectedListName("Selected"),
+    m_nDenseMCParticles(0)
 {
     PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->CreateInitialLists());
 }
@@ -44,17 +51,20 @@ StatusCode MCManager::Create(const object_creation::MCParticle::Parameters &para
 
     try
     {
-        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, factory.Create(parameters, pMCParticle));
+        if (!this->IsWithinObjectBudget(1))
+            throw StatusCodeException(STATUS_CODE_BUDGET_EXCEEDED);
+
+        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, factory.CreateObject(parameters, pMCParticle));
 
         NameToListMap::iterator inputIter = m_nameToListMap.find(m_inputListName);
 
         if (!pMCParticle || (m_nameToListMap.end() == inputIter))
             throw StatusCodeException(STATUS_CODE_FAILURE);
 
-        if (!m_uidToMCParticleMap.insert(UidToMCParticleMap::value_type(pMCParticle->GetUid(), pMCParticle)).second)
-            throw StatusCodeException(STATUS_CODE_ALREADY_PRESENT);
+        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->RegisterMCParticle(pMCParticle));
 
         inputIter->second->push_back(pMCParticle);
+        this->AssignIndex(pMCParticle);
         return STATUS_CODE_SUCCESS;
     }
     catch (StatusCodeException &statusCodeException)
@@ -68,21 +78,138 @@ StatusCode MCManager::Create(const object_creation::MCParticle::Parameters &para
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+StatusCode MCManager::Create(const std::vector<object_creation::MCParticle::Parameters> &parametersVector,
+    const ObjectFactory<object_creation::MCParticle::Parameters, object_creation::MCParticle::Object> &factory)
+{
+    NameToListMap::iterator inputIter = m_nameToListMap.find(m_inputListName);
+
+    if (m_nameToListMap.end() == inputIter)
+        return STATUS_CODE_FAILURE;
+
+    MCParticleVector mcParticleVector;
+    mcParticleVector.reserve(parametersVector.size());
+    unsigned int nRegistered(0);
+
+    if (!this->UseDenseUids())
+        m_uidToMCParticleMap.reserve(m_uidToMCParticleMap.size() + parametersVector.size());
+
+    try
+    {
+        if (!this->IsWithinObjectBudget(parametersVector.size()))
+            throw StatusCodeException(STATUS_CODE_BUDGET_EXCEEDED);
+
+        for (const object_creation::MCParticle::Parameters &parameters : parametersVector)
+        {
+            const MCParticle *pMCParticle(nullptr);
+            const StatusCode statusCode(factory.CreateObject(parameters, pMCParticle));
+
+            if (pMCParticle)
+                mcParticleVector.push_back(pMCParticle);
+
+            if (STATUS_CODE_SUCCESS != statusCode)
+                throw StatusCodeException(statusCode);
+
+            if (!pMCParticle)
+                throw StatusCodeException(STATUS_CODE_FAILURE);
+        }
+
+        for (const MCParticle *const pMCParticle : mcParticleVector)
+        {
+            PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->RegisterMCParticle(pMCParticle));
+            ++nRegistered;
+        }
+    }
+    catch (StatusCodeException &statusCodeException)
+    {
+        std::cout << "Failed to create mc particles: " << statusCodeException.ToString() << std::endl;
+
+        for (unsigned int i = 0; i < nRegistered; ++i)
+            this->DeregisterMCParticle(mcParticleVector[i]);
+
+        for (const MCParticle *const pMCParticle : mcParticleVector)
+            delete pMCParticle;
+
+        return statusCodeException.GetStatusCode();
+    }
+
+    inputIter->second->insert(inputIter->second->end(), mcParticleVector.begin(), mcParticleVector.end());
+
+    for (const MCParticle *const pMCParticle : mcParticleVector)
+        this->AssignIndex(pMCParticle);
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool MCManager::IsInInitialState() const
+{
+    if (!m_uidToMCParticleMap.empty() || !m_parentDaughterRelationMap.empty() || !m_denseUidToMCParticle.empty() ||
+        !m_denseParentDaughterRelations.empty() || !m_caloHitToMCParticleMap.IsEmpty() || !m_trackToMCParticleMap.IsEmpty() ||
+        !m_truthTree.m_mcParticleVector.empty())
+    {
+        return false;
+    }
+
+    return InputObjectManager<MCParticle>::IsInInitialState();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 StatusCode MCManager::EraseAllContent()
 {
     m_uidToMCParticleMap.clear();
     m_parentDaughterRelationMap.clear();
-    m_caloHitToMCParticleMap.clear();
-    m_trackToMCParticleMap.clear();
+    m_denseUidToMCParticle.clear();
+    m_nDenseMCParticles = 0;
+    m_denseParentDaughterRelations.clear();
+    m_caloHitToMCParticleMap.Clear();
+    m_trackToMCParticleMap.Clear();
+    m_truthTree.Clear();
+    m_daughterArray.clear();
+    m_parentArray.clear();
 
     return InputObjectManager<MCParticle>::EraseAllContent();
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+StatusCode MCManager::ReserveCapacity(const unsigned int nMCParticles, const unsigned int nCaloHitRelations, const unsigned int nTrackRelations)
+{
+    // ATTN Typically one parent-daughter relationship per mc particle
+    if (this->UseDenseUids())
+    {
+        m_denseUidToMCParticle.reserve(nMCParticles);
+        m_denseParentDaughterRelations.reserve(nMCParticles);
+        m_caloHitToMCParticleMap.m_uidToWeightMapVector.reserve(nCaloHitRelations);
+        m_trackToMCParticleMap.m_uidToWeightMapVector.reserve(nTrackRelations);
+    }
+    else
+    {
+        m_uidToMCParticleMap.reserve(nMCParticles);
+        m_parentDaughterRelationMap.reserve(nMCParticles);
+        m_caloHitToMCParticleMap.m_objectRelationMap.reserve(nCaloHitRelations);
+        m_trackToMCParticleMap.m_objectRelationMap.reserve(nTrackRelations);
+    }
+
+    return this->ReserveInputList(nMCParticles);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 StatusCode MCManager::SetMCParentDaughterRelationship(const Uid parentUid, const Uid daughterUid)
 {
-    m_parentDaughterRelationMap.insert(MCParticleRelationMap::value_type(parentUid, daughterUid));
+    if (this->UseDenseUids())
+    {
+        unsigned int parentIndex(0), daughterIndex(0);
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, MCManager::GetDenseIndex(parentUid, parentIndex));
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, MCManager::GetDenseIndex(daughterUid, daughterIndex));
+        m_denseParentDaughterRelations.push_back(DenseRelationVector::value_type(parentIndex, daughterIndex));
+    }
+    else
+    {
+        m_parentDaughterRelationMap.insert(MCParticleRelationMap::value_type(parentUid, daughterUid));
+    }
 
     return STATUS_CODE_SUCCESS;
 }
@@ -91,17 +218,63 @@ StatusCode MCManager::SetMCParentDaughterRelationship(const Uid parentUid, const
 
 StatusCode MCManager::IdentifyPfoTargets()
 {
-    NameToListMap::const_iterator inputIter = m_nameToListMap.find(m_inputListName);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->BuildTruthTree());
 
-    if (m_nameToListMap.end() == inputIter)
-        return STATUS_CODE_FAILURE;
+    const float selectionRadius(m_pPandora->GetSettings()->GetMCPfoSelectionRadius());
+    const float selectionMomentum(m_pPandora->GetSettings()->GetMCPfoSelectionMomentum());
+    const float selectionEnergyCutOffProtonsNeutrons(m_pPandora->GetSettings()->GetMCPfoSelectionLowEnergyNeutronProtonCutOff());
 
-    for (const MCParticle *const pMCParticle : *inputIter->second)
+    const MCParticleVector &mcParticleVector(m_truthTree.m_mcParticleVector);
+    const unsigned int nMCParticles(mcParticleVector.size());
+
+    // Apply the pfo selection rules once per particle
+    std::vector<bool> passesSelection(nMCParticles, false);
+
+    for (unsigned int index = 0; index < nMCParticles; ++index)
     {
-        MCParticleSet mcPfoSet;
+        const MCParticle *const pMCParticle(mcParticleVector[index]);
+        const int particleId(pMCParticle->GetParticleId());
 
-        if (pMCParticle->IsRootParticle())
-            PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ApplyPfoSelectionRules(pMCParticle, mcPfoSet));
+        passesSelection[index] = ((pMCParticle->GetOuterRadius() > selectionRadius) &&
+            (pMCParticle->GetInnerRadius() <= selectionRadius) &&
+            (pMCParticle->GetMomentum().GetMagnitude() > selectionMomentum) &&
+            !((particleId == PROTON || particleId == NEUTRON) && (pMCParticle->GetEnergy() < selectionEnergyCutOffProtonsNeutrons)));
+    }
+
+    // Depth-first search from each root particle, descending until reaching particles that pass the selection rules
+    std::vector<bool> isInPfoSet(nMCParticles, false);
+    UIntVector pfoSetIndices, searchStack, indexStack;
+
+    for (unsigned int rootIndex = 0; rootIndex < nMCParticles; ++rootIndex)
+    {
+        if (!mcParticleVector[rootIndex]->IsRootParticle())
+            continue;
+
+        for (const unsigned int index : pfoSetIndices)
+            isInPfoSet[index] = false;
+
+        pfoSetIndices.clear();
+        searchStack.push_back(rootIndex);
+
+        while (!searchStack.empty())
+        {
+            const unsigned int index(searchStack.back());
+            searchStack.pop_back();
+
+            // ATTN: Don't take particles from previously used decay chains; could happen because mc particles can have multiple parents.
+            if (!isInPfoSet[index] && passesSelection[index])
+            {
+                PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->SetPfoTargetInTree(index, indexStack));
+                isInPfoSet[index] = true;
+                pfoSetIndices.push_back(index);
+            }
+            else
+            {
+                // ATTN Reverse order, so that daughters are visited in list order
+                for (unsigned int iD = m_truthTree.m_daughterOffsets[index + 1]; iD > m_truthTree.m_daughterOffsets[index]; --iD)
+                    searchStack.push_back(m_truthTree.m_daughterIndices[iD - 1]);
+            }
+        }
     }
 
     return STATUS_CODE_SUCCESS;
@@ -124,6 +297,7 @@ StatusCode MCManager::SelectPfoTargets()
         ObjectList *const pObjectList(selectedIter->second);
         selectedIter = m_nameToListMap.erase(selectedIter);
         delete pObjectList;
+        m_pCurrentList = nullptr;
     }
 
     // Strip down mc particles and relationships to just those of pfo targets, if specified
@@ -133,77 +307,152 @@ StatusCode MCManager::SelectPfoTargets()
 
     for (const MCParticle *const pMCParticle : *inputIter->second)
     {
-        const bool isPfoTarget(pMCParticle->IsPfoTarget());
+        if (pMCParticle->IsPfoTarget() || !shouldCollapseMCParticlesToPfoTarget)
+            selectedMCPfoList.push_back(pMCParticle);
+    }
+
+    if (shouldCollapseMCParticlesToPfoTarget)
+    {
+        // Retain only the links between pfo targets, rebuilding the relationship arrays in a single pass
+        ParentDaughterLinkVector parentDaughterLinks, pfoTargetLinks;
+        this->GetParentDaughterLinks(*inputIter->second, parentDaughterLinks);
 
-        if (!isPfoTarget && shouldCollapseMCParticlesToPfoTarget)
+        for (const ParentDaughterLink &link : parentDaughterLinks)
         {
-            PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->RemoveMCParticleRelationships(pMCParticle));
+            if (link.first->IsPfoTarget() && link.second->IsPfoTarget())
+                pfoTargetLinks.push_back(link);
         }
 
-        if (isPfoTarget || !shouldCollapseMCParticlesToPfoTarget)
+        this->SetParentDaughterLinks(*inputIter->second, pfoTargetLinks);
+
+        for (const MCParticle *const pMCParticle : *inputIter->second)
         {
-            selectedMCPfoList.push_back(pMCParticle);
+            if (!pMCParticle->IsPfoTarget())
+                PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->Modifiable(pMCParticle)->RemovePfoTarget());
         }
     }
 
     // Save selected pfo target list
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->SaveList(m_selectedListName, selectedMCPfoList));
     m_currentListName = m_selectedListName;
+    m_pCurrentList = nullptr;
 
     return STATUS_CODE_SUCCESS;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-StatusCode MCManager::ApplyPfoSelectionRules(const MCParticle *const pMCParticle, MCParticleSet &mcPfoSet) const
+StatusCode MCManager::BuildTruthTree()
 {
-    const float selectionRadius(m_pPandora->GetSettings()->GetMCPfoSelectionRadius());
-    const float selectionMomentum(m_pPandora->GetSettings()->GetMCPfoSelectionMomentum());
-    const float selectionEnergyCutOffProtonsNeutrons(m_pPandora->GetSettings()->GetMCPfoSelectionLowEnergyNeutronProtonCutOff());
+    m_truthTree.Clear();
 
-    const int particleId(pMCParticle->GetParticleId());
+    const MCParticleList *pInputList(nullptr);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetList(m_inputListName, pInputList));
 
-    // ATTN: Don't take particles from previously used decay chains; could happen because mc particles can have multiple parents.
-    if (!mcPfoSet.count(pMCParticle) &&
-        (pMCParticle->GetOuterRadius() > selectionRadius) &&
-        (pMCParticle->GetInnerRadius() <= selectionRadius) &&
-        (pMCParticle->GetMomentum().GetMagnitude() > selectionMomentum) &&
-        !((particleId == PROTON || particleId == NEUTRON) && (pMCParticle->GetEnergy() < selectionEnergyCutOffProtonsNeutrons)))
+    MCParticleVector &mcParticleVector(m_truthTree.m_mcParticleVector);
+    mcParticleVector.insert(mcParticleVector.end(), pInputList->begin(), pInputList->end());
+    m_truthTree.m_isDense = this->UseDenseUids();
+
+    if (m_truthTree.m_isDense)
     {
-        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->SetPfoTargetInTree(pMCParticle, pMCParticle, true));
-        mcPfoSet.insert(pMCParticle);
+        m_truthTree.m_denseUidToIndex.assign(m_denseUidToMCParticle.size(), std::numeric_limits<unsigned int>::max());
     }
     else
     {
+        m_truthTree.m_uidToIndexMap.reserve(mcParticleVector.size());
+    }
+
+    for (unsigned int index = 0, nMCParticles = mcParticleVector.size(); index < nMCParticles; ++index)
+    {
+        if (m_truthTree.m_isDense)
+        {
+            unsigned int denseIndex(0);
+            PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, MCManager::GetDenseIndex(mcParticleVector[index]->GetUid(), denseIndex));
+
+            if (denseIndex >= m_truthTree.m_denseUidToIndex.size())
+                return STATUS_CODE_NOT_FOUND;
+
+            if (std::numeric_limits<unsigned int>::max() != m_truthTree.m_denseUidToIndex[denseIndex])
+                return STATUS_CODE_ALREADY_PRESENT;
+
+            m_truthTree.m_denseUidToIndex[denseIndex] = index;
+        }
+        else if (!m_truthTree.m_uidToIndexMap.insert(UidToIndexMap::value_type(mcParticleVector[index]->GetUid(), index)).second)
+        {
+            return STATUS_CODE_ALREADY_PRESENT;
+        }
+    }
+
+    m_truthTree.m_daughterOffsets.reserve(mcParticleVector.size() + 1);
+    m_truthTree.m_parentOffsets.reserve(mcParticleVector.size() + 1);
+
+    for (const MCParticle *const pMCParticle : mcParticleVector)
+    {
+        m_truthTree.m_daughterOffsets.push_back(m_truthTree.m_daughterIndices.size());
+        m_truthTree.m_parentOffsets.push_back(m_truthTree.m_parentIndices.size());
+
         for (const MCParticle *const pDaughterMCParticle : pMCParticle->GetDaughterList())
         {
-            PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ApplyPfoSelectionRules(pDaughterMCParticle, mcPfoSet));
+            unsigned int index(0);
+
+            if (!m_truthTree.FindIndex(pDaughterMCParticle->GetUid(), index))
+                return STATUS_CODE_NOT_FOUND;
+
+            m_truthTree.m_daughterIndices.push_back(index);
+        }
+
+        for (const MCParticle *const pParentMCParticle : pMCParticle->GetParentList())
+        {
+            unsigned int index(0);
+
+            if (!m_truthTree.FindIndex(pParentMCParticle->GetUid(), index))
+                return STATUS_CODE_NOT_FOUND;
+
+            m_truthTree.m_parentIndices.push_back(index);
         }
     }
 
+    m_truthTree.m_daughterOffsets.push_back(m_truthTree.m_daughterIndices.size());
+    m_truthTree.m_parentOffsets.push_back(m_truthTree.m_parentIndices.size());
+
     return STATUS_CODE_SUCCESS;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-StatusCode MCManager::SetPfoTargetInTree(const MCParticle *const pMCParticle, const MCParticle *const pPfoTarget, bool onlyDaughters) const
+StatusCode MCManager::SetPfoTargetInTree(const unsigned int pfoTargetIndex, UIntVector &indexStack) const
 {
-    if (pMCParticle->IsPfoTargetSet())
+    const MCParticleVector &mcParticleVector(m_truthTree.m_mcParticleVector);
+    const MCParticle *const pPfoTarget(mcParticleVector[pfoTargetIndex]);
+
+    if (pPfoTarget->IsPfoTargetSet())
         return STATUS_CODE_SUCCESS;
 
-    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->Modifiable(pMCParticle)->SetPfoTarget(pPfoTarget));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->Modifiable(pPfoTarget)->SetPfoTarget(pPfoTarget));
 
-    for (const MCParticle *const pDaughterMCParticle : pMCParticle->GetDaughterList())
-    {
-       PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->SetPfoTargetInTree(pDaughterMCParticle, pPfoTarget));
-    }
+    // ATTN Links are pushed in reverse order, parents before daughters, so that daughters are visited first and in list order
+    indexStack.clear();
 
-    if (!onlyDaughters)
+    for (unsigned int iD = m_truthTree.m_daughterOffsets[pfoTargetIndex + 1]; iD > m_truthTree.m_daughterOffsets[pfoTargetIndex]; --iD)
+        indexStack.push_back(m_truthTree.m_daughterIndices[iD - 1]);
+
+    while (!indexStack.empty())
     {
-        for (const MCParticle *const pParentMCParticle : pMCParticle->GetParentList())
-        {
-            PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->SetPfoTargetInTree(pParentMCParticle, pPfoTarget));
-        }
+        const unsigned int index(indexStack.back());
+        indexStack.pop_back();
+
+        const MCParticle *const pMCParticle(mcParticleVector[index]);
+
+        if (pMCParticle->IsPfoTargetSet())
+            continue;
+
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->Modifiable(pMCParticle)->SetPfoTarget(pPfoTarget));
+
+        for (unsigned int iP = m_truthTree.m_parentOffsets[index + 1]; iP > m_truthTree.m_parentOffsets[index]; --iP)
+            indexStack.push_back(m_truthTree.m_parentIndices[iP - 1]);
+
+        for (unsigned int iD = m_truthTree.m_daughterOffsets[index + 1]; iD > m_truthTree.m_daughterOffsets[index]; --iD)
+            indexStack.push_back(m_truthTree.m_daughterIndices[iD - 1]);
     }
 
     return STATUS_CODE_SUCCESS;
@@ -211,41 +460,89 @@ StatusCode MCManager::SetPfoTargetInTree(const MCParticle *const pMCParticle, co
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-StatusCode MCManager::AddMCParticleRelationships() const
+StatusCode MCManager::AddMCParticleRelationships()
 {
-    if (m_parentDaughterRelationMap.empty())
+    if (m_parentDaughterRelationMap.empty() && m_denseParentDaughterRelations.empty())
         return STATUS_CODE_SUCCESS;
 
     const MCParticleList *pInputList(nullptr);
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetList(m_inputListName, pInputList));
 
-    for (const MCParticle *const pParentMCParticle : *pInputList)
+    // ATTN In dense uid mode, group the daughter uids by parent uid with a counting sort, in place of the relation multimap
+    const bool useDenseUids(this->UseDenseUids());
+    const unsigned int nDenseUids(m_denseUidToMCParticle.size());
+    UIntVector daughterOffsets, daughterIndices;
+
+    if (useDenseUids)
     {
-        const auto range(m_parentDaughterRelationMap.equal_range(pParentMCParticle->GetUid()));
+        daughterOffsets.assign(nDenseUids + 1, 0);
+
+        for (const DenseRelationVector::value_type &relation : m_denseParentDaughterRelations)
+        {
+            if (relation.first < nDenseUids)
+                ++daughterOffsets[relation.first + 1];
+        }
+
+        std::partial_sum(daughterOffsets.begin(), daughterOffsets.end(), daughterOffsets.begin());
+        daughterIndices.resize(daughterOffsets.back());
+        UIntVector insertPositions(daughterOffsets.begin(), daughterOffsets.end() - 1);
 
+        for (const DenseRelationVector::value_type &relation : m_denseParentDaughterRelations)
+        {
+            if (relation.first < nDenseUids)
+                daughterIndices[insertPositions[relation.first]++] = relation.second;
+        }
+    }
+
+    ParentDaughterLinkVector parentDaughterLinks;
+    parentDaughterLinks.reserve(m_daughterArray.size() + (useDenseUids ? m_denseParentDaughterRelations.size() : m_parentDaughterRelationMap.size()));
+
+    for (const MCParticle *const pParentMCParticle : *pInputList)
+    {
         MCParticleList daughterList;
-        for (MCParticleRelationMap::const_iterator relIter = range.first; relIter != range.second; ++relIter)
+
+        if (useDenseUids)
+        {
+            const std::size_t parentIndex(UidToMCParticleWeightTable::GetDenseIndex(pParentMCParticle->GetUid()));
+
+            for (unsigned int iD = daughterOffsets[parentIndex]; iD < daughterOffsets[parentIndex + 1]; ++iD)
+            {
+                const MCParticle *const pDaughterMCParticle((daughterIndices[iD] < nDenseUids) ? m_denseUidToMCParticle[daughterIndices[iD]] : nullptr);
+
+                if (pDaughterMCParticle && (daughterList.end() == std::find(daughterList.begin(), daughterList.end(), pDaughterMCParticle)))
+                    daughterList.push_back(pDaughterMCParticle);
+            }
+        }
+        else
         {
-            UidToMCParticleMap::const_iterator daughterIter = m_uidToMCParticleMap.find(relIter->second);
+            const auto range(m_parentDaughterRelationMap.equal_range(pParentMCParticle->GetUid()));
+
+            for (MCParticleRelationMap::const_iterator relIter = range.first; relIter != range.second; ++relIter)
+            {
+                UidToMCParticleMap::const_iterator daughterIter = m_uidToMCParticleMap.find(relIter->second);
 
-            if ((m_uidToMCParticleMap.end() != daughterIter) && (daughterList.end() == std::find(daughterList.begin(), daughterList.end(), daughterIter->second)))
-                daughterList.push_back(daughterIter->second);
+                if ((m_uidToMCParticleMap.end() != daughterIter) && (daughterList.end() == std::find(daughterList.begin(), daughterList.end(), daughterIter->second)))
+                    daughterList.push_back(daughterIter->second);
+            }
         }
+
         daughterList.sort(PointerLessThan<MCParticle>());
 
-        for (const MCParticle *const pDaughterMCParticle : daughterList)
-        {
-            const StatusCode firstStatusCode(this->Modifiable(pParentMCParticle)->AddDaughter(pDaughterMCParticle));
-            const StatusCode secondStatusCode(this->Modifiable(pDaughterMCParticle)->AddParent(pParentMCParticle));
+        // ATTN New daughters follow any existing daughters of the parent, as links already present are retained
+        const MCParticleRange existingDaughters(pParentMCParticle->GetDaughterList());
 
-            if (firstStatusCode != secondStatusCode)
-                return STATUS_CODE_FAILURE;
+        for (const MCParticle *const pDaughterMCParticle : existingDaughters)
+            parentDaughterLinks.push_back(ParentDaughterLink(pParentMCParticle, pDaughterMCParticle));
 
-            if ((firstStatusCode != STATUS_CODE_SUCCESS) && (firstStatusCode != STATUS_CODE_ALREADY_PRESENT))
-                return firstStatusCode;
+        for (const MCParticle *const pDaughterMCParticle : daughterList)
+        {
+            if (existingDaughters.end() == std::find(existingDaughters.begin(), existingDaughters.end(), pDaughterMCParticle))
+                parentDaughterLinks.push_back(ParentDaughterLink(pParentMCParticle, pDaughterMCParticle));
         }
     }
 
+    this->SetParentDaughterLinks(*pInputList, parentDaughterLinks);
+
     return STATUS_CODE_SUCCESS;
 }
 
@@ -259,114 +556,291 @@ StatusCode MCManager::RemoveAllMCParticleRelationships()
         return STATUS_CODE_FAILURE;
 
     for (const MCParticle *const pMCParticle : *inputIter->second)
-        this->RemoveMCParticleRelationships(pMCParticle);
+    {
+        this->Modifiable(pMCParticle)->SetRelationships(MCParticleRange(), MCParticleRange());
+        (void) this->Modifiable(pMCParticle)->RemovePfoTarget();
+    }
 
+    m_daughterArray.clear();
+    m_parentArray.clear();
     m_uidToMCParticleMap.clear();
     m_parentDaughterRelationMap.clear();
-    m_caloHitToMCParticleMap.clear();
-    m_trackToMCParticleMap.clear();
+    m_denseUidToMCParticle.clear();
+    m_nDenseMCParticles = 0;
+    m_denseParentDaughterRelations.clear();
+    m_caloHitToMCParticleMap.Clear();
+    m_trackToMCParticleMap.Clear();
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void MCManager::GetParentDaughterLinks(const MCParticleList &inputList, ParentDaughterLinkVector &parentDaughterLinks) const
+{
+    parentDaughterLinks.reserve(parentDaughterLinks.size() + m_daughterArray.size());
+
+    for (const MCParticle *const pParentMCParticle : inputList)
+    {
+        for (const MCParticle *const pDaughterMCParticle : pParentMCParticle->GetDaughterList())
+            parentDaughterLinks.push_back(ParentDaughterLink(pParentMCParticle, pDaughterMCParticle));
+    }
+}
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void MCManager::SetParentDaughterLinks(const MCParticleList &inputList, const ParentDaughterLinkVector &parentDaughterLinks)
+{
+    // ATTN Stable sorts group the links by parent and by daughter, retaining the link order within each group
+    ParentDaughterLinkVector linksByParent(parentDaughterLinks), linksByDaughter(parentDaughterLinks);
+    std::stable_sort(linksByParent.begin(), linksByParent.end(), MCManager::IsParentLessThan);
+    std::stable_sort(linksByDaughter.begin(), linksByDaughter.end(), MCManager::IsDaughterLessThan);
+
+    m_daughterArray.clear();
+    m_parentArray.clear();
+    m_daughterArray.reserve(parentDaughterLinks.size());
+    m_parentArray.reserve(parentDaughterLinks.size());
+
+    for (const ParentDaughterLink &link : linksByParent)
+        m_daughterArray.push_back(link.second);
+
+    for (const ParentDaughterLink &link : linksByDaughter)
+        m_parentArray.push_back(link.first);
+
+    const MCParticle *const *const pDaughters(m_daughterArray.data());
+    const MCParticle *const *const pParents(m_parentArray.data());
+
+    for (const MCParticle *const pMCParticle : inputList)
+    {
+        const ParentDaughterLink key(pMCParticle, pMCParticle);
+        const auto daughterBounds(std::equal_range(linksByParent.begin(), linksByParent.end(), key, MCManager::IsParentLessThan));
+        const auto parentBounds(std::equal_range(linksByDaughter.begin(), linksByDaughter.end(), key, MCManager::IsDaughterLessThan));
+
+        const MCParticleRange daughterRange(pDaughters + (daughterBounds.first - linksByParent.begin()), pDaughters + (daughterBounds.second - linksByParent.begin()));
+        const MCParticleRange parentRange(pParents + (parentBounds.first - linksByDaughter.begin()), pParents + (parentBounds.second - linksByDaughter.begin()));
+        this->Modifiable(pMCParticle)->SetRelationships(parentRange, daughterRange);
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool MCManager::IsParentLessThan(const ParentDaughterLink &lhs, const ParentDaughterLink &rhs)
+{
+    return std::less<const MCParticle *>()(lhs.first, rhs.first);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool MCManager::IsDaughterLessThan(const ParentDaughterLink &lhs, const ParentDaughterLink &rhs)
+{
+    return std::less<const MCParticle *>()(lhs.second, rhs.second);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool MCManager::UseDenseUids() const
+{
+    return m_pPandora->GetSettings()->ShouldUseDenseUids();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode MCManager::GetDenseIndex(const Uid uid, unsigned int &index)
+{
+    const std::size_t denseIndex(UidToMCParticleWeightTable::GetDenseIndex(uid));
+
+    if (denseIndex >= m_maxDenseUid)
+        return STATUS_CODE_OUT_OF_RANGE;
+
+    index = static_cast<unsigned int>(denseIndex);
     return STATUS_CODE_SUCCESS;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-StatusCode MCManager::RemoveMCParticleRelationships(const MCParticle *const pMCParticle) const
+StatusCode MCManager::RegisterMCParticle(const MCParticle *const pMCParticle)
 {
-    const MCParticleList parentList(pMCParticle->GetParentList());
+    if (!this->UseDenseUids())
+    {
+        if (!m_uidToMCParticleMap.insert(UidToMCParticleMap::value_type(pMCParticle->GetUid(), pMCParticle)).second)
+            return STATUS_CODE_ALREADY_PRESENT;
+
+        return STATUS_CODE_SUCCESS;
+    }
+
+    unsigned int index(0);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, MCManager::GetDenseIndex(pMCParticle->GetUid(), index));
 
-    for (const MCParticle *const pParentMCParticle : parentList)
+    if (index >= m_denseUidToMCParticle.size())
+        m_denseUidToMCParticle.resize(index + 1, nullptr);
+
+    if (m_denseUidToMCParticle[index])
+        return STATUS_CODE_ALREADY_PRESENT;
+
+    m_denseUidToMCParticle[index] = pMCParticle;
+    ++m_nDenseMCParticles;
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void MCManager::DeregisterMCParticle(const MCParticle *const pMCParticle)
+{
+    if (!this->UseDenseUids())
     {
-        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->Modifiable(pParentMCParticle)->RemoveDaughter(pMCParticle));
-        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->Modifiable(pMCParticle)->RemoveParent(pParentMCParticle));
+        m_uidToMCParticleMap.erase(pMCParticle->GetUid());
+        return;
     }
 
-    const MCParticleList daughterList(pMCParticle->GetDaughterList());
+    const std::size_t index(UidToMCParticleWeightTable::GetDenseIndex(pMCParticle->GetUid()));
 
-    for (const MCParticle *const pDaughterMCParticle : daughterList)
+    if ((index < m_denseUidToMCParticle.size()) && (pMCParticle == m_denseUidToMCParticle[index]))
     {
-        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->Modifiable(pDaughterMCParticle)->RemoveParent(pMCParticle));
-        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->Modifiable(pMCParticle)->RemoveDaughter(pDaughterMCParticle));
+        m_denseUidToMCParticle[index] = nullptr;
+        --m_nDenseMCParticles;
     }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
 
-    return this->Modifiable(pMCParticle)->RemovePfoTarget();
+unsigned int MCManager::GetNRegisteredMCParticles() const
+{
+    return (this->UseDenseUids() ? m_nDenseMCParticles : m_uidToMCParticleMap.size());
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 StatusCode MCManager::SetUidToMCParticleRelationship(const Uid objectUid, const Uid mcParticleUid, const float mcParticleWeight,
-    ObjectRelationMap &objectRelationMap) const
+    ObjectRelations &objectRelations) const
 {
     const bool useSingleMCParticleAssociation(m_pPandora->GetSettings()->UseSingleMCParticleAssociation());
-    ObjectRelationMap::iterator iter = objectRelationMap.find(objectUid);
 
-    if (objectRelationMap.end() != iter)
+    return MCManager::AddUidToMCParticleRelationship(objectUid, mcParticleUid, mcParticleWeight, useSingleMCParticleAssociation,
+        this->UseDenseUids(), objectRelations);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode MCManager::SetUidToMCParticleRelationships(const MCParticleRelationshipVector &relationshipVector, ObjectRelations &objectRelations) const
+{
+    const bool useSingleMCParticleAssociation(m_pPandora->GetSettings()->UseSingleMCParticleAssociation());
+    const bool useDenseUids(this->UseDenseUids());
+
+    // ATTN Upper bound on the number of new objects, avoiding repeated rehashing as the relation map grows
+    if (!useDenseUids)
+        objectRelations.m_objectRelationMap.reserve(objectRelations.m_objectRelationMap.size() + relationshipVector.size());
+
+    for (const MCParticleRelationship &relationship : relationshipVector)
     {
-        UidToWeightMap &uidToWeightMap(iter->second);
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, MCManager::AddUidToMCParticleRelationship(relationship.m_objectUid,
+            relationship.m_mcParticleUid, relationship.m_mcParticleWeight, useSingleMCParticleAssociation, useDenseUids, objectRelations));
+    }
 
-        if (useSingleMCParticleAssociation && (mcParticleWeight < uidToWeightMap.begin()->second))
-            return STATUS_CODE_SUCCESS;
+    return STATUS_CODE_SUCCESS;
+}
 
-        if (useSingleMCParticleAssociation)
-            uidToWeightMap.clear();
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode MCManager::AddUidToMCParticleRelationship(const Uid objectUid, const Uid mcParticleUid, const float mcParticleWeight,
+    const bool useSingleMCParticleAssociation, const bool useDenseUids, ObjectRelations &objectRelations)
+{
+    UidToWeightMap *pUidToWeightMap(nullptr);
+
+    if (useDenseUids)
+    {
+        unsigned int index(0);
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, MCManager::GetDenseIndex(objectUid, index));
 
-        uidToWeightMap[mcParticleUid] += mcParticleWeight;
+        if (index >= objectRelations.m_uidToWeightMapVector.size())
+            objectRelations.m_uidToWeightMapVector.resize(index + 1);
+
+        pUidToWeightMap = &objectRelations.m_uidToWeightMapVector[index];
     }
     else
     {
-        UidToWeightMap uidToWeightMap;
+        pUidToWeightMap = &objectRelations.m_objectRelationMap.try_emplace(objectUid).first->second;
+    }
 
-        if (!uidToWeightMap.insert(UidToWeightMap::value_type(mcParticleUid, mcParticleWeight)).second)
-            return STATUS_CODE_FAILURE;
+    // ATTN Weight maps are never left empty, so an empty map marks a new object
+    UidToWeightMap &uidToWeightMap(*pUidToWeightMap);
+
+    if (!uidToWeightMap.empty())
+    {
+        if (useSingleMCParticleAssociation && (mcParticleWeight < uidToWeightMap.begin()->second))
+            return STATUS_CODE_SUCCESS;
 
-        if (!objectRelationMap.insert(ObjectRelationMap::value_type(objectUid, uidToWeightMap)).second)
-            return STATUS_CODE_FAILURE;
+        if (useSingleMCParticleAssociation)
+            uidToWeightMap.clear();
     }
 
+    uidToWeightMap[mcParticleUid] += mcParticleWeight;
     return STATUS_CODE_SUCCESS;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-StatusCode MCManager::CreateUidToPfoTargetsMap(UidToMCParticleWeightMap &uidToMCParticleWeightMap, const ObjectRelationMap &objectRelationMap) const
+StatusCode MCManager::CreateUidToPfoTargetsMap(UidToMCParticleWeightTable &uidToMCParticleWeightMap, const ObjectRelations &objectRelations) const
 {
-    if (m_uidToMCParticleMap.empty())
+    if (0 == this->GetNRegisteredMCParticles())
         return STATUS_CODE_SUCCESS;
 
+    // ATTN Requires the truth tree, built when identifying pfo targets
+    if (m_truthTree.m_mcParticleVector.size() != this->GetNRegisteredMCParticles())
+        return STATUS_CODE_NOT_INITIALIZED;
+
+    if (uidToMCParticleWeightMap.IsDense() != m_truthTree.m_isDense)
+        return STATUS_CODE_INVALID_PARAMETER;
+
     const bool collapseToPfoTarget(m_pPandora->GetSettings()->ShouldCollapseMCParticlesToPfoTarget());
+    UIntVector mcParticleIndices;
 
-    for (const ObjectRelationMap::value_type &relationEntry : objectRelationMap)
-    {
-        MCParticleSet mcParticleSet;
+    for (const ObjectRelationMap::value_type &relationEntry : objectRelations.m_objectRelationMap)
+        this->AddPfoTargets(relationEntry.first, relationEntry.second, collapseToPfoTarget, mcParticleIndices, uidToMCParticleWeightMap);
 
-        for (const UidToWeightMap::value_type &weightEntry : relationEntry.second)
-        {
-            UidToMCParticleMap::const_iterator mcParticleIter = m_uidToMCParticleMap.find(weightEntry.first);
+    for (std::size_t index = 0, nObjects = objectRelations.m_uidToWeightMapVector.size(); index < nObjects; ++index)
+    {
+        const UidToWeightMap &uidToWeightMap(objectRelations.m_uidToWeightMapVector[index]);
 
-            if (m_uidToMCParticleMap.end() != mcParticleIter)
-                mcParticleSet.insert(mcParticleIter->second);
-        }
+        if (!uidToWeightMap.empty())
+            this->AddPfoTargets(reinterpret_cast<Uid>(index), uidToWeightMap, collapseToPfoTarget, mcParticleIndices, uidToMCParticleWeightMap);
+    }
 
-        if (mcParticleSet.empty())
-            continue;
+    return STATUS_CODE_SUCCESS;
+}
 
-        MCParticleList mcParticleList(mcParticleSet.begin(), mcParticleSet.end());
-        mcParticleList.sort(PointerLessThan<MCParticle>());
-        MCParticleWeightMap &mcParticleWeightMap(uidToMCParticleWeightMap[relationEntry.first]);
+//------------------------------------------------------------------------------------------------------------------------------------------
 
-        for (const MCParticle *const pMCParticle : mcParticleList)
-        {
-            const float mcParticleWeight(relationEntry.second.at(pMCParticle->GetUid()));
-            const MCParticle *const pTargetMCParticle(!collapseToPfoTarget ? pMCParticle : pMCParticle->m_pPfoTarget);
+void MCManager::AddPfoTargets(const Uid objectUid, const UidToWeightMap &uidToWeightMap, const bool collapseToPfoTarget, UIntVector &mcParticleIndices,
+    UidToMCParticleWeightTable &uidToMCParticleWeightMap) const
+{
+    mcParticleIndices.clear();
 
-            if (!pTargetMCParticle)
-                continue;
+    for (const UidToWeightMap::value_type &weightEntry : uidToWeightMap)
+    {
+        unsigned int index(0);
 
-            mcParticleWeightMap[pTargetMCParticle] += mcParticleWeight;
-        }
+        if (m_truthTree.FindIndex(weightEntry.first, index))
+            mcParticleIndices.push_back(index);
     }
 
-    return STATUS_CODE_SUCCESS;
+    if (mcParticleIndices.empty())
+        return;
+
+    // ATTN Truth tree indices follow the sorted input list order
+    std::sort(mcParticleIndices.begin(), mcParticleIndices.end());
+    MCParticleWeightMap &mcParticleWeightMap(uidToMCParticleWeightMap[objectUid]);
+
+    for (const unsigned int index : mcParticleIndices)
+    {
+        const MCParticle *const pMCParticle(m_truthTree.m_mcParticleVector[index]);
+        const float mcParticleWeight(uidToWeightMap.at(pMCParticle->GetUid()));
+        const MCParticle *const pTargetMCParticle(!collapseToPfoTarget ? pMCParticle : pMCParticle->m_pPfoTarget);
+
+        if (!pTargetMCParticle)
+            continue;
+
+        mcParticleWeightMap[pTargetMCParticle] += mcParticleWeight;
+    }
 }
 
 } // namespace pandora
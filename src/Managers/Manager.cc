@@ -8,7 +8,19 @@
 
 #include "Managers/Manager.h"
 
+#include "Objects/CaloHit.h"
+#include "Objects/Cluster.h"
+#include "Objects/MCParticle.h"
+#include "Objects/ParticleFlowObject.h"
+#include "Objects/Track.h"
+#include "Objects/Vertex.h"
+
 #include "Pandora/Algorithm.h"
+#include "Pandora/HotPathCounters.h"
+#include "Pandora/Pandora.h"
+#include "Pandora/PandoraSettings.h"
+
+#include <limits>
 
 namespace pandora
 {
@@ -17,7 +29,10 @@ template<typename T>
 Manager<T>::Manager(const Pandora *const pPandora) :
     m_nullListName("NullList"),
     m_pPandora(pPandora),
-    m_currentListName(m_nullListName)
+    m_currentListName(m_nullListName),
+    m_pCurrentList(nullptr),
+    m_isObjectBudgetExceeded(false),
+    m_indexUpperBound(0)
 {
 }
 
@@ -33,6 +48,7 @@ Manager<T>::~Manager()
 template<typename T>
 StatusCode Manager<T>::GetList(const std::string &listName, const ObjectList *&pObjectList) const
 {
+    PANDORA_INCREMENT_HOT_PATH_COUNTER(HOT_PATH_GET_LIST);
     typename NameToListMap::const_iterator iter = m_nameToListMap.find(listName);
 
     if (m_nameToListMap.end() == iter)
@@ -48,7 +64,25 @@ template<typename T>
 StatusCode Manager<T>::GetCurrentList(const ObjectList *&pObjectList, std::string &listName) const
 {
     listName = m_currentListName;
-    return this->GetList(listName, pObjectList);
+    return this->GetCurrentList(pObjectList);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template<typename T>
+StatusCode Manager<T>::GetCurrentList(const ObjectList *&pObjectList) const
+{
+    // ATTN Any change of current list name, or deletion of lists, resets the cached address
+    if (!m_pCurrentList)
+    {
+        const StatusCode statusCode(this->GetList(m_currentListName, m_pCurrentList));
+
+        if (STATUS_CODE_SUCCESS != statusCode)
+            return statusCode;
+    }
+
+    pObjectList = m_pCurrentList;
+    return STATUS_CODE_SUCCESS;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -68,11 +102,11 @@ inline StatusCode Manager<T>::GetCurrentListName(std::string &listName) const
 template<typename T>
 StatusCode Manager<T>::GetAlgorithmInputList(const Algorithm *const pAlgorithm, const ObjectList *&pObjectList, std::string &listName) const
 {
-    typename AlgorithmInfoMap::const_iterator iter = m_algorithmInfoMap.find(pAlgorithm);
+    const AlgorithmInfo *const pAlgorithmInfo(this->GetActiveAlgorithmInfo(pAlgorithm));
 
-    if (m_algorithmInfoMap.end() != iter)
+    if (pAlgorithmInfo)
     {
-        listName = iter->second.m_parentListName;
+        listName = pAlgorithmInfo->m_parentListName;
     }
     else
     {
@@ -87,12 +121,12 @@ StatusCode Manager<T>::GetAlgorithmInputList(const Algorithm *const pAlgorithm,
 template<typename T>
 inline StatusCode Manager<T>::GetAlgorithmInputListName(const Algorithm *const pAlgorithm, std::string &listName) const
 {
-    typename AlgorithmInfoMap::const_iterator iter = m_algorithmInfoMap.find(pAlgorithm);
+    const AlgorithmInfo *const pAlgorithmInfo(this->GetActiveAlgorithmInfo(pAlgorithm));
 
-    if (m_algorithmInfoMap.end() == iter)
+    if (!pAlgorithmInfo)
         return this->GetCurrentListName(listName);
 
-    listName = iter->second.m_parentListName;
+    listName = pAlgorithmInfo->m_parentListName;
     return STATUS_CODE_SUCCESS;
 }
 
@@ -101,6 +135,7 @@ inline StatusCode Manager<T>::GetAlgorithmInputListName(const Algorithm *const p
 template<typename T>
 StatusCode Manager<T>::ResetCurrentListToAlgorithmInputList(const Algorithm *const pAlgorithm)
 {
+    m_pCurrentList = nullptr;
     return this->GetAlgorithmInputListName(pAlgorithm, m_currentListName);
 }
 
@@ -115,14 +150,16 @@ StatusCode Manager<T>::ReplaceCurrentAndAlgorithmInputLists(const Algorithm *con
     if (m_savedLists.end() == m_savedLists.find(listName))
         return STATUS_CODE_NOT_ALLOWED;
 
-    if (m_algorithmInfoMap.end() == m_algorithmInfoMap.find(pAlgorithm))
+    if (!this->GetActiveAlgorithmInfo(pAlgorithm))
         return STATUS_CODE_FAILURE;
 
     m_currentListName = listName;
+    m_pCurrentList = nullptr;
 
     for (typename AlgorithmInfoMap::value_type &mapEntry : m_algorithmInfoMap)
     {
-        mapEntry.second.m_parentListName = listName;
+        if (mapEntry.second.m_isActive)
+            mapEntry.second.m_parentListName = listName;
     }
 
     return STATUS_CODE_SUCCESS;
@@ -144,7 +181,9 @@ StatusCode Manager<T>::RenameList(const std::string &oldListName, const std::str
     if ((oldListName == newListName) || newListName.empty())
         return STATUS_CODE_INVALID_PARAMETER;
 
-    if (m_nameToListMap.end() == m_nameToListMap.find(oldListName))
+    typename NameToListMap::iterator oldListIter = m_nameToListMap.find(oldListName);
+
+    if (m_nameToListMap.end() == oldListIter)
         return STATUS_CODE_NOT_FOUND;
 
     if ((oldListName == m_nullListName) || (m_savedLists.end() == m_savedLists.find(oldListName)))
@@ -153,8 +192,9 @@ StatusCode Manager<T>::RenameList(const std::string &oldListName, const std::str
     if (m_savedLists.end() != m_savedLists.find(newListName))
         return STATUS_CODE_ALREADY_PRESENT;
 
-    m_nameToListMap[newListName] = m_nameToListMap.at(oldListName);
-    m_nameToListMap.erase(oldListName);
+    ObjectList *const pObjectList(oldListIter->second);
+    oldListIter = m_nameToListMap.erase(oldListIter);
+    m_nameToListMap[newListName] = pObjectList;
 
     m_savedLists.insert(newListName);
     m_savedLists.erase(oldListName);
@@ -176,18 +216,27 @@ StatusCode Manager<T>::RenameList(const std::string &oldListName, const std::str
 template<typename T>
 StatusCode Manager<T>::CreateTemporaryListAndSetCurrent(const Algorithm *const pAlgorithm, std::string &temporaryListName)
 {
-    typename AlgorithmInfoMap::iterator iter = m_algorithmInfoMap.find(pAlgorithm);
+    PANDORA_INCREMENT_HOT_PATH_COUNTER(HOT_PATH_CREATE_TEMPORARY_LIST);
 
-    if (m_algorithmInfoMap.end() == iter)
+    AlgorithmInfo *const pAlgorithmInfo(this->GetActiveAlgorithmInfo(pAlgorithm));
+
+    if (!pAlgorithmInfo)
         return STATUS_CODE_NOT_FOUND;
 
-    temporaryListName = pAlgorithm->GetInstanceName() + "_" + TypeToString(iter->second.m_numberOfListsCreated++);
+    AlgorithmInfo &algorithmInfo(*pAlgorithmInfo);
+    temporaryListName = Manager<T>::GetTemporaryListName(algorithmInfo, algorithmInfo.m_numberOfListsCreated++);
 
-    if (!iter->second.m_temporaryListNames.insert(temporaryListName).second)
+    ObjectList *const pObjectList(new ObjectList);
+
+    if (!m_nameToListMap.insert(typename NameToListMap::value_type(temporaryListName, pObjectList)).second)
+    {
+        delete pObjectList;
         return STATUS_CODE_ALREADY_PRESENT;
+    }
 
-    m_nameToListMap[temporaryListName] = new ObjectList;
+    algorithmInfo.m_temporaryLists.push_back(pObjectList);
     m_currentListName = temporaryListName;
+    m_pCurrentList = nullptr;
 
     return STATUS_CODE_SUCCESS;
 }
@@ -197,15 +246,26 @@ StatusCode Manager<T>::CreateTemporaryListAndSetCurrent(const Algorithm *const p
 template<typename T>
 StatusCode Manager<T>::RegisterAlgorithm(const Algorithm *const pAlgorithm)
 {
-    if (m_algorithmInfoMap.end() != m_algorithmInfoMap.find(pAlgorithm))
+    typename AlgorithmInfoMap::iterator iter = m_algorithmInfoMap.find(pAlgorithm);
+
+    // ATTN Reuse the record retained from any previous run of the algorithm, avoiding a map insertion and name prefix construction
+    if (m_algorithmInfoMap.end() == iter)
+    {
+        AlgorithmInfo algorithmInfo;
+        algorithmInfo.m_temporaryListPrefix = pAlgorithm->GetInstanceName() + "_";
+        algorithmInfo.m_isActive = false;
+        iter = m_algorithmInfoMap.insert(typename AlgorithmInfoMap::value_type(pAlgorithm, algorithmInfo)).first;
+    }
+    else if (iter->second.m_isActive)
+    {
         return STATUS_CODE_ALREADY_PRESENT;
+    }
 
-    AlgorithmInfo algorithmInfo;
+    AlgorithmInfo &algorithmInfo(iter->second);
     algorithmInfo.m_parentListName = m_currentListName;
+    algorithmInfo.m_firstTemporaryListHandle = 0;
     algorithmInfo.m_numberOfListsCreated = 0;
-
-    if (!m_algorithmInfoMap.insert(typename AlgorithmInfoMap::value_type(pAlgorithm, algorithmInfo)).second)
-        return STATUS_CODE_ALREADY_PRESENT;
+    algorithmInfo.m_isActive = true;
 
     return STATUS_CODE_SUCCESS;
 }
@@ -215,28 +275,28 @@ StatusCode Manager<T>::RegisterAlgorithm(const Algorithm *const pAlgorithm)
 template<typename T>
 StatusCode Manager<T>::ResetAlgorithmInfo(const Algorithm *const pAlgorithm, bool isAlgorithmFinished)
 {
-    typename AlgorithmInfoMap::iterator algorithmIter = m_algorithmInfoMap.find(pAlgorithm);
+    AlgorithmInfo *const pAlgorithmInfo(this->GetActiveAlgorithmInfo(pAlgorithm));
 
-    if (m_algorithmInfoMap.end() == algorithmIter)
+    if (!pAlgorithmInfo)
         return STATUS_CODE_NOT_FOUND;
 
-    for (const std::string &temporaryListName : algorithmIter->second.m_temporaryListNames)
-    {
-        typename NameToListMap::iterator iter = m_nameToListMap.find(temporaryListName);
+    AlgorithmInfo &algorithmInfo(*pAlgorithmInfo);
 
-        if (m_nameToListMap.end() == iter)
+    for (unsigned int iList = 0, nLists = algorithmInfo.m_temporaryLists.size(); iList < nLists; ++iList)
+    {
+        if (1 != m_nameToListMap.erase(Manager<T>::GetTemporaryListName(algorithmInfo, algorithmInfo.m_firstTemporaryListHandle + iList)))
             return STATUS_CODE_FAILURE;
 
-        ObjectList *const pObjectList(iter->second);
-        iter = m_nameToListMap.erase(iter);
-        delete pObjectList;
+        delete algorithmInfo.m_temporaryLists[iList];
     }
 
-    algorithmIter->second.m_temporaryListNames.clear();
-    m_currentListName = algorithmIter->second.m_parentListName;
+    algorithmInfo.m_temporaryLists.clear();
+    algorithmInfo.m_firstTemporaryListHandle = algorithmInfo.m_numberOfListsCreated;
+    m_currentListName = algorithmInfo.m_parentListName;
+    m_pCurrentList = nullptr;
 
     if (isAlgorithmFinished)
-        algorithmIter = m_algorithmInfoMap.erase(algorithmIter);
+        algorithmInfo.m_isActive = false;
 
     return STATUS_CODE_SUCCESS;
 }
@@ -246,14 +306,57 @@ StatusCode Manager<T>::ResetAlgorithmInfo(const Algorithm *const pAlgorithm, boo
 template<typename T>
 StatusCode Manager<T>::ResetForNextEvent()
 {
-    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->EraseAllContent());
-    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->CreateInitialLists());
+    // ATTN An untouched manager keeps its initial lists and retained storage, rather than reallocating them for each event
+    if (this->IsInInitialState())
+    {
+        m_currentListName = m_nullListName;
+        m_pCurrentList = nullptr;
+    }
+    else
+    {
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->EraseAllContent());
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->CreateInitialLists());
+    }
+
+    m_peakMemoryUsage = MemoryUsage();
+    m_isObjectBudgetExceeded = false;
 
     return STATUS_CODE_SUCCESS;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+template<typename T>
+bool Manager<T>::IsInInitialState() const
+{
+    return ((0 == m_indexUpperBound) && this->HasOnlyInitialLists(m_nullListName));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template<typename T>
+bool Manager<T>::HasOnlyInitialLists(const std::string &initialListName) const
+{
+    if (m_savedLists.size() != m_nameToListMap.size())
+        return false;
+
+    for (const typename AlgorithmInfoMap::value_type &mapEntry : m_algorithmInfoMap)
+    {
+        if (mapEntry.second.m_isActive)
+            return false;
+    }
+
+    for (const typename NameToListMap::value_type &mapEntry : m_nameToListMap)
+    {
+        if (!mapEntry.second->empty() || ((m_nullListName != mapEntry.first) && (initialListName != mapEntry.first)))
+            return false;
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 template<typename T>
 StatusCode Manager<T>::EraseAllContent()
 {
@@ -261,9 +364,22 @@ StatusCode Manager<T>::EraseAllContent()
         delete mapEntry.second;
 
     m_currentListName = m_nullListName;
+    m_pCurrentList = nullptr;
     m_nameToListMap.clear();
     m_savedLists.clear();
-    m_algorithmInfoMap.clear();
+    m_indexUpperBound = 0;
+    m_releasedIndices.clear();
+
+    // ATTN Indices restart from zero, so advance every generation to distinguish next event objects from those of this event
+    for (unsigned int &indexGeneration : m_indexGenerations)
+        ++indexGeneration;
+
+    // ATTN Algorithm records are retained, inactive, for reuse in later events; their temporary lists have been deleted above
+    for (typename AlgorithmInfoMap::value_type &mapEntry : m_algorithmInfoMap)
+    {
+        mapEntry.second.m_temporaryLists.clear();
+        mapEntry.second.m_isActive = false;
+    }
 
     return STATUS_CODE_SUCCESS;
 }
@@ -291,6 +407,193 @@ T *Manager<T>::Modifiable(const T *const pT) const
     return const_cast<T*>(pT);
 }
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template<typename T>
+void Manager<T>::GetMemoryUsage(MemoryUsage &currentUsage, MemoryUsage &peakUsage) const
+{
+    this->FillMemoryUsage(currentUsage);
+    peakUsage = m_peakMemoryUsage;
+    Manager<T>::MergePeakMemoryUsage(currentUsage, peakUsage);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template<typename T>
+void Manager<T>::UpdatePeakMemoryUsage(const Algorithm *const pAlgorithm)
+{
+    MemoryUsage memoryUsage;
+    this->FillMemoryUsage(memoryUsage);
+
+    if (memoryUsage.m_estimatedBytes > m_peakMemoryUsage.m_estimatedBytes)
+        memoryUsage.m_algorithmName = pAlgorithm->GetInstanceName();
+
+    Manager<T>::MergePeakMemoryUsage(memoryUsage, m_peakMemoryUsage);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template<typename T>
+void Manager<T>::FillMemoryUsage(MemoryUsage &memoryUsage) const
+{
+    unsigned int nListEntries(0);
+
+    for (const typename NameToListMap::value_type &mapEntry : m_nameToListMap)
+        nListEntries += mapEntry.second->size();
+
+#if PANDORA_MANAGED_CONTAINER_STABLE_ITERATORS
+    // ATTN Node-based lists hold each entry in a separate allocation, alongside the forward and backward links
+    const std::size_t listEntryBytes(sizeof(const T *) + 2 * sizeof(void *));
+#else
+    const std::size_t listEntryBytes(sizeof(const T *));
+#endif
+
+    memoryUsage.m_nObjects = this->GetNOwnedObjects();
+    memoryUsage.m_nLists = m_nameToListMap.size();
+    memoryUsage.m_nListEntries = nListEntries;
+    memoryUsage.m_estimatedBytes = memoryUsage.m_nObjects * sizeof(T) + memoryUsage.m_nLists * sizeof(ObjectList) + nListEntries * listEntryBytes;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template<typename T>
+void Manager<T>::MergePeakMemoryUsage(const MemoryUsage &memoryUsage, MemoryUsage &peakUsage)
+{
+    peakUsage.m_nObjects = std::max(peakUsage.m_nObjects, memoryUsage.m_nObjects);
+    peakUsage.m_nLists = std::max(peakUsage.m_nLists, memoryUsage.m_nLists);
+    peakUsage.m_nListEntries = std::max(peakUsage.m_nListEntries, memoryUsage.m_nListEntries);
+
+    if (memoryUsage.m_estimatedBytes > peakUsage.m_estimatedBytes)
+    {
+        peakUsage.m_estimatedBytes = memoryUsage.m_estimatedBytes;
+        peakUsage.m_algorithmName = memoryUsage.m_algorithmName;
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template<typename T>
+bool Manager<T>::IsWithinObjectBudget(const unsigned int nNewObjects)
+{
+    const unsigned int maxObjectsPerEvent(m_pPandora->GetSettings()->GetMaxObjectsPerEvent());
+
+    if ((0 == maxObjectsPerEvent) || (this->GetNOwnedObjects() + nNewObjects <= maxObjectsPerEvent))
+        return true;
+
+    m_isObjectBudgetExceeded = true;
+    return false;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template<typename T>
+bool Manager<T>::IsObjectBudgetExceeded() const
+{
+    return m_isObjectBudgetExceeded;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template<typename T>
+unsigned int Manager<T>::GetIndexUpperBound() const
+{
+    return m_indexUpperBound;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template<typename T>
+void Manager<T>::AssignIndex(const T *const pT)
+{
+    if (m_releasedIndices.empty())
+    {
+        this->Modifiable(pT)->m_index = m_indexUpperBound++;
+    }
+    else
+    {
+        this->Modifiable(pT)->m_index = m_releasedIndices.back();
+        m_releasedIndices.pop_back();
+    }
+
+    if (pT->m_index >= m_indexGenerations.size())
+        m_indexGenerations.resize(pT->m_index + 1, 0);
+
+    this->Modifiable(pT)->m_indexGeneration = m_indexGenerations[pT->m_index];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template<typename T>
+void Manager<T>::ReleaseIndex(const T *const pT)
+{
+    if (pT->m_index < m_indexUpperBound)
+    {
+        ++m_indexGenerations[pT->m_index];
+        m_releasedIndices.push_back(pT->m_index);
+    }
+
+    this->Modifiable(pT)->m_index = std::numeric_limits<unsigned int>::max();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template<typename T>
+typename Manager<T>::AlgorithmInfo *Manager<T>::GetActiveAlgorithmInfo(const Algorithm *const pAlgorithm)
+{
+    typename AlgorithmInfoMap::iterator iter = m_algorithmInfoMap.find(pAlgorithm);
+
+    return (((m_algorithmInfoMap.end() != iter) && iter->second.m_isActive) ? &(iter->second) : nullptr);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template<typename T>
+const typename Manager<T>::AlgorithmInfo *Manager<T>::GetActiveAlgorithmInfo(const Algorithm *const pAlgorithm) const
+{
+    typename AlgorithmInfoMap::const_iterator iter = m_algorithmInfoMap.find(pAlgorithm);
+
+    return (((m_algorithmInfoMap.end() != iter) && iter->second.m_isActive) ? &(iter->second) : nullptr);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template<typename T>
+std::string Manager<T>::GetTemporaryListName(const AlgorithmInfo &algorithmInfo, const unsigned int temporaryListHandle)
+{
+    return algorithmInfo.m_temporaryListPrefix + std::to_string(temporaryListHandle);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template<typename T>
+bool Manager<T>::IsTemporaryList(const AlgorithmInfo &algorithmInfo, const std::string &listName)
+{
+    const std::string &prefix(algorithmInfo.m_temporaryListPrefix);
+    const std::size_t nDigits(listName.size() - prefix.size());
+
+    if ((listName.size() <= prefix.size()) || (nDigits > std::numeric_limits<unsigned int>::digits10))
+        return false;
+
+    if (0 != listName.compare(0, prefix.size(), prefix))
+        return false;
+
+    // ATTN Handles are written without leading zeros, so any other spelling names a different list
+    if ((nDigits > 1) && ('0' == listName[prefix.size()]))
+        return false;
+
+    unsigned int temporaryListHandle(0);
+
+    for (std::size_t iChar = prefix.size(); iChar < listName.size(); ++iChar)
+    {
+        if ((listName[iChar] < '0') || (listName[iChar] > '9'))
+            return false;
+
+        temporaryListHandle = 10 * temporaryListHandle + static_cast<unsigned int>(listName[iChar] - '0');
+    }
+
+    return ((temporaryListHandle >= algorithmInfo.m_firstTemporaryListHandle) && (temporaryListHandle < algorithmInfo.m_numberOfListsCreated));
+}
+
 //------------------------------------------------------------------------------------------------------------------------------------------
 //------------------------------------------------------------------------------------------------------------------------------------------
 
@@ -8,24 +8,132 @@
 
 #include "Managers/Metadata.h"
 
+#include "Pandora/ObjectPool.h"
 #include "Pandora/PandoraInternal.h"
 
 #include <algorithm>
+#include <limits>
 
 namespace pandora
 {
 
-CaloHitMetadata::CaloHitMetadata(CaloHitList *const pCaloHitList, const std::string &caloHitListName, const bool initialHitAvailability) :
-    m_pCaloHitList(pCaloHitList),
-    m_caloHitListName(caloHitListName)
+#ifdef PANDORA_POOLED_OBJECT_ALLOCATION
+void *CaloHitReplacement::operator new(std::size_t size)
 {
-    for (const CaloHit *const pCaloHit : *pCaloHitList)
+    return ObjectPool<CaloHitReplacement>::Allocate(size);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void CaloHitReplacement::operator delete(void *pAddress, std::size_t size)
+{
+    ObjectPool<CaloHitReplacement>::Deallocate(pAddress, size);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+#endif
+
+void CaloHitBitset::And(const CaloHitBitset &rhs)
+{
+    const WordVector::size_type nWords(m_words.size()), nRhsWords(rhs.m_words.size());
+
+    for (WordVector::size_type iWord = 0; iWord < nWords; ++iWord)
+        m_words[iWord] &= ((iWord < nRhsWords) ? rhs.m_words[iWord] : 0);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void CaloHitBitset::AndNot(const CaloHitBitset &rhs)
+{
+    const WordVector::size_type nWords(std::min(m_words.size(), rhs.m_words.size()));
+
+    for (WordVector::size_type iWord = 0; iWord < nWords; ++iWord)
+        m_words[iWord] &= ~rhs.m_words[iWord];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void CaloHitBitset::Or(const CaloHitBitset &rhs)
+{
+    if (rhs.m_words.size() > m_words.size())
+        m_words.resize(rhs.m_words.size(), 0);
+
+    const WordVector::size_type nRhsWords(rhs.m_words.size());
+
+    for (WordVector::size_type iWord = 0; iWord < nRhsWords; ++iWord)
+        m_words[iWord] |= rhs.m_words[iWord];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool CaloHitBitset::IsSubsetOf(const CaloHitBitset &rhs) const
+{
+    const WordVector::size_type nWords(m_words.size()), nRhsWords(rhs.m_words.size());
+
+    for (WordVector::size_type iWord = 0; iWord < nWords; ++iWord)
     {
-        if (!m_caloHitUsageMap.insert(CaloHitUsageMap::value_type(pCaloHit, initialHitAvailability)).second)
-            throw StatusCodeException(STATUS_CODE_ALREADY_PRESENT);
+        const Word rhsWord((iWord < nRhsWords) ? rhs.m_words[iWord] : 0);
+
+        if (0 != (m_words[iWord] & ~rhsWord))
+            return false;
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void CaloHitBitset::Merge(const CaloHitBitset &mask, const CaloHitBitset &values)
+{
+    if (mask.m_words.size() > m_words.size())
+        m_words.resize(mask.m_words.size(), 0);
+
+    const WordVector::size_type nMaskWords(mask.m_words.size()), nValueWords(values.m_words.size());
+
+    for (WordVector::size_type iWord = 0; iWord < nMaskWords; ++iWord)
+    {
+        const Word maskWord(mask.m_words[iWord]);
+        const Word valueWord((iWord < nValueWords) ? values.m_words[iWord] : 0);
+        m_words[iWord] = (m_words[iWord] & ~maskWord) | (valueWord & maskWord);
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void CaloHitBitset::GetSetIndices(UIntVector &indices) const
+{
+    indices.clear();
+
+    const WordVector::size_type nWords(m_words.size());
+
+    for (WordVector::size_type iWord = 0; iWord < nWords; ++iWord)
+    {
+        Word word(m_words[iWord]);
+
+        for (unsigned int iBit = 0; 0 != word; ++iBit, word >>= 1)
+        {
+            if (word & Word(1))
+                indices.push_back(static_cast<unsigned int>(iWord * BITS_PER_WORD + iBit));
+        }
     }
 }
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+CaloHitMetadata::CaloHitMetadata(CaloHitList *const pCaloHitList, const std::string &caloHitListName, const CaloHitBitset *const pBaseMembershipBitset,
+        const CaloHitMetadata *const pParentCaloHitMetadata, const bool inheritAvailability) :
+    m_pCaloHitList(pCaloHitList),
+    m_caloHitListName(caloHitListName),
+    m_pBaseMembershipBitset(pBaseMembershipBitset),
+    m_pParentCaloHitMetadata(pParentCaloHitMetadata),
+    m_inheritAvailability(inheritAvailability)
+{
+    if (!m_pBaseMembershipBitset)
+        throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
+}
+
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 CaloHitMetadata::~CaloHitMetadata()
@@ -44,12 +152,19 @@ CaloHitMetadata::~CaloHitMetadata()
 template <>
 bool CaloHitMetadata::IsAvailable(const CaloHit *const pCaloHit) const
 {
-    CaloHitUsageMap::const_iterator usageMapIter = m_caloHitUsageMap.find(pCaloHit);
+    const unsigned int index(pCaloHit->m_index);
 
-    if ((m_caloHitUsageMap.end()) == usageMapIter || !usageMapIter->second)
+    if (!this->IsMember(index))
         return false;
 
-    return true;
+    if (m_recordedBitset.Test(index))
+        return m_availabilityBitset.Test(index);
+
+    if (!m_inheritAvailability)
+        return true;
+
+    // ATTN Unrecorded availability falls through to the parent level, which is not modified until this reclustering process ends
+    return (m_pParentCaloHitMetadata ? m_pParentCaloHitMetadata->IsAvailable(pCaloHit) : pCaloHit->IsAvailable());
 }
 
 template <>
@@ -57,9 +172,7 @@ bool CaloHitMetadata::IsAvailable(const CaloHitList *const pCaloHitList) const
 {
     for (const CaloHit *const pCaloHit : *pCaloHitList)
     {
-        CaloHitUsageMap::const_iterator usageMapIter = m_caloHitUsageMap.find(pCaloHit);
-
-        if ((m_caloHitUsageMap.end()) == usageMapIter || !usageMapIter->second)
+        if (!this->IsAvailable(pCaloHit))
             return false;
     }
 
@@ -71,12 +184,12 @@ bool CaloHitMetadata::IsAvailable(const CaloHitList *const pCaloHitList) const
 template <>
 StatusCode CaloHitMetadata::SetAvailability(const CaloHit *const pCaloHit, bool isAvailable)
 {
-    CaloHitUsageMap::iterator usageMapIter = m_caloHitUsageMap.find(pCaloHit);
+    const unsigned int index(pCaloHit->m_index);
 
-    if (m_caloHitUsageMap.end() == usageMapIter)
+    if (!this->IsMember(index))
         return STATUS_CODE_NOT_FOUND;
 
-    usageMapIter->second = isAvailable;
+    this->RecordAvailability(index, isAvailable);
 
     return STATUS_CODE_SUCCESS;
 }
@@ -86,12 +199,7 @@ StatusCode CaloHitMetadata::SetAvailability(const CaloHitList *const pCaloHitLis
 {
     for (const CaloHit *const pCaloHit : *pCaloHitList)
     {
-        CaloHitUsageMap::iterator usageMapIter = m_caloHitUsageMap.find(pCaloHit);
-
-        if (m_caloHitUsageMap.end() == usageMapIter)
-            return STATUS_CODE_NOT_FOUND;
-
-        usageMapIter->second = isAvailable;
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->SetAvailability(pCaloHit, isAvailable));
     }
 
     return STATUS_CODE_SUCCESS;
@@ -99,29 +207,43 @@ StatusCode CaloHitMetadata::SetAvailability(const CaloHitList *const pCaloHitLis
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-StatusCode CaloHitMetadata::Update(const CaloHitMetadata &caloHitMetadata)
+StatusCode CaloHitMetadata::Update(CaloHitMetadata &caloHitMetadata)
 {
-    const CaloHitReplacementList &caloHitReplacementList(caloHitMetadata.GetCaloHitReplacementList());
+    CaloHitReplacementList &caloHitReplacementList(caloHitMetadata.m_caloHitReplacementList);
 
-    for (const CaloHitReplacement *const pCaloHitReplacement : caloHitReplacementList)
+    for (CaloHitReplacementList::iterator iter = caloHitReplacementList.begin(), iterEnd = caloHitReplacementList.end(); iter != iterEnd; ++iter)
     {
-        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->Update(*pCaloHitReplacement));
+        const StatusCode statusCode(this->ApplyReplacement(**iter));
+
+        // ATTN Records already transferred must not also be released with the daughter metadata
+        if (STATUS_CODE_SUCCESS != statusCode)
+        {
+            caloHitReplacementList.erase(caloHitReplacementList.begin(), iter);
+            return statusCode;
+        }
+
+        m_caloHitReplacementList.push_back(*iter);
     }
 
-    const CaloHitUsageMap &caloHitUsageMap(caloHitMetadata.GetCaloHitUsageMap());
+    caloHitReplacementList.clear();
 
-    CaloHitVector caloHitVector;
-    for (const CaloHitUsageMap::value_type &mapEntry : caloHitUsageMap) caloHitVector.push_back(mapEntry.first);
-    std::sort(caloHitVector.begin(), caloHitVector.end(), PointerLessThan<CaloHit>());
+    UIntVector availableIndices, unavailableIndices;
+    caloHitMetadata.GetAvailabilityUpdates(availableIndices, unavailableIndices);
 
-    for (const CaloHit *const pCaloHit : caloHitVector)
+    for (const unsigned int index : availableIndices)
     {
-        CaloHitUsageMap::iterator usageMapIter = m_caloHitUsageMap.find(pCaloHit);
+        if (!this->IsMember(index))
+            return STATUS_CODE_FAILURE;
 
-        if (m_caloHitUsageMap.end() == usageMapIter)
+        this->RecordAvailability(index, true);
+    }
+
+    for (const unsigned int index : unavailableIndices)
+    {
+        if (!this->IsMember(index))
             return STATUS_CODE_FAILURE;
 
-        usageMapIter->second = caloHitUsageMap.at(pCaloHit);
+        this->RecordAvailability(index, false);
     }
 
     return STATUS_CODE_SUCCESS;
@@ -130,6 +252,36 @@ StatusCode CaloHitMetadata::Update(const CaloHitMetadata &caloHitMetadata)
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 StatusCode CaloHitMetadata::Update(const CaloHitReplacement &caloHitReplacement)
+{
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ApplyReplacement(caloHitReplacement));
+    m_caloHitReplacementList.push_back(new CaloHitReplacement(caloHitReplacement));
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode CaloHitMetadata::Update(CaloHitReplacement *const pCaloHitReplacement)
+{
+    if (!pCaloHitReplacement)
+        return STATUS_CODE_INVALID_PARAMETER;
+
+    const StatusCode statusCode(this->ApplyReplacement(*pCaloHitReplacement));
+
+    if (STATUS_CODE_SUCCESS != statusCode)
+    {
+        delete pCaloHitReplacement;
+        return statusCode;
+    }
+
+    m_caloHitReplacementList.push_back(pCaloHitReplacement);
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode CaloHitMetadata::ApplyReplacement(const CaloHitReplacement &caloHitReplacement)
 {
     for (const CaloHit *const pCaloHit : caloHitReplacement.m_newCaloHits)
     {
@@ -138,8 +290,14 @@ StatusCode CaloHitMetadata::Update(const CaloHitReplacement &caloHitReplacement)
 
         m_pCaloHitList->push_back(pCaloHit);
 
-        if (!m_caloHitUsageMap.insert(CaloHitUsageMap::value_type(pCaloHit, true)).second)
+        const unsigned int index(CaloHitMetadata::GetIndex(pCaloHit));
+
+        if (this->IsMember(index))
             return STATUS_CODE_ALREADY_PRESENT;
+
+        m_addedBitset.Set(index);
+        m_removedBitset.Reset(index);
+        this->RecordAvailability(index, true);
     }
 
     if (m_pCaloHitList == &caloHitReplacement.m_oldCaloHits)
@@ -154,15 +312,17 @@ StatusCode CaloHitMetadata::Update(const CaloHitReplacement &caloHitReplacement)
 
         listIter = m_pCaloHitList->erase(listIter);
 
-        CaloHitUsageMap::iterator mapIter = m_caloHitUsageMap.find(pCaloHit);
+        const unsigned int index(pCaloHit->m_index);
 
-        if (m_caloHitUsageMap.end() == mapIter)
+        if (!this->IsMember(index))
             return STATUS_CODE_FAILURE;
 
-        mapIter = m_caloHitUsageMap.erase(mapIter);
-    }
+        m_addedBitset.Reset(index);
+        this->EraseAvailability(index);
 
-    m_caloHitReplacementList.push_back(new CaloHitReplacement(caloHitReplacement));
+        if (m_pBaseMembershipBitset->Test(index))
+            m_removedBitset.Set(index);
+    }
 
     return STATUS_CODE_SUCCESS;
 }
@@ -176,19 +336,87 @@ void CaloHitMetadata::Clear()
 
     m_pCaloHitList = nullptr;
     m_caloHitListName.clear();
-    m_caloHitUsageMap.clear();
+    m_addedBitset.Clear();
+    m_removedBitset.Clear();
+    m_recordedBitset.Clear();
+    m_availabilityBitset.Clear();
     m_caloHitReplacementList.clear();
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
+
+void CaloHitMetadata::GetMembershipBitset(CaloHitBitset &membershipBitset) const
+{
+    membershipBitset = *m_pBaseMembershipBitset;
+    membershipBitset.AndNot(m_removedBitset);
+    membershipBitset.Or(m_addedBitset);
+}
+
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-ReclusterMetadata::ReclusterMetadata(CaloHitList *const pCaloHitList) :
+void CaloHitMetadata::GetAvailabilityUpdates(UIntVector &availableIndices, UIntVector &unavailableIndices) const
+{
+    availableIndices.clear();
+    unavailableIndices.clear();
+
+    UIntVector indices;
+
+    if (m_inheritAvailability)
+    {
+        // ATTN Availability is recorded only for associated calo hits, and erased if they are removed
+        m_recordedBitset.GetSetIndices(indices);
+    }
+    else
+    {
+        CaloHitBitset membershipBitset;
+        this->GetMembershipBitset(membershipBitset);
+        membershipBitset.GetSetIndices(indices);
+    }
+
+    for (const unsigned int index : indices)
+    {
+        if (!m_recordedBitset.Test(index) || m_availabilityBitset.Test(index))
+        {
+            availableIndices.push_back(index);
+        }
+        else
+        {
+            unavailableIndices.push_back(index);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+unsigned int CaloHitMetadata::GetIndex(const CaloHit *const pCaloHit)
+{
+    // ATTN Calo hits receive their index from the calo hit manager, upon creation
+    if (std::numeric_limits<unsigned int>::max() == pCaloHit->m_index)
+        throw StatusCodeException(STATUS_CODE_NOT_INITIALIZED);
+
+    return pCaloHit->m_index;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+ReclusterMetadata::ReclusterMetadata(CaloHitList *const pCaloHitList, const CaloHitMetadata *const pParentCaloHitMetadata) :
     m_pCurrentCaloHitMetadata(nullptr),
+    m_pParentCaloHitMetadata(pParentCaloHitMetadata),
     m_caloHitList(*pCaloHitList)
 {
     if (m_caloHitList.empty())
         throw StatusCodeException(STATUS_CODE_NOT_INITIALIZED);
+
+    for (const CaloHit *const pCaloHit : m_caloHitList)
+    {
+        const unsigned int index(CaloHitMetadata::GetIndex(pCaloHit));
+
+        if (m_membershipBitset.Test(index))
+            throw StatusCodeException(STATUS_CODE_ALREADY_PRESENT);
+
+        m_membershipBitset.Set(index);
+    }
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -202,30 +430,33 @@ ReclusterMetadata::~ReclusterMetadata()
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 StatusCode ReclusterMetadata::CreateCaloHitMetadata(CaloHitList *const pCaloHitList, const std::string &caloHitListName,
-    const std::string &reclusterListName, const bool initialHitAvailability)
+    const std::string &reclusterListName, const bool inheritAvailability)
 {
-    m_pCurrentCaloHitMetadata = new CaloHitMetadata(pCaloHitList, caloHitListName, initialHitAvailability);
+    // ATTN Each reclustering option starts from the same calo hits, so records only its differences from the shared membership bitset
+    CaloHitMetadata *const pCaloHitMetadata(new CaloHitMetadata(pCaloHitList, caloHitListName, &m_membershipBitset, m_pParentCaloHitMetadata,
+        inheritAvailability));
 
-    if (!m_nameToMetadataMap.insert(NameToMetadataMap::value_type(reclusterListName, m_pCurrentCaloHitMetadata)).second)
+    if (!m_nameToMetadataMap.insert(NameToMetadataMap::value_type(reclusterListName, pCaloHitMetadata)).second)
     {
-        delete m_pCurrentCaloHitMetadata;
+        delete pCaloHitMetadata;
         return STATUS_CODE_ALREADY_PRESENT;
     }
 
+    m_pCurrentCaloHitMetadata = pCaloHitMetadata;
+
     return STATUS_CODE_SUCCESS;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-StatusCode ReclusterMetadata::ExtractCaloHitMetadata(const std::string &reclusterListName, CaloHitMetadata *&pCaloHitMetaData)
+StatusCode ReclusterMetadata::GetCaloHitMetadata(const std::string &reclusterListName, CaloHitMetadata *&pCaloHitMetaData) const
 {
-    NameToMetadataMap::iterator iter = m_nameToMetadataMap.find(reclusterListName);
+    NameToMetadataMap::const_iterator iter = m_nameToMetadataMap.find(reclusterListName);
 
     if (m_nameToMetadataMap.end() == iter)
         return STATUS_CODE_FAILURE;
 
     pCaloHitMetaData = iter->second;
-    iter = m_nameToMetadataMap.erase(iter);
 
     return STATUS_CODE_SUCCESS;
 }
@@ -11,6 +11,7 @@
 #include "Objects/ParticleFlowObject.h"
 
 #include "Pandora/ObjectFactory.h"
+#include "Pandora/PandoraObjectFactories.h"
 
 #include <algorithm>
 
@@ -18,7 +19,9 @@ namespace pandora
 {
 
 ParticleFlowObjectManager::ParticleFlowObjectManager(const Pandora *const pPandora) :
-    AlgorithmObjectManager<ParticleFlowObject>(pPandora)
+    AlgorithmObjectManager<ParticleFlowObject>(pPandora),
+    m_isPfoHierarchyValid(false),
+    m_pfoHierarchyNDeleted(0)
 {
     PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->CreateInitialLists());
 }
@@ -42,17 +45,22 @@ StatusCode ParticleFlowObjectManager::Create(const object_creation::ParticleFlow
         if (!m_canMakeNewObjects)
             throw StatusCodeException(STATUS_CODE_NOT_ALLOWED);
 
+        if (!this->IsWithinObjectBudget(1))
+            throw StatusCodeException(STATUS_CODE_BUDGET_EXCEEDED);
+
         NameToListMap::iterator iter = m_nameToListMap.find(m_currentListName);
 
         if (m_nameToListMap.end() == iter)
              throw StatusCodeException(STATUS_CODE_NOT_INITIALIZED);
 
-        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, factory.Create(parameters, pPfo));
+        m_isPfoHierarchyValid = false;
+        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, factory.CreateObject(parameters, pPfo));
 
         if (!pPfo)
              throw StatusCodeException(STATUS_CODE_FAILURE);
 
-        iter->second->push_back(pPfo);
+        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->AddObjectToList(iter->second, pPfo));
+        this->AssignIndex(pPfo);
         return STATUS_CODE_SUCCESS;
     }
     catch (StatusCodeException &statusCodeException)
@@ -94,6 +102,7 @@ StatusCode ParticleFlowObjectManager::SetParentDaughterAssociation(const Particl
     if (pParentPfo == pDaughterPfo)
         return STATUS_CODE_INVALID_PARAMETER;
 
+    m_isPfoHierarchyValid = false;
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->Modifiable(pParentPfo)->AddDaughter(pDaughterPfo));
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->Modifiable(pDaughterPfo)->AddParent(pParentPfo));
 
@@ -104,12 +113,75 @@ StatusCode ParticleFlowObjectManager::SetParentDaughterAssociation(const Particl
 
 StatusCode ParticleFlowObjectManager::RemoveParentDaughterAssociation(const ParticleFlowObject *const pParentPfo, const ParticleFlowObject *const pDaughterPfo) const
 {
+    m_isPfoHierarchyValid = false;
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->Modifiable(pParentPfo)->RemoveDaughter(pDaughterPfo));
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->Modifiable(pDaughterPfo)->RemoveParent(pParentPfo));
 
     return STATUS_CODE_SUCCESS;
 }
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode ParticleFlowObjectManager::RemoveAllParentDaughterAssociations(const PfoList &pfoList) const
+{
+    m_isPfoHierarchyValid = false;
+
+    const PfoSet pfoSet(pfoList.begin(), pfoList.end());
+    PfoList relatedPfoList;
+    PfoSet relatedPfoSet;
+
+    for (const ParticleFlowObject *const pPfo : pfoList)
+    {
+        for (const PfoList *const pRelatedPfoList : {&pPfo->GetParentPfoList(), &pPfo->GetDaughterPfoList()})
+        {
+            for (const ParticleFlowObject *const pRelatedPfo : *pRelatedPfoList)
+            {
+                if (!pfoSet.count(pRelatedPfo) && relatedPfoSet.insert(pRelatedPfo).second)
+                    relatedPfoList.push_back(pRelatedPfo);
+            }
+        }
+    }
+
+    for (const ParticleFlowObject *const pRelatedPfo : relatedPfoList)
+        this->Modifiable(pRelatedPfo)->RemoveParentsAndDaughters(pfoSet);
+
+    for (const ParticleFlowObject *const pPfo : pfoSet)
+        this->Modifiable(pPfo)->ClearParentsAndDaughters();
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode ParticleFlowObjectManager::GetPfoHierarchy(const PfoHierarchy *&pPfoHierarchy)
+{
+    // ATTN Any deletion, including that of temporary lists and at the end of each event, is detected via the deleted object count
+    if (!m_isPfoHierarchyValid || (this->GetNObjectsDeleted() != m_pfoHierarchyNDeleted))
+    {
+        StringVector listNames;
+
+        for (const NameToListMap::value_type &mapEntry : m_nameToListMap)
+            listNames.push_back(mapEntry.first);
+
+        std::sort(listNames.begin(), listNames.end());
+        PfoList pfoList;
+
+        for (const std::string &listName : listNames)
+        {
+            const PfoList *const pPfoList(m_nameToListMap.at(listName));
+            pfoList.insert(pfoList.end(), pPfoList->begin(), pPfoList->end());
+        }
+
+        m_pfoHierarchy.Fill(pfoList);
+        m_isPfoHierarchyValid = true;
+        m_pfoHierarchyNDeleted = this->GetNObjectsDeleted();
+    }
+
+    pPfoHierarchy = &m_pfoHierarchy;
+
+    return STATUS_CODE_SUCCESS;
+}
+
 //------------------------------------------------------------------------------------------------------------------------------------------
 //------------------------------------------------------------------------------------------------------------------------------------------
 
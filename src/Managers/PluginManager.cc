@@ -151,6 +151,14 @@ const ParticleId *PluginManager::GetParticleId() const
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+ScratchArena &PluginManager::GetShowerProfileScratchArena() const
+{
+    // ATTN Scratch contents are not part of the observable plugin manager state, so are provided via const plugin manager access
+    return m_showerProfileScratchArena;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 StatusCode PluginManager::SetBFieldPlugin(BFieldPlugin *const pBFieldPlugin)
 {
     if (nullptr != m_pBFieldPlugin)
@@ -263,6 +271,8 @@ StatusCode PluginManager::ResetForNextEvent()
     if (m_pShowerProfilePlugin)
         PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pShowerProfilePlugin->Reset());
 
+    m_showerProfileScratchArena.Clear();
+
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pEnergyCorrections->ResetForNextEvent());
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pParticleId->ResetForNextEvent());
 
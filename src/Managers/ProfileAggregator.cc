@@ -0,0 +1,329 @@
+/**
+ *  @file   PandoraSDK/src/Managers/ProfileAggregator.cc
+ *
+ *  @brief  Implementation of the profile aggregator class.
+ *
+ *  $Log: $
+ */
+
+#include "Managers/ProfileAggregator.h"
+
+#include "Pandora/AllocationTracking.h"
+#include "Pandora/HotPathCounters.h"
+#include "Pandora/Pandora.h"
+#include "Pandora/PandoraSettings.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+namespace pandora
+{
+
+ProfileAggregator::InstanceSummaryMap ProfileAggregator::m_instanceSummaryMap;
+ProfileAggregator::Summary ProfileAggregator::m_retiredSummary;
+unsigned long long ProfileAggregator::m_nEvents(0);
+ProfileAggregator::Clock::time_point ProfileAggregator::m_startTime;
+std::mutex ProfileAggregator::m_mutex;
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+ProfileAggregator::AlgorithmSummary::AlgorithmSummary() :
+    m_nInstances(0),
+    m_nCalls(0),
+    m_nEvents(0),
+    m_wallTime(0.),
+    m_selfWallTime(0.),
+    m_cpuTime(0.),
+    m_nAllocations(0),
+    m_nAllocatedBytes(0)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+ProfileAggregator::Summary::Summary() :
+    m_nInstances(0),
+    m_nEvents(0),
+    m_elapsedTime(0.),
+    m_nEventLatencies(0),
+    m_latencySum(0.),
+    m_maxLatency(0.)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void ProfileAggregator::GetSummary(Summary &summary)
+{
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    ProfileAggregator::GetSummaryLocked(summary);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode ProfileAggregator::GetEventLatencyQuantile(const Summary &summary, const double fraction, double &latency)
+{
+    return ProfileManager::GetLatencyQuantile(summary.m_latencyBinVector, summary.m_nEventLatencies, summary.m_maxLatency, fraction, latency);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void ProfileAggregator::PrintSummary()
+{
+    Summary summary;
+    ProfileAggregator::GetSummary(summary);
+    ProfileAggregator::Print(summary);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void ProfileAggregator::Update(const Pandora *const pPandora, const ProfileManager &profileManager, const MemoryUsageMap &peakUsageMap)
+{
+    const std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (0 == m_nEvents)
+        m_startTime = Clock::now();
+
+    Summary &summary(m_instanceSummaryMap[pPandora]);
+    summary.m_nInstances = 1;
+    ++summary.m_nEvents;
+    ProfileAggregator::FillCumulativeProfile(profileManager, summary);
+    ProfileAggregator::MergePeakMemoryUsage(peakUsageMap, summary.m_peakMemoryUsageMap);
+
+#ifdef PANDORA_HOT_PATH_COUNTERS
+    // ATTN The hot path counters are held per thread and reset at the end of each event, so describe this instance for this event only
+    summary.m_hotPathCounts.resize(NUMBER_OF_HOT_PATH_COUNTERS, 0);
+
+    for (unsigned int i = 0; i < NUMBER_OF_HOT_PATH_COUNTERS; ++i)
+        summary.m_hotPathCounts[i] += HotPathCounters::GetCount(static_cast<HotPathCounter>(i));
+#endif
+
+    ++m_nEvents;
+    const unsigned int reportPeriod(pPandora->GetSettings()->GetAggregatedProfileReportPeriod());
+
+    if ((reportPeriod > 0) && (0 == m_nEvents % reportPeriod))
+    {
+        Summary mergedSummary;
+        ProfileAggregator::GetSummaryLocked(mergedSummary);
+        ProfileAggregator::Print(mergedSummary);
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void ProfileAggregator::Remove(const Pandora *const pPandora, const ProfileManager &profileManager)
+{
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    InstanceSummaryMap::iterator iter(m_instanceSummaryMap.find(pPandora));
+
+    if (m_instanceSummaryMap.end() == iter)
+        return;
+
+    ProfileAggregator::FillCumulativeProfile(profileManager, iter->second);
+    ProfileAggregator::Merge(iter->second, m_retiredSummary);
+    m_instanceSummaryMap.erase(iter);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void ProfileAggregator::FillCumulativeProfile(const ProfileManager &profileManager, Summary &summary)
+{
+    // ATTN Algorithm profiles are never removed from the profile manager, so each summary entry is simply overwritten
+    for (const ProfileManager::AlgorithmProfileMap::value_type &mapEntry : profileManager.GetAlgorithmProfileMap())
+    {
+        const ProfileManager::AlgorithmProfile &profile(mapEntry.second);
+        AlgorithmSummary &algorithmSummary(summary.m_algorithmSummaryMap[mapEntry.first]);
+
+        algorithmSummary.m_type = profile.m_type;
+        algorithmSummary.m_nInstances = 1;
+        algorithmSummary.m_nCalls = profile.m_nCalls;
+        algorithmSummary.m_nEvents = profile.m_nEvents;
+        algorithmSummary.m_wallTime = profile.m_wallTime;
+        algorithmSummary.m_selfWallTime = profile.m_selfWallTime;
+        algorithmSummary.m_cpuTime = profile.m_cpuTime;
+        algorithmSummary.m_objectCounts = profile.m_objectCounts;
+
+        if (profile.m_pAllocationCounters)
+        {
+            algorithmSummary.m_nAllocations = profile.m_pAllocationCounters->m_nAllocations.load();
+            algorithmSummary.m_nAllocatedBytes = profile.m_pAllocationCounters->m_nBytes.load();
+        }
+    }
+
+    summary.m_latencyBinVector = profileManager.m_latencyBinVector;
+    summary.m_nEventLatencies = profileManager.m_nEventLatencies;
+    summary.m_latencySum = profileManager.m_latencySum;
+    summary.m_maxLatency = profileManager.m_maxLatency;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void ProfileAggregator::Merge(const Summary &summary, Summary &mergedSummary)
+{
+    mergedSummary.m_nInstances += summary.m_nInstances;
+    mergedSummary.m_nEvents += summary.m_nEvents;
+
+    for (const AlgorithmSummaryMap::value_type &mapEntry : summary.m_algorithmSummaryMap)
+    {
+        const AlgorithmSummary &algorithmSummary(mapEntry.second);
+        AlgorithmSummary &mergedAlgorithmSummary(mergedSummary.m_algorithmSummaryMap[mapEntry.first]);
+        ProfileManager::ObjectCounts &objectCounts(mergedAlgorithmSummary.m_objectCounts);
+
+        mergedAlgorithmSummary.m_type = algorithmSummary.m_type;
+        mergedAlgorithmSummary.m_nInstances += algorithmSummary.m_nInstances;
+        mergedAlgorithmSummary.m_nCalls += algorithmSummary.m_nCalls;
+        mergedAlgorithmSummary.m_nEvents += algorithmSummary.m_nEvents;
+        mergedAlgorithmSummary.m_wallTime += algorithmSummary.m_wallTime;
+        mergedAlgorithmSummary.m_selfWallTime += algorithmSummary.m_selfWallTime;
+        mergedAlgorithmSummary.m_cpuTime += algorithmSummary.m_cpuTime;
+        objectCounts.m_nClustersCreated += algorithmSummary.m_objectCounts.m_nClustersCreated;
+        objectCounts.m_nClustersDeleted += algorithmSummary.m_objectCounts.m_nClustersDeleted;
+        objectCounts.m_nPfosCreated += algorithmSummary.m_objectCounts.m_nPfosCreated;
+        objectCounts.m_nPfosDeleted += algorithmSummary.m_objectCounts.m_nPfosDeleted;
+        objectCounts.m_nVerticesCreated += algorithmSummary.m_objectCounts.m_nVerticesCreated;
+        objectCounts.m_nVerticesDeleted += algorithmSummary.m_objectCounts.m_nVerticesDeleted;
+        mergedAlgorithmSummary.m_nAllocations += algorithmSummary.m_nAllocations;
+        mergedAlgorithmSummary.m_nAllocatedBytes += algorithmSummary.m_nAllocatedBytes;
+    }
+
+    if (mergedSummary.m_hotPathCounts.size() < summary.m_hotPathCounts.size())
+        mergedSummary.m_hotPathCounts.resize(summary.m_hotPathCounts.size(), 0);
+
+    for (unsigned int i = 0; i < summary.m_hotPathCounts.size(); ++i)
+        mergedSummary.m_hotPathCounts[i] += summary.m_hotPathCounts[i];
+
+    ProfileAggregator::MergePeakMemoryUsage(summary.m_peakMemoryUsageMap, mergedSummary.m_peakMemoryUsageMap);
+
+    // ATTN All histograms share the binning of the profile manager, so may be summed bin by bin
+    if (mergedSummary.m_latencyBinVector.size() < summary.m_latencyBinVector.size())
+        mergedSummary.m_latencyBinVector.resize(summary.m_latencyBinVector.size(), 0);
+
+    for (unsigned int iBin = 0; iBin < summary.m_latencyBinVector.size(); ++iBin)
+        mergedSummary.m_latencyBinVector[iBin] += summary.m_latencyBinVector[iBin];
+
+    mergedSummary.m_nEventLatencies += summary.m_nEventLatencies;
+    mergedSummary.m_latencySum += summary.m_latencySum;
+    mergedSummary.m_maxLatency = std::max(mergedSummary.m_maxLatency, summary.m_maxLatency);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void ProfileAggregator::MergePeakMemoryUsage(const MemoryUsageMap &peakUsageMap, MemoryUsageMap &mergedPeakUsageMap)
+{
+    for (const MemoryUsageMap::value_type &mapEntry : peakUsageMap)
+    {
+        MemoryUsageMap::iterator iter(mergedPeakUsageMap.find(mapEntry.first));
+
+        if (mergedPeakUsageMap.end() == iter)
+        {
+            mergedPeakUsageMap.insert(mapEntry);
+        }
+        else if (mapEntry.second.m_estimatedBytes > iter->second.m_estimatedBytes)
+        {
+            iter->second = mapEntry.second;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void ProfileAggregator::GetSummaryLocked(Summary &summary)
+{
+    summary = m_retiredSummary;
+
+    for (const InstanceSummaryMap::value_type &mapEntry : m_instanceSummaryMap)
+        ProfileAggregator::Merge(mapEntry.second, summary);
+
+    summary.m_elapsedTime = (m_nEvents > 0) ? std::chrono::duration<double>(Clock::now() - m_startTime).count() : 0.;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void ProfileAggregator::Print(const Summary &summary)
+{
+    std::cout << "Aggregated profile, " << summary.m_nInstances << " pandora instances, " << summary.m_nEvents << " events" << std::fixed
+              << std::setprecision(3) << ", " << ((summary.m_elapsedTime > 0.) ? static_cast<double>(summary.m_nEvents) / summary.m_elapsedTime : 0.)
+              << " events/s, Peak RSS: " << ProfileManager::GetPeakResidentSetSize() << " MB" << std::defaultfloat << std::endl;
+
+    if (!summary.m_algorithmSummaryMap.empty())
+    {
+        std::cout << "Algorithm profile (times in ms, objects as created/deleted)" << std::endl
+                  << std::left << std::setw(40) << "Instance" << std::setw(30) << "Type" << std::right << std::setw(10) << "Pandoras"
+                  << std::setw(12) << "Calls" << std::setw(12) << "Wall" << std::setw(12) << "SelfWall" << std::setw(12) << "Cpu"
+                  << std::setw(12) << "Wall/Event" << std::setw(20) << "Clusters" << std::setw(20) << "Pfos" << std::setw(20) << "Vertices";
+
+        if (AllocationTracking::IsEnabled())
+            std::cout << std::setw(14) << "Allocations" << std::setw(12) << "AllocMB";
+
+        std::cout << std::endl;
+
+        for (const AlgorithmSummaryMap::value_type &mapEntry : summary.m_algorithmSummaryMap)
+        {
+            const AlgorithmSummary &algorithmSummary(mapEntry.second);
+            const ProfileManager::ObjectCounts &objectCounts(algorithmSummary.m_objectCounts);
+            const double wallTimePerEvent((algorithmSummary.m_nEvents > 0) ?
+                algorithmSummary.m_wallTime / static_cast<double>(algorithmSummary.m_nEvents) : 0.);
+
+            std::cout << std::left << std::setw(40) << mapEntry.first << std::setw(30) << algorithmSummary.m_type << std::right
+                      << std::setw(10) << algorithmSummary.m_nInstances << std::setw(12) << algorithmSummary.m_nCalls << std::fixed
+                      << std::setprecision(3) << std::setw(12) << 1000. * algorithmSummary.m_wallTime << std::setw(12)
+                      << 1000. * algorithmSummary.m_selfWallTime << std::setw(12) << 1000. * algorithmSummary.m_cpuTime << std::setw(12)
+                      << 1000. * wallTimePerEvent
+                      << std::setw(20) << (std::to_string(objectCounts.m_nClustersCreated) + "/" + std::to_string(objectCounts.m_nClustersDeleted))
+                      << std::setw(20) << (std::to_string(objectCounts.m_nPfosCreated) + "/" + std::to_string(objectCounts.m_nPfosDeleted))
+                      << std::setw(20) << (std::to_string(objectCounts.m_nVerticesCreated) + "/" + std::to_string(objectCounts.m_nVerticesDeleted));
+
+            if (AllocationTracking::IsEnabled())
+            {
+                std::cout << std::setw(14) << algorithmSummary.m_nAllocations << std::setw(12)
+                          << static_cast<double>(algorithmSummary.m_nAllocatedBytes) / (1024. * 1024.);
+            }
+
+            std::cout << std::defaultfloat << std::endl;
+        }
+    }
+
+    if (summary.m_nEventLatencies > 0)
+    {
+        double p50(0.), p99(0.), p999(0.);
+        (void) ProfileAggregator::GetEventLatencyQuantile(summary, 0.5, p50);
+        (void) ProfileAggregator::GetEventLatencyQuantile(summary, 0.99, p99);
+        (void) ProfileAggregator::GetEventLatencyQuantile(summary, 0.999, p999);
+
+        std::cout << "Event latency, " << summary.m_nEventLatencies << " events (times in ms)" << std::endl << std::fixed << std::setprecision(3)
+                  << "    Mean: " << 1000. * summary.m_latencySum / static_cast<double>(summary.m_nEventLatencies) << ", Max: "
+                  << 1000. * summary.m_maxLatency << ", p50: " << 1000. * p50 << ", p99: " << 1000. * p99 << ", p999: " << 1000. * p999
+                  << std::defaultfloat << std::endl;
+    }
+
+    if (!summary.m_hotPathCounts.empty())
+    {
+        std::cout << "Hot path counters" << std::endl;
+
+        for (unsigned int i = 0; i < summary.m_hotPathCounts.size(); ++i)
+            std::cout << "    " << HotPathCounterToString(static_cast<HotPathCounter>(i)) << ": " << summary.m_hotPathCounts[i] << std::endl;
+    }
+
+    if (!summary.m_peakMemoryUsageMap.empty())
+    {
+        std::cout << "Memory usage, largest per-event peak (estimated MB)" << std::endl;
+
+        for (const MemoryUsageMap::value_type &mapEntry : summary.m_peakMemoryUsageMap)
+        {
+            const MemoryUsage &peakUsage(mapEntry.second);
+
+            std::cout << "    " << mapEntry.first << ": objects " << peakUsage.m_nObjects << ", lists " << peakUsage.m_nLists
+                      << ", list entries " << peakUsage.m_nListEntries << std::fixed << std::setprecision(3) << ", size "
+                      << static_cast<double>(peakUsage.m_estimatedBytes) / (1024. * 1024.) << std::defaultfloat;
+
+            if (!peakUsage.m_algorithmName.empty())
+                std::cout << ", peak after " << peakUsage.m_algorithmName;
+
+            std::cout << std::endl;
+        }
+    }
+}
+
+} // namespace pandora
@@ -0,0 +1,395 @@
+/**
+ *  @file   PandoraSDK/src/Managers/ProfileManager.cc
+ *
+ *  @brief  Implementation of the profile manager class.
+ *
+ *  $Log: $
+ */
+
+#include "Managers/ClusterManager.h"
+#include "Managers/ParticleFlowObjectManager.h"
+#include "Managers/ProfileManager.h"
+#include "Managers/VertexManager.h"
+
+#include "Pandora/Algorithm.h"
+#include "Pandora/AllocationTracking.h"
+#include "Pandora/Pandora.h"
+#include "Pandora/PandoraSettings.h"
+#include "Pandora/ProfileZones.h"
+
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+
+#include <sys/resource.h>
+
+namespace pandora
+{
+
+const double ProfileManager::m_minLatency(1.e-6);
+const unsigned int ProfileManager::m_nLatencyBinsPerDecade(20);
+const unsigned int ProfileManager::m_nLatencyBins(180);
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+ProfileManager::ObjectCounts::ObjectCounts() :
+    m_nClustersCreated(0),
+    m_nClustersDeleted(0),
+    m_nPfosCreated(0),
+    m_nPfosDeleted(0),
+    m_nVerticesCreated(0),
+    m_nVerticesDeleted(0)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+ProfileManager::AlgorithmProfile::AlgorithmProfile() :
+    m_nCalls(0),
+    m_nEvents(0),
+    m_wallTime(0.),
+    m_selfWallTime(0.),
+    m_cpuTime(0.),
+    m_pAllocationCounters(nullptr),
+    m_lastEventNumber(0)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+ProfileManager::ProfileManager(const Pandora *const pPandora, const ClusterManager *const pClusterManager,
+        const ParticleFlowObjectManager *const pPfoManager, const VertexManager *const pVertexManager) :
+    m_referenceTime(Clock::now()),
+    m_eventNumber(0),
+    m_latencyBinVector(m_nLatencyBins, 0),
+    m_nEventLatencies(0),
+    m_latencySum(0.),
+    m_maxLatency(0.),
+    m_pPandora(pPandora),
+    m_pClusterManager(pClusterManager),
+    m_pPfoManager(pPfoManager),
+    m_pVertexManager(pVertexManager)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+ProfileManager::~ProfileManager()
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void ProfileManager::PrintSummary() const
+{
+    std::cout << "Algorithm profile, " << m_eventNumber << " events (times in ms, objects as created/deleted)" << std::endl
+              << std::left << std::setw(40) << "Instance" << std::setw(30) << "Type" << std::right << std::setw(10) << "Calls"
+              << std::setw(12) << "Wall" << std::setw(12) << "SelfWall" << std::setw(12) << "Cpu" << std::setw(12) << "Wall/Event"
+              << std::setw(16) << "Clusters" << std::setw(16) << "Pfos" << std::setw(16) << "Vertices";
+
+    // ATTN Allocations are attributed to the innermost running algorithm, and live sizes include objects persisting beyond the algorithm
+    if (AllocationTracking::IsEnabled())
+        std::cout << std::setw(14) << "Allocations" << std::setw(12) << "AllocMB" << std::setw(12) << "LiveMB";
+
+    std::cout << std::endl;
+
+    for (const AlgorithmProfileMap::value_type &mapEntry : m_algorithmProfileMap)
+    {
+        const AlgorithmProfile &profile(mapEntry.second);
+        const ObjectCounts &objectCounts(profile.m_objectCounts);
+        const double wallTimePerEvent((profile.m_nEvents > 0) ? profile.m_wallTime / static_cast<double>(profile.m_nEvents) : 0.);
+
+        std::cout << std::left << std::setw(40) << mapEntry.first << std::setw(30) << profile.m_type << std::right << std::setw(10)
+                  << profile.m_nCalls << std::fixed << std::setprecision(3) << std::setw(12) << 1000. * profile.m_wallTime << std::setw(12)
+                  << 1000. * profile.m_selfWallTime << std::setw(12) << 1000. * profile.m_cpuTime << std::setw(12) << 1000. * wallTimePerEvent
+                  << std::setw(16) << (std::to_string(objectCounts.m_nClustersCreated) + "/" + std::to_string(objectCounts.m_nClustersDeleted))
+                  << std::setw(16) << (std::to_string(objectCounts.m_nPfosCreated) + "/" + std::to_string(objectCounts.m_nPfosDeleted))
+                  << std::setw(16) << (std::to_string(objectCounts.m_nVerticesCreated) + "/" + std::to_string(objectCounts.m_nVerticesDeleted));
+
+        if (profile.m_pAllocationCounters)
+        {
+            const AllocationCounters &allocationCounters(*profile.m_pAllocationCounters);
+            std::cout << std::setw(14) << allocationCounters.m_nAllocations.load() << std::setw(12)
+                      << static_cast<double>(allocationCounters.m_nBytes.load()) / (1024. * 1024.) << std::setw(12)
+                      << static_cast<double>(allocationCounters.m_liveBytes.load()) / (1024. * 1024.);
+        }
+
+        std::cout << std::defaultfloat << std::endl;
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode ProfileManager::WriteTrace(const std::string &fileName) const
+{
+    std::ofstream traceFile(fileName.c_str(), std::ios::out | std::ios::trunc);
+
+    if (!traceFile.is_open())
+    {
+        std::cout << "ProfileManager::WriteTrace - unable to open file " << fileName << std::endl;
+        return STATUS_CODE_FAILURE;
+    }
+
+    traceFile << "{\"traceEvents\":[";
+    traceFile << std::fixed << std::setprecision(3);
+
+    for (TraceEntryList::const_iterator iter = m_traceEntryList.begin(), iterEnd = m_traceEntryList.end(); iter != iterEnd; ++iter)
+    {
+        // ATTN Algorithm names and types are xml attributes and are not expected to contain characters requiring json escapes
+        traceFile << ((m_traceEntryList.begin() == iter) ? "\n" : ",\n")
+                  << "{\"name\":\"" << *(iter->m_pInstanceName) << "\",\"cat\":\"" << *(iter->m_pType) << "\",\"ph\":\"X\",\"ts\":"
+                  << 1.e6 * iter->m_startTime << ",\"dur\":" << 1.e6 * iter->m_duration << ",\"pid\":0,\"tid\":" << iter->m_threadIndex
+                  << ",\"args\":{\"event\":" << iter->m_eventNumber << "}}";
+    }
+
+#ifdef PANDORA_PROFILE_ZONES
+    ProfileZones::ThreadZoneRecordVector threadZoneRecordVector;
+    ProfileZones::GetZoneRecords(threadZoneRecordVector);
+
+    const unsigned long long referenceTime(std::chrono::duration_cast<std::chrono::nanoseconds>(m_referenceTime.time_since_epoch()).count());
+    bool isFirstEntry(m_traceEntryList.empty());
+
+    for (const ProfileZones::ThreadZoneRecordVector::value_type &threadZoneRecord : threadZoneRecordVector)
+    {
+        const ProfileZones::ZoneRecord &zoneRecord(threadZoneRecord.second);
+
+        if (zoneRecord.m_startTime < referenceTime)
+            continue;
+
+        // ATTN Zone names are string literals in content code and are not expected to contain characters requiring json escapes
+        traceFile << (isFirstEntry ? "\n" : ",\n")
+                  << "{\"name\":\"" << zoneRecord.m_pName << "\",\"cat\":\"zone\",\"ph\":\"X\",\"ts\":"
+                  << 1.e-3 * static_cast<double>(zoneRecord.m_startTime - referenceTime) << ",\"dur\":"
+                  << 1.e-3 * static_cast<double>(zoneRecord.m_endTime - zoneRecord.m_startTime) << ",\"pid\":0,\"tid\":"
+                  << threadZoneRecord.first << "}";
+        isFirstEntry = false;
+    }
+#endif
+
+    traceFile << "\n]}" << std::endl;
+
+    return (traceFile.good() ? STATUS_CODE_SUCCESS : STATUS_CODE_FAILURE);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode ProfileManager::GetEventLatencyQuantile(const double fraction, double &latency) const
+{
+    return ProfileManager::GetLatencyQuantile(m_latencyBinVector, m_nEventLatencies, m_maxLatency, fraction, latency);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void ProfileManager::PrintEventLatencySummary() const
+{
+    std::cout << "Event latency, " << m_nEventLatencies << " events (times in ms)" << std::endl;
+
+    if (0 == m_nEventLatencies)
+        return;
+
+    double p50(0.), p99(0.), p999(0.);
+    (void) this->GetEventLatencyQuantile(0.5, p50);
+    (void) this->GetEventLatencyQuantile(0.99, p99);
+    (void) this->GetEventLatencyQuantile(0.999, p999);
+
+    std::cout << std::fixed << std::setprecision(3)
+              << "    Mean: " << 1000. * m_latencySum / static_cast<double>(m_nEventLatencies) << ", Max: " << 1000. * m_maxLatency
+              << ", p50: " << 1000. * p50 << ", p99: " << 1000. * p99 << ", p999: " << 1000. * p999 << std::endl;
+
+    std::cout << "    Throughput: " << ((m_latencySum > 0.) ? static_cast<double>(m_nEventLatencies) / m_latencySum : 0.) << " events/s"
+              << ", Peak RSS: " << ProfileManager::GetPeakResidentSetSize() << " MB" << std::defaultfloat << std::endl;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode ProfileManager::BeginAlgorithm(const Algorithm *const pAlgorithm)
+{
+    AlgorithmProfileMap::iterator profileIter(m_algorithmProfileMap.find(pAlgorithm->GetInstanceName()));
+
+    if (m_algorithmProfileMap.end() == profileIter)
+    {
+        profileIter = m_algorithmProfileMap.insert(AlgorithmProfileMap::value_type(pAlgorithm->GetInstanceName(), AlgorithmProfile())).first;
+        profileIter->second.m_type = pAlgorithm->GetType();
+
+        if (AllocationTracking::IsEnabled())
+            profileIter->second.m_pAllocationCounters = AllocationTracking::NewCounters();
+    }
+
+    Invocation invocation;
+    invocation.m_profileIter = profileIter;
+    invocation.m_daughterWallTime = 0.;
+    this->GetObjectCounts(invocation.m_startObjectCounts);
+    invocation.m_startCpuTime = ProfileManager::GetThreadCpuTime();
+    invocation.m_startTime = Clock::now();
+    invocation.m_pParentCounters = AllocationTracking::GetCurrentCounters();
+    m_invocationStack.push_back(invocation);
+
+    if (profileIter->second.m_pAllocationCounters)
+        AllocationTracking::SetCurrentCounters(profileIter->second.m_pAllocationCounters);
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode ProfileManager::EndAlgorithm()
+{
+    const Clock::time_point endTime(Clock::now());
+    const double endCpuTime(ProfileManager::GetThreadCpuTime());
+
+    if (m_invocationStack.empty())
+        return STATUS_CODE_NOT_INITIALIZED;
+
+    const Invocation &invocation(m_invocationStack.back());
+    const double wallTime(std::chrono::duration<double>(endTime - invocation.m_startTime).count());
+
+    ObjectCounts endObjectCounts;
+    this->GetObjectCounts(endObjectCounts);
+
+    AlgorithmProfile &profile(invocation.m_profileIter->second);
+    ObjectCounts &objectCounts(profile.m_objectCounts);
+    const ObjectCounts &startObjectCounts(invocation.m_startObjectCounts);
+
+    ++profile.m_nCalls;
+    profile.m_wallTime += wallTime;
+    profile.m_selfWallTime += wallTime - invocation.m_daughterWallTime;
+    profile.m_cpuTime += endCpuTime - invocation.m_startCpuTime;
+    objectCounts.m_nClustersCreated += endObjectCounts.m_nClustersCreated - startObjectCounts.m_nClustersCreated;
+    objectCounts.m_nClustersDeleted += endObjectCounts.m_nClustersDeleted - startObjectCounts.m_nClustersDeleted;
+    objectCounts.m_nPfosCreated += endObjectCounts.m_nPfosCreated - startObjectCounts.m_nPfosCreated;
+    objectCounts.m_nPfosDeleted += endObjectCounts.m_nPfosDeleted - startObjectCounts.m_nPfosDeleted;
+    objectCounts.m_nVerticesCreated += endObjectCounts.m_nVerticesCreated - startObjectCounts.m_nVerticesCreated;
+    objectCounts.m_nVerticesDeleted += endObjectCounts.m_nVerticesDeleted - startObjectCounts.m_nVerticesDeleted;
+
+    if ((0 == profile.m_nEvents) || (profile.m_lastEventNumber != m_eventNumber))
+    {
+        ++profile.m_nEvents;
+        profile.m_lastEventNumber = m_eventNumber;
+    }
+
+    if (m_pPandora->GetSettings()->ShouldRecordAlgorithmTrace())
+    {
+        TraceEntry traceEntry;
+        traceEntry.m_pInstanceName = &(invocation.m_profileIter->first);
+        traceEntry.m_pType = &(profile.m_type);
+        traceEntry.m_eventNumber = m_eventNumber;
+#ifdef PANDORA_PROFILE_ZONES
+        traceEntry.m_threadIndex = ProfileZones::GetThreadIndex();
+#else
+        traceEntry.m_threadIndex = 0;
+#endif
+        traceEntry.m_startTime = std::chrono::duration<double>(invocation.m_startTime - m_referenceTime).count();
+        traceEntry.m_duration = wallTime;
+        m_traceEntryList.push_back(traceEntry);
+    }
+
+    AllocationTracking::SetCurrentCounters(invocation.m_pParentCounters);
+    m_invocationStack.pop_back();
+
+    if (!m_invocationStack.empty())
+        m_invocationStack.back().m_daughterWallTime += wallTime;
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode ProfileManager::ResetForNextEvent()
+{
+    if (!m_invocationStack.empty())
+        AllocationTracking::SetCurrentCounters(m_invocationStack.front().m_pParentCounters);
+
+    m_invocationStack.clear();
+    ++m_eventNumber;
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void ProfileManager::RecordEventLatency(const double latency)
+{
+    const double binPosition((latency > m_minLatency) ? static_cast<double>(m_nLatencyBinsPerDecade) * std::log10(latency / m_minLatency) : 0.);
+    const unsigned int iBin(std::min(static_cast<unsigned int>(binPosition), m_nLatencyBins - 1));
+
+    ++m_latencyBinVector[iBin];
+    ++m_nEventLatencies;
+    m_latencySum += latency;
+    m_maxLatency = std::max(m_maxLatency, latency);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void ProfileManager::GetObjectCounts(ObjectCounts &objectCounts) const
+{
+    objectCounts.m_nClustersCreated = m_pClusterManager->GetNObjectsCreated();
+    objectCounts.m_nClustersDeleted = m_pClusterManager->GetNObjectsDeleted();
+    objectCounts.m_nPfosCreated = m_pPfoManager->GetNObjectsCreated();
+    objectCounts.m_nPfosDeleted = m_pPfoManager->GetNObjectsDeleted();
+    objectCounts.m_nVerticesCreated = m_pVertexManager->GetNObjectsCreated();
+    objectCounts.m_nVerticesDeleted = m_pVertexManager->GetNObjectsDeleted();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+double ProfileManager::GetThreadCpuTime()
+{
+    timespec cpuTime;
+
+    if (0 != clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpuTime))
+        return 0.;
+
+    return static_cast<double>(cpuTime.tv_sec) + 1.e-9 * static_cast<double>(cpuTime.tv_nsec);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+double ProfileManager::GetPeakResidentSetSize()
+{
+    rusage resourceUsage;
+
+    if (0 != getrusage(RUSAGE_SELF, &resourceUsage))
+        return 0.;
+
+    // ATTN The maximum resident set size is reported in kilobytes on linux, but in bytes on macOS
+#ifdef __APPLE__
+    return static_cast<double>(resourceUsage.ru_maxrss) / (1024. * 1024.);
+#else
+    return static_cast<double>(resourceUsage.ru_maxrss) / 1024.;
+#endif
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode ProfileManager::GetLatencyQuantile(const std::vector<unsigned int> &latencyBinVector, const unsigned long long nEventLatencies,
+    const double maxLatency, const double fraction, double &latency)
+{
+    if ((fraction < 0.) || (fraction > 1.))
+        return STATUS_CODE_INVALID_PARAMETER;
+
+    if ((0 == nEventLatencies) || (m_nLatencyBins != latencyBinVector.size()))
+        return STATUS_CODE_NOT_INITIALIZED;
+
+    const double targetCount(fraction * static_cast<double>(nEventLatencies));
+    unsigned long long cumulativeCount(0);
+
+    for (unsigned int iBin = 0; iBin < m_nLatencyBins; ++iBin)
+    {
+        cumulativeCount += latencyBinVector[iBin];
+
+        if ((cumulativeCount > 0) && (static_cast<double>(cumulativeCount) >= targetCount))
+        {
+            const double binUpperEdge(m_minLatency * std::pow(10., static_cast<double>(iBin + 1) / static_cast<double>(m_nLatencyBinsPerDecade)));
+            latency = std::min(binUpperEdge, maxLatency);
+            return STATUS_CODE_SUCCESS;
+        }
+    }
+
+    latency = maxLatency;
+    return STATUS_CODE_SUCCESS;
+}
+
+} // namespace pandora
@@ -6,20 +6,34 @@
  *  $Log: $
  */
 
+#include "Geometry/SubDetector.h"
+
+#include "Managers/GeometryManager.h"
+#include "Managers/PluginManager.h"
 #include "Managers/TrackManager.h"
 
+#include "Objects/Helix.h"
 #include "Objects/Track.h"
 
 #include "Pandora/ObjectFactory.h"
+#include "Pandora/Pandora.h"
 #include "Pandora/PandoraInternal.h"
+#include "Pandora/PandoraObjectFactories.h"
+
+#include "Plugins/BFieldPlugin.h"
+#include "Plugins/PseudoLayerPlugin.h"
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace pandora
 {
 
 TrackManager::TrackManager(const Pandora *const pPandora) :
-    InputObjectManager<Track>(pPandora)
+    InputObjectManager<Track>(pPandora),
+    m_isInputSpatialIndexValid(false),
+    m_isTrackRelationGraphValid(false)
 {
     PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->CreateInitialLists());
 }
@@ -40,7 +54,13 @@ StatusCode TrackManager::Create(const object_creation::Track::Parameters &parame
 
     try
     {
-        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, factory.Create(parameters, pTrack));
+        if (!this->IsWithinObjectBudget(1))
+            throw StatusCodeException(STATUS_CODE_BUDGET_EXCEEDED);
+
+        if (this->ShouldValidateInputParameters())
+            PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, TrackManager::ValidateParameters(parameters));
+
+        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, factory.CreateObject(parameters, pTrack));
 
         NameToListMap::iterator inputIter = m_nameToListMap.find(m_inputListName);
 
@@ -51,6 +71,10 @@ StatusCode TrackManager::Create(const object_creation::Track::Parameters &parame
             throw StatusCodeException(STATUS_CODE_ALREADY_PRESENT);
 
         inputIter->second->push_back(pTrack);
+        this->AssignIndex(pTrack);
+        m_trackSelectionMasks.Add(pTrack);
+        m_isInputSpatialIndexValid = false;
+        m_isTrackRelationGraphValid = false;
         return STATUS_CODE_SUCCESS;
     }
     catch (StatusCodeException &statusCodeException)
@@ -64,6 +88,108 @@ StatusCode TrackManager::Create(const object_creation::Track::Parameters &parame
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+StatusCode TrackManager::Create(const std::vector<object_creation::Track::Parameters> &parametersVector,
+    const ObjectFactory<object_creation::Track::Parameters, object_creation::Track::Object> &factory)
+{
+    NameToListMap::iterator inputIter = m_nameToListMap.find(m_inputListName);
+
+    if (m_nameToListMap.end() == inputIter)
+        return STATUS_CODE_FAILURE;
+
+    TrackVector trackVector;
+    trackVector.reserve(parametersVector.size());
+    m_uidToTrackMap.reserve(m_uidToTrackMap.size() + parametersVector.size());
+    unsigned int nRegistered(0);
+
+    try
+    {
+        if (!this->IsWithinObjectBudget(parametersVector.size()))
+            throw StatusCodeException(STATUS_CODE_BUDGET_EXCEEDED);
+
+        const bool shouldValidateParameters(this->ShouldValidateInputParameters());
+
+        for (const object_creation::Track::Parameters &parameters : parametersVector)
+        {
+            if (shouldValidateParameters)
+                PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, TrackManager::ValidateParameters(parameters));
+
+            const Track *pTrack(nullptr);
+            const StatusCode statusCode(factory.CreateObject(parameters, pTrack));
+
+            if (pTrack)
+                trackVector.push_back(pTrack);
+
+            if (STATUS_CODE_SUCCESS != statusCode)
+                throw StatusCodeException(statusCode);
+
+            if (!pTrack)
+                throw StatusCodeException(STATUS_CODE_FAILURE);
+        }
+
+        for (const Track *const pTrack : trackVector)
+        {
+            if (!m_uidToTrackMap.insert(UidToTrackMap::value_type(pTrack->GetParentAddress(), pTrack)).second)
+                throw StatusCodeException(STATUS_CODE_ALREADY_PRESENT);
+
+            ++nRegistered;
+        }
+    }
+    catch (StatusCodeException &statusCodeException)
+    {
+        std::cout << "Failed to create tracks: " << statusCodeException.ToString() << std::endl;
+
+        for (unsigned int i = 0; i < nRegistered; ++i)
+            m_uidToTrackMap.erase(trackVector[i]->GetParentAddress());
+
+        for (const Track *const pTrack : trackVector)
+            delete pTrack;
+
+        return statusCodeException.GetStatusCode();
+    }
+
+    inputIter->second->insert(inputIter->second->end(), trackVector.begin(), trackVector.end());
+
+    for (const Track *const pTrack : trackVector)
+    {
+        this->AssignIndex(pTrack);
+        m_trackSelectionMasks.Add(pTrack);
+    }
+
+    m_isInputSpatialIndexValid = false;
+    m_isTrackRelationGraphValid = false;
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode TrackManager::ValidateParameters(const object_creation::Track::Parameters &parameters)
+{
+    if (!parameters.m_d0.IsInitialized() || !parameters.m_z0.IsInitialized() || !parameters.m_particleId.IsInitialized() ||
+        !parameters.m_charge.IsInitialized() || !parameters.m_mass.IsInitialized() || !parameters.m_momentumAtDca.IsInitialized() ||
+        !parameters.m_trackStateAtStart.IsInitialized() || !parameters.m_trackStateAtEnd.IsInitialized() ||
+        !parameters.m_trackStateAtCalorimeter.IsInitialized() || !parameters.m_timeAtCalorimeter.IsInitialized() ||
+        !parameters.m_reachesCalorimeter.IsInitialized() || !parameters.m_isProjectedToEndCap.IsInitialized() ||
+        !parameters.m_canFormPfo.IsInitialized() || !parameters.m_canFormClusterlessPfo.IsInitialized() ||
+        !parameters.m_pParentAddress.IsInitialized())
+    {
+        return STATUS_CODE_NOT_INITIALIZED;
+    }
+
+    // Consistency checks
+    const float mass(parameters.m_mass.Get());
+    const float energyAtDca(std::sqrt(mass * mass + parameters.m_momentumAtDca.Get().GetMagnitudeSquared()));
+
+    if (energyAtDca < std::numeric_limits<float>::epsilon())
+        return STATUS_CODE_INVALID_PARAMETER;
+
+    if (0 == parameters.m_charge.Get())
+        return STATUS_CODE_INVALID_PARAMETER;
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 template <>
 bool TrackManager::IsAvailable(const Track *const pTrack) const
 {
@@ -84,13 +210,14 @@ bool TrackManager::IsAvailable(const TrackList *const pTrackList) const
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 template <>
-void TrackManager::SetAvailability(const Track *const pTrack, bool isAvailable) const
+void TrackManager::SetAvailability(const Track *const pTrack, bool isAvailable)
 {
     this->Modifiable(pTrack)->SetAvailability(isAvailable);
+    m_trackSelectionMasks.SetFlag(pTrack, TrackSelectionMasks::IS_AVAILABLE, isAvailable);
 }
 
 template <>
-void TrackManager::SetAvailability(const TrackList *const pTrackList, bool isAvailable) const
+void TrackManager::SetAvailability(const TrackList *const pTrackList, bool isAvailable)
 {
     for (const Track *const pTrack : *pTrackList)
         this->SetAvailability(pTrack, isAvailable);
@@ -98,18 +225,129 @@ void TrackManager::SetAvailability(const TrackList *const pTrackList, bool isAva
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+bool TrackManager::IsInInitialState() const
+{
+    if (!m_uidToTrackMap.empty() || !m_parentDaughterRelationMap.empty() || !m_siblingRelationMap.empty() ||
+        m_isInputSpatialIndexValid || m_isTrackRelationGraphValid || !m_trackSelectionMasks.empty())
+    {
+        return false;
+    }
+
+    return InputObjectManager<Track>::IsInInitialState();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 StatusCode TrackManager::EraseAllContent()
 {
     m_uidToTrackMap.clear();
     m_parentDaughterRelationMap.clear();
     m_siblingRelationMap.clear();
 
+    m_inputSpatialIndex.Clear();
+    m_isInputSpatialIndexValid = false;
+
+    m_trackRelationGraph.Clear();
+    m_isTrackRelationGraphValid = false;
+
+    m_trackSelectionMasks.Clear();
+
     return InputObjectManager<Track>::EraseAllContent();
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-StatusCode TrackManager::MatchTracksToMCPfoTargets(const UidToMCParticleWeightMap &trackToPfoTargetsMap)
+StatusCode TrackManager::ReserveCapacity(const unsigned int nTracks)
+{
+    m_uidToTrackMap.reserve(nTracks);
+
+    return this->ReserveInputList(nTracks);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode TrackManager::GetInputSpatialIndex(const TrackSpatialIndex *&pTrackSpatialIndex)
+{
+    if (!m_isInputSpatialIndexValid)
+    {
+        NameToListMap::const_iterator inputIter = m_nameToListMap.find(m_inputListName);
+
+        if (m_nameToListMap.end() == inputIter)
+            return STATUS_CODE_FAILURE;
+
+        m_inputSpatialIndex.Fill(*inputIter->second);
+        m_isInputSpatialIndexValid = true;
+    }
+
+    pTrackSpatialIndex = &m_inputSpatialIndex;
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode TrackManager::GetTrackRelationGraph(const TrackRelationGraph *&pTrackRelationGraph)
+{
+    if (!m_isTrackRelationGraphValid)
+    {
+        NameToListMap::const_iterator inputIter = m_nameToListMap.find(m_inputListName);
+
+        if (m_nameToListMap.end() == inputIter)
+            return STATUS_CODE_FAILURE;
+
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_trackRelationGraph.Fill(*inputIter->second));
+        m_isTrackRelationGraphValid = true;
+    }
+
+    pTrackRelationGraph = &m_trackRelationGraph;
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode TrackManager::GetTrackSelectionMasks(const TrackSelectionMasks *&pTrackSelectionMasks) const
+{
+    pTrackSelectionMasks = &m_trackSelectionMasks;
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode TrackManager::CreateInputList()
+{
+    m_isInputSpatialIndexValid = false;
+    m_isTrackRelationGraphValid = false;
+    return InputObjectManager<Track>::CreateInputList();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode TrackManager::AddObjectsToList(const std::string &listName, const TrackList &trackList)
+{
+    if (m_inputListName == listName)
+    {
+        m_isInputSpatialIndexValid = false;
+        m_isTrackRelationGraphValid = false;
+    }
+
+    return InputObjectManager<Track>::AddObjectsToList(listName, trackList);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode TrackManager::RemoveObjectsFromList(const std::string &listName, const TrackList &trackList)
+{
+    if (m_inputListName == listName)
+    {
+        m_isInputSpatialIndexValid = false;
+        m_isTrackRelationGraphValid = false;
+    }
+
+    return InputObjectManager<Track>::RemoveObjectsFromList(listName, trackList);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode TrackManager::MatchTracksToMCPfoTargets(const UidToMCParticleWeightTable &trackToPfoTargetsMap, ThreadPool &threadPool)
 {
     if (trackToPfoTargetsMap.empty())
         return STATUS_CODE_SUCCESS;
@@ -119,16 +357,63 @@ StatusCode TrackManager::MatchTracksToMCPfoTargets(const UidToMCParticleWeightMa
     if (m_nameToListMap.end() == inputIter)
         return STATUS_CODE_FAILURE;
 
-    for (const Track *const pTrack : *inputIter->second)
+    // ATTN Each lookup writes only to its own track, so the input tracks are partitioned across the thread pool in chunks of 256
+    const TrackVector trackVector(inputIter->second->begin(), inputIter->second->end());
+    const MCPfoTargetMatchingTask matchingTask(*this, trackVector, trackToPfoTargetsMap);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, threadPool.ParallelFor(trackVector.size(), matchingTask, 256));
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode TrackManager::CalculateLayerIntersections(ThreadPool &threadPool)
+{
+    const PluginManager *const pPluginManager(m_pPandora->GetPlugins());
+
+    if (!pPluginManager->HasBFieldPlugin() || !pPluginManager->HasPseudoLayerPlugin())
+        return STATUS_CODE_SUCCESS;
+
+    CalorimeterLayerVector calorimeterLayers;
+
+    for (const SubDetectorMap::value_type &mapEntry : m_pPandora->GetGeometry()->GetSubDetectorMap())
     {
-        UidToMCParticleWeightMap::const_iterator pfoTargetIter = trackToPfoTargetsMap.find(pTrack->GetParentAddress());
+        const SubDetector *const pSubDetector(mapEntry.second);
+        const SubDetectorType subDetectorType(pSubDetector->GetSubDetectorType());
+        const bool isBarrel((ECAL_BARREL == subDetectorType) || (HCAL_BARREL == subDetectorType) || (MUON_BARREL == subDetectorType));
+        const bool isEndCap((ECAL_ENDCAP == subDetectorType) || (HCAL_ENDCAP == subDetectorType) || (MUON_ENDCAP == subDetectorType));
 
-        if (trackToPfoTargetsMap.end() == pfoTargetIter)
+        if (!isBarrel && !isEndCap)
             continue;
 
-        this->Modifiable(pTrack)->SetMCParticleWeightMap(pfoTargetIter->second);
+        const SubDetector::SubDetectorLayerVector &subDetectorLayerVector(pSubDetector->GetSubDetectorLayerVector());
+
+        for (unsigned int iLayer = 0; iLayer < subDetectorLayerVector.size(); ++iLayer)
+        {
+            CalorimeterLayer calorimeterLayer;
+            calorimeterLayer.m_subDetectorType = subDetectorType;
+            calorimeterLayer.m_layer = iLayer;
+            calorimeterLayer.m_isBarrel = isBarrel;
+            calorimeterLayer.m_distanceToIp = subDetectorLayerVector[iLayer].GetClosestDistanceToIp();
+            calorimeterLayer.m_maxExtent = isBarrel ? pSubDetector->GetOuterZCoordinate() : pSubDetector->GetOuterRCoordinate();
+            calorimeterLayer.m_isMirroredInZ = pSubDetector->IsMirroredInZ();
+            calorimeterLayers.push_back(calorimeterLayer);
+        }
     }
 
+    if (calorimeterLayers.empty())
+        return STATUS_CODE_SUCCESS;
+
+    NameToListMap::const_iterator inputIter = m_nameToListMap.find(m_inputListName);
+
+    if (m_nameToListMap.end() == inputIter)
+        return STATUS_CODE_FAILURE;
+
+    const float bField(pPluginManager->GetBFieldPlugin()->GetBField(CartesianVector(0.f, 0.f, 0.f)));
+    const TrackVector trackVector(inputIter->second->begin(), inputIter->second->end());
+    const LayerIntersectionTask layerIntersectionTask(*this, trackVector, calorimeterLayers, bField, *pPluginManager->GetPseudoLayerPlugin());
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, threadPool.ParallelFor(trackVector.size(), layerIntersectionTask, 16));
+
     return STATUS_CODE_SUCCESS;
 }
 
@@ -167,11 +452,15 @@ StatusCode TrackManager::SetTrackSiblingRelationship(const Uid firstSiblingUid,
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-StatusCode TrackManager::AssociateTracks() const
+StatusCode TrackManager::AssociateTracks()
 {
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->AddParentDaughterAssociations());
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->AddSiblingAssociations());
 
+    m_isTrackRelationGraphValid = false;
+    const TrackRelationGraph *pTrackRelationGraph(nullptr);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetTrackRelationGraph(pTrackRelationGraph));
+
     return STATUS_CODE_SUCCESS;
 }
 
@@ -257,21 +546,31 @@ StatusCode TrackManager::AddSiblingAssociations() const
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-StatusCode TrackManager::SetAssociatedCluster(const Track *const pTrack, const Cluster *const pCluster) const
+StatusCode TrackManager::SetAssociatedCluster(const Track *const pTrack, const Cluster *const pCluster)
 {
-    return this->Modifiable(pTrack)->SetAssociatedCluster(pCluster);
+    const StatusCode statusCode(this->Modifiable(pTrack)->SetAssociatedCluster(pCluster));
+
+    if (STATUS_CODE_SUCCESS == statusCode)
+        m_trackSelectionMasks.SetFlag(pTrack, TrackSelectionMasks::HAS_ASSOCIATED_CLUSTER, true);
+
+    return statusCode;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-StatusCode TrackManager::RemoveAssociatedCluster(const Track *const pTrack, const Cluster *const pCluster) const
+StatusCode TrackManager::RemoveAssociatedCluster(const Track *const pTrack, const Cluster *const pCluster)
 {
-    return this->Modifiable(pTrack)->RemoveAssociatedCluster(pCluster);
+    const StatusCode statusCode(this->Modifiable(pTrack)->RemoveAssociatedCluster(pCluster));
+
+    if (STATUS_CODE_SUCCESS == statusCode)
+        m_trackSelectionMasks.SetFlag(pTrack, TrackSelectionMasks::HAS_ASSOCIATED_CLUSTER, false);
+
+    return statusCode;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-StatusCode TrackManager::RemoveAllClusterAssociations() const
+StatusCode TrackManager::RemoveAllClusterAssociations()
 {
     NameToListMap::const_iterator inputIter = m_nameToListMap.find(m_inputListName);
 
@@ -283,22 +582,19 @@ StatusCode TrackManager::RemoveAllClusterAssociations() const
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-StatusCode TrackManager::RemoveCurrentClusterAssociations(TrackToClusterMap &danglingClusters) const
+StatusCode TrackManager::GetClusterAssociations(TrackClusterAssociationVector &associations) const
 {
-    NameToListMap::const_iterator listIter = m_nameToListMap.find(m_currentListName);
+    NameToListMap::const_iterator inputIter = m_nameToListMap.find(m_inputListName);
 
-    if (m_nameToListMap.end() == listIter)
+    if (m_nameToListMap.end() == inputIter)
         return STATUS_CODE_FAILURE;
 
-    for (const Track *const pTrack : *listIter->second)
-    {
-        if (!pTrack->HasAssociatedCluster())
-            continue;
-
-        if (!danglingClusters.insert(TrackToClusterMap::value_type(pTrack, pTrack->GetAssociatedCluster())).second)
-            return STATUS_CODE_FAILURE;
+    associations.clear();
 
-        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->RemoveAssociatedCluster(pTrack, pTrack->GetAssociatedCluster()));
+    for (const Track *const pTrack : *inputIter->second)
+    {
+        if (pTrack->HasAssociatedCluster())
+            associations.emplace_back(pTrack, pTrack->GetAssociatedCluster());
     }
 
     return STATUS_CODE_SUCCESS;
@@ -306,7 +602,7 @@ StatusCode TrackManager::RemoveCurrentClusterAssociations(TrackToClusterMap &dan
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-StatusCode TrackManager::RemoveClusterAssociations(const TrackList &trackList) const
+StatusCode TrackManager::RemoveClusterAssociations(const TrackList &trackList)
 {
     for (const Track *const pTrack : trackList)
     {
@@ -325,4 +621,99 @@ StatusCode TrackManager::InitializeReclustering(const Algorithm *const pAlgorith
     return this->CreateTemporaryListAndSetCurrent(pAlgorithm, trackList, temporaryListName);
 }
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+TrackManager::MCPfoTargetMatchingTask::MCPfoTargetMatchingTask(const TrackManager &trackManager, const TrackVector &trackVector,
+        const UidToMCParticleWeightTable &trackToPfoTargetsMap) :
+    m_trackManager(trackManager),
+    m_trackVector(trackVector),
+    m_trackToPfoTargetsMap(trackToPfoTargetsMap)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode TrackManager::MCPfoTargetMatchingTask::Run(const unsigned int index) const
+{
+    const Track *const pTrack(m_trackVector[index]);
+    const MCParticleWeightMap *const pMCParticleWeightMap(m_trackToPfoTargetsMap.Find(pTrack->GetParentAddress()));
+
+    if (pMCParticleWeightMap)
+        m_trackManager.Modifiable(pTrack)->SetMCParticleWeightMap(*pMCParticleWeightMap);
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+TrackManager::LayerIntersectionTask::LayerIntersectionTask(const TrackManager &trackManager, const TrackVector &trackVector,
+        const CalorimeterLayerVector &calorimeterLayers, const float bField, const PseudoLayerPlugin &pseudoLayerPlugin) :
+    m_trackManager(trackManager),
+    m_trackVector(trackVector),
+    m_calorimeterLayers(calorimeterLayers),
+    m_bField(bField),
+    m_pseudoLayerPlugin(pseudoLayerPlugin)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode TrackManager::LayerIntersectionTask::Run(const unsigned int index) const
+{
+    const Track *const pTrack(m_trackVector[index]);
+    const Helix &helix(pTrack->GetHelixAtCalorimeter(m_bField));
+    const CartesianVector &referencePoint(helix.GetReferencePoint());
+    const float zSign((pTrack->GetTrackStateAtCalorimeter().GetMomentum().GetZ() < 0.f) ? -1.f : 1.f);
+
+    Track::LayerIntersectionVector layerIntersections;
+
+    for (const CalorimeterLayer &calorimeterLayer : m_calorimeterLayers)
+    {
+        float genericTime(0.f);
+        CartesianVector intersectionPoint(0.f, 0.f, 0.f);
+
+        if (calorimeterLayer.m_isBarrel)
+        {
+            if ((STATUS_CODE_SUCCESS != helix.GetPointOnCircle(calorimeterLayer.m_distanceToIp, referencePoint, intersectionPoint, genericTime)) ||
+                (std::fabs(intersectionPoint.GetZ()) > calorimeterLayer.m_maxExtent))
+            {
+                continue;
+            }
+        }
+        else
+        {
+            if ((zSign < 0.f) && !calorimeterLayer.m_isMirroredInZ)
+                continue;
+
+            if ((STATUS_CODE_SUCCESS != helix.GetPointInZ(zSign * calorimeterLayer.m_distanceToIp, referencePoint, intersectionPoint, genericTime)) ||
+                (std::sqrt(intersectionPoint.GetX() * intersectionPoint.GetX() + intersectionPoint.GetY() * intersectionPoint.GetY()) > calorimeterLayer.m_maxExtent))
+            {
+                continue;
+            }
+        }
+
+        // ATTN Only intersections downstream of the track state at the calorimeter are of interest
+        if (genericTime < 0.f)
+            continue;
+
+        try
+        {
+            layerIntersections.push_back(Track::LayerIntersection(m_pseudoLayerPlugin.GetPseudoLayer(intersectionPoint), intersectionPoint,
+                genericTime, calorimeterLayer.m_subDetectorType, calorimeterLayer.m_layer));
+        }
+        catch (StatusCodeException &)
+        {
+            // ATTN Intersection points outside the pseudo layer description are not cached
+        }
+    }
+
+    std::stable_sort(layerIntersections.begin(), layerIntersections.end(), [](const Track::LayerIntersection &lhs, const Track::LayerIntersection &rhs)
+        { return ((lhs.m_pseudoLayer != rhs.m_pseudoLayer) ? (lhs.m_pseudoLayer < rhs.m_pseudoLayer) : (lhs.m_genericTime < rhs.m_genericTime)); });
+
+    m_trackManager.Modifiable(pTrack)->SetLayerIntersections(layerIntersections);
+    return STATUS_CODE_SUCCESS;
+}
+
 } // namespace pandora
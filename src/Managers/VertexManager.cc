@@ -11,8 +11,10 @@
 #include "Objects/Vertex.h"
 
 #include "Pandora/ObjectFactory.h"
+#include "Pandora/PandoraObjectFactories.h"
 
 #include <algorithm>
+#include <unordered_set>
 
 namespace pandora
 {
@@ -42,17 +44,21 @@ StatusCode VertexManager::Create(const object_creation::Vertex::Parameters &para
         if (!m_canMakeNewObjects)
             throw StatusCodeException(STATUS_CODE_NOT_ALLOWED);
 
+        if (!this->IsWithinObjectBudget(1))
+            throw StatusCodeException(STATUS_CODE_BUDGET_EXCEEDED);
+
         NameToListMap::iterator iter = m_nameToListMap.find(m_currentListName);
 
         if (m_nameToListMap.end() == iter)
              throw StatusCodeException(STATUS_CODE_NOT_INITIALIZED);
 
-        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, factory.Create(parameters, pVertex));
+        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, factory.CreateObject(parameters, pVertex));
 
         if (!pVertex)
              throw StatusCodeException(STATUS_CODE_FAILURE);
 
-        iter->second->push_back(pVertex);
+        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->AddObjectToList(iter->second, pVertex));
+        this->AssignIndex(pVertex);
         return STATUS_CODE_SUCCESS;
     }
     catch (StatusCodeException &statusCodeException)
@@ -105,4 +111,69 @@ void VertexManager::SetAvailability(const VertexList *const pVertexList, bool is
         this->SetAvailability(pVertex, isAvailable);
 }
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode VertexManager::GetListSpatialIndex(const std::string &listName, const VertexSpatialIndex *&pVertexSpatialIndex)
+{
+    NameToListMap::const_iterator iter = m_nameToListMap.find(listName);
+
+    if (m_nameToListMap.end() == iter)
+        return STATUS_CODE_NOT_INITIALIZED;
+
+    m_listSpatialIndex.Fill(*iter->second);
+    pVertexSpatialIndex = &m_listSpatialIndex;
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode VertexManager::GetDuplicateVertices(const std::string &listName, const float mergeDistance, VertexList &duplicateVertexList)
+{
+    if (mergeDistance < 0.f)
+        return STATUS_CODE_INVALID_PARAMETER;
+
+    const VertexSpatialIndex *pVertexSpatialIndex(nullptr);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetListSpatialIndex(listName, pVertexSpatialIndex));
+
+    std::unordered_set<const Vertex *> retainedVertices, duplicateVertices;
+    VertexSpatialIndex::ObjectVector nearbyVertices;
+
+    for (const Vertex *const pVertex : *m_nameToListMap.at(listName))
+    {
+        if (!pVertex->IsAvailable() || duplicateVertices.count(pVertex))
+            continue;
+
+        (void) retainedVertices.insert(pVertex);
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, pVertexSpatialIndex->FindWithinRadius(pVertex->GetPosition(), mergeDistance, nearbyVertices));
+
+        // ATTN Nearby vertices are returned in list order, so earlier vertices have already been retained or absorbed
+        for (const Vertex *const pNearbyVertex : nearbyVertices)
+        {
+            if (!pNearbyVertex->IsAvailable() || retainedVertices.count(pNearbyVertex) || !duplicateVertices.insert(pNearbyVertex).second)
+                continue;
+
+            duplicateVertexList.push_back(pNearbyVertex);
+        }
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool VertexManager::IsInInitialState() const
+{
+    return ((0 == m_listSpatialIndex.size()) && AlgorithmObjectManager<Vertex>::IsInInitialState());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode VertexManager::EraseAllContent()
+{
+    m_listSpatialIndex.Clear();
+
+    return AlgorithmObjectManager<Vertex>::EraseAllContent();
+}
+
 } // namespace pandora
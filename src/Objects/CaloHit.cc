@@ -6,9 +6,21 @@
  *  $Log: $
  */
 
+#include "Helpers/MCParticleHelper.h"
+#include "Helpers/SortingHelper.h"
+
 #include "Objects/CaloHit.h"
 
+#include "Pandora/ObjectPool.h"
+
 #include <cmath>
+#include <limits>
+
+#ifdef PANDORA_COMPACT_CALO_HITS
+#include <functional>
+#include <mutex>
+#include <unordered_set>
+#endif
 
 namespace pandora
 {
@@ -50,32 +62,46 @@ bool CaloHit::operator< (const CaloHit &rhs) const
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 CaloHit::CaloHit(const object_creation::CaloHit::Parameters &parameters) :
-    m_positionVector(parameters.m_positionVector.Get()),
+    m_positionVector(parameters.m_positionVector.GetUnchecked()),
     m_x0(0.f),
-    m_expectedDirection(parameters.m_expectedDirection.Get().GetUnitVector()),
-    m_cellNormalVector(parameters.m_cellNormalVector.Get().GetUnitVector()),
-    m_cellGeometry(parameters.m_cellGeometry.Get()),
-    m_cellSize0(parameters.m_cellSize0.Get()),
-    m_cellSize1(parameters.m_cellSize1.Get()),
-    m_cellThickness(parameters.m_cellThickness.Get()),
-    m_nCellRadiationLengths(parameters.m_nCellRadiationLengths.Get()),
-    m_nCellInteractionLengths(parameters.m_nCellInteractionLengths.Get()),
-    m_time(parameters.m_time.Get()),
-    m_inputEnergy(parameters.m_inputEnergy.Get()),
-    m_mipEquivalentEnergy(parameters.m_mipEquivalentEnergy.Get()),
-    m_electromagneticEnergy(parameters.m_electromagneticEnergy.Get()),
-    m_hadronicEnergy(parameters.m_hadronicEnergy.Get()),
-    m_isDigital(parameters.m_isDigital.Get()),
-    m_hitType(parameters.m_hitType.Get()),
-    m_hitRegion(parameters.m_hitRegion.Get()),
-    m_layer(parameters.m_layer.Get()),
-    m_isInOuterSamplingLayer(parameters.m_isInOuterSamplingLayer.Get()),
+#ifdef PANDORA_COMPACT_CALO_HITS
+    m_pCellProperties(CaloHit::GetSharedCellProperties(parameters)),
+#else
+    m_expectedDirection(parameters.m_expectedDirection.GetUnchecked().GetUnitVector()),
+    m_cellNormalVector(parameters.m_cellNormalVector.GetUnchecked().GetUnitVector()),
+    m_cellGeometry(parameters.m_cellGeometry.GetUnchecked()),
+#endif
+    m_cellSize0(parameters.m_cellSize0.GetUnchecked()),
+    m_cellSize1(parameters.m_cellSize1.GetUnchecked()),
+    m_cellThickness(parameters.m_cellThickness.GetUnchecked()),
+#ifndef PANDORA_COMPACT_CALO_HITS
+    m_nCellRadiationLengths(parameters.m_nCellRadiationLengths.GetUnchecked()),
+    m_nCellInteractionLengths(parameters.m_nCellInteractionLengths.GetUnchecked()),
+#endif
+    m_time(parameters.m_time.GetUnchecked()),
+    m_inputEnergy(parameters.m_inputEnergy.GetUnchecked()),
+    m_mipEquivalentEnergy(parameters.m_mipEquivalentEnergy.GetUnchecked()),
+    m_electromagneticEnergy(parameters.m_electromagneticEnergy.GetUnchecked()),
+    m_hadronicEnergy(parameters.m_hadronicEnergy.GetUnchecked()),
+    m_isDigital(parameters.m_isDigital.GetUnchecked()),
+    m_hitType(parameters.m_hitType.GetUnchecked()),
+    m_hitRegion(parameters.m_hitRegion.GetUnchecked()),
+    m_layer(parameters.m_layer.GetUnchecked()),
+#ifndef PANDORA_COMPACT_CALO_HITS
+    m_isInOuterSamplingLayer(parameters.m_isInOuterSamplingLayer.GetUnchecked()),
+#endif
     m_cellLengthScale(0.f),
     m_isPossibleMip(false),
     m_isIsolated(false),
     m_isAvailable(true),
+    m_index(std::numeric_limits<unsigned int>::max()),
+    m_indexGeneration(0),
     m_weight(1.f),
-    m_pParentAddress(parameters.m_pParentAddress.Get())
+    m_pMCParticleWeightMap(nullptr),
+    m_pMainMCParticle(nullptr),
+    m_pParentAddress(parameters.m_pParentAddress.GetUnchecked()),
+    m_eventId(parameters.m_eventId.IsInitialized() ? parameters.m_eventId.Get() : 0),
+    m_sortKey(SortingHelper::GetPositionSortKey(m_positionVector))
 {
     m_cellLengthScale = this->CalculateCellLengthScale();
 }
@@ -85,14 +111,20 @@ CaloHit::CaloHit(const object_creation::CaloHit::Parameters &parameters) :
 CaloHit::CaloHit(const object_creation::CaloHitFragment::Parameters &parameters) :
     m_positionVector(parameters.m_pOriginalCaloHit->m_positionVector),
     m_x0(parameters.m_pOriginalCaloHit->m_x0),
+#ifdef PANDORA_COMPACT_CALO_HITS
+    m_pCellProperties(parameters.m_pOriginalCaloHit->m_pCellProperties),
+#else
     m_expectedDirection(parameters.m_pOriginalCaloHit->m_expectedDirection),
     m_cellNormalVector(parameters.m_pOriginalCaloHit->m_cellNormalVector),
     m_cellGeometry(parameters.m_pOriginalCaloHit->m_cellGeometry),
+#endif
     m_cellSize0(parameters.m_pOriginalCaloHit->m_cellSize0),
     m_cellSize1(parameters.m_pOriginalCaloHit->m_cellSize1),
     m_cellThickness(parameters.m_pOriginalCaloHit->m_cellThickness),
+#ifndef PANDORA_COMPACT_CALO_HITS
     m_nCellRadiationLengths(parameters.m_pOriginalCaloHit->m_nCellRadiationLengths),
     m_nCellInteractionLengths(parameters.m_pOriginalCaloHit->m_nCellInteractionLengths),
+#endif
     m_time(parameters.m_pOriginalCaloHit->m_time),
     m_inputEnergy(parameters.m_weight.Get() * parameters.m_pOriginalCaloHit->m_inputEnergy),
     m_mipEquivalentEnergy(parameters.m_weight.Get() * parameters.m_pOriginalCaloHit->m_mipEquivalentEnergy),
@@ -103,23 +135,39 @@ CaloHit::CaloHit(const object_creation::CaloHitFragment::Parameters &parameters)
     m_hitRegion(parameters.m_pOriginalCaloHit->m_hitRegion),
     m_layer(parameters.m_pOriginalCaloHit->m_layer),
     m_pseudoLayer(parameters.m_pOriginalCaloHit->m_pseudoLayer),
+#ifndef PANDORA_COMPACT_CALO_HITS
     m_isInOuterSamplingLayer(parameters.m_pOriginalCaloHit->m_isInOuterSamplingLayer),
+#endif
     m_cellLengthScale(parameters.m_pOriginalCaloHit->m_cellLengthScale),
     m_isPossibleMip(parameters.m_pOriginalCaloHit->m_isPossibleMip),
     m_isIsolated(parameters.m_pOriginalCaloHit->m_isIsolated),
     m_isAvailable(parameters.m_pOriginalCaloHit->m_isAvailable),
+    m_index(std::numeric_limits<unsigned int>::max()),
+    m_indexGeneration(0),
     m_weight(parameters.m_weight.Get() * parameters.m_pOriginalCaloHit->m_weight),
-    m_mcParticleWeightMap(parameters.m_pOriginalCaloHit->m_mcParticleWeightMap),
-    m_pParentAddress(parameters.m_pOriginalCaloHit->m_pParentAddress)
+    m_pMCParticleWeightMap(nullptr),
+    m_pMainMCParticle(nullptr),
+    m_pParentAddress(parameters.m_pOriginalCaloHit->m_pParentAddress),
+    m_eventId(parameters.m_pOriginalCaloHit->m_eventId),
+    m_sortKey(parameters.m_pOriginalCaloHit->m_sortKey)
 {
-    for (MCParticleWeightMap::value_type &mapEntry : m_mcParticleWeightMap)
+    if (!parameters.m_pOriginalCaloHit->m_pMCParticleWeightMap)
+        return;
+
+    m_pMCParticleWeightMap = CaloHit::CreateMCParticleWeightMap();
+    *m_pMCParticleWeightMap = *parameters.m_pOriginalCaloHit->m_pMCParticleWeightMap;
+
+    for (MCParticleWeightMap::value_type &mapEntry : *m_pMCParticleWeightMap)
         mapEntry.second = mapEntry.second * parameters.m_weight.Get();
+
+    m_pMainMCParticle = MCParticleHelper::FindMainMCParticle(*m_pMCParticleWeightMap);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 CaloHit::~CaloHit()
 {
+    CaloHit::DeleteMCParticleWeightMap(m_pMCParticleWeightMap);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -156,14 +204,26 @@ StatusCode CaloHit::SetPseudoLayer(const unsigned int pseudoLayer)
 
 void CaloHit::SetMCParticleWeightMap(const MCParticleWeightMap &mcParticleWeightMap)
 {
-    m_mcParticleWeightMap = mcParticleWeightMap;
+    if (mcParticleWeightMap.empty())
+    {
+        this->RemoveMCParticles();
+        return;
+    }
+
+    if (!m_pMCParticleWeightMap)
+        m_pMCParticleWeightMap = CaloHit::CreateMCParticleWeightMap();
+
+    *m_pMCParticleWeightMap = mcParticleWeightMap;
+    m_pMainMCParticle = MCParticleHelper::FindMainMCParticle(*m_pMCParticleWeightMap);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 void CaloHit::RemoveMCParticles()
 {
-    m_mcParticleWeightMap.clear();
+    CaloHit::DeleteMCParticleWeightMap(m_pMCParticleWeightMap);
+    m_pMCParticleWeightMap = nullptr;
+    m_pMainMCParticle = nullptr;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -266,4 +326,115 @@ void CaloHit::GetPointingCellCorners(CartesianPointVector &cartesianPointVector)
     cartesianPointVector.push_back(CartesianVector(rMaxAtThetaMin * sinThetaMin * cosPhiMax, rMaxAtThetaMin * sinThetaMin * sinPhiMax, rMaxAtThetaMin * cosThetaMin));
 }
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+MCParticleWeightMap *CaloHit::CreateMCParticleWeightMap()
+{
+#ifdef PANDORA_POOLED_OBJECT_ALLOCATION
+    return new (ObjectPool<MCParticleWeightMap>::Allocate(sizeof(MCParticleWeightMap))) MCParticleWeightMap;
+#else
+    return new MCParticleWeightMap;
+#endif
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void CaloHit::DeleteMCParticleWeightMap(MCParticleWeightMap *const pMCParticleWeightMap)
+{
+#ifdef PANDORA_POOLED_OBJECT_ALLOCATION
+    if (!pMCParticleWeightMap)
+        return;
+
+    pMCParticleWeightMap->~MCParticleWeightMap();
+    ObjectPool<MCParticleWeightMap>::Deallocate(pMCParticleWeightMap, sizeof(MCParticleWeightMap));
+#else
+    delete pMCParticleWeightMap;
+#endif
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef PANDORA_POOLED_OBJECT_ALLOCATION
+void *CaloHit::operator new(std::size_t size)
+{
+    return ObjectPool<CaloHit>::Allocate(size);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void CaloHit::operator delete(void *pAddress, std::size_t size)
+{
+    ObjectPool<CaloHit>::Deallocate(pAddress, size);
+}
+#endif
+
+#ifdef PANDORA_COMPACT_CALO_HITS
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+CaloHit::CellProperties::CellProperties(const object_creation::CaloHit::Parameters &parameters) :
+    m_expectedDirection(parameters.m_expectedDirection.GetUnchecked().GetUnitVector()),
+    m_cellNormalVector(parameters.m_cellNormalVector.GetUnchecked().GetUnitVector()),
+    m_cellGeometry(parameters.m_cellGeometry.GetUnchecked()),
+    m_nCellRadiationLengths(parameters.m_nCellRadiationLengths.GetUnchecked()),
+    m_nCellInteractionLengths(parameters.m_nCellInteractionLengths.GetUnchecked()),
+    m_isInOuterSamplingLayer(parameters.m_isInOuterSamplingLayer.GetUnchecked())
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool CaloHit::CellProperties::operator== (const CellProperties &rhs) const
+{
+    return ((m_expectedDirection.GetX() == rhs.m_expectedDirection.GetX()) && (m_expectedDirection.GetY() == rhs.m_expectedDirection.GetY()) &&
+        (m_expectedDirection.GetZ() == rhs.m_expectedDirection.GetZ()) && (m_cellNormalVector.GetX() == rhs.m_cellNormalVector.GetX()) &&
+        (m_cellNormalVector.GetY() == rhs.m_cellNormalVector.GetY()) && (m_cellNormalVector.GetZ() == rhs.m_cellNormalVector.GetZ()) &&
+        (m_cellGeometry == rhs.m_cellGeometry) && (m_nCellRadiationLengths == rhs.m_nCellRadiationLengths) &&
+        (m_nCellInteractionLengths == rhs.m_nCellInteractionLengths) && (m_isInOuterSamplingLayer == rhs.m_isInOuterSamplingLayer));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+std::size_t CaloHit::CellProperties::GetHash() const
+{
+    const std::hash<float> floatHash;
+    std::size_t hash(std::hash<int>()(static_cast<int>(m_cellGeometry)) ^ (m_isInOuterSamplingLayer ? 1 : 0));
+
+    for (const float value : {m_expectedDirection.GetX(), m_expectedDirection.GetY(), m_expectedDirection.GetZ(), m_cellNormalVector.GetX(),
+        m_cellNormalVector.GetY(), m_cellNormalVector.GetZ(), m_nCellRadiationLengths, m_nCellInteractionLengths})
+    {
+        hash ^= floatHash(value) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    }
+
+    return hash;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+const CaloHit::CellProperties *CaloHit::GetSharedCellProperties(const object_creation::CaloHit::Parameters &parameters)
+{
+    class CellPropertiesHash
+    {
+    public:
+        std::size_t operator()(const CellProperties &cellProperties) const {return cellProperties.GetHash();}
+    };
+
+    typedef std::unordered_set<CellProperties, CellPropertiesHash> CellPropertiesSet;
+
+    // Consecutive hits typically share their cell properties, so check the last match for this thread before taking the lock
+    static thread_local const CellProperties *pLastCellProperties(nullptr);
+    const CellProperties cellProperties(parameters);
+
+    if (pLastCellProperties && (*pLastCellProperties == cellProperties))
+        return pLastCellProperties;
+
+    static CellPropertiesSet cellPropertiesSet;
+    static std::mutex cellPropertiesMutex;
+
+    const std::lock_guard<std::mutex> lock(cellPropertiesMutex);
+    pLastCellProperties = &(*cellPropertiesSet.insert(cellProperties).first);
+
+    return pLastCellProperties;
+}
+#endif
+
 } // namespace pandora
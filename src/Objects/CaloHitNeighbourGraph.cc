@@ -0,0 +1,167 @@
+/**
+ *  @file   PandoraSDK/src/Objects/CaloHitNeighbourGraph.cc
+ *
+ *  @brief  Implementation of the calo hit neighbour graph class.
+ *
+ *  $Log: $
+ */
+
+#include "Objects/CaloHit.h"
+#include "Objects/CaloHitNeighbourGraph.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace pandora
+{
+
+CaloHitNeighbourGraph::CaloHitNeighbourGraph() :
+    m_nCaloHits(0),
+    m_maxDistance(0.f),
+    m_layerWindow(0)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode CaloHitNeighbourGraph::GetNeighbours(const CaloHit *const pCaloHit, CaloHitVector &caloHitVector) const
+{
+    const unsigned int index(pCaloHit->m_index);
+
+    if ((index >= m_beginIndices.size()) || (std::numeric_limits<unsigned int>::max() == m_beginIndices[index]))
+        return STATUS_CODE_NOT_FOUND;
+
+    caloHitVector.insert(caloHitVector.end(), m_neighbourVector.begin() + m_beginIndices[index], m_neighbourVector.begin() + m_endIndices[index]);
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode CaloHitNeighbourGraph::Fill(const CaloHitList &caloHitList, const float maxDistance, const unsigned int layerWindow)
+{
+    this->Clear();
+
+    if (!(maxDistance > 0.f) || !std::isfinite(maxDistance))
+        return STATUS_CODE_INVALID_PARAMETER;
+
+    const CaloHitVector caloHitVector(caloHitList.begin(), caloHitList.end());
+    const float inverseCellSize(1.f / maxDistance), maxDistanceSquared(maxDistance * maxDistance);
+
+    // ATTN Cell coordinates are limited so that neighbouring cell coordinates cannot overflow
+    const float maxCellCoordinate(static_cast<float>(std::numeric_limits<int>::max() / 2));
+
+    GridEntryVector gridEntryVector;
+    gridEntryVector.reserve(caloHitVector.size());
+    unsigned int nIndices(0);
+
+    for (unsigned int listIndex = 0; listIndex < caloHitVector.size(); ++listIndex)
+    {
+        const CaloHit *const pCaloHit(caloHitVector[listIndex]);
+        const CartesianVector &positionVector(pCaloHit->GetPositionVector());
+        const float coordinates[3] = {positionVector.GetX(), positionVector.GetY(), positionVector.GetZ()};
+
+        GridEntry gridEntry;
+        gridEntry.m_pseudoLayer = pCaloHit->GetPseudoLayer();
+        gridEntry.m_listIndex = listIndex;
+
+        for (unsigned int axis = 0; axis < 3; ++axis)
+        {
+            const float cellCoordinate(std::floor(coordinates[axis] * inverseCellSize));
+
+            if (!(std::fabs(cellCoordinate) < maxCellCoordinate))
+                return STATUS_CODE_INVALID_PARAMETER;
+
+            gridEntry.m_cell[axis] = static_cast<int>(cellCoordinate);
+        }
+
+        if (std::numeric_limits<unsigned int>::max() == pCaloHit->m_index)
+            return STATUS_CODE_FAILURE;
+
+        nIndices = std::max(nIndices, pCaloHit->m_index + 1);
+        gridEntryVector.push_back(gridEntry);
+    }
+
+    GridEntryVector sortedGridEntryVector(gridEntryVector);
+    std::sort(sortedGridEntryVector.begin(), sortedGridEntryVector.end());
+
+    m_beginIndices.assign(nIndices, std::numeric_limits<unsigned int>::max());
+    m_endIndices.assign(nIndices, std::numeric_limits<unsigned int>::max());
+
+    UIntVector neighbourListIndices;
+
+    for (const GridEntry &gridEntry : gridEntryVector)
+    {
+        const CartesianVector &positionVector(caloHitVector[gridEntry.m_listIndex]->GetPositionVector());
+        const unsigned int firstPseudoLayer((gridEntry.m_pseudoLayer > layerWindow) ? gridEntry.m_pseudoLayer - layerWindow : 0);
+        neighbourListIndices.clear();
+
+        for (unsigned int pseudoLayer = firstPseudoLayer; ; ++pseudoLayer)
+        {
+            for (int dx = -1; dx <= 1; ++dx)
+            {
+                for (int dy = -1; dy <= 1; ++dy)
+                {
+                    for (int dz = -1; dz <= 1; ++dz)
+                    {
+                        GridEntry cellEntry;
+                        cellEntry.m_pseudoLayer = pseudoLayer;
+                        cellEntry.m_cell[0] = gridEntry.m_cell[0] + dx;
+                        cellEntry.m_cell[1] = gridEntry.m_cell[1] + dy;
+                        cellEntry.m_cell[2] = gridEntry.m_cell[2] + dz;
+                        cellEntry.m_listIndex = 0;
+
+                        for (GridEntryVector::const_iterator iter = std::lower_bound(sortedGridEntryVector.begin(), sortedGridEntryVector.end(),
+                            cellEntry); iter != sortedGridEntryVector.end(); ++iter)
+                        {
+                            if ((iter->m_pseudoLayer != pseudoLayer) || (iter->m_cell[0] != cellEntry.m_cell[0]) ||
+                                (iter->m_cell[1] != cellEntry.m_cell[1]) || (iter->m_cell[2] != cellEntry.m_cell[2]))
+                            {
+                                break;
+                            }
+
+                            if (iter->m_listIndex == gridEntry.m_listIndex)
+                                continue;
+
+                            if ((caloHitVector[iter->m_listIndex]->GetPositionVector() - positionVector).GetMagnitudeSquared() <= maxDistanceSquared)
+                                neighbourListIndices.push_back(iter->m_listIndex);
+                        }
+                    }
+                }
+            }
+
+            if (gridEntry.m_pseudoLayer == pseudoLayer)
+                break;
+        }
+
+        std::sort(neighbourListIndices.begin(), neighbourListIndices.end());
+
+        const unsigned int index(caloHitVector[gridEntry.m_listIndex]->m_index);
+        m_beginIndices[index] = m_neighbourVector.size();
+
+        for (const unsigned int neighbourListIndex : neighbourListIndices)
+            m_neighbourVector.push_back(caloHitVector[neighbourListIndex]);
+
+        m_endIndices[index] = m_neighbourVector.size();
+    }
+
+    m_nCaloHits = caloHitVector.size();
+    m_maxDistance = maxDistance;
+    m_layerWindow = layerWindow;
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void CaloHitNeighbourGraph::Clear()
+{
+    m_neighbourVector.clear();
+    m_beginIndices.clear();
+    m_endIndices.clear();
+    m_nCaloHits = 0;
+    m_maxDistance = 0.f;
+    m_layerWindow = 0;
+}
+
+} // namespace pandora
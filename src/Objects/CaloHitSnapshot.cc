@@ -0,0 +1,67 @@
+/**
+ *  @file   PandoraSDK/src/Objects/CaloHitSnapshot.cc
+ *
+ *  @brief  Implementation of the calo hit snapshot class.
+ *
+ *  $Log: $
+ */
+
+#include "Objects/CaloHit.h"
+#include "Objects/CaloHitSnapshot.h"
+
+namespace pandora
+{
+
+CaloHitSnapshot::CaloHitSnapshot()
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void CaloHitSnapshot::Fill(const CaloHitList &caloHitList)
+{
+    this->Clear();
+
+    const unsigned int nCaloHits(caloHitList.size());
+    m_caloHitVector.reserve(nCaloHits);
+    m_x.reserve(nCaloHits);
+    m_y.reserve(nCaloHits);
+    m_z.reserve(nCaloHits);
+    m_inputEnergy.reserve(nCaloHits);
+    m_electromagneticEnergy.reserve(nCaloHits);
+    m_hadronicEnergy.reserve(nCaloHits);
+    m_pseudoLayer.reserve(nCaloHits);
+    m_hitType.reserve(nCaloHits);
+
+    for (const CaloHit *const pCaloHit : caloHitList)
+    {
+        const CartesianVector &positionVector(pCaloHit->GetPositionVector());
+
+        m_caloHitVector.push_back(pCaloHit);
+        m_x.push_back(positionVector.GetX());
+        m_y.push_back(positionVector.GetY());
+        m_z.push_back(positionVector.GetZ());
+        m_inputEnergy.push_back(pCaloHit->GetInputEnergy());
+        m_electromagneticEnergy.push_back(pCaloHit->GetElectromagneticEnergy());
+        m_hadronicEnergy.push_back(pCaloHit->GetHadronicEnergy());
+        m_pseudoLayer.push_back(pCaloHit->GetPseudoLayer());
+        m_hitType.push_back(pCaloHit->GetHitType());
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void CaloHitSnapshot::Clear()
+{
+    m_caloHitVector.clear();
+    m_x.clear();
+    m_y.clear();
+    m_z.clear();
+    m_inputEnergy.clear();
+    m_electromagneticEnergy.clear();
+    m_hadronicEnergy.clear();
+    m_pseudoLayer.clear();
+    m_hitType.clear();
+}
+
+} // namespace pandora
@@ -0,0 +1,70 @@
+/**
+ *  @file   PandoraSDK/src/Objects/CaloHitTimeIndex.cc
+ *
+ *  @brief  Implementation of the calo hit time index class.
+ *
+ *  $Log: $
+ */
+
+#include "Objects/CaloHit.h"
+#include "Objects/CaloHitTimeIndex.h"
+
+#include <algorithm>
+
+namespace pandora
+{
+
+CaloHitTimeIndex::CaloHitTimeIndex()
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+CaloHitSpan CaloHitTimeIndex::GetSpan(const float minTime, const float maxTime) const
+{
+    if (!(maxTime > minTime))
+        return CaloHitSpan(m_caloHitVector.end(), m_caloHitVector.end());
+
+    const FloatVector::const_iterator firstIter(std::lower_bound(m_time.begin(), m_time.end(), minTime));
+    const FloatVector::const_iterator endIter(std::lower_bound(firstIter, m_time.end(), maxTime));
+
+    return CaloHitSpan(m_caloHitVector.begin() + (firstIter - m_time.begin()), m_caloHitVector.begin() + (endIter - m_time.begin()));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void CaloHitTimeIndex::Fill(const CaloHitList &caloHitList)
+{
+    this->Clear();
+
+    const CaloHitVector inputCaloHitVector(caloHitList.begin(), caloHitList.end());
+    const unsigned int nCaloHits(inputCaloHitVector.size());
+
+    // ATTN Sorting on (time, list position) gives a strict, reproducible ordering, which keeps equal-time hits in list order
+    TimeAndPositionVector timeAndPositionVector;
+    timeAndPositionVector.reserve(nCaloHits);
+
+    for (unsigned int position = 0; position < nCaloHits; ++position)
+        timeAndPositionVector.push_back(TimeAndPosition(inputCaloHitVector[position]->GetTime(), position));
+
+    std::sort(timeAndPositionVector.begin(), timeAndPositionVector.end());
+
+    m_caloHitVector.reserve(nCaloHits);
+    m_time.reserve(nCaloHits);
+
+    for (const TimeAndPosition &timeAndPosition : timeAndPositionVector)
+    {
+        m_caloHitVector.push_back(inputCaloHitVector[timeAndPosition.second]);
+        m_time.push_back(timeAndPosition.first);
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void CaloHitTimeIndex::Clear()
+{
+    m_caloHitVector.clear();
+    m_time.clear();
+}
+
+} // namespace pandora
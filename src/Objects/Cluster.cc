@@ -12,6 +12,7 @@
 #include "Objects/Cluster.h"
 #include "Objects/Track.h"
 
+#include "Pandora/ObjectPool.h"
 #include "Pandora/Pandora.h"
 #include "Pandora/PdgTable.h"
 
@@ -20,6 +21,7 @@
 #include "Plugins/ShowerProfilePlugin.h"
 
 #include <algorithm>
+#include <limits>
 
 namespace pandora
 {
@@ -34,28 +36,63 @@ const Track *Cluster::GetTrackSeed() const
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+StatusCode Cluster::GetTrackSeed(const Track *&pTrackSeed) const
+{
+    if (!m_pTrackSeed)
+        return STATUS_CODE_NOT_INITIALIZED;
+
+    pTrackSeed = m_pTrackSeed;
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 const CartesianVector Cluster::GetCentroid(const unsigned int pseudoLayer) const
 {
-    PointByPseudoLayerMap::const_iterator pointValueIter = m_sumXYZByPseudoLayer.find(pseudoLayer);
+    CartesianVector centroid(0.f, 0.f, 0.f);
+    const StatusCode statusCode(this->GetCentroid(pseudoLayer, centroid));
 
-    if (m_sumXYZByPseudoLayer.end() == pointValueIter)
-        throw StatusCodeException(STATUS_CODE_FAILURE);
+    if (STATUS_CODE_SUCCESS != statusCode)
+        throw StatusCodeException(statusCode);
 
-    const SimplePoint &mypoint = pointValueIter->second;
+    return centroid;
+}
 
-    if (0 == mypoint.m_nHits)
-        throw StatusCodeException(STATUS_CODE_FAILURE);
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode Cluster::GetCentroid(const unsigned int pseudoLayer, CartesianVector &centroid) const
+{
+    const SimplePoint *const pPoint(this->GetPoint(pseudoLayer));
+
+    if (!pPoint)
+        return STATUS_CODE_FAILURE;
 
-    return CartesianVector(static_cast<float>(mypoint.m_xyzPositionSums[0] / static_cast<float>(mypoint.m_nHits)),
+    const SimplePoint &mypoint = *pPoint;
+
+    centroid.SetValues(static_cast<float>(mypoint.m_xyzPositionSums[0] / static_cast<float>(mypoint.m_nHits)),
         static_cast<float>(mypoint.m_xyzPositionSums[1] / static_cast<float>(mypoint.m_nHits)),
         static_cast<float>(mypoint.m_xyzPositionSums[2] / static_cast<float>(mypoint.m_nHits)));
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+const ClusterFitAccumulator &Cluster::GetFitAccumulator(const unsigned int pseudoLayer) const
+{
+    const SimplePoint *const pPoint(this->GetPoint(pseudoLayer));
+
+    if (!pPoint)
+        throw StatusCodeException(STATUS_CODE_FAILURE);
+
+    return pPoint->m_fitAccumulator;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 const CartesianVector &Cluster::GetInitialDirection() const
 {
-    if (!m_isDirectionUpToDate)
+    if (!(m_cachedProperties & CACHED_INITIAL_DIRECTION))
         this->UpdateInitialDirectionCache();
 
     return m_initialDirection;
@@ -65,7 +102,7 @@ const CartesianVector &Cluster::GetInitialDirection() const
 
 const ClusterFitResult &Cluster::GetFitToAllHitsResult() const
 {
-    if (!m_isFitUpToDate)
+    if (!(m_cachedProperties & CACHED_FIT_TO_ALL_HITS))
         this->UpdateFitToAllHitsCache();
 
     return m_fitToAllHitsResult;
@@ -75,50 +112,50 @@ const ClusterFitResult &Cluster::GetFitToAllHitsResult() const
 
 HitType Cluster::GetInnerLayerHitType() const
 {
-    if (!m_innerLayerHitType.IsInitialized())
-        this->UpdateLayerHitTypeCache(m_innerPseudoLayer.Get(), m_innerLayerHitType);
+    if (!(m_cachedProperties & CACHED_INNER_LAYER_HIT_TYPE))
+        this->UpdateLayerHitTypeCache(m_innerPseudoLayer.Get(), CACHED_INNER_LAYER_HIT_TYPE, m_innerLayerHitType);
 
-    return m_innerLayerHitType.Get();
+    return m_innerLayerHitType;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 HitType Cluster::GetOuterLayerHitType() const
 {
-    if (!m_outerLayerHitType.IsInitialized())
-        this->UpdateLayerHitTypeCache(m_outerPseudoLayer.Get(), m_outerLayerHitType);
+    if (!(m_cachedProperties & CACHED_OUTER_LAYER_HIT_TYPE))
+        this->UpdateLayerHitTypeCache(m_outerPseudoLayer.Get(), CACHED_OUTER_LAYER_HIT_TYPE, m_outerLayerHitType);
 
-    return m_outerLayerHitType.Get();
+    return m_outerLayerHitType;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 float Cluster::GetCorrectedElectromagneticEnergy(const Pandora &pandora) const
 {
-    if (!m_correctedElectromagneticEnergy.IsInitialized())
+    if (!(m_cachedProperties & CACHED_ENERGY_CORRECTIONS))
         this->UpdateEnergyCorrectionsCache(pandora);
 
-    return m_correctedElectromagneticEnergy.Get();
+    return m_correctedElectromagneticEnergy;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 float Cluster::GetCorrectedHadronicEnergy(const Pandora &pandora) const
 {
-    if (!m_correctedHadronicEnergy.IsInitialized())
+    if (!(m_cachedProperties & CACHED_ENERGY_CORRECTIONS))
         this->UpdateEnergyCorrectionsCache(pandora);
 
-    return m_correctedHadronicEnergy.Get();
+    return m_correctedHadronicEnergy;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 float Cluster::GetTrackComparisonEnergy(const Pandora &pandora) const
 {
-    if (!m_trackComparisonEnergy.IsInitialized())
+    if (!(m_cachedProperties & CACHED_ENERGY_CORRECTIONS))
         this->UpdateEnergyCorrectionsCache(pandora);
 
-    return m_trackComparisonEnergy.Get();
+    return m_trackComparisonEnergy;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -128,77 +165,80 @@ bool Cluster::PassPhotonId(const Pandora &pandora) const
     if (PHOTON == m_particleId)
         return true;
 
-    if (!m_passPhotonId.IsInitialized())
+    if (!(m_cachedProperties & CACHED_PHOTON_ID))
         this->UpdatePhotonIdCache(pandora);
 
-    return m_passPhotonId.Get();
+    return m_passPhotonId;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 unsigned int Cluster::GetShowerStartLayer(const Pandora &pandora) const
 {
-    if (!m_showerStartLayer.IsInitialized())
+    if (!(m_cachedProperties & CACHED_SHOWER_START_LAYER))
         this->UpdateShowerLayerCache(pandora);
 
-    return m_showerStartLayer.Get();
+    return m_showerStartLayer;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 float Cluster::GetShowerProfileStart(const Pandora &pandora) const
 {
-    if (!m_showerProfileStart.IsInitialized())
+    if (!(m_cachedProperties & CACHED_SHOWER_PROFILE))
         this->UpdateShowerProfileCache(pandora);
 
-    return m_showerProfileStart.Get();
+    return m_showerProfileStart;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 float Cluster::GetShowerProfileDiscrepancy(const Pandora &pandora) const
 {
-    if (!m_showerProfileDiscrepancy.IsInitialized())
+    if (!(m_cachedProperties & CACHED_SHOWER_PROFILE))
         this->UpdateShowerProfileCache(pandora);
 
-    return m_showerProfileDiscrepancy.Get();
+    return m_showerProfileDiscrepancy;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 void Cluster::GetClusterSpanX(float &xmin, float &xmax) const
 {
-    if (m_xMin.IsInitialized() && m_xMax.IsInitialized())
-    {
-        xmin = m_xMin.Get();
-        xmax = m_xMax.Get();
-    }
-    else
-    {
-        xmin = std::numeric_limits<float>::max();
-        xmax = -std::numeric_limits<float>::max();
+    if (!(m_cachedProperties & CACHED_BOUNDING_BOX))
+        this->UpdateBoundingBoxCache();
 
-        for (OrderedCaloHitList::const_iterator ochIter = m_orderedCaloHitList.begin();  ochIter != m_orderedCaloHitList.end(); ++ochIter)
-        {
-            for (CaloHitList::const_iterator hIter = ochIter->second->begin(); hIter != ochIter->second->end(); ++hIter)
-            {
-                const CaloHit *const pCaloHit = *hIter;
-                const CartesianVector &hit(pCaloHit->GetPositionVector());
-                xmin = std::min(hit.GetX(), xmin);
-                xmax = std::max(hit.GetX(), xmax);
-            }
-        }
-        m_xMin.Set(xmin);
-        m_xMax.Set(xmax);
-    }
+    xmin = m_boundingBoxMin.GetX();
+    xmax = m_boundingBoxMax.GetX();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void Cluster::GetClusterBoundingBox(CartesianVector &minimum, CartesianVector &maximum) const
+{
+    if (!(m_cachedProperties & CACHED_BOUNDING_BOX))
+        this->UpdateBoundingBoxCache();
+
+    minimum = m_boundingBoxMin;
+    maximum = m_boundingBoxMax;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 void Cluster::GetClusterSpanZ(const float xmin, const float xmax, float &zmin, float &zmax) const
+{
+    const StatusCode statusCode(this->CalculateClusterSpanZ(xmin, xmax, zmin, zmax));
+
+    if (STATUS_CODE_SUCCESS != statusCode)
+        throw StatusCodeException(statusCode);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode Cluster::CalculateClusterSpanZ(const float xmin, const float xmax, float &zmin, float &zmax) const
 {
     if (xmin > xmax)
-        throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
+        return STATUS_CODE_INVALID_PARAMETER;
 
     const OrderedCaloHitList &orderedCaloHitList(this->GetOrderedCaloHitList());
 
@@ -209,6 +249,28 @@ void Cluster::GetClusterSpanZ(const float xmin, const float xmax, float &zmin, f
 
     for (OrderedCaloHitList::const_iterator ochIter = orderedCaloHitList.begin(), ochIterEnd = orderedCaloHitList.end(); ochIter != ochIterEnd; ++ochIter)
     {
+        // Use the pseudo layer hit position extent to skip, or accept wholesale, the hits in this layer where possible
+        const SimplePoint *const pLayerPoint(this->GetPoint(ochIter->first));
+
+        if (!pLayerPoint)
+            throw StatusCodeException(STATUS_CODE_FAILURE);
+
+        const SimplePoint &layerPoint(*pLayerPoint);
+
+        if (!layerPoint.m_isExtentUpToDate)
+            layerPoint.UpdateExtent(*ochIter->second);
+
+        if ((layerPoint.m_xyzMax[0] < xmin) || (layerPoint.m_xyzMin[0] > xmax))
+            continue;
+
+        if ((layerPoint.m_xyzMin[0] >= xmin) && (layerPoint.m_xyzMax[0] <= xmax))
+        {
+            zmin = std::min(layerPoint.m_xyzMin[2], zmin);
+            zmax = std::max(layerPoint.m_xyzMax[2], zmax);
+            foundHits = true;
+            continue;
+        }
+
         for (CaloHitList::const_iterator hIter = ochIter->second->begin(), hIterEnd = ochIter->second->end(); hIter != hIterEnd; ++hIter)
         {
             const CaloHit *const pCaloHit = *hIter;
@@ -223,8 +285,7 @@ void Cluster::GetClusterSpanZ(const float xmin, const float xmax, float &zmin, f
         }
     }
 
-    if (!foundHits)
-        throw StatusCodeException(STATUS_CODE_NOT_FOUND);
+    return (foundHits ? STATUS_CODE_SUCCESS : STATUS_CODE_NOT_FOUND);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -239,25 +300,47 @@ Cluster::Cluster(const object_creation::Cluster::Parameters &parameters) :
     m_isolatedHadronicEnergy(0),
     m_particleId(UNKNOWN_PARTICLE_TYPE),
     m_pTrackSeed(parameters.m_pTrack.IsInitialized() ? parameters.m_pTrack.Get() : nullptr),
+    m_firstPointPseudoLayer(0),
+    m_cachedProperties(0),
     m_initialDirection(0.f, 0.f, 0.f),
-    m_isDirectionUpToDate(false),
-    m_isFitUpToDate(false),
-    m_isAvailable(true)
+    m_boundingBoxMin(0.f, 0.f, 0.f),
+    m_boundingBoxMax(0.f, 0.f, 0.f),
+    m_correctedElectromagneticEnergy(0.f),
+    m_correctedHadronicEnergy(0.f),
+    m_trackComparisonEnergy(0.f),
+    m_showerProfileStart(0.f),
+    m_showerProfileDiscrepancy(0.f),
+    m_showerStartLayer(0),
+    m_innerLayerHitType(HIT_CUSTOM),
+    m_outerLayerHitType(HIT_CUSTOM),
+    m_passPhotonId(false),
+    m_isAvailable(true),
+    m_modificationEpoch(0),
+    m_eventId(0),
+    m_index(std::numeric_limits<unsigned int>::max()),
+    m_indexGeneration(0)
 {
     if (parameters.m_caloHitList.empty() && parameters.m_isolatedCaloHitList.empty() && !parameters.m_pTrack.IsInitialized())
         throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
 
     if (parameters.m_pTrack.IsInitialized())
     {
-        m_initialDirection = parameters.m_pTrack.Get()->GetTrackStateAtCalorimeter().GetMomentum().GetUnitVector();
-        m_isDirectionUpToDate = true;
+        m_eventId = parameters.m_pTrack.Get()->GetEventId();
+    }
+    else
+    {
+        m_eventId = (!parameters.m_caloHitList.empty() ? (*parameters.m_caloHitList.begin())->GetEventId() :
+            (*parameters.m_isolatedCaloHitList.begin())->GetEventId());
     }
 
-    for (const CaloHit *const pCaloHit : parameters.m_caloHitList)
+    if (parameters.m_pTrack.IsInitialized())
     {
-        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->AddCaloHit(pCaloHit));
+        m_initialDirection = parameters.m_pTrack.Get()->GetTrackStateAtCalorimeter().GetMomentum().GetUnitVector();
+        m_cachedProperties |= CACHED_INITIAL_DIRECTION;
     }
 
+    PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->AddCaloHits(parameters.m_caloHitList));
+
     for (const CaloHit *const pCaloHit : parameters.m_isolatedCaloHitList)
     {
         PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->AddIsolatedCaloHit(pCaloHit));
@@ -276,7 +359,8 @@ StatusCode Cluster::AlterMetadata(const object_creation::Cluster::Metadata &meta
 {
     if (metadata.m_particleId.IsInitialized())
     {
-        m_passPhotonId.Reset();
+        ++m_modificationEpoch;
+        m_cachedProperties &= ~CACHED_PHOTON_ID;
         m_particleId = metadata.m_particleId.Get();
     }
 
@@ -287,10 +371,45 @@ StatusCode Cluster::AlterMetadata(const object_creation::Cluster::Metadata &meta
 
 StatusCode Cluster::AddCaloHit(const CaloHit *const pCaloHit)
 {
+    if (pCaloHit->GetEventId() != m_eventId)
+        return STATUS_CODE_NOT_ALLOWED;
+
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_orderedCaloHitList.Add(pCaloHit));
 
     this->ResetOutdatedProperties();
+    this->AddCaloHitProperties(pCaloHit);
+
+    return STATUS_CODE_SUCCESS;
+}
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode Cluster::AddCaloHits(const CaloHitList &caloHitList)
+{
+    if (caloHitList.empty())
+        return STATUS_CODE_SUCCESS;
+
+    for (const CaloHit *const pCaloHit : caloHitList)
+    {
+        if (pCaloHit->GetEventId() != m_eventId)
+            return STATUS_CODE_NOT_ALLOWED;
+    }
+
+    this->ResetOutdatedProperties();
+
+    for (const CaloHit *const pCaloHit : caloHitList)
+    {
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_orderedCaloHitList.Add(pCaloHit));
+        this->AddCaloHitProperties(pCaloHit);
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void Cluster::AddCaloHitProperties(const CaloHit *const pCaloHit)
+{
     ++m_nCaloHits;
 
     if (pCaloHit->IsPossibleMip())
@@ -309,21 +428,37 @@ StatusCode Cluster::AddCaloHit(const CaloHit *const pCaloHit)
     const unsigned int pseudoLayer(pCaloHit->GetPseudoLayer());
     OrderedCaloHitList::const_iterator iter = m_orderedCaloHitList.find(pseudoLayer);
 
+    SimplePoint &mypoint = this->GetModifiablePoint(pseudoLayer);
+
     if ((m_orderedCaloHitList.end() != iter) && (iter->second->size() > 1))
     {
-        SimplePoint &mypoint = m_sumXYZByPseudoLayer[pseudoLayer];
         mypoint.m_xyzPositionSums[0] += x;
         mypoint.m_xyzPositionSums[1] += y;
         mypoint.m_xyzPositionSums[2] += z;
         ++mypoint.m_nHits;
+        mypoint.m_fitAccumulator.Add(pCaloHit);
+
+        if (mypoint.m_isExtentUpToDate)
+            mypoint.ExtendExtent(x, y, z);
     }
     else
     {
-        SimplePoint &mypoint = m_sumXYZByPseudoLayer[pseudoLayer];
         mypoint.m_xyzPositionSums[0] = x;
         mypoint.m_xyzPositionSums[1] = y;
         mypoint.m_xyzPositionSums[2] = z;
         mypoint.m_nHits = 1;
+        mypoint.m_fitAccumulator.Reset();
+        mypoint.m_fitAccumulator.Add(pCaloHit);
+        mypoint.m_xyzMin[0] = mypoint.m_xyzMax[0] = x;
+        mypoint.m_xyzMin[1] = mypoint.m_xyzMax[1] = y;
+        mypoint.m_xyzMin[2] = mypoint.m_xyzMax[2] = z;
+        mypoint.m_isExtentUpToDate = true;
+    }
+
+    if (m_cachedProperties & CACHED_BOUNDING_BOX)
+    {
+        m_boundingBoxMin.SetValues(std::min(x, m_boundingBoxMin.GetX()), std::min(y, m_boundingBoxMin.GetY()), std::min(z, m_boundingBoxMin.GetZ()));
+        m_boundingBoxMax.SetValues(std::max(x, m_boundingBoxMax.GetX()), std::max(y, m_boundingBoxMax.GetY()), std::max(z, m_boundingBoxMax.GetZ()));
     }
 
     if (!m_innerPseudoLayer.IsInitialized() || (pseudoLayer < m_innerPseudoLayer.Get()))
@@ -331,12 +466,33 @@ StatusCode Cluster::AddCaloHit(const CaloHit *const pCaloHit)
 
     if (!m_outerPseudoLayer.IsInitialized() || (pseudoLayer > m_outerPseudoLayer.Get()))
         m_outerPseudoLayer = pseudoLayer;
-
-    return STATUS_CODE_SUCCESS;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+Cluster::SimplePoint &Cluster::GetModifiablePoint(const unsigned int pseudoLayer)
+{
+    if (m_sumXYZByPseudoLayer.empty())
+    {
+        m_firstPointPseudoLayer = pseudoLayer;
+        m_sumXYZByPseudoLayer.push_back(SimplePoint());
+    }
+    else if (pseudoLayer < m_firstPointPseudoLayer)
+    {
+        // ATTN Extend towards lower pseudo layers by at least the current array size, so repeated extensions have amortized cost
+        const unsigned int nRequired(m_firstPointPseudoLayer - pseudoLayer);
+        const unsigned int nExtension(std::min(m_firstPointPseudoLayer, std::max(nRequired, static_cast<unsigned int>(m_sumXYZByPseudoLayer.size()))));
+        m_sumXYZByPseudoLayer.insert(m_sumXYZByPseudoLayer.begin(), nExtension, SimplePoint());
+        m_firstPointPseudoLayer -= nExtension;
+    }
+    else if (pseudoLayer - m_firstPointPseudoLayer >= m_sumXYZByPseudoLayer.size())
+    {
+        m_sumXYZByPseudoLayer.resize(pseudoLayer - m_firstPointPseudoLayer + 1, SimplePoint());
+    }
+
+    return m_sumXYZByPseudoLayer[pseudoLayer - m_firstPointPseudoLayer];
+}
+
 StatusCode Cluster::RemoveCaloHit(const CaloHit *const pCaloHit)
 {
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_orderedCaloHitList.Remove(pCaloHit));
@@ -363,17 +519,29 @@ StatusCode Cluster::RemoveCaloHit(const CaloHit *const pCaloHit)
 
     const unsigned int pseudoLayer(pCaloHit->GetPseudoLayer());
 
+    SimplePoint &mypoint = this->GetModifiablePoint(pseudoLayer);
+
     if (m_orderedCaloHitList.end() != m_orderedCaloHitList.find(pseudoLayer))
     {
-        SimplePoint &mypoint = m_sumXYZByPseudoLayer[pseudoLayer];
         mypoint.m_xyzPositionSums[0] -= x;
         mypoint.m_xyzPositionSums[1] -= y;
         mypoint.m_xyzPositionSums[2] -= z;
         --mypoint.m_nHits;
+        mypoint.m_fitAccumulator.Remove(pCaloHit);
+
+        // ATTN Removal of a hit on the boundary of the extent requires lazy recalculation
+        if (mypoint.m_isExtentUpToDate && !mypoint.IsInsideExtent(x, y, z))
+            mypoint.m_isExtentUpToDate = false;
     }
     else
     {
-        m_sumXYZByPseudoLayer.erase(pseudoLayer);
+        mypoint = SimplePoint();
+    }
+
+    if ((m_cachedProperties & CACHED_BOUNDING_BOX) && !((x > m_boundingBoxMin.GetX()) && (x < m_boundingBoxMax.GetX()) && (y > m_boundingBoxMin.GetY()) &&
+        (y < m_boundingBoxMax.GetY()) && (z > m_boundingBoxMin.GetZ()) && (z < m_boundingBoxMax.GetZ())))
+    {
+        m_cachedProperties &= ~CACHED_BOUNDING_BOX;
     }
 
     if (pseudoLayer <= m_innerPseudoLayer.Get())
@@ -389,6 +557,9 @@ StatusCode Cluster::RemoveCaloHit(const CaloHit *const pCaloHit)
 
 StatusCode Cluster::AddIsolatedCaloHit(const CaloHit *const pCaloHit)
 {
+    if (pCaloHit->GetEventId() != m_eventId)
+        return STATUS_CODE_NOT_ALLOWED;
+
     if (m_isolatedCaloHitList.end() != std::find(m_isolatedCaloHitList.begin(), m_isolatedCaloHitList.end(), pCaloHit))
         return STATUS_CODE_ALREADY_PRESENT;
 
@@ -430,8 +601,40 @@ StatusCode Cluster::RemoveIsolatedCaloHit(const CaloHit *const pCaloHit)
 
 void Cluster::UpdateFitToAllHitsCache() const
 {
+    m_fitToAllHitsResult.Reset();
     (void) ClusterFitHelper::FitFullCluster(this, m_fitToAllHitsResult);
-    m_isFitUpToDate = true;
+    m_cachedProperties |= CACHED_FIT_TO_ALL_HITS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void Cluster::UpdateBoundingBoxCache() const
+{
+    float xyzMin[3] = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+    float xyzMax[3] = {-std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max()};
+
+    for (const OrderedCaloHitList::value_type &layerEntry : m_orderedCaloHitList)
+    {
+        const SimplePoint *const pLayerPoint(this->GetPoint(layerEntry.first));
+
+        if (!pLayerPoint)
+            throw StatusCodeException(STATUS_CODE_FAILURE);
+
+        const SimplePoint &layerPoint(*pLayerPoint);
+
+        if (!layerPoint.m_isExtentUpToDate)
+            layerPoint.UpdateExtent(*layerEntry.second);
+
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+            xyzMin[i] = std::min(layerPoint.m_xyzMin[i], xyzMin[i]);
+            xyzMax[i] = std::max(layerPoint.m_xyzMax[i], xyzMax[i]);
+        }
+    }
+
+    m_boundingBoxMin.SetValues(xyzMin[0], xyzMin[1], xyzMin[2]);
+    m_boundingBoxMax.SetValues(xyzMax[0], xyzMax[1], xyzMax[2]);
+    m_cachedProperties |= CACHED_BOUNDING_BOX;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -441,7 +644,7 @@ void Cluster::UpdateInitialDirectionCache() const
     if (m_orderedCaloHitList.empty())
     {
         m_initialDirection.SetValues(0.f, 0.f, 0.f);
-        m_isDirectionUpToDate = false;
+        m_cachedProperties &= ~CACHED_INITIAL_DIRECTION;
         throw StatusCodeException(STATUS_CODE_NOT_INITIALIZED);
     }
     
@@ -452,12 +655,12 @@ void Cluster::UpdateInitialDirectionCache() const
         initialDirection += pCaloHit->GetExpectedDirection();
 
     m_initialDirection = initialDirection.GetUnitVector();
-    m_isDirectionUpToDate = true;
+    m_cachedProperties |= CACHED_INITIAL_DIRECTION;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-void Cluster::UpdateLayerHitTypeCache(const unsigned int pseudoLayer, InputHitType &layerHitType) const
+void Cluster::UpdateLayerHitTypeCache(const unsigned int pseudoLayer, const unsigned int cachedProperty, HitType &layerHitType) const
 {
     OrderedCaloHitList::const_iterator listIter = m_orderedCaloHitList.find(pseudoLayer);
 
@@ -490,6 +693,11 @@ void Cluster::UpdateLayerHitTypeCache(const unsigned int pseudoLayer, InputHitTy
             highestEnergy = mapEntry.second;
         }
     }
+
+    if (!(highestEnergy > 0.f))
+        throw StatusCodeException(STATUS_CODE_NOT_INITIALIZED);
+
+    m_cachedProperties |= cachedProperty;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -497,12 +705,28 @@ void Cluster::UpdateLayerHitTypeCache(const unsigned int pseudoLayer, InputHitTy
 void Cluster::UpdateEnergyCorrectionsCache(const Pandora &pandora) const
 {
     const EnergyCorrections *const pEnergyCorrections(pandora.GetPlugins()->GetEnergyCorrections());
-    const ParticleId *const pParticleId(pandora.GetPlugins()->GetParticleId());
 
-    float correctedElectromagneticEnergy(0.f), correctedHadronicEnergy(0.f), trackComparisonEnergy(0.f);
+    float correctedElectromagneticEnergy(0.f), correctedHadronicEnergy(0.f);
     PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, pEnergyCorrections->MakeEnergyCorrections(this, correctedElectromagneticEnergy,
         correctedHadronicEnergy));
 
+    this->SetEnergyCorrectionsCache(pandora, correctedElectromagneticEnergy, correctedHadronicEnergy);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool Cluster::IsEnergyCorrectionsCacheUpToDate() const
+{
+    return (m_cachedProperties & CACHED_ENERGY_CORRECTIONS);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void Cluster::SetEnergyCorrectionsCache(const Pandora &pandora, const float correctedElectromagneticEnergy, const float correctedHadronicEnergy) const
+{
+    const ParticleId *const pParticleId(pandora.GetPlugins()->GetParticleId());
+    float trackComparisonEnergy(0.f);
+
     if (pParticleId->IsEmShower(this))
     {
         trackComparisonEnergy = correctedElectromagneticEnergy;
@@ -512,11 +736,13 @@ void Cluster::UpdateEnergyCorrectionsCache(const Pandora &pandora) const
         trackComparisonEnergy = correctedHadronicEnergy;
     }
 
-    if (!(m_correctedElectromagneticEnergy = correctedElectromagneticEnergy) || !(m_correctedHadronicEnergy = correctedHadronicEnergy) ||
-        !(m_trackComparisonEnergy = trackComparisonEnergy))
-    {
-        throw StatusCodeException(STATUS_CODE_FAILURE);
-    }
+    if (!std::isfinite(correctedElectromagneticEnergy) || !std::isfinite(correctedHadronicEnergy) || !std::isfinite(trackComparisonEnergy))
+        throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
+
+    m_correctedElectromagneticEnergy = correctedElectromagneticEnergy;
+    m_correctedHadronicEnergy = correctedHadronicEnergy;
+    m_trackComparisonEnergy = trackComparisonEnergy;
+    m_cachedProperties |= CACHED_ENERGY_CORRECTIONS;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -525,8 +751,8 @@ void Cluster::UpdatePhotonIdCache(const Pandora &pandora) const
 {
     const bool passPhotonId(pandora.GetPlugins()->GetParticleId()->IsPhoton(this));
 
-    if (!(m_passPhotonId = passPhotonId))
-        throw StatusCodeException(STATUS_CODE_FAILURE);
+    m_passPhotonId = passPhotonId;
+    m_cachedProperties |= CACHED_PHOTON_ID;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -538,8 +764,8 @@ void Cluster::UpdateShowerLayerCache(const Pandora &pandora) const
     unsigned int showerStartLayer(std::numeric_limits<unsigned int>::max());
     pShowerProfilePlugin->CalculateShowerStartLayer(this, showerStartLayer);
 
-    if (!(m_showerStartLayer = showerStartLayer))
-        throw StatusCodeException(STATUS_CODE_FAILURE);
+    m_showerStartLayer = showerStartLayer;
+    m_cachedProperties |= CACHED_SHOWER_START_LAYER;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -551,8 +777,12 @@ void Cluster::UpdateShowerProfileCache(const Pandora &pandora) const
     float showerProfileStart(std::numeric_limits<float>::max()), showerProfileDiscrepancy(std::numeric_limits<float>::max());
     pShowerProfilePlugin->CalculateLongitudinalProfile(this, showerProfileStart, showerProfileDiscrepancy);
 
-    if (!(m_showerProfileStart = showerProfileStart) || !(m_showerProfileDiscrepancy = showerProfileDiscrepancy))
-        throw StatusCodeException(STATUS_CODE_FAILURE);
+    if (!std::isfinite(showerProfileStart) || !std::isfinite(showerProfileDiscrepancy))
+        throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
+
+    m_showerProfileStart = showerProfileStart;
+    m_showerProfileDiscrepancy = showerProfileDiscrepancy;
+    m_cachedProperties |= CACHED_SHOWER_PROFILE;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -569,6 +799,8 @@ StatusCode Cluster::ResetProperties()
     m_nCaloHitsInOuterLayer = 0;
 
     m_sumXYZByPseudoLayer.clear();
+    m_firstPointPseudoLayer = 0;
+    m_cachedProperties &= ~CACHED_BOUNDING_BOX;
 
     m_electromagneticEnergy = 0;
     m_hadronicEnergy = 0;
@@ -586,32 +818,19 @@ StatusCode Cluster::ResetProperties()
 
 void Cluster::ResetOutdatedProperties()
 {
-    m_isFitUpToDate = false;
-    m_isDirectionUpToDate = false;
-    m_initialDirection.SetValues(0.f, 0.f, 0.f);
-    m_fitToAllHitsResult.Reset();
-    m_showerStartLayer.Reset();
-    m_passPhotonId.Reset();
-    m_showerProfileStart.Reset();
-    m_showerProfileDiscrepancy.Reset();
-    m_correctedElectromagneticEnergy.Reset();
-    m_correctedHadronicEnergy.Reset();
-    m_trackComparisonEnergy.Reset();
-    m_innerLayerHitType.Reset();
-    m_outerLayerHitType.Reset();
-    m_xMin.Reset();
-    m_xMax.Reset();
+    // ATTN The bounding box is maintained incrementally as calo hits are added and removed, so survives the reset
+    ++m_modificationEpoch;
+    m_cachedProperties &= CACHED_BOUNDING_BOX;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 StatusCode Cluster::AddHitsFromSecondCluster(const Cluster *const pCluster)
 {
-    if (this == pCluster)
+    if ((this == pCluster) || (pCluster->GetEventId() != m_eventId))
         return STATUS_CODE_NOT_ALLOWED;
 
-    const OrderedCaloHitList &orderedCaloHitList(pCluster->GetOrderedCaloHitList());
-    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_orderedCaloHitList.Add(orderedCaloHitList));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_orderedCaloHitList.Add(pCluster->GetOrderedCaloHitList()));
 
     const CaloHitList &isolatedCaloHitList(pCluster->GetIsolatedCaloHitList());
     for (const CaloHit *const pCaloHit : isolatedCaloHitList)
@@ -622,6 +841,36 @@ StatusCode Cluster::AddHitsFromSecondCluster(const Cluster *const pCluster)
         m_isolatedCaloHitList.push_back(pCaloHit);
     }
 
+    this->AddPropertiesFromSecondCluster(pCluster);
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode Cluster::TransferHitsFromSecondCluster(Cluster *const pCluster)
+{
+    if ((this == pCluster) || (pCluster->GetEventId() != m_eventId))
+        return STATUS_CODE_NOT_ALLOWED;
+
+    for (const CaloHit *const pCaloHit : pCluster->m_isolatedCaloHitList)
+    {
+        if (m_isolatedCaloHitList.end() != std::find(m_isolatedCaloHitList.begin(), m_isolatedCaloHitList.end(), pCaloHit))
+            return STATUS_CODE_ALREADY_PRESENT;
+    }
+
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_orderedCaloHitList.Transfer(pCluster->m_orderedCaloHitList));
+
+    m_isolatedCaloHitList.insert(m_isolatedCaloHitList.end(), pCluster->m_isolatedCaloHitList.begin(), pCluster->m_isolatedCaloHitList.end());
+    pCluster->m_isolatedCaloHitList.clear();
+
+    this->AddPropertiesFromSecondCluster(pCluster);
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void Cluster::AddPropertiesFromSecondCluster(const Cluster *const pCluster)
+{
     this->ResetOutdatedProperties();
 
     m_nCaloHits += pCluster->GetNCaloHits();
@@ -631,34 +880,58 @@ StatusCode Cluster::AddHitsFromSecondCluster(const Cluster *const pCluster)
     m_electromagneticEnergy += pCluster->GetElectromagneticEnergy();
     m_hadronicEnergy += pCluster->GetHadronicEnergy();
 
-    // Loop over pseudo layers in second cluster
-    for (const OrderedCaloHitList::value_type &layerEntry : orderedCaloHitList)
+    // Loop over populated pseudo layers in second cluster, combining the per pseudo layer sums directly
+    for (unsigned int index = 0, nPoints = pCluster->m_sumXYZByPseudoLayer.size(); index < nPoints; ++index)
     {
-        const unsigned int pseudoLayer(layerEntry.first);
-        OrderedCaloHitList::const_iterator currentIter = m_orderedCaloHitList.find(pseudoLayer);
+        const SimplePoint &theirpoint = pCluster->m_sumXYZByPseudoLayer[index];
 
-        SimplePoint &mypoint = m_sumXYZByPseudoLayer[pseudoLayer];
-        const SimplePoint &theirpoint = pCluster->m_sumXYZByPseudoLayer.at(pseudoLayer);
+        if (0 == theirpoint.m_nHits)
+            continue;
 
-        if ((m_orderedCaloHitList.end() != currentIter) && (currentIter->second->size() > 1))
+        SimplePoint &mypoint = this->GetModifiablePoint(pCluster->m_firstPointPseudoLayer + index);
+
+        if (mypoint.m_nHits > 0)
         {
             mypoint.m_xyzPositionSums[0] += theirpoint.m_xyzPositionSums[0];
             mypoint.m_xyzPositionSums[1] += theirpoint.m_xyzPositionSums[1];
             mypoint.m_xyzPositionSums[2] += theirpoint.m_xyzPositionSums[2];
             mypoint.m_nHits += theirpoint.m_nHits;
+            mypoint.m_fitAccumulator += theirpoint.m_fitAccumulator;
+
+            if (mypoint.m_isExtentUpToDate && theirpoint.m_isExtentUpToDate)
+            {
+                mypoint.ExtendExtent(theirpoint.m_xyzMin[0], theirpoint.m_xyzMin[1], theirpoint.m_xyzMin[2]);
+                mypoint.ExtendExtent(theirpoint.m_xyzMax[0], theirpoint.m_xyzMax[1], theirpoint.m_xyzMax[2]);
+            }
+            else
+            {
+                mypoint.m_isExtentUpToDate = false;
+            }
         }
         else
         {
-            mypoint.m_xyzPositionSums[0] = theirpoint.m_xyzPositionSums[0];
-            mypoint.m_xyzPositionSums[1] = theirpoint.m_xyzPositionSums[1];
-            mypoint.m_xyzPositionSums[2] = theirpoint.m_xyzPositionSums[2];
-            mypoint.m_nHits = theirpoint.m_nHits;
+            mypoint = theirpoint;
         }
     }
 
-    m_innerPseudoLayer = m_orderedCaloHitList.begin()->first;
-    m_outerPseudoLayer = m_orderedCaloHitList.rbegin()->first;
-    return STATUS_CODE_SUCCESS;
+    if ((m_cachedProperties & CACHED_BOUNDING_BOX) && (pCluster->m_cachedProperties & CACHED_BOUNDING_BOX))
+    {
+        m_boundingBoxMin.SetValues(std::min(m_boundingBoxMin.GetX(), pCluster->m_boundingBoxMin.GetX()),
+            std::min(m_boundingBoxMin.GetY(), pCluster->m_boundingBoxMin.GetY()), std::min(m_boundingBoxMin.GetZ(), pCluster->m_boundingBoxMin.GetZ()));
+        m_boundingBoxMax.SetValues(std::max(m_boundingBoxMax.GetX(), pCluster->m_boundingBoxMax.GetX()),
+            std::max(m_boundingBoxMax.GetY(), pCluster->m_boundingBoxMax.GetY()), std::max(m_boundingBoxMax.GetZ(), pCluster->m_boundingBoxMax.GetZ()));
+    }
+    else
+    {
+        m_cachedProperties &= ~CACHED_BOUNDING_BOX;
+    }
+
+    // ATTN Merging two clusters containing only isolated calo hits leaves the ordered calo hit list empty
+    if (!m_orderedCaloHitList.empty())
+    {
+        m_innerPseudoLayer = m_orderedCaloHitList.begin()->first;
+        m_outerPseudoLayer = m_orderedCaloHitList.rbegin()->first;
+    }
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -668,10 +941,14 @@ StatusCode Cluster::AddTrackAssociation(const Track *const pTrack)
     if (!pTrack)
         return STATUS_CODE_INVALID_PARAMETER;
 
+    if (pTrack->GetEventId() != m_eventId)
+        return STATUS_CODE_NOT_ALLOWED;
+
     if (m_associatedTrackList.end() != std::find(m_associatedTrackList.begin(), m_associatedTrackList.end(), pTrack))
         return STATUS_CODE_ALREADY_PRESENT;
 
     m_associatedTrackList.push_back(pTrack);
+    ++m_modificationEpoch;
     return STATUS_CODE_SUCCESS;
 }
 
@@ -685,6 +962,7 @@ StatusCode Cluster::RemoveTrackAssociation(const Track *const pTrack)
         return STATUS_CODE_NOT_FOUND;
 
     m_associatedTrackList.erase(iter);
+    ++m_modificationEpoch;
     return STATUS_CODE_SUCCESS;
 }
 
@@ -693,7 +971,59 @@ StatusCode Cluster::RemoveTrackAssociation(const Track *const pTrack)
 void Cluster::RemoveTrackSeed()
 {
     m_pTrackSeed = nullptr;
+    ++m_modificationEpoch;
     this->UpdateInitialDirectionCache();
 }
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void Cluster::SimplePoint::ExtendExtent(const float x, const float y, const float z) const
+{
+    m_xyzMin[0] = std::min(x, m_xyzMin[0]);
+    m_xyzMin[1] = std::min(y, m_xyzMin[1]);
+    m_xyzMin[2] = std::min(z, m_xyzMin[2]);
+    m_xyzMax[0] = std::max(x, m_xyzMax[0]);
+    m_xyzMax[1] = std::max(y, m_xyzMax[1]);
+    m_xyzMax[2] = std::max(z, m_xyzMax[2]);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool Cluster::SimplePoint::IsInsideExtent(const float x, const float y, const float z) const
+{
+    return ((x > m_xyzMin[0]) && (x < m_xyzMax[0]) && (y > m_xyzMin[1]) && (y < m_xyzMax[1]) && (z > m_xyzMin[2]) && (z < m_xyzMax[2]));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void Cluster::SimplePoint::UpdateExtent(const CaloHitList &caloHitList) const
+{
+    m_xyzMin[0] = m_xyzMin[1] = m_xyzMin[2] = std::numeric_limits<float>::max();
+    m_xyzMax[0] = m_xyzMax[1] = m_xyzMax[2] = -std::numeric_limits<float>::max();
+
+    for (const CaloHit *const pCaloHit : caloHitList)
+    {
+        const CartesianVector &positionVector(pCaloHit->GetPositionVector());
+        this->ExtendExtent(positionVector.GetX(), positionVector.GetY(), positionVector.GetZ());
+    }
+
+    m_isExtentUpToDate = true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef PANDORA_POOLED_OBJECT_ALLOCATION
+void *Cluster::operator new(std::size_t size)
+{
+    return ObjectPool<Cluster>::Allocate(size);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void Cluster::operator delete(void *pAddress, std::size_t size)
+{
+    ObjectPool<Cluster>::Deallocate(pAddress, size);
+}
+#endif
+
 } // namespace pandora
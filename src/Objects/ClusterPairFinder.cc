@@ -0,0 +1,249 @@
+/**
+ *  @file   PandoraSDK/src/Objects/ClusterPairFinder.cc
+ *
+ *  @brief  Implementation of the cluster pair finder class.
+ *
+ *  $Log: $
+ */
+
+#include "Objects/CartesianVector.h"
+#include "Objects/Cluster.h"
+#include "Objects/ClusterPairFinder.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace pandora
+{
+
+ClusterPairFinder::ClusterPairFinder() :
+    m_sweepAxis(0)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode ClusterPairFinder::FindCandidatePairs(const float maximumGap, ClusterPairVector &clusterPairVector) const
+{
+    if (!(maximumGap >= 0.f))
+        return STATUS_CODE_INVALID_PARAMETER;
+
+    typedef std::pair<const Entry *, const Entry *> EntryPair;
+    std::vector<EntryPair> entryPairs;
+
+    for (EntryVector::const_iterator iter = m_entryVector.begin(), iterEnd = m_entryVector.end(); iter != iterEnd; ++iter)
+    {
+        // ATTN Entries are sorted by minimum along the sweep axis, so no later entry can overlap once one starts beyond this one
+        const float sweepLimit(iter->m_max[m_sweepAxis] + maximumGap);
+
+        for (EntryVector::const_iterator otherIter = iter + 1; (otherIter != iterEnd) && (otherIter->m_min[m_sweepAxis] <= sweepLimit); ++otherIter)
+        {
+            if (!ClusterPairFinder::Overlaps(*iter, *otherIter, maximumGap))
+                continue;
+
+            if (iter->m_listIndex < otherIter->m_listIndex)
+            {
+                entryPairs.emplace_back(&(*iter), &(*otherIter));
+            }
+            else
+            {
+                entryPairs.emplace_back(&(*otherIter), &(*iter));
+            }
+        }
+    }
+
+    std::sort(entryPairs.begin(), entryPairs.end(), [](const EntryPair &lhs, const EntryPair &rhs)
+    {
+        if (lhs.first->m_listIndex != rhs.first->m_listIndex)
+            return (lhs.first->m_listIndex < rhs.first->m_listIndex);
+
+        return (lhs.second->m_listIndex < rhs.second->m_listIndex);
+    });
+
+    clusterPairVector.clear();
+    clusterPairVector.reserve(entryPairs.size());
+
+    for (const EntryPair &entryPair : entryPairs)
+        clusterPairVector.emplace_back(entryPair.first->m_pCluster, entryPair.second->m_pCluster);
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode ClusterPairFinder::FindCandidates(const Cluster *const pCluster, const float maximumGap, ClusterVector &clusterVector) const
+{
+    if (!(maximumGap >= 0.f))
+        return STATUS_CODE_INVALID_PARAMETER;
+
+    Entry targetEntry;
+
+    if (!ClusterPairFinder::GetBoundingBox(pCluster, targetEntry))
+        return STATUS_CODE_NOT_INITIALIZED;
+
+    const float sweepLimit(targetEntry.m_max[m_sweepAxis] + maximumGap);
+    std::vector<const Entry *> entries;
+
+    for (EntryVector::const_iterator iter = m_entryVector.begin(), iterEnd = m_entryVector.end(); (iter != iterEnd) && (iter->m_min[m_sweepAxis] <= sweepLimit); ++iter)
+    {
+        if ((pCluster != iter->m_pCluster) && ClusterPairFinder::Overlaps(targetEntry, *iter, maximumGap))
+            entries.push_back(&(*iter));
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const Entry *const pLhs, const Entry *const pRhs)
+    {
+        return (pLhs->m_listIndex < pRhs->m_listIndex);
+    });
+
+    clusterVector.clear();
+    clusterVector.reserve(entries.size());
+
+    for (const Entry *const pEntry : entries)
+        clusterVector.push_back(pEntry->m_pCluster);
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void ClusterPairFinder::Fill(const ClusterList &clusterList)
+{
+    this->Clear();
+    m_entryVector.reserve(clusterList.size());
+
+    float centreMin[3] = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+    float centreMax[3] = {-std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max()};
+    unsigned int listIndex(0);
+
+    for (const Cluster *const pCluster : clusterList)
+    {
+        Entry entry;
+        entry.m_listIndex = listIndex++;
+        entry.m_pCluster = pCluster;
+
+        if (!ClusterPairFinder::GetBoundingBox(pCluster, entry))
+            continue;
+
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+            const float centre(0.5f * (entry.m_min[i] + entry.m_max[i]));
+            centreMin[i] = std::min(centreMin[i], centre);
+            centreMax[i] = std::max(centreMax[i], centre);
+        }
+
+        m_entryVector.push_back(entry);
+    }
+
+    if (m_entryVector.empty())
+        return;
+
+    // ATTN Sweep along the axis on which the bounding box centres are most spread, so that the fewest boxes overlap on it
+    for (unsigned int i = 1; i < 3; ++i)
+    {
+        if ((centreMax[i] - centreMin[i]) > (centreMax[m_sweepAxis] - centreMin[m_sweepAxis]))
+            m_sweepAxis = i;
+    }
+
+    std::sort(m_entryVector.begin(), m_entryVector.end(), SweepLessThan(m_sweepAxis));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void ClusterPairFinder::Clear()
+{
+    m_entryVector.clear();
+    m_sweepAxis = 0;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void ClusterPairFinder::Update(const Cluster *const pCluster)
+{
+    EntryVector::iterator iter = this->FindEntry(pCluster);
+
+    if (m_entryVector.end() == iter)
+        return;
+
+    Entry entry(*iter);
+    m_entryVector.erase(iter);
+
+    if (ClusterPairFinder::GetBoundingBox(pCluster, entry))
+        this->Insert(entry);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void ClusterPairFinder::Remove(const Cluster *const pCluster)
+{
+    EntryVector::iterator iter = this->FindEntry(pCluster);
+
+    if (m_entryVector.end() != iter)
+        m_entryVector.erase(iter);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+ClusterPairFinder::EntryVector::iterator ClusterPairFinder::FindEntry(const Cluster *const pCluster)
+{
+    return std::find_if(m_entryVector.begin(), m_entryVector.end(), [pCluster](const Entry &entry)
+    {
+        return (pCluster == entry.m_pCluster);
+    });
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void ClusterPairFinder::Insert(const Entry &entry)
+{
+    m_entryVector.insert(std::upper_bound(m_entryVector.begin(), m_entryVector.end(), entry, SweepLessThan(m_sweepAxis)), entry);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool ClusterPairFinder::GetBoundingBox(const Cluster *const pCluster, Entry &entry)
+{
+    if (0 == pCluster->GetNCaloHits())
+        return false;
+
+    CartesianVector minimum(0.f, 0.f, 0.f), maximum(0.f, 0.f, 0.f);
+    pCluster->GetClusterBoundingBox(minimum, maximum);
+
+    entry.m_min[0] = minimum.GetX(); entry.m_min[1] = minimum.GetY(); entry.m_min[2] = minimum.GetZ();
+    entry.m_max[0] = maximum.GetX(); entry.m_max[1] = maximum.GetY(); entry.m_max[2] = maximum.GetZ();
+
+    return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool ClusterPairFinder::Overlaps(const Entry &lhs, const Entry &rhs, const float maximumGap)
+{
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        if ((lhs.m_min[i] > rhs.m_max[i] + maximumGap) || (rhs.m_min[i] > lhs.m_max[i] + maximumGap))
+            return false;
+    }
+
+    return true;
+}
+
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+ClusterPairFinder::SweepLessThan::SweepLessThan(const unsigned int axis) :
+    m_axis(axis)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool ClusterPairFinder::SweepLessThan::operator()(const Entry &lhs, const Entry &rhs) const
+{
+    if (lhs.m_min[m_axis] != rhs.m_min[m_axis])
+        return (lhs.m_min[m_axis] < rhs.m_min[m_axis]);
+
+    return (lhs.m_listIndex < rhs.m_listIndex);
+}
+
+} // namespace pandora
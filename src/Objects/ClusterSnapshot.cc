@@ -0,0 +1,118 @@
+/**
+ *  @file   PandoraSDK/src/Objects/ClusterSnapshot.cc
+ *
+ *  @brief  Implementation of the cluster snapshot class.
+ *
+ *  $Log: $
+ */
+
+#include "Objects/Cluster.h"
+#include "Objects/ClusterSnapshot.h"
+
+#include <limits>
+
+namespace pandora
+{
+
+ClusterProperties::ClusterProperties(const Pandora &pandora, const Cluster *const pCluster) :
+    m_pCluster(pCluster),
+    m_initialDirection(0.f, 0.f, 0.f),
+    m_fitToAllHitsResult(pCluster->GetFitToAllHitsResult()),
+    m_correctedElectromagneticEnergy(0.f),
+    m_correctedHadronicEnergy(0.f),
+    m_trackComparisonEnergy(0.f),
+    m_passPhotonId(false),
+    m_showerStartLayer(std::numeric_limits<unsigned int>::max()),
+    m_showerProfileStart(0.f),
+    m_showerProfileDiscrepancy(0.f),
+    m_innerLayerHitType(HIT_CUSTOM),
+    m_outerLayerHitType(HIT_CUSTOM),
+    m_boundingBoxMin(0.f, 0.f, 0.f),
+    m_boundingBoxMax(0.f, 0.f, 0.f),
+    m_isInitialDirectionAvailable(false),
+    m_areEnergyCorrectionsAvailable(false),
+    m_isPhotonIdAvailable(false),
+    m_isShowerStartLayerAvailable(false),
+    m_isShowerProfileAvailable(false),
+    m_areLayerHitTypesAvailable(false)
+{
+    // ATTN Properties that cannot be calculated for this cluster (e.g. missing plugins) are flagged as unavailable
+    try
+    {
+        m_initialDirection = pCluster->GetInitialDirection();
+        m_isInitialDirectionAvailable = true;
+    }
+    catch (StatusCodeException &) {}
+
+    try
+    {
+        m_correctedElectromagneticEnergy = pCluster->GetCorrectedElectromagneticEnergy(pandora);
+        m_correctedHadronicEnergy = pCluster->GetCorrectedHadronicEnergy(pandora);
+        m_trackComparisonEnergy = pCluster->GetTrackComparisonEnergy(pandora);
+        m_areEnergyCorrectionsAvailable = true;
+    }
+    catch (StatusCodeException &) {}
+
+    try
+    {
+        m_passPhotonId = pCluster->PassPhotonId(pandora);
+        m_isPhotonIdAvailable = true;
+    }
+    catch (StatusCodeException &) {}
+
+    try
+    {
+        m_showerStartLayer = pCluster->GetShowerStartLayer(pandora);
+        m_isShowerStartLayerAvailable = true;
+    }
+    catch (StatusCodeException &) {}
+
+    try
+    {
+        m_showerProfileStart = pCluster->GetShowerProfileStart(pandora);
+        m_showerProfileDiscrepancy = pCluster->GetShowerProfileDiscrepancy(pandora);
+        m_isShowerProfileAvailable = true;
+    }
+    catch (StatusCodeException &) {}
+
+    try
+    {
+        m_innerLayerHitType = pCluster->GetInnerLayerHitType();
+        m_outerLayerHitType = pCluster->GetOuterLayerHitType();
+        m_areLayerHitTypesAvailable = true;
+    }
+    catch (StatusCodeException &) {}
+
+    pCluster->GetClusterBoundingBox(m_boundingBoxMin, m_boundingBoxMax);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+ClusterSnapshot::ClusterSnapshot(const Pandora &pandora, const ClusterList &clusterList)
+{
+    m_clusterPropertiesVector.reserve(clusterList.size());
+    m_clusterToIndexMap.reserve(clusterList.size());
+
+    for (const Cluster *const pCluster : clusterList)
+    {
+        if (!m_clusterToIndexMap.insert(ClusterToIndexMap::value_type(pCluster, m_clusterPropertiesVector.size())).second)
+            throw StatusCodeException(STATUS_CODE_ALREADY_PRESENT);
+
+        m_clusterPropertiesVector.push_back(ClusterProperties(pandora, pCluster));
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+const ClusterProperties &ClusterSnapshot::GetClusterProperties(const Cluster *const pCluster) const
+{
+    ClusterToIndexMap::const_iterator iter = m_clusterToIndexMap.find(pCluster);
+
+    if (m_clusterToIndexMap.end() == iter)
+        throw StatusCodeException(STATUS_CODE_NOT_FOUND);
+
+    return m_clusterPropertiesVector.at(iter->second);
+}
+
+} // namespace pandora
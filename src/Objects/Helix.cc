@@ -346,6 +346,69 @@ StatusCode Helix::GetDistanceToPoint(const CartesianVector &point, CartesianVect
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+StatusCode Helix::GetDistanceToPoints(const FloatVector &x, const FloatVector &y, const FloatVector &z, FloatVector &distanceXY,
+    FloatVector &distanceZ, FloatVector &distance3D, FloatVector &genericTime) const
+{
+    const FloatVector::size_type nPoints(x.size());
+
+    if ((y.size() != nPoints) || (z.size() != nPoints))
+        return STATUS_CODE_INVALID_PARAMETER;
+
+    distanceXY.resize(nPoints);
+    distanceZ.resize(nPoints);
+    distance3D.resize(nPoints);
+    genericTime.resize(nPoints);
+
+    if (0 == nPoints)
+        return STATUS_CODE_SUCCESS;
+
+    const float *const pX(&x[0]), *const pY(&y[0]), *const pZ(&z[0]);
+    float *const pDistanceXY(&distanceXY[0]), *const pDistanceZ(&distanceZ[0]), *const pDistance3D(&distance3D[0]), *const pGenericTime(&genericTime[0]);
+
+    // ATTN Per-helix quantities are hoisted; each per-point expression is evaluated exactly as in GetDistanceToPoint, so results are identical
+    const float xCentre(m_xCentre), yCentre(m_yCentre), radius(m_radius), charge(m_charge), referenceZ(m_referencePoint.GetZ());
+    const float phi0(std::atan2(m_referencePoint.GetY() - m_yCentre, m_referencePoint.GetX() - m_xCentre));
+    const bool findNCircles(std::fabs(m_tanLambda * m_radius) > 1.e-20);
+    const float tanLambdaRadius(m_tanLambda * m_radius), chargeRadiusTanLambda(m_charge * m_radius * m_tanLambda);
+    const bool useMomentumZ(std::fabs(m_momentum.GetZ()) > 0);
+    const float momentumZ(m_momentum.GetZ()), pxy(m_pxy), twoPi(TWO_PI), epsilon(std::numeric_limits<float>::epsilon());
+
+    // ATTN The azimuthal angles are computed in a separate scalar pass (atan2 does not vectorize), staged in the generic time output
+    for (FloatVector::size_type i = 0; i < nPoints; ++i)
+        pGenericTime[i] = std::atan2(pY[i] - yCentre, pX[i] - xCentre);
+
+    for (FloatVector::size_type i = 0; i < nPoints; ++i)
+    {
+        const float phi(pGenericTime[i]);
+
+        int nCircles = 0;
+        if (findNCircles)
+        {
+            const float xCircles((phi0 - phi - charge * (pZ[i] - referenceZ) / tanLambdaRadius) / twoPi);
+            const int n1((xCircles >= epsilon) ? static_cast<int>(xCircles) : static_cast<int>(xCircles) - 1);
+            const int n2(n1 + 1);
+            nCircles = ((std::fabs(n1 - xCircles) < std::fabs(n2 - xCircles)) ? n1 : n2);
+        }
+
+        const float dPhi(twoPi * (static_cast<float>(nCircles)) + phi - phi0);
+        const float zOnHelix(referenceZ - chargeRadiusTanLambda * dPhi);
+
+        const float distX(std::fabs(xCentre - pX[i]));
+        const float distY(std::fabs(yCentre - pY[i]));
+        const float distZ(std::fabs(zOnHelix - pZ[i]));
+        const float distXY(std::fabs(std::sqrt(distX * distX + distY * distY) - radius));
+
+        pDistanceXY[i] = distXY;
+        pDistanceZ[i] = distZ;
+        pDistance3D[i] = std::sqrt(distXY * distXY + distZ * distZ);
+        pGenericTime[i] = (useMomentumZ ? (zOnHelix - referenceZ) / momentumZ : charge * radius * dPhi / pxy);
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 StatusCode Helix::GetDistanceToHelix(const Helix *const pHelix, CartesianVector &positionOfClosestApproach, CartesianVector &v0momentum,
     float &helixDistance) const
 {
@@ -11,16 +11,44 @@
 #include "Objects/Histograms.h"
 
 #include "Pandora/StatusCodes.h"
+#include "Pandora/ThreadPool.h"
 
 #include "Xml/tinyxml.h"
 
 #include <cmath>
+#include <istream>
 #include <limits>
+#include <ostream>
 
 namespace pandora
 {
 
+const unsigned int HISTOGRAM_BINARY_ID(0x31484850);          ///< Identifies binary images of histograms
+const unsigned int TWOD_HISTOGRAM_BINARY_ID(0x32484850);     ///< Identifies binary images of two dimensional histograms
+const unsigned int HISTOGRAM_BINARY_VERSION(1);              ///< The histogram binary image format version
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+void Histogram::WriteBinaryValues(const T *const pValues, const unsigned int nValues, std::ostream &binaryStream)
+{
+    binaryStream.write(reinterpret_cast<const char*>(pValues), static_cast<std::streamsize>(nValues * sizeof(T)));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+void Histogram::ReadBinaryValues(std::istream &binaryStream, T *const pValues, const unsigned int nValues)
+{
+    if (!binaryStream.read(reinterpret_cast<char*>(pValues), static_cast<std::streamsize>(nValues * sizeof(T))))
+        throw StatusCodeException(STATUS_CODE_FAILURE);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 Histogram::Histogram(const unsigned int nBinsX, const float xLow, const float xHigh) :
+    m_shouldCachePrefixSums(false),
+    m_arePrefixSumsValid(false),
     m_nBinsX(nBinsX),
     m_xLow(xLow),
     m_xHigh(xHigh)
@@ -33,11 +61,16 @@ Histogram::Histogram(const unsigned int nBinsX, const float xLow, const float xH
     // ATTN Protect against cast to int wrapping to negative numbers if there are very many bins
     if (static_cast<int>((m_xHigh - m_xLow) / m_xBinWidth) < 0)
         throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
+
+    if (static_cast<unsigned int>(m_nBinsX) <= MAX_DENSE_BINS - 2)
+        m_binContents.assign(m_nBinsX + 2, 0.f);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 Histogram::Histogram(const TiXmlHandle *const pXmlHandle, const std::string &xmlElementName) :
+    m_shouldCachePrefixSums(false),
+    m_arePrefixSumsValid(false),
     m_nBinsX(0),
     m_xLow(0.f),
     m_xHigh(0.f)
@@ -60,6 +93,9 @@ Histogram::Histogram(const TiXmlHandle *const pXmlHandle, const std::string &xml
 
     m_xBinWidth = (m_xHigh - m_xLow) / static_cast<float>(m_nBinsX);
 
+    if (static_cast<unsigned int>(m_nBinsX) <= MAX_DENSE_BINS - 2)
+        m_binContents.assign(m_nBinsX + 2, 0.f);
+
     FloatVector orderedBinContents;
     PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, XmlHelper::ReadVectorOfValues(xmlHandle, "BinContents", orderedBinContents));
 
@@ -71,14 +107,70 @@ Histogram::Histogram(const TiXmlHandle *const pXmlHandle, const std::string &xml
         const float value(orderedBinContents[binX + 1]);
 
         if (std::fabs(value) > std::numeric_limits<float>::epsilon())
-            m_histogramMap[binX] = value;
+            this->SetBinContent(binX, value);
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+Histogram::Histogram(std::istream &binaryStream) :
+    m_shouldCachePrefixSums(false),
+    m_arePrefixSumsValid(false),
+    m_nBinsX(0),
+    m_xLow(0.f),
+    m_xHigh(0.f)
+{
+    unsigned int binaryId(0), binaryVersion(0), nDenseBins(0), nSparseBins(0);
+    Histogram::ReadBinaryValues(binaryStream, &binaryId, 1);
+    Histogram::ReadBinaryValues(binaryStream, &binaryVersion, 1);
+
+    if ((HISTOGRAM_BINARY_ID != binaryId) || (HISTOGRAM_BINARY_VERSION != binaryVersion))
+        throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
+
+    Histogram::ReadBinaryValues(binaryStream, &m_nBinsX, 1);
+    Histogram::ReadBinaryValues(binaryStream, &m_xLow, 1);
+    Histogram::ReadBinaryValues(binaryStream, &m_xHigh, 1);
+
+    if ((0 >= m_nBinsX) || (m_xHigh - m_xLow < std::numeric_limits<float>::epsilon()))
+        throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
+
+    m_xBinWidth = (m_xHigh - m_xLow) / static_cast<float>(m_nBinsX);
+
+    if (static_cast<unsigned int>(m_nBinsX) <= MAX_DENSE_BINS - 2)
+        m_binContents.assign(m_nBinsX + 2, 0.f);
+
+    Histogram::ReadBinaryValues(binaryStream, &nDenseBins, 1);
+
+    if (nDenseBins != m_binContents.size())
+        throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
+
+    if (!m_binContents.empty())
+        Histogram::ReadBinaryValues(binaryStream, m_binContents.data(), nDenseBins);
+
+    Histogram::ReadBinaryValues(binaryStream, &nSparseBins, 1);
+
+    for (unsigned int iBin = 0; iBin < nSparseBins; ++iBin)
+    {
+        int binX(0);
+        float value(0.f);
+        Histogram::ReadBinaryValues(binaryStream, &binX, 1);
+        Histogram::ReadBinaryValues(binaryStream, &value, 1);
+
+        if (this->IsDenseBin(binX) || !m_histogramMap.insert(HistogramMap::value_type(binX, value)).second)
+            throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
     }
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 Histogram::Histogram(const Histogram &rhs) :
+    m_binContents(rhs.m_binContents),
     m_histogramMap(rhs.m_histogramMap),
+    m_shouldCachePrefixSums(rhs.m_shouldCachePrefixSums),
+    m_arePrefixSumsValid(rhs.m_arePrefixSumsValid),
+    m_prefixSums(rhs.m_prefixSums),
+    m_prefixSumsX(rhs.m_prefixSumsX),
+    m_prefixSumsXX(rhs.m_prefixSumsXX),
     m_nBinsX(rhs.m_nBinsX),
     m_xLow(rhs.m_xLow),
     m_xHigh(rhs.m_xHigh),
@@ -90,6 +182,9 @@ Histogram::Histogram(const Histogram &rhs) :
 
 float Histogram::GetBinContent(const int binX) const
 {
+    if (this->IsDenseBin(binX))
+        return m_binContents[binX + 1];
+
     HistogramMap::const_iterator iter = m_histogramMap.find(binX);
 
     if (m_histogramMap.end() == iter)
@@ -120,16 +215,18 @@ int Histogram::GetBinNumber(const float valueX) const
 
 float Histogram::GetCumulativeSum(const int xLowBin, const int xHighBin) const
 {
+    if (this->UsePrefixSums())
+    {
+        double sum(0.), sumX(0.), sumXX(0.);
+        this->GetRangeSums(std::max(this->GetUnderflowBinNumber(), xLowBin), std::min(xHighBin, this->GetOverflowBinNumber()), sum, sumX, sumXX);
+        return static_cast<float>(sum);
+    }
+
     float sumEntries(0.f);
 
     for (int xBin = std::max(this->GetUnderflowBinNumber(), xLowBin), xBinEnd = std::min(xHighBin, this->GetOverflowBinNumber()); xBin <= xBinEnd; ++xBin)
     {
-        HistogramMap::const_iterator iterX = m_histogramMap.find(xBin);
-
-        if (m_histogramMap.end() == iterX)
-            continue;
-
-        sumEntries += iterX->second;
+        sumEntries += this->GetBinContent(xBin);
     }
 
     return sumEntries;
@@ -144,17 +241,12 @@ void Histogram::GetMaximum(const int xLowBin, const int xHighBin, float &maximum
 
     for (int xBin = std::max(this->GetUnderflowBinNumber(), xLowBin), xBinEnd = std::min(xHighBin, this->GetOverflowBinNumber()); xBin <= xBinEnd; ++xBin)
     {
-        HistogramMap::const_iterator iterX = m_histogramMap.find(xBin);
-
-        if (m_histogramMap.end() == iterX)
-            continue;
-
-        const float binContents(iterX->second);
+        const float binContents(this->GetBinContent(xBin));
 
         if (binContents > maximumValue)
         {
             maximumValue = binContents;
-            maximumBinX = iterX->first;
+            maximumBinX = xBin;
         }
     }
 }
@@ -163,18 +255,24 @@ void Histogram::GetMaximum(const int xLowBin, const int xHighBin, float &maximum
 
 float Histogram::GetMeanX(const int xLowBin, const int xHighBin) const
 {
+    if (this->UsePrefixSums())
+    {
+        double sum(0.), sumX(0.), sumXX(0.);
+        this->GetRangeSums(std::max(this->GetMinBinNumber(), xLowBin), std::min(xHighBin, this->GetMaxBinNumber()), sum, sumX, sumXX);
+
+        if (std::fabs(sum) < std::numeric_limits<float>::epsilon())
+            return 0.f;
+
+        return static_cast<float>(sumX / sum);
+    }
+
     float sumEntries(0.f), sumXEntries(0.f);
     const float firstBinCenter(m_xLow + (0.5f * m_xBinWidth));
 
     for (int xBin = std::max(this->GetMinBinNumber(), xLowBin), xBinEnd = std::min(xHighBin, this->GetMaxBinNumber()); xBin <= xBinEnd; ++xBin)
     {
-        HistogramMap::const_iterator iterX = m_histogramMap.find(xBin);
-
-        if (m_histogramMap.end() == iterX)
-            continue;
-
-        const float binCenter(firstBinCenter + (m_xBinWidth * static_cast<float>(iterX->first)));
-        const float binContents(iterX->second);
+        const float binCenter(firstBinCenter + (m_xBinWidth * static_cast<float>(xBin)));
+        const float binContents(this->GetBinContent(xBin));
 
         sumEntries += binContents;
         sumXEntries += binContents * binCenter;
@@ -190,18 +288,25 @@ float Histogram::GetMeanX(const int xLowBin, const int xHighBin) const
 
 float Histogram::GetStandardDeviationX(const int xLowBin, const int xHighBin) const
 {
+    if (this->UsePrefixSums())
+    {
+        double sum(0.), sumX(0.), sumXX(0.);
+        this->GetRangeSums(std::max(this->GetMinBinNumber(), xLowBin), std::min(xHighBin, this->GetMaxBinNumber()), sum, sumX, sumXX);
+
+        if (std::fabs(sum) < std::numeric_limits<float>::epsilon())
+            return 0.f;
+
+        const double meanX(sumX / sum);
+        return static_cast<float>(std::sqrt((sumXX / sum) - (meanX * meanX)));
+    }
+
     float sumEntries(0.f), sumXEntries(0.f), sumXXEntries(0.f);
     const float firstBinCenter(m_xLow + (0.5f * m_xBinWidth));
 
     for (int xBin = std::max(this->GetMinBinNumber(), xLowBin), xBinEnd = std::min(xHighBin, this->GetMaxBinNumber()); xBin <= xBinEnd; ++xBin)
     {
-        HistogramMap::const_iterator iterX = m_histogramMap.find(xBin);
-
-        if (m_histogramMap.end() == iterX)
-            continue;
-
-        const float binCenter(firstBinCenter + (m_xBinWidth * static_cast<float>(iterX->first)));
-        const float binContents(iterX->second);
+        const float binCenter(firstBinCenter + (m_xBinWidth * static_cast<float>(xBin)));
+        const float binContents(this->GetBinContent(xBin));
 
         sumEntries += binContents;
         sumXEntries += binContents * binCenter;
@@ -224,7 +329,16 @@ void Histogram::SetBinContent(const int binX, const float value)
     if ((binX < this->GetUnderflowBinNumber()) || (binX > this->GetOverflowBinNumber()))
         throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
 
-    m_histogramMap[binX] = value;
+    m_arePrefixSumsValid = false;
+
+    if (this->IsDenseBin(binX))
+    {
+        m_binContents[binX + 1] = value;
+    }
+    else
+    {
+        m_histogramMap[binX] = value;
+    }
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -232,6 +346,13 @@ void Histogram::SetBinContent(const int binX, const float value)
 void Histogram::Fill(const float valueX, const float weight)
 {
     const int binX(this->GetBinNumber(valueX));
+    m_arePrefixSumsValid = false;
+
+    if (this->IsDenseBin(binX))
+    {
+        m_binContents[binX + 1] += weight;
+        return;
+    }
 
     HistogramMap::iterator iter = m_histogramMap.find(binX);
 
@@ -248,8 +369,24 @@ void Histogram::Fill(const float valueX, const float weight)
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+void Histogram::Fill(const FloatVector &valuesX, const FloatVector &weights)
+{
+    if (valuesX.size() != weights.size())
+        throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
+
+    for (unsigned int index = 0, nEntries = valuesX.size(); index < nEntries; ++index)
+        this->Fill(valuesX[index], weights[index]);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 void Histogram::Scale(const float scaleFactor)
 {
+    m_arePrefixSumsValid = false;
+
+    for (float &binContent : m_binContents)
+        binContent = (binContent * scaleFactor);
+
     for (HistogramMap::value_type &mapEntry : m_histogramMap)
     {
         mapEntry.second = (mapEntry.second * scaleFactor);
@@ -258,6 +395,21 @@ void Histogram::Scale(const float scaleFactor)
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+void Histogram::SetShouldCachePrefixSums(const bool shouldCachePrefixSums)
+{
+    m_shouldCachePrefixSums = shouldCachePrefixSums;
+    m_arePrefixSumsValid = false;
+
+    if (!m_shouldCachePrefixSums)
+    {
+        PrefixSumVector().swap(m_prefixSums);
+        PrefixSumVector().swap(m_prefixSumsX);
+        PrefixSumVector().swap(m_prefixSumsXX);
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 void Histogram::WriteToXml(TiXmlDocument *const pTiXmlDocument, const std::string &histogramXmlKey) const
 {
     TiXmlElement *const pHistogramElement = new TiXmlElement(histogramXmlKey);
@@ -287,11 +439,102 @@ void Histogram::WriteToXml(TiXmlDocument *const pTiXmlDocument, const std::strin
     pTiXmlDocument->LinkEndChild(pHistogramElement);
 }
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void Histogram::WriteToBinary(std::ostream &binaryStream) const
+{
+    const unsigned int nDenseBins(m_binContents.size()), nSparseBins(m_histogramMap.size());
+
+    Histogram::WriteBinaryValues(&HISTOGRAM_BINARY_ID, 1, binaryStream);
+    Histogram::WriteBinaryValues(&HISTOGRAM_BINARY_VERSION, 1, binaryStream);
+    Histogram::WriteBinaryValues(&m_nBinsX, 1, binaryStream);
+    Histogram::WriteBinaryValues(&m_xLow, 1, binaryStream);
+    Histogram::WriteBinaryValues(&m_xHigh, 1, binaryStream);
+    Histogram::WriteBinaryValues(&nDenseBins, 1, binaryStream);
+    Histogram::WriteBinaryValues(m_binContents.data(), nDenseBins, binaryStream);
+    Histogram::WriteBinaryValues(&nSparseBins, 1, binaryStream);
+
+    for (const HistogramMap::value_type &mapEntry : m_histogramMap)
+    {
+        Histogram::WriteBinaryValues(&mapEntry.first, 1, binaryStream);
+        Histogram::WriteBinaryValues(&mapEntry.second, 1, binaryStream);
+    }
+
+    if (!binaryStream.good())
+        throw StatusCodeException(STATUS_CODE_FAILURE);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool Histogram::UsePrefixSums() const
+{
+    if (!m_shouldCachePrefixSums || m_binContents.empty())
+        return false;
+
+    if (m_arePrefixSumsValid)
+        return true;
+
+    const unsigned int nBins(m_binContents.size());
+    const float firstBinCenter(m_xLow + (0.5f * m_xBinWidth));
+
+    m_prefixSums.assign(nBins + 1, 0.);
+    m_prefixSumsX.assign(nBins + 1, 0.);
+    m_prefixSumsXX.assign(nBins + 1, 0.);
+
+    for (unsigned int index = 0; index < nBins; ++index)
+    {
+        const int xBin(static_cast<int>(index) + this->GetUnderflowBinNumber());
+        const double binCenter(firstBinCenter + (m_xBinWidth * static_cast<float>(xBin)));
+        const double binContents(m_binContents[index]);
+
+        m_prefixSums[index + 1] = m_prefixSums[index] + binContents;
+        m_prefixSumsX[index + 1] = m_prefixSumsX[index] + (binContents * binCenter);
+        m_prefixSumsXX[index + 1] = m_prefixSumsXX[index] + (binContents * binCenter * binCenter);
+    }
+
+    m_arePrefixSumsValid = true;
+    return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void Histogram::GetRangeSums(const int xLowBin, const int xHighBin, double &sum, double &sumX, double &sumXX) const
+{
+    sum = 0.; sumX = 0.; sumXX = 0.;
+
+    if (xLowBin > xHighBin)
+        return;
+
+    const unsigned int lowIndex(xLowBin + 1), highIndex(xHighBin + 2);
+    sum = m_prefixSums[highIndex] - m_prefixSums[lowIndex];
+    sumX = m_prefixSumsX[highIndex] - m_prefixSumsX[lowIndex];
+    sumXX = m_prefixSumsXX[highIndex] - m_prefixSumsXX[lowIndex];
+}
+
 //------------------------------------------------------------------------------------------------------------------------------------------
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+template <typename T>
+void TwoDHistogram::WriteBinaryValues(const T *const pValues, const unsigned int nValues, std::ostream &binaryStream)
+{
+    binaryStream.write(reinterpret_cast<const char*>(pValues), static_cast<std::streamsize>(nValues * sizeof(T)));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+void TwoDHistogram::ReadBinaryValues(std::istream &binaryStream, T *const pValues, const unsigned int nValues)
+{
+    if (!binaryStream.read(reinterpret_cast<char*>(pValues), static_cast<std::streamsize>(nValues * sizeof(T))))
+        throw StatusCodeException(STATUS_CODE_FAILURE);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 TwoDHistogram::TwoDHistogram(const unsigned int nBinsX, const float xLow, const float xHigh, const unsigned int nBinsY, const float yLow,
         const float yHigh) :
+    m_shouldCachePrefixSums(false),
+    m_arePrefixSumsValid(false),
     m_nBinsX(nBinsX),
     m_xLow(xLow),
     m_xHigh(xHigh),
@@ -308,11 +551,15 @@ TwoDHistogram::TwoDHistogram(const unsigned int nBinsX, const float xLow, const
     // ATTN Protect against cast to int wrapping to negative numbers if there are very many bins
     if ((static_cast<int>((m_xHigh - m_xLow) / m_xBinWidth) < 0) || (static_cast<int>((m_yHigh - m_yLow) / m_yBinWidth) < 0))
         throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
+
+    this->InitializeBinContents();
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 TwoDHistogram::TwoDHistogram(const TiXmlHandle *const pXmlHandle, const std::string &xmlElementName) :
+    m_shouldCachePrefixSums(false),
+    m_arePrefixSumsValid(false),
     m_nBinsX(0),
     m_xLow(0.f),
     m_xHigh(0.f),
@@ -346,6 +593,7 @@ TwoDHistogram::TwoDHistogram(const TiXmlHandle *const pXmlHandle, const std::str
         throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
 
     m_yBinWidth = (m_yHigh - m_yLow) / static_cast<float>(m_nBinsY);
+    this->InitializeBinContents();
 
     typedef std::vector<FloatVector> HistogramEntryList;
     HistogramEntryList histogramEntryList;
@@ -364,20 +612,84 @@ TwoDHistogram::TwoDHistogram(const TiXmlHandle *const pXmlHandle, const std::str
         for (int binX = this->GetUnderflowBinNumberX(), endBinX = this->GetOverflowBinNumberX(); binX <= endBinX; ++binX)
         {
             const float value(orderedBinContents[binX + 1]);
+
             if (std::fabs(value) > std::numeric_limits<float>::epsilon())
-            {
-                m_yxHistogramMap[binY][binX] = value;
-                m_xyHistogramMap[binX][binY] = value;
-            }
+                this->SetBinContent(binX, binY, value);
         }
     }
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+TwoDHistogram::TwoDHistogram(std::istream &binaryStream) :
+    m_shouldCachePrefixSums(false),
+    m_arePrefixSumsValid(false),
+    m_nBinsX(0),
+    m_xLow(0.f),
+    m_xHigh(0.f),
+    m_nBinsY(0),
+    m_yLow(0.f),
+    m_yHigh(0.f)
+{
+    unsigned int binaryId(0), binaryVersion(0), nDenseBins(0), nSparseBins(0);
+    TwoDHistogram::ReadBinaryValues(binaryStream, &binaryId, 1);
+    TwoDHistogram::ReadBinaryValues(binaryStream, &binaryVersion, 1);
+
+    if ((TWOD_HISTOGRAM_BINARY_ID != binaryId) || (HISTOGRAM_BINARY_VERSION != binaryVersion))
+        throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
+
+    TwoDHistogram::ReadBinaryValues(binaryStream, &m_nBinsX, 1);
+    TwoDHistogram::ReadBinaryValues(binaryStream, &m_xLow, 1);
+    TwoDHistogram::ReadBinaryValues(binaryStream, &m_xHigh, 1);
+    TwoDHistogram::ReadBinaryValues(binaryStream, &m_nBinsY, 1);
+    TwoDHistogram::ReadBinaryValues(binaryStream, &m_yLow, 1);
+    TwoDHistogram::ReadBinaryValues(binaryStream, &m_yHigh, 1);
+
+    if ((0 >= m_nBinsX) || (m_xHigh - m_xLow < std::numeric_limits<float>::epsilon()) || (0 >= m_nBinsY) ||
+        (m_yHigh - m_yLow < std::numeric_limits<float>::epsilon()))
+    {
+        throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
+    }
+
+    m_xBinWidth = (m_xHigh - m_xLow) / static_cast<float>(m_nBinsX);
+    m_yBinWidth = (m_yHigh - m_yLow) / static_cast<float>(m_nBinsY);
+    this->InitializeBinContents();
+
+    TwoDHistogram::ReadBinaryValues(binaryStream, &nDenseBins, 1);
+
+    if (nDenseBins != m_binContents.size())
+        throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
+
+    if (!m_binContents.empty())
+        TwoDHistogram::ReadBinaryValues(binaryStream, m_binContents.data(), nDenseBins);
+
+    TwoDHistogram::ReadBinaryValues(binaryStream, &nSparseBins, 1);
+
+    for (unsigned int iBin = 0; iBin < nSparseBins; ++iBin)
+    {
+        int binX(0), binY(0);
+        float value(0.f);
+        TwoDHistogram::ReadBinaryValues(binaryStream, &binX, 1);
+        TwoDHistogram::ReadBinaryValues(binaryStream, &binY, 1);
+        TwoDHistogram::ReadBinaryValues(binaryStream, &value, 1);
+
+        if (this->IsDenseBin(binX, binY) || !m_xyHistogramMap[binX].insert(HistogramMap::value_type(binY, value)).second)
+            throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 TwoDHistogram::TwoDHistogram(const TwoDHistogram &rhs) :
+    m_binContents(rhs.m_binContents),
     m_xyHistogramMap(rhs.m_xyHistogramMap),
-    m_yxHistogramMap(rhs.m_yxHistogramMap),
+    m_shouldCachePrefixSums(rhs.m_shouldCachePrefixSums),
+    m_arePrefixSumsValid(rhs.m_arePrefixSumsValid),
+    m_prefixSums(rhs.m_prefixSums),
+    m_prefixSumsX(rhs.m_prefixSumsX),
+    m_prefixSumsXX(rhs.m_prefixSumsXX),
+    m_prefixSumsY(rhs.m_prefixSumsY),
+    m_prefixSumsYY(rhs.m_prefixSumsYY),
     m_nBinsX(rhs.m_nBinsX),
     m_xLow(rhs.m_xLow),
     m_xHigh(rhs.m_xHigh),
@@ -393,6 +705,9 @@ TwoDHistogram::TwoDHistogram(const TwoDHistogram &rhs) :
 
 float TwoDHistogram::GetBinContent(const int binX, const int binY) const
 {
+    if (this->IsDenseBin(binX, binY))
+        return m_binContents[this->GetDenseIndex(binX, binY)];
+
     TwoDHistogramMap::const_iterator iterX = m_xyHistogramMap.find(binX);
 
     if (m_xyHistogramMap.end() == iterX)
@@ -444,23 +759,21 @@ int TwoDHistogram::GetBinNumberY(const float valueY) const
 
 float TwoDHistogram::GetCumulativeSum(const int xLowBin, const int xHighBin, const int yLowBin, const int yHighBin) const
 {
+    if (this->UsePrefixSums())
+    {
+        double sum(0.), sumX(0.), sumXX(0.), sumY(0.), sumYY(0.);
+        this->GetRangeSums(std::max(this->GetUnderflowBinNumberX(), xLowBin), std::min(xHighBin, this->GetOverflowBinNumberX()), std::max(this->GetUnderflowBinNumberY(), yLowBin),
+            std::min(yHighBin, this->GetOverflowBinNumberY()), sum, sumX, sumXX, sumY, sumYY);
+        return static_cast<float>(sum);
+    }
+
     float sumEntries(0.f);
 
     for (int yBin = std::max(this->GetUnderflowBinNumberY(), yLowBin), yBinEnd = std::min(yHighBin, this->GetOverflowBinNumberY()); yBin <= yBinEnd; ++yBin)
     {
-        TwoDHistogramMap::const_iterator iterY = m_yxHistogramMap.find(yBin);
-
-        if (m_yxHistogramMap.end() == iterY)
-            continue;
-
         for (int xBin = std::max(this->GetUnderflowBinNumberX(), xLowBin), xBinEnd = std::min(xHighBin, this->GetOverflowBinNumberX()); xBin <= xBinEnd; ++xBin)
         {
-            HistogramMap::const_iterator iterX = iterY->second.find(xBin);
-
-            if (iterY->second.end() == iterX)
-                continue;
-
-            sumEntries += iterX->second;
+            sumEntries += this->GetBinContent(xBin, yBin);
         }
     }
 
@@ -477,25 +790,15 @@ void TwoDHistogram::GetMaximum(const int xLowBin, const int xHighBin, const int
 
     for (int yBin = std::max(this->GetUnderflowBinNumberY(), yLowBin), yBinEnd = std::min(yHighBin, this->GetOverflowBinNumberY()); yBin <= yBinEnd; ++yBin)
     {
-        TwoDHistogramMap::const_iterator iterY = m_yxHistogramMap.find(yBin);
-
-        if (m_yxHistogramMap.end() == iterY)
-            continue;
-
         for (int xBin = std::max(this->GetUnderflowBinNumberX(), xLowBin), xBinEnd = std::min(xHighBin, this->GetOverflowBinNumberX()); xBin <= xBinEnd; ++xBin)
         {
-            HistogramMap::const_iterator iterX = iterY->second.find(xBin);
-
-            if (iterY->second.end() == iterX)
-                continue;
-
-            const float binContents(iterX->second);
+            const float binContents(this->GetBinContent(xBin, yBin));
 
             if (binContents > maximumValue)
             {
                 maximumValue = binContents;
-                maximumBinX = iterX->first;
-                maximumBinY = iterY->first;
+                maximumBinX = xBin;
+                maximumBinY = yBin;
             }
         }
     }
@@ -505,25 +808,27 @@ void TwoDHistogram::GetMaximum(const int xLowBin, const int xHighBin, const int
 
 float TwoDHistogram::GetMeanX(const int xLowBin, const int xHighBin, const int yLowBin, const int yHighBin) const
 {
+    if (this->UsePrefixSums())
+    {
+        double sum(0.), sumX(0.), sumXX(0.), sumY(0.), sumYY(0.);
+        this->GetRangeSums(std::max(this->GetMinBinNumberX(), xLowBin), std::min(xHighBin, this->GetMaxBinNumberX()), std::max(this->GetMinBinNumberY(), yLowBin),
+            std::min(yHighBin, this->GetMaxBinNumberY()), sum, sumX, sumXX, sumY, sumYY);
+
+        if (std::fabs(sum) < std::numeric_limits<float>::epsilon())
+            return 0.f;
+
+        return static_cast<float>(sumX / sum);
+    }
+
     float sumEntries(0.f), sumXEntries(0.f);
     const float firstBinXCenter(m_xLow + (0.5f * m_xBinWidth));
 
     for (int yBin = std::max(this->GetMinBinNumberY(), yLowBin), yBinEnd = std::min(yHighBin, this->GetMaxBinNumberY()); yBin <= yBinEnd; ++yBin)
     {
-        TwoDHistogramMap::const_iterator iterY = m_yxHistogramMap.find(yBin);
-
-        if (m_yxHistogramMap.end() == iterY)
-            continue;
-
         for (int xBin = std::max(this->GetMinBinNumberX(), xLowBin), xBinEnd = std::min(xHighBin, this->GetMaxBinNumberX()); xBin <= xBinEnd; ++xBin)
         {
-            HistogramMap::const_iterator iterX = iterY->second.find(xBin);
-
-            if (iterY->second.end() == iterX)
-                continue;
-
-            const float binXCenter(firstBinXCenter + (m_xBinWidth * static_cast<float>(iterX->first)));
-            const float binContents(iterX->second);
+            const float binXCenter(firstBinXCenter + (m_xBinWidth * static_cast<float>(xBin)));
+            const float binContents(this->GetBinContent(xBin, yBin));
 
             sumEntries += binContents;
             sumXEntries += binContents * binXCenter;
@@ -540,25 +845,28 @@ float TwoDHistogram::GetMeanX(const int xLowBin, const int xHighBin, const int y
 
 float TwoDHistogram::GetStandardDeviationX(const int xLowBin, const int xHighBin, const int yLowBin, const int yHighBin) const
 {
+    if (this->UsePrefixSums())
+    {
+        double sum(0.), sumX(0.), sumXX(0.), sumY(0.), sumYY(0.);
+        this->GetRangeSums(std::max(this->GetMinBinNumberX(), xLowBin), std::min(xHighBin, this->GetMaxBinNumberX()), std::max(this->GetMinBinNumberY(), yLowBin),
+            std::min(yHighBin, this->GetMaxBinNumberY()), sum, sumX, sumXX, sumY, sumYY);
+
+        if (std::fabs(sum) < std::numeric_limits<float>::epsilon())
+            return 0.f;
+
+        const double meanX(sumX / sum);
+        return static_cast<float>(std::sqrt((sumXX / sum) - (meanX * meanX)));
+    }
+
     float sumEntries(0.f), sumXEntries(0.f), sumXXEntries(0.f);
     const float firstBinXCenter(m_xLow + (0.5f * m_xBinWidth));
 
     for (int yBin = std::max(this->GetMinBinNumberY(), yLowBin), yBinEnd = std::min(yHighBin, this->GetMaxBinNumberY()); yBin <= yBinEnd; ++yBin)
     {
-        TwoDHistogramMap::const_iterator iterY = m_yxHistogramMap.find(yBin);
-
-        if (m_yxHistogramMap.end() == iterY)
-            continue;
-
         for (int xBin = std::max(this->GetMinBinNumberX(), xLowBin), xBinEnd = std::min(xHighBin, this->GetMaxBinNumberX()); xBin <= xBinEnd; ++xBin)
         {
-            HistogramMap::const_iterator iterX = iterY->second.find(xBin);
-
-            if (iterY->second.end() == iterX)
-                continue;
-
-            const float binXCenter(firstBinXCenter + (m_xBinWidth * static_cast<float>(iterX->first)));
-            const float binContents(iterX->second);
+            const float binXCenter(firstBinXCenter + (m_xBinWidth * static_cast<float>(xBin)));
+            const float binContents(this->GetBinContent(xBin, yBin));
 
             sumEntries += binContents;
             sumXEntries += binContents * binXCenter;
@@ -579,25 +887,27 @@ float TwoDHistogram::GetStandardDeviationX(const int xLowBin, const int xHighBin
 
 float TwoDHistogram::GetMeanY(const int xLowBin, const int xHighBin, const int yLowBin, const int yHighBin) const
 {
+    if (this->UsePrefixSums())
+    {
+        double sum(0.), sumX(0.), sumXX(0.), sumY(0.), sumYY(0.);
+        this->GetRangeSums(std::max(this->GetMinBinNumberX(), xLowBin), std::min(xHighBin, this->GetMaxBinNumberX()), std::max(this->GetMinBinNumberY(), yLowBin),
+            std::min(yHighBin, this->GetMaxBinNumberY()), sum, sumX, sumXX, sumY, sumYY);
+
+        if (std::fabs(sum) < std::numeric_limits<float>::epsilon())
+            return 0.f;
+
+        return static_cast<float>(sumY / sum);
+    }
+
     float sumEntries(0.f), sumYEntries(0.f);
     const float firstBinYCenter(m_yLow + (0.5f * m_yBinWidth));
 
     for (int xBin = std::max(this->GetMinBinNumberX(), xLowBin), xBinEnd = std::min(xHighBin, this->GetMaxBinNumberX()); xBin <= xBinEnd; ++xBin)
     {
-        TwoDHistogramMap::const_iterator iterX = m_xyHistogramMap.find(xBin);
-
-        if (m_xyHistogramMap.end() == iterX)
-            continue;
-
         for (int yBin = std::max(this->GetMinBinNumberY(), yLowBin), yBinEnd = std::min(yHighBin, this->GetMaxBinNumberY()); yBin <= yBinEnd; ++yBin)
         {
-            HistogramMap::const_iterator iterY = iterX->second.find(yBin);
-
-            if (iterX->second.end() == iterY)
-                continue;
-
-            const float binYCenter(firstBinYCenter + (m_yBinWidth * static_cast<float>(iterY->first)));
-            const float binContents(iterY->second);
+            const float binYCenter(firstBinYCenter + (m_yBinWidth * static_cast<float>(yBin)));
+            const float binContents(this->GetBinContent(xBin, yBin));
 
             sumEntries += binContents;
             sumYEntries += binContents * binYCenter;
@@ -614,25 +924,28 @@ float TwoDHistogram::GetMeanY(const int xLowBin, const int xHighBin, const int y
 
 float TwoDHistogram::GetStandardDeviationY(const int xLowBin, const int xHighBin, const int yLowBin, const int yHighBin) const
 {
+    if (this->UsePrefixSums())
+    {
+        double sum(0.), sumX(0.), sumXX(0.), sumY(0.), sumYY(0.);
+        this->GetRangeSums(std::max(this->GetMinBinNumberX(), xLowBin), std::min(xHighBin, this->GetMaxBinNumberX()), std::max(this->GetMinBinNumberY(), yLowBin),
+            std::min(yHighBin, this->GetMaxBinNumberY()), sum, sumX, sumXX, sumY, sumYY);
+
+        if (std::fabs(sum) < std::numeric_limits<float>::epsilon())
+            return 0.f;
+
+        const double meanY(sumY / sum);
+        return static_cast<float>(std::sqrt((sumYY / sum) - (meanY * meanY)));
+    }
+
     float sumEntries(0.f), sumYEntries(0.f), sumYYEntries(0.f);
     const float firstBinYCenter(m_yLow + (0.5f * m_yBinWidth));
 
     for (int xBin = std::max(this->GetMinBinNumberX(), xLowBin), xBinEnd = std::min(xHighBin, this->GetMaxBinNumberX()); xBin <= xBinEnd; ++xBin)
     {
-        TwoDHistogramMap::const_iterator iterX = m_xyHistogramMap.find(xBin);
-
-        if (m_xyHistogramMap.end() == iterX)
-            continue;
-
         for (int yBin = std::max(this->GetMinBinNumberY(), yLowBin), yBinEnd = std::min(yHighBin, this->GetMaxBinNumberY()); yBin <= yBinEnd; ++yBin)
         {
-            HistogramMap::const_iterator iterY = iterX->second.find(yBin);
-
-            if (iterX->second.end() == iterY)
-                continue;
-
-            const float binYCenter(firstBinYCenter + (m_yBinWidth * static_cast<float>(iterY->first)));
-            const float binContents(iterY->second);
+            const float binYCenter(firstBinYCenter + (m_yBinWidth * static_cast<float>(yBin)));
+            const float binContents(this->GetBinContent(xBin, yBin));
 
             sumEntries += binContents;
             sumYEntries += binContents * binYCenter;
@@ -656,8 +969,16 @@ void TwoDHistogram::SetBinContent(const int binX, const int binY, const float va
     if ((binX < this->GetUnderflowBinNumberX()) || (binX > this->GetOverflowBinNumberX()) || (binY < this->GetUnderflowBinNumberY()) || (binY > this->GetOverflowBinNumberY()))
         throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
 
-    m_xyHistogramMap[binX][binY] = value;
-    m_yxHistogramMap[binY][binX] = value;
+    m_arePrefixSumsValid = false;
+
+    if (this->IsDenseBin(binX, binY))
+    {
+        m_binContents[this->GetDenseIndex(binX, binY)] = value;
+    }
+    else
+    {
+        m_xyHistogramMap[binX][binY] = value;
+    }
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -666,6 +987,13 @@ void TwoDHistogram::Fill(const float valueX, const float valueY, const float wei
 {
     const int binX(this->GetBinNumberX(valueX));
     const int binY(this->GetBinNumberY(valueY));
+    m_arePrefixSumsValid = false;
+
+    if (this->IsDenseBin(binX, binY))
+    {
+        m_binContents[this->GetDenseIndex(binX, binY)] += weight;
+        return;
+    }
 
     HistogramMap &yHistogramMap(m_xyHistogramMap[binX]);
     HistogramMap::iterator iter = yHistogramMap.find(binY);
@@ -679,14 +1007,28 @@ void TwoDHistogram::Fill(const float valueX, const float valueY, const float wei
         if (!yHistogramMap.insert(HistogramMap::value_type(binY, weight)).second)
             throw StatusCodeException(STATUS_CODE_FAILURE);
     }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
 
-    m_yxHistogramMap[binY][binX] = yHistogramMap[binY];
+void TwoDHistogram::Fill(const FloatVector &valuesX, const FloatVector &valuesY, const FloatVector &weights)
+{
+    if ((valuesX.size() != weights.size()) || (valuesY.size() != weights.size()))
+        throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
+
+    for (unsigned int index = 0, nEntries = weights.size(); index < nEntries; ++index)
+        this->Fill(valuesX[index], valuesY[index], weights[index]);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 void TwoDHistogram::Scale(const float scaleFactor)
 {
+    m_arePrefixSumsValid = false;
+
+    for (float &binContent : m_binContents)
+        binContent = (binContent * scaleFactor);
+
     for (TwoDHistogramMap::value_type &mapEntryX : m_xyHistogramMap)
     {
         for (HistogramMap::value_type &mapEntryY : mapEntryX.second)
@@ -694,14 +1036,112 @@ void TwoDHistogram::Scale(const float scaleFactor)
             mapEntryY.second = (mapEntryY.second * scaleFactor);
         }
     }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void TwoDHistogram::SetShouldCachePrefixSums(const bool shouldCachePrefixSums)
+{
+    m_shouldCachePrefixSums = shouldCachePrefixSums;
+    m_arePrefixSumsValid = false;
+
+    if (!m_shouldCachePrefixSums)
+    {
+        PrefixSumVector().swap(m_prefixSums);
+        PrefixSumVector().swap(m_prefixSumsX);
+        PrefixSumVector().swap(m_prefixSumsXX);
+        PrefixSumVector().swap(m_prefixSumsY);
+        PrefixSumVector().swap(m_prefixSumsYY);
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void TwoDHistogram::InitializeBinContents()
+{
+    const unsigned int nBinsX(static_cast<unsigned int>(m_nBinsX) + 2), nBinsY(static_cast<unsigned int>(m_nBinsY) + 2);
 
-    for (TwoDHistogramMap::value_type &mapEntryY : m_yxHistogramMap)
+    if ((nBinsX <= MAX_DENSE_BINS) && (nBinsY <= MAX_DENSE_BINS / nBinsX))
+        m_binContents.assign(nBinsX * nBinsY, 0.f);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool TwoDHistogram::UsePrefixSums() const
+{
+    if (!m_shouldCachePrefixSums || m_binContents.empty())
+        return false;
+
+    if (m_arePrefixSumsValid)
+        return true;
+
+    // ATTN Summed-area tables carry a leading row and column of zeros, so row (column) index i + 1 accumulates dense rows (columns) up to i
+    const unsigned int nBinsX(static_cast<unsigned int>(m_nBinsX) + 2), nBinsY(static_cast<unsigned int>(m_nBinsY) + 2), tableWidth(nBinsX + 1);
+    const float firstBinXCenter(m_xLow + (0.5f * m_xBinWidth)), firstBinYCenter(m_yLow + (0.5f * m_yBinWidth));
+
+    m_prefixSums.assign(tableWidth * (nBinsY + 1), 0.);
+    m_prefixSumsX.assign(tableWidth * (nBinsY + 1), 0.);
+    m_prefixSumsXX.assign(tableWidth * (nBinsY + 1), 0.);
+    m_prefixSumsY.assign(tableWidth * (nBinsY + 1), 0.);
+    m_prefixSumsYY.assign(tableWidth * (nBinsY + 1), 0.);
+
+    for (unsigned int yIndex = 0; yIndex < nBinsY; ++yIndex)
     {
-        for (HistogramMap::value_type &mapEntryX : mapEntryY.second)
+        const int yBin(static_cast<int>(yIndex) + this->GetUnderflowBinNumberY());
+        const double binYCenter(firstBinYCenter + (m_yBinWidth * static_cast<float>(yBin)));
+        double rowSum(0.), rowSumX(0.), rowSumXX(0.), rowSumY(0.), rowSumYY(0.);
+
+        for (unsigned int xIndex = 0; xIndex < nBinsX; ++xIndex)
         {
-            mapEntryX.second = (mapEntryX.second * scaleFactor);
+            const int xBin(static_cast<int>(xIndex) + this->GetUnderflowBinNumberX());
+            const double binXCenter(firstBinXCenter + (m_xBinWidth * static_cast<float>(xBin)));
+            const double binContents(m_binContents[yIndex * nBinsX + xIndex]);
+
+            rowSum += binContents;
+            rowSumX += binContents * binXCenter;
+            rowSumXX += binContents * binXCenter * binXCenter;
+            rowSumY += binContents * binYCenter;
+            rowSumYY += binContents * binYCenter * binYCenter;
+
+            const unsigned int tableIndex((yIndex + 1) * tableWidth + xIndex + 1);
+            m_prefixSums[tableIndex] = m_prefixSums[tableIndex - tableWidth] + rowSum;
+            m_prefixSumsX[tableIndex] = m_prefixSumsX[tableIndex - tableWidth] + rowSumX;
+            m_prefixSumsXX[tableIndex] = m_prefixSumsXX[tableIndex - tableWidth] + rowSumXX;
+            m_prefixSumsY[tableIndex] = m_prefixSumsY[tableIndex - tableWidth] + rowSumY;
+            m_prefixSumsYY[tableIndex] = m_prefixSumsYY[tableIndex - tableWidth] + rowSumYY;
         }
     }
+
+    m_arePrefixSumsValid = true;
+    return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void TwoDHistogram::GetRangeSums(const int xLowBin, const int xHighBin, const int yLowBin, const int yHighBin, double &sum, double &sumX,
+    double &sumXX, double &sumY, double &sumYY) const
+{
+    sum = 0.; sumX = 0.; sumXX = 0.; sumY = 0.; sumYY = 0.;
+
+    if ((xLowBin > xHighBin) || (yLowBin > yHighBin))
+        return;
+
+    sum = this->GetTableSum(m_prefixSums, xLowBin, xHighBin, yLowBin, yHighBin);
+    sumX = this->GetTableSum(m_prefixSumsX, xLowBin, xHighBin, yLowBin, yHighBin);
+    sumXX = this->GetTableSum(m_prefixSumsXX, xLowBin, xHighBin, yLowBin, yHighBin);
+    sumY = this->GetTableSum(m_prefixSumsY, xLowBin, xHighBin, yLowBin, yHighBin);
+    sumYY = this->GetTableSum(m_prefixSumsYY, xLowBin, xHighBin, yLowBin, yHighBin);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+double TwoDHistogram::GetTableSum(const std::vector<double> &table, const int xLowBin, const int xHighBin, const int yLowBin, const int yHighBin) const
+{
+    const unsigned int tableWidth(static_cast<unsigned int>(m_nBinsX) + 3);
+    const unsigned int lowRow(yLowBin + 1), highRow(yHighBin + 2), lowColumn(xLowBin + 1), highColumn(xHighBin + 2);
+
+    return (table[highRow * tableWidth + highColumn] - table[lowRow * tableWidth + highColumn] -
+        table[highRow * tableWidth + lowColumn] + table[lowRow * tableWidth + lowColumn]);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -755,4 +1195,151 @@ void TwoDHistogram::WriteToXml(TiXmlDocument *const pTiXmlDocument, const std::s
     pTiXmlDocument->LinkEndChild(pHistogramElement);
 }
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void TwoDHistogram::WriteToBinary(std::ostream &binaryStream) const
+{
+    const unsigned int nDenseBins(m_binContents.size());
+    unsigned int nSparseBins(0);
+
+    for (const TwoDHistogramMap::value_type &mapEntryX : m_xyHistogramMap)
+        nSparseBins += mapEntryX.second.size();
+
+    TwoDHistogram::WriteBinaryValues(&TWOD_HISTOGRAM_BINARY_ID, 1, binaryStream);
+    TwoDHistogram::WriteBinaryValues(&HISTOGRAM_BINARY_VERSION, 1, binaryStream);
+    TwoDHistogram::WriteBinaryValues(&m_nBinsX, 1, binaryStream);
+    TwoDHistogram::WriteBinaryValues(&m_xLow, 1, binaryStream);
+    TwoDHistogram::WriteBinaryValues(&m_xHigh, 1, binaryStream);
+    TwoDHistogram::WriteBinaryValues(&m_nBinsY, 1, binaryStream);
+    TwoDHistogram::WriteBinaryValues(&m_yLow, 1, binaryStream);
+    TwoDHistogram::WriteBinaryValues(&m_yHigh, 1, binaryStream);
+    TwoDHistogram::WriteBinaryValues(&nDenseBins, 1, binaryStream);
+    TwoDHistogram::WriteBinaryValues(m_binContents.data(), nDenseBins, binaryStream);
+    TwoDHistogram::WriteBinaryValues(&nSparseBins, 1, binaryStream);
+
+    for (const TwoDHistogramMap::value_type &mapEntryX : m_xyHistogramMap)
+    {
+        for (const HistogramMap::value_type &mapEntryY : mapEntryX.second)
+        {
+            TwoDHistogram::WriteBinaryValues(&mapEntryX.first, 1, binaryStream);
+            TwoDHistogram::WriteBinaryValues(&mapEntryY.first, 1, binaryStream);
+            TwoDHistogram::WriteBinaryValues(&mapEntryY.second, 1, binaryStream);
+        }
+    }
+
+    if (!binaryStream.good())
+        throw StatusCodeException(STATUS_CODE_FAILURE);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+HistogramFillShards::HistogramFillShards(Histogram &histogram, const unsigned int nShards) :
+    m_histogram(histogram),
+    m_shardVector(nShards)
+{
+    if (0 == nShards)
+        throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
+
+    if (m_histogram.m_binContents.empty())
+        throw StatusCodeException(STATUS_CODE_NOT_ALLOWED);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+HistogramFillShards::~HistogramFillShards()
+{
+    this->Merge();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void HistogramFillShards::Fill(const float valueX, const float weight)
+{
+    const unsigned int shardIndex(ThreadPool::GetCurrentThreadIndex());
+
+    if (shardIndex >= m_shardVector.size())
+        throw StatusCodeException(STATUS_CODE_OUT_OF_RANGE);
+
+    // ATTN Shards are allocated by their own threads on first use, so threads that never fill the histogram cost nothing to merge
+    FloatVector &shard(m_shardVector[shardIndex]);
+
+    if (shard.empty())
+        shard.assign(m_histogram.m_binContents.size(), 0.f);
+
+    shard[m_histogram.GetBinNumber(valueX) + 1] += weight;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void HistogramFillShards::Merge()
+{
+    for (FloatVector &shard : m_shardVector)
+    {
+        if (shard.empty())
+            continue;
+
+        for (unsigned int index = 0, nBins = shard.size(); index < nBins; ++index)
+            m_histogram.m_binContents[index] += shard[index];
+
+        shard.clear();
+        m_histogram.m_arePrefixSumsValid = false;
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+TwoDHistogramFillShards::TwoDHistogramFillShards(TwoDHistogram &twoDHistogram, const unsigned int nShards) :
+    m_twoDHistogram(twoDHistogram),
+    m_shardVector(nShards)
+{
+    if (0 == nShards)
+        throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
+
+    if (m_twoDHistogram.m_binContents.empty())
+        throw StatusCodeException(STATUS_CODE_NOT_ALLOWED);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+TwoDHistogramFillShards::~TwoDHistogramFillShards()
+{
+    this->Merge();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void TwoDHistogramFillShards::Fill(const float valueX, const float valueY, const float weight)
+{
+    const unsigned int shardIndex(ThreadPool::GetCurrentThreadIndex());
+
+    if (shardIndex >= m_shardVector.size())
+        throw StatusCodeException(STATUS_CODE_OUT_OF_RANGE);
+
+    FloatVector &shard(m_shardVector[shardIndex]);
+
+    if (shard.empty())
+        shard.assign(m_twoDHistogram.m_binContents.size(), 0.f);
+
+    shard[m_twoDHistogram.GetDenseIndex(m_twoDHistogram.GetBinNumberX(valueX), m_twoDHistogram.GetBinNumberY(valueY))] += weight;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void TwoDHistogramFillShards::Merge()
+{
+    for (FloatVector &shard : m_shardVector)
+    {
+        if (shard.empty())
+            continue;
+
+        for (unsigned int index = 0, nBins = shard.size(); index < nBins; ++index)
+            m_twoDHistogram.m_binContents[index] += shard[index];
+
+        shard.clear();
+        m_twoDHistogram.m_arePrefixSumsValid = false;
+    }
+}
+
 } // namespace pandora
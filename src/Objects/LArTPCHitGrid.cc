@@ -0,0 +1,195 @@
+/**
+ *  @file   PandoraSDK/src/Objects/LArTPCHitGrid.cc
+ *
+ *  @brief  Implementation of the lar tpc hit grid class.
+ *
+ *  $Log: $
+ */
+
+#include "Geometry/LArTPC.h"
+
+#include "Objects/CaloHit.h"
+#include "Objects/LArTPCHitGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace pandora
+{
+
+LArTPCHitGrid::LArTPCHitGrid() :
+    m_pLArTPC(nullptr),
+    m_hitType(HIT_CUSTOM),
+    m_nDriftBins(0),
+    m_nWireBins(0),
+    m_driftMin(0.f),
+    m_wireMin(0.f),
+    m_driftBinWidth(0.f),
+    m_wireBinWidth(0.f),
+    m_cellOffsets(1, 0)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool LArTPCHitGrid::GetCell(const CartesianVector &positionVector, unsigned int &driftBin, unsigned int &wireBin) const
+{
+    if (m_caloHitVector.empty())
+        return false;
+
+    const float drift(std::floor((positionVector.GetX() - m_driftMin) / m_driftBinWidth));
+    const float wire(std::floor((positionVector.GetZ() - m_wireMin) / m_wireBinWidth));
+
+    if (!(drift >= 0.f) || !(drift < static_cast<float>(m_nDriftBins)) || !(wire >= 0.f) || !(wire < static_cast<float>(m_nWireBins)))
+        return false;
+
+    driftBin = static_cast<unsigned int>(drift);
+    wireBin = static_cast<unsigned int>(wire);
+    return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode LArTPCHitGrid::GetCellCaloHits(const unsigned int driftBin, const unsigned int wireBin, CaloHitVector &caloHitVector) const
+{
+    if ((driftBin >= m_nDriftBins) || (wireBin >= m_nWireBins))
+        return STATUS_CODE_OUT_OF_RANGE;
+
+    const unsigned int cellIndex(driftBin * m_nWireBins + wireBin);
+    caloHitVector.insert(caloHitVector.end(), m_caloHitVector.begin() + m_cellOffsets[cellIndex], m_caloHitVector.begin() + m_cellOffsets[cellIndex + 1]);
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode LArTPCHitGrid::GetNeighbourhoodCaloHits(const CartesianVector &positionVector, const unsigned int nDriftBins, const unsigned int nWireBins,
+    CaloHitVector &caloHitVector) const
+{
+    unsigned int driftBin(0), wireBin(0);
+
+    if (!this->GetCell(positionVector, driftBin, wireBin))
+        return STATUS_CODE_OUT_OF_RANGE;
+
+    const unsigned int firstDriftBin((driftBin > nDriftBins) ? driftBin - nDriftBins : 0);
+    const unsigned int lastDriftBin((m_nDriftBins - 1 - driftBin > nDriftBins) ? driftBin + nDriftBins : m_nDriftBins - 1);
+    const unsigned int firstWireBin((wireBin > nWireBins) ? wireBin - nWireBins : 0);
+    const unsigned int lastWireBin((m_nWireBins - 1 - wireBin > nWireBins) ? wireBin + nWireBins : m_nWireBins - 1);
+
+    // ATTN Cells adjacent in wire bin are contiguous, so the calo hits of each drift bin within the window form a single range
+    for (unsigned int iDrift = firstDriftBin; iDrift <= lastDriftBin; ++iDrift)
+    {
+        const unsigned int rowOffset(iDrift * m_nWireBins);
+        caloHitVector.insert(caloHitVector.end(), m_caloHitVector.begin() + m_cellOffsets[rowOffset + firstWireBin],
+            m_caloHitVector.begin() + m_cellOffsets[rowOffset + lastWireBin + 1]);
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode LArTPCHitGrid::Fill(const LArTPC *const pLArTPC, const HitType hitType, const float driftBinWidth, const CaloHitVector &caloHitVector)
+{
+    this->Clear();
+
+    if (!pLArTPC || !(driftBinWidth > 0.f) || !std::isfinite(driftBinWidth))
+        return STATUS_CODE_INVALID_PARAMETER;
+
+    const float wireBinWidth((TPC_VIEW_U == hitType) ? pLArTPC->GetWirePitchU() : (TPC_VIEW_V == hitType) ? pLArTPC->GetWirePitchV() :
+        (TPC_VIEW_W == hitType) ? pLArTPC->GetWirePitchW() : 0.f);
+
+    if (!(wireBinWidth > 0.f) || !std::isfinite(wireBinWidth))
+        return STATUS_CODE_INVALID_PARAMETER;
+
+    float wireLow(std::numeric_limits<float>::max()), wireHigh(-std::numeric_limits<float>::max());
+
+    for (const CaloHit *const pCaloHit : caloHitVector)
+    {
+        const CartesianVector &positionVector(pCaloHit->GetPositionVector());
+
+        if (!std::isfinite(positionVector.GetX()) || !std::isfinite(positionVector.GetZ()))
+            return STATUS_CODE_INVALID_PARAMETER;
+
+        wireLow = std::min(wireLow, positionVector.GetZ());
+        wireHigh = std::max(wireHigh, positionVector.GetZ());
+    }
+
+    const float driftMin(pLArTPC->GetCenterX() - 0.5f * pLArTPC->GetWidthX());
+    const double nDriftBins(std::max(1.0, std::ceil(static_cast<double>(pLArTPC->GetWidthX()) / driftBinWidth)));
+    const float wireMin(caloHitVector.empty() ? 0.f : std::floor(wireLow / wireBinWidth) * wireBinWidth);
+    const double nWireBins(caloHitVector.empty() ? 0.0 : std::floor(static_cast<double>(wireHigh - wireMin) / wireBinWidth) + 1.0);
+
+    // ATTN The cell offsets index the calo hit vector, so the number of cells must be representable
+    if (!(nDriftBins * nWireBins < static_cast<double>(std::numeric_limits<unsigned int>::max())))
+        return STATUS_CODE_OUT_OF_RANGE;
+
+    m_pLArTPC = pLArTPC;
+    m_hitType = hitType;
+    m_nDriftBins = static_cast<unsigned int>(nDriftBins);
+    m_nWireBins = static_cast<unsigned int>(nWireBins);
+    m_driftMin = driftMin;
+    m_wireMin = wireMin;
+    m_driftBinWidth = driftBinWidth;
+    m_wireBinWidth = wireBinWidth;
+
+    const unsigned int nCells(m_nDriftBins * m_nWireBins);
+    m_cellOffsets.assign(nCells + 1, 0);
+
+    UIntVector cellIndices;
+    cellIndices.reserve(caloHitVector.size());
+
+    for (const CaloHit *const pCaloHit : caloHitVector)
+    {
+        const CartesianVector &positionVector(pCaloHit->GetPositionVector());
+        const unsigned int driftBin(LArTPCHitGrid::GetClampedBin(positionVector.GetX(), m_driftMin, m_driftBinWidth, m_nDriftBins));
+        const unsigned int wireBin(LArTPCHitGrid::GetClampedBin(positionVector.GetZ(), m_wireMin, m_wireBinWidth, m_nWireBins));
+        cellIndices.push_back(driftBin * m_nWireBins + wireBin);
+        ++m_cellOffsets[cellIndices.back() + 1];
+    }
+
+    for (unsigned int iCell = 0; iCell < nCells; ++iCell)
+        m_cellOffsets[iCell + 1] += m_cellOffsets[iCell];
+
+    UIntVector insertPositions(m_cellOffsets.begin(), m_cellOffsets.end() - 1);
+    m_caloHitVector.resize(caloHitVector.size());
+
+    for (unsigned int listIndex = 0; listIndex < caloHitVector.size(); ++listIndex)
+        m_caloHitVector[insertPositions[cellIndices[listIndex]]++] = caloHitVector[listIndex];
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void LArTPCHitGrid::Clear()
+{
+    m_pLArTPC = nullptr;
+    m_hitType = HIT_CUSTOM;
+    m_nDriftBins = 0;
+    m_nWireBins = 0;
+    m_driftMin = 0.f;
+    m_wireMin = 0.f;
+    m_driftBinWidth = 0.f;
+    m_wireBinWidth = 0.f;
+    m_cellOffsets.assign(1, 0);
+    m_caloHitVector.clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+unsigned int LArTPCHitGrid::GetClampedBin(const float coordinate, const float minimum, const float binWidth, const unsigned int nBins)
+{
+    const float bin(std::floor((coordinate - minimum) / binWidth));
+
+    if (!(bin > 0.f))
+        return 0;
+
+    if (!(bin < static_cast<float>(nBins)))
+        return nBins - 1;
+
+    return static_cast<unsigned int>(bin);
+}
+
+} // namespace pandora
@@ -6,9 +6,12 @@
  *  $Log: $
  */
 
+#include "Helpers/SortingHelper.h"
+
 #include "Objects/MCParticle.h"
 
 #include <algorithm>
+#include <limits>
 
 namespace pandora
 {
@@ -51,7 +54,11 @@ MCParticle::MCParticle(const object_creation::MCParticle::Parameters &parameters
     m_outerRadius(parameters.m_endpoint.Get().GetMagnitude()),
     m_particleId(parameters.m_particleId.Get()),
     m_mcParticleType(parameters.m_mcParticleType.Get()),
-    m_pPfoTarget(nullptr)
+    m_eventId(parameters.m_eventId.IsInitialized() ? parameters.m_eventId.Get() : 0),
+    m_index(std::numeric_limits<unsigned int>::max()),
+    m_indexGeneration(0),
+    m_pPfoTarget(nullptr),
+    m_sortKey(SortingHelper::GetPositionSortKey(m_vertex))
 {
 }
 
@@ -63,50 +70,10 @@ MCParticle::~MCParticle()
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-StatusCode MCParticle::AddDaughter(const MCParticle *const pMCParticle)
-{
-    if (m_daughterList.end() != std::find(m_daughterList.begin(), m_daughterList.end(), pMCParticle))
-        return STATUS_CODE_ALREADY_PRESENT;
-
-    m_daughterList.push_back(pMCParticle);
-    return STATUS_CODE_SUCCESS;
-}
-
-//------------------------------------------------------------------------------------------------------------------------------------------
-
-StatusCode MCParticle::AddParent(const MCParticle *const pMCParticle)
-{
-    if (m_parentList.end() != std::find(m_parentList.begin(), m_parentList.end(), pMCParticle))
-        return STATUS_CODE_ALREADY_PRESENT;
-
-    m_parentList.push_back(pMCParticle);
-    return STATUS_CODE_SUCCESS;
-}
-
-//------------------------------------------------------------------------------------------------------------------------------------------
-
-StatusCode MCParticle::RemoveDaughter(const MCParticle *const pMCParticle)
+void MCParticle::SetRelationships(const MCParticleRange &parentRange, const MCParticleRange &daughterRange)
 {
-    MCParticleList::iterator iter = std::find(m_daughterList.begin(), m_daughterList.end(), pMCParticle);
-
-    if (m_daughterList.end() == iter)
-        return STATUS_CODE_NOT_FOUND;
-
-    m_daughterList.erase(iter);
-    return STATUS_CODE_SUCCESS;
-}
-
-//------------------------------------------------------------------------------------------------------------------------------------------
-
-StatusCode MCParticle::RemoveParent(const MCParticle *const pMCParticle)
-{
-    MCParticleList::iterator iter = std::find(m_parentList.begin(), m_parentList.end(), pMCParticle);
-
-    if (m_parentList.end() == iter)
-        return STATUS_CODE_NOT_FOUND;
-
-    m_parentList.erase(iter);
-    return STATUS_CODE_SUCCESS;
+    m_parentRange = parentRange;
+    m_daughterRange = daughterRange;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -9,6 +9,10 @@
 #include "Objects/CaloHit.h"
 #include "Objects/OrderedCaloHitList.h"
 
+#ifdef PANDORA_POOLED_OBJECT_ALLOCATION
+#include "Pandora/ObjectPool.h"
+#endif
+
 #include <algorithm>
 
 namespace pandora
@@ -30,21 +34,98 @@ OrderedCaloHitList::OrderedCaloHitList(const OrderedCaloHitList &rhs)
 OrderedCaloHitList::~OrderedCaloHitList()
 {
     for (const value_type &entry : m_theList)
-        delete entry.second;
+        OrderedCaloHitList::DeleteCaloHitList(entry.second);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 StatusCode OrderedCaloHitList::Add(const OrderedCaloHitList &rhs)
 {
+    if (this == &rhs)
+        return (rhs.empty() ? STATUS_CODE_SUCCESS : STATUS_CODE_ALREADY_PRESENT);
+
+    // ATTN Both lists are ordered by pseudo layer, so the layers can be matched in a single pass
+    TheList::iterator iter = m_theList.begin();
+
+    for (const value_type &rhsEntry : rhs)
+    {
+        if (rhsEntry.second->empty())
+            continue;
+
+        while ((m_theList.end() != iter) && (iter->first < rhsEntry.first))
+            ++iter;
+
+        if ((m_theList.end() == iter) || (iter->first != rhsEntry.first))
+        {
+            CaloHitList *const pCaloHitList = OrderedCaloHitList::CreateCaloHitList();
+            pCaloHitList->insert(pCaloHitList->end(), rhsEntry.second->begin(), rhsEntry.second->end());
+            iter = m_theList.insert(iter, TheList::value_type(rhsEntry.first, pCaloHitList));
+        }
+        else
+        {
+            if (OrderedCaloHitList::HasCommonCaloHits(*iter->second, *rhsEntry.second))
+                return STATUS_CODE_ALREADY_PRESENT;
+
+            iter->second->insert(iter->second->end(), rhsEntry.second->begin(), rhsEntry.second->end());
+        }
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode OrderedCaloHitList::Transfer(OrderedCaloHitList &rhs)
+{
+    if (this == &rhs)
+        return (rhs.empty() ? STATUS_CODE_SUCCESS : STATUS_CODE_ALREADY_PRESENT);
+
+    // ATTN Check for duplicate hits before any changes are made, so that a failure leaves both lists unmodified
+    TheList::const_iterator checkIter = m_theList.begin();
+
     for (const value_type &rhsEntry : rhs)
     {
-        for (const CaloHit *const pCaloHit : *rhsEntry.second)
+        while ((m_theList.end() != checkIter) && (checkIter->first < rhsEntry.first))
+            ++checkIter;
+
+        if (m_theList.end() == checkIter)
+            break;
+
+        if (checkIter->first != rhsEntry.first)
+            continue;
+
+        if (OrderedCaloHitList::HasCommonCaloHits(*checkIter->second, *rhsEntry.second))
+            return STATUS_CODE_ALREADY_PRESENT;
+    }
+
+    TheList::iterator iter = m_theList.begin();
+
+    for (TheList::iterator rhsIter = rhs.m_theList.begin(), rhsIterEnd = rhs.m_theList.end(); rhsIter != rhsIterEnd; ++rhsIter)
+    {
+        if (rhsIter->second->empty())
+            continue;
+
+        while ((m_theList.end() != iter) && (iter->first < rhsIter->first))
+            ++iter;
+
+        if ((m_theList.end() == iter) || (iter->first != rhsIter->first))
         {
-            PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->Add(pCaloHit, rhsEntry.first));
+            iter = m_theList.insert(iter, TheList::value_type(rhsIter->first, rhsIter->second));
+            rhsIter->second = nullptr;
+        }
+        else
+        {
+            iter->second->insert(iter->second->end(), rhsIter->second->begin(), rhsIter->second->end());
         }
     }
 
+    for (const value_type &rhsEntry : rhs.m_theList)
+    {
+        if (rhsEntry.second)
+            OrderedCaloHitList::DeleteCaloHitList(rhsEntry.second);
+    }
+
+    rhs.m_theList.clear();
     return STATUS_CODE_SUCCESS;
 }
 
@@ -52,11 +133,55 @@ StatusCode OrderedCaloHitList::Add(const OrderedCaloHitList &rhs)
 
 StatusCode OrderedCaloHitList::Remove(const OrderedCaloHitList &rhs)
 {
+    if (this == &rhs)
+    {
+        this->Reset();
+        return STATUS_CODE_SUCCESS;
+    }
+
+    // ATTN Both lists are ordered by pseudo layer, so the layers can be matched in a single pass
+    TheList::iterator iter = m_theList.begin();
+
     for (const value_type &rhsEntry : rhs)
     {
-        for (const CaloHit *const pCaloHit : *rhsEntry.second)
+        while ((m_theList.end() != iter) && (iter->first < rhsEntry.first))
+            ++iter;
+
+        if (m_theList.end() == iter)
+            break;
+
+        if (iter->first != rhsEntry.first)
+            continue;
+
+        if (iter->second->size() * rhsEntry.second->size() <= MAX_LINEAR_SEARCH_PRODUCT)
+        {
+            for (const CaloHit *const pCaloHit : *rhsEntry.second)
+            {
+                CaloHitList::iterator caloHitIter = std::find(iter->second->begin(), iter->second->end(), pCaloHit);
+
+                if (iter->second->end() != caloHitIter)
+                    caloHitIter = iter->second->erase(caloHitIter);
+            }
+        }
+        else
         {
-            PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, this->Remove(pCaloHit, rhsEntry.first));
+            // ATTN Rebuild the layer from the hits to keep, rather than erasing hits one at a time from the middle of the layer
+            const CaloHitSet caloHitsToRemove(rhsEntry.second->begin(), rhsEntry.second->end());
+            CaloHitList caloHitsToKeep;
+
+            for (const CaloHit *const pCaloHit : *iter->second)
+            {
+                if (!caloHitsToRemove.count(pCaloHit))
+                    caloHitsToKeep.push_back(pCaloHit);
+            }
+
+            *iter->second = caloHitsToKeep;
+        }
+
+        if (iter->second->empty())
+        {
+            OrderedCaloHitList::DeleteCaloHitList(iter->second);
+            iter = m_theList.erase(iter);
         }
     }
 
@@ -67,24 +192,45 @@ StatusCode OrderedCaloHitList::Remove(const OrderedCaloHitList &rhs)
 
 StatusCode OrderedCaloHitList::Add(const CaloHitList &caloHitList)
 {
-    for (const CaloHit *const pCaloHit : caloHitList)
+    if (caloHitList.size() * caloHitList.size() <= MAX_LINEAR_SEARCH_PRODUCT)
     {
-        PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, this->Add(pCaloHit, pCaloHit->GetPseudoLayer()));
+        for (const CaloHit *const pCaloHit : caloHitList)
+        {
+            PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, this->Add(pCaloHit, pCaloHit->GetPseudoLayer()));
+        }
+
+        return STATUS_CODE_SUCCESS;
     }
 
-    return STATUS_CODE_SUCCESS;
+    // ATTN Group the hits by pseudo layer, then merge the layers in a single pass, leaving this list unmodified if any hit is present twice
+    if (CaloHitSet(caloHitList.begin(), caloHitList.end()).size() != caloHitList.size())
+        return STATUS_CODE_ALREADY_PRESENT;
+
+    OrderedCaloHitList newCaloHits;
+    newCaloHits.FillWithoutChecks(caloHitList);
+
+    return this->Transfer(newCaloHits);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 StatusCode OrderedCaloHitList::Remove(const CaloHitList &caloHitList)
 {
-    for (const CaloHit *const pCaloHit : caloHitList)
+    if (caloHitList.size() * caloHitList.size() <= MAX_LINEAR_SEARCH_PRODUCT)
     {
-        PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, this->Remove(pCaloHit, pCaloHit->GetPseudoLayer()));
+        for (const CaloHit *const pCaloHit : caloHitList)
+        {
+            PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, this->Remove(pCaloHit, pCaloHit->GetPseudoLayer()));
+        }
+
+        return STATUS_CODE_SUCCESS;
     }
 
-    return STATUS_CODE_SUCCESS;
+    // ATTN Group the hits by pseudo layer, then remove them layer by layer in a single pass; absent hits are ignored, as before
+    OrderedCaloHitList oldCaloHits;
+    oldCaloHits.FillWithoutChecks(caloHitList);
+
+    return this->Remove(oldCaloHits);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -118,7 +264,7 @@ unsigned int OrderedCaloHitList::GetNCaloHitsInPseudoLayer(const unsigned int ps
 void OrderedCaloHitList::Reset()
 {
     for (const value_type &entry : m_theList)
-        delete entry.second;
+        OrderedCaloHitList::DeleteCaloHitList(entry.second);
 
     this->clear();
 
@@ -138,6 +284,28 @@ void OrderedCaloHitList::FillCaloHitList(CaloHitList &caloHitList) const
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+void OrderedCaloHitList::FillCaloHitVector(CaloHitVector &caloHitVector) const
+{
+    caloHitVector.reserve(caloHitVector.size() + this->GetNCaloHits());
+
+    for (const value_type &entry : m_theList)
+        caloHitVector.insert(caloHitVector.end(), entry.second->begin(), entry.second->end());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+unsigned int OrderedCaloHitList::GetNCaloHits() const
+{
+    unsigned int nCaloHits(0);
+
+    for (const value_type &entry : m_theList)
+        nCaloHits += entry.second->size();
+
+    return nCaloHits;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 bool OrderedCaloHitList::operator= (const OrderedCaloHitList &rhs)
 {
     if (this == &rhs)
@@ -157,12 +325,12 @@ StatusCode OrderedCaloHitList::Add(const CaloHit *const pCaloHit, const unsigned
 
     if (m_theList.end() == iter)
     {
-        CaloHitList *const pCaloHitList = new CaloHitList;
+        CaloHitList *const pCaloHitList = OrderedCaloHitList::CreateCaloHitList();
         pCaloHitList->push_back(pCaloHit);
 
         if (!(m_theList.insert(TheList::value_type(pseudoLayer, pCaloHitList)).second))
         {
-            delete pCaloHitList;
+            OrderedCaloHitList::DeleteCaloHitList(pCaloHitList);
             return STATUS_CODE_FAILURE;
         }
     }
@@ -195,11 +363,79 @@ StatusCode OrderedCaloHitList::Remove(const CaloHit *const pCaloHit, const unsig
 
     if (listIter->second->empty())
     {
-        delete listIter->second;
+        OrderedCaloHitList::DeleteCaloHitList(listIter->second);
         listIter = m_theList.erase(listIter);
     }
 
     return STATUS_CODE_SUCCESS;
 }
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void OrderedCaloHitList::FillWithoutChecks(const CaloHitList &caloHitList)
+{
+    for (const CaloHit *const pCaloHit : caloHitList)
+    {
+        const unsigned int pseudoLayer(pCaloHit->GetPseudoLayer());
+        TheList::iterator iter = m_theList.find(pseudoLayer);
+
+        if (m_theList.end() == iter)
+            iter = m_theList.insert(TheList::value_type(pseudoLayer, OrderedCaloHitList::CreateCaloHitList())).first;
+
+        iter->second->push_back(pCaloHit);
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool OrderedCaloHitList::HasCommonCaloHits(const CaloHitList &caloHitList, const CaloHitList &otherCaloHitList)
+{
+    if (caloHitList.size() * otherCaloHitList.size() <= MAX_LINEAR_SEARCH_PRODUCT)
+    {
+        for (const CaloHit *const pCaloHit : otherCaloHitList)
+        {
+            if (caloHitList.end() != std::find(caloHitList.begin(), caloHitList.end(), pCaloHit))
+                return true;
+        }
+
+        return false;
+    }
+
+    const bool isSmaller(caloHitList.size() < otherCaloHitList.size());
+    const CaloHitList &smallerList(isSmaller ? caloHitList : otherCaloHitList);
+    const CaloHitList &largerList(isSmaller ? otherCaloHitList : caloHitList);
+    const CaloHitSet caloHitSet(smallerList.begin(), smallerList.end());
+
+    for (const CaloHit *const pCaloHit : largerList)
+    {
+        if (caloHitSet.count(pCaloHit))
+            return true;
+    }
+
+    return false;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+CaloHitList *OrderedCaloHitList::CreateCaloHitList()
+{
+#ifdef PANDORA_POOLED_OBJECT_ALLOCATION
+    return new (ObjectPool<CaloHitList>::Allocate(sizeof(CaloHitList))) CaloHitList;
+#else
+    return new CaloHitList;
+#endif
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void OrderedCaloHitList::DeleteCaloHitList(CaloHitList *const pCaloHitList)
+{
+#ifdef PANDORA_POOLED_OBJECT_ALLOCATION
+    pCaloHitList->~CaloHitList();
+    ObjectPool<CaloHitList>::Deallocate(pCaloHitList, sizeof(CaloHitList));
+#else
+    delete pCaloHitList;
+#endif
+}
+
 } // namespace pandora
@@ -11,7 +11,10 @@
 #include "Objects/ParticleFlowObject.h"
 #include "Objects/Track.h"
 
+#include "Pandora/ObjectPool.h"
+
 #include <algorithm>
+#include <limits>
 
 namespace pandora
 {
@@ -25,10 +28,35 @@ ParticleFlowObject::ParticleFlowObject(const object_creation::ParticleFlowObject
     m_trackList(parameters.m_trackList),
     m_clusterList(parameters.m_clusterList),
     m_vertexList(parameters.m_vertexList),
-    m_propertiesMap(parameters.m_propertiesToAdd)
+    m_propertiesMap(parameters.m_propertiesToAdd),
+    m_modificationEpoch(0),
+    m_eventId(0),
+    m_index(std::numeric_limits<unsigned int>::max()),
+    m_indexGeneration(0)
 {
     if (!parameters.m_propertiesToRemove.empty())
         throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
+
+    if (!m_clusterList.empty())
+    {
+        m_eventId = (*m_clusterList.begin())->GetEventId();
+    }
+    else if (!m_trackList.empty())
+    {
+        m_eventId = (*m_trackList.begin())->GetEventId();
+    }
+
+    for (const Cluster *const pCluster : m_clusterList)
+    {
+        if (pCluster->GetEventId() != m_eventId)
+            throw StatusCodeException(STATUS_CODE_NOT_ALLOWED);
+    }
+
+    for (const Track *const pTrack : m_trackList)
+    {
+        if (pTrack->GetEventId() != m_eventId)
+            throw StatusCodeException(STATUS_CODE_NOT_ALLOWED);
+    }
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -41,6 +69,8 @@ ParticleFlowObject::~ParticleFlowObject()
 
 StatusCode ParticleFlowObject::AlterMetadata(const object_creation::ParticleFlowObject::Metadata &metadata)
 {
+    ++m_modificationEpoch;
+
     if (!metadata.m_propertiesToAdd.empty() || !metadata.m_propertiesToRemove.empty())
         PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->UpdatePropertiesMap(metadata));
 
@@ -106,9 +136,21 @@ ClusterAddressList ParticleFlowObject::GetClusterAddressList() const
 template <>
 StatusCode ParticleFlowObject::AddToPfo(const Cluster *const pCluster)
 {
+    ++m_modificationEpoch;
+
     if (m_clusterList.end() != std::find(m_clusterList.begin(), m_clusterList.end(), pCluster))
         return STATUS_CODE_ALREADY_PRESENT;
 
+    // ATTN A pfo without clusters or tracks adopts the event id of its first such constituent
+    if (m_clusterList.empty() && m_trackList.empty())
+    {
+        m_eventId = pCluster->GetEventId();
+    }
+    else if (pCluster->GetEventId() != m_eventId)
+    {
+        return STATUS_CODE_NOT_ALLOWED;
+    }
+
     m_clusterList.push_back(pCluster);
     return STATUS_CODE_SUCCESS;
 }
@@ -116,9 +158,20 @@ StatusCode ParticleFlowObject::AddToPfo(const Cluster *const pCluster)
 template <>
 StatusCode ParticleFlowObject::AddToPfo(const Track *const pTrack)
 {
+    ++m_modificationEpoch;
+
     if (m_trackList.end() != std::find(m_trackList.begin(), m_trackList.end(), pTrack))
         return STATUS_CODE_ALREADY_PRESENT;
 
+    if (m_clusterList.empty() && m_trackList.empty())
+    {
+        m_eventId = pTrack->GetEventId();
+    }
+    else if (pTrack->GetEventId() != m_eventId)
+    {
+        return STATUS_CODE_NOT_ALLOWED;
+    }
+
     m_trackList.push_back(pTrack);
     return STATUS_CODE_SUCCESS;
 }
@@ -126,6 +179,8 @@ StatusCode ParticleFlowObject::AddToPfo(const Track *const pTrack)
 template <>
 StatusCode ParticleFlowObject::AddToPfo(const Vertex *const pVertex)
 {
+    ++m_modificationEpoch;
+
     if (m_vertexList.end() != std::find(m_vertexList.begin(), m_vertexList.end(), pVertex))
         return STATUS_CODE_ALREADY_PRESENT;
 
@@ -138,11 +193,15 @@ StatusCode ParticleFlowObject::AddToPfo(const Vertex *const pVertex)
 template <>
 StatusCode ParticleFlowObject::RemoveFromPfo(const Cluster *const pCluster)
 {
+    ++m_modificationEpoch;
+
     ClusterList::iterator iter = std::find(m_clusterList.begin(), m_clusterList.end(), pCluster);
 
     if (m_clusterList.end() == iter)
         return STATUS_CODE_NOT_FOUND;
 
+    // ATTN Advance past the removed cluster epoch, so that the pfo epoch summed with its cluster epochs still increases
+    m_modificationEpoch += pCluster->GetModificationEpoch();
     m_clusterList.erase(iter);
     return STATUS_CODE_SUCCESS;
 }
@@ -150,6 +209,8 @@ StatusCode ParticleFlowObject::RemoveFromPfo(const Cluster *const pCluster)
 template <>
 StatusCode ParticleFlowObject::RemoveFromPfo(const Track *const pTrack)
 {
+    ++m_modificationEpoch;
+
     TrackList::iterator iter = std::find(m_trackList.begin(), m_trackList.end(), pTrack);
 
     if (m_trackList.end() == iter)
@@ -162,6 +223,8 @@ StatusCode ParticleFlowObject::RemoveFromPfo(const Track *const pTrack)
 template <>
 StatusCode ParticleFlowObject::RemoveFromPfo(const Vertex *const pVertex)
 {
+    ++m_modificationEpoch;
+
     VertexList::iterator iter = std::find(m_vertexList.begin(), m_vertexList.end(), pVertex);
 
     if (m_vertexList.end() == iter)
@@ -175,6 +238,8 @@ StatusCode ParticleFlowObject::RemoveFromPfo(const Vertex *const pVertex)
 
 StatusCode ParticleFlowObject::AddParent(const ParticleFlowObject *const pPfo)
 {
+    ++m_modificationEpoch;
+
     if (!pPfo)
         return STATUS_CODE_INVALID_PARAMETER;
 
@@ -189,6 +254,8 @@ StatusCode ParticleFlowObject::AddParent(const ParticleFlowObject *const pPfo)
 
 StatusCode ParticleFlowObject::AddDaughter(const ParticleFlowObject *const pPfo)
 {
+    ++m_modificationEpoch;
+
     if (!pPfo)
         return STATUS_CODE_INVALID_PARAMETER;
 
@@ -203,6 +270,8 @@ StatusCode ParticleFlowObject::AddDaughter(const ParticleFlowObject *const pPfo)
 
 StatusCode ParticleFlowObject::RemoveParent(const ParticleFlowObject *const pPfo)
 {
+    ++m_modificationEpoch;
+
     PfoList::iterator iter = std::find(m_parentPfoList.begin(), m_parentPfoList.end(), pPfo);
 
     if (m_parentPfoList.end() == iter)
@@ -216,6 +285,8 @@ StatusCode ParticleFlowObject::RemoveParent(const ParticleFlowObject *const pPfo
 
 StatusCode ParticleFlowObject::RemoveDaughter(const ParticleFlowObject *const pPfo)
 {
+    ++m_modificationEpoch;
+
     PfoList::iterator iter = std::find(m_daughterPfoList.begin(), m_daughterPfoList.end(), pPfo);
 
     if (m_daughterPfoList.end() == iter)
@@ -227,6 +298,40 @@ StatusCode ParticleFlowObject::RemoveDaughter(const ParticleFlowObject *const pP
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+void ParticleFlowObject::RemoveParentsAndDaughters(const PfoSet &pfoSet)
+{
+    ++m_modificationEpoch;
+
+    PfoList parentPfoList, daughterPfoList;
+
+    for (const ParticleFlowObject *const pParentPfo : m_parentPfoList)
+    {
+        if (!pfoSet.count(pParentPfo))
+            parentPfoList.push_back(pParentPfo);
+    }
+
+    for (const ParticleFlowObject *const pDaughterPfo : m_daughterPfoList)
+    {
+        if (!pfoSet.count(pDaughterPfo))
+            daughterPfoList.push_back(pDaughterPfo);
+    }
+
+    m_parentPfoList = parentPfoList;
+    m_daughterPfoList = daughterPfoList;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void ParticleFlowObject::ClearParentsAndDaughters()
+{
+    ++m_modificationEpoch;
+
+    m_parentPfoList.clear();
+    m_daughterPfoList.clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 StatusCode ParticleFlowObject::UpdatePropertiesMap(const object_creation::ParticleFlowObject::Metadata &metadata)
 {
     for (const std::string &propertyName : metadata.m_propertiesToRemove)
@@ -247,4 +352,74 @@ StatusCode ParticleFlowObject::UpdatePropertiesMap(const object_creation::Partic
     return STATUS_CODE_SUCCESS;
 }
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+const ParticleFlowObject::ClusterAggregates &ParticleFlowObject::GetClusterAggregates() const
+{
+    // ATTN The summed epoch increases with any change to the pfo constituents or to the calo hits of its clusters
+    unsigned int modificationEpoch(m_modificationEpoch);
+
+    for (const Cluster *const pCluster : m_clusterList)
+        modificationEpoch += pCluster->GetModificationEpoch();
+
+    if (m_clusterAggregates.m_isInitialized && (modificationEpoch == m_clusterAggregates.m_modificationEpoch))
+        return m_clusterAggregates;
+
+    ClusterAggregates clusterAggregates;
+
+    for (const Cluster *const pCluster : m_clusterList)
+    {
+        clusterAggregates.m_nCaloHits += pCluster->GetNCaloHits();
+        clusterAggregates.m_nIsolatedCaloHits += pCluster->GetNIsolatedCaloHits();
+        clusterAggregates.m_electromagneticEnergy += pCluster->GetElectromagneticEnergy();
+        clusterAggregates.m_hadronicEnergy += pCluster->GetHadronicEnergy();
+
+        for (const OrderedCaloHitList::value_type &layerEntry : pCluster->GetOrderedCaloHitList())
+        {
+            for (const CaloHit *const pCaloHit : *layerEntry.second)
+            {
+                if (pCaloHit->GetHitType() < ClusterAggregates::m_nHitTypes)
+                    ++clusterAggregates.m_nCaloHitsByType[pCaloHit->GetHitType()];
+            }
+        }
+    }
+
+    clusterAggregates.m_modificationEpoch = modificationEpoch;
+    clusterAggregates.m_isInitialized = true;
+    m_clusterAggregates = clusterAggregates;
+
+    return m_clusterAggregates;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef PANDORA_POOLED_OBJECT_ALLOCATION
+void *ParticleFlowObject::operator new(std::size_t size)
+{
+    return ObjectPool<ParticleFlowObject>::Allocate(size);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void ParticleFlowObject::operator delete(void *pAddress, std::size_t size)
+{
+    ObjectPool<ParticleFlowObject>::Deallocate(pAddress, size);
+}
+#endif
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+ParticleFlowObject::ClusterAggregates::ClusterAggregates() :
+    m_nCaloHits(0),
+    m_nIsolatedCaloHits(0),
+    m_electromagneticEnergy(0.f),
+    m_hadronicEnergy(0.f),
+    m_modificationEpoch(0),
+    m_isInitialized(false)
+{
+    for (unsigned int index = 0; index < m_nHitTypes; ++index)
+        m_nCaloHitsByType[index] = 0;
+}
+
 } // namespace pandora
@@ -0,0 +1,102 @@
+/**
+ *  @file   PandoraSDK/src/Objects/PfoExportTable.cc
+ *
+ *  @brief  Implementation of the pfo export table class.
+ *
+ *  $Log: $
+ */
+
+#include "Objects/CaloHit.h"
+#include "Objects/Cluster.h"
+#include "Objects/ParticleFlowObject.h"
+#include "Objects/PfoExportTable.h"
+#include "Objects/Track.h"
+#include "Objects/Vertex.h"
+
+namespace pandora
+{
+
+void PfoExportTable::Fill(const PfoList &pfoList)
+{
+    m_pfoHierarchy.Fill(pfoList);
+    m_pfoToIndexMap.clear();
+    m_pfoRows.clear();
+    m_daughterIndices.clear();
+    m_caloHitParentAddresses.clear();
+    m_caloHitPfoIndices.clear();
+    m_trackParentAddresses.clear();
+    m_vertexPositions.clear();
+
+    const PfoVector &pfoVector(m_pfoHierarchy.GetPfoVector());
+    m_pfoRows.reserve(pfoVector.size());
+
+    for (unsigned int iPfo = 0; iPfo < pfoVector.size(); ++iPfo)
+        m_pfoToIndexMap[pfoVector[iPfo]] = iPfo;
+
+    for (unsigned int iPfo = 0; iPfo < pfoVector.size(); ++iPfo)
+    {
+        const ParticleFlowObject *const pPfo(pfoVector[iPfo]);
+
+        PfoRow pfoRow;
+        pfoRow.m_particleId = pPfo->GetParticleId();
+        pfoRow.m_charge = pPfo->GetCharge();
+        pfoRow.m_mass = pPfo->GetMass();
+        pfoRow.m_energy = pPfo->GetEnergy();
+        pfoRow.m_momentumX = pPfo->GetMomentum().GetX();
+        pfoRow.m_momentumY = pPfo->GetMomentum().GetY();
+        pfoRow.m_momentumZ = pPfo->GetMomentum().GetZ();
+        pfoRow.m_eventId = pPfo->GetEventId();
+        pfoRow.m_parentIndex = -1;
+
+        // ATTN Parents need not be in the table, as the hierarchy includes only the pfos in the list and their downstream pfos
+        for (const ParticleFlowObject *const pParentPfo : pPfo->GetParentPfoList())
+        {
+            PfoToIndexMap::const_iterator parentIter(m_pfoToIndexMap.find(pParentPfo));
+
+            if (m_pfoToIndexMap.end() != parentIter)
+            {
+                pfoRow.m_parentIndex = static_cast<int>(parentIter->second);
+                break;
+            }
+        }
+
+        pfoRow.m_daughterBegin = m_daughterIndices.size();
+
+        for (const ParticleFlowObject *const pDaughterPfo : pPfo->GetDaughterPfoList())
+            m_daughterIndices.push_back(m_pfoToIndexMap.at(pDaughterPfo));
+
+        pfoRow.m_daughterEnd = m_daughterIndices.size();
+        pfoRow.m_caloHitBegin = m_caloHitParentAddresses.size();
+
+        for (const Cluster *const pCluster : pPfo->GetClusterList())
+        {
+            for (const OrderedCaloHitList::value_type &layerEntry : pCluster->GetOrderedCaloHitList())
+            {
+                for (const CaloHit *const pCaloHit : *layerEntry.second)
+                    m_caloHitParentAddresses.push_back(pCaloHit->GetParentAddress());
+            }
+
+            for (const CaloHit *const pCaloHit : pCluster->GetIsolatedCaloHitList())
+                m_caloHitParentAddresses.push_back(pCaloHit->GetParentAddress());
+        }
+
+        pfoRow.m_caloHitEnd = m_caloHitParentAddresses.size();
+        m_caloHitPfoIndices.insert(m_caloHitPfoIndices.end(), pfoRow.m_caloHitEnd - pfoRow.m_caloHitBegin, iPfo);
+
+        pfoRow.m_trackBegin = m_trackParentAddresses.size();
+
+        for (const Track *const pTrack : pPfo->GetTrackList())
+            m_trackParentAddresses.push_back(pTrack->GetParentAddress());
+
+        pfoRow.m_trackEnd = m_trackParentAddresses.size();
+        pfoRow.m_vertexBegin = m_vertexPositions.size();
+
+        for (const Vertex *const pVertex : pPfo->GetVertexList())
+            m_vertexPositions.push_back(pVertex->GetPosition());
+
+        pfoRow.m_vertexEnd = m_vertexPositions.size();
+        m_pfoRows.push_back(pfoRow);
+    }
+}
+
+} // namespace pandora
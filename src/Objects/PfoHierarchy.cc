@@ -0,0 +1,174 @@
+/**
+ *  @file   PandoraSDK/src/Objects/PfoHierarchy.cc
+ *
+ *  @brief  Implementation of the pfo hierarchy class.
+ *
+ *  $Log: $
+ */
+
+#include "Objects/Cluster.h"
+#include "Objects/ParticleFlowObject.h"
+#include "Objects/PfoHierarchy.h"
+
+namespace pandora
+{
+
+void PfoHierarchy::Fill(const PfoList &pfoList)
+{
+    m_pfoVector.clear();
+    m_subtreeEnds.clear();
+    m_pfoToIndexMap.clear();
+    m_isForest = true;
+
+    for (const ParticleFlowObject *const pPfo : pfoList)
+    {
+        if (pPfo->GetNParentPfos() > 1)
+            m_isForest = false;
+
+        if (0 == pPfo->GetNParentPfos())
+            this->AddSubtree(pPfo);
+    }
+
+    // ATTN Pick up pfos not downstream of any pfo without parents, i.e. those whose parents are absent from the list or in a cycle
+    for (const ParticleFlowObject *const pPfo : pfoList)
+    {
+        if (!m_pfoToIndexMap.count(pPfo))
+            this->AddSubtree(pPfo);
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PfoHierarchy::GetDownstreamPfos(const ParticleFlowObject *const pPfo, PfoVector &pfoVector) const
+{
+    PfoToIndexMap::const_iterator iter(m_pfoToIndexMap.find(pPfo));
+
+    if (m_pfoToIndexMap.end() == iter)
+        return STATUS_CODE_NOT_FOUND;
+
+    if (m_isForest)
+    {
+        pfoVector.insert(pfoVector.end(), m_pfoVector.begin() + iter->second, m_pfoVector.begin() + m_subtreeEnds[iter->second]);
+        return STATUS_CODE_SUCCESS;
+    }
+
+    typedef std::pair<const ParticleFlowObject *, PfoList::const_iterator> WalkEntry;
+    std::vector<WalkEntry> walkStack;
+    std::vector<bool> isVisited(m_pfoVector.size(), false);
+
+    isVisited[iter->second] = true;
+    pfoVector.push_back(pPfo);
+    walkStack.push_back(WalkEntry(pPfo, pPfo->GetDaughterPfoList().begin()));
+
+    while (!walkStack.empty())
+    {
+        WalkEntry &walkEntry(walkStack.back());
+
+        if (walkEntry.first->GetDaughterPfoList().end() == walkEntry.second)
+        {
+            walkStack.pop_back();
+            continue;
+        }
+
+        const ParticleFlowObject *const pDaughterPfo(*(walkEntry.second++));
+        PfoToIndexMap::const_iterator daughterIter(m_pfoToIndexMap.find(pDaughterPfo));
+
+        // ATTN Daughters are always present, unless the hierarchy has been modified since the last fill
+        if (m_pfoToIndexMap.end() == daughterIter)
+            return STATUS_CODE_FAILURE;
+
+        if (isVisited[daughterIter->second])
+            continue;
+
+        isVisited[daughterIter->second] = true;
+        pfoVector.push_back(pDaughterPfo);
+        walkStack.push_back(WalkEntry(pDaughterPfo, pDaughterPfo->GetDaughterPfoList().begin()));
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PfoHierarchy::GetDownstreamClusters(const ParticleFlowObject *const pPfo, ClusterList &clusterList) const
+{
+    PfoVector pfoVector;
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetDownstreamPfos(pPfo, pfoVector));
+
+    for (const ParticleFlowObject *const pDownstreamPfo : pfoVector)
+        clusterList.insert(clusterList.end(), pDownstreamPfo->GetClusterList().begin(), pDownstreamPfo->GetClusterList().end());
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PfoHierarchy::GetDownstreamTracks(const ParticleFlowObject *const pPfo, TrackList &trackList) const
+{
+    PfoVector pfoVector;
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetDownstreamPfos(pPfo, pfoVector));
+
+    for (const ParticleFlowObject *const pDownstreamPfo : pfoVector)
+        trackList.insert(trackList.end(), pDownstreamPfo->GetTrackList().begin(), pDownstreamPfo->GetTrackList().end());
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PfoHierarchy::GetDownstreamCaloHits(const ParticleFlowObject *const pPfo, CaloHitList &caloHitList) const
+{
+    PfoVector pfoVector;
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetDownstreamPfos(pPfo, pfoVector));
+
+    for (const ParticleFlowObject *const pDownstreamPfo : pfoVector)
+    {
+        for (const Cluster *const pCluster : pDownstreamPfo->GetClusterList())
+        {
+            pCluster->GetOrderedCaloHitList().FillCaloHitList(caloHitList);
+            caloHitList.insert(caloHitList.end(), pCluster->GetIsolatedCaloHitList().begin(), pCluster->GetIsolatedCaloHitList().end());
+        }
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void PfoHierarchy::AddSubtree(const ParticleFlowObject *const pPfo)
+{
+    typedef std::pair<unsigned int, PfoList::const_iterator> WalkEntry;
+    std::vector<WalkEntry> walkStack;
+
+    m_pfoToIndexMap[pPfo] = m_pfoVector.size();
+    walkStack.push_back(WalkEntry(m_pfoVector.size(), pPfo->GetDaughterPfoList().begin()));
+    m_pfoVector.push_back(pPfo);
+    m_subtreeEnds.push_back(0);
+
+    while (!walkStack.empty())
+    {
+        WalkEntry &walkEntry(walkStack.back());
+
+        if (m_pfoVector[walkEntry.first]->GetDaughterPfoList().end() == walkEntry.second)
+        {
+            m_subtreeEnds[walkEntry.first] = m_pfoVector.size();
+            walkStack.pop_back();
+            continue;
+        }
+
+        const ParticleFlowObject *const pDaughterPfo(*(walkEntry.second++));
+
+        // ATTN A daughter already present has several parents, or lies in a cycle, so its subtree is not contiguous for all parents
+        if (!m_pfoToIndexMap.insert(PfoToIndexMap::value_type(pDaughterPfo, m_pfoVector.size())).second)
+        {
+            m_isForest = false;
+            continue;
+        }
+
+        walkStack.push_back(WalkEntry(m_pfoVector.size(), pDaughterPfo->GetDaughterPfoList().begin()));
+        m_pfoVector.push_back(pDaughterPfo);
+        m_subtreeEnds.push_back(0);
+    }
+}
+
+} // namespace pandora
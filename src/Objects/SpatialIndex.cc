@@ -0,0 +1,325 @@
+/**
+ *  @file   PandoraSDK/src/Objects/SpatialIndex.cc
+ *
+ *  @brief  Implementation of the spatial index class.
+ *
+ *  $Log: $
+ */
+
+#include "Objects/CaloHit.h"
+#include "Objects/Cluster.h"
+#include "Objects/SpatialIndex.h"
+#include "Objects/Track.h"
+#include "Objects/Vertex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace pandora
+{
+
+template <typename T>
+SpatialIndex<T>::SpatialIndex() :
+    m_splitAxes{0, 1, 2},
+    m_nSplitAxes(3)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+StatusCode SpatialIndex<T>::FindNearest(const CartesianVector &point, const T *&pNearestObject, float &distance) const
+{
+    pNearestObject = nullptr;
+
+    if (m_entryVector.empty())
+        return STATUS_CODE_NOT_FOUND;
+
+    const float pointCoordinates[3] = {point.GetX(), point.GetY(), point.GetZ()};
+    const Entry *pBestEntry(nullptr);
+    float bestDistanceSquared(std::numeric_limits<float>::max());
+
+    this->FindNearest(pointCoordinates, 0, m_entryVector.size(), 0, pBestEntry, bestDistanceSquared);
+
+    if (!pBestEntry)
+        return STATUS_CODE_NOT_FOUND;
+
+    pNearestObject = pBestEntry->m_pObject;
+    distance = std::sqrt(bestDistanceSquared);
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+StatusCode SpatialIndex<T>::FindWithinRadius(const CartesianVector &point, const float radius, ObjectVector &objectVector) const
+{
+    objectVector.clear();
+
+    if (radius < 0.f)
+        return STATUS_CODE_INVALID_PARAMETER;
+
+    if (m_entryVector.empty())
+        return STATUS_CODE_SUCCESS;
+
+    const float pointCoordinates[3] = {point.GetX(), point.GetY(), point.GetZ()};
+    EntryVector entryVector;
+
+    this->FindWithinRadius(pointCoordinates, radius * radius, 0, m_entryVector.size(), 0, entryVector);
+
+    AxisLessThan listOrderLessThan(LIST_ORDER);
+    std::sort(entryVector.begin(), entryVector.end(), listOrderLessThan);
+
+    objectVector.reserve(entryVector.size());
+
+    for (const Entry &entry : entryVector)
+        objectVector.push_back(entry.m_pObject);
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+StatusCode SpatialIndex<T>::FindKNearest(const CartesianVector &point, const unsigned int k, ObjectVector &objectVector) const
+{
+    objectVector.clear();
+
+    if (0 == k)
+        return STATUS_CODE_INVALID_PARAMETER;
+
+    if (m_entryVector.empty())
+        return STATUS_CODE_SUCCESS;
+
+    const float pointCoordinates[3] = {point.GetX(), point.GetY(), point.GetZ()};
+    NeighbourVector neighbourHeap;
+    neighbourHeap.reserve(std::min(k, static_cast<unsigned int>(m_entryVector.size())));
+
+    this->FindKNearest(pointCoordinates, k, 0, m_entryVector.size(), 0, neighbourHeap);
+
+    NeighbourLessThan neighbourLessThan;
+    std::sort_heap(neighbourHeap.begin(), neighbourHeap.end(), neighbourLessThan);
+
+    objectVector.reserve(neighbourHeap.size());
+
+    for (const Neighbour &neighbour : neighbourHeap)
+        objectVector.push_back(neighbour.second->m_pObject);
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+void SpatialIndex<T>::Fill(const ObjectList &objectList)
+{
+    this->Clear();
+    m_entryVector.reserve(objectList.size());
+
+    unsigned int listIndex(0);
+
+    for (const T *const pObject : objectList)
+    {
+        CartesianVector position(0.f, 0.f, 0.f);
+
+        if (SpatialIndex<T>::GetPosition(pObject, position))
+        {
+            Entry entry;
+            entry.m_position[0] = position.GetX();
+            entry.m_position[1] = position.GetY();
+            entry.m_position[2] = position.GetZ();
+            entry.m_listIndex = listIndex;
+            entry.m_pObject = pObject;
+            m_entryVector.push_back(entry);
+        }
+
+        ++listIndex;
+    }
+
+    // ATTN Coordinates with no spread, such as y for hits in a single two-dimensional view, would only split the tree by list order
+    m_nSplitAxes = 0;
+
+    for (unsigned int axis = 0; axis < 3; ++axis)
+    {
+        float minCoordinate(std::numeric_limits<float>::max()), maxCoordinate(-std::numeric_limits<float>::max());
+
+        for (const Entry &entry : m_entryVector)
+        {
+            minCoordinate = std::min(minCoordinate, entry.m_position[axis]);
+            maxCoordinate = std::max(maxCoordinate, entry.m_position[axis]);
+        }
+
+        if (maxCoordinate > minCoordinate)
+            m_splitAxes[m_nSplitAxes++] = axis;
+    }
+
+    if (0 == m_nSplitAxes)
+        m_splitAxes[m_nSplitAxes++] = 0;
+
+    this->Build(0, m_entryVector.size(), 0);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+void SpatialIndex<T>::Clear()
+{
+    m_entryVector.clear();
+    m_splitAxes[0] = 0; m_splitAxes[1] = 1; m_splitAxes[2] = 2;
+    m_nSplitAxes = 3;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <>
+bool SpatialIndex<CaloHit>::GetPosition(const CaloHit *const pCaloHit, CartesianVector &position)
+{
+    position = pCaloHit->GetPositionVector();
+    return true;
+}
+
+template <>
+bool SpatialIndex<Track>::GetPosition(const Track *const pTrack, CartesianVector &position)
+{
+    position = pTrack->GetTrackStateAtCalorimeter().GetPosition();
+    return true;
+}
+
+template <>
+bool SpatialIndex<Cluster>::GetPosition(const Cluster *const pCluster, CartesianVector &position)
+{
+    if (0 == pCluster->GetNCaloHits())
+        return false;
+
+    position = pCluster->GetCentroid(pCluster->GetInnerPseudoLayer());
+    return true;
+}
+
+template <>
+bool SpatialIndex<Vertex>::GetPosition(const Vertex *const pVertex, CartesianVector &position)
+{
+    position = pVertex->GetPosition();
+    return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+void SpatialIndex<T>::Build(const unsigned int begin, const unsigned int end, const unsigned int depth)
+{
+    if (end - begin < 2)
+        return;
+
+    const unsigned int middle(begin + (end - begin) / 2);
+
+    AxisLessThan axisLessThan(this->GetSplitAxis(depth));
+    std::nth_element(m_entryVector.begin() + begin, m_entryVector.begin() + middle, m_entryVector.begin() + end, axisLessThan);
+
+    this->Build(begin, middle, depth + 1);
+    this->Build(middle + 1, end, depth + 1);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+void SpatialIndex<T>::FindNearest(const float *const point, const unsigned int begin, const unsigned int end, const unsigned int depth,
+    const Entry *&pBestEntry, float &bestDistanceSquared) const
+{
+    if (begin >= end)
+        return;
+
+    const unsigned int middle(begin + (end - begin) / 2);
+    const Entry &entry(m_entryVector[middle]);
+    const float distanceSquared(SpatialIndex<T>::GetDistanceSquared(entry, point));
+
+    if ((distanceSquared < bestDistanceSquared) || (pBestEntry && (distanceSquared == bestDistanceSquared) && (entry.m_listIndex < pBestEntry->m_listIndex)))
+    {
+        pBestEntry = &entry;
+        bestDistanceSquared = distanceSquared;
+    }
+
+    const unsigned int axis(this->GetSplitAxis(depth));
+    const float delta(point[axis] - entry.m_position[axis]);
+    const bool searchLowerFirst(delta < 0.f);
+
+    this->FindNearest(point, searchLowerFirst ? begin : middle + 1, searchLowerFirst ? middle : end, depth + 1, pBestEntry, bestDistanceSquared);
+
+    // ATTN Equality is included, so that equidistant entries on the far side can still win on list order
+    if (delta * delta <= bestDistanceSquared)
+        this->FindNearest(point, searchLowerFirst ? middle + 1 : begin, searchLowerFirst ? end : middle, depth + 1, pBestEntry, bestDistanceSquared);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+void SpatialIndex<T>::FindWithinRadius(const float *const point, const float radiusSquared, const unsigned int begin, const unsigned int end,
+    const unsigned int depth, EntryVector &entryVector) const
+{
+    if (begin >= end)
+        return;
+
+    const unsigned int middle(begin + (end - begin) / 2);
+    const Entry &entry(m_entryVector[middle]);
+
+    if (SpatialIndex<T>::GetDistanceSquared(entry, point) <= radiusSquared)
+        entryVector.push_back(entry);
+
+    const unsigned int axis(this->GetSplitAxis(depth));
+    const float delta(point[axis] - entry.m_position[axis]);
+
+    if ((delta <= 0.f) || (delta * delta <= radiusSquared))
+        this->FindWithinRadius(point, radiusSquared, begin, middle, depth + 1, entryVector);
+
+    if ((delta >= 0.f) || (delta * delta <= radiusSquared))
+        this->FindWithinRadius(point, radiusSquared, middle + 1, end, depth + 1, entryVector);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+void SpatialIndex<T>::FindKNearest(const float *const point, const unsigned int k, const unsigned int begin, const unsigned int end,
+    const unsigned int depth, NeighbourVector &neighbourHeap) const
+{
+    if (begin >= end)
+        return;
+
+    const unsigned int middle(begin + (end - begin) / 2);
+    const Entry &entry(m_entryVector[middle]);
+    const Neighbour neighbour(SpatialIndex<T>::GetDistanceSquared(entry, point), &entry);
+
+    NeighbourLessThan neighbourLessThan;
+
+    if (neighbourHeap.size() < k)
+    {
+        neighbourHeap.push_back(neighbour);
+        std::push_heap(neighbourHeap.begin(), neighbourHeap.end(), neighbourLessThan);
+    }
+    else if (neighbourLessThan(neighbour, neighbourHeap.front()))
+    {
+        std::pop_heap(neighbourHeap.begin(), neighbourHeap.end(), neighbourLessThan);
+        neighbourHeap.back() = neighbour;
+        std::push_heap(neighbourHeap.begin(), neighbourHeap.end(), neighbourLessThan);
+    }
+
+    const unsigned int axis(this->GetSplitAxis(depth));
+    const float delta(point[axis] - entry.m_position[axis]);
+    const bool searchLowerFirst(delta < 0.f);
+
+    this->FindKNearest(point, k, searchLowerFirst ? begin : middle + 1, searchLowerFirst ? middle : end, depth + 1, neighbourHeap);
+
+    // ATTN Equality is included, so that equidistant entries on the far side can still win on list order
+    if ((neighbourHeap.size() < k) || (delta * delta <= neighbourHeap.front().first))
+        this->FindKNearest(point, k, searchLowerFirst ? middle + 1 : begin, searchLowerFirst ? end : middle, depth + 1, neighbourHeap);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template class SpatialIndex<CaloHit>;
+template class SpatialIndex<Track>;
+template class SpatialIndex<Cluster>;
+template class SpatialIndex<Vertex>;
+
+} // namespace pandora
@@ -6,10 +6,17 @@
  *  $Log: $
  */
 
+#include "Helpers/MCParticleHelper.h"
+#include "Helpers/SortingHelper.h"
+
+#include "Objects/Helix.h"
 #include "Objects/Track.h"
 
+#include "Pandora/ObjectPool.h"
+
 #include <algorithm>
 #include <cmath>
+#include <limits>
 
 namespace pandora
 {
@@ -43,51 +50,70 @@ bool Track::operator< (const Track &rhs) const
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 Track::Track(const object_creation::Track::Parameters &parameters) :
-    m_d0(parameters.m_d0.Get()),
-    m_z0(parameters.m_z0.Get()),
-    m_particleId(parameters.m_particleId.Get()),
-    m_charge(parameters.m_charge.Get()),
-    m_mass(parameters.m_mass.Get()),
-    m_momentumAtDca(parameters.m_momentumAtDca.Get()),
+    m_d0(parameters.m_d0.GetUnchecked()),
+    m_z0(parameters.m_z0.GetUnchecked()),
+    m_particleId(parameters.m_particleId.GetUnchecked()),
+    m_charge(parameters.m_charge.GetUnchecked()),
+    m_mass(parameters.m_mass.GetUnchecked()),
+    m_momentumAtDca(parameters.m_momentumAtDca.GetUnchecked()),
     m_energyAtDca(std::sqrt(m_mass * m_mass + m_momentumAtDca.GetMagnitudeSquared())),
-    m_trackStateAtStart(parameters.m_trackStateAtStart.Get()),
-    m_trackStateAtEnd(parameters.m_trackStateAtEnd.Get()),
-    m_trackStateAtCalorimeter(parameters.m_trackStateAtCalorimeter.Get()),
-    m_timeAtCalorimeter(parameters.m_timeAtCalorimeter.Get()),
-    m_reachesCalorimeter(parameters.m_reachesCalorimeter.Get()),
-    m_isProjectedToEndCap(parameters.m_isProjectedToEndCap.Get()),
-    m_canFormPfo(parameters.m_canFormPfo.Get()),
-    m_canFormClusterlessPfo(parameters.m_canFormClusterlessPfo.Get()),
+    m_trackStateAtStart(parameters.m_trackStateAtStart.GetUnchecked()),
+    m_trackStateAtEnd(parameters.m_trackStateAtEnd.GetUnchecked()),
+    m_trackStateAtCalorimeter(parameters.m_trackStateAtCalorimeter.GetUnchecked()),
+    m_timeAtCalorimeter(parameters.m_timeAtCalorimeter.GetUnchecked()),
+    m_reachesCalorimeter(parameters.m_reachesCalorimeter.GetUnchecked()),
+    m_isProjectedToEndCap(parameters.m_isProjectedToEndCap.GetUnchecked()),
+    m_canFormPfo(parameters.m_canFormPfo.GetUnchecked()),
+    m_canFormClusterlessPfo(parameters.m_canFormClusterlessPfo.GetUnchecked()),
     m_pAssociatedCluster(nullptr),
-    m_pParentAddress(parameters.m_pParentAddress.Get()),
-    m_isAvailable(true)
+    m_pMCParticleWeightMap(nullptr),
+    m_pMainMCParticle(nullptr),
+    m_pParentAddress(parameters.m_pParentAddress.GetUnchecked()),
+    m_eventId(parameters.m_eventId.IsInitialized() ? parameters.m_eventId.Get() : 0),
+    m_index(std::numeric_limits<unsigned int>::max()),
+    m_indexGeneration(0),
+    m_isAvailable(true),
+    m_pHelixAtStart(nullptr),
+    m_pHelixAtEnd(nullptr),
+    m_pHelixAtCalorimeter(nullptr),
+    m_helixBField(0.f),
+    m_sortKey(SortingHelper::GetPositionSortKey(m_trackStateAtCalorimeter.GetPosition()))
 {
-    // Consistency checks
-    if (m_energyAtDca < std::numeric_limits<float>::epsilon())
-        throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
-
-    if (0 == m_charge)
-        throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
+    // ATTN Parameter initialization and consistency are checked by the track manager, prior to construction
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 Track::~Track()
 {
+    delete m_pMCParticleWeightMap;
+    this->ClearHelixCache();
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 void Track::SetMCParticleWeightMap(const MCParticleWeightMap &mcParticleWeightMap)
 {
-    m_mcParticleWeightMap = mcParticleWeightMap;
+    if (mcParticleWeightMap.empty())
+    {
+        this->RemoveMCParticles();
+        return;
+    }
+
+    if (!m_pMCParticleWeightMap)
+        m_pMCParticleWeightMap = new MCParticleWeightMap;
+
+    *m_pMCParticleWeightMap = mcParticleWeightMap;
+    m_pMainMCParticle = MCParticleHelper::FindMainMCParticle(*m_pMCParticleWeightMap);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 void Track::RemoveMCParticles()
 {
-    m_mcParticleWeightMap.clear();
+    delete m_pMCParticleWeightMap;
+    m_pMCParticleWeightMap = nullptr;
+    m_pMainMCParticle = nullptr;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -157,4 +183,62 @@ StatusCode Track::AddSibling(const Track *const pTrack)
     return STATUS_CODE_SUCCESS;
 }
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode Track::GetLayerIntersection(const unsigned int pseudoLayer, const LayerIntersection *&pLayerIntersection) const
+{
+    LayerIntersectionVector::const_iterator iter(std::lower_bound(m_layerIntersections.begin(), m_layerIntersections.end(), pseudoLayer,
+        [](const LayerIntersection &layerIntersection, const unsigned int layer) { return (layerIntersection.m_pseudoLayer < layer); }));
+
+    if ((m_layerIntersections.end() == iter) || (pseudoLayer != iter->m_pseudoLayer))
+        return STATUS_CODE_NOT_FOUND;
+
+    pLayerIntersection = &(*iter);
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+const Helix &Track::GetHelix(const TrackState &trackState, const float bField, const Helix *&pHelix) const
+{
+    if (bField != m_helixBField)
+    {
+        this->ClearHelixCache();
+        m_helixBField = bField;
+    }
+
+    if (!pHelix)
+        pHelix = new Helix(trackState.GetPosition(), trackState.GetMomentum(), static_cast<float>(m_charge), bField);
+
+    return *pHelix;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void Track::ClearHelixCache() const
+{
+    delete m_pHelixAtStart;
+    delete m_pHelixAtEnd;
+    delete m_pHelixAtCalorimeter;
+    m_pHelixAtStart = nullptr;
+    m_pHelixAtEnd = nullptr;
+    m_pHelixAtCalorimeter = nullptr;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef PANDORA_POOLED_OBJECT_ALLOCATION
+void *Track::operator new(std::size_t size)
+{
+    return ObjectPool<Track>::Allocate(size);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void Track::operator delete(void *pAddress, std::size_t size)
+{
+    ObjectPool<Track>::Deallocate(pAddress, size);
+}
+#endif
+
 } // namespace pandora
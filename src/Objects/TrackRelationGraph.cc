@@ -0,0 +1,101 @@
+/**
+ *  @file   PandoraSDK/src/Objects/TrackRelationGraph.cc
+ *
+ *  @brief  Implementation of the track relation graph class.
+ *
+ *  $Log: $
+ */
+
+#include "Objects/Track.h"
+#include "Objects/TrackRelationGraph.h"
+
+namespace pandora
+{
+
+TrackRelationGraph::TrackRelationGraph()
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode TrackRelationGraph::GetIndex(const Track *const pTrack, unsigned int &index) const
+{
+    TrackToIndexMap::const_iterator iter = m_trackToIndexMap.find(pTrack);
+
+    if (m_trackToIndexMap.end() == iter)
+        return STATUS_CODE_NOT_FOUND;
+
+    index = iter->second;
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode TrackRelationGraph::Fill(const TrackList &trackList)
+{
+    this->Clear();
+
+    const unsigned int nTracks(trackList.size());
+    m_trackVector.reserve(nTracks);
+    m_trackToIndexMap.reserve(nTracks);
+
+    for (const Track *const pTrack : trackList)
+    {
+        if (!m_trackToIndexMap.insert(TrackToIndexMap::value_type(pTrack, m_trackVector.size())).second)
+            return STATUS_CODE_ALREADY_PRESENT;
+
+        m_trackVector.push_back(pTrack);
+    }
+
+    m_parents.m_offsets.reserve(nTracks + 1);
+    m_daughters.m_offsets.reserve(nTracks + 1);
+    m_siblings.m_offsets.reserve(nTracks + 1);
+
+    for (const Track *const pTrack : m_trackVector)
+    {
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->AddRelations(pTrack->GetParentList(), m_parents));
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->AddRelations(pTrack->GetDaughterList(), m_daughters));
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->AddRelations(pTrack->GetSiblingList(), m_siblings));
+    }
+
+    m_parents.m_offsets.push_back(m_parents.m_indices.size());
+    m_daughters.m_offsets.push_back(m_daughters.m_indices.size());
+    m_siblings.m_offsets.push_back(m_siblings.m_indices.size());
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void TrackRelationGraph::Clear()
+{
+    m_trackVector.clear();
+    m_trackToIndexMap.clear();
+    m_parents.m_offsets.clear();
+    m_parents.m_indices.clear();
+    m_daughters.m_offsets.clear();
+    m_daughters.m_indices.clear();
+    m_siblings.m_offsets.clear();
+    m_siblings.m_indices.clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode TrackRelationGraph::AddRelations(const TrackList &relatedTrackList, Adjacency &adjacency) const
+{
+    adjacency.m_offsets.push_back(adjacency.m_indices.size());
+
+    for (const Track *const pRelatedTrack : relatedTrackList)
+    {
+        TrackToIndexMap::const_iterator iter = m_trackToIndexMap.find(pRelatedTrack);
+
+        if (m_trackToIndexMap.end() == iter)
+            return STATUS_CODE_NOT_FOUND;
+
+        adjacency.m_indices.push_back(iter->second);
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
+} // namespace pandora
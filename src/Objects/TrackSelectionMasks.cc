@@ -0,0 +1,138 @@
+/**
+ *  @file   PandoraSDK/src/Objects/TrackSelectionMasks.cc
+ *
+ *  @brief  Implementation of the track selection masks class.
+ *
+ *  $Log: $
+ */
+
+#include "Objects/Track.h"
+#include "Objects/TrackSelectionMasks.h"
+
+#include <limits>
+
+namespace pandora
+{
+
+TrackSelectionMasks::TrackSelectionMasks() :
+    m_cachedTracks(N_FLAGS),
+    m_validCacheFlags(0)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode TrackSelectionMasks::GetFlagWord(const Track *const pTrack, FlagWord &flagWord) const
+{
+    const unsigned int index(pTrack->GetIndex());
+
+    if ((index >= m_trackVector.size()) || (pTrack != m_trackVector[index]))
+        return STATUS_CODE_NOT_FOUND;
+
+    flagWord = m_flagWordVector[index];
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void TrackSelectionMasks::GetTracks(const FlagWord requiredFlags, const FlagWord vetoedFlags, TrackVector &trackVector) const
+{
+    const FlagWord mask(requiredFlags | vetoedFlags);
+
+    for (unsigned int index = 0, nTracks = m_flagWordVector.size(); index < nTracks; ++index)
+    {
+        if ((requiredFlags == (m_flagWordVector[index] & mask)) && m_trackVector[index])
+            trackVector.push_back(m_trackVector[index]);
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+const TrackVector &TrackSelectionMasks::GetTracks(const Flag flag) const
+{
+    const unsigned int flagPosition(TrackSelectionMasks::GetFlagPosition(flag));
+    TrackVector &cachedTracks(m_cachedTracks[flagPosition]);
+
+    if (!(m_validCacheFlags & flag))
+    {
+        cachedTracks.clear();
+        this->GetTracks(flag, 0, cachedTracks);
+        m_validCacheFlags |= flag;
+    }
+
+    return cachedTracks;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void TrackSelectionMasks::Add(const Track *const pTrack)
+{
+    const unsigned int index(pTrack->GetIndex());
+
+    if (std::numeric_limits<unsigned int>::max() == index)
+        throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
+
+    if (index >= m_trackVector.size())
+    {
+        m_trackVector.resize(index + 1, nullptr);
+        m_flagWordVector.resize(index + 1, 0);
+    }
+
+    FlagWord flagWord(0);
+    flagWord |= pTrack->CanFormPfo() ? CAN_FORM_PFO : 0;
+    flagWord |= pTrack->CanFormClusterlessPfo() ? CAN_FORM_CLUSTERLESS_PFO : 0;
+    flagWord |= pTrack->ReachesCalorimeter() ? REACHES_CALORIMETER : 0;
+    flagWord |= pTrack->IsProjectedToEndCap() ? IS_PROJECTED_TO_END_CAP : 0;
+    flagWord |= (pTrack->GetCharge() > 0) ? IS_POSITIVELY_CHARGED : 0;
+    flagWord |= pTrack->HasAssociatedCluster() ? HAS_ASSOCIATED_CLUSTER : 0;
+    flagWord |= pTrack->IsAvailable() ? IS_AVAILABLE : 0;
+
+    m_trackVector[index] = pTrack;
+    m_flagWordVector[index] = flagWord;
+    m_validCacheFlags = 0;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void TrackSelectionMasks::SetFlag(const Track *const pTrack, const Flag flag, const bool isSet)
+{
+    const unsigned int index(pTrack->GetIndex());
+
+    if ((index >= m_trackVector.size()) || (pTrack != m_trackVector[index]))
+        return;
+
+    FlagWord &flagWord(m_flagWordVector[index]);
+
+    if (isSet == static_cast<bool>(flagWord & flag))
+        return;
+
+    flagWord ^= flag;
+    m_validCacheFlags &= ~flag;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void TrackSelectionMasks::Clear()
+{
+    m_trackVector.clear();
+    m_flagWordVector.clear();
+    m_validCacheFlags = 0;
+
+    for (TrackVector &cachedTracks : m_cachedTracks)
+        cachedTracks.clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+unsigned int TrackSelectionMasks::GetFlagPosition(const Flag flag)
+{
+    for (unsigned int flagPosition = 0; flagPosition < N_FLAGS; ++flagPosition)
+    {
+        if ((1u << flagPosition) == static_cast<unsigned int>(flag))
+            return flagPosition;
+    }
+
+    throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
+}
+
+} // namespace pandora
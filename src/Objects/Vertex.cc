@@ -8,6 +8,8 @@
 
 #include "Objects/Vertex.h"
 
+#include <limits>
+
 namespace pandora
 {
 
@@ -16,7 +18,9 @@ Vertex::Vertex(const object_creation::Vertex::Parameters &parameters) :
     m_x0(parameters.m_x0.IsInitialized() ? parameters.m_x0.Get() : 0.f),
     m_vertexLabel(parameters.m_vertexLabel.Get()),
     m_vertexType(parameters.m_vertexType.Get()),
-    m_isAvailable(true)
+    m_isAvailable(true),
+    m_index(std::numeric_limits<unsigned int>::max()),
+    m_indexGeneration(0)
 {
 }
 
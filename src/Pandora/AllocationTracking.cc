@@ -0,0 +1,146 @@
+/**
+ *  @file   PandoraSDK/src/Pandora/AllocationTracking.cc
+ *
+ *  @brief  Implementation of the allocation tracking class.
+ *
+ *  $Log: $
+ */
+
+#include "Pandora/AllocationTracking.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace pandora
+{
+
+const std::size_t AllocationTracking::m_headerSize(alignof(std::max_align_t));
+thread_local AllocationCounters *AllocationTracking::m_pCurrentCounters(nullptr);
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+AllocationCounters::AllocationCounters() :
+    m_nAllocations(0),
+    m_nBytes(0),
+    m_liveBytes(0)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool AllocationTracking::IsEnabled()
+{
+#ifdef PANDORA_ALLOCATION_TRACKING
+    return true;
+#else
+    return false;
+#endif
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+AllocationCounters *AllocationTracking::NewCounters()
+{
+    return new AllocationCounters;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+AllocationCounters *AllocationTracking::GetCurrentCounters()
+{
+    return m_pCurrentCounters;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void AllocationTracking::SetCurrentCounters(AllocationCounters *const pAllocationCounters)
+{
+    m_pCurrentCounters = pAllocationCounters;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void *AllocationTracking::Allocate(const std::size_t size)
+{
+    static_assert(sizeof(AllocationHeader) <= alignof(std::max_align_t), "AllocationTracking: header exceeds the reserved space");
+
+    if (size > static_cast<std::size_t>(-1) - m_headerSize)
+        return nullptr;
+
+    unsigned char *const pBlock(static_cast<unsigned char*>(std::malloc(m_headerSize + size)));
+
+    if (!pBlock)
+        return nullptr;
+
+    AllocationCounters *const pAllocationCounters(m_pCurrentCounters);
+
+    AllocationHeader *const pHeader(reinterpret_cast<AllocationHeader*>(pBlock));
+    pHeader->m_pAllocationCounters = pAllocationCounters;
+    pHeader->m_size = size;
+
+    if (pAllocationCounters)
+    {
+        pAllocationCounters->m_nAllocations.fetch_add(1, std::memory_order_relaxed);
+        pAllocationCounters->m_nBytes.fetch_add(size, std::memory_order_relaxed);
+        pAllocationCounters->m_liveBytes.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    return pBlock + m_headerSize;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void AllocationTracking::Deallocate(void *const pAddress)
+{
+    if (!pAddress)
+        return;
+
+    unsigned char *const pBlock(static_cast<unsigned char*>(pAddress) - m_headerSize);
+    const AllocationHeader *const pHeader(reinterpret_cast<const AllocationHeader*>(pBlock));
+
+    if (pHeader->m_pAllocationCounters)
+        pHeader->m_pAllocationCounters->m_liveBytes.fetch_sub(pHeader->m_size, std::memory_order_relaxed);
+
+    std::free(pBlock);
+}
+
+} // namespace pandora
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef PANDORA_ALLOCATION_TRACKING
+// ATTN The array and nothrow forms forward to these by default. Over-aligned allocations are not recorded.
+void *operator new(std::size_t size)
+{
+    while (true)
+    {
+        void *const pAddress(pandora::AllocationTracking::Allocate(size));
+
+        if (pAddress)
+            return pAddress;
+
+        const std::new_handler newHandler(std::get_new_handler());
+
+        if (!newHandler)
+            throw std::bad_alloc();
+
+        newHandler();
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void operator delete(void *pAddress) noexcept
+{
+    pandora::AllocationTracking::Deallocate(pAddress);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void operator delete(void *pAddress, std::size_t /*size*/) noexcept
+{
+    pandora::AllocationTracking::Deallocate(pAddress);
+}
+#endif
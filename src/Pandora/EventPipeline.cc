@@ -0,0 +1,150 @@
+/**
+ *  @file   PandoraSDK/src/Pandora/EventPipeline.cc
+ *
+ *  @brief  Implementation of the event pipeline class.
+ *
+ *  $Log: $
+ */
+
+#include "Api/PandoraApi.h"
+
+#include "Pandora/EventPipeline.h"
+#include "Pandora/Pandora.h"
+#include "Pandora/PandoraSettings.h"
+#include "Pandora/ThreadPool.h"
+
+namespace pandora
+{
+
+EventTask::~EventTask()
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+EventPipeline::EventPipeline(const PandoraVector &workerPandoraVector) :
+    m_shouldStop(false)
+{
+    for (const Pandora *const pPandora : workerPandoraVector)
+    {
+        if (!pPandora)
+            throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
+    }
+
+    for (const Pandora *const pPandora : workerPandoraVector)
+        m_threadVector.push_back(std::thread(&EventPipeline::RunWorker, this, pPandora));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+EventPipeline::~EventPipeline()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_shouldStop = true;
+    }
+
+    m_condition.notify_all();
+
+    for (std::thread &thread : m_threadVector)
+        thread.join();
+
+    // ATTN Only reached with events still queued if there are no worker pandora instances
+    for (QueuedEvent &queuedEvent : m_queuedEvents)
+    {
+        delete queuedEvent.m_pEventTask;
+        queuedEvent.m_promise.set_value(STATUS_CODE_NOT_INITIALIZED);
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+std::future<StatusCode> EventPipeline::SubmitEvent(EventTask *const pEventTask)
+{
+    if (!pEventTask)
+        throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
+
+    std::future<StatusCode> future;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queuedEvents.push_back(QueuedEvent(pEventTask));
+        future = m_queuedEvents.back().m_promise.get_future();
+    }
+
+    m_condition.notify_one();
+    return future;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode EventPipeline::ProcessEvent(const Pandora &pandora, EventTask &eventTask)
+{
+    StatusCode statusCode(STATUS_CODE_SUCCESS);
+
+    try
+    {
+        statusCode = eventTask.CreateInputs(pandora);
+
+        if (STATUS_CODE_SUCCESS == statusCode)
+            statusCode = PandoraApi::ProcessEvent(pandora);
+
+        if (STATUS_CODE_SUCCESS == statusCode)
+        {
+            const PfoList *pPfoList(nullptr);
+            statusCode = PandoraApi::GetCurrentPfoList(pandora, pPfoList);
+
+            if (STATUS_CODE_SUCCESS == statusCode)
+                statusCode = eventTask.ProcessOutput(pandora, *pPfoList);
+        }
+    }
+    catch (StatusCodeException &statusCodeException)
+    {
+        statusCode = statusCodeException.GetStatusCode();
+    }
+    catch (...)
+    {
+        statusCode = STATUS_CODE_FAILURE;
+    }
+
+    // ATTN The worker is always reset, ready for the next event, with a reset failure reported only if the event itself succeeded
+    const StatusCode resetStatusCode(PandoraApi::Reset(pandora));
+
+    return ((STATUS_CODE_SUCCESS != statusCode) ? statusCode : resetStatusCode);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void EventPipeline::RunWorker(const Pandora *const pPandora)
+{
+    // ATTN Pin the worker to the cores of its pandora instance, so that its per-event objects are allocated on the local numa node
+    if (STATUS_CODE_SUCCESS != ThreadPool::PinCurrentThread(pPandora->GetSettings()->GetCoreSet()))
+        std::cout << "EventPipeline: unable to pin worker thread to the configured core set " << std::endl;
+
+    while (true)
+    {
+        EventTask *pEventTask(nullptr);
+        std::promise<StatusCode> promise;
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            while (!m_shouldStop && m_queuedEvents.empty())
+                m_condition.wait(lock);
+
+            if (m_queuedEvents.empty())
+                break;
+
+            pEventTask = m_queuedEvents.front().m_pEventTask;
+            promise = std::move(m_queuedEvents.front().m_promise);
+            m_queuedEvents.pop_front();
+        }
+
+        const StatusCode statusCode(EventPipeline::ProcessEvent(*pPandora, *pEventTask));
+        delete pEventTask;
+        promise.set_value(statusCode);
+    }
+}
+
+} // namespace pandora
@@ -0,0 +1,458 @@
+/**
+ *  @file   PandoraSDK/src/Pandora/LArTPCSubEventAlgorithm.cc
+ *
+ *  @brief  Implementation of the lar tpc sub event algorithm class.
+ *
+ *  $Log: $
+ */
+
+#include "Api/PandoraApi.h"
+
+#include "Pandora/AlgorithmHeaders.h"
+#include "Pandora/LArTPCSubEventAlgorithm.h"
+#include "Pandora/ProfileZones.h"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+using namespace pandora;
+
+LArTPCSubEventAlgorithm::LArTPCSubEventAlgorithm() :
+    m_outputClusterListName("LArTPCSubEventClusters"),
+    m_outputVertexListName("LArTPCSubEventVertices"),
+    m_outputPfoListName("LArTPCSubEventParticles")
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode LArTPCSubEventAlgorithm::Run()
+{
+    SubEventVector subEventVector;
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->PartitionCaloHits(subEventVector));
+
+    if (subEventVector.empty())
+        return STATUS_CODE_SUCCESS;
+
+    // ATTN Each worker processes its share of the sub events in turn, so that the number of workers bounds the concurrency
+    const unsigned int nWorkers(std::min(static_cast<unsigned int>(m_workerPandoraVector.size()), static_cast<unsigned int>(subEventVector.size())));
+    const SubEventTask subEventTask(*this, subEventVector);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::ParallelFor(*this, nWorkers, subEventTask, 1));
+
+    std::string clusterListName, vertexListName, pfoListName;
+
+    for (const SubEvent &subEvent : subEventVector)
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->CreateOutput(subEvent, clusterListName, vertexListName, pfoListName));
+
+    if (!clusterListName.empty())
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::SaveList<Cluster>(*this, clusterListName, m_outputClusterListName));
+
+    if (!vertexListName.empty())
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::SaveList<Vertex>(*this, vertexListName, m_outputVertexListName));
+
+    if (!pfoListName.empty())
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::SaveList<ParticleFlowObject>(*this, pfoListName, m_outputPfoListName));
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode LArTPCSubEventAlgorithm::PartitionCaloHits(SubEventVector &subEventVector) const
+{
+    const CaloHitList *pCaloHitList(nullptr);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::GetCurrentList(*this, pCaloHitList));
+
+    const GeometryManager *const pGeometryManager(PandoraContentApi::GetGeometry(*this));
+    const LArTPCMap &larTPCMap(pGeometryManager->GetLArTPCMap());
+
+    std::unordered_map<const LArTPC*, unsigned int> larTPCToSubEventMap;
+    subEventVector.reserve(larTPCMap.size());
+
+    for (const LArTPCMap::value_type &mapEntry : larTPCMap)
+    {
+        larTPCToSubEventMap[mapEntry.second] = subEventVector.size();
+        subEventVector.push_back(SubEvent(mapEntry.second));
+    }
+
+    for (const CaloHit *const pCaloHit : *pCaloHitList)
+    {
+        const LArTPC *pLArTPC(nullptr);
+
+        if (STATUS_CODE_SUCCESS != pGeometryManager->GetLArTPC(pCaloHit->GetPositionVector(), pLArTPC))
+            continue;
+
+        subEventVector.at(larTPCToSubEventMap.at(pLArTPC)).m_caloHitList.push_back(pCaloHit);
+    }
+
+    subEventVector.erase(std::remove_if(subEventVector.begin(), subEventVector.end(),
+        [](const SubEvent &subEvent) { return subEvent.m_caloHitList.empty(); }), subEventVector.end());
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode LArTPCSubEventAlgorithm::ProcessSubEvent(const Pandora &workerPandora, SubEvent &subEvent) const
+{
+    StatusCode subEventStatusCode(this->CreateWorkerCaloHits(workerPandora, subEvent));
+
+    if (STATUS_CODE_SUCCESS == subEventStatusCode)
+        subEventStatusCode = PandoraApi::ProcessEvent(workerPandora);
+
+    if (STATUS_CODE_SUCCESS == subEventStatusCode)
+        subEventStatusCode = this->RecordWorkerOutput(workerPandora, subEvent);
+
+    // ATTN Always reset the worker, so that it is ready for its next sub event, or for the next event, after any failure
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraApi::Reset(workerPandora));
+
+    return subEventStatusCode;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode LArTPCSubEventAlgorithm::CreateWorkerCaloHits(const Pandora &workerPandora, const SubEvent &subEvent) const
+{
+    PandoraApi::CaloHit::ParametersVector parametersVector;
+    parametersVector.reserve(subEvent.m_caloHitList.size());
+
+    for (const CaloHit *const pCaloHit : subEvent.m_caloHitList)
+    {
+        // ATTN The worker calo hit position includes any x0 shift already applied to the original calo hit
+        PandoraApi::CaloHit::Parameters parameters;
+        parameters.m_positionVector = pCaloHit->GetPositionVector();
+        parameters.m_expectedDirection = pCaloHit->GetExpectedDirection();
+        parameters.m_cellNormalVector = pCaloHit->GetCellNormalVector();
+        parameters.m_cellGeometry = pCaloHit->GetCellGeometry();
+        parameters.m_cellSize0 = pCaloHit->GetCellSize0();
+        parameters.m_cellSize1 = pCaloHit->GetCellSize1();
+        parameters.m_cellThickness = pCaloHit->GetCellThickness();
+        parameters.m_nCellRadiationLengths = pCaloHit->GetNCellRadiationLengths();
+        parameters.m_nCellInteractionLengths = pCaloHit->GetNCellInteractionLengths();
+        parameters.m_time = pCaloHit->GetTime();
+        parameters.m_inputEnergy = pCaloHit->GetInputEnergy();
+        parameters.m_mipEquivalentEnergy = pCaloHit->GetMipEquivalentEnergy();
+        parameters.m_electromagneticEnergy = pCaloHit->GetElectromagneticEnergy();
+        parameters.m_hadronicEnergy = pCaloHit->GetHadronicEnergy();
+        parameters.m_isDigital = pCaloHit->IsDigital();
+        parameters.m_hitType = pCaloHit->GetHitType();
+        parameters.m_hitRegion = pCaloHit->GetHitRegion();
+        parameters.m_layer = pCaloHit->GetLayer();
+        parameters.m_isInOuterSamplingLayer = pCaloHit->IsInOuterSamplingLayer();
+        parameters.m_pParentAddress = static_cast<const void*>(pCaloHit);
+        parameters.m_eventId = pCaloHit->GetEventId();
+        parametersVector.push_back(parameters);
+    }
+
+    return PandoraApi::CaloHit::Create(workerPandora, parametersVector);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode LArTPCSubEventAlgorithm::RecordWorkerOutput(const Pandora &workerPandora, SubEvent &subEvent) const
+{
+    const PfoList *pPfoList(nullptr);
+    const StatusCode pfoStatusCode(m_workerPfoListName.empty() ? PandoraApi::GetCurrentPfoList(workerPandora, pPfoList) :
+        PandoraApi::GetPfoList(workerPandora, m_workerPfoListName, pPfoList));
+
+    if ((STATUS_CODE_SUCCESS != pfoStatusCode) && (STATUS_CODE_NOT_INITIALIZED != pfoStatusCode) && (STATUS_CODE_NOT_FOUND != pfoStatusCode))
+        return pfoStatusCode;
+
+    const ClusterList *pClusterList(nullptr);
+
+    if (!m_workerClusterListName.empty())
+    {
+        const StatusCode clusterStatusCode(PandoraApi::GetClusterList(workerPandora, m_workerClusterListName, pClusterList));
+
+        if ((STATUS_CODE_SUCCESS != clusterStatusCode) && (STATUS_CODE_NOT_INITIALIZED != clusterStatusCode) && (STATUS_CODE_NOT_FOUND != clusterStatusCode))
+            return clusterStatusCode;
+    }
+
+    std::unordered_map<const Cluster*, unsigned int> clusterToIndexMap;
+    std::unordered_map<const Vertex*, unsigned int> vertexToIndexMap;
+    std::unordered_map<const ParticleFlowObject*, unsigned int> pfoToIndexMap;
+
+    ClusterVector workerClusterVector;
+    VertexVector workerVertexVector;
+    PfoVector workerPfoVector;
+
+    if (pPfoList)
+        workerPfoVector.insert(workerPfoVector.end(), pPfoList->begin(), pPfoList->end());
+
+    // ATTN Pfos are indexed before recording, so that daughters outside the named list are also recorded, in a defined order
+    for (const ParticleFlowObject *const pPfo : workerPfoVector)
+        pfoToIndexMap.insert(std::make_pair(pPfo, pfoToIndexMap.size()));
+
+    for (unsigned int pfoIndex = 0; pfoIndex < workerPfoVector.size(); ++pfoIndex)
+    {
+        for (const ParticleFlowObject *const pDaughterPfo : workerPfoVector.at(pfoIndex)->GetDaughterPfoList())
+        {
+            if (pfoToIndexMap.insert(std::make_pair(pDaughterPfo, pfoToIndexMap.size())).second)
+                workerPfoVector.push_back(pDaughterPfo);
+        }
+    }
+
+    if (pClusterList)
+        workerClusterVector.insert(workerClusterVector.end(), pClusterList->begin(), pClusterList->end());
+
+    for (const Cluster *const pCluster : workerClusterVector)
+        clusterToIndexMap.insert(std::make_pair(pCluster, clusterToIndexMap.size()));
+
+    for (const ParticleFlowObject *const pPfo : workerPfoVector)
+    {
+        PfoRecord pfoRecord(pPfo);
+
+        for (const Cluster *const pCluster : pPfo->GetClusterList())
+        {
+            const std::pair<std::unordered_map<const Cluster*, unsigned int>::const_iterator, bool> insertion(
+                clusterToIndexMap.insert(std::make_pair(pCluster, clusterToIndexMap.size())));
+
+            if (insertion.second)
+                workerClusterVector.push_back(pCluster);
+
+            pfoRecord.m_clusterIndices.push_back(insertion.first->second);
+        }
+
+        for (const Vertex *const pVertex : pPfo->GetVertexList())
+        {
+            const std::pair<std::unordered_map<const Vertex*, unsigned int>::const_iterator, bool> insertion(
+                vertexToIndexMap.insert(std::make_pair(pVertex, vertexToIndexMap.size())));
+
+            if (insertion.second)
+                workerVertexVector.push_back(pVertex);
+
+            pfoRecord.m_vertexIndices.push_back(insertion.first->second);
+        }
+
+        for (const ParticleFlowObject *const pDaughterPfo : pPfo->GetDaughterPfoList())
+            pfoRecord.m_daughterIndices.push_back(pfoToIndexMap.at(pDaughterPfo));
+
+        pfoRecord.m_propertiesMap["LArTPCVolumeId"] = static_cast<float>(subEvent.m_pLArTPC->GetLArTPCVolumeId());
+        subEvent.m_pfoRecords.push_back(pfoRecord);
+    }
+
+    for (const Cluster *const pCluster : workerClusterVector)
+    {
+        CaloHitList caloHitList;
+        pCluster->GetOrderedCaloHitList().FillCaloHitList(caloHitList);
+
+        ClusterRecord clusterRecord;
+        clusterRecord.m_particleId = pCluster->GetParticleId();
+
+        // ATTN Each worker calo hit addresses the original calo hit from which it was created as its parent
+        for (const CaloHit *const pCaloHit : caloHitList)
+            clusterRecord.m_caloHitList.push_back(static_cast<const CaloHit*>(pCaloHit->GetParentAddress()));
+
+        for (const CaloHit *const pCaloHit : pCluster->GetIsolatedCaloHitList())
+            clusterRecord.m_isolatedCaloHitList.push_back(static_cast<const CaloHit*>(pCaloHit->GetParentAddress()));
+
+        subEvent.m_clusterRecords.push_back(clusterRecord);
+    }
+
+    for (const Vertex *const pVertex : workerVertexVector)
+        subEvent.m_vertexRecords.push_back(VertexRecord(pVertex));
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode LArTPCSubEventAlgorithm::CreateOutput(const SubEvent &subEvent, std::string &clusterListName, std::string &vertexListName,
+    std::string &pfoListName) const
+{
+    ClusterVector clusterVector;
+
+    for (const ClusterRecord &clusterRecord : subEvent.m_clusterRecords)
+    {
+        if (clusterListName.empty())
+        {
+            const ClusterList *pClusterList(nullptr);
+            PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::CreateTemporaryListAndSetCurrent(*this, pClusterList, clusterListName));
+        }
+
+        PandoraContentApi::Cluster::Parameters parameters;
+        parameters.m_caloHitList = clusterRecord.m_caloHitList;
+        parameters.m_isolatedCaloHitList = clusterRecord.m_isolatedCaloHitList;
+
+        const Cluster *pCluster(nullptr);
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::Cluster::Create(*this, parameters, pCluster));
+
+        PandoraContentApi::Cluster::Metadata metadata;
+        metadata.m_particleId = clusterRecord.m_particleId;
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::Cluster::AlterMetadata(*this, pCluster, metadata));
+
+        clusterVector.push_back(pCluster);
+    }
+
+    VertexVector vertexVector;
+
+    for (const VertexRecord &vertexRecord : subEvent.m_vertexRecords)
+    {
+        if (vertexListName.empty())
+        {
+            const VertexList *pVertexList(nullptr);
+            PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::CreateTemporaryListAndSetCurrent(*this, pVertexList, vertexListName));
+        }
+
+        // ATTN The recorded position includes any x0 shift, which the vertex applies again on creation
+        PandoraContentApi::Vertex::Parameters parameters;
+        parameters.m_position = vertexRecord.m_position - CartesianVector(vertexRecord.m_x0, 0.f, 0.f);
+        parameters.m_vertexLabel = vertexRecord.m_vertexLabel;
+        parameters.m_vertexType = vertexRecord.m_vertexType;
+
+        if (std::fabs(vertexRecord.m_x0) > 0.f)
+            parameters.m_x0 = vertexRecord.m_x0;
+
+        const Vertex *pVertex(nullptr);
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::Vertex::Create(*this, parameters, pVertex));
+        vertexVector.push_back(pVertex);
+    }
+
+    PfoVector pfoVector;
+
+    for (const PfoRecord &pfoRecord : subEvent.m_pfoRecords)
+    {
+        if (pfoListName.empty())
+        {
+            const PfoList *pPfoList(nullptr);
+            PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::CreateTemporaryListAndSetCurrent(*this, pPfoList, pfoListName));
+        }
+
+        PandoraContentApi::ParticleFlowObject::Parameters parameters;
+        parameters.m_particleId = pfoRecord.m_particleId;
+        parameters.m_charge = pfoRecord.m_charge;
+        parameters.m_mass = pfoRecord.m_mass;
+        parameters.m_energy = pfoRecord.m_energy;
+        parameters.m_momentum = pfoRecord.m_momentum;
+        parameters.m_propertiesToAdd = pfoRecord.m_propertiesMap;
+
+        for (const unsigned int clusterIndex : pfoRecord.m_clusterIndices)
+            parameters.m_clusterList.push_back(clusterVector.at(clusterIndex));
+
+        for (const unsigned int vertexIndex : pfoRecord.m_vertexIndices)
+            parameters.m_vertexList.push_back(vertexVector.at(vertexIndex));
+
+        const ParticleFlowObject *pPfo(nullptr);
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::ParticleFlowObject::Create(*this, parameters, pPfo));
+        pfoVector.push_back(pPfo);
+    }
+
+    // ATTN Daughter pfos may be recorded after their parents, so the hierarchy is only rebuilt once all pfos exist
+    for (unsigned int pfoIndex = 0; pfoIndex < subEvent.m_pfoRecords.size(); ++pfoIndex)
+    {
+        for (const unsigned int daughterIndex : subEvent.m_pfoRecords.at(pfoIndex).m_daughterIndices)
+        {
+            PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::SetPfoParentDaughterRelationship(*this, pfoVector.at(pfoIndex),
+                pfoVector.at(daughterIndex)));
+        }
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode LArTPCSubEventAlgorithm::ReadSettings(const TiXmlHandle xmlHandle)
+{
+    ExternalLArTPCSubEventParameters *pExternalParameters(nullptr);
+
+    if (this->ExternalParametersPresent())
+    {
+        pExternalParameters = dynamic_cast<ExternalLArTPCSubEventParameters*>(this->GetExternalParameters());
+
+        if (!pExternalParameters)
+            return STATUS_CODE_FAILURE;
+
+        m_workerPandoraVector = pExternalParameters->m_workerPandoraVector;
+    }
+
+    if (m_workerPandoraVector.empty())
+    {
+        std::cout << "LArTPCSubEventAlgorithm - no worker pandora instances provided via external parameters." << std::endl;
+        return STATUS_CODE_NOT_INITIALIZED;
+    }
+
+    for (const Pandora *const pWorkerPandora : m_workerPandoraVector)
+    {
+        if (!pWorkerPandora || (pWorkerPandora == &this->GetPandora()) || (pWorkerPandora->GetGeometry() != this->GetPandora().GetGeometry()))
+        {
+            std::cout << "LArTPCSubEventAlgorithm - each worker must be a distinct pandora instance sharing this geometry." << std::endl;
+            return STATUS_CODE_INVALID_PARAMETER;
+        }
+    }
+
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(xmlHandle,
+        "WorkerClusterListName", m_workerClusterListName));
+
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(xmlHandle,
+        "WorkerPfoListName", m_workerPfoListName));
+
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(xmlHandle,
+        "OutputClusterListName", m_outputClusterListName));
+
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(xmlHandle,
+        "OutputVertexListName", m_outputVertexListName));
+
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(xmlHandle,
+        "OutputPfoListName", m_outputPfoListName));
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+LArTPCSubEventAlgorithm::VertexRecord::VertexRecord(const Vertex *const pVertex) :
+    m_position(pVertex->GetPosition()),
+    m_x0(pVertex->GetX0()),
+    m_vertexLabel(pVertex->GetVertexLabel()),
+    m_vertexType(pVertex->GetVertexType())
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+LArTPCSubEventAlgorithm::PfoRecord::PfoRecord(const ParticleFlowObject *const pPfo) :
+    m_particleId(pPfo->GetParticleId()),
+    m_charge(pPfo->GetCharge()),
+    m_mass(pPfo->GetMass()),
+    m_energy(pPfo->GetEnergy()),
+    m_momentum(pPfo->GetMomentum()),
+    m_propertiesMap(pPfo->GetPropertiesMap())
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+LArTPCSubEventAlgorithm::SubEvent::SubEvent(const LArTPC *const pLArTPC) :
+    m_pLArTPC(pLArTPC)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+LArTPCSubEventAlgorithm::SubEventTask::SubEventTask(const LArTPCSubEventAlgorithm &algorithm, SubEventVector &subEventVector) :
+    m_algorithm(algorithm),
+    m_subEventVector(subEventVector)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode LArTPCSubEventAlgorithm::SubEventTask::Run(const unsigned int index) const
+{
+    const unsigned int nWorkers(m_algorithm.m_workerPandoraVector.size());
+    const Pandora &workerPandora(*m_algorithm.m_workerPandoraVector.at(index));
+
+    for (unsigned int subEventIndex = index; subEventIndex < m_subEventVector.size(); subEventIndex += nWorkers)
+    {
+        PANDORA_PROFILE_SCOPE("LArTPCSubEvent");
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_algorithm.ProcessSubEvent(workerPandora, m_subEventVector.at(subEventIndex)));
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
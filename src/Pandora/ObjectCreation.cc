@@ -30,6 +30,15 @@ StatusCode ObjectCreationHelper<PARAMETERS, METADATA, OBJECT>::Create(const Pand
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+template <typename PARAMETERS, typename METADATA, typename OBJECT>
+StatusCode ObjectCreationHelper<PARAMETERS, METADATA, OBJECT>::Create(const Pandora &pandora, const ParametersVector &parametersVector,
+    const ObjectFactory<PARAMETERS, OBJECT> &factory)
+{
+    return pandora.GetPandoraApiImpl()->Create(parametersVector, factory);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 template <typename PARAMETERS, typename METADATA, typename OBJECT>
 StatusCode ObjectCreationHelper<PARAMETERS, METADATA, OBJECT>::Create(const Algorithm &algorithm, const PARAMETERS &parameters,
     const OBJECT *&pObject, const ObjectFactory<PARAMETERS, OBJECT> &factory)
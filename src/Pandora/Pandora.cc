@@ -11,6 +11,8 @@
 #include "Api/PandoraContentApi.h"
 #include "Api/PandoraContentApiImpl.h"
 
+#include "Helpers/SettingsCacheHelper.h"
+
 #include "Managers/AlgorithmManager.h"
 #include "Managers/CaloHitManager.h"
 #include "Managers/ClusterManager.h"
@@ -18,26 +20,48 @@
 #include "Managers/MCManager.h"
 #include "Managers/ParticleFlowObjectManager.h"
 #include "Managers/PluginManager.h"
+#include "Managers/ProfileAggregator.h"
+#include "Managers/ProfileManager.h"
 #include "Managers/TrackManager.h"
 #include "Managers/VertexManager.h"
 
 #include "Pandora/Pandora.h"
 #include "Pandora/PandoraImpl.h"
 #include "Pandora/PandoraSettings.h"
+#include "Pandora/ThreadPool.h"
 
 #include "Xml/tinyxml.h"
 
+#include <chrono>
+
 namespace pandora
 {
 
 Pandora::Pandora(const std::string &name) :
+    Pandora(static_cast<const GeometryManager*>(nullptr), name)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+Pandora::Pandora(const Pandora &geometryPandora, const std::string &name) :
+    Pandora(geometryPandora.GetGeometry(), name)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+Pandora::Pandora(const GeometryManager *const pSharedGeometryManager, const std::string &name) :
     m_pAlgorithmManager(nullptr),
     m_pCaloHitManager(nullptr),
     m_pClusterManager(nullptr),
     m_pGeometryManager(nullptr),
+    m_pGeometry(pSharedGeometryManager),
     m_pMCManager(nullptr),
     m_pPfoManager(nullptr),
     m_pPluginManager(nullptr),
+    m_pProfileManager(nullptr),
+    m_pThreadPool(nullptr),
     m_pTrackManager(nullptr),
     m_pVertexManager(nullptr),
     m_pPandoraSettings(nullptr),
@@ -51,12 +75,20 @@ Pandora::Pandora(const std::string &name) :
         m_pAlgorithmManager = new AlgorithmManager(this);
         m_pCaloHitManager = new CaloHitManager(this);
         m_pClusterManager = new ClusterManager(this);
-        m_pGeometryManager = new GeometryManager(this);
+
+        if (!m_pGeometry)
+        {
+            m_pGeometryManager = new GeometryManager(this);
+            m_pGeometry = m_pGeometryManager;
+        }
+
         m_pMCManager = new MCManager(this);
         m_pPfoManager = new ParticleFlowObjectManager(this);
         m_pPluginManager = new PluginManager(this);
         m_pTrackManager = new TrackManager(this);
         m_pVertexManager = new VertexManager(this);
+        m_pProfileManager = new ProfileManager(this, m_pClusterManager, m_pPfoManager, m_pVertexManager);
+        m_pThreadPool = new ThreadPool(1);
         m_pPandoraSettings = new PandoraSettings(this);
         m_pPandoraApiImpl = new PandoraApiImpl(this);
         m_pPandoraContentApiImpl = new PandoraContentApiImpl(this);
@@ -80,6 +112,9 @@ Pandora::Pandora(const std::string &name) :
 
 Pandora::~Pandora()
 {
+    if (m_pProfileManager)
+        ProfileAggregator::Remove(this, *m_pProfileManager);
+
     delete m_pAlgorithmManager;
     delete m_pCaloHitManager;
     delete m_pClusterManager;
@@ -87,6 +122,8 @@ Pandora::~Pandora()
     delete m_pMCManager;
     delete m_pPfoManager;
     delete m_pPluginManager;
+    delete m_pProfileManager;
+    delete m_pThreadPool;
     delete m_pTrackManager;
     delete m_pVertexManager;
     delete m_pPandoraSettings;
@@ -99,9 +136,9 @@ Pandora::~Pandora()
 
 StatusCode Pandora::PrepareEvent()
 {
-    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pPandoraImpl->PrepareMCParticles());
-    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pPandoraImpl->PrepareCaloHits());
-    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pPandoraImpl->PrepareTracks());
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pPandoraImpl->PrepareInputObjects());
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pPandoraImpl->MatchMCPfoTargets());
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pPandoraImpl->CalculateTrackLayerIntersections());
 
     return STATUS_CODE_SUCCESS;
 }
@@ -110,6 +147,15 @@ StatusCode Pandora::PrepareEvent()
 
 StatusCode Pandora::ProcessEvent()
 {
+    const std::chrono::steady_clock::time_point startTime(std::chrono::steady_clock::now());
+
+    // ATTN The input objects for an event exceeding the object budget are incomplete, so the event is abandoned before preparation
+    if (m_pPandoraImpl->IsObjectBudgetExceeded())
+    {
+        std::cout << "Pandora::ProcessEvent - input objects exceeded the per-event object budget" << std::endl;
+        return STATUS_CODE_BUDGET_EXCEEDED;
+    }
+
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->PrepareEvent());
 
     // Loop over algorithms
@@ -118,6 +164,16 @@ StatusCode Pandora::ProcessEvent()
     for (const std::string &algorithmName : pandoraAlgorithms)
         PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pPandoraImpl->RunAlgorithm(algorithmName));
 
+    const double latency(std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count());
+
+    if (m_pPandoraSettings->ShouldRecordEventLatency())
+        m_pProfileManager->RecordEventLatency(latency);
+
+    const float slowEventThreshold(m_pPandoraSettings->GetSlowEventThreshold());
+
+    if ((slowEventThreshold > 0.f) && (latency > slowEventThreshold))
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pPandoraImpl->WriteSlowEvent());
+
     return STATUS_CODE_SUCCESS;
 }
 
@@ -130,13 +186,21 @@ StatusCode Pandora::ResetEvent()
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-StatusCode Pandora::ReadSettings(const std::string &xmlFileName)
+StatusCode Pandora::ResetWindow(const float windowStartTime)
+{
+    return m_pPandoraImpl->ResetWindow(windowStartTime);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode Pandora::ReadSettings(const std::string &xmlFileName, const std::string &settingsCacheFileName)
 {
     try
     {
         TiXmlDocument xmlDocument(xmlFileName);
 
-        if (!xmlDocument.LoadFile())
+        if (settingsCacheFileName.empty() ? !xmlDocument.LoadFile() :
+            (STATUS_CODE_SUCCESS != SettingsCacheHelper::LoadSettings(xmlFileName, settingsCacheFileName, xmlDocument)))
         {
             std::cout << "Pandora::ReadSettings - Invalid xml file." << std::endl;
             throw StatusCodeException(STATUS_CODE_FAILURE);
@@ -146,6 +210,14 @@ StatusCode Pandora::ReadSettings(const std::string &xmlFileName)
         const TiXmlHandle xmlHandle(TiXmlHandle(xmlDocumentHandle.FirstChildElement().Element()));
 
         PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pPandoraImpl->InitializeSettings(&xmlHandle));
+
+        if ((m_pThreadPool->GetNThreads() != m_pPandoraSettings->GetNThreads()) ||
+            (m_pThreadPool->GetCoreSet() != m_pPandoraSettings->GetCoreSet()))
+        {
+            delete m_pThreadPool;
+            m_pThreadPool = nullptr;
+            m_pThreadPool = new ThreadPool(m_pPandoraSettings->GetNThreads(), m_pPandoraSettings->GetCoreSet());
+        }
         PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pPandoraImpl->InitializeAlgorithms(&xmlHandle));
         PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pPandoraImpl->InitializePlugins(&xmlHandle));
     }
@@ -188,7 +260,7 @@ const PandoraSettings *Pandora::GetSettings() const
 
 const GeometryManager *Pandora::GetGeometry() const
 {
-    return m_pGeometryManager;
+    return m_pGeometry;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -6,6 +6,7 @@
  *  $Log: $
  */
 
+#include "Api/PandoraApiImpl.h"
 #include "Api/PandoraContentApiImpl.h"
 
 #include "Managers/AlgorithmManager.h"
@@ -14,34 +15,85 @@
 #include "Managers/MCManager.h"
 #include "Managers/ParticleFlowObjectManager.h"
 #include "Managers/PluginManager.h"
+#include "Managers/ProfileAggregator.h"
+#include "Managers/ProfileManager.h"
 #include "Managers/TrackManager.h"
 #include "Managers/VertexManager.h"
 
+#include "Pandora/HotPathCounters.h"
 #include "Pandora/Pandora.h"
 #include "Pandora/PandoraImpl.h"
 #include "Pandora/PandoraSettings.h"
+#include "Pandora/ThreadPool.h"
+
+#include "Persistency/BinaryFileWriter.h"
+
+#include "Plugins/EnergyCorrectionsPlugin.h"
 
 namespace pandora
 {
 
+StatusCode PandoraImpl::PrepareInputObjects() const
+{
+    // ATTN Serial execution, on a single thread pandora instance, keeps the original mc particle, calo hit, track stage ordering
+    const PreparationTask preparationTask(*this);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pPandora->m_pThreadPool->ParallelFor(3, preparationTask, 1));
+
+    // ATTN Plugins, registered by content libraries, need not be thread-safe, so are only ever called from the calling thread
+    return m_pPandora->m_pPluginManager->m_pEnergyCorrections->MakeCaloHitEnergyCorrections(
+        m_pPandora->m_pCaloHitManager->m_indexedCaloHitVector);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 StatusCode PandoraImpl::PrepareMCParticles() const
 {
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pPandora->m_pMCManager->CreateInputList());
+
+    // ATTN In data mode, the (empty) input list is still created, so that mc particle list requests from algorithms succeed
+    if (m_pPandora->GetSettings()->IsDataMode())
+        return STATUS_CODE_SUCCESS;
+
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pPandora->m_pMCManager->AddMCParticleRelationships());
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pPandora->m_pMCManager->IdentifyPfoTargets());
 
-    UidToMCParticleWeightMap caloHitToPfoTargetsMap;
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PandoraImpl::MatchMCPfoTargets() const
+{
+    if (m_pPandora->GetSettings()->IsDataMode())
+        return STATUS_CODE_SUCCESS;
+
+    const bool useDenseUids(m_pPandora->GetSettings()->ShouldUseDenseUids());
+
+    UidToMCParticleWeightTable caloHitToPfoTargetsMap(useDenseUids);
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pPandora->m_pMCManager->CreateCaloHitToPfoTargetsMap(caloHitToPfoTargetsMap));
-    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pPandora->m_pCaloHitManager->MatchCaloHitsToMCPfoTargets(caloHitToPfoTargetsMap));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pPandora->m_pCaloHitManager->MatchCaloHitsToMCPfoTargets(caloHitToPfoTargetsMap,
+        *m_pPandora->m_pThreadPool));
 
-    UidToMCParticleWeightMap trackToPfoTargetsMap;
+    UidToMCParticleWeightTable trackToPfoTargetsMap(useDenseUids);
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pPandora->m_pMCManager->CreateTrackToPfoTargetsMap(trackToPfoTargetsMap));
-    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pPandora->m_pTrackManager->MatchTracksToMCPfoTargets(trackToPfoTargetsMap));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pPandora->m_pTrackManager->MatchTracksToMCPfoTargets(trackToPfoTargetsMap,
+        *m_pPandora->m_pThreadPool));
 
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pPandora->m_pMCManager->SelectPfoTargets());
 
     return STATUS_CODE_SUCCESS;
 }
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PandoraImpl::CalculateTrackLayerIntersections() const
+{
+    if (!m_pPandora->GetSettings()->ShouldCalculateTrackLayerIntersections())
+        return STATUS_CODE_SUCCESS;
+
+    return m_pPandora->m_pTrackManager->CalculateLayerIntersections(*m_pPandora->m_pThreadPool);
+}
+
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 StatusCode PandoraImpl::PrepareTracks() const
@@ -56,7 +108,26 @@ StatusCode PandoraImpl::PrepareTracks() const
 
 StatusCode PandoraImpl::PrepareCaloHits() const
 {
-    return m_pPandora->m_pCaloHitManager->CreateInputList();
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pPandora->m_pCaloHitManager->CreateInputList());
+
+    const PandoraSettings *const pSettings(m_pPandora->GetSettings());
+
+    if (pSettings->GetNeighbourGraphMaxDistance() > 0.f)
+    {
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pPandora->m_pCaloHitManager->CreateNeighbourGraph(
+            pSettings->GetNeighbourGraphMaxDistance(), pSettings->GetNeighbourGraphLayerWindow()));
+    }
+
+    if (pSettings->GetLArTPCHitGridDriftBinWidth() > 0.f)
+    {
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pPandora->m_pCaloHitManager->CreateLArTPCHitGrids(
+            pSettings->GetLArTPCHitGridDriftBinWidth()));
+    }
+
+    if (pSettings->ShouldPartitionInputCaloHits())
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pPandora->m_pCaloHitManager->CreateInputHitTypeLists());
+
+    return STATUS_CODE_SUCCESS;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -75,6 +146,13 @@ StatusCode PandoraImpl::RunAlgorithm(const std::string &algorithmName) const
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+bool PandoraImpl::IsObjectBudgetExceeded() const
+{
+    return m_pPandora->m_pPandoraContentApiImpl->IsObjectBudgetExceeded();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 StatusCode PandoraImpl::InitializeSettings(const TiXmlHandle *const pXmlHandle) const
 {
     return m_pPandora->m_pPandoraSettings->Initialize(pXmlHandle);
@@ -98,7 +176,54 @@ StatusCode PandoraImpl::InitializePlugins(const TiXmlHandle *const pXmlHandle) c
 
 StatusCode PandoraImpl::ResetEvent() const
 {
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->PrintEventSummaries());
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pPandora->m_pCaloHitManager->ResetForNextEvent());
+
+    return this->ResetNonCaloHitManagers();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PandoraImpl::ResetWindow(const float windowStartTime) const
+{
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->PrintEventSummaries());
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pPandora->m_pCaloHitManager->ResetForNextWindow(windowStartTime));
+
+    return this->ResetNonCaloHitManagers();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PandoraImpl::PrintEventSummaries() const
+{
+    // ATTN Contribute before the hot path counters for the calling thread are reset below
+    if (m_pPandora->GetSettings()->ShouldAggregateProfiles())
+    {
+        MemoryUsageMap currentUsageMap, peakUsageMap;
+
+        if (m_pPandora->GetSettings()->ShouldRecordMemoryUsage())
+            PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pPandora->m_pPandoraApiImpl->GetMemoryUsage(currentUsageMap, peakUsageMap));
+
+        ProfileAggregator::Update(m_pPandora, *m_pPandora->m_pProfileManager, peakUsageMap);
+    }
+
+#ifdef PANDORA_HOT_PATH_COUNTERS
+    if (m_pPandora->GetSettings()->ShouldDisplayHotPathCounters())
+        HotPathCounters::Print(m_pPandora->GetName());
+
+    HotPathCounters::Reset();
+#endif
+
+    if (m_pPandora->GetSettings()->ShouldDisplayMemoryUsage())
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pPandora->m_pPandoraApiImpl->PrintMemoryUsage());
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PandoraImpl::ResetNonCaloHitManagers() const
+{
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pPandora->m_pClusterManager->ResetForNextEvent());
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pPandora->m_pMCManager->ResetForNextEvent());
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pPandora->m_pPfoManager->ResetForNextEvent());
@@ -106,6 +231,31 @@ StatusCode PandoraImpl::ResetEvent() const
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pPandora->m_pVertexManager->ResetForNextEvent());
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pPandora->m_pAlgorithmManager->ResetForNextEvent());
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pPandora->m_pPluginManager->ResetForNextEvent());
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pPandora->m_pProfileManager->ResetForNextEvent());
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PandoraImpl::WriteSlowEvent() const
+{
+    // ATTN Written after processing, so any calo hit fragmentation or merging performed by the algorithms will be reflected in the output
+    const CaloHitManager *const pCaloHitManager(m_pPandora->m_pCaloHitManager);
+    const TrackManager *const pTrackManager(m_pPandora->m_pTrackManager);
+    const MCManager *const pMCManager(m_pPandora->m_pMCManager);
+
+    const CaloHitList *pCaloHitList(nullptr);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, pCaloHitManager->GetList(pCaloHitManager->m_inputListName, pCaloHitList));
+
+    const TrackList *pTrackList(nullptr);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, pTrackManager->GetList(pTrackManager->m_inputListName, pTrackList));
+
+    const MCParticleList *pMCParticleList(nullptr);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, pMCManager->GetList(pMCManager->m_inputListName, pMCParticleList));
+
+    BinaryFileWriter fileWriter(*m_pPandora, m_pPandora->GetSettings()->GetSlowEventFileName(), APPEND);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, fileWriter.WriteEvent(*pCaloHitList, *pTrackList, *pMCParticleList));
 
     return STATUS_CODE_SUCCESS;
 }
@@ -117,4 +267,29 @@ PandoraImpl::PandoraImpl(Pandora *const pPandora) :
 {
 }
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+PandoraImpl::PreparationTask::PreparationTask(const PandoraImpl &pandoraImpl) :
+    m_pandoraImpl(pandoraImpl)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PandoraImpl::PreparationTask::Run(const unsigned int index) const
+{
+    switch (index)
+    {
+    case 0:
+        return m_pandoraImpl.PrepareMCParticles();
+    case 1:
+        return m_pandoraImpl.PrepareCaloHits();
+    case 2:
+        return m_pandoraImpl.PrepareTracks();
+    default:
+        return STATUS_CODE_OUT_OF_RANGE;
+    }
+}
+
 } // namespace pandora
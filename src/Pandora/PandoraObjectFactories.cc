@@ -50,22 +50,7 @@ StatusCode PandoraObjectFactory<PARAMETERS, OBJECT>::Write(const Object *const /
 template <typename PARAMETERS, typename OBJECT>
 StatusCode PandoraObjectFactory<PARAMETERS, OBJECT>::Create(const PARAMETERS &parameters, const OBJECT *&pObject) const
 {
-    pObject = nullptr;
-
-    try
-    {
-        pObject = new OBJECT(parameters);
-    }
-    catch (StatusCodeException &statusCodeException)
-    {
-        delete pObject;
-        pObject = nullptr;
-
-        std::cout << "StatusCodeException caught while instantiating pandora object :" << statusCodeException.ToString() << std::endl;
-        return statusCodeException.GetStatusCode();
-    }
-
-    return STATUS_CODE_SUCCESS;
+    return PandoraObjectFactory<PARAMETERS, OBJECT>::CreateDefault(parameters, pObject);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -16,15 +16,36 @@ namespace pandora
 PandoraSettings::PandoraSettings(const Pandora *const pPandora) :
     m_isMonitoringEnabled(false),
     m_shouldDisplayAlgorithmInfo(false),
+    m_shouldProfileAlgorithms(false),
+    m_shouldRecordAlgorithmTrace(false),
+    m_shouldDisplayHotPathCounters(false),
+    m_shouldRecordEventLatency(false),
+    m_shouldRecordMemoryUsage(false),
+    m_shouldDisplayMemoryUsage(false),
+    m_shouldAggregateProfiles(false),
+    m_aggregatedProfileReportPeriod(0),
+    m_maxObjectsPerEvent(0),
+    m_nThreads(1),
     m_singleHitTypeClusteringMode(false),
+    m_shouldMaintainCaloHitClusterIndex(false),
     m_shouldCollapseMCParticlesToPfoTarget(false),
     m_useSingleMCParticleAssociation(false),
+    m_isDataMode(false),
+    m_shouldUseDenseUids(false),
     m_electromagneticEnergyResolution(0.2f),
     m_hadronicEnergyResolution(0.6f),
     m_mcPfoSelectionRadius(500.f),
     m_mcPfoSelectionMomentum(0.01f),
     m_mcPfoSelectionLowEnergyNPCutOff(1.2f),
     m_gapTolerance(0.f),
+    m_slowEventThreshold(0.f),
+    m_neighbourGraphMaxDistance(0.f),
+    m_neighbourGraphLayerWindow(1),
+    m_larTPCHitGridDriftBinWidth(0.f),
+    m_shouldPartitionInputCaloHits(false),
+    m_shouldCalculateTrackLayerIntersections(false),
+    m_shouldTrustInputObjects(false),
+    m_trustedInputValidationInterval(0),
     m_pPandora(pPandora)
 {
 }
@@ -64,10 +85,114 @@ StatusCode PandoraSettings::ReadGlobalSettings(const TiXmlHandle *const pXmlHand
     PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(*pXmlHandle,
         "ShouldDisplayAlgorithmInfo", m_shouldDisplayAlgorithmInfo));
 
+    m_shouldProfileAlgorithms = false;
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(*pXmlHandle,
+        "ShouldProfileAlgorithms", m_shouldProfileAlgorithms));
+
+    m_shouldRecordAlgorithmTrace = false;
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(*pXmlHandle,
+        "ShouldRecordAlgorithmTrace", m_shouldRecordAlgorithmTrace));
+
+    if (m_shouldRecordAlgorithmTrace && !m_shouldProfileAlgorithms)
+        return STATUS_CODE_INVALID_PARAMETER;
+
+    m_shouldDisplayHotPathCounters = false;
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(*pXmlHandle,
+        "ShouldDisplayHotPathCounters", m_shouldDisplayHotPathCounters));
+
+    m_shouldRecordEventLatency = false;
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(*pXmlHandle,
+        "ShouldRecordEventLatency", m_shouldRecordEventLatency));
+
+    m_shouldRecordMemoryUsage = false;
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(*pXmlHandle,
+        "ShouldRecordMemoryUsage", m_shouldRecordMemoryUsage));
+
+    m_shouldDisplayMemoryUsage = false;
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(*pXmlHandle,
+        "ShouldDisplayMemoryUsage", m_shouldDisplayMemoryUsage));
+
+    if (m_shouldDisplayMemoryUsage && !m_shouldRecordMemoryUsage)
+        return STATUS_CODE_INVALID_PARAMETER;
+
+    m_shouldAggregateProfiles = false;
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(*pXmlHandle,
+        "ShouldAggregateProfiles", m_shouldAggregateProfiles));
+
+    m_aggregatedProfileReportPeriod = 0;
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(*pXmlHandle,
+        "AggregatedProfileReportPeriod", m_aggregatedProfileReportPeriod));
+
+    if ((m_aggregatedProfileReportPeriod > 0) && !m_shouldAggregateProfiles)
+        return STATUS_CODE_INVALID_PARAMETER;
+
+    m_maxObjectsPerEvent = 0;
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(*pXmlHandle,
+        "MaxObjectsPerEvent", m_maxObjectsPerEvent));
+
+    m_nThreads = 1;
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(*pXmlHandle,
+        "NThreads", m_nThreads));
+
+    if (0 == m_nThreads)
+        return STATUS_CODE_INVALID_PARAMETER;
+
+    m_coreSet.clear();
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadVectorOfValues(*pXmlHandle,
+        "CoreSet", m_coreSet));
+
+    m_slowEventThreshold = 0.f;
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(*pXmlHandle,
+        "SlowEventThreshold", m_slowEventThreshold));
+
+    if (m_slowEventThreshold < 0.f)
+        return STATUS_CODE_INVALID_PARAMETER;
+
+    if (m_slowEventThreshold > 0.f)
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, XmlHelper::ReadValue(*pXmlHandle, "SlowEventFileName", m_slowEventFileName));
+
+    m_neighbourGraphMaxDistance = 0.f;
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(*pXmlHandle,
+        "NeighbourGraphMaxDistance", m_neighbourGraphMaxDistance));
+
+    if (m_neighbourGraphMaxDistance < 0.f)
+        return STATUS_CODE_INVALID_PARAMETER;
+
+    m_neighbourGraphLayerWindow = 1;
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(*pXmlHandle,
+        "NeighbourGraphLayerWindow", m_neighbourGraphLayerWindow));
+
+    m_larTPCHitGridDriftBinWidth = 0.f;
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(*pXmlHandle,
+        "LArTPCHitGridDriftBinWidth", m_larTPCHitGridDriftBinWidth));
+
+    if (m_larTPCHitGridDriftBinWidth < 0.f)
+        return STATUS_CODE_INVALID_PARAMETER;
+
+    m_shouldPartitionInputCaloHits = false;
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(*pXmlHandle,
+        "ShouldPartitionInputCaloHits", m_shouldPartitionInputCaloHits));
+
+    m_shouldCalculateTrackLayerIntersections = false;
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(*pXmlHandle,
+        "ShouldCalculateTrackLayerIntersections", m_shouldCalculateTrackLayerIntersections));
+
+    m_shouldTrustInputObjects = false;
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(*pXmlHandle,
+        "ShouldTrustInputObjects", m_shouldTrustInputObjects));
+
+    m_trustedInputValidationInterval = 0;
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(*pXmlHandle,
+        "TrustedInputValidationInterval", m_trustedInputValidationInterval));
+
     m_singleHitTypeClusteringMode = false;
     PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(*pXmlHandle,
         "SingleHitTypeClusteringMode", m_singleHitTypeClusteringMode));
 
+    m_shouldMaintainCaloHitClusterIndex = false;
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(*pXmlHandle,
+        "ShouldMaintainCaloHitClusterIndex", m_shouldMaintainCaloHitClusterIndex));
+
     m_shouldCollapseMCParticlesToPfoTarget = false;
     PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(*pXmlHandle,
         "ShouldCollapseMCParticlesToPfoTarget", m_shouldCollapseMCParticlesToPfoTarget));
@@ -76,6 +201,14 @@ StatusCode PandoraSettings::ReadGlobalSettings(const TiXmlHandle *const pXmlHand
     PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(*pXmlHandle,
         "UseSingleMCParticleAssociation", m_useSingleMCParticleAssociation));
 
+    m_isDataMode = false;
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(*pXmlHandle,
+        "IsDataMode", m_isDataMode));
+
+    m_shouldUseDenseUids = false;
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(*pXmlHandle,
+        "ShouldUseDenseUids", m_shouldUseDenseUids));
+
     m_electromagneticEnergyResolution = 0.2f;
     PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(*pXmlHandle,
         "ElectromagneticEnergyResolution", m_electromagneticEnergyResolution));
@@ -0,0 +1,97 @@
+/**
+ *  @file   PandoraSDK/src/Pandora/PdgTable.cc
+ * 
+ *  @brief  Implementation of the pdg table class.
+ * 
+ *  $Log: $
+ */
+
+#include "Pandora/PdgTable.h"
+
+namespace pandora
+{
+
+constexpr PdgTable::ParticleRecordArray PdgTable::GetSortedParticleRecords()
+{
+    ParticleRecordArray particleRecordArray{{PARTICLE_DATA_TABLE(GET_PARTICLE_RECORD_ENTRY)}};
+
+    for (unsigned int i = 1; i < N_PARTICLE_RECORDS; ++i)
+    {
+        const ParticleRecord particleRecord(particleRecordArray[i]);
+        unsigned int j(i);
+
+        for (; (j > 0) && (particleRecordArray[j - 1].m_pdgCode > particleRecord.m_pdgCode); --j)
+            particleRecordArray[j] = particleRecordArray[j - 1];
+
+        particleRecordArray[j] = particleRecord;
+    }
+
+    return particleRecordArray;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+constexpr PdgTable::DirectIndexArray PdgTable::GetDirectIndices(const ParticleRecordArray &particleRecordArray)
+{
+    static_assert(N_PARTICLE_RECORDS < 128, "PdgTable direct indices must be representable as signed char");
+
+    DirectIndexArray directIndexArray{};
+
+    for (unsigned int i = 0; i < directIndexArray.size(); ++i)
+        directIndexArray[i] = -1;
+
+    for (unsigned int i = 0; i < N_PARTICLE_RECORDS; ++i)
+    {
+        const int pdgCode(particleRecordArray[i].m_pdgCode);
+
+        if ((pdgCode >= -MAX_DIRECT_PDG_CODE) && (pdgCode <= MAX_DIRECT_PDG_CODE))
+            directIndexArray[pdgCode + MAX_DIRECT_PDG_CODE] = static_cast<signed char>(i);
+    }
+
+    return directIndexArray;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+const PdgTable::ParticleRecordArray PdgTable::m_particleRecordArray(PdgTable::GetSortedParticleRecords());
+const PdgTable::DirectIndexArray PdgTable::m_directIndexArray(PdgTable::GetDirectIndices(PdgTable::GetSortedParticleRecords()));
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode PdgTable::GetParticleRecord(const int pdgCode, const ParticleRecord *&pParticleRecord)
+{
+    if ((pdgCode >= -MAX_DIRECT_PDG_CODE) && (pdgCode <= MAX_DIRECT_PDG_CODE))
+    {
+        const int index(m_directIndexArray[pdgCode + MAX_DIRECT_PDG_CODE]);
+
+        if (index < 0)
+            return STATUS_CODE_INVALID_PARAMETER;
+
+        pParticleRecord = &m_particleRecordArray[index];
+        return STATUS_CODE_SUCCESS;
+    }
+
+    unsigned int low(0), high(N_PARTICLE_RECORDS);
+
+    while (low < high)
+    {
+        const unsigned int middle((low + high) / 2);
+
+        if (m_particleRecordArray[middle].m_pdgCode < pdgCode)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    if ((N_PARTICLE_RECORDS == low) || (pdgCode != m_particleRecordArray[low].m_pdgCode))
+        return STATUS_CODE_INVALID_PARAMETER;
+
+    pParticleRecord = &m_particleRecordArray[low];
+    return STATUS_CODE_SUCCESS;
+}
+
+} // namespace pandora
@@ -0,0 +1,106 @@
+/**
+ *  @file   PandoraSDK/src/Pandora/ProfileZones.cc
+ *
+ *  @brief  Implementation of the profile zones class.
+ *
+ *  $Log: $
+ */
+
+#include "Pandora/ProfileZones.h"
+
+#include <algorithm>
+
+#ifdef PANDORA_PROFILE_ZONES_ITT
+#include <ittnotify.h>
+#endif
+
+namespace pandora
+{
+
+const unsigned int ProfileZones::m_bufferSize(1 << 16);
+ProfileZones::ThreadBufferVector ProfileZones::m_threadBufferRegistry;
+std::mutex ProfileZones::m_threadBufferRegistryMutex;
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+unsigned int ProfileZones::GetThreadIndex()
+{
+    return ProfileZones::GetThreadBuffer().m_threadIndex;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void ProfileZones::Record(const char *const pName, const unsigned long long startTime, const unsigned long long endTime)
+{
+    ThreadBuffer &threadBuffer(ProfileZones::GetThreadBuffer());
+
+    if (threadBuffer.m_zoneRecords.empty())
+        threadBuffer.m_zoneRecords.resize(m_bufferSize);
+
+    const unsigned long long nRecorded(threadBuffer.m_nRecorded.load(std::memory_order_relaxed));
+
+    ZoneRecord &zoneRecord(threadBuffer.m_zoneRecords[nRecorded % m_bufferSize]);
+    zoneRecord.m_pName = pName;
+    zoneRecord.m_startTime = startTime;
+    zoneRecord.m_endTime = endTime;
+
+    threadBuffer.m_nRecorded.store(nRecorded + 1, std::memory_order_release);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void ProfileZones::BeginExternalZone(const char *const pName)
+{
+#ifdef PANDORA_PROFILE_ZONES_ITT
+    static __itt_domain *const pDomain(__itt_domain_create("PandoraSDK"));
+    __itt_task_begin(pDomain, __itt_null, __itt_null, __itt_string_handle_create(pName));
+#else
+    (void) pName;
+#endif
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void ProfileZones::EndExternalZone()
+{
+#ifdef PANDORA_PROFILE_ZONES_ITT
+    static __itt_domain *const pDomain(__itt_domain_create("PandoraSDK"));
+    __itt_task_end(pDomain);
+#endif
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void ProfileZones::GetZoneRecords(ThreadZoneRecordVector &threadZoneRecordVector)
+{
+    const std::lock_guard<std::mutex> lock(m_threadBufferRegistryMutex);
+
+    for (const ThreadBufferPtr &pThreadBuffer : m_threadBufferRegistry)
+    {
+        const unsigned long long nRecorded(pThreadBuffer->m_nRecorded.load(std::memory_order_acquire));
+        const unsigned long long nAvailable(std::min(nRecorded, static_cast<unsigned long long>(m_bufferSize)));
+
+        for (unsigned long long iRecord = nRecorded - nAvailable; iRecord < nRecorded; ++iRecord)
+        {
+            threadZoneRecordVector.push_back(std::make_pair(pThreadBuffer->m_threadIndex, pThreadBuffer->m_zoneRecords[iRecord % m_bufferSize]));
+        }
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+ProfileZones::ThreadBuffer &ProfileZones::GetThreadBuffer()
+{
+    thread_local ThreadBufferPtr pThreadBuffer;
+
+    if (!pThreadBuffer)
+    {
+        const std::lock_guard<std::mutex> lock(m_threadBufferRegistryMutex);
+        pThreadBuffer = std::make_shared<ThreadBuffer>(m_threadBufferRegistry.size());
+        m_threadBufferRegistry.push_back(pThreadBuffer);
+    }
+
+    return *pThreadBuffer;
+}
+
+} // namespace pandora
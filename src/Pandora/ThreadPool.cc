@@ -0,0 +1,348 @@
+/**
+ *  @file   PandoraSDK/src/Pandora/ThreadPool.cc
+ *
+ *  @brief  Implementation of the thread pool class.
+ *
+ *  $Log: $
+ */
+
+#include "Pandora/AllocationTracking.h"
+#include "Pandora/ThreadPool.h"
+
+#include <iostream>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace pandora
+{
+
+thread_local unsigned int ThreadPool::m_currentThreadIndex(0);
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+ParallelForTask::~ParallelForTask()
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+ThreadPool::ThreadPool(const unsigned int nThreads) :
+    ThreadPool(nThreads, std::vector<unsigned int>())
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+ThreadPool::ThreadPool(const unsigned int nThreads, const std::vector<unsigned int> &coreSet) :
+    m_nThreads((nThreads > 0) ? nThreads : 1),
+    m_coreSet(coreSet),
+    m_pWorkQueues(new WorkQueue[m_nThreads]),
+    m_pChunkTask(nullptr),
+    m_nItems(0),
+    m_grainSize(0),
+    m_firstFailedChunk(0),
+    m_statusCode(STATUS_CODE_SUCCESS),
+    m_pAllocationCounters(nullptr),
+    m_isRunning(false),
+    m_generation(0),
+    m_nBusyWorkers(0),
+    m_shouldStop(false)
+{
+    // ATTN The calling thread takes part in each parallel loop, using the first work queue
+    for (unsigned int queueIndex = 1; queueIndex < m_nThreads; ++queueIndex)
+        m_threadVector.push_back(std::thread(&ThreadPool::RunWorker, this, queueIndex));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_shouldStop = true;
+    }
+
+    m_condition.notify_all();
+
+    for (std::thread &thread : m_threadVector)
+        thread.join();
+
+    delete [] m_pWorkQueues;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode ThreadPool::PinCurrentThread(const std::vector<unsigned int> &coreSet)
+{
+    if (coreSet.empty())
+        return STATUS_CODE_SUCCESS;
+
+#ifdef __linux__
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+
+    for (const unsigned int core : coreSet)
+    {
+        if (core >= CPU_SETSIZE)
+            return STATUS_CODE_INVALID_PARAMETER;
+
+        CPU_SET(core, &cpuSet);
+    }
+
+    if (0 != pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet))
+        return STATUS_CODE_FAILURE;
+
+    return STATUS_CODE_SUCCESS;
+#else
+    return STATUS_CODE_NOT_ALLOWED;
+#endif
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode ThreadPool::ParallelFor(const unsigned int nItems, const ParallelForTask &task, const unsigned int grainSize)
+{
+    if (0 == grainSize)
+        return STATUS_CODE_INVALID_PARAMETER;
+
+    const ForChunkTask chunkTask(task);
+    return this->RunChunks(nItems, grainSize, chunkTask);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+unsigned int ThreadPool::GetNChunks(const unsigned int nItems, const unsigned int grainSize)
+{
+    return ((nItems / grainSize) + (((nItems % grainSize) > 0) ? 1 : 0));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode ThreadPool::RunChunks(const unsigned int nItems, const unsigned int grainSize, const ChunkTask &chunkTask)
+{
+    const unsigned int nChunks(ThreadPool::GetNChunks(nItems, grainSize));
+
+    if (0 == nChunks)
+        return STATUS_CODE_SUCCESS;
+
+    bool isParallel(false);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (!m_isRunning && !m_threadVector.empty() && (nChunks > 1))
+        {
+            for (unsigned int queueIndex = 0; queueIndex < m_nThreads; ++queueIndex)
+            {
+                const unsigned int firstChunk((static_cast<unsigned long long>(queueIndex) * nChunks) / m_nThreads);
+                const unsigned int endChunk((static_cast<unsigned long long>(queueIndex + 1) * nChunks) / m_nThreads);
+
+                std::lock_guard<std::mutex> queueLock(m_pWorkQueues[queueIndex].m_mutex);
+
+                for (unsigned int chunkIndex = firstChunk; chunkIndex < endChunk; ++chunkIndex)
+                    m_pWorkQueues[queueIndex].m_chunkIndices.push_back(chunkIndex);
+            }
+
+            m_pChunkTask = &chunkTask;
+            m_nItems = nItems;
+            m_grainSize = grainSize;
+            m_firstFailedChunk = nChunks;
+            m_statusCode = STATUS_CODE_SUCCESS;
+            m_pAllocationCounters = AllocationTracking::GetCurrentCounters();
+            m_isRunning = true;
+            ++m_generation;
+            isParallel = true;
+        }
+    }
+
+    // ATTN Nested loops, and loops on a pool without worker threads, run serially with the same chunks, giving the same results
+    if (!isParallel)
+    {
+        for (unsigned int chunkIndex = 0; chunkIndex < nChunks; ++chunkIndex)
+        {
+            const StatusCode statusCode(ThreadPool::RunChunk(chunkTask, chunkIndex, nItems, grainSize));
+
+            if (STATUS_CODE_SUCCESS != statusCode)
+                return statusCode;
+        }
+
+        return STATUS_CODE_SUCCESS;
+    }
+
+    // ATTN The calling thread may be a worker of another pool, so adopts the first thread index only for the duration of the loop
+    const unsigned int callingThreadIndex(m_currentThreadIndex);
+    m_currentThreadIndex = 0;
+
+    m_condition.notify_all();
+    this->ProcessChunks(0);
+    m_currentThreadIndex = callingThreadIndex;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (m_nBusyWorkers > 0)
+        m_condition.wait(lock);
+
+    m_pChunkTask = nullptr;
+    m_isRunning = false;
+
+    return m_statusCode;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode ThreadPool::RunChunk(const ChunkTask &chunkTask, const unsigned int chunkIndex, const unsigned int nItems, const unsigned int grainSize)
+{
+    const unsigned int firstIndex(chunkIndex * grainSize);
+    const unsigned int endIndex(((nItems - firstIndex) > grainSize) ? firstIndex + grainSize : nItems);
+
+    try
+    {
+        return chunkTask.Run(chunkIndex, firstIndex, endIndex);
+    }
+    catch (StatusCodeException &statusCodeException)
+    {
+        return statusCodeException.GetStatusCode();
+    }
+    catch (...)
+    {
+        return STATUS_CODE_FAILURE;
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void ThreadPool::ProcessChunks(const unsigned int queueIndex)
+{
+    unsigned int chunkIndex(0);
+
+    while (this->PopChunk(queueIndex, chunkIndex))
+    {
+        // ATTN Chunks beyond a failed chunk are skipped, whilst earlier chunks still run, so the first failure in index order is reported
+        if (chunkIndex > m_firstFailedChunk)
+            continue;
+
+        const StatusCode statusCode(ThreadPool::RunChunk(*m_pChunkTask, chunkIndex, m_nItems, m_grainSize));
+
+        if (STATUS_CODE_SUCCESS != statusCode)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (chunkIndex < m_firstFailedChunk)
+            {
+                m_firstFailedChunk = chunkIndex;
+                m_statusCode = statusCode;
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool ThreadPool::PopChunk(const unsigned int queueIndex, unsigned int &chunkIndex)
+{
+    {
+        WorkQueue &workQueue(m_pWorkQueues[queueIndex]);
+        std::lock_guard<std::mutex> lock(workQueue.m_mutex);
+
+        if (!workQueue.m_chunkIndices.empty())
+        {
+            chunkIndex = workQueue.m_chunkIndices.front();
+            workQueue.m_chunkIndices.pop_front();
+            return true;
+        }
+    }
+
+    for (unsigned int offset = 1; offset < m_nThreads; ++offset)
+    {
+        WorkQueue &workQueue(m_pWorkQueues[(queueIndex + offset) % m_nThreads]);
+        std::lock_guard<std::mutex> lock(workQueue.m_mutex);
+
+        if (!workQueue.m_chunkIndices.empty())
+        {
+            chunkIndex = workQueue.m_chunkIndices.back();
+            workQueue.m_chunkIndices.pop_back();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void ThreadPool::RunWorker(const unsigned int queueIndex)
+{
+    // ATTN A worker that cannot be pinned still runs, unpinned, as pinning affects only performance
+    if (STATUS_CODE_SUCCESS != ThreadPool::PinCurrentThread(m_coreSet))
+        std::cout << "ThreadPool: unable to pin worker thread to the configured core set " << std::endl;
+
+    m_currentThreadIndex = queueIndex;
+    unsigned int generation(0);
+    AllocationCounters *pAllocationCounters(nullptr);
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            while (!m_shouldStop && (!m_isRunning || (generation == m_generation)))
+                m_condition.wait(lock);
+
+            if (m_shouldStop)
+                break;
+
+            generation = m_generation;
+            pAllocationCounters = m_pAllocationCounters;
+            ++m_nBusyWorkers;
+        }
+
+        // ATTN Allocations by the workers are attributed as for the calling thread, e.g. to the algorithm starting the loop
+        AllocationTracking::SetCurrentCounters(pAllocationCounters);
+        this->ProcessChunks(queueIndex);
+        AllocationTracking::SetCurrentCounters(nullptr);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_nBusyWorkers;
+        }
+
+        m_condition.notify_all();
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+ThreadPool::ChunkTask::~ChunkTask()
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+ThreadPool::ForChunkTask::ForChunkTask(const ParallelForTask &task) :
+    m_task(task)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode ThreadPool::ForChunkTask::Run(const unsigned int /*chunkIndex*/, const unsigned int firstIndex, const unsigned int endIndex) const
+{
+    // ATTN Failures are returned without printing, as several threads may fail at once
+    for (unsigned int index = firstIndex; index < endIndex; ++index)
+    {
+        const StatusCode statusCode(m_task.Run(index));
+
+        if (STATUS_CODE_SUCCESS != statusCode)
+            return statusCode;
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
+} // namespace pandora
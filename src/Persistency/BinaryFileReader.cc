@@ -7,54 +7,169 @@
  */
 
 #include "Api/PandoraApi.h"
+#include "Api/PandoraContentApi.h"
+#include "Api/PandoraContentApiImpl.h"
 
 #include "Objects/CaloHit.h"
+#include "Objects/Cluster.h"
+#include "Objects/ParticleFlowObject.h"
 #include "Objects/Track.h"
+#include "Objects/Vertex.h"
 
 #include "Persistency/BinaryFileReader.h"
 
+#ifdef PANDORA_COMPRESSED_PERSISTENCY
+#include <zlib.h>
+#endif
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 namespace pandora
 {
 
-BinaryFileReader::BinaryFileReader(const pandora::Pandora &pandora, const std::string &fileName) :
+const unsigned int BinaryFileReader::m_caloHitDecodingGrainSize(1024);
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+BinaryFileReader::BinaryFileReader(const pandora::Pandora &pandora, const std::string &fileName, const bool useMemoryMap) :
     FileReader(pandora, fileName),
     m_containerPosition(0),
-    m_containerSize(0)
+    m_containerSize(0),
+    m_isMemoryMapped(useMemoryMap),
+    m_isCallerBuffer(false),
+    m_pMappedFile(nullptr),
+    m_mappedFileSize(0),
+    m_readLimit(0),
+    m_mappedPosition(0),
+    m_isReadingContainerBuffer(false),
+    m_bufferPosition(0)
 {
     m_fileType = BINARY;
-    m_fileStream.open(fileName.c_str(), std::ios::in | std::ios::binary);
 
-    if (!m_fileStream.is_open() || !m_fileStream.good())
+    if (!m_isMemoryMapped)
+    {
+        m_fileStream.open(fileName.c_str(), std::ios::in | std::ios::binary);
+
+        if (!m_fileStream.is_open() || !m_fileStream.good())
+            throw StatusCodeException(STATUS_CODE_FAILURE);
+
+        this->InitializeIndex();
+        return;
+    }
+
+    const int fileDescriptor(open(fileName.c_str(), O_RDONLY));
+
+    if (fileDescriptor < 0)
         throw StatusCodeException(STATUS_CODE_FAILURE);
+
+    struct stat fileStatus;
+
+    if ((0 != fstat(fileDescriptor, &fileStatus)) || (fileStatus.st_size < 0))
+    {
+        close(fileDescriptor);
+        throw StatusCodeException(STATUS_CODE_FAILURE);
+    }
+
+    m_mappedFileSize = static_cast<std::size_t>(fileStatus.st_size);
+
+    // ATTN An empty file cannot be mapped, but is left readable, with all reads failing as for an empty file stream
+    if (m_mappedFileSize > 0)
+    {
+        void *const pMappedFile(mmap(nullptr, m_mappedFileSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0));
+
+        if (MAP_FAILED == pMappedFile)
+        {
+            close(fileDescriptor);
+            throw StatusCodeException(STATUS_CODE_FAILURE);
+        }
+
+        madvise(pMappedFile, m_mappedFileSize, MADV_SEQUENTIAL);
+        m_pMappedFile = static_cast<const char*>(pMappedFile);
+    }
+
+    close(fileDescriptor);
+    m_readLimit = m_mappedFileSize;
+
+    this->InitializeIndex();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+BinaryFileReader::BinaryFileReader(const pandora::Pandora &pandora, const void *const pBuffer, const std::size_t bufferSize) :
+    FileReader(pandora, std::string()),
+    m_containerPosition(0),
+    m_containerSize(0),
+    m_isMemoryMapped(true),
+    m_isCallerBuffer(true),
+    m_pMappedFile(static_cast<const char*>(pBuffer)),
+    m_mappedFileSize(bufferSize),
+    m_readLimit(bufferSize),
+    m_mappedPosition(0),
+    m_isReadingContainerBuffer(false),
+    m_bufferPosition(0)
+{
+    m_fileType = BINARY;
+
+    if (!pBuffer && (bufferSize > 0))
+        throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
+
+    this->InitializeIndex();
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 BinaryFileReader::~BinaryFileReader()
 {
-    m_fileStream.close();
+    if (m_isMemoryMapped)
+    {
+        if (m_pMappedFile && !m_isCallerBuffer)
+            munmap(const_cast<char*>(m_pMappedFile), m_mappedFileSize);
+    }
+    else
+    {
+        m_fileStream.close();
+    }
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-StatusCode BinaryFileReader::ReadHeader()
+StatusCode BinaryFileReader::ReadReconstruction(const Algorithm &algorithm)
 {
-    std::string fileHash;
-    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(fileHash));
+    try
+    {
+        if (RECONSTRUCTION_CONTAINER != this->GetNextContainerId())
+            return STATUS_CODE_NOT_FOUND;
+    }
+    catch (StatusCodeException &)
+    {
+        return STATUS_CODE_NOT_FOUND;
+    }
 
-    if (PANDORA_FILE_HASH != fileHash)
-        return STATUS_CODE_FAILURE;
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadHeader());
 
-    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(m_containerId));
+    const StatusCode readStatusCode(this->ReadReconstructionComponents(algorithm));
+    m_containerId = UNKNOWN_CONTAINER;
 
-    if ((EVENT_CONTAINER != m_containerId) && (GEOMETRY_CONTAINER != m_containerId))
-        return STATUS_CODE_FAILURE;
+    // ATTN Always leave the read position at the container end, ready for the next event
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->SetPosition(m_containerPosition + m_containerSize));
 
-    m_containerPosition = m_fileStream.tellg();
-    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(m_containerSize));
+    return readStatusCode;
+}
 
-    if (0 == m_containerSize)
-        return STATUS_CODE_FAILURE;
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode BinaryFileReader::ReadHeader()
+{
+    bool isCompressed(false);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadContainerHeader(isCompressed));
+
+    if (isCompressed)
+    {
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->DecompressContainer());
+    }
 
     return STATUS_CODE_SUCCESS;
 }
@@ -63,20 +178,19 @@ StatusCode BinaryFileReader::ReadHeader()
 
 StatusCode BinaryFileReader::GoToNextContainer()
 {
-    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadHeader());
-    m_fileStream.seekg(m_containerPosition + m_containerSize, std::ios::beg);
-
-    if (!m_fileStream.good())
-        return STATUS_CODE_FAILURE;
+    bool isCompressed(false);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadContainerHeader(isCompressed));
 
-    return STATUS_CODE_SUCCESS;
+    return this->SetPosition(m_containerPosition + m_containerSize);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 ContainerId BinaryFileReader::GetNextContainerId()
 {
-    const std::ifstream::pos_type initialPosition(m_fileStream.tellg());
+    m_isReadingContainerBuffer = false;
+    const std::ifstream::pos_type initialPosition(this->GetPosition());
+    m_readLimit = m_mappedFileSize;
 
     std::string fileHash;
     const StatusCode fileHashStatusCode(this->ReadVariable(fileHash));
@@ -90,10 +204,13 @@ ContainerId BinaryFileReader::GetNextContainerId()
     ContainerId containerId(UNKNOWN_CONTAINER);
     PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(containerId));
 
-    m_fileStream.seekg(initialPosition, std::ios::beg);
+    PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->SetPosition(initialPosition));
 
-    if (!m_fileStream.good())
-        throw StatusCodeException(STATUS_CODE_FAILURE);
+    if (COMPRESSED_EVENT_CONTAINER == containerId)
+        return EVENT_CONTAINER;
+
+    if (COMPRESSED_GEOMETRY_CONTAINER == containerId)
+        return GEOMETRY_CONTAINER;
 
     return containerId;
 }
@@ -102,11 +219,11 @@ ContainerId BinaryFileReader::GetNextContainerId()
 
 StatusCode BinaryFileReader::GoToGeometry(const unsigned int geometryNumber)
 {
-    int nGeometriesRead(0);
-    m_fileStream.seekg(0, std::ios::beg);
+    if (geometryNumber < m_geometryPositions.size())
+        return this->SetPosition(m_geometryPositions[geometryNumber]);
 
-    if (!m_fileStream.good())
-        return STATUS_CODE_FAILURE;
+    int nGeometriesRead(0);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->SetPosition(0));
 
     if (GEOMETRY_CONTAINER != this->GetNextContainerId())
         --nGeometriesRead;
@@ -124,11 +241,11 @@ StatusCode BinaryFileReader::GoToGeometry(const unsigned int geometryNumber)
 
 StatusCode BinaryFileReader::GoToEvent(const unsigned int eventNumber)
 {
-    int nEventsRead(0);
-    m_fileStream.seekg(0, std::ios::beg);
+    if (eventNumber < m_eventPositions.size())
+        return this->SetPosition(m_eventPositions[eventNumber]);
 
-    if (!m_fileStream.good())
-        return STATUS_CODE_FAILURE;
+    int nEventsRead(0);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->SetPosition(0));
 
     if (EVENT_CONTAINER != this->GetNextContainerId())
         --nEventsRead;
@@ -196,6 +313,8 @@ StatusCode BinaryFileReader::ReadNextEventComponent()
     {
     case CALO_HIT_COMPONENT:
         return this->ReadCaloHit(false);
+    case CALO_HIT_BLOCK_COMPONENT:
+        return this->ReadCaloHitBlock(false);
     case TRACK_COMPONENT:
         return this->ReadTrack(false);
     case MC_PARTICLE_COMPONENT:
@@ -286,7 +405,7 @@ StatusCode BinaryFileReader::ReadSubDetector(bool checkComponentId)
             pParameters->m_layerParametersVector.push_back(layerParameters);
         }
 
-        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraApi::Geometry::SubDetector::Create(*m_pPandora, *pParameters, *m_pSubDetectorFactory));
+        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->CreateSubDetector(pParameters));
         delete pParameters;
     }
     catch (StatusCodeException &statusCodeException)
@@ -367,7 +486,7 @@ StatusCode BinaryFileReader::ReadLArTPC(bool checkComponentId)
         pParameters->m_sigmaUVW = sigmaUVW;
         pParameters->m_isDriftInPositiveX = isDriftInPositiveX;
 
-        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraApi::Geometry::LArTPC::Create(*m_pPandora, *pParameters, *m_pLArTPCFactory));
+        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->CreateLArTPC(pParameters));
         delete pParameters;
     }
     catch (StatusCodeException &statusCodeException)
@@ -417,7 +536,7 @@ StatusCode BinaryFileReader::ReadLineGap(bool checkComponentId)
         pParameters->m_lineEndX = lineEndX;
         pParameters->m_lineStartZ = lineStartZ;
         pParameters->m_lineEndZ = lineEndZ;
-        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraApi::Geometry::LineGap::Create(*m_pPandora, *pParameters, *m_pLineGapFactory));
+        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->CreateLineGap(pParameters));
         delete pParameters;
     }
     catch (StatusCodeException &statusCodeException)
@@ -464,7 +583,7 @@ StatusCode BinaryFileReader::ReadBoxGap(bool checkComponentId)
         pParameters->m_side1 = side1;
         pParameters->m_side2 = side2;
         pParameters->m_side3 = side3;
-        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraApi::Geometry::BoxGap::Create(*m_pPandora, *pParameters, *m_pBoxGapFactory));
+        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->CreateBoxGap(pParameters));
         delete pParameters;
     }
     catch (StatusCodeException &statusCodeException)
@@ -523,7 +642,7 @@ StatusCode BinaryFileReader::ReadConcentricGap(bool checkComponentId)
         pParameters->m_outerRCoordinate = outerRCoordinate;
         pParameters->m_outerPhiCoordinate = outerPhiCoordinate;
         pParameters->m_outerSymmetryOrder = outerSymmetryOrder;
-        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraApi::Geometry::ConcentricGap::Create(*m_pPandora, *pParameters, *m_pConcentricGapFactory));
+        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->CreateConcentricGap(pParameters));
         delete pParameters;
     }
     catch (StatusCodeException &statusCodeException)
@@ -551,7 +670,7 @@ StatusCode BinaryFileReader::ReadCaloHit(bool checkComponentId)
             return STATUS_CODE_FAILURE;
     }
 
-    PandoraApi::CaloHit::Parameters *pParameters = m_pCaloHitFactory->NewParameters();
+    PandoraApi::CaloHit::Parameters *pParameters = this->GetCaloHitParameters();
 
     try
     {
@@ -618,12 +737,12 @@ StatusCode BinaryFileReader::ReadCaloHit(bool checkComponentId)
         pParameters->m_layer = layer;
         pParameters->m_isInOuterSamplingLayer = isInOuterSamplingLayer;
         pParameters->m_pParentAddress = pParentAddress;
-        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraApi::CaloHit::Create(*m_pPandora, *pParameters, *m_pCaloHitFactory));
-        delete pParameters;
+        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->CreateCaloHit(pParameters));
+        this->DeleteParameters(pParameters);
     }
     catch (StatusCodeException &statusCodeException)
     {
-        delete pParameters;
+        this->DeleteParameters(pParameters);
         return statusCodeException.GetStatusCode();
     }
 
@@ -632,6 +751,154 @@ StatusCode BinaryFileReader::ReadCaloHit(bool checkComponentId)
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+StatusCode BinaryFileReader::ReadCaloHitBlock(bool checkComponentId)
+{
+    if (EVENT_CONTAINER != m_containerId)
+        return STATUS_CODE_FAILURE;
+
+    if (checkComponentId)
+    {
+        ComponentId componentId(UNKNOWN_COMPONENT);
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(componentId));
+
+        if (CALO_HIT_BLOCK_COMPONENT != componentId)
+            return STATUS_CODE_FAILURE;
+    }
+
+    unsigned int nCaloHits(0), recordSize(0);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(nCaloHits));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(recordSize));
+
+    if (sizeof(PackedCaloHitRecord) != recordSize)
+        return STATUS_CODE_FAILURE;
+
+    const char *pRecordBytes(nullptr);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadBytesView(static_cast<std::size_t>(nCaloHits) * recordSize, pRecordBytes));
+
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReserveCaloHits(nCaloHits));
+
+    // ATTN The records remain in place whilst the factory-extension data, which follows them, is read for each calo hit in turn
+    ThreadPool *const pThreadPool(m_pPandora->GetPandoraContentApiImpl()->GetThreadPool());
+
+    if (this->CanCreateCaloHitBatch())
+        return this->ReadCaloHitRecordsAsBatch(nCaloHits, pRecordBytes, *pThreadPool);
+
+    if ((pThreadPool->GetNThreads() > 1) && (nCaloHits > m_caloHitDecodingGrainSize))
+        return this->ReadCaloHitRecordsInParallel(nCaloHits, pRecordBytes, *pThreadPool);
+
+    StatusCode statusCode(STATUS_CODE_SUCCESS);
+
+    for (unsigned int iCaloHit = 0; (iCaloHit < nCaloHits) && (STATUS_CODE_SUCCESS == statusCode); ++iCaloHit)
+    {
+        PandoraApi::CaloHit::Parameters *pParameters = this->GetCaloHitParameters();
+        statusCode = m_pCaloHitFactory->Read(*pParameters, *this);
+
+        if (STATUS_CODE_SUCCESS == statusCode)
+        {
+            BinaryFileReader::FillCaloHitParameters(pRecordBytes + static_cast<std::size_t>(iCaloHit) * sizeof(PackedCaloHitRecord), *pParameters);
+            statusCode = this->CreateCaloHit(pParameters);
+        }
+
+        this->DeleteParameters(pParameters);
+    }
+
+    return statusCode;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode BinaryFileReader::ReadCaloHitRecordsInParallel(const unsigned int nCaloHits, const char *const pRecordBytes, ThreadPool &threadPool)
+{
+    // Read the factory-extension data in file order, then decode the records concurrently and create the calo hits in file order
+    CaloHitParametersVector parametersVector;
+    parametersVector.reserve(nCaloHits);
+
+    StatusCode statusCode(STATUS_CODE_SUCCESS);
+
+    for (unsigned int iCaloHit = 0; (iCaloHit < nCaloHits) && (STATUS_CODE_SUCCESS == statusCode); ++iCaloHit)
+    {
+        parametersVector.push_back(m_pCaloHitFactory->NewParameters());
+        statusCode = m_pCaloHitFactory->Read(*parametersVector.back(), *this);
+    }
+
+    if (STATUS_CODE_SUCCESS == statusCode)
+    {
+        const CaloHitDecodingTask caloHitDecodingTask(pRecordBytes, parametersVector);
+        statusCode = threadPool.ParallelFor(nCaloHits, caloHitDecodingTask, m_caloHitDecodingGrainSize);
+    }
+
+    for (object_creation::CaloHit::Parameters *pParameters : parametersVector)
+    {
+        if (STATUS_CODE_SUCCESS == statusCode)
+            statusCode = this->CreateCaloHit(pParameters);
+
+        this->DeleteParameters(pParameters);
+    }
+
+    return statusCode;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode BinaryFileReader::ReadCaloHitRecordsAsBatch(const unsigned int nCaloHits, const char *const pRecordBytes, ThreadPool &threadPool)
+{
+    // ATTN The default calo hit factory is in use, so the parameters may be held by value and passed to the batch creation call
+    object_creation::CaloHit::ParametersVector parametersVector(nCaloHits);
+    CaloHitParametersVector parametersAddressVector;
+    parametersAddressVector.reserve(nCaloHits);
+
+    for (object_creation::CaloHit::Parameters &parameters : parametersVector)
+    {
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pCaloHitFactory->Read(parameters, *this));
+        parametersAddressVector.push_back(&parameters);
+    }
+
+    const CaloHitDecodingTask caloHitDecodingTask(pRecordBytes, parametersAddressVector);
+
+    if ((threadPool.GetNThreads() > 1) && (nCaloHits > m_caloHitDecodingGrainSize))
+    {
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, threadPool.ParallelFor(nCaloHits, caloHitDecodingTask, m_caloHitDecodingGrainSize));
+    }
+    else
+    {
+        for (unsigned int iCaloHit = 0; iCaloHit < nCaloHits; ++iCaloHit)
+            (void) caloHitDecodingTask.Run(iCaloHit);
+    }
+
+    return this->CreateCaloHitBatch(parametersVector);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void BinaryFileReader::FillCaloHitParameters(const char *const pRecordBytes, object_creation::CaloHit::Parameters &parameters)
+{
+    PackedCaloHitRecord record;
+    std::memcpy(&record, pRecordBytes, sizeof(PackedCaloHitRecord));
+
+    parameters.m_positionVector = CartesianVector(record.m_positionVector[0], record.m_positionVector[1], record.m_positionVector[2]);
+    parameters.m_expectedDirection = CartesianVector(record.m_expectedDirection[0], record.m_expectedDirection[1], record.m_expectedDirection[2]);
+    parameters.m_cellNormalVector = CartesianVector(record.m_cellNormalVector[0], record.m_cellNormalVector[1], record.m_cellNormalVector[2]);
+    parameters.m_cellGeometry = static_cast<CellGeometry>(record.m_cellGeometry);
+    parameters.m_cellSize0 = record.m_cellSize0;
+    parameters.m_cellSize1 = record.m_cellSize1;
+    parameters.m_cellThickness = record.m_cellThickness;
+    parameters.m_nCellRadiationLengths = record.m_nCellRadiationLengths;
+    parameters.m_nCellInteractionLengths = record.m_nCellInteractionLengths;
+    parameters.m_time = record.m_time;
+    parameters.m_inputEnergy = record.m_inputEnergy;
+    parameters.m_mipEquivalentEnergy = record.m_mipEquivalentEnergy;
+    parameters.m_electromagneticEnergy = record.m_electromagneticEnergy;
+    parameters.m_hadronicEnergy = record.m_hadronicEnergy;
+    parameters.m_isDigital = (0 != record.m_isDigital);
+    parameters.m_hitType = static_cast<HitType>(record.m_hitType);
+    parameters.m_hitRegion = static_cast<HitRegion>(record.m_hitRegion);
+    parameters.m_layer = record.m_layer;
+    parameters.m_isInOuterSamplingLayer = (0 != record.m_isInOuterSamplingLayer);
+    parameters.m_pParentAddress = reinterpret_cast<const void*>(static_cast<std::uintptr_t>(record.m_parentAddress));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 StatusCode BinaryFileReader::ReadTrack(bool checkComponentId)
 {
     if (EVENT_CONTAINER != m_containerId)
@@ -646,7 +913,7 @@ StatusCode BinaryFileReader::ReadTrack(bool checkComponentId)
             return STATUS_CODE_FAILURE;
     }
 
-    PandoraApi::Track::Parameters *pParameters = m_pTrackFactory->NewParameters();
+    PandoraApi::Track::Parameters *pParameters = this->GetTrackParameters();
 
     try
     {
@@ -698,12 +965,12 @@ StatusCode BinaryFileReader::ReadTrack(bool checkComponentId)
         pParameters->m_canFormPfo = canFormPfo;
         pParameters->m_canFormClusterlessPfo = canFormClusterlessPfo;
         pParameters->m_pParentAddress = pParentAddress;
-        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraApi::Track::Create(*m_pPandora, *pParameters, *m_pTrackFactory));
-        delete pParameters;
+        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->CreateTrack(pParameters));
+        this->DeleteParameters(pParameters);
     }
     catch (StatusCodeException &statusCodeException)
     {
-        delete pParameters;
+        this->DeleteParameters(pParameters);
         return statusCodeException.GetStatusCode();
     }
 
@@ -726,7 +993,7 @@ StatusCode BinaryFileReader::ReadMCParticle(bool checkComponentId)
             return STATUS_CODE_FAILURE;
     }
 
-    PandoraApi::MCParticle::Parameters *pParameters = m_pMCParticleFactory->NewParameters();
+    PandoraApi::MCParticle::Parameters *pParameters = this->GetMCParticleParameters();
 
     try
     {
@@ -754,12 +1021,12 @@ StatusCode BinaryFileReader::ReadMCParticle(bool checkComponentId)
         pParameters->m_particleId = particleId;
         pParameters->m_mcParticleType = mcParticleType;
         pParameters->m_pParentAddress = pParentAddress;
-        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraApi::MCParticle::Create(*m_pPandora, *pParameters, *m_pMCParticleFactory));
-        delete pParameters;
+        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->CreateMCParticle(pParameters));
+        this->DeleteParameters(pParameters);
     }
     catch (StatusCodeException &statusCodeException)
     {
-        delete pParameters;
+        this->DeleteParameters(pParameters);
         return statusCodeException.GetStatusCode();
     }
 
@@ -791,22 +1058,547 @@ StatusCode BinaryFileReader::ReadRelationship(bool checkComponentId)
     float weight(1.f);
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(weight));
 
-    switch (relationshipId)
-    {
-    case CALO_HIT_TO_MC_RELATIONSHIP:
-        return PandoraApi::SetCaloHitToMCParticleRelationship(*m_pPandora, address1, address2, weight);
-    case TRACK_TO_MC_RELATIONSHIP:
-        return PandoraApi::SetTrackToMCParticleRelationship(*m_pPandora, address1, address2, weight);
-    case MC_PARENT_DAUGHTER_RELATIONSHIP:
-        return PandoraApi::SetMCParentDaughterRelationship(*m_pPandora, address1, address2);
-    case TRACK_PARENT_DAUGHTER_RELATIONSHIP:
-        return PandoraApi::SetTrackParentDaughterRelationship(*m_pPandora, address1, address2);
-    case TRACK_SIBLING_RELATIONSHIP:
-        return PandoraApi::SetTrackSiblingRelationship(*m_pPandora, address1, address2);
-    default:
+    return this->CreateRelationship(relationshipId, address1, address2, weight);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode BinaryFileReader::ReadReconstructionComponents(const Algorithm &algorithm)
+{
+    if (RECONSTRUCTION_CONTAINER != m_containerId)
+        return STATUS_CODE_FAILURE;
+
+    std::string clusterListName, vertexListName, pfoListName;
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(clusterListName));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(vertexListName));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(pfoListName));
+
+    ReconstructionState state;
+
+    const CaloHitList *pCaloHitList(nullptr);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::GetCurrentList(algorithm, pCaloHitList));
+
+    for (const CaloHit *const pCaloHit : *pCaloHitList)
+        state.m_caloHitAddressMap[pCaloHit->GetParentAddress()] = pCaloHit;
+
+    const TrackList *pTrackList(nullptr);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::GetCurrentList(algorithm, pTrackList));
+
+    for (const Track *const pTrack : *pTrackList)
+        state.m_trackAddressMap[pTrack->GetParentAddress()] = pTrack;
+
+    ComponentId componentId(UNKNOWN_COMPONENT);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(componentId));
+
+    while (RECONSTRUCTION_END_COMPONENT != componentId)
+    {
+        if (CLUSTER_COMPONENT == componentId)
+        {
+            PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadCluster(algorithm, state));
+        }
+        else if (VERTEX_COMPONENT == componentId)
+        {
+            PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVertex(algorithm, state));
+        }
+        else if (PFO_COMPONENT == componentId)
+        {
+            PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadPfo(algorithm, state));
+        }
+        else
+        {
+            return STATUS_CODE_FAILURE;
+        }
+
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(componentId));
+    }
+
+    // ATTN Daughter pfos may be stored after their parents, so the hierarchy is only rebuilt once all pfos exist
+    for (const PfoDaughterAddressVector::value_type &daughterAddress : state.m_pfoDaughterAddresses)
+    {
+        PfoAddressMap::const_iterator iter(state.m_pfoAddressMap.find(daughterAddress.second));
+
+        if (state.m_pfoAddressMap.end() == iter)
+            return STATUS_CODE_FAILURE;
+
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::SetPfoParentDaughterRelationship(algorithm, daughterAddress.first, iter->second));
+    }
+
+    if (!state.m_clusterListName.empty())
+    {
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::SaveList<Cluster>(algorithm, state.m_clusterListName, clusterListName));
+    }
+
+    if (!state.m_vertexListName.empty())
+    {
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::SaveList<Vertex>(algorithm, state.m_vertexListName, vertexListName));
+    }
+
+    if (!state.m_pfoListName.empty())
+    {
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::SaveList<ParticleFlowObject>(algorithm, state.m_pfoListName, pfoListName));
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode BinaryFileReader::ReadCluster(const Algorithm &algorithm, ReconstructionState &state)
+{
+    const void *pClusterAddress(nullptr);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(pClusterAddress));
+    int particleId(0);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(particleId));
+
+    PandoraContentApi::Cluster::Parameters parameters;
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadAddresses(state.m_caloHitAddressMap, parameters.m_caloHitList));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadAddresses(state.m_caloHitAddressMap, parameters.m_isolatedCaloHitList));
+
+    const void *pTrackSeedAddress(nullptr);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(pTrackSeedAddress));
+
+    if (pTrackSeedAddress)
+    {
+        TrackAddressMap::const_iterator iter(state.m_trackAddressMap.find(pTrackSeedAddress));
+
+        if (state.m_trackAddressMap.end() == iter)
+            return STATUS_CODE_FAILURE;
+
+        parameters.m_pTrack = iter->second;
+    }
+
+    TrackList associatedTrackList;
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadAddresses(state.m_trackAddressMap, associatedTrackList));
+
+    if (state.m_clusterListName.empty())
+    {
+        const ClusterList *pClusterList(nullptr);
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::CreateTemporaryListAndSetCurrent(algorithm, pClusterList, state.m_clusterListName));
+    }
+
+    const Cluster *pCluster(nullptr);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::Cluster::Create(algorithm, parameters, pCluster));
+
+    PandoraContentApi::Cluster::Metadata metadata;
+    metadata.m_particleId = particleId;
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::Cluster::AlterMetadata(algorithm, pCluster, metadata));
+
+    for (const Track *const pTrack : associatedTrackList)
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::AddTrackClusterAssociation(algorithm, pTrack, pCluster));
+
+    state.m_clusterAddressMap[pClusterAddress] = pCluster;
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode BinaryFileReader::ReadVertex(const Algorithm &algorithm, ReconstructionState &state)
+{
+    const void *pVertexAddress(nullptr);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(pVertexAddress));
+    CartesianVector position(0.f, 0.f, 0.f);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(position));
+    float x0(0.f);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(x0));
+    VertexLabel vertexLabel(VERTEX_INTERACTION);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(vertexLabel));
+    VertexType vertexType(VERTEX_3D);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(vertexType));
+
+    // ATTN The stored position includes any x0 shift, which the vertex applies again on creation
+    PandoraContentApi::Vertex::Parameters parameters;
+    parameters.m_position = position - CartesianVector(x0, 0.f, 0.f);
+    parameters.m_vertexLabel = vertexLabel;
+    parameters.m_vertexType = vertexType;
+
+    if (std::fabs(x0) > 0.f)
+        parameters.m_x0 = x0;
+
+    if (state.m_vertexListName.empty())
+    {
+        const VertexList *pVertexList(nullptr);
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::CreateTemporaryListAndSetCurrent(algorithm, pVertexList, state.m_vertexListName));
+    }
+
+    const Vertex *pVertex(nullptr);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::Vertex::Create(algorithm, parameters, pVertex));
+    state.m_vertexAddressMap[pVertexAddress] = pVertex;
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode BinaryFileReader::ReadPfo(const Algorithm &algorithm, ReconstructionState &state)
+{
+    const void *pPfoAddress(nullptr);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(pPfoAddress));
+    int particleId(0);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(particleId));
+    int charge(0);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(charge));
+    float mass(0.f);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(mass));
+    float energy(0.f);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(energy));
+    CartesianVector momentum(0.f, 0.f, 0.f);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(momentum));
+
+    PandoraContentApi::ParticleFlowObject::Parameters parameters;
+    parameters.m_particleId = particleId;
+    parameters.m_charge = charge;
+    parameters.m_mass = mass;
+    parameters.m_energy = energy;
+    parameters.m_momentum = momentum;
+
+    unsigned int nProperties(0);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(nProperties));
+
+    for (unsigned int iProperty = 0; iProperty < nProperties; ++iProperty)
+    {
+        std::string propertyName;
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(propertyName));
+        float propertyValue(0.f);
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(propertyValue));
+        parameters.m_propertiesToAdd[propertyName] = propertyValue;
+    }
+
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadAddresses(state.m_clusterAddressMap, parameters.m_clusterList));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadAddresses(state.m_trackAddressMap, parameters.m_trackList));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadAddresses(state.m_vertexAddressMap, parameters.m_vertexList));
+
+    unsigned int nDaughters(0);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(nDaughters));
+    std::vector<const void*> daughterAddresses;
+
+    for (unsigned int iDaughter = 0; iDaughter < nDaughters; ++iDaughter)
+    {
+        const void *pDaughterAddress(nullptr);
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(pDaughterAddress));
+        daughterAddresses.push_back(pDaughterAddress);
+    }
+
+    if (state.m_pfoListName.empty())
+    {
+        const PfoList *pPfoList(nullptr);
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::CreateTemporaryListAndSetCurrent(algorithm, pPfoList, state.m_pfoListName));
+    }
+
+    const ParticleFlowObject *pPfo(nullptr);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::ParticleFlowObject::Create(algorithm, parameters, pPfo));
+    state.m_pfoAddressMap[pPfoAddress] = pPfo;
+
+    for (const void *const pDaughterAddress : daughterAddresses)
+        state.m_pfoDaughterAddresses.push_back(PfoDaughterAddressVector::value_type(pPfo, pDaughterAddress));
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename MAP, typename T>
+StatusCode BinaryFileReader::ReadAddresses(const MAP &addressMap, T &t)
+{
+    unsigned int nEntries(0);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(nEntries));
+
+    for (unsigned int iEntry = 0; iEntry < nEntries; ++iEntry)
+    {
+        const void *pAddress(nullptr);
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(pAddress));
+
+        typename MAP::const_iterator iter(addressMap.find(pAddress));
+
+        if (addressMap.end() == iter)
+            return STATUS_CODE_FAILURE;
+
+        t.push_back(iter->second);
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode BinaryFileReader::ReadBytesView(const std::size_t nBytes, const char *&pBytes)
+{
+    if (m_isReadingContainerBuffer)
+    {
+        if (nBytes > m_containerBuffer.size() - m_bufferPosition)
+            return STATUS_CODE_FAILURE;
+
+        pBytes = m_containerBuffer.data() + m_bufferPosition;
+        m_bufferPosition += nBytes;
+
+        return STATUS_CODE_SUCCESS;
+    }
+
+    if (m_isMemoryMapped)
+    {
+        if (nBytes > m_readLimit - m_mappedPosition)
+            return STATUS_CODE_FAILURE;
+
+        pBytes = m_pMappedFile + m_mappedPosition;
+        m_mappedPosition += nBytes;
+
+        return STATUS_CODE_SUCCESS;
+    }
+
+    m_blockBuffer.resize(nBytes);
+    m_fileStream.read(m_blockBuffer.data(), nBytes);
+
+    if (!m_fileStream.good())
+        return STATUS_CODE_FAILURE;
+
+    pBytes = m_blockBuffer.data();
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode BinaryFileReader::ReadContainerHeader(bool &isCompressed)
+{
+    m_isReadingContainerBuffer = false;
+    m_readLimit = m_mappedFileSize;
+
+    std::string fileHash;
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(fileHash));
+
+    if (PANDORA_FILE_HASH != fileHash)
+        return STATUS_CODE_FAILURE;
+
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(m_containerId));
+    isCompressed = ((COMPRESSED_EVENT_CONTAINER == m_containerId) || (COMPRESSED_GEOMETRY_CONTAINER == m_containerId));
+
+    if (COMPRESSED_EVENT_CONTAINER == m_containerId)
+    {
+        m_containerId = EVENT_CONTAINER;
+    }
+    else if (COMPRESSED_GEOMETRY_CONTAINER == m_containerId)
+    {
+        m_containerId = GEOMETRY_CONTAINER;
+    }
+
+    if ((EVENT_CONTAINER != m_containerId) && (GEOMETRY_CONTAINER != m_containerId) && (INDEX_CONTAINER != m_containerId) &&
+        (RECONSTRUCTION_CONTAINER != m_containerId))
+    {
+        return STATUS_CODE_FAILURE;
+    }
+
+    m_containerPosition = this->GetPosition();
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(m_containerSize));
+
+    if (0 == m_containerSize)
+        return STATUS_CODE_FAILURE;
+
+    // ATTN For a memory-mapped file, the container extent is checked once here, and reads are then limited to the container
+    if (m_isMemoryMapped)
+    {
+        const std::size_t containerPosition(static_cast<std::size_t>(m_containerPosition));
+        const std::size_t containerSize(static_cast<std::size_t>(m_containerSize));
+
+        if ((m_containerSize < 0) || (containerSize > m_mappedFileSize - containerPosition))
+            return STATUS_CODE_FAILURE;
+
+        m_readLimit = containerPosition + containerSize;
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode BinaryFileReader::DecompressContainer()
+{
+#ifdef PANDORA_COMPRESSED_PERSISTENCY
+    unsigned int uncompressedSize(0);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(uncompressedSize));
+
+    const std::ifstream::pos_type containerEnd(m_containerPosition + std::streamoff(m_containerSize));
+    const std::streamoff compressedSize(containerEnd - this->GetPosition());
+
+    if (compressedSize <= 0)
+        return STATUS_CODE_FAILURE;
+
+    const char *pCompressedContents(nullptr);
+
+    if (m_isMemoryMapped)
+    {
+        pCompressedContents = m_pMappedFile + m_mappedPosition;
+    }
+    else
+    {
+        m_compressionBuffer.resize(compressedSize);
+        m_fileStream.read(m_compressionBuffer.data(), compressedSize);
+
+        if (!m_fileStream.good())
+            return STATUS_CODE_FAILURE;
+
+        pCompressedContents = m_compressionBuffer.data();
+    }
+
+    m_containerBuffer.resize(uncompressedSize);
+    uLongf decompressedSize(uncompressedSize);
+
+    if ((Z_OK != uncompress(reinterpret_cast<Bytef*>(m_containerBuffer.data()), &decompressedSize,
+        reinterpret_cast<const Bytef*>(pCompressedContents), compressedSize)) || (uncompressedSize != decompressedSize))
+    {
+        return STATUS_CODE_FAILURE;
+    }
+
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->SetPosition(containerEnd));
+    m_isReadingContainerBuffer = true;
+    m_bufferPosition = 0;
+
+    return STATUS_CODE_SUCCESS;
+#else
+    std::cout << "BinaryFileReader: reading compressed containers requires a build with PANDORA_COMPRESSED_PERSISTENCY" << std::endl;
+    return STATUS_CODE_NOT_ALLOWED;
+#endif
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void BinaryFileReader::InitializeIndex()
+{
+    // ATTN Without a valid index, positioning falls back to a sequential scan over the container headers
+    if (STATUS_CODE_SUCCESS != this->ReadIndex())
+    {
+        m_eventPositions.clear();
+        m_geometryPositions.clear();
+    }
+
+    m_containerId = UNKNOWN_CONTAINER;
+
+    if (!m_isMemoryMapped)
+        m_fileStream.clear();
+
+    PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->SetPosition(0));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode BinaryFileReader::ReadIndex()
+{
+    std::streamoff fileSize(static_cast<std::streamoff>(m_mappedFileSize));
+
+    if (!m_isMemoryMapped)
+    {
+        m_fileStream.seekg(0, std::ios::end);
+        fileSize = m_fileStream.tellg();
+    }
+
+    const std::streamoff trailerSize(sizeof(std::ifstream::pos_type) + sizeof(unsigned int) + PANDORA_FILE_HASH.size());
+
+    if (fileSize < trailerSize)
+        return STATUS_CODE_NOT_FOUND;
+
+    std::ifstream::pos_type indexPosition(0);
+    unsigned int fileHashSize(0);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->SetPosition(fileSize - trailerSize));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(indexPosition));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(fileHashSize));
+
+    if ((PANDORA_FILE_HASH.size() != fileHashSize) || (indexPosition < 0) || (indexPosition >= fileSize - trailerSize))
+        return STATUS_CODE_NOT_FOUND;
+
+    std::string fileHash;
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->SetPosition(fileSize - trailerSize + std::streamoff(sizeof(std::ifstream::pos_type))));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(fileHash));
+
+    if (PANDORA_FILE_HASH != fileHash)
+        return STATUS_CODE_NOT_FOUND;
+
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->SetPosition(indexPosition));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadHeader());
+
+    if ((INDEX_CONTAINER != m_containerId) || (m_containerPosition + std::streamoff(m_containerSize) != fileSize))
         return STATUS_CODE_FAILURE;
+
+    unsigned int nIndexEntries(0);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(nIndexEntries));
+
+    for (unsigned int iEntry = 0; iEntry < nIndexEntries; ++iEntry)
+    {
+        ContainerId containerId(UNKNOWN_CONTAINER);
+        std::ifstream::pos_type headerPosition(0);
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(containerId));
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable(headerPosition));
+
+        if ((headerPosition < 0) || (headerPosition >= indexPosition))
+            return STATUS_CODE_FAILURE;
+
+        if (EVENT_CONTAINER == containerId)
+        {
+            m_eventPositions.push_back(headerPosition);
+        }
+        else if (GEOMETRY_CONTAINER == containerId)
+        {
+            m_geometryPositions.push_back(headerPosition);
+        }
+        else
+        {
+            return STATUS_CODE_FAILURE;
+        }
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+std::ifstream::pos_type BinaryFileReader::GetPosition()
+{
+    if (m_isMemoryMapped)
+        return static_cast<std::streamoff>(m_mappedPosition);
+
+    return m_fileStream.tellg();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode BinaryFileReader::SetPosition(const std::ifstream::pos_type position)
+{
+    m_isReadingContainerBuffer = false;
+
+    if (m_isMemoryMapped)
+    {
+        const std::streamoff offset(position);
+
+        if ((offset < 0) || (static_cast<std::size_t>(offset) > m_mappedFileSize))
+            return STATUS_CODE_FAILURE;
+
+        // ATTN Repositioning may leave the current container, so reads are limited only by the file end until the next header is read
+        m_mappedPosition = static_cast<std::size_t>(offset);
+        m_readLimit = m_mappedFileSize;
+
+        return STATUS_CODE_SUCCESS;
     }
 
+    m_fileStream.seekg(position, std::ios::beg);
+
+    if (!m_fileStream.good())
+        return STATUS_CODE_FAILURE;
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+BinaryFileReader::CaloHitDecodingTask::CaloHitDecodingTask(const char *const pRecordBytes, const CaloHitParametersVector &parametersVector) :
+    m_pRecordBytes(pRecordBytes),
+    m_parametersVector(parametersVector)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode BinaryFileReader::CaloHitDecodingTask::Run(const unsigned int index) const
+{
+    BinaryFileReader::FillCaloHitParameters(m_pRecordBytes + static_cast<std::size_t>(index) * sizeof(PackedCaloHitRecord), *m_parametersVector[index]);
     return STATUS_CODE_SUCCESS;
 }
 
@@ -14,19 +14,46 @@
 #include "Geometry/SubDetector.h"
 
 #include "Objects/CaloHit.h"
+#include "Objects/Cluster.h"
 #include "Objects/MCParticle.h"
+#include "Objects/ParticleFlowObject.h"
 #include "Objects/Track.h"
+#include "Objects/Vertex.h"
 
 #include "Persistency/BinaryFileWriter.h"
+#include "Persistency/ContainerWriteQueue.h"
+
+#include <cstring>
+#include <limits>
+
+#ifdef PANDORA_COMPRESSED_PERSISTENCY
+#include <zlib.h>
+#endif
 
 namespace pandora
 {
 
-BinaryFileWriter::BinaryFileWriter(const pandora::Pandora &pandora, const std::string &fileName, const FileMode fileMode) :
-    FileWriter(pandora, fileName)
+BinaryFileWriter::BinaryFileWriter(const pandora::Pandora &pandora, const std::string &fileName, const FileMode fileMode,
+        const bool shouldWriteIndex, const bool shouldCompress, const unsigned int nQueuedContainers, const bool shouldPackCaloHits) :
+    FileWriter(pandora, fileName),
+    m_containerSizeOffset(0),
+    m_pOutputBuffer(nullptr),
+    m_filePosition(0),
+    m_pContainerWriteQueue(nullptr),
+    m_shouldWriteIndex(shouldWriteIndex),
+    m_shouldCompress(shouldCompress),
+    m_shouldPackCaloHits(shouldPackCaloHits)
 {
     m_fileType = BINARY;
 
+#ifndef PANDORA_COMPRESSED_PERSISTENCY
+    if (m_shouldCompress)
+    {
+        std::cout << "BinaryFileWriter: compression requires a build with PANDORA_COMPRESSED_PERSISTENCY" << std::endl;
+        throw StatusCodeException(STATUS_CODE_NOT_ALLOWED);
+    }
+#endif
+
     if (APPEND == fileMode)
     {
         m_fileStream.open(fileName.c_str(), std::ios::out | std::ios::in | std::ios::binary | std::ios::ate);
@@ -48,24 +75,146 @@ BinaryFileWriter::BinaryFileWriter(const pandora::Pandora &pandora, const std::s
     if (!m_fileStream.is_open() || !m_fileStream.good())
         throw StatusCodeException(STATUS_CODE_FAILURE);
 
-    m_containerPosition = m_fileStream.tellp();
+    if (m_shouldWriteIndex && (APPEND == fileMode))
+    {
+        std::ofstream::pos_type writePosition(m_fileStream.tellp());
+        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->IndexExistingContainers(fileName, writePosition));
+        m_fileStream.seekp(writePosition, std::ios::beg);
+
+        if (!m_fileStream.good())
+            throw StatusCodeException(STATUS_CODE_FAILURE);
+    }
+
+    m_filePosition = m_fileStream.tellp();
+
+    if (nQueuedContainers > 0)
+        m_pContainerWriteQueue = new ContainerWriteQueue(m_fileStream, nQueuedContainers);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+BinaryFileWriter::BinaryFileWriter(const pandora::Pandora &pandora, std::vector<char> &outputBuffer, const bool shouldWriteIndex,
+        const bool shouldCompress, const bool shouldPackCaloHits) :
+    FileWriter(pandora, std::string()),
+    m_containerSizeOffset(0),
+    m_pOutputBuffer(&outputBuffer),
+    m_filePosition(static_cast<std::streamoff>(outputBuffer.size())),
+    m_pContainerWriteQueue(nullptr),
+    m_shouldWriteIndex(shouldWriteIndex),
+    m_shouldCompress(shouldCompress),
+    m_shouldPackCaloHits(shouldPackCaloHits)
+{
+    m_fileType = BINARY;
+
+#ifndef PANDORA_COMPRESSED_PERSISTENCY
+    if (m_shouldCompress)
+    {
+        std::cout << "BinaryFileWriter: compression requires a build with PANDORA_COMPRESSED_PERSISTENCY" << std::endl;
+        throw StatusCodeException(STATUS_CODE_NOT_ALLOWED);
+    }
+#endif
+
+    // ATTN Containers already in the buffer are not indexed, so an index would not cover the whole buffer
+    if (m_shouldWriteIndex && !outputBuffer.empty())
+        throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 BinaryFileWriter::~BinaryFileWriter()
 {
-    m_fileStream.close();
+    // ATTN No index is written if a container has been left incomplete, so the file remains readable by sequential scan
+    if (m_shouldWriteIndex && (UNKNOWN_CONTAINER == m_containerId))
+    {
+        if (STATUS_CODE_SUCCESS != this->WriteIndex())
+            std::cout << "BinaryFileWriter: failed to write index to file " << m_fileName << std::endl;
+    }
+
+    // ATTN Queued containers are written first, preserving the order in which containers were completed
+    if (m_pContainerWriteQueue && (STATUS_CODE_SUCCESS != m_pContainerWriteQueue->Flush()))
+        std::cout << "BinaryFileWriter: failed to write queued containers to file " << m_fileName << std::endl;
+
+    delete m_pContainerWriteQueue;
+
+    // ATTN Any incomplete container is still written, matching the file contents produced by unbuffered writing
+    if (!m_containerBuffer.empty())
+    {
+        if (m_pOutputBuffer)
+        {
+            m_pOutputBuffer->insert(m_pOutputBuffer->end(), m_containerBuffer.begin(), m_containerBuffer.end());
+        }
+        else
+        {
+            m_fileStream.write(m_containerBuffer.data(), m_containerBuffer.size());
+        }
+    }
+
+    if (m_fileStream.is_open())
+        m_fileStream.close();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode BinaryFileWriter::WriteReconstruction(const std::string &clusterListName, const ClusterList &clusterList,
+    const std::string &vertexListName, const VertexList &vertexList, const std::string &pfoListName, const PfoList &pfoList)
+{
+    if (UNKNOWN_CONTAINER != m_containerId)
+        return STATUS_CODE_FAILURE;
+
+    // ATTN Check references between the objects before writing anything, so that no unreadable container is written
+    const ClusterSet clusterSet(clusterList.begin(), clusterList.end());
+    const VertexSet vertexSet(vertexList.begin(), vertexList.end());
+    const PfoSet pfoSet(pfoList.begin(), pfoList.end());
+
+    for (const ParticleFlowObject *const pPfo : pfoList)
+    {
+        for (const Cluster *const pCluster : pPfo->GetClusterList())
+        {
+            if (!clusterSet.count(pCluster))
+                return STATUS_CODE_INVALID_PARAMETER;
+        }
+
+        for (const Vertex *const pVertex : pPfo->GetVertexList())
+        {
+            if (!vertexSet.count(pVertex))
+                return STATUS_CODE_INVALID_PARAMETER;
+        }
+
+        for (const ParticleFlowObject *const pDaughterPfo : pPfo->GetDaughterPfoList())
+        {
+            if (!pfoSet.count(pDaughterPfo))
+                return STATUS_CODE_INVALID_PARAMETER;
+        }
+    }
+
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteHeader(RECONSTRUCTION_CONTAINER));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteVariable(clusterListName));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteVariable(vertexListName));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteVariable(pfoListName));
+
+    for (const Cluster *const pCluster : clusterList)
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteCluster(pCluster));
+
+    for (const Vertex *const pVertex : vertexList)
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteVertex(pVertex));
+
+    for (const ParticleFlowObject *const pPfo : pfoList)
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WritePfo(pPfo));
+
+    return this->WriteFooter();
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 StatusCode BinaryFileWriter::WriteHeader(const ContainerId containerId)
 {
+    if (m_shouldWriteIndex && (INDEX_CONTAINER != containerId) && (RECONSTRUCTION_CONTAINER != containerId))
+        m_indexEntryVector.push_back(IndexEntry(containerId, this->GetWritePosition()));
+
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteVariable(PANDORA_FILE_HASH));
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteVariable(containerId));
 
-    m_containerPosition = m_fileStream.tellp();
+    m_containerSizeOffset = m_containerBuffer.size();
     const std::ofstream::pos_type dummyContainerSize(0);
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteVariable(dummyContainerSize));
 
@@ -78,27 +227,27 @@ StatusCode BinaryFileWriter::WriteHeader(const ContainerId containerId)
 
 StatusCode BinaryFileWriter::WriteFooter()
 {
-    if ((EVENT_CONTAINER != m_containerId) && (GEOMETRY_CONTAINER != m_containerId))
-        return STATUS_CODE_FAILURE;
-
-    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteVariable((EVENT_CONTAINER == m_containerId) ? EVENT_END_COMPONENT : GEOMETRY_END_COMPONENT));
-    m_containerId = UNKNOWN_CONTAINER;
+    if (RECONSTRUCTION_CONTAINER == m_containerId)
+    {
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteVariable(RECONSTRUCTION_END_COMPONENT));
+        m_containerId = UNKNOWN_CONTAINER;
 
-    const std::ofstream::pos_type containerSize(m_fileStream.tellp() - m_containerPosition);
-    m_fileStream.seekp(m_containerPosition, std::ios::beg);
+        return this->WriteContainerBuffer();
+    }
 
-    if (!m_fileStream.good())
+    if ((EVENT_CONTAINER != m_containerId) && (GEOMETRY_CONTAINER != m_containerId))
         return STATUS_CODE_FAILURE;
 
-    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteVariable(containerSize));
-    m_fileStream.seekp(0, std::ios::end);
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteVariable((EVENT_CONTAINER == m_containerId) ? EVENT_END_COMPONENT : GEOMETRY_END_COMPONENT));
 
-    if (!m_fileStream.good())
-        return STATUS_CODE_FAILURE;
+    if (m_shouldCompress)
+    {
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->CompressContainerBuffer());
+    }
 
-    m_containerPosition = m_fileStream.tellp();
+    m_containerId = UNKNOWN_CONTAINER;
 
-    return STATUS_CODE_SUCCESS;
+    return this->WriteContainerBuffer();
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -266,6 +415,71 @@ StatusCode BinaryFileWriter::WriteCaloHit(const CaloHit *const pCaloHit)
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+StatusCode BinaryFileWriter::WriteCaloHitList(const CaloHitList &caloHitList)
+{
+    if (!m_shouldPackCaloHits)
+        return FileWriter::WriteCaloHitList(caloHitList);
+
+    if (EVENT_CONTAINER != m_containerId)
+        return STATUS_CODE_FAILURE;
+
+    const unsigned int nCaloHits(caloHitList.size());
+    const unsigned int recordSize(sizeof(PackedCaloHitRecord));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteVariable(CALO_HIT_BLOCK_COMPONENT));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteVariable(nCaloHits));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteVariable(recordSize));
+
+    // Fill the records in place, then append the factory-extension data for each calo hit, in the same order
+    const std::size_t recordOffset(m_containerBuffer.size());
+    m_containerBuffer.resize(recordOffset + static_cast<std::size_t>(nCaloHits) * recordSize);
+    char *pRecordBytes(m_containerBuffer.data() + recordOffset);
+
+    for (const CaloHit *const pCaloHit : caloHitList)
+    {
+        PackedCaloHitRecord record;
+        std::memset(&record, 0, sizeof(PackedCaloHitRecord));
+
+        record.m_parentAddress = reinterpret_cast<std::uintptr_t>(pCaloHit->GetParentAddress());
+        record.m_positionVector[0] = pCaloHit->GetPositionVector().GetX();
+        record.m_positionVector[1] = pCaloHit->GetPositionVector().GetY();
+        record.m_positionVector[2] = pCaloHit->GetPositionVector().GetZ();
+        record.m_expectedDirection[0] = pCaloHit->GetExpectedDirection().GetX();
+        record.m_expectedDirection[1] = pCaloHit->GetExpectedDirection().GetY();
+        record.m_expectedDirection[2] = pCaloHit->GetExpectedDirection().GetZ();
+        record.m_cellNormalVector[0] = pCaloHit->GetCellNormalVector().GetX();
+        record.m_cellNormalVector[1] = pCaloHit->GetCellNormalVector().GetY();
+        record.m_cellNormalVector[2] = pCaloHit->GetCellNormalVector().GetZ();
+        record.m_cellSize0 = pCaloHit->GetCellSize0();
+        record.m_cellSize1 = pCaloHit->GetCellSize1();
+        record.m_cellThickness = pCaloHit->GetCellThickness();
+        record.m_nCellRadiationLengths = pCaloHit->GetNCellRadiationLengths();
+        record.m_nCellInteractionLengths = pCaloHit->GetNCellInteractionLengths();
+        record.m_time = pCaloHit->GetTime();
+        record.m_inputEnergy = pCaloHit->GetInputEnergy();
+        record.m_mipEquivalentEnergy = pCaloHit->GetMipEquivalentEnergy();
+        record.m_electromagneticEnergy = pCaloHit->GetElectromagneticEnergy();
+        record.m_hadronicEnergy = pCaloHit->GetHadronicEnergy();
+        record.m_cellGeometry = static_cast<std::uint32_t>(pCaloHit->GetCellGeometry());
+        record.m_hitType = static_cast<std::uint32_t>(pCaloHit->GetHitType());
+        record.m_hitRegion = static_cast<std::uint32_t>(pCaloHit->GetHitRegion());
+        record.m_layer = pCaloHit->GetLayer();
+        record.m_isDigital = pCaloHit->IsDigital() ? 1 : 0;
+        record.m_isInOuterSamplingLayer = pCaloHit->IsInOuterSamplingLayer() ? 1 : 0;
+
+        std::memcpy(pRecordBytes, &record, sizeof(PackedCaloHitRecord));
+        pRecordBytes += recordSize;
+    }
+
+    for (const CaloHit *const pCaloHit : caloHitList)
+    {
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pCaloHitFactory->Write(pCaloHit, *this));
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 StatusCode BinaryFileWriter::WriteTrack(const Track *const pTrack)
 {
     if (EVENT_CONTAINER != m_containerId)
@@ -330,4 +544,270 @@ StatusCode BinaryFileWriter::WriteRelationship(const RelationshipId relationship
     return STATUS_CODE_SUCCESS;
 }
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode BinaryFileWriter::WriteCluster(const Cluster *const pCluster)
+{
+    if (RECONSTRUCTION_CONTAINER != m_containerId)
+        return STATUS_CODE_FAILURE;
+
+    CaloHitList caloHitList;
+    pCluster->GetOrderedCaloHitList().FillCaloHitList(caloHitList);
+
+    const Track *pTrackSeed(nullptr);
+    const void *pTrackSeedAddress(nullptr);
+
+    if (STATUS_CODE_SUCCESS == pCluster->GetTrackSeed(pTrackSeed))
+        pTrackSeedAddress = pTrackSeed->GetParentAddress();
+
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteVariable(CLUSTER_COMPONENT));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteVariable(static_cast<const void*>(pCluster)));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteVariable(pCluster->GetParticleId()));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteParentAddresses(caloHitList));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteParentAddresses(pCluster->GetIsolatedCaloHitList()));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteVariable(pTrackSeedAddress));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteParentAddresses(pCluster->GetAssociatedTrackList()));
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode BinaryFileWriter::WriteVertex(const Vertex *const pVertex)
+{
+    if (RECONSTRUCTION_CONTAINER != m_containerId)
+        return STATUS_CODE_FAILURE;
+
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteVariable(VERTEX_COMPONENT));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteVariable(static_cast<const void*>(pVertex)));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteVariable(pVertex->GetPosition()));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteVariable(pVertex->GetX0()));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteVariable(pVertex->GetVertexLabel()));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteVariable(pVertex->GetVertexType()));
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode BinaryFileWriter::WritePfo(const ParticleFlowObject *const pPfo)
+{
+    if (RECONSTRUCTION_CONTAINER != m_containerId)
+        return STATUS_CODE_FAILURE;
+
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteVariable(PFO_COMPONENT));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteVariable(static_cast<const void*>(pPfo)));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteVariable(pPfo->GetParticleId()));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteVariable(pPfo->GetCharge()));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteVariable(pPfo->GetMass()));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteVariable(pPfo->GetEnergy()));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteVariable(pPfo->GetMomentum()));
+
+    const PropertiesMap &propertiesMap(pPfo->GetPropertiesMap());
+    const unsigned int nProperties(propertiesMap.size());
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteVariable(nProperties));
+
+    for (const PropertiesMap::value_type &mapEntry : propertiesMap)
+    {
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteVariable(mapEntry.first));
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteVariable(mapEntry.second));
+    }
+
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteAddresses(pPfo->GetClusterList()));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteParentAddresses(pPfo->GetTrackList()));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteAddresses(pPfo->GetVertexList()));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteAddresses(pPfo->GetDaughterPfoList()));
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+StatusCode BinaryFileWriter::WriteParentAddresses(const T &t)
+{
+    const unsigned int nEntries(t.size());
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteVariable(nEntries));
+
+    for (const auto *const pT : t)
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteVariable(pT->GetParentAddress()));
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+StatusCode BinaryFileWriter::WriteAddresses(const T &t)
+{
+    const unsigned int nEntries(t.size());
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteVariable(nEntries));
+
+    for (const auto *const pT : t)
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteVariable(static_cast<const void*>(pT)));
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode BinaryFileWriter::IndexExistingContainers(const std::string &fileName, std::ofstream::pos_type &writePosition)
+{
+    std::ifstream fileStream(fileName.c_str(), std::ios::in | std::ios::binary | std::ios::ate);
+
+    if (!fileStream.is_open() || !fileStream.good())
+        return STATUS_CODE_FAILURE;
+
+    const std::ifstream::pos_type fileEnd(fileStream.tellg());
+    std::ifstream::pos_type headerPosition(0);
+    writePosition = fileEnd;
+
+    while (headerPosition != fileEnd)
+    {
+        fileStream.seekg(headerPosition, std::ios::beg);
+
+        unsigned int fileHashSize(0);
+        fileStream.read(reinterpret_cast<char*>(&fileHashSize), sizeof(unsigned int));
+
+        if (!fileStream.good() || (PANDORA_FILE_HASH.size() != fileHashSize))
+            return STATUS_CODE_FAILURE;
+
+        std::string fileHash(fileHashSize, ' ');
+        ContainerId containerId(UNKNOWN_CONTAINER);
+        std::ifstream::pos_type containerSize(0);
+        fileStream.read(&fileHash[0], fileHashSize);
+        fileStream.read(reinterpret_cast<char*>(&containerId), sizeof(ContainerId));
+        const std::ifstream::pos_type containerPosition(fileStream.tellg());
+        fileStream.read(reinterpret_cast<char*>(&containerSize), sizeof(std::ifstream::pos_type));
+
+        if (!fileStream.good() || (PANDORA_FILE_HASH != fileHash) || (containerSize <= 0) || (containerSize > fileEnd - containerPosition))
+            return STATUS_CODE_FAILURE;
+
+        const std::ifstream::pos_type nextHeaderPosition(containerPosition + std::streamoff(containerSize));
+
+        if ((EVENT_CONTAINER == containerId) || (COMPRESSED_EVENT_CONTAINER == containerId))
+        {
+            m_indexEntryVector.push_back(IndexEntry(EVENT_CONTAINER, headerPosition));
+        }
+        else if ((GEOMETRY_CONTAINER == containerId) || (COMPRESSED_GEOMETRY_CONTAINER == containerId))
+        {
+            m_indexEntryVector.push_back(IndexEntry(GEOMETRY_CONTAINER, headerPosition));
+        }
+        else if (RECONSTRUCTION_CONTAINER == containerId)
+        {
+        }
+        else if (INDEX_CONTAINER == containerId)
+        {
+            // ATTN An index at the file end is overwritten by the appended containers, whilst any earlier index is simply skipped
+            if (nextHeaderPosition == fileEnd)
+                writePosition = headerPosition;
+        }
+        else
+        {
+            return STATUS_CODE_FAILURE;
+        }
+
+        headerPosition = nextHeaderPosition;
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode BinaryFileWriter::WriteIndex()
+{
+    if (UNKNOWN_CONTAINER != m_containerId)
+        return STATUS_CODE_FAILURE;
+
+    const std::ofstream::pos_type indexPosition(this->GetWritePosition());
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteHeader(INDEX_CONTAINER));
+
+    const unsigned int nIndexEntries(m_indexEntryVector.size());
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteVariable(nIndexEntries));
+
+    for (const IndexEntry &indexEntry : m_indexEntryVector)
+    {
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteVariable(indexEntry.first));
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteVariable(indexEntry.second));
+    }
+
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteVariable(indexPosition));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->WriteVariable(PANDORA_FILE_HASH));
+    m_containerId = UNKNOWN_CONTAINER;
+
+    return this->WriteContainerBuffer();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode BinaryFileWriter::CompressContainerBuffer()
+{
+#ifdef PANDORA_COMPRESSED_PERSISTENCY
+    const std::size_t contentsOffset(m_containerSizeOffset + sizeof(std::ofstream::pos_type));
+    const std::size_t uncompressedSize(m_containerBuffer.size() - contentsOffset);
+
+    if (uncompressedSize > std::numeric_limits<unsigned int>::max())
+        return STATUS_CODE_OUT_OF_RANGE;
+
+    // ATTN The buffered header is kept, with its container id replaced, followed by the uncompressed and compressed contents
+    const ContainerId compressedContainerId((EVENT_CONTAINER == m_containerId) ? COMPRESSED_EVENT_CONTAINER : COMPRESSED_GEOMETRY_CONTAINER);
+    const unsigned int uncompressedContentsSize(uncompressedSize);
+    uLongf compressedSize(compressBound(uncompressedSize));
+    m_compressionBuffer.resize(contentsOffset + sizeof(unsigned int) + compressedSize);
+
+    std::memcpy(m_compressionBuffer.data(), m_containerBuffer.data(), contentsOffset);
+    std::memcpy(m_compressionBuffer.data() + m_containerSizeOffset - sizeof(ContainerId), &compressedContainerId, sizeof(ContainerId));
+    std::memcpy(m_compressionBuffer.data() + contentsOffset, &uncompressedContentsSize, sizeof(unsigned int));
+
+    if (Z_OK != compress2(reinterpret_cast<Bytef*>(m_compressionBuffer.data() + contentsOffset + sizeof(unsigned int)), &compressedSize,
+        reinterpret_cast<const Bytef*>(m_containerBuffer.data() + contentsOffset), uncompressedSize, Z_BEST_SPEED))
+    {
+        return STATUS_CODE_FAILURE;
+    }
+
+    m_compressionBuffer.resize(contentsOffset + sizeof(unsigned int) + compressedSize);
+    m_containerBuffer.swap(m_compressionBuffer);
+
+    return STATUS_CODE_SUCCESS;
+#else
+    return STATUS_CODE_NOT_ALLOWED;
+#endif
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode BinaryFileWriter::WriteContainerBuffer()
+{
+    const std::ofstream::pos_type containerSize(static_cast<std::streamoff>(m_containerBuffer.size() - m_containerSizeOffset));
+    std::memcpy(m_containerBuffer.data() + m_containerSizeOffset, &containerSize, sizeof(std::ofstream::pos_type));
+
+    m_filePosition += static_cast<std::streamoff>(m_containerBuffer.size());
+
+    if (m_pOutputBuffer)
+    {
+        m_pOutputBuffer->insert(m_pOutputBuffer->end(), m_containerBuffer.begin(), m_containerBuffer.end());
+        m_containerBuffer.clear();
+        return STATUS_CODE_SUCCESS;
+    }
+
+    if (m_pContainerWriteQueue)
+        return m_pContainerWriteQueue->Push(m_containerBuffer);
+
+    m_fileStream.write(m_containerBuffer.data(), m_containerBuffer.size());
+    m_containerBuffer.clear();
+
+    if (!m_fileStream.good())
+        return STATUS_CODE_FAILURE;
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+std::ofstream::pos_type BinaryFileWriter::GetWritePosition()
+{
+    return m_filePosition + static_cast<std::streamoff>(m_containerBuffer.size());
+}
+
 } // namespace pandora
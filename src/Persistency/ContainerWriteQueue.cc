@@ -0,0 +1,125 @@
+/**
+ *  @file   PandoraSDK/src/Persistency/ContainerWriteQueue.cc
+ * 
+ *  @brief  Implementation of the container write queue class.
+ * 
+ *  $Log: $
+ */
+
+#include "Persistency/ContainerWriteQueue.h"
+
+#include <algorithm>
+
+namespace pandora
+{
+
+ContainerWriteQueue::ContainerWriteQueue(std::ofstream &fileStream, const unsigned int nQueuedContainers) :
+    m_fileStream(fileStream),
+    m_nQueuedContainers(std::max(1U, nQueuedContainers)),
+    m_isWriting(false),
+    m_hasWriteFailed(false),
+    m_shouldStop(false)
+{
+    m_thread = std::thread(&ContainerWriteQueue::WriteContainers, this);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+ContainerWriteQueue::~ContainerWriteQueue()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_shouldStop = true;
+    }
+
+    m_condition.notify_all();
+    m_thread.join();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode ContainerWriteQueue::Push(ByteVector &containerBuffer)
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        while ((m_containerQueue.size() >= m_nQueuedContainers) && !m_hasWriteFailed)
+            m_condition.wait(lock);
+
+        if (m_hasWriteFailed)
+            return STATUS_CODE_FAILURE;
+
+        m_containerQueue.push_back(ByteVector());
+        m_containerQueue.back().swap(containerBuffer);
+        containerBuffer.swap(m_spareBuffer);
+    }
+
+    containerBuffer.clear();
+    m_condition.notify_all();
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode ContainerWriteQueue::Flush()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while ((!m_containerQueue.empty() || m_isWriting) && !m_hasWriteFailed)
+        m_condition.wait(lock);
+
+    return (m_hasWriteFailed ? STATUS_CODE_FAILURE : STATUS_CODE_SUCCESS);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void ContainerWriteQueue::WriteContainers()
+{
+    ByteVector containerBuffer;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            if (m_isWriting)
+            {
+                m_spareBuffer.swap(containerBuffer);
+                m_isWriting = false;
+            }
+
+            // ATTN Containers queued before the stop request are still written, so that the file is complete on destruction
+            while (m_containerQueue.empty() && !m_shouldStop)
+            {
+                m_condition.notify_all();
+                m_condition.wait(lock);
+            }
+
+            if (m_containerQueue.empty() || m_hasWriteFailed)
+                break;
+
+            containerBuffer.swap(m_containerQueue.front());
+            m_containerQueue.pop_front();
+            m_isWriting = true;
+        }
+
+        m_condition.notify_all();
+        m_fileStream.write(containerBuffer.data(), containerBuffer.size());
+
+        if (!m_fileStream.good())
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_hasWriteFailed = true;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isWriting = false;
+    }
+
+    m_condition.notify_all();
+}
+
+} // namespace pandora
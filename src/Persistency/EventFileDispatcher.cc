@@ -0,0 +1,196 @@
+/**
+ *  @file   PandoraSDK/src/Persistency/EventFileDispatcher.cc
+ * 
+ *  @brief  Implementation of the event file dispatcher class.
+ * 
+ *  $Log: $
+ */
+
+#include "Persistency/EventFileDispatcher.h"
+
+namespace pandora
+{
+
+EventFileDispatcher::EventFileDispatcher(const StringVector &fileNameVector, const bool isOrdered) :
+    m_isOrdered(isOrdered),
+    m_nextWorkUnitId(0),
+    m_nextOutputId(0)
+{
+    for (const std::string &fileName : fileNameVector)
+    {
+        FileState fileState;
+        fileState.m_fileName = fileName;
+        fileState.m_nextEventNumber = 0;
+        fileState.m_nReaders = 0;
+        fileState.m_isExhausted = false;
+        m_fileStateVector.push_back(fileState);
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode EventFileDispatcher::GetNextWorkUnit(const Pandora &pandora, WorkUnit &workUnit)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    ReaderStateMap::iterator iter(m_readerStateMap.find(&pandora));
+
+    if (m_readerStateMap.end() == iter)
+    {
+        ReaderState readerState;
+        readerState.m_fileIndex = m_fileStateVector.size();
+        readerState.m_workUnitId = 0;
+        readerState.m_hasWorkUnit = false;
+        iter = m_readerStateMap.insert(ReaderStateMap::value_type(&pandora, readerState)).first;
+    }
+
+    ReaderState &readerState(iter->second);
+    this->CompleteWorkUnit(readerState);
+
+    unsigned int fileIndex(m_fileStateVector.size());
+    const bool isFileFound(this->GetNextFileIndex(readerState, fileIndex));
+
+    if (fileIndex != readerState.m_fileIndex)
+    {
+        if (readerState.m_fileIndex < m_fileStateVector.size())
+            --m_fileStateVector[readerState.m_fileIndex].m_nReaders;
+
+        if (isFileFound)
+            ++m_fileStateVector[fileIndex].m_nReaders;
+
+        readerState.m_fileIndex = fileIndex;
+    }
+
+    if (!isFileFound)
+        return STATUS_CODE_NOT_FOUND;
+
+    FileState &fileState(m_fileStateVector[fileIndex]);
+    workUnit.m_fileName = fileState.m_fileName;
+    workUnit.m_eventNumber = fileState.m_nextEventNumber++;
+    workUnit.m_workUnitId = m_nextWorkUnitId++;
+
+    readerState.m_workUnitId = workUnit.m_workUnitId;
+    readerState.m_hasWorkUnit = true;
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode EventFileDispatcher::ReportEndOfFile(const Pandora &pandora)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    ReaderStateMap::iterator iter(m_readerStateMap.find(&pandora));
+
+    if ((m_readerStateMap.end() == iter) || !iter->second.m_hasWorkUnit)
+        return STATUS_CODE_NOT_FOUND;
+
+    m_fileStateVector[iter->second.m_fileIndex].m_isExhausted = true;
+    this->CompleteWorkUnit(iter->second);
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode EventFileDispatcher::BeginEventOutput(const Pandora &pandora)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    ReaderStateMap::const_iterator iter(m_readerStateMap.find(&pandora));
+
+    if ((m_readerStateMap.end() == iter) || !iter->second.m_hasWorkUnit)
+        return STATUS_CODE_NOT_FOUND;
+
+    if (!m_isOrdered)
+        return STATUS_CODE_SUCCESS;
+
+    const unsigned int workUnitId(iter->second.m_workUnitId);
+
+    while (workUnitId != m_nextOutputId)
+        m_condition.wait(lock);
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode EventFileDispatcher::EndEventOutput(const Pandora &pandora)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    ReaderStateMap::iterator iter(m_readerStateMap.find(&pandora));
+
+    if ((m_readerStateMap.end() == iter) || !iter->second.m_hasWorkUnit)
+        return STATUS_CODE_NOT_FOUND;
+
+    this->CompleteWorkUnit(iter->second);
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool EventFileDispatcher::GetNextFileIndex(const ReaderState &readerState, unsigned int &fileIndex) const
+{
+    const unsigned int nFiles(m_fileStateVector.size());
+
+    if (!m_isOrdered && (readerState.m_fileIndex < nFiles) && !m_fileStateVector[readerState.m_fileIndex].m_isExhausted)
+    {
+        fileIndex = readerState.m_fileIndex;
+        return true;
+    }
+
+    // ATTN In unordered mode, prefer a file not yet being read by any other pandora instance
+    unsigned int firstFileIndex(nFiles);
+
+    for (unsigned int index = 0; index < nFiles; ++index)
+    {
+        const FileState &fileState(m_fileStateVector[index]);
+
+        if (fileState.m_isExhausted)
+            continue;
+
+        if (m_isOrdered || (0 == fileState.m_nReaders))
+        {
+            fileIndex = index;
+            return true;
+        }
+
+        if (nFiles == firstFileIndex)
+            firstFileIndex = index;
+    }
+
+    fileIndex = firstFileIndex;
+
+    return (firstFileIndex < nFiles);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void EventFileDispatcher::CompleteWorkUnit(ReaderState &readerState)
+{
+    if (!readerState.m_hasWorkUnit)
+        return;
+
+    readerState.m_hasWorkUnit = false;
+
+    if (readerState.m_workUnitId != m_nextOutputId)
+    {
+        m_completedIdSet.insert(readerState.m_workUnitId);
+        return;
+    }
+
+    ++m_nextOutputId;
+
+    while (!m_completedIdSet.empty() && (*m_completedIdSet.begin() == m_nextOutputId))
+    {
+        m_completedIdSet.erase(m_completedIdSet.begin());
+        ++m_nextOutputId;
+    }
+
+    m_condition.notify_all();
+}
+
+} // namespace pandora
@@ -0,0 +1,126 @@
+/**
+ *  @file   PandoraSDK/src/Persistency/EventPrefetcher.cc
+ * 
+ *  @brief  Implementation of the event prefetcher class.
+ * 
+ *  $Log: $
+ */
+
+#include "Persistency/EventPrefetcher.h"
+#include "Persistency/EventRecord.h"
+#include "Persistency/FileReader.h"
+
+#include <algorithm>
+
+namespace pandora
+{
+
+EventPrefetcher::EventPrefetcher(FileReader &fileReader, const unsigned int nPrefetchEvents) :
+    m_fileReader(fileReader),
+    m_nPrefetchEvents(std::max(1U, nPrefetchEvents)),
+    m_isReadingFinished(false),
+    m_shouldStop(false)
+{
+    m_thread = std::thread(&EventPrefetcher::ReadEvents, this);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+EventPrefetcher::~EventPrefetcher()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_shouldStop = true;
+    }
+
+    m_condition.notify_all();
+    m_thread.join();
+
+    for (const PrefetchedEvent &prefetchedEvent : m_prefetchedEventQueue)
+        delete prefetchedEvent.m_pEventRecord;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode EventPrefetcher::ReplayNextEvent()
+{
+    PrefetchedEvent prefetchedEvent;
+
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        while (m_prefetchedEventQueue.empty() && !m_isReadingFinished)
+            m_condition.wait(lock);
+
+        // ATTN Only reached once the final read, which raised an exception, has already been replayed
+        if (m_prefetchedEventQueue.empty())
+            throw StatusCodeException(STATUS_CODE_NOT_FOUND);
+
+        prefetchedEvent = m_prefetchedEventQueue.front();
+        m_prefetchedEventQueue.pop_front();
+    }
+
+    m_condition.notify_all();
+
+    const StatusCode createStatusCode(m_fileReader.CreateEvent(*prefetchedEvent.m_pEventRecord));
+    delete prefetchedEvent.m_pEventRecord;
+
+    if (prefetchedEvent.m_isException)
+        throw StatusCodeException(prefetchedEvent.m_statusCode);
+
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, createStatusCode);
+
+    return prefetchedEvent.m_statusCode;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void EventPrefetcher::ReadEvents()
+{
+    bool isException(false);
+
+    while (!isException)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            while ((m_prefetchedEventQueue.size() >= m_nPrefetchEvents) && !m_shouldStop)
+                m_condition.wait(lock);
+
+            if (m_shouldStop)
+                break;
+        }
+
+        PrefetchedEvent prefetchedEvent;
+        prefetchedEvent.m_pEventRecord = new EventRecord;
+        prefetchedEvent.m_statusCode = STATUS_CODE_SUCCESS;
+        prefetchedEvent.m_isException = false;
+
+        try
+        {
+            prefetchedEvent.m_statusCode = m_fileReader.ReadEvent(*prefetchedEvent.m_pEventRecord);
+        }
+        catch (const StatusCodeException &statusCodeException)
+        {
+            prefetchedEvent.m_statusCode = statusCodeException.GetStatusCode();
+            prefetchedEvent.m_isException = true;
+            isException = true;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_prefetchedEventQueue.push_back(prefetchedEvent);
+        }
+
+        m_condition.notify_all();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isReadingFinished = true;
+    }
+
+    m_condition.notify_all();
+}
+
+} // namespace pandora
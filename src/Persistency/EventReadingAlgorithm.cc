@@ -10,6 +10,9 @@
 
 #include "Persistency/EventReadingAlgorithm.h"
 #include "Persistency/BinaryFileReader.h"
+#include "Persistency/EventFileDispatcher.h"
+#include "Persistency/EventPrefetcher.h"
+#include "Persistency/GeometryRecord.h"
 #include "Persistency/XmlFileReader.h"
 
 #include <algorithm>
@@ -18,7 +21,17 @@ using namespace pandora;
 
 EventReadingAlgorithm::EventReadingAlgorithm() :
     m_skipToEvent(0),
-    m_pEventFileReader(nullptr)
+    m_useMemoryMappedFiles(false),
+    m_useStreamingXmlFiles(false),
+    m_nPrefetchEvents(0),
+    m_shouldReadReconstruction(false),
+    m_pEventFileReader(nullptr),
+    m_pEventPrefetcher(nullptr),
+    m_pEventFileDispatcher(nullptr),
+    m_pGeometryRecord(nullptr),
+    m_pEventBuffer(nullptr),
+    m_eventBufferSize(0),
+    m_nextEventNumber(0)
 {
 }
 
@@ -26,6 +39,7 @@ EventReadingAlgorithm::EventReadingAlgorithm() :
 
 EventReadingAlgorithm::~EventReadingAlgorithm()
 {
+    delete m_pEventPrefetcher;
     delete m_pEventFileReader;
 }
 
@@ -33,18 +47,22 @@ EventReadingAlgorithm::~EventReadingAlgorithm()
 
 StatusCode EventReadingAlgorithm::Initialize()
 {
-    if (!m_geometryFileName.empty())
+    if (m_pGeometryRecord)
+    {
+        PANDORA_RETURN_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, m_pGeometryRecord->CreateGeometry(this->GetPandora()));
+    }
+    else if (!m_geometryFileName.empty())
     {
         const FileType geometryFileType(this->GetFileType(m_geometryFileName));
 
         if (BINARY == geometryFileType)
         {
-            BinaryFileReader fileReader(this->GetPandora(), m_geometryFileName);
+            BinaryFileReader fileReader(this->GetPandora(), m_geometryFileName, m_useMemoryMappedFiles);
             PANDORA_RETURN_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, fileReader.ReadGeometry());
         }
         else if (XML == geometryFileType)
         {
-            XmlFileReader fileReader(this->GetPandora(), m_geometryFileName);
+            XmlFileReader fileReader(this->GetPandora(), m_geometryFileName, m_useStreamingXmlFiles);
             PANDORA_RETURN_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, fileReader.ReadGeometry());
         }
         else
@@ -53,7 +71,12 @@ StatusCode EventReadingAlgorithm::Initialize()
         }
     }
 
-    if (!m_eventFileName.empty())
+    if (m_pEventBuffer)
+    {
+        m_pEventFileReader = new BinaryFileReader(this->GetPandora(), m_pEventBuffer, m_eventBufferSize);
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pEventFileReader->GoToEvent(m_skipToEvent));
+    }
+    else if (!m_eventFileName.empty())
     {
         PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReplaceEventFileReader(m_eventFileName));
         PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pEventFileReader->GoToEvent(m_skipToEvent));
@@ -66,11 +89,18 @@ StatusCode EventReadingAlgorithm::Initialize()
 
 StatusCode EventReadingAlgorithm::Run()
 {
-    if ((nullptr != m_pEventFileReader) && !m_eventFileName.empty())
+    if (m_pEventFileDispatcher)
+    {
+        this->ReadDispatchedEvent();
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::RepeatEventPreparation(*this));
+        return this->ReadReconstruction();
+    }
+
+    if ((nullptr != m_pEventFileReader) && (m_pEventBuffer || !m_eventFileName.empty()))
     {
         try
         {
-            m_pEventFileReader->ReadEvent();
+            this->ReadNextEvent();
         }
         catch (const StatusCodeException &)
         {
@@ -78,6 +108,7 @@ StatusCode EventReadingAlgorithm::Run()
         }
 
         PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraContentApi::RepeatEventPreparation(*this));
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadReconstruction());
     }
 
     return STATUS_CODE_SUCCESS;
@@ -96,7 +127,7 @@ void EventReadingAlgorithm::MoveToNextEventFile()
 
     try
     {
-        m_pEventFileReader->ReadEvent();
+        this->ReadNextEvent();
     }
     catch (const StatusCodeException &)
     {
@@ -106,8 +137,86 @@ void EventReadingAlgorithm::MoveToNextEventFile()
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+void EventReadingAlgorithm::ReadDispatchedEvent()
+{
+    EventFileDispatcher::WorkUnit workUnit;
+
+    while (STATUS_CODE_SUCCESS == m_pEventFileDispatcher->GetNextWorkUnit(this->GetPandora(), workUnit))
+    {
+        try
+        {
+            if (!m_pEventFileReader || (workUnit.m_fileName != m_eventFileName))
+            {
+                m_eventFileName = workUnit.m_fileName;
+                m_nextEventNumber = 0;
+                PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReplaceEventFileReader(m_eventFileName));
+            }
+
+            // ATTN Skip forwards from the last event read where possible, rather than searching again from the start of the file
+            const bool canSkip((m_nextEventNumber > 0) && (workUnit.m_eventNumber >= m_nextEventNumber));
+            StatusCode statusCode(canSkip ? m_pEventFileReader->SkipEvents(workUnit.m_eventNumber - m_nextEventNumber) :
+                m_pEventFileReader->GoToEvent(workUnit.m_eventNumber));
+
+            if (STATUS_CODE_SUCCESS == statusCode)
+                statusCode = m_pEventFileReader->ReadEvent();
+
+            if (STATUS_CODE_SUCCESS == statusCode)
+            {
+                m_nextEventNumber = workUnit.m_eventNumber + 1;
+                return;
+            }
+        }
+        catch (const StatusCodeException &)
+        {
+        }
+
+        // ATTN Position of failed reader is unreliable, so reopen the file if another of its events is dispatched
+        m_eventFileName.clear();
+        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pEventFileDispatcher->ReportEndOfFile(this->GetPandora()));
+    }
+
+    throw StopProcessingException("All event files processed");
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode EventReadingAlgorithm::ReadNextEvent()
+{
+    if (0 == m_nPrefetchEvents)
+        return m_pEventFileReader->ReadEvent();
+
+    // ATTN Prefetcher created on first read, so that it starts from the position reached via any initial skip to event
+    if (!m_pEventPrefetcher)
+        m_pEventPrefetcher = new EventPrefetcher(*m_pEventFileReader, m_nPrefetchEvents);
+
+    return m_pEventPrefetcher->ReplayNextEvent();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode EventReadingAlgorithm::ReadReconstruction()
+{
+    if (!m_shouldReadReconstruction)
+        return STATUS_CODE_SUCCESS;
+
+    // ATTN Reconstruction outputs are only ever written to binary files, so there is nothing to read from an xml file
+    BinaryFileReader *const pBinaryFileReader(dynamic_cast<BinaryFileReader*>(m_pEventFileReader));
+
+    if (!pBinaryFileReader)
+        return STATUS_CODE_SUCCESS;
+
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, pBinaryFileReader->ReadReconstruction(*this));
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 StatusCode EventReadingAlgorithm::ReplaceEventFileReader(const std::string &fileName)
 {
+    delete m_pEventPrefetcher;
+    m_pEventPrefetcher = nullptr;
+
     delete m_pEventFileReader;
     m_pEventFileReader = nullptr;
 
@@ -116,11 +225,11 @@ StatusCode EventReadingAlgorithm::ReplaceEventFileReader(const std::string &file
 
     if (BINARY == eventFileType)
     {
-        m_pEventFileReader = new BinaryFileReader(this->GetPandora(), fileName);
+        m_pEventFileReader = new BinaryFileReader(this->GetPandora(), fileName, m_useMemoryMappedFiles);
     }
     else if (XML == eventFileType)
     {
-        m_pEventFileReader = new XmlFileReader(this->GetPandora(), fileName);
+        m_pEventFileReader = new XmlFileReader(this->GetPandora(), fileName, m_useStreamingXmlFiles);
     }
     else
     {
@@ -166,7 +275,11 @@ StatusCode EventReadingAlgorithm::ReadSettings(const TiXmlHandle xmlHandle)
             return STATUS_CODE_FAILURE;
     }
 
-    if (pExternalParameters && !pExternalParameters->m_geometryFileName.empty())
+    if (pExternalParameters && pExternalParameters->m_pGeometryRecord)
+    {
+        m_pGeometryRecord = pExternalParameters->m_pGeometryRecord;
+    }
+    else if (pExternalParameters && !pExternalParameters->m_geometryFileName.empty())
     {
         m_geometryFileName = pExternalParameters->m_geometryFileName;
     }
@@ -175,7 +288,16 @@ StatusCode EventReadingAlgorithm::ReadSettings(const TiXmlHandle xmlHandle)
         PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(xmlHandle, "GeometryFileName", m_geometryFileName));
     }
 
-    if (pExternalParameters && !pExternalParameters->m_eventFileNameList.empty())
+    if (pExternalParameters && pExternalParameters->m_pEventFileDispatcher)
+    {
+        m_pEventFileDispatcher = pExternalParameters->m_pEventFileDispatcher;
+    }
+    else if (pExternalParameters && pExternalParameters->m_pEventBuffer)
+    {
+        m_pEventBuffer = pExternalParameters->m_pEventBuffer;
+        m_eventBufferSize = pExternalParameters->m_eventBufferSize;
+    }
+    else if (pExternalParameters && !pExternalParameters->m_eventFileNameList.empty())
     {
         XmlHelper::TokenizeString(pExternalParameters->m_eventFileNameList, m_eventFileNameVector, ":");
     }
@@ -200,7 +322,7 @@ StatusCode EventReadingAlgorithm::ReadSettings(const TiXmlHandle xmlHandle)
         PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(xmlHandle, "SkipToEvent", m_skipToEvent));
     }
 
-    if (m_geometryFileName.empty() && m_eventFileName.empty())
+    if (!m_pGeometryRecord && m_geometryFileName.empty() && m_eventFileName.empty() && !m_pEventFileDispatcher && !m_pEventBuffer)
     {
         std::cout << "EventReadingAlgorithm - nothing to do; neither geometry nor event file specified." << std::endl;
         return STATUS_CODE_NOT_INITIALIZED;
@@ -209,5 +331,24 @@ StatusCode EventReadingAlgorithm::ReadSettings(const TiXmlHandle xmlHandle)
     PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(xmlHandle,
         "SkipToEvent", m_skipToEvent));
 
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(xmlHandle,
+        "UseMemoryMappedFiles", m_useMemoryMappedFiles));
+
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(xmlHandle,
+        "UseStreamingXmlFiles", m_useStreamingXmlFiles));
+
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(xmlHandle,
+        "PrefetchEventCount", m_nPrefetchEvents));
+
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(xmlHandle,
+        "ShouldReadReconstruction", m_shouldReadReconstruction));
+
+    // ATTN The prefetcher reads ahead of the current event, so the reconstruction container following it is no longer next in the file
+    if (m_shouldReadReconstruction && (m_nPrefetchEvents > 0))
+    {
+        std::cout << "EventReadingAlgorithm: ShouldReadReconstruction cannot be combined with PrefetchEventCount " << std::endl;
+        return STATUS_CODE_INVALID_PARAMETER;
+    }
+
     return STATUS_CODE_SUCCESS;
 }
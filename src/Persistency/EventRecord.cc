@@ -0,0 +1,44 @@
+/**
+ *  @file   PandoraSDK/src/Persistency/EventRecord.cc
+ * 
+ *  @brief  Implementation of the event record class.
+ * 
+ *  $Log: $
+ */
+
+#include "Persistency/EventRecord.h"
+
+namespace pandora
+{
+
+EventRecord::EventRecord()
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+EventRecord::~EventRecord()
+{
+    this->Clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void EventRecord::Clear()
+{
+    for (const object_creation::CaloHit::Parameters *const pParameters : m_caloHitParametersVector)
+        delete pParameters;
+
+    for (const object_creation::Track::Parameters *const pParameters : m_trackParametersVector)
+        delete pParameters;
+
+    for (const object_creation::MCParticle::Parameters *const pParameters : m_mcParticleParametersVector)
+        delete pParameters;
+
+    m_caloHitParametersVector.clear();
+    m_trackParametersVector.clear();
+    m_mcParticleParametersVector.clear();
+    m_relationshipVector.clear();
+}
+
+} // namespace pandora
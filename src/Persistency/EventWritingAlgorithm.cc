@@ -23,6 +23,12 @@ EventWritingAlgorithm::EventWritingAlgorithm() :
     m_shouldWriteTrackRelationships(true),
     m_shouldOverwriteEventFile(false),
     m_shouldOverwriteGeometryFile(false),
+    m_shouldWriteFileIndex(false),
+    m_shouldCompressBinaryFiles(false),
+    m_shouldPackCaloHits(false),
+    m_shouldStreamXmlFiles(false),
+    m_nQueuedEventContainers(0),
+    m_shouldWriteReconstruction(false),
     m_pEventFileWriter(nullptr)
 {
 }
@@ -44,12 +50,13 @@ StatusCode EventWritingAlgorithm::Initialize()
 
         if (BINARY == m_geometryFileType)
         {
-            BinaryFileWriter geometryFileWriter(this->GetPandora(), m_geometryFileName, fileMode);
+            BinaryFileWriter geometryFileWriter(this->GetPandora(), m_geometryFileName, fileMode, m_shouldWriteFileIndex,
+                m_shouldCompressBinaryFiles);
             PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, geometryFileWriter.WriteGeometry());
         }
         else if (XML == m_geometryFileType)
         {
-            XmlFileWriter geometryFileWriter(this->GetPandora(), m_geometryFileName, fileMode);
+            XmlFileWriter geometryFileWriter(this->GetPandora(), m_geometryFileName, fileMode, m_shouldStreamXmlFiles);
             PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, geometryFileWriter.WriteGeometry());
         }
         else
@@ -64,11 +71,12 @@ StatusCode EventWritingAlgorithm::Initialize()
 
         if (BINARY == m_eventFileType)
         {
-            m_pEventFileWriter = new BinaryFileWriter(this->GetPandora(), m_eventFileName, fileMode);
+            m_pEventFileWriter = new BinaryFileWriter(this->GetPandora(), m_eventFileName, fileMode, m_shouldWriteFileIndex,
+                m_shouldCompressBinaryFiles, m_nQueuedEventContainers, m_shouldPackCaloHits);
         }
         else if (XML == m_eventFileType)
         {
-            m_pEventFileWriter = new XmlFileWriter(this->GetPandora(), m_eventFileName, fileMode);
+            m_pEventFileWriter = new XmlFileWriter(this->GetPandora(), m_eventFileName, fileMode, m_shouldStreamXmlFiles);
         }
         else
         {
@@ -96,6 +104,35 @@ StatusCode EventWritingAlgorithm::Run()
 
         PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pEventFileWriter->WriteEvent(*pCaloHitList, *pTrackList, *pMCParticleList,
             m_shouldWriteMCRelationships, m_shouldWriteTrackRelationships));
+
+        if (m_shouldWriteReconstruction)
+        {
+            BinaryFileWriter *const pBinaryFileWriter(dynamic_cast<BinaryFileWriter*>(m_pEventFileWriter));
+
+            if (!pBinaryFileWriter)
+                return STATUS_CODE_FAILURE;
+
+            // ATTN Lists absent from this event are written empty, so that each event is followed by its reconstruction container
+            const ClusterList emptyClusterList;
+            const ClusterList *pClusterList(nullptr);
+            PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_INITIALIZED, !=, PandoraContentApi::GetList(*this,
+                m_reconstructionClusterListName, pClusterList));
+
+            const VertexList emptyVertexList;
+            const VertexList *pVertexList(nullptr);
+            PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_INITIALIZED, !=, PandoraContentApi::GetList(*this,
+                m_reconstructionVertexListName, pVertexList));
+
+            const PfoList emptyPfoList;
+            const PfoList *pPfoList(nullptr);
+            PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_INITIALIZED, !=, PandoraContentApi::GetList(*this,
+                m_reconstructionPfoListName, pPfoList));
+
+            PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, pBinaryFileWriter->WriteReconstruction(
+                m_reconstructionClusterListName, pClusterList ? *pClusterList : emptyClusterList,
+                m_reconstructionVertexListName, pVertexList ? *pVertexList : emptyVertexList,
+                m_reconstructionPfoListName, pPfoList ? *pPfoList : emptyPfoList));
+        }
     }
 
     return STATUS_CODE_SUCCESS;
@@ -163,11 +200,53 @@ StatusCode EventWritingAlgorithm::ReadSettings(const TiXmlHandle xmlHandle)
     PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(xmlHandle,
         "ShouldOverwriteGeometryFile", m_shouldOverwriteGeometryFile));
 
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(xmlHandle,
+        "ShouldWriteFileIndex", m_shouldWriteFileIndex));
+
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(xmlHandle,
+        "ShouldCompressBinaryFiles", m_shouldCompressBinaryFiles));
+
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(xmlHandle,
+        "ShouldPackCaloHits", m_shouldPackCaloHits));
+
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(xmlHandle,
+        "ShouldStreamXmlFiles", m_shouldStreamXmlFiles));
+
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(xmlHandle,
+        "AsyncWriteQueueSize", m_nQueuedEventContainers));
+
+    if ((m_nQueuedEventContainers > 0) && (!m_shouldWriteEvents || (BINARY != m_eventFileType)))
+    {
+        std::cout << "EventWritingAlgorithm: AsyncWriteQueueSize may only be specified for binary event files " << std::endl;
+        return STATUS_CODE_INVALID_PARAMETER;
+    }
+
     PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(xmlHandle,
         "ShouldWriteMCRelationships", m_shouldWriteMCRelationships));
 
     PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(xmlHandle,
         "ShouldWriteTrackRelationships", m_shouldWriteTrackRelationships));
 
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(xmlHandle,
+        "ShouldWriteReconstruction", m_shouldWriteReconstruction));
+
+    if (m_shouldWriteReconstruction)
+    {
+        if (!m_shouldWriteEvents || (BINARY != m_eventFileType))
+        {
+            std::cout << "EventWritingAlgorithm: Reconstruction outputs may only be written to binary event files " << std::endl;
+            return STATUS_CODE_INVALID_PARAMETER;
+        }
+
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, XmlHelper::ReadValue(xmlHandle,
+            "ReconstructionClusterListName", m_reconstructionClusterListName));
+
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, XmlHelper::ReadValue(xmlHandle,
+            "ReconstructionVertexListName", m_reconstructionVertexListName));
+
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, XmlHelper::ReadValue(xmlHandle,
+            "ReconstructionPfoListName", m_reconstructionPfoListName));
+    }
+
     return STATUS_CODE_SUCCESS;
 }
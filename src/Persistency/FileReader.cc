@@ -8,13 +8,19 @@
 
 #include "Api/PandoraApi.h"
 
+#include "Persistency/EventRecord.h"
 #include "Persistency/FileReader.h"
+#include "Persistency/GeometryRecord.h"
 
 namespace pandora
 {
 
 FileReader::FileReader(const pandora::Pandora &pandora, const std::string &fileName) :
-    Persistency(pandora, fileName)
+    Persistency(pandora, fileName),
+    m_pEventRecord(nullptr),
+    m_pGeometryRecord(nullptr),
+    m_skippedComponents(0),
+    m_skippedRelationships(0)
 {
 }
 
@@ -55,6 +61,26 @@ StatusCode FileReader::ReadGeometry()
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+StatusCode FileReader::ReadGeometry(GeometryRecord &geometryRecord)
+{
+    geometryRecord.Clear();
+    m_pGeometryRecord = &geometryRecord;
+
+    try
+    {
+        const StatusCode statusCode(this->ReadGeometry());
+        m_pGeometryRecord = nullptr;
+        return statusCode;
+    }
+    catch (StatusCodeException &)
+    {
+        m_pGeometryRecord = nullptr;
+        throw;
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 StatusCode FileReader::ReadEvent()
 {
     if (EVENT_CONTAINER != this->GetNextContainerId())
@@ -81,6 +107,89 @@ StatusCode FileReader::ReadEvent()
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+StatusCode FileReader::ReadEvent(EventRecord &eventRecord)
+{
+    eventRecord.Clear();
+    m_pEventRecord = &eventRecord;
+
+    try
+    {
+        const StatusCode statusCode(this->ReadEvent());
+        m_pEventRecord = nullptr;
+        return statusCode;
+    }
+    catch (StatusCodeException &)
+    {
+        m_pEventRecord = nullptr;
+        throw;
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode FileReader::CreateEvent(const EventRecord &eventRecord) const
+{
+    for (const object_creation::CaloHit::Parameters *const pParameters : eventRecord.m_caloHitParametersVector)
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraApi::CaloHit::Create(*m_pPandora, *pParameters, *m_pCaloHitFactory));
+
+    for (const object_creation::Track::Parameters *const pParameters : eventRecord.m_trackParametersVector)
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraApi::Track::Create(*m_pPandora, *pParameters, *m_pTrackFactory));
+
+    for (const object_creation::MCParticle::Parameters *const pParameters : eventRecord.m_mcParticleParametersVector)
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraApi::MCParticle::Create(*m_pPandora, *pParameters, *m_pMCParticleFactory));
+
+    for (const EventRecord::Relationship &relationship : eventRecord.m_relationshipVector)
+    {
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->SetRelationship(relationship.m_relationshipId, relationship.m_address1,
+            relationship.m_address2, relationship.m_weight));
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode FileReader::SetComponentSelection(const ComponentId componentId, const bool shouldRecreate)
+{
+    if ((CALO_HIT_COMPONENT != componentId) && (TRACK_COMPONENT != componentId) && (MC_PARTICLE_COMPONENT != componentId) &&
+        (RELATIONSHIP_COMPONENT != componentId))
+    {
+        return STATUS_CODE_INVALID_PARAMETER;
+    }
+
+    if (shouldRecreate)
+    {
+        m_skippedComponents &= ~(1u << componentId);
+    }
+    else
+    {
+        m_skippedComponents |= (1u << componentId);
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode FileReader::SetRelationshipSelection(const RelationshipId relationshipId, const bool shouldRecreate)
+{
+    if ((relationshipId < CALO_HIT_TO_MC_RELATIONSHIP) || (relationshipId >= UNKNOWN_RELATIONSHIP))
+        return STATUS_CODE_INVALID_PARAMETER;
+
+    if (shouldRecreate)
+    {
+        m_skippedRelationships &= ~(1u << relationshipId);
+    }
+    else
+    {
+        m_skippedRelationships |= (1u << relationshipId);
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 StatusCode FileReader::GoToNextGeometry()
 {
     do
@@ -105,4 +214,311 @@ StatusCode FileReader::GoToNextEvent()
     return STATUS_CODE_SUCCESS;
 }
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode FileReader::SkipEvents(const unsigned int nEvents)
+{
+    if (0 == nEvents)
+        return STATUS_CODE_SUCCESS;
+
+    // ATTN Move to the start of the first event to skip, if not already there
+    if (EVENT_CONTAINER != this->GetNextContainerId())
+    {
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GoToNextEvent());
+    }
+
+    for (unsigned int iEvent = 0; iEvent < nEvents; ++iEvent)
+    {
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GoToNextEvent());
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool FileReader::ShouldRecreate(const RelationshipId relationshipId) const
+{
+    if (!this->ShouldRecreate(RELATIONSHIP_COMPONENT))
+        return false;
+
+    // ATTN Unrecognised relationship ids are passed on, to be reported as failures when the relationship is created
+    if ((relationshipId < CALO_HIT_TO_MC_RELATIONSHIP) || (relationshipId >= UNKNOWN_RELATIONSHIP))
+        return true;
+
+    if (m_skippedRelationships & (1u << relationshipId))
+        return false;
+
+    switch (relationshipId)
+    {
+    case CALO_HIT_TO_MC_RELATIONSHIP:
+        return (this->ShouldRecreate(CALO_HIT_COMPONENT) && this->ShouldRecreate(MC_PARTICLE_COMPONENT));
+    case TRACK_TO_MC_RELATIONSHIP:
+        return (this->ShouldRecreate(TRACK_COMPONENT) && this->ShouldRecreate(MC_PARTICLE_COMPONENT));
+    case MC_PARENT_DAUGHTER_RELATIONSHIP:
+        return this->ShouldRecreate(MC_PARTICLE_COMPONENT);
+    case TRACK_PARENT_DAUGHTER_RELATIONSHIP:
+    case TRACK_SIBLING_RELATIONSHIP:
+        return this->ShouldRecreate(TRACK_COMPONENT);
+    default:
+        return true;
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+object_creation::CaloHit::Parameters *FileReader::GetCaloHitParameters()
+{
+    return this->GetParameters(*m_pCaloHitFactory, m_pCaloHitParameters);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+object_creation::Track::Parameters *FileReader::GetTrackParameters()
+{
+    return this->GetParameters(*m_pTrackFactory, m_pTrackParameters);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+object_creation::MCParticle::Parameters *FileReader::GetMCParticleParameters()
+{
+    return this->GetParameters(*m_pMCParticleFactory, m_pMCParticleParameters);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void FileReader::DeleteParameters(object_creation::CaloHit::Parameters *const pParameters) const
+{
+    if (pParameters != m_pCaloHitParameters)
+        delete pParameters;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void FileReader::DeleteParameters(object_creation::Track::Parameters *const pParameters) const
+{
+    if (pParameters != m_pTrackParameters)
+        delete pParameters;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void FileReader::DeleteParameters(object_creation::MCParticle::Parameters *const pParameters) const
+{
+    if (pParameters != m_pMCParticleParameters)
+        delete pParameters;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode FileReader::CreateSubDetector(object_creation::Geometry::SubDetector::Parameters *&pParameters)
+{
+    if (!m_pGeometryRecord)
+        return PandoraApi::Geometry::SubDetector::Create(*m_pPandora, *pParameters, *m_pSubDetectorFactory);
+
+    m_pGeometryRecord->m_subDetectorParametersVector.push_back(pParameters);
+    pParameters = nullptr;
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode FileReader::CreateLArTPC(object_creation::Geometry::LArTPC::Parameters *&pParameters)
+{
+    if (!m_pGeometryRecord)
+        return PandoraApi::Geometry::LArTPC::Create(*m_pPandora, *pParameters, *m_pLArTPCFactory);
+
+    m_pGeometryRecord->m_larTPCParametersVector.push_back(pParameters);
+    pParameters = nullptr;
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode FileReader::CreateLineGap(object_creation::Geometry::LineGap::Parameters *&pParameters)
+{
+    if (!m_pGeometryRecord)
+        return PandoraApi::Geometry::LineGap::Create(*m_pPandora, *pParameters, *m_pLineGapFactory);
+
+    m_pGeometryRecord->m_lineGapParametersVector.push_back(pParameters);
+    pParameters = nullptr;
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode FileReader::CreateBoxGap(object_creation::Geometry::BoxGap::Parameters *&pParameters)
+{
+    if (!m_pGeometryRecord)
+        return PandoraApi::Geometry::BoxGap::Create(*m_pPandora, *pParameters, *m_pBoxGapFactory);
+
+    m_pGeometryRecord->m_boxGapParametersVector.push_back(pParameters);
+    pParameters = nullptr;
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode FileReader::CreateConcentricGap(object_creation::Geometry::ConcentricGap::Parameters *&pParameters)
+{
+    if (!m_pGeometryRecord)
+        return PandoraApi::Geometry::ConcentricGap::Create(*m_pPandora, *pParameters, *m_pConcentricGapFactory);
+
+    m_pGeometryRecord->m_concentricGapParametersVector.push_back(pParameters);
+    pParameters = nullptr;
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode FileReader::CreateCaloHit(object_creation::CaloHit::Parameters *&pParameters)
+{
+    if (!this->ShouldRecreate(CALO_HIT_COMPONENT))
+        return STATUS_CODE_SUCCESS;
+
+    if (!m_pEventRecord)
+        return PandoraApi::CaloHit::Create(*m_pPandora, *pParameters, *m_pCaloHitFactory);
+
+    m_pEventRecord->m_caloHitParametersVector.push_back(pParameters);
+    pParameters = nullptr;
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode FileReader::ReserveCaloHits(const unsigned int nCaloHits)
+{
+    if (!this->ShouldRecreate(CALO_HIT_COMPONENT))
+        return STATUS_CODE_SUCCESS;
+
+    if (!m_pEventRecord)
+        return PandoraApi::SetEventSizeHints(*m_pPandora, nCaloHits, 0, 0, 0);
+
+    m_pEventRecord->m_caloHitParametersVector.reserve(m_pEventRecord->m_caloHitParametersVector.size() + nCaloHits);
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool FileReader::CanCreateCaloHitBatch() const
+{
+    return (!m_pEventRecord && this->ShouldRecreate(CALO_HIT_COMPONENT) && m_pCaloHitFactory->IsDefaultFactory());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode FileReader::CreateCaloHitBatch(const object_creation::CaloHit::ParametersVector &parametersVector) const
+{
+    if (!this->CanCreateCaloHitBatch())
+        return STATUS_CODE_NOT_ALLOWED;
+
+    return PandoraApi::CaloHit::Create(*m_pPandora, parametersVector, *m_pCaloHitFactory);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode FileReader::CreateTrack(object_creation::Track::Parameters *&pParameters)
+{
+    if (!this->ShouldRecreate(TRACK_COMPONENT))
+        return STATUS_CODE_SUCCESS;
+
+    if (!m_pEventRecord)
+        return PandoraApi::Track::Create(*m_pPandora, *pParameters, *m_pTrackFactory);
+
+    m_pEventRecord->m_trackParametersVector.push_back(pParameters);
+    pParameters = nullptr;
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode FileReader::CreateMCParticle(object_creation::MCParticle::Parameters *&pParameters)
+{
+    if (!this->ShouldRecreate(MC_PARTICLE_COMPONENT))
+        return STATUS_CODE_SUCCESS;
+
+    if (!m_pEventRecord)
+        return PandoraApi::MCParticle::Create(*m_pPandora, *pParameters, *m_pMCParticleFactory);
+
+    m_pEventRecord->m_mcParticleParametersVector.push_back(pParameters);
+    pParameters = nullptr;
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode FileReader::CreateRelationship(const RelationshipId relationshipId, const void *address1, const void *address2, const float weight)
+{
+    if (!this->ShouldRecreate(relationshipId))
+        return STATUS_CODE_SUCCESS;
+
+    if (!m_pEventRecord)
+        return this->SetRelationship(relationshipId, address1, address2, weight);
+
+    if ((relationshipId < CALO_HIT_TO_MC_RELATIONSHIP) || (relationshipId >= UNKNOWN_RELATIONSHIP))
+        return STATUS_CODE_FAILURE;
+
+    EventRecord::Relationship relationship;
+    relationship.m_relationshipId = relationshipId;
+    relationship.m_address1 = address1;
+    relationship.m_address2 = address2;
+    relationship.m_weight = weight;
+    m_pEventRecord->m_relationshipVector.push_back(relationship);
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode FileReader::SetRelationship(const RelationshipId relationshipId, const void *address1, const void *address2, const float weight) const
+{
+    switch (relationshipId)
+    {
+    case CALO_HIT_TO_MC_RELATIONSHIP:
+        return PandoraApi::SetCaloHitToMCParticleRelationship(*m_pPandora, address1, address2, weight);
+    case TRACK_TO_MC_RELATIONSHIP:
+        return PandoraApi::SetTrackToMCParticleRelationship(*m_pPandora, address1, address2, weight);
+    case MC_PARENT_DAUGHTER_RELATIONSHIP:
+        return PandoraApi::SetMCParentDaughterRelationship(*m_pPandora, address1, address2);
+    case TRACK_PARENT_DAUGHTER_RELATIONSHIP:
+        return PandoraApi::SetTrackParentDaughterRelationship(*m_pPandora, address1, address2);
+    case TRACK_SIBLING_RELATIONSHIP:
+        return PandoraApi::SetTrackSiblingRelationship(*m_pPandora, address1, address2);
+    default:
+        return STATUS_CODE_FAILURE;
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename PARAMETERS, typename OBJECT>
+PARAMETERS *FileReader::GetParameters(const ObjectFactory<PARAMETERS, OBJECT> &factory, PARAMETERS *&pReusableParameters) const
+{
+    // ATTN Parameters added to an event record are owned by the record, so cannot be reused
+    if (m_pEventRecord)
+        return factory.NewParameters();
+
+    if (!pReusableParameters)
+    {
+        pReusableParameters = factory.NewParameters();
+    }
+    else
+    {
+        // ATTN Resets the base parameters only; factories supplying derived parameters are expected to set any extra members on read
+        *pReusableParameters = PARAMETERS();
+    }
+
+    return pReusableParameters;
+}
+
 } // namespace pandora
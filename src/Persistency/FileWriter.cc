@@ -257,8 +257,8 @@ StatusCode FileWriter::WriteMCParticleRelationships(const MCParticle *const pMCP
         return STATUS_CODE_FAILURE;
 
     const Uid uid(pMCParticle->GetUid());
-    const MCParticleList &parentList(pMCParticle->GetParentList());
-    const MCParticleList &daughterList(pMCParticle->GetDaughterList());
+    const MCParticleRange parentList(pMCParticle->GetParentList());
+    const MCParticleRange daughterList(pMCParticle->GetDaughterList());
 
     for (const MCParticle *const pParentMCParticle : parentList)
     {
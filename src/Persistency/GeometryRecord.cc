@@ -0,0 +1,89 @@
+/**
+ *  @file   PandoraSDK/src/Persistency/GeometryRecord.cc
+ * 
+ *  @brief  Implementation of the geometry record class.
+ * 
+ *  $Log: $
+ */
+
+#include "Api/PandoraApi.h"
+
+#include "Persistency/GeometryRecord.h"
+
+namespace pandora
+{
+
+GeometryRecord::GeometryRecord()
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+GeometryRecord::~GeometryRecord()
+{
+    this->Clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void GeometryRecord::Clear()
+{
+    for (const object_creation::Geometry::SubDetector::Parameters *const pParameters : m_subDetectorParametersVector)
+        delete pParameters;
+
+    for (const object_creation::Geometry::LArTPC::Parameters *const pParameters : m_larTPCParametersVector)
+        delete pParameters;
+
+    for (const object_creation::Geometry::LineGap::Parameters *const pParameters : m_lineGapParametersVector)
+        delete pParameters;
+
+    for (const object_creation::Geometry::BoxGap::Parameters *const pParameters : m_boxGapParametersVector)
+        delete pParameters;
+
+    for (const object_creation::Geometry::ConcentricGap::Parameters *const pParameters : m_concentricGapParametersVector)
+        delete pParameters;
+
+    m_subDetectorParametersVector.clear();
+    m_larTPCParametersVector.clear();
+    m_lineGapParametersVector.clear();
+    m_boxGapParametersVector.clear();
+    m_concentricGapParametersVector.clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode GeometryRecord::CreateGeometry(const Pandora &pandora) const
+{
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, GeometryRecord::CreateBatch<PandoraApi::Geometry::SubDetector>(pandora,
+        m_subDetectorParametersVector));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, GeometryRecord::CreateBatch<PandoraApi::Geometry::LArTPC>(pandora,
+        m_larTPCParametersVector));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, GeometryRecord::CreateBatch<PandoraApi::Geometry::LineGap>(pandora,
+        m_lineGapParametersVector));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, GeometryRecord::CreateBatch<PandoraApi::Geometry::BoxGap>(pandora,
+        m_boxGapParametersVector));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, GeometryRecord::CreateBatch<PandoraApi::Geometry::ConcentricGap>(pandora,
+        m_concentricGapParametersVector));
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename OBJECT_CREATION>
+StatusCode GeometryRecord::CreateBatch(const Pandora &pandora,
+    const std::vector<typename OBJECT_CREATION::Parameters*> &parametersPointerVector)
+{
+    if (parametersPointerVector.empty())
+        return STATUS_CODE_SUCCESS;
+
+    typename OBJECT_CREATION::ParametersVector parametersVector;
+    parametersVector.reserve(parametersPointerVector.size());
+
+    for (const typename OBJECT_CREATION::Parameters *const pParameters : parametersPointerVector)
+        parametersVector.push_back(*pParameters);
+
+    return OBJECT_CREATION::Create(pandora, parametersVector);
+}
+
+} // namespace pandora
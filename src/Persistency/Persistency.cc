@@ -25,7 +25,10 @@ Persistency::Persistency(const pandora::Pandora &pandora, const std::string &fil
     m_pLArTPCFactory(new PandoraObjectFactory<object_creation::Geometry::LArTPC::Parameters, object_creation::Geometry::LArTPC::Object>()),
     m_pLineGapFactory(new PandoraObjectFactory<object_creation::Geometry::LineGap::Parameters, object_creation::Geometry::LineGap::Object>()),
     m_pBoxGapFactory(new PandoraObjectFactory<object_creation::Geometry::BoxGap::Parameters, object_creation::Geometry::BoxGap::Object>()),
-    m_pConcentricGapFactory(new PandoraObjectFactory<object_creation::Geometry::ConcentricGap::Parameters, object_creation::Geometry::ConcentricGap::Object>())
+    m_pConcentricGapFactory(new PandoraObjectFactory<object_creation::Geometry::ConcentricGap::Parameters, object_creation::Geometry::ConcentricGap::Object>()),
+    m_pCaloHitParameters(nullptr),
+    m_pTrackParameters(nullptr),
+    m_pMCParticleParameters(nullptr)
 {
 }
 
@@ -41,6 +44,10 @@ Persistency::~Persistency()
     delete m_pLineGapFactory;
     delete m_pBoxGapFactory;
     delete m_pConcentricGapFactory;
+
+    delete m_pCaloHitParameters;
+    delete m_pTrackParameters;
+    delete m_pMCParticleParameters;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -62,6 +69,10 @@ void Persistency::ReplaceCurrentFactory(ObjectFactory<object_creation::CaloHit::
 {
     delete m_pCaloHitFactory;
     m_pCaloHitFactory = pFactory;
+
+    // ATTN The reusable parameters may be of a type specific to the replaced factory
+    delete m_pCaloHitParameters;
+    m_pCaloHitParameters = nullptr;
 }
 
 template<>
@@ -69,6 +80,10 @@ void Persistency::ReplaceCurrentFactory(ObjectFactory<object_creation::Track::Pa
 {
     delete m_pTrackFactory;
     m_pTrackFactory = pFactory;
+
+    // ATTN The reusable parameters may be of a type specific to the replaced factory
+    delete m_pTrackParameters;
+    m_pTrackParameters = nullptr;
 }
 
 template<>
@@ -76,6 +91,10 @@ void Persistency::ReplaceCurrentFactory(ObjectFactory<object_creation::MCParticl
 {
     delete m_pMCParticleFactory;
     m_pMCParticleFactory = pFactory;
+
+    // ATTN The reusable parameters may be of a type specific to the replaced factory
+    delete m_pMCParticleParameters;
+    m_pMCParticleParameters = nullptr;
 }
 
 template<>
@@ -16,13 +16,29 @@
 namespace pandora
 {
 
-XmlFileReader::XmlFileReader(const pandora::Pandora &pandora, const std::string &fileName) :
+XmlFileReader::XmlFileReader(const pandora::Pandora &pandora, const std::string &fileName, const bool useStreaming) :
     FileReader(pandora, fileName),
+    m_pXmlDocument(nullptr),
     m_pContainerXmlNode(nullptr),
     m_pCurrentXmlElement(nullptr),
-    m_isAtFileStart(true)
+    m_isAtFileStart(true),
+    m_isStreaming(useStreaming)
 {
     m_fileType = XML;
+
+    if (m_isStreaming)
+    {
+        m_fileStream.open(fileName.c_str(), std::ios::in);
+
+        if (!m_fileStream.is_open())
+        {
+            std::cout << "XmlFileReader - Invalid xml file." << std::endl;
+            throw StatusCodeException(STATUS_CODE_FAILURE);
+        }
+
+        return;
+    }
+
     m_pXmlDocument = new TiXmlDocument(fileName);
 
     if (!m_pXmlDocument->LoadFile())
@@ -62,7 +78,8 @@ StatusCode XmlFileReader::GoToNextContainer()
     if (m_isAtFileStart)
     {
         if (!m_pContainerXmlNode)
-            m_pContainerXmlNode = TiXmlHandle(m_pXmlDocument).FirstChildElement().Element();
+            m_pContainerXmlNode = m_isStreaming ? this->ReadContainerXmlElement(true) :
+                TiXmlHandle(m_pXmlDocument).FirstChildElement().Element();
 
         m_isAtFileStart = false;
     }
@@ -71,7 +88,7 @@ StatusCode XmlFileReader::GoToNextContainer()
         if (!m_pContainerXmlNode)
             throw StatusCodeException(STATUS_CODE_NOT_FOUND);
 
-        m_pContainerXmlNode = m_pContainerXmlNode->NextSibling();
+        m_pContainerXmlNode = m_isStreaming ? this->ReadContainerXmlElement(false) : m_pContainerXmlNode->NextSibling();
     }
 
     return STATUS_CODE_SUCCESS;
@@ -211,19 +228,19 @@ StatusCode XmlFileReader::ReadNextEventComponent()
 
     if (std::string("CaloHit") == componentName)
     {
-        return this->ReadCaloHit();
+        return (this->ShouldRecreate(CALO_HIT_COMPONENT) ? this->ReadCaloHit() : STATUS_CODE_SUCCESS);
     }
     else if (std::string("Track") == componentName)
     {
-        return this->ReadTrack();
+        return (this->ShouldRecreate(TRACK_COMPONENT) ? this->ReadTrack() : STATUS_CODE_SUCCESS);
     }
     else if (std::string("MCParticle") == componentName)
     {
-        return this->ReadMCParticle();
+        return (this->ShouldRecreate(MC_PARTICLE_COMPONENT) ? this->ReadMCParticle() : STATUS_CODE_SUCCESS);
     }
     else if (std::string("Relationship") == componentName)
     {
-        return this->ReadRelationship();
+        return (this->ShouldRecreate(RELATIONSHIP_COMPONENT) ? this->ReadRelationship() : STATUS_CODE_SUCCESS);
     }
     else
     {
@@ -303,7 +320,7 @@ StatusCode XmlFileReader::ReadSubDetector()
             }
         }
 
-        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraApi::Geometry::SubDetector::Create(*m_pPandora, *pParameters, *m_pSubDetectorFactory));
+        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->CreateSubDetector(pParameters));
         delete pParameters;
     }
     catch (StatusCodeException &statusCodeException)
@@ -375,7 +392,7 @@ StatusCode XmlFileReader::ReadLArTPC()
         pParameters->m_sigmaUVW = sigmaUVW;
         pParameters->m_isDriftInPositiveX = isDriftInPositiveX;
 
-        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraApi::Geometry::LArTPC::Create(*m_pPandora, *pParameters, *m_pLArTPCFactory));
+        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->CreateLArTPC(pParameters));
         delete pParameters;
     }
     catch (StatusCodeException &statusCodeException)
@@ -417,7 +434,7 @@ StatusCode XmlFileReader::ReadLineGap()
         pParameters->m_lineEndX = lineEndX;
         pParameters->m_lineStartZ = lineStartZ;
         pParameters->m_lineEndZ = lineEndZ;
-        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraApi::Geometry::LineGap::Create(*m_pPandora, *pParameters, *m_pLineGapFactory));
+        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->CreateLineGap(pParameters));
         delete pParameters;
     }
     catch (StatusCodeException &statusCodeException)
@@ -455,7 +472,7 @@ StatusCode XmlFileReader::ReadBoxGap()
         pParameters->m_side1 = side1;
         pParameters->m_side2 = side2;
         pParameters->m_side3 = side3;
-        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraApi::Geometry::BoxGap::Create(*m_pPandora, *pParameters, *m_pBoxGapFactory));
+        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->CreateBoxGap(pParameters));
         delete pParameters;
     }
     catch (StatusCodeException &statusCodeException)
@@ -505,7 +522,7 @@ StatusCode XmlFileReader::ReadConcentricGap()
         pParameters->m_outerRCoordinate = outerRCoordinate;
         pParameters->m_outerPhiCoordinate = outerPhiCoordinate;
         pParameters->m_outerSymmetryOrder = outerSymmetryOrder;
-        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraApi::Geometry::ConcentricGap::Create(*m_pPandora, *pParameters, *m_pConcentricGapFactory));
+        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->CreateConcentricGap(pParameters));
         delete pParameters;
     }
     catch (StatusCodeException &statusCodeException)
@@ -524,7 +541,7 @@ StatusCode XmlFileReader::ReadCaloHit()
     if (EVENT_CONTAINER != m_containerId)
         return STATUS_CODE_FAILURE;
 
-    PandoraApi::CaloHit::Parameters *pParameters = m_pCaloHitFactory->NewParameters();
+    PandoraApi::CaloHit::Parameters *pParameters = this->GetCaloHitParameters();
 
     try
     {
@@ -594,12 +611,12 @@ StatusCode XmlFileReader::ReadCaloHit()
         pParameters->m_layer = layer;
         pParameters->m_isInOuterSamplingLayer = isInOuterSamplingLayer;
         pParameters->m_pParentAddress = pParentAddress;
-        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraApi::CaloHit::Create(*m_pPandora, *pParameters, *m_pCaloHitFactory));
-        delete pParameters;
+        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->CreateCaloHit(pParameters));
+        this->DeleteParameters(pParameters);
     }
     catch (StatusCodeException &statusCodeException)
     {
-        delete pParameters;
+        this->DeleteParameters(pParameters);
         return statusCodeException.GetStatusCode();
     }
 
@@ -613,7 +630,7 @@ StatusCode XmlFileReader::ReadTrack()
     if (EVENT_CONTAINER != m_containerId)
         return STATUS_CODE_FAILURE;
 
-    PandoraApi::Track::Parameters *pParameters = m_pTrackFactory->NewParameters();
+    PandoraApi::Track::Parameters *pParameters = this->GetTrackParameters();
 
     try
     {
@@ -665,12 +682,12 @@ StatusCode XmlFileReader::ReadTrack()
         pParameters->m_canFormPfo = canFormPfo;
         pParameters->m_canFormClusterlessPfo = canFormClusterlessPfo;
         pParameters->m_pParentAddress = pParentAddress;
-        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraApi::Track::Create(*m_pPandora, *pParameters, *m_pTrackFactory));
-        delete pParameters;
+        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->CreateTrack(pParameters));
+        this->DeleteParameters(pParameters);
     }
     catch (StatusCodeException &statusCodeException)
     {
-        delete pParameters;
+        this->DeleteParameters(pParameters);
         return statusCodeException.GetStatusCode();
     }
 
@@ -684,7 +701,7 @@ StatusCode XmlFileReader::ReadMCParticle()
     if (EVENT_CONTAINER != m_containerId)
         return STATUS_CODE_FAILURE;
 
-    PandoraApi::MCParticle::Parameters *pParameters = m_pMCParticleFactory->NewParameters();
+    PandoraApi::MCParticle::Parameters *pParameters = this->GetMCParticleParameters();
 
     try
     {
@@ -713,12 +730,12 @@ StatusCode XmlFileReader::ReadMCParticle()
         pParameters->m_particleId = particleId;
         pParameters->m_mcParticleType = mcParticleType;
         pParameters->m_pParentAddress = pParentAddress;
-        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, PandoraApi::MCParticle::Create(*m_pPandora, *pParameters, *m_pMCParticleFactory));
-        delete pParameters;
+        PANDORA_THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->CreateMCParticle(pParameters));
+        this->DeleteParameters(pParameters);
     }
     catch (StatusCodeException &statusCodeException)
     {
-        delete pParameters;
+        this->DeleteParameters(pParameters);
         return statusCodeException.GetStatusCode();
     }
 
@@ -742,23 +759,103 @@ StatusCode XmlFileReader::ReadRelationship()
     float weight(1.f);
     PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->ReadVariable("Weight", weight));
 
-    switch (relationshipId)
-    {
-    case CALO_HIT_TO_MC_RELATIONSHIP:
-        return PandoraApi::SetCaloHitToMCParticleRelationship(*m_pPandora, address1, address2, weight);
-    case TRACK_TO_MC_RELATIONSHIP:
-        return PandoraApi::SetTrackToMCParticleRelationship(*m_pPandora, address1, address2, weight);
-    case MC_PARENT_DAUGHTER_RELATIONSHIP:
-        return PandoraApi::SetMCParentDaughterRelationship(*m_pPandora, address1, address2);
-    case TRACK_PARENT_DAUGHTER_RELATIONSHIP:
-        return PandoraApi::SetTrackParentDaughterRelationship(*m_pPandora, address1, address2);
-    case TRACK_SIBLING_RELATIONSHIP:
-        return PandoraApi::SetTrackSiblingRelationship(*m_pPandora, address1, address2);
-    default:
-        return STATUS_CODE_FAILURE;
+    return this->CreateRelationship(relationshipId, address1, address2, weight);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+TiXmlElement *XmlFileReader::ReadContainerXmlElement(const bool isAtFileStart)
+{
+    delete m_pXmlDocument;
+    m_pXmlDocument = nullptr;
+    m_containerText.clear();
+
+    if (isAtFileStart)
+    {
+        m_fileStream.clear();
+        m_fileStream.seekg(0, std::ios::beg);
     }
 
-    return STATUS_CODE_SUCCESS;
+    // ATTN Markup is read one tag at a time, up to each closing '>', which the xml writer always escapes within text and attributes
+    std::string markup;
+    int depth(0);
+
+    while (std::getline(m_fileStream, markup, '>'))
+    {
+        if (m_fileStream.eof())
+            break;
+
+        markup.push_back('>');
+        const std::string::size_type tagStart(markup.find('<'));
+
+        if (std::string::npos == tagStart)
+            throw StatusCodeException(STATUS_CODE_FAILURE);
+
+        const bool isComment(0 == markup.compare(tagStart, 4, "<!--"));
+        const bool isCData(0 == markup.compare(tagStart, 9, "<![CDATA["));
+        const std::string terminator(isComment ? "-->" : isCData ? "]]>" : ">");
+        const std::string::size_type minSize(tagStart + (isComment ? 7 : isCData ? 12 : 2));
+        std::string continuation;
+
+        while ((markup.size() < minSize) || (0 != markup.compare(markup.size() - terminator.size(), terminator.size(), terminator)))
+        {
+            if (!std::getline(m_fileStream, continuation, '>') || m_fileStream.eof())
+                throw StatusCodeException(STATUS_CODE_FAILURE);
+
+            markup.append(continuation);
+            markup.push_back('>');
+        }
+
+        const char tagType(markup[tagStart + 1]);
+
+        if (0 == depth)
+        {
+            // ATTN Declarations, comments and text between top-level containers are skipped
+            if (('?' == tagType) || ('!' == tagType))
+                continue;
+
+            if ('/' == tagType)
+                throw StatusCodeException(STATUS_CODE_FAILURE);
+
+            m_containerText.append(markup, tagStart, std::string::npos);
+        }
+        else
+        {
+            m_containerText.append(markup);
+        }
+
+        if ('/' == tagType)
+        {
+            --depth;
+        }
+        else if (('?' != tagType) && ('!' != tagType) && ('/' != markup[markup.size() - 2]))
+        {
+            ++depth;
+        }
+
+        if (0 == depth)
+            break;
+    }
+
+    if (m_containerText.empty())
+        return nullptr;
+
+    if (0 != depth)
+    {
+        std::cout << "XmlFileReader - Invalid xml file, incomplete container at end of file." << std::endl;
+        throw StatusCodeException(STATUS_CODE_FAILURE);
+    }
+
+    m_pXmlDocument = new TiXmlDocument;
+    m_pXmlDocument->Parse(m_containerText.c_str());
+
+    if (m_pXmlDocument->Error())
+    {
+        std::cout << "XmlFileReader - Invalid xml file, " << m_pXmlDocument->ErrorDesc() << std::endl;
+        throw StatusCodeException(STATUS_CODE_FAILURE);
+    }
+
+    return TiXmlHandle(m_pXmlDocument).FirstChildElement().Element();
 }
 
 } // namespace pandora
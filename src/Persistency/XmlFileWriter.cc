@@ -22,14 +22,31 @@
 namespace pandora
 {
 
-XmlFileWriter::XmlFileWriter(const pandora::Pandora &pandora, const std::string &fileName, const FileMode fileMode) :
+XmlFileWriter::XmlFileWriter(const pandora::Pandora &pandora, const std::string &fileName, const FileMode fileMode,
+        const bool useStreaming) :
     FileWriter(pandora, fileName),
+    m_pXmlDocument(nullptr),
     m_pContainerXmlElement(nullptr),
-    m_pCurrentXmlElement(nullptr)
+    m_pCurrentXmlElement(nullptr),
+    m_isStreaming(useStreaming)
 {
     m_fileType = XML;
 
-    if (APPEND == fileMode)
+    if (m_isStreaming)
+    {
+        if ((APPEND != fileMode) && (OVERWRITE != fileMode))
+            throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
+
+        // ATTN Containers are appended to any existing file as written, without loading and re-saving its contents
+        m_fileStream.open(fileName.c_str(), std::ios::out | ((APPEND == fileMode) ? std::ios::app : std::ios::trunc));
+
+        if (!m_fileStream.is_open())
+        {
+            std::cout << "XmlFileWriter - Unable to open file " << fileName << std::endl;
+            throw StatusCodeException(STATUS_CODE_FAILURE);
+        }
+    }
+    else if (APPEND == fileMode)
     {
         m_pXmlDocument = new TiXmlDocument(fileName);
 
@@ -54,6 +71,15 @@ XmlFileWriter::XmlFileWriter(const pandora::Pandora &pandora, const std::string
 
 XmlFileWriter::~XmlFileWriter()
 {
+    if (m_isStreaming)
+    {
+        if (m_pContainerXmlElement && (STATUS_CODE_SUCCESS != this->WriteContainer()))
+            std::cout << "XmlFileWriter - Unable to write final container to file " << m_fileName << std::endl;
+
+        m_fileStream.close();
+        return;
+    }
+
     m_pXmlDocument->SaveFile(m_fileName);
     delete m_pXmlDocument;
 }
@@ -64,7 +90,9 @@ StatusCode XmlFileWriter::WriteHeader(const ContainerId containerId)
 {
     const std::string containerXmlKey((GEOMETRY_CONTAINER == containerId) ? "Geometry" : (EVENT_CONTAINER == containerId) ? "Event" : "Unknown");
     m_pContainerXmlElement = new TiXmlElement(containerXmlKey);
-    m_pXmlDocument->LinkEndChild(m_pContainerXmlElement);
+
+    if (!m_isStreaming)
+        m_pXmlDocument->LinkEndChild(m_pContainerXmlElement);
 
     m_containerId = containerId;
 
@@ -80,6 +108,9 @@ StatusCode XmlFileWriter::WriteFooter()
 
     m_containerId = UNKNOWN_CONTAINER;
 
+    if (m_isStreaming)
+        return this->WriteContainer();
+
     return STATUS_CODE_SUCCESS;
 }
 
@@ -349,4 +380,27 @@ StatusCode XmlFileWriter::WriteRelationship(const RelationshipId relationshipId,
     return STATUS_CODE_SUCCESS;
 }
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode XmlFileWriter::WriteContainer()
+{
+    if (!m_pContainerXmlElement)
+        return STATUS_CODE_NOT_INITIALIZED;
+
+    // ATTN Printer output matches that of TiXmlDocument::SaveFile, so streamed and saved files are identical
+    TiXmlPrinter xmlPrinter;
+    m_pContainerXmlElement->Accept(&xmlPrinter);
+    m_fileStream << xmlPrinter.Str();
+    m_fileStream.flush();
+
+    delete m_pContainerXmlElement;
+    m_pContainerXmlElement = nullptr;
+    m_pCurrentXmlElement = nullptr;
+
+    if (!m_fileStream.good())
+        return STATUS_CODE_FAILURE;
+
+    return STATUS_CODE_SUCCESS;
+}
+
 } // namespace pandora
@@ -0,0 +1,185 @@
+/**
+ *  @file   PandoraSDK/src/Plugins/CachedBFieldPlugin.cc
+ * 
+ *  @brief  Implementation of the cached bfield plugin class.
+ * 
+ *  $Log: $
+ */
+
+#include "Helpers/XmlHelper.h"
+
+#include "Objects/CartesianVector.h"
+
+#include "Plugins/CachedBFieldPlugin.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace pandora
+{
+
+CachedBFieldPlugin::CachedBFieldPlugin(BFieldPlugin *const pInnerBFieldPlugin) :
+    m_pInnerBFieldPlugin(pInnerBFieldPlugin)
+{
+    if (!m_pInnerBFieldPlugin)
+        throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
+
+    for (unsigned int axis = 0; axis < 3; ++axis)
+    {
+        m_gridMin[axis] = 0.f;
+        m_gridMax[axis] = 0.f;
+        m_nGridPoints[axis] = 0;
+        m_inverseGridSpacing[axis] = 0.f;
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+CachedBFieldPlugin::~CachedBFieldPlugin()
+{
+    delete m_pInnerBFieldPlugin;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+float CachedBFieldPlugin::GetBField(const CartesianVector &positionVector) const
+{
+    if (m_bFieldVector.empty())
+        return m_pInnerBFieldPlugin->GetBField(positionVector);
+
+    const float position[3] = {positionVector.GetX(), positionVector.GetY(), positionVector.GetZ()};
+    const unsigned int stride[3] = {m_nGridPoints[1] * m_nGridPoints[2], m_nGridPoints[2], 1};
+    unsigned int baseIndex(0), step[3] = {0, 0, 0};
+    float fraction[3] = {0.f, 0.f, 0.f};
+
+    for (unsigned int axis = 0; axis < 3; ++axis)
+    {
+        // ATTN Negated comparisons also forward non-finite coordinates to the inner plugin
+        if (!(position[axis] >= m_gridMin[axis]) || !(position[axis] <= m_gridMax[axis]))
+            return m_pInnerBFieldPlugin->GetBField(positionVector);
+
+        if (m_nGridPoints[axis] < 2)
+            continue;
+
+        const float gridCoordinate((position[axis] - m_gridMin[axis]) * m_inverseGridSpacing[axis]);
+        const unsigned int lowerPoint(std::min(static_cast<unsigned int>(gridCoordinate), m_nGridPoints[axis] - 2));
+        fraction[axis] = std::min(1.f, gridCoordinate - static_cast<float>(lowerPoint));
+        baseIndex += lowerPoint * stride[axis];
+        step[axis] = stride[axis];
+    }
+
+    const float *const pBField(&m_bFieldVector[baseIndex]);
+    const float fx(fraction[0]), fy(fraction[1]), fz(fraction[2]);
+
+    const float b00((1.f - fz) * pBField[0] + fz * pBField[step[2]]);
+    const float b01((1.f - fz) * pBField[step[1]] + fz * pBField[step[1] + step[2]]);
+    const float b10((1.f - fz) * pBField[step[0]] + fz * pBField[step[0] + step[2]]);
+    const float b11((1.f - fz) * pBField[step[0] + step[1]] + fz * pBField[step[0] + step[1] + step[2]]);
+
+    return ((1.f - fx) * ((1.f - fy) * b00 + fy * b01) + fx * ((1.f - fy) * b10 + fy * b11));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode CachedBFieldPlugin::ReadSettings(const TiXmlHandle xmlHandle)
+{
+    CartesianVector gridMin(0.f, 0.f, 0.f), gridMax(0.f, 0.f, 0.f);
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(xmlHandle, "GridMin", gridMin));
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(xmlHandle, "GridMax", gridMax));
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(xmlHandle, "NGridPointsX", m_nGridPoints[0]));
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(xmlHandle, "NGridPointsY", m_nGridPoints[1]));
+    PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadValue(xmlHandle, "NGridPointsZ", m_nGridPoints[2]));
+
+    m_gridMin[0] = gridMin.GetX();
+    m_gridMin[1] = gridMin.GetY();
+    m_gridMin[2] = gridMin.GetZ();
+    m_gridMax[0] = gridMax.GetX();
+    m_gridMax[1] = gridMax.GetY();
+    m_gridMax[2] = gridMax.GetZ();
+
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->RegisterInnerPlugin());
+    TiXmlElement *const pInnerXmlElement(xmlHandle.FirstChild("InnerBFieldPlugin").Element());
+
+    if (nullptr != pInnerXmlElement)
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pInnerBFieldPlugin->ReadSettings(TiXmlHandle(pInnerXmlElement)));
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode CachedBFieldPlugin::Initialize()
+{
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->RegisterInnerPlugin());
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_pInnerBFieldPlugin->Initialize());
+
+    return this->FillGrid();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode CachedBFieldPlugin::Reset()
+{
+    return m_pInnerBFieldPlugin->Reset();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode CachedBFieldPlugin::RegisterInnerPlugin()
+{
+    if (nullptr != m_pInnerBFieldPlugin->m_pPandora)
+        return STATUS_CODE_SUCCESS;
+
+    return m_pInnerBFieldPlugin->RegisterDetails(m_pPandora, "BFieldPlugin", "InnerBFieldPlugin");
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode CachedBFieldPlugin::FillGrid()
+{
+    m_bFieldVector.clear();
+
+    // ATTN If no grid is configured, all queries are forwarded to the inner plugin
+    if ((0 == m_nGridPoints[0]) && (0 == m_nGridPoints[1]) && (0 == m_nGridPoints[2]))
+        return STATUS_CODE_SUCCESS;
+
+    unsigned int nGridPoints(1);
+
+    for (unsigned int axis = 0; axis < 3; ++axis)
+    {
+        if ((0 == m_nGridPoints[axis]) || (nGridPoints > MAX_GRID_POINTS / m_nGridPoints[axis]))
+            return STATUS_CODE_INVALID_PARAMETER;
+
+        if (!std::isfinite(m_gridMin[axis]) || !std::isfinite(m_gridMax[axis]) || (m_gridMax[axis] < m_gridMin[axis]))
+            return STATUS_CODE_INVALID_PARAMETER;
+
+        if ((m_nGridPoints[axis] > 1) && !(m_gridMax[axis] > m_gridMin[axis]))
+            return STATUS_CODE_INVALID_PARAMETER;
+
+        nGridPoints *= m_nGridPoints[axis];
+        m_inverseGridSpacing[axis] = (m_nGridPoints[axis] > 1) ? static_cast<float>(m_nGridPoints[axis] - 1) / (m_gridMax[axis] - m_gridMin[axis]) : 0.f;
+    }
+
+    m_bFieldVector.reserve(nGridPoints);
+    float gridSpacing[3] = {0.f, 0.f, 0.f};
+
+    for (unsigned int axis = 0; axis < 3; ++axis)
+        gridSpacing[axis] = (m_nGridPoints[axis] > 1) ? (m_gridMax[axis] - m_gridMin[axis]) / static_cast<float>(m_nGridPoints[axis] - 1) : 0.f;
+
+    for (unsigned int iX = 0; iX < m_nGridPoints[0]; ++iX)
+    {
+        for (unsigned int iY = 0; iY < m_nGridPoints[1]; ++iY)
+        {
+            for (unsigned int iZ = 0; iZ < m_nGridPoints[2]; ++iZ)
+            {
+                const CartesianVector gridPoint(m_gridMin[0] + static_cast<float>(iX) * gridSpacing[0],
+                    m_gridMin[1] + static_cast<float>(iY) * gridSpacing[1], m_gridMin[2] + static_cast<float>(iZ) * gridSpacing[2]);
+                m_bFieldVector.push_back(m_pInnerBFieldPlugin->GetBField(gridPoint));
+            }
+        }
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
+} // namespace pandora
@@ -8,6 +8,7 @@
 
 #include "Helpers/XmlHelper.h"
 
+#include "Objects/CaloHit.h"
 #include "Objects/Cluster.h"
 
 #include "Plugins/EnergyCorrectionsPlugin.h"
@@ -15,18 +16,32 @@
 namespace pandora
 {
 
+StatusCode EnergyCorrectionPlugin::MakeBatchEnergyCorrections(const ClusterVector &clusterVector, FloatVector &correctedEnergies) const
+{
+    if (clusterVector.size() != correctedEnergies.size())
+        return STATUS_CODE_INVALID_PARAMETER;
+
+    for (ClusterVector::size_type index = 0, indexEnd = clusterVector.size(); index < indexEnd; ++index)
+    {
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->MakeEnergyCorrections(clusterVector[index], correctedEnergies[index]));
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 StatusCode EnergyCorrections::MakeEnergyCorrections(const Cluster *const pCluster, float &correctedElectromagneticEnergy,
     float &correctedHadronicEnergy) const
 {
-    correctedHadronicEnergy = pCluster->GetHadronicEnergy();
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetUncorrectedEnergies(pCluster, correctedElectromagneticEnergy, correctedHadronicEnergy));
 
     for (const EnergyCorrectionPlugin *const pPlugin : m_hadEnergyCorrectionPlugins)
     {
         PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, pPlugin->MakeEnergyCorrections(pCluster, correctedHadronicEnergy));
     }
 
-    correctedElectromagneticEnergy = pCluster->GetElectromagneticEnergy();
-
     for (const EnergyCorrectionPlugin *const pPlugin : m_emEnergyCorrectionPlugins)
     {
         PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, pPlugin->MakeEnergyCorrections(pCluster, correctedElectromagneticEnergy));
@@ -37,6 +52,193 @@ StatusCode EnergyCorrections::MakeEnergyCorrections(const Cluster *const pCluste
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+StatusCode EnergyCorrections::MakeEnergyCorrections(const ClusterVector &clusterVector, FloatVector &correctedElectromagneticEnergies,
+    FloatVector &correctedHadronicEnergies) const
+{
+    correctedElectromagneticEnergies.clear();
+    correctedElectromagneticEnergies.reserve(clusterVector.size());
+    correctedHadronicEnergies.clear();
+    correctedHadronicEnergies.reserve(clusterVector.size());
+
+    for (const Cluster *const pCluster : clusterVector)
+    {
+        float electromagneticEnergy(0.f), hadronicEnergy(0.f);
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetUncorrectedEnergies(pCluster, electromagneticEnergy, hadronicEnergy));
+        correctedElectromagneticEnergies.push_back(electromagneticEnergy);
+        correctedHadronicEnergies.push_back(hadronicEnergy);
+    }
+
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, EnergyCorrections::MakeEnergyCorrections(m_hadEnergyCorrectionPlugins, clusterVector,
+        correctedHadronicEnergies));
+
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, EnergyCorrections::MakeEnergyCorrections(m_emEnergyCorrectionPlugins, clusterVector,
+        correctedElectromagneticEnergies));
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode EnergyCorrections::UpdateEnergyCorrections(const ClusterList &clusterList) const
+{
+    ClusterVector clusterVector;
+
+    for (const Cluster *const pCluster : clusterList)
+    {
+        if (!pCluster->IsEnergyCorrectionsCacheUpToDate())
+            clusterVector.push_back(pCluster);
+    }
+
+    if (clusterVector.empty())
+        return STATUS_CODE_SUCCESS;
+
+    FloatVector correctedElectromagneticEnergies, correctedHadronicEnergies;
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->MakeEnergyCorrections(clusterVector, correctedElectromagneticEnergies,
+        correctedHadronicEnergies));
+
+    for (ClusterVector::size_type index = 0, indexEnd = clusterVector.size(); index < indexEnd; ++index)
+    {
+        clusterVector[index]->SetEnergyCorrectionsCache(*m_pPandora, correctedElectromagneticEnergies[index], correctedHadronicEnergies[index]);
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode EnergyCorrections::GetCorrectedCaloHitEnergies(const CaloHit *const pCaloHit, float &correctedElectromagneticEnergy,
+    float &correctedHadronicEnergy) const
+{
+    const unsigned int index(pCaloHit->m_index);
+
+    // ATTN Calo hits created after the input list, e.g. fragments, or owned by another pandora instance, are corrected on demand
+    if ((index < m_correctedCaloHitVector.size()) && (pCaloHit == m_correctedCaloHitVector[index]))
+    {
+        correctedElectromagneticEnergy = m_correctedCaloHitEmEnergies[index];
+        correctedHadronicEnergy = m_correctedCaloHitHadEnergies[index];
+        return STATUS_CODE_SUCCESS;
+    }
+
+    correctedElectromagneticEnergy = pCaloHit->GetElectromagneticEnergy();
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, EnergyCorrections::MakeEnergyCorrections(m_emCaloHitEnergyCorrectionPlugins, pCaloHit,
+        correctedElectromagneticEnergy));
+
+    correctedHadronicEnergy = pCaloHit->GetHadronicEnergy();
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, EnergyCorrections::MakeEnergyCorrections(m_hadCaloHitEnergyCorrectionPlugins, pCaloHit,
+        correctedHadronicEnergy));
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode EnergyCorrections::MakeEnergyCorrections(const EnergyCorrectionPluginVector &energyCorrectionPluginVector,
+    const ClusterVector &clusterVector, FloatVector &correctedEnergies)
+{
+    for (const EnergyCorrectionPlugin *const pPlugin : energyCorrectionPluginVector)
+    {
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, pPlugin->MakeBatchEnergyCorrections(clusterVector, correctedEnergies));
+
+        if (clusterVector.size() != correctedEnergies.size())
+            return STATUS_CODE_FAILURE;
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode EnergyCorrections::MakeEnergyCorrections(const CaloHitEnergyCorrectionPluginVector &caloHitEnergyCorrectionPluginVector,
+    const CaloHit *const pCaloHit, float &correctedEnergy)
+{
+    for (const CaloHitEnergyCorrectionPlugin *const pPlugin : caloHitEnergyCorrectionPluginVector)
+    {
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, pPlugin->MakeEnergyCorrections(pCaloHit, correctedEnergy));
+    }
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode EnergyCorrections::GetUncorrectedEnergies(const Cluster *const pCluster, float &electromagneticEnergy, float &hadronicEnergy) const
+{
+    electromagneticEnergy = pCluster->GetElectromagneticEnergy();
+    hadronicEnergy = pCluster->GetHadronicEnergy();
+
+    const bool sumElectromagnetic(!m_emCaloHitEnergyCorrectionPlugins.empty()), sumHadronic(!m_hadCaloHitEnergyCorrectionPlugins.empty());
+
+    if (!sumElectromagnetic && !sumHadronic)
+        return STATUS_CODE_SUCCESS;
+
+    float electromagneticEnergySum(0.f), hadronicEnergySum(0.f);
+
+    for (const OrderedCaloHitList::value_type &layerEntry : pCluster->GetOrderedCaloHitList())
+    {
+        for (const CaloHit *const pCaloHit : *layerEntry.second)
+        {
+            float correctedElectromagneticEnergy(0.f), correctedHadronicEnergy(0.f);
+            PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetCorrectedCaloHitEnergies(pCaloHit, correctedElectromagneticEnergy,
+                correctedHadronicEnergy));
+
+            electromagneticEnergySum += correctedElectromagneticEnergy;
+            hadronicEnergySum += correctedHadronicEnergy;
+        }
+    }
+
+    for (const CaloHit *const pCaloHit : pCluster->GetIsolatedCaloHitList())
+    {
+        float correctedElectromagneticEnergy(0.f), correctedHadronicEnergy(0.f);
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetCorrectedCaloHitEnergies(pCaloHit, correctedElectromagneticEnergy,
+            correctedHadronicEnergy));
+
+        electromagneticEnergySum += correctedElectromagneticEnergy;
+        hadronicEnergySum += correctedHadronicEnergy;
+    }
+
+    if (sumElectromagnetic)
+        electromagneticEnergy = electromagneticEnergySum;
+
+    if (sumHadronic)
+        hadronicEnergy = hadronicEnergySum;
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+StatusCode EnergyCorrections::MakeCaloHitEnergyCorrections(const CaloHitVector &indexedCaloHitVector)
+{
+    m_correctedCaloHitVector.clear();
+    m_correctedCaloHitEmEnergies.clear();
+    m_correctedCaloHitHadEnergies.clear();
+
+    if (m_emCaloHitEnergyCorrectionPlugins.empty() && m_hadCaloHitEnergyCorrectionPlugins.empty())
+        return STATUS_CODE_SUCCESS;
+
+    FloatVector correctedElectromagneticEnergies, correctedHadronicEnergies;
+    correctedElectromagneticEnergies.reserve(indexedCaloHitVector.size());
+    correctedHadronicEnergies.reserve(indexedCaloHitVector.size());
+
+    for (const CaloHit *const pCaloHit : indexedCaloHitVector)
+    {
+        float correctedElectromagneticEnergy(0.f), correctedHadronicEnergy(0.f);
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->GetCorrectedCaloHitEnergies(pCaloHit, correctedElectromagneticEnergy,
+            correctedHadronicEnergy));
+
+        correctedElectromagneticEnergies.push_back(correctedElectromagneticEnergy);
+        correctedHadronicEnergies.push_back(correctedHadronicEnergy);
+    }
+
+    m_correctedCaloHitVector = indexedCaloHitVector;
+    m_correctedCaloHitEmEnergies.swap(correctedElectromagneticEnergies);
+    m_correctedCaloHitHadEnergies.swap(correctedHadronicEnergies);
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 EnergyCorrections::EnergyCorrections(const Pandora *const pPandora) :
     m_pPandora(pPandora)
 {
@@ -52,10 +254,20 @@ EnergyCorrections::~EnergyCorrections()
     for (const EnergyCorrectionPluginMap::value_type &mapEntry : m_emEnergyCorrectionPluginMap)
         delete mapEntry.second;
 
+    for (const CaloHitEnergyCorrectionPluginMap::value_type &mapEntry : m_hadCaloHitEnergyCorrectionPluginMap)
+        delete mapEntry.second;
+
+    for (const CaloHitEnergyCorrectionPluginMap::value_type &mapEntry : m_emCaloHitEnergyCorrectionPluginMap)
+        delete mapEntry.second;
+
     m_hadEnergyCorrectionPluginMap.clear();
     m_emEnergyCorrectionPluginMap.clear();
     m_hadEnergyCorrectionPlugins.clear();
     m_emEnergyCorrectionPlugins.clear();
+    m_hadCaloHitEnergyCorrectionPluginMap.clear();
+    m_emCaloHitEnergyCorrectionPluginMap.clear();
+    m_hadCaloHitEnergyCorrectionPlugins.clear();
+    m_emCaloHitEnergyCorrectionPlugins.clear();
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -75,18 +287,49 @@ StatusCode EnergyCorrections::RegisterPlugin(const std::string &name, const Ener
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+StatusCode EnergyCorrections::RegisterPlugin(const std::string &name, const EnergyCorrectionType energyCorrectionType,
+    CaloHitEnergyCorrectionPlugin *const pCaloHitEnergyCorrectionPlugin)
+{
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, pCaloHitEnergyCorrectionPlugin->RegisterDetails(m_pPandora, name, name));
+
+    CaloHitEnergyCorrectionPluginMap &caloHitEnergyCorrectionPluginMap(this->GetCaloHitEnergyCorrectionPluginMap(energyCorrectionType));
+
+    if (!caloHitEnergyCorrectionPluginMap.insert(CaloHitEnergyCorrectionPluginMap::value_type(name, pCaloHitEnergyCorrectionPlugin)).second)
+        return STATUS_CODE_ALREADY_PRESENT;
+
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 StatusCode EnergyCorrections::InitializePlugins(const TiXmlHandle *const pXmlHandle)
 {
-    for (EnergyCorrectionPluginMap::value_type &mapEntry : m_hadEnergyCorrectionPluginMap)
-    {
-        TiXmlElement *const pXmlElement(pXmlHandle->FirstChild(mapEntry.first).Element());
-        if (nullptr != pXmlElement)
-            PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, mapEntry.second->ReadSettings(TiXmlHandle(pXmlElement)));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, EnergyCorrections::InitializePluginMap(pXmlHandle, m_hadEnergyCorrectionPluginMap));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, EnergyCorrections::InitializePluginMap(pXmlHandle, m_emEnergyCorrectionPluginMap));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, EnergyCorrections::InitializePluginMap(pXmlHandle, m_hadCaloHitEnergyCorrectionPluginMap));
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, EnergyCorrections::InitializePluginMap(pXmlHandle, m_emCaloHitEnergyCorrectionPluginMap));
 
-        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, mapEntry.second->Initialize());
-    }
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, EnergyCorrections::InitializePlugin(pXmlHandle,
+        "HadronicEnergyCorrectionPlugins", m_hadEnergyCorrectionPluginMap, m_hadEnergyCorrectionPlugins));
+
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, EnergyCorrections::InitializePlugin(pXmlHandle,
+        "ElectromagneticEnergyCorrectionPlugins", m_emEnergyCorrectionPluginMap, m_emEnergyCorrectionPlugins));
+
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, EnergyCorrections::InitializePlugin(pXmlHandle,
+        "HadronicCaloHitEnergyCorrectionPlugins", m_hadCaloHitEnergyCorrectionPluginMap, m_hadCaloHitEnergyCorrectionPlugins));
+
+    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, EnergyCorrections::InitializePlugin(pXmlHandle,
+        "ElectromagneticCaloHitEnergyCorrectionPlugins", m_emCaloHitEnergyCorrectionPluginMap, m_emCaloHitEnergyCorrectionPlugins));
 
-    for (EnergyCorrectionPluginMap::value_type &mapEntry : m_emEnergyCorrectionPluginMap)
+    return STATUS_CODE_SUCCESS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename PLUGIN>
+StatusCode EnergyCorrections::InitializePluginMap(const TiXmlHandle *const pXmlHandle, const std::map<std::string, PLUGIN *> &pluginMap)
+{
+    for (const typename std::map<std::string, PLUGIN *>::value_type &mapEntry : pluginMap)
     {
         TiXmlElement *const pXmlElement(pXmlHandle->FirstChild(mapEntry.first).Element());
 
@@ -96,37 +339,30 @@ StatusCode EnergyCorrections::InitializePlugins(const TiXmlHandle *const pXmlHan
         PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, mapEntry.second->Initialize());
     }
 
-    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->InitializePlugin(pXmlHandle,
-        "HadronicEnergyCorrectionPlugins", HADRONIC, m_hadEnergyCorrectionPlugins));
-
-    PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->InitializePlugin(pXmlHandle,
-        "ElectromagneticEnergyCorrectionPlugins", ELECTROMAGNETIC, m_emEnergyCorrectionPlugins));
-
     return STATUS_CODE_SUCCESS;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+template <typename PLUGIN>
 StatusCode EnergyCorrections::InitializePlugin(const TiXmlHandle *const pXmlHandle, const std::string &xmlTagName,
-    const EnergyCorrectionType energyCorrectionType, EnergyCorrectionPluginVector &energyCorrectionPluginVector)
+    const std::map<std::string, PLUGIN *> &pluginMap, std::vector<PLUGIN *> &pluginVector)
 {
-    if (!energyCorrectionPluginVector.empty())
+    if (!pluginVector.empty())
         return STATUS_CODE_FAILURE;
 
     StringVector requestedPluginNames;
     PANDORA_RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_NOT_FOUND, !=, XmlHelper::ReadVectorOfValues(*pXmlHandle,
         xmlTagName, requestedPluginNames));
 
-    EnergyCorrectionPluginMap &energyCorrectionPluginMap(this->GetEnergyCorrectionPluginMap(energyCorrectionType));
-
     for (const std::string &requestedPluginName : requestedPluginNames)
     {
-        EnergyCorrectionPluginMap::const_iterator mapIter = energyCorrectionPluginMap.find(requestedPluginName);
+        typename std::map<std::string, PLUGIN *>::const_iterator mapIter = pluginMap.find(requestedPluginName);
 
-        if (energyCorrectionPluginMap.end() == mapIter)
+        if (pluginMap.end() == mapIter)
             return STATUS_CODE_NOT_FOUND;
 
-        energyCorrectionPluginVector.push_back(mapIter->second);
+        pluginVector.push_back(mapIter->second);
     }
 
     return STATUS_CODE_SUCCESS;
@@ -151,6 +387,23 @@ EnergyCorrections::EnergyCorrectionPluginMap &EnergyCorrections::GetEnergyCorrec
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+EnergyCorrections::CaloHitEnergyCorrectionPluginMap &EnergyCorrections::GetCaloHitEnergyCorrectionPluginMap(const EnergyCorrectionType energyCorrectionType)
+{
+    switch (energyCorrectionType)
+    {
+    case HADRONIC:
+        return m_hadCaloHitEnergyCorrectionPluginMap;
+
+    case ELECTROMAGNETIC:
+        return m_emCaloHitEnergyCorrectionPluginMap;
+
+    default:
+        throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 StatusCode EnergyCorrections::ResetForNextEvent()
 {
     for (const EnergyCorrectionPluginMap::value_type &mapEntry : m_hadEnergyCorrectionPluginMap)
@@ -159,6 +412,16 @@ StatusCode EnergyCorrections::ResetForNextEvent()
     for (const EnergyCorrectionPluginMap::value_type &mapEntry : m_emEnergyCorrectionPluginMap)
         PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, mapEntry.second->Reset());
 
+    for (const CaloHitEnergyCorrectionPluginMap::value_type &mapEntry : m_hadCaloHitEnergyCorrectionPluginMap)
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, mapEntry.second->Reset());
+
+    for (const CaloHitEnergyCorrectionPluginMap::value_type &mapEntry : m_emCaloHitEnergyCorrectionPluginMap)
+        PANDORA_RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, mapEntry.second->Reset());
+
+    m_correctedCaloHitVector.clear();
+    m_correctedCaloHitEmEnergies.clear();
+    m_correctedCaloHitHadEnergies.clear();
+
     return STATUS_CODE_SUCCESS;
 }
 
@@ -0,0 +1,135 @@
+/**
+ *  @file   PandoraSDK/src/Plugins/LArTransformationPlugin.cc
+ * 
+ *  @brief  Implementation of the lar transformation plugin interface class.
+ * 
+ *  $Log: $
+ */
+
+#include "Plugins/LArTransformationPlugin.h"
+
+namespace pandora
+{
+
+void LArTransformationPlugin::UVtoWArray(const unsigned int nPositions, const double *const pU, const double *const pV, double *const pW) const
+{
+    for (unsigned int index = 0; index < nPositions; ++index)
+        pW[index] = this->UVtoW(pU[index], pV[index]);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void LArTransformationPlugin::VWtoUArray(const unsigned int nPositions, const double *const pV, const double *const pW, double *const pU) const
+{
+    for (unsigned int index = 0; index < nPositions; ++index)
+        pU[index] = this->VWtoU(pV[index], pW[index]);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void LArTransformationPlugin::WUtoVArray(const unsigned int nPositions, const double *const pW, const double *const pU, double *const pV) const
+{
+    for (unsigned int index = 0; index < nPositions; ++index)
+        pV[index] = this->WUtoV(pW[index], pU[index]);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void LArTransformationPlugin::UVtoYArray(const unsigned int nPositions, const double *const pU, const double *const pV, double *const pY) const
+{
+    for (unsigned int index = 0; index < nPositions; ++index)
+        pY[index] = this->UVtoY(pU[index], pV[index]);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void LArTransformationPlugin::UVtoZArray(const unsigned int nPositions, const double *const pU, const double *const pV, double *const pZ) const
+{
+    for (unsigned int index = 0; index < nPositions; ++index)
+        pZ[index] = this->UVtoZ(pU[index], pV[index]);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void LArTransformationPlugin::UWtoYArray(const unsigned int nPositions, const double *const pU, const double *const pW, double *const pY) const
+{
+    for (unsigned int index = 0; index < nPositions; ++index)
+        pY[index] = this->UWtoY(pU[index], pW[index]);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void LArTransformationPlugin::UWtoZArray(const unsigned int nPositions, const double *const pU, const double *const pW, double *const pZ) const
+{
+    for (unsigned int index = 0; index < nPositions; ++index)
+        pZ[index] = this->UWtoZ(pU[index], pW[index]);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void LArTransformationPlugin::VWtoYArray(const unsigned int nPositions, const double *const pV, const double *const pW, double *const pY) const
+{
+    for (unsigned int index = 0; index < nPositions; ++index)
+        pY[index] = this->VWtoY(pV[index], pW[index]);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void LArTransformationPlugin::VWtoZArray(const unsigned int nPositions, const double *const pV, const double *const pW, double *const pZ) const
+{
+    for (unsigned int index = 0; index < nPositions; ++index)
+        pZ[index] = this->VWtoZ(pV[index], pW[index]);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void LArTransformationPlugin::YZtoUArray(const unsigned int nPositions, const double *const pY, const double *const pZ, double *const pU) const
+{
+    for (unsigned int index = 0; index < nPositions; ++index)
+        pU[index] = this->YZtoU(pY[index], pZ[index]);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void LArTransformationPlugin::YZtoVArray(const unsigned int nPositions, const double *const pY, const double *const pZ, double *const pV) const
+{
+    for (unsigned int index = 0; index < nPositions; ++index)
+        pV[index] = this->YZtoV(pY[index], pZ[index]);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void LArTransformationPlugin::YZtoWArray(const unsigned int nPositions, const double *const pY, const double *const pZ, double *const pW) const
+{
+    for (unsigned int index = 0; index < nPositions; ++index)
+        pW[index] = this->YZtoW(pY[index], pZ[index]);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void LArTransformationPlugin::GetMinChiSquaredYZArray(const unsigned int nPositions, const double *const pU, const double *const pV,
+    const double *const pW, const double *const pSigmaU, const double *const pSigmaV, const double *const pSigmaW, double *const pY, double *const pZ,
+    double *const pChiSquared) const
+{
+    for (unsigned int index = 0; index < nPositions; ++index)
+    {
+        this->GetMinChiSquaredYZ(pU[index], pV[index], pW[index], pSigmaU[index], pSigmaV[index], pSigmaW[index], pY[index], pZ[index],
+            pChiSquared[index]);
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void LArTransformationPlugin::GetMinChiSquaredYZArray(const unsigned int nPositions, const double *const pU, const double *const pV,
+    const double *const pW, const double *const pSigmaU, const double *const pSigmaV, const double *const pSigmaW, const double *const pUFit,
+    const double *const pVFit, const double *const pWFit, const double *const pSigmaFit, double *const pY, double *const pZ,
+    double *const pChiSquared) const
+{
+    for (unsigned int index = 0; index < nPositions; ++index)
+    {
+        this->GetMinChiSquaredYZ(pU[index], pV[index], pW[index], pSigmaU[index], pSigmaV[index], pSigmaW[index], pUFit[index], pVFit[index],
+            pWFit[index], pSigmaFit[index], pY[index], pZ[index], pChiSquared[index]);
+    }
+}
+
+} // namespace pandora
@@ -26,7 +26,7 @@ bool ParticleId::IsEmShower(const T *const pT) const
     if (!m_pEmShowerPlugin)
         return false;
 
-    return m_pEmShowerPlugin->IsMatch(pT);
+    return ParticleId::IsMatch(m_pEmShowerPlugin, ParticleIdCache::EM_SHOWER_ID, pT);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -37,7 +37,7 @@ bool ParticleId::IsPhoton(const T *const pT) const
     if (!m_pPhotonPlugin)
         return false;
 
-    return m_pPhotonPlugin->IsMatch(pT);
+    return ParticleId::IsMatch(m_pPhotonPlugin, ParticleIdCache::PHOTON_ID, pT);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -48,7 +48,7 @@ bool ParticleId::IsElectron(const T *const pT) const
     if (!m_pElectronPlugin)
         return false;
 
-    return m_pElectronPlugin->IsMatch(pT);
+    return ParticleId::IsMatch(m_pElectronPlugin, ParticleIdCache::ELECTRON_ID, pT);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -59,7 +59,43 @@ bool ParticleId::IsMuon(const T *const pT) const
     if (!m_pMuonPlugin)
         return false;
 
-    return m_pMuonPlugin->IsMatch(pT);
+    return ParticleId::IsMatch(m_pMuonPlugin, ParticleIdCache::MUON_ID, pT);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+bool ParticleId::IsMatch(const ParticleIdPlugin *const pParticleIdPlugin, const ParticleIdCache::ParticleIdType particleIdType, const T *const pT)
+{
+    const unsigned int modificationEpoch(ParticleId::GetModificationEpoch(pT));
+    bool isMatch(false);
+
+    if (pT->m_particleIdCache.Get(particleIdType, modificationEpoch, isMatch))
+        return isMatch;
+
+    isMatch = pParticleIdPlugin->IsMatch(pT);
+    pT->m_particleIdCache.Set(particleIdType, modificationEpoch, isMatch);
+
+    return isMatch;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+unsigned int ParticleId::GetModificationEpoch(const Cluster *const pCluster)
+{
+    return pCluster->GetModificationEpoch();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+unsigned int ParticleId::GetModificationEpoch(const ParticleFlowObject *const pPfo)
+{
+    unsigned int modificationEpoch(pPfo->GetModificationEpoch());
+
+    for (const Cluster *const pCluster : pPfo->GetClusterList())
+        modificationEpoch += pCluster->GetModificationEpoch();
+
+    return modificationEpoch;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
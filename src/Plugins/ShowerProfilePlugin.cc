@@ -0,0 +1,29 @@
+/**
+ *  @file   PandoraSDK/src/Plugins/ShowerProfilePlugin.cc
+ * 
+ *  @brief  Implementation of the shower profile plugin interface class.
+ * 
+ *  $Log: $
+ */
+
+#include "Plugins/ShowerProfilePlugin.h"
+
+namespace pandora
+{
+
+void ShowerProfilePlugin::CalculateTransverseProfileUsingArena(const Cluster *const pCluster, const unsigned int maxPseudoLayer,
+    ShowerPeakList &showerPeakList, const bool inclusiveMode, ScratchArena &/*scratchArena*/) const
+{
+    this->CalculateTransverseProfile(pCluster, maxPseudoLayer, showerPeakList, inclusiveMode);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void ShowerProfilePlugin::CalculateTrackBasedTransverseProfileUsingArena(const Cluster *const pCluster, const unsigned int maxPseudoLayer,
+    const Track *const pClosestTrack, const TrackVector &trackVector, ShowerPeakList &showerPeakListPhoton, ShowerPeakList &showerPeakListNonPhoton,
+    ScratchArena &/*scratchArena*/) const
+{
+    this->CalculateTrackBasedTransverseProfile(pCluster, maxPseudoLayer, pClosestTrack, trackVector, showerPeakListPhoton, showerPeakListNonPhoton);
+}
+
+} // namespace pandora
@@ -23,6 +23,7 @@ distribution.
 */
 
 #include <ctype.h>
+#include <stddef.h>
 
 #ifdef TIXML_USE_STL
 #include <sstream>
@@ -38,6 +39,133 @@ FILE* TiXmlFOpen( const char* filename, const char* mode );
 
 bool TiXmlBase::condenseWhiteSpace = true;
 
+// Allocations are preceded by a header recording the owning arena, null for the heap.
+static const size_t TIXML_ALIGNMENT = alignof( max_align_t );
+static const size_t TIXML_ALLOCATION_HEADER = ( sizeof( TiXmlArena* ) + TIXML_ALIGNMENT - 1 ) & ~( TIXML_ALIGNMENT - 1 );
+
+struct TiXmlArena::BlockCache
+{
+	BlockCache() : blocks( 0 ), nBlocks( 0 ) {}
+
+	~BlockCache()
+	{
+		while ( blocks )
+		{
+			Block* next = blocks->next;
+			::operator delete( blocks );
+			blocks = next;
+		}
+	}
+
+	Block*	blocks;
+	int		nBlocks;
+};
+
+
+TiXmlArena::BlockCache& TiXmlArena::GetBlockCache()
+{
+	static thread_local BlockCache blockCache;
+	return blockCache;
+}
+
+
+void* TiXmlArena::Allocate( size_t size )
+{
+	size = ( size + TIXML_ALIGNMENT - 1 ) & ~( TIXML_ALIGNMENT - 1 );
+	const size_t blockHeader = ( sizeof( Block ) + TIXML_ALIGNMENT - 1 ) & ~( TIXML_ALIGNMENT - 1 );
+
+	if ( size > static_cast<size_t>( end - position ) )
+	{
+		// Large allocations get a block of their own, leaving the current block in use.
+		const bool isDedicated = ( size > BLOCK_SIZE / 4 );
+		BlockCache& blockCache = GetBlockCache();
+		Block* block = 0;
+
+		if ( !isDedicated && blockCache.blocks )
+		{
+			block = blockCache.blocks;
+			blockCache.blocks = block->next;
+			--blockCache.nBlocks;
+		}
+		else
+		{
+			block = static_cast<Block*>( ::operator new( isDedicated ? blockHeader + size : static_cast<size_t>( BLOCK_SIZE ) ) );
+		}
+
+		block->next = blocks;
+		block->isDedicated = isDedicated;
+		blocks = block;
+
+		char* memory = reinterpret_cast<char*>( block );
+
+		if ( isDedicated )
+			return memory + blockHeader;
+
+		position = memory + blockHeader;
+		end = memory + BLOCK_SIZE;
+	}
+
+	void* p = position;
+	position += size;
+	return p;
+}
+
+
+void TiXmlArena::Release()
+{
+	BlockCache& blockCache = GetBlockCache();
+
+	while ( blocks )
+	{
+		Block* next = blocks->next;
+
+		if ( !blocks->isDedicated && ( blockCache.nBlocks < MAX_CACHED_BLOCKS ) )
+		{
+			blocks->next = blockCache.blocks;
+			blockCache.blocks = blocks;
+			++blockCache.nBlocks;
+		}
+		else
+		{
+			::operator delete( blocks );
+		}
+
+		blocks = next;
+	}
+
+	position = 0;
+	end = 0;
+}
+
+
+TiXmlArena*& TiXmlArena::Current()
+{
+	static thread_local TiXmlArena* current = 0;
+	return current;
+}
+
+
+void* TiXmlBase::operator new( size_t size )
+{
+	TiXmlArena* arena = TiXmlArena::Current();
+	char* memory = static_cast<char*>( arena ? arena->Allocate( TIXML_ALLOCATION_HEADER + size ) : ::operator new( TIXML_ALLOCATION_HEADER + size ) );
+	*reinterpret_cast<TiXmlArena**>( memory ) = arena;
+	return memory + TIXML_ALLOCATION_HEADER;
+}
+
+
+void TiXmlBase::operator delete( void* p )
+{
+	if ( !p )
+		return;
+
+	char* memory = static_cast<char*>( p ) - TIXML_ALLOCATION_HEADER;
+
+	// Arena memory is only returned when the arena is released.
+	if ( !*reinterpret_cast<TiXmlArena**>( memory ) )
+		::operator delete( memory );
+}
+
 // Microsoft compiler security
 FILE* TiXmlFOpen( const char* filename, const char* mode )
 {
@@ -954,6 +1082,13 @@ TiXmlDocument& TiXmlDocument::operator=( const TiXmlDocument& copy )
 }
 
 
+void TiXmlDocument::Clear()
+{
+	TiXmlNode::Clear();
+	arena.Release();
+}
+
+
 bool TiXmlDocument::LoadFile( TiXmlEncoding encoding )
 {
 	return LoadFile( Value(), encoding );
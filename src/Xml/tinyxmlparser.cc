@@ -40,6 +40,21 @@ namespace pandora // Added namespace
 #	endif
 #endif
 
+// Directs the nodes and attributes created by the current thread into a document arena, for
+// the lifetime of the scope.
+class TiXmlArenaScope
+{
+  public:
+	TiXmlArenaScope( TiXmlArena* arena ) : previous( TiXmlArena::Current() )	{ TiXmlArena::Current() = arena; }
+	~TiXmlArenaScope()															{ TiXmlArena::Current() = previous; }
+
+  private:
+	TiXmlArenaScope( const TiXmlArenaScope& );		// not implemented.
+	void operator=( const TiXmlArenaScope& );		// not allowed.
+
+	TiXmlArena* previous;
+};
+
 // Note tha "PutString" hardcodes the same list. This
 // is less flexible than it appears. Changing the entries
 // or order will break putstring.	
@@ -652,6 +667,7 @@ void TiXmlDocument::StreamIn( std::istream * in, TIXML_STRING * tag )
 	//
 	// This "pre-streaming" will never read the closing ">" so the
 	// sub-tag can orient itself.
+	TiXmlArenaScope arenaScope( &arena );
 
 	if ( !StreamTo( in, '<', tag ) ) 
 	{
@@ -709,6 +725,7 @@ void TiXmlDocument::StreamIn( std::istream * in, TIXML_STRING * tag )
 
 const char* TiXmlDocument::Parse( const char* p, TiXmlParsingData* prevData, TiXmlEncoding encoding )
 {
+	TiXmlArenaScope arenaScope( &arena );
 	ClearError();
 
 	// Parse away, at the document level. Since a document